@@ -0,0 +1,400 @@
+/**
+ * @file lv_bench.cpp
+ * @brief Headless benchmark: scripted scenarios with per-phase timing as JSON
+ *
+ * Renders into an lv::MemoryDisplay (no X11/SDL) with a virtual tick, so
+ * two runs on the same machine execute exactly the same frames.
+ *
+ * Usage: lv_bench [--frames N] [--widgets N] [--tile N] [--out results.json]
+ *
+ * --tile sets the tile edge of the render_fill_tiled scenario (default 64).
+ *
+ * Output is a JSON array with one object per scenario, see
+ * lv::Bench::write_json() for the fields.
+ */
+
+#include <lv/lv.hpp>
+#include <lv/others/bench.hpp>
+#include <lv/core/theme_switch.hpp>
+#include <lv/core/resolved_style.hpp>
+#include <lv/core/tile_render.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+
+namespace {
+
+constexpr int32_t WIDTH = 800;
+constexpr int32_t HEIGHT = 480;
+
+struct Options {
+    uint32_t frames = 300;
+    uint32_t widgets = 200;
+    uint16_t tile = 64;
+    const char* out = nullptr;
+};
+
+/// Fresh screen for each scenario so results do not depend on order
+lv::ObjectView fresh_screen() {
+    lv_obj_t* old = lv_screen_active();
+    lv::ObjectView scr = lv::screen_create();
+    lv::screen_load(scr);
+    if (old) lv_obj_delete(old);
+    return scr;
+}
+
+// ==================== Scenarios ====================
+
+/// Create N buttons with labels in a wrapping flex container
+void scenario_create_widgets(lv::Bench& bench, const Options& opt) {
+    lv::ObjectView scr = fresh_screen();
+    bench.reset();
+    auto grid = lv::hbox_wrap(scr).fill().gap(4);
+    for (uint32_t i = 0; i < opt.widgets; ++i) {
+        lv::Button::create(grid).text_fmt("Item %u", static_cast<unsigned>(i));
+        if (i % 20 == 19) bench.frame();    // spread creation over frames like a real UI
+    }
+    bench.run(opt.frames);
+}
+
+/// Fling a long list up and down with the virtual pointer
+void scenario_scroll_list(lv::Bench& bench, const Options& opt) {
+    lv::ObjectView scr = fresh_screen();
+    auto list = lv::List::create(scr);
+    list.size(WIDTH, HEIGHT);
+    for (uint32_t i = 0; i < opt.widgets; ++i) {
+        (void)list.add_button(LV_SYMBOL_FILE, "Log entry");
+    }
+    bench.run(2);
+    bench.reset();
+    uint32_t done = 0;
+    while (done < opt.frames) {
+        bench.swipe(WIDTH / 2, HEIGHT - 40, WIDTH / 2, 40, 10);
+        bench.run(20);
+        bench.swipe(WIDTH / 2, 40, WIDTH / 2, HEIGHT - 40, 10);
+        bench.run(20);
+        done += 2 * (10 + 2 + 20);
+    }
+}
+
+/// Many concurrent position and opacity animations
+void scenario_animate(lv::Bench& bench, const Options& opt) {
+    lv::ObjectView scr = fresh_screen();
+    const uint32_t n = opt.widgets < 64 ? opt.widgets : 64;
+    for (uint32_t i = 0; i < n; ++i) {
+        auto box = lv::Box::create(scr);
+        box.size(40, 40).pos(0, static_cast<int32_t>(i % 10) * 46);
+        lv::anim_x(box, 0, WIDTH - 40)
+            .duration(1000 + 37 * i)
+            .playback()
+            .repeat_infinite()
+            .start();
+    }
+    bench.reset();
+    bench.run(opt.frames);
+}
+
+/// Alternate between two populated screens with a slide animation
+void scenario_switch_screens(lv::Bench& bench, const Options& opt) {
+    lv::ObjectView a = fresh_screen();
+    lv::ObjectView b = lv::screen_create();
+    for (lv::ObjectView scr : {a, b}) {
+        auto col = lv::vbox(scr).fill().gap(6);
+        for (uint32_t i = 0; i < 12; ++i) {
+            lv::Button::create(col).text_fmt("Row %u", static_cast<unsigned>(i));
+        }
+    }
+    bench.run(2);
+    bench.reset();
+    bool to_b = true;
+    for (uint32_t done = 0; done < opt.frames; done += 30) {
+        lv::screen_load_anim(to_b ? b : a, lv::screen_anim::move_left, 300);
+        bench.run(30);
+        to_b = !to_b;
+    }
+    // Delete the inactive screen; fresh_screen() deletes the active one
+    lv_obj_delete(to_b ? b.get() : a.get());
+}
+
+/// Full-screen redraws of shadowed gradient cards (scales with LV_RENDER_THREADS)
+void scenario_render_fill(lv::Bench& bench, const Options& opt) {
+    lv::ObjectView scr = fresh_screen();
+    static lv::Style card;
+    card.radius(12).shadow_width(24).shadow_opa(LV_OPA_50)
+        .bg_color(lv::rgb(0x1e3a8a)).bg_grad_color(lv::rgb(0x38bdf8)).bg_grad_dir(LV_GRAD_DIR_VER);
+    auto grid = lv::hbox_wrap(scr).fill().gap(16);
+    for (uint32_t i = 0; i < 24; ++i) {
+        auto box = lv::Box::create(grid);
+        box.size(160, 90);
+        lv_obj_add_style(box.get(), card.get(), 0);
+    }
+    bench.run(2);
+    bench.reset();
+    for (uint32_t i = 0; i < opt.frames; ++i) {
+        lv_obj_invalidate(scr.get());
+        bench.frame();
+    }
+}
+
+/// render_fill with the display in tiled mode (tile_render.hpp), for comparison
+void scenario_render_fill_tiled(lv::Bench& bench, const Options& opt) {
+    lv::Display disp = lv::Display::get_default();
+    lv::TileConfig cfg;
+    cfg.tile_w = opt.tile;
+    cfg.tile_h = opt.tile;
+    lv::tile_render::enable(disp, cfg);
+    scenario_render_fill(bench, opt);
+    lv::tile_render::disable(disp);
+}
+
+#if LV_USE_THEME_DEFAULT && LV_USE_THEME_SIMPLE
+/// Toggle between two themes on a screen with 1000+ objects (see "theme_us")
+void scenario_theme_switch(lv::Bench& bench, const Options& opt) {
+    lv::ObjectView scr = fresh_screen();
+    auto grid = lv::hbox_wrap(scr).fill().gap(4);
+    const uint32_t buttons = opt.widgets > 600 ? opt.widgets : 600;    // button + label each
+    for (uint32_t i = 0; i < buttons; ++i) {
+        lv::Button::create(grid).text_fmt("%u", static_cast<unsigned>(i));
+    }
+    lv_display_t* disp = lv_display_get_default();
+    lv_theme_t* light = lv_display_get_theme(disp);
+    lv_theme_t* simple = lv::theme_simple_init(disp);
+    bench.run(2);
+    bench.reset();
+    bool to_simple = true;
+    for (uint32_t done = 0; done < opt.frames; done += 30) {
+        lv::switch_theme(disp, to_simple ? simple : light);
+        bench.run(30);
+        to_simple = !to_simple;
+    }
+    lv::switch_theme(disp, light);
+}
+#endif
+
+// ==================== Component lookup ====================
+
+constexpr uint32_t LOOKUP_CELLS = 128;
+constexpr uint32_t LOOKUP_HANDLERS = 16;
+constexpr uint32_t LOOKUPS_PER_FRAME = 64;    // per cell
+
+/// Component root carrying several handlers, like a widget with many on_*() bindings
+class LookupCell : public lv::Component<LookupCell> {
+    static void noop_cb(lv_event_t*) {}
+
+public:
+    lv::ObjectView build(lv::ObjectView parent) {
+        lv_obj_t* box = lv_obj_create(parent.get());
+        lv_obj_set_size(box, 20, 20);
+        for (uint32_t i = 0; i < LOOKUP_HANDLERS; ++i) {
+            lv_obj_add_event_cb(box, &LookupCell::noop_cb, LV_EVENT_PRESSED, nullptr);
+        }
+        return lv::ObjectView(box);
+    }
+};
+
+/// Previous owner lookup: walk the root's event descriptors
+LookupCell* scan_owner(lv_obj_t* obj, const LookupCell* expected) {
+    const uint32_t n = lv_obj_get_event_count(obj);
+    for (uint32_t i = 0; i < n; ++i) {
+        lv_event_dsc_t* d = lv_obj_get_event_dsc(obj, i);
+        if (d && lv_event_dsc_get_user_data(d) == expected) {
+            return static_cast<LookupCell*>(lv_event_dsc_get_user_data(d));
+        }
+    }
+    return nullptr;
+}
+
+/// Timer load: look every cell up LOOKUPS_PER_FRAME times per frame
+struct LookupLoad {
+    LookupCell* cells;
+    bool scan;
+    uint32_t found = 0;
+
+    void run() {
+        for (uint32_t rep = 0; rep < LOOKUPS_PER_FRAME; ++rep) {
+            for (uint32_t i = 0; i < LOOKUP_CELLS; ++i) {
+                lv_obj_t* root = cells[i].root().get();
+                found += (scan ? scan_owner(root, &cells[i]) : LookupCell::from_obj(root)) != nullptr;
+            }
+        }
+    }
+};
+
+void run_lookup(lv::Bench& bench, const Options& opt, bool scan) {
+    lv::ObjectView scr = fresh_screen();
+    LookupCell cells[LOOKUP_CELLS];
+    for (LookupCell& c : cells) c.mount(scr);
+    LookupLoad load{cells, scan};
+    {
+        lv::Timer timer = lv::Timer::create<&LookupLoad::run>(1, &load);
+        bench.run(2);
+        bench.reset();
+        bench.run(opt.frames);
+    }
+}
+
+/// Component::from_obj() on roots with many handlers (owner table)
+void scenario_component_lookup(lv::Bench& bench, const Options& opt) {
+    run_lookup(bench, opt, false);
+}
+
+/// Same load with the descriptor scan from_obj() used before, for comparison
+void scenario_component_lookup_scan(lv::Bench& bench, const Options& opt) {
+    run_lookup(bench, opt, true);
+}
+
+// ==================== Deep style stacks ====================
+
+constexpr uint32_t STACK_CELLS = LV_CPP_RESOLVED_STYLE_OBJECTS;
+constexpr uint32_t STACK_STYLES = 16;
+
+/// One shared style per part/state combination, like a heavily themed widget
+lv::Style* stack_styles() {
+    static lv::Style styles[STACK_STYLES];
+    static bool ready = false;
+    if (!ready) {
+        for (uint32_t i = 0; i < STACK_STYLES; ++i) {
+            styles[i].bg_color(lv::rgb((0x102030u * (i + 1)) & 0xffffffu)).radius(static_cast<int32_t>(i))
+                .border_width(1).border_color(lv::rgb(0x404040)).outline_width(static_cast<int32_t>(i % 2))
+                .shadow_width(static_cast<int32_t>(i % 3)).pad_all(2).text_color(lv::rgb(0xf0f0f0));
+        }
+        ready = true;
+    }
+    return styles;
+}
+
+/// Custom draw of the ITEMS part, resolving its descriptors on every redraw
+template<bool Resolved>
+void stack_draw_cb(lv_event_t* e) {
+    lv_obj_t* obj = lv_event_get_current_target_obj(e);
+    lv_layer_t* layer = lv_event_get_layer(e);
+    lv_area_t area;
+    lv_obj_get_coords(obj, &area);
+    lv_draw_rect_dsc_t rect;
+    lv_draw_rect_dsc_init(&rect);
+    lv_draw_label_dsc_t label;
+    lv_draw_label_dsc_init(&label);
+    if constexpr (Resolved) {
+        lv::resolved_style::init_rect_dsc(obj, LV_PART_ITEMS, &rect);
+        lv::resolved_style::init_label_dsc(obj, LV_PART_ITEMS, &label);
+    } else {
+        lv_obj_init_draw_rect_dsc(obj, LV_PART_ITEMS, &rect);
+        lv_obj_init_draw_label_dsc(obj, LV_PART_ITEMS, &label);
+    }
+    label.text = "42";
+    lv_draw_rect(layer, &rect, &area);
+    lv_draw_label(layer, &label, &area);
+}
+
+/// Timer load: redraw the whole screen every tick
+struct RedrawLoad {
+    lv_obj_t* scr;
+    void run() { lv_obj_invalidate(scr); }
+};
+
+void run_style_stack(lv::Bench& bench, const Options& opt, bool resolved) {
+    static constexpr lv_state_t states[] = {LV_STATE_DEFAULT, LV_STATE_CHECKED, LV_STATE_FOCUSED, LV_STATE_PRESSED,
+                                            LV_STATE_CHECKED | LV_STATE_PRESSED, LV_STATE_DISABLED};
+    lv::ObjectView scr = fresh_screen();
+    lv::Style* styles = stack_styles();
+    auto grid = lv::hbox_wrap(scr).fill().gap(8);
+    for (uint32_t i = 0; i < STACK_CELLS; ++i) {
+        lv_obj_t* cell = lv_obj_create(grid.get());
+        lv_obj_set_size(cell, 160, 80);
+        for (uint32_t k = 0; k < STACK_STYLES; ++k) {
+            lv_obj_add_style(cell, styles[k].get(), LV_PART_ITEMS | states[k % std::size(states)]);
+        }
+        lv_obj_add_state(cell, LV_STATE_CHECKED);
+        lv_obj_add_event_cb(cell, resolved ? &stack_draw_cb<true> : &stack_draw_cb<false>, LV_EVENT_DRAW_MAIN_END,
+                            nullptr);
+        if (resolved) lv::resolved_style::enable(cell);
+    }
+    RedrawLoad load{scr.get()};
+    {
+        lv::Timer timer = lv::Timer::create<&RedrawLoad::run>(1, &load);
+        bench.run(2);
+        bench.reset();
+        bench.run(opt.frames);
+    }
+}
+
+/// Custom-drawn cells with 16 styles per part, descriptors resolved every redraw
+void scenario_style_stack(lv::Bench& bench, const Options& opt) {
+    run_style_stack(bench, opt, false);
+}
+
+/// Same cells drawing from the resolved-style cache (resolved_style.hpp)
+void scenario_style_stack_resolved(lv::Bench& bench, const Options& opt) {
+    run_style_stack(bench, opt, true);
+}
+
+struct Scenario {
+    const char* name;
+    void (*run)(lv::Bench&, const Options&);
+};
+
+constexpr Scenario SCENARIOS[] = {
+    {"create_widgets", &scenario_create_widgets},
+    {"scroll_list", &scenario_scroll_list},
+    {"animate", &scenario_animate},
+    {"switch_screens", &scenario_switch_screens},
+    {"render_fill", &scenario_render_fill},
+    {"render_fill_tiled", &scenario_render_fill_tiled},
+    {"component_lookup", &scenario_component_lookup},
+    {"component_lookup_scan", &scenario_component_lookup_scan},
+    {"style_stack", &scenario_style_stack},
+    {"style_stack_resolved", &scenario_style_stack_resolved},
+#if LV_USE_THEME_DEFAULT && LV_USE_THEME_SIMPLE
+    {"theme_switch", &scenario_theme_switch},
+#endif
+};
+
+bool parse_args(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        const bool has_value = i + 1 < argc;
+        if (std::strcmp(argv[i], "--frames") == 0 && has_value) {
+            opt.frames = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--widgets") == 0 && has_value) {
+            opt.widgets = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--tile") == 0 && has_value) {
+            opt.tile = static_cast<uint16_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--out") == 0 && has_value) {
+            opt.out = argv[++i];
+        } else {
+            std::fprintf(stderr, "usage: %s [--frames N] [--widgets N] [--tile N] [--out FILE]\n", argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parse_args(argc, argv, opt)) return 2;
+
+    FILE* out = opt.out ? std::fopen(opt.out, "w") : stdout;
+    if (!out) {
+        std::perror(opt.out);
+        return 1;
+    }
+
+    lv::init();
+    static lv::MemoryDisplay<WIDTH, HEIGHT> display;
+    static lv::Bench bench(display);
+
+    std::fprintf(out, "[\n");
+    bool first = true;
+    for (const Scenario& s : SCENARIOS) {
+        s.run(bench, opt);
+        std::fprintf(out, first ? "  " : ",\n  ");
+        bench.write_json(out, s.name);
+        first = false;
+    }
+    std::fprintf(out, "\n]\n");
+
+    if (out != stdout) std::fclose(out);
+    return 0;
+}
@@ -0,0 +1,64 @@
+# lv_add_assets(<target> FORMAT <RGB565|RGB565A8|RGB888|XRGB8888|ARGB8888>
+#               [PREMULTIPLIED] [KEEP_ALPHA]
+#               [STRIDE_ALIGN <bytes> | LV_CONF <path/to/lv_conf.h>]
+#               SOURCES <image.c|image.png>...)
+#
+# Converts images to the display's color format at build time and adds the
+# generated C files to <target> (scripts/image_convert.py). Generated LVGL
+# image C files keep their lv_image_dsc_t names, so they can replace the
+# originals in SOURCES. Opaque images are stored without alpha so LVGL
+# blits them with memcpy. Rows are padded to STRIDE_ALIGN, by default
+# LV_DRAW_BUF_STRIDE_ALIGN from LV_CONF (or LV_CONF_PATH, or lv_conf.h at
+# the top of the source tree).
+
+find_package(Python3 COMPONENTS Interpreter QUIET)
+set(LV_IMAGE_CONVERT_SCRIPT ${CMAKE_CURRENT_LIST_DIR}/../scripts/image_convert.py)
+
+function(lv_add_assets target)
+    cmake_parse_arguments(ARG "PREMULTIPLIED;KEEP_ALPHA" "FORMAT;STRIDE_ALIGN;LV_CONF" "SOURCES" ${ARGN})
+    if(NOT ARG_FORMAT)
+        message(FATAL_ERROR "lv_add_assets(${target}): FORMAT is required")
+    endif()
+    if(NOT Python3_Interpreter_FOUND)
+        message(FATAL_ERROR "lv_add_assets(${target}): needs a Python 3 interpreter")
+    endif()
+
+    set(opts --format ${ARG_FORMAT})
+    if(ARG_PREMULTIPLIED)
+        list(APPEND opts --premultiply)
+    endif()
+    if(ARG_KEEP_ALPHA)
+        list(APPEND opts --keep-alpha)
+    endif()
+    if(NOT ARG_LV_CONF)
+        if(DEFINED LV_CONF_PATH)
+            set(ARG_LV_CONF ${LV_CONF_PATH})
+        elseif(EXISTS ${CMAKE_SOURCE_DIR}/lv_conf.h)
+            set(ARG_LV_CONF ${CMAKE_SOURCE_DIR}/lv_conf.h)
+        endif()
+    endif()
+    set(conf_dep)
+    if(ARG_STRIDE_ALIGN)
+        list(APPEND opts --stride-align ${ARG_STRIDE_ALIGN})
+    elseif(ARG_LV_CONF)
+        list(APPEND opts --lv-conf ${ARG_LV_CONF})
+        set(conf_dep ${ARG_LV_CONF})
+    endif()
+
+    set(out_dir ${CMAKE_CURRENT_BINARY_DIR}/lv_assets/${target})
+    set(outputs)
+    foreach(src IN LISTS ARG_SOURCES)
+        get_filename_component(src_abs ${src} ABSOLUTE)
+        get_filename_component(stem ${src} NAME_WE)
+        set(out ${out_dir}/${stem}.c)
+        add_custom_command(
+            OUTPUT ${out}
+            COMMAND ${Python3_EXECUTABLE} ${LV_IMAGE_CONVERT_SCRIPT} ${opts} -o ${out_dir} ${src_abs}
+            DEPENDS ${src_abs} ${LV_IMAGE_CONVERT_SCRIPT} ${conf_dep}
+            COMMENT "Converting ${stem} to ${ARG_FORMAT}"
+            VERBATIM
+        )
+        list(APPEND outputs ${out})
+    endforeach()
+    target_sources(${target} PRIVATE ${outputs})
+endfunction()
@@ -0,0 +1,122 @@
+# lv_profile([NAME <name>]
+#            WIDGETS <label|button|slider|...>...
+#            [FEATURES <flex|grid|observer>...]
+#            [EXTRAS <virtual_list|log_view|...>...])
+#
+# Writes lv_profile.h for the whole build: every LVGL widget switch
+# (LV_USE_ARC ... LV_USE_WIN) set to 1 for the WIDGETS listed, and the
+# widgets they need (keyboard pulls in buttonmatrix and textarea), 0 for
+# the rest. label and image are always on: core headers (text bindings,
+# the text cache, screen transitions) use them. FEATURES does the same
+# for the flex and grid layouts and the observer. EXTRAS picks the
+# wrapper-only headers (VirtualList, LogView, ...) that lv.hpp still
+# includes; without it lv.hpp includes none of them, and they can be
+# included directly instead. Opt-in headers that read LVGL internals
+# (led_bank.hpp, polyline_cache.hpp, ...) are never extras.
+#
+# The header is passed to lvgl and lv as LV_CPP_PROFILE_HEADER. lv_conf.h
+# must include it and leave the widget switches to it, as this tree's
+# lv_conf.h does:
+#
+#   #ifdef LV_CPP_PROFILE_HEADER
+#   #include LV_CPP_PROFILE_HEADER
+#   #endif
+#   #if !LV_CPP_PROFILE
+#   #define LV_USE_ARC 1 ...
+#   #endif
+#
+# Widgets left out are not compiled into LVGL, the default theme no longer
+# references their classes (so the linker can drop them), and lv.hpp no
+# longer parses their wrappers.
+
+set(LV_PROFILE_WIDGETS
+    arc bar button buttonmatrix calendar canvas chart checkbox dropdown image imagebutton keyboard
+    label led line list menu msgbox roller scale slider span spinbox spinner switch textarea table
+    tabview tileview win)
+set(LV_PROFILE_FEATURES flex grid observer)
+set(LV_PROFILE_EXTRAS
+    text_editor log_view notifications chart_decimator strip_chart virtual_list file_browser data_table
+    virtual_options)
+
+# What LVGL or the wrapper needs alongside each entry
+set(_lv_needs_calendar buttonmatrix label button dropdown)
+set(_lv_needs_dropdown label)
+set(_lv_needs_keyboard buttonmatrix textarea)
+set(_lv_needs_list label button image)
+set(_lv_needs_menu label image)
+set(_lv_needs_msgbox label button image)
+set(_lv_needs_roller label)
+set(_lv_needs_spinbox textarea)
+set(_lv_needs_spinner arc)
+set(_lv_needs_tabview button label)
+set(_lv_needs_textarea label)
+set(_lv_needs_win label button image)
+set(_lv_needs_text_editor label)
+set(_lv_needs_log_view label)
+set(_lv_needs_notifications label)
+set(_lv_needs_chart_decimator chart)
+set(_lv_needs_strip_chart canvas)
+set(_lv_needs_virtual_list list)
+set(_lv_needs_file_browser list)
+set(_lv_needs_data_table list)
+set(_lv_needs_virtual_options roller label)
+
+function(lv_profile)
+    cmake_parse_arguments(ARG "" "NAME" "WIDGETS;FEATURES;EXTRAS" ${ARGN})
+    if(NOT ARG_NAME)
+        set(ARG_NAME ${PROJECT_NAME})
+    endif()
+    foreach(kind WIDGETS FEATURES EXTRAS)
+        foreach(item IN LISTS ARG_${kind})
+            if(NOT item IN_LIST LV_PROFILE_${kind})
+                message(FATAL_ERROR "lv_profile(): unknown ${kind} entry '${item}' (known: ${LV_PROFILE_${kind}})")
+            endif()
+        endforeach()
+    endforeach()
+
+    # Close over the dependencies (a few rounds cover the deepest chain)
+    set(used label image ${ARG_WIDGETS} ${ARG_FEATURES} ${ARG_EXTRAS})
+    foreach(round RANGE 3)
+        foreach(item IN LISTS used)
+            list(APPEND used ${_lv_needs_${item}})
+        endforeach()
+        list(REMOVE_DUPLICATES used)
+    endforeach()
+
+    set(lines "/* Generated by lv_profile() (cmake/LvProfile.cmake) for ${ARG_NAME}; do not edit */\n")
+    string(APPEND lines "#ifndef LV_CPP_PROFILE\n#define LV_CPP_PROFILE 1\n\n")
+    foreach(item IN LISTS LV_PROFILE_WIDGETS LV_PROFILE_FEATURES)
+        string(TOUPPER ${item} upper)
+        if(item IN_LIST used)
+            string(APPEND lines "#define LV_USE_${upper} 1\n")
+        else()
+            string(APPEND lines "#define LV_USE_${upper} 0\n")
+        endif()
+    endforeach()
+    string(APPEND lines "\n")
+    foreach(item IN LISTS LV_PROFILE_EXTRAS)
+        string(TOUPPER ${item} upper)
+        if(item IN_LIST used)
+            string(APPEND lines "#define LV_CPP_PROFILE_${upper} 1\n")
+        else()
+            string(APPEND lines "#define LV_CPP_PROFILE_${upper} 0\n")
+        endif()
+    endforeach()
+    string(APPEND lines "\n#endif\n")
+
+    set(out ${CMAKE_BINARY_DIR}/lv_profile/lv_profile.h)
+    file(CONFIGURE OUTPUT ${out} CONTENT "${lines}")   # rewritten only when it changes
+
+    list(SORT used)
+    message(STATUS "lv_profile(${ARG_NAME}): ${used}")
+    foreach(target lvgl lv)
+        if(TARGET ${target})
+            get_target_property(type ${target} TYPE)
+            if(type STREQUAL "INTERFACE_LIBRARY")
+                target_compile_definitions(${target} INTERFACE LV_CPP_PROFILE_HEADER="${out}")
+            else()
+                target_compile_definitions(${target} PUBLIC LV_CPP_PROFILE_HEADER="${out}")
+            endif()
+        endif()
+    endforeach()
+endfunction()
@@ -9,6 +9,7 @@
  */
 
 #include <lv/lv.hpp>
+#include <lv/draw/rotation_cache.hpp>
 #include <array>
 #include <ctime>
 
@@ -94,6 +95,9 @@ class AnalogClockDemo {
     // RAII timer - automatically deleted in destructor
     lv::Timer m_timer{nullptr};
 
+    // Benchmark mode: clock runs from this epoch on the LVGL tick (-1 = wall clock)
+    std::time_t m_fixed_epoch = -1;
+
     // Hand pivot points (from image dimensions)
     static constexpr int kHourPivotX = 9;
     static constexpr int kHourPivotY = 98;
@@ -103,6 +107,16 @@ class AnalogClockDemo {
     static constexpr int kSecPivotY = 156;
 
 public:
+    /**
+     * @brief Run the clock from a fixed start time on the LVGL tick
+     *
+     * Makes the hands independent of the wall clock and time zone, so
+     * benchmark runs render the same frames every time.
+     */
+    void use_fixed_clock(std::time_t epoch) {
+        m_fixed_epoch = epoch;
+    }
+
     void create() {
         auto screen = lv::screen_active();
 
@@ -156,6 +170,11 @@ public:
             .pivot(kMinPivotX, kMinPivotY)
             .rotation(0);
 
+        // Hour and minute hands are redrawn under the second hand at the
+        // same angle many times: blit them from the rotation cache
+        lv::rotation_cache::enable(m_hour_hand, 5);
+        lv::rotation_cache::enable(m_minute_hand, 5);
+
         create_menu_panel(screen);
 
         // Bring battery label and icon to front
@@ -317,9 +336,11 @@ private:
 
     /// Timer callback - called every 100ms to update clock hands
     void update_time() {
-        // Get current local time
-        const std::time_t now = std::time(nullptr);
-        const std::tm* local = std::localtime(&now);
+        // Get current local time (or the fixed benchmark clock, in UTC)
+        const bool fixed = m_fixed_epoch >= 0;
+        const std::time_t now = fixed ? m_fixed_epoch + static_cast<std::time_t>(lv_tick_get() / 1000)
+                                      : std::time(nullptr);
+        const std::tm* local = fixed ? std::gmtime(&now) : std::localtime(&now);
 
         const int hours = local->tm_hour;
         const int minutes = local->tm_min;
@@ -340,9 +361,9 @@ private:
         // Second: 360 degrees / 60 seconds = 6 degrees per second
         const int32_t sec_angle = seconds * 60;
 
-        // Apply rotations
-        m_hour_hand.rotation(hour_angle);
-        m_minute_hand.rotation(min_angle);
+        // Apply rotations (hour and minute snapped to their cached 0.5 degree steps)
+        lv::rotation_cache::rotate(m_hour_hand, hour_angle);
+        lv::rotation_cache::rotate(m_minute_hand, min_angle);
         m_second_hand.rotation(sec_angle);
 
         // Update date label (MM/DD format)
@@ -3,15 +3,49 @@
  * @brief Analog clock demo entry point
  *
  * Displays an analog clock face with rotating hands showing real time.
+ *
+ * `--bench [--frames N] [--out FILE]` runs headless from a fixed start time
+ * and writes frame timings as JSON.
  */
 
 #include <lv/lv.hpp>
 #include <lv/assets/cursor.hpp>
+#include <lv/others/bench.hpp>
 #include "analog_clock.hpp"
 
-int main() {
+namespace {
+
+// The clock has no input; the hands advance on the virtual tick
+constexpr lv::BenchStep kBenchScript[] = {
+    lv::BenchStep::wait(300),
+};
+
+// 2024-01-01 10:08:30 UTC: hands spread over the dial
+constexpr std::time_t kBenchEpoch = 1704103710;
+
+int run_bench(const lv::BenchOptions& opts) {
+    static lv::MemoryDisplay<390, 390> display;
+    static lv::Bench bench(display);
+    analog_clock::AnalogClockDemo demo;
+    demo.use_fixed_clock(kBenchEpoch);
+    demo.create();
+    const bool ok = bench.run_script(opts, "analog_clock", kBenchScript);
+#if LV_CPP_USE_TIMER_STATS
+    // Is the 100 ms update_time timer on time while frames render?
+    lv::timer_stats::log(5);
+#endif
+    demo.destroy();
+    return ok ? 0 : 1;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
     lv::init();
 
+    const lv::BenchOptions bench = lv::bench_options(argc, argv);
+    if (bench.enabled) return run_bench(bench);
+
 #if LV_USE_X11
     lv::X11Display display("Analog Clock Demo", 390, 390, &lv::cursor_arrow);
 #elif LV_USE_SDL
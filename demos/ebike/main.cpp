@@ -4,17 +4,53 @@
  *
  * This is a C++ port of the official LVGL E-Bike demo using
  * zero-cost C++20 bindings.
+ *
+ * `--bench [--frames N] [--out FILE]` runs headless, clicking through the
+ * menu bar pages, and writes frame timings as JSON.
  */
 
 #include <lv/lv.hpp>
 #include <lv/assets/cursor.hpp>
+#include <lv/others/bench.hpp>
 #include "ebike_demo.hpp"
 
 static ebike::EbikeDemo demo;
 
-int main() {
+namespace {
+
+// Menu bar icons on the right edge of the 480x320 screen
+constexpr int32_t MENU_X = 458;
+constexpr int32_t MENU_SETTINGS_Y = 100;
+constexpr int32_t MENU_STATS_Y = 160;
+constexpr int32_t MENU_HOME_Y = 220;
+
+// Home -> stats -> settings -> home, with a drag on each page
+constexpr lv::BenchStep kBenchScript[] = {
+    lv::BenchStep::wait(60),
+    lv::BenchStep::click(MENU_X, MENU_STATS_Y), lv::BenchStep::wait(60),
+    lv::BenchStep::swipe(200, 160, 60, 160), lv::BenchStep::wait(40),
+    lv::BenchStep::click(MENU_X, MENU_SETTINGS_Y), lv::BenchStep::wait(60),
+    lv::BenchStep::swipe(200, 260, 200, 60), lv::BenchStep::wait(40),
+    lv::BenchStep::click(MENU_X, MENU_HOME_Y), lv::BenchStep::wait(60),
+};
+
+int run_bench(const lv::BenchOptions& opts) {
+    static lv::MemoryDisplay<480, 320> display;
+    static lv::Bench bench(display);
+    demo.create();
+    const bool ok = bench.run_script(opts, "ebike", kBenchScript);
+    demo.destroy();
+    return ok ? 0 : 1;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
     lv::init();
 
+    const lv::BenchOptions bench = lv::bench_options(argc, argv);
+    if (bench.enabled) return run_bench(bench);
+
     // Create display based on available backend
 #if LV_USE_X11
     lv::X11Display display("E-Bike Demo (C++ Port)", 480, 320, &lv::cursor_arrow);
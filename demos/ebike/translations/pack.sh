@@ -0,0 +1,4 @@
+#!/bin/bash
+# Compile the yml files into a binary pack for lv::translation::BinaryPack.
+
+../../../scripts/translation_pack.py en.yml zh.yml ar.yml -o ebike.ltp
@@ -1,18 +1,51 @@
 /**
  * @file main.cpp
  * @brief Smartwatch demo entry point
+ *
+ * `--bench [--frames N] [--out FILE]` runs headless with a scripted swipe
+ * tour of all screens and writes frame timings as JSON.
  */
 
 #include <lv/lv.hpp>
 #include <lv/assets/cursor.hpp>
+#include <lv/others/bench.hpp>
 #include "smartwatch_demo.hpp"
 #include "smartwatch_gestures.hpp"
 
 static smartwatch::SmartwatchDemo demo;
 
-int main() {
+namespace {
+
+constexpr int32_t CENTER = smartwatch::SCREEN_SIZE / 2;
+constexpr int32_t EDGE = smartwatch::SCREEN_SIZE - 40;
+
+// Home -> weather -> health -> sports -> music -> home -> control -> home,
+// waiting for each screen transition to finish
+constexpr lv::BenchStep kBenchScript[] = {
+    lv::BenchStep::swipe(EDGE, CENTER, 40, CENTER), lv::BenchStep::wait(70),
+    lv::BenchStep::swipe(EDGE, CENTER, 40, CENTER), lv::BenchStep::wait(70),
+    lv::BenchStep::swipe(EDGE, CENTER, 40, CENTER), lv::BenchStep::wait(70),
+    lv::BenchStep::swipe(EDGE, CENTER, 40, CENTER), lv::BenchStep::wait(70),
+    lv::BenchStep::swipe(EDGE, CENTER, 40, CENTER), lv::BenchStep::wait(70),
+    lv::BenchStep::swipe(CENTER, 40, CENTER, EDGE), lv::BenchStep::wait(70),
+    lv::BenchStep::swipe(EDGE, CENTER, 40, CENTER), lv::BenchStep::wait(70),
+};
+
+int run_bench(const lv::BenchOptions& opts) {
+    static lv::MemoryDisplay<smartwatch::SCREEN_SIZE, smartwatch::SCREEN_SIZE> display;
+    static lv::Bench bench(display);
+    demo.create();
+    return bench.run_script(opts, "smartwatch", kBenchScript) ? 0 : 1;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
     lv::init();
 
+    const lv::BenchOptions bench = lv::bench_options(argc, argv);
+    if (bench.enabled) return run_bench(bench);
+
     // Create display based on available backend (384x384 for smartwatch)
 #if LV_USE_X11
     lv::X11Display display("Smartwatch Demo (C++ Port)", smartwatch::SCREEN_SIZE, smartwatch::SCREEN_SIZE, &lv::cursor_arrow);
@@ -11,6 +11,7 @@
  */
 
 #include <lv/lv.hpp>
+#include <lv/layout/grid_template.hpp>
 #include <lv/assets/cursor.hpp>
 
 static lv::Color get_color(int index) {
@@ -100,13 +101,13 @@ int main() {
     // ========== Example 3: Fixed + Flexible ==========
     lv::Label::create(content).text("3. Fixed + Flexible (80px, 1fr, 80px):");
 
-    // Fixed 80px, flexible, fixed 80px
-    static int32_t col_dsc3[] = {80, lv::Grid::fr(1), 80, lv::Grid::template_last};
-    static int32_t row_dsc3[] = {50, lv::Grid::template_last};
+    // Fixed 80px, flexible, fixed 80px, built at compile time: resizing
+    // recomputes only the flexible column
+    using FixedFlexible = lv::GridTemplate<lv::GridTracks<80, lv::Grid::fr(1), 80>, lv::GridTracks<50>>;
 
     auto grid3 = lv::grid(content)
         .fill_width()
-        .dsc_array(col_dsc3, row_dsc3)
+        .use<FixedFlexible>()
         .gap(4);
 
     const char* labels3[] = {"Fixed", "Flexible", "Fixed"};
@@ -4,7 +4,7 @@
  *
  * Demonstrates:
  * - Static translation tables
- * - Language switching at runtime
+ * - Language switching at runtime, batched with switch_language()
  * - Using lv::tr() for translatable text
  * - Runtime font loading for extended Latin characters
  *
@@ -119,7 +119,7 @@ public:
 
         // Title
         m_title_label = lv::Label::create(content)
-            .text(lv::tr("app_title"))
+            .translated("app_title")
             .text_color(lv::rgb(0x2196F3));  // blue
         if (m_title_font) {
             m_title_label.font(m_title_font.get());
@@ -132,7 +132,7 @@ public:
             .align_items(lv::kFlexAlign::center);
 
         m_language_label = lv::Label::create(lang_row)
-            .text(lv::tr("language"));
+            .translated("language");
 
         m_language_dropdown = lv::Dropdown::create(lang_row)
             .options(g_language_names)
@@ -141,13 +141,13 @@ public:
 
         // Greeting
         m_greeting_label = lv::Label::create(content)
-            .text(lv::tr("greeting"))
+            .translated("greeting")
             .text_color(lv::rgb(0x4CAF50))  // green
             .font(m_title_font ? m_title_font.get() : lv::fonts::montserrat_20);
 
         // Settings section
         m_settings_label = lv::Label::create(content)
-            .text(lv::tr("settings"))
+            .translated("settings")
             .text_color(lv::rgb(0x404040));  // dark gray
 
         // Dark mode row
@@ -158,7 +158,7 @@ public:
             .radius(8)
             .align_items(lv::kFlexAlign::center);
         m_dark_mode_label = lv::Label::create(dark_row)
-            .text(lv::tr("dark_mode"))
+            .translated("dark_mode")
             .grow(1);
         m_dark_mode_switch = lv::Switch::create(dark_row);
 
@@ -170,7 +170,7 @@ public:
             .radius(8)
             .align_items(lv::kFlexAlign::center);
         m_notifications_label = lv::Label::create(notif_row)
-            .text(lv::tr("notifications"))
+            .translated("notifications")
             .grow(1);
         m_notifications_switch = lv::Switch::create(notif_row).on();
 
@@ -183,14 +183,14 @@ public:
             .gap(10)
             .align_items(lv::kFlexAlign::center);
         m_volume_label = lv::Label::create(volume_row)
-            .text(lv::tr("volume"));
+            .translated("volume");
         lv::Slider::create(volume_row)
             .width(150)
             .value(70);
 
         // Welcome message
         m_welcome_label = lv::Label::create(content)
-            .text(lv::tr("welcome_msg"))
+            .translated("welcome_msg")
             .text_color(lv::rgb(0x808080));  // gray
 
         // Buttons row
@@ -235,22 +235,13 @@ private:
 
         const char* lang_codes[] = {"en", "de", "fr", "es"};
         if (selected < 4) {
-            lv::translation::set_language(lang_codes[selected]);
+            // Bound labels are relabelled in one batch
+            lv::translation::switch_language(lang_codes[selected]);
             update_texts();
         }
     }
 
     void update_texts() {
-        // Update all labels with new translations
-        m_title_label.text(lv::tr("app_title"));
-        m_greeting_label.text(lv::tr("greeting"));
-        m_settings_label.text(lv::tr("settings"));
-        m_language_label.text(lv::tr("language"));
-        m_dark_mode_label.text(lv::tr("dark_mode"));
-        m_notifications_label.text(lv::tr("notifications"));
-        m_volume_label.text(lv::tr("volume"));
-        m_welcome_label.text(lv::tr("welcome_msg"));
-
         // Update button labels (set_text updates existing label)
         m_save_btn.set_text(lv::tr("save"));
         m_cancel_btn.set_text(lv::tr("cancel"));
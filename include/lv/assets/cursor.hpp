@@ -2,7 +2,7 @@
 
 /**
  * @file cursor.hpp
- * @brief Simple mouse cursor image for X11 display
+ * @brief Simple mouse cursor image
  *
  * A basic arrow cursor (12x18 pixels, ARGB8888).
  * Use with lv::X11Display:
@@ -11,6 +11,10 @@
  * #include <lv/assets/cursor.hpp>
  * lv::X11Display display("My App", 800, 480, &lv::cursor_arrow);
  * @endcode
+ *
+ * X11Display draws it on the system layer, re-rendered at every move.
+ * SDLDisplay::cursor() and DRMFlipDisplay::cursor() show it as a hardware
+ * cursor instead.
  */
 
 #include <lvgl.h>
@@ -42,6 +42,33 @@ namespace anim_path {
     constexpr anim_path_cb step = lv_anim_path_step;
 } // namespace anim_path
 
+/// How readily an animation gives up frames when rendering is over budget
+enum class AnimPriority : uint8_t {
+    low,     ///< decorative; thinned first
+    normal,  ///< thinned only at the lowest quality
+    high,    ///< never thinned (feedback the user is waiting for)
+};
+
+namespace detail {
+
+/// Start hook installed by lv::anim_governor (nullptr: plain lv_anim_start)
+using anim_start_fn = lv_anim_t* (*)(lv_anim_t* tmpl, AnimPriority prio);
+
+[[nodiscard]] inline anim_start_fn& anim_start_hook() noexcept {
+    static anim_start_fn hook = nullptr;
+    return hook;
+}
+
+/// Installed by core/visibility.hpp: an lv::Anim was started on `var`
+using anim_started_fn = void (*)(void* var, lv_anim_exec_xcb_t exec_cb);
+
+[[nodiscard]] inline anim_started_fn& anim_started_hook() noexcept {
+    static anim_started_fn hook = nullptr;
+    return hook;
+}
+
+} // namespace detail
+
 /**
  * @brief Animation builder with fluent API
  *
@@ -59,6 +86,7 @@ namespace anim_path {
  */
 class Anim {
     lv_anim_t m_anim;
+    AnimPriority m_priority = AnimPriority::normal;
 
 public:
     /// Initialize animation
@@ -427,11 +455,22 @@ public:
         return *this;
     }
 
+    /// Priority under lv::anim_governor (ignored while no governor runs)
+    Anim& priority(AnimPriority p) noexcept {
+        m_priority = p;
+        return *this;
+    }
+
+    [[nodiscard]] AnimPriority priority() const noexcept { return m_priority; }
+
     // ==================== Control ====================
 
     /// Start the animation (returns handle for optional pause/resume/delete)
     lv_anim_t* start() noexcept {
-        return lv_anim_start(&m_anim);
+        detail::anim_start_fn hook = detail::anim_start_hook();
+        lv_anim_t* a = hook ? hook(&m_anim, m_priority) : lv_anim_start(&m_anim);
+        if (detail::anim_started_fn started = detail::anim_started_hook()) started(m_anim.var, m_anim.exec_cb);
+        return a;
     }
 };
 
@@ -0,0 +1,362 @@
+#pragma once
+
+/**
+ * @file anim_batch.hpp
+ * @brief Many property animations evaluated together by one timer
+ *
+ * Every lv_anim_t is a list node with its own timing, path callback and
+ * exec callback, and the animation timer walks the list calling both for
+ * each one. A 300-card entrance is 600 indirect calls per frame before any
+ * property is set. AnimBatch<N> keeps its elements as parallel arrays
+ * (object, property, from, to, delay, duration, easing) and evaluates them
+ * in one pass per tick: progress and easing are plain integer arithmetic
+ * over the arrays (easing is a table lookup), then only the values that
+ * changed are written through the typed setters.
+ *
+ * @code
+ * static lv::AnimBatch<64> entrance;
+ * for (uint32_t i = 0; i < cards; ++i) {
+ *     entrance.add(card[i], lv::AnimProp::translate_y, 40, 0, 300, i * 20);
+ *     entrance.add(card[i], lv::AnimProp::opa, LV_OPA_TRANSP, LV_OPA_COVER, 300, i * 20);
+ * }
+ * entrance.start();                    // start values are applied at once
+ * @endcode
+ *
+ * Easing curves are sampled from LVGL's own path functions into 257-entry
+ * tables on first use, so they match lv_anim_path_* (within table
+ * interpolation). An element whose object is deleted is dropped from the
+ * batch. All calls must be made on the LVGL thread.
+ *
+ * Heap allocation: the timer (created by the first start()) and one
+ * delete-event descriptor per element
+ */
+
+#include <lvgl.h>
+#include <cstdint>
+#include "object.hpp"
+
+namespace lv {
+
+/// Property an AnimBatch element drives
+enum class AnimProp : uint8_t {
+    translate_x,
+    translate_y,
+    opa,
+    scale,          ///< Uniform transform scale (256 = 100%)
+    rotation,       ///< Transform rotation (0.1 degree units)
+    x,
+    y,
+    width,
+    height,
+    arc_value,      ///< lv_arc_set_value() (needs LV_USE_ARC)
+    arc_end_angle,  ///< lv_arc_set_end_angle() (needs LV_USE_ARC)
+};
+
+/// Easing of an AnimBatch element (the lv_anim_path_* curve of the same name)
+enum class Ease : uint8_t {
+    linear,
+    ease_in,
+    ease_out,
+    ease_in_out,
+    overshoot,
+    bounce,
+    step,
+};
+
+namespace detail {
+
+inline constexpr uint32_t EASE_CURVES = 7;
+inline constexpr uint32_t EASE_STEPS = 256;      ///< Table segments; entries are 0..1024 (more past the end for overshoot)
+
+struct EaseTables {
+    int16_t lut[EASE_CURVES][EASE_STEPS + 1];
+};
+
+/// Easing tables sampled from the LVGL path functions (built on first use)
+[[nodiscard]] inline const EaseTables& ease_tables() noexcept {
+    static EaseTables t = [] {
+        EaseTables e{};
+        const lv_anim_path_cb_t paths[EASE_CURVES] = {
+            lv_anim_path_linear, lv_anim_path_ease_in, lv_anim_path_ease_out, lv_anim_path_ease_in_out,
+            lv_anim_path_overshoot, lv_anim_path_bounce, lv_anim_path_step,
+        };
+        lv_anim_t a;
+        lv_anim_init(&a);
+        lv_anim_set_values(&a, 0, 1024);
+        lv_anim_set_duration(&a, EASE_STEPS);
+        for (uint32_t c = 0; c < EASE_CURVES; ++c) {
+            for (uint32_t i = 0; i <= EASE_STEPS; ++i) {
+                a.act_time = static_cast<int32_t>(i);
+                e.lut[c][i] = static_cast<int16_t>(paths[c](&a));
+            }
+        }
+        return e;
+    }();
+    return t;
+}
+
+/// Eased progress of `t` ms into `d` ms: 0..1024 (beyond for overshoot), interpolated between table steps
+[[nodiscard]] inline int32_t ease_progress(const EaseTables& tables, uint8_t ease, uint32_t t, uint32_t d) noexcept {
+    const uint32_t clamped = t < d ? t : d;
+    // Position in the table in 1/256 steps
+    const uint32_t pos = d ? static_cast<uint32_t>((static_cast<uint64_t>(clamped) * EASE_STEPS * 256) / d)
+                           : EASE_STEPS * 256;
+    const uint32_t idx = pos >> 8;
+    const int32_t frac = static_cast<int32_t>(pos & 255);
+    const int16_t* lut = tables.lut[ease];
+    const int32_t lo = lut[idx];
+    const int32_t hi = lut[idx < EASE_STEPS ? idx + 1 : idx];
+    return lo + (((hi - lo) * frac) >> 8);
+}
+
+/// Write `v` to `prop` of `obj` through the typed setter
+inline void anim_apply(lv_obj_t* obj, AnimProp prop, int32_t v) noexcept {
+    switch (prop) {
+        case AnimProp::translate_x: lv_obj_set_style_translate_x(obj, v, 0); break;
+        case AnimProp::translate_y: lv_obj_set_style_translate_y(obj, v, 0); break;
+        case AnimProp::opa:
+            lv_obj_set_style_opa(obj, static_cast<lv_opa_t>(v < 0 ? 0 : v > 255 ? 255 : v), 0);
+            break;
+        case AnimProp::scale: lv_obj_set_style_transform_scale(obj, v, 0); break;
+        case AnimProp::rotation: lv_obj_set_style_transform_rotation(obj, v, 0); break;
+        case AnimProp::x: lv_obj_set_x(obj, v); break;
+        case AnimProp::y: lv_obj_set_y(obj, v); break;
+        case AnimProp::width: lv_obj_set_width(obj, v); break;
+        case AnimProp::height: lv_obj_set_height(obj, v); break;
+#if LV_USE_ARC
+        case AnimProp::arc_value: lv_arc_set_value(obj, v); break;
+        case AnimProp::arc_end_angle: lv_arc_set_end_angle(obj, v); break;
+#endif
+        default: break;
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Fixed-capacity set of property animations sharing one timer
+ *
+ * Time is measured from start() for all elements; give each one a delay
+ * to stagger them. Non-movable: the timer and delete events keep a
+ * pointer to it.
+ *
+ * @tparam N Maximum number of elements
+ */
+template<uint32_t N>
+class AnimBatch {
+public:
+    struct Stats {
+        uint32_t ticks = 0;       ///< Timer passes
+        uint32_t applied = 0;     ///< Property writes
+        uint32_t skipped = 0;     ///< Evaluations whose value did not change
+    };
+
+private:
+    // Structure of arrays: the evaluation pass touches only the timing and value columns
+    lv_obj_t* m_obj[N];
+    int32_t m_from[N];
+    int32_t m_delta[N];
+    uint32_t m_delay[N];
+    uint32_t m_duration[N];
+    uint8_t m_ease[N];
+    AnimProp m_prop[N];
+    int32_t m_value[N];
+    int32_t m_applied[N];
+
+    uint32_t m_count = 0;
+    uint32_t m_t0 = 0;
+    bool m_running = false;
+    lv_timer_t* m_timer = nullptr;
+    void (*m_on_done)(void*) = nullptr;
+    void* m_done_ctx = nullptr;
+    Stats m_stats;
+
+    /**
+     * @brief Evaluate every element at `elapsed` ms and write the changed values
+     * @return Elements still running
+     */
+    uint32_t evaluate(uint32_t elapsed) noexcept {
+        const detail::EaseTables& tables = detail::ease_tables();
+        uint32_t active = 0;
+
+        // Pass 1: timing and easing only, no calls
+        for (uint32_t i = 0; i < m_count; ++i) {
+            const uint32_t t = elapsed > m_delay[i] ? elapsed - m_delay[i] : 0;
+            active += t < m_duration[i] ? 1u : 0u;
+            const int32_t eased = detail::ease_progress(tables, m_ease[i], t, m_duration[i]);
+            m_value[i] = m_from[i] + static_cast<int32_t>((static_cast<int64_t>(m_delta[i]) * eased) >> 10);
+        }
+
+        // Pass 2: write what changed
+        for (uint32_t i = 0; i < m_count; ++i) {
+            if (!m_obj[i] || m_value[i] == m_applied[i]) {
+                ++m_stats.skipped;
+                continue;
+            }
+            m_applied[i] = m_value[i];
+            detail::anim_apply(m_obj[i], m_prop[i], m_value[i]);
+            ++m_stats.applied;
+        }
+        return active;
+    }
+
+    void tick() noexcept {
+        ++m_stats.ticks;
+        if (evaluate(lv_tick_elaps(m_t0)) == 0) {
+            m_running = false;
+            lv_timer_pause(m_timer);
+            if (m_on_done) m_on_done(m_done_ctx);
+        }
+    }
+
+    static void timer_cb(lv_timer_t* t) noexcept {
+        static_cast<AnimBatch*>(lv_timer_get_user_data(t))->tick();
+    }
+
+    /// An animated object is being deleted: stop touching it
+    static void delete_cb(lv_event_t* e) noexcept {
+        auto* self = static_cast<AnimBatch*>(lv_event_get_user_data(e));
+        auto* obj = static_cast<lv_obj_t*>(lv_event_get_current_target(e));
+        for (uint32_t i = 0; i < self->m_count; ++i) {
+            if (self->m_obj[i] == obj) self->m_obj[i] = nullptr;
+        }
+    }
+
+    /// Remove the delete hooks (once per object, which may have several elements)
+    void unhook() noexcept {
+        for (uint32_t i = 0; i < m_count; ++i) {
+            lv_obj_t* obj = m_obj[i];
+            if (!obj) continue;
+            lv_obj_remove_event_cb_with_user_data(obj, &AnimBatch::delete_cb, this);
+            for (uint32_t j = i + 1; j < m_count; ++j) {
+                if (m_obj[j] == obj) m_obj[j] = nullptr;
+            }
+        }
+    }
+
+public:
+    AnimBatch() noexcept = default;
+
+    ~AnimBatch() {
+        unhook();
+        if (m_timer) lv_timer_delete(m_timer);
+    }
+
+    AnimBatch(const AnimBatch&) = delete;
+    AnimBatch& operator=(const AnimBatch&) = delete;
+
+    // ==================== Elements ====================
+
+    /**
+     * @brief Animate `prop` of `obj` from `from` to `to`
+     *
+     * @param duration Length of the transition in ms
+     * @param delay Time after start() before it begins (its start value is shown meanwhile)
+     * @return Element index, or UINT32_MAX if the batch is full
+     */
+    uint32_t add(ObjectView obj, AnimProp prop, int32_t from, int32_t to, uint32_t duration,
+                 uint32_t delay = 0, Ease ease = Ease::ease_out) noexcept {
+        if (m_count == N) {
+            LV_LOG_WARN("AnimBatch: full (%u elements)", static_cast<unsigned>(N));
+            return UINT32_MAX;
+        }
+        const uint32_t i = m_count;
+        bool hooked = false;
+        for (uint32_t j = 0; j < m_count && !hooked; ++j) hooked = m_obj[j] == obj.get();
+        if (!hooked) lv_obj_add_event_cb(obj.get(), &AnimBatch::delete_cb, LV_EVENT_DELETE, this);
+        m_obj[i] = obj.get();
+        m_prop[i] = prop;
+        m_from[i] = from;
+        m_delta[i] = to - from;
+        m_duration[i] = duration;
+        m_delay[i] = delay;
+        m_ease[i] = static_cast<uint8_t>(ease);
+        m_applied[i] = INT32_MIN;     // nothing written yet
+        ++m_count;
+        return i;
+    }
+
+    /**
+     * @brief Delay element i by `first + (i / group) * step` ms (a staggered entrance)
+     *
+     * `group` is the number of consecutive elements per object (2 when
+     * each card gets a translate and an opa element).
+     */
+    AnimBatch& stagger(uint32_t step, uint32_t first = 0, uint32_t group = 1) noexcept {
+        if (group == 0) group = 1;
+        for (uint32_t i = 0; i < m_count; ++i) m_delay[i] = first + (i / group) * step;
+        return *this;
+    }
+
+    /// Swap start and end of every element (play the same batch backwards)
+    AnimBatch& reverse() noexcept {
+        for (uint32_t i = 0; i < m_count; ++i) {
+            m_from[i] += m_delta[i];
+            m_delta[i] = -m_delta[i];
+        }
+        return *this;
+    }
+
+    /// Stop and drop every element
+    void clear() noexcept {
+        stop();
+        unhook();
+        m_count = 0;
+    }
+
+    // ==================== Playback ====================
+
+    /// Apply every start value now and run the batch from t = 0
+    void start() noexcept {
+        if (!m_timer) {
+            m_timer = lv_timer_create(&AnimBatch::timer_cb, LV_DEF_REFR_PERIOD, this);
+            if (!m_timer) return;
+        }
+        for (uint32_t i = 0; i < m_count; ++i) m_applied[i] = INT32_MIN;
+        m_t0 = lv_tick_get();
+        m_running = true;
+        evaluate(0);
+        lv_timer_resume(m_timer);
+    }
+
+    /// Stop where it is (values stay as last applied; no done callback)
+    void stop() noexcept {
+        m_running = false;
+        if (m_timer) lv_timer_pause(m_timer);
+    }
+
+    /// Jump to the end: apply every end value and call the done callback
+    void finish() noexcept {
+        if (!m_running) return;
+        uint32_t end = 0;
+        for (uint32_t i = 0; i < m_count; ++i) {
+            if (m_delay[i] + m_duration[i] > end) end = m_delay[i] + m_duration[i];
+        }
+        m_running = false;
+        if (m_timer) lv_timer_pause(m_timer);
+        evaluate(end);
+        if (m_on_done) m_on_done(m_done_ctx);
+    }
+
+    /// Call `(obj->*MemFn)()` when every element has reached its end value
+    template<auto MemFn, typename T>
+    AnimBatch& on_done(T* obj) noexcept {
+        m_done_ctx = obj;
+        m_on_done = [](void* ctx) { (static_cast<T*>(ctx)->*MemFn)(); };
+        return *this;
+    }
+
+    // ==================== State ====================
+
+    [[nodiscard]] bool running() const noexcept { return m_running; }
+    [[nodiscard]] uint32_t size() const noexcept { return m_count; }
+    [[nodiscard]] static constexpr uint32_t capacity() noexcept { return N; }
+
+    /// Last value computed for element `i`
+    [[nodiscard]] int32_t value(uint32_t i) const noexcept { return i < m_count ? m_value[i] : 0; }
+
+    [[nodiscard]] const Stats& stats() const noexcept { return m_stats; }
+    void reset_stats() noexcept { m_stats = {}; }
+};
+
+} // namespace lv
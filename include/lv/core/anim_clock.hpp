@@ -0,0 +1,317 @@
+#pragma once
+
+/**
+ * @file anim_clock.hpp
+ * @brief One clock for GIF, Lottie and AnimImage playback, ticked at each display refresh
+ *
+ * Every lv_gif has its own 10 ms timer that decodes and invalidates when
+ * a frame is due, so ten animated icons mean ten timer callbacks whose
+ * invalidations land in different refreshes. AnimationClock pauses the
+ * timers of the GIFs added to it and runs their frame step itself, all
+ * in one pass at the display's LV_EVENT_REFR_START. Their invalidations
+ * then join the refresh that is starting. Lottie and AnimImage already
+ * advance in LVGL's single animation timer pass, so the clock only pauses
+ * and resumes their animations:
+ *
+ * @code
+ * #include <lv/core/anim_clock.hpp>
+ *
+ * auto& clock = lv::AnimationClock::shared().attach(lv_display_get_default());
+ * clock.add(lv::GIF(row).src("A:/icons/fan.gif"));
+ * clock.add(lottie);
+ * clock.add(walker);                 // lv::AnimImage
+ * ...
+ * clock.pause();                     // all of them, e.g. while the display sleeps
+ * @endcode
+ *
+ * Media on a screen that is not the active one (nor on the top or system
+ * layer) are skipped, and their animations paused until it is loaded
+ * again, without any setup per screen. GIF::pause() does not stop a GIF
+ * the clock drives; use pause(media). A media object leaves the clock
+ * when it is deleted; remove() hands a GIF back to its own timer.
+ *
+ * Not included by lv.hpp: it pauses and steps GIFs through lv_gif_t::timer
+ * and lv_timer_t's callback and paused flag, none of which is public.
+ * Checked against LVGL 9.4 (see LV_CPP_INTERNALS_OK).
+ *
+ * Heap allocation: NONE (LV_CPP_ANIM_CLOCK_MEDIA fixed slots)
+ */
+
+#include <lvgl.h>
+#include "version.hpp"
+
+#if !LV_CPP_INTERNALS_OK
+#error "anim_clock.hpp reads LVGL internals checked against LVGL 9.4; see LV_CPP_INTERNALS_OK"
+#endif
+
+#include <src/misc/lv_timer_private.h>   // lv_timer_t::timer_cb, paused
+#include <cstdint>
+#include <new>
+#include "object.hpp"
+
+#if LV_USE_GIF
+#include <src/libs/gif/lv_gif_private.h>   // lv_gif_t::timer
+#endif
+
+#ifndef LV_CPP_ANIM_CLOCK_MEDIA
+/// Media objects one AnimationClock drives
+#define LV_CPP_ANIM_CLOCK_MEDIA 32
+#endif
+
+namespace lv {
+
+/**
+ * @brief Advances the GIFs added to it together at refresh start; pauses media off screen
+ */
+class AnimationClock {
+public:
+    struct Stats {
+        uint32_t ticks = 0;      ///< Refresh starts seen
+        uint32_t steps = 0;      ///< GIF frame steps run
+        uint32_t skipped = 0;    ///< Media skipped or paused because they were off screen or paused
+        uint32_t media = 0;      ///< Media on the clock now
+    };
+
+private:
+    enum class Kind : uint8_t { gif, lottie, animimg };
+
+    struct Media {
+        lv_obj_t* obj = nullptr;
+        Kind kind = Kind::gif;
+        bool held = false;       ///< pause(media)
+        bool parked = false;     ///< Animation paused by the clock
+        bool done = false;       ///< GIF played its last loop
+    };
+
+    Media m_media[LV_CPP_ANIM_CLOCK_MEDIA];
+    uint32_t m_count = 0;
+    lv_display_t* m_disp = nullptr;
+    bool m_paused = false;
+    Stats m_stats;
+
+    AnimationClock() noexcept = default;
+
+    [[nodiscard]] Media* find(const lv_obj_t* obj) noexcept {
+        for (uint32_t i = 0; i < m_count; ++i) {
+            if (m_media[i].obj == obj) return &m_media[i];
+        }
+        return nullptr;
+    }
+
+    [[nodiscard]] static bool kind_of(const lv_obj_t* obj, Kind& kind) noexcept {
+#if LV_USE_GIF
+        if (lv_obj_check_type(obj, &lv_gif_class)) {
+            kind = Kind::gif;
+            return true;
+        }
+#endif
+#if LV_USE_LOTTIE
+        if (lv_obj_check_type(obj, &lv_lottie_class)) {
+            kind = Kind::lottie;
+            return true;
+        }
+#endif
+#if LV_USE_ANIMIMG
+        if (lv_obj_check_type(obj, &lv_animimg_class)) {
+            kind = Kind::animimg;
+            return true;
+        }
+#endif
+        (void)obj;
+        (void)kind;
+        return false;
+    }
+
+    [[nodiscard]] static lv_anim_t* anim_of(const Media& m) noexcept {
+#if LV_USE_LOTTIE
+        if (m.kind == Kind::lottie) return lv_lottie_get_anim(m.obj);
+#endif
+#if LV_USE_ANIMIMG
+        if (m.kind == Kind::animimg) return lv_animimg_get_anim(m.obj);
+#endif
+        (void)m;
+        return nullptr;
+    }
+
+#if LV_USE_GIF
+    [[nodiscard]] static lv_timer_t* timer_of(const Media& m) noexcept {
+        return reinterpret_cast<lv_gif_t*>(m.obj)->timer;
+    }
+#endif
+
+    /// Give the media back to LVGL's own scheduling
+    static void release(Media& m) noexcept {
+#if LV_USE_GIF
+        if (m.kind == Kind::gif) {
+            if (lv_timer_t* t = timer_of(m); t && !m.done && !m.held) lv_timer_resume(t);
+            return;
+        }
+#endif
+        if (lv_anim_t* a = anim_of(m); a && m.parked) lv_anim_resume(a);
+        m.parked = false;
+    }
+
+    void erase(Media* m) noexcept {
+        *m = m_media[--m_count];
+        m_media[m_count] = Media{};
+        m_stats.media = m_count;
+    }
+
+    [[nodiscard]] bool on_screen(const lv_obj_t* obj, const lv_obj_t* active) const noexcept {
+        const lv_obj_t* scr = lv_obj_get_screen(obj);
+        return scr == active || scr == lv_display_get_layer_top(m_disp) || scr == lv_display_get_layer_sys(m_disp);
+    }
+
+    void tick() noexcept {
+        ++m_stats.ticks;
+        const lv_obj_t* active = lv_display_get_screen_active(m_disp);
+        for (uint32_t i = 0; i < m_count; ++i) {
+            Media& m = m_media[i];
+            const bool run = !m_paused && !m.held && on_screen(m.obj, active);
+            m_stats.skipped += !run;
+#if LV_USE_GIF
+            if (m.kind == Kind::gif) {
+                lv_timer_t* t = timer_of(m);
+                if (!t) continue;
+                if (!t->paused) {            // src() or restart() started it again
+                    m.done = false;
+                    lv_timer_pause(t);
+                }
+                if (!run || m.done) continue;
+                lv_timer_resume(t);          // the step pauses it after the last loop
+                t->timer_cb(t);
+                if (t->paused) {
+                    m.done = true;
+                } else {
+                    lv_timer_pause(t);
+                }
+                ++m_stats.steps;
+                continue;
+            }
+#endif
+            lv_anim_t* a = anim_of(m);
+            if (!a) continue;
+            if (!run && !m.parked && !lv_anim_is_paused(a)) {
+                lv_anim_pause(a);
+                m.parked = true;
+            } else if (run && m.parked) {
+                lv_anim_resume(a);
+                m.parked = false;
+            }
+        }
+    }
+
+    static void refr_start_cb(lv_event_t* e) noexcept {
+        static_cast<AnimationClock*>(lv_event_get_user_data(e))->tick();
+    }
+
+    static void delete_cb(lv_event_t* e) noexcept {
+        auto* self = static_cast<AnimationClock*>(lv_event_get_user_data(e));
+        if (Media* m = self->find(lv_event_get_current_target_obj(e))) self->erase(m);
+    }
+
+public:
+    AnimationClock(const AnimationClock&) = delete;
+    AnimationClock& operator=(const AnimationClock&) = delete;
+
+    /// The shared clock (never destroyed)
+    [[nodiscard]] static AnimationClock& shared() noexcept {
+        alignas(AnimationClock) static unsigned char storage[sizeof(AnimationClock)];
+        static AnimationClock* clock = new (storage) AnimationClock();
+        return *clock;
+    }
+
+    // ==================== Display ====================
+
+    /// Tick at every refresh start of `disp`
+    AnimationClock& attach(lv_display_t* disp) noexcept {
+        if (!disp) return *this;
+        detach();
+        m_disp = disp;
+        lv_display_add_event_cb(disp, &refr_start_cb, LV_EVENT_REFR_START, this);
+        return *this;
+    }
+
+    /// Stop ticking and hand every media back to LVGL
+    AnimationClock& detach() noexcept {
+        if (m_disp) lv_display_remove_event_cb_with_user_data(m_disp, &refr_start_cb, this);
+        m_disp = nullptr;
+        while (m_count > 0) remove(ObjectView(m_media[m_count - 1].obj));
+        return *this;
+    }
+
+    // ==================== Media ====================
+
+    /**
+     * @brief Drive a GIF, Lottie or AnimImage object from the clock
+     *
+     * @return false for other objects, when already added, without a
+     *         display or with all LV_CPP_ANIM_CLOCK_MEDIA slots taken
+     */
+    bool add(ObjectView media) noexcept {
+        lv_obj_t* obj = media.get();
+        if (!obj || !m_disp || find(obj)) return false;
+        Media m;
+        m.obj = obj;
+        if (!kind_of(obj, m.kind)) return false;
+        if (m_count == LV_CPP_ANIM_CLOCK_MEDIA) {
+            LV_LOG_WARN("AnimationClock full, raise LV_CPP_ANIM_CLOCK_MEDIA");
+            return false;
+        }
+        m_media[m_count++] = m;
+        m_stats.media = m_count;
+        lv_obj_add_event_cb(obj, &delete_cb, LV_EVENT_DELETE, this);
+#if LV_USE_GIF
+        if (m.kind == Kind::gif) {
+            if (lv_timer_t* t = timer_of(m)) lv_timer_pause(t);
+        }
+#endif
+        return true;
+    }
+
+    /// Hand `media` back to its own timer or animation
+    void remove(ObjectView media) noexcept {
+        Media* m = find(media.get());
+        if (!m) return;
+        lv_obj_remove_event_cb_with_user_data(m->obj, &delete_cb, this);
+        release(*m);
+        erase(m);
+    }
+
+    [[nodiscard]] bool contains(ObjectView media) noexcept { return find(media.get()) != nullptr; }
+
+    // ==================== Playback ====================
+
+    /// Stop every media on the clock
+    AnimationClock& pause() noexcept {
+        m_paused = true;
+        return *this;
+    }
+
+    AnimationClock& resume() noexcept {
+        m_paused = false;
+        return *this;
+    }
+
+    [[nodiscard]] bool paused() const noexcept { return m_paused; }
+
+    /// Stop one media while the others play
+    AnimationClock& pause(ObjectView media) noexcept {
+        if (Media* m = find(media.get())) m->held = true;
+        return *this;
+    }
+
+    AnimationClock& resume(ObjectView media) noexcept {
+        if (Media* m = find(media.get())) m->held = false;
+        return *this;
+    }
+
+    [[nodiscard]] const Stats& stats() const noexcept { return m_stats; }
+
+    void reset_stats() noexcept {
+        m_stats = Stats{};
+        m_stats.media = m_count;
+    }
+};
+
+} // namespace lv
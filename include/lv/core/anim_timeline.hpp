@@ -20,6 +20,10 @@
  *   .repeat_infinite()
  *   .start();
  * @endcode
+ *
+ * For fixed choreography that is scrubbed or played backwards, a constant
+ * lv::Keyframes description and a KeyframePlayer (keyframes.hpp) avoid
+ * the per-segment lv_anim_t copies.
  */
 
 #include <lvgl.h>
@@ -9,6 +9,9 @@
 
 #include <lvgl.h>
 #include <cstdint>
+#include "async.hpp"
+#include "thread.hpp"
+#include "startup.hpp"
 
 #ifdef __unix__
 #include <unistd.h>
@@ -18,15 +21,105 @@
 #include <windows.h>
 #endif
 
+#ifndef LV_CPP_IDLE_MIN_SLACK_MS
+/// tick() runs the idle handler only when the next timer is at least this far away
+#define LV_CPP_IDLE_MIN_SLACK_MS 4
+#endif
+
+#ifndef LV_CPP_IDLE_MAX_SLICE_MS
+/// Longest time slice handed to the idle handlers per tick()
+#define LV_CPP_IDLE_MAX_SLICE_MS 8
+#endif
+
+#ifndef LV_CPP_IDLE_HANDLERS
+/// Idle handlers installed at once
+#define LV_CPP_IDLE_HANDLERS 4
+#endif
+
 namespace lv {
 
+/// Background work run from tick() in timer slack; returns true while work is left
+using IdleFn = bool (*)(uint32_t budget_ms);
+
+namespace detail {
+struct IdleSlots {
+    IdleFn fns[LV_CPP_IDLE_HANDLERS] = {};
+    uint8_t first = 0;   ///< round-robin start, so one busy handler cannot starve the rest
+};
+
+[[nodiscard]] inline IdleSlots& idle_slots() noexcept {
+    static IdleSlots slots;
+    return slots;
+}
+
+/// Run the installed handlers for up to `slice` ms in total
+inline void run_idle_handlers(uint32_t slice) noexcept {
+    IdleSlots& s = idle_slots();
+    const uint32_t start = lv_tick_get();
+    const uint8_t first = s.first;
+    s.first = static_cast<uint8_t>((first + 1) % LV_CPP_IDLE_HANDLERS);
+    for (uint8_t i = 0; i < LV_CPP_IDLE_HANDLERS; ++i) {
+        const IdleFn fn = s.fns[(first + i) % LV_CPP_IDLE_HANDLERS];
+        if (!fn) continue;
+        const uint32_t spent = lv_tick_elaps(start);
+        if (spent >= slice) break;
+        fn(slice - spent);
+    }
+}
+} // namespace detail
+
+/**
+ * @brief Install an idle handler (no-op if already installed)
+ *
+ * lv::prefetch and the frame decode-ahead caches install themselves here
+ * when they have work. nullptr removes all handlers.
+ *
+ * @return false if all LV_CPP_IDLE_HANDLERS slots are taken
+ */
+inline bool idle_handler(IdleFn fn) noexcept {
+    detail::IdleSlots& s = detail::idle_slots();
+    if (!fn) {
+        for (IdleFn& f : s.fns) f = nullptr;
+        return true;
+    }
+    IdleFn* free_slot = nullptr;
+    for (IdleFn& f : s.fns) {
+        if (f == fn) return true;
+        if (!f && !free_slot) free_slot = &f;
+    }
+    if (!free_slot) {
+        LV_LOG_WARN("idle handler slots exhausted, raise LV_CPP_IDLE_HANDLERS");
+        return false;
+    }
+    *free_slot = fn;
+    return true;
+}
+
+/// Remove an idle handler installed with idle_handler()
+inline void remove_idle_handler(IdleFn fn) noexcept {
+    for (IdleFn& f : detail::idle_slots().fns) {
+        if (f == fn) f = nullptr;
+    }
+}
+
+/// True if any idle handler is installed
+[[nodiscard]] inline bool has_idle_handlers() noexcept {
+    for (IdleFn f : detail::idle_slots().fns) {
+        if (f) return true;
+    }
+    return false;
+}
+
 /**
  * @brief Initialize LVGL
  *
- * Must be called before creating any displays or widgets.
+ * Must be called before creating any displays or widgets. The calling
+ * thread becomes the UI thread checked by lv::ui_thread().
  */
 inline void init() noexcept {
     lv_init();
+    mark_ui_thread();
+    startup::mark(startup::Phase::init);
 }
 
 /**
@@ -56,12 +149,33 @@ inline void sleep_ms(uint32_t ms) noexcept {
 /**
  * @brief Run one iteration of the main loop
  *
- * Processes LVGL timers and returns time until next call needed.
+ * Runs callables posted from other threads via lv::post() and applies
+ * State::set_from_any_thread() values (holding the LVGL lock, as threaded
+ * builds render concurrently), then processes LVGL
+ * timers and returns time until next call needed. When the next timer is
+ * at least LV_CPP_IDLE_MIN_SLACK_MS away, the idle handlers share the slack
+ * (at most LV_CPP_IDLE_MAX_SLICE_MS) and their time is deducted.
  *
  * @return Milliseconds until next call needed
  */
 inline uint32_t tick() noexcept {
-    return lv_timer_handler();
+    {
+        LockGuard lock;
+        dispatcher().drain();
+        detail::drain_pending();
+    }
+    uint32_t next = lv_timer_handler();
+    if (next >= LV_CPP_IDLE_MIN_SLACK_MS && has_idle_handlers()) {
+        const uint32_t slice = next - 1 < LV_CPP_IDLE_MAX_SLICE_MS ? next - 1 : LV_CPP_IDLE_MAX_SLICE_MS;
+        const uint32_t start = lv_tick_get();
+        {
+            LockGuard lock;
+            detail::run_idle_handlers(slice);
+        }
+        const uint32_t spent = lv_tick_elaps(start);
+        next = next > spent ? next - spent : 0;
+    }
+    return next;
 }
 
 /**
@@ -80,7 +194,7 @@ inline uint32_t tick() noexcept {
  */
 [[noreturn]] inline void run() noexcept {
     while (true) {
-        uint32_t time_till_next = lv_timer_handler();
+        uint32_t time_till_next = tick();
         sleep_ms(time_till_next);
     }
 }
@@ -104,7 +218,7 @@ inline uint32_t tick() noexcept {
 template<typename F>
 inline void run_with(F&& on_tick) {
     while (on_tick()) {
-        uint32_t time_till_next = lv_timer_handler();
+        uint32_t time_till_next = tick();
         sleep_ms(time_till_next);
     }
 }
@@ -116,7 +230,7 @@ inline void run_with(F&& on_tick) {
  */
 inline void run_for(uint32_t max_iterations) noexcept {
     for (uint32_t i = 0; i < max_iterations; ++i) {
-        uint32_t time_till_next = lv_timer_handler();
+        uint32_t time_till_next = tick();
         sleep_ms(time_till_next);
     }
 }
@@ -138,7 +252,10 @@ inline void run_for(uint32_t max_iterations) noexcept {
  */
 class InitGuard {
 public:
-    InitGuard() noexcept { lv_init(); }
+    InitGuard() noexcept {
+        lv_init();
+        mark_ui_thread();
+    }
     ~InitGuard() { lv_deinit(); }
 
     // Non-copyable, non-movable
@@ -0,0 +1,305 @@
+#pragma once
+
+/**
+ * @file asset_pack.hpp
+ * @brief One mapped file holding a product's images, fonts and translations
+ *
+ * scripts/asset_pack.py bundles generated image arrays (the demos'
+ * generated .c files), LVGL .bin images, PNGs, lv_binfont fonts and lv_i18n
+ * YAML translations into one .lap file: a table of contents sorted by name
+ * hash, the names, then the assets. AssetPack maps it once with fs::MappedFile and serves
+ * every asset from the mapping:
+ *
+ * @code
+ * static lv::AssetPack assets("A:/data/ebike.lap");   // one open, no copies
+ * static lv::MappedFont body;
+ * static lv::translation::BinaryPack texts;
+ *
+ * assets.font("inter_14", body);
+ * assets.translations("ebike", texts);
+ * texts.use();
+ * lv::Image::create(screen).src(assets.image("bg"));
+ * label.text_font(body);
+ * @endcode
+ *
+ * Lookups are a binary search over 32-bit FNV-1a name hashes (the packer
+ * refuses colliding names), so asset_hash("bg") can be computed at compile
+ * time and passed instead of the name. Images are stored as LVGL .bin
+ * images in the display's color format (--color-format), with the pixel
+ * data aligned to the pack's alignment (LV_DRAW_BUF_ALIGN by default), so
+ * they draw straight from the mapping. Their descriptors live in the pack
+ * (LV_CPP_ASSET_PACK_IMAGES of them), since image objects keep a pointer.
+ *
+ * An OTA update replaces the file; close() the fonts and translation
+ * packs opened from it, then reopen the pack. Not movable: descriptors
+ * and fonts point into it.
+ *
+ * Heap allocation: NONE when mapped (a pooled copy of the file otherwise);
+ * fonts allocate their glyph tables, see mapped_font.hpp
+ */
+
+#include <lvgl.h>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include "mapped_file.hpp"
+#include "mapped_font.hpp"
+#include "translation_pack.hpp"
+
+#ifndef LV_CPP_ASSET_PACK_IMAGES
+/// Image descriptors one AssetPack hands out
+#define LV_CPP_ASSET_PACK_IMAGES 32
+#endif
+
+namespace lv {
+
+/// What an asset holds (set by the packer from the input type)
+enum class AssetKind : uint8_t {
+    raw = 0,            ///< Bytes as given (JSON, Lottie, sounds...)
+    image = 1,          ///< LVGL .bin image: lv_image_header_t, then the pixels
+    font = 2,           ///< lv_binfont
+    translations = 3,   ///< translation::BinaryPack (.ltp)
+};
+
+/// One asset, pointing into the pack
+struct Asset {
+    AssetKind kind = AssetKind::raw;
+    const uint8_t* data = nullptr;
+    uint32_t size = 0;
+
+    explicit operator bool() const noexcept { return data != nullptr; }
+};
+
+/// 32-bit FNV-1a of an asset name, as stored by scripts/asset_pack.py
+[[nodiscard]] constexpr uint32_t asset_hash(std::string_view name) noexcept {
+    uint32_t h = 0x811C9DC5u;
+    for (char c : name) {
+        h = (h ^ static_cast<uint8_t>(c)) * 0x01000193u;
+    }
+    return h;
+}
+
+namespace detail::apack {
+
+inline constexpr char magic[4] = {'L', 'V', 'A', 'P'};
+
+/// File header; followed by `count` Entry records sorted by hash, then the
+/// NUL-terminated names (`names_size` bytes) and the asset data
+struct Head {
+    char magic[4];
+    uint16_t version;
+    uint16_t align;         ///< Alignment of image pixel data, in bytes
+    uint32_t count;
+    uint32_t names_size;
+};
+static_assert(sizeof(Head) == 16, "asset pack header must be packed");
+
+struct Entry {
+    uint32_t hash;          ///< asset_hash() of the name
+    uint8_t kind;           ///< AssetKind
+    uint8_t reserved[3];
+    uint32_t name;          ///< Offset into the name table
+    uint32_t offset;        ///< From the start of the pack
+    uint32_t length;
+};
+static_assert(sizeof(Entry) == 20, "asset pack entry must be packed");
+
+} // namespace detail::apack
+
+/**
+ * @brief Mapped .lap asset pack (scripts/asset_pack.py)
+ */
+class AssetPack {
+    struct ImageSlot {
+        uint32_t hash;
+        lv_image_dsc_t dsc;
+    };
+
+    fs::MappedFile m_file;
+    const uint8_t* m_data = nullptr;
+    detail::apack::Head m_head{};
+    const uint8_t* m_toc = nullptr;
+    const char* m_names = nullptr;
+    ImageSlot m_images[LV_CPP_ASSET_PACK_IMAGES] = {};
+    uint32_t m_image_count = 0;
+
+    [[nodiscard]] detail::apack::Entry entry(uint32_t i) const noexcept {
+        detail::apack::Entry e;
+        std::memcpy(&e, m_toc + sizeof(e) * i, sizeof(e));
+        return e;
+    }
+
+    /// Check the layout: entries sorted, names and data inside the file
+    [[nodiscard]] bool parse(const uint8_t* data, size_t size) noexcept {
+        namespace ap = detail::apack;
+        if (size < sizeof(ap::Head)) return false;
+        std::memcpy(&m_head, data, sizeof(m_head));
+        if (std::memcmp(m_head.magic, ap::magic, sizeof(ap::magic)) != 0 || m_head.version != 1) return false;
+        const uint64_t names_end = sizeof(ap::Head) + uint64_t(sizeof(ap::Entry)) * m_head.count + m_head.names_size;
+        if (names_end > size || (m_head.names_size && data[names_end - 1] != '\0')) return false;
+        m_toc = data + sizeof(ap::Head);
+        m_names = reinterpret_cast<const char*>(m_toc + sizeof(ap::Entry) * m_head.count);
+        for (uint32_t i = 0; i < m_head.count; ++i) {
+            const ap::Entry e = entry(i);
+            if (i > 0 && entry(i - 1).hash >= e.hash) return false;
+            if (e.name >= m_head.names_size || e.offset < names_end || e.offset > size || e.length > size - e.offset) {
+                return false;
+            }
+        }
+        m_data = data;
+        return true;
+    }
+
+    /// Index of `hash` in the table of contents, or -1
+    [[nodiscard]] int32_t index_of(uint32_t hash) const noexcept {
+        uint32_t lo = 0;
+        uint32_t hi = m_data ? m_head.count : 0;
+        while (lo < hi) {
+            const uint32_t mid = lo + (hi - lo) / 2;
+            const uint32_t h = entry(mid).hash;
+            if (h == hash) return static_cast<int32_t>(mid);
+            if (h < hash) lo = mid + 1;
+            else hi = mid;
+        }
+        return -1;
+    }
+
+    [[nodiscard]] Asset at(int32_t i) const noexcept {
+        if (i < 0) return {};
+        const detail::apack::Entry e = entry(static_cast<uint32_t>(i));
+        return Asset{static_cast<AssetKind>(e.kind), m_data + e.offset, e.length};
+    }
+
+public:
+    AssetPack() noexcept = default;
+
+    explicit AssetPack(const char* path) noexcept { open(path); }
+
+    ~AssetPack() { close(); }
+
+    AssetPack(const AssetPack&) = delete;
+    AssetPack& operator=(const AssetPack&) = delete;
+
+    /**
+     * @brief Map a pack (closes any current one first)
+     * @return false if the file is missing or not a valid pack
+     */
+    bool open(const char* path) noexcept {
+        close();
+        if (m_file.open(path) != LV_FS_RES_OK) return false;
+        if (!parse(m_file.data(), m_file.size())) {
+            LV_LOG_WARN("AssetPack: %s is not an asset pack", path);
+            m_file.close();
+            return false;
+        }
+        return true;
+    }
+
+    /// Use a pack already in memory (linked in, RomFs); `data` must outlive the pack
+    bool open(const uint8_t* data, size_t size) noexcept {
+        close();
+        return parse(data, size);
+    }
+
+    /// Unmap; cached decodes of the pack's images are dropped first
+    void close() noexcept {
+        for (uint32_t i = 0; i < m_image_count; ++i) lv_image_cache_drop(&m_images[i].dsc);
+        m_image_count = 0;
+        m_data = nullptr;
+        m_toc = nullptr;
+        m_names = nullptr;
+        m_file.close();
+    }
+
+    [[nodiscard]] bool is_open() const noexcept { return m_data != nullptr; }
+    explicit operator bool() const noexcept { return is_open(); }
+
+    /// True if backed by mmap() or a RomFs table (or caller memory)
+    [[nodiscard]] bool is_mapped() const noexcept { return m_data && (!m_file || m_file.is_mapped()); }
+
+    // ==================== Lookup ====================
+
+    /// Asset called `name` (empty if missing)
+    [[nodiscard]] Asset find(const char* name) const noexcept {
+        if (!name) return {};
+        const int32_t i = index_of(asset_hash(name));
+        if (i < 0 || std::strcmp(m_names + entry(static_cast<uint32_t>(i)).name, name) != 0) return {};
+        return at(i);
+    }
+
+    /// Asset whose name hashes to `hash` (asset_hash(), e.g. computed at compile time)
+    [[nodiscard]] Asset find(uint32_t hash) const noexcept { return at(index_of(hash)); }
+
+    /**
+     * @brief Image descriptor of `name`, for Image::src() and lv_image_set_src()
+     * @return nullptr if missing, not an image, or the descriptor slots are full
+     */
+    [[nodiscard]] const lv_image_dsc_t* image(const char* name) noexcept {
+        const Asset a = find(name);
+        return a ? image_at(asset_hash(name), a) : nullptr;
+    }
+
+    [[nodiscard]] const lv_image_dsc_t* image(uint32_t hash) noexcept {
+        const Asset a = find(hash);
+        return a ? image_at(hash, a) : nullptr;
+    }
+
+    /// Point `font` at the lv_binfont `name`; close `font` before the pack
+    bool font(const char* name, MappedFont& font) const noexcept {
+        const Asset a = find(name);
+        if (!a || a.kind != AssetKind::font) return false;
+        return font.open(a.data, a.size);
+    }
+
+#if LV_USE_TRANSLATION
+    /// Open the translation pack `name` in place; close `pack` before this one
+    bool translations(const char* name, translation::BinaryPack& pack) const noexcept {
+        const Asset a = find(name);
+        if (!a || a.kind != AssetKind::translations) return false;
+        return pack.open(a.data, a.size);
+    }
+#endif
+
+    // ==================== Listing ====================
+
+    [[nodiscard]] uint32_t count() const noexcept { return m_data ? m_head.count : 0; }
+
+    /// Name of asset `i` (table order, i.e. by hash)
+    [[nodiscard]] const char* name(uint32_t i) const noexcept { return i < count() ? m_names + entry(i).name : nullptr; }
+
+    [[nodiscard]] Asset asset(uint32_t i) const noexcept { return i < count() ? at(static_cast<int32_t>(i)) : Asset{}; }
+
+    /// Alignment of image pixel data in the file
+    [[nodiscard]] uint32_t alignment() const noexcept { return m_data ? m_head.align : 0; }
+
+private:
+    [[nodiscard]] const lv_image_dsc_t* image_at(uint32_t hash, const Asset& a) noexcept {
+        for (uint32_t i = 0; i < m_image_count; ++i) {
+            if (m_images[i].hash == hash) return &m_images[i].dsc;
+        }
+        lv_image_header_t header;
+        if (a.kind != AssetKind::image || a.size < sizeof(header)) return nullptr;
+        std::memcpy(&header, a.data, sizeof(header));
+        const size_t data_size = a.size - sizeof(header);
+        if (header.stride == 0) header.stride = lv_draw_buf_width_to_stride(header.w, static_cast<lv_color_format_t>(header.cf));
+        if (header.magic != LV_IMAGE_HEADER_MAGIC || (header.flags & LV_IMAGE_FLAGS_COMPRESSED) ||
+            data_size < static_cast<size_t>(header.stride) * header.h) {
+            return nullptr;
+        }
+        if (m_image_count == LV_CPP_ASSET_PACK_IMAGES) {
+            LV_LOG_WARN("AssetPack: image descriptors exhausted, raise LV_CPP_ASSET_PACK_IMAGES");
+            return nullptr;
+        }
+        // The descriptor does not own the data: LVGL must never free or write it
+        header.flags &= ~(LV_IMAGE_FLAGS_ALLOCATED | LV_IMAGE_FLAGS_MODIFIABLE);
+        ImageSlot& slot = m_images[m_image_count++];
+        slot.hash = hash;
+        slot.dsc = lv_image_dsc_t{};
+        slot.dsc.header = header;
+        slot.dsc.data = a.data + sizeof(header);
+        slot.dsc.data_size = static_cast<uint32_t>(data_size);
+        return &slot.dsc;
+    }
+};
+
+} // namespace lv
@@ -2,17 +2,34 @@
 
 /**
  * @file async.hpp
- * @brief Zero-cost wrapper for LVGL deferred calls
+ * @brief Zero-cost wrapper for LVGL deferred calls and cross-thread posting
  *
  * Schedule a function to run on the next LVGL tick.
  * Useful for deferring UI updates from event callbacks.
  *
+ * async_call() must be called from the LVGL thread. To hand work to the UI
+ * from other threads, use lv::post(): it pushes the callable into a bounded
+ * lock-free queue that lv::tick()/lv::run() drain on the LVGL thread.
+ *
  * Usage:
  *   lv::async_call([](void*) { ... });
+ *
+ *   // From a sensor thread:
+ *   lv::post([value] { rpm_state.set(value); });
+ *
+ * Objects that only need "apply my latest value" (State::set_from_any_thread())
+ * use an intrusive pending list instead: each is queued at most once
+ * however often it is set, and lv::tick() applies the queued ones after
+ * the posted callables.
  */
 
 #include <lvgl.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
 #include <type_traits>
+#include <utility>
 
 namespace lv {
 
@@ -35,4 +52,257 @@ template<auto MemFn, typename T>
     }, instance) == LV_RESULT_OK;
 }
 
+// ==================== Cross-Thread Dispatcher ====================
+
+/**
+ * @brief Bounded lock-free multi-producer queue of callables for the LVGL thread
+ *
+ * Any thread may post(); only the LVGL thread may drain(). Callables are
+ * stored inline in a fixed ring of Capacity cells (no heap allocation), so
+ * captures must fit in InlineSize bytes. post() returns false when the ring
+ * is full instead of blocking.
+ *
+ * The ring uses per-cell sequence numbers: producers claim a slot with a
+ * single CAS on the enqueue index, the consumer never contends with them.
+ *
+ * @tparam Capacity Number of slots (power of two)
+ * @tparam InlineSize Maximum callable size in bytes
+ */
+template<size_t Capacity = 64, size_t InlineSize = 3 * sizeof(void*)>
+class Dispatcher {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+        "Dispatcher capacity must be a power of two");
+
+public:
+    /// Hook called after every successful post (e.g. to wake an event loop)
+    using wake_cb = void (*)(void* user_data);
+
+private:
+    static constexpr size_t MASK = Capacity - 1;
+
+    struct Cell {
+        std::atomic<size_t> seq;
+        /// Invokes (if run) and destroys the stored callable
+        void (*op)(void* storage, bool run);
+        alignas(std::max_align_t) unsigned char storage[InlineSize];
+    };
+
+    alignas(64) std::atomic<size_t> m_enqueue{0};
+    alignas(64) size_t m_dequeue = 0;
+    std::atomic<wake_cb> m_wake{nullptr};
+    std::atomic<void*> m_wake_data{nullptr};
+    Cell m_cells[Capacity];
+
+    template<typename Fn>
+    static void op_impl(void* storage, bool run) noexcept {
+        Fn* fn = std::launder(static_cast<Fn*>(storage));
+        if (run) (*fn)();
+        fn->~Fn();
+    }
+
+    /// Next ready cell (LVGL thread only), or nullptr when empty
+    Cell* front() noexcept {
+        Cell& c = m_cells[m_dequeue & MASK];
+        const size_t seq = c.seq.load(std::memory_order_acquire);
+        if (static_cast<intptr_t>(seq - (m_dequeue + 1)) < 0) return nullptr;
+        return &c;
+    }
+
+    void pop(Cell& c) noexcept {
+        c.seq.store(m_dequeue + Capacity, std::memory_order_release);
+        ++m_dequeue;
+    }
+
+public:
+    Dispatcher() noexcept {
+        for (size_t i = 0; i < Capacity; ++i) {
+            m_cells[i].seq.store(i, std::memory_order_relaxed);
+            m_cells[i].op = nullptr;
+        }
+    }
+
+    /// Destroys pending callables without running them
+    ~Dispatcher() {
+        while (Cell* c = front()) {
+            c->op(c->storage, false);
+            pop(*c);
+        }
+    }
+
+    Dispatcher(const Dispatcher&) = delete;
+    Dispatcher& operator=(const Dispatcher&) = delete;
+    Dispatcher(Dispatcher&&) = delete;
+    Dispatcher& operator=(Dispatcher&&) = delete;
+
+    /**
+     * @brief Queue a callable for the LVGL thread (any thread, lock-free)
+     *
+     * @return false if the queue is full (the callable is not stored)
+     */
+    template<typename F>
+    [[nodiscard]] bool post(F&& fn) noexcept {
+        using Fn = std::decay_t<F>;
+        static_assert(std::is_invocable_v<Fn&>, "post() requires a callable taking no arguments");
+        static_assert(sizeof(Fn) <= InlineSize,
+            "Callable captures too much state for the Dispatcher's inline storage; "
+            "capture a pointer or raise InlineSize");
+        static_assert(alignof(Fn) <= alignof(std::max_align_t), "Over-aligned callable");
+        static_assert(std::is_nothrow_constructible_v<Fn, F&&>,
+            "Callable must be nothrow constructible");
+
+        size_t pos = m_enqueue.load(std::memory_order_relaxed);
+        Cell* c;
+        for (;;) {
+            c = &m_cells[pos & MASK];
+            const size_t seq = c->seq.load(std::memory_order_acquire);
+            const auto diff = static_cast<intptr_t>(seq - pos);
+            if (diff == 0) {
+                if (m_enqueue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false;  // full
+            } else {
+                pos = m_enqueue.load(std::memory_order_relaxed);
+            }
+        }
+
+        ::new (static_cast<void*>(c->storage)) Fn(std::forward<F>(fn));
+        c->op = &op_impl<Fn>;
+        c->seq.store(pos + 1, std::memory_order_release);
+        wake();
+        return true;
+    }
+
+    /// Call the on_post() hook without posting (any thread)
+    void wake() const noexcept {
+        if (wake_cb cb = m_wake.load(std::memory_order_acquire)) {
+            cb(m_wake_data.load(std::memory_order_relaxed));
+        }
+    }
+
+    /// Queue a member function call (instance must outlive the call)
+    template<auto MemFn, typename T>
+        requires std::is_member_function_pointer_v<decltype(MemFn)>
+    [[nodiscard]] bool post(T* instance) noexcept {
+        return post([instance]() noexcept { (instance->*MemFn)(); });
+    }
+
+    /**
+     * @brief Run queued callables (LVGL thread only)
+     *
+     * @param max Maximum number of callables to run; bounds the time spent
+     *            when producers keep posting
+     * @return Number of callables run
+     */
+    size_t drain(size_t max = Capacity) noexcept {
+        size_t n = 0;
+        while (n < max) {
+            Cell* c = front();
+            if (!c) break;
+            c->op(c->storage, true);
+            pop(*c);
+            ++n;
+        }
+        return n;
+    }
+
+    /// Check whether anything is queued (approximate if producers are active)
+    [[nodiscard]] bool empty() const noexcept {
+        const Cell& c = m_cells[m_dequeue & MASK];
+        return static_cast<intptr_t>(c.seq.load(std::memory_order_acquire) - (m_dequeue + 1)) < 0;
+    }
+
+    /// Queue capacity
+    [[nodiscard]] static constexpr size_t capacity() noexcept { return Capacity; }
+
+    /**
+     * @brief Set a hook called after each post (e.g. EventLoop::attach)
+     *
+     * Install before producer threads start posting.
+     */
+    void on_post(wake_cb cb, void* user_data = nullptr) noexcept {
+        m_wake_data.store(user_data, std::memory_order_relaxed);
+        m_wake.store(cb, std::memory_order_release);
+    }
+};
+
+/// Dispatcher type used by lv::post() and drained by lv::tick()
+using DefaultDispatcher = Dispatcher<>;
+
+/// Process-wide dispatcher drained by lv::tick(), lv::run() and EventLoop
+[[nodiscard]] inline DefaultDispatcher& dispatcher() noexcept {
+    static DefaultDispatcher instance;
+    return instance;
+}
+
+/// Post a callable to the LVGL thread from any thread. Returns false if full.
+template<typename F>
+[[nodiscard]] bool post(F&& fn) noexcept {
+    return dispatcher().post(std::forward<F>(fn));
+}
+
+/// Post a member function call to the LVGL thread from any thread
+template<auto MemFn, typename T>
+    requires std::is_member_function_pointer_v<decltype(MemFn)>
+[[nodiscard]] bool post(T* instance) noexcept {
+    return dispatcher().template post<MemFn>(instance);
+}
+
+// ==================== Cross-Thread Pending List ====================
+
+namespace detail {
+
+/**
+ * Link of an object with an update pending for the LVGL thread.
+ *
+ * Producers push a node at most once until it is drained (`queued`), so
+ * repeated updates coalesce. The consumer detaches the whole list with
+ * one exchange and only then clears `queued`, so a node never sits in two
+ * lists at once and no ABA can occur.
+ */
+struct PendingNode {
+    std::atomic<PendingNode*> next{nullptr};
+    std::atomic<bool> queued{false};
+    void (*apply)(PendingNode* node) noexcept = nullptr;    ///< Runs on the LVGL thread
+    void* owner = nullptr;
+};
+
+[[nodiscard]] inline std::atomic<PendingNode*>& pending_head() noexcept {
+    static std::atomic<PendingNode*> head{nullptr};
+    return head;
+}
+
+/// Queue `node` unless it is already queued (any thread, lock-free)
+inline void push_pending(PendingNode& node) noexcept {
+    if (node.queued.exchange(true)) return;
+    std::atomic<PendingNode*>& head = pending_head();
+    PendingNode* old = head.load(std::memory_order_relaxed);
+    do {
+        node.next.store(old, std::memory_order_relaxed);
+    } while (!head.compare_exchange_weak(old, &node, std::memory_order_release, std::memory_order_relaxed));
+    if (!old) dispatcher().wake();
+}
+
+/// Apply every queued node, oldest first (LVGL thread); returns the number applied
+inline size_t drain_pending() noexcept {
+    PendingNode* n = pending_head().exchange(nullptr, std::memory_order_acquire);
+    PendingNode* fifo = nullptr;
+    while (n) {
+        PendingNode* next = n->next.load(std::memory_order_relaxed);
+        n->next.store(fifo, std::memory_order_relaxed);
+        fifo = n;
+        n = next;
+    }
+    size_t count = 0;
+    while (fifo) {
+        PendingNode* next = fifo->next.load(std::memory_order_relaxed);
+        fifo->queued.store(false);    // a set from now on queues the node again
+        fifo->apply(fifo);
+        fifo = next;
+        ++count;
+    }
+    return count;
+}
+
+} // namespace detail
+
 } // namespace lv
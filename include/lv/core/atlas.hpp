@@ -0,0 +1,152 @@
+#pragma once
+
+/**
+ * @file atlas.hpp
+ * @brief Sprite sheets: many small images as sub-rectangles of one packed image
+ *
+ * An Atlas holds one lv_image_dsc_t per sub-rectangle, each pointing into
+ * the sheet's pixels with the sheet's stride. Drawing an icon therefore
+ * needs no decoder work, no copy and no image cache entry of its own, and
+ * the icons share one header and one alignment padding in flash.
+ *
+ * @code
+ * // generated by scripts/atlas_pack.py
+ * extern const lv_image_dsc_t icons_sheet;
+ * inline constexpr lv::AtlasRect icons_rects[] = {
+ *     {"battery", 0, 0, 53, 46},
+ *     {"bluetooth", 53, 0, 40, 40},
+ * };
+ *
+ * static lv::Atlas icons(icons_sheet, icons_rects);
+ * lv::Image::create(parent).src(icons["battery"]);
+ * lv::Image::create(parent).src(icons[1]);
+ * @endcode
+ *
+ * The sheet must be a non-indexed, non-planar format of 8 or more bits per
+ * pixel (RGB565, ARGB8565, RGB888, ARGB8888, XRGB8888, A8, L8, ...): a
+ * sub-rectangle of a palette or a separate alpha plane is not an image.
+ * Sub-images start at arbitrary bytes of the sheet, so draw units that
+ * need LV_DRAW_BUF_ALIGN aligned sources fall back to software drawing.
+ *
+ * Heap allocation: NONE (N descriptors stored inline)
+ */
+
+#include <lvgl.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace lv {
+
+/// One named sub-rectangle of a sheet (pixels)
+struct AtlasRect {
+    const char* name;
+    uint16_t x;
+    uint16_t y;
+    uint16_t w;
+    uint16_t h;
+};
+
+/**
+ * @brief Fixed-capacity sprite sheet
+ *
+ * @tparam N Number of sub-images (deduced from a rect array)
+ *
+ * Not copyable or movable: image objects keep pointers to the descriptors.
+ * Rects outside the sheet, or any rect of an unsupported sheet format,
+ * yield empty descriptors (0x0) and a warning.
+ */
+template<size_t N>
+class Atlas {
+    const lv_image_dsc_t* m_sheet = nullptr;
+    const char* m_names[N] = {};
+    lv_image_dsc_t m_sub[N] = {};
+    size_t m_size = 0;
+
+    [[nodiscard]] static bool sheet_ok(const lv_image_dsc_t& sheet) noexcept {
+        const auto cf = static_cast<lv_color_format_t>(sheet.header.cf);
+        return !LV_COLOR_FORMAT_IS_INDEXED(cf) && cf != LV_COLOR_FORMAT_RGB565A8 &&
+               lv_color_format_get_bpp(cf) >= 8 && sheet.data != nullptr;
+    }
+
+public:
+    /// Sheet plus a compile-time rect table (N deduced)
+    Atlas(const lv_image_dsc_t& sheet, const AtlasRect (&rects)[N]) noexcept { load(sheet, rects, N); }
+
+    /// Sheet plus a runtime rect table of up to N entries
+    Atlas(const lv_image_dsc_t& sheet, const AtlasRect* rects, size_t count) noexcept { load(sheet, rects, count); }
+
+    Atlas(const Atlas&) = delete;
+    Atlas& operator=(const Atlas&) = delete;
+
+    /**
+     * @brief Rebuild all descriptors from `rects` (e.g. after loading a new table)
+     *
+     * Images still showing the old sub-images show the new rect of the same index.
+     */
+    void load(const lv_image_dsc_t& sheet, const AtlasRect* rects, size_t count) noexcept {
+        m_sheet = &sheet;
+        if (count > N) {
+            LV_LOG_WARN("Atlas: %u rects for a capacity of %u", static_cast<unsigned>(count), static_cast<unsigned>(N));
+            count = N;
+        }
+        m_size = count;
+        const bool ok = sheet_ok(sheet);
+        if (!ok) LV_LOG_WARN("Atlas: sheet color format %d cannot be split", static_cast<int>(sheet.header.cf));
+        const auto cf = static_cast<lv_color_format_t>(sheet.header.cf);
+        const uint32_t bytes_pp = lv_color_format_get_bpp(cf) / 8;
+        const uint32_t stride = sheet.header.stride ? sheet.header.stride : lv_draw_buf_width_to_stride(sheet.header.w, cf);
+        for (size_t i = 0; i < count; ++i) {
+            const AtlasRect& r = rects[i];
+            lv_image_dsc_t& d = m_sub[i];
+            d = lv_image_dsc_t{};
+            m_names[i] = r.name;
+            d.header.magic = LV_IMAGE_HEADER_MAGIC;
+            d.header.cf = cf;
+            if (!ok) continue;
+            if (r.w == 0 || r.h == 0 || r.x + r.w > sheet.header.w || r.y + r.h > sheet.header.h) {
+                LV_LOG_WARN("Atlas: rect '%s' is outside the sheet", r.name ? r.name : "");
+                continue;
+            }
+            const uint32_t offset = r.y * stride + r.x * bytes_pp;
+            d.header.w = r.w;
+            d.header.h = r.h;
+            d.header.stride = stride;
+            d.data = sheet.data + offset;
+            d.data_size = (r.h - 1u) * stride + r.w * bytes_pp;
+        }
+    }
+
+    /// Index of `name`, or -1
+    [[nodiscard]] int32_t find(const char* name) const noexcept {
+        for (size_t i = 0; i < m_size; ++i) {
+            if (m_names[i] && std::strcmp(m_names[i], name) == 0) return static_cast<int32_t>(i);
+        }
+        return -1;
+    }
+
+    /// Sub-image by name (nullptr and a warning if missing); pass to Image::src()
+    [[nodiscard]] const lv_image_dsc_t* operator[](const char* name) const noexcept {
+        const int32_t i = find(name);
+        if (i < 0) {
+            LV_LOG_WARN("Atlas: no image '%s'", name);
+            return nullptr;
+        }
+        return &m_sub[i];
+    }
+
+    /// Sub-image by index (e.g. an enum generated with the rect table)
+    [[nodiscard]] const lv_image_dsc_t* operator[](int i) const noexcept {
+        return i >= 0 && static_cast<size_t>(i) < m_size ? &m_sub[i] : nullptr;
+    }
+
+    [[nodiscard]] size_t size() const noexcept { return m_size; }
+    [[nodiscard]] static constexpr size_t capacity() noexcept { return N; }
+    [[nodiscard]] const lv_image_dsc_t* sheet() const noexcept { return m_sheet; }
+    [[nodiscard]] const char* name(size_t i) const noexcept { return i < m_size ? m_names[i] : nullptr; }
+};
+
+template<size_t N>
+Atlas(const lv_image_dsc_t&, const AtlasRect (&)[N]) -> Atlas<N>;
+
+} // namespace lv
@@ -0,0 +1,209 @@
+#pragma once
+
+/**
+ * @file bindings.hpp
+ * @brief Compile-time binding table of a Component: one observer per state
+ *
+ * Every bind_text()/bind_value()/observe() adds its own LVGL observer, so a
+ * state shown by a label, a bar and an LED costs three observers and three
+ * indirect callbacks per change. A component can declare its bindings as a
+ * type instead; mount() subscribes once per distinct state and each change
+ * runs one generated function that updates all dependent widgets inline:
+ *
+ * @code
+ * class Dashboard : public lv::Component<Dashboard> {
+ *     lv::State<int32_t> rpm{0};
+ *     lv::State<bool> overheat{false};
+ *     lv::Label rpm_label;
+ *     lv::Bar rpm_bar;
+ *     lv::Led warn;
+ *
+ * public:
+ *     using bindings = lv::Bindings<
+ *         lv::Bind<&Dashboard::rpm, &Dashboard::rpm_label, lv::prop::text<"{} rpm">>,
+ *         lv::Bind<&Dashboard::rpm, &Dashboard::rpm_bar, lv::prop::value>,
+ *         lv::Bind<&Dashboard::overheat, &Dashboard::warn, lv::prop::visible>>;   // 2 subscriptions
+ *
+ *     lv::ObjectView build(lv::ObjectView parent) {
+ *         auto root = lv::vbox(parent);
+ *         rpm_label = lv::Label::create(root);
+ *         rpm_bar = lv::Bar::create(root).range(0, 8000);
+ *         warn = lv::Led::create(root);
+ *         return root;                   // bindings attach after build()
+ *     }
+ * };
+ * @endcode
+ *
+ * `bindings` must be a public member type. The table is attached with
+ * Component::subscribe()'s pooled subscriptions (see subscription.hpp), so
+ * each distinct state applies its widgets once right away and is
+ * unsubscribed on unmount(). A property is any type with a static
+ * apply(widget, value); the ones below cover the common cases.
+ *
+ * Heap allocation: NONE (one pooled subscription per distinct state)
+ */
+
+#include <lvgl.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "format.hpp"
+#include "subscription.hpp"
+#include "text_cache.hpp"
+
+#if LV_USE_OBSERVER
+
+namespace lv {
+
+/// Widget properties for lv::Bind
+namespace prop {
+
+#if LV_USE_LABEL
+/// Label text formatted with lv::fmt (skipped when the text is unchanged)
+template<FixedString F>
+struct text {
+    static_assert(Format<F>::arg_count == 1, "prop::text: the format needs exactly one field");
+
+    template<typename W, typename T>
+    static void apply(W& widget, const T& v) noexcept {
+        const auto s = fmt<F>(v);
+        lv_obj_t* label = widget.get();
+        if (!text_cache::unchanged(lv_label_get_text(label), s.c_str())) lv_label_set_text(label, s.c_str());
+    }
+};
+#endif
+
+/// value() of a Bar, Slider, Arc, ... (no animation)
+struct value {
+    template<typename W, typename T>
+    static void apply(W& widget, const T& v) noexcept {
+        widget.value(static_cast<int32_t>(v));
+    }
+};
+
+/// LV_STATE_CHECKED while the value is true
+struct checked {
+    template<typename W, typename T>
+    static void apply(W& widget, const T& v) noexcept {
+        if (v) lv_obj_add_state(widget.get(), LV_STATE_CHECKED);
+        else lv_obj_remove_state(widget.get(), LV_STATE_CHECKED);
+    }
+};
+
+/// LV_STATE_DISABLED while the value is true
+struct disabled {
+    template<typename W, typename T>
+    static void apply(W& widget, const T& v) noexcept {
+        if (v) lv_obj_add_state(widget.get(), LV_STATE_DISABLED);
+        else lv_obj_remove_state(widget.get(), LV_STATE_DISABLED);
+    }
+};
+
+/// Shown while the value is true (LV_OBJ_FLAG_HIDDEN otherwise)
+struct visible {
+    template<typename W, typename T>
+    static void apply(W& widget, const T& v) noexcept {
+        if (v) lv_obj_remove_flag(widget.get(), LV_OBJ_FLAG_HIDDEN);
+        else lv_obj_add_flag(widget.get(), LV_OBJ_FLAG_HIDDEN);
+    }
+};
+
+} // namespace prop
+
+namespace detail {
+
+/// Same pointer-to-member (false for members of different types)
+template<auto A, auto B>
+inline constexpr bool same_member = [] {
+    if constexpr (std::is_same_v<decltype(A), decltype(B)>) return A == B;
+    else return false;
+}();
+
+} // namespace detail
+
+/**
+ * @brief One binding: `(self.*WidgetMember)` shows `(self.*StateMember).get()` as Prop
+ * @tparam StateMember Pointer to a State/Computed member
+ * @tparam WidgetMember Pointer to a widget member (anything with get() -> lv_obj_t*)
+ * @tparam Prop Property type with static apply(widget, value)
+ */
+template<auto StateMember, auto WidgetMember, typename Prop>
+    requires std::is_member_object_pointer_v<decltype(StateMember)> &&
+             std::is_member_object_pointer_v<decltype(WidgetMember)>
+struct Bind {
+    static constexpr auto state = StateMember;
+
+    /// Update the widget if this binding depends on `S`; compiles to nothing otherwise
+    template<auto S, typename Self, typename T>
+    static void apply_if(Self& self, const T& v) noexcept {
+        if constexpr (detail::same_member<StateMember, S>) Prop::apply(self.*WidgetMember, v);
+    }
+};
+
+/**
+ * @brief Binding table of a component (declare as `using bindings = lv::Bindings<...>`)
+ */
+template<typename... Bs>
+struct Bindings {
+    static_assert(sizeof...(Bs) > 0, "lv::Bindings needs at least one lv::Bind");
+
+private:
+    using List = std::tuple<Bs...>;
+
+    template<size_t I, size_t... J>
+    static constexpr bool first_use(std::index_sequence<J...>) noexcept {
+        return !((J < I && detail::same_member<std::tuple_element_t<J, List>::state,
+                                               std::tuple_element_t<I, List>::state>) || ...);
+    }
+
+    template<size_t... I>
+    static constexpr auto first_uses(std::index_sequence<I...> seq) noexcept {
+        return std::array<bool, sizeof...(I)>{first_use<I>(seq)...};
+    }
+
+    template<typename Self, size_t... I>
+    static size_t attach_each(Self& self, const void* owner, std::index_sequence<I...>) noexcept {
+        constexpr auto first = first_uses(std::index_sequence<I...>{});
+        size_t n = 0;
+        ([&] {
+            if constexpr (first[I]) {
+                constexpr auto S = std::tuple_element_t<I, List>::state;
+                n += detail::subscribe_pooled((self.*S).subject(), &apply_state<Self, S>, &self, owner);
+            }
+        }(), ...);
+        return n;
+    }
+
+public:
+    /// Apply every binding of state S, inlined into one function per state
+    template<typename Self, auto S>
+    static void apply_state(void* target, lv_subject_t*) noexcept {
+        Self& self = *static_cast<Self*>(target);
+        const auto& v = (self.*S).get();
+        (Bs::template apply_if<S>(self, v), ...);
+    }
+
+    /// Distinct states in the table
+    static constexpr size_t state_count = [] {
+        constexpr auto first = first_uses(std::index_sequence_for<Bs...>{});
+        size_t n = 0;
+        for (bool f : first) n += f;
+        return n;
+    }();
+
+    /**
+     * @brief Subscribe once per distinct state on behalf of `owner`
+     * @return Subscriptions made (less than state_count if the pool ran out)
+     */
+    template<typename Self>
+    static size_t attach(Self& self, const void* owner) noexcept {
+        return attach_each(self, owner, std::index_sequence_for<Bs...>{});
+    }
+};
+
+} // namespace lv
+
+#endif // LV_USE_OBSERVER
@@ -0,0 +1,371 @@
+#pragma once
+
+/**
+ * @file buffered_file.hpp
+ * @brief Buffered file reader/writer with read-ahead and write coalescing
+ *
+ * fs::File::read()/write() map one-to-one to lv_fs_read()/lv_fs_write(),
+ * and with LV_FS_*_CACHE_SIZE at 0 each of those is a driver call (a
+ * syscall on POSIX). A parser reading 16 bytes at a time pays one call per
+ * token. BufferedFile reads ahead into its buffer and hands out bytes,
+ * lines and records from there, and gathers small writes into one call:
+ *
+ * @code
+ * lv::fs::BufferedFile cfg("A:/etc/app.conf");
+ * std::string_view line;
+ * while (cfg.read_line(line)) {
+ *     parse(line);                        // points into the buffer
+ * }
+ * LV_LOG_USER("%u calls, %u saved", cfg.stats().calls, cfg.stats().saved());
+ * @endcode
+ *
+ * Read-ahead starts at 1/8 of the buffer and doubles with every refill
+ * until a seek, so a few random reads stay cheap and a sequential scan
+ * soon reads whole buffers. Reads and writes of a buffer or more go
+ * straight to the file. Views returned by read_line()/read_record() stay
+ * valid until the next call on the file.
+ *
+ * The buffer is lv_malloc'd on first use, or borrowed from the caller
+ * (a static array, or FrameArena memory for a file read within one frame).
+ *
+ * Heap allocation: the buffer (LV_CPP_FS_BUFFER_SIZE, lv_malloc on first
+ * use) unless borrowed; nothing per call
+ */
+
+#include <lvgl.h>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include "fs.hpp"
+
+/// Default buffer of a BufferedFile (bytes)
+#ifndef LV_CPP_FS_BUFFER_SIZE
+#define LV_CPP_FS_BUFFER_SIZE 4096
+#endif
+
+namespace lv::fs {
+
+/**
+ * @brief File with a read-ahead / write-back buffer
+ *
+ * One buffer serves both directions: writing after reading drops the
+ * read-ahead (one seek back), reading after writing flushes first.
+ * close() and the destructor flush pending writes.
+ */
+class BufferedFile {
+public:
+    /// Per-file counters; saved() is the driver calls avoided
+    struct Stats {
+        uint32_t calls;        ///< read/write/read_line/read_record calls
+        uint32_t fs_reads;     ///< lv_fs_read() calls issued
+        uint32_t fs_writes;    ///< lv_fs_write() calls issued
+        uint32_t seeks;        ///< lv_fs_seek() calls issued
+        uint32_t cut;          ///< Lines longer than the buffer, returned in pieces
+
+        [[nodiscard]] uint32_t saved() const noexcept {
+            const uint32_t issued = fs_reads + fs_writes;
+            return calls > issued ? calls - issued : 0;
+        }
+    };
+
+private:
+    File m_file;
+    uint8_t* m_buf = nullptr;
+    uint32_t m_cap;
+    bool m_owned = true;
+    uint32_t m_begin = 0;      ///< First unread byte of the read-ahead
+    uint32_t m_end = 0;        ///< End of the read-ahead
+    uint32_t m_dirty = 0;      ///< Pending write bytes at the buffer start
+    uint32_t m_pos = 0;        ///< Position of the underlying file
+    uint32_t m_window = 0;     ///< Next refill size
+    bool m_eof = false;
+    lv_fs_res_t m_res = LV_FS_RES_OK;
+    Stats m_stats{};
+
+    [[nodiscard]] uint32_t first_window() const noexcept {
+        const uint32_t w = m_cap / 8;
+        return w < 64 ? (m_cap < 64 ? m_cap : 64) : w;
+    }
+
+    [[nodiscard]] bool ensure_buffer() noexcept {
+        if (m_buf) return true;
+        if (m_owned && m_cap) m_buf = static_cast<uint8_t*>(lv_malloc(m_cap));
+        if (!m_buf) m_res = LV_FS_RES_OUT_OF_MEM;
+        return m_buf != nullptr;
+    }
+
+    void drop_read_ahead() noexcept {
+        m_begin = m_end = 0;
+        m_eof = false;
+        m_window = first_window();
+    }
+
+    /// Prepare for reading: buffer present, pending writes flushed
+    [[nodiscard]] bool ready_read() noexcept {
+        if (!m_file || !ensure_buffer()) return false;
+        return m_dirty == 0 || flush() == LV_FS_RES_OK;
+    }
+
+    /// Prepare for writing: put the file back where the reader is
+    [[nodiscard]] bool ready_write() noexcept {
+        if (!m_file || !ensure_buffer()) return false;
+        if (m_end == 0) return true;
+        const uint32_t at = tell();
+        if (at != m_pos) {
+            ++m_stats.seeks;
+            m_res = m_file.seek(at);
+            if (m_res != LV_FS_RES_OK) return false;
+            m_pos = at;
+        }
+        drop_read_ahead();
+        return true;
+    }
+
+    /// Read ahead at least `need` bytes (as far as space allows); false if none arrived
+    bool refill(uint32_t need) noexcept {
+        if (m_begin) {
+            std::memmove(m_buf, m_buf + m_begin, m_end - m_begin);
+            m_end -= m_begin;
+            m_begin = 0;
+        }
+        const uint32_t space = m_cap - m_end;
+        uint32_t want = need > m_window ? need : m_window;
+        if (want > space) want = space;
+        if (want == 0) return false;
+        uint32_t got = 0;
+        ++m_stats.fs_reads;
+        m_res = m_file.read(m_buf + m_end, want, &got);
+        m_end += got;
+        m_pos += got;
+        if (m_res != LV_FS_RES_OK || got < want) m_eof = true;
+        if (m_window < m_cap / 2) m_window *= 2;
+        else m_window = m_cap;
+        return got > 0;
+    }
+
+public:
+    /// Closed file with an owned buffer of `capacity` bytes
+    explicit BufferedFile(uint32_t capacity = LV_CPP_FS_BUFFER_SIZE) noexcept : m_cap(capacity) {
+        m_window = first_window();
+    }
+
+    /// Closed file on caller memory; `buf` must outlive the file
+    BufferedFile(void* buf, uint32_t size) noexcept
+        : m_buf(static_cast<uint8_t*>(buf)), m_cap(size), m_owned(false) {
+        m_window = first_window();
+    }
+
+    /// Open `path` with an owned buffer
+    explicit BufferedFile(const char* path, lv_fs_mode_t m = LV_FS_MODE_RD,
+                          uint32_t capacity = LV_CPP_FS_BUFFER_SIZE) noexcept
+        : BufferedFile(capacity) {
+        open(path, m);
+    }
+
+    ~BufferedFile() {
+        close();
+        if (m_owned) lv_free(m_buf);
+    }
+
+    BufferedFile(const BufferedFile&) = delete;
+    BufferedFile& operator=(const BufferedFile&) = delete;
+
+    // ==================== Open / Close ====================
+
+    /// Open a file (flushes and closes any current one first)
+    lv_fs_res_t open(const char* path, lv_fs_mode_t m = LV_FS_MODE_RD) noexcept {
+        close();
+        m_res = m_file.open(path, m);
+        return m_res;
+    }
+
+    /// Flush pending writes and close; returns the flush result
+    lv_fs_res_t close() noexcept {
+        const lv_fs_res_t r = m_file ? flush() : LV_FS_RES_OK;
+        m_file.close();
+        drop_read_ahead();
+        m_dirty = 0;
+        m_pos = 0;
+        return r;
+    }
+
+    [[nodiscard]] bool is_open() const noexcept { return m_file.is_open(); }
+    explicit operator bool() const noexcept { return is_open(); }
+
+    // ==================== Reading ====================
+
+    /// Read up to `size` bytes (fewer only at the end of the file or on error)
+    lv_fs_res_t read(void* buf, uint32_t size, uint32_t* bytes_read = nullptr) noexcept {
+        uint32_t done = 0;
+        if (ready_read()) {
+            ++m_stats.calls;
+            m_res = LV_FS_RES_OK;
+            auto* out = static_cast<uint8_t*>(buf);
+            while (done < size) {
+                const uint32_t avail = m_end - m_begin;
+                if (avail) {
+                    const uint32_t n = avail < size - done ? avail : size - done;
+                    std::memcpy(out + done, m_buf + m_begin, n);
+                    m_begin += n;
+                    done += n;
+                    continue;
+                }
+                if (m_eof) break;
+                const uint32_t left = size - done;
+                if (left >= m_cap) {
+                    uint32_t got = 0;
+                    ++m_stats.fs_reads;
+                    m_res = m_file.read(out + done, left, &got);
+                    m_pos += got;
+                    done += got;
+                    if (got < left) m_eof = true;
+                    break;
+                }
+                if (!refill(left)) break;
+            }
+        }
+        if (bytes_read) *bytes_read = done;
+        return m_res;
+    }
+
+    /**
+     * @brief Next line without its "\n" (or "\r\n")
+     *
+     * A line longer than the buffer is returned in buffer-sized pieces
+     * (counted in Stats::cut). The last line needs no terminator.
+     * @return false at the end of the file or on error (see result())
+     */
+    bool read_line(std::string_view& line) noexcept {
+        if (!ready_read()) return false;
+        ++m_stats.calls;
+        uint32_t scanned = 0;
+        for (;;) {
+            const uint32_t from = m_begin + scanned;
+            const auto* nl = static_cast<const uint8_t*>(std::memchr(m_buf + from, '\n', m_end - from));
+            if (nl) {
+                const auto end = static_cast<uint32_t>(nl - m_buf);
+                uint32_t len = end - m_begin;
+                if (len && m_buf[end - 1] == '\r') --len;
+                line = {reinterpret_cast<const char*>(m_buf + m_begin), len};
+                m_begin = end + 1;
+                return true;
+            }
+            scanned = m_end - m_begin;
+            const bool full = scanned == m_cap;
+            if (m_eof || full) {
+                if (scanned == 0) return false;
+                if (full) ++m_stats.cut;
+                line = {reinterpret_cast<const char*>(m_buf + m_begin), scanned};
+                m_begin = m_end;
+                return true;
+            }
+            if (!refill(1) && m_res != LV_FS_RES_OK) return false;
+        }
+    }
+
+    /**
+     * @brief Next `size` bytes as a view into the buffer (size <= capacity())
+     * @return false if the file ends first (the partial bytes stay readable) or on error
+     */
+    bool read_record(uint32_t size, std::string_view& record) noexcept {
+        if (size > m_cap) {
+            m_res = LV_FS_RES_INV_PARAM;
+            return false;
+        }
+        if (!ready_read()) return false;
+        ++m_stats.calls;
+        while (m_end - m_begin < size) {
+            if (m_eof || !refill(size - (m_end - m_begin))) return false;
+        }
+        record = {reinterpret_cast<const char*>(m_buf + m_begin), size};
+        m_begin += size;
+        return true;
+    }
+
+    // ==================== Writing ====================
+
+    /// Write `size` bytes; small writes are gathered until the buffer fills or flush()
+    lv_fs_res_t write(const void* buf, uint32_t size, uint32_t* bytes_written = nullptr) noexcept {
+        uint32_t done = 0;
+        if (ready_write()) {
+            ++m_stats.calls;
+            m_res = LV_FS_RES_OK;
+            if (m_dirty + size > m_cap) flush();
+            if (m_res == LV_FS_RES_OK) {
+                if (size >= m_cap) {
+                    ++m_stats.fs_writes;
+                    m_res = m_file.write(buf, size, &done);
+                    m_pos += done;
+                } else {
+                    std::memcpy(m_buf + m_dirty, buf, size);
+                    m_dirty += size;
+                    done = size;
+                }
+            }
+        }
+        if (bytes_written) *bytes_written = done;
+        return m_res;
+    }
+
+    lv_fs_res_t write(std::string_view text) noexcept {
+        return write(text.data(), static_cast<uint32_t>(text.size()));
+    }
+
+    /// Write out gathered bytes (one lv_fs_write call)
+    lv_fs_res_t flush() noexcept {
+        if (m_dirty == 0) return LV_FS_RES_OK;
+        uint32_t done = 0;
+        ++m_stats.fs_writes;
+        m_res = m_file.write(m_buf, m_dirty, &done);
+        m_pos += done;
+        if (m_res == LV_FS_RES_OK && done < m_dirty) m_res = LV_FS_RES_FULL;
+        m_dirty = 0;
+        return m_res;
+    }
+
+    // ==================== Position ====================
+
+    /// Seek; moves within the read-ahead without touching the file
+    lv_fs_res_t seek(uint32_t pos, lv_fs_whence_t w = LV_FS_SEEK_SET) noexcept {
+        if (!m_file) return LV_FS_RES_NOT_EX;
+        if (w == LV_FS_SEEK_CUR) {
+            pos += tell();
+            w = LV_FS_SEEK_SET;
+        }
+        const uint32_t start = m_pos - m_end;
+        if (w == LV_FS_SEEK_SET && m_end && pos >= start && pos <= m_pos) {
+            m_begin = pos - start;
+            return m_res = LV_FS_RES_OK;
+        }
+        if (flush() != LV_FS_RES_OK) return m_res;
+        drop_read_ahead();
+        ++m_stats.seeks;
+        m_res = m_file.seek(pos, w);
+        if (m_res == LV_FS_RES_OK) m_pos = w == LV_FS_SEEK_SET ? pos : m_file.tell();
+        return m_res;
+    }
+
+    /// Position as seen by the caller
+    [[nodiscard]] uint32_t tell() const noexcept { return m_pos - (m_end - m_begin) + m_dirty; }
+
+    /// File size (flushes pending writes first)
+    [[nodiscard]] uint32_t size() noexcept {
+        flush();
+        return m_file.size();
+    }
+
+    // ==================== Info ====================
+
+    /// Result of the last operation
+    [[nodiscard]] lv_fs_res_t result() const noexcept { return m_res; }
+
+    [[nodiscard]] uint32_t capacity() const noexcept { return m_cap; }
+
+    [[nodiscard]] const Stats& stats() const noexcept { return m_stats; }
+    void reset_stats() noexcept { m_stats = {}; }
+
+    /// The unbuffered file (flush() before using it directly)
+    [[nodiscard]] File& file() noexcept { return m_file; }
+};
+
+} // namespace lv::fs
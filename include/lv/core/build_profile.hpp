@@ -0,0 +1,330 @@
+#pragma once
+
+/**
+ * @file build_profile.hpp
+ * @brief Opt-in timing of Component::mount(): build, on_mount, layout and first render
+ *
+ * With LV_CPP_USE_BUILD_PROFILE=1 (CMake -DLV_CPP_USE_BUILD_PROFILE=ON)
+ * every Component::mount(), including the one ScreenComponent::mount_screen()
+ * runs, becomes a node of a tree: components mounted from another
+ * component's build() are its children. Each node records
+ *
+ * - the wall time of build() (children included), on_mount() and the
+ *   layout pass at the end of mount (only the outermost mount lays out;
+ *   nested ones show 0 and are laid out with their parent),
+ * - the first refresh of its display after the mount: how long that
+ *   refresh took and how long after the mount it finished,
+ * - the objects, styles and event descriptors in the component's subtree
+ *   once on_mount() returned.
+ *
+ * @code
+ * lv::build_profile::reset();
+ * settings.mount_and_load();
+ * lv::run_for(100);
+ * lv::build_profile::log();
+ * // Settings        build 4210 us  on_mount 35 us  layout 1890 us  render 6120 us (+6300)  142 obj  61 styles  18 events
+ * //   WifiList      build 2380 us  ...
+ * @endcode
+ *
+ * Top-level mounts also go into the startup timeline as named marks
+ * (lv::startup::log()), and with LV_CPP_USE_PROFILER the phases appear
+ * as "build", "on_mount", "layout" and "first render" scopes in the
+ * Chrome/Perfetto trace, inside the mount() scope.
+ *
+ * Off (the default), the macros Component uses expand to nothing.
+ *
+ * With the option on, the style count reads lv_obj_t::style_cnt, which
+ * has no getter; the option requires LV_CPP_INTERNALS_OK and was checked
+ * against LVGL 9.4.
+ *
+ * Single-threaded: mount and query from the LVGL thread.
+ * Heap allocation: NONE (LV_CPP_BUILD_PROFILE_NODES fixed nodes)
+ */
+
+#include <lvgl.h>
+#include <cstdint>
+#include "version.hpp"
+
+#ifndef LV_CPP_USE_BUILD_PROFILE
+#define LV_CPP_USE_BUILD_PROFILE 0
+#endif
+
+#ifndef LV_CPP_BUILD_PROFILE_NODES
+/// Mounts recorded until reset(); later mounts are counted as dropped
+#define LV_CPP_BUILD_PROFILE_NODES 64
+#endif
+
+#ifndef LV_CPP_BUILD_PROFILE_NAME
+/// Bytes kept of a component's type name (including the terminator)
+#define LV_CPP_BUILD_PROFILE_NAME 32
+#endif
+
+#if LV_CPP_USE_BUILD_PROFILE
+
+#if !LV_CPP_INTERNALS_OK
+#error "LV_CPP_USE_BUILD_PROFILE reads LVGL internals checked against LVGL 9.4; see LV_CPP_INTERNALS_OK"
+#endif
+
+#include <src/core/lv_obj_private.h>   // obj->style_cnt
+#include <chrono>
+#include "profiler.hpp"
+#include "startup.hpp"
+
+namespace lv::build_profile {
+
+/// Not reached (yet): render times of a node whose display has not refreshed
+inline constexpr uint32_t pending = UINT32_MAX;
+
+/// One Component::mount()
+struct Node {
+    char name[LV_CPP_BUILD_PROFILE_NAME];   ///< Component type (from the mount signature)
+    const void* component;
+    lv_obj_t* root;              ///< Root at mount time (may be deleted since)
+    lv_display_t* display;       ///< Display timed for the first render (nullptr: not timed)
+    int16_t parent;              ///< Index of the enclosing mount, -1 for top level
+    uint16_t depth;
+    uint64_t start_us;           ///< Steady clock at mount()
+    uint32_t build_us;
+    uint32_t on_mount_us;
+    uint32_t layout_us;          ///< 0 when nested (laid out by the outermost mount)
+    uint32_t render_us;          ///< Duration of the first refresh after the mount
+    uint32_t first_frame_us;     ///< End of mount() to the end of that refresh
+    uint32_t objects;            ///< Subtree of the root, root included
+    uint32_t styles;             ///< Style entries (shared, local and transition) in the subtree
+    uint32_t events;             ///< Event descriptors in the subtree
+};
+
+namespace detail {
+
+struct Tree {
+    Node nodes[LV_CPP_BUILD_PROFILE_NODES];
+    uint32_t count = 0;
+    uint32_t dropped = 0;
+    int16_t current = -1;            ///< Innermost mount in progress
+    uint32_t render_pending = 0;     ///< Nodes waiting for their first refresh
+    lv_display_t* hooked = nullptr;  ///< Display whose refreshes are watched
+    uint64_t refr_start_us = 0;
+};
+
+[[nodiscard]] inline Tree& tree() noexcept {
+    static Tree t;
+    return t;
+}
+
+[[nodiscard]] inline uint64_t now_us() noexcept {
+    using namespace std::chrono;
+    return static_cast<uint64_t>(duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+inline void trace(const char* name, uint64_t start_us, uint64_t end_us) noexcept {
+#if LV_CPP_USE_PROFILER
+    if (profiler::enabled()) profiler::detail::record(name, start_us, end_us);
+#else
+    (void)name, (void)start_us, (void)end_us;
+#endif
+}
+
+/// Copy the component type out of `void lv::Component<Derived>::mount(...) [with Derived = X]`
+inline void copy_name(char* out, const char* signature) noexcept {
+    const char* s = signature;
+    for (const char* p = signature; *p; ++p) {
+        if (p[0] == '=' && p[1] == ' ') s = p + 2;                     // GCC / Clang "Derived = X"
+        else if (p[0] == '<' && s == signature) s = p + 1;             // MSVC "Component<class X>"
+    }
+    if (s[0] == 'c' && s[1] == 'l' && s[2] == 'a' && s[3] == 's' && s[4] == 's' && s[5] == ' ') s += 6;
+    uint32_t n = 0;
+    for (; s[n] && s[n] != ']' && s[n] != ';' && s[n] != '>' && n + 1 < LV_CPP_BUILD_PROFILE_NAME; ++n) {
+        out[n] = s[n];
+    }
+    out[n] = '\0';
+}
+
+struct Counts {
+    uint32_t objects = 0, styles = 0, events = 0;
+};
+
+inline void count(lv_obj_t* obj, Counts& c) noexcept {
+    ++c.objects;
+    c.styles += obj->style_cnt;
+    c.events += lv_obj_get_event_count(obj);
+    const uint32_t n = lv_obj_get_child_count(obj);
+    for (uint32_t i = 0; i < n; ++i) count(lv_obj_get_child(obj, static_cast<int32_t>(i)), c);
+}
+
+inline void refr_cb(lv_event_t* e) noexcept;
+
+inline void unhook() noexcept {
+    Tree& t = tree();
+    if (!t.hooked) return;
+    lv_display_remove_event_cb_with_user_data(t.hooked, &refr_cb, nullptr);
+    t.hooked = nullptr;
+}
+
+/// Time the display's refreshes until every mounted node has seen one
+inline void refr_cb(lv_event_t* e) noexcept {
+    Tree& t = tree();
+    const uint64_t now = now_us();
+    if (lv_event_get_code(e) == LV_EVENT_REFR_START) {
+        t.refr_start_us = now;
+        return;
+    }
+    if (!t.refr_start_us) return;   // hooked in the middle of a refresh
+    for (uint32_t i = 0; i < t.count; ++i) {
+        Node& n = t.nodes[i];
+        if (n.display != t.hooked || n.render_us != pending || n.start_us > t.refr_start_us) continue;
+        n.render_us = static_cast<uint32_t>(now - t.refr_start_us);
+        const uint64_t mounted = n.start_us + n.build_us + n.on_mount_us + n.layout_us;
+        n.first_frame_us = static_cast<uint32_t>(now - mounted);
+        --t.render_pending;
+    }
+    trace("first render", t.refr_start_us, now);
+    // LVGL defers removing descriptors of the list it is traversing
+    if (!t.render_pending) unhook();
+}
+
+} // namespace detail
+
+/**
+ * @brief One mount in progress (Component::mount() opens it before build())
+ *
+ * Declared before the BuildScope so its destructor runs after the layout
+ * pass and can time it.
+ */
+class Scope {
+    int16_t m_index = -1;
+    int16_t m_parent;
+    uint64_t m_mark;
+
+public:
+    explicit Scope(const void* component, const char* signature) noexcept
+        : m_parent(detail::tree().current), m_mark(detail::now_us()) {
+        detail::Tree& t = detail::tree();
+        if (t.count == LV_CPP_BUILD_PROFILE_NODES) {
+            if (t.dropped++ == 0) LV_LOG_WARN("build profile full, raise LV_CPP_BUILD_PROFILE_NODES");
+            return;
+        }
+        m_index = static_cast<int16_t>(t.count++);
+        Node& n = t.nodes[m_index];
+        n = Node{};
+        detail::copy_name(n.name, signature);
+        n.component = component;
+        n.parent = m_parent;
+        n.depth = m_parent < 0 ? 0 : static_cast<uint16_t>(t.nodes[m_parent].depth + 1);
+        n.start_us = m_mark;
+        n.render_us = n.first_frame_us = pending;
+        t.current = m_index;
+    }
+
+    /// build() returned `root`
+    void built(lv_obj_t* root) noexcept {
+        const uint64_t now = detail::now_us();
+        detail::trace("build", m_mark, now);
+        if (m_index >= 0) {
+            detail::tree().nodes[m_index].root = root;
+            detail::tree().nodes[m_index].build_us = static_cast<uint32_t>(now - m_mark);
+        }
+        m_mark = now;
+    }
+
+    /// on_mount() returned (or there is none)
+    void mounted() noexcept {
+        if (m_index < 0) return;
+        Node& n = detail::tree().nodes[m_index];
+        const uint64_t now = detail::now_us();
+        if (n.root) {
+            detail::trace("on_mount", m_mark, now);
+            n.on_mount_us = static_cast<uint32_t>(now - m_mark);
+            detail::Counts c;
+            detail::count(n.root, c);
+            n.objects = c.objects;
+            n.styles = c.styles;
+            n.events = c.events;
+        }
+        m_mark = detail::now_us();   // counting is not part of the layout
+    }
+
+    ~Scope() {
+        detail::Tree& t = detail::tree();
+        t.current = m_parent;
+        if (m_index < 0) return;
+        Node& n = t.nodes[m_index];
+        const uint64_t now = detail::now_us();
+        if (m_parent < 0 && n.root) {
+            n.layout_us = static_cast<uint32_t>(now - m_mark);
+            detail::trace("layout", m_mark, now);
+        }
+        if (m_parent < 0) {
+            startup::mark(n.name, static_cast<uint32_t>(now - n.start_us));
+        }
+        lv_display_t* disp = n.root ? lv_obj_get_display(n.root) : nullptr;
+        if (!disp || (t.hooked && t.hooked != disp)) return;   // one display watched at a time
+        n.display = disp;
+        ++t.render_pending;
+        if (!t.hooked) {
+            t.hooked = disp;
+            t.refr_start_us = 0;
+            lv_display_add_event_cb(disp, &detail::refr_cb, LV_EVENT_REFR_START, nullptr);
+            lv_display_add_event_cb(disp, &detail::refr_cb, LV_EVENT_REFR_READY, nullptr);
+        }
+    }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+};
+
+/// Mounts recorded, in mount order (a parent precedes its children)
+[[nodiscard]] inline uint32_t size() noexcept { return detail::tree().count; }
+
+/// Mounts not recorded because the table was full
+[[nodiscard]] inline uint32_t dropped() noexcept { return detail::tree().dropped; }
+
+[[nodiscard]] inline const Node& node(uint32_t i) noexcept { return detail::tree().nodes[i]; }
+
+/// Forget all nodes (not from inside a mount; the startup timeline's names are reused afterwards)
+inline void reset() noexcept {
+    detail::unhook();
+    detail::tree() = detail::Tree{};
+}
+
+/// LV_LOG_USER the tree, one line per mount, indented by nesting depth
+inline void log() noexcept {
+    const detail::Tree& t = detail::tree();
+    LV_LOG_USER("build profile: %u mounts (%u dropped)", static_cast<unsigned>(t.count),
+                static_cast<unsigned>(t.dropped));
+    for (uint32_t i = 0; i < t.count; ++i) {
+        const Node& n = t.nodes[i];
+        const unsigned indent = n.depth * 2u;
+        if (n.render_us == pending) {
+            LV_LOG_USER("  %*s%-*s build %u us  on_mount %u us  layout %u us  render -  %u obj  %u styles  %u events",
+                        indent, "", static_cast<int>(16 - (indent < 16 ? indent : 16)), n.name,
+                        static_cast<unsigned>(n.build_us), static_cast<unsigned>(n.on_mount_us),
+                        static_cast<unsigned>(n.layout_us), static_cast<unsigned>(n.objects),
+                        static_cast<unsigned>(n.styles), static_cast<unsigned>(n.events));
+        } else {
+            LV_LOG_USER("  %*s%-*s build %u us  on_mount %u us  layout %u us  render %u us (+%u)  %u obj  %u styles  %u events",
+                        indent, "", static_cast<int>(16 - (indent < 16 ? indent : 16)), n.name,
+                        static_cast<unsigned>(n.build_us), static_cast<unsigned>(n.on_mount_us),
+                        static_cast<unsigned>(n.layout_us), static_cast<unsigned>(n.render_us),
+                        static_cast<unsigned>(n.first_frame_us), static_cast<unsigned>(n.objects),
+                        static_cast<unsigned>(n.styles), static_cast<unsigned>(n.events));
+        }
+        (void)n;
+        (void)indent;
+    }
+}
+
+} // namespace lv::build_profile
+
+/// Open the profile node of the enclosing mount
+#define LV_CPP_BUILD_PROFILE_SCOPE(component, signature) \
+    ::lv::build_profile::Scope lv_build_profile_scope_((component), (signature))
+#define LV_CPP_BUILD_PROFILE_BUILT(root) lv_build_profile_scope_.built(root)
+#define LV_CPP_BUILD_PROFILE_MOUNTED() lv_build_profile_scope_.mounted()
+
+#else // !LV_CPP_USE_BUILD_PROFILE
+
+#define LV_CPP_BUILD_PROFILE_SCOPE(component, signature) ((void)(component), (void)(signature))
+#define LV_CPP_BUILD_PROFILE_BUILT(root) ((void)(root))
+#define LV_CPP_BUILD_PROFILE_MOUNTED() ((void)0)
+
+#endif // LV_CPP_USE_BUILD_PROFILE
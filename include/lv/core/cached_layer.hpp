@@ -0,0 +1,494 @@
+#pragma once
+
+/**
+ * @file cached_layer.hpp
+ * @brief Render a static subtree once and redraw it from a bitmap
+ *
+ * Dashboards with scales, labels and decorations that never change are
+ * still redrawn object by object whenever something over them animates.
+ * A cached layer snapshots the object with all its children into a
+ * pooled ARGB8888 buffer; while the cache is valid, redraws of the
+ * object draw that bitmap and skip the object's own drawing and its
+ * whole subtree.
+ *
+ * @code
+ * #include <lv/core/cached_layer.hpp>
+ *
+ * auto gauge = lv::CachedLayer::create(screen).size(240, 240);
+ * lv::Scale::create(gauge)...;                 // static decorations
+ *
+ * // or on any existing object
+ * panel.cache_as_bitmap(true);
+ *
+ * label.text("42");                            // no LVGL event for this:
+ * lv::cached_layer::invalidate(panel);         // re-render on the next frame
+ * @endcode
+ *
+ * The cache is dropped automatically when the object or a descendant
+ * gets LV_EVENT_STYLE_CHANGED (so also on theme switches), SIZE_CHANGED,
+ * VALUE_CHANGED, a pressed/focus change, scrolls, or when children are
+ * created or deleted. Plain lv_obj_invalidate() has no hook, so content
+ * changed without any of these events needs invalidate(). Moving the
+ * object keeps the cache.
+ *
+ * Content::self caches only the object's own drawing: children are left
+ * out of the bitmap and drawn live on top of it, and only the object's
+ * own events drop the cache. A Scale with moving needles is the typical
+ * case (Scale::cache_static()). An optional fingerprint function is
+ * checked before every cached draw, so widget properties that change
+ * without an event (a scale's range or tick count) drop the cache too.
+ *
+ * A new bitmap is captured at the display's REFR_READY once the subtree
+ * has gone a whole frame without invalidation, so content that changes
+ * every frame is simply drawn uncached instead of being captured for
+ * nothing. Captures that would exceed LV_CPP_CACHED_LAYER_BYTES are
+ * skipped.
+ *
+ * Requires LV_USE_SNAPSHOT=1.
+ *
+ * Not included by lv.hpp: it swaps lv_layer_t::_clip_area and the
+ * object's spec_attr->child_cnt around the object's drawing, neither of
+ * which is public. Checked against LVGL 9.4 (see LV_CPP_INTERNALS_OK).
+ *
+ * Heap allocation: NONE in the wrapper (fixed table; bitmaps come from
+ * draw::pool_handlers(); LVGL allocates one event descriptor per descendant)
+ */
+
+#include <lvgl.h>
+#include "version.hpp"
+
+#if LV_USE_SNAPSHOT
+
+#if !LV_CPP_INTERNALS_OK
+#error "cached_layer.hpp reads LVGL internals checked against LVGL 9.4; see LV_CPP_INTERNALS_OK"
+#endif
+
+#include <src/core/lv_obj_private.h>   // spec_attr->child_cnt
+#include <src/draw/lv_draw_private.h>  // lv_layer_t::_clip_area
+#include <cstdint>
+#include "object.hpp"
+#include "event.hpp"
+#include "style.hpp"
+#include "snapshot.hpp"
+#include "../draw/draw_buf.hpp"
+
+#ifndef LV_CPP_CACHED_LAYERS
+/// Objects that can be cached at the same time
+#define LV_CPP_CACHED_LAYERS 8
+#endif
+
+#ifndef LV_CPP_CACHED_LAYER_BYTES
+/// Bitmap bytes all cached layers may hold together
+#define LV_CPP_CACHED_LAYER_BYTES (1024u * 1024u)
+#endif
+
+namespace lv::cached_layer {
+
+/// What the bitmap holds
+enum class Content : uint8_t {
+    subtree,   ///< the object and all its children
+    self,      ///< only the object's own drawing; children draw live on top
+};
+
+/// Summary of properties that change the object's look without an event
+using Fingerprint = uint32_t (*)(lv_obj_t* obj);
+
+/// Counters of the cached layers
+struct Stats {
+    uint32_t layers;         ///< objects with caching enabled
+    uint32_t valid;          ///< of these, drawn from a bitmap
+    uint32_t bytes;          ///< bitmap bytes held
+    uint32_t captures;       ///< snapshots taken
+    uint32_t cached_draws;   ///< redraws served by a bitmap
+    uint32_t invalidations;  ///< caches dropped by a change in the subtree
+    uint32_t skipped;        ///< captures not taken (over the byte cap or out of memory)
+};
+
+namespace detail {
+
+enum class State : uint8_t {
+    dirty,     ///< changed during the current frame
+    settling,  ///< unchanged for one REFR_READY; captured at the next
+    valid,     ///< bitmap matches the subtree
+};
+
+struct Entry {
+    lv_obj_t* obj = nullptr;
+    lv_draw_buf_t* buf = nullptr;   ///< pooled ARGB8888 bitmap
+    State state = State::dirty;
+    Content content = Content::subtree;
+    Fingerprint fingerprint = nullptr;
+    uint32_t print = 0;             ///< fingerprint at capture time
+    bool capturing = false;     ///< snapshot in progress: draw normally
+    bool substituted = false;   ///< children hidden for the current redraw
+    uint32_t child_cnt = 0;     ///< hidden child count, restored at DRAW_POST_BEGIN
+    lv_area_t clip{};           ///< layer clip saved at DRAW_MAIN_BEGIN
+};
+
+struct Tables {
+    Entry entries[LV_CPP_CACHED_LAYERS];
+    Stats stats{};
+};
+
+[[nodiscard]] inline Tables& tables() noexcept {
+    static Tables t;
+    return t;
+}
+
+[[nodiscard]] inline Entry* find(lv_obj_t* obj) noexcept {
+    for (Entry& e : tables().entries) {
+        if (e.obj == obj) return &e;
+    }
+    return nullptr;
+}
+
+/// Area the snapshot covers: the coordinates grown by the extended draw size
+[[nodiscard]] inline lv_area_t snapshot_area(lv_obj_t* obj) noexcept {
+    lv_area_t a;
+    lv_obj_get_coords(obj, &a);
+    const int32_t ext = lv_obj_get_ext_draw_size(obj);
+    lv_area_increase(&a, ext, ext);
+    return a;
+}
+
+inline void free_buf(Entry& e) noexcept {
+    if (!e.buf) return;
+    tables().stats.bytes -= e.buf->data_size;
+    lv_image_cache_drop(e.buf);
+    lv_draw_buf_destroy(e.buf);
+    e.buf = nullptr;
+}
+
+inline void mark_dirty(Entry& e) noexcept {
+    Tables& t = tables();
+    if (e.state == State::valid) {
+        --t.stats.valid;
+        ++t.stats.invalidations;
+    }
+    e.state = State::dirty;
+}
+
+/// Events after which the subtree may look different
+[[nodiscard]] constexpr bool changes_look(lv_event_code_t code) noexcept {
+    switch (code) {
+        case LV_EVENT_STYLE_CHANGED:
+        case LV_EVENT_SIZE_CHANGED:
+        case LV_EVENT_VALUE_CHANGED:
+        case LV_EVENT_CHILD_CHANGED:
+        case LV_EVENT_CHILD_CREATED:
+        case LV_EVENT_CHILD_DELETED:
+        case LV_EVENT_SCROLL:
+        case LV_EVENT_LAYOUT_CHANGED:
+        case LV_EVENT_PRESSED:
+        case LV_EVENT_RELEASED:
+        case LV_EVENT_PRESS_LOST:
+        case LV_EVENT_FOCUSED:
+        case LV_EVENT_DEFOCUSED:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/// Child events, which do not concern a Content::self cache
+[[nodiscard]] constexpr bool about_children(lv_event_code_t code) noexcept {
+    return code == LV_EVENT_CHILD_CHANGED || code == LV_EVENT_CHILD_CREATED || code == LV_EVENT_CHILD_DELETED;
+}
+
+inline void watch_cb(lv_event_t* e) noexcept {
+    const lv_event_code_t code = lv_event_get_code(e);
+    if (!changes_look(code)) return;
+    Entry* entry = find(static_cast<lv_obj_t*>(lv_event_get_user_data(e)));
+    // The cache may have been disabled while descendants still carried the callback
+    if (!entry || (entry->content == Content::self && about_children(code))) return;
+    mark_dirty(*entry);
+}
+
+inline lv_obj_tree_walk_res_t watch_walk_cb(lv_obj_t* obj, void* root) noexcept {
+    lv_obj_remove_event_cb_with_user_data(obj, &watch_cb, root);
+    lv_obj_add_event_cb(obj, &watch_cb, LV_EVENT_ALL, root);
+    return LV_OBJ_TREE_WALK_NEXT;
+}
+
+inline lv_obj_tree_walk_res_t unwatch_walk_cb(lv_obj_t* obj, void* root) noexcept {
+    lv_obj_remove_event_cb_with_user_data(obj, &watch_cb, root);
+    return LV_OBJ_TREE_WALK_NEXT;
+}
+
+/// Snapshot `e.obj` into its bitmap; false leaves the entry to be drawn normally
+[[nodiscard]] inline bool capture(Entry& e) noexcept {
+    Tables& t = tables();
+    const lv_area_t a = snapshot_area(e.obj);
+    const uint32_t w = static_cast<uint32_t>(lv_area_get_width(&a));
+    const uint32_t h = static_cast<uint32_t>(lv_area_get_height(&a));
+    const uint32_t need = lv_draw_buf_width_to_stride(w, LV_COLOR_FORMAT_ARGB8888) * h;
+    if (!e.buf || e.buf->data_size < need) {
+        free_buf(e);
+        if (t.stats.bytes + need > LV_CPP_CACHED_LAYER_BYTES) return false;
+        e.buf = lv_draw_buf_create_ex(draw::pool_handlers(), w, h, LV_COLOR_FORMAT_ARGB8888, 0);
+        if (!e.buf) return false;
+        t.stats.bytes += e.buf->data_size;
+    } else {
+        lv_image_cache_drop(e.buf);
+    }
+    // Children created since the last capture start reporting changes too
+    if (e.content == Content::subtree) lv_obj_tree_walk(e.obj, &watch_walk_cb, e.obj);
+    lv_obj_spec_attr_t* spec = e.obj->spec_attr;
+    const uint32_t child_cnt = spec ? spec->child_cnt : 0;
+    if (spec && e.content == Content::self) spec->child_cnt = 0;   // leave the children out
+    e.capturing = true;
+    const bool ok = snapshot::take_to(ObjectView(e.obj), e.buf);
+    e.capturing = false;
+    if (spec) spec->child_cnt = child_cnt;
+    if (!ok) return false;
+    if (e.fingerprint) e.print = e.fingerprint(e.obj);
+    ++t.stats.captures;
+    return true;
+}
+
+inline void refr_ready_cb(lv_event_t* ev) noexcept {
+    Tables& t = tables();
+    auto* disp = static_cast<lv_display_t*>(lv_event_get_current_target(ev));
+    for (Entry& e : t.entries) {
+        if (!e.obj || e.state == State::valid || lv_obj_get_display(e.obj) != disp) continue;
+        if (e.state == State::dirty) {
+            e.state = State::settling;
+            continue;
+        }
+        if (!lv_obj_is_visible(e.obj)) continue;
+        if (capture(e)) {
+            e.state = State::valid;
+            ++t.stats.valid;
+        } else {
+            ++t.stats.skipped;
+            e.state = State::dirty;   // retry once it settles again
+        }
+    }
+}
+
+/// Skip the object's own drawing and its children, then draw the bitmap in their place
+inline void draw_main_begin_cb(lv_event_t* ev) noexcept {
+    Entry* e = find(static_cast<lv_obj_t*>(lv_event_get_current_target(ev)));
+    if (!e || e->capturing || e->state != State::valid) return;
+    const lv_area_t a = snapshot_area(e->obj);
+    if (static_cast<uint32_t>(lv_area_get_width(&a)) != e->buf->header.w ||
+        static_cast<uint32_t>(lv_area_get_height(&a)) != e->buf->header.h ||
+        (e->fingerprint && e->fingerprint(e->obj) != e->print)) {
+        mark_dirty(*e);   // changed without an event reaching us (ext draw size, widget properties)
+        return;
+    }
+    lv_layer_t* layer = lv_event_get_layer(ev);
+    e->clip = layer->_clip_area;
+    layer->_clip_area = lv_area_t{0, 0, -1, -1};   // the class draws into nothing
+    if (e->content == Content::subtree) {
+        e->child_cnt = e->obj->spec_attr ? e->obj->spec_attr->child_cnt : 0;
+        if (e->obj->spec_attr) e->obj->spec_attr->child_cnt = 0;
+    }
+    e->substituted = true;
+}
+
+inline void draw_main_end_cb(lv_event_t* ev) noexcept {
+    Entry* e = find(static_cast<lv_obj_t*>(lv_event_get_current_target(ev)));
+    if (!e || !e->substituted) return;
+    lv_layer_t* layer = lv_event_get_layer(ev);
+    layer->_clip_area = e->clip;
+    lv_draw_image_dsc_t img;
+    lv_draw_image_dsc_init(&img);
+    img.src = e->buf;
+    const lv_area_t a = snapshot_area(e->obj);
+    lv_draw_image(layer, &img, &a);
+    ++tables().stats.cached_draws;
+}
+
+inline void draw_post_begin_cb(lv_event_t* ev) noexcept {
+    Entry* e = find(static_cast<lv_obj_t*>(lv_event_get_current_target(ev)));
+    if (!e || !e->substituted) return;
+    if (e->obj->spec_attr && e->content == Content::subtree) e->obj->spec_attr->child_cnt = e->child_cnt;
+    e->substituted = false;
+}
+
+inline void release(Entry& e, bool deleting) noexcept {
+    Tables& t = tables();
+    if (!deleting) {
+        lv_obj_tree_walk(e.obj, &unwatch_walk_cb, e.obj);
+        lv_obj_remove_event_cb(e.obj, &draw_main_begin_cb);
+        lv_obj_remove_event_cb(e.obj, &draw_main_end_cb);
+        lv_obj_remove_event_cb(e.obj, &draw_post_begin_cb);
+        lv_obj_invalidate(e.obj);
+    }
+    if (e.state == State::valid) --t.stats.valid;
+    free_buf(e);
+    --t.stats.layers;
+    e = Entry{};
+}
+
+inline void delete_cb(lv_event_t* ev) noexcept {
+    Entry* e = find(static_cast<lv_obj_t*>(lv_event_get_current_target(ev)));
+    if (e) release(*e, true);
+}
+
+} // namespace detail
+
+/**
+ * @brief Draw `obj` and its subtree from a cached bitmap while it is unchanged
+ *
+ * The first bitmap is taken after the object has been on screen for a
+ * frame. Returns false if all LV_CPP_CACHED_LAYERS slots are in use.
+ * Enabling twice is a no-op.
+ *
+ * @param content     Content::self leaves the children out of the bitmap
+ * @param fingerprint Checked before each cached draw; a different value drops the cache
+ */
+inline bool enable(ObjectView obj, Content content = Content::subtree, Fingerprint fingerprint = nullptr) noexcept {
+    lv_obj_t* o = obj.get();
+    if (!o) return false;
+    if (detail::find(o)) return true;
+    detail::Entry* e = detail::find(nullptr);
+    if (!e) return false;
+    detail::Tables& t = detail::tables();
+    e->obj = o;
+    e->state = detail::State::dirty;
+    e->content = content;
+    e->fingerprint = fingerprint;
+    ++t.stats.layers;
+    // Preprocess: run before the widget class draws, so its drawing can be skipped
+    lv_obj_add_event_cb(o, &detail::draw_main_begin_cb,
+                        static_cast<lv_event_code_t>(LV_EVENT_DRAW_MAIN_BEGIN | LV_EVENT_PREPROCESS), nullptr);
+    lv_obj_add_event_cb(o, &detail::draw_main_end_cb, LV_EVENT_DRAW_MAIN_END, nullptr);
+    lv_obj_add_event_cb(o, &detail::draw_post_begin_cb,
+                        static_cast<lv_event_code_t>(LV_EVENT_DRAW_POST_BEGIN | LV_EVENT_PREPROCESS), nullptr);
+    lv_obj_add_event_cb(o, &detail::delete_cb, LV_EVENT_DELETE, nullptr);
+    if (content == Content::subtree) {
+        lv_obj_tree_walk(o, &detail::watch_walk_cb, o);
+    } else {
+        detail::watch_walk_cb(o, o);
+    }
+    lv_display_t* disp = lv_obj_get_display(o);
+    lv_display_remove_event_cb_with_user_data(disp, &detail::refr_ready_cb, nullptr);
+    lv_display_add_event_cb(disp, &detail::refr_ready_cb, LV_EVENT_REFR_READY, nullptr);
+    return true;
+}
+
+/// Stop caching `obj` and free its bitmap
+inline void disable(ObjectView obj) noexcept {
+    detail::Entry* e = obj.get() ? detail::find(obj.get()) : nullptr;
+    if (!e) return;
+    lv_obj_remove_event_cb(e->obj, &detail::delete_cb);
+    detail::release(*e, false);
+}
+
+/// Whether caching is enabled for `obj`
+[[nodiscard]] inline bool enabled(ObjectView obj) noexcept {
+    return obj.get() && detail::find(obj.get());
+}
+
+/// Whether `obj` is currently drawn from its bitmap
+[[nodiscard]] inline bool valid(ObjectView obj) noexcept {
+    const detail::Entry* e = obj.get() ? detail::find(obj.get()) : nullptr;
+    return e && e->state == detail::State::valid;
+}
+
+/// Re-render `obj`'s subtree and take a new bitmap once it has settled
+inline void invalidate(ObjectView obj) noexcept {
+    detail::Entry* e = obj.get() ? detail::find(obj.get()) : nullptr;
+    if (!e) return;
+    detail::mark_dirty(*e);
+    lv_obj_invalidate(e->obj);
+}
+
+/// Bitmap bytes held for `obj` (0 if not cached)
+[[nodiscard]] inline uint32_t bytes(ObjectView obj) noexcept {
+    const detail::Entry* e = obj.get() ? detail::find(obj.get()) : nullptr;
+    return e && e->buf ? e->buf->data_size : 0;
+}
+
+[[nodiscard]] inline Stats stats() noexcept { return detail::tables().stats; }
+
+/// Zero the capture/draw counters (sizes are kept)
+inline void reset_stats() noexcept {
+    Stats& s = detail::tables().stats;
+    s.captures = s.cached_draws = s.invalidations = s.skipped = 0;
+}
+
+/// Free every bitmap; objects stay enabled and are captured again when settled
+inline void drop() noexcept {
+    for (detail::Entry& e : detail::tables().entries) {
+        if (!e.obj) continue;
+        detail::mark_dirty(e);
+        detail::free_buf(e);
+    }
+}
+
+} // namespace lv::cached_layer
+
+namespace lv {
+
+namespace detail {
+
+/// ObjectMixin::cache_as_bitmap() lands here (declared in object.hpp)
+template <typename>
+struct CacheAsBitmap {
+    static void set(lv_obj_t* obj, bool en) noexcept {
+        if (en) {
+            cached_layer::enable(ObjectView(obj));
+        } else {
+            cached_layer::disable(ObjectView(obj));
+        }
+    }
+};
+
+} // namespace detail
+
+/**
+ * @brief Container whose subtree is drawn from a cached bitmap
+ *
+ * A plain, non-scrollable lv_obj with cached_layer::enable() applied.
+ * Put the static parts of a panel in it; see cached_layer for when the
+ * bitmap is retaken.
+ *
+ * Size: sizeof(void*) - 4 or 8 bytes
+ */
+class CachedLayer : public ObjectView,
+                    public ObjectMixin<CachedLayer>,
+                    public EventMixin<CachedLayer>,
+                    public StyleMixin<CachedLayer> {
+public:
+    /// Default constructor (null/invalid layer)
+    constexpr CachedLayer() noexcept : ObjectView(nullptr) {}
+
+    /// Wrap an existing lv_obj_t* (does NOT enable caching)
+    constexpr CachedLayer(wrap_t, lv_obj_t* obj) noexcept : ObjectView(obj) {}
+
+    /// Create a container with caching enabled
+    [[nodiscard]] static CachedLayer create(lv_obj_t* parent) {
+        CachedLayer layer;
+        layer.m_obj = lv_obj_create(parent);
+        lv_obj_remove_flag(layer.m_obj, LV_OBJ_FLAG_SCROLLABLE);
+        cached_layer::enable(layer);
+        return layer;
+    }
+
+    [[nodiscard]] static CachedLayer create(ObjectView parent) {
+        return create(parent.get());
+    }
+
+    /// Take a new bitmap once the subtree has settled
+    CachedLayer& invalidate_cache() noexcept {
+        cached_layer::invalidate(*this);
+        return *this;
+    }
+
+    /// Whether the subtree is currently drawn from the bitmap
+    [[nodiscard]] bool is_cached() const noexcept {
+        return cached_layer::valid(*this);
+    }
+
+    /// Bitmap bytes held
+    [[nodiscard]] uint32_t cache_bytes() const noexcept {
+        return cached_layer::bytes(*this);
+    }
+};
+
+} // namespace lv
+
+#endif // LV_USE_SNAPSHOT
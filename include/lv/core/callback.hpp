@@ -0,0 +1,138 @@
+#pragma once
+
+/**
+ * @file callback.hpp
+ * @brief Fixed pool of small-buffer slots for capturing callbacks
+ *
+ * Backs the capturing-lambda overloads that LV_CPP_USE_STD_FUNCTION enables
+ * on EventMixin::on(), Timer::create() and State::observe(). Each callable
+ * is moved into one slot of a static pool with LV_CPP_CALLBACK_STORAGE bytes
+ * of inline storage; nothing is allocated on the heap. The slot is freed
+ * when its owner goes away:
+ *
+ * - event callbacks: on LV_EVENT_DELETE of the widget
+ * - timers: when the owning lv::Timer deletes the timer
+ * - observers: when the State is destroyed, or on LV_EVENT_DELETE of the
+ *   object an observe_obj() observer is tied to
+ *
+ * Usage (with -DLV_CPP_USE_STD_FUNCTION=ON):
+ * @code
+ * int clicks = 0;
+ * btn.on_click([&clicks](lv::Event) { ++clicks; });
+ * auto clock = lv::Timer::create(1000, [this]() { update_clock(); });
+ * rpm.observe_obj(label, [label](int32_t v) { lv_label_set_text_fmt(label, "%d", v); });
+ * @endcode
+ */
+
+#include <lvgl.h>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace lv {
+
+/// Compile-time check for capturing callback support (LV_CPP_USE_STD_FUNCTION)
+#if LV_CPP_USE_STD_FUNCTION
+inline constexpr bool capturing_callbacks = true;
+#else
+inline constexpr bool capturing_callbacks = false;
+#endif
+
+#ifndef LV_CPP_CALLBACK_STORAGE
+/// Inline capture storage per callback, in bytes
+#define LV_CPP_CALLBACK_STORAGE (3 * sizeof(void*))
+#endif
+
+#ifndef LV_CPP_MAX_CALLBACKS
+/// Maximum number of live capturing callbacks
+#define LV_CPP_MAX_CALLBACKS 64
+#endif
+
+namespace detail {
+
+/// One pooled callable; the typed trampoline that registered it knows its type
+struct CallbackSlot {
+    alignas(std::max_align_t) unsigned char storage[LV_CPP_CALLBACK_STORAGE];
+    void (*destroy)(void* storage) noexcept = nullptr;   ///< nullptr = free slot
+    const void* owner = nullptr;   ///< Timer or subject releasing the slot (nullptr: LV_EVENT_DELETE)
+    int32_t runs = -1;             ///< Runs left of a once()/repeat(n) timer, released after the last (-1: none)
+
+    template<typename F>
+    [[nodiscard]] F& as() noexcept {
+        return *std::launder(reinterpret_cast<F*>(storage));
+    }
+};
+
+[[nodiscard]] inline CallbackSlot* callback_slots() noexcept {
+    static CallbackSlot slots[LV_CPP_MAX_CALLBACKS];
+    return slots;
+}
+
+/// Move a callable into a free slot; nullptr if the pool is exhausted
+template<typename F>
+[[nodiscard]] CallbackSlot* acquire_callback(F&& fn, const void* owner = nullptr) noexcept {
+    using Fn = std::decay_t<F>;
+    static_assert(sizeof(Fn) <= LV_CPP_CALLBACK_STORAGE,
+        "Callback captures exceed LV_CPP_CALLBACK_STORAGE: capture a pointer to a struct instead");
+    static_assert(alignof(Fn) <= alignof(std::max_align_t), "Over-aligned callback captures");
+    static_assert(std::is_nothrow_constructible_v<Fn, F&&>,
+        "Callback captures must be nothrow copy/move constructible");
+
+    CallbackSlot* slots = callback_slots();
+    for (size_t i = 0; i < LV_CPP_MAX_CALLBACKS; ++i) {
+        CallbackSlot& slot = slots[i];
+        if (slot.destroy) continue;
+        ::new (static_cast<void*>(slot.storage)) Fn(std::forward<F>(fn));
+        slot.destroy = [](void* p) noexcept { static_cast<Fn*>(p)->~Fn(); };
+        slot.owner = owner;
+        slot.runs = -1;
+        return &slot;
+    }
+    LV_LOG_WARN("callback pool exhausted, raise LV_CPP_MAX_CALLBACKS");
+    return nullptr;
+}
+
+inline void release_callback(CallbackSlot* slot) noexcept {
+    if (!slot || !slot->destroy) return;
+    auto* destroy = slot->destroy;
+    slot->destroy = nullptr;
+    slot->owner = nullptr;
+    destroy(slot->storage);
+}
+
+/// Release every slot owned by a timer or subject
+inline void release_callbacks(const void* owner) noexcept {
+    if (!owner) return;
+    CallbackSlot* slots = callback_slots();
+    for (size_t i = 0; i < LV_CPP_MAX_CALLBACKS; ++i) {
+        if (slots[i].destroy && slots[i].owner == owner) release_callback(&slots[i]);
+    }
+}
+
+/// Slot owned by a timer or subject, nullptr if none
+[[nodiscard]] inline CallbackSlot* owned_callback(const void* owner) noexcept {
+    if (!owner) return nullptr;
+    CallbackSlot* slots = callback_slots();
+    for (size_t i = 0; i < LV_CPP_MAX_CALLBACKS; ++i) {
+        if (slots[i].destroy && slots[i].owner == owner) return &slots[i];
+    }
+    return nullptr;
+}
+
+/// LV_EVENT_DELETE hook releasing the slot in user_data
+inline void callback_delete_cb(lv_event_t* e) noexcept {
+    release_callback(static_cast<CallbackSlot*>(lv_event_get_user_data(e)));
+}
+
+} // namespace detail
+
+/// Number of capturing callbacks currently holding a pool slot
+[[nodiscard]] inline size_t callbacks_in_use() noexcept {
+    const detail::CallbackSlot* slots = detail::callback_slots();
+    size_t n = 0;
+    for (size_t i = 0; i < LV_CPP_MAX_CALLBACKS; ++i) n += slots[i].destroy != nullptr;
+    return n;
+}
+
+} // namespace lv
@@ -38,6 +38,15 @@ inline lv_color_t rgb3(uint32_t hex) noexcept {
     return lv_color_hex3(hex);
 }
 
+/// Compile-time color from hex value (0xRRGGBB), e.g. for lv::ConstStyle
+[[nodiscard]] constexpr lv_color_t const_rgb(uint32_t hex) noexcept {
+    return lv_color_t{
+        .blue = static_cast<uint8_t>(hex & 0xFF),
+        .green = static_cast<uint8_t>((hex >> 8) & 0xFF),
+        .red = static_cast<uint8_t>((hex >> 16) & 0xFF),
+    };
+}
+
 // ==================== Color Constants ====================
 
 namespace colors {
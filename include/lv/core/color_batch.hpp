@@ -0,0 +1,428 @@
+#pragma once
+
+/**
+ * @file color_batch.hpp
+ * @brief Color operations over whole spans: mix, palette lookup, HSV, premultiply, fade
+ *
+ * Calling lv_color_mix() or lv_color_hsv_to_rgb() once per cell costs a
+ * call and a few branches per color, which adds up when a theme generator
+ * or a heatmap colors tens of thousands of cells. The functions in
+ * lv::color take spans and run the same kernels selection as pixel.hpp
+ * (scalar, SSE2, AVX2 picked at runtime, NEON):
+ *
+ * @code
+ * lv_color32_t ramp[256];
+ * lv::color::gradient(ramp, lv::rgb(0x1a237e), lv::rgb(0xffeb3b));    // palette
+ *
+ * lv::Canvas canvas = ...;                                             // ARGB8888 buffer
+ * for (int32_t y = 0; y < rows; ++y) {
+ *     lv::color::lookup(canvas.row32(y), levels.subspan(y * cols, cols), ramp);
+ * }
+ * lv::color::fade(canvas.row32(0), LV_OPA_50);
+ *
+ * lv::color::mix(tints, base, accent, 64);                             // 64/255 of base
+ * lv::color::hsv_to_rgb(wheel, hsv_points);
+ * @endcode
+ *
+ * mix(), fade() and premultiply() work on lv_color_t and lv_color32_t
+ * alike, byte by byte, rounding to nearest. lookup() gathers with AVX2
+ * from full 256-entry lv_color32_t palettes. hsv_to_rgb() takes the
+ * integer steps of lv_color_hsv_to_rgb() eight colors at a time on
+ * SSE2/AVX2 machines. rgb_to_hsv() divides per color and is scalar.
+ * dst may be the same span as a source everywhere; the spans are
+ * processed up to the shortest one's size.
+ *
+ * Heap allocation: NONE
+ */
+
+#include <lvgl.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include "pixel.hpp"
+
+namespace lv::color {
+
+namespace detail {
+
+using pixel::detail::div255;
+
+// ==================== Scalar Kernels ====================
+
+inline void mix_scalar(uint8_t* dst, const uint8_t* a, const uint8_t* b, size_t n, uint8_t ratio) noexcept {
+    const uint32_t inv = 255u - ratio;
+    for (size_t i = 0; i < n; ++i) dst[i] = static_cast<uint8_t>(div255(a[i] * ratio + b[i] * inv));
+}
+
+/// Multiply byte k of every 4-byte group by factor k (0..255)
+inline void scale_scalar(uint8_t* dst, const uint8_t* src, size_t n, const uint8_t (&f)[4]) noexcept {
+    for (size_t i = 0; i < n; ++i) dst[i] = static_cast<uint8_t>(div255(src[i] * f[i & 3]));
+}
+
+/// lv_color_hsv_to_rgb() of the clamped input, with the region switch as selects
+[[nodiscard]] inline lv_color_t hsv_scalar(lv_color_hsv_t c) noexcept {
+    const uint32_t h = std::min<uint32_t>(c.h, 359) * 255u / 360u;
+    const uint32_t s = std::min<uint32_t>(c.s, 100) * 255u / 100u;
+    const uint32_t v = std::min<uint32_t>(c.v, 100) * 255u / 100u;
+    const uint32_t region = h / 43u;
+    const uint32_t rem = ((h - region * 43u) * 6u) & 0xFF;
+    const uint32_t p = (v * (255u - s)) >> 8;
+    const uint32_t q = (v * (255u - ((s * rem) >> 8))) >> 8;
+    const uint32_t t = (v * (255u - ((s * (255u - rem)) >> 8))) >> 8;
+    uint32_t r = region == 0 || region >= 5 ? v : region == 1 ? q : region == 4 ? t : p;
+    uint32_t g = region == 0 ? t : region <= 2 ? v : region == 3 ? q : p;
+    uint32_t b = region <= 1 ? p : region == 2 ? t : region <= 4 ? v : q;
+    if (s == 0) r = g = b = v;
+    return lv_color_make(static_cast<uint8_t>(r), static_cast<uint8_t>(g), static_cast<uint8_t>(b));
+}
+
+// ==================== SSE2 ====================
+
+#if LV_CPP_PIXEL_SSE2
+/// round(x / 255) per 16-bit lane, x <= 255 * 255
+[[nodiscard]] inline __m128i div255_sse2(__m128i x) noexcept {
+    x = _mm_add_epi16(x, _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+
+inline void mix_sse2(uint8_t* dst, const uint8_t* a, const uint8_t* b, size_t n, uint8_t ratio) noexcept {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i r = _mm_set1_epi16(ratio), inv = _mm_set1_epi16(static_cast<int16_t>(255 - ratio));
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        const __m128i lo = div255_sse2(_mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(va, zero), r),
+                                                     _mm_mullo_epi16(_mm_unpacklo_epi8(vb, zero), inv)));
+        const __m128i hi = div255_sse2(_mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(va, zero), r),
+                                                     _mm_mullo_epi16(_mm_unpackhi_epi8(vb, zero), inv)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(lo, hi));
+    }
+    mix_scalar(dst + i, a + i, b + i, n - i, ratio);
+}
+
+inline void scale_sse2(uint8_t* dst, const uint8_t* src, size_t n, const uint8_t (&f)[4]) noexcept {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i fv = _mm_set_epi16(f[3], f[2], f[1], f[0], f[3], f[2], f[1], f[0]);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        const __m128i lo = div255_sse2(_mm_mullo_epi16(_mm_unpacklo_epi8(p, zero), fv));
+        const __m128i hi = div255_sse2(_mm_mullo_epi16(_mm_unpackhi_epi8(p, zero), fv));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(lo, hi));
+    }
+    scale_scalar(dst + i, src + i, n - i, f);
+}
+
+/// a == b ? x : y per 16-bit lane
+[[nodiscard]] inline __m128i pick_sse2(__m128i region, int16_t value, __m128i x, __m128i y) noexcept {
+    const __m128i m = _mm_cmpeq_epi16(region, _mm_set1_epi16(value));
+    return _mm_or_si128(_mm_and_si128(m, x), _mm_andnot_si128(m, y));
+}
+
+/// Eight colors per step; the divisions are exact multiply-high reciprocals for the input ranges
+inline void hsv_sse2(lv_color_t* dst, const lv_color_hsv_t* src, size_t n) noexcept {
+    alignas(16) uint16_t hs[8], ss[8], vs[8];
+    alignas(16) uint16_t rs[8], gs[8], bs[8];
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        for (uint32_t k = 0; k < 8; ++k) {
+            hs[k] = src[i + k].h;
+            ss[k] = src[i + k].s;
+            vs[k] = src[i + k].v;
+        }
+        const __m128i h360 = _mm_min_epi16(_mm_load_si128(reinterpret_cast<const __m128i*>(hs)), _mm_set1_epi16(359));
+        const __m128i h = _mm_mulhi_epu16(_mm_mullo_epi16(h360, _mm_set1_epi16(17)), _mm_set1_epi16(2731));   // * 255 / 360
+        const __m128i c100 = _mm_set1_epi16(100);
+        const __m128i s100 = _mm_min_epi16(_mm_load_si128(reinterpret_cast<const __m128i*>(ss)), c100);
+        const __m128i v100 = _mm_min_epi16(_mm_load_si128(reinterpret_cast<const __m128i*>(vs)), c100);
+        const __m128i s = _mm_srli_epi16(_mm_mulhi_epu16(_mm_mullo_epi16(s100, _mm_set1_epi16(255)),
+                                                         _mm_set1_epi16(5243)), 3);   // * 255 / 100
+        const __m128i v = _mm_srli_epi16(_mm_mulhi_epu16(_mm_mullo_epi16(v100, _mm_set1_epi16(255)),
+                                                         _mm_set1_epi16(5243)), 3);
+        const __m128i region = _mm_mulhi_epu16(h, _mm_set1_epi16(1525));                        // / 43
+        const __m128i rem = _mm_and_si128(_mm_mullo_epi16(_mm_sub_epi16(h, _mm_mullo_epi16(region, _mm_set1_epi16(43))),
+                                                          _mm_set1_epi16(6)),
+                                          _mm_set1_epi16(0xFF));
+        const __m128i c255 = _mm_set1_epi16(255);
+        const __m128i p = _mm_srli_epi16(_mm_mullo_epi16(v, _mm_sub_epi16(c255, s)), 8);
+        const __m128i q = _mm_srli_epi16(
+            _mm_mullo_epi16(v, _mm_sub_epi16(c255, _mm_srli_epi16(_mm_mullo_epi16(s, rem), 8))), 8);
+        const __m128i t = _mm_srli_epi16(
+            _mm_mullo_epi16(v, _mm_sub_epi16(c255, _mm_srli_epi16(_mm_mullo_epi16(s, _mm_sub_epi16(c255, rem)), 8))), 8);
+        // region: 0 (v t p), 1 (q v p), 2 (p v t), 3 (p q v), 4 (t p v), 5 (v p q)
+        __m128i r = pick_sse2(region, 0, v, pick_sse2(region, 1, q, pick_sse2(region, 4, t, pick_sse2(region, 5, v, p))));
+        __m128i g = pick_sse2(region, 0, t, pick_sse2(region, 3, q, pick_sse2(region, 4, p, pick_sse2(region, 5, p, v))));
+        __m128i b = pick_sse2(region, 2, t, pick_sse2(region, 3, v, pick_sse2(region, 4, v, pick_sse2(region, 5, q, p))));
+        const __m128i grey = _mm_cmpeq_epi16(s, _mm_setzero_si128());
+        r = _mm_or_si128(_mm_and_si128(grey, v), _mm_andnot_si128(grey, r));
+        g = _mm_or_si128(_mm_and_si128(grey, v), _mm_andnot_si128(grey, g));
+        b = _mm_or_si128(_mm_and_si128(grey, v), _mm_andnot_si128(grey, b));
+        _mm_store_si128(reinterpret_cast<__m128i*>(rs), r);
+        _mm_store_si128(reinterpret_cast<__m128i*>(gs), g);
+        _mm_store_si128(reinterpret_cast<__m128i*>(bs), b);
+        for (uint32_t k = 0; k < 8; ++k) {
+            dst[i + k] = lv_color_make(static_cast<uint8_t>(rs[k]), static_cast<uint8_t>(gs[k]),
+                                       static_cast<uint8_t>(bs[k]));
+        }
+    }
+    for (; i < n; ++i) dst[i] = hsv_scalar(src[i]);
+}
+#endif
+
+// ==================== AVX2 ====================
+
+#if LV_CPP_PIXEL_AVX2
+#if defined(__AVX2__)
+#define LV_CPP_COLOR_AVX2_FN inline
+#else
+#define LV_CPP_COLOR_AVX2_FN __attribute__((target("avx2"))) inline
+#endif
+
+LV_CPP_COLOR_AVX2_FN __m256i div255_avx2(__m256i x) noexcept {
+    x = _mm256_add_epi16(x, _mm256_set1_epi16(128));
+    return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), 8);
+}
+
+LV_CPP_COLOR_AVX2_FN void mix_avx2(uint8_t* dst, const uint8_t* a, const uint8_t* b, size_t n,
+                                   uint8_t ratio) noexcept {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i r = _mm256_set1_epi16(ratio), inv = _mm256_set1_epi16(static_cast<int16_t>(255 - ratio));
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        // unpack and pack are both per 128-bit lane, so byte order is preserved
+        const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        const __m256i lo = div255_avx2(_mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(va, zero), r),
+                                                        _mm256_mullo_epi16(_mm256_unpacklo_epi8(vb, zero), inv)));
+        const __m256i hi = div255_avx2(_mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(va, zero), r),
+                                                        _mm256_mullo_epi16(_mm256_unpackhi_epi8(vb, zero), inv)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_packus_epi16(lo, hi));
+    }
+    mix_sse2(dst + i, a + i, b + i, n - i, ratio);
+}
+
+LV_CPP_COLOR_AVX2_FN void scale_avx2(uint8_t* dst, const uint8_t* src, size_t n, const uint8_t (&f)[4]) noexcept {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i fv = _mm256_set_epi16(f[3], f[2], f[1], f[0], f[3], f[2], f[1], f[0],
+                                        f[3], f[2], f[1], f[0], f[3], f[2], f[1], f[0]);
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        const __m256i p = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        const __m256i lo = div255_avx2(_mm256_mullo_epi16(_mm256_unpacklo_epi8(p, zero), fv));
+        const __m256i hi = div255_avx2(_mm256_mullo_epi16(_mm256_unpackhi_epi8(p, zero), fv));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_packus_epi16(lo, hi));
+    }
+    scale_sse2(dst + i, src + i, n - i, f);
+}
+
+/// Eight palette entries per gather; `palette` has 256 entries, so any index is in range
+LV_CPP_COLOR_AVX2_FN void lookup32_avx2(lv_color32_t* dst, const uint8_t* idx, size_t n,
+                                        const lv_color32_t* palette) noexcept {
+    const int* base = reinterpret_cast<const int*>(palette);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256i k = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(idx + i)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_i32gather_epi32(base, k, 4));
+    }
+    for (; i < n; ++i) dst[i] = palette[idx[i]];
+}
+
+#undef LV_CPP_COLOR_AVX2_FN
+#endif
+
+// ==================== NEON ====================
+
+#if LV_CPP_PIXEL_NEON
+inline void mix_neon(uint8_t* dst, const uint8_t* a, const uint8_t* b, size_t n, uint8_t ratio) noexcept {
+    const uint8x8_t r = vdup_n_u8(ratio), inv = vdup_n_u8(static_cast<uint8_t>(255 - ratio));
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const uint16x8_t t = vmlal_u8(vmull_u8(vld1_u8(a + i), r), vld1_u8(b + i), inv);
+        vst1_u8(dst + i, vraddhn_u16(t, vrshrq_n_u16(t, 8)));   // round(t / 255)
+    }
+    mix_scalar(dst + i, a + i, b + i, n - i, ratio);
+}
+
+inline void scale_neon(uint8_t* dst, const uint8_t* src, size_t n, const uint8_t (&f)[4]) noexcept {
+    const uint8_t pattern[8] = {f[0], f[1], f[2], f[3], f[0], f[1], f[2], f[3]};
+    const uint8x8_t fv = vld1_u8(pattern);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const uint16x8_t t = vmull_u8(vld1_u8(src + i), fv);
+        vst1_u8(dst + i, vraddhn_u16(t, vrshrq_n_u16(t, 8)));
+    }
+    scale_scalar(dst + i, src + i, n - i, f);
+}
+#endif
+
+// ==================== Dispatch ====================
+
+inline void mix_bytes(uint8_t* dst, const uint8_t* a, const uint8_t* b, size_t n, uint8_t ratio) noexcept {
+    switch (pixel::isa()) {
+#if LV_CPP_PIXEL_AVX2
+    case pixel::Isa::avx2: mix_avx2(dst, a, b, n, ratio); return;
+#endif
+#if LV_CPP_PIXEL_SSE2
+    case pixel::Isa::sse2: mix_sse2(dst, a, b, n, ratio); return;
+#endif
+#if LV_CPP_PIXEL_NEON
+    case pixel::Isa::neon: mix_neon(dst, a, b, n, ratio); return;
+#endif
+    default: mix_scalar(dst, a, b, n, ratio); return;
+    }
+}
+
+inline void scale_bytes(uint8_t* dst, const uint8_t* src, size_t n, const uint8_t (&f)[4]) noexcept {
+    switch (pixel::isa()) {
+#if LV_CPP_PIXEL_AVX2
+    case pixel::Isa::avx2: scale_avx2(dst, src, n, f); return;
+#endif
+#if LV_CPP_PIXEL_SSE2
+    case pixel::Isa::sse2: scale_sse2(dst, src, n, f); return;
+#endif
+#if LV_CPP_PIXEL_NEON
+    case pixel::Isa::neon: scale_neon(dst, src, n, f); return;
+#endif
+    default: scale_scalar(dst, src, n, f); return;
+    }
+}
+
+template<typename C>
+[[nodiscard]] inline uint8_t* bytes(C* p) noexcept { return reinterpret_cast<uint8_t*>(p); }
+
+template<typename C>
+[[nodiscard]] inline const uint8_t* bytes(const C* p) noexcept { return reinterpret_cast<const uint8_t*>(p); }
+
+} // namespace detail
+
+// ==================== Mixing ====================
+
+/**
+ * @brief dst[i] = a[i] * ratio / 255 + b[i] * (255 - ratio) / 255, per channel
+ *
+ * Same weighting as lv_color_mix(): 255 gives `a`, 0 gives `b`.
+ */
+inline void mix(std::span<lv_color_t> dst, std::span<const lv_color_t> a, std::span<const lv_color_t> b,
+                uint8_t ratio) noexcept {
+    const size_t n = std::min({dst.size(), a.size(), b.size()});
+    detail::mix_bytes(detail::bytes(dst.data()), detail::bytes(a.data()), detail::bytes(b.data()), 3 * n, ratio);
+}
+
+/// mix() of ARGB colors; alpha is mixed like the channels
+inline void mix(std::span<lv_color32_t> dst, std::span<const lv_color32_t> a, std::span<const lv_color32_t> b,
+                uint8_t ratio) noexcept {
+    const size_t n = std::min({dst.size(), a.size(), b.size()});
+    detail::mix_bytes(detail::bytes(dst.data()), detail::bytes(a.data()), detail::bytes(b.data()), 4 * n, ratio);
+}
+
+/// Mix every color of `src` with the one color `with` (tints, shades, theme variants)
+inline void mix(std::span<lv_color_t> dst, std::span<const lv_color_t> src, lv_color_t with, uint8_t ratio) noexcept {
+    constexpr size_t CHUNK = 64;
+    lv_color_t fill[CHUNK];
+    std::fill(std::begin(fill), std::end(fill), with);
+    const size_t n = std::min(dst.size(), src.size());
+    for (size_t i = 0; i < n; i += CHUNK) {
+        const size_t k = std::min(CHUNK, n - i);
+        mix(dst.subspan(i, k), src.subspan(i, k), std::span<const lv_color_t>(fill, k), ratio);
+    }
+}
+
+/// Fill `dst` with an even blend from `from` (first entry) to `to` (last entry)
+template<typename C>
+inline void gradient(std::span<C> dst, lv_color_t from, lv_color_t to) noexcept {
+    const size_t n = dst.size();
+    for (size_t i = 0; i < n; ++i) {
+        const auto ratio = static_cast<uint8_t>(n > 1 ? 255 - i * 255 / (n - 1) : 255);
+        const lv_color_t c = lv_color_mix(from, to, ratio);
+        if constexpr (sizeof(C) == sizeof(lv_color32_t)) {
+            dst[i] = lv_color_to_32(c, LV_OPA_COVER);
+        } else {
+            dst[i] = c;
+        }
+    }
+}
+
+template<typename C, size_t N>
+inline void gradient(C (&dst)[N], lv_color_t from, lv_color_t to) noexcept {
+    gradient(std::span<C>(dst), from, to);
+}
+
+// ==================== Palettes ====================
+
+/**
+ * @brief dst[i] = palette[index[i]]; indices past the palette take its last entry
+ *
+ * A 256-entry palette is looked up without a range check, and with AVX2
+ * gathers where available. Write straight into a canvas row (Canvas::row32()).
+ */
+inline void lookup(std::span<lv_color32_t> dst, std::span<const uint8_t> index,
+                   std::span<const lv_color32_t> palette) noexcept {
+    const size_t n = std::min(dst.size(), index.size());
+    if (palette.empty()) return;
+    if (palette.size() >= 256) {
+#if LV_CPP_PIXEL_AVX2
+        if (pixel::isa() == pixel::Isa::avx2) {
+            detail::lookup32_avx2(dst.data(), index.data(), n, palette.data());
+            return;
+        }
+#endif
+        for (size_t i = 0; i < n; ++i) dst[i] = palette[index[i]];
+        return;
+    }
+    const size_t last = palette.size() - 1;
+    for (size_t i = 0; i < n; ++i) dst[i] = palette[std::min<size_t>(index[i], last)];
+}
+
+/// lookup() into RGB colors (chart series, style arrays)
+inline void lookup(std::span<lv_color_t> dst, std::span<const uint8_t> index,
+                   std::span<const lv_color_t> palette) noexcept {
+    const size_t n = std::min(dst.size(), index.size());
+    if (palette.empty()) return;
+    const size_t last = palette.size() - 1;
+    for (size_t i = 0; i < n; ++i) dst[i] = palette[std::min<size_t>(index[i], last)];
+}
+
+// ==================== HSV ====================
+
+/// lv_color_hsv_to_rgb() for every entry (h 0..359, s and v 0..100; larger values are clamped)
+inline void hsv_to_rgb(std::span<lv_color_t> dst, std::span<const lv_color_hsv_t> src) noexcept {
+    const size_t n = std::min(dst.size(), src.size());
+#if LV_CPP_PIXEL_SSE2
+    if (pixel::isa() != pixel::Isa::scalar) {
+        detail::hsv_sse2(dst.data(), src.data(), n);
+        return;
+    }
+#endif
+    for (size_t i = 0; i < n; ++i) dst[i] = detail::hsv_scalar(src[i]);
+}
+
+/// lv_color_rgb_to_hsv() for every entry (one division per color, no SIMD form)
+inline void rgb_to_hsv(std::span<lv_color_hsv_t> dst, std::span<const lv_color_t> src) noexcept {
+    const size_t n = std::min(dst.size(), src.size());
+    for (size_t i = 0; i < n; ++i) dst[i] = lv_color_to_hsv(src[i]);
+}
+
+// ==================== Opacity ====================
+
+/// Multiply the channels of ARGB colors by their alpha (pixel::premultiply())
+inline void premultiply(std::span<lv_color32_t> px) noexcept {
+    pixel::premultiply(detail::bytes(px.data()), detail::bytes(px.data()), static_cast<uint32_t>(px.size()));
+}
+
+/// Scale the alpha of ARGB colors by `opa`
+inline void fade(std::span<lv_color32_t> px, lv_opa_t opa) noexcept {
+    if (opa == LV_OPA_COVER) return;
+    const uint8_t f[4] = {255, 255, 255, opa};   // lv_color32_t is blue, green, red, alpha
+    detail::scale_bytes(detail::bytes(px.data()), detail::bytes(px.data()), 4 * px.size(), f);
+}
+
+/// Scale premultiplied ARGB colors (channels and alpha) by `opa`
+inline void fade_premultiplied(std::span<lv_color32_t> px, lv_opa_t opa) noexcept {
+    if (opa == LV_OPA_COVER) return;
+    const uint8_t f[4] = {opa, opa, opa, opa};
+    detail::scale_bytes(detail::bytes(px.data()), detail::bytes(px.data()), 4 * px.size(), f);
+}
+
+} // namespace lv::color
@@ -9,10 +9,163 @@
  */
 
 #include <lvgl.h>
+#include <cstdint>
+#include <type_traits>
 #include "object.hpp"
+#include "profiler.hpp"
+#include "mem_account.hpp"
+#include "startup.hpp"
+#include "build_profile.hpp"
+#include "subscription.hpp"
 
 namespace lv {
 
+// ==================== Component Owner Table ====================
+
+#ifndef LV_CPP_COMPONENT_TABLE_SIZE
+/// Slots in the component owner table (power of two, filled up to 3/4)
+#define LV_CPP_COMPONENT_TABLE_SIZE 256
+#endif
+
+namespace detail {
+
+static_assert((LV_CPP_COMPONENT_TABLE_SIZE & (LV_CPP_COMPONENT_TABLE_SIZE - 1)) == 0,
+              "LV_CPP_COMPONENT_TABLE_SIZE must be a power of two");
+
+/// One component root: the tag is the root_delete_cb of its Component<Derived>
+struct ComponentEntry {
+    const lv_obj_t* obj = nullptr;     ///< nullptr = free slot
+    lv_event_cb_t tag = nullptr;
+    void* owner = nullptr;
+};
+
+/// Linear-probing table of component roots (backward-shift deletion, no tombstones)
+struct ComponentTable {
+    static constexpr uint32_t SIZE = LV_CPP_COMPONENT_TABLE_SIZE;
+    static constexpr uint32_t MASK = SIZE - 1;
+    static constexpr uint32_t MAX_LOAD = SIZE - SIZE / 4;
+
+    ComponentEntry slots[SIZE];
+    uint32_t count = 0;
+    uint32_t overflow = 0;   ///< Roots that did not fit; found by scanning instead
+
+    [[nodiscard]] static uint32_t home(const lv_obj_t* obj) noexcept {
+        const uint64_t v = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(obj)) >> 3;
+        return static_cast<uint32_t>((v * 0x9E3779B97F4A7C15ull) >> 32) & MASK;
+    }
+
+    /// Slot holding (obj, tag), or the free slot that ends its probe sequence
+    [[nodiscard]] uint32_t probe(const lv_obj_t* obj, lv_event_cb_t tag) const noexcept {
+        uint32_t i = home(obj);
+        while (slots[i].obj && (slots[i].obj != obj || slots[i].tag != tag)) i = (i + 1) & MASK;
+        return i;
+    }
+
+    void insert(const lv_obj_t* obj, lv_event_cb_t tag, void* owner) noexcept {
+        const uint32_t i = probe(obj, tag);
+        if (!slots[i].obj) {
+            if (count >= MAX_LOAD) {
+                ++overflow;
+                return;
+            }
+            ++count;
+        }
+        slots[i] = ComponentEntry{obj, tag, owner};
+    }
+
+    [[nodiscard]] void* find(const lv_obj_t* obj, lv_event_cb_t tag) const noexcept {
+        return slots[probe(obj, tag)].owner;
+    }
+
+    void erase(const lv_obj_t* obj, lv_event_cb_t tag) noexcept {
+        uint32_t i = probe(obj, tag);
+        if (!slots[i].obj) {
+            if (overflow > 0) --overflow;
+            return;
+        }
+        // Pull later entries of the cluster back so probes never stop early
+        for (uint32_t j = (i + 1) & MASK; slots[j].obj; j = (j + 1) & MASK) {
+            const uint32_t h = home(slots[j].obj);
+            if (((j - h) & MASK) >= ((j - i) & MASK)) {
+                slots[i] = slots[j];
+                i = j;
+            }
+        }
+        slots[i] = ComponentEntry{};
+        --count;
+    }
+};
+
+[[nodiscard]] inline ComponentTable& component_table() noexcept {
+    static ComponentTable table;
+    return table;
+}
+
+} // namespace detail
+
+/**
+ * @brief RAII guard that batches layout and invalidation of a subtree build
+ *
+ * While the scope is open, invalidation is disabled on the parent's display,
+ * so fluent setters on freshly created children don't each add and merge
+ * dirty areas. On exit the layout is updated once and the built root (or the
+ * parent, if no root was set) is invalidated once.
+ *
+ * LVGL already postpones layout to the next refresh; the single pass at exit
+ * makes sure widgets are positioned before the next getter or refresh, and
+ * scopes opened inside another scope (nested Component::mount) do nothing.
+ * Getters that force a layout update (e.g. get_width()) inside the scope
+ * still pay for a full layout pass, so read sizes after the scope closes.
+ *
+ * Component::mount() opens one automatically around build().
+ *
+ * @code
+ * {
+ *     lv::BuildScope scope(screen);
+ *     for (int i = 0; i < 200; ++i) {
+ *         lv::Label::create(screen).text("row").width(lv::pct(100));
+ *     }
+ * }   // one layout pass, one invalidated area
+ * @endcode
+ */
+class BuildScope {
+    lv_display_t* m_disp = nullptr;
+    lv_obj_t* m_target = nullptr;
+
+public:
+    explicit BuildScope(ObjectView parent) noexcept {
+        if (!parent) return;
+        lv_display_t* disp = lv_obj_get_display(parent.get());
+        // Already inside a scope (or invalidation disabled by the app): leave it to the owner
+        if (!disp || !lv_display_is_invalidation_enabled(disp)) return;
+        m_disp = disp;
+        m_target = parent.get();
+        lv_display_enable_invalidation(m_disp, false);
+    }
+
+    ~BuildScope() {
+        if (!m_disp) return;
+        lv_display_enable_invalidation(m_disp, true);
+        if (m_target) {
+            lv_obj_update_layout(m_target);
+            lv_obj_invalidate(m_target);
+        }
+    }
+
+    BuildScope(const BuildScope&) = delete;
+    BuildScope& operator=(const BuildScope&) = delete;
+
+    /// Narrow the final invalidation to the built subtree root
+    void set_root(ObjectView root) noexcept {
+        if (m_disp && root) m_target = root.get();
+    }
+
+    /// Check whether this scope owns the suspension (false when nested)
+    [[nodiscard]] bool active() const noexcept {
+        return m_disp != nullptr;
+    }
+};
+
 /**
  * @brief CRTP base class for UI components
  *
@@ -21,17 +174,21 @@ namespace lv {
  *
  * Features:
  * - Zero virtual call overhead (CRTP static dispatch)
- * - Component lookup via event-descriptor scanning (no user_data collision)
+ * - O(1) component lookup via an owner side table (no user_data collision)
  * - Mount/unmount lifecycle management
+ * - subscribe(): state subscriptions removed on unmount, no allocation
  * - user_data() on component roots is freely usable by application code
  *
  * Size: sizeof(void*) = 8 bytes on 64-bit (just the root pointer)
  *
  * Ownership lookup: root_delete_cb is registered on every component root.
  * Its callback address &Component<Derived>::root_delete_cb is unique per
- * Derived type. owner_from_obj() scans event descriptors to find it and
- * extracts the component pointer from the event's user_data. This avoids
- * probing lv_obj_t::user_data entirely, eliminating UB.
+ * Derived type and doubles as a type tag. Roots are recorded in a fixed-size
+ * open-addressing table keyed by (object, tag), so owner_from_obj() is a
+ * hash probe instead of a walk over the root's event descriptors. If the
+ * table is full, further roots are found by scanning for the descriptor and
+ * reading the component pointer from its user_data. lv_obj_t::user_data is
+ * never probed, eliminating UB.
  *
  * Usage:
  * @code
@@ -74,6 +231,8 @@ private:
     /// Delete-event hook: nulls m_root when LVGL deletes the root externally
     /// (e.g. screen auto_del). Prevents double-delete in destructor/unmount.
     static void root_delete_cb(lv_event_t* e) noexcept {
+        detail::component_table().erase(lv_event_get_current_target_obj(e), tag());
+
         auto* derived = static_cast<Derived*>(lv_event_get_user_data(e));
         if (!derived) return;
 
@@ -83,8 +242,13 @@ private:
         }
     }
 
+    [[nodiscard]] static lv_event_cb_t tag() noexcept {
+        return &Component::root_delete_cb;
+    }
+
     static void attach_root_delete_hook(lv_obj_t* root, Derived* owner) noexcept {
         lv_obj_add_event_cb(root, &Component::root_delete_cb, LV_EVENT_DELETE, owner);
+        detail::component_table().insert(root, tag(), owner);
     }
 
     static void rebind_root_delete_hook(lv_obj_t* root, Derived* old_owner,
@@ -93,11 +257,22 @@ private:
         attach_root_delete_hook(root, new_owner);
     }
 
-    /// Scan event descriptors on obj for root_delete_cb; return owning Derived*.
+    /// Hand the pooled subscriptions of a moved-from component to this one
+    void rebind_subscriptions([[maybe_unused]] Component& other) noexcept {
+#if LV_USE_OBSERVER
+        detail::rebind_owner(&other, this, static_cast<Derived*>(this));
+#endif
+    }
+
+    /// Look up the owning Derived* of a component root: one table probe, plus a
+    /// descriptor scan only for roots registered while the table was full.
     /// The callback address &Component::root_delete_cb is unique per Derived type,
     /// so this is type-safe. Uses only public, stable LVGL APIs.
     [[nodiscard]] static Derived* owner_from_obj(lv_obj_t* obj) noexcept {
         if (!obj) return nullptr;
+        const detail::ComponentTable& table = detail::component_table();
+        if (void* owner = table.find(obj, tag())) return static_cast<Derived*>(owner);
+        if (table.overflow == 0) return nullptr;
         const uint32_t n = lv_obj_get_event_count(obj);
         for (uint32_t i = 0; i < n; ++i) {
             lv_event_dsc_t* d = lv_obj_get_event_dsc(obj, i);
@@ -125,6 +300,7 @@ public:
             auto* new_owner = static_cast<Derived*>(this);
             rebind_root_delete_hook(m_root, old_owner, new_owner);
         }
+        rebind_subscriptions(other);
     }
 
     Component& operator=(Component&& other) noexcept {
@@ -137,6 +313,7 @@ public:
                 auto* new_owner = static_cast<Derived*>(this);
                 rebind_root_delete_hook(m_root, old_owner, new_owner);
             }
+            rebind_subscriptions(other);
         }
         return *this;
     }
@@ -144,6 +321,7 @@ public:
     /// Destructor unmounts if mounted
     ~Component() {
         unmount();
+        LV_CPP_MEM_ACCOUNT_ROOT(this, nullptr);
     }
 
     // ==================== Lifecycle ====================
@@ -152,36 +330,57 @@ public:
      * @brief Mount the component to a parent
      *
      * Calls the derived class's build() method and stores the result.
-     * A delete-event hook is registered on the root to track external deletion.
+     * build() runs inside a BuildScope: layout and invalidation happen once
+     * for the whole subtree when it returns. A delete-event hook is registered on the root to track external deletion.
      * The root's user_data is not touched — it remains available for application use.
      *
      * @param parent The parent object (ObjectView)
      */
     void mount(ObjectView parent) {
+        LV_PROFILE_FUNCTION();
         if (m_root) {
             unmount();
         }
 
+        LV_CPP_BUILD_PROFILE_SCOPE(this, LV_CPP_PROFILE_FUNC_NAME);
+        BuildScope scope(parent);
+        LV_CPP_MEM_ACCOUNT_SCOPE(this, LV_CPP_PROFILE_FUNC_NAME);
+
         // Call derived class build() - CRTP static dispatch
         ObjectView root = static_cast<Derived*>(this)->build(parent);
         m_root = root.get();
+        LV_CPP_BUILD_PROFILE_BUILT(m_root);
+        scope.set_root(root);
+        LV_CPP_MEM_ACCOUNT_ROOT(this, &m_root);
 
         if (m_root) {
             attach_root_delete_hook(m_root, static_cast<Derived*>(this));
+#if LV_USE_OBSERVER
+            // Compile-time binding table (see bindings.hpp): one subscription per state
+            if constexpr (requires { typename Derived::bindings; }) {
+                Derived::bindings::attach(*static_cast<Derived*>(this), this);
+            }
+#endif
 
             // Call optional lifecycle hook
             if constexpr (requires { static_cast<Derived*>(this)->on_mount(); }) {
                 static_cast<Derived*>(this)->on_mount();
             }
         }
+        LV_CPP_BUILD_PROFILE_MOUNTED();
+        startup::mark(startup::Phase::mount);
     }
 
     /**
      * @brief Unmount the component
      *
-     * Deletes the root object (LVGL cascades to children).
+     * Deletes the root object (LVGL cascades to children) and removes the
+     * component's subscribe() subscriptions.
      */
     void unmount() {
+#if LV_USE_OBSERVER
+        detail::unsubscribe_owner(this);
+#endif
         if (m_root) {
             // Call optional lifecycle hook.
             // Note: the hook may delete m_root externally, which triggers
@@ -197,6 +396,32 @@ public:
         }
     }
 
+#if LV_USE_OBSERVER
+    /**
+     * @brief Subscribe a member function of the component to a state
+     *
+     * The subscription lives until unmount() or destruction, so call it
+     * from build(). No allocation: the node comes from a fixed pool
+     * (LV_CPP_SUBSCRIPTION_POOL). The callback runs once right away with
+     * the current value.
+     *
+     * @code
+     * lv::ObjectView build(lv::ObjectView parent) {
+     *     subscribe<&Dashboard::on_rpm>(rpm);
+     *     ...
+     * }
+     * @endcode
+     *
+     * @return false if the pool or the observer hubs are exhausted
+     */
+    template<auto MemFn, typename S>
+        requires std::is_member_function_pointer_v<decltype(MemFn)>
+    bool subscribe(S& state) noexcept {
+        return detail::subscribe_pooled(state.subject(), &S::template subscriber_cb<MemFn, Derived>,
+                                        static_cast<Derived*>(this), this);
+    }
+#endif
+
     /**
      * @brief Check if component is mounted
      */
@@ -248,9 +473,9 @@ public:
     /**
      * @brief Get component instance from an event
      *
-     * Walks up the widget tree scanning event descriptors on each node
-     * for the root_delete_cb unique to this Component<Derived> type.
-     * O(events) per node, type-safe (only matches this specific Derived type).
+     * Walks up the widget tree and looks each node up in the owner table
+     * under the tag unique to this Component<Derived> type.
+     * O(1) per node, type-safe (only matches this specific Derived type).
      *
      * @code
      * void handle_event(lv_event_t* e) {
@@ -0,0 +1,221 @@
+#pragma once
+
+/**
+ * @file component_pool.hpp
+ * @brief Recycled component subtrees for popups, dialogs and repeated cards
+ *
+ * Opening a dialog with mount() and closing it with unmount() pays the
+ * whole build every time: object allocation, style setup and event
+ * registration. A ComponentPool keeps released components built. release()
+ * hides the root and parks it on the system layer; acquire() moves it
+ * under the new parent, calls the component's `reset(args...)` to rebind
+ * its data and shows it again, which is a handful of property sets. Only
+ * when no idle component is left is a new one mounted.
+ *
+ * @code
+ * struct ConfirmDialog : lv::Component<ConfirmDialog> {
+ *     lv_obj_t* m_text = nullptr;
+ *     lv::ObjectView build(lv::ObjectView parent);       // full build, once per pool slot
+ *     void reset(const char* question) { lv_label_set_text(m_text, question); }
+ *     void on_release() {}                               // optional
+ * };
+ *
+ * static lv::ComponentPool<ConfirmDialog, 2> dialogs;
+ * dialogs.budget(64 * 1024);                            // drop idle ones above 64 KiB of LVGL heap
+ * ConfirmDialog* d = dialogs.acquire(lv::screen_active(), "Delete file?");
+ * ...
+ * dialogs.release(d);
+ * @endcode
+ *
+ * trim() unmounts idle components (least recently released first); with a
+ * budget set it runs after every release while LVGL's heap usage
+ * (lv_mem_monitor, builtin allocator only) exceeds it. A component whose
+ * root LVGL deleted (e.g. with its parent) is simply built again.
+ *
+ * Non-movable: the components register themselves as event user data.
+ * Heap allocation: NONE in the pool (N components inline; LVGL allocates
+ * their objects)
+ *
+ * @tparam T Component<T> with a default constructor
+ * @tparam N Components the pool can hold (in use plus idle)
+ */
+
+#include <lvgl.h>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include "object.hpp"
+#include "component.hpp"
+
+namespace lv {
+
+template<typename T, uint32_t N = 4>
+class ComponentPool {
+    static_assert(N > 0, "ComponentPool needs at least one slot");
+
+public:
+    struct Stats {
+        uint32_t acquires = 0;
+        uint32_t reuses = 0;      ///< Acquires served by an idle, built component
+        uint32_t builds = 0;      ///< Acquires that had to mount
+        uint32_t trimmed = 0;     ///< Idle components unmounted by trim()
+        uint32_t exhausted = 0;   ///< Acquires refused because every slot was in use
+    };
+
+private:
+    T m_items[N];
+    bool m_in_use[N] = {};
+    uint32_t m_released_at[N] = {};   ///< m_clock at release, for LRU trimming
+    uint32_t m_clock = 0;
+    size_t m_budget = 0;
+    Stats m_stats;
+
+    [[nodiscard]] uint32_t index_of(const T* item) const noexcept {
+        for (uint32_t i = 0; i < N; ++i) {
+            if (&m_items[i] == item) return i;
+        }
+        return N;
+    }
+
+    /// Idle slot with a built component, most recently released first (warmest)
+    [[nodiscard]] uint32_t warm_slot() const noexcept {
+        uint32_t best = N;
+        for (uint32_t i = 0; i < N; ++i) {
+            if (m_in_use[i] || !m_items[i].is_mounted()) continue;
+            if (best == N || m_released_at[i] > m_released_at[best]) best = i;
+        }
+        return best;
+    }
+
+    /// Idle slot with a built component, least recently released first
+    [[nodiscard]] uint32_t cold_slot() const noexcept {
+        uint32_t best = N;
+        for (uint32_t i = 0; i < N; ++i) {
+            if (m_in_use[i] || !m_items[i].is_mounted()) continue;
+            if (best == N || m_released_at[i] < m_released_at[best]) best = i;
+        }
+        return best;
+    }
+
+    [[nodiscard]] static size_t lv_mem_used() noexcept {
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+        lv_mem_monitor_t mon;
+        lv_mem_monitor(&mon);
+        return mon.total_size - mon.free_size;
+#else
+        return 0;
+#endif
+    }
+
+public:
+    ComponentPool() = default;
+
+    ComponentPool(const ComponentPool&) = delete;
+    ComponentPool& operator=(const ComponentPool&) = delete;
+
+    /**
+     * @brief Take a component, shown under `parent`
+     *
+     * An idle component is moved to `parent`; otherwise a free slot is
+     * mounted there. Then `reset(args...)` is called if T has one.
+     *
+     * @return nullptr when all N components are in use
+     */
+    template<typename... Args>
+    T* acquire(ObjectView parent, Args&&... args) {
+        ++m_stats.acquires;
+        uint32_t i = warm_slot();
+        if (i < N) {
+            ++m_stats.reuses;
+            lv_obj_t* root = m_items[i].root().get();
+            lv_obj_set_parent(root, parent.get());
+            lv_obj_remove_flag(root, LV_OBJ_FLAG_HIDDEN);
+        } else {
+            for (i = 0; i < N && m_in_use[i]; ++i) {}
+            if (i == N) {
+                ++m_stats.exhausted;
+                LV_LOG_WARN("ComponentPool exhausted, raise its size");
+                return nullptr;
+            }
+            ++m_stats.builds;
+            m_items[i].mount(parent);
+        }
+        m_in_use[i] = true;
+        T& item = m_items[i];
+        if constexpr (requires { item.reset(std::forward<Args>(args)...); }) {
+            item.reset(std::forward<Args>(args)...);
+        }
+        return &item;
+    }
+
+    /// Give `item` back: it is hidden and parked on the system layer, still built
+    void release(T* item) {
+        const uint32_t i = index_of(item);
+        if (i == N || !m_in_use[i]) return;
+        m_in_use[i] = false;
+        m_released_at[i] = ++m_clock;
+        if constexpr (requires { item->on_release(); }) {
+            item->on_release();
+        }
+        if (lv_obj_t* root = item->root().get()) {
+            lv_obj_add_flag(root, LV_OBJ_FLAG_HIDDEN);
+            lv_obj_set_parent(root, lv_layer_sys());
+        }
+        trim_to_budget();
+    }
+
+    // ==================== Memory ====================
+
+    /// Unmount idle components while LVGL heap usage exceeds `bytes` (0: never)
+    ComponentPool& budget(size_t bytes) {
+        m_budget = bytes;
+        trim_to_budget();
+        return *this;
+    }
+
+    [[nodiscard]] size_t budget() const noexcept { return m_budget; }
+
+    /// Unmount idle components until at most `keep` stay built, least recently released first
+    void trim(uint32_t keep = 0) {
+        while (idle() > keep) {
+            const uint32_t i = cold_slot();
+            if (i == N) break;
+            m_items[i].unmount();
+            ++m_stats.trimmed;
+        }
+    }
+
+    /// Unmount idle components while over the budget
+    void trim_to_budget() {
+        if (m_budget == 0) return;
+        while (lv_mem_used() > m_budget) {
+            const uint32_t i = cold_slot();
+            if (i == N) break;
+            m_items[i].unmount();
+            ++m_stats.trimmed;
+        }
+    }
+
+    // ==================== State ====================
+
+    /// Components handed out and not released
+    [[nodiscard]] uint32_t in_use() const noexcept {
+        uint32_t n = 0;
+        for (uint32_t i = 0; i < N; ++i) n += m_in_use[i];
+        return n;
+    }
+
+    /// Released components that are still built
+    [[nodiscard]] uint32_t idle() const noexcept {
+        uint32_t n = 0;
+        for (uint32_t i = 0; i < N; ++i) n += !m_in_use[i] && m_items[i].is_mounted();
+        return n;
+    }
+
+    [[nodiscard]] static constexpr uint32_t capacity() noexcept { return N; }
+
+    [[nodiscard]] const Stats& stats() const noexcept { return m_stats; }
+    void reset_stats() noexcept { m_stats = {}; }
+};
+
+} // namespace lv
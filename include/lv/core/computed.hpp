@@ -0,0 +1,185 @@
+#pragma once
+
+/**
+ * @file computed.hpp
+ * @brief Derived state with lazy recomputation
+ *
+ * Computed<T, F, Deps...> holds a value derived from other State<T> (or
+ * Computed) instances. It subscribes to each dependency once; a change only
+ * marks the value stale. The function runs again when the value is read,
+ * or immediately when something observes the Computed, and observers are
+ * notified only if the result actually changed.
+ *
+ * Usage:
+ * @code
+ * lv::State<int32_t> battery{80};
+ * lv::State<int32_t> efficiency{5};
+ * lv::Computed range{[](int32_t b, int32_t e) { return b * e; }, battery, efficiency};
+ *
+ * label.bind_text(range, "%d km");
+ * int32_t km = range.get();
+ * @endcode
+ */
+
+#include <lvgl.h>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "state.hpp"
+
+#if LV_USE_OBSERVER
+
+namespace lv {
+
+/**
+ * @brief Read-only state derived from other states
+ *
+ * Dependencies are held by reference and must outlive the Computed. Their
+ * observers are stored in a fixed array of sizeof...(Deps) entries.
+ *
+ * Heap allocation: NONE
+ *
+ * @tparam T Result type (same requirements as State<T>)
+ * @tparam F Callable invoked with the dependencies' values
+ * @tparam Deps Dependency types (State<U> or Computed<...>)
+ */
+template<typename T, typename F, typename... Deps>
+class Computed {
+    static_assert(sizeof...(Deps) > 0, "Computed<T> needs at least one dependency");
+
+private:
+    mutable State<T> m_state;
+    F m_fn;
+    std::tuple<Deps&...> m_deps;
+    lv_observer_t* m_links[sizeof...(Deps)] = {};
+    mutable bool m_stale = true;
+    bool m_observed = false;
+
+    void refresh() const noexcept {
+        if (!m_stale) return;
+        m_stale = false;
+        m_state.set(std::apply([this](Deps&... d) { return m_fn(d.get()...); }, m_deps));
+    }
+
+    static void dep_changed_cb(lv_observer_t* observer, lv_subject_t*) noexcept {
+        auto* self = static_cast<Computed*>(lv_observer_get_user_data(observer));
+        self->m_stale = true;
+        // Nobody listening: stay lazy until the next get()
+        if (self->m_observed) self->refresh();
+    }
+
+    // Subscribe before any observer of our own exists, so construction stays lazy
+    template<size_t... I>
+    void link(std::index_sequence<I...>) noexcept {
+        ((m_links[I] = std::get<I>(m_deps).observe_raw(&Computed::dep_changed_cb, this)), ...);
+    }
+
+    void mark_observed() noexcept {
+        m_observed = true;
+        refresh();
+    }
+
+public:
+    /// Construct from a callable and its dependencies (value computed on first use)
+    Computed(F fn, Deps&... deps) noexcept
+        : m_state(T{}), m_fn(std::move(fn)), m_deps(deps...) {
+        link(std::index_sequence_for<Deps...>{});
+    }
+
+    ~Computed() noexcept {
+        for (lv_observer_t* o : m_links) {
+            if (o) lv_observer_remove(o);
+        }
+    }
+
+    // Non-copyable and non-movable (dependencies observe `this`)
+    Computed(const Computed&) = delete;
+    Computed& operator=(const Computed&) = delete;
+    Computed(Computed&&) = delete;
+    Computed& operator=(Computed&&) = delete;
+
+    // ==================== Accessors ====================
+
+    /// Get current value (recomputed first if a dependency changed)
+    [[nodiscard]] const T& get() const noexcept {
+        refresh();
+        return m_state.get();
+    }
+
+    /// Get value by implicit conversion
+    [[nodiscard]] operator const T&() const noexcept {
+        return get();
+    }
+
+    /// Check whether a dependency changed since the last computation
+    [[nodiscard]] bool stale() const noexcept {
+        return m_stale;
+    }
+
+    /// Number of dependencies
+    [[nodiscard]] static constexpr size_t dependency_count() noexcept {
+        return sizeof...(Deps);
+    }
+
+    // ==================== LVGL Integration ====================
+
+    /**
+     * @brief Get underlying subject for LVGL binding APIs
+     *
+     * Binding through the subject makes the Computed eager: it recomputes
+     * whenever a dependency changes.
+     */
+    [[nodiscard]] lv_subject_t* subject() noexcept {
+        mark_observed();
+        return m_state.subject();
+    }
+
+    /// Add observer with member function callback (see State::observe)
+    template<auto MemFn, typename Instance>
+        requires std::is_member_function_pointer_v<decltype(MemFn)>
+    lv_observer_t* observe(Instance* instance) noexcept {
+        mark_observed();
+        return m_state.template observe<MemFn>(instance);
+    }
+
+    /// Add throttled member function observer (see State::observe)
+    template<auto MemFn, typename Instance>
+        requires std::is_member_function_pointer_v<decltype(MemFn)>
+    lv_observer_t* observe(Instance* instance, throttle interval) noexcept {
+        mark_observed();
+        return m_state.template observe<MemFn>(instance, interval);
+    }
+
+    /// Add observer with C-style callback
+    lv_observer_t* observe_raw(lv_observer_cb_t cb, void* user_data = nullptr) noexcept {
+        mark_observed();
+        return m_state.observe_raw(cb, user_data);
+    }
+
+    /// Add observer tied to an LVGL object's lifecycle
+    lv_observer_t* observe_obj(lv_observer_cb_t cb, lv_obj_t* target_obj, void* user_data = nullptr) noexcept {
+        mark_observed();
+        return m_state.observe_obj(cb, target_obj, user_data);
+    }
+
+#if LV_USE_LABEL
+    /// Backend of Label::bind_text(computed, fmt, throttle)
+    template<typename U = T>
+        requires std::is_integral_v<U>
+    lv_observer_t* bind_label_text(lv_obj_t* label, const char* fmt, throttle interval) noexcept {
+        mark_observed();
+        return m_state.bind_label_text(label, fmt, interval);
+    }
+#endif
+};
+
+/// Deduce T from the callable's result: Computed c{fn, a, b};
+template<typename F, typename... Deps>
+Computed(F, Deps&...) -> Computed<
+    std::decay_t<std::invoke_result_t<F&, std::decay_t<decltype(std::declval<Deps&>().get())>...>>,
+    F, Deps...>;
+
+} // namespace lv
+
+#endif // LV_USE_OBSERVER
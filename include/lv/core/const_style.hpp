@@ -0,0 +1,521 @@
+#pragma once
+
+/**
+ * @file const_style.hpp
+ * @brief Compile-time constant styles (LV_STYLE_CONST_INIT from C++)
+ *
+ * lv::Style builds its property list at runtime (lv_style_init() plus one
+ * allocation-backed setter per property). A ConstStyle is built entirely by
+ * the compiler: the property array and the lv_style_t header are constant
+ * data, so they end up in flash on MCU targets, take no RAM and need no
+ * init code at startup.
+ *
+ * The builder uses the same fluent property names as lv::Style. Colors must
+ * be constant expressions: use lv::const_rgb() (lv::rgb() is not constexpr).
+ *
+ * Usage:
+ * @code
+ * constexpr lv::ConstStyle card_style = lv::const_style()
+ *     .bg_color(lv::const_rgb(0x202020))
+ *     .radius(8)
+ *     .pad_all(12)
+ *     .text_font(&lv_font_montserrat_14);
+ *
+ * lv::Box::create(parent).add_style(card_style);
+ * @endcode
+ *
+ * A ConstStyle refers to its own property array, so it must have static
+ * storage duration (namespace scope, or a `static` local/member).
+ */
+
+#include <lvgl.h>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace lv {
+
+namespace detail {
+
+template<typename T>
+    requires std::is_integral_v<T> || std::is_enum_v<T>
+[[nodiscard]] constexpr lv_style_value_t const_num(T value) noexcept {
+    return lv_style_value_t{.num = static_cast<int32_t>(value)};
+}
+
+[[nodiscard]] constexpr lv_style_value_t const_color(lv_color_t color) noexcept {
+    return lv_style_value_t{.color = color};
+}
+
+[[nodiscard]] constexpr lv_style_value_t const_ptr(const void* ptr) noexcept {
+    return lv_style_value_t{.ptr = ptr};
+}
+
+} // namespace detail
+
+template<size_t N>
+class ConstStyle;
+
+/**
+ * @brief constexpr builder for a ConstStyle
+ *
+ * Every setter returns a new builder with room for one more property (the
+ * count is part of the type). Setting a property twice overwrites the first
+ * value, like lv::Style does.
+ *
+ * @tparam N Number of property slots
+ */
+template<size_t N = 0>
+class ConstStyleBuilder {
+    template<size_t>
+    friend class ConstStyleBuilder;
+    template<size_t>
+    friend class ConstStyle;
+
+    lv_style_const_prop_t m_props[N > 0 ? N : 1] = {};
+    size_t m_count = 0;
+
+public:
+    constexpr ConstStyleBuilder() noexcept = default;
+
+    /// Number of distinct properties set so far
+    [[nodiscard]] constexpr size_t size() const noexcept { return m_count; }
+
+    /// Set any property by id (escape hatch for properties without a setter)
+    [[nodiscard]] constexpr ConstStyleBuilder<N + 1> prop(lv_style_prop_t id,
+                                                          lv_style_value_t value) const noexcept {
+        ConstStyleBuilder<N + 1> next;
+        for (size_t i = 0; i < m_count; ++i) next.m_props[i] = m_props[i];
+        next.m_count = m_count;
+        for (size_t i = 0; i < m_count; ++i) {
+            if (next.m_props[i].prop == id) {
+                next.m_props[i].value = value;
+                return next;
+            }
+        }
+        next.m_props[next.m_count++] = lv_style_const_prop_t{.prop = id, .value = value};
+        return next;
+    }
+
+    // ==================== Background ====================
+
+    [[nodiscard]] constexpr auto bg_color(lv_color_t color) const noexcept {
+        return prop(LV_STYLE_BG_COLOR, detail::const_color(color));
+    }
+
+    [[nodiscard]] constexpr auto bg_opa(lv_opa_t opa) const noexcept {
+        return prop(LV_STYLE_BG_OPA, detail::const_num(opa));
+    }
+
+    [[nodiscard]] constexpr auto bg_grad_color(lv_color_t color) const noexcept {
+        return prop(LV_STYLE_BG_GRAD_COLOR, detail::const_color(color));
+    }
+
+    [[nodiscard]] constexpr auto bg_grad_dir(lv_grad_dir_t dir) const noexcept {
+        return prop(LV_STYLE_BG_GRAD_DIR, detail::const_num(dir));
+    }
+
+    [[nodiscard]] constexpr auto bg_main_stop(int32_t stop) const noexcept {
+        return prop(LV_STYLE_BG_MAIN_STOP, detail::const_num(stop));
+    }
+
+    [[nodiscard]] constexpr auto bg_grad_stop(int32_t stop) const noexcept {
+        return prop(LV_STYLE_BG_GRAD_STOP, detail::const_num(stop));
+    }
+
+    // ==================== Border ====================
+
+    [[nodiscard]] constexpr auto border_color(lv_color_t color) const noexcept {
+        return prop(LV_STYLE_BORDER_COLOR, detail::const_color(color));
+    }
+
+    [[nodiscard]] constexpr auto border_width(int32_t width) const noexcept {
+        return prop(LV_STYLE_BORDER_WIDTH, detail::const_num(width));
+    }
+
+    [[nodiscard]] constexpr auto border_opa(lv_opa_t opa) const noexcept {
+        return prop(LV_STYLE_BORDER_OPA, detail::const_num(opa));
+    }
+
+    [[nodiscard]] constexpr auto border_side(lv_border_side_t side) const noexcept {
+        return prop(LV_STYLE_BORDER_SIDE, detail::const_num(side));
+    }
+
+    // ==================== Outline ====================
+
+    [[nodiscard]] constexpr auto outline_color(lv_color_t color) const noexcept {
+        return prop(LV_STYLE_OUTLINE_COLOR, detail::const_color(color));
+    }
+
+    [[nodiscard]] constexpr auto outline_width(int32_t width) const noexcept {
+        return prop(LV_STYLE_OUTLINE_WIDTH, detail::const_num(width));
+    }
+
+    [[nodiscard]] constexpr auto outline_opa(lv_opa_t opa) const noexcept {
+        return prop(LV_STYLE_OUTLINE_OPA, detail::const_num(opa));
+    }
+
+    [[nodiscard]] constexpr auto outline_pad(int32_t pad) const noexcept {
+        return prop(LV_STYLE_OUTLINE_PAD, detail::const_num(pad));
+    }
+
+    // ==================== Shadow ====================
+
+    [[nodiscard]] constexpr auto shadow_color(lv_color_t color) const noexcept {
+        return prop(LV_STYLE_SHADOW_COLOR, detail::const_color(color));
+    }
+
+    [[nodiscard]] constexpr auto shadow_width(int32_t width) const noexcept {
+        return prop(LV_STYLE_SHADOW_WIDTH, detail::const_num(width));
+    }
+
+    [[nodiscard]] constexpr auto shadow_opa(lv_opa_t opa) const noexcept {
+        return prop(LV_STYLE_SHADOW_OPA, detail::const_num(opa));
+    }
+
+    [[nodiscard]] constexpr auto shadow_offset(int32_t x, int32_t y) const noexcept {
+        return prop(LV_STYLE_SHADOW_OFFSET_X, detail::const_num(x))
+            .prop(LV_STYLE_SHADOW_OFFSET_Y, detail::const_num(y));
+    }
+
+    [[nodiscard]] constexpr auto shadow_spread(int32_t spread) const noexcept {
+        return prop(LV_STYLE_SHADOW_SPREAD, detail::const_num(spread));
+    }
+
+    // ==================== Padding ====================
+
+    [[nodiscard]] constexpr auto pad_all(int32_t pad) const noexcept {
+        return prop(LV_STYLE_PAD_TOP, detail::const_num(pad))
+            .prop(LV_STYLE_PAD_BOTTOM, detail::const_num(pad))
+            .prop(LV_STYLE_PAD_LEFT, detail::const_num(pad))
+            .prop(LV_STYLE_PAD_RIGHT, detail::const_num(pad));
+    }
+
+    [[nodiscard]] constexpr auto pad_top(int32_t pad) const noexcept {
+        return prop(LV_STYLE_PAD_TOP, detail::const_num(pad));
+    }
+
+    [[nodiscard]] constexpr auto pad_bottom(int32_t pad) const noexcept {
+        return prop(LV_STYLE_PAD_BOTTOM, detail::const_num(pad));
+    }
+
+    [[nodiscard]] constexpr auto pad_left(int32_t pad) const noexcept {
+        return prop(LV_STYLE_PAD_LEFT, detail::const_num(pad));
+    }
+
+    [[nodiscard]] constexpr auto pad_right(int32_t pad) const noexcept {
+        return prop(LV_STYLE_PAD_RIGHT, detail::const_num(pad));
+    }
+
+    [[nodiscard]] constexpr auto pad_hor(int32_t pad) const noexcept {
+        return prop(LV_STYLE_PAD_LEFT, detail::const_num(pad))
+            .prop(LV_STYLE_PAD_RIGHT, detail::const_num(pad));
+    }
+
+    [[nodiscard]] constexpr auto pad_ver(int32_t pad) const noexcept {
+        return prop(LV_STYLE_PAD_TOP, detail::const_num(pad))
+            .prop(LV_STYLE_PAD_BOTTOM, detail::const_num(pad));
+    }
+
+    [[nodiscard]] constexpr auto pad_row(int32_t pad) const noexcept {
+        return prop(LV_STYLE_PAD_ROW, detail::const_num(pad));
+    }
+
+    [[nodiscard]] constexpr auto pad_column(int32_t pad) const noexcept {
+        return prop(LV_STYLE_PAD_COLUMN, detail::const_num(pad));
+    }
+
+    [[nodiscard]] constexpr auto pad_gap(int32_t pad) const noexcept {
+        return prop(LV_STYLE_PAD_ROW, detail::const_num(pad))
+            .prop(LV_STYLE_PAD_COLUMN, detail::const_num(pad));
+    }
+
+    // ==================== Margin ====================
+
+    [[nodiscard]] constexpr auto margin_all(int32_t margin) const noexcept {
+        return prop(LV_STYLE_MARGIN_TOP, detail::const_num(margin))
+            .prop(LV_STYLE_MARGIN_BOTTOM, detail::const_num(margin))
+            .prop(LV_STYLE_MARGIN_LEFT, detail::const_num(margin))
+            .prop(LV_STYLE_MARGIN_RIGHT, detail::const_num(margin));
+    }
+
+    [[nodiscard]] constexpr auto margin_top(int32_t margin) const noexcept {
+        return prop(LV_STYLE_MARGIN_TOP, detail::const_num(margin));
+    }
+
+    [[nodiscard]] constexpr auto margin_bottom(int32_t margin) const noexcept {
+        return prop(LV_STYLE_MARGIN_BOTTOM, detail::const_num(margin));
+    }
+
+    [[nodiscard]] constexpr auto margin_left(int32_t margin) const noexcept {
+        return prop(LV_STYLE_MARGIN_LEFT, detail::const_num(margin));
+    }
+
+    [[nodiscard]] constexpr auto margin_right(int32_t margin) const noexcept {
+        return prop(LV_STYLE_MARGIN_RIGHT, detail::const_num(margin));
+    }
+
+    // ==================== Size ====================
+
+    [[nodiscard]] constexpr auto width(int32_t w) const noexcept {
+        return prop(LV_STYLE_WIDTH, detail::const_num(w));
+    }
+
+    [[nodiscard]] constexpr auto min_width(int32_t w) const noexcept {
+        return prop(LV_STYLE_MIN_WIDTH, detail::const_num(w));
+    }
+
+    [[nodiscard]] constexpr auto max_width(int32_t w) const noexcept {
+        return prop(LV_STYLE_MAX_WIDTH, detail::const_num(w));
+    }
+
+    [[nodiscard]] constexpr auto height(int32_t h) const noexcept {
+        return prop(LV_STYLE_HEIGHT, detail::const_num(h));
+    }
+
+    [[nodiscard]] constexpr auto min_height(int32_t h) const noexcept {
+        return prop(LV_STYLE_MIN_HEIGHT, detail::const_num(h));
+    }
+
+    [[nodiscard]] constexpr auto max_height(int32_t h) const noexcept {
+        return prop(LV_STYLE_MAX_HEIGHT, detail::const_num(h));
+    }
+
+    // ==================== Appearance ====================
+
+    [[nodiscard]] constexpr auto radius(int32_t r) const noexcept {
+        return prop(LV_STYLE_RADIUS, detail::const_num(r));
+    }
+
+    [[nodiscard]] constexpr auto opa(lv_opa_t opa) const noexcept {
+        return prop(LV_STYLE_OPA, detail::const_num(opa));
+    }
+
+    [[nodiscard]] constexpr auto clip_corner(bool clip) const noexcept {
+        return prop(LV_STYLE_CLIP_CORNER, detail::const_num(clip));
+    }
+
+    [[nodiscard]] constexpr auto blend_mode(lv_blend_mode_t mode) const noexcept {
+        return prop(LV_STYLE_BLEND_MODE, detail::const_num(mode));
+    }
+
+    // ==================== Text ====================
+
+    [[nodiscard]] constexpr auto text_color(lv_color_t color) const noexcept {
+        return prop(LV_STYLE_TEXT_COLOR, detail::const_color(color));
+    }
+
+    [[nodiscard]] constexpr auto text_opa(lv_opa_t opa) const noexcept {
+        return prop(LV_STYLE_TEXT_OPA, detail::const_num(opa));
+    }
+
+    [[nodiscard]] constexpr auto text_font(const lv_font_t* font) const noexcept {
+        return prop(LV_STYLE_TEXT_FONT, detail::const_ptr(font));
+    }
+
+    [[nodiscard]] constexpr auto text_letter_space(int32_t space) const noexcept {
+        return prop(LV_STYLE_TEXT_LETTER_SPACE, detail::const_num(space));
+    }
+
+    [[nodiscard]] constexpr auto text_line_space(int32_t space) const noexcept {
+        return prop(LV_STYLE_TEXT_LINE_SPACE, detail::const_num(space));
+    }
+
+    [[nodiscard]] constexpr auto text_decor(lv_text_decor_t decor) const noexcept {
+        return prop(LV_STYLE_TEXT_DECOR, detail::const_num(decor));
+    }
+
+    [[nodiscard]] constexpr auto text_align(lv_text_align_t align) const noexcept {
+        return prop(LV_STYLE_TEXT_ALIGN, detail::const_num(align));
+    }
+
+    // ==================== Image ====================
+
+    [[nodiscard]] constexpr auto image_opa(lv_opa_t opa) const noexcept {
+        return prop(LV_STYLE_IMAGE_OPA, detail::const_num(opa));
+    }
+
+    [[nodiscard]] constexpr auto image_recolor(lv_color_t color) const noexcept {
+        return prop(LV_STYLE_IMAGE_RECOLOR, detail::const_color(color));
+    }
+
+    [[nodiscard]] constexpr auto image_recolor_opa(lv_opa_t opa) const noexcept {
+        return prop(LV_STYLE_IMAGE_RECOLOR_OPA, detail::const_num(opa));
+    }
+
+    // ==================== Line ====================
+
+    [[nodiscard]] constexpr auto line_color(lv_color_t color) const noexcept {
+        return prop(LV_STYLE_LINE_COLOR, detail::const_color(color));
+    }
+
+    [[nodiscard]] constexpr auto line_width(int32_t width) const noexcept {
+        return prop(LV_STYLE_LINE_WIDTH, detail::const_num(width));
+    }
+
+    [[nodiscard]] constexpr auto line_opa(lv_opa_t opa) const noexcept {
+        return prop(LV_STYLE_LINE_OPA, detail::const_num(opa));
+    }
+
+    [[nodiscard]] constexpr auto line_rounded(bool rounded) const noexcept {
+        return prop(LV_STYLE_LINE_ROUNDED, detail::const_num(rounded));
+    }
+
+    // ==================== Arc ====================
+
+    [[nodiscard]] constexpr auto arc_color(lv_color_t color) const noexcept {
+        return prop(LV_STYLE_ARC_COLOR, detail::const_color(color));
+    }
+
+    [[nodiscard]] constexpr auto arc_width(int32_t width) const noexcept {
+        return prop(LV_STYLE_ARC_WIDTH, detail::const_num(width));
+    }
+
+    [[nodiscard]] constexpr auto arc_opa(lv_opa_t opa) const noexcept {
+        return prop(LV_STYLE_ARC_OPA, detail::const_num(opa));
+    }
+
+    [[nodiscard]] constexpr auto arc_rounded(bool rounded) const noexcept {
+        return prop(LV_STYLE_ARC_ROUNDED, detail::const_num(rounded));
+    }
+
+    // ==================== Transform ====================
+
+    [[nodiscard]] constexpr auto transform_width(int32_t width) const noexcept {
+        return prop(LV_STYLE_TRANSFORM_WIDTH, detail::const_num(width));
+    }
+
+    [[nodiscard]] constexpr auto transform_height(int32_t height) const noexcept {
+        return prop(LV_STYLE_TRANSFORM_HEIGHT, detail::const_num(height));
+    }
+
+    [[nodiscard]] constexpr auto transform_scale(int32_t scale) const noexcept {
+        return prop(LV_STYLE_TRANSFORM_SCALE_X, detail::const_num(scale))
+            .prop(LV_STYLE_TRANSFORM_SCALE_Y, detail::const_num(scale));
+    }
+
+    [[nodiscard]] constexpr auto transform_scale_x(int32_t scale) const noexcept {
+        return prop(LV_STYLE_TRANSFORM_SCALE_X, detail::const_num(scale));
+    }
+
+    [[nodiscard]] constexpr auto transform_scale_y(int32_t scale) const noexcept {
+        return prop(LV_STYLE_TRANSFORM_SCALE_Y, detail::const_num(scale));
+    }
+
+    [[nodiscard]] constexpr auto transform_rotation(int32_t angle) const noexcept {
+        return prop(LV_STYLE_TRANSFORM_ROTATION, detail::const_num(angle));
+    }
+
+    [[nodiscard]] constexpr auto transform_pivot(int32_t x, int32_t y) const noexcept {
+        return prop(LV_STYLE_TRANSFORM_PIVOT_X, detail::const_num(x))
+            .prop(LV_STYLE_TRANSFORM_PIVOT_Y, detail::const_num(y));
+    }
+
+    // ==================== Layout ====================
+
+    [[nodiscard]] constexpr auto layout(uint16_t layout) const noexcept {
+        return prop(LV_STYLE_LAYOUT, detail::const_num(layout));
+    }
+
+#if LV_USE_FLEX
+    [[nodiscard]] constexpr auto flex_flow(lv_flex_flow_t flow) const noexcept {
+        return prop(LV_STYLE_FLEX_FLOW, detail::const_num(flow));
+    }
+
+    [[nodiscard]] constexpr auto flex_main_place(lv_flex_align_t place) const noexcept {
+        return prop(LV_STYLE_FLEX_MAIN_PLACE, detail::const_num(place));
+    }
+
+    [[nodiscard]] constexpr auto flex_cross_place(lv_flex_align_t place) const noexcept {
+        return prop(LV_STYLE_FLEX_CROSS_PLACE, detail::const_num(place));
+    }
+
+    [[nodiscard]] constexpr auto flex_track_place(lv_flex_align_t place) const noexcept {
+        return prop(LV_STYLE_FLEX_TRACK_PLACE, detail::const_num(place));
+    }
+
+    [[nodiscard]] constexpr auto flex_grow(uint8_t grow) const noexcept {
+        return prop(LV_STYLE_FLEX_GROW, detail::const_num(grow));
+    }
+#endif // LV_USE_FLEX
+
+    // ==================== Alignment ====================
+
+    [[nodiscard]] constexpr auto align(lv_align_t align) const noexcept {
+        return prop(LV_STYLE_ALIGN, detail::const_num(align));
+    }
+
+    // ==================== Transform ====================
+
+    [[nodiscard]] constexpr auto translate_x(int32_t x) const noexcept {
+        return prop(LV_STYLE_TRANSLATE_X, detail::const_num(x));
+    }
+
+    [[nodiscard]] constexpr auto translate_y(int32_t y) const noexcept {
+        return prop(LV_STYLE_TRANSLATE_Y, detail::const_num(y));
+    }
+};
+
+/// Start a constexpr style: `constexpr lv::ConstStyle s = lv::const_style().radius(4);`
+[[nodiscard]] constexpr ConstStyleBuilder<> const_style() noexcept {
+    return {};
+}
+
+/**
+ * @brief Constant lv_style_t with an embedded constant property array
+ *
+ * Equivalent to LV_STYLE_CONST_PROPS_END plus LV_STYLE_CONST_INIT in C.
+ * Pass it anywhere a `const lv_style_t*` is expected (add_style(),
+ * remove_style(), lv_obj_add_style()). LVGL never writes to const styles;
+ * lv_style_set_*() and lv_style_reset() must not be called on get().
+ *
+ * Non-copyable and non-movable: the lv_style_t points into this object.
+ *
+ * Heap allocation: NONE (no RAM at all when declared constexpr)
+ *
+ * @tparam N Property slots (deduced from the builder)
+ */
+template<size_t N>
+class ConstStyle {
+    static_assert(LV_STYLE_PROP_INV == 0, "Zeroed entries must terminate the property array");
+
+    lv_style_const_prop_t m_props[N + 1] = {};    ///< Unused tail is the LV_STYLE_PROP_INV terminator
+    lv_style_t m_style;
+
+public:
+    constexpr ConstStyle(const ConstStyleBuilder<N>& builder) noexcept
+        : m_style{
+#if LV_USE_ASSERT_STYLE
+              .sentinel = LV_STYLE_SENTINEL_VALUE,
+#endif
+              .values_and_props = m_props,
+              .has_group = 0xFFFFFFFF,
+              .prop_cnt = LV_STYLE_PROP_CONST,
+          } {
+        for (size_t i = 0; i < builder.m_count; ++i) m_props[i] = builder.m_props[i];
+    }
+
+    ConstStyle(const ConstStyle&) = delete;
+    ConstStyle& operator=(const ConstStyle&) = delete;
+
+    /// Get pointer to underlying style (for LVGL API)
+    [[nodiscard]] constexpr const lv_style_t* get() const noexcept { return &m_style; }
+
+    /// Implicit conversion for C API interop
+    [[nodiscard]] constexpr operator const lv_style_t*() const noexcept { return &m_style; }
+
+    /// Number of properties in the style
+    [[nodiscard]] constexpr size_t size() const noexcept {
+        size_t n = 0;
+        while (n < N && m_props[n].prop != LV_STYLE_PROP_INV) ++n;
+        return n;
+    }
+
+    /// The property array (terminated by LV_STYLE_PROP_INV)
+    [[nodiscard]] constexpr const lv_style_const_prop_t* props() const noexcept { return m_props; }
+};
+
+template<size_t N>
+ConstStyle(const ConstStyleBuilder<N>&) -> ConstStyle<N>;
+
+} // namespace lv
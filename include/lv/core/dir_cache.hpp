@@ -0,0 +1,331 @@
+#pragma once
+
+/**
+ * @file dir_cache.hpp
+ * @brief Cached, incrementally sorted directory listings
+ *
+ * Listing a folder of thousands of files through lv_fs_dir_read() takes
+ * long on an SD card, and lv_file_explorer re-reads and re-sorts it on
+ * every visit. dir_cache::open(path) returns a DirListing that keeps the
+ * names in one block and an index sorted as entries arrive (directories
+ * first, then case-insensitive name), so the first entries can be shown
+ * while the rest is still being read with load():
+ *
+ * @code
+ * lv::fs::DirListing* dir = lv::fs::dir_cache::open("A:/media");
+ * while (dir && !dir->complete()) dir->load(64);        // or a few per frame
+ * for (uint32_t i = 0; i < dir->count(); ++i) show(dir->at(i).name);
+ * lv::fs::dir_cache::release(dir);
+ * @endcode
+ *
+ * Up to LV_CPP_DIR_CACHE_DIRS listings are kept; the least recently used
+ * one that nobody holds is reused. Opening a cached directory checks its
+ * modification time (stat() on drives mapped to the OS filesystem, the
+ * same ones MappedFile maps) and reloads it if it changed. Other drives
+ * have no timestamps: call invalidate() after writing to them.
+ *
+ * Heap allocation: per listing, the names and the sorted index (lv_realloc,
+ * doubling); kept for reuse when the slot is recycled
+ */
+
+#include <lvgl.h>
+#include <cstdint>
+#include <cstring>
+#include "fs.hpp"
+#include "mapped_file.hpp"
+
+#ifndef LV_CPP_DIR_CACHE_DIRS
+/// Directory listings kept
+#define LV_CPP_DIR_CACHE_DIRS 4
+#endif
+
+#ifndef LV_CPP_DIR_CACHE_PATH
+/// Longest directory path cached (longer ones are not opened)
+#define LV_CPP_DIR_CACHE_PATH 128
+#endif
+
+#ifndef LV_CPP_DIR_CACHE_NAME
+/// Longest entry name read (bytes, including the terminator)
+#define LV_CPP_DIR_CACHE_NAME 128
+#endif
+
+namespace lv::fs {
+
+/// One listed entry; `name` stays valid while the listing is held and not reloaded
+struct DirEntry {
+    const char* name;
+    bool is_dir;
+};
+
+namespace detail {
+
+/// Modification time of a directory in ns, -1 where the drive does not tell
+[[nodiscard]] inline int64_t dir_stamp(const char* path) noexcept {
+#if LV_CPP_FS_MMAP
+    char os[LV_CPP_FS_PATH_MAX];
+    struct stat st;
+    if (!os_path(path, os, sizeof(os)) || ::stat(os, &st) != 0) return -1;
+#if defined(__linux__)
+    return static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+#else
+    return static_cast<int64_t>(st.st_mtime) * 1000000000;
+#endif
+#else
+    (void)path;
+    return -1;
+#endif
+}
+
+/// Case-insensitive ASCII order, ties broken bytewise
+[[nodiscard]] inline int name_cmp(const char* a, const char* b) noexcept {
+    for (const char *x = a, *y = b;; ++x, ++y) {
+        const char cx = (*x >= 'A' && *x <= 'Z') ? static_cast<char>(*x + 32) : *x;
+        const char cy = (*y >= 'A' && *y <= 'Z') ? static_cast<char>(*y + 32) : *y;
+        if (cx != cy) return static_cast<unsigned char>(cx) < static_cast<unsigned char>(cy) ? -1 : 1;
+        if (!cx) break;
+    }
+    return std::strcmp(a, b);
+}
+
+} // namespace detail
+
+/**
+ * @brief Sorted listing of one directory, filled by load()
+ *
+ * Names are stored back to back as [kind byte][name][NUL]; the index
+ * holds their offsets in display order.
+ */
+class DirListing {
+    char m_path[LV_CPP_DIR_CACHE_PATH] = {};
+    char* m_names = nullptr;
+    uint32_t m_names_size = 0;
+    uint32_t m_names_cap = 0;
+    uint32_t* m_order = nullptr;
+    uint32_t m_count = 0;
+    uint32_t m_order_cap = 0;
+    Directory m_dir;
+    int64_t m_stamp = -1;
+    uint32_t m_version = 0;
+    uint32_t m_pins = 0;
+    uint32_t m_used = 0;
+    bool m_complete = false;
+    bool m_stale = false;
+
+    friend struct DirCacheAccess;
+
+    [[nodiscard]] const char* raw(uint32_t i) const noexcept { return m_names + m_order[i]; }
+
+    /// true if a (raw, with kind byte) sorts before b
+    [[nodiscard]] static bool before(const char* a, const char* b) noexcept {
+        if (a[0] != b[0]) return a[0] == 'd';
+        return detail::name_cmp(a + 1, b + 1) < 0;
+    }
+
+    [[nodiscard]] bool add(const char* fn) noexcept {
+        const bool is_dir = fn[0] == '/';
+        const char* name = is_dir ? fn + 1 : fn;
+        if (!name[0] || std::strcmp(name, ".") == 0 || std::strcmp(name, "..") == 0) return true;
+        const auto len = static_cast<uint32_t>(std::strlen(name)) + 2;
+        if (m_names_size + len > m_names_cap) {
+            uint32_t cap = m_names_cap ? m_names_cap * 2 : 4096;
+            while (cap < m_names_size + len) cap *= 2;
+            auto* names = static_cast<char*>(lv_realloc(m_names, cap));
+            if (!names) return false;
+            m_names = names;
+            m_names_cap = cap;
+        }
+        if (m_count == m_order_cap) {
+            const uint32_t cap = m_order_cap ? m_order_cap * 2 : 256;
+            auto* order = static_cast<uint32_t*>(lv_realloc(m_order, sizeof(uint32_t) * cap));
+            if (!order) return false;
+            m_order = order;
+            m_order_cap = cap;
+        }
+        char* at = m_names + m_names_size;
+        at[0] = is_dir ? 'd' : 'f';
+        std::memcpy(at + 1, name, len - 1);
+
+        // Binary search for the insertion point, then shift the tail of the index
+        uint32_t lo = 0, hi = m_count;
+        while (lo < hi) {
+            const uint32_t mid = (lo + hi) / 2;
+            if (before(at, raw(mid))) hi = mid;
+            else lo = mid + 1;
+        }
+        std::memmove(m_order + lo + 1, m_order + lo, sizeof(uint32_t) * (m_count - lo));
+        m_order[lo] = m_names_size;
+        m_names_size += len;
+        ++m_count;
+        return true;
+    }
+
+    void reset(const char* path) noexcept {
+        m_dir.close();
+        if (path != m_path) std::strcpy(m_path, path);
+        m_names_size = 0;
+        m_count = 0;
+        m_complete = false;
+        m_stale = false;
+        m_stamp = detail::dir_stamp(m_path);
+        ++m_version;
+        if (m_dir.open(m_path) != LV_FS_RES_OK) {
+            LV_LOG_WARN("dir_cache: cannot open %s", m_path);
+            m_complete = true;
+        }
+    }
+
+public:
+    DirListing() noexcept = default;
+
+    ~DirListing() {
+        lv_free(m_names);
+        lv_free(m_order);
+    }
+
+    DirListing(const DirListing&) = delete;
+    DirListing& operator=(const DirListing&) = delete;
+
+    /**
+     * @brief Read up to `max` more entries (each inserted in sorted order)
+     * @return Entries read; the listing is complete when the directory ends
+     */
+    uint32_t load(uint32_t max) noexcept {
+        uint32_t n = 0;
+        char fn[LV_CPP_DIR_CACHE_NAME];
+        while (!m_complete && n < max) {
+            if (m_dir.read(fn, sizeof(fn)) != LV_FS_RES_OK || fn[0] == '\0') {
+                m_complete = true;
+                break;
+            }
+            if (!add(fn)) {
+                LV_LOG_WARN("dir_cache: out of memory listing %s", m_path);
+                m_complete = true;
+                break;
+            }
+            ++n;
+        }
+        if (m_complete) m_dir.close();
+        if (n) ++m_version;
+        return n;
+    }
+
+    /// Everything read (or the directory could not be read further)
+    [[nodiscard]] bool complete() const noexcept { return m_complete; }
+
+    [[nodiscard]] uint32_t count() const noexcept { return m_count; }
+
+    /// Entry `i` in display order (i < count())
+    [[nodiscard]] DirEntry at(uint32_t i) const noexcept {
+        const char* r = raw(i);
+        return {r + 1, r[0] == 'd'};
+    }
+
+    [[nodiscard]] const char* path() const noexcept { return m_path; }
+
+    /// Bumped when entries arrive or the listing is reloaded (for views)
+    [[nodiscard]] uint32_t version() const noexcept { return m_version; }
+
+    /// Bytes allocated for names and index
+    [[nodiscard]] uint32_t heap_bytes() const noexcept {
+        return m_names_cap + m_order_cap * static_cast<uint32_t>(sizeof(uint32_t));
+    }
+};
+
+namespace dir_cache {
+
+struct Stats {
+    uint32_t hits;        ///< Opened from the cache
+    uint32_t misses;      ///< Read from the drive
+    uint32_t reloads;     ///< Cached but changed on the drive (or invalidated)
+    uint32_t evictions;   ///< Listings dropped for another directory
+};
+
+} // namespace dir_cache
+
+/// Internal access to DirListing for the cache functions
+struct DirCacheAccess {
+    static void reset(DirListing& d, const char* path) noexcept { d.reset(path); }
+    static uint32_t& pins(DirListing& d) noexcept { return d.m_pins; }
+    static uint32_t& used(DirListing& d) noexcept { return d.m_used; }
+    static bool& stale(DirListing& d) noexcept { return d.m_stale; }
+    static int64_t stamp(const DirListing& d) noexcept { return d.m_stamp; }
+};
+
+namespace dir_cache {
+
+namespace detail {
+
+struct Cache {
+    DirListing dirs[LV_CPP_DIR_CACHE_DIRS];
+    uint32_t clock = 0;
+    Stats stats{};
+};
+
+[[nodiscard]] inline Cache& cache() noexcept {
+    static Cache c;
+    return c;
+}
+
+} // namespace detail
+
+/**
+ * @brief Listing of `path`, held until release()
+ *
+ * Cached and unchanged listings come back as they are (complete() may
+ * already be true); otherwise the listing is (re)started and filled by
+ * load(). Must be called on the LVGL thread.
+ * @return nullptr if the path is too long or every slot is held
+ */
+inline DirListing* open(const char* path) noexcept {
+    if (!path || std::strlen(path) >= LV_CPP_DIR_CACHE_PATH) return nullptr;
+    detail::Cache& c = detail::cache();
+    DirListing* victim = nullptr;
+    for (DirListing& d : c.dirs) {
+        if (d.path()[0] && std::strcmp(d.path(), path) == 0) {
+            const bool changed = DirCacheAccess::stale(d) ||
+                                 (d.complete() && DirCacheAccess::stamp(d) != fs::detail::dir_stamp(path));
+            if (changed) {
+                ++c.stats.reloads;
+                DirCacheAccess::reset(d, path);
+            } else {
+                ++c.stats.hits;
+            }
+            ++DirCacheAccess::pins(d);
+            DirCacheAccess::used(d) = ++c.clock;
+            return &d;
+        }
+        if (DirCacheAccess::pins(d) == 0 &&
+            (!victim || DirCacheAccess::used(d) < DirCacheAccess::used(*victim))) {
+            victim = &d;
+        }
+    }
+    if (!victim) {
+        LV_LOG_WARN("dir_cache: all listings held (raise LV_CPP_DIR_CACHE_DIRS)");
+        return nullptr;
+    }
+    if (victim->path()[0]) ++c.stats.evictions;
+    ++c.stats.misses;
+    DirCacheAccess::reset(*victim, path);
+    ++DirCacheAccess::pins(*victim);
+    DirCacheAccess::used(*victim) = ++c.clock;
+    return victim;
+}
+
+/// Stop holding a listing from open() (it stays cached)
+inline void release(DirListing* d) noexcept {
+    if (d && DirCacheAccess::pins(*d)) --DirCacheAccess::pins(*d);
+}
+
+/// Reload `path` (every listing if nullptr) on its next open()
+inline void invalidate(const char* path = nullptr) noexcept {
+    for (DirListing& d : detail::cache().dirs) {
+        if (!path || std::strcmp(d.path(), path) == 0) DirCacheAccess::stale(d) = true;
+    }
+}
+
+[[nodiscard]] inline Stats stats() noexcept { return detail::cache().stats; }
+inline void reset_stats() noexcept { detail::cache().stats = {}; }
+
+} // namespace dir_cache
+
+} // namespace lv::fs
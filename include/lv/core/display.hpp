@@ -10,8 +10,15 @@
 #include <lvgl.h>
 #include "object.hpp"
 #include "version.hpp"
+#include "thread.hpp"
+#include "refresh_rate.hpp"
+#include "display_mode.hpp"
 #include <cstdint>
 
+#if LV_USE_SDL
+#include LV_SDL_INCLUDE_PATH
+#endif
+
 namespace lv {
 
 /**
@@ -20,6 +27,10 @@ namespace lv {
 class Display {
     lv_display_t* m_display;
 
+protected:
+    /// For backends that create the LVGL display after opening their device
+    constexpr void attach(lv_display_t* d) noexcept { m_display = d; }
+
 public:
     constexpr Display(lv_display_t* d) noexcept : m_display(d) {}
 
@@ -38,7 +49,7 @@ public:
         return ObjectView(lv_display_get_screen_active(m_display));
     }
 
-    /// Set theme for this display
+    /// Set theme for this display (existing objects keep their styles; see lv::switch_theme())
     Display& set_theme(lv_theme_t* theme) noexcept {
         lv_display_set_theme(m_display, theme);
         return *this;
@@ -105,6 +116,37 @@ public:
         return ObjectView(lv_display_get_layer_bottom(m_display));
     }
 
+    // ==================== Refresh Rate ====================
+
+    /// Refresh faster in motion, slower for plain updates, not at all when idle (see refresh_rate.hpp)
+    Display& adaptive_refresh(const RefreshConfig& cfg = {}) noexcept {
+        refresh_rate::enable(m_display, cfg);
+        return *this;
+    }
+
+    /// Back to a fixed LV_DEF_REFR_PERIOD
+    Display& fixed_refresh() noexcept {
+        refresh_rate::disable(m_display);
+        return *this;
+    }
+
+    [[nodiscard]] refresh_rate::Mode refresh_mode() const noexcept {
+        return refresh_rate::mode(m_display);
+    }
+
+    // ==================== Mode ====================
+
+    /// Change the resolution (and the DPI when > 0) keeping every screen (see display_mode.hpp)
+    bool resize(int32_t w, int32_t h, int32_t dpi = 0) noexcept {
+        return display_mode::apply(m_display, w, h, dpi);
+    }
+
+    /// Render into two DrawBufPool buffers that resize() reallocates
+    Display& pooled_buffers(uint32_t rows, lv_display_render_mode_t mode = LV_DISPLAY_RENDER_MODE_PARTIAL) noexcept {
+        display_mode::buffers(m_display, rows, mode);
+        return *this;
+    }
+
     // ==================== Coordinate Transform ====================
 
 #if LV_VERSION_AT_LEAST(9, 5, 0)
@@ -116,6 +158,11 @@ public:
 
     // ==================== Static ====================
 
+    /// Software render threads shared by all displays (build option LV_RENDER_THREADS)
+    [[nodiscard]] static constexpr uint32_t render_threads() noexcept {
+        return lv::render_threads();
+    }
+
     /// Get default display
     [[nodiscard]] static Display get_default() noexcept {
         return Display(lv_display_get_default());
@@ -123,6 +170,57 @@ public:
 };
 
 
+/**
+ * @brief Headless display rendering into an embedded buffer
+ *
+ * No window system or device is touched: LVGL renders into a partial
+ * buffer of `Lines` rows that is stored inside the object, and flushing
+ * completes immediately. Intended for benchmarks and tests (see
+ * others/bench.hpp). Create it after lv::init(); because of the buffer
+ * size prefer static storage:
+ *
+ * @code
+ * lv::init();
+ * static lv::MemoryDisplay<800, 480> display;
+ * @endcode
+ *
+ * @tparam W Horizontal resolution
+ * @tparam H Vertical resolution
+ * @tparam Lines Height of the render buffer in rows
+ */
+template<int32_t W, int32_t H, int32_t Lines = (H >= 10 ? H / 10 : H)>
+class MemoryDisplay : public Display {
+    static_assert(W > 0 && H > 0 && Lines > 0 && Lines <= H, "invalid MemoryDisplay geometry");
+
+    static constexpr uint32_t BUF_SIZE =
+        static_cast<uint32_t>(W) * static_cast<uint32_t>(Lines) * ((LV_COLOR_DEPTH + 7) / 8);
+
+    alignas(64) uint8_t m_buf[BUF_SIZE];
+
+    static void flush_cb(lv_display_t* disp, const lv_area_t*, uint8_t*) noexcept {
+        lv_display_flush_ready(disp);
+    }
+
+public:
+    MemoryDisplay() noexcept : Display(lv_display_create(W, H)) {
+        if (!get()) return;
+        lv_display_set_buffers(get(), m_buf, nullptr, BUF_SIZE, LV_DISPLAY_RENDER_MODE_PARTIAL);
+        lv_display_set_flush_cb(get(), &MemoryDisplay::flush_cb);
+    }
+
+    /// Deletes the display (it renders into this object's buffer)
+    ~MemoryDisplay() {
+        if (get()) lv_display_delete(get());
+    }
+
+    MemoryDisplay(const MemoryDisplay&) = delete;
+    MemoryDisplay& operator=(const MemoryDisplay&) = delete;
+
+    /// Size of the embedded render buffer in bytes
+    [[nodiscard]] static constexpr uint32_t buffer_size() noexcept { return BUF_SIZE; }
+};
+
+
 #if LV_USE_X11
 /**
  * @brief X11 display backend
@@ -169,16 +267,50 @@ public:
  * @code
  * lv::init();
  * auto display = lv::SDLDisplay(800, 480);
+ * lv::SDLDisplay::cursor(&lv::cursor_arrow);   // optional, <lv/assets/cursor.hpp>
  * // ... create UI ...
  * lv::run();
  * @endcode
  */
 class SDLDisplay : public Display {
+    [[nodiscard]] static SDL_Cursor*& current_cursor() noexcept {
+        static SDL_Cursor* c = nullptr;
+        return c;
+    }
+
 public:
     SDLDisplay(int32_t width, int32_t height)
         : Display(lv_sdl_window_create(width, height)) {
         lv_sdl_mouse_create();
     }
+
+    /**
+     * @brief Use `img` (ARGB8888) as the window's system cursor
+     *
+     * SDL and the window system move it, so mouse motion renders nothing
+     * in LVGL, unlike lv_indev_set_cursor(). (hot_x, hot_y) is the pixel
+     * that points; nullptr restores the default arrow.
+     */
+    static bool cursor(const lv_image_dsc_t* img, int32_t hot_x = 0, int32_t hot_y = 0) noexcept {
+        SDL_Cursor*& cur = current_cursor();
+        SDL_Cursor* next = nullptr;
+        if (img) {
+            if (img->header.cf != LV_COLOR_FORMAT_ARGB8888) return false;
+            const int pitch = static_cast<int>(img->header.stride ? img->header.stride : img->header.w * 4u);
+            SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormatFrom(
+                const_cast<uint8_t*>(img->data), static_cast<int>(img->header.w), static_cast<int>(img->header.h),
+                32, pitch, SDL_PIXELFORMAT_ARGB8888);
+            if (!surface) return false;
+            next = SDL_CreateColorCursor(surface, hot_x, hot_y);   // copies the pixels
+            SDL_FreeSurface(surface);
+            if (!next) return false;
+        }
+        SDL_SetCursor(next ? next : SDL_GetDefaultCursor());
+        SDL_ShowCursor(SDL_ENABLE);
+        if (cur) SDL_FreeCursor(cur);
+        cur = next;
+        return true;
+    }
 };
 #endif
 
@@ -186,12 +318,25 @@ public:
 #if LV_USE_LINUX_FBDEV
 /**
  * @brief Linux framebuffer display backend
+ *
+ * pixel::convert_on_flush() (pixel_flush.hpp) after opening the device
+ * (lv_linux_fbdev_set_file() sets up the buffers) lets LVGL render
+ * XRGB8888 for a 16 bpp framebuffer and converts each area.
+ *
+ * Single-buffered; see FBFlipDisplay (page_flip.hpp) for tear-free panning,
+ * or FBFlipDisplay(device, FlushMode::in_place) to render straight into the
+ * framebuffer without the flush copy.
  */
 class FBDisplay : public Display {
 public:
     FBDisplay()
         : Display(lv_linux_fbdev_create()) {
     }
+
+    explicit FBDisplay(const char* device)
+        : Display(lv_linux_fbdev_create()) {
+        lv_linux_fbdev_set_file(get(), device);
+    }
 };
 #endif
 
@@ -199,12 +344,23 @@ public:
 #if LV_USE_LINUX_DRM
 /**
  * @brief Linux DRM/KMS display backend
+ *
+ * See DRMFlipDisplay (page_flip.hpp) for double-buffered page flipping, or
+ * FlushMode::in_place there to render into the scanout buffer without the
+ * flush copy. LVGL's driver keeps its device and CRTC to itself, so the
+ * hardware cursor (DRMFlipDisplay::cursor()) is only available there.
  */
 class DRMDisplay : public Display {
 public:
     DRMDisplay()
         : Display(lv_linux_drm_create()) {
     }
+
+    /// Open `device` (e.g. "/dev/dri/card0")
+    explicit DRMDisplay(const char* device, int64_t connector_id = -1)
+        : Display(lv_linux_drm_create()) {
+        lv_linux_drm_set_file(get(), device, connector_id);
+    }
 };
 #endif
 
@@ -0,0 +1,239 @@
+#pragma once
+
+/**
+ * @file display_mode.hpp
+ * @brief Resolution and DPI changes of a live display, without rebuilding the UI
+ *
+ * When an HDMI output changes mode, tearing the display down deletes every
+ * screen with it. apply() changes the resolution (and optionally the DPI)
+ * of the existing lv_display_t instead:
+ *
+ * - draw buffers allocated with buffers() are given back to the DrawBufPool
+ *   and taken again at the new size (drivers owning their buffers, such as
+ *   DRMFlipDisplay, swap them in the `rebuffer` callback)
+ * - LVGL resizes the screens and layers and marks layouts dirty; the
+ *   active screen and the layers are then laid out once, so percentage and
+ *   content sizes are final before the listeners run
+ * - cached layers drop only the bitmaps of objects whose size changed
+ *   (SIZE_CHANGED); on a DPI change, images shown with Image::src(set)
+ *   pick their variant again (image_set::rescale())
+ * - listeners (listen()) handle the rest, e.g. reapplying a theme whose
+ *   styles were computed with lv_dpx()
+ *
+ * @code
+ * lv::Display disp = lv::Display::get_default();
+ * lv::display_mode::buffers(disp, 48);                     // pooled partial buffers
+ * lv::display_mode::listen([](const lv::display_mode::Change& c, void*) {
+ *     if (c.rescaled()) lv::switch_theme(c.disp, app_theme.init(c.disp));   // theme_switch.hpp
+ * });
+ * ...
+ * disp.resize(1280, 720);                                  // or display_mode::apply()
+ * @endcode
+ *
+ * Call it from the LVGL thread between refreshes. Screens that are not
+ * loaded are laid out when they are. Stats::last_us tells how long the
+ * last change took.
+ *
+ * Heap allocation: NONE in the wrapper (fixed tables; draw buffers come
+ * from the DrawBufPool)
+ */
+
+#include <lvgl.h>
+#include <chrono>
+#include <cstdint>
+#include "image_set.hpp"
+#include "../draw/draw_buf.hpp"
+
+#ifndef LV_CPP_DISPLAY_MODE_DISPLAYS
+/// Displays whose draw buffers buffers() can manage at once
+#define LV_CPP_DISPLAY_MODE_DISPLAYS 2
+#endif
+
+#ifndef LV_CPP_DISPLAY_MODE_LISTENERS
+/// Callbacks told about mode changes
+#define LV_CPP_DISPLAY_MODE_LISTENERS 8
+#endif
+
+namespace lv::display_mode {
+
+/// One resolution or DPI change
+struct Change {
+    lv_display_t* disp;
+    int32_t old_w, old_h, old_dpi;
+    int32_t w, h, dpi;
+
+    [[nodiscard]] bool resized() const noexcept { return w != old_w || h != old_h; }
+    [[nodiscard]] bool rescaled() const noexcept { return dpi != old_dpi; }
+};
+
+using Listener = void (*)(const Change& change, void* user);
+
+struct Stats {
+    uint32_t changes = 0;      ///< apply() calls that changed something
+    uint32_t rebuffers = 0;    ///< Draw buffer pairs reallocated
+    uint32_t images = 0;       ///< Images that picked another variant
+    uint32_t last_us = 0;      ///< Duration of the last change
+};
+
+namespace detail {
+
+struct Buffers {
+    lv_display_t* disp = nullptr;   ///< nullptr: free slot
+    lv_draw_buf_t* bufs[2] = {nullptr, nullptr};
+    uint32_t rows = 0;              ///< 0: full screen
+    lv_display_render_mode_t mode = LV_DISPLAY_RENDER_MODE_PARTIAL;
+};
+
+struct ListenerSlot {
+    Listener fn = nullptr;
+    void* user = nullptr;
+};
+
+struct State {
+    Buffers buffers[LV_CPP_DISPLAY_MODE_DISPLAYS];
+    ListenerSlot listeners[LV_CPP_DISPLAY_MODE_LISTENERS];
+    Stats stats;
+};
+
+[[nodiscard]] inline State& state() noexcept {
+    static State s;
+    return s;
+}
+
+[[nodiscard]] inline Buffers* find(const lv_display_t* disp) noexcept {
+    for (Buffers& b : state().buffers) {
+        if (b.disp == disp) return &b;
+    }
+    return nullptr;
+}
+
+inline void free_bufs(Buffers& b) noexcept {
+    for (lv_draw_buf_t*& buf : b.bufs) {
+        if (buf) lv_draw_buf_destroy(buf);
+        buf = nullptr;
+    }
+}
+
+/// Give the old pair back to the pool first, so one of the same size class can be reused
+[[nodiscard]] inline bool alloc_bufs(Buffers& b) noexcept {
+    free_bufs(b);
+    const auto w = static_cast<uint32_t>(lv_display_get_horizontal_resolution(b.disp));
+    const auto h = static_cast<uint32_t>(lv_display_get_vertical_resolution(b.disp));
+    const uint32_t rows = b.rows && b.rows < h ? b.rows : h;
+    const lv_color_format_t cf = lv_display_get_color_format(b.disp);
+    for (lv_draw_buf_t*& buf : b.bufs) {
+        buf = lv_draw_buf_create_ex(draw::pool_handlers(), w, rows, cf, LV_STRIDE_AUTO);
+        if (!buf) {
+            free_bufs(b);
+            return false;
+        }
+    }
+    lv_display_set_draw_buffers(b.disp, b.bufs[0], b.bufs[1]);
+    lv_display_set_render_mode(b.disp, b.mode);
+    return true;
+}
+
+inline void delete_cb(lv_event_t* e) noexcept {
+    if (Buffers* b = find(static_cast<lv_display_t*>(lv_event_get_current_target(e)))) {
+        free_bufs(*b);
+        *b = Buffers{};
+    }
+}
+
+[[nodiscard]] inline uint32_t now_us() noexcept {
+    using namespace std::chrono;
+    return static_cast<uint32_t>(duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+} // namespace detail
+
+/**
+ * @brief Render `disp` into two DrawBufPool buffers that apply() resizes
+ *
+ * @param rows Rows per buffer in partial mode (0: full screen)
+ * @param mode LV_DISPLAY_RENDER_MODE_PARTIAL, or FULL/DIRECT with rows = 0
+ * @return false without a free slot (LV_CPP_DISPLAY_MODE_DISPLAYS) or memory
+ */
+inline bool buffers(lv_display_t* disp, uint32_t rows,
+                    lv_display_render_mode_t mode = LV_DISPLAY_RENDER_MODE_PARTIAL) noexcept {
+    if (!disp) return false;
+    detail::Buffers* b = detail::find(disp);
+    if (!b) {
+        b = detail::find(nullptr);
+        if (!b) {
+            LV_LOG_WARN("display_mode: raise LV_CPP_DISPLAY_MODE_DISPLAYS");
+            return false;
+        }
+        b->disp = disp;
+        lv_display_add_event_cb(disp, &detail::delete_cb, LV_EVENT_DELETE, nullptr);
+    }
+    b->rows = mode == LV_DISPLAY_RENDER_MODE_PARTIAL ? rows : 0;
+    b->mode = mode;
+    return detail::alloc_bufs(*b);
+}
+
+/// Call `fn` after every change apply() makes
+inline bool listen(Listener fn, void* user = nullptr) noexcept {
+    for (detail::ListenerSlot& l : detail::state().listeners) {
+        if (!l.fn) {
+            l = {fn, user};
+            return true;
+        }
+    }
+    LV_LOG_WARN("display_mode: raise LV_CPP_DISPLAY_MODE_LISTENERS");
+    return false;
+}
+
+inline void unlisten(Listener fn, void* user = nullptr) noexcept {
+    for (detail::ListenerSlot& l : detail::state().listeners) {
+        if (l.fn == fn && l.user == user) l = {};
+    }
+}
+
+/**
+ * @brief Switch `disp` to `w` x `h` (and `dpi` when > 0) in place
+ *
+ * @param rebuffer Called right after LVGL took the new resolution, for
+ *                 drivers that hand LVGL new screen buffers themselves
+ * @return false if nothing changed or the pooled buffers could not be reallocated
+ */
+inline bool apply(lv_display_t* disp, int32_t w, int32_t h, int32_t dpi = 0,
+                  void (*rebuffer)(lv_display_t*, void*) = nullptr, void* user = nullptr) noexcept {
+    if (!disp || w <= 0 || h <= 0) return false;
+    detail::State& st = detail::state();
+    const uint32_t start = detail::now_us();
+    Change c{disp, lv_display_get_horizontal_resolution(disp), lv_display_get_vertical_resolution(disp),
+             lv_display_get_dpi(disp), w, h, dpi > 0 ? dpi : lv_display_get_dpi(disp)};
+    if (!c.resized() && !c.rescaled()) return false;
+
+    if (c.rescaled()) lv_display_set_dpi(disp, c.dpi);
+    bool ok = true;
+    if (c.resized()) {
+        lv_display_set_resolution(disp, w, h);
+        if (rebuffer) rebuffer(disp, user);
+        if (detail::Buffers* b = detail::find(disp)) {
+            ok = detail::alloc_bufs(*b);
+            ++st.stats.rebuffers;
+        }
+    }
+    if (c.rescaled()) st.stats.images += image_set::rescale(disp);
+
+    // One layout pass for what is visible; other screens follow when loaded
+    lv_obj_update_layout(lv_display_get_screen_active(disp));
+    lv_obj_update_layout(lv_display_get_layer_top(disp));
+    lv_obj_update_layout(lv_display_get_layer_sys(disp));
+    lv_obj_update_layout(lv_display_get_layer_bottom(disp));
+
+    for (const detail::ListenerSlot& l : st.listeners) {
+        if (l.fn) l.fn(c, l.user);
+    }
+    ++st.stats.changes;
+    st.stats.last_us = detail::now_us() - start;
+    return ok;
+}
+
+[[nodiscard]] inline Stats stats() noexcept { return detail::state().stats; }
+
+inline void reset_stats() noexcept { detail::state().stats = Stats{}; }
+
+} // namespace lv::display_mode
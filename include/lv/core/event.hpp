@@ -51,6 +51,11 @@
 #include <cstring>
 #include <utility>
 #include "object.hpp"  // For ObjectView
+#include "callback.hpp"
+#include "profiler.hpp"
+#include "event_stats.hpp"
+#include "mem_account.hpp"
+#include "gesture.hpp"
 
 
 namespace lv {
@@ -178,10 +183,62 @@ public:
     }
 };
 
+/**
+ * @brief Event delivered through EventMixin::delegate()
+ *
+ * Identifies the direct child of the delegating container that the event
+ * originated from (the target itself or its ancestor below the container).
+ */
+class DelegateEvent {
+    Event m_event;
+    lv_obj_t* m_child;
+
+public:
+    constexpr DelegateEvent(lv_event_t* e, lv_obj_t* child) noexcept : m_event(e), m_child(child) {}
+
+    /// Underlying event (current target is the container)
+    [[nodiscard]] constexpr Event event() const noexcept { return m_event; }
+
+    /// Direct child of the container the event came from
+    [[nodiscard]] ObjectView child() const noexcept { return ObjectView(m_child); }
+
+    /// Index of child() among the container's children
+    [[nodiscard]] int32_t index() const noexcept { return lv_obj_get_index(m_child); }
+
+    /// Name of child() (nullptr if not set or LV_USE_OBJ_NAME is disabled)
+    [[nodiscard]] const char* name() const noexcept {
+#if LV_USE_OBJ_NAME
+        return lv_obj_get_name(m_child);
+#else
+        return nullptr;
+#endif
+    }
+
+    /// The container the handler is registered on
+    [[nodiscard]] ObjectView container() const noexcept { return m_event.current_target(); }
+
+    [[nodiscard]] lv_event_code_t code() const noexcept { return m_event.code(); }
+};
+
 /// Check if F is a stateless lambda taking lv::Event
 template<typename F>
 concept StatelessEventCallable = std::is_convertible_v<F, void(*)(Event)>;
 
+/// Check if F is a capturing callable taking lv::Event or lv_event_t*
+template<typename F>
+concept CapturingEventCallable = Invocable<F, Event> &&
+    !StatelessEventCallable<F> && !StatelessCallable<F, lv_event_t*>;
+
+/// Callables accepted by on() and its shorthands (capturing only with LV_CPP_USE_STD_FUNCTION)
+template<typename F>
+concept EventHandler = StatelessCallable<F, lv_event_t*> || StatelessEventCallable<F> ||
+    (capturing_callbacks && CapturingEventCallable<F>);
+
+/// Capturing callables rejected with a deleted overload when LV_CPP_USE_STD_FUNCTION is off
+template<typename F>
+concept RejectedCapture = !capturing_callbacks && CapturingCallable<F, lv_event_t*> &&
+    !StatelessEventCallable<F>;
+
 // ==================== Event Callback Helpers ====================
 
 namespace detail {
@@ -195,6 +252,9 @@ namespace detail {
 template<void(*Fn)(Event)>
 struct EventTrampoline {
     static void callback(lv_event_t* e) {
+        LV_CPP_EVENT_STATS_SCOPE(e);
+        LV_CPP_MEM_ACCOUNT_EVENT_SCOPE(e);
+        LV_PROFILE_FUNCTION();
         Fn(Event(e));
     }
 };
@@ -209,6 +269,9 @@ struct EventTrampoline {
 template<auto MemFn, typename T>
 struct MemberTrampoline {
     static void callback(lv_event_t* e) {
+        LV_CPP_EVENT_STATS_SCOPE(e);
+        LV_CPP_MEM_ACCOUNT_EVENT_SCOPE(e);
+        LV_PROFILE_FUNCTION();
         auto* instance = static_cast<T*>(lv_event_get_user_data(e));
         (instance->*MemFn)(e);
     }
@@ -220,6 +283,9 @@ struct MemberTrampoline {
 template<auto MemFn, typename T>
 struct MemberTrampolineEvent {
     static void callback(lv_event_t* e) {
+        LV_CPP_EVENT_STATS_SCOPE(e);
+        LV_CPP_MEM_ACCOUNT_EVENT_SCOPE(e);
+        LV_PROFILE_FUNCTION();
         auto* instance = static_cast<T*>(lv_event_get_user_data(e));
         (instance->*MemFn)(Event(e));
     }
@@ -231,11 +297,61 @@ struct MemberTrampolineEvent {
 template<auto MemFn, typename T>
 struct MemberTrampolineNoArg {
     static void callback(lv_event_t* e) {
+        LV_CPP_EVENT_STATS_SCOPE(e);
+        LV_CPP_MEM_ACCOUNT_EVENT_SCOPE(e);
+        LV_PROFILE_FUNCTION();
         auto* instance = static_cast<T*>(lv_event_get_user_data(e));
         (instance->*MemFn)();
     }
 };
 
+/// Trampoline for pooled capturing callbacks (user_data is the CallbackSlot)
+template<typename F>
+struct CallbackEventTrampoline {
+    static void callback(lv_event_t* e) {
+        LV_CPP_EVENT_STATS_SCOPE(e);
+        LV_CPP_MEM_ACCOUNT_EVENT_SCOPE(e);
+        LV_PROFILE_FUNCTION();
+        static_cast<CallbackSlot*>(lv_event_get_user_data(e))->as<F>()(Event(e));
+    }
+};
+
+/// Direct child of `container` containing `obj`, or nullptr if obj is the container or outside it
+[[nodiscard]] inline lv_obj_t* delegate_child(lv_obj_t* container, lv_obj_t* obj) noexcept {
+    while (obj && obj != container) {
+        lv_obj_t* parent = lv_obj_get_parent(obj);
+        if (parent == container) return obj;
+        obj = parent;
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Trampoline for delegated events: resolves the child, filters by class
+ *
+ * Class == nullptr accepts any child.
+ */
+template<auto MemFn, typename T, const lv_obj_class_t* Class>
+struct DelegateTrampoline {
+    static void callback(lv_event_t* e) {
+        lv_obj_t* child = delegate_child(lv_event_get_current_target_obj(e), lv_event_get_target_obj(e));
+        if (!child) return;
+        if constexpr (Class != nullptr) {
+            if (!lv_obj_check_type(child, Class)) return;
+        }
+        auto* instance = static_cast<T*>(lv_event_get_user_data(e));
+        (instance->*MemFn)(DelegateEvent(e, child));
+    }
+};
+
+/// Make children created later bubble their events to the delegating container
+inline void delegate_child_created_cb(lv_event_t* e) {
+    auto* child = static_cast<lv_obj_t*>(lv_event_get_param(e));
+    if (child && lv_obj_get_parent(child) == lv_event_get_current_target_obj(e)) {
+        lv_obj_add_flag(child, LV_OBJ_FLAG_EVENT_BUBBLE);
+    }
+}
+
 } // namespace detail
 
 
@@ -256,6 +372,7 @@ struct MemberTrampolineNoArg {
  * - Hover: on_hover_over, on_hover_leave
  * - Scroll: on_scroll, on_scroll_begin, on_scroll_end, on_gesture
  * - Value: on_value_changed
+ * - Gestures (GestureMixin): on_pan, on_fling, on_pinch, on_rotate, on_hold, on_double_tap
  *
  * For less common events (rotary, key, indev_reset, draw events, etc.), use the
  * generic on() method with lv::kEvent:: constants.
@@ -269,7 +386,7 @@ struct MemberTrampolineNoArg {
  * For display events, use: lv_display_add_event_cb(display, callback, code, user_data)
  */
 template<typename Derived>
-class EventMixin {
+class EventMixin : public GestureMixin<Derived> {
 private:
     [[nodiscard]] lv_obj_t* obj() noexcept {
         return static_cast<Derived*>(this)->get();
@@ -378,11 +495,35 @@ public:
         return *static_cast<Derived*>(this);
     }
 
+    /**
+     * @brief Add capturing callback (LV_CPP_USE_STD_FUNCTION mode)
+     *
+     * The callable is moved into a fixed pool slot (see callback.hpp) and
+     * released on LV_EVENT_DELETE of this object; no heap allocation.
+     * Captures must fit LV_CPP_CALLBACK_STORAGE. If the pool is exhausted a
+     * warning is logged and no callback is added.
+     *
+     * @code
+     * int clicks = 0;
+     * btn.on(lv::kEvent::clicked, [&clicks](lv::Event) { ++clicks; });
+     * @endcode
+     */
+    template<typename F>
+        requires (capturing_callbacks && CapturingEventCallable<F>)
+    Derived& on(lv_event_code_t code, F&& fn) noexcept {
+        detail::CallbackSlot* slot = detail::acquire_callback(std::forward<F>(fn));
+        if (slot) {
+            lv_obj_add_event_cb(obj(), &detail::CallbackEventTrampoline<std::decay_t<F>>::callback, code, slot);
+            lv_obj_add_event_cb(obj(), &detail::callback_delete_cb, LV_EVENT_DELETE, slot);
+        }
+        return *static_cast<Derived*>(this);
+    }
+
     /**
      * @brief Deleted overload for capturing lambdas - provides helpful error message
      */
     template<typename F>
-        requires (CapturingCallable<F, lv_event_t*> && !StatelessEventCallable<F>)
+        requires RejectedCapture<F>
     Derived& on(lv_event_code_t code, F&& fn) = delete;  // Use member function: btn.on<&MyClass::handler>(event, this)
 
     /// @deprecated Use on() instead
@@ -484,6 +625,49 @@ public:
         return on_simple<MemFn>(code, instance);
     }
 
+    // ==================== Delegation ====================
+
+    /**
+     * @brief Handle an event of all children with one handler on this container
+     *
+     * Registers a single descriptor on the container instead of one per
+     * child. The handler receives a DelegateEvent with the originating direct
+     * child, its index and name. Existing and later-created children get
+     * LV_OBJ_FLAG_EVENT_BUBBLE so their events reach the container; deeper
+     * descendants need the flag themselves (non-clickable labels inside a
+     * button don't, the button is the target).
+     *
+     * Children are resolved when the event fires, so rows that are rebound
+     * or recycled (e.g. VirtualList) need no re-registration.
+     *
+     * @tparam MemFn Member function void(lv::DelegateEvent)
+     * @tparam Class Only deliver events from children of this class (nullptr = any)
+     *
+     * @code
+     * class Keypad {
+     *     void on_key(lv::DelegateEvent e) { press(e.index()); }
+     * };
+     * grid.delegate<&Keypad::on_key>(this);                         // clicks of any child
+     * list.delegate<&Log::on_row, &lv_button_class>(this, lv::kEvent::long_pressed);
+     * @endcode
+     */
+    template<auto MemFn, const lv_obj_class_t* Class = nullptr, typename T>
+        requires std::is_invocable_v<decltype(MemFn), T*, DelegateEvent>
+    Derived& delegate(T* instance, lv_event_code_t code = LV_EVENT_CLICKED) noexcept {
+        lv_obj_t* container = obj();
+        const uint32_t n = lv_obj_get_child_count(container);
+        for (uint32_t i = 0; i < n; ++i) {
+            lv_obj_add_flag(lv_obj_get_child(container, static_cast<int32_t>(i)), LV_OBJ_FLAG_EVENT_BUBBLE);
+        }
+        // One shared hook per container, however many delegates are registered
+        lv_obj_remove_event_cb(container, &detail::delegate_child_created_cb);
+        lv_obj_add_event_cb(container, &detail::delegate_child_created_cb, LV_EVENT_CHILD_CREATED, nullptr);
+
+        using Trampoline = detail::DelegateTrampoline<MemFn, T, Class>;
+        lv_obj_add_event_cb(container, &Trampoline::callback, code, instance);
+        return *static_cast<Derived*>(this);
+    }
+
     // ==================== Removal ====================
 
     /// Remove callback descriptor by index
@@ -510,7 +694,7 @@ public:
 
     /// Shorthand for clicked event (stateless lambda with lv_event_t* or lv::Event)
     template<typename F>
-        requires StatelessCallable<F, lv_event_t*> || StatelessEventCallable<F>
+        requires EventHandler<F>
     Derived& on_click(F&& fn) noexcept {
         return on(LV_EVENT_CLICKED, std::forward<F>(fn));
     }
@@ -523,12 +707,12 @@ public:
 
     /// Deleted: capturing lambda - use member function instead
     template<typename F>
-        requires (CapturingCallable<F, lv_event_t*> && !StatelessEventCallable<F>)
+        requires RejectedCapture<F>
     Derived& on_click(F&& fn) = delete;  // Use member function: btn.on_click<&MyClass::handler>(this)
 
     /// Shorthand for value_changed event (stateless lambda with lv_event_t* or lv::Event)
     template<typename F>
-        requires StatelessCallable<F, lv_event_t*> || StatelessEventCallable<F>
+        requires EventHandler<F>
     Derived& on_value_changed(F&& fn) noexcept {
         return on(LV_EVENT_VALUE_CHANGED, std::forward<F>(fn));
     }
@@ -541,36 +725,36 @@ public:
 
     /// Deleted: capturing lambda - use member function instead
     template<typename F>
-        requires (CapturingCallable<F, lv_event_t*> && !StatelessEventCallable<F>)
+        requires RejectedCapture<F>
     Derived& on_value_changed(F&& fn) = delete;  // Use member function: btn.on_value_changed<&MyClass::handler>(this)
 
     /// Shorthand for pressed event (stateless lambda with lv_event_t* or lv::Event)
     template<typename F>
-        requires StatelessCallable<F, lv_event_t*> || StatelessEventCallable<F>
+        requires EventHandler<F>
     Derived& on_pressed(F&& fn) noexcept {
         return on(LV_EVENT_PRESSED, std::forward<F>(fn));
     }
 
     /// Shorthand for released event (stateless lambda with lv_event_t* or lv::Event)
     template<typename F>
-        requires StatelessCallable<F, lv_event_t*> || StatelessEventCallable<F>
+        requires EventHandler<F>
     Derived& on_released(F&& fn) noexcept {
         return on(LV_EVENT_RELEASED, std::forward<F>(fn));
     }
 
     /// Deleted: capturing lambda - use member function instead
     template<typename F>
-        requires (CapturingCallable<F, lv_event_t*> && !StatelessEventCallable<F>)
+        requires RejectedCapture<F>
     Derived& on_pressed(F&& fn) = delete;  // Use member function: btn.on<&MyClass::handler>(lv::kEvent::pressed, this)
 
     /// Deleted: capturing lambda - use member function instead
     template<typename F>
-        requires (CapturingCallable<F, lv_event_t*> && !StatelessEventCallable<F>)
+        requires RejectedCapture<F>
     Derived& on_released(F&& fn) = delete;  // Use member function: btn.on<&MyClass::handler>(lv::kEvent::released, this)
 
     /// Shorthand for focused event (stateless lambda with lv_event_t* or lv::Event)
     template<typename F>
-        requires StatelessCallable<F, lv_event_t*> || StatelessEventCallable<F>
+        requires EventHandler<F>
     Derived& on_focused(F&& fn) noexcept {
         return on(LV_EVENT_FOCUSED, std::forward<F>(fn));
     }
@@ -583,7 +767,7 @@ public:
 
     /// Shorthand for defocused event (stateless lambda with lv_event_t* or lv::Event)
     template<typename F>
-        requires StatelessCallable<F, lv_event_t*> || StatelessEventCallable<F>
+        requires EventHandler<F>
     Derived& on_defocused(F&& fn) noexcept {
         return on(LV_EVENT_DEFOCUSED, std::forward<F>(fn));
     }
@@ -596,19 +780,19 @@ public:
 
     /// Deleted: capturing lambda - use member function instead
     template<typename F>
-        requires (CapturingCallable<F, lv_event_t*> && !StatelessEventCallable<F>)
+        requires RejectedCapture<F>
     Derived& on_focused(F&& fn) = delete;  // Use member function: btn.on_focused<&MyClass::handler>(this)
 
     /// Deleted: capturing lambda - use member function instead
     template<typename F>
-        requires (CapturingCallable<F, lv_event_t*> && !StatelessEventCallable<F>)
+        requires RejectedCapture<F>
     Derived& on_defocused(F&& fn) = delete;  // Use member function: btn.on_defocused<&MyClass::handler>(this)
 
     // ==================== Multi-click Events ====================
 
     /// Shorthand for single_clicked event (stateless lambda)
     template<typename F>
-        requires StatelessCallable<F, lv_event_t*> || StatelessEventCallable<F>
+        requires EventHandler<F>
     Derived& on_single_clicked(F&& fn) noexcept {
         return on(LV_EVENT_SINGLE_CLICKED, std::forward<F>(fn));
     }
@@ -621,7 +805,7 @@ public:
 
     /// Shorthand for double_clicked event (stateless lambda)
     template<typename F>
-        requires StatelessCallable<F, lv_event_t*> || StatelessEventCallable<F>
+        requires EventHandler<F>
     Derived& on_double_clicked(F&& fn) noexcept {
         return on(LV_EVENT_DOUBLE_CLICKED, std::forward<F>(fn));
     }
@@ -634,7 +818,7 @@ public:
 
     /// Shorthand for triple_clicked event (stateless lambda)
     template<typename F>
-        requires StatelessCallable<F, lv_event_t*> || StatelessEventCallable<F>
+        requires EventHandler<F>
     Derived& on_triple_clicked(F&& fn) noexcept {
         return on(LV_EVENT_TRIPLE_CLICKED, std::forward<F>(fn));
     }
@@ -647,7 +831,7 @@ public:
 
     /// Shorthand for long_pressed event (stateless lambda)
     template<typename F>
-        requires StatelessCallable<F, lv_event_t*> || StatelessEventCallable<F>
+        requires EventHandler<F>
     Derived& on_long_pressed(F&& fn) noexcept {
         return on(LV_EVENT_LONG_PRESSED, std::forward<F>(fn));
     }
@@ -662,7 +846,7 @@ public:
 
     /// Shorthand for hover_over event (stateless lambda)
     template<typename F>
-        requires StatelessCallable<F, lv_event_t*> || StatelessEventCallable<F>
+        requires EventHandler<F>
     Derived& on_hover_over(F&& fn) noexcept {
         return on(LV_EVENT_HOVER_OVER, std::forward<F>(fn));
     }
@@ -675,7 +859,7 @@ public:
 
     /// Shorthand for hover_leave event (stateless lambda)
     template<typename F>
-        requires StatelessCallable<F, lv_event_t*> || StatelessEventCallable<F>
+        requires EventHandler<F>
     Derived& on_hover_leave(F&& fn) noexcept {
         return on(LV_EVENT_HOVER_LEAVE, std::forward<F>(fn));
     }
@@ -690,7 +874,7 @@ public:
 
     /// Shorthand for scroll event (stateless lambda)
     template<typename F>
-        requires StatelessCallable<F, lv_event_t*> || StatelessEventCallable<F>
+        requires EventHandler<F>
     Derived& on_scroll(F&& fn) noexcept {
         return on(LV_EVENT_SCROLL, std::forward<F>(fn));
     }
@@ -703,7 +887,7 @@ public:
 
     /// Shorthand for scroll_begin event (stateless lambda)
     template<typename F>
-        requires StatelessCallable<F, lv_event_t*> || StatelessEventCallable<F>
+        requires EventHandler<F>
     Derived& on_scroll_begin(F&& fn) noexcept {
         return on(LV_EVENT_SCROLL_BEGIN, std::forward<F>(fn));
     }
@@ -716,7 +900,7 @@ public:
 
     /// Shorthand for scroll_end event (stateless lambda)
     template<typename F>
-        requires StatelessCallable<F, lv_event_t*> || StatelessEventCallable<F>
+        requires EventHandler<F>
     Derived& on_scroll_end(F&& fn) noexcept {
         return on(LV_EVENT_SCROLL_END, std::forward<F>(fn));
     }
@@ -729,7 +913,7 @@ public:
 
     /// Shorthand for gesture event (stateless lambda)
     template<typename F>
-        requires StatelessCallable<F, lv_event_t*> || StatelessEventCallable<F>
+        requires EventHandler<F>
     Derived& on_gesture(F&& fn) noexcept {
         return on(LV_EVENT_GESTURE, std::forward<F>(fn));
     }
@@ -742,13 +926,15 @@ public:
 
     // ==================== Notes ====================
     //
-    // Capturing lambdas are intentionally NOT supported.
+    // Capturing lambdas are NOT supported by default.
     // When you try to use a capturing lambda, you'll get a compile error
     // pointing you to use a member function instead:
     //
     //   btn.on_click<&MyClass::handler>(this);
     //
     // This is zero-cost and matches how C handles stateful callbacks (via user_data).
+    // With LV_CPP_USE_STD_FUNCTION, on() and the shorthands also accept capturing
+    // lambdas, stored in a fixed pool (callback.hpp) instead of the heap.
 };
 
 
@@ -0,0 +1,350 @@
+#pragma once
+
+/**
+ * @file event_loop.hpp
+ * @brief Event-driven main loop that blocks on file descriptors
+ *
+ * lv::run() sleeps for whatever lv_timer_handler() returns, so an idle
+ * device still wakes every refresh period and a touch can wait up to one
+ * period before it is read. EventLoop instead blocks in epoll_wait() on:
+ *
+ * - the input/display file descriptors you register (evdev, DRM, X11, ...)
+ * - a timerfd armed with lv_timer_handler()'s return value
+ * - an eventfd that other threads can signal via wake(), or implicitly by
+ *   posting to an attached Dispatcher (see async.hpp)
+ *
+ * Input devices registered with watch() are switched to LVGL's event mode
+ * and read as soon as their fd becomes readable. With idle_refresh(), the
+ * display refresh timer is paused while no redraw is requested, so the loop
+ * sleeps indefinitely until input, a timer or wake() arrives.
+ * adaptive_refresh() does the same and also lowers the refresh rate
+ * for updates without motion (see refresh_rate.hpp).
+ *
+ * Linux only (epoll, timerfd, eventfd). Use lv::run() elsewhere.
+ *
+ * Usage:
+ * @code
+ * lv::init();
+ * lv::DRMDisplay display;
+ * lv_indev_t* touch = lv_evdev_create(LV_INDEV_TYPE_POINTER, "/dev/input/event0");
+ *
+ * lv::EventLoop loop;
+ * loop.watch(touch_fd, touch)       // read touch as soon as it arrives
+ *     .idle_refresh(display)        // stop refreshing when nothing changed
+ *     .attach(lv::dispatcher());    // wake when a worker calls lv::post()
+ * loop.run();
+ * @endcode
+ */
+
+#include <lvgl.h>
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+#include "app.hpp"
+#include "async.hpp"
+#include "refresh_rate.hpp"
+
+#if defined(__linux__)
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+namespace lv {
+
+/// Callback invoked when a watched fd becomes ready (epoll event mask in `events`)
+using fd_cb = void (*)(int fd, uint32_t events, void* user_data);
+
+/**
+ * @brief epoll-based main loop with timerfd and eventfd wakeups
+ *
+ * Non-copyable, non-movable (the kernel objects are tied to this instance).
+ * At most MAX_WATCHES file descriptors can be registered; no heap allocation.
+ */
+class EventLoop {
+public:
+    static constexpr size_t MAX_WATCHES = 8;
+
+private:
+    struct Watch {
+        int fd = -1;
+        fd_cb cb = nullptr;
+        void* user_data = nullptr;
+        lv_indev_t* indev = nullptr;
+    };
+
+    int m_epoll = -1;
+    int m_timer = -1;
+    int m_wake = -1;
+    Watch m_watches[MAX_WATCHES];
+    size_t m_count = 0;
+    bool m_quit = false;
+    void (*m_drain)(void*) = nullptr;
+    void* m_drain_obj = nullptr;
+
+    // Tags stored in epoll_event::data.u64 for the internal fds
+    static constexpr uint64_t TAG_TIMER = UINT64_MAX;
+    static constexpr uint64_t TAG_WAKE = UINT64_MAX - 1;
+
+    bool add_fd(int fd, uint64_t tag) noexcept {
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.u64 = tag;
+        return epoll_ctl(m_epoll, EPOLL_CTL_ADD, fd, &ev) == 0;
+    }
+
+    void arm_timer(uint32_t ms) noexcept {
+        itimerspec spec{};
+        if (ms != LV_NO_TIMER_READY) {
+            // Zero would disarm the timer: round up to 1 ns for "now"
+            spec.it_value.tv_sec = ms / 1000;
+            spec.it_value.tv_nsec = ms == 0 ? 1 : static_cast<long>(ms % 1000) * 1000000L;
+        }
+        timerfd_settime(m_timer, 0, &spec, nullptr);
+    }
+
+    static void drain(int fd) noexcept {
+        uint64_t v;
+        while (::read(fd, &v, sizeof(v)) == sizeof(v)) {}
+    }
+
+    void dispatch(const epoll_event& ev) noexcept {
+        if (ev.data.u64 == TAG_TIMER) {
+            drain(m_timer);
+            return;
+        }
+        if (ev.data.u64 == TAG_WAKE) {
+            drain(m_wake);
+            return;
+        }
+        if (ev.data.u64 >= MAX_WATCHES) return;
+        Watch& w = m_watches[ev.data.u64];
+        if (w.fd < 0) return;
+        if (w.indev) lv_indev_read(w.indev);
+        if (w.cb) w.cb(w.fd, ev.events, w.user_data);
+    }
+
+    static void display_refr_request_cb(lv_event_t* e) noexcept {
+        auto* disp = static_cast<lv_display_t*>(lv_event_get_current_target(e));
+        if (lv_timer_t* t = lv_display_get_refr_timer(disp)) lv_timer_resume(t);
+    }
+
+    static void display_refr_ready_cb(lv_event_t* e) noexcept {
+        // Keep refreshing while animations run; they invalidate every frame anyway
+        if (lv_anim_count_running() > 0) return;
+        auto* disp = static_cast<lv_display_t*>(lv_event_get_current_target(e));
+        if (lv_timer_t* t = lv_display_get_refr_timer(disp)) lv_timer_pause(t);
+    }
+
+public:
+    /// Create epoll instance, timerfd and wake eventfd
+    EventLoop() noexcept {
+        m_epoll = epoll_create1(EPOLL_CLOEXEC);
+        m_timer = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+        m_wake = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (m_epoll >= 0) {
+            if (m_timer >= 0) add_fd(m_timer, TAG_TIMER);
+            if (m_wake >= 0) add_fd(m_wake, TAG_WAKE);
+        }
+    }
+
+    ~EventLoop() {
+        if (m_wake >= 0) ::close(m_wake);
+        if (m_timer >= 0) ::close(m_timer);
+        if (m_epoll >= 0) ::close(m_epoll);
+    }
+
+    EventLoop(const EventLoop&) = delete;
+    EventLoop& operator=(const EventLoop&) = delete;
+    EventLoop(EventLoop&&) = delete;
+    EventLoop& operator=(EventLoop&&) = delete;
+
+    /// Check that all kernel objects were created
+    [[nodiscard]] bool valid() const noexcept {
+        return m_epoll >= 0 && m_timer >= 0 && m_wake >= 0;
+    }
+    explicit operator bool() const noexcept { return valid(); }
+
+    // ==================== Registration ====================
+
+    /**
+     * @brief Watch an input device fd
+     *
+     * Switches the indev to LV_INDEV_MODE_EVENT so LVGL stops polling it,
+     * and calls lv_indev_read() as soon as the fd becomes readable.
+     */
+    EventLoop& watch(int fd, lv_indev_t* indev) noexcept {
+        if (add_watch(fd, nullptr, nullptr, indev)) {
+            lv_indev_set_mode(indev, LV_INDEV_MODE_EVENT);
+        }
+        return *this;
+    }
+
+    /// Watch an arbitrary fd with a C callback (e.g. a display vsync or socket fd)
+    EventLoop& watch(int fd, fd_cb cb, void* user_data = nullptr) noexcept {
+        add_watch(fd, cb, user_data, nullptr);
+        return *this;
+    }
+
+    /// Watch an fd with a member function callback void(int fd, uint32_t events)
+    template<auto MemFn, typename T>
+        requires std::is_member_function_pointer_v<decltype(MemFn)>
+    EventLoop& watch(int fd, T* instance) noexcept {
+        add_watch(fd, [](int f, uint32_t events, void* ud) {
+            (static_cast<T*>(ud)->*MemFn)(f, events);
+        }, instance, nullptr);
+        return *this;
+    }
+
+    /// Stop watching an fd. Indevs are switched back to timer mode.
+    bool unwatch(int fd) noexcept {
+        if (fd < 0) return false;
+        for (size_t i = 0; i < MAX_WATCHES; ++i) {
+            Watch& w = m_watches[i];
+            if (w.fd != fd) continue;
+            epoll_ctl(m_epoll, EPOLL_CTL_DEL, fd, nullptr);
+            if (w.indev) lv_indev_set_mode(w.indev, LV_INDEV_MODE_TIMER);
+            w = Watch{};
+            --m_count;
+            return true;
+        }
+        return false;
+    }
+
+    /// Number of registered fds
+    [[nodiscard]] size_t watch_count() const noexcept { return m_count; }
+
+    /**
+     * @brief Pause the display refresh timer while nothing is invalidated
+     *
+     * The refresh timer is resumed by LV_EVENT_REFR_REQUEST and paused
+     * again after each refresh when no animation is running. Together with
+     * fd wakeups this lets the loop sleep indefinitely on an idle screen.
+     *
+     * @param disp Display to manage (nullptr = default display)
+     */
+    EventLoop& idle_refresh(lv_display_t* disp = nullptr) noexcept {
+        if (!disp) disp = lv_display_get_default();
+        if (!disp) return *this;
+        lv_display_add_event_cb(disp, &EventLoop::display_refr_request_cb,
+                                LV_EVENT_REFR_REQUEST, nullptr);
+        lv_display_add_event_cb(disp, &EventLoop::display_refr_ready_cb,
+                                LV_EVENT_REFR_READY, nullptr);
+        return *this;
+    }
+
+    /**
+     * @brief Let the display pick its refresh period, pausing it when idle
+     *
+     * Replaces idle_refresh() on that display. With `cfg.idle_ms` = 0 (the
+     * default) the idle screen stops refreshing as with idle_refresh();
+     * in between, the timerfd follows the boost and normal periods.
+     *
+     * @param disp Display to manage (nullptr = default display)
+     */
+    EventLoop& adaptive_refresh(lv_display_t* disp = nullptr, const RefreshConfig& cfg = {}) noexcept {
+        if (!disp) disp = lv_display_get_default();
+        if (!disp) return *this;
+        lv_display_remove_event_cb_with_user_data(disp, &EventLoop::display_refr_request_cb, nullptr);
+        lv_display_remove_event_cb_with_user_data(disp, &EventLoop::display_refr_ready_cb, nullptr);
+        refresh_rate::enable(disp, cfg);
+        return *this;
+    }
+
+    // ==================== Wakeup ====================
+
+    /// Wake the loop from any thread (async-signal-safe)
+    void wake() noexcept {
+        if (m_wake < 0) return;
+        uint64_t one = 1;
+        [[maybe_unused]] ssize_t n = ::write(m_wake, &one, sizeof(one));
+    }
+
+    /**
+     * @brief Drain a Dispatcher every iteration and wake on each post
+     *
+     * The default lv::dispatcher() is always drained (via lv::tick()); attach
+     * it to also get an immediate wakeup when another thread calls lv::post().
+     * Call before producer threads start posting.
+     */
+    template<size_t Capacity, size_t InlineSize>
+    EventLoop& attach(Dispatcher<Capacity, InlineSize>& d) noexcept {
+        d.on_post([](void* ud) { static_cast<EventLoop*>(ud)->wake(); }, this);
+        m_drain = [](void* obj) { static_cast<Dispatcher<Capacity, InlineSize>*>(obj)->drain(); };
+        m_drain_obj = &d;
+        return *this;
+    }
+
+    /// Wake eventfd, for integrating with other notification sources
+    [[nodiscard]] int wake_fd() const noexcept { return m_wake; }
+
+    /// Ask run()/run_with() to return after the current iteration
+    void quit() noexcept {
+        m_quit = true;
+        wake();
+    }
+
+    // ==================== Running ====================
+
+    /**
+     * @brief Run one iteration: handle posts and timers, then block until the next event
+     *
+     * @param max_wait_ms Upper bound for blocking (-1 = no bound)
+     * @return Value returned by lv_timer_handler()
+     */
+    uint32_t run_once(int32_t max_wait_ms = -1) noexcept {
+        if (m_drain) {
+            LockGuard lock;
+            m_drain(m_drain_obj);
+        }
+        uint32_t next = tick();
+        arm_timer(next);
+
+        epoll_event events[MAX_WATCHES + 2];
+        int n = epoll_wait(m_epoll, events, static_cast<int>(MAX_WATCHES + 2), max_wait_ms);
+        LockGuard lock;    // indev reads and fd callbacks touch LVGL (threaded builds)
+        for (int i = 0; i < n; ++i) {
+            dispatch(events[i]);
+        }
+        return next;
+    }
+
+    /// Run until quit() is called
+    void run() noexcept {
+        m_quit = false;
+        while (!m_quit) {
+            run_once();
+        }
+    }
+
+    /**
+     * @brief Run with a custom per-iteration callback
+     *
+     * @param on_tick Called every iteration. Return false to exit.
+     */
+    template<typename F>
+    void run_with(F&& on_tick) {
+        m_quit = false;
+        while (!m_quit && on_tick()) {
+            run_once();
+        }
+    }
+
+private:
+    bool add_watch(int fd, fd_cb cb, void* user_data, lv_indev_t* indev) noexcept {
+        if (fd < 0 || m_epoll < 0 || m_count >= MAX_WATCHES) return false;
+        for (size_t i = 0; i < MAX_WATCHES; ++i) {
+            if (m_watches[i].fd >= 0) continue;
+            if (!add_fd(fd, i)) return false;
+            m_watches[i] = Watch{fd, cb, user_data, indev};
+            ++m_count;
+            return true;
+        }
+        return false;
+    }
+};
+
+} // namespace lv
+
+#endif // __linux__
@@ -0,0 +1,278 @@
+#pragma once
+
+/**
+ * @file event_stats.hpp
+ * @brief Opt-in event handler latency tracking (per widget, event code and handler)
+ *
+ * With LV_CPP_USE_EVENT_STATS=1 (CMake -DLV_CPP_USE_EVENT_STATS=ON) every
+ * handler registered through on()/on<>() is timed by its trampoline. Each
+ * call lands in a global log2 histogram and in a bounded table keyed by
+ * (object, event code, handler) that keeps the LV_CPP_EVENT_STATS_ENTRIES
+ * slowest keys: when the table is full, a new key only gets in by beating
+ * the fastest worst case currently held.
+ *
+ * Off (the default), LV_CPP_EVENT_STATS_SCOPE expands to nothing: the
+ * trampolines compile to the bare call and Event/Object stay pointer-sized
+ * (see verify.hpp). Raw lv_obj_add_event_cb() handlers are not timed.
+ *
+ * Usage:
+ * @code
+ * // from a debug key or a periodic timer
+ * lv::event_stats::log(5);
+ *
+ * lv::event_stats::HandlerStat top[5];
+ * uint32_t n = lv::event_stats::slowest(top, 5);
+ * uint32_t p99 = lv::event_stats::histogram().percentile_us(99);
+ * @endcode
+ *
+ * Single-threaded: record and query from the LVGL thread.
+ * Heap allocation: NONE (fixed table and histogram)
+ */
+
+#include <lvgl.h>
+#include <cstdint>
+#include "profiler.hpp"  // LV_CPP_PROFILE_FUNC_NAME
+
+#ifndef LV_CPP_USE_EVENT_STATS
+#define LV_CPP_USE_EVENT_STATS 0
+#endif
+
+#ifndef LV_CPP_EVENT_STATS_ENTRIES
+/// Distinct (object, code, handler) keys kept, slowest first
+#define LV_CPP_EVENT_STATS_ENTRIES 32
+#endif
+
+#ifndef LV_CPP_EVENT_STATS_NAME
+/// Bytes of the object name copied into an entry (LV_USE_OBJ_NAME)
+#define LV_CPP_EVENT_STATS_NAME 24
+#endif
+
+#if LV_CPP_USE_EVENT_STATS
+
+#include <chrono>
+
+namespace lv::event_stats {
+
+/// Histogram bucket count: bucket 0 is < 1 us, bucket i is [2^(i-1), 2^i) us, the last is open-ended
+inline constexpr uint32_t kBuckets = 22;
+
+/// Accumulated timings of one (object, event code, handler) key
+struct HandlerStat {
+    lv_obj_t* obj;          ///< Identity only; may be deleted by now
+    lv_event_code_t code;
+    const char* handler;    ///< Trampoline signature, names the handler
+    char name[LV_CPP_EVENT_STATS_NAME];  ///< Object name when registered ("" if none)
+    uint32_t calls;
+    uint32_t max_us;
+    uint64_t total_us;
+
+    [[nodiscard]] uint32_t avg_us() const noexcept {
+        return calls ? static_cast<uint32_t>(total_us / calls) : 0;
+    }
+};
+
+/// Duration distribution over all timed handler calls
+struct Histogram {
+    uint32_t buckets[kBuckets];
+    uint32_t count;
+
+    /// Lower bound of bucket `i` in microseconds
+    [[nodiscard]] static constexpr uint32_t floor_us(uint32_t i) noexcept {
+        return i == 0 ? 0 : 1u << (i - 1);
+    }
+
+    /// Upper bound (exclusive) of the bucket holding the p-th percentile
+    [[nodiscard]] uint32_t percentile_us(uint32_t p) const noexcept {
+        if (count == 0) return 0;
+        const uint64_t want = (static_cast<uint64_t>(count) * p + 99) / 100;
+        uint64_t seen = 0;
+        for (uint32_t i = 0; i < kBuckets; ++i) {
+            seen += buckets[i];
+            if (seen >= want && seen) return i + 1 < kBuckets ? floor_us(i + 1) : UINT32_MAX;
+        }
+        return UINT32_MAX;
+    }
+};
+
+namespace detail {
+
+struct Table {
+    HandlerStat entries[LV_CPP_EVENT_STATS_ENTRIES];
+    uint32_t used = 0;
+    uint32_t evicted = 0;  ///< Keys pushed out (or refused) by slower ones
+    Histogram histogram{};
+    bool enabled = true;
+};
+
+[[nodiscard]] inline Table& table() noexcept {
+    static Table t;
+    return t;
+}
+
+[[nodiscard]] inline uint64_t now_us() noexcept {
+    using namespace std::chrono;
+    return static_cast<uint64_t>(duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+[[nodiscard]] inline uint32_t bucket_of(uint32_t us) noexcept {
+    uint32_t i = 0;
+    while (us && i + 1 < kBuckets) { us >>= 1; ++i; }
+    return i;
+}
+
+inline void copy_name(HandlerStat& s, lv_obj_t* obj) noexcept {
+    s.name[0] = '\0';
+#if LV_USE_OBJ_NAME
+    // The handler may have deleted its object; only dereference live ones
+    if (!lv_obj_is_valid(obj)) return;
+    const char* n = lv_obj_get_name(obj);
+    if (!n) return;
+    uint32_t i = 0;
+    for (; n[i] && i + 1 < LV_CPP_EVENT_STATS_NAME; ++i) s.name[i] = n[i];
+    s.name[i] = '\0';
+#else
+    (void)obj;
+#endif
+}
+
+inline void record(lv_obj_t* obj, lv_event_code_t code, const char* handler, uint32_t us) noexcept {
+    Table& t = table();
+    Histogram& h = t.histogram;
+    ++h.buckets[bucket_of(us)];
+    ++h.count;
+
+    HandlerStat* slot = nullptr;
+    for (uint32_t i = 0; i < t.used; ++i) {
+        HandlerStat& s = t.entries[i];
+        if (s.obj == obj && s.code == code && s.handler == handler) { slot = &s; break; }
+    }
+    if (!slot) {
+        if (t.used < LV_CPP_EVENT_STATS_ENTRIES) {
+            slot = &t.entries[t.used++];
+        } else {
+            HandlerStat* fastest = &t.entries[0];
+            for (uint32_t i = 1; i < t.used; ++i) {
+                if (t.entries[i].max_us < fastest->max_us) fastest = &t.entries[i];
+            }
+            ++t.evicted;
+            if (us <= fastest->max_us) return;
+            slot = fastest;
+        }
+        *slot = HandlerStat{obj, code, handler, {}, 0, 0, 0};
+        copy_name(*slot, obj);
+    }
+    ++slot->calls;
+    slot->total_us += us;
+    if (us > slot->max_us) slot->max_us = us;
+}
+
+} // namespace detail
+
+/**
+ * @brief RAII timer placed in the event trampolines by LV_CPP_EVENT_STATS_SCOPE
+ *
+ * Captures the key before the handler runs, so handlers that delete their
+ * own object are still attributed.
+ */
+class Scope {
+    lv_obj_t* m_obj;
+    const char* m_handler;
+    uint64_t m_start;
+    lv_event_code_t m_code;
+
+public:
+    Scope(lv_event_t* e, const char* handler) noexcept
+        : m_obj(lv_event_get_current_target_obj(e))
+        , m_handler(handler)
+        , m_start(detail::now_us())
+        , m_code(lv_event_get_code(e)) {}
+
+    ~Scope() {
+        if (!detail::table().enabled) return;
+        const uint64_t us = detail::now_us() - m_start;
+        detail::record(m_obj, m_code, m_handler, us > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(us));
+    }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+};
+
+/// Pause or resume recording
+inline void enable(bool on) noexcept { detail::table().enabled = on; }
+
+[[nodiscard]] inline bool enabled() noexcept { return detail::table().enabled; }
+
+/// Keys currently held in the table
+[[nodiscard]] inline uint32_t size() noexcept { return detail::table().used; }
+
+/// Keys that did not fit (pushed out or too fast to enter a full table)
+[[nodiscard]] inline uint32_t evicted() noexcept { return detail::table().evicted; }
+
+[[nodiscard]] inline const Histogram& histogram() noexcept { return detail::table().histogram; }
+
+/**
+ * @brief Copy up to `max` entries into `out`, slowest worst case first
+ * @return Number of entries written
+ */
+inline uint32_t slowest(HandlerStat* out, uint32_t max) noexcept {
+    const detail::Table& t = detail::table();
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < t.used; ++i) {
+        // Insertion into the bounded output, descending by max_us
+        const HandlerStat& s = t.entries[i];
+        uint32_t pos = n;
+        while (pos > 0 && out[pos - 1].max_us < s.max_us) {
+            if (pos < max) out[pos] = out[pos - 1];
+            --pos;
+        }
+        if (pos < max) out[pos] = s;
+        if (n < max) ++n;
+    }
+    return n;
+}
+
+/// Visit all entries in table order
+template<typename F>
+void for_each(F&& fn) {
+    const detail::Table& t = detail::table();
+    for (uint32_t i = 0; i < t.used; ++i) fn(t.entries[i]);
+}
+
+inline void reset() noexcept {
+    detail::Table& t = detail::table();
+    t.used = 0;
+    t.evicted = 0;
+    t.histogram = Histogram{};
+}
+
+/// LV_LOG_USER the `count` slowest handlers and the p50/p99 of all calls
+inline void log(uint32_t count = 10) noexcept {
+    const Histogram& h = histogram();
+    LV_LOG_USER("event handlers: %u calls, p50 < %u us, p99 < %u us, %u keys evicted",
+                static_cast<unsigned>(h.count), static_cast<unsigned>(h.percentile_us(50)),
+                static_cast<unsigned>(h.percentile_us(99)), static_cast<unsigned>(evicted()));
+    HandlerStat top[8];
+    if (count > 8) count = 8;
+    const uint32_t n = slowest(top, count);
+    for (uint32_t i = 0; i < n; ++i) {
+        const HandlerStat& s = top[i];
+        LV_LOG_USER("  max %u us avg %u us x%u  obj %p '%s' code %d  %s",
+                    static_cast<unsigned>(s.max_us), static_cast<unsigned>(s.avg_us()),
+                    static_cast<unsigned>(s.calls), static_cast<void*>(s.obj), s.name,
+                    static_cast<int>(s.code), s.handler);
+        (void)s;
+    }
+    (void)h;
+}
+
+} // namespace lv::event_stats
+
+/// Time the enclosing event trampoline; `e` is its lv_event_t*
+#define LV_CPP_EVENT_STATS_SCOPE(e) \
+    ::lv::event_stats::Scope lv_event_stats_scope_((e), LV_CPP_PROFILE_FUNC_NAME)
+
+#else // !LV_CPP_USE_EVENT_STATS
+
+#define LV_CPP_EVENT_STATS_SCOPE(e) ((void)(e))
+
+#endif // LV_CPP_USE_EVENT_STATS
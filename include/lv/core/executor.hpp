@@ -0,0 +1,603 @@
+#pragma once
+
+/**
+ * @file executor.hpp
+ * @brief Work-stealing worker pool with completions on the UI thread
+ *
+ * JSON parsing, image decoding and network calls must not run on the UI
+ * thread, and each team ends up writing its own thread and its own way of
+ * getting the result back. lv::executor() is a fixed pool of
+ * LV_CPP_EXECUTOR_THREADS workers. A job's result is delivered through
+ * lv::post(), and the member function given as template argument runs on
+ * the UI thread from lv::tick():
+ *
+ * @code
+ * class Weather : public lv::Component<Weather> {
+ *     void on_forecast(Forecast& f) { ... }             // UI thread
+ * public:
+ *     void on_mount() {
+ *         lv::executor().submit([city = m_city] { return fetch_forecast(city); })
+ *             .then_on_ui<&Weather::on_forecast>(this);
+ *     }
+ * };
+ *
+ * // Long jobs can poll for cancellation
+ * lv::executor().submit([](const lv::CancelToken& tok) {
+ *     for (auto& tile : tiles) { if (tok) return; decode(tile); }
+ * }).detach();
+ * @endcode
+ *
+ * Each worker has its own queue. submit() hands jobs out round robin and
+ * wakes the target worker, plus an idle one if the target is busy. A
+ * worker takes its newest job first. When its queue is empty, it steals the
+ * oldest job from another worker's queue. The callable and its result share
+ * one inline buffer of LV_CPP_EXECUTOR_JOB_BYTES in a fixed job table.
+ * Results are destroyed on the UI thread after the callback.
+ *
+ * Cancellation: jobs continued on a mounted Component are tied to its root
+ * the same way fs::read_async() is. When the root is deleted, queued jobs
+ * are dropped, running ones see their CancelToken set, and no callback
+ * runs. The owner is looked up again from the root at delivery, so a
+ * moved component is called at its new address. Other owners call
+ * cancel_for(this) in their destructor, or cancel(id). A callable must not
+ * use its owner on the worker: capture the inputs by value.
+ *
+ * Without an OS, an LVGL timer runs one job per tick on the UI thread.
+ *
+ * Heap allocation: NONE in the wrapper (fixed job table, inline callables
+ * and results; LVGL allocates the worker threads once)
+ */
+
+#include <lvgl.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "async.hpp"
+#include "object.hpp"
+#include "version.hpp"
+
+#ifndef LV_CPP_EXECUTOR_THREADS
+/// Worker threads of lv::executor()
+#define LV_CPP_EXECUTOR_THREADS 2
+#endif
+
+#ifndef LV_CPP_EXECUTOR_JOBS
+/// Jobs queued, running or awaiting delivery at once
+#define LV_CPP_EXECUTOR_JOBS 32
+#endif
+
+#ifndef LV_CPP_EXECUTOR_JOB_BYTES
+/// Inline storage of one job's callable and, after it ran, its result
+#define LV_CPP_EXECUTOR_JOB_BYTES 64
+#endif
+
+#ifndef LV_CPP_EXECUTOR_STACK
+/// Stack of each worker thread in bytes
+#define LV_CPP_EXECUTOR_STACK (16 * 1024)
+#endif
+
+namespace lv {
+
+/// Set once the job's owner is gone or the job was cancelled; long jobs poll it
+class CancelToken {
+    const std::atomic<bool>* m_flag;
+
+public:
+    explicit CancelToken(const std::atomic<bool>& flag) noexcept : m_flag(&flag) {}
+
+    [[nodiscard]] bool cancelled() const noexcept { return m_flag->load(std::memory_order_relaxed); }
+
+    explicit operator bool() const noexcept { return cancelled(); }
+};
+
+struct ExecutorStats {
+    uint32_t submitted;
+    uint32_t completed;    ///< Delivered to a callback (or finished without one)
+    uint32_t cancelled;
+    uint32_t stolen;       ///< Jobs a worker took from another worker's queue
+    uint32_t refused;      ///< Job table full
+};
+
+namespace detail::exec {
+
+enum class JobState : uint8_t { free, reserved, queued, running, done };
+
+struct Job;
+using job_fn = void (*)(Job& j);
+
+struct Job {
+    alignas(std::max_align_t) unsigned char storage[LV_CPP_EXECUTOR_JOB_BYTES];
+    job_fn run = nullptr;           ///< Invoke the callable and store the result in its place
+    job_fn drop = nullptr;          ///< Destroy the callable or the result
+    void (*complete)(Job& j) = nullptr;
+    void* owner = nullptr;
+    lv_obj_t* guard = nullptr;      ///< Deleting it cancels the job
+    uint32_t id = 0;
+    JobState state = JobState::free;
+    bool has_result = false;        ///< storage holds the result, not the callable
+    std::atomic<bool> cancelled{false};
+};
+
+/// One worker's queue: the owner pops the newest job, thieves take the oldest
+struct Worker {
+    uint16_t ring[LV_CPP_EXECUTOR_JOBS];
+    uint32_t head = 0;              ///< Oldest
+    uint32_t tail = 0;              ///< One past the newest
+    lv_mutex_t lock;
+    std::atomic<bool> idle{false};
+#if LV_USE_OS != LV_OS_NONE
+    lv_thread_t thread;
+    lv_thread_sync_t wake;
+#endif
+};
+
+struct Pool {
+    Job jobs[LV_CPP_EXECUTOR_JOBS];
+    Worker workers[LV_CPP_EXECUTOR_THREADS];
+    lv_mutex_t lock;                ///< Job states and stats
+    uint32_t next_id = 1;
+    uint32_t next_worker = 0;
+    ExecutorStats stats{};
+    std::atomic<bool> delivery_queued{false};
+#if LV_USE_OS != LV_OS_NONE
+    bool running = false;
+    std::atomic<bool> stopping{false};
+#else
+    lv_timer_t* timer = nullptr;
+#endif
+
+    Pool() noexcept {
+        lv_mutex_init(&lock);
+        for (Worker& w : workers) lv_mutex_init(&w.lock);
+    }
+};
+
+[[nodiscard]] inline Pool& pool() noexcept {
+    static Pool instance;
+    return instance;
+}
+
+struct Lock {
+    lv_mutex_t& m;
+    explicit Lock(lv_mutex_t& mutex) noexcept : m(mutex) { lv_mutex_lock(&m); }
+    ~Lock() { lv_mutex_unlock(&m); }
+    Lock(const Lock&) = delete;
+    Lock& operator=(const Lock&) = delete;
+};
+
+[[nodiscard]] inline uint16_t index_of(const Pool& p, const Job& j) noexcept {
+    return static_cast<uint16_t>(&j - p.jobs);
+}
+
+inline void push(Worker& w, uint16_t job) noexcept {
+    Lock lock(w.lock);
+    w.ring[w.tail++ % LV_CPP_EXECUTOR_JOBS] = job;
+}
+
+/// Newest job of the worker's own queue, or -1
+[[nodiscard]] inline int32_t pop(Worker& w) noexcept {
+    Lock lock(w.lock);
+    if (w.head == w.tail) return -1;
+    return w.ring[--w.tail % LV_CPP_EXECUTOR_JOBS];
+}
+
+/// Oldest job of another worker's queue, or -1
+[[nodiscard]] inline int32_t steal(Worker& w) noexcept {
+    Lock lock(w.lock);
+    if (w.head == w.tail) return -1;
+    return w.ring[w.head++ % LV_CPP_EXECUTOR_JOBS];
+}
+
+/// Mark a dequeued job running; false if it was cancelled while queued (the slot is freed)
+[[nodiscard]] inline bool start(Pool& p, Job& j) noexcept {
+    Lock lock(p.lock);
+    if (j.state != JobState::queued) {
+        j.state = JobState::free;
+        return false;
+    }
+    j.state = JobState::running;
+    return true;
+}
+
+inline void guard_delete_cb(lv_event_t* e);
+
+/// Stop watching `guard` unless a live job other than `leaving` uses it (UI thread, lock held)
+inline void unwatch(Pool& p, lv_obj_t* guard, const Job* leaving = nullptr) noexcept {
+    if (!guard) return;
+    for (const Job& j : p.jobs) {
+        if (&j != leaving && j.state != JobState::free && j.guard == guard) return;
+    }
+    lv_obj_remove_event_cb_with_user_data(guard, &guard_delete_cb, nullptr);
+}
+
+/// Run callbacks of finished jobs (UI thread)
+inline void deliver() {
+    Pool& p = pool();
+    p.delivery_queued.store(false, std::memory_order_release);
+    for (Job& j : p.jobs) {
+        {
+            Lock lock(p.lock);
+            if (j.state != JobState::done) continue;
+            unwatch(p, j.guard, &j);
+        }
+        // Done jobs belong to the UI thread: workers no longer touch them
+        if (!j.cancelled.load(std::memory_order_acquire) && j.complete) j.complete(j);
+        j.drop(j);
+        Lock lock(p.lock);
+        if (j.cancelled.load(std::memory_order_relaxed)) ++p.stats.cancelled;
+        else ++p.stats.completed;
+        j.state = JobState::free;
+    }
+}
+
+/// Hand finished jobs to the UI thread (worker)
+inline void request_delivery(Pool& p) noexcept {
+    if (p.delivery_queued.exchange(true, std::memory_order_acq_rel)) return;
+    if (lv::post([]() noexcept { deliver(); })) return;
+    // Post queue full: fall back to an LVGL async call under the LVGL lock
+    lv_lock();
+    lv_async_call([](void*) { deliver(); }, nullptr);
+    lv_unlock();
+}
+
+inline void execute(Pool& p, Job& j) {
+    j.run(j);
+    Lock lock(p.lock);
+    j.state = JobState::done;
+}
+
+#if LV_USE_OS != LV_OS_NONE
+inline void worker_main(void* arg) {
+    Pool& p = pool();
+    const auto self = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(arg));
+    Worker& w = p.workers[self];
+    while (!p.stopping.load(std::memory_order_acquire)) {
+        int32_t idx = pop(w);
+        for (uint32_t k = 1; idx < 0 && k < LV_CPP_EXECUTOR_THREADS; ++k) {
+            idx = steal(p.workers[(self + k) % LV_CPP_EXECUTOR_THREADS]);
+            if (idx >= 0) {
+                Lock lock(p.lock);
+                ++p.stats.stolen;
+            }
+        }
+        if (idx < 0) {
+            w.idle.store(true, std::memory_order_release);
+            lv_thread_sync_wait(&w.wake);
+            w.idle.store(false, std::memory_order_release);
+            continue;
+        }
+        Job& j = p.jobs[idx];
+        if (!start(p, j)) continue;
+        execute(p, j);
+        request_delivery(p);
+    }
+}
+
+inline void start_workers(Pool& p) noexcept {
+    if (p.running) return;
+    p.stopping.store(false, std::memory_order_relaxed);
+    for (uint32_t i = 0; i < LV_CPP_EXECUTOR_THREADS; ++i) {
+        Worker& w = p.workers[i];
+        lv_thread_sync_init(&w.wake);
+        void* arg = reinterpret_cast<void*>(static_cast<uintptr_t>(i));
+#if LV_VERSION_AT_LEAST(9, 3, 0)
+        const lv_result_t res = lv_thread_init(&w.thread, "lv_exec", LV_THREAD_PRIO_MID, &worker_main,
+                                               LV_CPP_EXECUTOR_STACK, arg);
+#else
+        const lv_result_t res = lv_thread_init(&w.thread, LV_THREAD_PRIO_MID, &worker_main,
+                                               LV_CPP_EXECUTOR_STACK, arg);
+#endif
+        if (res != LV_RESULT_OK) LV_LOG_WARN("executor: cannot start worker %u", static_cast<unsigned>(i));
+    }
+    p.running = true;
+}
+
+/// Wake the target worker, and an idle one to steal if the target is busy
+inline void wake(Pool& p, uint32_t target) noexcept {
+    lv_thread_sync_signal(&p.workers[target].wake);
+    if (p.workers[target].idle.load(std::memory_order_acquire)) return;
+    for (Worker& w : p.workers) {
+        if (w.idle.load(std::memory_order_acquire)) {
+            lv_thread_sync_signal(&w.wake);
+            return;
+        }
+    }
+}
+#else
+inline void poll_cb(lv_timer_t* t) {
+    Pool& p = pool();
+    const int32_t idx = steal(p.workers[0]);
+    if (idx < 0) {
+        lv_timer_pause(t);
+        return;
+    }
+    Job& j = p.jobs[idx];
+    if (!start(p, j)) return;
+    execute(p, j);
+    deliver();
+}
+#endif
+
+/// Reserve a slot for a callable of type F (UI thread); nullptr when the table is full
+template<typename F>
+[[nodiscard]] Job* reserve(F&& fn) noexcept {
+    using Fn = std::decay_t<F>;
+    constexpr bool takes_token = std::is_invocable_v<Fn&, const CancelToken&>;
+    using R = typename std::conditional_t<takes_token, std::invoke_result<Fn&, const CancelToken&>,
+                                          std::invoke_result<Fn&>>::type;
+    static_assert(sizeof(Fn) <= LV_CPP_EXECUTOR_JOB_BYTES && alignof(Fn) <= alignof(std::max_align_t),
+                  "executor: callable too large, raise LV_CPP_EXECUTOR_JOB_BYTES");
+    if constexpr (!std::is_void_v<R>) {
+        static_assert(sizeof(R) <= LV_CPP_EXECUTOR_JOB_BYTES && alignof(R) <= alignof(std::max_align_t),
+                      "executor: result too large, raise LV_CPP_EXECUTOR_JOB_BYTES");
+        static_assert(std::is_move_constructible_v<R>, "executor: result must be movable");
+    }
+
+    Pool& p = pool();
+    Job* j = nullptr;
+    {
+        Lock lock(p.lock);
+        for (Job& c : p.jobs) {
+            if (c.state == JobState::free) {
+                j = &c;
+                break;
+            }
+        }
+        if (!j) {
+            ++p.stats.refused;
+            LV_LOG_WARN("executor: job table full, raise LV_CPP_EXECUTOR_JOBS");
+            return nullptr;
+        }
+        j->state = JobState::reserved;
+        j->id = p.next_id++;
+        if (p.next_id == 0) p.next_id = 1;
+    }
+    ::new (static_cast<void*>(j->storage)) Fn(std::forward<F>(fn));
+    j->has_result = false;
+    j->cancelled.store(false, std::memory_order_relaxed);
+    j->complete = nullptr;
+    j->owner = nullptr;
+    j->guard = nullptr;
+    j->run = [](Job& job) {
+        Fn* stored = std::launder(reinterpret_cast<Fn*>(job.storage));
+        Fn f(std::move(*stored));
+        stored->~Fn();
+        const CancelToken token(job.cancelled);
+        auto call = [&]() -> decltype(auto) {
+            if constexpr (takes_token) return f(token);
+            else return f();
+        };
+        if constexpr (std::is_void_v<R>) {
+            call();
+        } else {
+            ::new (static_cast<void*>(job.storage)) R(call());
+        }
+        job.has_result = true;
+    };
+    j->drop = [](Job& job) {
+        if (!job.has_result) {
+            std::launder(reinterpret_cast<Fn*>(job.storage))->~Fn();
+        } else if constexpr (!std::is_void_v<R>) {
+            std::launder(reinterpret_cast<R*>(job.storage))->~R();
+        }
+        job.has_result = false;
+    };
+    return j;
+}
+
+/// Queue a reserved job on the next worker (UI thread)
+inline void queue(Job& j) noexcept {
+    Pool& p = pool();
+    uint32_t target;
+    {
+        Lock lock(p.lock);
+        j.state = JobState::queued;
+        ++p.stats.submitted;
+        target = p.next_worker++ % LV_CPP_EXECUTOR_THREADS;
+        if (j.guard) {
+            bool watched = false;
+            for (const Job& c : p.jobs) watched = watched || (&c != &j && c.state != JobState::free && c.guard == j.guard);
+            if (!watched) lv_obj_add_event_cb(j.guard, &guard_delete_cb, LV_EVENT_DELETE, nullptr);
+        }
+    }
+#if LV_USE_OS != LV_OS_NONE
+    push(p.workers[target], index_of(p, j));
+    start_workers(p);
+    wake(p, target);
+#else
+    (void)target;
+    push(p.workers[0], index_of(p, j));
+    if (!p.timer) p.timer = lv_timer_create(&poll_cb, 0, nullptr);
+    else lv_timer_resume(p.timer);
+#endif
+}
+
+/// Cancel `j` (UI thread, lock held): queued jobs are dropped now, others when delivered
+inline void cancel_job(Pool& p, Job& j) noexcept {
+    j.cancelled.store(true, std::memory_order_release);
+    j.guard = nullptr;
+    if (j.state == JobState::queued) {
+        j.drop(j);
+        j.state = JobState::reserved;    // still in a worker queue; the worker frees the slot
+        ++p.stats.cancelled;
+    }
+}
+
+inline void guard_delete_cb(lv_event_t* e) {
+    auto* guard = static_cast<lv_obj_t*>(lv_event_get_current_target(e));
+    Pool& p = pool();
+    Lock lock(p.lock);
+    for (Job& j : p.jobs) {
+        if (j.state != JobState::free && j.guard == guard) cancel_job(p, j);
+    }
+}
+
+/// Root object of a mounted component, nullptr for other owners
+template<typename T>
+[[nodiscard]] lv_obj_t* guard_of(T* owner) noexcept {
+    if constexpr (requires { owner->root().get(); T::from_obj(owner->root()); }) {
+        return owner->root().get();
+    } else {
+        return nullptr;
+    }
+}
+
+template<auto MemFn, typename T, typename R>
+void complete(Job& j) {
+    auto* self = static_cast<T*>(j.owner);
+    if constexpr (requires { T::from_obj(ObjectView(j.guard)); }) {
+        if (j.guard) self = T::from_obj(ObjectView(j.guard));   // follows a moved component
+        if (!self) return;
+    }
+    if constexpr (std::is_void_v<R>) {
+        (self->*MemFn)();
+    } else {
+        (self->*MemFn)(*std::launder(reinterpret_cast<R*>(j.storage)));
+    }
+}
+
+} // namespace detail::exec
+
+/**
+ * @brief A submitted job waiting for its continuation
+ *
+ * Queued by then_on_ui() or detach(), or when it goes out of scope.
+ * @tparam R Result of the callable (void allowed)
+ */
+template<typename R>
+class Submitted {
+    detail::exec::Job* m_job;
+
+public:
+    explicit Submitted(detail::exec::Job* job) noexcept : m_job(job) {}
+
+    Submitted(const Submitted&) = delete;
+    Submitted& operator=(const Submitted&) = delete;
+
+    Submitted(Submitted&& other) noexcept : m_job(std::exchange(other.m_job, nullptr)) {}
+    Submitted& operator=(Submitted&&) = delete;
+
+    ~Submitted() { detach(); }
+
+    /**
+     * @brief Run `(owner->*MemFn)(R&)` (or `()` for void) on the UI thread with the result
+     * @return Job id for Executor::cancel(), 0 if the job table was full
+     */
+    template<auto MemFn, typename T>
+        requires std::is_member_function_pointer_v<decltype(MemFn)>
+    uint32_t then_on_ui(T* owner) noexcept {
+        if (!m_job) return 0;
+        m_job->owner = owner;
+        m_job->guard = detail::exec::guard_of(owner);
+        m_job->complete = &detail::exec::complete<MemFn, T, R>;
+        return detach();
+    }
+
+    /// Queue without a continuation; the result is dropped on the UI thread
+    uint32_t detach() noexcept {
+        detail::exec::Job* j = std::exchange(m_job, nullptr);
+        if (!j) return 0;
+        detail::exec::queue(*j);
+        return j->id;
+    }
+
+    /// False if the job table was full
+    [[nodiscard]] bool valid() const noexcept { return m_job != nullptr; }
+};
+
+/**
+ * @brief Fixed pool of worker threads (see executor.hpp); use lv::executor()
+ */
+class Executor {
+public:
+    /**
+     * @brief Run `fn()` or `fn(const CancelToken&)` on a worker
+     *
+     * Call from the UI thread. The job is queued by the returned handle.
+     */
+    template<typename F>
+    auto submit(F&& fn) noexcept {
+        using Fn = std::decay_t<F>;
+        using R = typename std::conditional_t<std::is_invocable_v<Fn&, const CancelToken&>,
+                                              std::invoke_result<Fn&, const CancelToken&>,
+                                              std::invoke_result<Fn&>>::type;
+        return Submitted<R>(detail::exec::reserve(std::forward<F>(fn)));
+    }
+
+    /// Drop job `id`: no callback runs; a running job sees its CancelToken set
+    void cancel(uint32_t id) noexcept {
+        detail::exec::Pool& p = detail::exec::pool();
+        detail::exec::Lock lock(p.lock);
+        for (detail::exec::Job& j : p.jobs) {
+            if (id == 0 || j.id != id || j.state == detail::exec::JobState::free) continue;
+            lv_obj_t* guard = j.guard;
+            detail::exec::cancel_job(p, j);
+            detail::exec::unwatch(p, guard);
+            return;
+        }
+    }
+
+    /// Cancel every job continued on `owner` (call from a non-component owner's destructor)
+    void cancel_for(const void* owner) noexcept {
+        detail::exec::Pool& p = detail::exec::pool();
+        detail::exec::Lock lock(p.lock);
+        for (detail::exec::Job& j : p.jobs) {
+            if (j.state == detail::exec::JobState::free || j.owner != owner) continue;
+            lv_obj_t* guard = j.guard;
+            detail::exec::cancel_job(p, j);
+            detail::exec::unwatch(p, guard);
+        }
+    }
+
+    /// Jobs queued, running or awaiting delivery
+    [[nodiscard]] uint32_t pending() const noexcept {
+        detail::exec::Pool& p = detail::exec::pool();
+        detail::exec::Lock lock(p.lock);
+        uint32_t n = 0;
+        for (const detail::exec::Job& j : p.jobs) n += j.state != detail::exec::JobState::free;
+        return n;
+    }
+
+    [[nodiscard]] ExecutorStats stats() const noexcept {
+        detail::exec::Pool& p = detail::exec::pool();
+        detail::exec::Lock lock(p.lock);
+        return p.stats;
+    }
+
+    void reset_stats() noexcept {
+        detail::exec::Pool& p = detail::exec::pool();
+        detail::exec::Lock lock(p.lock);
+        p.stats = {};
+    }
+
+    /**
+     * @brief Stop the workers after their current jobs (queued jobs wait for the next submit())
+     *
+     * Call from the UI thread outside lv_timer_handler() (a finishing job may need the LVGL lock).
+     */
+    void shutdown() noexcept {
+#if LV_USE_OS != LV_OS_NONE
+        detail::exec::Pool& p = detail::exec::pool();
+        if (!p.running) return;
+        p.stopping.store(true, std::memory_order_release);
+        for (detail::exec::Worker& w : p.workers) lv_thread_sync_signal(&w.wake);
+        for (detail::exec::Worker& w : p.workers) {
+            lv_thread_delete(&w.thread);
+            lv_thread_sync_delete(&w.wake);
+        }
+        p.running = false;
+#endif
+    }
+};
+
+/// The process-wide worker pool
+[[nodiscard]] inline Executor& executor() noexcept {
+    static Executor instance;
+    return instance;
+}
+
+} // namespace lv
@@ -3,14 +3,81 @@
 /**
  * @file focus.hpp
  * @brief Zero-cost wrapper for LVGL focus groups (keyboard/encoder navigation)
+ *
+ * focus_next() steps over every hidden member. add_range() adds a
+ * container's children in one call, and set_hidden() takes an object out
+ * of the group while it is hidden, so keypad traversal only visits objects
+ * that can take focus. Both use lv_group_add_obj(), which scans the group
+ * for duplicates (O(n^2) for n rows); group_list.hpp (opt-in) links them
+ * in O(n) and keeps the child order when a row is shown again.
+ * For long lists, VirtualList::focus_group() keeps the list a single
+ * focus stop and moves the focus over items instead of row objects.
+ * With state_update.hpp installed, members added afterwards change
+ * FOCUSED, FOCUS_KEY and EDITED in one style update (lv::set_states())
+ * when they receive the focus. focus_by(n) lands where n focus_next()
+ * calls would, with a single focus change.
  */
 
 #include <lvgl.h>
 #include "object.hpp"
+#include "state_batch.hpp"
 #include "version.hpp"
 
 namespace lv {
 
+namespace detail {
+
+/// Not hidden itself nor through a parent (lv_group_focus_next() skips the others)
+[[nodiscard]] inline bool focus_visible(lv_obj_t* obj) noexcept {
+    for (; obj; obj = lv_obj_get_parent(obj)) {
+        if (lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief The member `n` focus_next() calls would end on (focus_prev() for n < 0)
+ *
+ * Follows the group's wrap setting; returns the focused member if no
+ * visible one lies that way, nullptr for an empty group. Members are read
+ * with lv_group_get_obj_by_index(), which walks the group's list from its
+ * head, so a step costs O(members) per visited member.
+ */
+[[nodiscard]] inline lv_obj_t* group_step(lv_group_t* group, int32_t n) noexcept {
+    const uint32_t count = lv_group_get_obj_count(group);
+    if (count == 0) return nullptr;
+    // Members by index (public API): count stands for "no focus yet"
+    lv_obj_t* focused = lv_group_get_focused(group);
+    uint32_t pos = count;
+    for (uint32_t i = 0; focused && i < count; ++i) {
+        if (lv_group_get_obj_by_index(group, i) == focused) {
+            pos = i;
+            break;
+        }
+    }
+    const bool forward = n >= 0;
+    const bool wrap = lv_group_get_wrap(group);
+    uint32_t at = pos;
+    uint32_t left = forward ? static_cast<uint32_t>(n) : 0u - static_cast<uint32_t>(n);
+    for (uint32_t seen = 0; left > 0 && seen <= count; ++seen) {
+        if (pos == count) {
+            pos = forward ? 0 : count - 1;
+        } else if (forward ? pos + 1 < count : pos > 0) {
+            pos = forward ? pos + 1 : pos - 1;
+        } else {
+            if (!wrap) break;
+            pos = forward ? 0 : count - 1;
+        }
+        if (!focus_visible(lv_group_get_obj_by_index(group, pos))) continue;
+        at = pos;
+        seen = 0;
+        --left;
+    }
+    return at < count ? lv_group_get_obj_by_index(group, at) : nullptr;
+}
+
+} // namespace detail
+
 /**
  * @brief Owning wrapper for lv_group_t (focus group)
  *
@@ -63,10 +130,54 @@ public:
 
     /// Add object to the group
     Group& add(ObjectView obj) noexcept {
+        detail::batch_focus_states(obj);
         lv_group_add_obj(m_group, obj);
         return *this;
     }
 
+    /**
+     * @brief Add the visible children of `parent` for which `filter(ObjectView)` is true, in child order
+     *
+     * Children already in this group stay where they are.
+     * group_list::add_range() does the same without lv_group_add_obj()'s
+     * duplicate scan.
+     */
+    template<typename F>
+    Group& add_range(ObjectView parent, F&& filter) {
+        if (!parent) return *this;
+        const uint32_t n = lv_obj_get_child_count(parent.get());
+        for (uint32_t i = 0; i < n; ++i) {
+            lv_obj_t* c = lv_obj_get_child(parent.get(), static_cast<int32_t>(i));
+            if (lv_obj_get_group(c) == m_group || lv_obj_has_flag(c, LV_OBJ_FLAG_HIDDEN)) continue;
+            if (filter(ObjectView(c))) add(ObjectView(c));
+        }
+        return *this;
+    }
+
+    /// Add all visible children of `parent`, in child order
+    Group& add_range(ObjectView parent) noexcept {
+        return add_range(parent, [](ObjectView) noexcept { return true; });
+    }
+
+    /**
+     * @brief Hide or show `obj` and keep it out of the group while hidden
+     *
+     * Focus traversal then never steps over it. Shown again, it goes back
+     * at the end of the group; group_list::set_hidden() puts it back in
+     * child order.
+     */
+    Group& set_hidden(ObjectView obj, bool hidden) noexcept {
+        if (!obj) return *this;
+        if (hidden) {
+            lv_obj_add_flag(obj.get(), LV_OBJ_FLAG_HIDDEN);
+            if (lv_obj_get_group(obj.get()) == m_group) lv_group_remove_obj(obj.get());
+        } else {
+            lv_obj_remove_flag(obj.get(), LV_OBJ_FLAG_HIDDEN);
+            if (lv_obj_get_group(obj.get()) != m_group) add(obj);
+        }
+        return *this;
+    }
+
     /// Remove object from the group
     Group& remove(ObjectView obj) noexcept {
         lv_group_remove_obj(obj);
@@ -103,6 +214,18 @@ public:
         return *this;
     }
 
+    /**
+     * @brief Move the focus `n` members forward (back for n < 0) in one step
+     *
+     * Lands where n focus_next() calls would, but only the final member
+     * receives the focus, so the members in between neither restyle nor
+     * scroll into view.
+     */
+    Group& focus_by(int32_t n) noexcept {
+        if (lv_obj_t* obj = detail::group_step(m_group, n)) lv_group_focus_obj(obj);
+        return *this;
+    }
+
     /// Focus a specific object
     Group& focus(ObjectView obj) noexcept {
         lv_group_focus_obj(obj);
@@ -0,0 +1,368 @@
+#pragma once
+
+/**
+ * @file font_bake.hpp
+ * @brief Bake a runtime font's charset into an in-memory bitmap font
+ *
+ * A TTF font rasterizes on demand, so every first use of a glyph costs a
+ * render. For the glyphs a UI actually shows, bake_font() renders them once
+ * into a plain lv_font_fmt_txt font, the same format lv_font_conv emits
+ * (demos/ebike/generated/font_ebike_*.c): 4 bpp, uncompressed, sorted
+ * cmaps. Drawing it is a table lookup and needs neither the TTF data nor a
+ * glyph cache.
+ *
+ * @code
+ * lv::DynamicFont ttf("A:fonts/Inter.ttf", 48);
+ * lv::BakedFont speed = lv::BakedFont::load("A:cache/speed48.bin");
+ * if (!speed) {
+ *     speed = ttf.bake("0123456789:.-km/h");
+ *     speed.save("A:cache/speed48.bin");   // next boot skips the TTF
+ * }
+ * label.text_font(speed);
+ * @endcode
+ *
+ * Letters outside the charset are not drawn; set fallback() to the TTF
+ * font to cover them. Kerning is not baked. Vector glyphs (outline
+ * FreeType fonts) come out empty. save() writes native-endian data for
+ * the same device, not a portable lv_binfont file.
+ *
+ * Heap allocation: one lv_malloc block per baked font (font, tables and
+ * bitmaps), a code point array and one A8 scratch buffer while baking
+ */
+
+#include <lvgl.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "fs.hpp"
+
+namespace lv {
+
+namespace detail::bake {
+
+inline constexpr uint8_t bpp = 4;
+inline constexpr char magic[4] = {'L', 'V', 'B', 'F'};
+inline constexpr uint16_t version = 1;
+
+[[nodiscard]] constexpr size_t align_up(size_t n) noexcept { return (n + 7u) & ~size_t(7u); }
+
+/// Counts that size a baked font's block
+struct Counts {
+    uint32_t glyphs = 0;     ///< Including the reserved glyph 0
+    uint32_t cmaps = 0;
+    uint32_t list = 0;       ///< uint16_t unicode offsets of sparse cmaps
+    uint32_t bitmap = 0;     ///< Bytes
+};
+
+/// Head of the block; the tables follow in this order
+struct Block {
+    lv_font_t font;
+    lv_font_fmt_txt_dsc_t dsc;
+    Counts counts;
+
+    [[nodiscard]] static size_t cmaps_at() noexcept { return align_up(sizeof(Block)); }
+    [[nodiscard]] size_t glyphs_at() const noexcept {
+        return cmaps_at() + align_up(sizeof(lv_font_fmt_txt_cmap_t) * counts.cmaps);
+    }
+    [[nodiscard]] size_t list_at() const noexcept {
+        return glyphs_at() + align_up(sizeof(lv_font_fmt_txt_glyph_dsc_t) * counts.glyphs);
+    }
+    [[nodiscard]] size_t bitmap_at() const noexcept { return list_at() + align_up(sizeof(uint16_t) * counts.list); }
+    [[nodiscard]] size_t size() const noexcept { return bitmap_at() + counts.bitmap; }
+
+    template<typename T>
+    [[nodiscard]] T* at(size_t off) noexcept { return reinterpret_cast<T*>(reinterpret_cast<uint8_t*>(this) + off); }
+
+    [[nodiscard]] lv_font_fmt_txt_cmap_t* cmaps() noexcept { return at<lv_font_fmt_txt_cmap_t>(cmaps_at()); }
+    [[nodiscard]] lv_font_fmt_txt_glyph_dsc_t* glyphs() noexcept { return at<lv_font_fmt_txt_glyph_dsc_t>(glyphs_at()); }
+    [[nodiscard]] uint16_t* list() noexcept { return at<uint16_t>(list_at()); }
+    [[nodiscard]] uint8_t* bitmap() noexcept { return at<uint8_t>(bitmap_at()); }
+};
+
+/// Allocate a zeroed block for `c` and wire the font to its tables
+[[nodiscard]] inline Block* allocate(const Counts& c) noexcept {
+    Block probe{};
+    probe.counts = c;
+    auto* b = static_cast<Block*>(lv_malloc_zeroed(probe.size()));
+    if (!b) return nullptr;
+    b->counts = c;
+    b->dsc.glyph_bitmap = b->bitmap();
+    b->dsc.glyph_dsc = b->glyphs();
+    b->dsc.cmaps = b->cmaps();
+    b->dsc.cmap_num = static_cast<uint16_t>(c.cmaps);
+    b->dsc.bpp = bpp;
+    b->font.get_glyph_dsc = lv_font_get_glyph_dsc_fmt_txt;
+    b->font.get_glyph_bitmap = lv_font_get_bitmap_fmt_txt;
+    b->font.subpx = LV_FONT_SUBPX_NONE;
+    b->font.dsc = &b->dsc;
+    return b;
+}
+
+/// Split sorted code points into cmaps of at most 65536 code points each
+template<typename F>
+void for_each_cmap(const uint32_t* cps, uint32_t n, F&& f) {
+    uint32_t i = 0;
+    while (i < n) {
+        uint32_t j = i + 1;
+        while (j < n && cps[j] - cps[i] <= 0xFFFF) ++j;
+        f(i, j);
+        i = j;
+    }
+}
+
+[[nodiscard]] inline bool dense(const uint32_t* cps, uint32_t first, uint32_t end) noexcept {
+    return cps[end - 1] - cps[first] == end - first - 1;
+}
+
+[[nodiscard]] inline bool renderable(const lv_font_glyph_dsc_t& g) noexcept {
+    return g.box_w && g.box_h && g.box_w <= 0xFF && g.box_h <= 0xFF &&
+           g.format >= LV_FONT_GLYPH_FORMAT_A1 && g.format <= LV_FONT_GLYPH_FORMAT_A8;
+}
+
+[[nodiscard]] inline uint32_t packed_size(const lv_font_glyph_dsc_t& g) noexcept {
+    return renderable(g) ? (static_cast<uint32_t>(g.box_w) * g.box_h * bpp + 7u) / 8u : 0;
+}
+
+/// Pack an A8 glyph row by row into continuous 4 bpp nibbles (high nibble first)
+inline void pack(const lv_draw_buf_t* src, uint32_t w, uint32_t h, uint8_t* out) noexcept {
+    uint32_t nib = 0;
+    for (uint32_t y = 0; y < h; ++y) {
+        const uint8_t* row = src->data + y * src->header.stride;
+        for (uint32_t x = 0; x < w; ++x, ++nib) {
+            const uint8_t v = static_cast<uint8_t>(row[x] >> 4);
+            out[nib >> 1] |= (nib & 1) ? v : static_cast<uint8_t>(v << 4);
+        }
+    }
+}
+
+template<typename T>
+[[nodiscard]] constexpr T clamp_to(int32_t v, int32_t lo, int32_t hi) noexcept {
+    return static_cast<T>(v < lo ? lo : v > hi ? hi : v);
+}
+
+/// On-disk header of BakedFont::save()
+struct FileHead {
+    char magic[4];
+    uint16_t version;
+    uint16_t bpp;
+    int32_t line_height;
+    int32_t base_line;
+    int32_t underline_position;
+    int32_t underline_thickness;
+    Counts counts;
+};
+
+} // namespace detail::bake
+
+/**
+ * @brief Owning in-memory bitmap font made by bake_font() or load()
+ *
+ * Converts to const lv_font_t* and lv::Font. Labels must not use the font
+ * after it is destroyed.
+ */
+class BakedFont {
+    detail::bake::Block* m_block = nullptr;
+
+public:
+    BakedFont() noexcept = default;
+
+    /// Take ownership of a block from detail::bake::allocate()
+    explicit BakedFont(detail::bake::Block* b) noexcept : m_block(b) {}
+    ~BakedFont() { lv_free(m_block); }
+
+    BakedFont(const BakedFont&) = delete;
+    BakedFont& operator=(const BakedFont&) = delete;
+
+    BakedFont(BakedFont&& other) noexcept : m_block(other.m_block) { other.m_block = nullptr; }
+
+    BakedFont& operator=(BakedFont&& other) noexcept {
+        if (this != &other) {
+            lv_free(m_block);
+            m_block = other.m_block;
+            other.m_block = nullptr;
+        }
+        return *this;
+    }
+
+    [[nodiscard]] const lv_font_t* get() const noexcept { return m_block ? &m_block->font : nullptr; }
+    [[nodiscard]] bool valid() const noexcept { return m_block != nullptr; }
+    explicit operator bool() const noexcept { return valid(); }
+    operator const lv_font_t*() const noexcept { return get(); }
+
+    /// Font drawing the letters the charset missed (e.g. the TTF it was baked from)
+    BakedFont& fallback(const lv_font_t* font) noexcept {
+        if (m_block) m_block->font.fallback = font;
+        return *this;
+    }
+
+    /// Baked glyphs (without the reserved glyph 0)
+    [[nodiscard]] uint32_t glyph_count() const noexcept { return m_block ? m_block->counts.glyphs - 1 : 0; }
+
+    /// Bytes of the whole block (font, tables, bitmaps)
+    [[nodiscard]] size_t bytes() const noexcept { return m_block ? m_block->size() : 0; }
+
+    /// Write the font for load() on the next boot
+    [[nodiscard]] bool save(const char* path) const noexcept {
+        if (!m_block) return false;
+        fs::File f(path, fs::mode::write);
+        if (!f) return false;
+        detail::bake::FileHead head{};
+        std::memcpy(head.magic, detail::bake::magic, sizeof(head.magic));
+        head.version = detail::bake::version;
+        head.bpp = detail::bake::bpp;
+        head.line_height = m_block->font.line_height;
+        head.base_line = m_block->font.base_line;
+        head.underline_position = m_block->font.underline_position;
+        head.underline_thickness = m_block->font.underline_thickness;
+        head.counts = m_block->counts;
+        if (f.write(&head, sizeof(head)) != fs::res::ok) return false;
+        // Tables are written as laid out in memory; pointers are rebuilt by load()
+        const auto* base = reinterpret_cast<const uint8_t*>(m_block);
+        const size_t off = detail::bake::Block::cmaps_at();
+        return f.write(base + off, static_cast<uint32_t>(m_block->size() - off)) == fs::res::ok;
+    }
+
+    /// Read a font written by save(); invalid on a missing, foreign or truncated file
+    [[nodiscard]] static BakedFont load(const char* path) noexcept {
+        fs::File f(path, fs::mode::read);
+        if (!f) return {};
+        detail::bake::FileHead head{};
+        uint32_t br = 0;
+        if (f.read(&head, sizeof(head), &br) != fs::res::ok || br != sizeof(head)) return {};
+        if (std::memcmp(head.magic, detail::bake::magic, sizeof(head.magic)) != 0 ||
+            head.version != detail::bake::version || head.bpp != detail::bake::bpp || head.counts.glyphs == 0) {
+            return {};
+        }
+        detail::bake::Block* b = detail::bake::allocate(head.counts);
+        if (!b) return {};
+        BakedFont font(b);
+        const size_t off = detail::bake::Block::cmaps_at();
+        const auto rest = static_cast<uint32_t>(b->size() - off);
+        if (f.read(b->at<uint8_t>(off), rest, &br) != fs::res::ok || br != rest) return {};
+        uint16_t* list = b->list();
+        lv_font_fmt_txt_cmap_t* cmaps = b->cmaps();
+        for (uint32_t i = 0; i < head.counts.cmaps; ++i) {
+            cmaps[i].unicode_list = cmaps[i].list_length ? list : nullptr;
+            cmaps[i].glyph_id_ofs_list = nullptr;
+            list += cmaps[i].list_length;
+        }
+        b->font.line_height = head.line_height;
+        b->font.base_line = head.base_line;
+        b->font.underline_position = static_cast<int8_t>(head.underline_position);
+        b->font.underline_thickness = static_cast<int8_t>(head.underline_thickness);
+        return font;
+    }
+};
+
+/**
+ * @brief Render the letters of UTF-8 `charset` from `src` into a BakedFont
+ *
+ * Duplicates and order do not matter. Runs synchronously (one render per
+ * letter); bake at startup or from prefetch idle time.
+ */
+[[nodiscard]] inline BakedFont bake_font(const lv_font_t* src, const char* charset) noexcept {
+    namespace bk = detail::bake;
+    if (!src || !charset) return {};
+
+    // Sorted, unique code points
+    uint32_t n = 0;
+    for (uint32_t i = 0; lv_text_encoded_next(charset, &i) != 0;) ++n;
+    if (n == 0) return {};
+    auto* cps = static_cast<uint32_t*>(lv_malloc(sizeof(uint32_t) * n));
+    if (!cps) return {};
+    n = 0;
+    for (uint32_t i = 0, cp; (cp = lv_text_encoded_next(charset, &i)) != 0;) cps[n++] = cp;
+    std::sort(cps, cps + n);
+    n = static_cast<uint32_t>(std::unique(cps, cps + n) - cps);
+
+    // Pass 1: sizes; letters `src` lacks are left out so a fallback can draw them
+    bk::Counts c;
+    uint32_t max_w = 0, max_h = 0;
+    uint32_t kept = 0;
+    for (uint32_t k = 0; k < n; ++k) {
+        lv_font_glyph_dsc_t g;
+        std::memset(&g, 0, sizeof(g));
+        if (!lv_font_get_glyph_dsc(src, &g, cps[k], 0)) continue;
+        cps[kept++] = cps[k];
+        c.bitmap += bk::packed_size(g);
+        max_w = g.box_w > max_w ? g.box_w : max_w;
+        max_h = g.box_h > max_h ? g.box_h : max_h;
+    }
+    n = kept;
+    c.glyphs = n + 1;
+    bk::for_each_cmap(cps, n, [&](uint32_t first, uint32_t end) {
+        ++c.cmaps;
+        if (!bk::dense(cps, first, end)) c.list += end - first;
+    });
+    if (c.bitmap >= (1u << 20) || c.cmaps >= (1u << 9)) {
+        LV_LOG_WARN("font bake: charset too large for one lv_font_fmt_txt font");
+        lv_free(cps);
+        return {};
+    }
+
+    bk::Block* b = bk::allocate(c);
+    BakedFont font(b);
+    lv_draw_buf_t* scratch = max_w && max_h ? lv_draw_buf_create(max_w, max_h, LV_COLOR_FORMAT_A8, LV_STRIDE_AUTO)
+                                            : nullptr;
+    if (!b || (max_w && max_h && !scratch)) {
+        lv_free(cps);
+        return {};
+    }
+
+    b->font.line_height = src->line_height;
+    b->font.base_line = src->base_line;
+    b->font.underline_position = src->underline_position;
+    b->font.underline_thickness = src->underline_thickness;
+
+    // Cmaps: glyph ids follow the sorted code points
+    lv_font_fmt_txt_cmap_t* cmap = b->cmaps();
+    uint16_t* list = b->list();
+    bk::for_each_cmap(cps, n, [&](uint32_t first, uint32_t end) {
+        cmap->range_start = cps[first];
+        cmap->range_length = static_cast<uint16_t>(cps[end - 1] - cps[first] + 1);
+        cmap->glyph_id_start = static_cast<uint16_t>(first + 1);
+        if (bk::dense(cps, first, end)) {
+            cmap->type = LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY;
+        } else {
+            cmap->type = LV_FONT_FMT_TXT_CMAP_SPARSE_TINY;
+            cmap->unicode_list = list;
+            cmap->list_length = static_cast<uint16_t>(end - first);
+            for (uint32_t k = first; k < end; ++k) *list++ = static_cast<uint16_t>(cps[k] - cps[first]);
+        }
+        ++cmap;
+    });
+
+    // Pass 2: glyph descriptors and bitmaps
+    lv_font_fmt_txt_glyph_dsc_t* glyphs = b->glyphs();
+    uint8_t* bitmap = b->bitmap();
+    uint32_t at = 0;
+    for (uint32_t k = 0; k < n; ++k) {
+        lv_font_glyph_dsc_t g;
+        std::memset(&g, 0, sizeof(g));
+        if (!lv_font_get_glyph_dsc(src, &g, cps[k], 0)) continue;
+        lv_font_fmt_txt_glyph_dsc_t& d = glyphs[k + 1];
+        d.bitmap_index = at;
+        d.adv_w = bk::clamp_to<uint32_t>(g.adv_w * 16, 0, 0xFFF);
+        d.ofs_x = bk::clamp_to<int8_t>(g.ofs_x, INT8_MIN, INT8_MAX);
+        d.ofs_y = bk::clamp_to<int8_t>(g.ofs_y, INT8_MIN, INT8_MAX);
+        if (!bk::renderable(g)) continue;
+        const uint32_t size = bk::packed_size(g);
+        if (at + size > c.bitmap) continue;    // the font changed between the passes
+        lv_draw_buf_clear(scratch, nullptr);
+        const auto* out = static_cast<const lv_draw_buf_t*>(lv_font_get_glyph_bitmap(&g, scratch));
+        if (out) {
+            d.box_w = static_cast<uint8_t>(g.box_w);
+            d.box_h = static_cast<uint8_t>(g.box_h);
+            bk::pack(out, g.box_w, g.box_h, bitmap + at);
+            at += size;
+        }
+        lv_font_glyph_release_draw_data(&g);
+    }
+
+    if (scratch) lv_draw_buf_destroy(scratch);
+    lv_free(cps);
+    return font;
+}
+
+} // namespace lv
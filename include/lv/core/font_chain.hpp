@@ -0,0 +1,295 @@
+#pragma once
+
+/**
+ * @file font_chain.hpp
+ * @brief Font fallback chains that remember which font has each letter
+ *
+ * LVGL resolves a letter by asking the font and then every `fallback` in
+ * turn. For mixed Latin/CJK/emoji text most letters fail one or two
+ * lookups first, and for TinyTTF and FreeType fonts a failed lookup is a
+ * cmap search per letter per draw. A FontChain presents the fonts as one
+ * chain and remembers, per code point, which member resolved it: ASCII in
+ * a direct table, other code points in a small hash. Members before the
+ * remembered one answer "no" without asking their font:
+ *
+ * @code
+ * lv::DynamicFont cjk("A:fonts/noto_sc.ttf", 16);
+ * lv::DynamicFont emoji("A:fonts/emoji.ttf", 16);
+ * static lv::FontChain text_font{&lv_font_montserrat_16, cjk.get(), emoji.get()};
+ * label.text_font(text_font);
+ * ...
+ * text_font.dump();       // letters resolved per member, misses, missing letters
+ * @endcode
+ *
+ * The chain's fonts are proxies. They forward to the members and keep the
+ * members' own `fallback` untouched, so a font can be in several chains
+ * and flash-resident fonts work. Each member still looks up the glyphs it
+ * draws; its own glyph cache applies. Call refresh() after changing a
+ * member's size. The chain must outlive the objects using it.
+ *
+ * Lookups take an lv_mutex when LVGL runs with an OS, as draw units may
+ * shape labels in parallel.
+ *
+ * Heap allocation: NONE (the memo is part of the chain object)
+ */
+
+#include <lvgl.h>
+#include <cstdint>
+#include <initializer_list>
+
+#ifndef LV_CPP_FONT_CHAIN_FONTS
+/// Fonts per chain
+#define LV_CPP_FONT_CHAIN_FONTS 4
+#endif
+
+#ifndef LV_CPP_FONT_CHAIN_MEMO
+/// Non-ASCII code points remembered per chain (power of two)
+#define LV_CPP_FONT_CHAIN_MEMO 256
+#endif
+
+static_assert((LV_CPP_FONT_CHAIN_MEMO & (LV_CPP_FONT_CHAIN_MEMO - 1)) == 0,
+              "LV_CPP_FONT_CHAIN_MEMO must be a power of two");
+
+namespace lv {
+
+/// Lookup counters of a FontChain
+struct FontChainStats {
+    uint32_t hits;          ///< Letters answered from the memo
+    uint32_t misses;        ///< Letters resolved by asking the members in turn
+    uint32_t missing;       ///< Lookups of letters no member has
+    uint32_t skipped;       ///< Member lookups the memo saved
+    uint32_t resolved[LV_CPP_FONT_CHAIN_FONTS];  ///< Lookups answered per member
+    uint32_t last_missing;  ///< Most recent letter no member has (0: none)
+};
+
+/**
+ * @brief Fallback chain of up to LV_CPP_FONT_CHAIN_FONTS fonts with a per-letter memo
+ *
+ * Non-copyable and non-movable: LVGL holds pointers to the proxy fonts.
+ */
+class FontChain {
+    static constexpr uint8_t kUnknown = 0;
+    static constexpr uint8_t kNone = 0xFF;    ///< No member has the letter
+
+    struct Member {
+        lv_font_t proxy{};
+        const lv_font_t* font = nullptr;
+        FontChain* chain = nullptr;
+        uint8_t index = 0;
+    };
+
+    Member m_members[LV_CPP_FONT_CHAIN_FONTS];
+    uint8_t m_count = 0;
+    uint8_t m_ascii[128] = {};                    ///< Member index + 1, kNone or kUnknown
+    uint32_t m_memo[LV_CPP_FONT_CHAIN_MEMO] = {}; ///< Code point | (member index + 1) << 24; 0 = empty
+    FontChainStats m_stats{};
+#if LV_USE_OS != LV_OS_NONE
+    lv_mutex_t m_lock;
+#endif
+
+    struct Lock {
+        [[maybe_unused]] FontChain* c;
+        explicit Lock(FontChain* chain) noexcept : c(chain) {
+#if LV_USE_OS != LV_OS_NONE
+            lv_mutex_lock(&c->m_lock);
+#endif
+        }
+        ~Lock() {
+#if LV_USE_OS != LV_OS_NONE
+            lv_mutex_unlock(&c->m_lock);
+#endif
+        }
+    };
+
+    [[nodiscard]] static Member* member_of(const lv_font_t* proxy) noexcept {
+        return static_cast<Member*>(proxy->user_data);
+    }
+
+    [[nodiscard]] static uint32_t slot_of(uint32_t letter) noexcept {
+        return (letter * 2654435761u) >> 24 & (LV_CPP_FONT_CHAIN_MEMO - 1);
+    }
+
+    /// Remembered member + 1 for `letter`, kNone, or kUnknown
+    [[nodiscard]] uint8_t recall(uint32_t letter) const noexcept {
+        if (letter < 128) return m_ascii[letter];
+        for (uint32_t i = 0, s = slot_of(letter); i < 4; ++i, s = (s + 1) & (LV_CPP_FONT_CHAIN_MEMO - 1)) {
+            const uint32_t e = m_memo[s];
+            if (!e) return kUnknown;
+            if ((e & 0xFFFFFF) == letter) return static_cast<uint8_t>(e >> 24);
+        }
+        return kUnknown;
+    }
+
+    void remember(uint32_t letter, uint8_t v) noexcept {
+        if (letter < 128) {
+            m_ascii[letter] = v;
+            return;
+        }
+        if (letter > 0xFFFFFF) return;
+        uint32_t s = slot_of(letter);
+        for (uint32_t i = 0; i < 4 && m_memo[s] && (m_memo[s] & 0xFFFFFF) != letter; ++i) {
+            s = (s + 1) & (LV_CPP_FONT_CHAIN_MEMO - 1);
+        }
+        m_memo[s] = letter | static_cast<uint32_t>(v) << 24;   // probes full: the last one is replaced
+    }
+
+    /// Ask the members in turn; fills `g` when member 0 has the letter
+    [[nodiscard]] uint8_t resolve(lv_font_glyph_dsc_t* g, uint32_t letter, uint32_t next) noexcept {
+        for (uint8_t i = 0; i < m_count; ++i) {
+            const lv_font_t* f = m_members[i].font;
+            if (!f->get_glyph_dsc) continue;
+            lv_font_glyph_dsc_t probe = *g;
+            if (f->get_glyph_dsc(f, &probe, letter, f->kerning == LV_FONT_KERNING_NONE ? 0 : next) &&
+                !probe.is_placeholder) {
+                if (i == 0) *g = probe;
+                return static_cast<uint8_t>(i + 1);
+            }
+        }
+        return kNone;
+    }
+
+    static bool glyph_dsc_cb(const lv_font_t* proxy, lv_font_glyph_dsc_t* g, uint32_t letter, uint32_t next) {
+        Member* m = member_of(proxy);
+        FontChain* c = m->chain;
+        const lv_font_t* f = m->font;
+        uint8_t v;
+        {
+            Lock lock(c);
+            v = c->recall(letter);
+            if (v == kUnknown) {
+                // Only the head proxy resolves; LVGL always starts there
+                if (m->index != 0) return f->get_glyph_dsc && f->get_glyph_dsc(f, g, letter, next);
+                ++c->m_stats.misses;
+                v = c->resolve(g, letter, next);
+                c->remember(letter, v);
+                if (v == kNone) {
+                    ++c->m_stats.missing;
+                    c->m_stats.last_missing = letter;
+                } else {
+                    ++c->m_stats.resolved[v - 1];
+                }
+                if (v == 1) return true;
+            } else if (m->index == 0) {
+                ++c->m_stats.hits;
+                if (v == kNone) ++c->m_stats.missing;
+                else ++c->m_stats.resolved[v - 1];
+            }
+            if (v != kNone && m->index + 1 != v) {
+                ++c->m_stats.skipped;
+                return false;
+            }
+        }
+        // The remembered member, or every member when none has the letter (placeholders)
+        return f->get_glyph_dsc && f->get_glyph_dsc(f, g, letter, next);
+    }
+
+    // LVGL sets resolved_font to the proxy; the member needs itself there
+    static const void* glyph_bitmap_cb(lv_font_glyph_dsc_t* g, lv_draw_buf_t* buf) {
+        const lv_font_t* proxy = g->resolved_font;
+        const lv_font_t* f = member_of(proxy)->font;
+        if (!f->get_glyph_bitmap) return nullptr;
+        g->resolved_font = f;
+        const void* bitmap = f->get_glyph_bitmap(g, buf);
+        g->resolved_font = proxy;
+        return bitmap;
+    }
+
+    static void release_glyph_cb(const lv_font_t* proxy, lv_font_glyph_dsc_t* g) {
+        const lv_font_t* f = member_of(proxy)->font;
+        if (!f->release_glyph) return;
+        g->resolved_font = f;
+        f->release_glyph(f, g);
+        g->resolved_font = proxy;
+    }
+
+    void build_proxies() noexcept {
+        for (uint8_t i = 0; i < m_count; ++i) {
+            Member& m = m_members[i];
+            m.proxy = *m.font;          // metrics, kerning, subpx, underline
+            m.proxy.get_glyph_dsc = &glyph_dsc_cb;
+            m.proxy.get_glyph_bitmap = &glyph_bitmap_cb;
+            m.proxy.release_glyph = &release_glyph_cb;
+            m.proxy.fallback = i + 1 < m_count ? &m_members[i + 1].proxy : nullptr;
+            m.proxy.user_data = &m;
+        }
+    }
+
+public:
+    /// Chain `fonts` in order (the first one sets the line metrics); extra fonts are ignored
+    FontChain(std::initializer_list<const lv_font_t*> fonts) noexcept {
+#if LV_USE_OS != LV_OS_NONE
+        lv_mutex_init(&m_lock);
+#endif
+        for (const lv_font_t* f : fonts) {
+            if (!f) continue;
+            if (m_count == LV_CPP_FONT_CHAIN_FONTS) {
+                LV_LOG_WARN("font chain full, raise LV_CPP_FONT_CHAIN_FONTS");
+                break;
+            }
+            m_members[m_count] = Member{{}, f, this, m_count};
+            ++m_count;
+        }
+        build_proxies();
+    }
+
+    ~FontChain() {
+#if LV_USE_OS != LV_OS_NONE
+        lv_mutex_delete(&m_lock);
+#endif
+    }
+
+    FontChain(const FontChain&) = delete;
+    FontChain& operator=(const FontChain&) = delete;
+
+    /// The font to set on labels (nullptr for an empty chain)
+    [[nodiscard]] const lv_font_t* get() const noexcept { return m_count ? &m_members[0].proxy : nullptr; }
+    operator const lv_font_t*() const noexcept { return get(); }
+
+    [[nodiscard]] uint32_t size() const noexcept { return m_count; }
+
+    /// Member `i` as passed to the constructor
+    [[nodiscard]] const lv_font_t* font(uint32_t i) const noexcept {
+        return i < m_count ? m_members[i].font : nullptr;
+    }
+
+    /// Re-read the members' metrics and forget the memo (after a member changed size or glyphs)
+    void refresh() noexcept {
+        Lock lock(this);
+        build_proxies();
+        clear_locked();
+    }
+
+    /// Forget which member has which letter
+    void clear() noexcept {
+        Lock lock(this);
+        clear_locked();
+    }
+
+    [[nodiscard]] FontChainStats stats() const noexcept { return m_stats; }
+
+    void reset_stats() noexcept {
+        Lock lock(this);
+        m_stats = {};
+    }
+
+    /// LV_LOG_USER the lookups per member and the last missing letter
+    void dump() const noexcept {
+        const FontChainStats& s = m_stats;
+        LV_LOG_USER("font chain: %u memo hits, %u misses, %u member lookups skipped, %u missing (last U+%04X)",
+                    static_cast<unsigned>(s.hits), static_cast<unsigned>(s.misses),
+                    static_cast<unsigned>(s.skipped), static_cast<unsigned>(s.missing),
+                    static_cast<unsigned>(s.last_missing));
+        for (uint32_t i = 0; i < m_count; ++i) {
+            LV_LOG_USER("  font %u (%p): %u lookups", static_cast<unsigned>(i),
+                        static_cast<const void*>(m_members[i].font), static_cast<unsigned>(s.resolved[i]));
+        }
+    }
+
+private:
+    void clear_locked() noexcept {
+        for (uint8_t& a : m_ascii) a = kUnknown;
+        for (uint32_t& e : m_memo) e = 0;
+    }
+};
+
+} // namespace lv
@@ -9,14 +9,40 @@
  * - TinyTTF fonts (requires LV_USE_TINY_TTF)
  *
  * Both backends support TTF/OTF fonts loaded from files or memory.
+ * FontCache sizes a font's glyph cache at creation and can put the font
+ * behind the shared, budgeted cache of glyph_cache.hpp (stats per font).
+ * DynamicFont::prewarm() renders a charset at idle time, bake() turns it
+ * into a bitmap font (font_bake.hpp). FontChain (font_chain.hpp) chains
+ * runtime and built-in fonts as fallbacks that remember which font has
+ * each letter.
  */
 
 #include <lvgl.h>
 #include <cstdint>
 #include <cstddef>
+#include "glyph_cache.hpp"
+#include "font_bake.hpp"
+#include "font_chain.hpp"
+#include "prefetch.hpp"
 
 namespace lv {
 
+// ==================== Glyph Cache Config ====================
+
+/**
+ * @brief Glyph cache options for runtime fonts
+ *
+ * @code
+ * auto cjk = lv::TinyTTFFont::create("A:noto_sc.ttf", 20, {.glyphs = 1024});
+ * auto ui  = lv::TinyTTFFont::create(ui_ttf, ui_ttf_size, 16, {.shared = true});
+ * @endcode
+ */
+struct FontCache {
+    uint32_t glyphs = 0;     ///< TinyTTF glyph cache entries (0: LV_TINY_TTF_CACHE_GLYPH_CNT)
+    bool kerning = true;     ///< TinyTTF kerning (its cache size is LV_TINY_TTF_CACHE_KERNING_CNT)
+    bool shared = false;     ///< Also serve bitmaps from lv::glyph_cache (budget and stats)
+};
+
 // ==================== Font Style ====================
 
 #if LV_USE_FREETYPE
@@ -79,12 +105,27 @@ public:
                  lv_freetype_font_render_mode_t render = LV_FREETYPE_FONT_RENDER_MODE_BITMAP) noexcept
         : m_font(lv_freetype_font_create(path, render, size, style)), m_owned(true) {}
 
+    /**
+     * @brief Create a bitmap font with cache options
+     *
+     * FreeType's own glyph cache is shared by all its fonts and sized by
+     * freetype_init(); cache.glyphs is ignored, cache.shared attaches the
+     * font to lv::glyph_cache.
+     */
+    [[nodiscard]] static FreeTypeFont create(const char* path, uint32_t size, FontCache cache,
+                                             lv_freetype_font_style_t style = LV_FREETYPE_FONT_STYLE_NORMAL) noexcept {
+        FreeTypeFont font(path, size, style, LV_FREETYPE_FONT_RENDER_MODE_BITMAP);
+        if (font.m_font && cache.shared) glyph_cache::attach(font.m_font);
+        return font;
+    }
+
     /// Wrap existing font (non-owning)
     explicit FreeTypeFont(lv_font_t* font) noexcept
         : m_font(font), m_owned(false) {}
 
     ~FreeTypeFont() {
         if (m_owned && m_font) {
+            glyph_cache::detach(m_font);
             lv_freetype_font_delete(m_font);
         }
     }
@@ -103,6 +144,7 @@ public:
     FreeTypeFont& operator=(FreeTypeFont&& other) noexcept {
         if (this != &other) {
             if (m_owned && m_font) {
+                glyph_cache::detach(m_font);
                 lv_freetype_font_delete(m_font);
             }
             m_font = other.m_font;
@@ -183,12 +225,26 @@ public:
                 lv_font_kerning_t kerning, size_t cache_size) noexcept
         : m_font(lv_tiny_ttf_create_data_ex(data, data_size, size, kerning, cache_size)), m_owned(true) {}
 
+#if LV_TINY_TTF_FILE_SUPPORT
+    /// Create from file with a sized glyph cache, optionally behind lv::glyph_cache
+    [[nodiscard]] static TinyTTFFont create(const char* path, int32_t size, FontCache cache) noexcept {
+        return attached(TinyTTFFont(path, size, kerning_of(cache), cache_size_of(cache)), cache);
+    }
+#endif
+
+    /// Create from memory with a sized glyph cache, optionally behind lv::glyph_cache
+    [[nodiscard]] static TinyTTFFont create(const void* data, size_t data_size, int32_t size,
+                                            FontCache cache) noexcept {
+        return attached(TinyTTFFont(data, data_size, size, kerning_of(cache), cache_size_of(cache)), cache);
+    }
+
     /// Wrap existing font (non-owning)
     explicit TinyTTFFont(lv_font_t* font) noexcept
         : m_font(font), m_owned(false) {}
 
     ~TinyTTFFont() {
         if (m_owned && m_font) {
+            glyph_cache::detach(m_font);
             lv_tiny_ttf_destroy(m_font);
         }
     }
@@ -207,6 +263,7 @@ public:
     TinyTTFFont& operator=(TinyTTFFont&& other) noexcept {
         if (this != &other) {
             if (m_owned && m_font) {
+                glyph_cache::detach(m_font);
                 lv_tiny_ttf_destroy(m_font);
             }
             m_font = other.m_font;
@@ -231,6 +288,7 @@ public:
     /// Change font size
     TinyTTFFont& set_size(int32_t size) noexcept {
         if (m_font) {
+            glyph_cache::drop(m_font);
             lv_tiny_ttf_set_size(m_font, size);
         }
         return *this;
@@ -241,6 +299,24 @@ public:
         m_owned = false;
         return m_font;
     }
+
+private:
+    static lv_font_kerning_t kerning_of(FontCache cache) noexcept {
+        return cache.kerning ? LV_FONT_KERNING_NORMAL : LV_FONT_KERNING_NONE;
+    }
+
+    static size_t cache_size_of(FontCache cache) noexcept {
+#ifdef LV_TINY_TTF_CACHE_GLYPH_CNT
+        return cache.glyphs ? cache.glyphs : LV_TINY_TTF_CACHE_GLYPH_CNT;
+#else
+        return cache.glyphs ? cache.glyphs : 128;
+#endif
+    }
+
+    static TinyTTFFont attached(TinyTTFFont font, FontCache cache) noexcept {
+        if (font.m_font && cache.shared) glyph_cache::attach(font.m_font);
+        return font;
+    }
 };
 
 #endif // LV_USE_TINY_TTF
@@ -376,6 +452,7 @@ public:
     /// Destroy the font and release resources
     void destroy() noexcept {
         if (!m_font) return;
+        glyph_cache::detach(m_font);
 
         switch (m_backend) {
 #if LV_USE_TINY_TTF
@@ -413,6 +490,7 @@ public:
     [[nodiscard]] bool set_size([[maybe_unused]] int32_t size) noexcept {
 #if LV_USE_TINY_TTF
         if (m_font && m_backend == Backend::TinyTTF) {
+            glyph_cache::drop(m_font);
             lv_tiny_ttf_set_size(m_font, size);
             return true;
         }
@@ -420,6 +498,28 @@ public:
         return false;
     }
 
+    /**
+     * @brief Render the letters of `utf8` into the glyph cache at idle time
+     *
+     * Queued on lv::prefetch (worked off by lv::tick() when idle), so the
+     * first frame showing them does not rasterize. Keep the font alive
+     * until the ticket is done or cancel it.
+     */
+    prefetch::Ticket prewarm(const char* utf8, prefetch::Ticket t = 0) noexcept {
+        return m_font ? prefetch::text(m_font, utf8, t) : 0;
+    }
+
+    prefetch::Ticket prewarm(const char8_t* utf8, prefetch::Ticket t = 0) noexcept {
+        return prewarm(reinterpret_cast<const char*>(utf8), t);
+    }
+
+    /// Render the letters of `utf8` into an in-memory bitmap font (see font_bake.hpp)
+    [[nodiscard]] BakedFont bake(const char* utf8) const noexcept { return bake_font(m_font, utf8); }
+
+    [[nodiscard]] BakedFont bake(const char8_t* utf8) const noexcept {
+        return bake(reinterpret_cast<const char*>(utf8));
+    }
+
     /// Release ownership (font won't be deleted in destructor)
     [[nodiscard]] lv_font_t* release() noexcept {
         lv_font_t* font = m_font;
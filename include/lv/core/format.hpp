@@ -0,0 +1,339 @@
+#pragma once
+
+/**
+ * @file format.hpp
+ * @brief Compile-time parsed format strings (no printf at runtime)
+ *
+ * `lv::fmt<"...">` parses the format string at compile time; formatting
+ * writes the literal text and specialized integer / fixed-point
+ * conversions straight into a stack buffer sized for the argument types:
+ *
+ * @code
+ * label.text(lv::fmt<"Speed: {} km/h">, speed);
+ * label.text(lv::fmt<"{:.1} V">, volts);                // float, 1 decimal
+ * label.bind_text(rpm, lv::fmt<"{:5} rpm">);
+ * table.cell_value(row, 2, lv::fmt<"0x{:04X}">, addr);
+ * auto s = lv::fmt<"{}/{}">(done, total);              // s.c_str(), s.view()
+ * @endcode
+ *
+ * Fields: `{}` or `{:[0][width][.precision][d|x|X]}`; `{{` and `}}` are
+ * literal braces.
+ *
+ * - integers: decimal (32-bit division when the value fits), `x` / `X` hex
+ * - float / double: fixed point, `precision` decimals (default 2, max 9),
+ *   rounded half away from zero; integer parts past 2^64 saturate
+ * - char: the character; const char* / std::string_view: the text, cut
+ *   at LV_CPP_FMT_STR_MAX bytes
+ * - `width` pads on the left with spaces, or zeros after the sign with `0`
+ *
+ * A malformed string or a wrong argument count is a compile error.
+ *
+ * Heap allocation: NONE
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+
+#ifndef LV_CPP_FMT_STR_MAX
+/// Bytes a string argument can add to a formatted text
+#define LV_CPP_FMT_STR_MAX 32
+#endif
+
+namespace lv {
+
+/// String literal usable as a template argument
+template<size_t N>
+struct FixedString {
+    char data[N]{};
+
+    constexpr FixedString(const char (&s)[N]) noexcept {
+        for (size_t i = 0; i < N; ++i) data[i] = s[i];
+    }
+};
+
+/// Result of formatting: a null-terminated text in a buffer of `Cap` bytes
+template<size_t Cap>
+struct FormatBuf {
+    char data[Cap];
+    size_t len = 0;
+
+    [[nodiscard]] const char* c_str() const noexcept { return data; }
+    [[nodiscard]] std::string_view view() const noexcept { return {data, len}; }
+};
+
+namespace detail::format {
+
+struct Field {
+    uint16_t pos = 0;          ///< Offset in the literal text where the field goes
+    uint8_t width = 0;
+    int8_t precision = -1;
+    bool zero = false;
+    char kind = 'd';           ///< 'd', 'x' or 'X'
+};
+
+template<size_t N>
+struct Parsed {
+    char text[N]{};            ///< Literal text, escapes resolved
+    size_t text_len = 0;
+    Field fields[N]{};
+    size_t count = 0;
+    bool ok = true;
+};
+
+template<size_t N>
+[[nodiscard]] constexpr Parsed<N> parse(const char (&s)[N]) noexcept {
+    Parsed<N> p;
+    size_t i = 0;
+    while (i + 1 < N) {
+        const char c = s[i];
+        if (c == '{' && s[i + 1] == '{') {
+            p.text[p.text_len++] = '{';
+            i += 2;
+        } else if (c == '}') {
+            if (s[i + 1] != '}') {
+                p.ok = false;
+                return p;
+            }
+            p.text[p.text_len++] = '}';
+            i += 2;
+        } else if (c != '{') {
+            p.text[p.text_len++] = c;
+            ++i;
+        } else {
+            Field f;
+            f.pos = static_cast<uint16_t>(p.text_len);
+            ++i;
+            if (s[i] == ':') {
+                ++i;
+                if (s[i] == '0') {
+                    f.zero = true;
+                    ++i;
+                }
+                int w = 0;
+                while (s[i] >= '0' && s[i] <= '9') w = w * 10 + (s[i++] - '0');
+                if (w > 64) p.ok = false;
+                f.width = static_cast<uint8_t>(w);
+                if (s[i] == '.') {
+                    ++i;
+                    int prec = 0;
+                    if (!(s[i] >= '0' && s[i] <= '9')) p.ok = false;
+                    while (s[i] >= '0' && s[i] <= '9') prec = prec * 10 + (s[i++] - '0');
+                    if (prec > 9) p.ok = false;
+                    f.precision = static_cast<int8_t>(prec);
+                }
+                if (s[i] == 'd' || s[i] == 'x' || s[i] == 'X') f.kind = s[i++];
+            }
+            if (s[i] != '}') {
+                p.ok = false;
+                return p;
+            }
+            ++i;
+            p.fields[p.count++] = f;
+        }
+    }
+    return p;
+}
+
+/// Most bytes argument type T can produce under `f`
+template<typename T>
+[[nodiscard]] constexpr size_t max_len(const Field& f) noexcept {
+    using U = std::remove_cvref_t<T>;
+    size_t n = 0;
+    if constexpr (std::is_same_v<U, char>) {
+        n = 1;
+    } else if constexpr (std::is_same_v<U, bool>) {
+        n = 1;
+    } else if constexpr (std::is_integral_v<U> || std::is_enum_v<U>) {
+        n = f.kind == 'd' ? std::numeric_limits<uint64_t>::digits10 + 2 : 16;
+    } else if constexpr (std::is_floating_point_v<U>) {
+        n = 1 + 20 + 1 + 9;
+    } else {
+        static_assert(std::is_convertible_v<U, std::string_view>,
+                      "lv::fmt: arguments are integers, floats, chars or strings");
+        n = LV_CPP_FMT_STR_MAX;
+    }
+    return n > f.width ? n : f.width;
+}
+
+/// Digits of `v` in `base`; returns their count
+[[nodiscard]] inline size_t digits(char* out, uint64_t v, unsigned base, bool upper) noexcept {
+    const char* set = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    char tmp[20];
+    size_t n = 0;
+    if (base == 10 && v <= UINT32_MAX) {
+        // 32-bit division: no libgcc 64-bit divide on 32-bit MCUs
+        uint32_t w = static_cast<uint32_t>(v);
+        do {
+            tmp[n++] = static_cast<char>('0' + w % 10);
+            w /= 10;
+        } while (w);
+    } else {
+        do {
+            tmp[n++] = set[v % base];
+            v /= base;
+        } while (v);
+    }
+    for (size_t i = 0; i < n; ++i) out[i] = tmp[n - 1 - i];
+    return n;
+}
+
+/// `body` with its sign, padded to the field width
+[[nodiscard]] inline size_t pad(char* out, bool neg, const char* body, size_t len, const Field& f) noexcept {
+    const size_t total = len + (neg ? 1 : 0);
+    const size_t fill = f.width > total ? f.width - total : 0;
+    size_t n = 0;
+    if (!f.zero) {
+        std::memset(out, ' ', fill);
+        n += fill;
+    }
+    if (neg) out[n++] = '-';
+    if (f.zero) {
+        std::memset(out + n, '0', fill);
+        n += fill;
+    }
+    std::memcpy(out + n, body, len);
+    return n + len;
+}
+
+template<typename T>
+[[nodiscard]] size_t write_int(char* out, T v, const Field& f) noexcept {
+    char body[20];
+    bool neg = false;
+    uint64_t mag;
+    if constexpr (std::is_signed_v<T>) {
+        neg = v < 0;
+        mag = neg ? 0 - static_cast<uint64_t>(static_cast<int64_t>(v)) : static_cast<uint64_t>(v);
+    } else {
+        mag = static_cast<uint64_t>(v);
+    }
+    if (f.kind != 'd') {
+        neg = false;
+        mag = static_cast<uint64_t>(static_cast<std::make_unsigned_t<T>>(v));
+    }
+    const size_t len = digits(body, mag, f.kind == 'd' ? 10 : 16, f.kind == 'X');
+    return pad(out, neg, body, len, f);
+}
+
+template<typename T>
+[[nodiscard]] size_t write_float(char* out, T v, const Field& f) noexcept {
+    constexpr uint32_t pow10[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+    const int prec = f.precision < 0 ? 2 : f.precision;
+    if (v != v) return pad(out, false, "nan", 3, f);
+    const bool neg = v < 0;
+    const double a = neg ? -static_cast<double>(v) : static_cast<double>(v);
+    // Integer and fraction apart, so large values keep their integer digits
+    uint64_t ip = a >= 18446744073709551615.0 ? UINT64_MAX : static_cast<uint64_t>(a);
+    uint64_t fq = ip == UINT64_MAX ? 0 : static_cast<uint64_t>((a - static_cast<double>(ip)) * pow10[prec] + 0.5);
+    if (fq >= pow10[prec]) {
+        fq -= pow10[prec];
+        if (ip != UINT64_MAX) ++ip;
+    }
+    char body[32];
+    size_t len = digits(body, ip, 10, false);
+    if (prec > 0) {
+        body[len++] = '.';
+        char frac[10];
+        const size_t fl = digits(frac, fq, 10, false);
+        for (size_t i = fl; i < static_cast<size_t>(prec); ++i) body[len++] = '0';
+        std::memcpy(body + len, frac, fl);
+        len += fl;
+    }
+    return pad(out, neg && (ip | fq) != 0, body, len, f);
+}
+
+template<typename T>
+[[nodiscard]] size_t write_arg(char* out, const T& v, const Field& f) noexcept {
+    using U = std::remove_cvref_t<T>;
+    if constexpr (std::is_same_v<U, char>) {
+        return pad(out, false, &v, 1, f);
+    } else if constexpr (std::is_same_v<U, bool>) {
+        const char c = v ? '1' : '0';
+        return pad(out, false, &c, 1, f);
+    } else if constexpr (std::is_enum_v<U>) {
+        return write_int(out, static_cast<std::underlying_type_t<U>>(v), f);
+    } else if constexpr (std::is_integral_v<U>) {
+        return write_int(out, v, f);
+    } else if constexpr (std::is_floating_point_v<U>) {
+        return write_float(out, v, f);
+    } else {
+        std::string_view s;
+        if constexpr (std::is_pointer_v<U>) {
+            if (v) s = v;
+        } else {
+            s = std::string_view(v);
+        }
+        if (s.size() > LV_CPP_FMT_STR_MAX) s = s.substr(0, LV_CPP_FMT_STR_MAX);
+        return pad(out, false, s.data(), s.size(), f);
+    }
+}
+
+} // namespace detail::format
+
+/**
+ * @brief A format string parsed at compile time; see lv::fmt
+ */
+template<FixedString F>
+struct Format {
+    static constexpr auto parsed = detail::format::parse(F.data);
+    static_assert(parsed.ok, "lv::fmt: malformed format string");
+
+    /// Fields in the string
+    static constexpr size_t arg_count = parsed.count;
+
+    /// Buffer bytes formatting Args needs (terminator included)
+    template<typename... Args>
+    [[nodiscard]] static constexpr size_t capacity() noexcept {
+        size_t n = parsed.text_len + 1;
+        size_t i = 0;
+        ((n += detail::format::max_len<Args>(parsed.fields[i++])), ...);
+        return n;
+    }
+
+    template<typename... Args>
+    [[nodiscard]] FormatBuf<capacity<Args...>()> operator()(const Args&... args) const noexcept {
+        static_assert(sizeof...(Args) == arg_count, "lv::fmt: argument count does not match the fields");
+        FormatBuf<capacity<Args...>()> out;
+        size_t lit = 0;
+        size_t i = 0;
+        [[maybe_unused]] auto field = [&](const auto& a) noexcept {
+            const detail::format::Field& f = parsed.fields[i++];
+            std::memcpy(out.data + out.len, parsed.text + lit, f.pos - lit);
+            out.len += f.pos - lit;
+            lit = f.pos;
+            out.len += detail::format::write_arg(out.data + out.len, a, f);
+        };
+        (field(args), ...);
+        std::memcpy(out.data + out.len, parsed.text + lit, parsed.text_len - lit);
+        out.len += parsed.text_len - lit;
+        out.data[out.len] = '\0';
+        return out;
+    }
+
+    /// Format into `buf` (cut to `size` - 1 bytes); returns the untruncated length like snprintf
+    template<typename... Args>
+    size_t to(char* buf, size_t size, const Args&... args) const noexcept {
+        const auto s = (*this)(args...);
+        if (size) {
+            const size_t n = s.len < size ? s.len : size - 1;
+            std::memcpy(buf, s.data, n);
+            buf[n] = '\0';
+        }
+        return s.len;
+    }
+};
+
+/// Compile-time format: `lv::fmt<"T = {:.1} C">(t)`
+template<FixedString F>
+inline constexpr Format<F> fmt{};
+
+/// snprintf() with a compile-time format
+template<FixedString F, typename... Args>
+inline int snprintf(char* buffer, size_t count, const Format<F>& f, const Args&... args) noexcept {
+    return static_cast<int>(f.to(buffer, count, args...));
+}
+
+} // namespace lv
@@ -0,0 +1,1215 @@
+#pragma once
+
+/**
+ * @file frame_ahead.hpp
+ * @brief Decode-ahead frame caches for GIF playback, AnimImage and Lottie
+ *
+ * lv_gif decodes a frame in the timer that shows it, so several GIFs
+ * playing at once put all their decode work into the same frames.
+ * GifPlayer plays a GIF into any image object from a ring of pre-decoded
+ * ARGB8888 frames instead. lv::tick() refills the ring in timer slack
+ * (see lv::idle_handler()), so the timer only swaps sources. Short loops
+ * that fit the budget are decoded once and kept, after which the decoder
+ * and its file are released.
+ *
+ * @code
+ * auto img = lv::Image::create(parent);
+ * auto gif = lv::GifPlayer::play(img, "A:/anim/loading.gif");
+ * auto spinner = lv::GifPlayer::play(lv::Image::create(parent), &spinner_gif, {.ahead = 4});
+ *
+ * static const void* walk[] = {"A:/walk/0.png", "A:/walk/1.png", "A:/walk/2.png"};
+ * auto anim = lv::AnimImage::create(parent);
+ * lv::frames::predecode(anim, walk, 3);
+ * anim.duration(300).repeat_count(LV_ANIM_REPEAT_INFINITE).start();
+ * @endcode
+ *
+ * frames::cache(lottie) plays a Lottie widget from frames rendered once
+ * (or a few frames ahead) instead of running ThorVG in every frame.
+ *
+ * frames::predecode() decodes file, compressed and indexed AnimImage
+ * sources into pooled buffers in the same idle time and swaps them into
+ * the source array, so the animation no longer goes through a decoder on
+ * every frame change.
+ *
+ * Budget: frame memory is taken from the image cache budget (lowering
+ * lv::image_cache::budget() while held, returned on release), or from
+ * LV_CPP_FRAME_AHEAD_BUDGET when the image cache is disabled. A GIF whose
+ * loop does not fit is played from the ring; an AnimImage frame that does
+ * not fit keeps its original source.
+ *
+ * Threads: all state lives on the UI thread. A loop that does not use
+ * lv::tick() can call frames::run_idle(ms) with the LVGL lock held, e.g.
+ * from a worker thread; Lottie renders go through the widget, so they
+ * cannot run without the lock.
+ *
+ * Heap allocation: NONE in the wrapper (fixed player tables; pixels come
+ * from the DrawBufPool; one lv_timer per playing GIF)
+ */
+
+#include <lvgl.h>
+#include <cstdint>
+#include <cstring>
+#include "app.hpp"
+#include "image_cache.hpp"
+#include "mapped_file.hpp"
+#include "../draw/draw_buf.hpp"
+#include "../widgets/animimage.hpp"
+#include "../widgets/lottie.hpp"
+
+#ifndef LV_CPP_FRAME_AHEAD_PLAYERS
+/// GIFs playing through GifPlayer at once
+#define LV_CPP_FRAME_AHEAD_PLAYERS 4
+#endif
+
+#ifndef LV_CPP_FRAME_AHEAD_FRAMES
+/// Frames per player (ring slots or a cached loop) and per pre-decoded AnimImage
+#define LV_CPP_FRAME_AHEAD_FRAMES 32
+#endif
+
+#ifndef LV_CPP_FRAME_AHEAD_ANIMS
+/// AnimImages with pre-decoded sources at once
+#define LV_CPP_FRAME_AHEAD_ANIMS 4
+#endif
+
+#ifndef LV_CPP_FRAME_AHEAD_LOTTIES
+/// Lottie widgets with a frame cache at once
+#define LV_CPP_FRAME_AHEAD_LOTTIES 2
+#endif
+
+#ifndef LV_CPP_FRAME_AHEAD_LOTTIE_FRAMES
+/// Longest Lottie loop (in frames) that can be cached whole
+#define LV_CPP_FRAME_AHEAD_LOTTIE_FRAMES 120
+#endif
+
+#ifndef LV_CPP_FRAME_AHEAD_BUDGET
+/// Frame bytes allowed when the image cache is disabled
+#define LV_CPP_FRAME_AHEAD_BUDGET (512u * 1024u)
+#endif
+
+namespace lv {
+
+/// GifPlayer::play() options
+struct GifOptions {
+    uint8_t ahead = 2;        ///< frames decoded ahead of the shown one (ring mode)
+    bool cache_loop = true;   ///< keep every frame if the whole loop fits the budget
+    int32_t loops = -1;       ///< plays (0 = forever); -1 uses the file's loop count
+};
+
+/// frames::cache() options for Lottie widgets
+struct LottieCacheOptions {
+    uint8_t ahead = 0;          ///< 0: cache the whole loop if it fits; N: ring of N frames rendered ahead
+    uint32_t max_bytes = 0;     ///< cap for this widget's frames (0: shared budget only)
+    /// Stored format: ARGB8888, ARGB8565 (-25%) or RGB565 for opaque animations (-50%)
+    lv_color_format_t cf = LV_COLOR_FORMAT_ARGB8888;
+};
+
+namespace frames {
+
+/// Memory and scheduling counters
+struct Stats {
+    uint32_t bytes;       ///< frame bytes held against the budget
+    uint32_t players;     ///< GIFs playing
+    uint32_t cached;      ///< of those, with the whole loop cached
+    uint32_t anims;       ///< AnimImages with pre-decoded sources
+    uint32_t lotties;     ///< Lottie widgets playing from a frame cache
+    uint32_t late;        ///< frames decoded by the timer because idle time ran short
+    uint32_t refused;     ///< charges the budget could not cover
+};
+
+namespace detail {
+
+// ==================== Budget ====================
+
+/// Bytes one owner holds, and where they came from
+struct Charge {
+    uint32_t bytes = 0;
+    bool from_cache = false;
+};
+
+struct Counters {
+    uint32_t own_bytes = 0;    ///< charged against LV_CPP_FRAME_AHEAD_BUDGET
+    uint32_t cache_bytes = 0;  ///< taken from the image cache budget
+    uint32_t late = 0;
+    uint32_t refused = 0;
+};
+
+[[nodiscard]] inline Counters& counters() noexcept {
+    static Counters c;
+    return c;
+}
+
+/// Add `bytes` to `c` from the image cache budget (or the own budget); false if it does not fit
+[[nodiscard]] inline bool charge(Charge& c, uint32_t bytes) noexcept {
+    Counters& k = counters();
+    const bool use_cache = c.bytes ? c.from_cache : image_cache::enabled();
+    if (use_cache) {
+        const uint32_t cache = image_cache::budget();
+        // Keep the cache enabled: a budget of 0 switches it off
+        if (cache <= bytes) {
+            ++k.refused;
+            return false;
+        }
+        image_cache::set_budget(cache - bytes, true);
+        k.cache_bytes += bytes;
+    } else {
+        if (k.own_bytes + bytes > LV_CPP_FRAME_AHEAD_BUDGET) {
+            ++k.refused;
+            return false;
+        }
+        k.own_bytes += bytes;
+    }
+    c.bytes += bytes;
+    c.from_cache = use_cache;
+    return true;
+}
+
+/// Return `bytes` (all if larger than held) of `c` to where they came from
+inline void refund(Charge& c, uint32_t bytes = UINT32_MAX) noexcept {
+    if (bytes > c.bytes) bytes = c.bytes;
+    if (!bytes) return;
+    Counters& k = counters();
+    if (c.from_cache) {
+        image_cache::set_budget(image_cache::budget() + bytes, false);
+        k.cache_bytes -= bytes;
+    } else {
+        k.own_bytes -= bytes;
+    }
+    c.bytes -= bytes;
+}
+
+/// Free a frame buffer an image may still reference in the cache
+inline void free_frame(lv_draw_buf_t*& buf) noexcept {
+    if (!buf) return;
+    lv_image_cache_drop(buf);
+    lv_draw_buf_destroy(buf);
+    buf = nullptr;
+}
+
+// ==================== GIF decoding ====================
+
+/// LZW tables and the local color table, shared: one frame decodes at a time
+struct GifScratch {
+    uint16_t prefix[4096];
+    uint8_t suffix[4096];
+    uint8_t stack[4097];
+    lv_color32_t lct[256];
+};
+
+[[nodiscard]] inline GifScratch& gif_scratch() noexcept {
+    static GifScratch s;
+    return s;
+}
+
+/**
+ * @brief GIF87a/89a frame decoder compositing into an ARGB8888 canvas
+ *
+ * Handles global and local palettes, transparency, interlacing and the
+ * "none", "background" (cleared to transparent) and "previous" disposal
+ * methods. The input stays in memory; nothing is copied but the palette.
+ */
+struct GifStream {
+    const uint8_t* data = nullptr;
+    uint32_t size = 0;
+    uint32_t pos = 0;
+    uint32_t first_block = 0;   ///< first block after the global palette
+    uint32_t end = 0;           ///< end of the last complete frame
+    uint16_t w = 0;
+    uint16_t h = 0;
+    uint16_t frames = 0;
+    int32_t loops = -1;         ///< NETSCAPE loop count (0 = forever), -1 if absent
+    bool needs_backup = false;  ///< some frame uses "restore to previous"
+    uint16_t gct_size = 0;
+    lv_color32_t gct[256];
+    // Graphic control of the next image
+    uint16_t delay_cs = 0;
+    int16_t transparent = -1;
+    uint8_t dispose = 0;
+    // Disposal still to apply for the frame on the canvas
+    uint8_t prev_dispose = 0;
+    uint16_t px = 0, py = 0, pw = 0, ph = 0;
+    uint16_t next_index = 0;
+    lv_draw_buf_t* canvas = nullptr;
+    lv_draw_buf_t* backup = nullptr;
+
+    [[nodiscard]] bool has(uint32_t n) const noexcept { return n <= size - pos; }
+    [[nodiscard]] uint16_t le16(uint32_t at) const noexcept {
+        return static_cast<uint16_t>(data[at] | (data[at + 1] << 8));
+    }
+
+    void read_palette(lv_color32_t* pal, uint32_t n) noexcept {
+        for (uint32_t i = 0; i < n; ++i, pos += 3) {
+            pal[i].red = data[pos];
+            pal[i].green = data[pos + 1];
+            pal[i].blue = data[pos + 2];
+            pal[i].alpha = 0xFF;
+        }
+    }
+
+    [[nodiscard]] bool skip_sub_blocks() noexcept {
+        while (has(1)) {
+            const uint8_t n = data[pos++];
+            if (n == 0) return true;
+            if (!has(n)) return false;
+            pos += n;
+        }
+        return false;
+    }
+
+    /// Parse the header and index the frames; false if not a usable GIF
+    [[nodiscard]] bool open(const uint8_t* bytes, uint32_t len) noexcept {
+        data = bytes;
+        size = len;
+        pos = 0;
+        if (!has(13) || (std::memcmp(data, "GIF87a", 6) != 0 && std::memcmp(data, "GIF89a", 6) != 0)) return false;
+        w = le16(6);
+        h = le16(8);
+        const uint8_t packed = data[10];
+        pos = 13;
+        gct_size = 0;
+        if (packed & 0x80) {
+            gct_size = static_cast<uint16_t>(2u << (packed & 7));
+            if (!has(3u * gct_size)) return false;
+            read_palette(gct, gct_size);
+        }
+        first_block = pos;
+        if (w == 0 || h == 0) return false;
+        scan();
+        return frames > 0;
+    }
+
+    void scan() noexcept {
+        frames = 0;
+        end = pos;
+        while (has(1)) {
+            const uint8_t b = data[pos++];
+            if (b == 0x21) {
+                if (!has(1)) break;
+                const uint8_t label = data[pos++];
+                if (label == 0xF9 && has(6) && data[pos] == 4 && ((data[pos + 1] >> 2) & 7) == 3) needs_backup = true;
+                if (label == 0xFF && has(16) && data[pos] == 11 && std::memcmp(data + pos + 1, "NETSCAPE2.0", 11) == 0 &&
+                    data[pos + 12] == 3 && data[pos + 13] == 1) {
+                    loops = le16(pos + 14);
+                }
+                if (!skip_sub_blocks()) break;
+            } else if (b == 0x2C) {
+                if (!has(9)) break;
+                const uint8_t packed = data[pos + 8];
+                pos += 9;
+                const uint32_t lct = packed & 0x80 ? 3u * (2u << (packed & 7)) : 0;
+                if (!has(lct + 1)) break;
+                pos += lct + 1;   // palette and LZW minimum code size
+                if (!skip_sub_blocks()) break;
+                ++frames;
+                end = pos;
+            } else {
+                break;   // trailer, or garbage after the last frame
+            }
+        }
+        pos = first_block;
+    }
+
+    /// Back to the first frame with a transparent canvas
+    void rewind() noexcept {
+        pos = first_block;
+        next_index = 0;
+        prev_dispose = 0;
+        delay_cs = 0;
+        transparent = -1;
+        dispose = 0;
+        if (canvas) std::memset(canvas->data, 0, canvas->data_size);
+    }
+
+    /// Copy (src) or clear (nullptr) a canvas rect, clipped
+    void restore_rect(const lv_draw_buf_t* src, uint32_t x, uint32_t y, uint32_t rw, uint32_t rh) noexcept {
+        if (x >= w || y >= h) return;
+        if (rw > w - x) rw = w - x;
+        if (rh > h - y) rh = h - y;
+        const uint32_t stride = canvas->header.stride;
+        for (uint32_t row = y; row < y + rh; ++row) {
+            uint8_t* dst = canvas->data + row * stride + x * 4;
+            if (src) {
+                std::memcpy(dst, src->data + row * stride + x * 4, rw * 4);
+            } else {
+                std::memset(dst, 0, rw * 4);
+            }
+        }
+    }
+
+    /// Row of the n-th decoded line of an interlaced image
+    [[nodiscard]] static uint32_t interlaced_row(uint32_t n, uint32_t fh) noexcept {
+        const uint32_t p1 = (fh + 7) / 8, p2 = (fh + 3) / 8, p3 = (fh + 1) / 4;
+        if (n < p1) return n * 8;
+        n -= p1;
+        if (n < p2) return 4 + n * 8;
+        n -= p2;
+        if (n < p3) return 2 + n * 4;
+        return 1 + (n - p3) * 2;
+    }
+
+    /// Decode the image data of a frame into the canvas
+    [[nodiscard]] bool decode_image(uint32_t fx, uint32_t fy, uint32_t fw, uint32_t fh, bool interlace,
+                                    const lv_color32_t* pal, uint32_t pal_size) noexcept {
+        GifScratch& s = gif_scratch();
+        if (!has(1)) return false;
+        const uint32_t min_size = data[pos++];
+        if (min_size < 2 || min_size > 8) return false;
+        const uint32_t clear = 1u << min_size, eoi = clear + 1;
+        uint32_t code_size = min_size + 1, mask = (1u << code_size) - 1, avail = clear + 2;
+        int32_t old = -1;
+        uint8_t first = 0;
+        uint32_t datum = 0, bits = 0, block_left = 0;
+        bool blocks_done = false;
+        const uint32_t total = fw * fh, stride = canvas->header.stride;
+        uint32_t written = 0, col = 0, line = 0;
+        uint8_t* row_ptr = nullptr;
+
+        auto row_start = [&]() {
+            const uint32_t y = fy + (interlace ? interlaced_row(line, fh) : line);
+            row_ptr = line < fh && y < h ? canvas->data + y * stride : nullptr;
+        };
+        auto put = [&](uint8_t idx) {
+            const uint32_t x = fx + col;
+            if (row_ptr && x < w && idx != transparent && idx < pal_size) {
+                std::memcpy(row_ptr + x * 4, &pal[idx], 4);
+            }
+            ++written;
+            if (++col == fw) {
+                col = 0;
+                ++line;
+                row_start();
+            }
+        };
+        row_start();
+
+        while (written < total) {
+            while (bits < code_size) {
+                if (block_left == 0) {
+                    if (!has(1)) return false;
+                    block_left = data[pos++];
+                    if (block_left == 0) {
+                        blocks_done = true;
+                        break;
+                    }
+                    if (!has(block_left)) return false;
+                }
+                datum |= static_cast<uint32_t>(data[pos++]) << bits;
+                bits += 8;
+                --block_left;
+            }
+            if (blocks_done) break;
+            uint32_t code = datum & mask;
+            datum >>= code_size;
+            bits -= code_size;
+            if (code == clear) {
+                code_size = min_size + 1;
+                mask = (1u << code_size) - 1;
+                avail = clear + 2;
+                old = -1;
+                continue;
+            }
+            if (code == eoi) break;
+            if (old < 0) {
+                if (code >= clear) return false;
+                first = static_cast<uint8_t>(code);
+                put(first);
+                old = static_cast<int32_t>(code);
+                continue;
+            }
+            const uint32_t in = code;
+            uint32_t sp = 0;
+            if (code >= avail) {
+                if (code > avail) return false;
+                s.stack[sp++] = first;   // KwKwK: the string of `old` plus its own first byte
+                code = static_cast<uint32_t>(old);
+            }
+            while (code >= clear) {
+                s.stack[sp++] = s.suffix[code];
+                code = s.prefix[code];
+            }
+            first = static_cast<uint8_t>(code);
+            s.stack[sp++] = first;
+            if (avail < 4096) {
+                s.prefix[avail] = static_cast<uint16_t>(old);
+                s.suffix[avail] = first;
+                if (++avail > mask && code_size < 12) {
+                    ++code_size;
+                    mask = (1u << code_size) - 1;
+                }
+            }
+            while (sp && written < total) put(s.stack[--sp]);
+            old = static_cast<int32_t>(in);
+        }
+        if (blocks_done) return true;
+        if (!has(block_left)) return false;
+        pos += block_left;
+        return skip_sub_blocks();
+    }
+
+    /**
+     * @brief Composite the next frame onto the canvas (wrapping after the last)
+     * @param delay_ms Display time of the frame
+     * @param index Frame number within the loop
+     */
+    [[nodiscard]] bool next(uint16_t& delay_ms, uint16_t& index) noexcept {
+        for (uint32_t guard = 0; guard < 2; ) {
+            if (pos >= end) {
+                rewind();
+                ++guard;   // a stream without a decodable frame ends here
+            }
+            const uint8_t b = data[pos++];
+            if (b == 0x21) {
+                const uint8_t label = data[pos++];
+                if (label == 0xF9 && has(6) && data[pos] == 4) {
+                    const uint8_t packed = data[pos + 1];
+                    dispose = (packed >> 2) & 7;
+                    delay_cs = le16(pos + 2);
+                    transparent = packed & 1 ? data[pos + 4] : -1;
+                }
+                if (!skip_sub_blocks()) return false;
+                continue;
+            }
+            if (b != 0x2C) {
+                pos = end;
+                continue;
+            }
+            const uint16_t fx = le16(pos), fy = le16(pos + 2), fw = le16(pos + 4), fh = le16(pos + 6);
+            const uint8_t packed = data[pos + 8];
+            pos += 9;
+            const lv_color32_t* pal = gct;
+            uint32_t pal_size = gct_size;
+            if (packed & 0x80) {
+                pal_size = 2u << (packed & 7);
+                read_palette(gif_scratch().lct, pal_size);
+                pal = gif_scratch().lct;
+            }
+            if (prev_dispose == 2) restore_rect(nullptr, px, py, pw, ph);
+            if (prev_dispose == 3 && backup) restore_rect(backup, px, py, pw, ph);
+            if (dispose == 3 && backup) {
+                for (uint32_t row = fy; row < h && row < fy + fh; ++row) {
+                    const uint32_t off = row * canvas->header.stride;
+                    std::memcpy(backup->data + off, canvas->data + off, canvas->header.stride);
+                }
+            }
+            if (fw && fh) {
+                if (!decode_image(fx, fy, fw, fh, packed & 0x40, pal, pal_size)) return false;
+            } else {
+                ++pos;   // empty frame: LZW minimum code size and data are ignored
+                if (!skip_sub_blocks()) return false;
+            }
+            prev_dispose = dispose;
+            px = fx;
+            py = fy;
+            pw = fw;
+            ph = fh;
+            delay_ms = static_cast<uint16_t>(delay_cs > 1 ? delay_cs * 10 : 100);   // 0/1 cs: browsers use 100 ms
+            index = next_index++;
+            delay_cs = 0;
+            transparent = -1;
+            dispose = 0;
+            return true;
+        }
+        return false;
+    }
+};
+
+// ==================== Players ====================
+
+struct Slot {
+    lv_draw_buf_t* buf = nullptr;
+    uint16_t delay_ms = 0;
+    uint16_t index = 0;
+};
+
+struct Player {
+    lv_obj_t* obj = nullptr;
+    lv_timer_t* timer = nullptr;
+    fs::MappedFile file;
+    GifStream gif;
+    Slot slots[LV_CPP_FRAME_AHEAD_FRAMES];
+    uint16_t cap = 0;       ///< ring size, or loop length when cached
+    uint16_t ready = 0;     ///< ring: decoded frames after `shown`; cached: frames decoded
+    uint16_t shown = 0;
+    bool cached = false;
+    bool started = false;
+    int32_t plays = 0;      ///< 0 = forever
+    int32_t loops_left = 0; ///< plays after the current one, <0 forever
+    Charge charge;
+};
+
+struct Anim {
+    lv_obj_t* obj = nullptr;
+    uint8_t count = 0;
+    uint8_t next = 0;       ///< next source to decode
+    const void* srcs[LV_CPP_FRAME_AHEAD_FRAMES] = {};   ///< array lv_animimg reads
+    const void* orig[LV_CPP_FRAME_AHEAD_FRAMES] = {};
+    lv_draw_buf_t* bufs[LV_CPP_FRAME_AHEAD_FRAMES] = {};
+    Charge charge;
+};
+
+#if LV_USE_LOTTIE
+struct LottieFrames {
+    lv_obj_t* obj = nullptr;
+    lv_anim_t* anim = nullptr;
+    lv_anim_exec_xcb_t live = nullptr;   ///< lv_lottie's own (rendering) exec callback
+    int32_t first = 0;                   ///< anim value of frame 0
+    uint16_t frames = 0;
+    uint16_t cap = 0;                    ///< buffers: `frames` when whole, else ahead + 1
+    uint16_t ahead = 0;                  ///< 0 when the whole loop is cached
+    uint16_t sweep = 0;                  ///< next frame the idle pass renders (whole mode)
+    uint16_t current = 0;
+    lv_color_format_t cf = LV_COLOR_FORMAT_ARGB8888;
+    const lv_draw_buf_t* shown = nullptr;
+    lv_draw_buf_t* bufs[LV_CPP_FRAME_AHEAD_LOTTIE_FRAMES] = {};
+    int32_t frame_of[LV_CPP_FRAME_AHEAD_LOTTIE_FRAMES] = {};   ///< ring mode: frame held per buffer, -1 none
+    Charge charge;
+};
+#endif
+
+struct Tables {
+    Player players[LV_CPP_FRAME_AHEAD_PLAYERS];
+    Anim anims[LV_CPP_FRAME_AHEAD_ANIMS];
+#if LV_USE_LOTTIE
+    LottieFrames lotties[LV_CPP_FRAME_AHEAD_LOTTIES];
+#endif
+};
+
+[[nodiscard]] inline Tables& tables() noexcept {
+    static Tables t;
+    return t;
+}
+
+inline bool run(uint32_t budget_ms);
+
+[[nodiscard]] inline uint32_t frame_bytes(const GifStream& g) noexcept {
+    return lv_draw_buf_width_to_stride(g.w, LV_COLOR_FORMAT_ARGB8888) * g.h;
+}
+
+[[nodiscard]] inline lv_draw_buf_t* alloc_frame(const GifStream& g) noexcept {
+    return lv_draw_buf_create_ex(draw::pool_handlers(), g.w, g.h, LV_COLOR_FORMAT_ARGB8888, 0);
+}
+
+/// Drop the decoder state of a player whose loop is fully cached
+inline void release_decoder(Player& p) noexcept {
+    const uint32_t fb = frame_bytes(p.gif);
+    refund(p.charge, fb * ((p.gif.canvas ? 1u : 0u) + (p.gif.backup ? 1u : 0u)));
+    free_frame(p.gif.canvas);
+    free_frame(p.gif.backup);
+    p.file.close();
+    p.gif.data = nullptr;
+}
+
+inline void release_player(Player& p) noexcept {
+    if (!p.obj) return;
+    if (p.timer) lv_timer_delete(p.timer);
+    p.timer = nullptr;
+    for (Slot& s : p.slots) free_frame(s.buf);
+    free_frame(p.gif.canvas);
+    free_frame(p.gif.backup);
+    p.file.close();
+    refund(p.charge);
+    p.gif.data = nullptr;
+    p.obj = nullptr;
+    p.cap = p.ready = p.shown = 0;
+    p.cached = p.started = false;
+}
+
+/// Decode one frame ahead; false if the ring is full or the loop is complete
+inline bool decode_one(Player& p) noexcept {
+    if (!p.gif.data) return false;
+    uint16_t i;
+    if (p.cached) {
+        if (p.ready >= p.cap) return false;
+        i = p.ready;
+    } else {
+        if (p.ready + 1u >= p.cap) return false;
+        i = static_cast<uint16_t>((p.shown + 1u + p.ready) % p.cap);
+    }
+    Slot& s = p.slots[i];
+    uint16_t delay = 0, index = 0;
+    if (!p.gif.next(delay, index)) {
+        LV_LOG_WARN("GifPlayer: corrupt frame, stopping");
+        p.gif.data = nullptr;
+        return false;
+    }
+    lv_image_cache_drop(s.buf);   // in case a cache entry copied the old pixels
+    std::memcpy(s.buf->data, p.gif.canvas->data, p.gif.canvas->data_size);
+    lv_draw_buf_flush_cache(s.buf, nullptr);
+    s.delay_ms = delay;
+    s.index = index;
+    ++p.ready;
+    if (p.cached && p.ready == p.cap) release_decoder(p);
+    return true;
+}
+
+/// Show the next frame; false when the last play has ended
+inline bool advance(Player& p) noexcept {
+    const uint16_t next = static_cast<uint16_t>((p.shown + 1u) % p.cap);
+    if (p.cached ? next >= p.ready : p.ready == 0) {
+        if (p.started) ++counters().late;
+        if (!decode_one(p)) return false;
+    }
+    const Slot& s = p.slots[next];
+    if (s.index == 0 && p.started) {
+        if (p.loops_left == 0) return false;
+        if (p.loops_left > 0) --p.loops_left;
+    }
+    p.started = true;
+    p.shown = next;
+    if (!p.cached) --p.ready;
+    lv_image_set_src(p.obj, s.buf);
+    if (p.timer) lv_timer_set_period(p.timer, s.delay_ms);
+    return true;
+}
+
+inline void player_timer_cb(lv_timer_t* t) {
+    Player& p = *static_cast<Player*>(lv_timer_get_user_data(t));
+    if (advance(p)) return;
+    lv_timer_pause(t);
+    lv_obj_send_event(p.obj, LV_EVENT_READY, nullptr);
+}
+
+inline void reset_loops(Player& p) noexcept { p.loops_left = p.plays == 0 ? -1 : p.plays - 1; }
+
+[[nodiscard]] inline Player* player_of(const lv_obj_t* obj) noexcept {
+    if (!obj) return nullptr;
+    for (Player& p : tables().players) {
+        if (p.obj == obj) return &p;
+    }
+    return nullptr;
+}
+
+[[nodiscard]] inline Anim* anim_of(const lv_obj_t* obj) noexcept {
+    if (!obj) return nullptr;
+    for (Anim& a : tables().anims) {
+        if (a.obj == obj) return &a;
+    }
+    return nullptr;
+}
+
+/// Existing slot of `obj`, else a free one (nullptr if all are taken)
+template<typename T, size_t N>
+[[nodiscard]] T* slot_for(T (&slots)[N], const lv_obj_t* obj) noexcept {
+    T* free_slot = nullptr;
+    for (T& s : slots) {
+        if (s.obj == obj) return &s;
+        if (!s.obj && !free_slot) free_slot = &s;
+    }
+    return free_slot;
+}
+
+/// Put the original sources back and free the decoded ones
+inline void revert_anim(Anim& a) noexcept {
+    for (uint8_t i = 0; i < a.count; ++i) {
+        a.srcs[i] = a.orig[i];
+        free_frame(a.bufs[i]);
+    }
+    refund(a.charge);
+    a.next = a.count;
+}
+
+#if LV_USE_LOTTIE
+[[nodiscard]] inline LottieFrames* lottie_of(const void* obj) noexcept {
+    if (!obj) return nullptr;
+    for (LottieFrames& l : tables().lotties) {
+        if (l.obj == obj) return &l;
+    }
+    return nullptr;
+}
+
+[[nodiscard]] inline uint32_t lottie_frame_bytes(const lv_draw_buf_t* src, lv_color_format_t cf) noexcept {
+    return lv_draw_buf_width_to_stride(src->header.w, cf) * src->header.h;
+}
+
+/// Copy the widget's rendered ARGB8888 frame into `dst`, converting to dst's format
+inline void store_frame(const lv_draw_buf_t* src, lv_draw_buf_t* dst) noexcept {
+    const auto cf = static_cast<lv_color_format_t>(dst->header.cf);
+    const uint32_t w = src->header.w, h = src->header.h;
+    for (uint32_t y = 0; y < h; ++y) {
+        const uint8_t* in = src->data + y * src->header.stride;
+        uint8_t* out = dst->data + y * dst->header.stride;
+        if (cf == static_cast<lv_color_format_t>(src->header.cf)) {
+            std::memcpy(out, in, w * 4);
+            continue;
+        }
+        for (uint32_t x = 0; x < w; ++x, in += 4) {
+            const uint16_t c = static_cast<uint16_t>(((in[2] & 0xF8) << 8) | ((in[1] & 0xFC) << 3) | (in[0] >> 3));
+            *out++ = static_cast<uint8_t>(c);
+            *out++ = static_cast<uint8_t>(c >> 8);
+            if (cf == LV_COLOR_FORMAT_ARGB8565) *out++ = in[3];
+        }
+    }
+    lv_draw_buf_flush_cache(dst, nullptr);
+}
+
+/// Render frame `idx` with lv_lottie's callback and keep it in `slot`
+[[nodiscard]] inline lv_draw_buf_t* render_frame(LottieFrames& l, uint16_t idx, uint16_t slot) noexcept {
+    const lv_draw_buf_t* target = lv_canvas_get_draw_buf(l.obj);
+    if (!target) return nullptr;
+    lv_draw_buf_t*& buf = l.bufs[slot];
+    if (!buf) buf = lv_draw_buf_create_ex(draw::pool_handlers(), target->header.w, target->header.h, l.cf, 0);
+    if (!buf) return nullptr;
+    l.live(l.obj, l.first + idx);
+    lv_image_cache_drop(buf);
+    store_frame(target, buf);
+    if (l.ahead) l.frame_of[slot] = idx;
+    return buf;
+}
+
+/// True if `idx` lies in the window of the shown frame and the `ahead` after it
+[[nodiscard]] inline bool in_window(const LottieFrames& l, int32_t idx) noexcept {
+    return idx >= 0 && static_cast<uint32_t>(idx - l.current + l.frames) % l.frames <= l.ahead;
+}
+
+/// Cached frame `idx`; rendered now if missing and `render`
+[[nodiscard]] inline lv_draw_buf_t* lottie_frame(LottieFrames& l, uint16_t idx, bool render) noexcept {
+    if (!l.ahead) return l.bufs[idx] || !render ? l.bufs[idx] : render_frame(l, idx, idx);
+    uint16_t victim = l.cap;
+    for (uint16_t s = 0; s < l.cap; ++s) {
+        if (l.frame_of[s] == idx) return l.bufs[s];
+        if (victim == l.cap && l.bufs[s] != l.shown && !in_window(l, l.frame_of[s])) victim = s;
+    }
+    return render && victim < l.cap ? render_frame(l, idx, victim) : nullptr;
+}
+
+/// One idle render; false when nothing is missing
+inline bool lottie_step(LottieFrames& l) noexcept {
+    if (!l.ahead) {
+        while (l.sweep < l.frames && l.bufs[l.sweep]) ++l.sweep;
+        return l.sweep < l.frames && render_frame(l, l.sweep, l.sweep);
+    }
+    for (uint16_t k = 1; k <= l.ahead; ++k) {
+        const auto idx = static_cast<uint16_t>((l.current + k) % l.frames);
+        if (!lottie_frame(l, idx, false)) return lottie_frame(l, idx, true) != nullptr;
+    }
+    return false;
+}
+
+/// Exec callback installed on the Lottie's animation: show cached frames
+inline void lottie_exec_cb(void* var, int32_t v) {
+    LottieFrames* l = lottie_of(var);
+    if (!l) return;
+    int32_t idx = v - l->first;
+    if (idx < 0) idx = 0;
+    if (idx >= l->frames) idx = l->frames - 1;
+    l->current = static_cast<uint16_t>(idx);
+    const bool missing = !lottie_frame(*l, l->current, false);
+    lv_draw_buf_t* f = lottie_frame(*l, l->current, true);
+    if (missing && l->shown) ++counters().late;
+    if (!f) {
+        l->live(var, v);   // no buffer to spare: show the live render
+        f = lv_canvas_get_draw_buf(l->obj);
+    }
+    if (f != l->shown) {
+        lv_image_set_src(l->obj, f);
+        l->shown = f;
+    }
+    idle_handler(&run);
+}
+
+inline void release_lottie(LottieFrames& l, bool restore) noexcept {
+    if (!l.obj) return;
+    if (restore) {
+        if (l.anim) lv_anim_set_exec_cb(l.anim, l.live);
+        lv_draw_buf_t* target = lv_canvas_get_draw_buf(l.obj);
+        if (target) {
+            l.live(l.obj, l.first + l.current);
+            lv_image_set_src(l.obj, target);
+        }
+    }
+    for (uint16_t s = 0; s < l.cap; ++s) free_frame(l.bufs[s]);
+    refund(l.charge);
+    l.obj = nullptr;
+    l.anim = nullptr;
+    l.shown = nullptr;
+}
+#endif
+
+inline void delete_cb(lv_event_t* e) {
+    lv_obj_t* obj = static_cast<lv_obj_t*>(lv_event_get_target(e));
+    if (Player* p = player_of(obj)) release_player(*p);
+    if (Anim* a = anim_of(obj)) {
+        revert_anim(*a);
+        a->obj = nullptr;
+    }
+#if LV_USE_LOTTIE
+    if (LottieFrames* l = lottie_of(obj)) release_lottie(*l, false);
+#endif
+}
+
+[[nodiscard]] inline bool needs_decode(const void* src) noexcept {
+    switch (lv_image_src_get_type(src)) {
+    case LV_IMAGE_SRC_FILE:
+        return true;
+    case LV_IMAGE_SRC_VARIABLE: {
+        const lv_image_header_t& h = static_cast<const lv_image_dsc_t*>(src)->header;
+        const auto cf = static_cast<lv_color_format_t>(h.cf);
+        return (h.flags & LV_IMAGE_FLAGS_COMPRESSED) || LV_COLOR_FORMAT_IS_INDEXED(cf) ||
+               cf == LV_COLOR_FORMAT_RAW || cf == LV_COLOR_FORMAT_RAW_ALPHA;
+    }
+    default:
+        return false;
+    }
+}
+
+/// Decode the next source of `a`; an over-budget source ends the pass
+inline void anim_step(Anim& a) noexcept {
+    const uint8_t i = a.next++;
+    if (!needs_decode(a.srcs[i])) return;
+    lv_image_decoder_dsc_t dsc;
+    lv_image_decoder_args_t args{};
+    args.no_cache = true;   // our copy replaces the cache entry
+    if (lv_image_decoder_open(&dsc, a.srcs[i], &args) != LV_RESULT_OK) return;
+    lv_draw_buf_t* buf = nullptr;
+    if (dsc.decoded && charge(a.charge, dsc.decoded->data_size)) {
+        buf = lv_draw_buf_dup_ex(draw::pool_handlers(), dsc.decoded);
+        if (!buf) refund(a.charge, dsc.decoded->data_size);
+    } else if (dsc.decoded) {
+        a.next = a.count;
+    }
+    lv_image_decoder_close(&dsc);
+    if (!buf) return;
+    a.bufs[i] = buf;
+    a.srcs[i] = buf;
+}
+
+inline void hook_delete(lv_obj_t* obj) noexcept {
+    lv_obj_remove_event_cb(obj, &delete_cb);
+    lv_obj_add_event_cb(obj, &delete_cb, LV_EVENT_DELETE, nullptr);
+}
+
+/// Idle handler: fill rings and decode AnimImage sources until `budget_ms` is used
+inline bool run(uint32_t budget_ms) {
+    Tables& t = tables();
+    const uint32_t start = lv_tick_get();
+    bool more = false, active = false;
+    for (Player& p : t.players) {
+        if (!p.obj) continue;
+        active = true;
+        while (lv_tick_elaps(start) < budget_ms && decode_one(p)) {}
+        more |= p.gif.data && (p.cached ? p.ready < p.cap : p.ready + 1u < p.cap);
+    }
+    for (Anim& a : t.anims) {
+        if (!a.obj) continue;
+        while (lv_tick_elaps(start) < budget_ms && a.next < a.count) anim_step(a);
+        more |= a.next < a.count;
+        active |= a.next < a.count;
+    }
+#if LV_USE_LOTTIE
+    for (LottieFrames& l : t.lotties) {
+        if (!l.obj) continue;
+        bool left = true;
+        while (lv_tick_elaps(start) < budget_ms && (left = lottie_step(l))) {}
+        more |= left;
+        active = true;   // ring mode refills after every frame change
+    }
+#endif
+    if (!active) remove_idle_handler(&run);
+    return more;
+}
+
+} // namespace detail
+
+/**
+ * @brief Play pre-decoded sources through an AnimImage
+ *
+ * Sets `srcs` at once, then decodes file, compressed and indexed sources
+ * into pooled buffers at idle time and swaps each into the array the
+ * widget reads. Calling again for the same widget releases the previous
+ * buffers. Falls back to AnimImage::src() when all slots are taken or
+ * `count` exceeds LV_CPP_FRAME_AHEAD_FRAMES.
+ *
+ * @return true if the sources are being pre-decoded
+ */
+inline bool predecode(AnimImage img, const void* const srcs[], uint8_t count) noexcept {
+    lv_obj_t* obj = img.get();
+    if (!obj) return false;
+    detail::Anim* a = detail::slot_for(detail::tables().anims, obj);
+    if (a && a->obj) {
+        detail::revert_anim(*a);
+        a->obj = nullptr;
+    }
+    if (!a || count > LV_CPP_FRAME_AHEAD_FRAMES) {
+        LV_LOG_WARN("frames::predecode: no slot for %u sources (LV_CPP_FRAME_AHEAD_ANIMS/_FRAMES)",
+                    static_cast<unsigned>(count));
+        img.src(const_cast<const void**>(srcs), count);
+        return false;
+    }
+    a->obj = obj;
+    a->count = count;
+    a->next = 0;
+    for (uint8_t i = 0; i < count; ++i) {
+        a->srcs[i] = a->orig[i] = srcs[i];
+        a->bufs[i] = nullptr;
+    }
+    detail::hook_delete(obj);
+    lv_animimg_set_src(obj, a->srcs, count);
+    idle_handler(&detail::run);
+    return true;
+}
+
+/**
+ * @brief Free the pre-decoded buffers of `img`; it plays its original sources again
+ *
+ * The slot stays bound to the widget (which still reads its source array)
+ * until the widget is deleted.
+ */
+inline void release(AnimImage img) noexcept {
+    if (detail::Anim* a = detail::anim_of(img.get())) detail::revert_anim(*a);
+}
+
+#if LV_USE_LOTTIE
+/**
+ * @brief Play a Lottie widget from pre-rendered frames
+ *
+ * Takes over the exec callback of the widget's animation, so duration,
+ * repeat, pause and resume keep working. Each frame value shows a cached
+ * buffer; lv_lottie's renderer only runs to fill the cache, at idle time,
+ * or at once when the shown frame is missing (counted in Stats::late).
+ *
+ * With `opt.ahead == 0` the whole loop is cached if it has at most
+ * LV_CPP_FRAME_AHEAD_LOTTIE_FRAMES frames and fits `opt.max_bytes` and the
+ * budget; otherwise (or with `opt.ahead > 0`) a ring of ahead + 1 buffers
+ * holds the shown frame and the next ones, rendered in idle time (2 if
+ * ahead is 0). Call after buffer() and src_*(); call again after changing
+ * the source.
+ *
+ * @return false if the widget has no buffer or animation, no slot is free
+ *         or not even a two-frame ring fits; it then keeps rendering live
+ */
+inline bool cache(Lottie lottie, const LottieCacheOptions& opt = {}) noexcept {
+    using namespace detail;
+    lv_obj_t* obj = lottie.get();
+    lv_anim_t* anim = obj ? lottie.get_anim() : nullptr;
+    const lv_draw_buf_t* target = obj ? lv_canvas_get_draw_buf(obj) : nullptr;
+    if (!anim || !target) return false;
+    LottieFrames* l = slot_for(tables().lotties, obj);
+    if (l && l->obj) release_lottie(*l, true);
+    if (!l) {
+        LV_LOG_WARN("frames::cache: no slot, raise LV_CPP_FRAME_AHEAD_LOTTIES");
+        return false;
+    }
+    lv_color_format_t cf = opt.cf;
+    const auto src_cf = static_cast<lv_color_format_t>(target->header.cf);
+    if (cf != src_cf && (src_cf != LV_COLOR_FORMAT_ARGB8888 ||
+                         (cf != LV_COLOR_FORMAT_ARGB8565 && cf != LV_COLOR_FORMAT_RGB565))) {
+        cf = src_cf;   // only straight ARGB8888 renders convert
+    }
+    const int32_t lo = anim->start_value < anim->end_value ? anim->start_value : anim->end_value;
+    const int32_t hi = anim->start_value < anim->end_value ? anim->end_value : anim->start_value;
+    const uint32_t frames = static_cast<uint32_t>(hi - lo + 1);
+    const uint32_t fb = lottie_frame_bytes(target, cf);
+    auto fits = [&](uint32_t n) {
+        return (!opt.max_bytes || fb * n <= opt.max_bytes) && charge(l->charge, fb * n);
+    };
+    uint32_t ahead = opt.ahead;
+    if (ahead == 0 && (frames > LV_CPP_FRAME_AHEAD_LOTTIE_FRAMES || !fits(frames))) ahead = 2;
+    if (ahead) {
+        if (ahead > LV_CPP_FRAME_AHEAD_LOTTIE_FRAMES - 1u) ahead = LV_CPP_FRAME_AHEAD_LOTTIE_FRAMES - 1u;
+        if (ahead >= frames) ahead = frames - 1;
+        while (ahead > 1 && !fits(ahead + 1)) --ahead;
+        if (ahead < 1 || (!l->charge.bytes && !fits(ahead + 1))) {
+            LV_LOG_WARN("frames::cache: %u byte frames do not fit, rendering live", static_cast<unsigned>(fb));
+            return false;
+        }
+    }
+    l->obj = obj;
+    l->anim = anim;
+    l->live = anim->exec_cb;
+    l->first = lo;
+    l->frames = static_cast<uint16_t>(frames);
+    l->ahead = static_cast<uint16_t>(ahead);
+    l->cap = static_cast<uint16_t>(ahead ? ahead + 1 : frames);
+    l->sweep = 0;
+    l->cf = cf;
+    l->shown = nullptr;
+    l->current = static_cast<uint16_t>(anim->current_value - lo < 0 ? 0 : anim->current_value - lo);
+    if (l->current >= l->frames) l->current = 0;
+    for (uint16_t s = 0; s < l->cap; ++s) {
+        l->bufs[s] = nullptr;
+        l->frame_of[s] = -1;
+    }
+    hook_delete(obj);
+    lv_anim_set_exec_cb(anim, &lottie_exec_cb);
+    lottie_exec_cb(obj, lo + l->current);
+    return true;
+}
+
+/// Stop using the frame cache of `lottie` and free it; the widget renders live again
+inline void uncache(Lottie lottie) noexcept {
+    if (detail::LottieFrames* l = detail::lottie_of(lottie.get())) detail::release_lottie(*l, true);
+}
+#endif
+
+/**
+ * @brief Do up to `budget_ms` of decode-ahead work (called by lv::tick() when idle)
+ * @return true while work is left
+ */
+inline bool run_idle(uint32_t budget_ms) { return detail::run(budget_ms); }
+
+[[nodiscard]] inline Stats stats() noexcept {
+    const detail::Counters& k = detail::counters();
+    Stats s{k.own_bytes + k.cache_bytes, 0, 0, 0, k.late, k.refused};
+    for (const detail::Player& p : detail::tables().players) {
+        s.players += p.obj != nullptr;
+        s.cached += p.obj && p.cached;
+    }
+    for (const detail::Anim& a : detail::tables().anims) s.anims += a.obj && a.count;
+#if LV_USE_LOTTIE
+    for (const detail::LottieFrames& l : detail::tables().lotties) s.lotties += l.obj != nullptr;
+#endif
+    return s;
+}
+
+} // namespace frames
+
+/**
+ * @brief GIF playback from pre-decoded frames into an image object
+ *
+ * Handle to a player slot keyed by the image object; the slot is freed
+ * when the image is deleted or stop() is called. Sends LV_EVENT_READY to
+ * the image after the last play, like lv_gif.
+ */
+class GifPlayer {
+    lv_obj_t* m_obj = nullptr;
+
+    explicit GifPlayer(lv_obj_t* obj) noexcept : m_obj(obj) {}
+
+    [[nodiscard]] frames::detail::Player* slot() const noexcept { return frames::detail::player_of(m_obj); }
+
+public:
+    GifPlayer() noexcept = default;
+
+    /**
+     * @brief Start playing `src` (file path or lv_image_dsc_t with GIF bytes) in `image`
+     *
+     * Decodes and shows the first frame before returning. The whole loop is
+     * cached if `opt.cache_loop`, it has at most LV_CPP_FRAME_AHEAD_FRAMES
+     * frames and the budget covers it; otherwise `opt.ahead` frames are
+     * decoded ahead (fewer if the budget is short, at least one).
+     *
+     * @return Invalid handle if the source is not a GIF or no slot is free
+     */
+    [[nodiscard]] static GifPlayer play(ObjectView image, const void* src, const GifOptions& opt = {}) noexcept {
+        using namespace frames::detail;
+        lv_obj_t* obj = image.get();
+        Player* p = obj ? slot_for(tables().players, obj) : nullptr;
+        if (p) release_player(*p);
+        if (!p || !src) {
+            LV_LOG_WARN("GifPlayer: no free player, raise LV_CPP_FRAME_AHEAD_PLAYERS");
+            return GifPlayer();
+        }
+        const uint8_t* bytes = nullptr;
+        uint32_t len = 0;
+        if (lv_image_src_get_type(src) == LV_IMAGE_SRC_FILE) {
+            if (p->file.open(static_cast<const char*>(src)) == LV_FS_RES_OK) {
+                bytes = p->file.data();
+                len = static_cast<uint32_t>(p->file.size());
+            }
+        } else if (lv_image_src_get_type(src) == LV_IMAGE_SRC_VARIABLE) {
+            bytes = static_cast<const lv_image_dsc_t*>(src)->data;
+            len = static_cast<const lv_image_dsc_t*>(src)->data_size;
+        }
+        GifStream& g = p->gif;
+        g = GifStream{};
+        if (!bytes || !g.open(bytes, len)) {
+            LV_LOG_WARN("GifPlayer: source is not a readable GIF");
+            p->file.close();
+            return GifPlayer();
+        }
+        p->obj = obj;
+        const uint32_t fb = frame_bytes(g);
+        const uint32_t work = 1u + (g.needs_backup ? 1u : 0u);
+        p->cached = g.frames == 1 ||
+                    (opt.cache_loop && g.frames <= LV_CPP_FRAME_AHEAD_FRAMES && charge(p->charge, fb * (g.frames + work)));
+        if (p->cached) {
+            p->cap = g.frames;
+        } else {
+            uint32_t ahead = opt.ahead ? opt.ahead : 1;
+            if (ahead > LV_CPP_FRAME_AHEAD_FRAMES - 1u) ahead = LV_CPP_FRAME_AHEAD_FRAMES - 1u;
+            while (ahead > 1 && !charge(p->charge, fb * (ahead + 1 + work))) --ahead;
+            if (ahead == 1 && !p->charge.bytes && !charge(p->charge, fb * (2 + work))) {
+                LV_LOG_WARN("GifPlayer: frame budget exhausted, playing over budget");
+            }
+            p->cap = static_cast<uint16_t>(ahead + 1);
+        }
+        g.canvas = alloc_frame(g);
+        g.backup = g.needs_backup ? alloc_frame(g) : nullptr;
+        bool ok = g.canvas && (!g.needs_backup || g.backup);
+        for (uint16_t i = 0; ok && i < p->cap; ++i) {
+            p->slots[i].buf = alloc_frame(g);
+            ok = p->slots[i].buf != nullptr;
+        }
+        if (!ok) {
+            LV_LOG_WARN("GifPlayer: out of memory for %ux%u frames", static_cast<unsigned>(g.w), static_cast<unsigned>(g.h));
+            release_player(*p);
+            return GifPlayer();
+        }
+        g.rewind();
+        hook_delete(obj);
+        p->plays = opt.loops >= 0 ? opt.loops : (g.loops < 0 ? 1 : g.loops);
+        reset_loops(*p);
+        p->shown = static_cast<uint16_t>(p->cap - 1);
+        if (!advance(*p)) {
+            release_player(*p);
+            return GifPlayer();
+        }
+        if (g.frames > 1) p->timer = lv_timer_create(&player_timer_cb, p->slots[p->shown].delay_ms, p);
+        idle_handler(&run);
+        return GifPlayer(obj);
+    }
+
+    [[nodiscard]] bool valid() const noexcept { return slot() != nullptr; }
+    explicit operator bool() const noexcept { return valid(); }
+
+    [[nodiscard]] lv_obj_t* image() const noexcept { return m_obj; }
+
+    void pause() noexcept {
+        if (auto* p = slot(); p && p->timer) lv_timer_pause(p->timer);
+    }
+
+    void resume() noexcept {
+        if (auto* p = slot(); p && p->timer) lv_timer_resume(p->timer);
+    }
+
+    /// Back to the first frame with the loop count reset
+    void restart() noexcept {
+        auto* p = slot();
+        if (!p || !p->timer) return;
+        if (!p->cached) {
+            p->gif.rewind();
+            p->ready = 0;
+        }
+        p->started = false;
+        frames::detail::reset_loops(*p);
+        p->shown = static_cast<uint16_t>(p->cap - 1);
+        if (frames::detail::advance(*p)) lv_timer_resume(p->timer);
+    }
+
+    /// Stop, clear the image source and free all frames
+    void stop() noexcept {
+        auto* p = slot();
+        if (!p) return;
+        lv_image_set_src(p->obj, nullptr);
+        frames::detail::release_player(*p);
+    }
+
+    /// True once every frame of the loop is decoded and the decoder is released
+    [[nodiscard]] bool fully_cached() const noexcept {
+        auto* p = slot();
+        return p && p->cached && p->ready == p->cap;
+    }
+
+    /// Frames per loop
+    [[nodiscard]] uint32_t frame_count() const noexcept {
+        auto* p = slot();
+        return p ? (p->cached ? p->cap : p->gif.frames) : 0;
+    }
+
+    /// Bytes held against the budget
+    [[nodiscard]] uint32_t bytes() const noexcept {
+        auto* p = slot();
+        return p ? p->charge.bytes : 0;
+    }
+};
+
+} // namespace lv
@@ -0,0 +1,308 @@
+#pragma once
+
+/**
+ * @file frame_arena.hpp
+ * @brief Per-frame bump allocator for draw descriptors and temporary strings
+ *
+ * Draw event handlers build descriptors and formatted strings that only
+ * have to live until the frame is rendered. FrameArena hands them out from
+ * one block by bumping a pointer, and the whole block is reset when the
+ * next refresh of an attached display starts (LV_EVENT_REFR_START), so
+ * there is nothing to free and nothing to fragment.
+ *
+ * @code
+ * lv::FrameArena::instance().attach(lv_display_get_default());
+ *
+ * void on_draw(lv::Event e) {
+ *     auto& arena = lv::FrameArena::instance();
+ *     auto* pts = arena.make_array<lv_point_precise_t>(64);
+ *     lv::LabelDsc dsc;
+ *     dsc.text_fmt("%d rpm", rpm);                // formatted into the arena
+ *     std::pmr::vector<int> tmp(&arena);          // any pmr container
+ * }
+ * @endcode
+ *
+ * Memory from the arena is valid until the next reset: data handed to
+ * draw tasks during a refresh outlives the tasks. A request that does not
+ * fit the block goes to an overflow block; overflow blocks are freed at
+ * reset and the main block grows to the frame's high-water mark, so a
+ * steady frame ends up in one block. mark() / rewind() give scoped use
+ * outside frames; rewind() also frees the overflow blocks made since.
+ *
+ * Not thread-safe: use it from the LVGL thread.
+ *
+ * Heap allocation: the block (LV_CPP_FRAME_ARENA_BYTES, lv_malloc on first
+ * use, grown at reset) and overflow blocks; NONE per allocation
+ */
+
+#include <lvgl.h>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <string_view>
+#include <type_traits>
+
+#if !defined(LV_CPP_FRAME_ARENA_PMR)
+#if __has_include(<memory_resource>)
+#define LV_CPP_FRAME_ARENA_PMR 1
+#else
+#define LV_CPP_FRAME_ARENA_PMR 0
+#endif
+#endif
+
+#if LV_CPP_FRAME_ARENA_PMR
+#include <memory_resource>
+#endif
+
+namespace lv {
+
+#ifndef LV_CPP_FRAME_ARENA_BYTES
+/// Initial size of the FrameArena::instance() block
+#define LV_CPP_FRAME_ARENA_BYTES (16 * 1024)
+#endif
+
+/**
+ * @brief Bump allocator reset at the start of each refresh
+ *
+ * Also a std::pmr::memory_resource (unless LV_CPP_FRAME_ARENA_PMR is 0);
+ * deallocate() only reclaims the most recent allocation.
+ */
+class FrameArena
+#if LV_CPP_FRAME_ARENA_PMR
+    : public std::pmr::memory_resource
+#endif
+{
+public:
+    struct Stats {
+        uint32_t resets = 0;
+        uint32_t allocs = 0;
+        uint32_t overflows = 0;     ///< Allocations that did not fit the block
+        uint32_t failures = 0;      ///< Allocations lv_malloc could not serve
+        uint32_t capacity = 0;      ///< Size of the block
+        uint32_t used = 0;          ///< Bytes used this frame (block + overflow)
+        uint32_t high_water = 0;    ///< Most bytes used in one frame
+    };
+
+    /// Position to rewind() to
+    struct Marker {
+        size_t used;
+        void* overflow;
+    };
+
+private:
+    struct Overflow {
+        Overflow* next;
+        size_t bytes;    ///< Counted in m_frame
+    };
+
+    uint8_t* m_base = nullptr;
+    size_t m_cap;
+    size_t m_used = 0;
+    Overflow* m_overflow = nullptr;
+    size_t m_frame = 0;    ///< Bytes handed out since the last reset
+    Stats m_stats;
+
+    [[nodiscard]] static size_t align_up(size_t v, size_t a) noexcept { return (v + a - 1) & ~(a - 1); }
+
+    [[nodiscard]] void* overflow_alloc(size_t bytes, size_t align) noexcept {
+        const size_t head = align_up(sizeof(Overflow), align);
+        auto* o = static_cast<Overflow*>(lv_malloc(head + bytes));
+        if (!o) return nullptr;
+        o->next = m_overflow;
+        o->bytes = bytes;
+        m_overflow = o;
+        ++m_stats.overflows;
+        return reinterpret_cast<uint8_t*>(o) + head;
+    }
+
+    static void refr_start_cb(lv_event_t* e) noexcept {
+        static_cast<FrameArena*>(lv_event_get_user_data(e))->reset();
+    }
+
+public:
+    explicit FrameArena(size_t capacity = LV_CPP_FRAME_ARENA_BYTES) noexcept : m_cap(capacity) {}
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    ~FrameArena() {
+        reset();
+        lv_free(m_base);
+    }
+
+    /// The shared per-frame arena (never destroyed, so no lv_free() after lv_deinit())
+    [[nodiscard]] static FrameArena& instance() noexcept {
+        alignas(FrameArena) static unsigned char storage[sizeof(FrameArena)];
+        static FrameArena* arena = new (storage) FrameArena();
+        return *arena;
+    }
+
+    // ==================== Frames ====================
+
+    /// Reset whenever `disp` starts a refresh
+    FrameArena& attach(lv_display_t* disp) noexcept {
+        if (!disp) return *this;
+        lv_display_remove_event_cb_with_user_data(disp, &refr_start_cb, this);
+        lv_display_add_event_cb(disp, &refr_start_cb, LV_EVENT_REFR_START, this);
+        return *this;
+    }
+
+    FrameArena& detach(lv_display_t* disp) noexcept {
+        if (disp) lv_display_remove_event_cb_with_user_data(disp, &refr_start_cb, this);
+        return *this;
+    }
+
+    /// Release everything; grows the block to the frame's high-water mark if it overflowed
+    void reset() noexcept {
+        const bool overflowed = m_overflow != nullptr;
+        while (m_overflow) {
+            Overflow* next = m_overflow->next;
+            lv_free(m_overflow);
+            m_overflow = next;
+        }
+        if (overflowed && m_frame > m_cap) {
+            lv_free(m_base);
+            m_base = nullptr;
+            m_cap = align_up(m_frame, 1024);
+        }
+        m_used = 0;
+        m_frame = 0;
+        m_stats.used = 0;
+        ++m_stats.resets;
+    }
+
+    [[nodiscard]] Marker mark() const noexcept { return {m_used, m_overflow}; }
+
+    /// Give back everything allocated after `m`, overflow blocks included (no-op after a reset)
+    void rewind(const Marker& m) noexcept {
+        for (Overflow* o = m_overflow; o != m.overflow; o = o->next) {
+            if (!o) return;    // m's overflow block was freed by reset()
+        }
+        if (m.used > m_used) return;
+        while (m_overflow != m.overflow) {
+            Overflow* next = m_overflow->next;
+            m_frame -= m_overflow->bytes;
+            lv_free(m_overflow);
+            m_overflow = next;
+        }
+        m_frame -= m_used - m.used;
+        m_stats.used = static_cast<uint32_t>(m_frame);
+        m_used = m.used;
+    }
+
+    // ==================== Allocation ====================
+
+    /// `bytes` aligned to `align` (a power of two); nullptr only when lv_malloc fails
+    [[nodiscard]] void* alloc(size_t bytes, size_t align = alignof(std::max_align_t)) noexcept {
+        if (!m_base && m_cap) {
+            m_base = static_cast<uint8_t*>(lv_malloc(m_cap));
+            if (!m_base) m_cap = 0;
+            m_stats.capacity = static_cast<uint32_t>(m_cap);
+        }
+        ++m_stats.allocs;
+        void* p = nullptr;
+        const size_t at = align_up(reinterpret_cast<uintptr_t>(m_base) + m_used, align) -
+                          reinterpret_cast<uintptr_t>(m_base);
+        if (m_base && at + bytes <= m_cap) {
+            p = m_base + at;
+            m_frame += at + bytes - m_used;    // padding included, so rewind() balances
+            m_used = at + bytes;
+        } else {
+            p = overflow_alloc(bytes, align);
+            if (p) m_frame += bytes;
+        }
+        if (!p) {
+            ++m_stats.failures;
+            return nullptr;
+        }
+        m_stats.used = static_cast<uint32_t>(m_frame);
+        if (m_stats.used > m_stats.high_water) m_stats.high_water = m_stats.used;
+        return p;
+    }
+
+    /// Construct a T in the arena; its destructor never runs
+    template <typename T, typename... Args>
+    [[nodiscard]] T* make(Args&&... args) noexcept {
+        static_assert(std::is_trivially_destructible_v<T>, "FrameArena never runs destructors");
+        void* p = alloc(sizeof(T), alignof(T));
+        return p ? new (p) T(static_cast<Args&&>(args)...) : nullptr;
+    }
+
+    /// `n` value-initialized Ts
+    template <typename T>
+    [[nodiscard]] T* make_array(size_t n) noexcept {
+        static_assert(std::is_trivially_destructible_v<T>, "FrameArena never runs destructors");
+        void* p = alloc(sizeof(T) * n, alignof(T));
+        if (!p) return nullptr;
+        T* a = static_cast<T*>(p);
+        for (size_t i = 0; i < n; ++i) new (a + i) T();
+        return a;
+    }
+
+    /// Null-terminated copy of `sv`
+    [[nodiscard]] char* copy(std::string_view sv) noexcept {
+        auto* s = static_cast<char*>(alloc(sv.size() + 1, 1));
+        if (!s) return nullptr;
+        std::memcpy(s, sv.data(), sv.size());
+        s[sv.size()] = '\0';
+        return s;
+    }
+
+    /// printf-style formatting into the arena (lv_vsnprintf)
+    [[nodiscard]] const char* vformat(const char* fmt, va_list args) noexcept {
+        va_list again;
+        va_copy(again, args);
+        const int n = lv_vsnprintf(nullptr, 0, fmt, args);
+        char* s = n >= 0 ? static_cast<char*>(alloc(static_cast<size_t>(n) + 1, 1)) : nullptr;
+        if (s) lv_vsnprintf(s, static_cast<size_t>(n) + 1, fmt, again);
+        va_end(again);
+        return s;
+    }
+
+    [[nodiscard]] const char* format(const char* fmt, ...) noexcept {
+        va_list args;
+        va_start(args, fmt);
+        const char* s = vformat(fmt, args);
+        va_end(args);
+        return s;
+    }
+
+    // ==================== Stats ====================
+
+    [[nodiscard]] Stats stats() const noexcept { return m_stats; }
+
+    void reset_stats() noexcept {
+        const Stats keep = m_stats;
+        m_stats = Stats{};
+        m_stats.capacity = keep.capacity;
+        m_stats.used = keep.used;
+    }
+
+#if LV_CPP_FRAME_ARENA_PMR
+protected:
+    void* do_allocate(size_t bytes, size_t align) override {
+        void* p = alloc(bytes, align);
+#if defined(__cpp_exceptions)
+        if (!p) throw std::bad_alloc();
+#endif
+        return p;
+    }
+
+    /// Only the last allocation of the block can be given back
+    void do_deallocate(void* p, size_t bytes, size_t) override {
+        if (m_base && static_cast<uint8_t*>(p) + bytes == m_base + m_used) {
+            m_used -= bytes;
+            m_frame -= bytes;
+            m_stats.used = static_cast<uint32_t>(m_frame);
+        }
+    }
+
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+#endif
+};
+
+} // namespace lv
@@ -0,0 +1,309 @@
+#pragma once
+
+/**
+ * @file frame_pacing.hpp
+ * @brief Per-display frame budgets so displays sharing one LVGL loop interleave
+ *
+ * Two displays driven by one lv_timer_handler() refresh in turn: a heavy
+ * frame on the main display delays the instrument cluster's next frame
+ * by its whole render time. A paced display renders at most `budget_us`
+ * worth of invalidated pixels per refresh:
+ *
+ * - at REFR_START the invalidated areas are kept in order until the
+ *   budget is used up; an area that does not fit is cut into a band of
+ *   rows that does (at least `min_rows`) and the remainder;
+ * - the areas left over are invalidated again at REFR_READY, ahead of any
+ *   new ones, so the next refresh starts with them;
+ * - between the two refreshes lv_timer_handler() runs the other
+ *   display's refresh timer, which no longer waits behind a full heavy
+ *   frame.
+ *
+ * The pixels per budget come from the display's own measured render cost
+ * (time between RENDER_START and RENDER_READY per rendered pixel, moving
+ * average), so the cut follows what the content costs to draw.
+ *
+ * @code
+ * #include <lv/core/frame_pacing.hpp>
+ *
+ * lv::Display main_disp = ..., cluster = ...;
+ * lv::frame_pacing::enable(main_disp, {.budget_us = 8000});   // main may take at most ~8 ms per refresh
+ * lv::frame_pacing::enable(cluster, {.budget_us = 0});        // not cut, frame statistics only
+ * ...
+ * lv::frame_pacing::Stats s = lv::frame_pacing::stats(cluster);
+ * // s.late_frames, s.interval_max_ms, s.render_max_us ...
+ * @endcode
+ *
+ * Only LV_DISPLAY_RENDER_MODE_PARTIAL displays are cut (in direct and
+ * full mode a frame is one buffer and cannot be spread over refreshes);
+ * others still get statistics. A large animated area spread over several
+ * refreshes shows its parts from consecutive frames, which is the price
+ * of the interleaving.
+ *
+ * Rendering on one thread per display is not offered: LVGL's object tree,
+ * animations, timers and draw units are shared by all displays, so two
+ * refreshes cannot run at once under one LVGL instance. Render threads
+ * (LV_DRAW_SW_DRAW_UNIT_CNT, tile_render.hpp) parallelize inside a refresh.
+ *
+ * Not included by lv.hpp: it rewrites lv_display_t's inv_areas and inv_p
+ * and reads render_mode, none of which has a public accessor that works
+ * mid-refresh. Checked against LVGL 9.4 (see LV_CPP_INTERNALS_OK).
+ *
+ * Heap allocation: NONE (LV_CPP_PACED_DISPLAYS fixed slots; LVGL
+ * allocates the event descriptors)
+ */
+
+#include <lvgl.h>
+#include "version.hpp"
+
+#if !LV_CPP_INTERNALS_OK
+#error "frame_pacing.hpp reads LVGL internals checked against LVGL 9.4; see LV_CPP_INTERNALS_OK"
+#endif
+
+#include <src/display/lv_display_private.h>   // inv_areas, inv_p, render_mode
+#include <chrono>
+#include <cstdint>
+
+#ifndef LV_CPP_PACED_DISPLAYS
+/// Displays with frame pacing or frame statistics at once
+#define LV_CPP_PACED_DISPLAYS 2
+#endif
+
+namespace lv {
+
+/// Per-refresh budget of frame_pacing::enable()
+struct PacingConfig {
+    uint32_t budget_us = 8000;   ///< Render time per refresh (0: never cut, statistics only)
+    uint16_t min_rows = 16;      ///< Smallest band an area is cut into
+};
+
+namespace frame_pacing {
+
+/// Frame statistics of a display
+struct Stats {
+    uint32_t frames;           ///< Refreshes that rendered something
+    uint32_t cut_frames;       ///< Of these, refreshes that left areas for the next one
+    uint32_t deferred_areas;   ///< Areas (or remainders) moved to the next refresh
+    uint32_t late_frames;      ///< Frames more than two refresh periods after the previous one
+    uint32_t interval_max_ms;  ///< Longest time between two frames
+    uint32_t render_avg_us;    ///< Average render time of a frame
+    uint32_t render_max_us;
+    uint32_t ns_per_px;        ///< Measured render cost used to size the budget
+    uint64_t pixels;           ///< Pixels rendered
+};
+
+namespace detail {
+
+struct Hook {
+    lv_display_t* disp = nullptr;    ///< nullptr: free slot
+    PacingConfig cfg{};
+    lv_area_t deferred[LV_INV_BUF_SIZE] = {};
+    uint32_t deferred_n = 0;
+    uint64_t render_start = 0;
+    uint64_t render_us = 0;          ///< Sum over `stats.frames`
+    uint32_t frame_px = 0;
+    uint32_t last_frame = 0;         ///< lv_tick_get() of the previous frame
+    bool drew = false;
+    Stats stats{};
+};
+
+[[nodiscard]] inline Hook* hooks() noexcept {
+    static Hook h[LV_CPP_PACED_DISPLAYS];
+    return h;
+}
+
+[[nodiscard]] inline Hook* find(lv_display_t* disp) noexcept {
+    Hook* h = hooks();
+    for (uint32_t i = 0; i < LV_CPP_PACED_DISPLAYS; ++i) {
+        if (h[i].disp == disp) return &h[i];
+    }
+    return nullptr;
+}
+
+[[nodiscard]] inline uint64_t now_us() noexcept {
+    using namespace std::chrono;
+    return static_cast<uint64_t>(duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+[[nodiscard]] inline uint32_t area_px(const lv_area_t& a) noexcept {
+    return static_cast<uint32_t>(lv_area_get_width(&a)) * static_cast<uint32_t>(lv_area_get_height(&a));
+}
+
+inline void defer(Hook& h, const lv_area_t& a) noexcept {
+    if (h.deferred_n < LV_INV_BUF_SIZE) {
+        h.deferred[h.deferred_n++] = a;
+    } else {
+        // Out of room: fold into the last deferred area
+        lv_area_t& last = h.deferred[h.deferred_n - 1];
+        lv_area_join(&last, &last, &a);
+    }
+    ++h.stats.deferred_areas;
+}
+
+/// Keep the areas that fit the budget, in order; defer the rest
+inline void refr_start_cb(lv_event_t* e) noexcept {
+    auto* disp = static_cast<lv_display_t*>(lv_event_get_current_target(e));
+    Hook* h = find(disp);
+    if (!h || disp->inv_p == 0) return;
+    if (h->cfg.budget_us == 0 || h->stats.ns_per_px == 0) return;
+    if (disp->render_mode != LV_DISPLAY_RENDER_MODE_PARTIAL) return;
+
+    const uint64_t budget_px = static_cast<uint64_t>(h->cfg.budget_us) * 1000 / h->stats.ns_per_px;
+    uint64_t used = 0;
+    uint32_t kept = 0;
+    const uint32_t n = disp->inv_p;
+    for (uint32_t i = 0; i < n; ++i) {
+        const lv_area_t a = disp->inv_areas[i];
+        const uint32_t px = area_px(a);
+        if (kept == 0 || used + px <= budget_px) {
+            if (used + px > budget_px) {
+                // The first area alone is over budget: render a band of it now
+                const int32_t w = lv_area_get_width(&a);
+                int32_t rows = static_cast<int32_t>(budget_px / static_cast<uint64_t>(w));
+                if (rows < h->cfg.min_rows) rows = h->cfg.min_rows;
+                if (rows < lv_area_get_height(&a)) {
+                    lv_area_t band = a;
+                    band.y2 = a.y1 + rows - 1;
+                    lv_area_t rest = a;
+                    rest.y1 = band.y2 + 1;
+                    disp->inv_areas[kept] = band;
+                    disp->inv_area_joined[kept++] = 0;
+                    defer(*h, rest);
+                    used = budget_px;
+                    continue;
+                }
+            }
+            disp->inv_areas[kept] = a;
+            disp->inv_area_joined[kept++] = 0;
+            used += px;
+        } else {
+            defer(*h, a);
+        }
+    }
+    disp->inv_p = kept;
+    if (h->deferred_n) ++h->stats.cut_frames;
+}
+
+/// Pixels LVGL is about to render (after joining) and the start time
+inline void render_start_cb(lv_event_t* e) noexcept {
+    auto* disp = static_cast<lv_display_t*>(lv_event_get_current_target(e));
+    Hook* h = find(disp);
+    if (!h) return;
+    uint32_t px = 0;
+    for (uint32_t i = 0; i < disp->inv_p; ++i) {
+        if (!disp->inv_area_joined[i]) px += area_px(disp->inv_areas[i]);
+    }
+    h->frame_px = px;
+    h->drew = true;
+    h->render_start = now_us();
+}
+
+inline void render_ready_cb(lv_event_t* e) noexcept {
+    Hook* h = find(static_cast<lv_display_t*>(lv_event_get_current_target(e)));
+    if (!h || !h->drew) return;
+    const auto us = static_cast<uint32_t>(now_us() - h->render_start);
+    h->render_us += us;
+    if (us > h->stats.render_max_us) h->stats.render_max_us = us;
+    h->stats.pixels += h->frame_px;
+    if (h->frame_px) {
+        const auto sample = static_cast<uint32_t>(static_cast<uint64_t>(us) * 1000 / h->frame_px);
+        uint32_t& cost = h->stats.ns_per_px;
+        cost = cost ? (cost * 3 + sample) / 4 : (sample ? sample : 1);
+    }
+}
+
+/// Frame statistics, then the deferred areas back in line for the next refresh
+inline void refr_ready_cb(lv_event_t* e) noexcept {
+    auto* disp = static_cast<lv_display_t*>(lv_event_get_current_target(e));
+    Hook* h = find(disp);
+    if (!h) return;
+    if (h->drew) {
+        const uint32_t now = lv_tick_get();
+        ++h->stats.frames;
+        h->stats.render_avg_us = static_cast<uint32_t>(h->render_us / h->stats.frames);
+        if (h->last_frame) {
+            const uint32_t interval = lv_tick_elaps(h->last_frame);
+            if (interval > h->stats.interval_max_ms) h->stats.interval_max_ms = interval;
+            lv_timer_t* t = lv_display_get_refr_timer(disp);
+            const uint32_t period = t ? lv_timer_get_period(t) : LV_DEF_REFR_PERIOD;
+            if (interval > 2 * period) ++h->stats.late_frames;
+        }
+        h->last_frame = now;
+        h->drew = false;
+    }
+    const uint32_t n = h->deferred_n;
+    h->deferred_n = 0;
+    for (uint32_t i = 0; i < n; ++i) lv_inv_area(disp, &h->deferred[i]);
+}
+
+inline void remove_cbs(lv_display_t* disp) noexcept {
+    lv_display_remove_event_cb_with_user_data(disp, &refr_start_cb, nullptr);
+    lv_display_remove_event_cb_with_user_data(disp, &render_start_cb, nullptr);
+    lv_display_remove_event_cb_with_user_data(disp, &render_ready_cb, nullptr);
+    lv_display_remove_event_cb_with_user_data(disp, &refr_ready_cb, nullptr);
+}
+
+inline void delete_cb(lv_event_t* e) noexcept {
+    if (Hook* h = find(static_cast<lv_display_t*>(lv_event_get_current_target(e)))) *h = Hook{};
+}
+
+} // namespace detail
+
+/**
+ * @brief Pace `disp` (see the file comment); enabling again applies a new budget
+ * @return false when LV_CPP_PACED_DISPLAYS is reached
+ */
+inline bool enable(lv_display_t* disp, const PacingConfig& cfg = {}) noexcept {
+    if (!disp) return false;
+    detail::Hook* h = detail::find(disp);
+    if (!h) {
+        h = detail::find(nullptr);
+        if (!h) {
+            LV_LOG_WARN("paced displays exhausted, raise LV_CPP_PACED_DISPLAYS");
+            return false;
+        }
+        *h = detail::Hook{};
+        h->disp = disp;
+        lv_display_add_event_cb(disp, &detail::refr_start_cb, LV_EVENT_REFR_START, nullptr);
+        lv_display_add_event_cb(disp, &detail::render_start_cb, LV_EVENT_RENDER_START, nullptr);
+        lv_display_add_event_cb(disp, &detail::render_ready_cb, LV_EVENT_RENDER_READY, nullptr);
+        lv_display_add_event_cb(disp, &detail::refr_ready_cb, LV_EVENT_REFR_READY, nullptr);
+        lv_display_add_event_cb(disp, &detail::delete_cb, LV_EVENT_DELETE, nullptr);
+    }
+    h->cfg = cfg;
+    return true;
+}
+
+/// Render every invalidated area in one refresh again (deferred areas are invalidated now)
+inline void disable(lv_display_t* disp) noexcept {
+    detail::Hook* h = disp ? detail::find(disp) : nullptr;
+    if (!h) return;
+    detail::remove_cbs(disp);
+    lv_display_remove_event_cb_with_user_data(disp, &detail::delete_cb, nullptr);
+    for (uint32_t i = 0; i < h->deferred_n; ++i) lv_inv_area(disp, &h->deferred[i]);
+    *h = detail::Hook{};
+}
+
+[[nodiscard]] inline bool enabled(lv_display_t* disp) noexcept {
+    return disp && detail::find(disp);
+}
+
+/// Frame statistics of a paced display (zero if not paced)
+[[nodiscard]] inline Stats stats(lv_display_t* disp) noexcept {
+    const detail::Hook* h = disp ? detail::find(disp) : nullptr;
+    return h ? h->stats : Stats{};
+}
+
+/// Zero the counters (the measured render cost is kept)
+inline void reset_stats(lv_display_t* disp) noexcept {
+    detail::Hook* h = disp ? detail::find(disp) : nullptr;
+    if (!h) return;
+    const uint32_t cost = h->stats.ns_per_px;
+    h->stats = Stats{};
+    h->stats.ns_per_px = cost;
+    h->render_us = 0;
+    h->last_frame = 0;
+}
+
+} // namespace frame_pacing
+
+} // namespace lv
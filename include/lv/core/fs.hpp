@@ -16,6 +16,9 @@
  *     f.read(buf, sizeof(buf), &n);
  * }
  *
+ * // Read without blocking the UI (inside an lv::Task coroutine)
+ * auto [res, n] = co_await f.read_async(big_buf, big_size);
+ *
  * // List a directory
  * lv::fs::Directory dir("A:/assets");
  * if (dir) {
@@ -28,6 +31,7 @@
  */
 
 #include <lvgl.h>
+#include <coroutine>
 #include <cstring>
 
 namespace lv::fs {
@@ -62,6 +66,78 @@ namespace res {
     constexpr auto unknown     = LV_FS_RES_UNKNOWN;
 } // namespace res
 
+// ==================== Async Read ====================
+
+/// Result of an asynchronous read
+struct ReadResult {
+    lv_fs_res_t res;
+    uint32_t bytes;
+};
+
+/**
+ * @brief Awaitable chunked read (see File::read_async)
+ *
+ * Reads one chunk per LVGL timer tick so large reads are interleaved with
+ * rendering and input. Completes at EOF, on error or when `size` bytes were
+ * read. The file must stay open until the read completes.
+ */
+class ReadOp {
+    lv_fs_file_t* m_file;
+    uint8_t* m_buf;
+    uint32_t m_size;
+    uint32_t m_chunk;
+    ReadResult m_result{LV_FS_RES_OK, 0};
+    lv_timer_t* m_timer = nullptr;
+    std::coroutine_handle<> m_handle;
+
+    /// Read one chunk; returns true when the whole read is finished
+    bool step() noexcept {
+        uint32_t want = m_size - m_result.bytes;
+        if (want > m_chunk) want = m_chunk;
+        uint32_t br = 0;
+        m_result.res = lv_fs_read(m_file, m_buf + m_result.bytes, want, &br);
+        m_result.bytes += br;
+        return m_result.res != LV_FS_RES_OK || br < want || m_result.bytes >= m_size;
+    }
+
+    static void timer_cb(lv_timer_t* t) noexcept {
+        auto* self = static_cast<ReadOp*>(lv_timer_get_user_data(t));
+        if (!self->step()) return;
+        std::coroutine_handle<> h = self->m_handle;
+        self->m_timer = nullptr;
+        lv_timer_delete(t);
+        h.resume();
+    }
+
+public:
+    ReadOp(lv_fs_file_t* file, void* buf, uint32_t size, uint32_t chunk) noexcept
+        : m_file(file), m_buf(static_cast<uint8_t*>(buf)), m_size(size),
+          m_chunk(chunk ? chunk : size) {}
+
+    ~ReadOp() {
+        if (m_timer) lv_timer_delete(m_timer);
+    }
+
+    ReadOp(const ReadOp&) = delete;
+    ReadOp& operator=(const ReadOp&) = delete;
+
+    /// Reads that fit in one chunk complete synchronously
+    [[nodiscard]] bool await_ready() noexcept {
+        return m_size <= m_chunk ? (step(), true) : false;
+    }
+
+    bool await_suspend(std::coroutine_handle<> h) noexcept {
+        if (step()) return false;
+        m_handle = h;
+        m_timer = lv_timer_create(&ReadOp::timer_cb, 0, this);
+        if (m_timer) return true;
+        while (!step()) {}  // timer allocation failed: finish synchronously
+        return false;
+    }
+
+    [[nodiscard]] ReadResult await_resume() const noexcept { return m_result; }
+};
+
 // ==================== File ====================
 
 /**
@@ -139,6 +215,19 @@ public:
         return r;
     }
 
+    /**
+     * @brief Read asynchronously from an lv::Task coroutine
+     *
+     * @code
+     * auto [res, n] = co_await file.read_async(buf, size);
+     * @endcode
+     *
+     * @param chunk Bytes read per LVGL tick (bounds time spent per frame)
+     */
+    [[nodiscard]] ReadOp read_async(void* buf, uint32_t size, uint32_t chunk = 4096) noexcept {
+        return ReadOp(&m_file, buf, size, chunk);
+    }
+
     /// Write bytes to file
     lv_fs_res_t write(const void* buf, uint32_t size, uint32_t* bytes_written = nullptr) noexcept {
         uint32_t bw = 0;
@@ -0,0 +1,595 @@
+#pragma once
+
+/**
+ * @file fs_async.hpp
+ * @brief File reads and writes on an I/O worker, completed on the UI thread
+ *
+ * fs::File blocks the caller, and an SD card read of 20-80 ms on the UI
+ * thread is several dropped frames. fs::read_async() and fs::write_async()
+ * queue the transfer for one I/O worker thread; when it finishes, the
+ * worker posts delivery through lv::post(), and the member function given
+ * as template argument runs on the UI thread from lv::tick():
+ *
+ * @code
+ * class Gallery : public lv::Component<Gallery> {
+ *     void on_index(lv::fs::IoResult& r) {
+ *         if (r.ok()) parse_json(r.text());   // pooled buffer, freed after return
+ *     }
+ * public:
+ *     void on_mount() { lv::fs::read_async<&Gallery::on_index>("A:/photos/index.json", this); }
+ * };
+ * @endcode
+ *
+ * Cancellation: requests from a mounted Component are tied to its root. If
+ * the root is deleted (unmount(), the destructor, or the screen going
+ * away), queued requests are dropped and the callback never runs; the
+ * owner is looked up again from the root at delivery, so a moved
+ * component is called at its new address. Other owners call
+ * cancel_for(this) in their destructor, or cancel(id).
+ *
+ * Buffers: read_async(path, owner) reads the whole file into a DrawBufPool
+ * buffer (NUL-terminated, released after the callback unless taken).
+ * read_async(path, buf, size, owner) reads into the caller's memory; if
+ * such a read is cancelled while in progress, cancel() waits for the
+ * current chunk (LV_CPP_FS_ASYNC_CHUNK) so the worker is done with `buf`
+ * when it returns. write_async() copies the data into a pooled buffer.
+ *
+ * Without an OS, an LVGL timer does one chunk per tick on the UI thread
+ * and calls the callback directly.
+ *
+ * Heap allocation: NONE in the wrapper (fixed job table); read and write
+ * buffers come from the DrawBufPool
+ */
+
+#include <lvgl.h>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include "async.hpp"
+#include "fs.hpp"
+#include "object.hpp"
+#include "version.hpp"
+#include "../draw/draw_buf.hpp"
+
+#ifndef LV_CPP_FS_ASYNC_JOBS
+/// Requests queued, running or awaiting delivery at once
+#define LV_CPP_FS_ASYNC_JOBS 16
+#endif
+
+#ifndef LV_CPP_FS_ASYNC_PATH
+/// Longest path stored (longer ones are refused)
+#define LV_CPP_FS_ASYNC_PATH 64
+#endif
+
+#ifndef LV_CPP_FS_ASYNC_CHUNK
+/// Bytes per lv_fs call; bounds cancel() waits and, without an OS, the work per tick
+#define LV_CPP_FS_ASYNC_CHUNK (16 * 1024)
+#endif
+
+#ifndef LV_CPP_FS_ASYNC_STACK
+/// Stack of the I/O worker thread in bytes
+#define LV_CPP_FS_ASYNC_STACK (8 * 1024)
+#endif
+
+namespace lv::fs {
+
+/// Outcome handed to the completion callback
+struct IoResult {
+    lv_fs_res_t res;
+    uint32_t id;          ///< Value returned by read_async()/write_async()
+    uint8_t* data;        ///< Bytes read: the caller's buffer or a pooled one (nullptr for writes)
+    uint32_t bytes;       ///< Bytes read or written
+    bool pooled;          ///< `data` is released after the callback
+
+    [[nodiscard]] bool ok() const noexcept { return res == LV_FS_RES_OK; }
+
+    [[nodiscard]] std::string_view text() const noexcept {
+        return {reinterpret_cast<const char*>(data), data ? bytes : 0};
+    }
+
+    /// Keep a pooled buffer past the callback (free it with release_buffer()); nullptr if not pooled
+    [[nodiscard]] uint8_t* take() noexcept {
+        if (!pooled) return nullptr;
+        pooled = false;
+        return data;
+    }
+};
+
+/// Free a buffer obtained from IoResult::take()
+inline void release_buffer(void* buf) noexcept {
+    if (buf) draw::pool_free(buf);
+}
+
+namespace detail::io {
+
+enum class Op : uint8_t { read, write, append };
+enum class JobState : uint8_t { free, queued, running, done };
+
+using complete_fn = void (*)(void* owner, lv_obj_t* guard, IoResult& r);
+
+struct Job {
+    char path[LV_CPP_FS_ASYNC_PATH];
+    File file;
+    uint8_t* data = nullptr;
+    uint32_t size = 0;              ///< Buffer size (read) or bytes to write
+    uint32_t bytes = 0;
+    uint32_t id = 0;                ///< Also the queue order
+    void* owner = nullptr;
+    lv_obj_t* guard = nullptr;      ///< Deleting it cancels the job
+    complete_fn complete = nullptr;
+    lv_fs_res_t res = LV_FS_RES_OK;
+    JobState state = JobState::free;
+    Op op = Op::read;
+    bool pooled = false;            ///< `data` comes from the pool and belongs to the job
+    bool whole = false;             ///< Read the whole file into a pooled buffer
+    std::atomic<bool> cancelled{false};
+};
+
+struct Stats {
+    uint32_t queued;
+    uint32_t completed;
+    uint32_t failed;        ///< Completed with an error
+    uint32_t cancelled;
+    uint32_t refused;       ///< Table full or path too long
+    uint64_t bytes;
+};
+
+struct Io {
+    Job jobs[LV_CPP_FS_ASYNC_JOBS];
+    lv_mutex_t lock;
+    uint32_t next_id = 1;
+    Stats stats{};
+    std::atomic<bool> delivery_queued{false};
+#if LV_USE_OS != LV_OS_NONE
+    lv_thread_t thread;
+    lv_thread_sync_t wake;
+    lv_thread_sync_t idle;          ///< Signalled after every finished job
+    bool running = false;
+    bool stopping = false;
+#else
+    lv_timer_t* timer = nullptr;
+    Job* current = nullptr;
+#endif
+
+    Io() noexcept { lv_mutex_init(&lock); }
+};
+
+[[nodiscard]] inline Io& io() noexcept {
+    static Io instance;
+    return instance;
+}
+
+struct IoLock {
+    Io& io;
+    explicit IoLock(Io& i) noexcept : io(i) { lv_mutex_lock(&io.lock); }
+    ~IoLock() { lv_mutex_unlock(&io.lock); }
+    IoLock(const IoLock&) = delete;
+    IoLock& operator=(const IoLock&) = delete;
+};
+
+/// Oldest queued job, marked running (call with the lock held)
+[[nodiscard]] inline Job* take_job(Io& s) noexcept {
+    Job* next = nullptr;
+    for (Job& j : s.jobs) {
+        if (j.state == JobState::queued && (!next || j.id - next->id > UINT32_MAX / 2)) next = &j;
+    }
+    if (next) next->state = JobState::running;
+    return next;
+}
+
+/// Do one chunk of `j` (worker, or UI timer without an OS); true when finished
+inline bool step(Job& j) noexcept {
+    if (!j.file) {
+        j.res = j.file.open(j.path, j.op == Op::read ? LV_FS_MODE_RD : LV_FS_MODE_WR);
+        if (j.res != LV_FS_RES_OK) return true;
+        if (j.op == Op::append) {
+            j.res = j.file.seek(0, LV_FS_SEEK_END);
+            if (j.res != LV_FS_RES_OK) return true;
+        }
+        if (j.whole) {
+            j.size = j.file.size();
+            j.data = static_cast<uint8_t*>(draw::pool_malloc(j.size + 1, LV_COLOR_FORMAT_RAW));
+            if (!j.data) {
+                j.res = LV_FS_RES_OUT_OF_MEM;
+                return true;
+            }
+            j.pooled = true;
+        }
+    }
+    uint32_t want = j.size - j.bytes;
+    if (want > LV_CPP_FS_ASYNC_CHUNK) want = LV_CPP_FS_ASYNC_CHUNK;
+    uint32_t n = 0;
+    j.res = j.op == Op::read ? j.file.read(j.data + j.bytes, want, &n) : j.file.write(j.data + j.bytes, want, &n);
+    j.bytes += n;
+    if (j.res == LV_FS_RES_OK && n == want && j.bytes < j.size) return false;
+    if (j.res == LV_FS_RES_OK && j.op != Op::read && n < want) j.res = LV_FS_RES_FULL;
+    if (j.op == Op::read && j.whole) j.data[j.bytes] = '\0';
+    return true;
+}
+
+/// Release what `j` holds and free the slot (call with the lock held)
+inline void release(Job& j) noexcept {
+    j.file.close();
+    if (j.pooled) release_buffer(j.data);
+    j.data = nullptr;
+    j.pooled = false;
+    j.state = JobState::free;
+}
+
+inline void guard_delete_cb(lv_event_t* e);
+
+/// Stop watching `guard` unless another live job uses it (UI thread, lock held)
+inline void unwatch(Io& s, lv_obj_t* guard) noexcept {
+    if (!guard) return;
+    for (const Job& j : s.jobs) {
+        if (j.state != JobState::free && j.guard == guard) return;
+    }
+    lv_obj_remove_event_cb_with_user_data(guard, &guard_delete_cb, nullptr);
+}
+
+/// Run completion callbacks of finished jobs, oldest first (UI thread)
+inline void deliver() {
+    Io& s = io();
+    s.delivery_queued.store(false, std::memory_order_release);
+    for (;;) {
+        IoResult r{};
+        void* owner = nullptr;
+        lv_obj_t* guard = nullptr;
+        complete_fn complete = nullptr;
+        {
+            IoLock lock(s);
+            Job* j = nullptr;
+            for (Job& c : s.jobs) {
+                if (c.state == JobState::done && (!j || c.id - j->id > UINT32_MAX / 2)) j = &c;
+            }
+            if (!j) break;
+            r = IoResult{j->res, j->id, j->op == Op::read ? j->data : nullptr, j->bytes, j->pooled};
+            if (!r.data && j->pooled) release_buffer(j->data);   // write buffer
+            owner = j->owner;
+            guard = j->guard;
+            complete = j->complete;
+            j->data = nullptr;
+            j->pooled = false;
+            j->state = JobState::free;
+            ++s.stats.completed;
+            if (!r.ok()) ++s.stats.failed;
+            s.stats.bytes += r.bytes;
+            unwatch(s, guard);
+        }
+        complete(owner, guard, r);
+        if (r.pooled) release_buffer(r.data);
+    }
+}
+
+/// Hand finished jobs to the UI thread (worker)
+inline void request_delivery(Io& s) noexcept {
+    if (s.delivery_queued.exchange(true, std::memory_order_acq_rel)) return;
+    if (lv::post([]() noexcept { deliver(); })) return;
+    // Post queue full: fall back to an LVGL async call under the LVGL lock
+    lv_lock();
+    lv_async_call([](void*) { deliver(); }, nullptr);
+    lv_unlock();
+}
+
+/// Mark `j` cancelled; returns true if the caller must wait for the worker (lock held)
+[[nodiscard]] inline bool cancel_job(Io& s, Job& j) noexcept {
+    if (j.state == JobState::free) return false;
+    ++s.stats.cancelled;
+    j.guard = nullptr;
+#if LV_USE_OS != LV_OS_NONE
+    if (j.state == JobState::running) {
+        j.cancelled.store(true, std::memory_order_release);
+        return j.op == Op::read && !j.whole;   // the worker still fills the caller's buffer
+    }
+#else
+    if (s.current == &j) s.current = nullptr;
+#endif
+    release(j);
+    return false;
+}
+
+/// Wait until job `id` is no longer running (UI thread, lock not held)
+inline void wait_job(Io& s, Job& j, uint32_t id) noexcept {
+#if LV_USE_OS != LV_OS_NONE
+    for (;;) {
+        {
+            IoLock lock(s);
+            if (j.id != id || j.state != JobState::running) return;
+        }
+        lv_thread_sync_wait(&s.idle);
+    }
+#else
+    (void)s;
+    (void)j;
+    (void)id;
+#endif
+}
+
+inline void guard_delete_cb(lv_event_t* e) {
+    auto* guard = static_cast<lv_obj_t*>(lv_event_get_current_target(e));
+    Io& s = io();
+    for (Job& j : s.jobs) {
+        bool wait = false;
+        uint32_t id = 0;
+        {
+            IoLock lock(s);
+            if (j.state == JobState::free || j.guard != guard) continue;
+            id = j.id;
+            wait = cancel_job(s, j);
+        }
+        if (wait) wait_job(s, j, id);
+    }
+}
+
+/// Leave a finished job for deliver(), or free it if cancelled meanwhile (lock held)
+inline bool finish(Job& j) noexcept {
+    j.file.close();
+    if (j.cancelled.load(std::memory_order_acquire)) {
+        release(j);
+        return false;
+    }
+    j.state = JobState::done;
+    return true;
+}
+
+#if LV_USE_OS != LV_OS_NONE
+inline void worker_main(void*) {
+    Io& s = io();
+    for (;;) {
+        Job* j = nullptr;
+        {
+            IoLock lock(s);
+            if (s.stopping) break;
+            j = take_job(s);
+        }
+        if (!j) {
+            lv_thread_sync_wait(&s.wake);
+            continue;
+        }
+        bool done = false;
+        while (!done && !j->cancelled.load(std::memory_order_acquire)) done = step(*j);
+        bool deliver_it;
+        {
+            IoLock lock(s);
+            deliver_it = finish(*j);
+        }
+        lv_thread_sync_signal(&s.idle);
+        if (deliver_it) request_delivery(s);
+    }
+}
+
+inline void start_worker(Io& s) noexcept {
+    if (s.running) return;
+    lv_thread_sync_init(&s.wake);
+    lv_thread_sync_init(&s.idle);
+#if LV_VERSION_AT_LEAST(9, 3, 0)
+    const lv_result_t res = lv_thread_init(&s.thread, "lv_fs_io", LV_THREAD_PRIO_MID, &worker_main,
+                                           LV_CPP_FS_ASYNC_STACK, nullptr);
+#else
+    const lv_result_t res = lv_thread_init(&s.thread, LV_THREAD_PRIO_MID, &worker_main,
+                                           LV_CPP_FS_ASYNC_STACK, nullptr);
+#endif
+    if (res != LV_RESULT_OK) {
+        lv_thread_sync_delete(&s.wake);
+        lv_thread_sync_delete(&s.idle);
+        LV_LOG_WARN("fs async: cannot start the I/O thread");
+        return;
+    }
+    s.running = true;
+}
+#else
+inline void poll_cb(lv_timer_t* t) {
+    Io& s = io();
+    {
+        IoLock lock(s);
+        if (!s.current) s.current = take_job(s);
+        if (!s.current) {
+            lv_timer_pause(t);
+            return;
+        }
+    }
+    Job& j = *s.current;
+    if (!step(j)) return;
+    {
+        IoLock lock(s);
+        s.current = nullptr;
+        finish(j);
+    }
+    deliver();
+}
+#endif
+
+/// Queue a job (UI thread); returns its id or 0
+[[nodiscard]] inline uint32_t queue(const char* path, Op op, uint8_t* data, uint32_t size, bool pooled,
+                                    void* owner, lv_obj_t* guard, complete_fn complete) noexcept {
+    Io& s = io();
+    const size_t len = path ? std::strlen(path) : LV_CPP_FS_ASYNC_PATH;
+    uint32_t id = 0;
+    {
+        IoLock lock(s);
+        Job* j = nullptr;
+        if (len < LV_CPP_FS_ASYNC_PATH) {
+            for (Job& c : s.jobs) {
+                if (c.state == JobState::free) {
+                    j = &c;
+                    break;
+                }
+            }
+        }
+        if (!j) {
+            ++s.stats.refused;
+            LV_LOG_WARN("fs async: cannot queue %s (raise LV_CPP_FS_ASYNC_JOBS or LV_CPP_FS_ASYNC_PATH)",
+                        path ? path : "(null)");
+            if (pooled) release_buffer(data);
+            return 0;
+        }
+        bool watched = false;
+        if (guard) {
+            for (const Job& c : s.jobs) watched = watched || (c.state != JobState::free && c.guard == guard);
+        }
+        std::memcpy(j->path, path, len + 1);
+        j->data = data;
+        j->size = size;
+        j->bytes = 0;
+        j->op = op;
+        j->pooled = pooled;
+        j->whole = op == Op::read && !data;
+        j->owner = owner;
+        j->guard = guard;
+        j->complete = complete;
+        j->res = LV_FS_RES_OK;
+        j->cancelled.store(false, std::memory_order_relaxed);
+        j->id = id = s.next_id++;
+        if (s.next_id == 0) s.next_id = 1;
+        j->state = JobState::queued;
+        ++s.stats.queued;
+        if (guard && !watched) lv_obj_add_event_cb(guard, &guard_delete_cb, LV_EVENT_DELETE, nullptr);
+    }
+#if LV_USE_OS != LV_OS_NONE
+    start_worker(s);
+    lv_thread_sync_signal(&s.wake);
+#else
+    if (!s.timer) s.timer = lv_timer_create(&poll_cb, 0, nullptr);
+    else lv_timer_resume(s.timer);
+#endif
+    return id;
+}
+
+/// Root object of a mounted component, nullptr for other owners
+template<typename T>
+[[nodiscard]] lv_obj_t* guard_of(T* owner) noexcept {
+    if constexpr (requires { owner->root().get(); T::from_obj(owner->root()); }) {
+        return owner->root().get();
+    } else {
+        return nullptr;
+    }
+}
+
+template<auto MemFn, typename T>
+void complete(void* owner, lv_obj_t* guard, IoResult& r) {
+    auto* self = static_cast<T*>(owner);
+    if constexpr (requires { T::from_obj(ObjectView(guard)); }) {
+        if (guard) self = T::from_obj(ObjectView(guard));   // follows a moved component
+        if (!self) return;
+    }
+    (self->*MemFn)(r);
+}
+
+} // namespace detail::io
+
+using IoStats = detail::io::Stats;
+
+/**
+ * @brief Read the whole file into a pooled buffer on the I/O worker
+ *
+ * `(owner->*MemFn)(IoResult&)` runs on the UI thread when done.
+ * @return Request id for cancel(), 0 if it could not be queued
+ */
+template<auto MemFn, typename T>
+    requires std::is_member_function_pointer_v<decltype(MemFn)>
+uint32_t read_async(const char* path, T* owner) noexcept {
+    return detail::io::queue(path, detail::io::Op::read, nullptr, 0, false, owner, detail::io::guard_of(owner),
+                             &detail::io::complete<MemFn, T>);
+}
+
+/// Read up to `size` bytes into `buf` (valid until completion or cancel() returns)
+template<auto MemFn, typename T>
+    requires std::is_member_function_pointer_v<decltype(MemFn)>
+uint32_t read_async(const char* path, void* buf, uint32_t size, T* owner) noexcept {
+    return detail::io::queue(path, detail::io::Op::read, static_cast<uint8_t*>(buf), size, false, owner,
+                             detail::io::guard_of(owner), &detail::io::complete<MemFn, T>);
+}
+
+/**
+ * @brief Write `size` bytes of `data` (copied) to `path` on the I/O worker
+ * @param append Write at the end of the file instead of the start
+ * @return Request id for cancel(), 0 if it could not be queued (or out of memory)
+ */
+template<auto MemFn, typename T>
+    requires std::is_member_function_pointer_v<decltype(MemFn)>
+uint32_t write_async(const char* path, const void* data, uint32_t size, T* owner, bool append = false) noexcept {
+    auto* copy = static_cast<uint8_t*>(draw::pool_malloc(size ? size : 1, LV_COLOR_FORMAT_RAW));
+    if (!copy) return 0;
+    if (size) std::memcpy(copy, data, size);
+    return detail::io::queue(path, append ? detail::io::Op::append : detail::io::Op::write, copy, size, true,
+                             owner, detail::io::guard_of(owner), &detail::io::complete<MemFn, T>);
+}
+
+/// Drop request `id`; its callback will not run. Waits if the worker is filling a caller buffer.
+inline void cancel(uint32_t id) noexcept {
+    detail::io::Io& s = detail::io::io();
+    for (detail::io::Job& j : s.jobs) {
+        bool wait = false;
+        {
+            detail::io::IoLock lock(s);
+            if (id == 0 || j.id != id || j.state == detail::io::JobState::free) continue;
+            const lv_obj_t* guard = j.guard;
+            wait = detail::io::cancel_job(s, j);
+            detail::io::unwatch(s, const_cast<lv_obj_t*>(guard));
+        }
+        if (wait) detail::io::wait_job(s, j, id);
+        return;
+    }
+}
+
+/// Drop every request made with `owner` (call from a non-component owner's destructor)
+inline void cancel_for(const void* owner) noexcept {
+    detail::io::Io& s = detail::io::io();
+    for (detail::io::Job& j : s.jobs) {
+        uint32_t id = 0;
+        {
+            detail::io::IoLock lock(s);
+            if (j.state == detail::io::JobState::free || j.owner != owner) continue;
+            id = j.id;
+        }
+        cancel(id);
+    }
+}
+
+/// Requests queued, running or awaiting delivery
+[[nodiscard]] inline uint32_t pending() noexcept {
+    detail::io::Io& s = detail::io::io();
+    detail::io::IoLock lock(s);
+    uint32_t n = 0;
+    for (const detail::io::Job& j : s.jobs) n += j.state != detail::io::JobState::free;
+    return n;
+}
+
+[[nodiscard]] inline IoStats io_stats() noexcept {
+    detail::io::Io& s = detail::io::io();
+    detail::io::IoLock lock(s);
+    return s.stats;
+}
+
+inline void reset_io_stats() noexcept {
+    detail::io::Io& s = detail::io::io();
+    detail::io::IoLock lock(s);
+    s.stats = {};
+}
+
+/**
+ * @brief Stop the I/O thread after its current job (queued jobs wait for the next request)
+ *
+ * Call from the UI thread outside lv_timer_handler() (a finishing job may need the LVGL lock).
+ */
+inline void shutdown_io() noexcept {
+#if LV_USE_OS != LV_OS_NONE
+    detail::io::Io& s = detail::io::io();
+    {
+        detail::io::IoLock lock(s);
+        if (!s.running) return;
+        s.stopping = true;
+    }
+    lv_thread_sync_signal(&s.wake);
+    lv_thread_delete(&s.thread);
+    lv_thread_sync_delete(&s.wake);
+    lv_thread_sync_delete(&s.idle);
+    detail::io::IoLock lock(s);
+    s.running = false;
+    s.stopping = false;
+#endif
+}
+
+} // namespace lv::fs
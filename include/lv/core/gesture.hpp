@@ -0,0 +1,505 @@
+#pragma once
+
+/**
+ * @file gesture.hpp
+ * @brief Allocation-free gesture recognizers (pan, fling, pinch, rotate, hold, double tap)
+ *
+ * LV_EVENT_GESTURE only reports a direction once the finger has gone, so
+ * anything that follows the finger or needs a speed is hand-rolled on
+ * PRESSING events. lv::gesture runs a small state machine per object
+ * instead and calls a handler with an Info for each recognized gesture:
+ *
+ * - `pan`: begin once the pointer moved past `slop_px`, update per sample,
+ *   end at the release with the release velocity
+ * - `fling`: a release faster than `fling_speed` px/s (after moving past the slop)
+ * - `hold`: pressed for `hold_ms` without moving past the slop (fires once)
+ * - `double_tap`: two short taps within `double_tap_ms` and 2 * slop
+ * - `pinch` / `rotate`: scale and angle of two touches against where they
+ *   started; the driver reports the second finger with touches()
+ *
+ * @code
+ * page.on_pan<&Pager::follow>(this)       // void follow(const lv::gesture::Info& g)
+ *     .on_fling<&Pager::settle>(this)
+ *     .on_double_tap<&Pager::zoom>(this);
+ * @endcode
+ *
+ * All recognizers of an object share one slot and one set of event
+ * callbacks: LVGL's hit test picks the object once, every sample is read
+ * once and each enabled recognizer steps on it. With an IndevQueue that
+ * coalesces moves this is once per sample batch. The object should not
+ * scroll in the panned direction (LVGL would take the drag over) and
+ * usually wants `gesture_bubble` removed.
+ *
+ * Multi-touch: LVGL indevs carry one point, which drives the events. A
+ * multi-touch driver passes all its points to touches() from its read
+ * callback; while two are down, pinch and rotate are evaluated on the
+ * object the first one pressed (no second hit test).
+ *
+ * Heap allocation: NONE in the wrapper (LV_CPP_GESTURE_OBJECTS fixed
+ * slots; LVGL allocates the event descriptors)
+ */
+
+#include <lvgl.h>
+#include <cmath>
+#include <cstdint>
+#include <initializer_list>
+#include <type_traits>
+
+#ifndef LV_CPP_GESTURE_OBJECTS
+/// Objects that can have recognizers at once
+#define LV_CPP_GESTURE_OBJECTS 16
+#endif
+
+#ifndef LV_CPP_GESTURE_INDEVS
+/// Multi-touch indevs that can report touches() at once
+#define LV_CPP_GESTURE_INDEVS 2
+#endif
+
+namespace lv::gesture {
+
+enum class Kind : uint8_t { pan, fling, pinch, rotate, hold, double_tap };
+
+inline constexpr uint32_t kKinds = 6;
+
+enum class Phase : uint8_t { begin, update, end };
+
+/// What a handler gets
+struct Info {
+    Kind kind;
+    Phase phase;           ///< begin/update/end for pan, pinch and rotate; end for the others
+    lv_obj_t* obj;
+    lv_point_t point;      ///< Current pointer position (center of the touches for pinch and rotate)
+    lv_point_t start;      ///< Where the press (or the two-touch gesture) started
+    int32_t vx;            ///< Velocity at the last samples (px/s)
+    int32_t vy;
+    lv_dir_t dir;          ///< Dominant direction of the motion (pan, fling)
+    float scale;           ///< Touch distance / distance at begin (pinch)
+    float angle;           ///< Degrees turned since begin, clockwise (rotate)
+
+    [[nodiscard]] int32_t dx() const noexcept { return point.x - start.x; }
+    [[nodiscard]] int32_t dy() const noexcept { return point.y - start.y; }
+};
+
+using handler_t = void (*)(const Info& info, void* ctx);
+
+/// Thresholds shared by all recognizers
+struct Config {
+    uint16_t slop_px = 10;         ///< Movement that turns a press into a pan
+    uint16_t hold_ms = 400;
+    uint16_t double_tap_ms = 300;  ///< Time from the first release to the second press
+    uint16_t fling_speed = 400;    ///< px/s
+};
+
+namespace detail {
+
+/// Samples kept for the release velocity
+inline constexpr uint32_t kHistory = 4;
+
+/// Samples older than this are not used for the velocity (ms)
+inline constexpr uint32_t kVelocityWindow = 100;
+
+struct Sample {
+    uint32_t tick;
+    lv_point_t p;
+};
+
+struct Slot {
+    lv_obj_t* obj = nullptr;      ///< nullptr: free slot
+    handler_t handlers[kKinds] = {};
+    void* ctx[kKinds] = {};
+    // Press state
+    lv_point_t start{};
+    uint32_t press_tick = 0;
+    Sample history[kHistory] = {};
+    uint32_t samples = 0;
+    bool moved = false;           ///< Past the slop since the press
+    bool held = false;            ///< hold fired for this press
+    bool panning = false;
+    // Two touches
+    bool multi = false;
+    bool multi_seen = false;      ///< Two touches were down during this press
+    lv_point_t multi_start{};
+    float multi_dist = 0.0f;
+    float multi_angle = 0.0f;
+    // Tap history for double_tap
+    uint32_t tap_tick = 0;
+    lv_point_t tap{};
+    bool tapped = false;
+};
+
+struct Touches {
+    lv_indev_t* indev = nullptr;
+    lv_point_t p[2] = {};
+    uint32_t count = 0;
+};
+
+[[nodiscard]] inline Slot* slots() noexcept {
+    static Slot s[LV_CPP_GESTURE_OBJECTS];
+    return s;
+}
+
+[[nodiscard]] inline Touches* touches() noexcept {
+    static Touches t[LV_CPP_GESTURE_INDEVS];
+    return t;
+}
+
+[[nodiscard]] inline Config& config() noexcept {
+    static Config c;
+    return c;
+}
+
+[[nodiscard]] inline Slot* find(const lv_obj_t* obj) noexcept {
+    Slot* s = slots();
+    for (uint32_t i = 0; i < LV_CPP_GESTURE_OBJECTS; ++i) {
+        if (s[i].obj == obj) return &s[i];
+    }
+    return nullptr;
+}
+
+[[nodiscard]] inline Touches* find_touches(const lv_indev_t* indev) noexcept {
+    Touches* t = touches();
+    for (uint32_t i = 0; i < LV_CPP_GESTURE_INDEVS; ++i) {
+        if (t[i].indev == indev) return &t[i];
+    }
+    return nullptr;
+}
+
+[[nodiscard]] inline bool wants(const Slot& s, Kind k) noexcept {
+    return s.handlers[static_cast<uint32_t>(k)] != nullptr;
+}
+
+[[nodiscard]] inline int32_t abs32(int32_t v) noexcept { return v < 0 ? -v : v; }
+
+[[nodiscard]] inline lv_dir_t dir_of(int32_t dx, int32_t dy) noexcept {
+    if (dx == 0 && dy == 0) return LV_DIR_NONE;
+    if (abs32(dx) >= abs32(dy)) return dx < 0 ? LV_DIR_LEFT : LV_DIR_RIGHT;
+    return dy < 0 ? LV_DIR_TOP : LV_DIR_BOTTOM;
+}
+
+inline void emit(Slot& s, Kind k, Phase phase, Info info) {
+    const uint32_t i = static_cast<uint32_t>(k);
+    if (!s.handlers[i]) return;
+    info.kind = k;
+    info.phase = phase;
+    // The handler may delete the object (and free the slot); read ctx first
+    void* ctx = s.ctx[i];
+    s.handlers[i](info, ctx);
+}
+
+/// Velocity over the samples of the last kVelocityWindow ms (px/s)
+inline void velocity(const Slot& s, int32_t& vx, int32_t& vy) noexcept {
+    vx = vy = 0;
+    if (s.samples < 2) return;
+    const Sample& last = s.history[(s.samples - 1) % kHistory];
+    const uint32_t kept = s.samples < kHistory ? s.samples : kHistory;
+    const Sample* first = &last;
+    for (uint32_t k = 2; k <= kept; ++k) {
+        const Sample& c = s.history[(s.samples - k) % kHistory];
+        if (last.tick - c.tick > kVelocityWindow) break;
+        first = &c;
+    }
+    const uint32_t dt = last.tick - first->tick;
+    if (dt == 0) return;
+    vx = (last.p.x - first->p.x) * 1000 / static_cast<int32_t>(dt);
+    vy = (last.p.y - first->p.y) * 1000 / static_cast<int32_t>(dt);
+}
+
+[[nodiscard]] inline Info base_info(const Slot& s, lv_point_t p) noexcept {
+    Info info{};
+    info.obj = s.obj;
+    info.point = p;
+    info.start = s.start;
+    info.scale = 1.0f;
+    velocity(s, info.vx, info.vy);
+    info.dir = dir_of(info.vx, info.vy);
+    return info;
+}
+
+[[nodiscard]] inline float touch_dist(const Touches& t) noexcept {
+    const float dx = static_cast<float>(t.p[1].x - t.p[0].x);
+    const float dy = static_cast<float>(t.p[1].y - t.p[0].y);
+    return std::sqrt(dx * dx + dy * dy);
+}
+
+[[nodiscard]] inline float touch_angle(const Touches& t) noexcept {
+    return std::atan2(static_cast<float>(t.p[1].y - t.p[0].y), static_cast<float>(t.p[1].x - t.p[0].x))
+           * 57.29578f;
+}
+
+/// Two-touch step: pinch and rotate begin, update or end
+inline void step_multi(Slot& s, lv_indev_t* indev, bool pressed) {
+    if (!wants(s, Kind::pinch) && !wants(s, Kind::rotate)) return;
+    const Touches* t = find_touches(indev);
+    const bool two = pressed && t && t->count >= 2;
+    if (!two && !s.multi) return;
+
+    Info info{};
+    info.obj = s.obj;
+    info.scale = 1.0f;
+    Phase phase = Phase::update;
+    if (two) {
+        info.point = {(t->p[0].x + t->p[1].x) / 2, (t->p[0].y + t->p[1].y) / 2};
+        if (!s.multi) {
+            s.multi = true;
+            s.multi_seen = true;
+            s.multi_start = info.point;
+            s.multi_dist = touch_dist(*t);
+            s.multi_angle = touch_angle(*t);
+            phase = Phase::begin;
+        }
+        const float d = touch_dist(*t);
+        info.scale = s.multi_dist > 0.0f ? d / s.multi_dist : 1.0f;
+        float a = touch_angle(*t) - s.multi_angle;
+        if (a > 180.0f) a -= 360.0f;
+        if (a < -180.0f) a += 360.0f;
+        info.angle = a;
+    } else {
+        s.multi = false;
+        phase = Phase::end;
+        info.point = s.multi_start;
+    }
+    info.start = s.multi_start;
+    const lv_obj_t* obj = s.obj;
+    emit(s, Kind::pinch, phase, info);
+    if (s.obj != obj) return;
+    emit(s, Kind::rotate, phase, info);
+}
+
+inline void on_press(Slot& s, lv_point_t p) noexcept {
+    const uint32_t now = lv_tick_get();
+    s.start = p;
+    s.press_tick = now;
+    s.samples = 0;
+    s.history[s.samples++ % kHistory] = {now, p};
+    s.moved = false;
+    s.held = false;
+    s.panning = false;
+    s.multi = false;
+    s.multi_seen = false;
+}
+
+inline void on_pressing(Slot& s, lv_indev_t* indev, lv_point_t p) {
+    const uint32_t now = lv_tick_get();
+    const Config& cfg = config();
+    s.history[s.samples++ % kHistory] = {now, p};
+    const lv_obj_t* obj = s.obj;
+
+    step_multi(s, indev, true);
+    if (s.obj != obj || s.multi_seen) return;
+
+    if (!s.moved && (abs32(p.x - s.start.x) > cfg.slop_px || abs32(p.y - s.start.y) > cfg.slop_px)) {
+        s.moved = true;
+    }
+    if (s.moved && wants(s, Kind::pan)) {
+        const Phase phase = s.panning ? Phase::update : Phase::begin;
+        s.panning = true;
+        Info info = base_info(s, p);
+        info.dir = dir_of(info.dx(), info.dy());
+        emit(s, Kind::pan, phase, info);
+        return;
+    }
+    if (!s.moved && !s.held && now - s.press_tick >= cfg.hold_ms) {
+        s.held = true;
+        s.tapped = false;
+        emit(s, Kind::hold, Phase::end, base_info(s, p));
+    }
+}
+
+inline void on_release(Slot& s, lv_indev_t* indev, lv_point_t p, bool lost) {
+    const uint32_t now = lv_tick_get();
+    const Config& cfg = config();
+    const lv_obj_t* obj = s.obj;
+
+    step_multi(s, indev, false);
+    if (s.obj != obj) return;
+
+    Info info = base_info(s, p);
+    if (s.panning) {
+        s.panning = false;
+        emit(s, Kind::pan, Phase::end, info);
+        if (s.obj != obj) return;
+    }
+    if (lost || s.multi_seen) {
+        s.tapped = false;
+        return;
+    }
+    if (s.moved) {
+        const int64_t v2 = static_cast<int64_t>(info.vx) * info.vx + static_cast<int64_t>(info.vy) * info.vy;
+        if (v2 >= static_cast<int64_t>(cfg.fling_speed) * cfg.fling_speed) emit(s, Kind::fling, Phase::end, info);
+        s.tapped = false;
+        return;
+    }
+    if (s.held || now - s.press_tick >= cfg.hold_ms) {
+        s.tapped = false;
+        return;
+    }
+    // A tap: the second one within time and distance of the first is a double tap
+    if (s.tapped && s.press_tick - s.tap_tick <= cfg.double_tap_ms
+        && abs32(p.x - s.tap.x) <= 2 * cfg.slop_px && abs32(p.y - s.tap.y) <= 2 * cfg.slop_px) {
+        s.tapped = false;
+        emit(s, Kind::double_tap, Phase::end, info);
+        return;
+    }
+    s.tapped = true;
+    s.tap_tick = now;
+    s.tap = p;
+}
+
+inline void event_cb(lv_event_t* e) {
+    Slot* s = find(static_cast<lv_obj_t*>(lv_event_get_current_target(e)));
+    if (!s) return;
+    const lv_event_code_t code = lv_event_get_code(e);
+    if (code == LV_EVENT_DELETE) {
+        *s = Slot{};
+        return;
+    }
+    lv_indev_t* indev = lv_indev_active();
+    if (!indev || lv_indev_get_type(indev) != LV_INDEV_TYPE_POINTER) return;
+    lv_point_t p;
+    lv_indev_get_point(indev, &p);
+    switch (code) {
+    case LV_EVENT_PRESSED: on_press(*s, p); break;
+    case LV_EVENT_PRESSING: on_pressing(*s, indev, p); break;
+    case LV_EVENT_RELEASED: on_release(*s, indev, p, false); break;
+    case LV_EVENT_PRESS_LOST: on_release(*s, indev, p, true); break;
+    default: break;
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Call `fn(info, ctx)` for `kind` gestures on `obj` (nullptr removes it)
+ *
+ * A second handler for the same kind replaces the first.
+ *
+ * @return false when LV_CPP_GESTURE_OBJECTS is reached
+ */
+inline bool recognize(lv_obj_t* obj, Kind kind, handler_t fn, void* ctx = nullptr) noexcept {
+    if (!obj) return false;
+    detail::Slot* s = detail::find(obj);
+    if (!s) {
+        if (!fn) return true;
+        s = detail::find(nullptr);
+        if (!s) {
+            LV_LOG_WARN("gesture objects exhausted, raise LV_CPP_GESTURE_OBJECTS");
+            return false;
+        }
+        s->obj = obj;
+        for (lv_event_code_t code : {LV_EVENT_PRESSED, LV_EVENT_PRESSING, LV_EVENT_RELEASED,
+                                     LV_EVENT_PRESS_LOST, LV_EVENT_DELETE}) {
+            lv_obj_add_event_cb(obj, &detail::event_cb, code, nullptr);
+        }
+    }
+    s->handlers[static_cast<uint32_t>(kind)] = fn;
+    s->ctx[static_cast<uint32_t>(kind)] = ctx;
+    return true;
+}
+
+/// Remove all recognizers of `obj`
+inline void forget(lv_obj_t* obj) noexcept {
+    detail::Slot* s = obj ? detail::find(obj) : nullptr;
+    if (!s) return;
+    lv_obj_remove_event_cb_with_user_data(obj, &detail::event_cb, nullptr);
+    *s = detail::Slot{};
+}
+
+/**
+ * @brief Report the current touches of a multi-touch `indev` (from its read callback)
+ *
+ * Pass every finger that is down, the one LVGL tracks first; count 0 once
+ * all are up. Only the first two are used.
+ *
+ * @return false when LV_CPP_GESTURE_INDEVS is reached
+ */
+inline bool touches(lv_indev_t* indev, const lv_point_t* points, uint32_t count) noexcept {
+    if (!indev) return false;
+    detail::Touches* t = detail::find_touches(indev);
+    if (!t) {
+        if (count == 0) return true;
+        t = detail::find_touches(nullptr);
+        if (!t) {
+            LV_LOG_WARN("multi-touch indevs exhausted, raise LV_CPP_GESTURE_INDEVS");
+            return false;
+        }
+        t->indev = indev;
+    }
+    t->count = count > 2 ? 2 : count;
+    for (uint32_t i = 0; i < t->count; ++i) t->p[i] = points[i];
+    return true;
+}
+
+/// Thresholds used by all recognizers
+inline void config(const Config& cfg) noexcept { detail::config() = cfg; }
+
+[[nodiscard]] inline const Config& config() noexcept { return detail::config(); }
+
+} // namespace lv::gesture
+
+namespace lv {
+
+/**
+ * @brief Mixin adding gesture recognizers to widgets (see gesture.hpp)
+ *
+ * Part of EventMixin. Handlers take `const lv::gesture::Info&` or nothing.
+ */
+template<typename Derived>
+class GestureMixin {
+    [[nodiscard]] lv_obj_t* gesture_obj() noexcept {
+        return static_cast<Derived*>(this)->get();
+    }
+
+public:
+    /// Call `(instance->*MemFn)(info)` for `kind` gestures on this object
+    template<auto MemFn, typename T>
+        requires std::is_member_function_pointer_v<decltype(MemFn)>
+    Derived& recognize(gesture::Kind kind, T* instance) noexcept {
+        gesture::recognize(gesture_obj(), kind, [](const gesture::Info& info, void* ctx) {
+            if constexpr (std::is_invocable_v<decltype(MemFn), T*, const gesture::Info&>) {
+                (static_cast<T*>(ctx)->*MemFn)(info);
+            } else {
+                (void)info;
+                (static_cast<T*>(ctx)->*MemFn)();
+            }
+        }, instance);
+        return *static_cast<Derived*>(this);
+    }
+
+    /// Call `fn(info, ctx)` for `kind` gestures on this object
+    Derived& recognize(gesture::Kind kind, gesture::handler_t fn, void* ctx = nullptr) noexcept {
+        gesture::recognize(gesture_obj(), kind, fn, ctx);
+        return *static_cast<Derived*>(this);
+    }
+
+    /// Follow a drag past the slop: begin, update per sample, end at release
+    template<auto MemFn, typename T>
+    Derived& on_pan(T* instance) noexcept { return recognize<MemFn>(gesture::Kind::pan, instance); }
+
+    /// A fast release (velocity in Info::vx/vy)
+    template<auto MemFn, typename T>
+    Derived& on_fling(T* instance) noexcept { return recognize<MemFn>(gesture::Kind::fling, instance); }
+
+    /// Two touches moving apart or together (Info::scale)
+    template<auto MemFn, typename T>
+    Derived& on_pinch(T* instance) noexcept { return recognize<MemFn>(gesture::Kind::pinch, instance); }
+
+    /// Two touches turning (Info::angle)
+    template<auto MemFn, typename T>
+    Derived& on_rotate(T* instance) noexcept { return recognize<MemFn>(gesture::Kind::rotate, instance); }
+
+    /// Pressed still for Config::hold_ms
+    template<auto MemFn, typename T>
+    Derived& on_hold(T* instance) noexcept { return recognize<MemFn>(gesture::Kind::hold, instance); }
+
+    /// Two quick taps at the same place
+    template<auto MemFn, typename T>
+    Derived& on_double_tap(T* instance) noexcept { return recognize<MemFn>(gesture::Kind::double_tap, instance); }
+
+    /// Remove all recognizers of this object
+    Derived& forget_gestures() noexcept {
+        gesture::forget(gesture_obj());
+        return *static_cast<Derived*>(this);
+    }
+};
+
+} // namespace lv
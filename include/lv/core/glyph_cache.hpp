@@ -0,0 +1,345 @@
+#pragma once
+
+/**
+ * @file glyph_cache.hpp
+ * @brief Shared, budgeted glyph bitmap cache with statistics for runtime fonts
+ *
+ * TinyTTF sizes its glyph cache per font (LV_TINY_TTF_CACHE_GLYPH_CNT by
+ * default) and FreeType once for all fonts, neither reports how well the
+ * cache works, and CJK text thrashes a 128-glyph cache. glyph_cache sits in
+ * front of any number of such fonts with one byte budget:
+ *
+ * @code
+ * lv::glyph_cache::budget(256 * 1024);
+ * auto cjk = lv::TinyTTFFont::create(noto_sc, noto_sc_size, 20, {.glyphs = 32, .shared = true});
+ * ...
+ * lv::glyph_cache::FontStats s = lv::glyph_cache::stats(cjk.get());   // hits, misses, bytes
+ * @endcode
+ *
+ * attach(font) interposes the font's get_glyph_bitmap / release_glyph:
+ *
+ * - a hit returns a cached copy of the A8 bitmap without calling the font,
+ * - a miss lets the font render, copies the bitmap into a pooled draw
+ *   buffer (DrawBufPool) and releases the font's own entry at once, so the
+ *   font's cache only has to hold what is being rendered,
+ * - glyphs are looked up in 4-way sets (LV_CPP_GLYPH_CACHE slots, key:
+ *   font, glyph index, box size); the least recently used unpinned glyph
+ *   of the set, and then of the whole cache while over budget(), goes,
+ * - a bitmap handed to a draw task stays pinned until the task releases it.
+ *
+ * Vector (outline) glyphs and other formats pass through uncached. Fonts
+ * changing size must drop(font) (TinyTTFFont::set_size() does). detach()
+ * before destroying a font (the font wrappers do).
+ *
+ * Lookups take an lv_mutex when LVGL runs with an OS, as draw units may
+ * render labels in parallel.
+ *
+ * Heap allocation: the slot table (lv_malloc on first attach) and one
+ * pooled draw buffer per cached glyph
+ */
+
+#include <lvgl.h>
+#include <cstdint>
+#include <cstring>
+#include "../draw/draw_buf.hpp"
+
+#ifndef LV_CPP_GLYPH_CACHE
+/// Glyph slots shared by all attached fonts (rounded down to a multiple of 4)
+#define LV_CPP_GLYPH_CACHE 512
+#endif
+
+#ifndef LV_CPP_GLYPH_CACHE_BYTES
+/// Default bitmap budget of the shared cache
+#define LV_CPP_GLYPH_CACHE_BYTES (128u * 1024u)
+#endif
+
+#ifndef LV_CPP_GLYPH_CACHE_FONTS
+/// Fonts that can be attached at once
+#define LV_CPP_GLYPH_CACHE_FONTS 8
+#endif
+
+namespace lv::glyph_cache {
+
+struct FontStats {
+    uint32_t hits = 0;
+    uint32_t misses = 0;
+    uint32_t bypassed = 0;    ///< Glyphs not cached (vector or unsupported format)
+    uint32_t glyphs = 0;      ///< Cached now
+    uint32_t bytes = 0;       ///< Bitmap bytes cached now
+};
+
+struct Stats {
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+    uint32_t glyphs;
+    uint32_t bytes;
+    uint32_t budget;
+    uint32_t fonts;       ///< Attached fonts
+};
+
+namespace detail {
+
+inline constexpr uint32_t ways = 4;
+inline constexpr uint32_t sets = LV_CPP_GLYPH_CACHE / ways;
+static_assert(sets > 0, "LV_CPP_GLYPH_CACHE must be at least 4");
+
+struct Slot {
+    const lv_font_t* font;
+    uint32_t glyph;
+    uint16_t box_w, box_h;
+    lv_draw_buf_t* buf;
+    uint32_t used;     ///< LRU stamp
+    uint16_t pins;     ///< Draw tasks holding the bitmap
+};
+
+struct FontRec {
+    lv_font_t* font = nullptr;
+    const void* (*get_bitmap)(lv_font_glyph_dsc_t*, lv_draw_buf_t*) = nullptr;
+    void (*release)(const lv_font_t*, lv_font_glyph_dsc_t*) = nullptr;
+    FontStats stats;
+};
+
+struct Tables {
+    Slot* slots = nullptr;
+    FontRec fonts[LV_CPP_GLYPH_CACHE_FONTS];
+    uint32_t clock = 0;
+    uint32_t budget = LV_CPP_GLYPH_CACHE_BYTES;
+    uint32_t bytes = 0;
+    uint32_t glyphs = 0;
+    uint32_t hits = 0;
+    uint32_t misses = 0;
+    uint32_t evictions = 0;
+#if LV_USE_OS != LV_OS_NONE
+    lv_mutex_t lock;
+    Tables() noexcept { lv_mutex_init(&lock); }
+#endif
+};
+
+[[nodiscard]] inline Tables& tables() noexcept {
+    static Tables t;
+    return t;
+}
+
+/// Scoped lock of the tables (no-op without an OS)
+struct Lock {
+    Lock() noexcept {
+#if LV_USE_OS != LV_OS_NONE
+        lv_mutex_lock(&tables().lock);
+#endif
+    }
+    ~Lock() {
+#if LV_USE_OS != LV_OS_NONE
+        lv_mutex_unlock(&tables().lock);
+#endif
+    }
+};
+
+[[nodiscard]] inline FontRec* rec_of(const lv_font_t* font) noexcept {
+    for (FontRec& r : tables().fonts) {
+        if (r.font && r.font == font) return &r;
+    }
+    return nullptr;
+}
+
+[[nodiscard]] inline uint32_t set_of(const lv_font_t* font, uint32_t glyph) noexcept {
+    uint32_t h = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(font) >> 4) * 0x9E3779B1u;
+    h ^= glyph * 0x85EBCA6Bu;
+    h ^= h >> 15;
+    return h % sets;
+}
+
+inline void free_slot(Tables& t, Slot& s) noexcept {
+    if (!s.buf) return;
+    t.bytes -= s.buf->data_size;
+    --t.glyphs;
+    if (FontRec* r = rec_of(s.font)) {
+        r->stats.bytes -= s.buf->data_size;
+        --r->stats.glyphs;
+    }
+    lv_draw_buf_destroy(s.buf);
+    s = Slot{};
+}
+
+/// Evict least recently used unpinned glyphs until `need` more bytes fit the budget
+inline void trim(Tables& t, uint32_t need) noexcept {
+    while (t.bytes + need > t.budget) {
+        Slot* v = nullptr;
+        for (uint32_t i = 0; i < sets * ways; ++i) {
+            Slot& s = t.slots[i];
+            if (s.buf && !s.pins && (!v || s.used < v->used)) v = &s;
+        }
+        if (!v) return;
+        free_slot(t, *v);
+        ++t.evictions;
+    }
+}
+
+/// Marks a glyph dsc whose bitmap came from a slot (lv_font_glyph_dsc_t::entry)
+[[nodiscard]] inline lv_cache_entry_t* entry_of(Slot& s) noexcept {
+    return reinterpret_cast<lv_cache_entry_t*>(&s);
+}
+
+[[nodiscard]] inline Slot* slot_of(const lv_font_glyph_dsc_t* g) noexcept {
+    Tables& t = tables();
+    auto* p = reinterpret_cast<Slot*>(g->entry);
+    return t.slots && p >= t.slots && p < t.slots + sets * ways ? p : nullptr;
+}
+
+inline const void* get_bitmap_cb(lv_font_glyph_dsc_t* g, lv_draw_buf_t* draw_buf) noexcept {
+    const lv_font_t* font = g->resolved_font;
+    const Lock lock;
+    Tables& t = tables();
+    FontRec* r = rec_of(font);
+    if (!r) return nullptr;
+    if (g->format != LV_FONT_GLYPH_FORMAT_A8 || !t.slots) {
+        ++r->stats.bypassed;
+        return r->get_bitmap(g, draw_buf);
+    }
+
+    const uint32_t glyph = g->gid.index;
+    Slot* set = t.slots + set_of(font, glyph) * ways;
+    for (uint32_t w = 0; w < ways; ++w) {
+        Slot& s = set[w];
+        if (s.buf && s.font == font && s.glyph == glyph && s.box_w == g->box_w && s.box_h == g->box_h) {
+            ++t.hits;
+            ++r->stats.hits;
+            s.used = ++t.clock;
+            ++s.pins;
+            g->entry = entry_of(s);
+            return s.buf;
+        }
+    }
+
+    ++t.misses;
+    ++r->stats.misses;
+    const void* src = r->get_bitmap(g, draw_buf);
+    const auto* rendered = static_cast<const lv_draw_buf_t*>(src);
+    if (!rendered) return nullptr;
+
+    Slot* v = nullptr;
+    for (uint32_t w = 0; w < ways; ++w) {
+        Slot& s = set[w];
+        if (s.pins) continue;
+        if (!s.buf) {
+            v = &s;
+            break;
+        }
+        if (!v || s.used < v->used) v = &s;
+    }
+    if (!v) return src;    // whole set pinned: serve the font's bitmap uncached
+    if (v->buf) {
+        free_slot(t, *v);
+        ++t.evictions;
+    }
+    trim(t, rendered->data_size);
+    lv_draw_buf_t* copy = lv_draw_buf_create_ex(draw::pool_handlers(), rendered->header.w, rendered->header.h,
+                                                static_cast<lv_color_format_t>(rendered->header.cf),
+                                                rendered->header.stride);
+    if (!copy) return src;
+    std::memcpy(copy->data, rendered->data, rendered->data_size < copy->data_size ? rendered->data_size
+                                                                                  : copy->data_size);
+    if (r->release) r->release(font, g);    // the font's entry is no longer needed
+    *v = Slot{font, glyph, static_cast<uint16_t>(g->box_w), static_cast<uint16_t>(g->box_h), copy, ++t.clock, 1};
+    t.bytes += copy->data_size;
+    ++t.glyphs;
+    r->stats.bytes += copy->data_size;
+    ++r->stats.glyphs;
+    g->entry = entry_of(*v);
+    return copy;
+}
+
+inline void release_cb(const lv_font_t* font, lv_font_glyph_dsc_t* g) noexcept {
+    const Lock lock;
+    if (Slot* s = slot_of(g)) {
+        if (s->pins) --s->pins;
+        g->entry = nullptr;
+        return;
+    }
+    FontRec* r = rec_of(font);
+    if (r && r->release) r->release(font, g);
+}
+
+} // namespace detail
+
+/**
+ * @brief Serve `font`'s bitmaps from the shared cache
+ * @return false if LV_CPP_GLYPH_CACHE_FONTS fonts are attached or out of memory
+ */
+inline bool attach(lv_font_t* font) noexcept {
+    if (!font) return false;
+    const detail::Lock lock;
+    detail::Tables& t = detail::tables();
+    if (detail::rec_of(font)) return true;
+    if (!t.slots) {
+        t.slots = static_cast<detail::Slot*>(lv_malloc_zeroed(sizeof(detail::Slot) * detail::sets * detail::ways));
+        if (!t.slots) return false;
+    }
+    for (detail::FontRec& r : t.fonts) {
+        if (r.font) continue;
+        r = detail::FontRec{font, font->get_glyph_bitmap, font->release_glyph, {}};
+        font->get_glyph_bitmap = &detail::get_bitmap_cb;
+        font->release_glyph = &detail::release_cb;
+        return true;
+    }
+    LV_LOG_WARN("glyph cache: all font slots in use, raise LV_CPP_GLYPH_CACHE_FONTS");
+    return false;
+}
+
+/// Drop `font`'s cached glyphs that no draw task holds (after a size change)
+inline void drop(const lv_font_t* font) noexcept {
+    const detail::Lock lock;
+    detail::Tables& t = detail::tables();
+    if (!t.slots) return;
+    for (uint32_t i = 0; i < detail::sets * detail::ways; ++i) {
+        detail::Slot& s = t.slots[i];
+        if (s.buf && s.font == font && !s.pins) detail::free_slot(t, s);
+    }
+}
+
+/// Give `font` its own callbacks back and forget its glyphs (before destroying it)
+inline void detach(lv_font_t* font) noexcept {
+    drop(font);
+    const detail::Lock lock;
+    detail::FontRec* r = detail::rec_of(font);
+    if (!r) return;
+    font->get_glyph_bitmap = r->get_bitmap;
+    font->release_glyph = r->release;
+    *r = detail::FontRec{};
+}
+
+/// Bitmap bytes all attached fonts share; shrinking evicts at once
+inline void budget(uint32_t bytes) noexcept {
+    const detail::Lock lock;
+    detail::Tables& t = detail::tables();
+    t.budget = bytes;
+    if (t.slots) detail::trim(t, 0);
+}
+
+[[nodiscard]] inline uint32_t budget() noexcept { return detail::tables().budget; }
+
+[[nodiscard]] inline Stats stats() noexcept {
+    const detail::Lock lock;
+    const detail::Tables& t = detail::tables();
+    uint32_t fonts = 0;
+    for (const detail::FontRec& r : t.fonts) fonts += r.font ? 1 : 0;
+    return Stats{t.hits, t.misses, t.evictions, t.glyphs, t.bytes, t.budget, fonts};
+}
+
+/// Counters of one attached font (zero if not attached)
+[[nodiscard]] inline FontStats stats(const lv_font_t* font) noexcept {
+    const detail::Lock lock;
+    const detail::FontRec* r = detail::rec_of(font);
+    return r ? r->stats : FontStats{};
+}
+
+inline void reset_stats() noexcept {
+    const detail::Lock lock;
+    detail::Tables& t = detail::tables();
+    t.hits = t.misses = t.evictions = 0;
+    for (detail::FontRec& r : t.fonts) {
+        r.stats.hits = r.stats.misses = r.stats.bypassed = 0;
+    }
+}
+
+} // namespace lv::glyph_cache
@@ -19,10 +19,18 @@
  * // Remove when no longer needed:
  * lv::gridnav::remove(grid);
  * @endcode
+ *
+ * With lv::key_nav attached to the keypad or encoder, the arrow keys that
+ * arrive within one frame move the focus once: add() registers the
+ * container, which then focuses and scrolls to the final child only.
+ * Containers with scroll_first keep LVGL's per-key handling.
  */
 
 #include <lvgl.h>
+#include <cstdint>
 #include "object.hpp"
+#include "key_nav.hpp"
+#include "spatial_index.hpp"
 
 #if LV_USE_GRIDNAV
 
@@ -36,15 +44,99 @@ constexpr auto scroll_first          = LV_GRIDNAV_CTRL_SCROLL_FIRST;
 constexpr auto horizontal_move_only  = LV_GRIDNAV_CTRL_HORIZONTAL_MOVE_ONLY;
 constexpr auto vertical_move_only    = LV_GRIDNAV_CTRL_VERTICAL_MOVE_ONLY;
 
+namespace detail {
+
+/// Child gridnav shows focused (it keeps LV_STATE_FOCUSED on it)
+[[nodiscard]] inline lv_obj_t* focused_child(lv_obj_t* cont) noexcept {
+    const uint32_t n = lv_obj_get_child_count(cont);
+    for (uint32_t i = 0; i < n; ++i) {
+        lv_obj_t* c = lv_obj_get_child(cont, static_cast<int32_t>(i));
+        if (lv_obj_has_state(c, LV_STATE_FOCUSED)) return c;
+    }
+    return nullptr;
+}
+
+/// Visible child of `cont` closest to `a` in `dir` (lv::SpatialIndex's score), nullptr if none
+[[nodiscard]] inline lv_obj_t* nearest(lv_obj_t* cont, lv_obj_t* from, const lv_area_t& a, lv_dir_t dir) noexcept {
+    lv_obj_t* best = nullptr;
+    int32_t best_score = INT32_MAX;
+    const uint32_t n = lv_obj_get_child_count(cont);
+    for (uint32_t i = 0; i < n; ++i) {
+        lv_obj_t* c = lv_obj_get_child(cont, static_cast<int32_t>(i));
+        if (c == from || lv_obj_has_flag(c, LV_OBJ_FLAG_HIDDEN)) continue;
+        lv_area_t b;
+        lv_obj_get_coords(c, &b);
+        const int32_t score = lv::detail::direction_score(a, b, dir);
+        if (score >= 0 && score < best_score) {
+            best_score = score;
+            best = c;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Rollover target: the next row's first child (right), the previous
+ * row's last (left), the first row (down) or the last row (up)
+ */
+[[nodiscard]] inline lv_obj_t* roll_over(lv_obj_t* cont, lv_obj_t* from, const lv_area_t& a, lv_dir_t dir) noexcept {
+    constexpr int32_t far = 1 << 24;    // a probe outside any sensible layout
+    lv_area_t probe = a;
+    switch (dir) {
+    case LV_DIR_RIGHT: probe.x1 = probe.x2 = a.x1 - far; dir = LV_DIR_BOTTOM; break;
+    case LV_DIR_LEFT: probe.x1 = probe.x2 = a.x2 + far; dir = LV_DIR_TOP; break;
+    case LV_DIR_BOTTOM: probe.y1 = probe.y2 = a.y1 - far; break;
+    case LV_DIR_TOP: probe.y1 = probe.y2 = a.y2 + far; break;
+    default: return nullptr;
+    }
+    lv_obj_t* obj = nearest(cont, from, probe, dir);
+    if (obj || probe.y1 != a.y1) return obj;
+    // Past the last row (right) or before the first (left): start over on the other end
+    if (dir == LV_DIR_BOTTOM) probe.y1 = probe.y2 = a.y1 - far;
+    else probe.y1 = probe.y2 = a.y2 + far;
+    return nearest(cont, from, probe, dir);
+}
+
+/// key_nav step: walk dx, dy children from the focused one, then focus the last only
+inline void key_nav_step(lv_obj_t* cont, void* ctx, int32_t dx, int32_t dy) noexcept {
+    const auto ctrl = static_cast<lv_gridnav_ctrl_t>(reinterpret_cast<uintptr_t>(ctx));
+    lv_obj_t* from = focused_child(cont);
+    lv_obj_t* at = from;
+    const lv_dir_t dir = dx > 0 ? LV_DIR_RIGHT : dx < 0 ? LV_DIR_LEFT : dy > 0 ? LV_DIR_BOTTOM : LV_DIR_TOP;
+    int32_t left = dx != 0 ? dx : dy;
+    if (left < 0) left = -left;
+    if (!at) {
+        at = lv_obj_get_child(cont, 0);    // gridnav starts on the first child
+        --left;
+    }
+    for (; at && left > 0; --left) {
+        lv_area_t a;
+        lv_obj_get_coords(at, &a);
+        lv_obj_t* next = nearest(cont, at, a, dir);
+        if (!next && (ctrl & LV_GRIDNAV_CTRL_ROLLOVER)) next = roll_over(cont, at, a, dir);
+        if (!next) break;
+        at = next;
+    }
+    if (at && at != from) lv_gridnav_set_focused(cont, at, LV_ANIM_ON);
+}
+
+} // namespace detail
+
 // ==================== Functions ====================
 
 /// Enable grid navigation on a container
 inline void add(ObjectView obj, lv_gridnav_ctrl_t ctrl = LV_GRIDNAV_CTRL_NONE) noexcept {
     lv_gridnav_add(obj.get(), ctrl);
+    if (ctrl & LV_GRIDNAV_CTRL_SCROLL_FIRST) return;    // scrolling depends on each key
+    uint8_t axes = key_nav::both;
+    if (ctrl & LV_GRIDNAV_CTRL_HORIZONTAL_MOVE_ONLY) axes = key_nav::horizontal;
+    if (ctrl & LV_GRIDNAV_CTRL_VERTICAL_MOVE_ONLY) axes = key_nav::vertical;
+    key_nav::add(obj.get(), &detail::key_nav_step, reinterpret_cast<void*>(static_cast<uintptr_t>(ctrl)), axes);
 }
 
 /// Disable grid navigation on a container
 inline void remove(ObjectView obj) noexcept {
+    key_nav::remove(obj.get());
     lv_gridnav_remove(obj.get());
 }
 
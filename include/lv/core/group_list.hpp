@@ -0,0 +1,118 @@
+#pragma once
+
+/**
+ * @file group_list.hpp
+ * @brief O(n) bulk focus group membership (opt-in)
+ *
+ * lv_group_add_obj() scans the whole group for duplicates, so adding n
+ * settings rows one by one through Group::add_range() is O(n^2), and a row
+ * shown again by Group::set_hidden() goes back at the end of the group.
+ * The functions here link members straight into the group's list: one
+ * O(n) pass for a container's children, and a shown row goes back before
+ * its first later sibling in the group.
+ *
+ * @code
+ * #include <lv/core/group_list.hpp>
+ *
+ * lv::group_list::add_range(group, settings);
+ * lv::group_list::set_hidden(group, advanced, !show_advanced);
+ * @endcode
+ *
+ * Not included by lv.hpp: it writes lv_group_t's object list and the
+ * member's group pointer, neither of which is public. Checked against
+ * LVGL 9.4 (see LV_CPP_INTERNALS_OK).
+ *
+ * Heap allocation: one list node per member (LVGL's, as lv_group_add_obj())
+ */
+
+#include <lvgl.h>
+#include "version.hpp"
+
+#if !LV_CPP_INTERNALS_OK
+#error "group_list.hpp reads LVGL internals checked against LVGL 9.4; see LV_CPP_INTERNALS_OK"
+#endif
+
+#include <src/core/lv_group_private.h>  // obj_ll, obj_focus
+#include <src/core/lv_obj_private.h>    // spec_attr->group_p
+#include "focus.hpp"
+
+namespace lv::group_list {
+
+namespace detail {
+
+/// Append `obj` (or insert it before the member node `before`) without lv_group_add_obj()'s duplicate scan
+inline void link(lv_group_t* group, lv_obj_t* obj, lv_obj_t** before) noexcept {
+    if (lv_obj_get_group(obj)) lv_group_remove_obj(obj);
+    auto** node = static_cast<lv_obj_t**>(before ? lv_ll_ins_prev(&group->obj_ll, before)
+                                                 : lv_ll_ins_tail(&group->obj_ll));
+    if (!node) return;
+    *node = obj;
+    lv_obj_allocate_spec_attr(obj);
+    obj->spec_attr->group_p = group;
+    lv::detail::batch_focus_states(obj);
+    if (!group->obj_focus) lv_group_focus_obj(obj);
+}
+
+/// Node of the first later sibling of `obj` in `group`, nullptr to append
+[[nodiscard]] inline lv_obj_t** next_member_node(lv_group_t* group, lv_obj_t* obj) noexcept {
+    lv_obj_t* parent = lv_obj_get_parent(obj);
+    if (!parent) return nullptr;
+    const uint32_t n = lv_obj_get_child_count(parent);
+    lv_obj_t* next = nullptr;
+    for (uint32_t i = static_cast<uint32_t>(lv_obj_get_index(obj)) + 1; i < n && !next; ++i) {
+        lv_obj_t* c = lv_obj_get_child(parent, static_cast<int32_t>(i));
+        if (lv_obj_get_group(c) == group) next = c;
+    }
+    if (!next) return nullptr;
+    lv_ll_t* ll = &group->obj_ll;
+    for (auto** node = static_cast<lv_obj_t**>(lv_ll_get_head(ll)); node;
+         node = static_cast<lv_obj_t**>(lv_ll_get_next(ll, node))) {
+        if (*node == next) return node;
+    }
+    return nullptr;
+}
+
+} // namespace detail
+
+/**
+ * @brief Group::add_range() in one O(n) pass over the children
+ *
+ * Adds the visible children of `parent` for which `filter(ObjectView)` is
+ * true, in child order. Children already in `group` stay where they are.
+ */
+template<typename F>
+void add_range(lv_group_t* group, ObjectView parent, F&& filter) {
+    if (!group || !parent) return;
+    const uint32_t n = lv_obj_get_child_count(parent.get());
+    for (uint32_t i = 0; i < n; ++i) {
+        lv_obj_t* c = lv_obj_get_child(parent.get(), static_cast<int32_t>(i));
+        if (lv_obj_get_group(c) == group || lv_obj_has_flag(c, LV_OBJ_FLAG_HIDDEN)) continue;
+        if (filter(ObjectView(c))) detail::link(group, c, nullptr);
+    }
+}
+
+/// Add all visible children of `parent`, in child order
+inline void add_range(lv_group_t* group, ObjectView parent) noexcept {
+    add_range(group, parent, [](ObjectView) noexcept { return true; });
+}
+
+/**
+ * @brief Group::set_hidden() that keeps the child order
+ *
+ * Shown again, `obj` goes back before its first later sibling in `group`
+ * (at the end if none).
+ */
+inline void set_hidden(lv_group_t* group, ObjectView obj, bool hidden) noexcept {
+    if (!group || !obj) return;
+    if (hidden) {
+        lv_obj_add_flag(obj.get(), LV_OBJ_FLAG_HIDDEN);
+        if (lv_obj_get_group(obj.get()) == group) lv_group_remove_obj(obj.get());
+    } else {
+        lv_obj_remove_flag(obj.get(), LV_OBJ_FLAG_HIDDEN);
+        if (lv_obj_get_group(obj.get()) != group) {
+            detail::link(group, obj.get(), detail::next_member_node(group, obj.get()));
+        }
+    }
+}
+
+} // namespace lv::group_list
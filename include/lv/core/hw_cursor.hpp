@@ -0,0 +1,143 @@
+#pragma once
+
+/**
+ * @file hw_cursor.hpp
+ * @brief Move a hardware cursor from a pointer's reads, outside LVGL's rendering
+ *
+ * lv_indev_set_cursor() draws the cursor as an image on the system
+ * layer, so every mouse move invalidates the old and the new cursor area
+ * and renders both, up to once per frame for as long as the mouse moves.
+ * Backends with a cursor plane instead position the cursor in hardware.
+ * follow() wraps the pointer's read callback and passes each new
+ * position to the backend, before LVGL processes the point:
+ *
+ * @code
+ * static lv::DRMFlipDisplay display("/dev/dri/card0");
+ * lv_indev_t* mouse = lv_evdev_create(LV_INDEV_TYPE_POINTER, "/dev/input/event1");
+ * if (!display.cursor(mouse, &lv::cursor_arrow)) {
+ *     lv_indev_set_cursor(mouse, arrow_image);   // no cursor plane: software cursor
+ * }
+ * @endcode
+ *
+ * Positions are the ones the driver reports, in the panel's own
+ * orientation, which is what a cursor plane expects. Backends use
+ * DRMFlipDisplay::cursor() and SDLDisplay::cursor(); follow() is the
+ * building block for others.
+ *
+ * Heap allocation: NONE (LV_CPP_HW_CURSOR_INDEVS fixed slots)
+ */
+
+#include <lvgl.h>
+#include <cstdint>
+
+#ifndef LV_CPP_HW_CURSOR_INDEVS
+/// Pointers whose position can drive a hardware cursor at once
+#define LV_CPP_HW_CURSOR_INDEVS 2
+#endif
+
+namespace lv::hw_cursor {
+
+/// Place the cursor image's hot spot at (x, y)
+using MoveFn = void (*)(void* ctx, int32_t x, int32_t y);
+
+struct Stats {
+    uint32_t reads = 0;    ///< Pointer reads seen
+    uint32_t moves = 0;    ///< Positions passed to a backend
+};
+
+namespace detail {
+
+struct Follower {
+    lv_indev_t* indev = nullptr;   ///< nullptr: free slot
+    lv_indev_read_cb_t read_cb = nullptr;
+    MoveFn move = nullptr;
+    void* ctx = nullptr;
+    lv_point_t last{-1, -1};
+};
+
+struct State {
+    Follower followers[LV_CPP_HW_CURSOR_INDEVS];
+    Stats stats;
+};
+
+[[nodiscard]] inline State& state() noexcept {
+    static State s;
+    return s;
+}
+
+[[nodiscard]] inline Follower* find(const lv_indev_t* indev) noexcept {
+    for (Follower& f : state().followers) {
+        if (f.indev == indev) return &f;
+    }
+    return nullptr;
+}
+
+inline void read_cb(lv_indev_t* indev, lv_indev_data_t* data) {
+    Follower* f = find(indev);
+    if (!f) return;
+    if (f->read_cb) f->read_cb(indev, data);
+    Stats& st = state().stats;
+    ++st.reads;
+    if (data->point.x == f->last.x && data->point.y == f->last.y) return;
+    f->last = data->point;
+    f->move(f->ctx, data->point.x, data->point.y);
+    ++st.moves;
+}
+
+inline void release(Follower& f) noexcept {
+    if (lv_indev_get_read_cb(f.indev) == &read_cb) lv_indev_set_read_cb(f.indev, f.read_cb);
+    f = Follower{};
+}
+
+inline void delete_cb(lv_event_t* e) noexcept {
+    if (Follower* f = find(static_cast<lv_indev_t*>(lv_event_get_current_target(e)))) release(*f);
+}
+
+} // namespace detail
+
+/**
+ * @brief Call `move` with every new position `pointer` reports
+ *
+ * Following an indev again replaces its backend.
+ * @return false for non-pointer devices or without a free slot
+ */
+inline bool follow(lv_indev_t* pointer, MoveFn move, void* ctx = nullptr) noexcept {
+    if (!pointer || !move || lv_indev_get_type(pointer) != LV_INDEV_TYPE_POINTER) return false;
+    detail::Follower* f = detail::find(pointer);
+    if (!f) {
+        f = detail::find(nullptr);
+        if (!f) {
+            LV_LOG_WARN("hw_cursor: raise LV_CPP_HW_CURSOR_INDEVS");
+            return false;
+        }
+        f->indev = pointer;
+        f->read_cb = lv_indev_get_read_cb(pointer);
+        lv_indev_set_read_cb(pointer, &detail::read_cb);
+        lv_indev_add_event_cb(pointer, &detail::delete_cb, LV_EVENT_DELETE, nullptr);
+    }
+    f->move = move;
+    f->ctx = ctx;
+    f->last = {-1, -1};
+    return true;
+}
+
+/// Give `pointer` its read callback back
+inline void unfollow(lv_indev_t* pointer) noexcept {
+    detail::Follower* f = detail::find(pointer);
+    if (!f) return;
+    lv_indev_remove_event_cb_with_user_data(pointer, &detail::delete_cb, nullptr);
+    detail::release(*f);
+}
+
+/// Send the last position to the backend again, e.g. after a mode set reset the cursor
+inline void repeat(lv_indev_t* pointer) noexcept {
+    if (detail::Follower* f = detail::find(pointer); f && f->last.x >= 0) f->move(f->ctx, f->last.x, f->last.y);
+}
+
+[[nodiscard]] inline bool following(const lv_indev_t* pointer) noexcept { return detail::find(pointer) != nullptr; }
+
+[[nodiscard]] inline Stats stats() noexcept { return detail::state().stats; }
+
+inline void reset_stats() noexcept { detail::state().stats = Stats{}; }
+
+} // namespace lv::hw_cursor
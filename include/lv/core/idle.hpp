@@ -0,0 +1,359 @@
+#pragma once
+
+/**
+ * @file idle.hpp
+ * @brief Cooperative UI-thread work run in the slack left after each frame
+ *
+ * Building 500 list rows or filling a large table from one callback holds
+ * lv_timer_handler() until it is done, and the display misses every frame
+ * in between. Work that can be split goes to lv::idle::schedule() instead.
+ * After each refresh of the display, the scheduler runs chunks of it in the
+ * time that is left until the next refresh: the refresh period minus the
+ * last render time, minus a safety margin.
+ *
+ * @code
+ * // A chunk returns true while there is more to do
+ * lv::idle::schedule([this, i = 0u]() mutable {
+ *     add_row(i++);
+ *     return i < m_rows.size();
+ * }, lv::idle::Priority::low);
+ *
+ * // Coroutines yield only when the frame's slack is used up
+ * lv::Task build_list(lv::ObjectView list) {
+ *     for (uint32_t i = 0; i < 500; ++i) {
+ *         make_row(list, i);
+ *         co_await lv::yield_if_over_budget();
+ *     }
+ * }
+ * @endcode
+ *
+ * The highest priority with pending work always runs first. Tasks of the
+ * same priority take turns, one chunk each. At least Config::min_chunks
+ * chunks run after every frame, so work still progresses when rendering
+ * uses the whole period. A coroutine that yields is resumed by the
+ * scheduler like any other task. Destroying it while it waits frees its
+ * slot.
+ *
+ * While work is pending, the refresh timer is kept running so that a
+ * display idled by EventLoop::idle_refresh() still schedules the work.
+ *
+ * Heap allocation: NONE (LV_CPP_IDLE_TASKS fixed slots with inline
+ * callables; LVGL allocates the display event descriptors)
+ */
+
+#include <lvgl.h>
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#ifndef LV_CPP_IDLE_TASKS
+/// Scheduled tasks and waiting coroutines at once
+#define LV_CPP_IDLE_TASKS 16
+#endif
+
+#ifndef LV_CPP_IDLE_TASK_STORAGE
+/// Inline capture storage per scheduled callable, in bytes
+#define LV_CPP_IDLE_TASK_STORAGE (3 * sizeof(void*))
+#endif
+
+namespace lv {
+
+namespace idle {
+
+/// Order in which pending work gets the slack
+enum class Priority : uint8_t { high, normal, low };
+
+struct Config {
+    lv_display_t* display = nullptr;   ///< Display whose frames pace the work (nullptr = default)
+    uint16_t margin_us = 1000;         ///< Slack kept free before the next refresh
+    uint8_t min_chunks = 1;            ///< Chunks run after every frame, even without slack
+};
+
+struct Stats {
+    uint32_t frames;            ///< Frames after which work ran
+    uint32_t chunks;            ///< Chunks run (coroutine resumptions included)
+    uint32_t starved_frames;    ///< Frames without slack (only min_chunks ran)
+    uint32_t render_us;         ///< Render time of the last frame
+    uint32_t slack_us;          ///< Slack of the last frame
+    uint32_t used_us;           ///< Time spent in chunks after the last frame
+};
+
+namespace detail {
+
+struct Slot {
+    alignas(std::max_align_t) unsigned char storage[LV_CPP_IDLE_TASK_STORAGE];
+    bool (*run)(void* storage) = nullptr;
+    void (*destroy)(void* storage) noexcept = nullptr;
+    std::coroutine_handle<> handle;     ///< Waiting coroutine (run == nullptr)
+    int32_t* waiter = nullptr;          ///< Awaiter's slot index, reset when resumed
+    uint32_t id = 0;                    ///< 0: free
+    uint32_t turn = 0;                  ///< Last round it ran in
+    Priority prio = Priority::normal;
+};
+
+struct Scheduler {
+    Slot slots[LV_CPP_IDLE_TASKS];
+    Config cfg{};
+    lv_display_t* disp = nullptr;       ///< Display the callbacks are attached to
+    uint64_t refr_start = 0;
+    uint64_t frame_end = 0;             ///< End of the last refresh
+    uint64_t deadline = 0;              ///< End of the running slice (0: none)
+    uint32_t next_id = 1;
+    uint32_t round = 0;
+    uint32_t count = 0;
+    Slot* running = nullptr;            ///< Slot whose chunk is executing
+    bool cancel_running = false;        ///< cancel() of the running slot, applied after its chunk
+    Stats stats{};
+};
+
+[[nodiscard]] inline Scheduler& scheduler() noexcept {
+    static Scheduler s;
+    return s;
+}
+
+[[nodiscard]] inline uint64_t now_us() noexcept {
+    using namespace std::chrono;
+    return static_cast<uint64_t>(duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+[[nodiscard]] inline uint32_t period_us(lv_display_t* disp) noexcept {
+    lv_timer_t* t = disp ? lv_display_get_refr_timer(disp) : nullptr;
+    return (t ? lv_timer_get_period(t) : LV_DEF_REFR_PERIOD) * 1000u;
+}
+
+/// Refresh period minus the last render time and the margin
+[[nodiscard]] inline uint32_t slack_us(const Scheduler& s) noexcept {
+    const uint32_t period = period_us(s.disp);
+    const uint32_t used = s.stats.render_us + s.cfg.margin_us;
+    return period > used ? period - used : 0;
+}
+
+/// Next slot to run: highest priority, then the one that waited longest
+[[nodiscard]] inline Slot* pick(Scheduler& s) noexcept {
+    Slot* best = nullptr;
+    for (Slot& c : s.slots) {
+        if (c.id == 0) continue;
+        if (!best || c.prio < best->prio || (c.prio == best->prio && c.turn < best->turn)) best = &c;
+    }
+    return best;
+}
+
+inline void release(Scheduler& s, Slot& slot) noexcept {
+    if (slot.destroy) slot.destroy(slot.storage);
+    slot = Slot{};
+    --s.count;
+}
+
+/// Run one chunk of `slot`; frees it when the work is done
+inline void run_chunk(Scheduler& s, Slot& slot) {
+    slot.turn = ++s.round;
+    ++s.stats.chunks;
+    if (!slot.run) {
+        const std::coroutine_handle<> h = slot.handle;
+        *slot.waiter = -1;
+        release(s, slot);
+        h.resume();
+        return;
+    }
+    s.running = &slot;
+    const bool more = slot.run(slot.storage);
+    s.running = nullptr;
+    if (!more || s.cancel_running) release(s, slot);
+    s.cancel_running = false;
+}
+
+inline void refr_start_cb(lv_event_t*) noexcept {
+    scheduler().refr_start = now_us();
+}
+
+/// Spend the slack of the frame that just ended on pending work
+inline void refr_ready_cb(lv_event_t*) {
+    Scheduler& s = scheduler();
+    const uint64_t start = now_us();
+    s.frame_end = start;
+    s.stats.render_us = s.refr_start ? static_cast<uint32_t>(start - s.refr_start) : 0;
+    s.stats.slack_us = slack_us(s);
+    if (s.count == 0) return;
+
+    ++s.stats.frames;
+    if (s.stats.slack_us == 0) ++s.stats.starved_frames;
+    s.deadline = start + s.stats.slack_us;
+    uint32_t ran = 0;
+    while (Slot* slot = pick(s)) {
+        if (ran >= s.cfg.min_chunks && now_us() >= s.deadline) break;
+        run_chunk(s, *slot);
+        ++ran;
+    }
+    s.deadline = 0;
+    s.stats.used_us = static_cast<uint32_t>(now_us() - start);
+}
+
+inline void detach_display(Scheduler& s) noexcept {
+    if (!s.disp) return;
+    lv_display_remove_event_cb_with_user_data(s.disp, &refr_start_cb, nullptr);
+    lv_display_remove_event_cb_with_user_data(s.disp, &refr_ready_cb, nullptr);
+    s.disp = nullptr;
+}
+
+inline void display_delete_cb(lv_event_t*) noexcept {
+    Scheduler& s = scheduler();
+    lv_display_remove_event_cb_with_user_data(s.disp, &display_delete_cb, nullptr);
+    detach_display(s);
+}
+
+/// Hook the pacing display and keep its refresh timer running while work is pending
+inline bool wake(Scheduler& s) noexcept {
+    lv_display_t* disp = s.cfg.display ? s.cfg.display : lv_display_get_default();
+    if (!disp) return false;
+    if (s.disp != disp) {
+        if (s.disp) lv_display_remove_event_cb_with_user_data(s.disp, &display_delete_cb, nullptr);
+        detach_display(s);
+        s.disp = disp;
+        s.refr_start = 0;
+        lv_display_add_event_cb(disp, &refr_start_cb, LV_EVENT_REFR_START, nullptr);
+        lv_display_add_event_cb(disp, &refr_ready_cb, LV_EVENT_REFR_READY, nullptr);
+        lv_display_add_event_cb(disp, &display_delete_cb, LV_EVENT_DELETE, nullptr);
+    }
+    if (lv_timer_t* t = lv_display_get_refr_timer(disp)) lv_timer_resume(t);
+    return true;
+}
+
+/// Free slot for new work, or nullptr (logged) when the table is full
+[[nodiscard]] inline Slot* acquire(Scheduler& s, Priority prio) noexcept {
+    if (!wake(s)) return nullptr;
+    for (Slot& c : s.slots) {
+        if (c.id != 0) continue;
+        c.id = s.next_id++;
+        if (s.next_id == 0) s.next_id = 1;
+        c.prio = prio;
+        c.turn = s.round;
+        ++s.count;
+        return &c;
+    }
+    LV_LOG_WARN("idle: task table full, raise LV_CPP_IDLE_TASKS");
+    return nullptr;
+}
+
+} // namespace detail
+
+/// Change the pacing display, margin or minimum progress
+inline void configure(const Config& cfg) noexcept {
+    detail::scheduler().cfg = cfg;
+    if (detail::scheduler().count) detail::wake(detail::scheduler());
+}
+
+/**
+ * @brief Run `fn()` in the slack after each frame until it returns false
+ * @param fn Callable returning bool (true: call again), at most LV_CPP_IDLE_TASK_STORAGE bytes
+ * @return Task id for cancel(), 0 if the table is full or there is no display
+ */
+template<typename F>
+uint32_t schedule(F&& fn, Priority prio = Priority::normal) noexcept {
+    using Fn = std::decay_t<F>;
+    static_assert(std::is_invocable_r_v<bool, Fn&>, "idle task must return bool (true: more work)");
+    static_assert(sizeof(Fn) <= LV_CPP_IDLE_TASK_STORAGE && alignof(Fn) <= alignof(std::max_align_t),
+                  "idle task capture too large, raise LV_CPP_IDLE_TASK_STORAGE");
+    static_assert(std::is_nothrow_destructible_v<Fn>, "idle task must be nothrow destructible");
+
+    detail::Slot* slot = detail::acquire(detail::scheduler(), prio);
+    if (!slot) return 0;
+    ::new (static_cast<void*>(slot->storage)) Fn(std::forward<F>(fn));
+    slot->run = [](void* p) -> bool { return (*std::launder(static_cast<Fn*>(p)))(); };
+    slot->destroy = [](void* p) noexcept { std::launder(static_cast<Fn*>(p))->~Fn(); };
+    return slot->id;
+}
+
+/// Run `(instance->*MemFn)()` after each frame until it returns false
+template<auto MemFn, typename T>
+uint32_t schedule(T* instance, Priority prio = Priority::normal) noexcept {
+    return schedule([instance]() -> bool { return (instance->*MemFn)(); }, prio);
+}
+
+/// Drop task `id` (may be called from inside its own chunk)
+inline void cancel(uint32_t id) noexcept {
+    detail::Scheduler& s = detail::scheduler();
+    if (id == 0) return;
+    for (detail::Slot& c : s.slots) {
+        if (c.id != id || !c.run) continue;
+        if (&c == s.running) s.cancel_running = true;   // the chunk's captures are still in use
+        else detail::release(s, c);
+        return;
+    }
+}
+
+/// Tasks and coroutines waiting for slack
+[[nodiscard]] inline uint32_t pending() noexcept {
+    return detail::scheduler().count;
+}
+
+/**
+ * @brief Whether the current frame's slack is used up
+ *
+ * Inside the scheduler this is the slice deadline; elsewhere it is the
+ * time since the last frame ended compared with its slack. Before the
+ * first frame on a display there is no slack to measure: true.
+ */
+[[nodiscard]] inline bool over_budget() noexcept {
+    const detail::Scheduler& s = detail::scheduler();
+    if (s.deadline) return detail::now_us() >= s.deadline;
+    if (!s.frame_end) return true;
+    return detail::now_us() - s.frame_end >= s.stats.slack_us;
+}
+
+[[nodiscard]] inline Stats stats() noexcept {
+    return detail::scheduler().stats;
+}
+
+/// Zero the counters (last render time and slack are kept)
+inline void reset_stats() noexcept {
+    Stats& st = detail::scheduler().stats;
+    st = Stats{0, 0, 0, st.render_us, st.slack_us, 0};
+}
+
+} // namespace idle
+
+/**
+ * @brief Awaitable that suspends only when the frame's slack is used up
+ *
+ * The coroutine then waits in the idle scheduler at the given priority and
+ * resumes in the slack after a later frame. If the task table is full it
+ * continues immediately.
+ */
+class IdleYieldAwaiter {
+    idle::Priority m_prio;
+    int32_t m_slot = -1;
+
+public:
+    explicit IdleYieldAwaiter(idle::Priority prio) noexcept : m_prio(prio) {}
+    ~IdleYieldAwaiter() {
+        if (m_slot >= 0) idle::detail::release(idle::detail::scheduler(), idle::detail::scheduler().slots[m_slot]);
+    }
+
+    IdleYieldAwaiter(const IdleYieldAwaiter&) = delete;
+    IdleYieldAwaiter& operator=(const IdleYieldAwaiter&) = delete;
+
+    [[nodiscard]] bool await_ready() const noexcept { return !idle::over_budget(); }
+
+    bool await_suspend(std::coroutine_handle<> h) noexcept {
+        idle::detail::Scheduler& s = idle::detail::scheduler();
+        idle::detail::Slot* slot = idle::detail::acquire(s, m_prio);
+        if (!slot) return false;
+        slot->handle = h;
+        slot->waiter = &m_slot;
+        m_slot = static_cast<int32_t>(slot - s.slots);
+        return true;
+    }
+
+    void await_resume() const noexcept {}
+};
+
+/// Continue if the frame has slack left, otherwise resume after a later frame
+[[nodiscard]] inline IdleYieldAwaiter yield_if_over_budget(idle::Priority prio = idle::Priority::normal) noexcept {
+    return IdleYieldAwaiter(prio);
+}
+
+} // namespace lv
@@ -0,0 +1,141 @@
+#pragma once
+
+/**
+ * @file image_cache.hpp
+ * @brief Image and image-header cache control: budget, entries, drop
+ *
+ * LVGL keeps decoded images in a size-bounded cache (bytes, LV_CACHE_DEF_SIZE)
+ * and image headers in a count-bounded one (LV_IMAGE_HEADER_CACHE_DEF_CNT).
+ * This wraps both with a budget setter and getter, an entry count and drops:
+ *
+ * @code
+ * lv::image_cache::set_budget(4 * 1024 * 1024);
+ * ...
+ * lv::image_cache::drop("A:/icons/splash.png");   // not shown again
+ * @endcode
+ *
+ * LVGL has no public getter for a cache's budget, so budget() returns the
+ * last set_budget() (LV_CACHE_DEF_SIZE until then); resize through these
+ * setters rather than lv_image_cache_resize() to keep it exact.
+ *
+ * Hit, miss and eviction counts, the decoded bytes and pinning are in
+ * image_cache_stats.hpp (opt-in).
+ *
+ * Heap allocation: NONE
+ */
+
+#include <lvgl.h>
+#include <cstdint>
+
+namespace lv::image_cache {
+
+/// Snapshot of one cache
+struct Stats {
+    uint32_t entries = 0;
+    uint32_t bytes = 0;        ///< Image cache: decoded bytes; header cache: entry count
+    uint32_t budget = 0;       ///< Maximum of `bytes` (0: cache disabled)
+    uint32_t hits = 0;         ///< Lookups served from the cache (since enable_stats())
+    uint32_t misses = 0;       ///< Lookups that had to decode / read the header
+    uint32_t evictions = 0;    ///< Entries pushed out to make room
+
+    [[nodiscard]] uint32_t lookups() const noexcept { return hits + misses; }
+
+    [[nodiscard]] uint32_t hit_rate_pct() const noexcept {
+        return lookups() ? static_cast<uint32_t>(static_cast<uint64_t>(hits) * 100 / lookups()) : 0;
+    }
+};
+
+namespace detail {
+
+/// Budgets as last set through this wrapper
+struct Budgets {
+    uint32_t image = LV_CACHE_DEF_SIZE;
+    uint32_t header = LV_IMAGE_HEADER_CACHE_DEF_CNT;
+};
+
+[[nodiscard]] inline Budgets& budgets() noexcept {
+    static Budgets b;
+    return b;
+}
+
+/// Entries walked by lv_iter_inspect (no user data in its callback)
+[[nodiscard]] inline uint32_t& inspect_count() noexcept {
+    static uint32_t n = 0;
+    return n;
+}
+
+inline void count_entry(void*) { ++inspect_count(); }
+
+[[nodiscard]] inline uint32_t count_entries(lv_iter_t* iter) noexcept {
+    if (!iter) return 0;
+    inspect_count() = 0;
+    lv_iter_inspect(iter, &count_entry);
+    lv_iter_destroy(iter);
+    return inspect_count();
+}
+
+} // namespace detail
+
+// ==================== Image Cache ====================
+
+/// Image cache is enabled (budget > 0)
+[[nodiscard]] inline bool enabled() noexcept { return lv_image_cache_is_enabled(); }
+
+/**
+ * @brief Set the decoded-image budget in bytes
+ * @param evict_now Evict down to the new budget immediately (else as entries are added)
+ */
+inline void set_budget(uint32_t bytes, bool evict_now = true) noexcept {
+    lv_image_cache_resize(bytes, evict_now);
+    detail::budgets().image = bytes;
+}
+
+/// Budget as last set through set_budget()
+[[nodiscard]] inline uint32_t budget() noexcept { return detail::budgets().image; }
+
+/// Decoded images currently cached
+[[nodiscard]] inline uint32_t entries() noexcept {
+    return detail::count_entries(lv_image_cache_iter_create());
+}
+
+/// Drop the decoded image of `src` (pinned entries go once unpinned)
+inline void drop(const void* src) noexcept {
+    if (src) lv_image_cache_drop(src);
+}
+
+/// Drop every unpinned decoded image
+inline void drop_all() noexcept { lv_image_cache_drop(nullptr); }
+
+/// LV_LOG_USER the cache content (LVGL's own dump)
+inline void dump() noexcept { lv_image_cache_dump(); }
+
+// ==================== Header Cache ====================
+
+namespace header {
+
+[[nodiscard]] inline bool enabled() noexcept { return lv_image_header_cache_is_enabled(); }
+
+/// Set the number of image headers kept
+inline void set_budget(uint32_t count, bool evict_now = true) noexcept {
+    lv_image_header_cache_resize(count, evict_now);
+    detail::budgets().header = count;
+}
+
+/// Budget as last set through set_budget()
+[[nodiscard]] inline uint32_t budget() noexcept { return detail::budgets().header; }
+
+[[nodiscard]] inline uint32_t entries() noexcept {
+    return detail::count_entries(lv_image_header_cache_iter_create());
+}
+
+inline void drop(const void* src) noexcept {
+    if (src) lv_image_header_cache_drop(src);
+}
+
+inline void drop_all() noexcept { lv_image_header_cache_drop(nullptr); }
+
+inline void dump() noexcept { lv_image_header_cache_dump(); }
+
+} // namespace header
+
+} // namespace lv::image_cache
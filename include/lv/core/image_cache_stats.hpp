@@ -0,0 +1,260 @@
+#pragma once
+
+/**
+ * @file image_cache_stats.hpp
+ * @brief Image cache hit/miss/eviction counters and pinning (opt-in)
+ *
+ * Hit, miss and eviction counters come from wrapping the cache's class
+ * callbacks (lookup and victim selection) the first time stats are enabled,
+ * so they count from enable_stats() on. Call it at startup to size the cache
+ * from real hit rates, and let a screen pin the images it must never
+ * re-decode:
+ *
+ * @code
+ * #include <lv/core/image_cache_stats.hpp>
+ *
+ * lv::image_cache::enable_stats();
+ * lv::image_cache::set_budget(4 * 1024 * 1024);
+ * lv::image_cache::pin("A:/icons/home.png", home_screen);   // released when home_screen is deleted
+ * ...
+ * lv::image_cache::Stats s = lv::image_cache::stats();
+ * LV_LOG_USER("image cache %u entries, %u/%u B, hit rate %u%%",
+ *             s.entries, s.bytes, s.budget, s.hit_rate_pct());
+ * @endcode
+ *
+ * Pinning holds a decoder reference to the cache entry; referenced entries
+ * are never chosen as eviction victims. Pinned images count against the
+ * budget, and pinning more than the budget makes further decodes uncached.
+ *
+ * Not included by lv.hpp: it reaches the caches through LVGL's globals,
+ * swaps their lv_cache_class_t and keeps lv_image_decoder_dsc_t pins, none
+ * of which is public. Checked against LVGL 9.4 (see LV_CPP_INTERNALS_OK).
+ *
+ * Heap allocation: NONE in the wrapper (LV_CPP_IMAGE_CACHE_PINS fixed pins)
+ */
+
+#include <lvgl.h>
+#include "version.hpp"
+
+#if !LV_CPP_INTERNALS_OK
+#error "image_cache_stats.hpp reads LVGL internals checked against LVGL 9.4; see LV_CPP_INTERNALS_OK"
+#endif
+
+#include <src/core/lv_global.h>                 // img_cache, img_header_cache
+#include <src/misc/cache/lv_cache_private.h>    // lv_cache_t::clz, lv_cache_class_t
+#include <src/draw/lv_image_decoder_private.h>  // lv_image_decoder_dsc_t, cache data
+#include <cstdint>
+#include "image_cache.hpp"
+
+#ifndef LV_CPP_IMAGE_CACHE_PINS
+/// Images that can be pinned at once
+#define LV_CPP_IMAGE_CACHE_PINS 16
+#endif
+
+namespace lv::image_cache {
+
+namespace detail {
+
+/// Counting copy of a cache's class (one per wrapped cache)
+struct Counters {
+    lv_cache_t* cache = nullptr;
+    const lv_cache_class_t* orig = nullptr;
+    lv_cache_class_t cls{};
+    uint32_t hits = 0;
+    uint32_t misses = 0;
+    uint32_t evictions = 0;
+};
+
+enum CacheId : uint32_t { image_id = 0, header_id = 1 };
+
+[[nodiscard]] inline Counters* counters() noexcept {
+    static Counters c[2];
+    return c;
+}
+
+[[nodiscard]] inline Counters* counters_of(const lv_cache_t* cache) noexcept {
+    Counters* c = counters();
+    for (uint32_t i = 0; i < 2; ++i) {
+        if (c[i].cache == cache) return &c[i];
+    }
+    return nullptr;
+}
+
+// Called under the cache lock
+inline lv_cache_entry_t* counting_get(lv_cache_t* cache, const void* key, void* user_data) {
+    Counters* c = counters_of(cache);
+    lv_cache_entry_t* entry = c->orig->get_cb(cache, key, user_data);
+    ++(entry ? c->hits : c->misses);
+    return entry;
+}
+
+inline lv_cache_entry_t* counting_get_victim(lv_cache_t* cache, void* user_data) {
+    Counters* c = counters_of(cache);
+    lv_cache_entry_t* victim = c->orig->get_victim_cb(cache, user_data);
+    if (victim) ++c->evictions;
+    return victim;
+}
+
+[[nodiscard]] inline lv_cache_t* image_cache_ptr() noexcept { return LV_GLOBAL_DEFAULT()->img_cache; }
+[[nodiscard]] inline lv_cache_t* header_cache_ptr() noexcept { return LV_GLOBAL_DEFAULT()->img_header_cache; }
+
+inline void instrument(CacheId id, lv_cache_t* cache) noexcept {
+    Counters& c = counters()[id];
+    if (!cache || c.cache == cache) return;
+    lv_mutex_lock(&cache->lock);    // render threads may be decoding
+    c = Counters{};
+    c.cache = cache;
+    c.orig = cache->clz;
+    c.cls = *cache->clz;
+    c.cls.get_cb = &counting_get;
+    if (c.cls.get_victim_cb) c.cls.get_victim_cb = &counting_get_victim;
+    cache->clz = &c.cls;
+    lv_mutex_unlock(&cache->lock);
+}
+
+[[nodiscard]] inline Stats stats_of(CacheId id, lv_cache_t* cache, uint32_t entries) noexcept {
+    Stats s;
+    if (!cache) return s;
+    s.entries = entries;
+    s.bytes = lv_cache_get_size(cache, nullptr);
+    s.budget = lv_cache_get_max_size(cache, nullptr);
+    const Counters& c = counters()[id];
+    if (c.cache == cache) {
+        s.hits = c.hits;
+        s.misses = c.misses;
+        s.evictions = c.evictions;
+    }
+    return s;
+}
+
+struct Pin {
+    const void* src = nullptr;      ///< nullptr: free slot
+    lv_obj_t* screen = nullptr;     ///< nullptr: pinned until unpin()
+    lv_image_decoder_dsc_t dsc;
+};
+
+[[nodiscard]] inline Pin* pins() noexcept {
+    static Pin p[LV_CPP_IMAGE_CACHE_PINS];
+    return p;
+}
+
+inline void release(Pin& p) noexcept {
+    lv_image_decoder_close(&p.dsc);
+    p.src = nullptr;
+    p.screen = nullptr;
+}
+
+[[nodiscard]] inline bool screen_has_pins(const lv_obj_t* screen) noexcept {
+    Pin* p = pins();
+    for (uint32_t i = 0; i < LV_CPP_IMAGE_CACHE_PINS; ++i) {
+        if (p[i].src && p[i].screen == screen) return true;
+    }
+    return false;
+}
+
+inline void release_screen(lv_obj_t* screen) noexcept {
+    Pin* p = pins();
+    for (uint32_t i = 0; i < LV_CPP_IMAGE_CACHE_PINS; ++i) {
+        if (p[i].src && p[i].screen == screen) release(p[i]);
+    }
+}
+
+inline void screen_delete_cb(lv_event_t* e) {
+    release_screen(static_cast<lv_obj_t*>(lv_event_get_current_target(e)));
+}
+
+} // namespace detail
+
+// ==================== Statistics ====================
+
+/// Start counting hits, misses and evictions of both caches
+inline void enable_stats() noexcept {
+    detail::instrument(detail::image_id, detail::image_cache_ptr());
+    detail::instrument(detail::header_id, detail::header_cache_ptr());
+}
+
+/// Entries, bytes, budget and (after enable_stats()) hit/miss/eviction counts
+[[nodiscard]] inline Stats stats() noexcept {
+    return detail::stats_of(detail::image_id, detail::image_cache_ptr(), entries());
+}
+
+/// Zero the hit/miss/eviction counters of both caches
+inline void reset_stats() noexcept {
+    detail::Counters* c = detail::counters();
+    for (uint32_t i = 0; i < 2; ++i) {
+        c[i].hits = 0;
+        c[i].misses = 0;
+        c[i].evictions = 0;
+    }
+}
+
+// ==================== Pinning ====================
+
+/**
+ * @brief Decode `src` into the cache and keep it there
+ * @param src Image source; must outlive the pin (file path literal, image dsc)
+ * @param screen Unpinned automatically when this screen is deleted (nullptr: until unpin())
+ * @return false if the image cannot be opened or all LV_CPP_IMAGE_CACHE_PINS are used
+ */
+inline bool pin(const void* src, lv_obj_t* screen = nullptr) noexcept {
+    if (!src) return false;
+    detail::Pin* free_pin = nullptr;
+    detail::Pin* p = detail::pins();
+    for (uint32_t i = 0; i < LV_CPP_IMAGE_CACHE_PINS; ++i) {
+        if (p[i].src == src && p[i].screen == screen) return true;
+        if (!p[i].src && !free_pin) free_pin = &p[i];
+    }
+    if (!free_pin) {
+        LV_LOG_WARN("image cache pins exhausted, raise LV_CPP_IMAGE_CACHE_PINS");
+        return false;
+    }
+    lv_image_decoder_args_t args{};
+    args.no_cache = false;
+    if (lv_image_decoder_open(&free_pin->dsc, src, &args) != LV_RESULT_OK) return false;
+    if (screen && !detail::screen_has_pins(screen)) {
+        lv_obj_add_event_cb(screen, &detail::screen_delete_cb, LV_EVENT_DELETE, nullptr);
+    }
+    free_pin->src = src;
+    free_pin->screen = screen;
+    return true;
+}
+
+/// Release every pin of `src`
+inline void unpin(const void* src) noexcept {
+    detail::Pin* p = detail::pins();
+    for (uint32_t i = 0; i < LV_CPP_IMAGE_CACHE_PINS; ++i) {
+        if (p[i].src && p[i].src == src) {
+            lv_obj_t* screen = p[i].screen;
+            detail::release(p[i]);
+            if (screen && !detail::screen_has_pins(screen)) {
+                lv_obj_remove_event_cb_with_user_data(screen, &detail::screen_delete_cb, nullptr);
+            }
+        }
+    }
+}
+
+/// Release the pins held for `screen`
+inline void unpin_screen(lv_obj_t* screen) noexcept {
+    if (!screen || !detail::screen_has_pins(screen)) return;
+    detail::release_screen(screen);
+    lv_obj_remove_event_cb_with_user_data(screen, &detail::screen_delete_cb, nullptr);
+}
+
+/// Images currently pinned
+[[nodiscard]] inline uint32_t pinned() noexcept {
+    uint32_t n = 0;
+    detail::Pin* p = detail::pins();
+    for (uint32_t i = 0; i < LV_CPP_IMAGE_CACHE_PINS; ++i) n += p[i].src != nullptr;
+    return n;
+}
+
+namespace header {
+
+/// Same as image_cache::stats(); `bytes` and `budget` count headers
+[[nodiscard]] inline Stats stats() noexcept {
+    return detail::stats_of(detail::header_id, detail::header_cache_ptr(), entries());
+}
+
+} // namespace header
+
+} // namespace lv::image_cache
@@ -0,0 +1,419 @@
+#pragma once
+
+/**
+ * @file image_loader.hpp
+ * @brief Background image decoding with placeholder and fade-in
+ *
+ * Image::src_async(path) (or image_loader::load()) shows a placeholder and
+ * queues the decode of `path` on a worker thread. The decoded pixels go
+ * into a DrawBufPool buffer, and an LVGL timer swaps them into the image on
+ * the UI thread, optionally fading them in. This keeps a screen with dozens
+ * of PNG icons from decoding them all inside its first render.
+ *
+ * @code
+ * lv::image_loader::set_concurrency(2);
+ * lv::image_loader::set_placeholder(&icon_placeholder);
+ * lv::image_loader::set_fade(150);
+ *
+ * for (const char* path : icon_paths) {
+ *     lv::Image::create(grid).src_async(path);
+ * }
+ * @endcode
+ *
+ * Requests for the same path share one decode and one buffer while any
+ * image uses it. The buffer is freed when the last of those images is
+ * deleted. If decoding fails, or the decoder only decodes on demand (no
+ * full frame), the image falls back to lv_image_set_src(path).
+ *
+ * Threads: with LV_USE_OS != LV_OS_NONE, up to LV_CPP_IMAGE_LOADER_THREADS
+ * lv_thread workers call lv_image_decoder_open() the same way threaded
+ * render units do. Without an OS, the timer decodes one image per tick on
+ * the UI thread. That still spreads the work over frames.
+ *
+ * Heap allocation: NONE in the wrapper (fixed job/binding tables; pixels come
+ * from the DrawBufPool)
+ */
+
+#include <lvgl.h>
+#include <cstdint>
+#include <cstring>
+#include "version.hpp"
+#include "../draw/draw_buf.hpp"
+
+#ifndef LV_CPP_IMAGE_LOADER_THREADS
+/// Maximum decode worker threads
+#define LV_CPP_IMAGE_LOADER_THREADS 2
+#endif
+
+#ifndef LV_CPP_IMAGE_LOADER_JOBS
+/// Distinct sources queued, decoding or in use at once
+#define LV_CPP_IMAGE_LOADER_JOBS 32
+#endif
+
+#ifndef LV_CPP_IMAGE_LOADER_BINDINGS
+/// Images waiting for or showing an async-loaded source
+#define LV_CPP_IMAGE_LOADER_BINDINGS 64
+#endif
+
+#ifndef LV_CPP_IMAGE_LOADER_PATH
+/// Longest path stored (longer ones load synchronously)
+#define LV_CPP_IMAGE_LOADER_PATH 64
+#endif
+
+#ifndef LV_CPP_IMAGE_LOADER_STACK
+/// Stack of each worker thread in bytes
+#define LV_CPP_IMAGE_LOADER_STACK (32 * 1024)
+#endif
+
+#ifndef LV_CPP_IMAGE_LOADER_POLL_MS
+/// Period of the UI-thread timer swapping decoded images in
+#define LV_CPP_IMAGE_LOADER_POLL_MS 15
+#endif
+
+namespace lv::image_loader {
+
+namespace detail {
+
+enum class JobState : uint8_t { free, queued, decoding, done, failed };
+
+struct Job {
+    char path[LV_CPP_IMAGE_LOADER_PATH];
+    JobState state = JobState::free;
+    lv_draw_buf_t* buf = nullptr;   ///< Decoded pixels (done)
+    uint32_t refs = 0;              ///< Bindings using this job
+    uint32_t seq = 0;               ///< Queue order
+};
+
+struct Binding {
+    lv_obj_t* img = nullptr;        ///< nullptr: free slot
+    Job* job = nullptr;
+    const void* placeholder = nullptr;
+    uint32_t fade_ms = 0;
+    bool waiting = false;           ///< Placeholder shown, result not swapped in yet
+};
+
+struct Loader {
+    Job jobs[LV_CPP_IMAGE_LOADER_JOBS];
+    Binding bindings[LV_CPP_IMAGE_LOADER_BINDINGS];
+    lv_timer_t* timer = nullptr;
+    const void* placeholder = nullptr;
+    uint32_t fade_ms = 0;
+    uint32_t next_seq = 0;
+    uint32_t concurrency = 1;
+    lv_mutex_t lock;
+#if LV_USE_OS != LV_OS_NONE
+    lv_thread_t threads[LV_CPP_IMAGE_LOADER_THREADS];
+    lv_thread_sync_t wake[LV_CPP_IMAGE_LOADER_THREADS];
+    uint32_t running = 0;
+    bool stopping = false;
+#endif
+
+    Loader() noexcept { lv_mutex_init(&lock); }
+};
+
+[[nodiscard]] inline Loader& loader() noexcept {
+    static Loader l;
+    return l;
+}
+
+struct LoaderLock {
+    Loader& l;
+    explicit LoaderLock(Loader& loader) noexcept : l(loader) { lv_mutex_lock(&l.lock); }
+    ~LoaderLock() { lv_mutex_unlock(&l.lock); }
+    LoaderLock(const LoaderLock&) = delete;
+    LoaderLock& operator=(const LoaderLock&) = delete;
+};
+
+/// Decode `path` fully into a pooled buffer (nullptr if not possible)
+[[nodiscard]] inline lv_draw_buf_t* decode(const char* path) noexcept {
+    lv_image_decoder_dsc_t dsc;
+    lv_image_decoder_args_t args{};
+    args.no_cache = true;     // keep our copy only, don't fill the image cache twice
+    if (lv_image_decoder_open(&dsc, path, &args) != LV_RESULT_OK) return nullptr;
+    lv_draw_buf_t* out = dsc.decoded ? lv_draw_buf_dup_ex(draw::pool_handlers(), dsc.decoded) : nullptr;
+    lv_image_decoder_close(&dsc);
+    return out;
+}
+
+/// Oldest queued job, marked decoding (call with the lock held)
+[[nodiscard]] inline Job* take_job(Loader& l) noexcept {
+    Job* next = nullptr;
+    for (Job& j : l.jobs) {
+        if (j.state == JobState::queued && (!next || j.seq - next->seq > UINT32_MAX / 2)) next = &j;
+    }
+    if (next) next->state = JobState::decoding;
+    return next;
+}
+
+inline void run_job(Loader& l, Job& j) noexcept {
+    lv_draw_buf_t* buf = decode(j.path);
+    LoaderLock lock(l);
+    j.buf = buf;
+    j.state = buf ? JobState::done : JobState::failed;
+}
+
+#if LV_USE_OS != LV_OS_NONE
+inline void worker_main(void* arg) {
+    Loader& l = loader();
+    lv_thread_sync_t& wake = l.wake[reinterpret_cast<uintptr_t>(arg)];
+    for (;;) {
+        Job* j = nullptr;
+        {
+            LoaderLock lock(l);
+            if (l.stopping) break;
+            j = take_job(l);
+        }
+        if (j) run_job(l, *j);
+        else lv_thread_sync_wait(&wake);
+    }
+}
+
+inline void start_workers(Loader& l) noexcept {
+    while (l.running < l.concurrency) {
+        const uint32_t i = l.running;
+        lv_thread_sync_init(&l.wake[i]);
+#if LV_VERSION_AT_LEAST(9, 3, 0)
+        const lv_result_t res = lv_thread_init(&l.threads[i], "lv_image_loader", LV_THREAD_PRIO_LOW, &worker_main,
+                                               LV_CPP_IMAGE_LOADER_STACK, reinterpret_cast<void*>(uintptr_t{i}));
+#else
+        const lv_result_t res = lv_thread_init(&l.threads[i], LV_THREAD_PRIO_LOW, &worker_main,
+                                               LV_CPP_IMAGE_LOADER_STACK, reinterpret_cast<void*>(uintptr_t{i}));
+#endif
+        if (res != LV_RESULT_OK) {
+            lv_thread_sync_delete(&l.wake[i]);
+            LV_LOG_WARN("image loader: cannot start worker thread");
+            break;
+        }
+        ++l.running;
+    }
+}
+
+inline void wake_workers(Loader& l) noexcept {
+    for (uint32_t i = 0; i < l.running; ++i) lv_thread_sync_signal(&l.wake[i]);
+}
+
+inline void stop_workers(Loader& l) noexcept {
+    {
+        LoaderLock lock(l);
+        l.stopping = true;
+    }
+    for (uint32_t i = 0; i < l.running; ++i) {
+        lv_thread_sync_signal(&l.wake[i]);
+        lv_thread_delete(&l.threads[i]);
+        lv_thread_sync_delete(&l.wake[i]);
+    }
+    LoaderLock lock(l);
+    l.running = 0;
+    l.stopping = false;
+}
+#endif
+
+/// Free a job nobody uses any more (call with the lock held)
+inline void maybe_free_job(Job& j) noexcept {
+    if (j.refs != 0) return;
+    if (j.state == JobState::queued || j.state == JobState::failed) {
+        j.state = JobState::free;
+    } else if (j.state == JobState::done) {
+        lv_image_cache_drop(j.buf);   // same source pointer may be reused by the pool
+        lv_draw_buf_destroy(j.buf);
+        j.buf = nullptr;
+        j.state = JobState::free;
+    }
+    // decoding: freed by the timer once the worker is done
+}
+
+[[nodiscard]] inline Binding* find_binding(Loader& l, const lv_obj_t* img) noexcept {
+    for (Binding& b : l.bindings) {
+        if (b.img == img) return &b;
+    }
+    return nullptr;
+}
+
+/// Drop `b` and its job reference (call with the lock held)
+inline void unbind(Binding& b) noexcept {
+    if (b.job) {
+        --b.job->refs;
+        maybe_free_job(*b.job);
+    }
+    b = Binding{};
+}
+
+inline void image_delete_cb(lv_event_t* e) {
+    Loader& l = loader();
+    LoaderLock lock(l);
+    if (Binding* b = find_binding(l, static_cast<lv_obj_t*>(lv_event_get_current_target(e)))) unbind(*b);
+}
+
+inline void fade_exec_cb(void* obj, int32_t v) {
+    lv_obj_set_style_image_opa(static_cast<lv_obj_t*>(obj), static_cast<lv_opa_t>(v), 0);
+}
+
+/// `img` still shows `placeholder` (lv_image copies path and symbol sources)
+[[nodiscard]] inline bool shows(lv_obj_t* img, const void* placeholder) noexcept {
+    const void* src = lv_image_get_src(img);
+    if (src == placeholder) return true;
+    if (!src || !placeholder || lv_image_src_get_type(placeholder) == LV_IMAGE_SRC_VARIABLE) return false;
+    return lv_image_src_get_type(src) != LV_IMAGE_SRC_VARIABLE &&
+           std::strcmp(static_cast<const char*>(src), static_cast<const char*>(placeholder)) == 0;
+}
+
+/// Show the finished job in `b.img` (UI thread, lock held)
+inline void swap_in(Binding& b) {
+    b.waiting = false;
+    // The app set another source meanwhile: leave it
+    if (!shows(b.img, b.placeholder)) return;
+    if (b.job->state == JobState::done) {
+        lv_image_set_src(b.img, b.job->buf);
+    } else {
+        lv_image_set_src(b.img, b.job->path);   // synchronous fallback
+    }
+    if (b.fade_ms == 0) return;
+    lv_obj_set_style_image_opa(b.img, LV_OPA_TRANSP, 0);
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, b.img);
+    lv_anim_set_exec_cb(&a, &fade_exec_cb);
+    lv_anim_set_values(&a, LV_OPA_TRANSP, LV_OPA_COVER);
+    lv_anim_set_duration(&a, b.fade_ms);
+    lv_anim_start(&a);
+}
+
+inline void poll_cb(lv_timer_t* t) {
+    Loader& l = loader();
+#if LV_USE_OS == LV_OS_NONE
+    Job* j = nullptr;
+    {
+        LoaderLock lock(l);
+        j = take_job(l);
+    }
+    if (j) run_job(l, *j);
+#endif
+    LoaderLock lock(l);
+    bool busy = false;
+    for (Binding& b : l.bindings) {
+        if (!b.img || !b.waiting) continue;
+        if (b.job->state == JobState::done || b.job->state == JobState::failed) swap_in(b);
+        else busy = true;
+    }
+    for (Job& j : l.jobs) maybe_free_job(j);
+    if (!busy) lv_timer_pause(t);
+}
+
+[[nodiscard]] inline Job* find_or_queue_job(Loader& l, const char* path) noexcept {
+    Job* free_job = nullptr;
+    for (Job& j : l.jobs) {
+        if (j.state == JobState::free) {
+            if (!free_job) free_job = &j;
+        } else if (j.state != JobState::failed && std::strcmp(j.path, path) == 0) {
+            return &j;
+        }
+    }
+    if (!free_job) return nullptr;
+    std::memcpy(free_job->path, path, std::strlen(path) + 1);
+    free_job->state = JobState::queued;
+    free_job->buf = nullptr;
+    free_job->refs = 0;
+    free_job->seq = l.next_seq++;
+    return free_job;
+}
+
+} // namespace detail
+
+/**
+ * @brief Worker threads decoding in parallel (1..LV_CPP_IMAGE_LOADER_THREADS)
+ *
+ * Workers start on the first load(); raising the value later starts more.
+ * Lowering it takes effect after shutdown(). No effect without an OS.
+ */
+inline void set_concurrency(uint32_t threads) noexcept {
+    if (threads < 1) threads = 1;
+    if (threads > LV_CPP_IMAGE_LOADER_THREADS) threads = LV_CPP_IMAGE_LOADER_THREADS;
+    detail::Loader& l = detail::loader();
+    l.concurrency = threads;
+#if LV_USE_OS != LV_OS_NONE
+    if (l.running) detail::start_workers(l);
+#endif
+}
+
+/// Default placeholder source shown while decoding (nullptr: empty image)
+inline void set_placeholder(const void* src) noexcept { detail::loader().placeholder = src; }
+
+/// Default fade-in time of decoded images (0: swap without fading)
+inline void set_fade(uint32_t ms) noexcept { detail::loader().fade_ms = ms; }
+
+/**
+ * @brief Show `placeholder` in `img` and decode `path` in the background
+ * @param path File path; copied, must be shorter than LV_CPP_IMAGE_LOADER_PATH
+ * @param placeholder Source shown meanwhile (must outlive the load)
+ * @return false if it was loaded synchronously (path too long, tables full)
+ */
+inline bool load(lv_obj_t* img, const char* path, const void* placeholder, uint32_t fade_ms) noexcept {
+    if (!img || !path) return false;
+    detail::Loader& l = detail::loader();
+    bool queued = false;
+    {
+        detail::LoaderLock lock(l);
+        detail::Binding* b = detail::find_binding(l, img);
+        if (b) {
+            detail::unbind(*b);
+        } else {
+            b = detail::find_binding(l, nullptr);
+            if (b) lv_obj_add_event_cb(img, &detail::image_delete_cb, LV_EVENT_DELETE, nullptr);
+        }
+        detail::Job* j = nullptr;
+        if (b && std::strlen(path) < LV_CPP_IMAGE_LOADER_PATH) j = detail::find_or_queue_job(l, path);
+        if (j) {
+            ++j->refs;
+            *b = detail::Binding{img, j, placeholder, fade_ms, true};
+            queued = true;
+            lv_image_set_src(img, placeholder);
+            if (j->state == detail::JobState::done) detail::swap_in(*b);   // already decoded for another image
+        } else if (b) {
+            lv_obj_remove_event_cb_with_user_data(img, &detail::image_delete_cb, nullptr);
+        }
+    }
+    if (!queued) {
+        lv_image_set_src(img, path);
+        return false;
+    }
+    if (!l.timer) l.timer = lv_timer_create(&detail::poll_cb, LV_CPP_IMAGE_LOADER_POLL_MS, nullptr);
+    else lv_timer_resume(l.timer);
+#if LV_USE_OS != LV_OS_NONE
+    detail::start_workers(l);
+    detail::wake_workers(l);
+#endif
+    return true;
+}
+
+/// load() with the default placeholder and fade
+inline bool load(lv_obj_t* img, const char* path) noexcept {
+    const detail::Loader& l = detail::loader();
+    return load(img, path, l.placeholder, l.fade_ms);
+}
+
+/// Images still showing their placeholder
+[[nodiscard]] inline uint32_t pending() noexcept {
+    detail::Loader& l = detail::loader();
+    detail::LoaderLock lock(l);
+    uint32_t n = 0;
+    for (const detail::Binding& b : l.bindings) n += b.img && b.waiting;
+    return n;
+}
+
+/// Decoded sources currently held (shared by all images showing them)
+[[nodiscard]] inline uint32_t cached() noexcept {
+    detail::Loader& l = detail::loader();
+    detail::LoaderLock lock(l);
+    uint32_t n = 0;
+    for (const detail::Job& j : l.jobs) n += j.state == detail::JobState::done;
+    return n;
+}
+
+/// Stop the worker threads (queued images stay on their placeholder until the next load())
+inline void shutdown() noexcept {
+#if LV_USE_OS != LV_OS_NONE
+    detail::stop_workers(detail::loader());
+#endif
+}
+
+} // namespace lv::image_loader
@@ -0,0 +1,407 @@
+#pragma once
+
+/**
+ * @file image_set.hpp
+ * @brief Image sources with variants per display density, resampled once when none fits
+ *
+ * One UI running on 320x240, 480x320 and 800x480 panels either stores
+ * every image at every size or zooms it on every draw, which filters each
+ * pixel again per frame. An ImageSet lists the variants that exist, and
+ * resolve() picks the one made for the display's DPI. Without an exact
+ * variant, the nearest larger one is resampled once (area averaging,
+ * premultiplied alpha) into a pooled buffer that is then drawn unscaled:
+ *
+ * @code
+ * LV_IMAGE_DECLARE(logo_1x);   // 64x64 for 130 DPI
+ * LV_IMAGE_DECLARE(logo_2x);   // 128x128
+ * static constexpr lv::ImageSet logo{{{lv::density::x1, &logo_1x}, {lv::density::x2, &logo_2x}}};
+ *
+ * lv::Image::create(parent).src(logo);   // 96x96 from logo_2x on a 195 DPI panel
+ * @endcode
+ *
+ * Density 100 is an asset drawn for LV_CPP_IMAGE_SET_BASE_DPI. Resampled
+ * images are keyed by source and size and stay until drop_all(), since
+ * images may still show them; when the LV_CPP_IMAGE_SET_CACHE slots are
+ * used up, or the source is not a raw RGB565/RGB888/XRGB8888/ARGB8888
+ * lv_image_dsc_t, resolve() falls back to the nearest variant and a draw
+ * time scale.
+ *
+ * Image::src(set) also remembers which set an image shows (the set must
+ * outlive the image, as a `static constexpr` one does). After the display's
+ * DPI changes, rescale() resolves again only those images and frees the
+ * resampled copies none of them shows any more.
+ *
+ * Heap allocation: NONE in the wrapper (fixed slots; resampled pixels
+ * come from the DrawBufPool)
+ */
+
+#include <lvgl.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include "../draw/draw_buf.hpp"
+
+#ifndef LV_CPP_IMAGE_SET_BASE_DPI
+/// DPI an asset of density 100 (1x) is drawn for
+#define LV_CPP_IMAGE_SET_BASE_DPI LV_DPI_DEF
+#endif
+
+#ifndef LV_CPP_IMAGE_SET_CACHE
+/// Resampled images kept at once
+#define LV_CPP_IMAGE_SET_CACHE 16
+#endif
+
+#ifndef LV_CPP_IMAGE_SET_BOUND
+/// Images shown with Image::src(set) that rescale() can pick a new variant for
+#define LV_CPP_IMAGE_SET_BOUND 32
+#endif
+
+#ifndef LV_CPP_IMAGE_SET_SNAP_PCT
+/// A variant within this many percent of the wanted density is used as is
+#define LV_CPP_IMAGE_SET_SNAP_PCT 5
+#endif
+
+namespace lv {
+
+/// Densities in percent of LV_CPP_IMAGE_SET_BASE_DPI
+namespace density {
+    constexpr uint16_t x1 = 100;
+    constexpr uint16_t x1_5 = 150;
+    constexpr uint16_t x2 = 200;
+    constexpr uint16_t x3 = 300;
+}
+
+/// One stored size of an image
+struct ImageVariant {
+    uint16_t density;                ///< Percent of LV_CPP_IMAGE_SET_BASE_DPI (see lv::density)
+    const lv_image_dsc_t* src;
+};
+
+/// A source to show: an image and the draw time scale it still needs (LV_SCALE_NONE normally)
+struct ResolvedImage {
+    const void* src = nullptr;
+    int32_t scale = LV_SCALE_NONE;
+};
+
+namespace image_set {
+
+struct Stats {
+    uint32_t exact;         ///< resolve() answered by a stored variant
+    uint32_t resampled;     ///< Variants resampled (once per source and size)
+    uint32_t reused;        ///< resolve() answered by an earlier resample
+    uint32_t scaled;        ///< Fallbacks to a draw time scale
+    uint32_t bytes;         ///< Pixel bytes of the resampled images
+};
+
+namespace detail {
+
+struct Slot {
+    const lv_image_dsc_t* src = nullptr;    ///< nullptr: free
+    uint32_t w = 0;
+    uint32_t h = 0;
+    DrawBuf buf;
+};
+
+/// An image showing a variant of a set
+struct Bound {
+    lv_obj_t* img = nullptr;                ///< nullptr: free
+    const ImageVariant* variants = nullptr;
+    size_t count = 0;
+};
+
+struct Cache {
+    Slot slots[LV_CPP_IMAGE_SET_CACHE];
+    Bound bound[LV_CPP_IMAGE_SET_BOUND];
+    Stats stats{};
+};
+
+[[nodiscard]] inline Cache& cache() noexcept {
+    static Cache c;
+    return c;
+}
+
+[[nodiscard]] inline bool readable(lv_color_format_t cf) noexcept {
+    return cf == LV_COLOR_FORMAT_RGB565 || cf == LV_COLOR_FORMAT_RGB888 || cf == LV_COLOR_FORMAT_XRGB8888 ||
+           cf == LV_COLOR_FORMAT_ARGB8888;
+}
+
+/// Pixel `x` of `row` as premultiplied 8-bit A, R, G, B
+inline void read_px(lv_color_format_t cf, const uint8_t* row, uint32_t x, uint32_t out[4]) noexcept {
+    switch (cf) {
+    case LV_COLOR_FORMAT_RGB565: {
+        const uint32_t v = row[x * 2] | row[x * 2 + 1] << 8;
+        out[0] = 255;
+        out[1] = ((v >> 11) & 0x1F) * 255 / 31;
+        out[2] = ((v >> 5) & 0x3F) * 255 / 63;
+        out[3] = (v & 0x1F) * 255 / 31;
+        return;
+    }
+    case LV_COLOR_FORMAT_RGB888:
+        out[0] = 255;
+        out[1] = row[x * 3 + 2];
+        out[2] = row[x * 3 + 1];
+        out[3] = row[x * 3];
+        return;
+    default: {      // XRGB8888 / ARGB8888, stored B, G, R, A
+        const uint8_t* p = row + x * 4;
+        const uint32_t a = cf == LV_COLOR_FORMAT_ARGB8888 ? p[3] : 255;
+        out[0] = a;
+        out[1] = p[2] * a / 255;
+        out[2] = p[1] * a / 255;
+        out[3] = p[0] * a / 255;
+        return;
+    }
+    }
+}
+
+/// Undo the premultiplication of channel `c` by alpha `a`
+[[nodiscard]] inline uint32_t unpremultiply(uint32_t c, uint32_t a) noexcept {
+    return a ? std::min<uint32_t>((c * 255 + a / 2) / a, 255) : 0;
+}
+
+/// Store premultiplied A, R, G, B as pixel `x` of `row` (straight alpha for ARGB8888)
+inline void write_px(lv_color_format_t cf, uint8_t* row, uint32_t x, const uint32_t in[4]) noexcept {
+    switch (cf) {
+    case LV_COLOR_FORMAT_RGB565: {
+        const uint32_t v = (in[1] * 31 + 127) / 255 << 11 | (in[2] * 63 + 127) / 255 << 5 | (in[3] * 31 + 127) / 255;
+        row[x * 2] = static_cast<uint8_t>(v);
+        row[x * 2 + 1] = static_cast<uint8_t>(v >> 8);
+        return;
+    }
+    case LV_COLOR_FORMAT_RGB888:
+        row[x * 3] = static_cast<uint8_t>(in[3]);
+        row[x * 3 + 1] = static_cast<uint8_t>(in[2]);
+        row[x * 3 + 2] = static_cast<uint8_t>(in[1]);
+        return;
+    default: {
+        uint8_t* p = row + x * 4;
+        const uint32_t a = cf == LV_COLOR_FORMAT_ARGB8888 ? in[0] : 255;
+        p[0] = static_cast<uint8_t>(unpremultiply(in[3], a));
+        p[1] = static_cast<uint8_t>(unpremultiply(in[2], a));
+        p[2] = static_cast<uint8_t>(unpremultiply(in[1], a));
+        p[3] = static_cast<uint8_t>(a);
+        return;
+    }
+    }
+}
+
+/**
+ * @brief Area-average `src` into `dst` (same color format, any size)
+ *
+ * Every destination pixel is the coverage-weighted mean of the source
+ * pixels under it (8 fractional bits per axis), so downscaling does not
+ * alias and upscaling blends neighbours at pixel borders.
+ */
+inline void resample(const lv_image_dsc_t& src, uint8_t* dst, uint32_t dw, uint32_t dh, uint32_t dstride) noexcept {
+    const lv_color_format_t cf = static_cast<lv_color_format_t>(src.header.cf);
+    const uint32_t sw = src.header.w;
+    const uint32_t sh = src.header.h;
+    const uint32_t sstride = src.header.stride ? src.header.stride : lv_draw_buf_width_to_stride(sw, cf);
+    // Destination pixel d covers source [d * sw / dw, (d + 1) * sw / dw), in 1/256 source pixels
+    for (uint32_t dy = 0; dy < dh; ++dy) {
+        const uint64_t y0 = static_cast<uint64_t>(dy) * sh * 256 / dh;
+        const uint64_t y1 = static_cast<uint64_t>(dy + 1) * sh * 256 / dh;
+        uint8_t* out_row = dst + dy * dstride;
+        for (uint32_t dx = 0; dx < dw; ++dx) {
+            const uint64_t x0 = static_cast<uint64_t>(dx) * sw * 256 / dw;
+            const uint64_t x1 = static_cast<uint64_t>(dx + 1) * sw * 256 / dw;
+            uint64_t acc[4] = {};
+            uint64_t total = 0;
+            for (uint64_t sy = y0 >> 8; sy < sh && (sy << 8) < y1; ++sy) {
+                const uint64_t wy = (std::min((sy + 1) << 8, y1) - std::max(sy << 8, y0));
+                const uint8_t* row = src.data + sy * sstride;
+                for (uint64_t sx = x0 >> 8; sx < sw && (sx << 8) < x1; ++sx) {
+                    const uint64_t w = wy * (std::min((sx + 1) << 8, x1) - std::max(sx << 8, x0));
+                    uint32_t px[4];
+                    read_px(cf, row, static_cast<uint32_t>(sx), px);
+                    for (int c = 0; c < 4; ++c) acc[c] += px[c] * w;
+                    total += w;
+                }
+            }
+            uint32_t px[4] = {};
+            if (total) {
+                for (int c = 0; c < 4; ++c) px[c] = static_cast<uint32_t>((acc[c] + total / 2) / total);
+            }
+            write_px(cf, out_row, dx, px);
+        }
+    }
+}
+
+/// Resampled copy of `src` at `w` x `h`, nullptr if it cannot be made
+[[nodiscard]] inline const lv_draw_buf_t* resampled(const lv_image_dsc_t* src, uint32_t w, uint32_t h) noexcept {
+    Cache& c = cache();
+    Slot* free_slot = nullptr;
+    for (Slot& s : c.slots) {
+        if (s.src == src && s.w == w && s.h == h) {
+            ++c.stats.reused;
+            return s.buf.get();
+        }
+        if (!s.src && !free_slot) free_slot = &s;
+    }
+    const auto cf = static_cast<lv_color_format_t>(src->header.cf);
+    if (!free_slot || !src->data || !readable(cf) || (src->header.flags & LV_IMAGE_FLAGS_COMPRESSED)) return nullptr;
+    DrawBuf buf = DrawBuf::acquire(w, h, cf);
+    if (!buf) return nullptr;
+    resample(*src, buf.data(), w, h, buf.stride());
+    buf.clear_flag(LV_IMAGE_FLAGS_PREMULTIPLIED);
+    free_slot->src = src;
+    free_slot->w = w;
+    free_slot->h = h;
+    free_slot->buf = std::move(buf);
+    ++c.stats.resampled;
+    c.stats.bytes += free_slot->buf.get()->data_size;
+    return free_slot->buf.get();
+}
+
+/// Scale `len` by `num / den`, rounded, at least 1
+[[nodiscard]] inline uint32_t scaled(uint32_t len, uint32_t num, uint32_t den) noexcept {
+    const uint32_t v = (len * num + den / 2) / den;
+    return v ? v : 1;
+}
+
+[[nodiscard]] inline ResolvedImage resolve(const ImageVariant* v, size_t n, int32_t dpi) noexcept {
+    ResolvedImage r;
+    if (!n) return r;
+    const uint32_t want = dpi > 0 ? static_cast<uint32_t>(dpi) * 100 / LV_CPP_IMAGE_SET_BASE_DPI : 100;
+    // Nearest variant at or above the wanted density (downsampling keeps detail), else the densest
+    const ImageVariant* best = nullptr;
+    const ImageVariant* densest = &v[0];
+    for (size_t i = 0; i < n; ++i) {
+        if (v[i].density > densest->density) densest = &v[i];
+        if (v[i].density >= want && (!best || v[i].density < best->density)) best = &v[i];
+        const uint32_t diff = v[i].density > want ? v[i].density - want : want - v[i].density;
+        if (diff * 100 <= want * LV_CPP_IMAGE_SET_SNAP_PCT) {
+            r.src = v[i].src;
+            ++cache().stats.exact;
+            return r;
+        }
+    }
+    if (!best) best = densest;
+    const lv_image_dsc_t* src = best->src;
+    const uint32_t w = scaled(src->header.w, want, best->density);
+    const uint32_t h = scaled(src->header.h, want, best->density);
+    if (const lv_draw_buf_t* buf = resampled(src, w, h)) {
+        r.src = buf;
+        return r;
+    }
+    r.src = src;
+    r.scale = static_cast<int32_t>(scaled(LV_SCALE_NONE, want, best->density));
+    ++cache().stats.scaled;
+    return r;
+}
+
+inline void unbind_cb(lv_event_t* e) noexcept {
+    const lv_obj_t* img = lv_event_get_current_target_obj(e);
+    for (Bound& b : cache().bound) {
+        if (b.img == img) b = Bound{};
+    }
+}
+
+/// Remember that `img` shows a variant of `v` (untracked when the table is full)
+inline void bind(lv_obj_t* img, const ImageVariant* v, size_t n) noexcept {
+    Bound* free_bound = nullptr;
+    for (Bound& b : cache().bound) {
+        if (b.img == img) {
+            b.variants = v;
+            b.count = n;
+            return;
+        }
+        if (!b.img && !free_bound) free_bound = &b;
+    }
+    if (!free_bound) return;
+    *free_bound = Bound{img, v, n};
+    lv_obj_add_event_cb(img, &unbind_cb, LV_EVENT_DELETE, nullptr);
+}
+
+} // namespace detail
+
+/**
+ * @brief Pick the variants again for the images on `disp` shown with Image::src(set)
+ *
+ * Call after the display's DPI changed. Resampled copies that one of these
+ * images showed before and none shows now are freed.
+ * @return Images whose source changed
+ */
+inline uint32_t rescale(lv_display_t* disp) noexcept {
+    detail::Cache& c = detail::cache();
+    const int32_t dpi = lv_display_get_dpi(disp);
+    bool stale[LV_CPP_IMAGE_SET_CACHE] = {};
+    uint32_t changed = 0;
+    for (detail::Bound& b : c.bound) {
+        if (!b.img || lv_obj_get_display(b.img) != disp) continue;
+        const void* old = lv_image_get_src(b.img);
+        const ResolvedImage r = detail::resolve(b.variants, b.count, dpi);
+        if (r.src == old) continue;
+        for (size_t i = 0; i < LV_CPP_IMAGE_SET_CACHE; ++i) {
+            if (c.slots[i].src && c.slots[i].buf.get() == old) stale[i] = true;
+        }
+        lv_image_set_src(b.img, r.src);
+        lv_image_set_scale(b.img, static_cast<uint32_t>(r.scale));
+        ++changed;
+    }
+    for (size_t i = 0; i < LV_CPP_IMAGE_SET_CACHE; ++i) {
+        if (!stale[i]) continue;
+        detail::Slot& s = c.slots[i];
+        bool shown = false;
+        for (const detail::Bound& b : c.bound) shown = shown || (b.img && lv_image_get_src(b.img) == s.buf.get());
+        if (shown) continue;
+        c.stats.bytes -= s.buf.get()->data_size;
+        lv_image_cache_drop(s.buf.get());
+        s = detail::Slot{};
+    }
+    return changed;
+}
+
+/// Free all resampled images (after a DPI change, once no image shows them)
+inline void drop_all() noexcept {
+    detail::Cache& c = detail::cache();
+    for (detail::Slot& s : c.slots) {
+        if (!s.src) continue;
+        lv_image_cache_drop(s.buf.get());
+        s = detail::Slot{};
+    }
+    c.stats.bytes = 0;
+}
+
+[[nodiscard]] inline Stats stats() noexcept {
+    return detail::cache().stats;
+}
+
+inline void reset_stats() noexcept {
+    Stats& s = detail::cache().stats;
+    s = Stats{0, 0, 0, 0, s.bytes};
+}
+
+} // namespace image_set
+
+/**
+ * @brief Variants of one image for different display densities
+ *
+ * Holds pointers only; a `static constexpr` set lives in flash.
+ *
+ * @tparam N Number of variants (deduced)
+ */
+template<size_t N>
+struct ImageSet {
+    ImageVariant variants[N];
+
+    constexpr ImageSet(const ImageVariant (&v)[N]) noexcept : variants{} {
+        for (size_t i = 0; i < N; ++i) variants[i] = v[i];
+    }
+
+    /// Source for a display of `dpi`, resampled on the first call when no variant fits
+    [[nodiscard]] ResolvedImage resolve(int32_t dpi) const noexcept {
+        return image_set::detail::resolve(variants, N, dpi);
+    }
+
+    /// Source for `disp` (default display when nullptr)
+    [[nodiscard]] ResolvedImage resolve_for(lv_display_t* disp = nullptr) const noexcept {
+        return resolve(lv_display_get_dpi(disp));
+    }
+};
+
+template<size_t N>
+ImageSet(const ImageVariant (&)[N]) -> ImageSet<N>;
+
+} // namespace lv
@@ -9,6 +9,7 @@
 
 #include <lvgl.h>
 #include "object.hpp"
+#include "touch_predict.hpp"
 #include "version.hpp"
 
 namespace lv {
@@ -130,6 +131,28 @@ public:
         return *this;
     }
 
+    /// Get read callback (e.g. to wrap it)
+    [[nodiscard]] lv_indev_read_cb_t read_cb() const noexcept {
+        return lv_indev_get_read_cb(m_indev);
+    }
+
+    /// Set read mode: LV_INDEV_MODE_TIMER (polled) or LV_INDEV_MODE_EVENT (read())
+    Indev& mode(lv_indev_mode_t m) noexcept {
+        lv_indev_set_mode(m_indev, m);
+        return *this;
+    }
+
+    /// Get read mode
+    [[nodiscard]] lv_indev_mode_t mode() const noexcept {
+        return lv_indev_get_mode(m_indev);
+    }
+
+    /// Read and process the device now (event mode)
+    Indev& read() noexcept {
+        lv_indev_read(m_indev);
+        return *this;
+    }
+
     /// Set user data
     Indev& user_data(void* data) noexcept {
         lv_indev_set_user_data(m_indev, data);
@@ -147,6 +170,20 @@ public:
         return *this;
     }
 
+    // ==================== Prediction ====================
+
+    /// Extrapolate pressed pointer positions ahead of the latency (see touch_predict.hpp)
+    Indev& predict(const PredictConfig& cfg = {}) noexcept {
+        touch_predict::enable(m_indev, cfg);
+        return *this;
+    }
+
+    /// Report raw pointer positions again
+    Indev& no_predict() noexcept {
+        touch_predict::disable(m_indev);
+        return *this;
+    }
+
     // ==================== Group ====================
 
     /// Set group (for keypad/encoder navigation)
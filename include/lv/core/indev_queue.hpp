@@ -0,0 +1,263 @@
+#pragma once
+
+/**
+ * @file indev_queue.hpp
+ * @brief Event-mode input device fed from an interrupt or reader thread
+ *
+ * A polled read_cb sees one point per LV_DEF_INDEV_READ_PERIOD, so a fast
+ * swipe loses its intermediate points, and polling faster costs CPU on
+ * every idle frame. IndevQueue puts the indev in LV_INDEV_MODE_EVENT and
+ * lets the touch controller's ISR or an evdev thread push timestamped
+ * samples into a lock-free single-producer ring. The LVGL thread consumes
+ * everything queued as one batch per frame (at the start of the display
+ * refresh, before layout and rendering), and a slow timer picks up input
+ * while the display is not refreshing.
+ *
+ * With coalesce() on, pressed pointer samples followed by another pressed
+ * sample are skipped: LVGL sees the last position of each frame plus
+ * every press and release, so clicks are never merged away. Without it
+ * every sample reaches LVGL (scroll throw and gestures see the full path).
+ *
+ * @code
+ * static lv::IndevQueue<64> touch_queue;
+ * lv::Indev touch;
+ * touch.as_pointer();
+ * touch_queue.attach(touch.get()).coalesce(true);
+ *
+ * // touch controller ISR or reader thread
+ * touch_queue.push_point(x, y, pressed);
+ * @endcode
+ *
+ * The timestamps (lv_tick_get() by default) give the queueing latency in
+ * stats(). With an EventLoop, on_push() can wake() it so input is read at
+ * once instead of on the next frame. When the ring is full new samples are
+ * dropped (a producer must not touch the consumer's end).
+ *
+ * Threading: one producer (any thread or ISR), consumer on the LVGL thread.
+ * Call detach() (or destroy the queue) before deleting the indev.
+ * Heap allocation: the timer and one display event descriptor
+ */
+
+#include <lvgl.h>
+#include <atomic>
+#include <cstdint>
+
+#ifndef LV_CPP_INDEV_QUEUE_POLL_MS
+/// Period of the fallback read while the display does not refresh (ms)
+#define LV_CPP_INDEV_QUEUE_POLL_MS 30
+#endif
+
+namespace lv {
+
+/// One input sample as pushed by the producer
+struct IndevSample {
+    int32_t x;
+    int32_t y;
+    uint32_t key;          ///< Keypad / button id (0 for pointers)
+    uint32_t timestamp;    ///< lv_tick_get() when it was sampled
+    bool pressed;
+};
+
+/**
+ * @brief Lock-free sample ring driving one event-mode indev
+ *
+ * Non-movable: the indev, the timer and the display event keep a pointer to it.
+ *
+ * @tparam Capacity Samples that can wait between two frames (power of two)
+ */
+template<uint32_t Capacity = 64>
+class IndevQueue {
+    static_assert(Capacity > 1 && (Capacity & (Capacity - 1)) == 0, "IndevQueue size must be a power of two");
+
+public:
+    /// Hook called after every accepted push (e.g. EventLoop::wake)
+    using wake_cb = void (*)(void* user_data);
+
+    struct Stats {
+        uint32_t samples = 0;          ///< Samples consumed
+        uint32_t coalesced = 0;        ///< Pressed moves skipped by coalesce()
+        uint32_t reads = 0;            ///< Batches with samples
+        uint32_t max_batch = 0;        ///< Most samples consumed in one batch
+        uint32_t max_latency_ms = 0;   ///< Longest push-to-read time
+    };
+
+private:
+    IndevSample m_ring[Capacity] = {};
+    alignas(64) std::atomic<uint32_t> m_head{0};    ///< Written by the producer
+    alignas(64) std::atomic<uint32_t> m_tail{0};    ///< Written by the consumer
+    std::atomic<uint32_t> m_dropped{0};
+    std::atomic<wake_cb> m_wake{nullptr};
+    std::atomic<void*> m_wake_data{nullptr};
+
+    lv_indev_t* m_indev = nullptr;
+    lv_display_t* m_disp = nullptr;
+    lv_timer_t* m_timer = nullptr;
+    IndevSample m_last{};             ///< Reported while the ring is empty
+    uint32_t m_batch = 0;
+    bool m_coalesce = false;
+    Stats m_stats;
+
+    [[nodiscard]] bool pending() const noexcept {
+        return m_tail.load(std::memory_order_relaxed) != m_head.load(std::memory_order_acquire);
+    }
+
+    void read_sample(lv_indev_data_t* data) noexcept {
+        uint32_t tail = m_tail.load(std::memory_order_relaxed);
+        const uint32_t head = m_head.load(std::memory_order_acquire);
+        if (tail != head) {
+            const bool pointer = lv_indev_get_type(m_indev) == LV_INDEV_TYPE_POINTER;
+            // A pressed move followed by another pressed sample adds nothing LVGL would act on
+            while (m_coalesce && pointer && head - tail > 1 && m_ring[tail & (Capacity - 1)].pressed
+                   && m_ring[(tail + 1) & (Capacity - 1)].pressed) {
+                ++tail;
+                ++m_stats.coalesced;
+            }
+            m_last = m_ring[tail & (Capacity - 1)];
+            m_tail.store(tail + 1, std::memory_order_release);
+            ++m_stats.samples;
+            ++m_batch;
+            const uint32_t latency = lv_tick_elaps(m_last.timestamp);
+            if (latency > m_stats.max_latency_ms) m_stats.max_latency_ms = latency;
+        }
+        data->point.x = m_last.x;
+        data->point.y = m_last.y;
+        data->key = m_last.key;
+        data->btn_id = m_last.key;
+        data->state = m_last.pressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+    }
+
+    static void read_cb(lv_indev_t* indev, lv_indev_data_t* data) noexcept {
+        static_cast<IndevQueue*>(lv_indev_get_driver_data(indev))->read_sample(data);
+    }
+
+    static void refr_start_cb(lv_event_t* e) noexcept {
+        static_cast<IndevQueue*>(lv_event_get_user_data(e))->read();
+    }
+
+    static void timer_cb(lv_timer_t* t) noexcept {
+        static_cast<IndevQueue*>(lv_timer_get_user_data(t))->read();
+    }
+
+public:
+    IndevQueue() noexcept = default;
+
+    ~IndevQueue() {
+        detach();
+    }
+
+    IndevQueue(const IndevQueue&) = delete;
+    IndevQueue& operator=(const IndevQueue&) = delete;
+
+    // ==================== Setup (LVGL thread) ====================
+
+    /**
+     * @brief Feed `indev` from this queue
+     *
+     * Sets its read_cb and driver data and switches it to
+     * LV_INDEV_MODE_EVENT. Samples are read at the start of each refresh
+     * of the indev's display (the default display if it has none).
+     */
+    IndevQueue& attach(lv_indev_t* indev) noexcept {
+        detach();
+        if (!indev) return *this;
+        m_indev = indev;
+        lv_indev_set_driver_data(indev, this);
+        lv_indev_set_read_cb(indev, &IndevQueue::read_cb);
+        lv_indev_set_mode(indev, LV_INDEV_MODE_EVENT);
+        m_disp = lv_indev_get_display(indev);
+        if (!m_disp) m_disp = lv_display_get_default();
+        if (m_disp) lv_display_add_event_cb(m_disp, &IndevQueue::refr_start_cb, LV_EVENT_REFR_START, this);
+        m_timer = lv_timer_create(&IndevQueue::timer_cb, LV_CPP_INDEV_QUEUE_POLL_MS, this);
+        return *this;
+    }
+
+    /// Stop feeding the indev and put it back in timer mode (its read_cb is cleared)
+    void detach() noexcept {
+        if (m_timer) lv_timer_delete(m_timer);
+        m_timer = nullptr;
+        if (m_disp) lv_display_remove_event_cb_with_user_data(m_disp, &IndevQueue::refr_start_cb, this);
+        m_disp = nullptr;
+        if (m_indev) {
+            lv_indev_set_mode(m_indev, LV_INDEV_MODE_TIMER);
+            lv_indev_set_read_cb(m_indev, nullptr);
+            lv_indev_set_driver_data(m_indev, nullptr);
+        }
+        m_indev = nullptr;
+    }
+
+    /// Skip pressed pointer moves that another pressed sample follows
+    IndevQueue& coalesce(bool on) noexcept {
+        m_coalesce = on;
+        return *this;
+    }
+
+    /// Call `cb(user_data)` from the producer after each accepted push
+    IndevQueue& on_push(wake_cb cb, void* user_data = nullptr) noexcept {
+        m_wake_data.store(user_data, std::memory_order_relaxed);
+        m_wake.store(cb, std::memory_order_release);
+        return *this;
+    }
+
+    // ==================== Producer (any thread, ISR) ====================
+
+    /**
+     * @brief Queue one sample
+     * @return false if the ring was full (the sample is dropped)
+     */
+    bool push(const IndevSample& s) noexcept {
+        const uint32_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tail.load(std::memory_order_acquire) >= Capacity) {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        m_ring[head & (Capacity - 1)] = s;
+        m_head.store(head + 1, std::memory_order_release);
+        if (wake_cb wake = m_wake.load(std::memory_order_acquire)) {
+            wake(m_wake_data.load(std::memory_order_relaxed));
+        }
+        return true;
+    }
+
+    /// Queue a pointer sample
+    bool push_point(int32_t x, int32_t y, bool pressed, uint32_t timestamp = lv_tick_get()) noexcept {
+        return push(IndevSample{x, y, 0, timestamp, pressed});
+    }
+
+    /// Queue a keypad key (or button id) press or release
+    bool push_key(uint32_t key, bool pressed, uint32_t timestamp = lv_tick_get()) noexcept {
+        return push(IndevSample{0, 0, key, timestamp, pressed});
+    }
+
+    // ==================== Consumer (LVGL thread) ====================
+
+    /// Hand everything queued to LVGL now (done per frame and by the fallback timer)
+    void read() noexcept {
+        if (!m_indev || !pending()) return;
+        m_batch = 0;
+        // LVGL ignores continue_reading in event mode: one read per sample
+        for (uint32_t i = 0; i < Capacity && pending(); ++i) lv_indev_read(m_indev);
+        ++m_stats.reads;
+        if (m_batch > m_stats.max_batch) m_stats.max_batch = m_batch;
+    }
+
+    [[nodiscard]] lv_indev_t* indev() const noexcept { return m_indev; }
+
+    /// Samples waiting (approximate while the producer runs)
+    [[nodiscard]] uint32_t size() const noexcept {
+        return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] static constexpr uint32_t capacity() noexcept { return Capacity; }
+
+    /// Samples refused because the ring was full
+    [[nodiscard]] uint32_t dropped() const noexcept { return m_dropped.load(std::memory_order_relaxed); }
+
+    [[nodiscard]] const Stats& stats() const noexcept { return m_stats; }
+
+    void reset_stats() noexcept {
+        m_stats = {};
+        m_dropped.store(0, std::memory_order_relaxed);
+    }
+};
+
+} // namespace lv
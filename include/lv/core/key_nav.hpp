@@ -0,0 +1,443 @@
+#pragma once
+
+/**
+ * @file key_nav.hpp
+ * @brief Keypad and encoder navigation resolved once per frame
+ *
+ * LVGL moves the focus on every arrow key, LV_KEY_NEXT/PREV and encoder
+ * detent it processes: the old and the new object change their focus
+ * styles, and scroll-on-focus (or gridnav) starts a scroll animation
+ * towards the new one. With the key repeat faster than the frame rate,
+ * several of these land in one frame, each one restyling an object that
+ * is never shown focused and restarting the scroll from wherever the last
+ * one got to, so a long list stutters behind the key. attach() takes the
+ * navigation keys of a keypad or encoder out of LVGL's processing and
+ * counts them instead. Once per frame, at the start of the refresh (or
+ * from a fallback timer while nothing is being redrawn), the steps are
+ * resolved into their final target, which receives the focus and is
+ * scrolled into view once:
+ *
+ * @code
+ * lv::Indev keys;
+ * keys.as_keypad().group(group);
+ * lv::key_nav::attach(keys.get());
+ *
+ * lv::gridnav::add(grid, lv::gridnav::rollover);   // arrows between the grid's children
+ * list.focus_group(group);                          // VirtualList: arrows between items
+ * @endcode
+ *
+ * Taken from LVGL:
+ * - LV_KEY_NEXT/PREV and encoder turns outside editing mode; the focus
+ *   goes where as many lv_group_focus_next()/prev() calls would end.
+ * - Arrow keys (and encoder turns in editing mode) while the focused
+ *   object is a target: gridnav containers and VirtualList::focus_group()
+ *   lists register themselves, add() registers others with their own
+ *   step function.
+ *
+ * Every other key reaches LVGL unchanged, after the pending steps are
+ * resolved, so Enter acts on the object the navigation arrived at. A
+ * different navigation key resolves the steps of the previous one first.
+ * Held keys repeat after LV_CPP_KEY_NAV_REPEAT_DELAY, then every
+ * LV_CPP_KEY_NAV_REPEAT_PERIOD ms counted from the press (LVGL's long-press
+ * defaults; repeat_timing() changes them per indev), so a late frame
+ * catches up in one move instead of losing repeats. Steps are resolved inside lv_indev_read(), so LVGL still sees
+ * a keypad or encoder focus (LV_STATE_FOCUS_KEY).
+ *
+ * Single-threaded: LVGL thread. With an IndevQueue on the same indev,
+ * attach the queue first so its samples are read before the steps are
+ * resolved in the same refresh.
+ * Heap allocation: the fallback timer, and one event descriptor per indev,
+ * display and target
+ */
+
+#include <lvgl.h>
+#include <cstdint>
+#include "focus.hpp"
+
+#ifndef LV_CPP_KEY_NAV_INDEVS
+/// Keypads and encoders whose navigation can be resolved per frame at once
+#define LV_CPP_KEY_NAV_INDEVS 2
+#endif
+
+#ifndef LV_CPP_KEY_NAV_TARGETS
+/// Objects (gridnav containers, virtual lists, ...) that take arrow keys at once
+#define LV_CPP_KEY_NAV_TARGETS 8
+#endif
+
+#ifndef LV_CPP_KEY_NAV_FLUSH_MS
+/// Delay of the fallback resolution while the display does not refresh (ms)
+#define LV_CPP_KEY_NAV_FLUSH_MS LV_DEF_REFR_PERIOD
+#endif
+
+#ifndef LV_CPP_KEY_NAV_REPEAT_DELAY
+/// Hold time before a navigation key repeats (ms, LVGL's default long-press time)
+#define LV_CPP_KEY_NAV_REPEAT_DELAY 400
+#endif
+
+#ifndef LV_CPP_KEY_NAV_REPEAT_PERIOD
+/// Time between repeats of a held navigation key (ms, LVGL's default long-press repeat time)
+#define LV_CPP_KEY_NAV_REPEAT_PERIOD 100
+#endif
+
+namespace lv::key_nav {
+
+/**
+ * @brief Move the focus inside `obj` by dx, dy steps in one go
+ *
+ * dx counts right (negative: left) presses, dy down (negative: up).
+ */
+using StepFn = void (*)(lv_obj_t* obj, void* ctx, int32_t dx, int32_t dy);
+
+/// Arrow keys a target takes (the others reach LVGL)
+enum Axes : uint8_t {
+    horizontal = 1,    ///< LV_KEY_LEFT/RIGHT, encoder turns in editing mode
+    vertical = 2,      ///< LV_KEY_UP/DOWN
+    both = 3,
+};
+
+struct Stats {
+    uint32_t steps = 0;       ///< Presses, repeats and encoder detents taken from LVGL
+    uint32_t moves = 0;       ///< Focus moves they were resolved into
+    uint32_t max_batch = 0;   ///< Most steps resolved in one move
+};
+
+namespace detail {
+
+struct Target {
+    lv_obj_t* obj = nullptr;   ///< nullptr: free slot
+    StepFn step = nullptr;
+    void* ctx = nullptr;
+    uint8_t axes = 0;
+};
+
+struct Nav {
+    lv_indev_t* indev = nullptr;   ///< nullptr: free slot
+    lv_indev_read_cb_t read_cb = nullptr;
+    lv_display_t* disp = nullptr;
+    lv_obj_t* target = nullptr;    ///< Object the pending arrow steps go to (nullptr: the group)
+    uint32_t key = 0;              ///< Key of the pending steps (LV_KEY_NEXT/PREV: group steps)
+    uint32_t count = 0;            ///< Pending steps
+    uint32_t held = 0;             ///< Key taken from LVGL until its release (0: none)
+    lv_obj_t* held_target = nullptr;
+    uint32_t press_time = 0;
+    uint32_t repeats = 0;          ///< Repeats of `held` counted so far
+    uint32_t repeat_delay = LV_CPP_KEY_NAV_REPEAT_DELAY;
+    uint32_t repeat_period = LV_CPP_KEY_NAV_REPEAT_PERIOD;
+    bool lv_pressed = false;       ///< Last state LVGL was given
+    bool resolve = false;          ///< Resolve the pending steps at the end of this read
+};
+
+struct State {
+    Nav navs[LV_CPP_KEY_NAV_INDEVS];
+    Target targets[LV_CPP_KEY_NAV_TARGETS];
+    lv_timer_t* timer = nullptr;
+    Stats stats;
+};
+
+[[nodiscard]] inline State& state() noexcept {
+    static State s;
+    return s;
+}
+
+[[nodiscard]] inline Nav* find_nav(const lv_indev_t* indev) noexcept {
+    for (Nav& n : state().navs) {
+        if (n.indev == indev) return &n;
+    }
+    return nullptr;
+}
+
+[[nodiscard]] inline Target* find_target(const lv_obj_t* obj) noexcept {
+    for (Target& t : state().targets) {
+        if (t.obj == obj) return &t;
+    }
+    return nullptr;
+}
+
+[[nodiscard]] inline Target* focused_target(lv_group_t* group) noexcept {
+    lv_obj_t* obj = lv_group_get_focused(group);
+    return obj ? find_target(obj) : nullptr;
+}
+
+[[nodiscard]] constexpr bool is_group_key(uint32_t key) noexcept {
+    return key == LV_KEY_NEXT || key == LV_KEY_PREV;
+}
+
+[[nodiscard]] constexpr uint8_t key_axis(uint32_t key) noexcept {
+    switch (key) {
+    case LV_KEY_LEFT:
+    case LV_KEY_RIGHT: return horizontal;
+    case LV_KEY_UP:
+    case LV_KEY_DOWN: return vertical;
+    default: return 0;
+    }
+}
+
+/// Move the focus once for all pending steps
+inline void resolve(Nav& n) noexcept {
+    if (n.count == 0) return;
+    const auto count = static_cast<int32_t>(n.count);
+    n.count = 0;
+    Stats& st = state().stats;
+    ++st.moves;
+    if (static_cast<uint32_t>(count) > st.max_batch) st.max_batch = static_cast<uint32_t>(count);
+    if (is_group_key(n.key)) {
+        lv_group_t* group = lv_indev_get_group(n.indev);
+        if (!group) return;
+        lv_group_set_editing(group, false);
+        if (lv_obj_t* obj = lv::detail::group_step(group, n.key == LV_KEY_NEXT ? count : -count)) {
+            lv_group_focus_obj(obj);
+        }
+    } else if (Target* t = n.target ? find_target(n.target) : nullptr) {
+        const int32_t steps = n.key == LV_KEY_RIGHT || n.key == LV_KEY_DOWN ? count : -count;
+        if (key_axis(n.key) == horizontal) {
+            t->step(t->obj, t->ctx, steps, 0);
+        } else {
+            t->step(t->obj, t->ctx, 0, steps);
+        }
+    }
+}
+
+inline void add_steps(Nav& n, lv_obj_t* target, uint32_t key, uint32_t count) noexcept {
+    if (n.count && (n.key != key || n.target != target)) resolve(n);
+    n.target = target;
+    n.key = key;
+    n.count += count;
+    state().stats.steps += count;
+}
+
+/// Where a press of `key` goes: false for LVGL, else the group (target nullptr) or a target
+[[nodiscard]] inline bool route(const Nav& n, uint32_t key, lv_obj_t*& target) noexcept {
+    lv_group_t* group = lv_indev_get_group(n.indev);
+    if (!group) return false;
+    target = nullptr;
+    if (is_group_key(key)) return true;
+    const uint8_t axis = key_axis(key);
+    if (!axis) return false;
+    const Target* t = focused_target(group);
+    if (!t || !(t->axes & axis)) return false;
+    target = t->obj;
+    return true;
+}
+
+inline void keypad(Nav& n, lv_indev_data_t* data) noexcept {
+    const bool pressed = data->state == LV_INDEV_STATE_PRESSED;
+    if (n.held) {
+        if (pressed && data->key == n.held) {
+            const uint32_t elapsed = lv_tick_elaps(n.press_time);
+            const uint32_t period = n.repeat_period ? n.repeat_period : 1;
+            const uint32_t due = elapsed > n.repeat_delay ? (elapsed - n.repeat_delay) / period : 0;
+            if (due > n.repeats) {
+                add_steps(n, n.held_target, n.held, due - n.repeats);
+                n.repeats = due;
+            }
+            data->state = LV_INDEV_STATE_RELEASED;
+            return;
+        }
+        n.held = 0;
+        if (!pressed) return;    // LVGL never saw this key pressed
+    }
+    if (!pressed || n.lv_pressed) return;
+    lv_obj_t* target = nullptr;
+    if (!route(n, data->key, target)) {
+        resolve(n);    // e.g. Enter acts where the navigation arrived
+        return;
+    }
+    n.held = data->key;
+    n.held_target = target;
+    n.press_time = lv_tick_get();
+    n.repeats = 0;
+    add_steps(n, target, data->key, 1);
+    data->state = LV_INDEV_STATE_RELEASED;
+}
+
+inline void encoder(Nav& n, lv_indev_data_t* data) noexcept {
+    if (data->state == LV_INDEV_STATE_PRESSED && !n.lv_pressed) resolve(n);
+    if (data->enc_diff == 0) return;
+    lv_group_t* group = lv_indev_get_group(n.indev);
+    if (!group) return;
+    const bool forward = data->enc_diff > 0;
+    lv_obj_t* target = nullptr;
+    uint32_t key = forward ? LV_KEY_NEXT : LV_KEY_PREV;
+    if (lv_group_get_editing(group)) {
+        // LVGL sends LV_KEY_RIGHT/LEFT to the focused object while editing
+        const Target* t = focused_target(group);
+        if (!t || !(t->axes & horizontal)) return;
+        target = t->obj;
+        key = forward ? LV_KEY_RIGHT : LV_KEY_LEFT;
+    }
+    add_steps(n, target, key, static_cast<uint32_t>(forward ? data->enc_diff : -data->enc_diff));
+    data->enc_diff = 0;
+}
+
+inline void read_cb(lv_indev_t* indev, lv_indev_data_t* data) {
+    Nav* n = find_nav(indev);
+    if (!n) return;
+    if (n->read_cb) n->read_cb(indev, data);
+    if (lv_indev_get_type(indev) == LV_INDEV_TYPE_ENCODER) {
+        encoder(*n, data);
+    } else {
+        keypad(*n, data);
+    }
+    if (n->resolve) {
+        n->resolve = false;
+        resolve(*n);
+    }
+    n->lv_pressed = data->state == LV_INDEV_STATE_PRESSED;
+    if (n->count && state().timer) lv_timer_resume(state().timer);
+}
+
+/// Resolve `n`'s steps from an extra read, so they go through LVGL as the active indev
+inline void flush(Nav& n) noexcept {
+    if (n.count == 0) return;
+    n.resolve = true;
+    lv_indev_read(n.indev);
+    if (n.resolve) {    // disabled indev: read_cb did not run
+        n.resolve = false;
+        resolve(n);
+    }
+}
+
+inline void refr_start_cb(lv_event_t* e) noexcept {
+    flush(*static_cast<Nav*>(lv_event_get_user_data(e)));
+}
+
+inline void timer_cb(lv_timer_t* timer) noexcept {
+    lv_timer_pause(timer);    // resumed by the next read that leaves steps pending
+    for (Nav& n : state().navs) {
+        if (n.indev) flush(n);
+    }
+}
+
+inline void release(Nav& n) noexcept {
+    if (lv_indev_get_read_cb(n.indev) == &read_cb) lv_indev_set_read_cb(n.indev, n.read_cb);
+    if (n.disp) lv_display_remove_event_cb_with_user_data(n.disp, &refr_start_cb, &n);
+    n = Nav{};
+    for (const Nav& other : state().navs) {
+        if (other.indev) return;
+    }
+    if (state().timer) lv_timer_delete(state().timer);
+    state().timer = nullptr;
+}
+
+inline void indev_delete_cb(lv_event_t* e) noexcept {
+    if (Nav* n = find_nav(static_cast<lv_indev_t*>(lv_event_get_current_target(e)))) release(*n);
+}
+
+inline void release(Target& t) noexcept {
+    for (Nav& n : state().navs) {
+        if (n.target == t.obj) n.count = 0;
+        if (n.held_target == t.obj) n.held = 0;
+    }
+    t = Target{};
+}
+
+inline void target_delete_cb(lv_event_t* e) noexcept {
+    if (Target* t = find_target(static_cast<lv_obj_t*>(lv_event_get_current_target(e)))) release(*t);
+}
+
+} // namespace detail
+
+/**
+ * @brief Resolve the navigation keys of a keypad or encoder once per frame
+ *
+ * Steps are resolved at the start of each refresh of the indev's display
+ * (the default display if it has none).
+ * @return false for other indev types or without a free slot
+ */
+inline bool attach(lv_indev_t* indev) noexcept {
+    if (!indev) return false;
+    const lv_indev_type_t type = lv_indev_get_type(indev);
+    if (type != LV_INDEV_TYPE_KEYPAD && type != LV_INDEV_TYPE_ENCODER) return false;
+    if (detail::find_nav(indev)) return true;
+    detail::Nav* n = detail::find_nav(nullptr);
+    if (!n) {
+        LV_LOG_WARN("key_nav: raise LV_CPP_KEY_NAV_INDEVS");
+        return false;
+    }
+    detail::State& s = detail::state();
+    if (!s.timer) {
+        s.timer = lv_timer_create(&detail::timer_cb, LV_CPP_KEY_NAV_FLUSH_MS, nullptr);
+        lv_timer_pause(s.timer);
+    }
+    n->indev = indev;
+    n->read_cb = lv_indev_get_read_cb(indev);
+    lv_indev_set_read_cb(indev, &detail::read_cb);
+    lv_indev_add_event_cb(indev, &detail::indev_delete_cb, LV_EVENT_DELETE, nullptr);
+    n->disp = lv_indev_get_display(indev);
+    if (!n->disp) n->disp = lv_display_get_default();
+    if (n->disp) lv_display_add_event_cb(n->disp, &detail::refr_start_cb, LV_EVENT_REFR_START, n);
+    return true;
+}
+
+/// Resolve what is pending and give the indev its read callback back
+inline void detach(lv_indev_t* indev) noexcept {
+    detail::Nav* n = indev ? detail::find_nav(indev) : nullptr;
+    if (!n) return;
+    detail::flush(*n);
+    lv_indev_remove_event_cb_with_user_data(indev, &detail::indev_delete_cb, nullptr);
+    detail::release(*n);
+}
+
+[[nodiscard]] inline bool attached(const lv_indev_t* indev) noexcept {
+    return indev && detail::find_nav(indev) != nullptr;
+}
+
+/**
+ * @brief Repeat timing of held navigation keys on the attached `indev`
+ *
+ * The keys key_nav takes never reach LVGL's long-press handling; match
+ * this to lv_indev_set_long_press_time()/_repeat_time() when the indev
+ * uses other values than LVGL's defaults.
+ */
+inline void repeat_timing(lv_indev_t* indev, uint32_t delay_ms, uint32_t period_ms) noexcept {
+    if (detail::Nav* n = indev ? detail::find_nav(indev) : nullptr) {
+        n->repeat_delay = delay_ms;
+        n->repeat_period = period_ms;
+    }
+}
+
+/**
+ * @brief Let `obj` take the arrow keys along `axes` while it has the focus
+ *
+ * Adding it again replaces its step function. The entry goes away with
+ * the object.
+ * @return false without a free slot (the keys then reach LVGL one by one)
+ */
+inline bool add(lv_obj_t* obj, StepFn step, void* ctx = nullptr, uint8_t axes = both) noexcept {
+    if (!obj || !step) return false;
+    detail::Target* t = detail::find_target(obj);
+    if (!t) {
+        t = detail::find_target(nullptr);
+        if (!t) {
+            LV_LOG_WARN("key_nav: raise LV_CPP_KEY_NAV_TARGETS");
+            return false;
+        }
+        t->obj = obj;
+        lv_obj_add_event_cb(obj, &detail::target_delete_cb, LV_EVENT_DELETE, nullptr);
+    }
+    t->step = step;
+    t->ctx = ctx;
+    t->axes = axes;
+    return true;
+}
+
+/// Hand `obj`'s arrow keys back to LVGL
+inline void remove(lv_obj_t* obj) noexcept {
+    detail::Target* t = obj ? detail::find_target(obj) : nullptr;
+    if (!t) return;
+    lv_obj_remove_event_cb_with_user_data(obj, &detail::target_delete_cb, nullptr);
+    detail::release(*t);
+}
+
+/// Resolve the pending steps of every attached indev now
+inline void flush() noexcept {
+    for (detail::Nav& n : detail::state().navs) {
+        if (n.indev) detail::flush(n);
+    }
+}
+
+[[nodiscard]] inline Stats stats() noexcept { return detail::state().stats; }
+
+inline void reset_stats() noexcept { detail::state().stats = Stats{}; }
+
+} // namespace lv::key_nav
@@ -0,0 +1,347 @@
+#pragma once
+
+/**
+ * @file keyframes.hpp
+ * @brief Constant keyframe tracks played by sampling, with O(log n) seek and reverse
+ *
+ * AnimTimeline copies an lv_anim_t per segment and starts each at its
+ * offset; seeking restarts them and reversing rebuilds them. Keyframes
+ * is a constant description instead: per track a target slot, a
+ * property and keys sorted by time, all constexpr so it lives in flash.
+ * KeyframePlayer samples every track once per frame at the play
+ * position (the segment found last is checked first, otherwise a binary
+ * search), so seek() is O(log keys) per track and reverse() only flips
+ * the direction the position moves.
+ *
+ * @code
+ * inline constexpr lv::Keyframe sweep[] = {{0, 0}, {400, 75, lv::Ease::ease_out}, {900, 60, lv::Ease::ease_in_out}};
+ * inline constexpr lv::Keyframe fade[]  = {{0, 0}, {200, 255}};
+ * inline constexpr lv::KeyTrack tracks[] = {
+ *     {0, lv::AnimProp::arc_value, sweep},
+ *     {1, lv::AnimProp::opa, fade},
+ * };
+ * inline constexpr lv::Keyframes arc_intro{tracks};
+ * static_assert(arc_intro.valid());
+ *
+ * static lv::KeyframePlayer intro(arc_intro);
+ * intro.bind(0, arc).bind(1, label).play();
+ * intro.seek(450);                     // scrub
+ * intro.reverse().play();              // back to the start
+ * @endcode
+ *
+ * A key's ease shapes the segment that arrives at it. scripts/keyframes.py
+ * turns a JSON description into such a header.
+ *
+ * Heap allocation: the timer (created by the first play()) and one
+ * delete-event descriptor per bound target
+ */
+
+#include <lvgl.h>
+#include <cstddef>
+#include <cstdint>
+#include "object.hpp"
+#include "anim_batch.hpp"
+
+#ifndef LV_CPP_KEYFRAME_TRACKS
+/// Tracks a KeyframePlayer can play
+#define LV_CPP_KEYFRAME_TRACKS 16
+#endif
+
+#ifndef LV_CPP_KEYFRAME_TARGETS
+/// Target slots (objects) a KeyframePlayer can bind
+#define LV_CPP_KEYFRAME_TARGETS 8
+#endif
+
+namespace lv {
+
+/// Value at a time (ms); `ease` shapes the segment from the previous key to this one
+struct Keyframe {
+    uint32_t time;
+    int32_t value;
+    Ease ease = Ease::linear;
+};
+
+/// Keys of one property of one target slot, sorted by time
+struct KeyTrack {
+    uint8_t target;
+    AnimProp prop;
+    const Keyframe* keys;
+    uint32_t count;
+
+    constexpr KeyTrack(uint8_t t, AnimProp p, const Keyframe* k, uint32_t n) noexcept
+        : target(t), prop(p), keys(k), count(n) {}
+
+    template<size_t K>
+    constexpr KeyTrack(uint8_t t, AnimProp p, const Keyframe (&k)[K]) noexcept
+        : target(t), prop(p), keys(k), count(static_cast<uint32_t>(K)) {}
+
+    /// Time of the last key
+    [[nodiscard]] constexpr uint32_t end() const noexcept { return count ? keys[count - 1].time : 0; }
+};
+
+/// A set of tracks; its duration is the latest last key
+struct Keyframes {
+    const KeyTrack* tracks;
+    uint32_t count;
+
+    constexpr Keyframes(const KeyTrack* t, uint32_t n) noexcept : tracks(t), count(n) {}
+
+    template<size_t T>
+    constexpr Keyframes(const KeyTrack (&t)[T]) noexcept : tracks(t), count(static_cast<uint32_t>(T)) {}
+
+    [[nodiscard]] constexpr uint32_t duration() const noexcept {
+        uint32_t d = 0;
+        for (uint32_t i = 0; i < count; ++i) d = tracks[i].end() > d ? tracks[i].end() : d;
+        return d;
+    }
+
+    /// Every track has keys in strictly increasing time and a target slot in range
+    [[nodiscard]] constexpr bool valid() const noexcept {
+        if (count > LV_CPP_KEYFRAME_TRACKS) return false;
+        for (uint32_t i = 0; i < count; ++i) {
+            const KeyTrack& t = tracks[i];
+            if (t.count == 0 || t.target >= LV_CPP_KEYFRAME_TARGETS) return false;
+            for (uint32_t k = 1; k < t.count; ++k) {
+                if (t.keys[k].time <= t.keys[k - 1].time) return false;
+            }
+        }
+        return true;
+    }
+};
+
+namespace detail {
+
+/// Index of the segment [keys[i], keys[i + 1]) holding `t` (keys[0].time <= t < end)
+[[nodiscard]] inline uint32_t key_segment(const KeyTrack& track, uint32_t t) noexcept {
+    uint32_t lo = 0, hi = track.count - 1;      // invariant: keys[lo].time <= t < keys[hi].time
+    while (hi - lo > 1) {
+        const uint32_t mid = (lo + hi) / 2;
+        if (track.keys[mid].time <= t) lo = mid;
+        else hi = mid;
+    }
+    return lo;
+}
+
+} // namespace detail
+
+/**
+ * @brief Plays a Keyframes description on bound objects
+ *
+ * Non-movable: the timer and delete events keep a pointer to it.
+ */
+class KeyframePlayer {
+public:
+    struct Stats {
+        uint32_t ticks = 0;       ///< Frames sampled
+        uint32_t searches = 0;    ///< Binary searches (the cached segment missed)
+        uint32_t applied = 0;     ///< Property writes
+    };
+
+private:
+    const Keyframes& m_seq;
+    uint32_t m_duration;
+    lv_obj_t* m_targets[LV_CPP_KEYFRAME_TARGETS] = {};
+    uint32_t m_segment[LV_CPP_KEYFRAME_TRACKS] = {};
+    int32_t m_applied[LV_CPP_KEYFRAME_TRACKS];
+    uint32_t m_pos = 0;
+    uint32_t m_last_tick = 0;
+    uint32_t m_repeat = 0;
+    uint32_t m_repeats_left = 0;
+    bool m_reverse = false;
+    bool m_playing = false;
+    lv_timer_t* m_timer = nullptr;
+    void (*m_on_done)(void*) = nullptr;
+    void* m_done_ctx = nullptr;
+    Stats m_stats;
+
+    /// Value of track `i` at `t`
+    [[nodiscard]] int32_t sample(uint32_t i, uint32_t t) noexcept {
+        const KeyTrack& track = m_seq.tracks[i];
+        const Keyframe* k = track.keys;
+        if (t <= k[0].time) return k[0].value;
+        if (t >= k[track.count - 1].time) return k[track.count - 1].value;
+        uint32_t s = m_segment[i];
+        if (s + 1 >= track.count || t < k[s].time || t >= k[s + 1].time) {
+            // Playing usually moves into the next (or previous) segment
+            if (s + 2 < track.count && t >= k[s + 1].time && t < k[s + 2].time) ++s;
+            else if (s > 0 && s < track.count && t >= k[s - 1].time && t < k[s].time) --s;
+            else {
+                s = detail::key_segment(track, t);
+                ++m_stats.searches;
+            }
+            m_segment[i] = s;
+        }
+        const int32_t eased = detail::ease_progress(detail::ease_tables(), static_cast<uint8_t>(k[s + 1].ease),
+                                                    t - k[s].time, k[s + 1].time - k[s].time);
+        const int64_t delta = static_cast<int64_t>(k[s + 1].value) - k[s].value;
+        return k[s].value + static_cast<int32_t>((delta * eased) >> 10);
+    }
+
+    /// Sample every track at the current position and write the changed values
+    void render() noexcept {
+        for (uint32_t i = 0; i < m_seq.count && i < LV_CPP_KEYFRAME_TRACKS; ++i) {
+            const KeyTrack& track = m_seq.tracks[i];
+            lv_obj_t* obj = track.target < LV_CPP_KEYFRAME_TARGETS ? m_targets[track.target] : nullptr;
+            if (!obj) continue;
+            const int32_t v = sample(i, m_pos);
+            if (v == m_applied[i]) continue;
+            m_applied[i] = v;
+            detail::anim_apply(obj, track.prop, v);
+            ++m_stats.applied;
+        }
+    }
+
+    /// Move the position by `dt` ms in the play direction; false when playback ends
+    [[nodiscard]] bool advance(uint32_t dt) noexcept {
+        while (true) {
+            const uint32_t room = m_reverse ? m_pos : m_duration - m_pos;
+            if (dt < room || m_duration == 0) {
+                m_pos = m_reverse ? m_pos - dt : m_pos + dt;
+                return m_duration != 0;
+            }
+            dt -= room;
+            m_pos = m_reverse ? 0 : m_duration;
+            if (m_repeats_left == 0) return false;
+            if (m_repeats_left != LV_ANIM_REPEAT_INFINITE) --m_repeats_left;
+            m_pos = m_reverse ? m_duration : 0;
+        }
+    }
+
+    void tick() noexcept {
+        ++m_stats.ticks;
+        const uint32_t now = lv_tick_get();
+        const uint32_t dt = now - m_last_tick;
+        m_last_tick = now;
+        const bool more = advance(dt);
+        render();
+        if (!more) {
+            m_playing = false;
+            lv_timer_pause(m_timer);
+            if (m_on_done) m_on_done(m_done_ctx);
+        }
+    }
+
+    static void timer_cb(lv_timer_t* t) noexcept {
+        static_cast<KeyframePlayer*>(lv_timer_get_user_data(t))->tick();
+    }
+
+    static void delete_cb(lv_event_t* e) noexcept {
+        auto* self = static_cast<KeyframePlayer*>(lv_event_get_user_data(e));
+        auto* obj = static_cast<lv_obj_t*>(lv_event_get_current_target(e));
+        for (lv_obj_t*& t : self->m_targets) {
+            if (t == obj) t = nullptr;
+        }
+    }
+
+    void unbind(uint8_t slot) noexcept {
+        lv_obj_t* obj = m_targets[slot];
+        if (!obj) return;
+        m_targets[slot] = nullptr;
+        for (lv_obj_t* t : m_targets) {
+            if (t == obj) return;       // still hooked for another slot
+        }
+        lv_obj_remove_event_cb_with_user_data(obj, &KeyframePlayer::delete_cb, this);
+    }
+
+public:
+    /// @param seq Tracks to play (must outlive the player; usually a constexpr global)
+    explicit KeyframePlayer(const Keyframes& seq) noexcept : m_seq(seq), m_duration(seq.duration()) {
+        for (int32_t& v : m_applied) v = INT32_MIN;
+        if (seq.count > LV_CPP_KEYFRAME_TRACKS) {
+            LV_LOG_WARN("KeyframePlayer: %u tracks (raise LV_CPP_KEYFRAME_TRACKS)", static_cast<unsigned>(seq.count));
+        }
+    }
+
+    ~KeyframePlayer() {
+        for (uint8_t s = 0; s < LV_CPP_KEYFRAME_TARGETS; ++s) unbind(s);
+        if (m_timer) lv_timer_delete(m_timer);
+    }
+
+    KeyframePlayer(const KeyframePlayer&) = delete;
+    KeyframePlayer& operator=(const KeyframePlayer&) = delete;
+
+    // ==================== Setup ====================
+
+    /// Drive the tracks of target slot `slot` on `obj` (nullptr unbinds)
+    KeyframePlayer& bind(uint8_t slot, ObjectView obj) noexcept {
+        if (slot >= LV_CPP_KEYFRAME_TARGETS) {
+            LV_LOG_WARN("KeyframePlayer: target slot %u (raise LV_CPP_KEYFRAME_TARGETS)", static_cast<unsigned>(slot));
+            return *this;
+        }
+        unbind(slot);
+        if (!obj.get()) return *this;
+        bool hooked = false;
+        for (lv_obj_t* t : m_targets) hooked = hooked || t == obj.get();
+        if (!hooked) lv_obj_add_event_cb(obj.get(), &KeyframePlayer::delete_cb, LV_EVENT_DELETE, this);
+        m_targets[slot] = obj.get();
+        for (uint32_t i = 0; i < m_seq.count && i < LV_CPP_KEYFRAME_TRACKS; ++i) {
+            if (m_seq.tracks[i].target == slot) m_applied[i] = INT32_MIN;
+        }
+        return *this;
+    }
+
+    /// Play towards the start (true) or the end (false); takes effect at once, even while playing
+    KeyframePlayer& reverse(bool en = true) noexcept {
+        m_reverse = en;
+        return *this;
+    }
+
+    /// Extra passes after the first (LV_ANIM_REPEAT_INFINITE for forever)
+    KeyframePlayer& repeat(uint32_t count) noexcept {
+        m_repeat = count;
+        return *this;
+    }
+
+    /// Call `(obj->*MemFn)()` when playback reaches its end
+    template<auto MemFn, typename T>
+    KeyframePlayer& on_done(T* obj) noexcept {
+        m_done_ctx = obj;
+        m_on_done = [](void* ctx) { (static_cast<T*>(ctx)->*MemFn)(); };
+        return *this;
+    }
+
+    // ==================== Playback ====================
+
+    /**
+     * @brief Play from the current position
+     *
+     * At the end of the play direction, starts over from the other end.
+     */
+    void play() noexcept {
+        if (!m_timer) {
+            m_timer = lv_timer_create(&KeyframePlayer::timer_cb, LV_DEF_REFR_PERIOD, this);
+            if (!m_timer) return;
+        }
+        if (m_reverse ? m_pos == 0 : m_pos >= m_duration) m_pos = m_reverse ? m_duration : 0;
+        m_repeats_left = m_repeat;
+        m_last_tick = lv_tick_get();
+        m_playing = true;
+        render();
+        lv_timer_resume(m_timer);
+    }
+
+    /// Stop at the current position
+    void pause() noexcept {
+        m_playing = false;
+        if (m_timer) lv_timer_pause(m_timer);
+    }
+
+    /// Jump to `ms` (clamped to the duration) and apply the values there
+    KeyframePlayer& seek(uint32_t ms) noexcept {
+        m_pos = ms < m_duration ? ms : m_duration;
+        render();
+        return *this;
+    }
+
+    // ==================== State ====================
+
+    [[nodiscard]] bool playing() const noexcept { return m_playing; }
+    [[nodiscard]] bool reversed() const noexcept { return m_reverse; }
+    [[nodiscard]] uint32_t position() const noexcept { return m_pos; }
+    [[nodiscard]] uint32_t duration() const noexcept { return m_duration; }
+
+    [[nodiscard]] const Stats& stats() const noexcept { return m_stats; }
+    void reset_stats() noexcept { m_stats = {}; }
+};
+
+} // namespace lv
@@ -0,0 +1,613 @@
+#pragma once
+
+/**
+ * @file kinetic_scroll.hpp
+ * @brief Fling scrolling from the pointer samples, drawn from a cached content bitmap
+ *
+ * Every frame of a scroll invalidates the whole container, and LVGL draws
+ * every visible child again although the content only moved. LVGL's own
+ * momentum also takes its velocity from the last sample alone, so a noisy
+ * final read decides how far a list flies. kinetic_scroll::enable() changes
+ * both for one scrollable object:
+ *
+ * @code
+ * #include <lv/core/kinetic_scroll.hpp>
+ *
+ * auto list = lv::List::create(screen).size(lv::pct(100), lv::pct(100));
+ * ... 200 rows ...
+ * lv::kinetic_scroll::enable(list);                       // cache + fling
+ * lv::kinetic_scroll::enable(log, {.margin_px = 128});    // bigger cache band
+ * lv::kinetic_scroll::fling(list, 0, -2400.0f);           // programmatic fling, px/s
+ * @endcode
+ *
+ * Fling: while the pointer drags the object, each scroll step records the
+ * pointer position. On release, the velocity is the least-squares slope
+ * of the samples from the last 100 ms. The object then moves with
+ * exponential decay, v(t) = v0 * e^(-t / decay_ms). The motion is applied
+ * with scroll_by() once per frame and stops at the scroll edges, below
+ * `min_speed`, or when a pointer presses on the object.
+ * LV_OBJ_FLAG_SCROLL_MOMENTUM is cleared, so LVGL's throw does not run as
+ * well; elastic bounce-back and snapping are LVGL's as before.
+ *
+ * Content cache (LV_USE_SNAPSHOT): once a scroll has lasted
+ * `capture_delay_ms` (past press/release transitions of the rows), the
+ * children are rendered once into an ARGB8888 bitmap `margin_px` larger
+ * than the viewport along the scroll axes. Until the object has been still
+ * for `idle_ms`, its redraws draw the background live, blit the bitmap at
+ * the current offset and skip the children. When the viewport leaves the
+ * bitmap, the pixels still in view are moved in place and only the newly
+ * exposed strips are rendered. The bitmap returns to the DrawBufPool when
+ * scrolling stops.
+ *
+ * The container's own events drop the bitmap: STYLE_CHANGED, SIZE_CHANGED,
+ * and child created/deleted/changed. Rows that change while the cache is in
+ * use (a clock, a progress bar) need invalidate(). Objects with many such
+ * rows should use the fling without the cache ({.cache = false}).
+ *
+ * Not included by lv.hpp: it walks children through spec_attr, reads
+ * objects' coords and narrows lv_layer_t::_clip_area, none of which is
+ * public. Checked against LVGL 9.4 (see LV_CPP_INTERNALS_OK).
+ *
+ * Heap allocation: NONE in the wrapper (LV_CPP_KINETIC_SCROLL_OBJECTS fixed
+ * slots, one LVGL timer); bitmaps come from the DrawBufPool
+ */
+
+#include <lvgl.h>
+#include "version.hpp"
+
+#if !LV_CPP_INTERNALS_OK
+#error "kinetic_scroll.hpp reads LVGL internals checked against LVGL 9.4; see LV_CPP_INTERNALS_OK"
+#endif
+
+#include <src/core/lv_obj_private.h>   // spec_attr->child_cnt, coords
+#include <src/draw/lv_draw_private.h>  // lv_layer_t::_clip_area
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include "object.hpp"
+#include "snapshot_stream.hpp"
+#include "../draw/draw_buf.hpp"
+
+#ifndef LV_CPP_KINETIC_SCROLL_OBJECTS
+/// Objects that can use kinetic scrolling at once
+#define LV_CPP_KINETIC_SCROLL_OBJECTS 4
+#endif
+
+#ifndef LV_CPP_KINETIC_SCROLL_BYTES
+/// Content bitmap bytes all kinetic objects may hold together
+#define LV_CPP_KINETIC_SCROLL_BYTES (1024u * 1024u)
+#endif
+
+namespace lv {
+
+/// Tuning of a kinetic scroll object (see kinetic_scroll.hpp)
+struct KineticConfig {
+    uint16_t decay_ms = 325;          ///< Time constant of the fling's exponential slow-down
+    uint16_t min_speed = 20;          ///< px/s where a fling stops
+    uint16_t fling_speed = 150;       ///< Release speed (px/s) that starts a fling
+    uint16_t max_speed = 8000;        ///< Release speeds are capped to this (px/s)
+    uint16_t margin_px = 64;          ///< Cached content beyond each scrolled edge of the viewport
+    uint16_t capture_delay_ms = 120;  ///< Scroll time before the content is cached
+    uint16_t idle_ms = 200;           ///< Stillness after which the bitmap is released
+    bool cache = true;                ///< Draw scroll frames from a content bitmap
+    bool fling = true;                ///< Replace LVGL's momentum with the fling model
+};
+
+namespace kinetic_scroll {
+
+/// Counters of all kinetic scroll objects
+struct Stats {
+    uint32_t flings;        ///< Flings started (release or fling())
+    uint32_t captures;      ///< Full content renders into a bitmap
+    uint32_t strips;        ///< Exposed strips rendered after a shift
+    uint64_t strip_pixels;  ///< Pixels of these strips
+    uint32_t cached_draws;  ///< Redraws that blitted the bitmap instead of drawing the children
+    uint32_t drops;         ///< Bitmaps dropped by a content change or invalidate()
+    uint32_t bytes;         ///< Bitmap bytes held
+};
+
+namespace detail {
+
+/// Pointer samples kept for the release velocity
+inline constexpr uint32_t kSamples = 8;
+
+/// Samples older than this are not used for the velocity (ms)
+inline constexpr uint32_t kVelocityWindow = 100;
+
+struct Sample {
+    uint32_t tick;
+    lv_point_t p;
+};
+
+struct Entry {
+    lv_obj_t* obj = nullptr;        ///< nullptr: free slot
+    KineticConfig cfg{};
+    bool had_momentum = false;      ///< LV_OBJ_FLAG_SCROLL_MOMENTUM before enable()
+    // Pointer tracking and fling
+    Sample samples[kSamples] = {};
+    uint32_t sample_count = 0;
+    bool tracking = false;          ///< Dragged by a pointer since the last release
+    bool flinging = false;
+    float vx = 0.0f;                ///< px/s, the direction content moves
+    float vy = 0.0f;
+    float rx = 0.0f;                ///< Sub-pixel motion not applied yet
+    float ry = 0.0f;
+    uint32_t fling_tick = 0;
+    // Content cache
+    uint32_t scroll_start = 0;      ///< Tick of the first scroll since idle
+    uint32_t last_scroll = 0;
+    bool scrolling = false;
+    lv_draw_buf_t* buf = nullptr;   ///< Pooled ARGB8888 content bitmap
+    bool valid = false;             ///< buf matches the children
+    lv_area_t area{};               ///< Screen area buf covers at scroll (base_x, base_y)
+    int32_t base_x = 0;
+    int32_t base_y = 0;
+    bool substituted = false;       ///< Children hidden for the current redraw
+    uint32_t child_cnt = 0;
+};
+
+struct Tables {
+    Entry entries[LV_CPP_KINETIC_SCROLL_OBJECTS];
+    lv_timer_t* timer = nullptr;
+    Stats stats{};
+};
+
+[[nodiscard]] inline Tables& tables() noexcept {
+    static Tables t;
+    return t;
+}
+
+[[nodiscard]] inline Entry* find(const lv_obj_t* obj) noexcept {
+    for (Entry& e : tables().entries) {
+        if (e.obj == obj) return &e;
+    }
+    return nullptr;
+}
+
+inline void wake() noexcept {
+    if (lv_timer_t* t = tables().timer) lv_timer_resume(t);
+}
+
+// ==================== Fling ====================
+
+/// Least-squares slope of the samples of the last kVelocityWindow ms (px/s)
+inline void velocity(const Entry& e, float& vx, float& vy) noexcept {
+    vx = vy = 0.0f;
+    if (e.sample_count < 2) return;
+    const uint32_t kept = e.sample_count < kSamples ? e.sample_count : kSamples;
+    const Sample& last = e.samples[(e.sample_count - 1) % kSamples];
+    uint32_t n = 0;
+    float st = 0.0f, sx = 0.0f, sy = 0.0f;
+    for (uint32_t k = 1; k <= kept; ++k) {
+        const Sample& s = e.samples[(e.sample_count - k) % kSamples];
+        if (last.tick - s.tick > kVelocityWindow) break;
+        st += -static_cast<float>(last.tick - s.tick);
+        sx += static_cast<float>(s.p.x);
+        sy += static_cast<float>(s.p.y);
+        ++n;
+    }
+    if (n < 2) return;
+    const float mt = st / n, mx = sx / n, my = sy / n;
+    float stt = 0.0f, stx = 0.0f, sty = 0.0f;
+    for (uint32_t k = 1; k <= n; ++k) {
+        const Sample& s = e.samples[(e.sample_count - k) % kSamples];
+        const float t = -static_cast<float>(last.tick - s.tick) - mt;
+        stt += t * t;
+        stx += t * (static_cast<float>(s.p.x) - mx);
+        sty += t * (static_cast<float>(s.p.y) - my);
+    }
+    if (stt <= 0.0f) return;
+    vx = stx / stt * 1000.0f;
+    vy = sty / stt * 1000.0f;
+}
+
+inline void start_fling(Entry& e, float vx, float vy) noexcept {
+    const lv_dir_t dir = lv_obj_get_scroll_dir(e.obj);
+    if (!(dir & LV_DIR_HOR)) vx = 0.0f;
+    if (!(dir & LV_DIR_VER)) vy = 0.0f;
+    const float max = e.cfg.max_speed;
+    vx = vx > max ? max : (vx < -max ? -max : vx);
+    vy = vy > max ? max : (vy < -max ? -max : vy);
+    if (vx * vx + vy * vy < static_cast<float>(e.cfg.fling_speed) * e.cfg.fling_speed) return;
+    e.vx = vx;
+    e.vy = vy;
+    e.rx = e.ry = 0.0f;
+    e.fling_tick = lv_tick_get();
+    e.flinging = true;
+    ++tables().stats.flings;
+    wake();
+}
+
+/// Any pointer pressed on the object stops its fling
+[[nodiscard]] inline bool touched(const Entry& e) noexcept {
+    for (lv_indev_t* i = lv_indev_get_next(nullptr); i; i = lv_indev_get_next(i)) {
+        if (lv_indev_get_type(i) != LV_INDEV_TYPE_POINTER || lv_indev_get_state(i) != LV_INDEV_STATE_PRESSED) continue;
+        lv_point_t p;
+        lv_indev_get_point(i, &p);
+        if (lv_area_is_point_on(&e.obj->coords, &p, 0)) return true;
+    }
+    return false;
+}
+
+/// Clamp a step to the room left before the scroll edge; false if it was cut
+[[nodiscard]] inline bool clamp(int32_t& d, int32_t room_neg, int32_t room_pos) noexcept {
+    if (d > room_pos) { d = room_pos > 0 ? room_pos : 0; return false; }
+    if (d < -room_neg) { d = room_neg > 0 ? -room_neg : 0; return false; }
+    return true;
+}
+
+inline void step_fling(Entry& e) noexcept {
+    if (touched(e)) {
+        e.flinging = false;
+        return;
+    }
+    const uint32_t dt = lv_tick_elaps(e.fling_tick);
+    if (dt == 0) return;
+    e.fling_tick = lv_tick_get();
+    const float tau = e.cfg.decay_ms / 1000.0f;
+    const float k = std::exp(-static_cast<float>(dt) / e.cfg.decay_ms);
+    // Exact distance of the decaying velocity over dt: v0 * tau * (1 - k)
+    e.rx += e.vx * tau * (1.0f - k);
+    e.ry += e.vy * tau * (1.0f - k);
+    e.vx *= k;
+    e.vy *= k;
+    int32_t dx = static_cast<int32_t>(e.rx);
+    int32_t dy = static_cast<int32_t>(e.ry);
+    e.rx -= static_cast<float>(dx);
+    e.ry -= static_cast<float>(dy);
+    // Content moving right uncovers what is scrolled out on the left
+    if (!clamp(dx, lv_obj_get_scroll_right(e.obj), lv_obj_get_scroll_left(e.obj))) e.vx = e.rx = 0.0f;
+    if (!clamp(dy, lv_obj_get_scroll_bottom(e.obj), lv_obj_get_scroll_top(e.obj))) e.vy = e.ry = 0.0f;
+    if (dx || dy) lv_obj_scroll_by(e.obj, dx, dy, LV_ANIM_OFF);
+    const float min = e.cfg.min_speed;
+    if (e.vx * e.vx + e.vy * e.vy < min * min) e.flinging = false;
+}
+
+// ==================== Content cache ====================
+
+#if LV_USE_SNAPSHOT
+
+inline void free_buf(Entry& e) noexcept {
+    e.valid = false;
+    if (!e.buf) return;
+    tables().stats.bytes -= e.buf->data_size;
+    lv_image_cache_drop(e.buf);
+    lv_draw_buf_destroy(e.buf);
+    e.buf = nullptr;
+}
+
+/// Viewport grown by the margin along the object's scroll axes
+[[nodiscard]] inline lv_area_t cache_area(const Entry& e) noexcept {
+    lv_area_t a = e.obj->coords;
+    const lv_dir_t dir = lv_obj_get_scroll_dir(e.obj);
+    const int32_t m = e.cfg.margin_px;
+    if (dir & LV_DIR_HOR) { a.x1 -= m; a.x2 += m; }
+    if (dir & LV_DIR_VER) { a.y1 -= m; a.y2 += m; }
+    return a;
+}
+
+/// Where the bitmap lies now, after scrolling since it was based
+[[nodiscard]] inline lv_area_t current_area(const Entry& e) noexcept {
+    lv_area_t a = e.area;
+    lv_area_move(&a, e.base_x - lv_obj_get_scroll_x(e.obj), e.base_y - lv_obj_get_scroll_y(e.obj));
+    return a;
+}
+
+/// Render the children inside `strip` (screen coordinates, inside e.area) into the bitmap
+inline void render(Entry& e, const lv_area_t& strip) noexcept {
+    lv_area_t rel = strip;
+    lv_area_move(&rel, -e.area.x1, -e.area.y1);
+    lv_draw_buf_clear(e.buf, &rel);
+    lv_layer_t layer;
+    lv_layer_init(&layer);
+    layer.draw_buf = e.buf;
+    layer.color_format = LV_COLOR_FORMAT_ARGB8888;
+    layer.buf_area = e.area;
+    layer._clip_area = strip;
+    layer.phy_clip_area = strip;
+    const uint32_t n = lv_obj_get_child_count(e.obj);
+    for (uint32_t i = 0; i < n; ++i) {
+        lv_obj_t* child = e.obj->spec_attr->children[i];
+        if (lv_obj_has_flag(child, LV_OBJ_FLAG_HIDDEN)) continue;
+        lv_area_t ext = child->coords;
+        const int32_t grow = lv_obj_get_ext_draw_size(child);
+        lv_area_increase(&ext, grow, grow);
+        lv_area_t common;
+        if (!lv_area_intersect(&common, &ext, &strip)) continue;
+        snapshot::detail::redraw(child, layer);
+    }
+}
+
+/// Render the whole band around the viewport; false leaves the children drawn live
+[[nodiscard]] inline bool capture(Entry& e) noexcept {
+    Tables& t = tables();
+    const lv_area_t a = cache_area(e);
+    const uint32_t w = static_cast<uint32_t>(lv_area_get_width(&a));
+    const uint32_t h = static_cast<uint32_t>(lv_area_get_height(&a));
+    if (!e.buf || e.buf->header.w != w || e.buf->header.h != h) {
+        free_buf(e);
+        const uint32_t need = lv_draw_buf_width_to_stride(w, LV_COLOR_FORMAT_ARGB8888) * h;
+        if (t.stats.bytes + need > LV_CPP_KINETIC_SCROLL_BYTES) return false;
+        e.buf = lv_draw_buf_create_ex(draw::pool_handlers(), w, h, LV_COLOR_FORMAT_ARGB8888, 0);
+        if (!e.buf) return false;
+        t.stats.bytes += e.buf->data_size;
+    } else {
+        lv_image_cache_drop(e.buf);
+    }
+    e.area = a;
+    e.base_x = lv_obj_get_scroll_x(e.obj);
+    e.base_y = lv_obj_get_scroll_y(e.obj);
+    render(e, a);
+    e.valid = true;
+    ++t.stats.captures;
+    return true;
+}
+
+/// Move the bitmap so the viewport is centred in it again, then render the uncovered strips
+inline void recentre(Entry& e, const lv_area_t& now) noexcept {
+    Tables& t = tables();
+    const lv_area_t next = cache_area(e);
+    const int32_t w = lv_area_get_width(&next);
+    const int32_t h = lv_area_get_height(&next);
+    const int32_t ox = now.x1 - next.x1;    // old pixel (x, y) lands at (x + ox, y + oy)
+    const int32_t oy = now.y1 - next.y1;
+    if (ox <= -w || ox >= w || oy <= -h || oy >= h) {
+        e.valid = false;
+        (void)capture(e);
+        return;
+    }
+    lv_image_cache_drop(e.buf);
+    auto* data = static_cast<uint8_t*>(e.buf->data);
+    const uint32_t stride = e.buf->header.stride;
+    if (oy > 0) std::memmove(data + oy * stride, data, (h - oy) * stride);
+    if (oy < 0) std::memmove(data, data - oy * stride, (h + oy) * stride);
+    if (ox != 0) {
+        const int32_t keep = (w - (ox < 0 ? -ox : ox)) * 4;
+        for (int32_t y = 0; y < h; ++y) {
+            uint8_t* row = data + y * stride;
+            if (ox > 0) std::memmove(row + ox * 4, row, keep);
+            else std::memmove(row, row - ox * 4, keep);
+        }
+    }
+    e.area = next;
+    e.base_x = lv_obj_get_scroll_x(e.obj);
+    e.base_y = lv_obj_get_scroll_y(e.obj);
+    auto strip = [&](int32_t x1, int32_t y1, int32_t x2, int32_t y2) {
+        const lv_area_t s{next.x1 + x1, next.y1 + y1, next.x1 + x2, next.y1 + y2};
+        render(e, s);
+        ++t.stats.strips;
+        t.stats.strip_pixels += lv_area_get_size(&s);
+    };
+    if (oy > 0) strip(0, 0, w - 1, oy - 1);
+    if (oy < 0) strip(0, h + oy, w - 1, h - 1);
+    // Columns only over the rows the vertical strips did not cover
+    const int32_t ry1 = oy > 0 ? oy : 0;
+    const int32_t ry2 = oy < 0 ? h + oy - 1 : h - 1;
+    if (ox > 0 && ry1 <= ry2) strip(0, ry1, ox - 1, ry2);
+    if (ox < 0 && ry1 <= ry2) strip(w + ox, ry1, w - 1, ry2);
+}
+
+inline void drop(Entry& e) noexcept {
+    if (!e.valid) return;
+    e.valid = false;
+    ++tables().stats.drops;
+}
+
+/// Blit the bitmap after the object's own drawing and skip the children
+inline void draw_main_end_cb(lv_event_t* ev) noexcept {
+    Entry* e = find(static_cast<lv_obj_t*>(lv_event_get_current_target(ev)));
+    if (!e || !e->valid || !e->obj->spec_attr) return;
+    const lv_area_t a = current_area(*e);
+    if (!lv_area_is_in(&e->obj->coords, &a, 0)) return;   // recentre() missed a step: draw live
+    lv_layer_t* layer = lv_event_get_layer(ev);
+    const lv_area_t clip = layer->_clip_area;
+    lv_area_t inner;
+    if (lv_area_intersect(&inner, &clip, &e->obj->coords)) {   // children are clipped to the coords
+        layer->_clip_area = inner;
+        lv_draw_image_dsc_t img;
+        lv_draw_image_dsc_init(&img);
+        img.src = e->buf;
+        lv_draw_image(layer, &img, &a);
+        layer->_clip_area = clip;
+    }
+    e->child_cnt = e->obj->spec_attr->child_cnt;
+    e->obj->spec_attr->child_cnt = 0;
+    e->substituted = true;
+    ++tables().stats.cached_draws;
+}
+
+inline void draw_post_begin_cb(lv_event_t* ev) noexcept {
+    Entry* e = find(static_cast<lv_obj_t*>(lv_event_get_current_target(ev)));
+    if (!e || !e->substituted) return;
+    e->obj->spec_attr->child_cnt = e->child_cnt;
+    e->substituted = false;
+}
+
+inline void scrolled(Entry& e) noexcept {
+    const uint32_t now = lv_tick_get();
+    if (!e.scrolling) {
+        e.scrolling = true;
+        e.scroll_start = now;
+        wake();
+    }
+    e.last_scroll = now;
+    if (!e.cfg.cache || now - e.scroll_start < e.cfg.capture_delay_ms) return;
+    if (!e.valid) {
+        (void)capture(e);
+        return;
+    }
+    const lv_area_t a = current_area(e);
+    if (!lv_area_is_in(&e.obj->coords, &a, 0)) recentre(e, a);
+}
+
+#else
+
+inline void free_buf(Entry& e) noexcept { e.valid = false; }
+inline void drop(Entry&) noexcept {}
+
+inline void scrolled(Entry& e) noexcept {
+    e.scrolling = true;
+    e.last_scroll = lv_tick_get();
+}
+
+#endif // LV_USE_SNAPSHOT
+
+// ==================== Events and timer ====================
+
+inline void scroll_cb(lv_event_t* ev) noexcept {
+    Entry* e = find(static_cast<lv_obj_t*>(lv_event_get_current_target(ev)));
+    if (!e) return;
+    lv_indev_t* indev = lv_indev_active();
+    const bool dragged = indev && lv_indev_get_scroll_obj(indev) == e->obj &&
+                         lv_indev_get_state(indev) == LV_INDEV_STATE_PRESSED;
+    if (lv_event_get_code(ev) == LV_EVENT_SCROLL) {
+        if (dragged && e->cfg.fling) {
+            if (!e->tracking) e->sample_count = 0;
+            e->tracking = true;
+            e->flinging = false;
+            Sample& s = e->samples[e->sample_count++ % kSamples];
+            s.tick = lv_tick_get();
+            lv_indev_get_point(indev, &s.p);
+        }
+        scrolled(*e);
+    } else if (e->tracking && !dragged) {    // SCROLL_END after the release
+        e->tracking = false;
+        float vx, vy;
+        velocity(*e, vx, vy);
+        start_fling(*e, vx, vy);
+    }
+}
+
+inline void change_cb(lv_event_t* ev) noexcept {
+    if (Entry* e = find(static_cast<lv_obj_t*>(lv_event_get_current_target(ev)))) drop(*e);
+}
+
+inline void timer_cb(lv_timer_t* timer) noexcept {
+    bool busy = false;
+    for (Entry& e : tables().entries) {
+        if (!e.obj) continue;
+        if (e.flinging) step_fling(e);
+        if (e.scrolling && !e.flinging && !e.tracking && lv_tick_elaps(e.last_scroll) >= e.cfg.idle_ms) {
+            e.scrolling = false;
+            if (e.valid) lv_obj_invalidate(e.obj);    // back to live children
+            free_buf(e);
+        }
+        busy = busy || e.flinging || e.scrolling;
+    }
+    if (!busy) lv_timer_pause(timer);
+}
+
+inline void release(Entry& e, bool deleting) noexcept {
+    if (!deleting) {
+        lv_obj_remove_event_cb(e.obj, &scroll_cb);
+        lv_obj_remove_event_cb(e.obj, &change_cb);
+#if LV_USE_SNAPSHOT
+        lv_obj_remove_event_cb(e.obj, &draw_main_end_cb);
+        lv_obj_remove_event_cb(e.obj, &draw_post_begin_cb);
+#endif
+        if (e.had_momentum) lv_obj_add_flag(e.obj, LV_OBJ_FLAG_SCROLL_MOMENTUM);
+        if (e.valid) lv_obj_invalidate(e.obj);
+    }
+    free_buf(e);
+    e = Entry{};
+}
+
+inline void delete_cb(lv_event_t* ev) noexcept {
+    if (Entry* e = find(static_cast<lv_obj_t*>(lv_event_get_current_target(ev)))) release(*e, true);
+}
+
+} // namespace detail
+
+/**
+ * @brief Fling `obj` from the pointer samples and cache its content while it scrolls
+ *
+ * Enabling again applies a new configuration.
+ *
+ * @return false if all LV_CPP_KINETIC_SCROLL_OBJECTS slots are in use
+ */
+inline bool enable(ObjectView obj, const KineticConfig& cfg = {}) noexcept {
+    lv_obj_t* o = obj.get();
+    if (!o) return false;
+    detail::Tables& t = detail::tables();
+    detail::Entry* e = detail::find(o);
+    if (!e) {
+        e = detail::find(nullptr);
+        if (!e) {
+            LV_LOG_WARN("kinetic scroll objects exhausted, raise LV_CPP_KINETIC_SCROLL_OBJECTS");
+            return false;
+        }
+        e->obj = o;
+        e->had_momentum = lv_obj_has_flag(o, LV_OBJ_FLAG_SCROLL_MOMENTUM);
+        lv_obj_add_event_cb(o, &detail::scroll_cb, LV_EVENT_SCROLL, nullptr);
+        lv_obj_add_event_cb(o, &detail::scroll_cb, LV_EVENT_SCROLL_END, nullptr);
+        lv_obj_add_event_cb(o, &detail::change_cb, LV_EVENT_STYLE_CHANGED, nullptr);
+        lv_obj_add_event_cb(o, &detail::change_cb, LV_EVENT_SIZE_CHANGED, nullptr);
+        lv_obj_add_event_cb(o, &detail::change_cb, LV_EVENT_CHILD_CHANGED, nullptr);
+        lv_obj_add_event_cb(o, &detail::change_cb, LV_EVENT_CHILD_CREATED, nullptr);
+        lv_obj_add_event_cb(o, &detail::change_cb, LV_EVENT_CHILD_DELETED, nullptr);
+#if LV_USE_SNAPSHOT
+        lv_obj_add_event_cb(o, &detail::draw_main_end_cb, LV_EVENT_DRAW_MAIN_END, nullptr);
+        lv_obj_add_event_cb(o, &detail::draw_post_begin_cb,
+                            static_cast<lv_event_code_t>(LV_EVENT_DRAW_POST_BEGIN | LV_EVENT_PREPROCESS), nullptr);
+#endif
+        lv_obj_add_event_cb(o, &detail::delete_cb, LV_EVENT_DELETE, nullptr);
+    }
+    e->cfg = cfg;
+    if (cfg.fling) lv_obj_remove_flag(o, LV_OBJ_FLAG_SCROLL_MOMENTUM);
+    else if (e->had_momentum) lv_obj_add_flag(o, LV_OBJ_FLAG_SCROLL_MOMENTUM);
+    if (!cfg.cache) detail::free_buf(*e);
+    if (!t.timer) {
+        t.timer = lv_timer_create(&detail::timer_cb, LV_DEF_REFR_PERIOD, nullptr);
+        lv_timer_pause(t.timer);
+    }
+    return true;
+}
+
+/// Back to LVGL's own scrolling; the bitmap is freed
+inline void disable(ObjectView obj) noexcept {
+    detail::Entry* e = obj.get() ? detail::find(obj.get()) : nullptr;
+    if (!e) return;
+    lv_obj_remove_event_cb(e->obj, &detail::delete_cb);
+    detail::release(*e, false);
+}
+
+[[nodiscard]] inline bool enabled(ObjectView obj) noexcept {
+    return obj.get() && detail::find(obj.get());
+}
+
+/// Start a fling of `obj` at (vx, vy) px/s in the direction the content moves
+inline void fling(ObjectView obj, float vx, float vy) noexcept {
+    if (detail::Entry* e = obj.get() ? detail::find(obj.get()) : nullptr) detail::start_fling(*e, vx, vy);
+}
+
+/// Stop a running fling where it is
+inline void stop(ObjectView obj) noexcept {
+    if (detail::Entry* e = obj.get() ? detail::find(obj.get()) : nullptr) e->flinging = false;
+}
+
+[[nodiscard]] inline bool flinging(ObjectView obj) noexcept {
+    const detail::Entry* e = obj.get() ? detail::find(obj.get()) : nullptr;
+    return e && e->flinging;
+}
+
+/// Re-render the cached content on the next scroll step (rows changed without an event)
+inline void invalidate(ObjectView obj) noexcept {
+    detail::Entry* e = obj.get() ? detail::find(obj.get()) : nullptr;
+    if (!e || !e->valid) return;
+    detail::drop(*e);
+    lv_obj_invalidate(e->obj);
+}
+
+[[nodiscard]] inline Stats stats() noexcept { return detail::tables().stats; }
+
+/// Zero the counters (bytes held are kept)
+inline void reset_stats() noexcept {
+    Stats& s = detail::tables().stats;
+    const uint32_t bytes = s.bytes;
+    s = Stats{};
+    s.bytes = bytes;
+}
+
+} // namespace kinetic_scroll
+
+} // namespace lv
@@ -0,0 +1,321 @@
+#pragma once
+
+/**
+ * @file lazy_asset.hpp
+ * @brief Fonts and images that load on first use instead of at startup
+ *
+ * A FreeType/TinyTTF font parses its file when it is created, so a demo
+ * that creates every font up front pays for screens that may never open.
+ * LazyFont is an lv_font_t proxy: it can be given to styles right away
+ * (it converts to const lv_font_t*), and the real font is created the
+ * first time LVGL asks the proxy for a glyph, i.e. when a text using it
+ * is first measured or drawn. prefetch() loads it ahead, and so does
+ * lv::prefetch::glyphs(lazy, ...) at idle time.
+ *
+ * @code
+ * static lv::LazyFont title("A:fonts/inter_bold.ttf", 28);
+ * static lv::LazyFont cjk("A:fonts/noto_sc.ttf", 20);       // only if the user picks Chinese
+ * static lv::LazyImage map("A:img/map.bin");
+ *
+ * heading.text_font(title);                                  // nothing loaded yet
+ * map.apply(lv_image_create(stats_screen));                  // loads when stats_screen starts loading
+ * lv::prefetch::glyphs(cjk, 0x4E00, 0x4E40);                 // or cjk.prefetch()
+ * @endcode
+ *
+ * Until it is loaded the proxy reports an estimated line height (the
+ * `line_height` hint, else 5/4 of the size). If the real metrics differ,
+ * styles are refreshed once afterwards so layouts pick them up; give the
+ * exact hint, or prefetch() before the screen is built, to avoid the
+ * relayout. A font that fails to load draws with its fallback.
+ *
+ * LazyImage does the same for image sources: src() loads on first call,
+ * apply(img) sets the source when the image's screen is (or starts being)
+ * loaded. Both record their load time in lv::startup as a Span named
+ * after the asset.
+ *
+ * Loading happens on the thread that first asks. With parallel draw units
+ * prefetch() from the UI thread before the first render to keep it there.
+ * Neither class is movable: LVGL keeps pointers to them.
+ *
+ * Heap allocation: NONE in the wrapper (LV_CPP_LAZY_IMAGE_BINDINGS pending
+ * apply() calls); the fonts and images themselves allocate as usual
+ */
+
+#include <lvgl.h>
+#include <cstdint>
+#include "font_loader.hpp"
+#include "mapped_file.hpp"
+#include "startup.hpp"
+
+#ifndef LV_CPP_LAZY_IMAGE_BINDINGS
+/// LazyImage::apply() calls waiting for their screen at once
+#define LV_CPP_LAZY_IMAGE_BINDINGS 16
+#endif
+
+namespace lv {
+
+/**
+ * @brief lv_font_t that creates the real font on first glyph lookup
+ */
+class LazyFont {
+public:
+    /// Creates the real font; nullptr on failure (it must stay valid while the LazyFont is used)
+    using Loader = const lv_font_t* (*)(void* user);
+
+private:
+    lv_font_t m_proxy{};              ///< What LVGL sees; user_data points back here
+    const lv_font_t* m_font = nullptr;
+    Loader m_loader = nullptr;
+    void* m_user = nullptr;
+    const char* m_name = nullptr;
+    const void* m_data = nullptr;     ///< Built-in loaders: path or TTF data
+    size_t m_data_size = 0;
+    int32_t m_size = 0;
+    bool m_tried = false;
+    const lv_font_t* m_fallback = nullptr;   ///< Set by fallback()
+    DynamicFont m_owned;
+
+    [[nodiscard]] static LazyFont* self(const lv_font_t* f) noexcept {
+        return static_cast<LazyFont*>(f->user_data);
+    }
+
+    static bool glyph_dsc_cb(const lv_font_t* f, lv_font_glyph_dsc_t* g, uint32_t letter, uint32_t next) {
+        const lv_font_t* real = self(f)->resolve();
+        if (!real || !real->get_glyph_dsc) return false;
+        return real->get_glyph_dsc(real, g, letter, real->kerning == LV_FONT_KERNING_NONE ? 0 : next);
+    }
+
+    // LVGL sets resolved_font to the proxy; the real font needs itself there
+    static const void* glyph_bitmap_cb(lv_font_glyph_dsc_t* g, lv_draw_buf_t* buf) {
+        const lv_font_t* proxy = g->resolved_font;
+        const lv_font_t* real = self(proxy)->m_font;
+        if (!real || !real->get_glyph_bitmap) return nullptr;
+        g->resolved_font = real;
+        const void* bitmap = real->get_glyph_bitmap(g, buf);
+        g->resolved_font = proxy;
+        return bitmap;
+    }
+
+    static void release_glyph_cb(const lv_font_t* f, lv_font_glyph_dsc_t* g) {
+        const lv_font_t* real = self(f)->m_font;
+        if (!real || !real->release_glyph) return;
+        g->resolved_font = real;
+        real->release_glyph(real, g);
+        g->resolved_font = f;
+    }
+
+    static const lv_font_t* load_file(void* user) noexcept {
+        auto* lf = static_cast<LazyFont*>(user);
+        return lf->m_owned.load_from_file(static_cast<const char*>(lf->m_data), lf->m_size) ? lf->m_owned.get() : nullptr;
+    }
+
+    static const lv_font_t* load_memory(void* user) noexcept {
+        auto* lf = static_cast<LazyFont*>(user);
+        return lf->m_owned.load_from_memory(lf->m_data, lf->m_data_size, lf->m_size) ? lf->m_owned.get() : nullptr;
+    }
+
+    void init(int32_t size, int32_t line_height) noexcept {
+        m_size = size;
+        m_proxy.get_glyph_dsc = &glyph_dsc_cb;
+        m_proxy.get_glyph_bitmap = &glyph_bitmap_cb;
+        m_proxy.release_glyph = &release_glyph_cb;
+        m_proxy.line_height = line_height > 0 ? line_height : size * 5 / 4;
+        m_proxy.base_line = m_proxy.line_height / 5;
+        m_proxy.kerning = LV_FONT_KERNING_NORMAL;
+        m_proxy.fallback = lv_font_get_default();
+        m_proxy.user_data = this;
+    }
+
+public:
+    /// TTF/OTF file through DynamicFont (FreeType or TinyTTF)
+    LazyFont(const char* path, int32_t size, int32_t line_height = 0) noexcept
+        : m_loader(&load_file), m_user(this), m_name(path), m_data(path) {
+        init(size, line_height);
+    }
+
+    /// TTF/OTF data in memory (TinyTTF); `data` must outlive the font
+    LazyFont(const void* data, size_t data_size, int32_t size, const char* name, int32_t line_height = 0) noexcept
+        : m_loader(&load_memory), m_user(this), m_name(name), m_data(data), m_data_size(data_size) {
+        init(size, line_height);
+    }
+
+    /// Any font source (MappedFont, FontPack, AssetPack...): `loader(user)` runs once
+    LazyFont(Loader loader, void* user, int32_t size, const char* name, int32_t line_height = 0) noexcept
+        : m_loader(loader), m_user(user), m_name(name) {
+        init(size, line_height);
+    }
+
+    LazyFont(const LazyFont&) = delete;
+    LazyFont& operator=(const LazyFont&) = delete;
+
+    /// Font to give to styles and widgets (the proxy)
+    [[nodiscard]] const lv_font_t* get() const noexcept { return &m_proxy; }
+    operator const lv_font_t*() const noexcept { return &m_proxy; }
+
+    /**
+     * @brief The real font, loading it now if needed
+     * @return nullptr if loading failed
+     */
+    const lv_font_t* resolve() noexcept {
+        if (m_tried) return m_font;
+        m_tried = true;
+        const int32_t line_height = m_proxy.line_height;
+        const int32_t base_line = m_proxy.base_line;
+        {
+            startup::Span span(m_name ? m_name : "LazyFont");
+            m_font = m_loader ? m_loader(m_user) : nullptr;
+        }
+        if (!m_font) {
+            LV_LOG_WARN("LazyFont: %s failed to load, using the fallback", m_name ? m_name : "?");
+            return nullptr;
+        }
+        m_proxy.line_height = m_font->line_height;
+        m_proxy.base_line = m_font->base_line;
+        m_proxy.subpx = m_font->subpx;
+        m_proxy.underline_position = m_font->underline_position;
+        m_proxy.underline_thickness = m_font->underline_thickness;
+        m_proxy.fallback = m_fallback ? m_fallback : m_font->fallback;
+        if (line_height != m_font->line_height || base_line != m_font->base_line) {
+            // Layouts measured with the estimate; redo them outside the measuring/drawing code
+            lv_async_call([](void*) { lv_obj_report_style_change(nullptr); }, nullptr);
+        }
+        return m_font;
+    }
+
+    /// Load now (e.g. while a splash or transition is showing)
+    void prefetch() noexcept { resolve(); }
+
+    [[nodiscard]] bool loaded() const noexcept { return m_font != nullptr; }
+
+    /// Font used for letters the real font lacks, or instead of it if loading fails
+    LazyFont& fallback(const lv_font_t* font) noexcept {
+        m_fallback = font;
+        m_proxy.fallback = font;
+        return *this;
+    }
+};
+
+class LazyImage;
+
+namespace detail::lazy_image {
+
+struct Binding {
+    lv_obj_t* image = nullptr;
+    lv_obj_t* screen = nullptr;
+    LazyImage* lazy = nullptr;
+};
+
+[[nodiscard]] inline Binding* bindings() noexcept {
+    static Binding table[LV_CPP_LAZY_IMAGE_BINDINGS];
+    return table;
+}
+
+inline void screen_load_cb(lv_event_t* e);
+
+inline void image_delete_cb(lv_event_t* e);
+
+} // namespace detail::lazy_image
+
+/**
+ * @brief Image source that is loaded on first use
+ */
+class LazyImage {
+public:
+    /// Produces the image source (descriptor or path); nullptr on failure
+    using Loader = const void* (*)(void* user);
+
+private:
+    Loader m_loader = nullptr;
+    void* m_user = nullptr;
+    const char* m_name = nullptr;
+    const void* m_src = nullptr;
+    bool m_tried = false;
+    MappedImage m_mapped;
+
+    static const void* load_mapped(void* user) noexcept {
+        auto* li = static_cast<LazyImage*>(user);
+        return li->m_mapped.open(li->m_name) ? li->m_mapped.src() : nullptr;
+    }
+
+public:
+    /// LVGL .bin image, mapped with MappedImage on first use
+    explicit LazyImage(const char* path) noexcept : m_loader(&load_mapped), m_user(this), m_name(path) {}
+
+    /// Any source (AssetPack::image(), a decoded DrawBuf...): `loader(user)` runs once
+    LazyImage(Loader loader, void* user, const char* name) noexcept : m_loader(loader), m_user(user), m_name(name) {}
+
+    ~LazyImage() {
+        detail::lazy_image::Binding* b = detail::lazy_image::bindings();
+        for (uint32_t i = 0; i < LV_CPP_LAZY_IMAGE_BINDINGS; ++i) {
+            if (b[i].lazy != this) continue;
+            lv_obj_remove_event_cb_with_user_data(b[i].screen, &detail::lazy_image::screen_load_cb, &b[i]);
+            lv_obj_remove_event_cb_with_user_data(b[i].image, &detail::lazy_image::image_delete_cb, &b[i]);
+            b[i] = {};
+        }
+    }
+
+    LazyImage(const LazyImage&) = delete;
+    LazyImage& operator=(const LazyImage&) = delete;
+
+    /// Image source, loading it now if needed (nullptr if loading failed)
+    [[nodiscard]] const void* src() noexcept {
+        if (m_tried) return m_src;
+        m_tried = true;
+        {
+            startup::Span span(m_name ? m_name : "LazyImage");
+            m_src = m_loader ? m_loader(m_user) : nullptr;
+        }
+        if (!m_src) LV_LOG_WARN("LazyImage: %s failed to load", m_name ? m_name : "?");
+        return m_src;
+    }
+
+    void prefetch() noexcept { (void)src(); }
+
+    [[nodiscard]] bool loaded() const noexcept { return m_src != nullptr; }
+
+    /**
+     * @brief Set as the source of `image` once its screen is shown
+     *
+     * Loads now if already loaded or the screen is active; otherwise when
+     * the screen starts loading (LV_EVENT_SCREEN_LOAD_START).
+     */
+    void apply(lv_obj_t* image) noexcept {
+        if (!image) return;
+        lv_obj_t* screen = lv_obj_get_screen(image);
+        if (m_tried || screen == lv_display_get_screen_active(lv_obj_get_display(image))) {
+            if (const void* s = src()) lv_image_set_src(image, s);
+            return;
+        }
+        detail::lazy_image::Binding* b = detail::lazy_image::bindings();
+        for (uint32_t i = 0; i < LV_CPP_LAZY_IMAGE_BINDINGS; ++i) {
+            if (b[i].lazy) continue;
+            b[i] = {image, screen, this};
+            lv_obj_add_event_cb(screen, &detail::lazy_image::screen_load_cb, LV_EVENT_SCREEN_LOAD_START, &b[i]);
+            lv_obj_add_event_cb(image, &detail::lazy_image::image_delete_cb, LV_EVENT_DELETE, &b[i]);
+            return;
+        }
+        LV_LOG_WARN("LazyImage: bindings exhausted, raise LV_CPP_LAZY_IMAGE_BINDINGS");
+        if (const void* s = src()) lv_image_set_src(image, s);
+    }
+};
+
+namespace detail::lazy_image {
+
+inline void screen_load_cb(lv_event_t* e) {
+    auto* b = static_cast<Binding*>(lv_event_get_user_data(e));
+    Binding bound = *b;
+    *b = {};
+    lv_obj_remove_event_cb_with_user_data(bound.screen, &screen_load_cb, b);
+    lv_obj_remove_event_cb_with_user_data(bound.image, &image_delete_cb, b);
+    if (const void* s = bound.lazy->src()) lv_image_set_src(bound.image, s);
+}
+
+inline void image_delete_cb(lv_event_t* e) {
+    auto* b = static_cast<Binding*>(lv_event_get_user_data(e));
+    lv_obj_remove_event_cb_with_user_data(b->screen, &screen_load_cb, b);
+    *b = {};
+}
+
+} // namespace detail::lazy_image
+
+} // namespace lv
@@ -0,0 +1,229 @@
+#pragma once
+
+/**
+ * @file lazy_page.hpp
+ * @brief Deferred construction of Tabview/Tileview pages
+ *
+ * Tabview::add_tab_lazy() and Tileview::add_tile_lazy() create the empty
+ * page right away but mount its Component only when the page becomes
+ * visible: when it is selected, or when scrolling/swiping brings it into
+ * the viewport. During idle time (lv_timer_get_idle() at least
+ * LV_CPP_LAZY_PRELOAD_IDLE percent) one neighbor of the active page is
+ * mounted per timer period, so the next swipe shows a built page.
+ * Optionally a page that stayed hidden (and is not a neighbor of the
+ * active page) for `unmount_after_ms` is unmounted again.
+ *
+ * Usage:
+ * @code
+ * class MainScreen {
+ *     StatusPage m_status;        // lv::Component<StatusPage>
+ *     SettingsPage m_settings;    // must outlive the tabview pages
+ *     lv::Tabview m_tabs;
+ * public:
+ *     void build(lv::ObjectView parent) {
+ *         m_tabs = lv::Tabview::create(parent);
+ *         m_tabs.add_tab_lazy("Status", m_status);             // active tab: mounted now
+ *         m_tabs.add_tab_lazy("Settings", m_settings, 30000);  // unmount after 30 s hidden
+ *     }
+ * };
+ * @endcode
+ *
+ * Heap allocation: NONE (LV_CPP_MAX_LAZY_PAGES fixed slots, one shared lv_timer)
+ */
+
+#include <lvgl.h>
+#include <cstdint>
+#include "object.hpp"
+
+namespace lv {
+
+#ifndef LV_CPP_MAX_LAZY_PAGES
+/// Maximum number of lazy pages alive at once (all views)
+#define LV_CPP_MAX_LAZY_PAGES 16
+#endif
+
+#ifndef LV_CPP_LAZY_PAGE_PERIOD
+/// Period of the preload/unmount timer in milliseconds
+#define LV_CPP_LAZY_PAGE_PERIOD 250
+#endif
+
+#ifndef LV_CPP_LAZY_PRELOAD_IDLE
+/// Minimum lv_timer_get_idle() percentage for preloading a neighbor page
+#define LV_CPP_LAZY_PRELOAD_IDLE 50
+#endif
+
+namespace detail {
+
+/// Type-erased Component operations of a lazy page
+struct LazyPageOps {
+    void (*mount)(void* component, lv_obj_t* page);
+    void (*unmount)(void* component);
+    bool (*mounted)(const void* component);
+};
+
+template<typename C>
+inline constexpr LazyPageOps lazy_page_ops{
+    [](void* c, lv_obj_t* page) { static_cast<C*>(c)->mount(ObjectView(page)); },
+    [](void* c) { static_cast<C*>(c)->unmount(); },
+    [](const void* c) { return static_cast<const C*>(c)->is_mounted(); },
+};
+
+/// How a view reports its active page and which pages are next to each other
+struct LazyViewOps {
+    lv_obj_t* (*active)(lv_obj_t* view);
+    lv_obj_t* (*scroller)(lv_obj_t* view);
+    bool (*adjacent)(lv_obj_t* view, lv_obj_t* a, lv_obj_t* b);
+};
+
+struct LazyPage {
+    lv_obj_t* page = nullptr;          ///< nullptr: free slot
+    lv_obj_t* view = nullptr;
+    const LazyViewOps* view_ops = nullptr;
+    void* component = nullptr;
+    const LazyPageOps* ops = nullptr;
+    uint32_t unmount_after_ms = 0;     ///< 0: stay mounted once built
+    uint32_t hidden_since = 0;
+    bool hidden = true;
+};
+
+struct LazyPages {
+    LazyPage pages[LV_CPP_MAX_LAZY_PAGES];
+    lv_timer_t* timer = nullptr;
+};
+
+[[nodiscard]] inline LazyPages& lazy_pages() noexcept {
+    static LazyPages pages;
+    return pages;
+}
+
+inline void lazy_mount(LazyPage& p) {
+    if (!p.ops->mounted(p.component)) p.ops->mount(p.component, p.page);
+    p.hidden = false;
+}
+
+/// Page overlaps the scroll container's visible area
+[[nodiscard]] inline bool lazy_in_viewport(const LazyPage& p) noexcept {
+    lv_area_t page;
+    lv_area_t view;
+    lv_obj_get_coords(p.page, &page);
+    lv_obj_get_coords(p.view_ops->scroller(p.view), &view);
+    return page.x1 <= view.x2 && page.x2 >= view.x1 && page.y1 <= view.y2 && page.y2 >= view.y1;
+}
+
+/// VALUE_CHANGED on the view: mount the newly active page
+inline void lazy_view_changed_cb(lv_event_t* e) {
+    lv_obj_t* view = lv_event_get_current_target_obj(e);
+    for (LazyPage& p : lazy_pages().pages) {
+        if (p.page && p.view == view && p.page == p.view_ops->active(view)) lazy_mount(p);
+    }
+}
+
+/// SCROLL on the scroll container: mount pages sliding into view
+inline void lazy_scroll_cb(lv_event_t* e) {
+    lv_obj_t* scroller = lv_event_get_current_target_obj(e);
+    for (LazyPage& p : lazy_pages().pages) {
+        if (!p.page || p.view_ops->scroller(p.view) != scroller) continue;
+        if (!p.ops->mounted(p.component) && lazy_in_viewport(p)) lazy_mount(p);
+    }
+}
+
+inline void lazy_page_delete_cb(lv_event_t* e) noexcept {
+    LazyPages& all = lazy_pages();
+    lv_obj_t* page = lv_event_get_current_target_obj(e);
+    bool any = false;
+    for (LazyPage& p : all.pages) {
+        if (p.page == page) p = LazyPage{};
+        any |= p.page != nullptr;
+    }
+    if (!any && all.timer) {
+        lv_timer_delete(all.timer);
+        all.timer = nullptr;
+    }
+}
+
+/// Periodic pass: preload one neighbor when idle, unmount pages hidden for too long
+inline void lazy_timer_cb(lv_timer_t*) {
+    bool preloaded = lv_timer_get_idle() < LV_CPP_LAZY_PRELOAD_IDLE;
+    for (LazyPage& p : lazy_pages().pages) {
+        if (!p.page) continue;
+        lv_obj_t* active = p.view_ops->active(p.view);
+        const bool mounted = p.ops->mounted(p.component);
+        if (p.page == active) {
+            if (!mounted) lazy_mount(p);
+            p.hidden = false;
+            continue;
+        }
+        const bool neighbor = active && p.view_ops->adjacent(p.view, p.page, active);
+        if (!mounted) {
+            if (neighbor && !preloaded) {
+                lazy_mount(p);
+                preloaded = true;
+            }
+            continue;
+        }
+        if (neighbor || lazy_in_viewport(p)) {
+            p.hidden = false;
+            continue;
+        }
+        if (!p.hidden) {
+            p.hidden = true;
+            p.hidden_since = lv_tick_get();
+        } else if (p.unmount_after_ms && lv_tick_elaps(p.hidden_since) >= p.unmount_after_ms) {
+            p.ops->unmount(p.component);
+        }
+    }
+}
+
+/// Install the view/scroller hooks once per object (remove first, then add)
+inline void lazy_hook(lv_obj_t* obj, lv_event_cb_t cb, lv_event_code_t code) noexcept {
+    lv_obj_remove_event_cb(obj, cb);
+    lv_obj_add_event_cb(obj, cb, code, nullptr);
+}
+
+} // namespace detail
+
+/**
+ * @brief Register `component` to be mounted into `page` on demand
+ *
+ * Used by Tabview::add_tab_lazy() and Tileview::add_tile_lazy(). If the
+ * page is already the active one it is mounted immediately. When all
+ * LV_CPP_MAX_LAZY_PAGES slots are taken the component is mounted eagerly.
+ *
+ * @return true if the page is lazy, false if it was mounted eagerly
+ */
+template<typename C>
+bool lazy_page(lv_obj_t* view, const detail::LazyViewOps& view_ops, lv_obj_t* page,
+               C& component, uint32_t unmount_after_ms = 0) {
+    detail::LazyPages& all = detail::lazy_pages();
+    detail::LazyPage* slot = nullptr;
+    for (detail::LazyPage& p : all.pages) {
+        if (!p.page) {
+            slot = &p;
+            break;
+        }
+    }
+    if (!slot) {
+        LV_LOG_WARN("lazy page slots exhausted, raise LV_CPP_MAX_LAZY_PAGES");
+        component.mount(ObjectView(page));
+        return false;
+    }
+    *slot = detail::LazyPage{page, view, &view_ops, &component, &detail::lazy_page_ops<C>,
+                             unmount_after_ms, 0, true};
+    lv_obj_add_event_cb(page, &detail::lazy_page_delete_cb, LV_EVENT_DELETE, nullptr);
+    detail::lazy_hook(view, &detail::lazy_view_changed_cb, LV_EVENT_VALUE_CHANGED);
+    detail::lazy_hook(view_ops.scroller(view), &detail::lazy_scroll_cb, LV_EVENT_SCROLL);
+    if (!all.timer) all.timer = lv_timer_create(&detail::lazy_timer_cb, LV_CPP_LAZY_PAGE_PERIOD, nullptr);
+    if (page == view_ops.active(view)) detail::lazy_mount(*slot);
+    return true;
+}
+
+/// Number of lazy pages whose component is currently mounted
+[[nodiscard]] inline uint32_t lazy_pages_mounted() noexcept {
+    uint32_t n = 0;
+    for (const detail::LazyPage& p : detail::lazy_pages().pages) {
+        n += p.page && p.ops->mounted(p.component);
+    }
+    return n;
+}
+
+} // namespace lv
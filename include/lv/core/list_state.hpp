@@ -0,0 +1,244 @@
+#pragma once
+
+/**
+ * @file list_state.hpp
+ * @brief Fixed-capacity reactive list with per-row change notifications
+ *
+ * State<T> notifies "the value changed"; a list bound that way has to be
+ * rebuilt completely. ListState<T, Capacity> instead tells observers what
+ * changed (insert/remove/update/move at an index), so widgets can patch
+ * only the affected rows.
+ *
+ * Notifications go through an embedded lv_subject_t, so observers can be
+ * tied to object lifetimes like any other LVGL observer. A newly added
+ * observer first receives a `reset` change and should build all rows.
+ *
+ * Usage:
+ * @code
+ * struct Alarm { uint32_t id; uint8_t severity; };
+ * lv::ListState<Alarm, 2048> alarms;
+ *
+ * class AlarmTable {
+ *     lv::Table m_table;
+ *     void on_alarms(const lv::ListChange& c) {
+ *         switch (c.op) {
+ *         case lv::ListOp::update: write_row(c.index); break;
+ *         case lv::ListOp::reset:  rebuild(); break;
+ *         default:                 shift_rows(c); break;
+ *         }
+ *     }
+ * };
+ * alarms.observe<&AlarmTable::on_alarms>(&table);
+ *
+ * alarms.push_back({42, 3});   // observers get {insert, index = size-1}
+ * alarms.set(0, {42, 1});      // observers get {update, index = 0}
+ * @endcode
+ */
+
+#include <lvgl.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include "subscription.hpp"
+
+#if LV_USE_OBSERVER
+
+namespace lv {
+
+/// Kind of change reported by ListState
+enum class ListOp : uint8_t {
+    reset,    ///< Contents replaced; rebuild everything
+    insert,   ///< `count` items inserted at `index`
+    remove,   ///< `count` items removed at `index`
+    update,   ///< Item at `index` changed in place
+    move,     ///< Item moved from `index` to `to`
+};
+
+/// One change notification (valid only during the observer callback)
+struct ListChange {
+    ListOp op = ListOp::reset;
+    uint32_t index = 0;
+    uint32_t to = 0;       ///< Destination index (move only)
+    uint32_t count = 0;    ///< Number of items (insert/remove); list size for reset
+};
+
+/**
+ * @brief Reactive list of up to Capacity items (stack-allocated)
+ *
+ * Mutators return false instead of asserting when an index is out of range
+ * or the list is full. Items are stored inline; insert/remove shift with
+ * memmove, so T must be trivially copyable (like State<T>).
+ *
+ * Heap allocation: NONE
+ *
+ * @tparam T Item type
+ * @tparam Capacity Maximum number of items
+ */
+template<typename T, size_t Capacity>
+class ListState {
+    static_assert(std::is_trivially_copyable_v<T>,
+        "ListState<T> requires trivially copyable items");
+    static_assert(Capacity > 0 && Capacity <= UINT32_MAX, "ListState capacity out of range");
+
+private:
+    lv_subject_t m_subject;
+    ListChange m_change;
+    uint32_t m_size = 0;
+    T m_items[Capacity];
+
+    void emit(ListOp op, uint32_t index, uint32_t count = 1, uint32_t to = 0) noexcept {
+        m_change = ListChange{op, index, to, count};
+        lv_subject_notify(&m_subject);
+        // Observers added later are notified immediately: they must see a reset
+        m_change = ListChange{ListOp::reset, 0, 0, m_size};
+    }
+
+public:
+    ListState() noexcept {
+        lv_subject_init_pointer(&m_subject, &m_change);
+    }
+
+    ~ListState() noexcept {
+        detail::release_hub(&m_subject);
+        lv_subject_deinit(&m_subject);
+    }
+
+    // Non-copyable, non-movable (observers hold the subject address)
+    ListState(const ListState&) = delete;
+    ListState& operator=(const ListState&) = delete;
+    ListState(ListState&&) = delete;
+    ListState& operator=(ListState&&) = delete;
+
+    // ==================== Accessors ====================
+
+    [[nodiscard]] uint32_t size() const noexcept { return m_size; }
+    [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+    [[nodiscard]] bool full() const noexcept { return m_size == Capacity; }
+    [[nodiscard]] static constexpr size_t capacity() noexcept { return Capacity; }
+
+    /// Item at index (unchecked; use set() to modify)
+    [[nodiscard]] const T& operator[](uint32_t i) const noexcept { return m_items[i]; }
+
+    [[nodiscard]] const T* begin() const noexcept { return m_items; }
+    [[nodiscard]] const T* end() const noexcept { return m_items + m_size; }
+    [[nodiscard]] const T* data() const noexcept { return m_items; }
+
+    // ==================== Mutators ====================
+
+    /// Insert at index (index == size() appends)
+    bool insert(uint32_t index, const T& item) noexcept {
+        if (index > m_size || full()) return false;
+        std::memmove(&m_items[index + 1], &m_items[index], (m_size - index) * sizeof(T));
+        m_items[index] = item;
+        ++m_size;
+        emit(ListOp::insert, index);
+        return true;
+    }
+
+    /// Append to the end
+    bool push_back(const T& item) noexcept {
+        return insert(m_size, item);
+    }
+
+    /// Remove `count` items starting at index
+    bool erase(uint32_t index, uint32_t count = 1) noexcept {
+        if (count == 0 || index >= m_size || count > m_size - index) return false;
+        std::memmove(&m_items[index], &m_items[index + count],
+                     (m_size - index - count) * sizeof(T));
+        m_size -= count;
+        emit(ListOp::remove, index, count);
+        return true;
+    }
+
+    /// Replace the item at index
+    bool set(uint32_t index, const T& item) noexcept {
+        if (index >= m_size) return false;
+        m_items[index] = item;
+        emit(ListOp::update, index);
+        return true;
+    }
+
+    /**
+     * @brief Modify the item at index in place and report an update
+     *
+     * @param fn Called as fn(T&)
+     */
+    template<typename F>
+    bool update(uint32_t index, F&& fn) noexcept {
+        if (index >= m_size) return false;
+        fn(m_items[index]);
+        emit(ListOp::update, index);
+        return true;
+    }
+
+    /// Move an item so it ends up at index `to` (indices refer to the list before the move)
+    bool move(uint32_t from, uint32_t to) noexcept {
+        if (from >= m_size || to >= m_size) return false;
+        if (from == to) return true;
+        T item = m_items[from];
+        if (from < to) {
+            std::memmove(&m_items[from], &m_items[from + 1], (to - from) * sizeof(T));
+        } else {
+            std::memmove(&m_items[to + 1], &m_items[to], (from - to) * sizeof(T));
+        }
+        m_items[to] = item;
+        emit(ListOp::move, from, 1, to);
+        return true;
+    }
+
+    /// Replace all contents (truncated to Capacity) and report a reset
+    void assign(const T* items, size_t count) noexcept {
+        if (count > Capacity) count = Capacity;
+        if (count > 0) std::memcpy(m_items, items, count * sizeof(T));
+        m_size = static_cast<uint32_t>(count);
+        emit(ListOp::reset, 0, m_size);
+    }
+
+    /// Remove all items and report a reset
+    void clear() noexcept {
+        m_size = 0;
+        emit(ListOp::reset, 0, 0);
+    }
+
+    // ==================== LVGL Integration ====================
+
+    /// Underlying subject (pointer subject to the current ListChange)
+    [[nodiscard]] lv_subject_t* subject() noexcept {
+        return &m_subject;
+    }
+
+    /**
+     * @brief Add observer with member function callback void(const ListChange&)
+     *
+     * Called once immediately with a reset change, then once per mutation.
+     */
+    template<auto MemFn, typename Instance>
+        requires std::is_member_function_pointer_v<decltype(MemFn)>
+    lv_observer_t* observe(Instance* instance) noexcept {
+        return lv_subject_add_observer(&m_subject,
+            [](lv_observer_t* observer, lv_subject_t* subject) {
+                auto* inst = static_cast<Instance*>(lv_observer_get_user_data(observer));
+                (inst->*MemFn)(*static_cast<const ListChange*>(lv_subject_get_pointer(subject)));
+            }, instance);
+    }
+
+    /// Add observer with C-style callback (read the change with change_of())
+    lv_observer_t* observe_raw(lv_observer_cb_t cb, void* user_data = nullptr) noexcept {
+        return lv_subject_add_observer(&m_subject, cb, user_data);
+    }
+
+    /// Add observer tied to an LVGL object's lifecycle
+    lv_observer_t* observe_obj(lv_observer_cb_t cb, lv_obj_t* target_obj, void* user_data = nullptr) noexcept {
+        return lv_subject_add_observer_obj(&m_subject, cb, target_obj, user_data);
+    }
+
+    /// Get the change being delivered (for use in raw observer callbacks)
+    [[nodiscard]] static const ListChange& change_of(lv_subject_t* subject) noexcept {
+        return *static_cast<const ListChange*>(lv_subject_get_pointer(subject));
+    }
+};
+
+} // namespace lv
+
+#endif // LV_USE_OBSERVER
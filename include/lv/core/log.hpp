@@ -13,6 +13,30 @@
  *   });
  *   lv::log::info("value = %d", 42);
  *   lv::log::warn("something happened");
+ *
+ * To show the log on the device, see LogView::capture_log()
+ * (widgets/log_view.hpp).
+ *
+ * Levels below LV_CPP_LOG_LEVEL (default LVGL's LV_LOG_LEVEL) compile to
+ * nothing; only the argument expressions remain, and pure ones are
+ * optimized out.
+ *
+ * With LV_CPP_LOG_DEFERRED, a call copies the format pointer, the source
+ * location and its arguments into a lock-free ring (a Dispatcher; strings
+ * are copied up to LV_CPP_LOG_STR bytes) and returns. lv_log_add() then
+ * formats and prints them later from drain(), called by one thread only:
+ * a low-priority thread, or the idle time of lv::tick() after
+ * drain_in_idle(). Format strings must be literals (or outlive the ring).
+ * LVGL's own LV_LOG_* calls stay synchronous, and LV_LOG_USE_TIMESTAMP
+ * shows the time of printing.
+ *
+ * @code
+ * lv::log::drain_in_idle();                       // UI thread, once
+ * // or: std::thread([] { for (;;) { lv::log::drain(); lv::sleep_ms(20); } }).detach();
+ * @endcode
+ *
+ * Heap allocation: none (the deferred ring is a static of
+ * LV_CPP_LOG_QUEUE records of LV_CPP_LOG_RECORD bytes)
  */
 
 #include <lvgl.h>
@@ -20,6 +44,40 @@
 
 #if LV_USE_LOG
 
+#ifndef LV_CPP_LOG_LEVEL
+/// Lowest level compiled in; lv::log calls below it are removed
+#define LV_CPP_LOG_LEVEL LV_LOG_LEVEL
+#endif
+
+#ifndef LV_CPP_LOG_DEFERRED
+/// 1: lv::log calls queue their arguments, lv::log::drain() prints them
+#define LV_CPP_LOG_DEFERRED 0
+#endif
+
+#if LV_CPP_LOG_DEFERRED
+#include <atomic>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+#include "async.hpp"
+#include "app.hpp"
+
+#ifndef LV_CPP_LOG_QUEUE
+/// Deferred records queued at once (power of two); further calls are dropped and counted
+#define LV_CPP_LOG_QUEUE 256
+#endif
+
+#ifndef LV_CPP_LOG_RECORD
+/// Bytes per deferred record for the location and arguments
+#define LV_CPP_LOG_RECORD 96
+#endif
+
+#ifndef LV_CPP_LOG_STR
+/// String arguments of deferred records are copied up to this many bytes (including the terminator)
+#define LV_CPP_LOG_STR 32
+#endif
+#endif // LV_CPP_LOG_DEFERRED
+
 namespace lv::log {
 
 /// Log level constants
@@ -50,9 +108,13 @@ struct Fmt {
 
 namespace detail {
 
-/// Dispatch log call. Uses "%s" for no-arg calls to avoid -Wformat-security.
+/// Compile-time filter: LV_CPP_LOG_LEVEL and LVGL's own LV_LOG_LEVEL
+template<lv_log_level_t Lvl>
+inline constexpr bool enabled = Lvl >= LV_CPP_LOG_LEVEL && Lvl >= LV_LOG_LEVEL;
+
+/// Print now. Uses "%s" for no-arg calls to avoid -Wformat-security.
 template<typename... Args>
-inline void log_add(lv_log_level_t lvl, const Fmt& fmt, Args... args) noexcept {
+inline void log_now(lv_log_level_t lvl, const Fmt& fmt, Args... args) noexcept {
     if constexpr (sizeof...(Args) == 0) {
         lv_log_add(lvl, fmt.loc.file_name(), static_cast<int>(fmt.loc.line()),
                    fmt.loc.function_name(), "%s", fmt.str);
@@ -62,38 +124,170 @@ inline void log_add(lv_log_level_t lvl, const Fmt& fmt, Args... args) noexcept {
     }
 }
 
+#if LV_CPP_LOG_DEFERRED
+
+/// String argument copied into a deferred record
+struct LogStr {
+    char s[LV_CPP_LOG_STR];
+};
+
+template<typename T>
+[[nodiscard]] inline auto capture(T v) noexcept {
+    if constexpr (std::is_same_v<std::decay_t<T>, const char*> || std::is_same_v<std::decay_t<T>, char*>) {
+        LogStr copy;
+        const char* str = v ? v : "(null)";
+        const size_t n = std::strlen(str);
+        const size_t len = n < sizeof(copy.s) - 1 ? n : sizeof(copy.s) - 1;
+        std::memcpy(copy.s, str, len);
+        copy.s[len] = '\0';
+        return copy;
+    } else {
+        static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>,
+            "deferred lv::log arguments must be numbers, enums, pointers or C strings");
+        return v;
+    }
+}
+
+template<typename T>
+[[nodiscard]] inline auto pass(const T& v) noexcept {
+    if constexpr (std::is_same_v<T, LogStr>) return static_cast<const char*>(v.s);
+    else return v;
+}
+
+using LogQueue = Dispatcher<LV_CPP_LOG_QUEUE, LV_CPP_LOG_RECORD>;
+
+struct LogTables {
+    LogQueue queue;
+    std::atomic<uint32_t> queued{0};
+    std::atomic<uint32_t> dropped{0};
+    uint32_t written = 0;          ///< Consumer only
+    uint32_t reported = 0;         ///< Drops already reported by drain()
+};
+
+[[nodiscard]] inline LogTables& log_tables() noexcept {
+    static LogTables t;
+    return t;
+}
+
+/// Queue a record; the format runs in drain()
+template<typename... Args>
+inline void log_defer(lv_log_level_t lvl, const Fmt& fmt, Args... args) noexcept {
+    LogTables& t = log_tables();
+    auto record = [lvl, fmt, a = std::tuple{capture(args)...}]() noexcept {
+        std::apply([&](const auto&... v) { log_now(lvl, fmt, pass(v)...); }, a);
+    };
+    if (t.queue.post(record)) t.queued.fetch_add(1, std::memory_order_relaxed);
+    else t.dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+#endif // LV_CPP_LOG_DEFERRED
+
+template<lv_log_level_t Lvl, typename... Args>
+inline void log_add(const Fmt& fmt, Args... args) noexcept {
+    if constexpr (enabled<Lvl>) {
+#if LV_CPP_LOG_DEFERRED
+        log_defer(Lvl, fmt, args...);
+#else
+        log_now(Lvl, fmt, args...);
+#endif
+    }
+}
+
 } // namespace detail
 
 /// Log at trace level
 template<typename... Args>
 inline void trace(Fmt fmt, Args... args) noexcept {
-    detail::log_add(LV_LOG_LEVEL_TRACE, fmt, args...);
+    detail::log_add<LV_LOG_LEVEL_TRACE>(fmt, args...);
 }
 
 /// Log at info level
 template<typename... Args>
 inline void info(Fmt fmt, Args... args) noexcept {
-    detail::log_add(LV_LOG_LEVEL_INFO, fmt, args...);
+    detail::log_add<LV_LOG_LEVEL_INFO>(fmt, args...);
 }
 
 /// Log at warn level
 template<typename... Args>
 inline void warn(Fmt fmt, Args... args) noexcept {
-    detail::log_add(LV_LOG_LEVEL_WARN, fmt, args...);
+    detail::log_add<LV_LOG_LEVEL_WARN>(fmt, args...);
 }
 
 /// Log at error level
 template<typename... Args>
 inline void error(Fmt fmt, Args... args) noexcept {
-    detail::log_add(LV_LOG_LEVEL_ERROR, fmt, args...);
+    detail::log_add<LV_LOG_LEVEL_ERROR>(fmt, args...);
 }
 
 /// Log at user level
 template<typename... Args>
 inline void user(Fmt fmt, Args... args) noexcept {
-    detail::log_add(LV_LOG_LEVEL_USER, fmt, args...);
+    detail::log_add<LV_LOG_LEVEL_USER>(fmt, args...);
+}
+
+#if LV_CPP_LOG_DEFERRED
+
+// ==================== Deferred output ====================
+
+struct Stats {
+    uint32_t queued = 0;      ///< Records queued
+    uint32_t written = 0;     ///< Records printed by drain()
+    uint32_t dropped = 0;     ///< Calls lost to a full ring
+};
+
+/**
+ * @brief Format and print up to `max` queued records (one consumer thread)
+ *
+ * Reports records dropped since the last call as one warning.
+ * @return Records printed
+ */
+inline size_t drain(size_t max = LV_CPP_LOG_QUEUE) noexcept {
+    detail::LogTables& t = detail::log_tables();
+    const uint32_t dropped = t.dropped.load(std::memory_order_relaxed);
+    if (dropped != t.reported) {
+        lv_log_add(LV_LOG_LEVEL_WARN, __FILE__, __LINE__, __func__,
+                   "%u log records dropped, raise LV_CPP_LOG_QUEUE", static_cast<unsigned>(dropped - t.reported));
+        t.reported = dropped;
+    }
+    const size_t n = t.queue.drain(max);
+    t.written += static_cast<uint32_t>(n);
+    return n;
+}
+
+/// True while records wait for drain()
+[[nodiscard]] inline bool pending() noexcept {
+    return !detail::log_tables().queue.empty();
+}
+
+namespace detail {
+inline bool log_idle(uint32_t budget_ms) noexcept {
+    const uint32_t start = lv_tick_get();
+    while (drain(16) && lv_tick_elaps(start) < budget_ms) {}
+    return pending();
+}
+} // namespace detail
+
+/// Drain from lv::tick()'s idle time (call once on the UI thread; do not also drain elsewhere)
+inline bool drain_in_idle() noexcept {
+    return idle_handler(&detail::log_idle);
+}
+
+[[nodiscard]] inline Stats stats() noexcept {
+    const detail::LogTables& t = detail::log_tables();
+    return Stats{t.queued.load(std::memory_order_relaxed), t.written, t.dropped.load(std::memory_order_relaxed)};
 }
 
+/// Reset the counters (consumer thread)
+inline void reset_stats() noexcept {
+    detail::LogTables& t = detail::log_tables();
+    t.queued.store(0, std::memory_order_relaxed);
+    t.written = 0;
+    t.dropped.store(0, std::memory_order_relaxed);
+    t.reported = 0;
+}
+
+#endif // LV_CPP_LOG_DEFERRED
+
 } // namespace lv::log
 
 #else // !LV_USE_LOG
@@ -0,0 +1,280 @@
+#pragma once
+
+/**
+ * @file mapped_file.hpp
+ * @brief Memory-mapped files and zero-copy LVGL .bin image sources
+ *
+ * fs::MappedFile maps a file read-only with mmap() when the path resolves
+ * to an OS path (no drive letter, or the letter of LVGL's POSIX or STDIO
+ * driver). Otherwise, or where mmap() is unavailable, the file is read
+ * once through lv_fs into a buffer from the DrawBufPool. Paths on a RomFs
+ * drive (romfs.hpp) use the linked-in table data directly.
+ *
+ * MappedImage points an lv_image_dsc_t at the pixel data of a mapped LVGL
+ * .bin image (already converted to the display format, uncompressed), so a
+ * full-screen background costs page cache instead of heap and loads
+ * without a decode:
+ *
+ * @code
+ * static lv::MappedImage wallpaper("A:/img/wallpaper.bin");
+ * if (wallpaper) lv::Image::create(screen).src(wallpaper.src());
+ * @endcode
+ *
+ * The pixel data keeps the file layout (after the 12 byte header), so it
+ * is not LV_DRAW_BUF_ALIGN aligned; GPU draw units that require aligned
+ * sources fall back to the software renderer or copy.
+ *
+ * Heap allocation: NONE when mapped; one pooled buffer of the file size otherwise
+ */
+
+#include <lvgl.h>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include "fs.hpp"
+#include "romfs.hpp"
+#include "../draw/draw_buf.hpp"
+
+#ifndef LV_CPP_FS_MMAP
+#if defined(__unix__) || defined(__APPLE__)
+#define LV_CPP_FS_MMAP 1
+#else
+#define LV_CPP_FS_MMAP 0
+#endif
+#endif
+
+#ifndef LV_CPP_FS_PATH_MAX
+/// Longest OS path built from an LVGL path for mmap()
+#define LV_CPP_FS_PATH_MAX 256
+#endif
+
+#if LV_CPP_FS_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace lv::fs {
+
+namespace detail {
+
+/// Append `rest` to `prefix` in `out`; false if it does not fit
+inline bool join_path(char* out, size_t n, const char* prefix, const char* rest) noexcept {
+    const int len = std::snprintf(out, n, "%s%s", prefix, rest);
+    return len >= 0 && static_cast<size_t>(len) < n;
+}
+
+/// OS path of an LVGL path, if a driver maps it 1:1 onto the OS filesystem
+inline bool os_path(const char* path, char* out, size_t n) noexcept {
+    if (!path || !path[0]) return false;
+    if (path[1] != ':') return join_path(out, n, "", path);
+#if LV_USE_FS_POSIX
+    if (path[0] == LV_FS_POSIX_LETTER) return join_path(out, n, LV_FS_POSIX_PATH, path + 2);
+#endif
+#if LV_USE_FS_STDIO
+    if (path[0] == LV_FS_STDIO_LETTER) return join_path(out, n, LV_FS_STDIO_PATH, path + 2);
+#endif
+    return false;
+}
+
+} // namespace detail
+
+/**
+ * @brief Read-only view of a whole file, mapped or read into a pooled buffer
+ *
+ * Move-only. data() stays valid until close() or destruction.
+ */
+class MappedFile {
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+    bool m_mapped = false;
+    bool m_rom = false;       ///< Points into a RomFs table
+
+    [[nodiscard]] bool map(const char* path) noexcept {
+#if LV_CPP_FS_MMAP
+        char os[LV_CPP_FS_PATH_MAX];
+        if (!detail::os_path(path, os, sizeof(os))) return false;
+        const int fd = ::open(os, O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return false;
+        struct stat st;
+        void* p = MAP_FAILED;
+        if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+            p = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        ::close(fd);   // the mapping keeps the file referenced
+        if (p == MAP_FAILED) return false;
+        m_data = static_cast<const uint8_t*>(p);
+        m_size = static_cast<size_t>(st.st_size);
+        m_mapped = true;
+        return true;
+#else
+        (void)path;
+        return false;
+#endif
+    }
+
+    [[nodiscard]] lv_fs_res_t read_whole(const char* path) noexcept {
+        File f;
+        const lv_fs_res_t r = f.open(path);
+        if (r != LV_FS_RES_OK) return r;
+        const uint32_t size = f.size();
+        if (size == 0) return LV_FS_RES_FS_ERR;
+        auto* mem = static_cast<uint8_t*>(draw::pool_malloc(size, LV_COLOR_FORMAT_RAW));
+        if (!mem) return LV_FS_RES_OUT_OF_MEM;
+        uint32_t br = 0;
+        if (f.read(mem, size, &br) != LV_FS_RES_OK || br != size) {
+            draw::pool_free(mem);
+            return LV_FS_RES_FS_ERR;
+        }
+        m_data = mem;
+        m_size = size;
+        return LV_FS_RES_OK;
+    }
+
+public:
+    MappedFile() noexcept = default;
+
+    explicit MappedFile(const char* path) noexcept { open(path); }
+
+    ~MappedFile() { close(); }
+
+    MappedFile(MappedFile&& other) noexcept
+        : m_data(other.m_data), m_size(other.m_size), m_mapped(other.m_mapped), m_rom(other.m_rom) {
+        other.m_data = nullptr;
+        other.m_size = 0;
+        other.m_mapped = false;
+        other.m_rom = false;
+    }
+
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            close();
+            m_data = other.m_data;
+            m_size = other.m_size;
+            m_mapped = other.m_mapped;
+            m_rom = other.m_rom;
+            other.m_data = nullptr;
+            other.m_size = 0;
+            other.m_mapped = false;
+            other.m_rom = false;
+        }
+        return *this;
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /// Map `path` (closes any current file first); falls back to a pooled copy
+    lv_fs_res_t open(const char* path) noexcept {
+        close();
+        if (const RomEntry* e = RomFs::lookup(path)) {
+            m_data = e->data;
+            m_size = e->size;
+            m_mapped = m_rom = true;
+            return LV_FS_RES_OK;
+        }
+        if (map(path)) return LV_FS_RES_OK;
+        return read_whole(path);
+    }
+
+    void close() noexcept {
+        if (!m_data) return;
+#if LV_CPP_FS_MMAP
+        if (m_mapped && !m_rom) ::munmap(const_cast<uint8_t*>(m_data), m_size);
+#endif
+        if (!m_mapped) draw::pool_free(const_cast<uint8_t*>(m_data));
+        m_data = nullptr;
+        m_size = 0;
+        m_mapped = false;
+        m_rom = false;
+    }
+
+    [[nodiscard]] bool is_open() const noexcept { return m_data != nullptr; }
+    explicit operator bool() const noexcept { return m_data != nullptr; }
+
+    /// True if backed by mmap() or a RomFs table, false if copied into a pooled buffer
+    [[nodiscard]] bool is_mapped() const noexcept { return m_mapped; }
+
+    [[nodiscard]] const uint8_t* data() const noexcept { return m_data; }
+    [[nodiscard]] size_t size() const noexcept { return m_size; }
+};
+
+} // namespace lv::fs
+
+namespace lv {
+
+/**
+ * @brief Zero-copy image source over a mapped LVGL .bin file
+ *
+ * Accepts uncompressed .bin images (lv_image_header_t followed by the
+ * palette, if any, and the pixels). Not movable: image objects keep a
+ * pointer to the embedded descriptor.
+ */
+class MappedImage {
+    fs::MappedFile m_file;
+    lv_image_dsc_t m_dsc{};
+
+public:
+    MappedImage() noexcept = default;
+
+    explicit MappedImage(const char* path) noexcept { open(path); }
+
+    ~MappedImage() { close(); }
+
+    MappedImage(const MappedImage&) = delete;
+    MappedImage& operator=(const MappedImage&) = delete;
+
+    /**
+     * @brief Map a .bin image (closes any current one first)
+     * @return false if the file is missing, not a .bin image, compressed or truncated
+     */
+    bool open(const char* path) noexcept {
+        close();
+        if (m_file.open(path) != LV_FS_RES_OK) return false;
+        lv_image_header_t header;
+        if (m_file.size() < sizeof(header)) {
+            m_file.close();
+            return false;
+        }
+        std::memcpy(&header, m_file.data(), sizeof(header));
+        const size_t data_size = m_file.size() - sizeof(header);
+        if (header.stride == 0) header.stride = lv_draw_buf_width_to_stride(header.w, static_cast<lv_color_format_t>(header.cf));
+        if (header.magic != LV_IMAGE_HEADER_MAGIC || (header.flags & LV_IMAGE_FLAGS_COMPRESSED) ||
+            data_size < static_cast<size_t>(header.stride) * header.h) {
+            LV_LOG_WARN("MappedImage: %s is not an uncompressed LVGL .bin image", path);
+            m_file.close();
+            return false;
+        }
+        // The descriptor does not own the data: LVGL must never free or write it
+        header.flags &= ~(LV_IMAGE_FLAGS_ALLOCATED | LV_IMAGE_FLAGS_MODIFIABLE);
+        m_dsc.header = header;
+        m_dsc.data = m_file.data() + sizeof(header);
+        m_dsc.data_size = static_cast<uint32_t>(data_size);
+        return true;
+    }
+
+    /// Unmap; cached decodes of this source are dropped first
+    void close() noexcept {
+        if (!m_file) return;
+        lv_image_cache_drop(&m_dsc);
+        m_dsc = lv_image_dsc_t{};
+        m_file.close();
+    }
+
+    [[nodiscard]] bool is_open() const noexcept { return m_file.is_open(); }
+    explicit operator bool() const noexcept { return m_file.is_open(); }
+    [[nodiscard]] bool is_mapped() const noexcept { return m_file.is_mapped(); }
+
+    /// Image source for Image::src(), lv_image_set_src() and draw descriptors
+    [[nodiscard]] const void* src() const noexcept { return &m_dsc; }
+    [[nodiscard]] const lv_image_dsc_t* dsc() const noexcept { return &m_dsc; }
+
+    [[nodiscard]] uint32_t width() const noexcept { return m_dsc.header.w; }
+    [[nodiscard]] uint32_t height() const noexcept { return m_dsc.header.h; }
+    [[nodiscard]] lv_color_format_t color_format() const noexcept {
+        return static_cast<lv_color_format_t>(m_dsc.header.cf);
+    }
+};
+
+} // namespace lv
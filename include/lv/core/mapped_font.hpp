@@ -0,0 +1,571 @@
+#pragma once
+
+/**
+ * @file mapped_font.hpp
+ * @brief LVGL binary fonts (lv_binfont) served from mapped files
+ *
+ * lv_binfont_create() reads a .bin font (lv_font_conv --format bin) through
+ * lv_fs and copies every table and bitmap to the heap. MappedFont parses
+ * the same file from a fs::MappedFile and points the font at it:
+ *
+ * @code
+ * static lv::MappedFont inter("A:fonts/inter_14.bin");
+ * label.text_font(inter);
+ *
+ * static lv::FontPack ui("A:fonts/inter.fpk");    // scripts/font_pack.py
+ * title.text_font(ui.font(28));
+ * body.text_font(ui.font(14));
+ * @endcode
+ *
+ * Glyph bitmaps and kerning tables stay in the mapped file. Glyph
+ * descriptors and cmap headers are unpacked into one heap block per font
+ * (8 bytes per glyph, 32 per cmap); unicode lists that are not 2-byte
+ * aligned in the file are copied there too. Fonts whose glyph headers are
+ * not a whole number of bytes (xy_bits, wh_bits and advance_width_bits
+ * chosen by lv_font_conv) cannot be referenced in place: their bitmaps
+ * are shifted into the block, and in_place() reports it.
+ *
+ * A FontPack bundles several sizes (and styles) of one family in one file
+ * and maps it once; each size is parsed on first use. Both read only the
+ * file layout, so new fonts can be shipped with an OTA update without
+ * rebuilding, and the RAM cost of N sizes is N glyph tables instead of N
+ * copies of every bitmap.
+ *
+ * Heap allocation: one lv_malloc block per parsed font; the file itself
+ * is mapped (or read once into a pooled buffer, see mapped_file.hpp)
+ */
+
+#include <lvgl.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include "mapped_file.hpp"
+
+#ifndef LV_CPP_FONT_PACK_FONTS
+/// Fonts one FontPack can hold
+#define LV_CPP_FONT_PACK_FONTS 8
+#endif
+
+namespace lv {
+
+namespace detail::binfont {
+
+/// "head" table of an lv_binfont file (after the length and label)
+struct Head {
+    uint32_t version;
+    uint16_t tables_count;
+    uint16_t font_size;
+    uint16_t ascent;
+    int16_t descent;
+    uint16_t typo_ascent;
+    int16_t typo_descent;
+    uint16_t typo_line_gap;
+    int16_t min_y;
+    int16_t max_y;
+    uint16_t default_advance_width;
+    uint16_t kerning_scale;
+    uint8_t index_to_loc_format;
+    uint8_t glyph_id_format;
+    uint8_t advance_width_format;
+    uint8_t bits_per_pixel;
+    uint8_t xy_bits;
+    uint8_t wh_bits;
+    uint8_t advance_width_bits;
+    uint8_t compression_id;
+    uint8_t subpixels_mode;
+    uint8_t padding;
+    int16_t underline_position;
+    uint16_t underline_thickness;
+};
+
+/// One cmap subtable record of the "cmap" table
+struct CmapRecord {
+    uint32_t data_offset;
+    uint32_t range_start;
+    uint16_t range_length;
+    uint16_t glyph_id_start;
+    uint16_t data_entries_count;
+    uint8_t format_type;
+    uint8_t padding;
+};
+static_assert(sizeof(CmapRecord) == 16);
+
+[[nodiscard]] constexpr size_t align_up(size_t n) noexcept { return (n + 7u) & ~size_t(7u); }
+
+template<typename T>
+[[nodiscard]] inline T load(const uint8_t* p) noexcept {
+    T v;
+    std::memcpy(&v, p, sizeof(T));
+    return v;
+}
+
+/// Bounds-checked view of the file
+struct Reader {
+    const uint8_t* data;
+    size_t size;
+
+    [[nodiscard]] bool has(size_t off, size_t n) const noexcept { return off <= size && n <= size - off; }
+
+    /// Length of the table labelled `label` at `off` (0 if missing or truncated)
+    [[nodiscard]] uint32_t table(size_t off, const char* label) const noexcept {
+        if (!has(off, 8) || std::memcmp(data + off + 4, label, 4) != 0) return 0;
+        const auto len = load<uint32_t>(data + off);
+        return len >= 8 && has(off, len) ? len : 0;
+    }
+};
+
+/// MSB-first bit reader over a glyph record
+struct Bits {
+    const uint8_t* p;
+    uint32_t bit = 0;
+
+    [[nodiscard]] uint32_t read(uint32_t n) noexcept {
+        uint32_t v = 0;
+        for (uint32_t i = 0; i < n; ++i, ++bit) v = (v << 1) | ((p[bit >> 3] >> (7 - (bit & 7))) & 1u);
+        return v;
+    }
+
+    [[nodiscard]] int32_t read_signed(uint32_t n) noexcept {
+        const uint32_t v = read(n);
+        return n && (v & (1u << (n - 1))) ? static_cast<int32_t>(v | ~((1u << n) - 1)) : static_cast<int32_t>(v);
+    }
+};
+
+/// Head of a parsed font; cmaps, glyph descriptors and copied data follow
+struct Block {
+    lv_font_t font;
+    lv_font_fmt_txt_dsc_t dsc;
+    lv_font_fmt_txt_kern_pair_t kern_pair;
+    lv_font_fmt_txt_kern_classes_t kern_classes;
+    uint32_t cmap_cnt;
+    uint32_t glyph_cnt;
+    uint32_t extra;       ///< Bytes of copied lists and bitmaps
+    bool in_place;
+
+    [[nodiscard]] static size_t cmaps_at() noexcept { return align_up(sizeof(Block)); }
+    [[nodiscard]] size_t glyphs_at() const noexcept {
+        return cmaps_at() + align_up(sizeof(lv_font_fmt_txt_cmap_t) * cmap_cnt);
+    }
+    [[nodiscard]] size_t extra_at() const noexcept {
+        return glyphs_at() + align_up(sizeof(lv_font_fmt_txt_glyph_dsc_t) * glyph_cnt);
+    }
+    [[nodiscard]] size_t size() const noexcept { return extra_at() + extra; }
+
+    template<typename T>
+    [[nodiscard]] T* at(size_t off) noexcept { return reinterpret_cast<T*>(reinterpret_cast<uint8_t*>(this) + off); }
+};
+
+/// Table offsets and sizes found by scan()
+struct Layout {
+    Head head{};
+    size_t cmap = 0, loca = 0, glyf = 0, kern = 0;
+    uint32_t glyf_len = 0, kern_len = 0;
+    uint32_t cmap_cnt = 0, glyph_cnt = 0;
+    uint32_t header_bits = 0;
+    uint32_t extra = 0;
+    bool in_place = true;
+};
+
+[[nodiscard]] inline bool aligned2(const uint8_t* p) noexcept { return (reinterpret_cast<uintptr_t>(p) & 1u) == 0; }
+
+[[nodiscard]] inline uint32_t loca_at(const Reader& r, const Layout& l, uint32_t i) noexcept {
+    const uint8_t* p = r.data + l.loca + 12;
+    return l.head.index_to_loc_format == 0 ? load<uint16_t>(p + 2 * i) : load<uint32_t>(p + 4 * i);
+}
+
+/// Bitmap bytes of glyph `i` as lv_binfont_loader counts them
+[[nodiscard]] inline uint32_t bitmap_len(const Reader& r, const Layout& l, uint32_t i) noexcept {
+    const uint32_t start = loca_at(r, l, i);
+    const uint32_t next = i + 1 < l.glyph_cnt ? loca_at(r, l, i + 1) : l.glyf_len;
+    const uint32_t head = start + l.header_bits / 8;
+    return next > head ? next - head : 0;
+}
+
+/// Validate the tables and size the heap block; false if not an lv_binfont
+[[nodiscard]] inline bool scan(const Reader& r, Layout& l) noexcept {
+    const uint32_t head_len = r.table(0, "head");
+    if (head_len < 8 + offsetof(Head, underline_thickness) + sizeof(uint16_t)) return false;
+    std::memcpy(&l.head, r.data + 8, head_len - 8 < sizeof(Head) ? head_len - 8 : sizeof(Head));
+    const Head& h = l.head;
+    if (h.bits_per_pixel == 0 || h.bits_per_pixel > 8 || h.compression_id > 2) return false;
+
+    l.cmap = head_len;
+    const uint32_t cmap_len = r.table(l.cmap, "cmap");
+    if (cmap_len < 12) return false;
+    l.cmap_cnt = load<uint32_t>(r.data + l.cmap + 8);
+    if (l.cmap_cnt >= (1u << 9) || 12 + sizeof(CmapRecord) * l.cmap_cnt > cmap_len) return false;
+
+    l.loca = l.cmap + cmap_len;
+    const uint32_t loca_len = r.table(l.loca, "loca");
+    if (loca_len < 12) return false;
+    l.glyph_cnt = load<uint32_t>(r.data + l.loca + 8);
+    if (l.glyph_cnt == 0 || 12 + (h.index_to_loc_format ? 4u : 2u) * size_t(l.glyph_cnt) > loca_len) return false;
+
+    l.glyf = l.loca + loca_len;
+    l.glyf_len = r.table(l.glyf, "glyf");
+    if (l.glyf_len == 0) return false;
+
+    l.kern = l.glyf + l.glyf_len;
+    l.kern_len = h.tables_count > 4 ? r.table(l.kern, "kern") : 0;
+
+    // Unicode / glyph id lists the fmt_txt lookup reads as uint16_t must be aligned
+    for (uint32_t i = 0; i < l.cmap_cnt; ++i) {
+        const auto rec = load<CmapRecord>(r.data + l.cmap + 12 + sizeof(CmapRecord) * i);
+        const uint8_t* p = r.data + l.cmap + rec.data_offset;
+        const size_t n = rec.data_entries_count;
+        switch (rec.format_type) {
+        case LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL:
+            if (!r.has(l.cmap + rec.data_offset, rec.range_length)) return false;
+            break;
+        case LV_FONT_FMT_TXT_CMAP_SPARSE_FULL:
+            if (!r.has(l.cmap + rec.data_offset, 4 * n)) return false;
+            if (!aligned2(p)) l.extra += static_cast<uint32_t>(align_up(4 * n));
+            break;
+        case LV_FONT_FMT_TXT_CMAP_SPARSE_TINY:
+            if (!r.has(l.cmap + rec.data_offset, 2 * n)) return false;
+            if (!aligned2(p)) l.extra += static_cast<uint32_t>(align_up(2 * n));
+            break;
+        case LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY:
+            break;
+        default:
+            return false;
+        }
+    }
+
+    // Glyph records start on a byte; their bitmaps only if the header is whole bytes
+    l.header_bits = h.advance_width_bits + 2u * h.xy_bits + 2u * h.wh_bits;
+    l.in_place = l.header_bits % 8 == 0;
+    uint32_t copied = 0;
+    for (uint32_t i = 0; i < l.glyph_cnt; ++i) {
+        const uint32_t off = loca_at(r, l, i);
+        if (off >= l.glyf_len) return false;
+        copied += bitmap_len(r, l, i);
+    }
+    if (l.in_place) {
+        if (l.glyf_len >= (1u << 20)) return false;    // bitmap_index is 20 bits
+    } else {
+        if (copied >= (1u << 20)) return false;
+        l.extra += static_cast<uint32_t>(align_up(copied));
+    }
+    return true;
+}
+
+/// Copy `n` bytes that start `shift` bits into `src` (shift 1..7)
+inline void copy_shifted(const uint8_t* src, const uint8_t* end, uint32_t shift, uint8_t* out, uint32_t n) noexcept {
+    for (uint32_t k = 0; k < n; ++k) {
+        const uint8_t hi = static_cast<uint8_t>(src[k] << shift);
+        const uint8_t lo = src + k + 1 < end ? static_cast<uint8_t>(src[k + 1] >> (8 - shift)) : 0;
+        out[k] = hi | lo;
+    }
+}
+
+inline void fill_kerning(const Reader& r, const Layout& l, Block* b) noexcept {
+    if (l.kern_len < 12) return;
+    const uint8_t* k = r.data + l.kern;
+    const uint8_t format = k[8];
+    if (format == 0 && l.kern_len >= 16) {
+        const uint32_t cnt = load<uint32_t>(k + 12);
+        const size_t id_size = l.head.glyph_id_format ? 2 : 1;
+        const uint8_t* ids = k + 16;
+        if (16 + cnt * (2 * id_size + 1) > l.kern_len || (id_size == 2 && !aligned2(ids))) {
+            LV_LOG_WARN("MappedFont: kerning pairs skipped (truncated or misaligned)");
+            return;
+        }
+        b->kern_pair.glyph_ids = ids;
+        b->kern_pair.values = reinterpret_cast<const int8_t*>(ids + cnt * 2 * id_size);
+        b->kern_pair.pair_cnt = cnt;
+        b->kern_pair.glyph_ids_size = l.head.glyph_id_format;
+        b->dsc.kern_dsc = &b->kern_pair;
+        b->dsc.kern_classes = 0;
+    } else if (format == 3 && l.kern_len >= 16) {
+        const uint16_t map_len = load<uint16_t>(k + 12);
+        const uint8_t rows = k[14];
+        const uint8_t cols = k[15];
+        if (16 + 2u * map_len + size_t(rows) * cols > l.kern_len) return;
+        b->kern_classes.left_class_mapping = k + 16;
+        b->kern_classes.right_class_mapping = k + 16 + map_len;
+        b->kern_classes.class_pair_values = reinterpret_cast<const int8_t*>(k + 16 + 2u * map_len);
+        b->kern_classes.left_class_cnt = rows;
+        b->kern_classes.right_class_cnt = cols;
+        b->dsc.kern_dsc = &b->kern_classes;
+        b->dsc.kern_classes = 1;
+    }
+    b->dsc.kern_scale = l.head.kerning_scale;
+}
+
+/// Build the font for the file at `data`; the file must outlive the result
+[[nodiscard]] inline Block* parse(const uint8_t* data, size_t size) noexcept {
+    const Reader r{data, size};
+    Layout l;
+    if (!data || !scan(r, l)) return nullptr;
+
+    Block probe{};
+    probe.cmap_cnt = l.cmap_cnt;
+    probe.glyph_cnt = l.glyph_cnt;
+    probe.extra = l.extra;
+    auto* b = static_cast<Block*>(lv_malloc_zeroed(probe.size()));
+    if (!b) return nullptr;
+    b->cmap_cnt = l.cmap_cnt;
+    b->glyph_cnt = l.glyph_cnt;
+    b->extra = l.extra;
+    b->in_place = l.in_place;
+    uint8_t* extra = b->at<uint8_t>(b->extra_at());
+
+    const Head& h = l.head;
+    b->font.get_glyph_dsc = lv_font_get_glyph_dsc_fmt_txt;
+    b->font.get_glyph_bitmap = lv_font_get_bitmap_fmt_txt;
+    b->font.line_height = h.ascent - h.descent;
+    b->font.base_line = -h.descent;
+    b->font.subpx = h.subpixels_mode;
+    b->font.underline_position = static_cast<int8_t>(h.underline_position);
+    b->font.underline_thickness = static_cast<int8_t>(h.underline_thickness);
+    b->font.dsc = &b->dsc;
+    b->dsc.bpp = h.bits_per_pixel;
+    b->dsc.bitmap_format = h.compression_id;
+    b->dsc.cmap_num = static_cast<uint16_t>(l.cmap_cnt);
+
+    auto* cmaps = b->at<lv_font_fmt_txt_cmap_t>(b->cmaps_at());
+    for (uint32_t i = 0; i < l.cmap_cnt; ++i) {
+        const auto rec = load<CmapRecord>(data + l.cmap + 12 + sizeof(CmapRecord) * i);
+        const uint8_t* p = data + l.cmap + rec.data_offset;
+        const size_t n = rec.data_entries_count;
+        lv_font_fmt_txt_cmap_t& c = cmaps[i];
+        c.range_start = rec.range_start;
+        c.range_length = rec.range_length;
+        c.glyph_id_start = rec.glyph_id_start;
+        c.type = static_cast<lv_font_fmt_txt_cmap_type_t>(rec.format_type);
+        c.list_length = static_cast<uint16_t>(n);
+        if (rec.format_type == LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL) {
+            c.glyph_id_ofs_list = p;
+            c.list_length = rec.range_length;
+        } else if (rec.format_type == LV_FONT_FMT_TXT_CMAP_SPARSE_FULL ||
+                   rec.format_type == LV_FONT_FMT_TXT_CMAP_SPARSE_TINY) {
+            const size_t bytes = (rec.format_type == LV_FONT_FMT_TXT_CMAP_SPARSE_FULL ? 4 : 2) * n;
+            if (!aligned2(p)) {
+                std::memcpy(extra, p, bytes);
+                p = extra;
+                extra += align_up(bytes);
+            }
+            c.unicode_list = reinterpret_cast<const uint16_t*>(p);
+            if (rec.format_type == LV_FONT_FMT_TXT_CMAP_SPARSE_FULL) c.glyph_id_ofs_list = p + 2 * n;
+        }
+    }
+
+    const uint8_t* glyf = data + l.glyf;
+    const uint8_t* glyf_end = glyf + l.glyf_len;
+    auto* glyphs = b->at<lv_font_fmt_txt_glyph_dsc_t>(b->glyphs_at());
+    uint32_t copied = 0;
+    for (uint32_t i = 1; i < l.glyph_cnt; ++i) {    // glyph 0 stays the empty reserved one
+        const uint32_t off = loca_at(r, l, i);
+        Bits bits{glyf + off};
+        lv_font_fmt_txt_glyph_dsc_t& g = glyphs[i];
+        uint32_t adv = h.advance_width_bits ? bits.read(h.advance_width_bits) : h.default_advance_width;
+        if (h.advance_width_format == 0) adv *= 16;
+        g.adv_w = adv;
+        g.ofs_x = static_cast<int8_t>(bits.read_signed(h.xy_bits));
+        g.ofs_y = static_cast<int8_t>(bits.read_signed(h.xy_bits));
+        g.box_w = static_cast<uint8_t>(bits.read(h.wh_bits));
+        g.box_h = static_cast<uint8_t>(bits.read(h.wh_bits));
+        if (g.box_w == 0 || g.box_h == 0) continue;
+        if (l.in_place) {
+            g.bitmap_index = off + l.header_bits / 8;
+        } else {
+            const uint32_t n = bitmap_len(r, l, i);
+            copy_shifted(glyf + off + l.header_bits / 8, glyf_end, l.header_bits % 8, extra + copied, n);
+            g.bitmap_index = copied;
+            copied += n;
+        }
+    }
+    b->dsc.glyph_bitmap = l.in_place ? glyf : extra;
+    b->dsc.glyph_dsc = glyphs;
+    b->dsc.cmaps = cmaps;
+    fill_kerning(r, l, b);
+    return b;
+}
+
+/// Font pack file: "LVFP", version, count, then one Entry per font
+struct PackHead {
+    char magic[4];
+    uint16_t version;
+    uint16_t count;
+};
+
+struct PackEntry {
+    uint16_t size;        ///< Pixel size
+    uint16_t style;       ///< Free for the packer (0: regular)
+    uint32_t offset;      ///< From the start of the pack
+    uint32_t length;
+};
+
+inline constexpr char pack_magic[4] = {'L', 'V', 'F', 'P'};
+
+} // namespace detail::binfont
+
+/**
+ * @brief lv_binfont font over a mapped file or caller-owned memory
+ *
+ * Movable; the lv_font_t lives in the heap block, so labels keep a valid
+ * pointer across moves. Labels must not use the font after close().
+ */
+class MappedFont {
+    fs::MappedFile m_file;
+    detail::binfont::Block* m_block = nullptr;
+
+public:
+    MappedFont() noexcept = default;
+
+    explicit MappedFont(const char* path) noexcept { open(path); }
+
+    ~MappedFont() { close(); }
+
+    MappedFont(MappedFont&& other) noexcept : m_file(std::move(other.m_file)), m_block(other.m_block) {
+        other.m_block = nullptr;
+    }
+
+    MappedFont& operator=(MappedFont&& other) noexcept {
+        if (this != &other) {
+            close();
+            m_file = std::move(other.m_file);
+            m_block = other.m_block;
+            other.m_block = nullptr;
+        }
+        return *this;
+    }
+
+    MappedFont(const MappedFont&) = delete;
+    MappedFont& operator=(const MappedFont&) = delete;
+
+    /**
+     * @brief Map an lv_binfont file (closes any current font first)
+     * @return false if the file is missing, not an lv_binfont or out of memory
+     */
+    bool open(const char* path) noexcept {
+        close();
+        if (m_file.open(path) != LV_FS_RES_OK) return false;
+        m_block = detail::binfont::parse(m_file.data(), m_file.size());
+        if (!m_block) {
+            LV_LOG_WARN("MappedFont: %s is not an LVGL binary font", path);
+            m_file.close();
+            return false;
+        }
+        return true;
+    }
+
+    /// Use an lv_binfont already in memory (flash, a FontPack); `data` must outlive the font
+    bool open(const uint8_t* data, size_t size) noexcept {
+        close();
+        m_block = detail::binfont::parse(data, size);
+        return m_block != nullptr;
+    }
+
+    void close() noexcept {
+        lv_free(m_block);
+        m_block = nullptr;
+        m_file.close();
+    }
+
+    [[nodiscard]] const lv_font_t* get() const noexcept { return m_block ? &m_block->font : nullptr; }
+    [[nodiscard]] bool valid() const noexcept { return m_block != nullptr; }
+    explicit operator bool() const noexcept { return valid(); }
+    operator const lv_font_t*() const noexcept { return get(); }
+
+    /// Font for letters this one lacks
+    MappedFont& fallback(const lv_font_t* font) noexcept {
+        if (m_block) m_block->font.fallback = font;
+        return *this;
+    }
+
+    /// True if glyph bitmaps are read from the file, false if they were realigned into the heap
+    [[nodiscard]] bool in_place() const noexcept { return m_block && m_block->in_place; }
+
+    /// Heap bytes of the parsed tables (and realigned bitmaps)
+    [[nodiscard]] size_t heap_bytes() const noexcept { return m_block ? m_block->size() : 0; }
+};
+
+/**
+ * @brief Several lv_binfont fonts in one mapped file (scripts/font_pack.py)
+ *
+ * Not movable: the fonts point into the pack's mapping.
+ */
+class FontPack {
+    fs::MappedFile m_file;
+    detail::binfont::PackEntry m_entries[LV_CPP_FONT_PACK_FONTS] = {};
+    MappedFont m_fonts[LV_CPP_FONT_PACK_FONTS];
+    uint16_t m_count = 0;
+
+public:
+    FontPack() noexcept = default;
+
+    explicit FontPack(const char* path) noexcept { open(path); }
+
+    FontPack(const FontPack&) = delete;
+    FontPack& operator=(const FontPack&) = delete;
+
+    /**
+     * @brief Map a font pack (closes any current one first)
+     * @return false if the file is missing or not a font pack
+     */
+    bool open(const char* path) noexcept {
+        namespace bf = detail::binfont;
+        close();
+        if (m_file.open(path) != LV_FS_RES_OK) return false;
+        bf::PackHead head;
+        if (m_file.size() < sizeof(head)) {
+            m_file.close();
+            return false;
+        }
+        std::memcpy(&head, m_file.data(), sizeof(head));
+        const size_t table_end = sizeof(head) + sizeof(bf::PackEntry) * head.count;
+        if (std::memcmp(head.magic, bf::pack_magic, sizeof(head.magic)) != 0 || head.version != 1 ||
+            table_end > m_file.size()) {
+            LV_LOG_WARN("FontPack: %s is not a font pack", path);
+            m_file.close();
+            return false;
+        }
+        if (head.count > LV_CPP_FONT_PACK_FONTS) {
+            LV_LOG_WARN("FontPack: %s has %d fonts, raise LV_CPP_FONT_PACK_FONTS", path, head.count);
+        }
+        for (uint16_t i = 0; i < head.count && m_count < LV_CPP_FONT_PACK_FONTS; ++i) {
+            const auto e = bf::load<bf::PackEntry>(m_file.data() + sizeof(head) + sizeof(bf::PackEntry) * i);
+            if (e.offset < table_end || e.offset > m_file.size() || e.length > m_file.size() - e.offset) continue;
+            m_entries[m_count++] = e;
+        }
+        return true;
+    }
+
+    void close() noexcept {
+        for (uint16_t i = 0; i < m_count; ++i) m_fonts[i].close();
+        m_count = 0;
+        m_file.close();
+    }
+
+    [[nodiscard]] bool is_open() const noexcept { return m_file.is_open(); }
+    explicit operator bool() const noexcept { return is_open(); }
+
+    /// The font of `size` px and `style`, parsed on first use (nullptr if not in the pack)
+    [[nodiscard]] const lv_font_t* font(uint16_t size, uint16_t style = 0) noexcept {
+        for (uint16_t i = 0; i < m_count; ++i) {
+            const detail::binfont::PackEntry& e = m_entries[i];
+            if (e.size != size || e.style != style) continue;
+            if (!m_fonts[i] && !m_fonts[i].open(m_file.data() + e.offset, e.length)) return nullptr;
+            return m_fonts[i].get();
+        }
+        return nullptr;
+    }
+
+    /// Fonts in the pack
+    [[nodiscard]] uint16_t count() const noexcept { return m_count; }
+
+    /// Pixel size of font `i` (for listing what an update shipped)
+    [[nodiscard]] uint16_t size_at(uint16_t i) const noexcept { return i < m_count ? m_entries[i].size : 0; }
+
+    /// Heap bytes of the fonts parsed so far
+    [[nodiscard]] size_t heap_bytes() const noexcept {
+        size_t n = 0;
+        for (uint16_t i = 0; i < m_count; ++i) n += m_fonts[i].heap_bytes();
+        return n;
+    }
+};
+
+} // namespace lv
@@ -0,0 +1,326 @@
+#pragma once
+
+/**
+ * @file mem_account.hpp
+ * @brief Opt-in attribution of LVGL heap usage to components
+ *
+ * With LV_CPP_USE_MEM_ACCOUNT=1 (CMake -DLV_CPP_USE_MEM_ACCOUNT=ON) every
+ * LVGL allocation is charged to an owner: the Component being mounted
+ * (Component::mount() opens an owner scope around build()), or the
+ * component whose subtree receives the event being dispatched (the
+ * lv::Event trampolines open one). Anything else goes to the
+ * "unattributed" owner. Each block remembers its owner, so frees, also
+ * after unmount(), are credited back to whoever allocated. The bytes an
+ * owner still holds after its screen was left are its leak.
+ *
+ * The allocator is the hook: build LVGL with
+ * LV_USE_STDLIB_MALLOC = LV_STDLIB_CUSTOM and, in exactly one translation
+ * unit, define LV_CPP_MEM_ACCOUNT_ALLOCATOR before including this header.
+ * That unit then provides lv_malloc_core() and friends on top of malloc(),
+ * with a 16-byte header per block. Objects, styles, event descriptors,
+ * label text and draw buffers all come through it.
+ *
+ * @code
+ * // mem_account.cpp
+ * #define LV_CPP_MEM_ACCOUNT_ALLOCATOR
+ * #include <lv/core/mem_account.hpp>
+ *
+ * // after visiting the settings screen a few times
+ * lv::mem_account::log(8);   // live bytes, blocks and objects per component
+ * @endcode
+ *
+ * Off (the default), the scope macros expand to nothing.
+ *
+ * Single-threaded: allocate (LVGL's lock held) and query from the LVGL thread.
+ * Heap allocation: NONE (LV_CPP_MEM_ACCOUNT_OWNERS fixed owners)
+ */
+
+#include <lvgl.h>
+#include <cstdint>
+
+#ifndef LV_CPP_USE_MEM_ACCOUNT
+#define LV_CPP_USE_MEM_ACCOUNT 0
+#endif
+
+#ifndef LV_CPP_MEM_ACCOUNT_OWNERS
+/// Owners tracked besides "unattributed"; later owners are charged to it
+#define LV_CPP_MEM_ACCOUNT_OWNERS 32
+#endif
+
+#if LV_CPP_USE_MEM_ACCOUNT
+
+namespace lv::mem_account {
+
+/// Heap held by one owner
+struct OwnerStat {
+    const void* owner;        ///< Component instance (nullptr: unattributed)
+    const char* name;         ///< Names the component type
+    uint32_t live_bytes;      ///< Requested bytes not freed yet
+    uint32_t peak_bytes;
+    uint32_t live_blocks;     ///< Allocations not freed yet
+    uint32_t allocs;          ///< Allocations made
+    uint32_t objects;         ///< Objects in the component's subtree at report time (0 if not mounted)
+};
+
+namespace detail {
+
+struct Owner {
+    OwnerStat stat;
+    lv_obj_t* const* root;    ///< The component's root member (nullptr once it is destroyed)
+};
+
+struct Table {
+    Owner owners[LV_CPP_MEM_ACCOUNT_OWNERS + 1] = {{{nullptr, "unattributed", 0, 0, 0, 0, 0}, nullptr}};
+    uint32_t used = 1;
+    uint16_t current = 0;     ///< Owner charged for new allocations
+};
+
+[[nodiscard]] inline Table& table() noexcept {
+    static Table t;
+    return t;
+}
+
+/// Slot of `owner`, registering it if new (0 when the table is full)
+[[nodiscard]] inline uint16_t slot_of(const void* owner, const char* name) noexcept {
+    Table& t = table();
+    for (uint32_t i = 1; i < t.used; ++i) {
+        if (t.owners[i].stat.owner == owner) return static_cast<uint16_t>(i);
+    }
+    if (t.used > LV_CPP_MEM_ACCOUNT_OWNERS) return 0;
+    t.owners[t.used] = Owner{{owner, name, 0, 0, 0, 0, 0}, nullptr};
+    return static_cast<uint16_t>(t.used++);
+}
+
+inline void charge(uint16_t slot, uint32_t bytes) noexcept {
+    OwnerStat& s = table().owners[slot].stat;
+    s.live_bytes += bytes;
+    if (s.live_bytes > s.peak_bytes) s.peak_bytes = s.live_bytes;
+    ++s.live_blocks;
+    ++s.allocs;
+}
+
+inline void credit(uint16_t slot, uint32_t bytes) noexcept {
+    OwnerStat& s = table().owners[slot].stat;
+    s.live_bytes -= bytes;
+    --s.live_blocks;
+}
+
+[[nodiscard]] inline uint32_t count_objects(lv_obj_t* obj) noexcept {
+    uint32_t n = 1;
+    const uint32_t c = lv_obj_get_child_count(obj);
+    for (uint32_t i = 0; i < c; ++i) n += count_objects(lv_obj_get_child(obj, static_cast<int32_t>(i)));
+    return n;
+}
+
+/// Owner of the component subtree `obj` belongs to (0 if none)
+[[nodiscard]] inline uint16_t owner_of_obj(lv_obj_t* obj) noexcept {
+    const Table& t = table();
+    for (; obj; obj = lv_obj_get_parent(obj)) {
+        for (uint32_t i = 1; i < t.used; ++i) {
+            const lv_obj_t* const* root = t.owners[i].root;
+            if (root && *root == obj) return static_cast<uint16_t>(i);
+        }
+    }
+    return 0;
+}
+
+} // namespace detail
+
+/// RAII owner context: allocations inside are charged to `owner`
+class Scope {
+    uint16_t m_prev;
+
+public:
+    Scope(const void* owner, const char* name) noexcept : m_prev(detail::table().current) {
+        detail::table().current = detail::slot_of(owner, name);
+    }
+
+    ~Scope() { detail::table().current = m_prev; }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+};
+
+/// RAII owner context of an event: the component whose subtree holds the target
+class EventScope {
+    uint16_t m_prev;
+
+public:
+    explicit EventScope(lv_event_t* e) noexcept : m_prev(detail::table().current) {
+        const uint16_t owner = detail::owner_of_obj(static_cast<lv_obj_t*>(lv_event_get_current_target(e)));
+        if (owner) detail::table().current = owner;
+    }
+
+    ~EventScope() { detail::table().current = m_prev; }
+
+    EventScope(const EventScope&) = delete;
+    EventScope& operator=(const EventScope&) = delete;
+};
+
+/// Where to find the root of `owner` (Component passes &m_root; nullptr when it is destroyed)
+inline void set_root(const void* owner, lv_obj_t* const* root) noexcept {
+    detail::Table& t = detail::table();
+    for (uint32_t i = 1; i < t.used; ++i) {
+        if (t.owners[i].stat.owner == owner) t.owners[i].root = root;
+    }
+}
+
+/// Stats of `owner` (objects counted now), or of the unattributed owner for nullptr
+[[nodiscard]] inline OwnerStat find(const void* owner) noexcept {
+    const detail::Table& t = detail::table();
+    for (uint32_t i = 0; i < t.used; ++i) {
+        const detail::Owner& o = t.owners[i];
+        if (o.stat.owner != owner) continue;
+        OwnerStat s = o.stat;
+        s.objects = o.root && *o.root ? detail::count_objects(*o.root) : 0;
+        return s;
+    }
+    return OwnerStat{owner, nullptr, 0, 0, 0, 0, 0};
+}
+
+/// Owners tracked, including "unattributed"
+[[nodiscard]] inline uint32_t size() noexcept { return detail::table().used; }
+
+/**
+ * @brief Copy up to `max` owners into `out`, most live bytes first
+ * @return Number of entries written
+ */
+inline uint32_t report(OwnerStat* out, uint32_t max) noexcept {
+    const detail::Table& t = detail::table();
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < t.used; ++i) {
+        // Insertion into the bounded output, descending by live_bytes
+        const OwnerStat s = find(t.owners[i].stat.owner);
+        uint32_t pos = n;
+        while (pos > 0 && out[pos - 1].live_bytes < s.live_bytes) {
+            if (pos < max) out[pos] = out[pos - 1];
+            --pos;
+        }
+        if (pos < max) out[pos] = s;
+        if (n < max) ++n;
+    }
+    return n;
+}
+
+/// Clear peaks and allocation counts (live bytes stay: they are still held)
+inline void reset_peaks() noexcept {
+    detail::Table& t = detail::table();
+    for (uint32_t i = 0; i < t.used; ++i) {
+        t.owners[i].stat.peak_bytes = t.owners[i].stat.live_bytes;
+        t.owners[i].stat.allocs = 0;
+    }
+}
+
+/// LV_LOG_USER the `count` owners holding the most bytes
+inline void log(uint32_t count = 10) noexcept {
+    OwnerStat top[8];
+    if (count > 8) count = 8;
+    const uint32_t n = report(top, count);
+    LV_LOG_USER("heap by owner: %u owners", static_cast<unsigned>(size()));
+    for (uint32_t i = 0; i < n; ++i) {
+        const OwnerStat& s = top[i];
+        LV_LOG_USER("  %u bytes live (peak %u) in %u blocks, %u allocs, %u objects  %p %s",
+                    static_cast<unsigned>(s.live_bytes), static_cast<unsigned>(s.peak_bytes),
+                    static_cast<unsigned>(s.live_blocks), static_cast<unsigned>(s.allocs),
+                    static_cast<unsigned>(s.objects), s.owner, s.name);
+        (void)s;
+    }
+}
+
+} // namespace lv::mem_account
+
+/// Charge allocations in the enclosing scope to `owner`
+#define LV_CPP_MEM_ACCOUNT_SCOPE(owner, name) ::lv::mem_account::Scope lv_mem_account_scope_((owner), (name))
+/// Charge allocations in the enclosing event handler to the component of its target
+#define LV_CPP_MEM_ACCOUNT_EVENT_SCOPE(e) ::lv::mem_account::EventScope lv_mem_account_event_scope_(e)
+#define LV_CPP_MEM_ACCOUNT_ROOT(owner, root) ::lv::mem_account::set_root((owner), (root))
+
+// ==================== Allocator (one translation unit) ====================
+
+#ifdef LV_CPP_MEM_ACCOUNT_ALLOCATOR
+
+#if LV_USE_STDLIB_MALLOC != LV_STDLIB_CUSTOM
+#error "LV_CPP_MEM_ACCOUNT_ALLOCATOR needs LV_USE_STDLIB_MALLOC == LV_STDLIB_CUSTOM"
+#endif
+
+#include <cstdlib>
+
+namespace lv::mem_account::detail {
+
+/// Block header, 16 bytes to keep malloc()'s alignment
+struct alignas(16) Header {
+    uint32_t size;
+    uint16_t owner;
+};
+
+static_assert(sizeof(Header) == 16, "mem_account header must keep 16-byte alignment");
+
+} // namespace lv::mem_account::detail
+
+void lv_mem_init(void) {}
+
+void lv_mem_deinit(void) {}
+
+lv_mem_pool_t lv_mem_add_pool(void* mem, size_t bytes) {
+    (void)mem;
+    (void)bytes;
+    return nullptr;
+}
+
+void lv_mem_remove_pool(lv_mem_pool_t pool) {
+    (void)pool;
+}
+
+void* lv_malloc_core(size_t size) {
+    using namespace lv::mem_account::detail;
+    auto* h = static_cast<Header*>(std::malloc(sizeof(Header) + size));
+    if (!h) return nullptr;
+    h->size = static_cast<uint32_t>(size);
+    h->owner = table().current;
+    charge(h->owner, h->size);
+    return h + 1;
+}
+
+void lv_free_core(void* p) {
+    using namespace lv::mem_account::detail;
+    if (!p) return;
+    Header* h = static_cast<Header*>(p) - 1;
+    credit(h->owner, h->size);
+    std::free(h);
+}
+
+void* lv_realloc_core(void* p, size_t new_size) {
+    using namespace lv::mem_account::detail;
+    if (!p) return lv_malloc_core(new_size);
+    Header* h = static_cast<Header*>(p) - 1;
+    const uint16_t owner = h->owner;   // growth stays with the block's owner
+    const uint32_t old_size = h->size;
+    auto* n = static_cast<Header*>(std::realloc(h, sizeof(Header) + new_size));
+    if (!n) return nullptr;
+    credit(owner, old_size);
+    n->size = static_cast<uint32_t>(new_size);
+    charge(owner, n->size);
+    --table().owners[owner].stat.allocs;   // a resize is not a new allocation
+    return n + 1;
+}
+
+void lv_mem_monitor_core(lv_mem_monitor_t* mon_p) {
+    using namespace lv::mem_account::detail;
+    lv_memzero(mon_p, sizeof(lv_mem_monitor_t));
+    const Table& t = table();
+    for (uint32_t i = 0; i < t.used; ++i) mon_p->max_used += t.owners[i].stat.live_bytes;
+}
+
+lv_result_t lv_mem_test_core(void) {
+    return LV_RESULT_OK;
+}
+
+#endif // LV_CPP_MEM_ACCOUNT_ALLOCATOR
+
+#else // !LV_CPP_USE_MEM_ACCOUNT
+
+#define LV_CPP_MEM_ACCOUNT_SCOPE(owner, name) ((void)(owner), (void)(name))
+#define LV_CPP_MEM_ACCOUNT_EVENT_SCOPE(e) ((void)(e))
+#define LV_CPP_MEM_ACCOUNT_ROOT(owner, root) ((void)(owner), (void)(root))
+
+#endif // LV_CPP_USE_MEM_ACCOUNT
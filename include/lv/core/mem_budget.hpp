@@ -0,0 +1,378 @@
+#pragma once
+
+/**
+ * @file mem_budget.hpp
+ * @brief Soft/hard LVGL heap limits with caches shedding memory in priority order
+ *
+ * Running out of LVGL heap shows up as nullptr objects and crashes deep in
+ * drawing. lv::memory::budget watches heap usage instead and, once it
+ * crosses the soft limit, asks the registered caches to give memory back,
+ * lowest priority value first, until usage is under the soft limit again:
+ *
+ * @code
+ * lv::memory::budget::set(160 * 1024, 200 * 1024);   // soft, hard
+ * lv::memory::budget::add_defaults();                // image, glyph and draw buffer caches
+ * lv::memory::budget::add(nav, 40);                  // then unmount cached screens
+ * lv::memory::budget::add(dialogs, 50);              // then idle ComponentPool dialogs
+ * lv::memory::budget::start();                       // check every LV_CPP_MEM_BUDGET_PERIOD ms
+ *
+ * // before loading a big image
+ * if (!lv::memory::budget::reserve(w * h * 4)) show_placeholder();
+ * @endcode
+ *
+ * Each episode is recorded in a Report: usage before and after, and the
+ * bytes each shedder freed, measured as the drop in usage across its call.
+ * The report also goes, as the parameter of low_memory_event(), to the
+ * active screen, so screens can drop their own thumbnails and similar.
+ * Usage still over the hard limit after every shedder ran is logged as an
+ * error.
+ *
+ * Usage is read with lv_mem_monitor(). The builtin allocator and
+ * lv::slab_alloc report it. For other allocators, set_usage_source() takes
+ * a function, e.g. lv::memory::stats().bytes with the pmr bridge.
+ *
+ * Single-threaded: call from the LVGL thread.
+ * Heap allocation: NONE (LV_CPP_MEM_BUDGET_SHEDDERS fixed slots, one timer)
+ */
+
+#include <lvgl.h>
+#include <cstddef>
+#include <cstdint>
+#include "image_cache.hpp"
+#include "glyph_cache.hpp"
+#include "screen.hpp"
+#include "page_stack.hpp"
+#include "component_pool.hpp"
+#include "../draw/draw_buf.hpp"
+
+#ifndef LV_CPP_MEM_BUDGET_SHEDDERS
+/// Caches that can be registered to shed memory
+#define LV_CPP_MEM_BUDGET_SHEDDERS 12
+#endif
+
+#ifndef LV_CPP_MEM_BUDGET_PERIOD
+/// Interval of the usage check started by start(), in milliseconds
+#define LV_CPP_MEM_BUDGET_PERIOD 250
+#endif
+
+namespace lv::memory::budget {
+
+/// Frees what it can; `need` is how many bytes the budget is short of
+using shed_cb = void (*)(size_t need, void* user_data);
+
+enum class Level : uint8_t {
+    ok,      ///< Under the soft limit
+    soft,    ///< Over the soft limit
+    hard,    ///< Over the hard limit
+};
+
+/// One shedding episode
+struct Report {
+    struct Entry {
+        const char* name;
+        size_t freed;       ///< Drop in usage across the shedder's call
+    };
+
+    uint32_t timestamp = 0;     ///< lv_tick_get() at the start
+    size_t before = 0;
+    size_t after = 0;
+    size_t target = 0;          ///< Usage the episode shed towards
+    Level level = Level::ok;    ///< Level before shedding
+    uint32_t count = 0;         ///< Shedders called
+    Entry entries[LV_CPP_MEM_BUDGET_SHEDDERS] = {};
+
+    [[nodiscard]] size_t freed() const noexcept { return before > after ? before - after : 0; }
+};
+
+struct Stats {
+    uint32_t episodes = 0;      ///< Soft limit crossings handled
+    uint32_t hard_hits = 0;     ///< Episodes that ended still over the hard limit
+    uint32_t refusals = 0;      ///< reserve() calls that could not fit
+    size_t freed = 0;           ///< Bytes freed over all episodes
+    size_t peak = 0;            ///< Highest usage seen by a check
+};
+
+namespace detail {
+
+struct Shedder {
+    shed_cb cb = nullptr;
+    void* user_data = nullptr;
+    const char* name = nullptr;
+    int32_t priority = 0;
+    size_t freed = 0;           ///< Over all episodes
+    uint32_t calls = 0;
+};
+
+struct State {
+    size_t soft = 0;            ///< 0: no budget
+    size_t hard = 0;
+    size_t (*usage)() = nullptr;
+    Shedder shedders[LV_CPP_MEM_BUDGET_SHEDDERS];
+    uint32_t count = 0;
+    lv_timer_t* timer = nullptr;
+    uint32_t event = 0;         ///< Registered lazily
+    bool shedding = false;      ///< A shedder's allocation must not start another episode
+    Report report;
+    Stats stats;
+};
+
+[[nodiscard]] inline State& state() noexcept {
+    static State s;
+    return s;
+}
+
+[[nodiscard]] inline size_t monitor_usage() noexcept {
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    return mon.total_size > mon.free_size ? mon.total_size - mon.free_size : 0;
+}
+
+[[nodiscard]] inline size_t usage_now() noexcept {
+    const State& s = state();
+    return s.usage ? s.usage() : monitor_usage();
+}
+
+/// Call shedders in priority order until usage is at most `target`
+inline void shed(size_t target, Level level) {
+    State& s = state();
+    Report& r = s.report;
+    r = Report{};
+    r.timestamp = lv_tick_get();
+    r.before = usage_now();
+    r.target = target;
+    r.level = level;
+    s.shedding = true;
+    size_t now = r.before;
+    for (uint32_t i = 0; i < s.count && now > target; ++i) {
+        Shedder& sh = s.shedders[i];
+        sh.cb(now - target, sh.user_data);
+        const size_t after = usage_now();
+        const size_t freed = now > after ? now - after : 0;
+        sh.freed += freed;
+        ++sh.calls;
+        r.entries[r.count++] = Report::Entry{sh.name, freed};
+        now = after;
+    }
+    s.shedding = false;
+    r.after = now;
+    ++s.stats.episodes;
+    s.stats.freed += r.freed();
+    if (s.hard && now > s.hard) {
+        ++s.stats.hard_hits;
+        LV_LOG_ERROR("memory budget: %u bytes in use after shedding, hard limit %u",
+                     static_cast<unsigned>(now), static_cast<unsigned>(s.hard));
+    }
+    if (!s.event) s.event = lv_event_register_id();
+    if (lv_obj_t* scr = lv_screen_active()) lv_obj_send_event(scr, static_cast<lv_event_code_t>(s.event), &r);
+}
+
+} // namespace detail
+
+// ==================== Limits ====================
+
+/**
+ * @brief Set the limits in bytes of LVGL heap usage (soft 0: no budget)
+ *
+ * Crossing `soft` sheds memory down to it; `hard` (0: none) is the level
+ * reserve() never plans beyond and that is reported when shedding falls short.
+ */
+inline void set(size_t soft, size_t hard = 0) noexcept {
+    detail::State& s = detail::state();
+    s.soft = soft;
+    s.hard = hard && hard < soft ? soft : hard;
+}
+
+[[nodiscard]] inline size_t soft_limit() noexcept { return detail::state().soft; }
+[[nodiscard]] inline size_t hard_limit() noexcept { return detail::state().hard; }
+
+/// Read usage with `fn` instead of lv_mem_monitor() (nullptr: back to lv_mem_monitor())
+inline void set_usage_source(size_t (*fn)()) noexcept { detail::state().usage = fn; }
+
+/// Current LVGL heap usage in bytes
+[[nodiscard]] inline size_t usage() noexcept { return detail::usage_now(); }
+
+[[nodiscard]] inline Level level() noexcept {
+    const detail::State& s = detail::state();
+    const size_t u = detail::usage_now();
+    if (s.hard && u > s.hard) return Level::hard;
+    if (s.soft && u > s.soft) return Level::soft;
+    return Level::ok;
+}
+
+// ==================== Shedders ====================
+
+/**
+ * @brief Register a cache that can give memory back
+ *
+ * Lower `priority` sheds first: cheap-to-rebuild caches before UI that
+ * has to be built again. Equal priorities keep registration order.
+ *
+ * @return false when all LV_CPP_MEM_BUDGET_SHEDDERS slots are taken
+ */
+inline bool add(const char* name, int32_t priority, shed_cb cb, void* user_data = nullptr) noexcept {
+    detail::State& s = detail::state();
+    if (s.count == LV_CPP_MEM_BUDGET_SHEDDERS) {
+        LV_LOG_WARN("memory budget: no free shedder slot, raise LV_CPP_MEM_BUDGET_SHEDDERS");
+        return false;
+    }
+    uint32_t pos = s.count;
+    while (pos > 0 && s.shedders[pos - 1].priority > priority) {
+        s.shedders[pos] = s.shedders[pos - 1];
+        --pos;
+    }
+    s.shedders[pos] = detail::Shedder{cb, user_data, name, priority, 0, 0};
+    ++s.count;
+    return true;
+}
+
+/// Unregister every shedder with this callback and user data
+inline void remove(shed_cb cb, void* user_data = nullptr) noexcept {
+    detail::State& s = detail::state();
+    uint32_t out = 0;
+    for (uint32_t i = 0; i < s.count; ++i) {
+        if (s.shedders[i].cb == cb && s.shedders[i].user_data == user_data) continue;
+        s.shedders[out++] = s.shedders[i];
+    }
+    s.count = out;
+}
+
+/// Navigator: unmount cached screens that are neither shown nor on the stack
+inline bool add(Navigator& nav, int32_t priority = 40) noexcept {
+    return add("navigator", priority, [](size_t, void* u) { static_cast<Navigator*>(u)->evict_unused(); }, &nav);
+}
+
+/// PageStack: unmount every page below the top one
+inline bool add(PageStack& pages, int32_t priority = 45) noexcept {
+    return add("page stack", priority, [](size_t, void* u) { static_cast<PageStack*>(u)->evict_covered(); }, &pages);
+}
+
+/// ComponentPool: unmount every idle component
+template<typename T, uint32_t N>
+bool add(ComponentPool<T, N>& pool, int32_t priority = 50) noexcept {
+    return add("component pool", priority, [](size_t, void* u) { static_cast<ComponentPool<T, N>*>(u)->trim(0); }, &pool);
+}
+
+/**
+ * @brief Register the library's caches
+ *
+ *   10 draw buffer pool: idle buffers
+ *   20 glyph cache: halve, then let it grow back
+ *   30 image cache: halve, then let it grow back; the header cache last
+ */
+inline void add_defaults() noexcept {
+    add("draw buffer pool", 10, [](size_t, void*) { draw::pool_trim(); });
+    add("glyph cache", 20, [](size_t, void*) {
+        const uint32_t b = glyph_cache::budget();
+        glyph_cache::budget(b / 2);
+        glyph_cache::budget(b);
+    });
+    add("image cache", 30, [](size_t need, void*) {
+        const uint32_t b = image_cache::budget();
+        image_cache::set_budget(b / 2, true);
+        image_cache::set_budget(b, false);
+        if (need > b / 2) image_cache::header::drop_all();
+    });
+}
+
+// ==================== Checking ====================
+
+/**
+ * @brief Shed if usage is over the soft limit
+ * @return Level before shedding
+ */
+inline Level check() {
+    detail::State& s = detail::state();
+    if (!s.soft || s.shedding) return Level::ok;
+    const size_t u = detail::usage_now();
+    if (u > s.stats.peak) s.stats.peak = u;
+    if (u <= s.soft) return Level::ok;
+    const Level lv = s.hard && u > s.hard ? Level::hard : Level::soft;
+    detail::shed(s.soft, lv);
+    return lv;
+}
+
+/**
+ * @brief Make room for an allocation of `bytes` that is about to happen
+ *
+ * Sheds until usage plus `bytes` is under the soft limit if needed.
+ * @return false if it would still exceed the hard limit (or the soft one
+ * without a hard limit): skip the allocation or use a lighter fallback
+ */
+inline bool reserve(size_t bytes) {
+    detail::State& s = detail::state();
+    if (!s.soft) return true;
+    size_t u = detail::usage_now();
+    if (u + bytes > s.soft && !s.shedding) {
+        detail::shed(bytes < s.soft ? s.soft - bytes : 0, u > s.hard && s.hard ? Level::hard : Level::soft);
+        u = detail::usage_now();
+    }
+    const size_t limit = s.hard ? s.hard : s.soft;
+    if (u + bytes <= limit) return true;
+    ++s.stats.refusals;
+    return false;
+}
+
+/// Check every `period_ms` from an LVGL timer
+inline bool start(uint32_t period_ms = LV_CPP_MEM_BUDGET_PERIOD) noexcept {
+    detail::State& s = detail::state();
+    if (!s.timer) s.timer = lv_timer_create([](lv_timer_t*) { (void)check(); }, period_ms, nullptr);
+    if (!s.timer) return false;
+    lv_timer_set_period(s.timer, period_ms);
+    return true;
+}
+
+inline void stop() noexcept {
+    detail::State& s = detail::state();
+    if (s.timer) lv_timer_delete(s.timer);
+    s.timer = nullptr;
+}
+
+/// Event code sent to the active screen after each episode; the parameter is the const Report*
+[[nodiscard]] inline lv_event_code_t low_memory_event() noexcept {
+    detail::State& s = detail::state();
+    if (!s.event) s.event = lv_event_register_id();
+    return static_cast<lv_event_code_t>(s.event);
+}
+
+// ==================== Reporting ====================
+
+/// Last shedding episode
+[[nodiscard]] inline const Report& last_report() noexcept { return detail::state().report; }
+
+[[nodiscard]] inline const Stats& stats() noexcept { return detail::state().stats; }
+
+/// Bytes shedder `name` freed over all episodes (0 if unknown)
+[[nodiscard]] inline size_t freed_by(const char* name) noexcept {
+    const detail::State& s = detail::state();
+    size_t total = 0;
+    for (uint32_t i = 0; i < s.count; ++i) {
+        if (s.shedders[i].name == name || (name && s.shedders[i].name && lv_strcmp(s.shedders[i].name, name) == 0)) {
+            total += s.shedders[i].freed;
+        }
+    }
+    return total;
+}
+
+inline void reset_stats() noexcept {
+    detail::State& s = detail::state();
+    s.stats = Stats{};
+    for (uint32_t i = 0; i < s.count; ++i) {
+        s.shedders[i].freed = 0;
+        s.shedders[i].calls = 0;
+    }
+}
+
+/// LV_LOG_USER the last episode, one line per shedder
+inline void log() noexcept {
+    const Report& r = last_report();
+    LV_LOG_USER("memory budget: %u -> %u bytes (target %u), %u shedders",
+                static_cast<unsigned>(r.before), static_cast<unsigned>(r.after),
+                static_cast<unsigned>(r.target), static_cast<unsigned>(r.count));
+    for (uint32_t i = 0; i < r.count; ++i) {
+        LV_LOG_USER("  %-20s freed %u", r.entries[i].name ? r.entries[i].name : "?",
+                    static_cast<unsigned>(r.entries[i].freed));
+    }
+    (void)r;
+}
+
+} // namespace lv::memory::budget
@@ -0,0 +1,249 @@
+#pragma once
+
+/**
+ * @file memory.hpp
+ * @brief std::pmr bridge for LVGL's heap, in both directions
+ *
+ * LVGL to pmr: with LV_USE_STDLIB_MALLOC = LV_STDLIB_CUSTOM and, in exactly
+ * one source file, LV_CPP_PMR_ALLOCATOR defined before including this
+ * header, lv_malloc()/lv_realloc()/lv_free() go to the resource given to
+ * set_resource() (std::pmr::get_default_resource() until then). pmr needs
+ * the size at deallocation and LVGL's free does not pass it, so every block
+ * carries a small header with its size and the resource it came from;
+ * lv_realloc() is allocate, copy and deallocate. Blocks are always returned
+ * to their own resource, so switching resources later is safe.
+ *
+ * pmr to LVGL: resource() is a std::pmr::memory_resource over lv_malloc()
+ * and lv_free() (any LVGL allocator), so UI-side containers count against
+ * the same heap and show up in lv_mem_monitor().
+ *
+ * @code
+ * // lv_memory.cpp
+ * #define LV_CPP_PMR_ALLOCATOR
+ * #include <lv/core/memory.hpp>
+ *
+ * static std::pmr::unsynchronized_pool_resource ui_pool(&ui_budget);
+ * lv::memory::set_resource(&ui_pool);           // before lv_init()
+ * std::pmr::vector<Row> rows(lv::memory::resource());
+ * @endcode
+ *
+ * Do not combine LV_CPP_PMR_ALLOCATOR with the allocators of
+ * mem_account.hpp or slab_alloc.hpp: each provides lv_malloc_core().
+ * Not thread-safe beyond the resource itself: allocate from the LVGL thread.
+ * Heap allocation: NONE of its own (a max_align_t header per LVGL block)
+ */
+
+#include <lvgl.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#include <new>
+
+namespace lv::memory {
+
+// ==================== pmr over LVGL ====================
+
+/// std::pmr::memory_resource backed by lv_malloc()/lv_free()
+class LvglResource : public std::pmr::memory_resource {
+protected:
+    void* do_allocate(size_t bytes, size_t align) override {
+        void* p = nullptr;
+        if (align <= alignof(void*)) {
+            p = lv_malloc(bytes);
+        } else if (void* raw = lv_malloc(bytes + align)) {
+            // Over-allocate and keep the raw pointer just below the aligned one
+            auto addr = (reinterpret_cast<uintptr_t>(raw) + sizeof(void*) + align - 1) & ~(uintptr_t(align) - 1);
+            p = reinterpret_cast<void*>(addr);
+            static_cast<void**>(p)[-1] = raw;
+        }
+#if defined(__cpp_exceptions)
+        if (!p) throw std::bad_alloc();
+#endif
+        return p;
+    }
+
+    void do_deallocate(void* p, size_t, size_t align) override {
+        lv_free(align <= alignof(void*) ? p : static_cast<void**>(p)[-1]);
+    }
+
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+/// LVGL's allocator as a pmr resource (one shared instance)
+[[nodiscard]] inline std::pmr::memory_resource* resource() noexcept {
+    static LvglResource r;
+    return &r;
+}
+
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_CUSTOM
+
+// ==================== LVGL over pmr ====================
+
+struct Stats {
+    size_t bytes = 0;        ///< Requested bytes held by LVGL
+    size_t peak = 0;
+    uint32_t blocks = 0;
+    uint32_t allocs = 0;
+    uint32_t failures = 0;   ///< Requests the resource refused
+};
+
+namespace detail {
+
+/// Per-block header: what pmr needs back at deallocation
+struct alignas(std::max_align_t) BlockHeader {
+    size_t size;
+    std::pmr::memory_resource* resource;
+};
+
+struct State {
+    std::pmr::memory_resource* resource = nullptr;   ///< nullptr: the default resource
+    Stats stats;
+};
+
+[[nodiscard]] inline State& state() noexcept {
+    static State s;
+    return s;
+}
+
+[[nodiscard]] inline void* allocate(size_t size) noexcept {
+    State& s = state();
+    std::pmr::memory_resource* r = s.resource ? s.resource : std::pmr::get_default_resource();
+    void* raw = nullptr;
+#if defined(__cpp_exceptions)
+    try {
+        raw = r->allocate(sizeof(BlockHeader) + size, alignof(BlockHeader));
+    } catch (const std::bad_alloc&) {
+        raw = nullptr;
+    }
+#else
+    raw = r->allocate(sizeof(BlockHeader) + size, alignof(BlockHeader));
+#endif
+    if (!raw) {
+        ++s.stats.failures;
+        return nullptr;
+    }
+    auto* h = static_cast<BlockHeader*>(raw);
+    h->size = size;
+    h->resource = r;
+    s.stats.bytes += size;
+    if (s.stats.bytes > s.stats.peak) s.stats.peak = s.stats.bytes;
+    ++s.stats.blocks;
+    ++s.stats.allocs;
+    return h + 1;
+}
+
+inline void release(void* p) noexcept {
+    if (!p) return;
+    State& s = state();
+    BlockHeader* h = static_cast<BlockHeader*>(p) - 1;
+    s.stats.bytes -= h->size;
+    --s.stats.blocks;
+    h->resource->deallocate(h, sizeof(BlockHeader) + h->size, alignof(BlockHeader));
+}
+
+[[nodiscard]] inline void* reallocate(void* p, size_t size) noexcept {
+    if (!p) return allocate(size);
+    const size_t old_size = (static_cast<BlockHeader*>(p) - 1)->size;
+    if (size <= old_size && size >= old_size / 2) return p;   // shrinking a little: keep the block
+    void* n = allocate(size);
+    if (!n) return nullptr;
+    std::memcpy(n, p, size < old_size ? size : old_size);
+    release(p);
+    return n;
+}
+
+} // namespace detail
+
+/**
+ * @brief Route LVGL's allocations to `r` from now on (nullptr: the default resource)
+ *
+ * Blocks already allocated keep going back to the resource they came from.
+ * `r` must outlive them. resource() itself is refused (it would recurse).
+ */
+inline bool set_resource(std::pmr::memory_resource* r) noexcept {
+    if (r == resource()) {
+        LV_LOG_WARN("lv::memory::set_resource: resource() allocates from LVGL itself");
+        return false;
+    }
+    detail::state().resource = r;
+    return true;
+}
+
+/// Resource LVGL allocates from (the default resource if none was set)
+[[nodiscard]] inline std::pmr::memory_resource* lvgl_resource() noexcept {
+    std::pmr::memory_resource* r = detail::state().resource;
+    return r ? r : std::pmr::get_default_resource();
+}
+
+[[nodiscard]] inline const Stats& stats() noexcept { return detail::state().stats; }
+
+/// Restart the peak at the current use and zero the counters
+inline void reset_stats() noexcept {
+    Stats& s = detail::state().stats;
+    s.peak = s.bytes;
+    s.allocs = 0;
+    s.failures = 0;
+}
+
+#endif // LV_USE_STDLIB_MALLOC == LV_STDLIB_CUSTOM
+
+} // namespace lv::memory
+
+// ==================== LVGL stdlib backend (one translation unit) ====================
+
+#ifdef LV_CPP_PMR_ALLOCATOR
+
+#if LV_USE_STDLIB_MALLOC != LV_STDLIB_CUSTOM
+#error "LV_CPP_PMR_ALLOCATOR needs LV_USE_STDLIB_MALLOC == LV_STDLIB_CUSTOM"
+#endif
+
+#if defined(LV_CPP_MEM_ACCOUNT_ALLOCATOR) || defined(LV_CPP_SLAB_ALLOCATOR)
+#error "LV_CPP_PMR_ALLOCATOR: only one lv::*_ALLOCATOR may provide lv_malloc_core()"
+#endif
+
+void lv_mem_init(void) {}
+
+void lv_mem_deinit(void) {}
+
+lv_mem_pool_t lv_mem_add_pool(void* mem, size_t bytes) {
+    (void)mem;
+    (void)bytes;
+    return nullptr;
+}
+
+void lv_mem_remove_pool(lv_mem_pool_t pool) {
+    (void)pool;
+}
+
+void* lv_malloc_core(size_t size) {
+    return lv::memory::detail::allocate(size);
+}
+
+void* lv_realloc_core(void* p, size_t new_size) {
+    return lv::memory::detail::reallocate(p, new_size);
+}
+
+void lv_free_core(void* p) {
+    lv::memory::detail::release(p);
+}
+
+/// The resource's capacity is unknown: only use, block count and peak are reported
+void lv_mem_monitor_core(lv_mem_monitor_t* mon_p) {
+    lv_memzero(mon_p, sizeof(lv_mem_monitor_t));
+    const lv::memory::Stats& s = lv::memory::stats();
+    mon_p->used_cnt = s.blocks;
+    mon_p->max_used = s.peak;
+}
+
+lv_result_t lv_mem_test_core(void) {
+    return LV_RESULT_OK;
+}
+
+#endif // LV_CPP_PMR_ALLOCATOR
+
+#endif // __has_include(<memory_resource>)
@@ -0,0 +1,377 @@
+#pragma once
+
+/**
+ * @file name_index.hpp
+ * @brief Hash index of named objects per screen: lv::find("settings.wifi.toggle")
+ *
+ * lv_obj_find_by_name() and lv_obj_get_child_by_name() walk the tree, so
+ * a test driver that looks up thousands of widgets on a screen of a few
+ * thousand objects spends its time walking. name_index::enable(screen)
+ * keeps the screen's named objects in an open-addressing table keyed by
+ * (scope, name), the scope of an object being its nearest named ancestor
+ * (or the screen). A dotted path is then one probe per segment:
+ *
+ * @code
+ * lv::name_index::enable(lv::screen_active());
+ * settings.name("settings");
+ * wifi_row.name("wifi");                 // anywhere below `settings`; unnamed containers between don't count
+ * toggle.name("toggle");
+ *
+ * lv::ObjectView t = lv::find("settings.wifi.toggle");      // O(depth)
+ * lv::ObjectView w = lv::find(settings, "wifi.toggle");
+ * @endcode
+ *
+ * ObjectMixin::name() and set_parent() update the index (re-keying the
+ * named objects below an unnamed object that moved or got a name), and
+ * each indexed object removes itself on LV_EVENT_DELETE. Names set or
+ * objects moved through the C API are caught on lookup: every hit is
+ * checked against the object's current name and scope, stale entries are
+ * re-keyed, and a miss walks the scope's subtree once and indexes what it
+ * finds. enable() indexes the names already set.
+ *
+ * Names should be unique within a scope; with duplicates any of them may
+ * be returned. Without an index on the screen, find() resolves the same
+ * paths by walking. Requires LV_USE_OBJ_NAME.
+ *
+ * Heap allocation: one table per indexed screen (doubled past 3/4 load);
+ * LVGL allocates one event descriptor per indexed object
+ */
+
+#include <lvgl.h>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include "object.hpp"
+
+#if LV_USE_OBJ_NAME
+
+#ifndef LV_CPP_NAME_INDEX_SCREENS
+/// Screens that can be indexed at once
+#define LV_CPP_NAME_INDEX_SCREENS 4
+#endif
+
+#ifndef LV_CPP_NAME_INDEX_MIN
+/// Initial slots per screen table (power of two)
+#define LV_CPP_NAME_INDEX_MIN 64
+#endif
+
+static_assert((LV_CPP_NAME_INDEX_MIN & (LV_CPP_NAME_INDEX_MIN - 1)) == 0,
+              "LV_CPP_NAME_INDEX_MIN must be a power of two");
+
+namespace lv {
+
+namespace name_index {
+
+struct Stats {
+    uint32_t lookups = 0;      ///< Path segments resolved
+    uint32_t hits = 0;         ///< Segments answered by the table
+    uint32_t walks = 0;        ///< Segments that fell back to a subtree walk
+    uint32_t stale = 0;        ///< Entries re-keyed on lookup (C API renames and moves)
+    uint32_t indexed = 0;      ///< Objects in all tables
+};
+
+namespace detail {
+
+struct Entry {
+    lv_obj_t* obj = nullptr;   ///< nullptr: free slot
+    lv_obj_t* scope = nullptr;
+    uint32_t key = 0;
+};
+
+struct Index {
+    lv_obj_t* screen = nullptr;    ///< nullptr: free slot
+    Entry* slots = nullptr;
+    uint32_t mask = 0;
+    uint32_t count = 0;
+};
+
+struct Tables {
+    Index screens[LV_CPP_NAME_INDEX_SCREENS];
+    Stats stats;
+};
+
+[[nodiscard]] inline Tables& tables() noexcept {
+    static Tables t;
+    return t;
+}
+
+[[nodiscard]] inline uint32_t key_of(lv_obj_t* scope, std::string_view name) noexcept {
+    uint32_t h = 2166136261u;                  // FNV-1a
+    for (char c : name) h = (h ^ static_cast<uint8_t>(c)) * 16777619u;
+    return h ^ static_cast<uint32_t>(reinterpret_cast<uintptr_t>(scope) >> 4) * 2654435761u;
+}
+
+[[nodiscard]] inline bool named(const lv_obj_t* obj) noexcept {
+    const char* n = lv_obj_get_name(obj);
+    return n && *n;
+}
+
+/// Nearest named ancestor, or the screen (nullptr for a screen)
+[[nodiscard]] inline lv_obj_t* scope_of(const lv_obj_t* obj) noexcept {
+    lv_obj_t* p = lv_obj_get_parent(obj);
+    while (p && lv_obj_get_parent(p) && !named(p)) p = lv_obj_get_parent(p);
+    return p;
+}
+
+[[nodiscard]] inline Index* index_of(const lv_obj_t* screen) noexcept {
+    if (!screen) return nullptr;
+    for (Index& ix : tables().screens) {
+        if (ix.screen == screen) return &ix;
+    }
+    return nullptr;
+}
+
+[[nodiscard]] inline bool is(const lv_obj_t* obj, std::string_view name) noexcept {
+    const char* n = lv_obj_get_name(obj);
+    return n && std::strlen(n) == name.size() && std::memcmp(n, name.data(), name.size()) == 0;
+}
+
+inline void place(Index& ix, const Entry& e) noexcept {
+    uint32_t s = e.key & ix.mask;
+    while (ix.slots[s].obj) s = (s + 1) & ix.mask;
+    ix.slots[s] = e;
+}
+
+/// Double the table (false if out of memory; the old one is kept)
+[[nodiscard]] inline bool grow(Index& ix) noexcept {
+    const uint32_t n = ix.slots ? (ix.mask + 1) * 2 : LV_CPP_NAME_INDEX_MIN;
+    auto* slots = static_cast<Entry*>(lv_malloc_zeroed(n * sizeof(Entry)));
+    if (!slots) return false;
+    Entry* old = ix.slots;
+    const uint32_t old_n = old ? ix.mask + 1 : 0;
+    ix.slots = slots;
+    ix.mask = n - 1;
+    for (uint32_t i = 0; i < old_n; ++i) {
+        if (old[i].obj) place(ix, old[i]);
+    }
+    lv_free(old);
+    return true;
+}
+
+/// Remove `obj` from the chain of `key`, shifting later entries back over the hole
+[[nodiscard]] inline bool erase(Index& ix, const lv_obj_t* obj, uint32_t key) noexcept {
+    if (!ix.slots) return false;
+    uint32_t s = key & ix.mask;
+    while (ix.slots[s].obj != obj) {
+        if (!ix.slots[s].obj) return false;
+        s = (s + 1) & ix.mask;
+    }
+    for (uint32_t next = (s + 1) & ix.mask; ix.slots[next].obj; next = (next + 1) & ix.mask) {
+        const uint32_t home = ix.slots[next].key & ix.mask;
+        // Move `next` into the hole unless its home lies cyclically in (s, next]
+        if (((next - home) & ix.mask) >= ((next - s) & ix.mask)) {
+            ix.slots[s] = ix.slots[next];
+            s = next;
+        }
+    }
+    ix.slots[s] = Entry{};
+    --ix.count;
+    --tables().stats.indexed;
+    return true;
+}
+
+inline void delete_cb(lv_event_t* e) noexcept;
+
+/// The object's LV_EVENT_DELETE descriptor added by track() (nullptr: not indexed)
+[[nodiscard]] inline lv_event_dsc_t* tracked(lv_obj_t* obj) noexcept {
+    const uint32_t n = lv_obj_get_event_count(obj);
+    for (uint32_t i = 0; i < n; ++i) {
+        lv_event_dsc_t* d = lv_obj_get_event_dsc(obj, i);
+        if (lv_event_dsc_get_cb(d) == &delete_cb) return d;
+    }
+    return nullptr;
+}
+
+/// Drop `obj` from whichever table holds it under `key`
+inline void forget(lv_obj_t* obj, uint32_t key) noexcept {
+    for (Index& ix : tables().screens) {
+        if (ix.screen && erase(ix, obj, key)) return;
+    }
+}
+
+/// Index `obj` under its current scope and name, or drop it if it has no name or indexed screen
+inline void track(lv_obj_t* obj) noexcept {
+    if (lv_event_dsc_t* d = tracked(obj)) {
+        forget(obj, static_cast<uint32_t>(reinterpret_cast<uintptr_t>(lv_event_dsc_get_user_data(d))));
+        lv_obj_remove_event_dsc(obj, d);
+    }
+    Index* ix = index_of(lv_obj_get_screen(obj));
+    lv_obj_t* scope = scope_of(obj);
+    if (!ix || !scope || !named(obj)) return;
+    if ((ix->count + 1) * 4 > (ix->mask + 1) * 3 || !ix->slots) {
+        if (!grow(*ix)) {
+            LV_LOG_WARN("name index: out of memory, %s not indexed", lv_obj_get_name(obj));
+            return;
+        }
+    }
+    const uint32_t key = key_of(scope, lv_obj_get_name(obj));
+    place(*ix, Entry{obj, scope, key});
+    ++ix->count;
+    ++tables().stats.indexed;
+    lv_obj_add_event_cb(obj, &delete_cb, LV_EVENT_DELETE, reinterpret_cast<void*>(static_cast<uintptr_t>(key)));
+}
+
+/// Re-key the named objects whose scope runs through `obj` (stopping at named ones)
+inline void track_below(lv_obj_t* obj) noexcept {
+    const uint32_t n = lv_obj_get_child_count(obj);
+    for (uint32_t i = 0; i < n; ++i) {
+        lv_obj_t* child = lv_obj_get_child(obj, static_cast<int32_t>(i));
+        if (named(child)) {
+            track(child);
+        } else {
+            track_below(child);
+        }
+    }
+}
+
+/// ObjectMixin::name() / set_parent() hook
+inline void renamed(lv_obj_t* obj) noexcept {
+    if (named(obj) || tracked(obj)) track(obj);
+    track_below(obj);
+}
+
+inline void delete_cb(lv_event_t* e) noexcept {
+    auto* obj = static_cast<lv_obj_t*>(lv_event_get_current_target(e));
+    forget(obj, static_cast<uint32_t>(reinterpret_cast<uintptr_t>(lv_event_get_user_data(e))));
+}
+
+inline void release(Index& ix) noexcept {
+    tables().stats.indexed -= ix.count;
+    lv_free(ix.slots);
+    ix = Index{};
+    for (const Index& o : tables().screens) {
+        if (o.screen) return;
+    }
+    lv::detail::obj_renamed_hook() = nullptr;
+}
+
+inline void screen_delete_cb(lv_event_t* e) noexcept {
+    // Sent before the children's; their own DELETE events then find nothing to erase
+    if (Index* ix = index_of(static_cast<lv_obj_t*>(lv_event_get_current_target(e)))) release(*ix);
+}
+
+/// First object named `name` whose scope is `from`, depth-first (not below named objects)
+[[nodiscard]] inline lv_obj_t* walk(lv_obj_t* from, std::string_view name) noexcept {
+    const uint32_t n = lv_obj_get_child_count(from);
+    for (uint32_t i = 0; i < n; ++i) {
+        lv_obj_t* child = lv_obj_get_child(from, static_cast<int32_t>(i));
+        if (named(child)) {
+            if (is(child, name)) return child;
+        } else if (lv_obj_t* hit = walk(child, name)) {
+            return hit;
+        }
+    }
+    return nullptr;
+}
+
+/// The object named `name` in `scope`
+[[nodiscard]] inline lv_obj_t* resolve(Index* ix, lv_obj_t* scope, std::string_view name) noexcept {
+    Stats& st = tables().stats;
+    ++st.lookups;
+    if (ix && ix->slots) {
+        const uint32_t key = key_of(scope, name);
+        for (uint32_t s = key & ix->mask; ix->slots[s].obj;) {
+            const Entry e = ix->slots[s];
+            if (e.key != key || e.scope != scope) {
+                s = (s + 1) & ix->mask;
+                continue;
+            }
+            if (scope_of(e.obj) == scope && named(e.obj) && key_of(scope, lv_obj_get_name(e.obj)) == key) {
+                if (is(e.obj, name)) {
+                    ++st.hits;
+                    return e.obj;
+                }
+                s = (s + 1) & ix->mask;    // another name with the same hash
+                continue;
+            }
+            ++st.stale;
+            track(e.obj);          // re-keyed elsewhere; the chain shifted, probe it again
+            s = key & ix->mask;
+        }
+    }
+    ++st.walks;
+    lv_obj_t* hit = walk(scope, name);
+    if (hit && ix) track(hit);
+    return hit;
+}
+
+} // namespace detail
+
+/**
+ * @brief Index the named objects of `screen` and keep the index up to date
+ *
+ * Returns false if LV_CPP_NAME_INDEX_SCREENS screens are already indexed
+ * or the table cannot be allocated.
+ */
+inline bool enable(ObjectView screen) noexcept {
+    using namespace detail;
+    lv_obj_t* scr = screen.get();
+    if (!scr || index_of(scr)) return scr != nullptr;
+    for (Index& ix : tables().screens) {
+        if (ix.screen) continue;
+        ix.screen = scr;
+        if (!grow(ix)) {
+            ix = Index{};
+            return false;
+        }
+        lv::detail::obj_renamed_hook() = &renamed;
+        lv_obj_add_event_cb(scr, &screen_delete_cb, LV_EVENT_DELETE, nullptr);
+        track_below(scr);
+        return true;
+    }
+    LV_LOG_WARN("name index: all screens in use, raise LV_CPP_NAME_INDEX_SCREENS");
+    return false;
+}
+
+/// Drop the index of `screen`
+inline void disable(ObjectView screen) noexcept {
+    using namespace detail;
+    Index* ix = index_of(screen.get());
+    if (!ix) return;
+    for (uint32_t i = 0; i <= ix->mask; ++i) {
+        if (lv_obj_t* obj = ix->slots[i].obj) lv_obj_remove_event_cb(obj, &delete_cb);
+    }
+    lv_obj_remove_event_cb_with_user_data(ix->screen, &screen_delete_cb, nullptr);
+    release(*ix);
+}
+
+[[nodiscard]] inline bool enabled(ObjectView screen) noexcept { return detail::index_of(screen.get()) != nullptr; }
+
+[[nodiscard]] inline Stats stats() noexcept { return detail::tables().stats; }
+
+inline void reset_stats() noexcept {
+    Stats& st = detail::tables().stats;
+    const uint32_t indexed = st.indexed;
+    st = Stats{};
+    st.indexed = indexed;
+}
+
+} // namespace name_index
+
+/**
+ * @brief Find an object by a dotted path of names below `root`
+ *
+ * `root` is a screen or a named object; each segment names an object
+ * whose nearest named ancestor is the previous segment's object. Returns
+ * a null view if any segment is not found.
+ */
+[[nodiscard]] inline ObjectView find(ObjectView root, std::string_view path) noexcept {
+    lv_obj_t* scope = root.get();
+    if (!scope) return ObjectView(nullptr);
+    name_index::detail::Index* ix = name_index::detail::index_of(lv_obj_get_screen(scope));
+    while (scope && !path.empty()) {
+        const size_t dot = path.find('.');
+        scope = name_index::detail::resolve(ix, scope, path.substr(0, dot));
+        path = dot == std::string_view::npos ? std::string_view{} : path.substr(dot + 1);
+    }
+    return ObjectView(scope);
+}
+
+/// Same, from the active screen
+[[nodiscard]] inline ObjectView find(std::string_view path) noexcept {
+    return find(ObjectView(lv_screen_active()), path);
+}
+
+} // namespace lv
+
+#endif // LV_USE_OBJ_NAME
@@ -12,8 +12,10 @@
 #include <lvgl.h>
 #include <utility>
 #include <cstdint>
+#include "state_batch.hpp"
 #include "wrap.hpp"
 #include "version.hpp"
+#include "setter_audit.hpp"
 
 namespace lv {
 
@@ -292,6 +294,27 @@ static_assert(sizeof(Object) == sizeof(void*),
 
 // ==================== Object Mixin for Widget Fluent API ====================
 
+namespace detail {
+/// Defined in cached_layer.hpp; include it to use ObjectMixin::cache_as_bitmap()
+template <typename> struct CacheAsBitmap;
+
+/// Name/parent change hook installed by lv::name_index (nullptr: no screen indexed)
+using obj_renamed_fn = void (*)(lv_obj_t* obj);
+
+[[nodiscard]] inline obj_renamed_fn& obj_renamed_hook() noexcept {
+    static obj_renamed_fn hook = nullptr;
+    return hook;
+}
+
+/// Installed by core/visibility.hpp: start or stop watching an object's visibility
+using visibility_watch_fn = bool (*)(lv_obj_t* obj, bool on);
+
+[[nodiscard]] inline visibility_watch_fn& visibility_watch_hook() noexcept {
+    static visibility_watch_fn hook = nullptr;
+    return hook;
+}
+} // namespace detail
+
 /**
  * @brief CRTP mixin providing common fluent object methods
  *
@@ -324,23 +347,37 @@ private:
         return p;
     }
 
+    /// Local style `prop` of the main part is already `v` (LV_CPP_SETTER_AUDIT / LV_CPP_SET_IF_CHANGED)
+    [[nodiscard]] bool local_is(lv_style_prop_t prop, int32_t v) const noexcept {
+        return setter_audit::detail::local_is(obj(), prop, v, 0);
+    }
+
+    [[nodiscard]] bool hidden() const noexcept { return lv_obj_has_flag(obj(), LV_OBJ_FLAG_HIDDEN); }
+
 public:
     // ==================== Size ====================
+    // size(), width(), height(), pos(), x(), y() and the visibility setters
+    // can skip unchanged values and report redundant calls (setter_audit.hpp)
 
     /// Set size in pixels
-    Derived& size(int32_t w, int32_t h) noexcept {
+    Derived& size(int32_t w, int32_t h LV_CPP_SETTER_SITE) noexcept {
+        if (LV_CPP_SETTER_UNCHANGED("size", obj(), local_is(LV_STYLE_WIDTH, w) && local_is(LV_STYLE_HEIGHT, h))) {
+            return *static_cast<Derived*>(this);
+        }
         lv_obj_set_size(obj(), w, h);
         return *static_cast<Derived*>(this);
     }
 
     /// Set width in pixels
-    Derived& width(int32_t w) noexcept {
+    Derived& width(int32_t w LV_CPP_SETTER_SITE) noexcept {
+        if (LV_CPP_SETTER_UNCHANGED("width", obj(), local_is(LV_STYLE_WIDTH, w))) return *static_cast<Derived*>(this);
         lv_obj_set_width(obj(), w);
         return *static_cast<Derived*>(this);
     }
 
     /// Set height in pixels
-    Derived& height(int32_t h) noexcept {
+    Derived& height(int32_t h LV_CPP_SETTER_SITE) noexcept {
+        if (LV_CPP_SETTER_UNCHANGED("height", obj(), local_is(LV_STYLE_HEIGHT, h))) return *static_cast<Derived*>(this);
         lv_obj_set_height(obj(), h);
         return *static_cast<Derived*>(this);
     }
@@ -384,19 +421,24 @@ public:
     // ==================== Position ====================
 
     /// Set position relative to parent
-    Derived& pos(int32_t x, int32_t y) noexcept {
+    Derived& pos(int32_t x, int32_t y LV_CPP_SETTER_SITE) noexcept {
+        if (LV_CPP_SETTER_UNCHANGED("pos", obj(), local_is(LV_STYLE_X, x) && local_is(LV_STYLE_Y, y))) {
+            return *static_cast<Derived*>(this);
+        }
         lv_obj_set_pos(obj(), x, y);
         return *static_cast<Derived*>(this);
     }
 
     /// Set X position
-    Derived& x(int32_t x) noexcept {
+    Derived& x(int32_t x LV_CPP_SETTER_SITE) noexcept {
+        if (LV_CPP_SETTER_UNCHANGED("x", obj(), local_is(LV_STYLE_X, x))) return *static_cast<Derived*>(this);
         lv_obj_set_x(obj(), x);
         return *static_cast<Derived*>(this);
     }
 
     /// Set Y position
-    Derived& y(int32_t y) noexcept {
+    Derived& y(int32_t y LV_CPP_SETTER_SITE) noexcept {
+        if (LV_CPP_SETTER_UNCHANGED("y", obj(), local_is(LV_STYLE_Y, y))) return *static_cast<Derived*>(this);
         lv_obj_set_y(obj(), y);
         return *static_cast<Derived*>(this);
     }
@@ -434,24 +476,40 @@ public:
     // ==================== Visibility ====================
 
     /// Hide the object
-    Derived& hide() noexcept {
+    Derived& hide(LV_CPP_SETTER_VOID_SITE) noexcept {
+        if (LV_CPP_SETTER_UNCHANGED("hide", obj(), hidden())) return *static_cast<Derived*>(this);
         lv_obj_add_flag(obj(), LV_OBJ_FLAG_HIDDEN);
         return *static_cast<Derived*>(this);
     }
 
     /// Show the object
-    Derived& show() noexcept {
+    Derived& show(LV_CPP_SETTER_VOID_SITE) noexcept {
+        if (LV_CPP_SETTER_UNCHANGED("show", obj(), !hidden())) return *static_cast<Derived*>(this);
         lv_obj_remove_flag(obj(), LV_OBJ_FLAG_HIDDEN);
         return *static_cast<Derived*>(this);
     }
 
     /// Set visibility
-    Derived& visible(bool v) noexcept {
+    Derived& visible(bool v LV_CPP_SETTER_SITE) noexcept {
+        if (LV_CPP_SETTER_UNCHANGED("visible", obj(), v != hidden())) return *static_cast<Derived*>(this);
         if (v) lv_obj_remove_flag(obj(), LV_OBJ_FLAG_HIDDEN);
         else lv_obj_add_flag(obj(), LV_OBJ_FLAG_HIDDEN);
         return *static_cast<Derived*>(this);
     }
 
+    /**
+     * @brief Pause this object's animations, tied timers and media and its
+     *        throttled observers while it is not visible (core/visibility.hpp)
+     */
+    Derived& pause_when_hidden(bool on = true) noexcept {
+        if (detail::visibility_watch_fn hook = detail::visibility_watch_hook()) {
+            (void)hook(obj(), on);
+        } else {
+            LV_LOG_WARN("pause_when_hidden() needs lv/core/visibility.hpp");
+        }
+        return *static_cast<Derived*>(this);
+    }
+
     // ==================== Flags ====================
 
     /// Set clickable flag
@@ -487,6 +545,12 @@ public:
         return *static_cast<Derived*>(this);
     }
 
+    /// Add `add` and remove `remove` (one style update with state_update.hpp installed)
+    Derived& set_states(lv_state_t add, lv_state_t remove) noexcept {
+        lv::set_states(obj(), add, remove);
+        return *static_cast<Derived*>(this);
+    }
+
     // ==================== User Data ====================
 
     /**
@@ -600,6 +664,7 @@ public:
     /// Move to new parent
     Derived& set_parent(ObjectView new_parent) noexcept {
         lv_obj_set_parent(obj(), new_parent);
+        if (detail::obj_renamed_fn hook = detail::obj_renamed_hook()) hook(obj());
         return *static_cast<Derived*>(this);
     }
 
@@ -714,13 +779,24 @@ public:
         return *static_cast<Derived*>(this);
     }
 
+    // ==================== Bitmap Cache ====================
+
+    /// Draw this object and its children from a cached bitmap while unchanged
+    /// (requires LV_USE_SNAPSHOT and #include <lv/core/cached_layer.hpp>)
+    Derived& cache_as_bitmap(bool en = true) noexcept {
+        detail::CacheAsBitmap<Derived>::set(obj(), en);
+        return *static_cast<Derived*>(this);
+    }
+
     // ==================== Object Naming ====================
 
     /// Set object name (requires LV_USE_OBJ_NAME in lv_conf.h)
-    /// Useful for widget identification in UI automation and debugging
+    /// Useful for widget identification in UI automation and debugging;
+    /// lv::find() in name_index.hpp looks names up without a tree walk
     Derived& name([[maybe_unused]] const char* name) noexcept {
         if constexpr (has_obj_name) {
             lv_obj_set_name(obj(), name);
+            if (detail::obj_renamed_fn hook = detail::obj_renamed_hook()) hook(obj());
         }
         return *static_cast<Derived*>(this);
     }
@@ -0,0 +1,965 @@
+#pragma once
+
+/**
+ * @file page_flip.hpp
+ * @brief Double-buffered, tear-free framebuffer and DRM/KMS displays
+ *
+ * FBDisplay and DRMDisplay hand everything to LVGL's drivers, which copy
+ * each area into the one visible buffer and block until it is written.
+ * FBFlipDisplay and DRMFlipDisplay instead own two full-screen buffers
+ * (fbdev: a virtual screen twice as tall, panned with FBIOPAN_DISPLAY;
+ * DRM: two dumb buffers flipped with drmModePageFlip()) and present the
+ * back buffer on vblank:
+ *
+ * - flush_cb queues the flip and returns; lv_display_flush_ready() is
+ *   called from the flip-complete event (DRM) or after one refresh period
+ *   (fbdev, which has no completion event)
+ * - while a flip is pending the display's refresh timer is paused instead
+ *   of blocking in LVGL's flush wait, so other timers and input keep running
+ *
+ * Flush modes:
+ * - FlushMode::direct: LVGL renders straight into the buffers and syncs
+ *   the changed areas into the other buffer itself (least copying)
+ * - FlushMode::full: the whole screen is redrawn into the back buffer
+ * - FlushMode::partial: LVGL renders into two small buffers that are copied
+ *   into the back buffer; the frame's areas are copied forward after the flip
+ * - FlushMode::in_place: one buffer, the one on screen. LVGL renders into it
+ *   and the flush only reports the frame done: no copy, no flip, half the
+ *   memory. For fully opaque, mostly static screens that can live with
+ *   tearing while an area is redrawn; DRM gets drmModeDirtyFB() per area
+ *   for drivers that scan out from a shadow copy
+ *
+ * Usage:
+ * @code
+ * lv::init();
+ * static lv::DRMFlipDisplay display("/dev/dri/card0", lv::FlushMode::direct);
+ * if (!display.ok()) return 1;
+ *
+ * lv::EventLoop loop;     // optional: handle flip events as soon as they arrive
+ * loop.watch<&lv::DRMFlipDisplay::on_readable>(display.fd(), &display);
+ * loop.run();
+ * @endcode
+ *
+ * DRMFlipDisplay::cursor() shows the mouse cursor on the CRTC's cursor
+ * plane and moves it from the pointer's reads (hw_cursor.hpp), so mouse
+ * motion does not render anything.
+ *
+ * Heap allocation: the wrapper allocates none; partial mode renders into
+ * two lv_draw_buf_t from LVGL's heap. Screen buffers are mmap()ed device
+ * memory (one in in_place mode).
+ */
+
+#include <lvgl.h>
+#include <cstdint>
+#include <cstring>
+#include "display.hpp"
+#include "display_mode.hpp"
+#include "hw_cursor.hpp"
+#include "../draw/draw_buf.hpp"
+
+#if defined(__linux__) && (LV_USE_LINUX_FBDEV || LV_USE_LINUX_DRM)
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#if LV_USE_LINUX_FBDEV
+#include <linux/fb.h>
+#endif
+
+#if LV_USE_LINUX_DRM
+#include <linux/netlink.h>
+#include <sys/socket.h>
+#include <xf86drm.h>
+#include <xf86drmMode.h>
+#endif
+
+namespace lv {
+
+#ifndef LV_CPP_FLIP_MAX_AREAS
+/// Areas remembered per frame for partial-mode buffer sync (more: full copy)
+#define LV_CPP_FLIP_MAX_AREAS 32
+#endif
+
+#ifndef LV_CPP_FLIP_POLL_MS
+/// Period of the fallback timer polling the DRM fd for flip events
+#define LV_CPP_FLIP_POLL_MS 1
+#endif
+
+/// How LVGL renders into a page-flipping display
+enum class FlushMode : uint8_t {
+    direct,     ///< Render into the screen buffers, sync changed areas
+    partial,    ///< Render into small buffers, copy into the back buffer
+    full,       ///< Redraw the whole screen into the back buffer every frame
+    in_place,   ///< Render into the single buffer on screen; no copy, no flip (may tear)
+};
+
+/**
+ * @brief CRTP base: LVGL glue shared by the page-flipping backends
+ *
+ * Backend provides:
+ * - `bool queue_flip(uint32_t index)`: start presenting buffer `index`
+ *   without blocking; complete_flip() is called once it is visible
+ * - `void wait_flip()`: block until the pending flip completed
+ * - optionally `void dirty(const lv_area_t&)`: an area of the visible
+ *   buffer changed (FlushMode::in_place)
+ *
+ * and calls setup() once its two buffers (one for in_place) are mapped,
+ * and rebind() with new ones after a mode change.
+ */
+template<typename Backend>
+class PageFlipDisplay : public Display {
+    uint8_t* m_pages[2] = {nullptr, nullptr};
+    uint32_t m_stride = 0;
+    uint32_t m_px_size = 0;
+    uint32_t m_front = 0;
+    FlushMode m_mode = FlushMode::direct;
+    bool m_pending = false;
+    uint32_t m_flips = 0;
+    lv_draw_buf_t* m_render[2] = {nullptr, nullptr};
+    lv_area_t m_areas[LV_CPP_FLIP_MAX_AREAS];
+    uint32_t m_area_count = 0;
+    bool m_areas_overflow = false;
+    bool m_rebind_ok = true;
+
+    [[nodiscard]] static Backend* self(lv_display_t* disp) noexcept {
+        return static_cast<Backend*>(lv_display_get_driver_data(disp));
+    }
+
+    [[nodiscard]] uint32_t back() const noexcept { return m_front ^ 1u; }
+
+    void copy_rows(uint8_t* dst, uint32_t dst_stride, const uint8_t* src, uint32_t src_stride,
+                   const lv_area_t& a) const noexcept {
+        const uint32_t bytes = static_cast<uint32_t>(lv_area_get_width(&a)) * m_px_size;
+        for (int32_t y = 0; y < lv_area_get_height(&a); ++y) {
+            std::memcpy(dst + static_cast<uint32_t>(y) * dst_stride, src + static_cast<uint32_t>(y) * src_stride, bytes);
+        }
+    }
+
+    [[nodiscard]] uint8_t* at(uint32_t page, int32_t x, int32_t y) const noexcept {
+        return m_pages[page] + static_cast<uint32_t>(y) * m_stride + static_cast<uint32_t>(x) * m_px_size;
+    }
+
+    void record_area(const lv_area_t& a) noexcept {
+        if (m_area_count < LV_CPP_FLIP_MAX_AREAS) {
+            m_areas[m_area_count++] = a;
+        } else {
+            m_areas_overflow = true;
+        }
+    }
+
+    /// Partial mode: bring the new back buffer up to date with the one now shown
+    void sync_back() noexcept {
+        const uint32_t from = m_front;
+        const uint32_t to = back();
+        if (m_areas_overflow) {
+            std::memcpy(m_pages[to], m_pages[from], static_cast<size_t>(m_stride) * static_cast<uint32_t>(height()));
+        } else {
+            for (uint32_t i = 0; i < m_area_count; ++i) {
+                const lv_area_t& a = m_areas[i];
+                copy_rows(at(to, a.x1, a.y1), m_stride, at(from, a.x1, a.y1), m_stride, a);
+            }
+        }
+        m_area_count = 0;
+        m_areas_overflow = false;
+    }
+
+    static void flush_cb(lv_display_t* disp, const lv_area_t* area, uint8_t* px) {
+        Backend* b = self(disp);
+        PageFlipDisplay& d = *b;
+        if (d.m_mode == FlushMode::in_place) {
+            // Already drawn where it is shown
+            if constexpr (requires { b->dirty(*area); }) b->dirty(*area);
+            if (lv_display_flush_is_last(disp)) ++d.m_flips;
+            lv_display_flush_ready(disp);
+            return;
+        }
+        if (d.m_mode == FlushMode::partial) {
+            const uint32_t src_stride = lv_draw_buf_width_to_stride(
+                static_cast<uint32_t>(lv_area_get_width(area)), lv_display_get_color_format(disp));
+            d.copy_rows(d.at(d.back(), area->x1, area->y1), d.m_stride, px, src_stride, *area);
+            d.record_area(*area);
+        }
+        if (!lv_display_flush_is_last(disp)) {
+            lv_display_flush_ready(disp);
+            return;
+        }
+        const uint32_t index = d.m_mode == FlushMode::partial ? d.back() : (px == d.m_pages[0] ? 0u : 1u);
+        if (!b->queue_flip(index)) {
+            lv_display_flush_ready(disp);   // could not flip: keep showing the old frame
+            return;
+        }
+        d.m_pending = true;
+        if (lv_timer_t* t = lv_display_get_refr_timer(disp)) lv_timer_pause(t);
+    }
+
+    static void flush_wait_cb(lv_display_t* disp) {
+        Backend* b = self(disp);
+        if (static_cast<PageFlipDisplay&>(*b).m_pending) b->wait_flip();
+    }
+
+    /// Give LVGL the current pages (and partial render buffers) at the display's resolution
+    bool install_buffers(lv_display_t* disp) noexcept {
+        const int32_t w = lv_display_get_horizontal_resolution(disp);
+        const int32_t h = lv_display_get_vertical_resolution(disp);
+        const uint32_t size = m_stride * static_cast<uint32_t>(h);
+        if (m_mode == FlushMode::partial) {
+            release_render_buffers();
+            const uint32_t rows = h >= 10 ? static_cast<uint32_t>(h) / 10 : static_cast<uint32_t>(h);
+            const lv_color_format_t cf = lv_display_get_color_format(disp);
+            m_render[0] = lv_draw_buf_create_ex(draw::pool_handlers(), static_cast<uint32_t>(w), rows, cf, 0);
+            m_render[1] = lv_draw_buf_create_ex(draw::pool_handlers(), static_cast<uint32_t>(w), rows, cf, 0);
+            if (!m_render[0] || !m_render[1]) {
+                release_render_buffers();
+                return false;
+            }
+            lv_display_set_draw_buffers(disp, m_render[0], m_render[1]);
+            lv_display_set_render_mode(disp, LV_DISPLAY_RENDER_MODE_PARTIAL);
+        } else if (m_mode == FlushMode::in_place) {
+            lv_display_set_buffers_with_stride(disp, m_pages[0], nullptr, size, m_stride, LV_DISPLAY_RENDER_MODE_DIRECT);
+        } else {
+            // LVGL renders into page 1 first; page 0 is on screen
+            lv_display_set_buffers_with_stride(disp, m_pages[1], m_pages[0], size, m_stride,
+                m_mode == FlushMode::direct ? LV_DISPLAY_RENDER_MODE_DIRECT : LV_DISPLAY_RENDER_MODE_FULL);
+        }
+        return true;
+    }
+
+    static void rebuffer_cb(lv_display_t* disp, void* user) {
+        auto* d = static_cast<PageFlipDisplay*>(user);
+        d->m_rebind_ok = d->install_buffers(disp);
+    }
+
+protected:
+    PageFlipDisplay() noexcept : Display(nullptr) {}
+
+    /**
+     * @brief Create the LVGL display over two mapped screen buffers
+     *
+     * `page1` is unused (may be nullptr) with FlushMode::in_place.
+     * @return false if LVGL could not create the display or render buffers
+     */
+    bool setup(uint8_t* page0, uint8_t* page1, int32_t w, int32_t h, uint32_t stride,
+               lv_color_format_t cf, FlushMode mode) noexcept {
+        lv_display_t* disp = lv_display_create(w, h);
+        if (!disp) return false;
+        m_pages[0] = page0;
+        m_pages[1] = page1;
+        m_stride = stride;
+        m_px_size = lv_color_format_get_size(cf);
+        m_mode = mode;
+        m_front = 0;
+        lv_display_set_color_format(disp, cf);
+        lv_display_set_driver_data(disp, static_cast<Backend*>(this));
+        if (!install_buffers(disp)) {
+            lv_display_delete(disp);
+            return false;
+        }
+        lv_display_set_flush_cb(disp, &PageFlipDisplay::flush_cb);
+        lv_display_set_flush_wait_cb(disp, &PageFlipDisplay::flush_wait_cb);
+        attach(disp);
+        return true;
+    }
+
+    /**
+     * @brief Switch LVGL to new screen buffers of `w` x `h`, keeping the display and its screens
+     *
+     * After a mode change; no flip may be pending. `page0` is the buffer on
+     * screen. The old buffers can be unmapped once this returns.
+     */
+    bool rebind(uint8_t* page0, uint8_t* page1, int32_t w, int32_t h, uint32_t stride) noexcept {
+        m_pages[0] = page0;
+        m_pages[1] = page1;
+        m_stride = stride;
+        m_front = 0;
+        m_area_count = 0;
+        m_areas_overflow = false;
+        if (w == width() && h == height()) {
+            // Same size (another refresh rate): new, blank buffers need a full redraw
+            m_rebind_ok = install_buffers(get());
+            lv_obj_invalidate(lv_display_get_screen_active(get()));
+            return m_rebind_ok;
+        }
+        m_rebind_ok = true;
+        display_mode::apply(get(), w, h, 0, &PageFlipDisplay::rebuffer_cb, this);
+        return m_rebind_ok;
+    }
+
+    /// Delete the LVGL display (before the backend unmaps its buffers)
+    void teardown() noexcept {
+        if (get()) lv_display_delete(get());
+        attach(nullptr);
+        release_render_buffers();
+    }
+
+    void release_render_buffers() noexcept {
+        for (lv_draw_buf_t*& b : m_render) {
+            if (b) lv_draw_buf_destroy(b);
+            b = nullptr;
+        }
+    }
+
+    /// Called by the backend once buffer `index` is being scanned out
+    void complete_flip(uint32_t index) noexcept {
+        if (!m_pending) return;
+        m_pending = false;
+        m_front = index;
+        ++m_flips;
+        if (m_mode == FlushMode::partial) sync_back();
+        lv_display_flush_ready(get());
+        if (lv_timer_t* t = lv_display_get_refr_timer(get())) lv_timer_resume(t);
+    }
+
+    [[nodiscard]] uint8_t* page(uint32_t index) const noexcept { return m_pages[index]; }
+    [[nodiscard]] uint32_t stride() const noexcept { return m_stride; }
+
+public:
+    PageFlipDisplay(const PageFlipDisplay&) = delete;
+    PageFlipDisplay& operator=(const PageFlipDisplay&) = delete;
+
+    /// Device opened and display created
+    [[nodiscard]] bool ok() const noexcept { return get() != nullptr; }
+
+    [[nodiscard]] FlushMode mode() const noexcept { return m_mode; }
+
+    /// A presented frame is still waiting for vblank
+    [[nodiscard]] bool flip_pending() const noexcept { return m_pending; }
+
+    /// Frames presented so far (in_place: frames drawn)
+    [[nodiscard]] uint32_t flips() const noexcept { return m_flips; }
+
+    /// Index (0/1) of the buffer on screen
+    [[nodiscard]] uint32_t front() const noexcept { return m_front; }
+};
+
+// ==================== Framebuffer ====================
+
+#if LV_USE_LINUX_FBDEV
+/**
+ * @brief fbdev display panning between two halves of a double-height virtual screen
+ *
+ * Needs a driver that accepts yres_virtual = 2 * yres and FBIOPAN_DISPLAY
+ * (most DRM-emulated and SoC framebuffers); ok() is false otherwise.
+ * FlushMode::in_place uses the visible screen as it is and works with any
+ * driver. fbdev
+ * reports no flip completion, so the frame counts as shown one refresh
+ * period (from the video timings, 60 Hz if unknown) after the pan.
+ */
+class FBFlipDisplay : public PageFlipDisplay<FBFlipDisplay> {
+    friend class PageFlipDisplay<FBFlipDisplay>;
+
+    int m_fd = -1;
+    uint8_t* m_map = nullptr;
+    size_t m_map_size = 0;
+    fb_var_screeninfo m_var{};
+    lv_timer_t* m_vsync_timer = nullptr;
+    uint32_t m_queued = 0;
+
+    [[nodiscard]] static uint32_t refresh_period_ms(const fb_var_screeninfo& v) noexcept {
+        const uint64_t htotal = v.xres + v.left_margin + v.right_margin + v.hsync_len;
+        const uint64_t vtotal = v.yres + v.upper_margin + v.lower_margin + v.vsync_len;
+        if (!v.pixclock || !htotal || !vtotal) return 17;
+        const uint64_t us = static_cast<uint64_t>(v.pixclock) * htotal * vtotal / 1000000u;   // pixclock in ps
+        return us >= 1000 ? static_cast<uint32_t>((us + 999) / 1000) : 1;
+    }
+
+    static void vsync_timer_cb(lv_timer_t* t) {
+        auto* self = static_cast<FBFlipDisplay*>(lv_timer_get_user_data(t));
+        lv_timer_pause(t);
+        self->complete_flip(self->m_queued);
+    }
+
+    bool queue_flip(uint32_t index) noexcept {
+        fb_var_screeninfo v = m_var;
+        v.yoffset = index * m_var.yres;
+        if (ioctl(m_fd, FBIOPAN_DISPLAY, &v) != 0) return false;
+        m_queued = index;
+        lv_timer_reset(m_vsync_timer);
+        lv_timer_resume(m_vsync_timer);
+        return true;
+    }
+
+    void wait_flip() noexcept {
+        uint32_t crtc = 0;
+        ioctl(m_fd, FBIO_WAITFORVSYNC, &crtc);   // not all drivers support it; then just proceed
+        lv_timer_pause(m_vsync_timer);
+        complete_flip(m_queued);
+    }
+
+    void close_device() noexcept {
+        if (m_map) munmap(m_map, m_map_size);
+        if (m_fd >= 0) close(m_fd);
+        m_map = nullptr;
+        m_fd = -1;
+    }
+
+public:
+    explicit FBFlipDisplay(const char* device = "/dev/fb0", FlushMode mode = FlushMode::direct) noexcept {
+        m_fd = open(device, O_RDWR | O_CLOEXEC);
+        if (m_fd < 0) {
+            LV_LOG_WARN("cannot open %s", device);
+            return;
+        }
+        fb_fix_screeninfo fix{};
+        if (ioctl(m_fd, FBIOGET_VSCREENINFO, &m_var) != 0 || ioctl(m_fd, FBIOGET_FSCREENINFO, &fix) != 0) {
+            close_device();
+            return;
+        }
+        const uint32_t pages = mode == FlushMode::in_place ? 1 : 2;
+        if (pages == 2) {
+            m_var.yres_virtual = m_var.yres * 2;
+            m_var.yoffset = 0;
+            if (ioctl(m_fd, FBIOPUT_VSCREENINFO, &m_var) != 0 || ioctl(m_fd, FBIOGET_VSCREENINFO, &m_var) != 0 ||
+                m_var.yres_virtual < m_var.yres * 2 || ioctl(m_fd, FBIOGET_FSCREENINFO, &fix) != 0) {
+                LV_LOG_WARN("%s cannot pan a double-height screen", device);
+                close_device();
+                return;
+            }
+        } else if (m_var.yoffset != 0) {
+            m_var.yoffset = 0;       // draw into the page at the top of the virtual screen and show it
+            ioctl(m_fd, FBIOPAN_DISPLAY, &m_var);
+        }
+        lv_color_format_t cf;
+        switch (m_var.bits_per_pixel) {
+        case 16: cf = LV_COLOR_FORMAT_RGB565; break;
+        case 24: cf = LV_COLOR_FORMAT_RGB888; break;
+        case 32: cf = LV_COLOR_FORMAT_XRGB8888; break;
+        default:
+            LV_LOG_WARN("unsupported framebuffer depth %u", static_cast<unsigned>(m_var.bits_per_pixel));
+            close_device();
+            return;
+        }
+        const size_t page_size = static_cast<size_t>(fix.line_length) * m_var.yres;
+        m_map_size = page_size * pages;
+        void* map = mmap(nullptr, m_map_size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+        if (map == MAP_FAILED) {
+            close_device();
+            return;
+        }
+        m_map = static_cast<uint8_t*>(map);
+        m_vsync_timer = lv_timer_create(&FBFlipDisplay::vsync_timer_cb, refresh_period_ms(m_var), this);
+        if (!m_vsync_timer) {
+            close_device();
+            return;
+        }
+        lv_timer_pause(m_vsync_timer);
+        if (!setup(m_map, pages == 2 ? m_map + page_size : nullptr, static_cast<int32_t>(m_var.xres),
+                   static_cast<int32_t>(m_var.yres),
+                   fix.line_length, cf, mode)) {
+            lv_timer_delete(m_vsync_timer);
+            m_vsync_timer = nullptr;
+            close_device();
+        }
+    }
+
+    /// Deletes the display, restores yoffset 0 and unmaps the framebuffer
+    ~FBFlipDisplay() {
+        teardown();
+        if (m_vsync_timer) lv_timer_delete(m_vsync_timer);
+        if (m_fd >= 0) {
+            m_var.yoffset = 0;
+            ioctl(m_fd, FBIOPAN_DISPLAY, &m_var);
+        }
+        close_device();
+    }
+
+    /// Framebuffer file descriptor (-1 if opening failed)
+    [[nodiscard]] int fd() const noexcept { return m_fd; }
+};
+#endif
+
+// ==================== DRM/KMS ====================
+
+#if LV_USE_LINUX_DRM
+/**
+ * @brief DRM/KMS display flipping between two dumb buffers
+ *
+ * Picks the requested (or first connected) connector, its preferred mode
+ * and a CRTC, and presents with drmModePageFlip(DRM_MODE_PAGE_FLIP_EVENT).
+ * Flip events are read by a 1 ms LVGL timer while a flip is pending, or
+ * right away when fd() is watched by an EventLoop (on_readable()).
+ * Uses the legacy KMS API, which every KMS driver supports, rather than
+ * atomic commits. FlushMode::in_place scans out one dumb buffer and never
+ * flips.
+ *
+ * set_mode() and hotplug() switch modes in place: new dumb buffers are
+ * set on the CRTC and handed to the same LVGL display (display_mode.hpp),
+ * so screens are kept and only laid out again. DRMHotplug delivers the
+ * kernel's hot-plug events to hotplug() through an EventLoop.
+ */
+class DRMFlipDisplay : public PageFlipDisplay<DRMFlipDisplay> {
+    friend class PageFlipDisplay<DRMFlipDisplay>;
+
+    struct Buffer {
+        uint32_t handle = 0;
+        uint32_t fb_id = 0;
+        uint32_t pitch = 0;
+        uint64_t size = 0;
+        uint8_t* map = nullptr;
+    };
+
+    int m_fd = -1;
+    uint32_t m_connector = 0;
+    uint32_t m_crtc = 0;
+    drmModeModeInfo m_mode_info{};
+    drmModeCrtc* m_saved_crtc = nullptr;
+    Buffer m_buffers[2];
+    lv_timer_t* m_poll_timer = nullptr;
+    uint32_t m_queued = 0;
+    uint32_t m_bpp = 32;
+    bool m_connected = true;
+    uint32_t m_mode_changes = 0;
+    Buffer m_cursor;                     ///< ARGB8888 cursor plane image (handle only, no FB)
+    uint32_t m_cursor_w = 0, m_cursor_h = 0;
+    int32_t m_hot_x = 0, m_hot_y = 0;
+    lv_indev_t* m_cursor_indev = nullptr;
+
+    static void page_flip_handler(int, unsigned, unsigned, unsigned, void* data) {
+        auto* self = static_cast<DRMFlipDisplay*>(data);
+        self->complete_flip(self->m_queued);
+    }
+
+    /// Read pending DRM events (flip completions)
+    void handle_events() noexcept {
+        drmEventContext ctx{};
+        ctx.version = 2;
+        ctx.page_flip_handler = &DRMFlipDisplay::page_flip_handler;
+        drmHandleEvent(m_fd, &ctx);
+    }
+
+    static void poll_timer_cb(lv_timer_t* t) {
+        auto* self = static_cast<DRMFlipDisplay*>(lv_timer_get_user_data(t));
+        pollfd p{self->m_fd, POLLIN, 0};
+        if (poll(&p, 1, 0) > 0) self->handle_events();
+        if (!self->flip_pending()) lv_timer_pause(t);
+    }
+
+    // in_place: drivers scanning out from a shadow copy (USB, virtual GPUs) need to be told
+    void dirty(const lv_area_t& a) noexcept {
+        drmModeClip clip{static_cast<uint16_t>(a.x1), static_cast<uint16_t>(a.y1), static_cast<uint16_t>(a.x2 + 1),
+                         static_cast<uint16_t>(a.y2 + 1)};
+        drmModeDirtyFB(m_fd, m_buffers[0].fb_id, &clip, 1);   // -ENOSYS where scanout reads the buffer itself
+    }
+
+    bool queue_flip(uint32_t index) noexcept {
+        if (drmModePageFlip(m_fd, m_crtc, m_buffers[index].fb_id, DRM_MODE_PAGE_FLIP_EVENT, this) != 0) {
+            return false;
+        }
+        m_queued = index;
+        lv_timer_resume(m_poll_timer);
+        return true;
+    }
+
+    void wait_flip() noexcept {
+        while (flip_pending()) {
+            pollfd p{m_fd, POLLIN, 0};
+            if (poll(&p, 1, 100) <= 0) break;    // flip lost (e.g. VT switch): do not hang
+            handle_events();
+        }
+        if (flip_pending()) complete_flip(m_queued);
+    }
+
+    bool find_output(int64_t connector_id) noexcept {
+        drmModeRes* res = drmModeGetResources(m_fd);
+        if (!res) return false;
+        drmModeConnector* conn = nullptr;
+        for (int i = 0; i < res->count_connectors && !conn; ++i) {
+            drmModeConnector* c = drmModeGetConnector(m_fd, res->connectors[i]);
+            if (!c) continue;
+            const bool wanted = connector_id < 0 || c->connector_id == static_cast<uint32_t>(connector_id);
+            if (wanted && c->connection == DRM_MODE_CONNECTED && c->count_modes > 0) {
+                conn = c;
+            } else {
+                drmModeFreeConnector(c);
+            }
+        }
+        if (!conn) {
+            drmModeFreeResources(res);
+            return false;
+        }
+        m_connector = conn->connector_id;
+        m_mode_info = preferred_mode(*conn);
+        if (drmModeEncoder* enc = conn->encoder_id ? drmModeGetEncoder(m_fd, conn->encoder_id) : nullptr) {
+            m_crtc = enc->crtc_id;
+            drmModeFreeEncoder(enc);
+        }
+        for (int e = 0; e < conn->count_encoders && !m_crtc; ++e) {
+            drmModeEncoder* enc = drmModeGetEncoder(m_fd, conn->encoders[e]);
+            if (!enc) continue;
+            for (int c = 0; c < res->count_crtcs; ++c) {
+                if (enc->possible_crtcs & (1u << c)) {
+                    m_crtc = res->crtcs[c];
+                    break;
+                }
+            }
+            drmModeFreeEncoder(enc);
+        }
+        drmModeFreeConnector(conn);
+        drmModeFreeResources(res);
+        return m_crtc != 0;
+    }
+
+    [[nodiscard]] static drmModeModeInfo preferred_mode(const drmModeConnector& conn) noexcept {
+        for (int i = 0; i < conn.count_modes; ++i) {
+            if (conn.modes[i].type & DRM_MODE_TYPE_PREFERRED) return conn.modes[i];
+        }
+        return conn.modes[0];
+    }
+
+    bool create_buffer(Buffer& b, uint32_t bpp) noexcept {
+        drm_mode_create_dumb create{};
+        create.width = m_mode_info.hdisplay;
+        create.height = m_mode_info.vdisplay;
+        create.bpp = bpp;
+        if (drmIoctl(m_fd, DRM_IOCTL_MODE_CREATE_DUMB, &create) != 0) return false;
+        b.handle = create.handle;
+        b.pitch = create.pitch;
+        b.size = create.size;
+        if (drmModeAddFB(m_fd, create.width, create.height, bpp == 16 ? 16 : 24, static_cast<uint8_t>(bpp),
+                         b.pitch, b.handle, &b.fb_id) != 0) {
+            return false;
+        }
+        drm_mode_map_dumb map{};
+        map.handle = b.handle;
+        if (drmIoctl(m_fd, DRM_IOCTL_MODE_MAP_DUMB, &map) != 0) return false;
+        void* p = mmap(nullptr, b.size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, static_cast<off_t>(map.offset));
+        if (p == MAP_FAILED) return false;
+        b.map = static_cast<uint8_t*>(p);
+        std::memset(b.map, 0, b.size);
+        return true;
+    }
+
+    void free_buffer(Buffer& b) noexcept {
+        if (b.map) munmap(b.map, b.size);
+        if (b.fb_id) drmModeRmFB(m_fd, b.fb_id);
+        if (b.handle) {
+            drm_mode_destroy_dumb destroy{};
+            destroy.handle = b.handle;
+            drmIoctl(m_fd, DRM_IOCTL_MODE_DESTROY_DUMB, &destroy);
+        }
+        b = Buffer{};
+    }
+
+    static void move_cursor_cb(void* ctx, int32_t x, int32_t y) {
+        auto* self = static_cast<DRMFlipDisplay*>(ctx);
+        drmModeMoveCursor(self->m_fd, self->m_crtc, x - self->m_hot_x, y - self->m_hot_y);
+    }
+
+    /// Put the cursor image back on the CRTC (a mode set may have dropped it)
+    bool show_cursor() noexcept {
+        if (!m_cursor.handle) return false;
+        if (drmModeSetCursor2(m_fd, m_crtc, m_cursor.handle, m_cursor_w, m_cursor_h, m_hot_x, m_hot_y) != 0 &&
+            drmModeSetCursor(m_fd, m_crtc, m_cursor.handle, m_cursor_w, m_cursor_h) != 0) {
+            return false;
+        }
+        if (m_cursor_indev) hw_cursor::repeat(m_cursor_indev);
+        return true;
+    }
+
+    void release() noexcept {
+        hide_cursor();
+        for (Buffer& b : m_buffers) free_buffer(b);
+        if (m_poll_timer) lv_timer_delete(m_poll_timer);
+        m_poll_timer = nullptr;
+        if (m_saved_crtc) drmModeFreeCrtc(m_saved_crtc);
+        m_saved_crtc = nullptr;
+        if (m_fd >= 0) close(m_fd);
+        m_fd = -1;
+    }
+
+public:
+    /**
+     * @param device DRM card node
+     * @param mode How LVGL renders (see FlushMode)
+     * @param connector_id Connector to drive, -1 for the first connected one
+     */
+    explicit DRMFlipDisplay(const char* device = "/dev/dri/card0", FlushMode mode = FlushMode::direct,
+                            int64_t connector_id = -1) noexcept {
+        m_fd = open(device, O_RDWR | O_CLOEXEC);
+        if (m_fd < 0) {
+            LV_LOG_WARN("cannot open %s", device);
+            return;
+        }
+        if (!find_output(connector_id)) {
+            LV_LOG_WARN("no connected output on %s", device);
+            release();
+            return;
+        }
+        m_bpp = LV_COLOR_DEPTH == 16 ? 16 : 32;
+        const lv_color_format_t cf = m_bpp == 16 ? LV_COLOR_FORMAT_RGB565 : LV_COLOR_FORMAT_XRGB8888;
+        if (!create_buffer(m_buffers[0], m_bpp) ||
+            (mode != FlushMode::in_place && !create_buffer(m_buffers[1], m_bpp))) {
+            LV_LOG_WARN("cannot allocate dumb buffers");
+            release();
+            return;
+        }
+        m_saved_crtc = drmModeGetCrtc(m_fd, m_crtc);
+        if (drmModeSetCrtc(m_fd, m_crtc, m_buffers[0].fb_id, 0, 0, &m_connector, 1, &m_mode_info) != 0) {
+            LV_LOG_WARN("cannot set mode on CRTC %u", static_cast<unsigned>(m_crtc));
+            release();
+            return;
+        }
+        m_poll_timer = lv_timer_create(&DRMFlipDisplay::poll_timer_cb, LV_CPP_FLIP_POLL_MS, this);
+        if (!m_poll_timer ||
+            !setup(m_buffers[0].map, m_buffers[1].map, m_mode_info.hdisplay, m_mode_info.vdisplay,
+                   m_buffers[0].pitch, cf, mode)) {
+            release();
+            return;
+        }
+        lv_timer_pause(m_poll_timer);
+    }
+
+    /// Waits for a pending flip, deletes the display and restores the previous CRTC state
+    ~DRMFlipDisplay() {
+        if (flip_pending()) wait_flip();
+        teardown();
+        if (m_saved_crtc && m_fd >= 0) {
+            drmModeSetCrtc(m_fd, m_saved_crtc->crtc_id, m_saved_crtc->buffer_id, m_saved_crtc->x, m_saved_crtc->y,
+                           &m_connector, 1, &m_saved_crtc->mode);
+        }
+        release();
+    }
+
+    /// DRM fd to watch for flip events (-1 if opening failed)
+    [[nodiscard]] int fd() const noexcept { return m_fd; }
+
+    /// EventLoop callback: handle flip events as soon as the fd is readable
+    void on_readable(int, uint32_t) noexcept { handle_events(); }
+
+    [[nodiscard]] uint32_t connector_id() const noexcept { return m_connector; }
+    [[nodiscard]] uint32_t crtc_id() const noexcept { return m_crtc; }
+
+    /// Vertical refresh of the selected mode in Hz
+    [[nodiscard]] uint32_t refresh_rate() const noexcept { return m_mode_info.vrefresh; }
+
+    [[nodiscard]] const drmModeModeInfo& mode_info() const noexcept { return m_mode_info; }
+
+    /// Mode switches made by set_mode() and hotplug()
+    [[nodiscard]] uint32_t mode_changes() const noexcept { return m_mode_changes; }
+
+    /**
+     * @brief Scan out `info` (a mode of the connector) without recreating the LVGL display
+     *
+     * Allocates dumb buffers for the new size, sets them on the CRTC and
+     * hands them to LVGL, then frees the old ones. On failure the old mode
+     * stays.
+     */
+    bool set_mode(const drmModeModeInfo& info) noexcept {
+        if (!ok()) return false;
+        if (flip_pending()) wait_flip();
+        Buffer old[2] = {m_buffers[0], m_buffers[1]};
+        const drmModeModeInfo old_info = m_mode_info;
+        m_buffers[0] = m_buffers[1] = Buffer{};
+        m_mode_info = info;
+        const bool two = mode() != FlushMode::in_place;
+        if (!create_buffer(m_buffers[0], m_bpp) || (two && !create_buffer(m_buffers[1], m_bpp)) ||
+            drmModeSetCrtc(m_fd, m_crtc, m_buffers[0].fb_id, 0, 0, &m_connector, 1, &m_mode_info) != 0) {
+            LV_LOG_WARN("cannot switch to %ux%u", static_cast<unsigned>(info.hdisplay),
+                        static_cast<unsigned>(info.vdisplay));
+            for (Buffer& b : m_buffers) free_buffer(b);
+            m_buffers[0] = old[0];
+            m_buffers[1] = old[1];
+            m_mode_info = old_info;
+            return false;
+        }
+        const bool rebound = rebind(m_buffers[0].map, m_buffers[1].map, info.hdisplay, info.vdisplay,
+                                    m_buffers[0].pitch);
+        for (Buffer& b : old) free_buffer(b);
+        show_cursor();
+        ++m_mode_changes;
+        return rebound;
+    }
+
+    /// set_mode() with the connector's mode of `w` x `h` (and `hz`, 0: any)
+    bool set_mode(uint32_t w, uint32_t h, uint32_t hz = 0) noexcept {
+        drmModeConnector* conn = m_fd >= 0 ? drmModeGetConnector(m_fd, m_connector) : nullptr;
+        if (!conn) return false;
+        bool done = false;
+        for (int i = 0; i < conn->count_modes && !done; ++i) {
+            const drmModeModeInfo& m = conn->modes[i];
+            if (m.hdisplay == w && m.vdisplay == h && (hz == 0 || m.vrefresh == hz)) done = set_mode(m);
+        }
+        drmModeFreeConnector(conn);
+        return done;
+    }
+
+    /**
+     * @brief Probe the connector again after a hot-plug event
+     *
+     * Switches to the preferred mode of a new monitor, and sets the CRTC
+     * again when the same one comes back. While disconnected, LVGL keeps
+     * rendering into the buffers.
+     * @return true if the mode changed
+     */
+    bool hotplug() noexcept {
+        drmModeConnector* conn = m_fd >= 0 ? drmModeGetConnector(m_fd, m_connector) : nullptr;
+        if (!conn) return false;
+        bool changed = false;
+        const bool connected = conn->connection == DRM_MODE_CONNECTED && conn->count_modes > 0;
+        if (connected) {
+            const drmModeModeInfo info = preferred_mode(*conn);
+            if (info.hdisplay != m_mode_info.hdisplay || info.vdisplay != m_mode_info.vdisplay ||
+                info.vrefresh != m_mode_info.vrefresh) {
+                changed = set_mode(info);
+            } else if (!m_connected) {
+                if (flip_pending()) wait_flip();
+                drmModeSetCrtc(m_fd, m_crtc, m_buffers[front()].fb_id, 0, 0, &m_connector, 1, &m_mode_info);
+                show_cursor();
+            }
+        }
+        m_connected = connected;
+        drmModeFreeConnector(conn);
+        return changed;
+    }
+
+    [[nodiscard]] bool connected() const noexcept { return m_connected; }
+
+    // ==================== Cursor plane ====================
+
+    /**
+     * @brief Show `img` on the CRTC's cursor plane and move it with `pointer`
+     *
+     * The cursor is positioned by the hardware: moving it neither
+     * invalidates nor renders anything. `img` must be ARGB8888 and fit the
+     * driver's cursor size (DRM_CAP_CURSOR_WIDTH/HEIGHT, usually 64 x 64);
+     * (hot_x, hot_y) is the pixel that points.
+     * @return false if the image does not qualify or the driver has no
+     *         cursor plane; use lv_indev_set_cursor() then
+     */
+    bool cursor(lv_indev_t* pointer, const lv_image_dsc_t* img, int32_t hot_x = 0, int32_t hot_y = 0) noexcept {
+        if (!ok() || !img || img->header.cf != LV_COLOR_FORMAT_ARGB8888) return false;
+        uint64_t cap_w = 64, cap_h = 64;
+        drmGetCap(m_fd, DRM_CAP_CURSOR_WIDTH, &cap_w);
+        drmGetCap(m_fd, DRM_CAP_CURSOR_HEIGHT, &cap_h);
+        if (img->header.w > cap_w || img->header.h > cap_h) {
+            LV_LOG_WARN("cursor image larger than the %ux%u cursor plane", static_cast<unsigned>(cap_w),
+                        static_cast<unsigned>(cap_h));
+            return false;
+        }
+        hide_cursor();
+        drm_mode_create_dumb create{};
+        create.width = static_cast<uint32_t>(cap_w);
+        create.height = static_cast<uint32_t>(cap_h);
+        create.bpp = 32;
+        if (drmIoctl(m_fd, DRM_IOCTL_MODE_CREATE_DUMB, &create) != 0) return false;
+        m_cursor.handle = create.handle;
+        m_cursor.pitch = create.pitch;
+        m_cursor.size = create.size;
+        drm_mode_map_dumb map{};
+        map.handle = m_cursor.handle;
+        void* p = drmIoctl(m_fd, DRM_IOCTL_MODE_MAP_DUMB, &map) == 0
+                      ? mmap(nullptr, m_cursor.size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd,
+                             static_cast<off_t>(map.offset))
+                      : MAP_FAILED;
+        if (p == MAP_FAILED) {
+            free_buffer(m_cursor);
+            return false;
+        }
+        m_cursor.map = static_cast<uint8_t*>(p);
+        std::memset(m_cursor.map, 0, m_cursor.size);
+        const uint32_t src_stride = img->header.stride ? img->header.stride : img->header.w * 4u;
+        for (uint32_t y = 0; y < img->header.h; ++y) {
+            std::memcpy(m_cursor.map + y * m_cursor.pitch, img->data + y * src_stride, img->header.w * 4u);
+        }
+        m_cursor_w = create.width;
+        m_cursor_h = create.height;
+        m_hot_x = hot_x;
+        m_hot_y = hot_y;
+        if (!show_cursor()) {
+            LV_LOG_WARN("no cursor plane on CRTC %u", static_cast<unsigned>(m_crtc));
+            free_buffer(m_cursor);
+            return false;
+        }
+        m_cursor_indev = pointer;
+        if (pointer) hw_cursor::follow(pointer, &DRMFlipDisplay::move_cursor_cb, this);
+        return true;
+    }
+
+    /// Remove the cursor from the plane and stop following the pointer
+    void hide_cursor() noexcept {
+        if (m_cursor_indev) hw_cursor::unfollow(m_cursor_indev);
+        m_cursor_indev = nullptr;
+        if (!m_cursor.handle) return;
+        drmModeSetCursor(m_fd, m_crtc, 0, 0, 0);
+        free_buffer(m_cursor);
+    }
+
+    [[nodiscard]] bool has_cursor() const noexcept { return m_cursor.handle != 0; }
+};
+
+/**
+ * @brief Kernel hot-plug events (netlink uevents) for a DRMFlipDisplay
+ *
+ * @code
+ * static lv::DRMHotplug hotplug(display);
+ * loop.watch<&lv::DRMHotplug::on_readable>(hotplug.fd(), &hotplug);
+ * @endcode
+ *
+ * Without an EventLoop, call poll() from a timer. Several events arriving
+ * together (a monitor announcing itself in steps) probe the connector once.
+ */
+class DRMHotplug {
+    int m_fd = -1;
+    DRMFlipDisplay* m_display;
+    uint32_t m_events = 0;
+
+public:
+    explicit DRMHotplug(DRMFlipDisplay& display) noexcept : m_display(&display) {
+        m_fd = socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK, NETLINK_KOBJECT_UEVENT);
+        if (m_fd < 0) {
+            LV_LOG_WARN("cannot open uevent socket");
+            return;
+        }
+        sockaddr_nl addr{};
+        addr.nl_family = AF_NETLINK;
+        addr.nl_groups = 1;   // kernel uevents
+        if (::bind(m_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+            close(m_fd);
+            m_fd = -1;
+        }
+    }
+
+    ~DRMHotplug() {
+        if (m_fd >= 0) close(m_fd);
+    }
+
+    DRMHotplug(const DRMHotplug&) = delete;
+    DRMHotplug& operator=(const DRMHotplug&) = delete;
+
+    /// Socket to watch (-1 if it could not be opened)
+    [[nodiscard]] int fd() const noexcept { return m_fd; }
+
+    /// EventLoop callback: read the queued uevents, probe the display on a DRM hot-plug
+    void on_readable(int, uint32_t) noexcept {
+        char msg[2048];
+        bool hotplug = false;
+        for (;;) {
+            const ssize_t n = recv(m_fd, msg, sizeof(msg) - 1, 0);
+            if (n <= 0) break;
+            msg[n] = '\0';
+            bool drm = false, plug = false;
+            for (const char* p = msg; p < msg + n; p += std::strlen(p) + 1) {
+                drm = drm || std::strcmp(p, "SUBSYSTEM=drm") == 0;
+                plug = plug || std::strcmp(p, "HOTPLUG=1") == 0;
+            }
+            hotplug = hotplug || (drm && plug);
+        }
+        if (!hotplug) return;
+        ++m_events;
+        m_display->hotplug();
+    }
+
+    void poll() noexcept {
+        if (m_fd >= 0) on_readable(m_fd, 0);
+    }
+
+    /// Hot-plug events handled
+    [[nodiscard]] uint32_t events() const noexcept { return m_events; }
+};
+#endif
+
+} // namespace lv
+
+#endif // __linux__ && (LV_USE_LINUX_FBDEV || LV_USE_LINUX_DRM)
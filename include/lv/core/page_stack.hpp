@@ -0,0 +1,283 @@
+#pragma once
+
+/**
+ * @file page_stack.hpp
+ * @brief Navigation stack of Components inside one container, obscured pages evictable
+ *
+ * A fragment stack keeps the objects of every pushed fragment alive, so a
+ * settings flow five levels deep holds five pages of widgets that nobody
+ * can see. PageStack stacks Components (or anything with mount(parent),
+ * unmount() and root(), such as lv::FragmentPage) in one container. Only
+ * pages that are on top get built; the page a push covers is hidden, and
+ * covered pages beyond keep(n), or all of them when LVGL's heap use goes
+ * over budget(), are unmounted. Their C++ members (State<T>, scroll
+ * positions saved in on_unmount()) stay, and pop() builds the page again
+ * from them:
+ *
+ * @code
+ * lv::PageStack pages(content);              // content: the area below the title bar
+ * pages.keep(1).budget(96 * 1024);           // at most one covered page stays built
+ * pages.push(settings);                      // lv::Component<Settings>
+ * pages.push(wifi);                          // settings is hidden
+ * pages.push(wifi_detail);                   // settings is unmounted, wifi hidden
+ * pages.pop();                               // wifi shown again
+ * pages.pop();                               // settings rebuilt
+ *
+ * pages.assign(settings, wifi, wifi_detail); // deep link: only wifi_detail is built
+ * @endcode
+ *
+ * lv::memory::budget::add(pages) unmounts every covered page when the
+ * budget manager sheds. Pages must outlive the stack or be popped first;
+ * a page is on the stack at most once.
+ *
+ * Heap allocation: NONE (LV_CPP_PAGE_STACK_DEPTH fixed slots); the pages
+ * allocate what they build
+ */
+
+#include <lvgl.h>
+#include <cstddef>
+#include <cstdint>
+#include "object.hpp"
+#include "thread.hpp"
+
+#ifndef LV_CPP_PAGE_STACK_DEPTH
+/// Maximum PageStack depth
+#define LV_CPP_PAGE_STACK_DEPTH 16
+#endif
+
+namespace lv {
+
+namespace detail {
+
+/// Type-erased page operations used by PageStack
+struct PageOps {
+    void (*mount)(void* page, lv_obj_t* container);
+    void (*unmount)(void* page);
+    lv_obj_t* (*root)(const void* page);
+};
+
+template<typename P>
+inline constexpr PageOps page_ops{
+    [](void* p, lv_obj_t* container) { static_cast<P*>(p)->mount(ObjectView(container)); },
+    [](void* p) { static_cast<P*>(p)->unmount(); },
+    [](const void* p) { return static_cast<const P*>(p)->root().get(); },
+};
+
+} // namespace detail
+
+/**
+ * @brief Stack of pages in a container: the top one shown, covered ones hidden or unmounted
+ *
+ * Non-copyable (two stacks would unmount each other's pages).
+ */
+class PageStack {
+    struct Entry {
+        void* page = nullptr;
+        const detail::PageOps* ops = nullptr;
+        bool evicted = false;      ///< Unmounted while covered, rebuild on the way back
+
+        [[nodiscard]] lv_obj_t* root() const noexcept { return ops->root(page); }
+    };
+
+    Entry m_stack[LV_CPP_PAGE_STACK_DEPTH];
+    uint32_t m_depth = 0;
+    lv_obj_t* m_container = nullptr;
+    size_t m_budget = 0;
+    uint32_t m_keep = UINT32_MAX;
+    uint32_t m_evictions = 0;
+    uint32_t m_rebuilds = 0;
+
+    [[nodiscard]] uint32_t index_of(const void* page) const noexcept {
+        for (uint32_t i = 0; i < m_depth; ++i) {
+            if (m_stack[i].page == page) return i;
+        }
+        return UINT32_MAX;
+    }
+
+    void evict(Entry& e) {
+        e.ops->unmount(e.page);
+        e.evicted = true;
+        ++m_evictions;
+    }
+
+    /// Build the top page if needed and show it
+    [[nodiscard]] lv_obj_t* realize(Entry& e) {
+        lv_obj_t* root = e.root();
+        if (!root) {
+            if (e.evicted) ++m_rebuilds;
+            e.evicted = false;
+            e.ops->mount(e.page, m_container);
+            root = e.root();
+        }
+        if (root) lv_obj_remove_flag(root, LV_OBJ_FLAG_HIDDEN);
+        return root;
+    }
+
+    /// Unmount covered pages beyond keep(), then, over budget, the rest (deepest first)
+    void trim() {
+        uint32_t kept = 0;
+        for (uint32_t i = m_depth - 1; i-- > 0;) {
+            Entry& e = m_stack[i];
+            if (e.root() && ++kept > m_keep) evict(e);
+        }
+        if (!m_budget) return;
+        for (uint32_t i = 0; i + 1 < m_depth && lv_mem_used() > m_budget; ++i) {
+            if (m_stack[i].root()) evict(m_stack[i]);
+        }
+    }
+
+    [[nodiscard]] static size_t lv_mem_used() noexcept {
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+        lv_mem_monitor_t mon;
+        lv_mem_monitor(&mon);
+        return mon.total_size - mon.free_size;
+#else
+        return 0;
+#endif
+    }
+
+public:
+    PageStack() noexcept = default;
+    explicit PageStack(ObjectView container) noexcept : m_container(container.get()) {}
+
+    PageStack(const PageStack&) = delete;
+    PageStack& operator=(const PageStack&) = delete;
+
+    // ==================== Configuration ====================
+
+    /// Container the pages are mounted into
+    PageStack& container(ObjectView c) noexcept {
+        m_container = c.get();
+        return *this;
+    }
+
+    [[nodiscard]] ObjectView container() const noexcept { return ObjectView(m_container); }
+
+    /// Covered pages kept built (default: all); deeper ones are unmounted
+    PageStack& keep(uint32_t n) noexcept {
+        m_keep = n;
+        return *this;
+    }
+
+    /// LVGL heap use above which covered pages are unmounted after a push (0: no limit)
+    PageStack& budget(size_t bytes) noexcept {
+        m_budget = bytes;
+        return *this;
+    }
+
+    // ==================== Navigation ====================
+
+    /**
+     * @brief Build `page` in the container on top of the stack, hiding the previous top
+     *
+     * @return false if the stack is full, the page is already on it or did not build
+     */
+    template<typename P>
+    bool push(P& page) {
+        ui_thread();
+        if (m_depth == LV_CPP_PAGE_STACK_DEPTH) {
+            LV_LOG_WARN("PageStack full, raise LV_CPP_PAGE_STACK_DEPTH");
+            return false;
+        }
+        if (!m_container || index_of(&page) != UINT32_MAX) return false;
+        Entry& e = m_stack[m_depth];
+        e = Entry{&page, &detail::page_ops<P>, false};
+        if (!realize(e)) return false;
+        if (m_depth > 0) {
+            if (lv_obj_t* below = m_stack[m_depth - 1].root()) lv_obj_add_flag(below, LV_OBJ_FLAG_HIDDEN);
+        }
+        ++m_depth;
+        trim();
+        return true;
+    }
+
+    /**
+     * @brief Unmount the top page and show the one below, rebuilding it if it was evicted
+     *
+     * @return false if the stack is empty
+     */
+    bool pop() {
+        ui_thread();
+        if (m_depth == 0) return false;
+        Entry& leaving = m_stack[--m_depth];
+        leaving.ops->unmount(leaving.page);
+        leaving = Entry{};
+        if (m_depth > 0) (void)realize(m_stack[m_depth - 1]);
+        return true;
+    }
+
+    /// Pop until `page` is on top (false if it is not on the stack)
+    template<typename P>
+    bool pop_to(P& page) {
+        const uint32_t i = index_of(&page);
+        if (i == UINT32_MAX) return false;
+        while (m_depth > i + 1) {
+            Entry& leaving = m_stack[--m_depth];
+            leaving.ops->unmount(leaving.page);
+            leaving = Entry{};
+        }
+        (void)realize(m_stack[i]);
+        return true;
+    }
+
+    /**
+     * @brief Replace the stack with `pages` (bottom first), building only the last one
+     *
+     * The others are built when pop() reaches them (deep links, restored
+     * navigation state).
+     */
+    template<typename... P>
+    bool assign(P&... pages) {
+        static_assert(sizeof...(P) > 0 && sizeof...(P) <= LV_CPP_PAGE_STACK_DEPTH, "PageStack::assign: bad page count");
+        clear();
+        ((m_stack[m_depth++] = Entry{&pages, &detail::page_ops<P>, false}), ...);
+        for (uint32_t i = 0; i + 1 < m_depth; ++i) {
+            if (lv_obj_t* root = m_stack[i].root()) lv_obj_add_flag(root, LV_OBJ_FLAG_HIDDEN);
+        }
+        return realize(m_stack[m_depth - 1]) != nullptr;
+    }
+
+    /// Unmount every page and empty the stack
+    void clear() {
+        while (m_depth > 0) {
+            Entry& e = m_stack[--m_depth];
+            e.ops->unmount(e.page);
+            e = Entry{};
+        }
+    }
+
+    /// Unmount every covered page (memory pressure); pop() rebuilds them
+    void evict_covered() {
+        for (uint32_t i = 0; i + 1 < m_depth; ++i) {
+            if (m_stack[i].root()) evict(m_stack[i]);
+        }
+    }
+
+    // ==================== Queries ====================
+
+    [[nodiscard]] uint32_t depth() const noexcept { return m_depth; }
+    [[nodiscard]] bool can_pop() const noexcept { return m_depth > 1; }
+
+    /// Root of the page on top
+    [[nodiscard]] ObjectView current() const noexcept {
+        return m_depth > 0 ? ObjectView(m_stack[m_depth - 1].root()) : ObjectView(nullptr);
+    }
+
+    template<typename P>
+    [[nodiscard]] bool contains(const P& page) const noexcept { return index_of(&page) != UINT32_MAX; }
+
+    /// Pages currently built (the top one included)
+    [[nodiscard]] uint32_t built_count() const noexcept {
+        uint32_t n = 0;
+        for (uint32_t i = 0; i < m_depth; ++i) n += m_stack[i].root() != nullptr;
+        return n;
+    }
+
+    /// Covered pages unmounted so far (keep(), budget() or evict_covered())
+    [[nodiscard]] uint32_t evictions() const noexcept { return m_evictions; }
+
+    /// Evicted pages built again on the way back
+    [[nodiscard]] uint32_t rebuilds() const noexcept { return m_rebuilds; }
+};
+
+} // namespace lv
@@ -0,0 +1,908 @@
+#pragma once
+
+/**
+ * @file pixel.hpp
+ * @brief SIMD pixel conversion kernels and a flush-time conversion hook
+ *
+ * Kernels (scalar, SSE2, AVX2, NEON):
+ * - argb8888_to_rgb565(), optionally with 4x4 ordered dithering
+ * - rgb565_swap() for panels expecting big-endian RGB565
+ * - premultiply() / unpremultiply() of ARGB8888
+ * - copy_opaque(): ARGB8888 copy with alpha forced to 0xFF
+ * - rotate_xrgb8888() / rotate_rgb565() / rotate_xrgb8888_to_rgb565():
+ *   90/180/270° rotation, cache-blocked, fused with the RGB565 conversion
+ *
+ * On x86 the AVX2 variants are picked at runtime (cpuid) unless the build
+ * already targets AVX2; SSE2 is the x86-64 baseline. On ARM, NEON is used
+ * when the compiler targets it (__ARM_NEON). All kernels accept src == dst;
+ * argb8888_to_rgb565() also converts in place (the output is half the size).
+ *
+ * The flush-time conversion and rotation hooks built on them
+ * (convert_on_flush(), rotate_on_flush()) are in pixel_flush.hpp (opt-in).
+ *
+ * Heap allocation: NONE
+ */
+
+#include <lvgl.h>
+#include <cstdint>
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__)) && !defined(LV_CPP_PIXEL_NO_SIMD)
+#define LV_CPP_PIXEL_SSE2 1
+#include <emmintrin.h>
+#if defined(__AVX2__) || defined(__GNUC__) || defined(__clang__)
+#define LV_CPP_PIXEL_AVX2 1
+#include <immintrin.h>
+#endif
+#elif defined(__ARM_NEON) && !defined(LV_CPP_PIXEL_NO_SIMD)
+#define LV_CPP_PIXEL_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace lv {
+
+#ifndef LV_CPP_ROTATE_BLOCK
+/// Edge of the pixel squares the rotate kernels walk (multiple of 8; 32 keeps an ARGB8888 block in 4 KB)
+#define LV_CPP_ROTATE_BLOCK 32
+#endif
+
+namespace pixel {
+
+/// Instruction set the kernels run with on this machine
+enum class Isa : uint8_t { scalar, sse2, avx2, neon };
+
+namespace detail {
+
+// ==================== Scalar Kernels ====================
+
+/// 4x4 Bayer matrix (0..15)
+inline constexpr uint8_t bayer4[4][4] = {
+    {0, 8, 2, 10},
+    {12, 4, 14, 6},
+    {3, 11, 1, 9},
+    {15, 7, 13, 5},
+};
+
+/// Offsets added before truncation for one pixel: B/R by bayer/2, G by bayer/4
+[[nodiscard]] constexpr uint32_t dither_word(uint32_t x, uint32_t y) noexcept {
+    const uint32_t d = bayer4[y & 3][x & 3];
+    return (d >> 1) | ((d >> 2) << 8) | ((d >> 1) << 16);
+}
+
+[[nodiscard]] inline uint32_t load32(const uint8_t* p) noexcept {
+    uint32_t v;
+    std::memcpy(&v, p, 4);
+    return v;
+}
+
+inline void store16(uint8_t* p, uint16_t v) noexcept { std::memcpy(p, &v, 2); }
+inline void store32(uint8_t* p, uint32_t v) noexcept { std::memcpy(p, &v, 4); }
+
+[[nodiscard]] constexpr uint16_t to565(uint32_t c) noexcept {
+    return static_cast<uint16_t>(((c >> 8) & 0xF800) | ((c >> 5) & 0x07E0) | ((c >> 3) & 0x001F));
+}
+
+/// Per-byte saturating add of the dither offsets (alpha untouched)
+[[nodiscard]] constexpr uint32_t add_sat(uint32_t c, uint32_t d) noexcept {
+    uint32_t out = c & 0xFF000000;
+    for (uint32_t shift = 0; shift < 24; shift += 8) {
+        uint32_t v = ((c >> shift) & 0xFF) + ((d >> shift) & 0xFF);
+        out |= (v > 0xFF ? 0xFF : v) << shift;
+    }
+    return out;
+}
+
+/// round(v / 255) for v <= 255 * 255
+[[nodiscard]] constexpr uint32_t div255(uint32_t v) noexcept {
+    v += 128;
+    return (v + (v >> 8)) >> 8;
+}
+
+[[nodiscard]] constexpr uint32_t premul(uint32_t c) noexcept {
+    const uint32_t a = c >> 24;
+    return (c & 0xFF000000) | (div255(((c >> 16) & 0xFF) * a) << 16) |
+           (div255(((c >> 8) & 0xFF) * a) << 8) | div255((c & 0xFF) * a);
+}
+
+[[nodiscard]] constexpr uint32_t unpremul(uint32_t c) noexcept {
+    const uint32_t a = c >> 24;
+    if (a == 0xFF) return c;
+    if (a == 0) return 0;
+    auto ch = [a](uint32_t v) {
+        v = (v * 255 + a / 2) / a;
+        return v > 0xFF ? 0xFFu : v;
+    };
+    return (c & 0xFF000000) | (ch((c >> 16) & 0xFF) << 16) | (ch((c >> 8) & 0xFF) << 8) | ch(c & 0xFF);
+}
+
+inline void to565_scalar(uint8_t* dst, const uint8_t* src, uint32_t n) noexcept {
+    for (uint32_t i = 0; i < n; ++i) store16(dst + 2 * i, to565(load32(src + 4 * i)));
+}
+
+inline void to565_dither_scalar(uint8_t* dst, const uint8_t* src, uint32_t n, uint32_t x, uint32_t y) noexcept {
+    for (uint32_t i = 0; i < n; ++i) {
+        store16(dst + 2 * i, to565(add_sat(load32(src + 4 * i), dither_word(x + i, y))));
+    }
+}
+
+inline void swap565_scalar(uint8_t* buf, uint32_t n) noexcept {
+    for (uint32_t i = 0; i < n; ++i) {
+        const uint8_t lo = buf[2 * i];
+        buf[2 * i] = buf[2 * i + 1];
+        buf[2 * i + 1] = lo;
+    }
+}
+
+inline void premul_scalar(uint8_t* dst, const uint8_t* src, uint32_t n) noexcept {
+    for (uint32_t i = 0; i < n; ++i) store32(dst + 4 * i, premul(load32(src + 4 * i)));
+}
+
+inline void opaque_scalar(uint8_t* dst, const uint8_t* src, uint32_t n) noexcept {
+    for (uint32_t i = 0; i < n; ++i) store32(dst + 4 * i, load32(src + 4 * i) | 0xFF000000);
+}
+
+// ==================== SSE2 ====================
+
+#if LV_CPP_PIXEL_SSE2
+/// 4 ARGB8888 pixels -> 4 RGB565 values in the low 16 bits of each 32-bit lane (sign-extended)
+[[nodiscard]] inline __m128i to565_lanes_sse2(__m128i p) noexcept {
+    const __m128i r = _mm_and_si128(_mm_srli_epi32(p, 8), _mm_set1_epi32(0xF800));
+    const __m128i g = _mm_and_si128(_mm_srli_epi32(p, 5), _mm_set1_epi32(0x07E0));
+    const __m128i b = _mm_and_si128(_mm_srli_epi32(p, 3), _mm_set1_epi32(0x001F));
+    const __m128i v = _mm_or_si128(r, _mm_or_si128(g, b));
+    return _mm_srai_epi32(_mm_slli_epi32(v, 16), 16);    // packs_epi32 is signed
+}
+
+inline void to565_sse2(uint8_t* dst, const uint8_t* src, uint32_t n,
+                       bool dither = false, uint32_t x = 0, uint32_t y = 0) noexcept {
+    alignas(16) uint32_t row[8] = {};
+    if (dither) {
+        for (uint32_t i = 0; i < 8; ++i) row[i] = dither_word(x + i, y);
+    }
+    uint32_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 4 * i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 4 * i + 16));
+        if (dither) {
+            a = _mm_adds_epu8(a, _mm_load_si128(reinterpret_cast<const __m128i*>(row)));
+            b = _mm_adds_epu8(b, _mm_load_si128(reinterpret_cast<const __m128i*>(row + 4)));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 2 * i),
+                         _mm_packs_epi32(to565_lanes_sse2(a), to565_lanes_sse2(b)));
+    }
+    if (dither) {
+        to565_dither_scalar(dst + 2 * i, src + 4 * i, n - i, x + i, y);
+    } else {
+        to565_scalar(dst + 2 * i, src + 4 * i, n - i);
+    }
+}
+
+inline void swap565_sse2(uint8_t* buf, uint32_t n) noexcept {
+    uint32_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i* p = reinterpret_cast<__m128i*>(buf + 2 * i);
+        const __m128i v = _mm_loadu_si128(p);
+        _mm_storeu_si128(p, _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8)));
+    }
+    swap565_scalar(buf + 2 * i, n - i);
+}
+
+/// 2 pixels widened to 16-bit channels, premultiplied
+[[nodiscard]] inline __m128i premul_half_sse2(__m128i c) noexcept {
+    __m128i a = _mm_shufflelo_epi16(c, _MM_SHUFFLE(3, 3, 3, 3));
+    a = _mm_shufflehi_epi16(a, _MM_SHUFFLE(3, 3, 3, 3));
+    // alpha lane multiplied by 255 so div255() returns it unchanged
+    a = _mm_or_si128(_mm_and_si128(a, _mm_set1_epi64x(0x0000FFFFFFFFFFFF)),
+                     _mm_set1_epi64x(static_cast<int64_t>(0x00FF000000000000)));
+    __m128i t = _mm_add_epi16(_mm_mullo_epi16(c, a), _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+}
+
+inline void premul_sse2(uint8_t* dst, const uint8_t* src, uint32_t n) noexcept {
+    const __m128i zero = _mm_setzero_si128();
+    uint32_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 4 * i));
+        const __m128i lo = premul_half_sse2(_mm_unpacklo_epi8(p, zero));
+        const __m128i hi = premul_half_sse2(_mm_unpackhi_epi8(p, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 4 * i), _mm_packus_epi16(lo, hi));
+    }
+    premul_scalar(dst + 4 * i, src + 4 * i, n - i);
+}
+
+inline void opaque_sse2(uint8_t* dst, const uint8_t* src, uint32_t n) noexcept {
+    const __m128i alpha = _mm_set1_epi32(static_cast<int32_t>(0xFF000000));
+    uint32_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 4 * i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 4 * i), _mm_or_si128(p, alpha));
+    }
+    opaque_scalar(dst + 4 * i, src + 4 * i, n - i);
+}
+
+/// Index of the first pixel in [0, n) that is not fully opaque, in steps of 4
+[[nodiscard]] inline uint32_t opaque_prefix_sse2(const uint8_t* src, uint32_t n) noexcept {
+    const __m128i alpha = _mm_set1_epi32(static_cast<int32_t>(0xFF000000));
+    uint32_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 4 * i));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(p, alpha), alpha)) != 0xFFFF) break;
+    }
+    return i;
+}
+#endif
+
+// ==================== AVX2 ====================
+
+#if LV_CPP_PIXEL_AVX2
+#if defined(__AVX2__)
+#define LV_CPP_PIXEL_AVX2_FN inline
+#else
+#define LV_CPP_PIXEL_AVX2_FN __attribute__((target("avx2"))) inline
+#endif
+
+LV_CPP_PIXEL_AVX2_FN __m256i to565_lanes_avx2(__m256i p) noexcept {
+    const __m256i r = _mm256_and_si256(_mm256_srli_epi32(p, 8), _mm256_set1_epi32(0xF800));
+    const __m256i g = _mm256_and_si256(_mm256_srli_epi32(p, 5), _mm256_set1_epi32(0x07E0));
+    const __m256i b = _mm256_and_si256(_mm256_srli_epi32(p, 3), _mm256_set1_epi32(0x001F));
+    const __m256i v = _mm256_or_si256(r, _mm256_or_si256(g, b));
+    return _mm256_srai_epi32(_mm256_slli_epi32(v, 16), 16);
+}
+
+LV_CPP_PIXEL_AVX2_FN void to565_avx2(uint8_t* dst, const uint8_t* src, uint32_t n,
+                                     bool dither = false, uint32_t x = 0, uint32_t y = 0) noexcept {
+    alignas(32) uint32_t row[8] = {};
+    if (dither) {
+        for (uint32_t i = 0; i < 8; ++i) row[i] = dither_word(x + i, y);
+    }
+    const __m256i d = _mm256_load_si256(reinterpret_cast<const __m256i*>(row));
+    uint32_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 4 * i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 4 * i + 32));
+        if (dither) {
+            a = _mm256_adds_epu8(a, d);
+            b = _mm256_adds_epu8(b, d);
+        }
+        // packs works per 128-bit lane: a0 b0 a1 b1 -> a0 a1 b0 b1
+        const __m256i v = _mm256_packs_epi32(to565_lanes_avx2(a), to565_lanes_avx2(b));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 2 * i), _mm256_permute4x64_epi64(v, 0xD8));
+    }
+    if (dither) {
+        to565_dither_scalar(dst + 2 * i, src + 4 * i, n - i, x + i, y);
+    } else {
+        to565_scalar(dst + 2 * i, src + 4 * i, n - i);
+    }
+}
+
+LV_CPP_PIXEL_AVX2_FN void swap565_avx2(uint8_t* buf, uint32_t n) noexcept {
+    uint32_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256i* p = reinterpret_cast<__m256i*>(buf + 2 * i);
+        const __m256i v = _mm256_loadu_si256(p);
+        _mm256_storeu_si256(p, _mm256_or_si256(_mm256_slli_epi16(v, 8), _mm256_srli_epi16(v, 8)));
+    }
+    swap565_scalar(buf + 2 * i, n - i);
+}
+
+LV_CPP_PIXEL_AVX2_FN __m256i premul_half_avx2(__m256i c) noexcept {
+    __m256i a = _mm256_shufflelo_epi16(c, _MM_SHUFFLE(3, 3, 3, 3));
+    a = _mm256_shufflehi_epi16(a, _MM_SHUFFLE(3, 3, 3, 3));
+    a = _mm256_or_si256(_mm256_and_si256(a, _mm256_set1_epi64x(0x0000FFFFFFFFFFFF)),
+                        _mm256_set1_epi64x(static_cast<int64_t>(0x00FF000000000000)));
+    __m256i t = _mm256_add_epi16(_mm256_mullo_epi16(c, a), _mm256_set1_epi16(128));
+    return _mm256_srli_epi16(_mm256_add_epi16(t, _mm256_srli_epi16(t, 8)), 8);
+}
+
+LV_CPP_PIXEL_AVX2_FN void premul_avx2(uint8_t* dst, const uint8_t* src, uint32_t n) noexcept {
+    const __m256i zero = _mm256_setzero_si256();
+    uint32_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        // unpack and pack are both per 128-bit lane, so pixel order is preserved
+        const __m256i p = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 4 * i));
+        const __m256i lo = premul_half_avx2(_mm256_unpacklo_epi8(p, zero));
+        const __m256i hi = premul_half_avx2(_mm256_unpackhi_epi8(p, zero));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 4 * i), _mm256_packus_epi16(lo, hi));
+    }
+    premul_sse2(dst + 4 * i, src + 4 * i, n - i);
+}
+
+LV_CPP_PIXEL_AVX2_FN void opaque_avx2(uint8_t* dst, const uint8_t* src, uint32_t n) noexcept {
+    const __m256i alpha = _mm256_set1_epi32(static_cast<int32_t>(0xFF000000));
+    uint32_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256i p = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 4 * i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 4 * i), _mm256_or_si256(p, alpha));
+    }
+    opaque_sse2(dst + 4 * i, src + 4 * i, n - i);
+}
+
+#undef LV_CPP_PIXEL_AVX2_FN
+#endif
+
+// ==================== NEON ====================
+
+#if LV_CPP_PIXEL_NEON
+inline void to565_neon(uint8_t* dst, const uint8_t* src, uint32_t n,
+                       bool dither = false, uint32_t x = 0, uint32_t y = 0) noexcept {
+    uint8x8_t d5 = vdup_n_u8(0);
+    uint8x8_t d6 = vdup_n_u8(0);
+    if (dither) {
+        uint8_t five[8];
+        uint8_t six[8];
+        for (uint32_t i = 0; i < 8; ++i) {
+            const uint32_t w = dither_word(x + i, y);
+            five[i] = static_cast<uint8_t>(w & 0xFF);
+            six[i] = static_cast<uint8_t>((w >> 8) & 0xFF);
+        }
+        d5 = vld1_u8(five);
+        d6 = vld1_u8(six);
+    }
+    uint32_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        uint8x8x4_t p = vld4_u8(src + 4 * i);     // planes b, g, r, a
+        if (dither) {
+            p.val[0] = vqadd_u8(p.val[0], d5);
+            p.val[1] = vqadd_u8(p.val[1], d6);
+            p.val[2] = vqadd_u8(p.val[2], d5);
+        }
+        uint16x8_t v = vshll_n_u8(p.val[2], 8);
+        v = vsriq_n_u16(v, vshll_n_u8(p.val[1], 8), 5);
+        v = vsriq_n_u16(v, vshll_n_u8(p.val[0], 8), 11);
+        vst1q_u8(dst + 2 * i, vreinterpretq_u8_u16(v));
+    }
+    if (dither) {
+        to565_dither_scalar(dst + 2 * i, src + 4 * i, n - i, x + i, y);
+    } else {
+        to565_scalar(dst + 2 * i, src + 4 * i, n - i);
+    }
+}
+
+inline void swap565_neon(uint8_t* buf, uint32_t n) noexcept {
+    uint32_t i = 0;
+    for (; i + 8 <= n; i += 8) vst1q_u8(buf + 2 * i, vrev16q_u8(vld1q_u8(buf + 2 * i)));
+    swap565_scalar(buf + 2 * i, n - i);
+}
+
+[[nodiscard]] inline uint8x8_t premul_plane_neon(uint8x8_t c, uint8x8_t a) noexcept {
+    const uint16x8_t t = vmull_u8(c, a);
+    return vraddhn_u16(t, vrshrq_n_u16(t, 8));    // round(t / 255)
+}
+
+inline void premul_neon(uint8_t* dst, const uint8_t* src, uint32_t n) noexcept {
+    uint32_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        uint8x8x4_t p = vld4_u8(src + 4 * i);
+        p.val[0] = premul_plane_neon(p.val[0], p.val[3]);
+        p.val[1] = premul_plane_neon(p.val[1], p.val[3]);
+        p.val[2] = premul_plane_neon(p.val[2], p.val[3]);
+        vst4_u8(dst + 4 * i, p);
+    }
+    premul_scalar(dst + 4 * i, src + 4 * i, n - i);
+}
+
+inline void opaque_neon(uint8_t* dst, const uint8_t* src, uint32_t n) noexcept {
+    const uint32x4_t alpha = vdupq_n_u32(0xFF000000);
+    uint32_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const uint32x4_t p = vreinterpretq_u32_u8(vld1q_u8(src + 4 * i));
+        vst1q_u8(dst + 4 * i, vreinterpretq_u8_u32(vorrq_u32(p, alpha)));
+    }
+    opaque_scalar(dst + 4 * i, src + 4 * i, n - i);
+}
+#endif
+
+// ==================== Dispatch ====================
+
+[[nodiscard]] inline Isa detect_isa() noexcept {
+#if LV_CPP_PIXEL_AVX2 && defined(__AVX2__)
+    return Isa::avx2;
+#elif LV_CPP_PIXEL_AVX2
+    return __builtin_cpu_supports("avx2") ? Isa::avx2 : Isa::sse2;
+#elif LV_CPP_PIXEL_SSE2
+    return Isa::sse2;
+#elif LV_CPP_PIXEL_NEON
+    return Isa::neon;
+#else
+    return Isa::scalar;
+#endif
+}
+
+/// Selected instruction set (detected once; force() overrides it for testing)
+[[nodiscard]] inline Isa& active_isa() noexcept {
+    static Isa isa = detect_isa();
+    return isa;
+}
+
+} // namespace detail
+
+/// Instruction set the kernels currently use
+[[nodiscard]] inline Isa isa() noexcept { return detail::active_isa(); }
+
+/**
+ * @brief Restrict the kernels to a lower instruction set (benchmarks, tests)
+ * @return false if `isa` is not available on this machine or build
+ */
+inline bool force_isa(Isa isa) noexcept {
+    const Isa best = detail::detect_isa();
+    const bool ok = isa == Isa::scalar || isa == best || (isa == Isa::sse2 && best == Isa::avx2);
+    if (ok) detail::active_isa() = isa;
+    return ok;
+}
+
+// ==================== Kernels ====================
+
+/// Convert `n` ARGB8888/XRGB8888 pixels to RGB565 (dst may equal src)
+inline void argb8888_to_rgb565(uint8_t* dst, const uint8_t* src, uint32_t n) noexcept {
+    switch (isa()) {
+#if LV_CPP_PIXEL_AVX2
+    case Isa::avx2: detail::to565_avx2(dst, src, n); return;
+#endif
+#if LV_CPP_PIXEL_SSE2
+    case Isa::sse2: detail::to565_sse2(dst, src, n); return;
+#endif
+#if LV_CPP_PIXEL_NEON
+    case Isa::neon: detail::to565_neon(dst, src, n); return;
+#endif
+    default: detail::to565_scalar(dst, src, n); return;
+    }
+}
+
+/**
+ * @brief Convert one row to RGB565 with 4x4 ordered dithering
+ *
+ * @param x, y Screen position of the first pixel (selects the dither phase)
+ */
+inline void argb8888_to_rgb565_dither(uint8_t* dst, const uint8_t* src, uint32_t n,
+                                      uint32_t x, uint32_t y) noexcept {
+    switch (isa()) {
+#if LV_CPP_PIXEL_AVX2
+    case Isa::avx2: detail::to565_avx2(dst, src, n, true, x, y); return;
+#endif
+#if LV_CPP_PIXEL_SSE2
+    case Isa::sse2: detail::to565_sse2(dst, src, n, true, x, y); return;
+#endif
+#if LV_CPP_PIXEL_NEON
+    case Isa::neon: detail::to565_neon(dst, src, n, true, x, y); return;
+#endif
+    default: detail::to565_dither_scalar(dst, src, n, x, y); return;
+    }
+}
+
+/// Swap the bytes of `n` RGB565 pixels in place
+inline void rgb565_swap(uint8_t* buf, uint32_t n) noexcept {
+    switch (isa()) {
+#if LV_CPP_PIXEL_AVX2
+    case Isa::avx2: detail::swap565_avx2(buf, n); return;
+#endif
+#if LV_CPP_PIXEL_SSE2
+    case Isa::sse2: detail::swap565_sse2(buf, n); return;
+#endif
+#if LV_CPP_PIXEL_NEON
+    case Isa::neon: detail::swap565_neon(buf, n); return;
+#endif
+    default: detail::swap565_scalar(buf, n); return;
+    }
+}
+
+/// Multiply the color channels of `n` ARGB8888 pixels by their alpha (dst may equal src)
+inline void premultiply(uint8_t* dst, const uint8_t* src, uint32_t n) noexcept {
+    switch (isa()) {
+#if LV_CPP_PIXEL_AVX2
+    case Isa::avx2: detail::premul_avx2(dst, src, n); return;
+#endif
+#if LV_CPP_PIXEL_SSE2
+    case Isa::sse2: detail::premul_sse2(dst, src, n); return;
+#endif
+#if LV_CPP_PIXEL_NEON
+    case Isa::neon: detail::premul_neon(dst, src, n); return;
+#endif
+    default: detail::premul_scalar(dst, src, n); return;
+    }
+}
+
+/**
+ * @brief Divide the color channels of `n` premultiplied ARGB8888 pixels by alpha
+ *
+ * Division has no SIMD form; runs of opaque pixels are skipped (SSE2) or
+ * copied, the rest is scalar.
+ */
+inline void unpremultiply(uint8_t* dst, const uint8_t* src, uint32_t n) noexcept {
+    uint32_t i = 0;
+    while (i < n) {
+#if LV_CPP_PIXEL_SSE2
+        if (isa() != Isa::scalar) {
+            const uint32_t run = detail::opaque_prefix_sse2(src + 4 * i, n - i);
+            if (run) {
+                if (dst != src) std::memmove(dst + 4 * i, src + 4 * i, 4 * run);
+                i += run;
+                continue;
+            }
+        }
+#endif
+        detail::store32(dst + 4 * i, detail::unpremul(detail::load32(src + 4 * i)));
+        ++i;
+    }
+}
+
+/// Copy `n` ARGB8888 pixels with alpha forced to 0xFF (dst may equal src)
+inline void copy_opaque(uint8_t* dst, const uint8_t* src, uint32_t n) noexcept {
+    switch (isa()) {
+#if LV_CPP_PIXEL_AVX2
+    case Isa::avx2: detail::opaque_avx2(dst, src, n); return;
+#endif
+#if LV_CPP_PIXEL_SSE2
+    case Isa::sse2: detail::opaque_sse2(dst, src, n); return;
+#endif
+#if LV_CPP_PIXEL_NEON
+    case Isa::neon: detail::opaque_neon(dst, src, n); return;
+#endif
+    default: detail::opaque_scalar(dst, src, n); return;
+    }
+}
+
+// ==================== Rotation ====================
+
+namespace detail {
+
+/// What one rotate job reads and writes
+enum class RotKind : uint8_t { xrgb8888, rgb565, xrgb8888_to_rgb565 };
+
+/// Destination column/row of a pixel
+struct RotPos {
+    uint32_t x, y;
+};
+
+/// Where source pixel (x, y) of a w x h area lands; the lv_draw_sw_rotate() mapping
+[[nodiscard]] constexpr RotPos rotate_pos(lv_display_rotation_t rot, uint32_t w, uint32_t h,
+                                          uint32_t x, uint32_t y) noexcept {
+    switch (rot) {
+    case LV_DISPLAY_ROTATION_90: return {h - 1 - y, x};
+    case LV_DISPLAY_ROTATION_180: return {w - 1 - x, h - 1 - y};
+    case LV_DISPLAY_ROTATION_270: return {y, w - 1 - x};
+    default: return {x, y};
+    }
+}
+
+struct RotJob {
+    uint8_t* dst;
+    uint32_t dst_stride;
+    const uint8_t* src;
+    uint32_t src_stride;
+    uint32_t w, h;    ///< Source size
+    lv_display_rotation_t rot;
+    bool dither, swap;
+    uint32_t x, y;    ///< Screen position of the destination's first pixel (dither phase)
+    /// dither_word() rows, 8 wide so 4 lanes can be loaded from any phase
+    alignas(16) uint32_t dither_tab[4][8];
+};
+
+/// Pixels [x0, x1) x [y0, y1) one at a time (tile edges, scalar builds)
+template <RotKind K>
+inline void rotate_px_scalar(const RotJob& j, uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1) noexcept {
+    constexpr uint32_t sbpp = K == RotKind::rgb565 ? 2 : 4;
+    constexpr uint32_t dbpp = K == RotKind::xrgb8888 ? 4 : 2;
+    for (uint32_t y = y0; y < y1; ++y) {
+        const uint8_t* s = j.src + y * j.src_stride + x0 * sbpp;
+        for (uint32_t x = x0; x < x1; ++x, s += sbpp) {
+            const RotPos p = rotate_pos(j.rot, j.w, j.h, x, y);
+            uint8_t* d = j.dst + p.y * j.dst_stride + p.x * dbpp;
+            if constexpr (K == RotKind::xrgb8888) {
+                store32(d, load32(s));
+            } else {
+                uint16_t v;
+                if constexpr (K == RotKind::rgb565) {
+                    std::memcpy(&v, s, 2);
+                } else {
+                    uint32_t c = load32(s);
+                    if (j.dither) c = add_sat(c, dither_word(j.x + p.x, j.y + p.y));
+                    v = to565(c);
+                }
+                if (j.swap) v = static_cast<uint16_t>((v << 8) | (v >> 8));
+                store16(d, v);
+            }
+        }
+    }
+}
+
+/// Square tile edge handled by the SIMD paths: 4 ARGB8888 or 8 RGB565 pixels (one 128-bit row)
+template <RotKind K>
+inline constexpr uint32_t rot_tile = K == RotKind::rgb565 ? 8 : 4;
+
+/**
+ * Walk the area in LV_CPP_ROTATE_BLOCK squares so the source rows and the
+ * destination rows of a block stay in L1 (a naive column walk of a 90°
+ * rotation misses the cache on every destination write). Full tiles go to
+ * `tile`, ragged edges to the scalar loop.
+ */
+template <RotKind K, typename Tile>
+inline void rotate_blocked(const RotJob& j, Tile tile) noexcept {
+    constexpr uint32_t B = LV_CPP_ROTATE_BLOCK;
+    constexpr uint32_t T = rot_tile<K>;
+    static_assert(B % 8 == 0, "LV_CPP_ROTATE_BLOCK must be a multiple of 8");
+    for (uint32_t by = 0; by < j.h; by += B) {
+        const uint32_t ye = by + B < j.h ? by + B : j.h;
+        for (uint32_t bx = 0; bx < j.w; bx += B) {
+            const uint32_t xe = bx + B < j.w ? bx + B : j.w;
+            uint32_t y = by;
+            for (; y + T <= ye; y += T) {
+                uint32_t x = bx;
+                for (; x + T <= xe; x += T) tile(j, x, y);
+                rotate_px_scalar<K>(j, x, y, xe, y + T);
+            }
+            rotate_px_scalar<K>(j, bx, y, xe, ye);
+        }
+    }
+}
+
+template <RotKind K>
+inline void rotate_tile_scalar(const RotJob& j, uint32_t x, uint32_t y) noexcept {
+    rotate_px_scalar<K>(j, x, y, x + rot_tile<K>, y + rot_tile<K>);
+}
+
+#if LV_CPP_PIXEL_SSE2
+[[nodiscard]] inline __m128i load128(const uint8_t* p) noexcept {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+}
+
+/// In: 4 rows of 4 32-bit pixels. Out: the 4 columns
+inline void transpose4_sse2(__m128i r[4]) noexcept {
+    const __m128i t0 = _mm_unpacklo_epi32(r[0], r[1]);
+    const __m128i t1 = _mm_unpacklo_epi32(r[2], r[3]);
+    const __m128i t2 = _mm_unpackhi_epi32(r[0], r[1]);
+    const __m128i t3 = _mm_unpackhi_epi32(r[2], r[3]);
+    r[0] = _mm_unpacklo_epi64(t0, t1);
+    r[1] = _mm_unpackhi_epi64(t0, t1);
+    r[2] = _mm_unpacklo_epi64(t2, t3);
+    r[3] = _mm_unpackhi_epi64(t2, t3);
+}
+
+/// In: 8 rows of 8 16-bit pixels. Out: the 8 columns
+inline void transpose8_sse2(__m128i r[8]) noexcept {
+    __m128i t[8];
+    for (uint32_t i = 0; i < 4; ++i) {
+        t[2 * i] = _mm_unpacklo_epi16(r[2 * i], r[2 * i + 1]);
+        t[2 * i + 1] = _mm_unpackhi_epi16(r[2 * i], r[2 * i + 1]);
+    }
+    const __m128i u0 = _mm_unpacklo_epi32(t[0], t[2]);
+    const __m128i u1 = _mm_unpackhi_epi32(t[0], t[2]);
+    const __m128i u2 = _mm_unpacklo_epi32(t[1], t[3]);
+    const __m128i u3 = _mm_unpackhi_epi32(t[1], t[3]);
+    const __m128i u4 = _mm_unpacklo_epi32(t[4], t[6]);
+    const __m128i u5 = _mm_unpackhi_epi32(t[4], t[6]);
+    const __m128i u6 = _mm_unpacklo_epi32(t[5], t[7]);
+    const __m128i u7 = _mm_unpackhi_epi32(t[5], t[7]);
+    r[0] = _mm_unpacklo_epi64(u0, u4);
+    r[1] = _mm_unpackhi_epi64(u0, u4);
+    r[2] = _mm_unpacklo_epi64(u1, u5);
+    r[3] = _mm_unpackhi_epi64(u1, u5);
+    r[4] = _mm_unpacklo_epi64(u2, u6);
+    r[5] = _mm_unpackhi_epi64(u2, u6);
+    r[6] = _mm_unpacklo_epi64(u3, u7);
+    r[7] = _mm_unpackhi_epi64(u3, u7);
+}
+
+[[nodiscard]] inline __m128i reverse16_sse2(__m128i v) noexcept {
+    v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+    v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+    return _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+}
+
+/**
+ * Rotate the T x T tile at (x, y) in registers: r[i] becomes the run of
+ * destination pixels starting at at[i]. For 90° the rows are loaded
+ * bottom-up so the transposed columns already run in destination order.
+ */
+template <RotKind K>
+inline void tile_rows_sse2(const RotJob& j, uint32_t x, uint32_t y, __m128i* r, RotPos* at) noexcept {
+    constexpr uint32_t T = rot_tile<K>;
+    constexpr uint32_t bpp = K == RotKind::rgb565 ? 2 : 4;
+    const uint8_t* s = j.src + y * j.src_stride + bpp * x;
+    switch (j.rot) {
+    case LV_DISPLAY_ROTATION_90:
+        for (uint32_t i = 0; i < T; ++i) {
+            r[i] = load128(s + (T - 1 - i) * j.src_stride);
+            at[i] = {j.h - T - y, x + i};
+        }
+        break;
+    case LV_DISPLAY_ROTATION_270:
+        for (uint32_t i = 0; i < T; ++i) {
+            r[i] = load128(s + i * j.src_stride);
+            at[i] = {y, j.w - 1 - x - i};
+        }
+        break;
+    default:    // 180: reverse each row
+        for (uint32_t i = 0; i < T; ++i) {
+            const __m128i v = load128(s + i * j.src_stride);
+            r[i] = bpp == 2 ? reverse16_sse2(v) : _mm_shuffle_epi32(v, _MM_SHUFFLE(0, 1, 2, 3));
+            at[i] = {j.w - T - x, j.h - 1 - y - i};
+        }
+        return;
+    }
+    if constexpr (T == 8) {
+        transpose8_sse2(r);
+    } else {
+        transpose4_sse2(r);
+    }
+}
+
+template <RotKind K>
+inline void rotate_tile_sse2(const RotJob& j, uint32_t x, uint32_t y) noexcept {
+    constexpr uint32_t T = rot_tile<K>;
+    __m128i r[T];
+    RotPos at[T];
+    tile_rows_sse2<K>(j, x, y, r, at);
+    for (uint32_t i = 0; i < T; ++i) {
+        if constexpr (K == RotKind::xrgb8888) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(j.dst + at[i].y * j.dst_stride + 4 * at[i].x), r[i]);
+        } else {
+            __m128i v = r[i];
+            if constexpr (K == RotKind::xrgb8888_to_rgb565) {
+                if (j.dither) {
+                    const uint32_t* d = &j.dither_tab[(j.y + at[i].y) & 3][(j.x + at[i].x) & 3];
+                    v = _mm_adds_epu8(v, _mm_loadu_si128(reinterpret_cast<const __m128i*>(d)));
+                }
+                v = _mm_packs_epi32(to565_lanes_sse2(v), _mm_setzero_si128());
+            }
+            if (j.swap) v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+            uint8_t* d = j.dst + at[i].y * j.dst_stride + 2 * at[i].x;
+            if constexpr (K == RotKind::rgb565) {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(d), v);
+            } else {
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(d), v);
+            }
+        }
+    }
+}
+#endif
+
+#if LV_CPP_PIXEL_NEON
+/// In: 4 rows of 4 32-bit pixels. Out: the 4 columns
+inline void transpose4_neon(uint32x4_t r[4]) noexcept {
+    const uint32x4x2_t a = vtrnq_u32(r[0], r[1]);
+    const uint32x4x2_t b = vtrnq_u32(r[2], r[3]);
+    r[0] = vcombine_u32(vget_low_u32(a.val[0]), vget_low_u32(b.val[0]));
+    r[1] = vcombine_u32(vget_low_u32(a.val[1]), vget_low_u32(b.val[1]));
+    r[2] = vcombine_u32(vget_high_u32(a.val[0]), vget_high_u32(b.val[0]));
+    r[3] = vcombine_u32(vget_high_u32(a.val[1]), vget_high_u32(b.val[1]));
+}
+
+/// 32-bit sources only; RGB565 rotation stays on the blocked scalar path on ARM
+template <RotKind K>
+inline void rotate_tile_neon(const RotJob& j, uint32_t x, uint32_t y) noexcept {
+    const uint8_t* s = j.src + y * j.src_stride + 4 * x;
+    uint32x4_t r[4];
+    RotPos at[4];
+    switch (j.rot) {
+    case LV_DISPLAY_ROTATION_90:
+        for (uint32_t i = 0; i < 4; ++i) {
+            r[i] = vreinterpretq_u32_u8(vld1q_u8(s + (3 - i) * j.src_stride));
+            at[i] = {j.h - 4 - y, x + i};
+        }
+        transpose4_neon(r);
+        break;
+    case LV_DISPLAY_ROTATION_270:
+        for (uint32_t i = 0; i < 4; ++i) {
+            r[i] = vreinterpretq_u32_u8(vld1q_u8(s + i * j.src_stride));
+            at[i] = {y, j.w - 1 - x - i};
+        }
+        transpose4_neon(r);
+        break;
+    default:
+        for (uint32_t i = 0; i < 4; ++i) {
+            const uint32x4_t v = vrev64q_u32(vreinterpretq_u32_u8(vld1q_u8(s + i * j.src_stride)));
+            r[i] = vcombine_u32(vget_high_u32(v), vget_low_u32(v));
+            at[i] = {j.w - 4 - x, j.h - 1 - y - i};
+        }
+        break;
+    }
+    for (uint32_t i = 0; i < 4; ++i) {
+        if constexpr (K == RotKind::xrgb8888) {
+            vst1q_u8(j.dst + at[i].y * j.dst_stride + 4 * at[i].x, vreinterpretq_u8_u32(r[i]));
+        } else {
+            uint32x4_t v = r[i];
+            if (j.dither) {
+                const uint32_t* d = &j.dither_tab[(j.y + at[i].y) & 3][(j.x + at[i].x) & 3];
+                v = vreinterpretq_u32_u8(vqaddq_u8(vreinterpretq_u8_u32(v), vreinterpretq_u8_u32(vld1q_u32(d))));
+            }
+            const uint32x4_t c = vorrq_u32(vandq_u32(vshrq_n_u32(v, 8), vdupq_n_u32(0xF800)),
+                                           vorrq_u32(vandq_u32(vshrq_n_u32(v, 5), vdupq_n_u32(0x07E0)),
+                                                     vandq_u32(vshrq_n_u32(v, 3), vdupq_n_u32(0x001F))));
+            uint8x8_t p = vreinterpret_u8_u16(vmovn_u32(c));
+            if (j.swap) p = vrev16_u8(p);
+            vst1_u8(j.dst + at[i].y * j.dst_stride + 2 * at[i].x, p);
+        }
+    }
+}
+#endif
+
+template <RotKind K>
+inline void rotate(RotJob& j) noexcept {
+    if (j.w == 0 || j.h == 0) return;
+    if (K == RotKind::xrgb8888_to_rgb565 && j.dither) {
+        for (uint32_t y = 0; y < 4; ++y) {
+            for (uint32_t x = 0; x < 8; ++x) j.dither_tab[y][x] = dither_word(x, y);
+        }
+    }
+    switch (isa()) {
+#if LV_CPP_PIXEL_SSE2
+    case Isa::avx2:    // a 128-bit row is one tile row; AVX2 buys nothing here
+    case Isa::sse2: rotate_blocked<K>(j, &rotate_tile_sse2<K>); return;
+#endif
+#if LV_CPP_PIXEL_NEON
+    case Isa::neon:
+        if constexpr (K != RotKind::rgb565) {
+            rotate_blocked<K>(j, &rotate_tile_neon<K>);
+            return;
+        }
+        break;
+#endif
+    default: break;
+    }
+    rotate_blocked<K>(j, &rotate_tile_scalar<K>);
+}
+
+} // namespace detail
+
+/**
+ * @brief Rotate a w x h ARGB8888/XRGB8888 area into `dst`
+ *
+ * Same mapping as lv_draw_sw_rotate(): for 90° and 270° `dst` is h pixels
+ * wide and w rows tall. Cache-blocked, with SSE2/NEON 4x4 transposes.
+ * `dst` must not overlap `src`.
+ */
+inline void rotate_xrgb8888(uint8_t* dst, uint32_t dst_stride, const uint8_t* src, uint32_t src_stride,
+                            uint32_t w, uint32_t h, lv_display_rotation_t rot) noexcept {
+    if (rot == LV_DISPLAY_ROTATION_0) {
+        for (uint32_t y = 0; y < h; ++y) std::memcpy(dst + y * dst_stride, src + y * src_stride, 4 * w);
+        return;
+    }
+    detail::RotJob j{dst, dst_stride, src, src_stride, w, h, rot, false, false, 0, 0, {}};
+    detail::rotate<detail::RotKind::xrgb8888>(j);
+}
+
+/// Rotate a w x h RGB565 area into `dst`, optionally byte-swapping it on the way (SSE2 8x8 transposes)
+inline void rotate_rgb565(uint8_t* dst, uint32_t dst_stride, const uint8_t* src, uint32_t src_stride,
+                          uint32_t w, uint32_t h, lv_display_rotation_t rot, bool swap = false) noexcept {
+    if (rot == LV_DISPLAY_ROTATION_0) {
+        for (uint32_t y = 0; y < h; ++y) {
+            std::memcpy(dst + y * dst_stride, src + y * src_stride, 2 * w);
+            if (swap) rgb565_swap(dst + y * dst_stride, w);
+        }
+        return;
+    }
+    detail::RotJob j{dst, dst_stride, src, src_stride, w, h, rot, false, swap, 0, 0, {}};
+    detail::rotate<detail::RotKind::rgb565>(j);
+}
+
+/**
+ * @brief Rotate and convert to RGB565 in one pass (optionally dithered and byte-swapped)
+ *
+ * Each source pixel is read once and written once, so a rotated RGB565
+ * panel costs no more memory traffic than an unrotated conversion.
+ *
+ * @param x, y Screen position of the first destination pixel (dither phase)
+ */
+inline void rotate_xrgb8888_to_rgb565(uint8_t* dst, uint32_t dst_stride, const uint8_t* src,
+                                      uint32_t src_stride, uint32_t w, uint32_t h,
+                                      lv_display_rotation_t rot, bool dither = false, bool swap = false,
+                                      uint32_t x = 0, uint32_t y = 0) noexcept {
+    if (rot == LV_DISPLAY_ROTATION_0) {
+        for (uint32_t row = 0; row < h; ++row) {
+            uint8_t* d = dst + row * dst_stride;
+            if (dither) {
+                argb8888_to_rgb565_dither(d, src + row * src_stride, w, x, y + row);
+            } else {
+                argb8888_to_rgb565(d, src + row * src_stride, w);
+            }
+            if (swap) rgb565_swap(d, w);
+        }
+        return;
+    }
+    detail::RotJob j{dst, dst_stride, src, src_stride, w, h, rot, dither, swap, x, y, {}};
+    detail::rotate<detail::RotKind::xrgb8888_to_rgb565>(j);
+}
+
+} // namespace pixel
+
+} // namespace lv
@@ -0,0 +1,317 @@
+#pragma once
+
+/**
+ * @file pixel_flush.hpp
+ * @brief Flush-time pixel conversion and rotation with the pixel.hpp kernels (opt-in)
+ *
+ * convert_on_flush() wraps a display's flush callback so LVGL can render
+ * in XRGB8888 and the driver receives RGB565 (or byte-swapped RGB565):
+ *
+ * @code
+ * #include <lv/core/pixel_flush.hpp>
+ *
+ * lv::FBDisplay display("/dev/fb0");
+ * lv::pixel::convert_on_flush(display, lv::pixel::FlushConvert::rgb565_dither);
+ * @endcode
+ *
+ * rotate_on_flush() does the partial-mode rotation copy of
+ * Display::rotation() in the same pass as the conversion.
+ *
+ * Not included by lv.hpp: the hook takes over lv_display_t's flush_cb and
+ * shows the driver RGB565 and an unrotated display for each call by
+ * switching color_format and rotation around it, none of which LVGL
+ * exposes. Checked against LVGL 9.4 (see LV_CPP_INTERNALS_OK).
+ *
+ * Heap allocation: NONE (LV_CPP_MAX_FLUSH_HOOKS fixed slots); rotate_on_flush()
+ * keeps one pooled draw buffer per display
+ */
+
+#include <lvgl.h>
+#include "version.hpp"
+
+#if !LV_CPP_INTERNALS_OK
+#error "pixel_flush.hpp reads LVGL internals checked against LVGL 9.4; see LV_CPP_INTERNALS_OK"
+#endif
+
+#include <src/display/lv_display_private.h>   // color_format, render_mode, flush_cb
+#include <cstdint>
+#include "../draw/draw_buf.hpp"
+#include "pixel.hpp"
+
+#ifndef LV_CPP_MAX_FLUSH_HOOKS
+/// Displays that can have a flush conversion installed at once
+#define LV_CPP_MAX_FLUSH_HOOKS 4
+#endif
+
+namespace lv {
+
+namespace pixel {
+
+/// What convert_on_flush() does to each rendered area before the driver sees it
+enum class FlushConvert : uint8_t {
+    none,                  ///< Remove the hook
+    rgb565,                ///< Render XRGB8888, hand RGB565 to the driver
+    rgb565_dither,         ///< Same with 4x4 ordered dithering (no banding in gradients)
+    rgb565_swap,           ///< Render XRGB8888, hand byte-swapped RGB565 (SPI panels)
+    rgb565_dither_swap,    ///< Dithered and byte-swapped
+    swap,                  ///< Display renders RGB565; swap bytes in place
+    opaque,                ///< Display renders ARGB8888; force alpha to 0xFF
+};
+
+namespace detail {
+
+struct FlushHook {
+    lv_display_t* disp = nullptr;    ///< nullptr: free slot
+    lv_display_flush_cb_t flush = nullptr;
+    FlushConvert mode = FlushConvert::none;
+    bool rotate = false;                 ///< rotate_on_flush()
+    lv_draw_buf_t* rotated = nullptr;    ///< Rotation target, grown to the largest area seen
+};
+
+[[nodiscard]] inline FlushHook* flush_hooks() noexcept {
+    static FlushHook hooks[LV_CPP_MAX_FLUSH_HOOKS];
+    return hooks;
+}
+
+[[nodiscard]] inline FlushHook* find_flush_hook(lv_display_t* disp) noexcept {
+    FlushHook* hooks = flush_hooks();
+    for (uint32_t i = 0; i < LV_CPP_MAX_FLUSH_HOOKS; ++i) {
+        if (hooks[i].disp == disp) return &hooks[i];
+    }
+    return nullptr;
+}
+
+[[nodiscard]] constexpr bool converts_to_565(FlushConvert m) noexcept {
+    return m == FlushConvert::rgb565 || m == FlushConvert::rgb565_dither ||
+           m == FlushConvert::rgb565_swap || m == FlushConvert::rgb565_dither_swap;
+}
+
+inline void convert_area(FlushConvert mode, const lv_area_t* area, uint8_t* px) noexcept {
+    const uint32_t w = static_cast<uint32_t>(lv_area_get_width(area));
+    const uint32_t h = static_cast<uint32_t>(lv_area_get_height(area));
+    if (converts_to_565(mode)) {
+        const uint32_t src_stride = lv_draw_buf_width_to_stride(w, LV_COLOR_FORMAT_XRGB8888);
+        const uint32_t dst_stride = lv_draw_buf_width_to_stride(w, LV_COLOR_FORMAT_RGB565);
+        const bool dither = mode == FlushConvert::rgb565_dither || mode == FlushConvert::rgb565_dither_swap;
+        const bool swap = mode == FlushConvert::rgb565_swap || mode == FlushConvert::rgb565_dither_swap;
+        for (uint32_t y = 0; y < h; ++y) {
+            uint8_t* dst = px + y * dst_stride;
+            const uint8_t* src = px + y * src_stride;
+            if (dither) {
+                argb8888_to_rgb565_dither(dst, src, w, static_cast<uint32_t>(area->x1),
+                                          static_cast<uint32_t>(area->y1) + y);
+            } else {
+                argb8888_to_rgb565(dst, src, w);
+            }
+            if (swap) rgb565_swap(dst, w);
+        }
+        return;
+    }
+    const lv_color_format_t cf = mode == FlushConvert::swap ? LV_COLOR_FORMAT_RGB565 : LV_COLOR_FORMAT_ARGB8888;
+    const uint32_t stride = lv_draw_buf_width_to_stride(w, cf);
+    for (uint32_t y = 0; y < h; ++y) {
+        uint8_t* row = px + y * stride;
+        if (mode == FlushConvert::swap) {
+            rgb565_swap(row, w);
+        } else {
+            copy_opaque(row, row, w);
+        }
+    }
+}
+
+[[nodiscard]] constexpr bool dithers(FlushConvert m) noexcept {
+    return m == FlushConvert::rgb565_dither || m == FlushConvert::rgb565_dither_swap;
+}
+
+[[nodiscard]] constexpr bool swaps(FlushConvert m) noexcept {
+    return m == FlushConvert::rgb565_swap || m == FlushConvert::rgb565_dither_swap || m == FlushConvert::swap;
+}
+
+/// Make hook.rotated hold a w x h `cf` buffer with `stride`
+[[nodiscard]] inline bool reserve_rotated(FlushHook& hook, uint32_t w, uint32_t h, lv_color_format_t cf,
+                                          uint32_t stride) noexcept {
+    if (hook.rotated && hook.rotated->data_size >= stride * h) return true;
+    if (hook.rotated) lv_draw_buf_destroy(hook.rotated);
+    hook.rotated = lv_draw_buf_create_ex(draw::pool_handlers(), w, h, cf, stride);
+    return hook.rotated != nullptr;
+}
+
+/**
+ * Rotate (and convert) the area into hook.rotated, then hand the driver the
+ * panel-space area. The driver sees an unrotated display for this call, so
+ * drivers that rotate on their own (fbdev, DRM) do not rotate a second time.
+ */
+inline void rotated_flush(FlushHook& hook, lv_display_t* disp, const lv_area_t* area, uint8_t* px) {
+    const lv_display_rotation_t rot = disp->rotation;
+    const uint32_t w = static_cast<uint32_t>(lv_area_get_width(area));
+    const uint32_t h = static_cast<uint32_t>(lv_area_get_height(area));
+    const bool to565 = converts_to_565(hook.mode);
+    const lv_color_format_t render_cf = disp->color_format;
+    const lv_color_format_t out_cf = to565 ? LV_COLOR_FORMAT_RGB565 : render_cf;
+    const bool quarter = rot == LV_DISPLAY_ROTATION_90 || rot == LV_DISPLAY_ROTATION_270;
+    const uint32_t out_w = quarter ? h : w;
+    const uint32_t out_h = quarter ? w : h;
+    const uint32_t src_stride = lv_draw_buf_width_to_stride(w, render_cf);
+    const uint32_t dst_stride = lv_draw_buf_width_to_stride(out_w, out_cf);
+    if (!reserve_rotated(hook, out_w, out_h, out_cf, dst_stride)) {
+        LV_LOG_WARN("no memory for the rotated area, dropped");
+        lv_display_flush_ready(disp);
+        return;
+    }
+    lv_area_t panel = *area;
+    lv_display_rotate_area(disp, &panel);
+    uint8_t* out = hook.rotated->data;
+
+    if (to565) {
+        rotate_xrgb8888_to_rgb565(out, dst_stride, px, src_stride, w, h, rot, dithers(hook.mode),
+                                  swaps(hook.mode), static_cast<uint32_t>(panel.x1),
+                                  static_cast<uint32_t>(panel.y1));
+    } else if (render_cf == LV_COLOR_FORMAT_RGB565) {
+        rotate_rgb565(out, dst_stride, px, src_stride, w, h, rot, hook.mode == FlushConvert::swap);
+    } else if (lv_color_format_get_size(render_cf) == 4) {
+        rotate_xrgb8888(out, dst_stride, px, src_stride, w, h, rot);
+        if (hook.mode == FlushConvert::opaque) {
+            for (uint32_t y = 0; y < out_h; ++y) copy_opaque(out + y * dst_stride, out + y * dst_stride, out_w);
+        }
+    } else {
+#if LV_USE_DRAW_SW
+        lv_draw_sw_rotate(px, out, static_cast<int32_t>(w), static_cast<int32_t>(h),
+                          static_cast<int32_t>(src_stride), static_cast<int32_t>(dst_stride), rot, render_cf);
+#else
+        LV_LOG_WARN("no rotate kernel for this color format");
+#endif
+    }
+
+    disp->rotation = LV_DISPLAY_ROTATION_0;
+    disp->color_format = out_cf;
+    hook.flush(disp, &panel, out);
+    disp->color_format = render_cf;
+    disp->rotation = rot;
+}
+
+/// Convert, then call the driver's flush with the color format it expects
+inline void converting_flush_cb(lv_display_t* disp, const lv_area_t* area, uint8_t* px) {
+    FlushHook* hook = find_flush_hook(disp);
+    if (!hook) {
+        lv_display_flush_ready(disp);
+        return;
+    }
+    if (hook->rotate && disp->rotation != LV_DISPLAY_ROTATION_0) {
+        rotated_flush(*hook, disp, area, px);
+        return;
+    }
+    if (hook->mode != FlushConvert::none) convert_area(hook->mode, area, px);
+    if (converts_to_565(hook->mode)) {
+        // Drivers size rows from the display's color format; show them RGB565 for this call
+        const lv_color_format_t render_cf = disp->color_format;
+        disp->color_format = LV_COLOR_FORMAT_RGB565;
+        hook->flush(disp, area, px);
+        disp->color_format = render_cf;
+    } else {
+        hook->flush(disp, area, px);
+    }
+}
+
+inline void release_flush_hook(FlushHook& hook) noexcept {
+    if (hook.rotated) lv_draw_buf_destroy(hook.rotated);
+    hook = FlushHook{};
+}
+
+inline void flush_hook_delete_cb(lv_event_t* e) noexcept {
+    auto* disp = static_cast<lv_display_t*>(lv_event_get_current_target(e));
+    if (FlushHook* hook = find_flush_hook(disp)) release_flush_hook(*hook);
+}
+
+/// Existing hook for `disp`, or a new one wrapping its flush callback
+[[nodiscard]] inline FlushHook* attach_flush_hook(lv_display_t* disp) noexcept {
+    if (FlushHook* hook = find_flush_hook(disp)) return hook;
+    if (disp->render_mode != LV_DISPLAY_RENDER_MODE_PARTIAL) {
+        LV_LOG_WARN("flush conversion and rotation need a partial render mode display");
+        return nullptr;
+    }
+    FlushHook* hook = find_flush_hook(nullptr);
+    if (!hook) {
+        LV_LOG_WARN("flush hooks exhausted, raise LV_CPP_MAX_FLUSH_HOOKS");
+        return nullptr;
+    }
+    hook->disp = disp;
+    hook->flush = disp->flush_cb;
+    lv_display_set_flush_cb(disp, &converting_flush_cb);
+    lv_display_add_event_cb(disp, &flush_hook_delete_cb, LV_EVENT_DELETE, nullptr);
+    return hook;
+}
+
+/// Give the driver its flush callback back once neither conversion nor rotation is left
+inline void detach_if_idle(FlushHook& hook) noexcept {
+    if (hook.mode != FlushConvert::none || hook.rotate) return;
+    lv_display_set_flush_cb(hook.disp, hook.flush);
+    lv_display_remove_event_cb_with_user_data(hook.disp, &flush_hook_delete_cb, nullptr);
+    release_flush_hook(hook);
+}
+
+} // namespace detail
+
+/**
+ * @brief Convert every rendered area before the display's flush callback runs
+ *
+ * Only for LV_DISPLAY_RENDER_MODE_PARTIAL displays, where each area is a
+ * contiguous buffer of its own. The rgb565* modes switch the display to
+ * render XRGB8888 and convert in place (the render buffer is then filled
+ * with half as many pixels per chunk). Call after the flush callback and
+ * buffers are set up; FlushConvert::none restores the original callback
+ * (unless rotate_on_flush() still needs it).
+ *
+ * @return false for non-partial displays or when LV_CPP_MAX_FLUSH_HOOKS is reached
+ */
+inline bool convert_on_flush(lv_display_t* disp, FlushConvert mode) noexcept {
+    if (!disp) return false;
+    if (mode == FlushConvert::none) {
+        if (detail::FlushHook* hook = detail::find_flush_hook(disp)) {
+            const bool was_565 = detail::converts_to_565(hook->mode);
+            hook->mode = FlushConvert::none;
+            detail::detach_if_idle(*hook);
+            if (was_565) lv_display_set_color_format(disp, LV_COLOR_FORMAT_RGB565);
+        }
+        return true;
+    }
+    detail::FlushHook* hook = detail::attach_flush_hook(disp);
+    if (!hook) return false;
+    hook->mode = mode;
+    if (detail::converts_to_565(mode)) lv_display_set_color_format(disp, LV_COLOR_FORMAT_XRGB8888);
+    return true;
+}
+
+/**
+ * @brief Rotate every rendered area for the driver (Display::rotation() in partial mode)
+ *
+ * In partial mode LVGL renders unrotated areas and leaves the 90/180/270°
+ * copy to the driver. With this hook the copy is done by the cache-blocked
+ * rotate kernels, fused with the convert_on_flush() conversion when one is
+ * set (one read and one write per pixel), into a pooled buffer sized to the
+ * largest area. The driver then receives panel coordinates and sees
+ * LV_DISPLAY_ROTATION_0 for the call, so it must not rotate again.
+ * Rotation 0 areas pass straight through.
+ *
+ * RGB565 and 32-bit formats use the SIMD kernels; other formats fall back
+ * to lv_draw_sw_rotate().
+ *
+ * @return false for non-partial displays or when LV_CPP_MAX_FLUSH_HOOKS is reached
+ */
+inline bool rotate_on_flush(lv_display_t* disp, bool enable = true) noexcept {
+    if (!disp) return false;
+    if (!enable) {
+        if (detail::FlushHook* hook = detail::find_flush_hook(disp)) {
+            hook->rotate = false;
+            detail::detach_if_idle(*hook);
+        }
+        return true;
+    }
+    detail::FlushHook* hook = detail::attach_flush_hook(disp);
+    if (!hook) return false;
+    hook->rotate = true;
+    return true;
+}
+
+} // namespace pixel
+
+} // namespace lv
@@ -0,0 +1,414 @@
+#pragma once
+
+/**
+ * @file prefetch.hpp
+ * @brief Idle-time warming of the image and font caches for upcoming screens
+ *
+ * lv::prefetch queues image sources, glyph ranges, texts and whole
+ * components. lv::tick() works the queue off whenever lv_timer_handler()
+ * leaves slack (see LV_CPP_IDLE_MIN_SLACK_MS in app.hpp):
+ * - images are decoded into LVGL's image cache (and their header cache)
+ * - glyphs are rendered once so FreeType/TinyTTF cache them
+ * - a component is built off screen (dry run), its image sources and label
+ *   texts are queued, and it is unmounted again
+ *
+ * @code
+ * lv::prefetch::Ticket t = lv::prefetch::images({"A:/img/map.png", &compass_icon});
+ * lv::prefetch::glyphs(roboto_24, 0x20, 0x7E, t);
+ * lv::prefetch::component<SettingsScreen>(t);
+ * ...
+ * lv::prefetch::cancel(t);     // user went elsewhere
+ * @endcode
+ *
+ * Navigator::auto_prefetch() uses this to warm the screen usually pushed
+ * next from the current one.
+ *
+ * Loops that call lv_timer_handler() themselves can call run_idle(ms).
+ * Everything runs on the UI thread. Item sources that are pointers
+ * (image descriptors, fonts, components passed by reference) must outlive
+ * the queue; paths and texts are copied.
+ *
+ * Heap allocation: NONE in the wrapper (LV_CPP_PREFETCH_ITEMS queue, a
+ * LV_CPP_PREFETCH_TEXT text arena, one glyph scratch buffer while running)
+ */
+
+#include <lvgl.h>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include "object.hpp"
+#include "app.hpp"
+
+#ifndef LV_CPP_PREFETCH_ITEMS
+/// Queued prefetch items
+#define LV_CPP_PREFETCH_ITEMS 64
+#endif
+
+#ifndef LV_CPP_PREFETCH_PATH
+/// Longest image path stored (longer ones are skipped)
+#define LV_CPP_PREFETCH_PATH 64
+#endif
+
+#ifndef LV_CPP_PREFETCH_TEXT
+/// Bytes of queued text (collected label texts, text())
+#define LV_CPP_PREFETCH_TEXT 1024
+#endif
+
+namespace lv::prefetch {
+
+/// Identifies a group of items for cancel() (0: rejected, queue full)
+using Ticket = uint32_t;
+
+/// A code point range of a font to warm
+struct Glyphs {
+    const lv_font_t* font;
+    uint32_t first;
+    uint32_t last;
+};
+
+struct Stats {
+    uint32_t pending = 0;     ///< Items still queued
+    uint32_t images = 0;      ///< Images decoded into the cache
+    uint32_t glyphs = 0;      ///< Glyphs rendered
+    uint32_t components = 0;  ///< Components dry-run built
+    uint32_t failed = 0;      ///< Images that could not be opened
+    uint32_t dropped = 0;     ///< Items rejected (queue, path or text space full)
+};
+
+namespace detail {
+
+enum class Kind : uint8_t { image, glyphs, text, collect };
+
+struct Item {
+    Ticket ticket = 0;                  ///< 0: free or cancelled
+    Kind kind = Kind::image;
+    const void* src = nullptr;          ///< image: descriptor, or path[] for files
+    const lv_font_t* font = nullptr;
+    uint32_t cur = 0;                   ///< glyphs: next code point; text: arena offset
+    uint32_t end = 0;                   ///< glyphs: last code point; text: arena end
+    void (*collect)(void*, Ticket) = nullptr;
+    void* ctx = nullptr;
+    char path[LV_CPP_PREFETCH_PATH];
+};
+
+struct Queue {
+    Item items[LV_CPP_PREFETCH_ITEMS];
+    uint32_t head = 0;
+    uint32_t count = 0;
+    char text[LV_CPP_PREFETCH_TEXT];
+    uint32_t text_used = 0;
+    Ticket next_ticket = 1;
+    lv_draw_buf_t* scratch = nullptr;   ///< A8 target for glyph bitmaps
+    Stats stats;
+};
+
+[[nodiscard]] inline Queue& queue() noexcept {
+    static Queue q;
+    return q;
+}
+
+inline bool run(uint32_t budget_ms);
+
+inline Ticket ticket_for(Queue& q, Ticket t) noexcept {
+    if (t) return t;
+    t = q.next_ticket++;
+    if (q.next_ticket == 0) q.next_ticket = 1;
+    return t;
+}
+
+[[nodiscard]] inline Item* push(Queue& q, Ticket t, Kind kind) noexcept {
+    if (q.count == LV_CPP_PREFETCH_ITEMS) {
+        ++q.stats.dropped;
+        return nullptr;
+    }
+    Item& it = q.items[(q.head + q.count++) % LV_CPP_PREFETCH_ITEMS];
+    it = Item{};
+    it.ticket = t;
+    it.kind = kind;
+    idle_handler(&run);
+    return &it;
+}
+
+inline void add_image(Queue& q, const void* src, Ticket t) noexcept {
+    if (!src) return;
+    const lv_image_src_t type = lv_image_src_get_type(src);
+    if (type == LV_IMAGE_SRC_SYMBOL || type == LV_IMAGE_SRC_UNKNOWN) return;
+    const size_t len = type == LV_IMAGE_SRC_FILE ? std::strlen(static_cast<const char*>(src)) : 0;
+    if (len >= LV_CPP_PREFETCH_PATH) {
+        ++q.stats.dropped;
+        return;
+    }
+    Item* it = push(q, t, Kind::image);
+    if (!it) return;
+    if (type == LV_IMAGE_SRC_FILE) {
+        std::memcpy(it->path, src, len + 1);
+        it->src = it->path;
+    } else {
+        it->src = src;
+    }
+}
+
+inline void add_text(Queue& q, const lv_font_t* font, const char* txt, Ticket t) noexcept {
+    if (!font || !txt || !*txt) return;
+    const size_t len = std::strlen(txt);
+    if (q.text_used + len > LV_CPP_PREFETCH_TEXT) {
+        ++q.stats.dropped;
+        return;
+    }
+    Item* it = push(q, t, Kind::text);
+    if (!it) return;
+    std::memcpy(q.text + q.text_used, txt, len);
+    it->font = font;
+    it->cur = q.text_used;
+    it->end = q.text_used + static_cast<uint32_t>(len);
+    q.text_used = it->end;
+}
+
+/// Queue the image sources and label texts of a built tree
+inline void collect_tree(Queue& q, lv_obj_t* obj, Ticket t) noexcept {
+#if LV_USE_IMAGE
+    if (lv_obj_check_type(obj, &lv_image_class)) add_image(q, lv_image_get_src(obj), t);
+#endif
+#if LV_USE_LABEL
+    if (lv_obj_check_type(obj, &lv_label_class)) {
+        add_text(q, lv_obj_get_style_text_font(obj, LV_PART_MAIN), lv_label_get_text(obj), t);
+    }
+#endif
+    add_image(q, lv_obj_get_style_bg_image_src(obj, LV_PART_MAIN), t);
+    const uint32_t n = lv_obj_get_child_count(obj);
+    for (uint32_t i = 0; i < n; ++i) collect_tree(q, lv_obj_get_child(obj, static_cast<int32_t>(i)), t);
+}
+
+/// Build `c` off screen (unless it already is), collect its tree, undo the build
+template<typename C>
+void dry_run(C& c, Ticket t) {
+    Queue& q = queue();
+    if (c.is_mounted()) {
+        collect_tree(q, c.root().get(), t);
+        return;
+    }
+    if constexpr (requires { c.mount_screen(); c.unmount_screen(); }) {
+        collect_tree(q, c.mount_screen().get(), t);
+        c.unmount_screen();
+    } else {
+        lv_obj_t* parent = lv_obj_create(nullptr);   // never loaded, never rendered
+        c.mount(ObjectView(parent));
+        collect_tree(q, parent, t);
+        c.unmount();
+        lv_obj_delete(parent);
+    }
+    ++q.stats.components;
+}
+
+template<typename C>
+void dry_run_instance(void* c, Ticket t) {
+    dry_run(*static_cast<C*>(c), t);
+}
+
+template<typename C>
+void dry_run_type(void*, Ticket t) {
+    C c;
+    dry_run(c, t);
+}
+
+inline void warm_image(Queue& q, const void* src) noexcept {
+    lv_image_header_t header;
+    lv_image_decoder_dsc_t dsc;
+    lv_image_decoder_args_t args{};
+    if (lv_image_decoder_get_info(src, &header) != LV_RESULT_OK ||
+        lv_image_decoder_open(&dsc, src, &args) != LV_RESULT_OK) {
+        ++q.stats.failed;
+        return;
+    }
+    lv_image_decoder_close(&dsc);   // the decoded entry stays in the image cache
+    ++q.stats.images;
+}
+
+inline void warm_glyph(Queue& q, const lv_font_t* font, uint32_t letter) noexcept {
+    lv_font_glyph_dsc_t g;
+    std::memset(&g, 0, sizeof(g));
+    if (!lv_font_get_glyph_dsc(font, &g, letter, 0) || g.box_w == 0 || g.box_h == 0) return;
+    if (!q.scratch || q.scratch->header.w < g.box_w || q.scratch->header.h < g.box_h) {
+        const uint32_t w = q.scratch && q.scratch->header.w > g.box_w ? q.scratch->header.w : g.box_w;
+        const uint32_t h = q.scratch && q.scratch->header.h > g.box_h ? q.scratch->header.h : g.box_h;
+        if (q.scratch) lv_draw_buf_destroy(q.scratch);
+        q.scratch = lv_draw_buf_create(w, h, LV_COLOR_FORMAT_A8, LV_STRIDE_AUTO);
+        if (!q.scratch) return;
+    }
+    lv_font_get_glyph_bitmap(&g, q.scratch);
+    lv_font_glyph_release_draw_data(&g);
+    ++q.stats.glyphs;
+}
+
+/// Do one unit of the head item; true when it is finished and can be released
+inline bool step(Queue& q, Item& it) {
+    switch (it.kind) {
+    case Kind::image:
+        warm_image(q, it.src);
+        return true;
+    case Kind::glyphs:
+        warm_glyph(q, it.font, it.cur);
+        return it.cur++ >= it.end;
+    case Kind::text: {
+        uint32_t i = it.cur;
+        const uint32_t letter = lv_text_encoded_next(q.text, &i);
+        it.cur = i;
+        if (letter) warm_glyph(q, it.font, letter);
+        return it.cur >= it.end || letter == 0;
+    }
+    case Kind::collect: {
+        // collect() may queue more items; take this one off first
+        void (*fn)(void*, Ticket) = it.collect;
+        void* ctx = it.ctx;
+        const Ticket t = it.ticket;
+        it.ticket = 0;
+        fn(ctx, t);
+        return false;   // already released; `it` may be reused by now
+    }
+    }
+    return true;
+}
+
+inline void pop_finished(Queue& q) noexcept {
+    while (q.count > 0 && q.items[q.head].ticket == 0) {
+        q.head = (q.head + 1) % LV_CPP_PREFETCH_ITEMS;
+        --q.count;
+    }
+    if (q.count == 0) {
+        q.text_used = 0;
+        if (q.scratch) {
+            lv_draw_buf_destroy(q.scratch);
+            q.scratch = nullptr;
+        }
+    }
+}
+
+inline bool run(uint32_t budget_ms) {
+    Queue& q = queue();
+    const uint32_t start = lv_tick_get();
+    pop_finished(q);
+    while (q.count > 0) {
+        Item& it = q.items[q.head];
+        if (step(q, it)) it.ticket = 0;
+        pop_finished(q);
+        if (lv_tick_elaps(start) >= budget_ms) break;
+    }
+    return q.count > 0;
+}
+
+} // namespace detail
+
+/// Queue one image (descriptor or file path); returns `t` or a new ticket
+inline Ticket image(const void* src, Ticket t = 0) noexcept {
+    detail::Queue& q = detail::queue();
+    t = detail::ticket_for(q, t);
+    detail::add_image(q, src, t);
+    return t;
+}
+
+/// Queue several images under one ticket
+inline Ticket images(std::initializer_list<const void*> srcs, Ticket t = 0) noexcept {
+    detail::Queue& q = detail::queue();
+    t = detail::ticket_for(q, t);
+    for (const void* src : srcs) detail::add_image(q, src, t);
+    return t;
+}
+
+/// Queue the code points [first, last] of `font`
+inline Ticket glyphs(const lv_font_t* font, uint32_t first, uint32_t last, Ticket t = 0) noexcept {
+    detail::Queue& q = detail::queue();
+    t = detail::ticket_for(q, t);
+    if (!font || last < first) return t;
+    if (detail::Item* it = detail::push(q, t, detail::Kind::glyphs)) {
+        it->font = font;
+        it->cur = first;
+        it->end = last;
+    }
+    return t;
+}
+
+/// Queue several font ranges under one ticket
+inline Ticket fonts(std::initializer_list<Glyphs> ranges, Ticket t = 0) noexcept {
+    t = detail::ticket_for(detail::queue(), t);
+    for (const Glyphs& g : ranges) glyphs(g.font, g.first, g.last, t);
+    return t;
+}
+
+/// Queue the glyphs of a UTF-8 text (copied)
+inline Ticket text(const lv_font_t* font, const char* utf8, Ticket t = 0) noexcept {
+    detail::Queue& q = detail::queue();
+    t = detail::ticket_for(q, t);
+    detail::add_text(q, font, utf8, t);
+    return t;
+}
+
+/**
+ * @brief Queue a dry run of `component` (Component or ScreenComponent)
+ *
+ * At idle time the component is mounted off screen (or its mounted tree is
+ * used), its image sources and label texts are queued under the same
+ * ticket, and it is unmounted again. on_mount()/on_unmount() run as usual.
+ */
+template<typename C>
+Ticket component(C& component, Ticket t = 0) noexcept {
+    detail::Queue& q = detail::queue();
+    t = detail::ticket_for(q, t);
+    if (detail::Item* it = detail::push(q, t, detail::Kind::collect)) {
+        it->collect = &detail::dry_run_instance<C>;
+        it->ctx = &component;
+    }
+    return t;
+}
+
+/// Queue a dry run of a default-constructed temporary C
+template<typename C>
+Ticket component(Ticket t = 0) noexcept {
+    detail::Queue& q = detail::queue();
+    t = detail::ticket_for(q, t);
+    if (detail::Item* it = detail::push(q, t, detail::Kind::collect)) {
+        it->collect = &detail::dry_run_type<C>;
+    }
+    return t;
+}
+
+/// Drop the queued items of `t` (the item running now finishes)
+inline void cancel(Ticket t) noexcept {
+    if (t == 0) return;
+    detail::Queue& q = detail::queue();
+    for (uint32_t k = 0; k < q.count; ++k) {
+        detail::Item& it = q.items[(q.head + k) % LV_CPP_PREFETCH_ITEMS];
+        if (it.ticket == t) it.ticket = 0;
+    }
+    detail::pop_finished(q);
+}
+
+inline void cancel_all() noexcept {
+    detail::Queue& q = detail::queue();
+    for (detail::Item& it : q.items) it.ticket = 0;
+    detail::pop_finished(q);
+}
+
+/// Items of `t` still queued (any ticket: t == 0)
+[[nodiscard]] inline uint32_t pending(Ticket t = 0) noexcept {
+    const detail::Queue& q = detail::queue();
+    uint32_t n = 0;
+    for (uint32_t k = 0; k < q.count; ++k) {
+        const Ticket it = q.items[(q.head + k) % LV_CPP_PREFETCH_ITEMS].ticket;
+        n += it != 0 && (t == 0 || it == t);
+    }
+    return n;
+}
+
+[[nodiscard]] inline Stats stats() noexcept {
+    Stats s = detail::queue().stats;
+    s.pending = pending();
+    return s;
+}
+
+/**
+ * @brief Work the queue for up to `budget_ms` (called by lv::tick() when idle)
+ * @return true if items are left
+ */
+inline bool run_idle(uint32_t budget_ms) { return detail::run(budget_ms); }
+
+} // namespace lv::prefetch
@@ -0,0 +1,212 @@
+#pragma once
+
+/**
+ * @file profiler.hpp
+ * @brief Scoped profiling markers with a Chrome/Perfetto trace ring buffer
+ *
+ * LV_PROFILE_SCOPE("name") times the enclosing scope; LV_PROFILE_FUNCTION()
+ * names it after the function (for templates the signature shows the
+ * handler, e.g. `MemberTrampoline<&Settings::on_save, Settings>`). The
+ * wrapper places them around Component::mount(), the event and timer
+ * trampolines and State notifications.
+ *
+ * With LV_CPP_USE_PROFILER=0 (default; CMake -DLV_CPP_USE_PROFILER=ON)
+ * both macros expand to nothing. With it on, every scope is recorded as a
+ * complete ("X") event in a LV_CPP_PROFILER_EVENTS ring buffer, and also
+ * forwarded to LVGL's profiler when LV_USE_PROFILER is set, so the C++
+ * scopes nest inside LVGL's own trace.
+ *
+ * Usage:
+ * @code
+ * void Dashboard::on_refresh() {
+ *     LV_PROFILE_SCOPE("dashboard refresh");
+ *     ...
+ * }
+ *
+ * // later, e.g. from a debug key
+ * lv::profiler::write_chrome_trace("/tmp/ui.json");   // open in ui.perfetto.dev
+ * @endcode
+ *
+ * Heap allocation: NONE (fixed ring of LV_CPP_PROFILER_EVENTS entries)
+ */
+
+#include <lvgl.h>
+#include <cstdint>
+
+#ifndef LV_CPP_USE_PROFILER
+#define LV_CPP_USE_PROFILER 0
+#endif
+
+#ifndef LV_CPP_PROFILER_EVENTS
+/// Trace ring capacity (oldest events are overwritten)
+#define LV_CPP_PROFILER_EVENTS 4096
+#endif
+
+/// Signature of the enclosing function (names template trampolines by their handler)
+#if defined(__GNUC__) || defined(__clang__)
+#define LV_CPP_PROFILE_FUNC_NAME __PRETTY_FUNCTION__
+#elif defined(_MSC_VER)
+#define LV_CPP_PROFILE_FUNC_NAME __FUNCSIG__
+#else
+#define LV_CPP_PROFILE_FUNC_NAME __func__
+#endif
+
+#if LV_CPP_USE_PROFILER
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+
+namespace lv::profiler {
+
+/// One completed scope
+struct TraceEvent {
+    const char* name;
+    uint64_t ts_us;     ///< Start, steady clock
+    uint32_t dur_us;
+    uint32_t tid;       ///< Small per-thread id (1 = first thread that traced)
+};
+
+namespace detail {
+
+struct TraceRing {
+    TraceEvent events[LV_CPP_PROFILER_EVENTS];
+    std::atomic<uint32_t> head{0};        ///< Total events recorded (wraps the ring)
+    std::atomic<uint32_t> next_tid{1};
+    std::atomic<bool> enabled{true};
+};
+
+[[nodiscard]] inline TraceRing& trace_ring() noexcept {
+    static TraceRing ring;
+    return ring;
+}
+
+[[nodiscard]] inline uint64_t now_us() noexcept {
+    using namespace std::chrono;
+    return static_cast<uint64_t>(duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+[[nodiscard]] inline uint32_t thread_id() noexcept {
+    thread_local uint32_t tid = trace_ring().next_tid.fetch_add(1, std::memory_order_relaxed);
+    return tid;
+}
+
+inline void record(const char* name, uint64_t start_us, uint64_t end_us) noexcept {
+    TraceRing& r = trace_ring();
+    const uint32_t i = r.head.fetch_add(1, std::memory_order_relaxed) % LV_CPP_PROFILER_EVENTS;
+    r.events[i] = TraceEvent{name, start_us, static_cast<uint32_t>(end_us - start_us), thread_id()};
+}
+
+/// Write `s` as a JSON string body (quotes and backslashes escaped)
+inline void write_json_string(FILE* out, const char* s) noexcept {
+    for (; *s; ++s) {
+        if (*s == '"' || *s == '\\') std::fputc('\\', out);
+        if (static_cast<unsigned char>(*s) >= 0x20) std::fputc(*s, out);
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief RAII marker recording the lifetime of the scope
+ *
+ * `name` must outlive the trace (string literals, __PRETTY_FUNCTION__).
+ */
+class Scope {
+    const char* m_name;
+    uint64_t m_start;
+
+public:
+    explicit Scope(const char* name) noexcept : m_name(name), m_start(detail::now_us()) {
+#if LV_USE_PROFILER
+        LV_PROFILER_BEGIN_TAG(name);
+#endif
+    }
+
+    ~Scope() {
+#if LV_USE_PROFILER
+        LV_PROFILER_END_TAG(m_name);
+#endif
+        if (detail::trace_ring().enabled.load(std::memory_order_relaxed)) {
+            detail::record(m_name, m_start, detail::now_us());
+        }
+    }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+};
+
+/// Pause or resume recording into the ring (LVGL forwarding is unaffected)
+inline void enable(bool on) noexcept { detail::trace_ring().enabled.store(on, std::memory_order_relaxed); }
+
+[[nodiscard]] inline bool enabled() noexcept { return detail::trace_ring().enabled.load(std::memory_order_relaxed); }
+
+/// Events currently held in the ring
+[[nodiscard]] inline uint32_t size() noexcept {
+    const uint32_t n = detail::trace_ring().head.load(std::memory_order_relaxed);
+    return n < LV_CPP_PROFILER_EVENTS ? n : LV_CPP_PROFILER_EVENTS;
+}
+
+/// Events overwritten because the ring was full
+[[nodiscard]] inline uint32_t dropped() noexcept {
+    const uint32_t n = detail::trace_ring().head.load(std::memory_order_relaxed);
+    return n > LV_CPP_PROFILER_EVENTS ? n - LV_CPP_PROFILER_EVENTS : 0;
+}
+
+inline void clear() noexcept { detail::trace_ring().head.store(0, std::memory_order_relaxed); }
+
+/// Visit the recorded events, oldest first
+template<typename F>
+void for_each(F&& fn) {
+    detail::TraceRing& r = detail::trace_ring();
+    const uint32_t head = r.head.load(std::memory_order_acquire);
+    const uint32_t n = size();
+    for (uint32_t k = 0; k < n; ++k) fn(r.events[(head - n + k) % LV_CPP_PROFILER_EVENTS]);
+}
+
+/**
+ * @brief Write the ring as Chrome trace JSON (chrome://tracing, ui.perfetto.dev)
+ *
+ * Take the dump while no other thread records, e.g. from the UI thread.
+ */
+inline void write_chrome_trace(FILE* out) noexcept {
+    std::fprintf(out, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    bool first = true;
+    for_each([&](const TraceEvent& e) {
+        std::fprintf(out, "%s\n{\"name\":\"", first ? "" : ",");
+        detail::write_json_string(out, e.name);
+        std::fprintf(out, "\",\"cat\":\"lv\",\"ph\":\"X\",\"ts\":%llu,\"dur\":%u,\"pid\":1,\"tid\":%u}",
+                     static_cast<unsigned long long>(e.ts_us), static_cast<unsigned>(e.dur_us),
+                     static_cast<unsigned>(e.tid));
+        first = false;
+    });
+    std::fprintf(out, "\n]}\n");
+}
+
+/// Write the trace to `path`; false if the file cannot be opened
+inline bool write_chrome_trace(const char* path) noexcept {
+    FILE* out = std::fopen(path, "w");
+    if (!out) return false;
+    write_chrome_trace(out);
+    std::fclose(out);
+    return true;
+}
+
+} // namespace lv::profiler
+
+#define LV_CPP_PROFILE_CONCAT_(a, b) a##b
+#define LV_CPP_PROFILE_CONCAT(a, b) LV_CPP_PROFILE_CONCAT_(a, b)
+
+/// Time the enclosing scope under `name`
+#define LV_PROFILE_SCOPE(name) \
+    ::lv::profiler::Scope LV_CPP_PROFILE_CONCAT(lv_profile_scope_, __LINE__)(name)
+
+/// Time the enclosing function, named by its signature
+#define LV_PROFILE_FUNCTION() LV_PROFILE_SCOPE(LV_CPP_PROFILE_FUNC_NAME)
+
+#else // !LV_CPP_USE_PROFILER
+
+#define LV_PROFILE_SCOPE(name) ((void)0)
+#define LV_PROFILE_FUNCTION() ((void)0)
+
+#endif // LV_CPP_USE_PROFILER
@@ -0,0 +1,76 @@
+#pragma once
+
+/**
+ * @file qoi.hpp
+ * @brief Streaming QOI pixel encoder (https://qoiformat.org)
+ *
+ * QOI packs runs, 64 recently seen colors and small deltas to the previous
+ * pixel into 1-2 byte ops, at memcpy-like speed and with 300 bytes of
+ * state. The encoder takes one RGBA pixel at a time and writes its ops to
+ * any output with byte(uint8_t) and bytes(const void*, uint32_t); the
+ * caller writes the 14-byte file header and the end marker if it produces
+ * a .qoi file. snapshot::encode() and remote::Mirror use it.
+ *
+ * Heap allocation: NONE
+ */
+
+#include <cstdint>
+#include <cstring>
+
+namespace lv::qoi {
+
+/// End of a .qoi file: seven 0x00 and one 0x01
+inline constexpr uint8_t end_marker[8] = {0, 0, 0, 0, 0, 0, 0, 1};
+
+/// Encoder state; reset() before each independent stream
+struct Encoder {
+    uint8_t index[64][4] = {};
+    uint8_t prev[4] = {0, 0, 0, 255};
+    uint32_t run = 0;
+
+    void reset() noexcept { *this = Encoder{}; }
+
+    /// Write the pending run, if any (call after the last pixel)
+    template<class Out>
+    void flush(Out& out) noexcept {
+        if (run) out.byte(static_cast<uint8_t>(0xC0 | (run - 1)));
+        run = 0;
+    }
+
+    /// Encode one pixel (R, G, B, A)
+    template<class Out>
+    void pixel(Out& out, const uint8_t px[4]) noexcept {
+        if (std::memcmp(px, prev, 4) == 0) {
+            if (++run == 62) flush(out);
+            return;
+        }
+        flush(out);
+        const uint32_t h = (px[0] * 3u + px[1] * 5u + px[2] * 7u + px[3] * 11u) % 64u;
+        if (std::memcmp(index[h], px, 4) == 0) {
+            out.byte(static_cast<uint8_t>(h));
+        } else {
+            std::memcpy(index[h], px, 4);
+            if (px[3] == prev[3]) {
+                const int8_t dr = static_cast<int8_t>(px[0] - prev[0]);
+                const int8_t dg = static_cast<int8_t>(px[1] - prev[1]);
+                const int8_t db = static_cast<int8_t>(px[2] - prev[2]);
+                const int dr_dg = static_cast<int8_t>(dr - dg), db_dg = static_cast<int8_t>(db - dg);
+                if (dr > -3 && dr < 2 && dg > -3 && dg < 2 && db > -3 && db < 2) {
+                    out.byte(static_cast<uint8_t>(0x40 | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2)));
+                } else if (dg > -33 && dg < 32 && dr_dg > -9 && dr_dg < 8 && db_dg > -9 && db_dg < 8) {
+                    out.byte(static_cast<uint8_t>(0x80 | (dg + 32)));
+                    out.byte(static_cast<uint8_t>((dr_dg + 8) << 4 | (db_dg + 8)));
+                } else {
+                    out.byte(0xFE);
+                    out.bytes(px, 3);
+                }
+            } else {
+                out.byte(0xFF);
+                out.bytes(px, 4);
+            }
+        }
+        std::memcpy(prev, px, 4);
+    }
+};
+
+} // namespace lv::qoi
@@ -0,0 +1,239 @@
+#pragma once
+
+/**
+ * @file refresh_rate.hpp
+ * @brief Refresh period that follows what is happening on screen
+ *
+ * The refresh timer runs at LV_DEF_REFR_PERIOD whether the screen is
+ * static or scrolling. An adaptive display picks the period after every
+ * refresh:
+ *
+ * - `boost` while animations run, an object is scrolled (also while it
+ *   coasts after a throw) or input arrived within `linger_ms`
+ * - `normal` while content still changes without motion (a clock, a
+ *   value label)
+ * - `idle` once nothing was redrawn for `idle_after_ms`: `idle_ms`, or
+ *   with 0 the timer is paused until the next invalidation resumes it
+ *   (event-driven, as EventLoop::idle_refresh())
+ *
+ * @code
+ * lv::Display disp = lv::Display::get_default();
+ * disp.adaptive_refresh({.boost_ms = 11});          // 90 Hz in motion, 30 Hz for updates, paused when idle
+ * ...
+ * auto s = lv::refresh_rate::stats(disp);
+ * @endcode
+ *
+ * lv_timer_handler() returns the time to the refresh timer's next run,
+ * so lv::run() and EventLoop sleep longer by themselves at the lower
+ * rates. The input device read timers are not changed. An invalidation
+ * made while idle resumes refreshing at once, not one period later.
+ *
+ * Heap allocation: NONE in the wrapper (LV_CPP_REFRESH_DISPLAYS fixed
+ * slots; LVGL allocates the event descriptors)
+ */
+
+#include <lvgl.h>
+#include <cstdint>
+
+#ifndef LV_CPP_REFRESH_DISPLAYS
+/// Displays that can refresh adaptively at once
+#define LV_CPP_REFRESH_DISPLAYS 2
+#endif
+
+namespace lv {
+
+/// Periods of Display::adaptive_refresh() in ms
+struct RefreshConfig {
+    uint16_t boost_ms = LV_DEF_REFR_PERIOD;        ///< Animations, scrolling or recent input
+    uint16_t normal_ms = 2 * LV_DEF_REFR_PERIOD;   ///< Redraws without motion
+    uint16_t idle_ms = 0;                          ///< Nothing redrawn (0: pause until invalidated)
+    uint16_t idle_after_ms = 1000;                 ///< Time without redraws before idle
+    uint16_t linger_ms = 300;                      ///< Boost kept after the last input or motion
+};
+
+namespace refresh_rate {
+
+/// Rate a display currently refreshes at
+enum class Mode : uint8_t { boost, normal, idle };
+
+/// Counters of an adaptive display
+struct Stats {
+    uint32_t boost_frames;    ///< refreshes that drew in boost
+    uint32_t normal_frames;   ///< refreshes that drew in normal
+    uint32_t idle_frames;     ///< refreshes that drew in idle (with idle_ms)
+    uint32_t switches;        ///< mode changes
+    uint32_t wakeups;         ///< resumes from a paused idle timer
+};
+
+namespace detail {
+
+struct Hook {
+    lv_display_t* disp = nullptr;    ///< nullptr: free slot
+    RefreshConfig cfg{};
+    Mode mode = Mode::normal;
+    uint32_t last_motion = 0;
+    uint32_t last_change = 0;
+    bool drew = false;               ///< the current refresh rendered something
+    Stats stats{};
+};
+
+[[nodiscard]] inline Hook* hooks() noexcept {
+    static Hook h[LV_CPP_REFRESH_DISPLAYS];
+    return h;
+}
+
+[[nodiscard]] inline Hook* find(lv_display_t* disp) noexcept {
+    Hook* h = hooks();
+    for (uint32_t i = 0; i < LV_CPP_REFRESH_DISPLAYS; ++i) {
+        if (h[i].disp == disp) return &h[i];
+    }
+    return nullptr;
+}
+
+/// Animations, a scroll (dragged or coasting) or input within `linger` ms
+[[nodiscard]] inline bool in_motion(lv_display_t* disp, uint32_t linger) noexcept {
+    if (lv_anim_count_running() > 0) return true;
+    if (lv_display_get_inactive_time(disp) < linger) return true;
+    for (lv_indev_t* i = lv_indev_get_next(nullptr); i; i = lv_indev_get_next(i)) {
+        if (lv_indev_get_display(i) != disp) continue;
+        if (lv_indev_get_scroll_obj(i) || lv_indev_get_state(i) == LV_INDEV_STATE_PRESSED) return true;
+    }
+    return false;
+}
+
+inline void set_mode(Hook& h, Mode mode) noexcept {
+    lv_timer_t* t = lv_display_get_refr_timer(h.disp);
+    if (!t) return;
+    if (mode != h.mode) ++h.stats.switches;
+    h.mode = mode;
+    switch (mode) {
+    case Mode::boost: lv_timer_set_period(t, h.cfg.boost_ms); break;
+    case Mode::normal: lv_timer_set_period(t, h.cfg.normal_ms); break;
+    case Mode::idle:
+        if (h.cfg.idle_ms == 0) {
+            lv_timer_pause(t);
+            return;
+        }
+        lv_timer_set_period(t, h.cfg.idle_ms);
+        break;
+    }
+    lv_timer_resume(t);
+}
+
+[[nodiscard]] inline Mode decide(Hook& h, uint32_t now) noexcept {
+    if (in_motion(h.disp, h.cfg.linger_ms)) h.last_motion = now;
+    if (now - h.last_motion < h.cfg.linger_ms) return Mode::boost;
+    if (now - h.last_change < h.cfg.idle_after_ms) return Mode::normal;
+    return Mode::idle;
+}
+
+inline void render_start_cb(lv_event_t* e) noexcept {
+    if (Hook* h = find(static_cast<lv_display_t*>(lv_event_get_current_target(e)))) h->drew = true;
+}
+
+inline void refr_ready_cb(lv_event_t* e) noexcept {
+    Hook* h = find(static_cast<lv_display_t*>(lv_event_get_current_target(e)));
+    if (!h) return;
+    const uint32_t now = lv_tick_get();
+    if (h->drew) {
+        h->last_change = now;
+        switch (h->mode) {
+        case Mode::boost: ++h->stats.boost_frames; break;
+        case Mode::normal: ++h->stats.normal_frames; break;
+        case Mode::idle: ++h->stats.idle_frames; break;
+        }
+    }
+    h->drew = false;
+    set_mode(*h, decide(*h, now));
+}
+
+/// An invalidation while idle: refresh now at the rate it calls for
+inline void refr_request_cb(lv_event_t* e) noexcept {
+    Hook* h = find(static_cast<lv_display_t*>(lv_event_get_current_target(e)));
+    if (!h || h->mode != Mode::idle) return;
+    const uint32_t now = lv_tick_get();
+    h->last_change = now;
+    if (h->cfg.idle_ms == 0) ++h->stats.wakeups;
+    set_mode(*h, decide(*h, now));
+}
+
+inline void remove_cbs(lv_display_t* disp) noexcept {
+    lv_display_remove_event_cb_with_user_data(disp, &render_start_cb, nullptr);
+    lv_display_remove_event_cb_with_user_data(disp, &refr_ready_cb, nullptr);
+    lv_display_remove_event_cb_with_user_data(disp, &refr_request_cb, nullptr);
+}
+
+inline void delete_cb(lv_event_t* e) noexcept {
+    if (Hook* h = find(static_cast<lv_display_t*>(lv_event_get_current_target(e)))) *h = Hook{};
+}
+
+} // namespace detail
+
+/**
+ * @brief Let `disp` pick its refresh period (see the file comment)
+ *
+ * Enabling again applies a new configuration (the counters are kept).
+ *
+ * @return false when LV_CPP_REFRESH_DISPLAYS is reached
+ */
+inline bool enable(lv_display_t* disp, const RefreshConfig& cfg = {}) noexcept {
+    if (!disp) return false;
+    detail::Hook* h = detail::find(disp);
+    if (!h) {
+        h = detail::find(nullptr);
+        if (!h) {
+            LV_LOG_WARN("adaptive displays exhausted, raise LV_CPP_REFRESH_DISPLAYS");
+            return false;
+        }
+        lv_display_add_event_cb(disp, &detail::render_start_cb, LV_EVENT_RENDER_START, nullptr);
+        lv_display_add_event_cb(disp, &detail::refr_ready_cb, LV_EVENT_REFR_READY, nullptr);
+        lv_display_add_event_cb(disp, &detail::refr_request_cb, LV_EVENT_REFR_REQUEST, nullptr);
+        lv_display_add_event_cb(disp, &detail::delete_cb, LV_EVENT_DELETE, nullptr);
+    }
+    const uint32_t now = lv_tick_get();
+    const Stats kept = h->stats;
+    *h = detail::Hook{};
+    h->stats = kept;
+    h->disp = disp;
+    h->cfg = cfg;
+    h->last_change = now;
+    detail::set_mode(*h, Mode::normal);
+    return true;
+}
+
+/// Back to a fixed LV_DEF_REFR_PERIOD
+inline void disable(lv_display_t* disp) noexcept {
+    detail::Hook* h = disp ? detail::find(disp) : nullptr;
+    if (!h) return;
+    detail::remove_cbs(disp);
+    lv_display_remove_event_cb_with_user_data(disp, &detail::delete_cb, nullptr);
+    if (lv_timer_t* t = lv_display_get_refr_timer(disp)) {
+        lv_timer_set_period(t, LV_DEF_REFR_PERIOD);
+        lv_timer_resume(t);
+    }
+    *h = detail::Hook{};
+}
+
+[[nodiscard]] inline bool enabled(lv_display_t* disp) noexcept {
+    return disp && detail::find(disp);
+}
+
+/// Current mode (normal if not adaptive)
+[[nodiscard]] inline Mode mode(lv_display_t* disp) noexcept {
+    const detail::Hook* h = disp ? detail::find(disp) : nullptr;
+    return h ? h->mode : Mode::normal;
+}
+
+/// Counters of an adaptive display (zero if not adaptive)
+[[nodiscard]] inline Stats stats(lv_display_t* disp) noexcept {
+    const detail::Hook* h = disp ? detail::find(disp) : nullptr;
+    return h ? h->stats : Stats{};
+}
+
+inline void reset_stats(lv_display_t* disp) noexcept {
+    if (detail::Hook* h = disp ? detail::find(disp) : nullptr) h->stats = Stats{};
+}
+
+} // namespace refresh_rate
+
+} // namespace lv
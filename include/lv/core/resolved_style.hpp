@@ -0,0 +1,285 @@
+#pragma once
+
+/**
+ * @file resolved_style.hpp
+ * @brief Per-object cache of resolved draw descriptors for deep style stacks
+ *
+ * lv_obj_init_draw_rect_dsc() looks up some 40 properties, and each lookup
+ * walks every style of the object and skips the ones whose part or state
+ * does not match. A widget with a dozen styles for
+ * `LV_PART_INDICATOR | LV_STATE_PRESSED` and friends pays that walk on
+ * every redraw, although nothing changed since the last one. For objects
+ * registered here, the resolved descriptors are kept per part until the
+ * object's styles or state change:
+ *
+ * @code
+ * #include <lv/core/resolved_style.hpp>
+ *
+ * lv::resolved_style::enable(gauge);
+ *
+ * static void draw_cb(lv_event_t* e) {            // LV_EVENT_DRAW_MAIN
+ *     lv_obj_t* obj = lv_event_get_current_target_obj(e);
+ *     lv_draw_rect_dsc_t rect;
+ *     lv_draw_rect_dsc_init(&rect);
+ *     lv::resolved_style::init_rect_dsc(obj, LV_PART_INDICATOR, &rect);   // cached
+ *     ...
+ * }
+ * @endcode
+ *
+ * init_rect_dsc(), init_label_dsc(), init_line_dsc() and init_arc_dsc()
+ * are drop-in replacements for the lv_obj_init_draw_*_dsc() calls of
+ * custom draw code, including the wrapper's own draw routines. The
+ * descriptor is overwritten apart from its base (layer, ids, user data),
+ * so set per-draw fields such as the label text afterwards. LVGL's
+ * built-in widgets resolve their styles inside LVGL and are not affected.
+ *
+ * The cache of an object is dropped on LV_EVENT_STATE_CHANGED and
+ * LV_EVENT_STYLE_CHANGED. That covers add/remove of styles, local style
+ * setters, lv_obj_report_style_change() and theme switches. While a style
+ * transition runs, descriptors are resolved without caching. The rect
+ * descriptor includes the opacity inherited from the parents; call
+ * invalidate() after fading a parent.
+ *
+ * Not included by lv.hpp: it checks obj->styles for running transitions,
+ * which have no getter. Checked against LVGL 9.4 (see
+ * LV_CPP_INTERNALS_OK).
+ *
+ * Heap allocation: NONE (LV_CPP_RESOLVED_STYLE_OBJECTS fixed slots;
+ * LVGL allocates the event descriptors)
+ */
+
+#include <lvgl.h>
+#include "version.hpp"
+
+#if !LV_CPP_INTERNALS_OK
+#error "resolved_style.hpp reads LVGL internals checked against LVGL 9.4; see LV_CPP_INTERNALS_OK"
+#endif
+
+#include <src/core/lv_obj_private.h>         // obj->styles, to detect transitions
+#include <src/core/lv_obj_style_private.h>
+#include <cstdint>
+#include "object.hpp"
+
+#ifndef LV_CPP_RESOLVED_STYLE_OBJECTS
+/// Objects with a resolved-style cache at once
+#define LV_CPP_RESOLVED_STYLE_OBJECTS 16
+#endif
+
+#ifndef LV_CPP_RESOLVED_STYLE_PARTS
+/// Parts cached per object
+#define LV_CPP_RESOLVED_STYLE_PARTS 3
+#endif
+
+namespace lv::resolved_style {
+
+struct Stats {
+    uint32_t hits;
+    uint32_t misses;          ///< Resolved and stored
+    uint32_t uncached;        ///< Resolved without caching (transition running, no room)
+    uint32_t invalidations;
+};
+
+namespace detail {
+
+enum Kind : uint8_t { kRect = 1, kLabel = 2, kLine = 4, kArc = 8 };
+
+struct PartCache {
+    lv_part_t part = 0;
+    uint8_t valid = 0;          ///< Kind bits
+    uint8_t rect_skip = 0;      ///< Sections the caller disabled (opa TRANSP) when `rect` was resolved
+    lv_draw_rect_dsc_t rect;
+    lv_draw_label_dsc_t label;
+    lv_draw_line_dsc_t line;
+    lv_draw_arc_dsc_t arc;
+};
+
+struct Entry {
+    lv_obj_t* obj = nullptr;    ///< nullptr: free slot
+    PartCache parts[LV_CPP_RESOLVED_STYLE_PARTS];
+};
+
+struct Table {
+    Entry entries[LV_CPP_RESOLVED_STYLE_OBJECTS];
+    Stats stats{};
+};
+
+[[nodiscard]] inline Table& table() noexcept {
+    static Table t;
+    return t;
+}
+
+[[nodiscard]] inline Entry* find(lv_obj_t* obj) noexcept {
+    for (Entry& e : table().entries) {
+        if (e.obj == obj) return &e;
+    }
+    return nullptr;
+}
+
+inline void clear(Entry& e) noexcept {
+    for (PartCache& p : e.parts) p.valid = 0;
+}
+
+/// A style transition changes values every frame without STYLE_CHANGED
+[[nodiscard]] inline bool transitioning(const lv_obj_t* obj) noexcept {
+    for (uint32_t i = 0; i < obj->style_cnt; ++i) {
+        if (obj->styles[i].is_trans) return true;
+    }
+    return false;
+}
+
+/// Cache of `part` (claims a free part slot), nullptr if uncacheable
+[[nodiscard]] inline PartCache* part_cache(lv_obj_t* obj, lv_part_t part) noexcept {
+    Entry* e = find(obj);
+    if (!e || transitioning(obj)) return nullptr;
+    PartCache* free_slot = nullptr;
+    for (PartCache& p : e->parts) {
+        if (p.valid && p.part == part) return &p;
+        if (!p.valid && !free_slot) free_slot = &p;
+    }
+    if (!free_slot) return nullptr;
+    free_slot->part = part;
+    return free_slot;
+}
+
+inline void event_cb(lv_event_t* e) noexcept {
+    auto* obj = static_cast<lv_obj_t*>(lv_event_get_current_target(e));
+    Entry* entry = find(obj);
+    if (!entry) return;
+    if (lv_event_get_code(e) == LV_EVENT_DELETE) {
+        *entry = Entry{};
+        return;
+    }
+    clear(*entry);
+    ++table().stats.invalidations;
+}
+
+/// Sections of lv_obj_init_draw_rect_dsc() the caller switched off by presetting opa TRANSP
+[[nodiscard]] inline uint8_t rect_skip(const lv_draw_rect_dsc_t& d) noexcept {
+    return static_cast<uint8_t>((d.bg_opa == LV_OPA_TRANSP) | (d.bg_image_opa == LV_OPA_TRANSP) << 1 |
+                                (d.border_opa == LV_OPA_TRANSP) << 2 | (d.outline_opa == LV_OPA_TRANSP) << 3 |
+                                (d.shadow_opa == LV_OPA_TRANSP) << 4);
+}
+
+/// Copy a cached descriptor, keeping the caller's layer, ids and user data
+template<typename Dsc>
+inline void restore(Dsc* out, const Dsc& cached) noexcept {
+    const lv_draw_dsc_base_t base = out->base;
+    *out = cached;
+    out->base = base;
+    out->base.obj = cached.base.obj;
+    out->base.part = cached.base.part;
+}
+
+/**
+ * @brief Cached lv_obj_init_draw_*_dsc()
+ *
+ * Descriptors are resolved into a freshly initialized copy (with the
+ * caller's disabled rect sections), so what is cached never depends on
+ * other fields the caller set beforehand.
+ */
+template<Kind K, typename Dsc>
+inline void init_cached(lv_obj_t* obj, lv_part_t part, Dsc* out, Dsc PartCache::*slot, void (*init)(Dsc*),
+                        void (*resolve)(lv_obj_t*, lv_part_t, Dsc*), uint8_t skip = 0) noexcept {
+    Stats& st = table().stats;
+    PartCache* pc = part_cache(obj, part);
+    if (pc && (pc->valid & K) && (K != kRect || pc->rect_skip == skip)) {
+        restore(out, pc->*slot);
+        ++st.hits;
+        return;
+    }
+    Dsc fresh;
+    init(&fresh);
+    if constexpr (K == kRect) {
+        if (skip & 1) fresh.bg_opa = LV_OPA_TRANSP;
+        if (skip & 2) fresh.bg_image_opa = LV_OPA_TRANSP;
+        if (skip & 4) fresh.border_opa = LV_OPA_TRANSP;
+        if (skip & 8) fresh.outline_opa = LV_OPA_TRANSP;
+        if (skip & 16) fresh.shadow_opa = LV_OPA_TRANSP;
+    }
+    resolve(obj, part, &fresh);
+    restore(out, fresh);
+    if (!pc) {
+        ++st.uncached;
+        return;
+    }
+    pc->*slot = fresh;
+    pc->valid |= K;
+    if constexpr (K == kRect) pc->rect_skip = skip;
+    ++st.misses;
+}
+
+} // namespace detail
+
+/**
+ * @brief Cache resolved descriptors of `obj` from now on
+ * @return false when LV_CPP_RESOLVED_STYLE_OBJECTS is reached
+ */
+inline bool enable(ObjectView obj) noexcept {
+    lv_obj_t* o = obj.get();
+    if (!o) return false;
+    if (detail::find(o)) return true;
+    detail::Entry* e = detail::find(nullptr);
+    if (!e) {
+        LV_LOG_WARN("resolved styles exhausted, raise LV_CPP_RESOLVED_STYLE_OBJECTS");
+        return false;
+    }
+    *e = detail::Entry{};
+    e->obj = o;
+    lv_obj_add_event_cb(o, &detail::event_cb, LV_EVENT_STATE_CHANGED, nullptr);
+    lv_obj_add_event_cb(o, &detail::event_cb, LV_EVENT_STYLE_CHANGED, nullptr);
+    lv_obj_add_event_cb(o, &detail::event_cb, LV_EVENT_DELETE, nullptr);
+    return true;
+}
+
+inline void disable(ObjectView obj) noexcept {
+    detail::Entry* e = obj.get() ? detail::find(obj.get()) : nullptr;
+    if (!e) return;
+    lv_obj_remove_event_cb_with_user_data(obj.get(), &detail::event_cb, nullptr);
+    *e = detail::Entry{};
+}
+
+[[nodiscard]] inline bool enabled(ObjectView obj) noexcept {
+    return obj.get() && detail::find(obj.get());
+}
+
+/// Drop the cached descriptors (for changes LVGL reports no event for)
+inline void invalidate(ObjectView obj) noexcept {
+    if (detail::Entry* e = obj.get() ? detail::find(obj.get()) : nullptr) {
+        detail::clear(*e);
+        ++detail::table().stats.invalidations;
+    }
+}
+
+/// lv_obj_init_draw_rect_dsc() from the cache when the styles did not change
+inline void init_rect_dsc(lv_obj_t* obj, lv_part_t part, lv_draw_rect_dsc_t* dsc) noexcept {
+    detail::init_cached<detail::kRect>(obj, part, dsc, &detail::PartCache::rect, &lv_draw_rect_dsc_init,
+                                       &lv_obj_init_draw_rect_dsc, detail::rect_skip(*dsc));
+}
+
+/// lv_obj_init_draw_label_dsc() from the cache when the styles did not change
+inline void init_label_dsc(lv_obj_t* obj, lv_part_t part, lv_draw_label_dsc_t* dsc) noexcept {
+    detail::init_cached<detail::kLabel>(obj, part, dsc, &detail::PartCache::label, &lv_draw_label_dsc_init,
+                                        &lv_obj_init_draw_label_dsc);
+}
+
+/// lv_obj_init_draw_line_dsc() from the cache when the styles did not change
+inline void init_line_dsc(lv_obj_t* obj, lv_part_t part, lv_draw_line_dsc_t* dsc) noexcept {
+    detail::init_cached<detail::kLine>(obj, part, dsc, &detail::PartCache::line, &lv_draw_line_dsc_init,
+                                       &lv_obj_init_draw_line_dsc);
+}
+
+/// lv_obj_init_draw_arc_dsc() from the cache when the styles did not change
+inline void init_arc_dsc(lv_obj_t* obj, lv_part_t part, lv_draw_arc_dsc_t* dsc) noexcept {
+    detail::init_cached<detail::kArc>(obj, part, dsc, &detail::PartCache::arc, &lv_draw_arc_dsc_init,
+                                      &lv_obj_init_draw_arc_dsc);
+}
+
+[[nodiscard]] inline Stats stats() noexcept {
+    return detail::table().stats;
+}
+
+inline void reset_stats() noexcept {
+    detail::table().stats = {};
+}
+
+} // namespace lv::resolved_style
@@ -0,0 +1,389 @@
+#pragma once
+
+/**
+ * @file resume.hpp
+ * @brief Show the last frame again at once after suspend, re-rendering only what changed
+ *
+ * A panel that loses its contents while the device sleeps is normally
+ * repainted by invalidating the whole screen on wake, a full render
+ * before the user sees anything. keep_frame() keeps a copy of every area
+ * the display flushes in a reserved frame-sized buffer, so the last
+ * frame the panel showed is always at hand:
+ *
+ * @code
+ * #include <lv/core/resume.hpp>
+ *
+ * lv_display_t* disp = lv_display_get_default();
+ * lv::resume::keep_frame(disp);                 // once the flush callback is set
+ * ...
+ * lv::resume::suspend(disp);                    // before the panel sleeps
+ * clock.text("07:31");                          // invalidations are kept, not rendered
+ * ...
+ * lv::resume::resume(disp);                     // old frame flushed as is, then the clock
+ *
+ * lv::resume::suspend(disp, "A:/var/frame.bin"); // deep sleep: keep it on disk too
+ * lv::resume::resume(disp, "A:/var/frame.bin");  // after a reboot, before the UI is built
+ * @endcode
+ *
+ * suspend() pauses the refresh timer and keeps it paused while objects
+ * invalidate. resume() hands the kept frame to the driver's own flush
+ * callback in one full-screen flush and restarts the timer. The areas
+ * invalidated since suspend() (a clock, a notification) are then
+ * rendered by the next refresh, and nothing else.
+ *
+ * Call keep_frame() after the driver's flush callback is set and before
+ * pixel::convert_on_flush() or rotate_on_flush(), so the frame is kept as the
+ * panel receives it. A frame saved to a file is loaded only by a display
+ * of the same size and color format.
+ *
+ * Not included by lv.hpp: it swaps lv_display_t::flush_cb and drives the
+ * flush state (flushing, buf_act, color_format, rotation) by hand, none of
+ * which is public. Checked against LVGL 9.4 (see LV_CPP_INTERNALS_OK).
+ *
+ * Heap allocation: one frame-sized draw buffer per display from the
+ * DrawBufPool (LV_CPP_RESUME_DISPLAYS fixed slots)
+ */
+
+#include <lvgl.h>
+#include "version.hpp"
+
+#if !LV_CPP_INTERNALS_OK
+#error "resume.hpp reads LVGL internals checked against LVGL 9.4; see LV_CPP_INTERNALS_OK"
+#endif
+
+#include <src/display/lv_display_private.h>   // flush_cb, flush_wait_cb, flushing, buf_act, buf_1/buf_2, hor_res
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include "fs.hpp"
+#include "../draw/draw_buf.hpp"
+
+#ifndef LV_CPP_RESUME_DISPLAYS
+/// Displays whose last frame can be kept at once
+#define LV_CPP_RESUME_DISPLAYS 2
+#endif
+
+namespace lv::resume {
+
+struct Stats {
+    uint32_t copies = 0;          ///< Flushed areas copied into a kept frame
+    uint32_t presents = 0;        ///< Kept frames flushed by resume() or present()
+    uint32_t saves = 0;           ///< Frames written to a file
+    uint32_t loads = 0;           ///< Frames read from a file
+    uint32_t held = 0;            ///< Refresh requests held back while suspended
+    uint32_t last_present_us = 0; ///< Duration of the last present(), flush included
+};
+
+namespace detail {
+
+/// Header of a saved frame
+struct FileHeader {
+    uint32_t magic;
+    uint32_t w, h, stride;
+    uint32_t cf;
+};
+
+inline constexpr uint32_t FRAME_MAGIC = 0x5246564cu;   // "LVFR"
+
+struct Frame {
+    lv_display_t* disp = nullptr;      ///< nullptr: free slot
+    lv_display_flush_cb_t flush = nullptr;
+    lv_draw_buf_t* shadow = nullptr;   ///< Native panel orientation (hor_res x ver_res)
+    lv_color_format_t cf = LV_COLOR_FORMAT_UNKNOWN;   ///< Format of the copied pixels
+    bool valid = false;                ///< A whole frame went through since keep_frame()
+    bool suspended = false;
+};
+
+struct State {
+    Frame frames[LV_CPP_RESUME_DISPLAYS];
+    Stats stats;
+};
+
+[[nodiscard]] inline State& state() noexcept {
+    static State s;
+    return s;
+}
+
+[[nodiscard]] inline Frame* find(const lv_display_t* disp) noexcept {
+    for (Frame& f : state().frames) {
+        if (f.disp == disp) return &f;
+    }
+    return nullptr;
+}
+
+[[nodiscard]] inline uint32_t now_us() noexcept {
+    using namespace std::chrono;
+    return static_cast<uint32_t>(duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+[[nodiscard]] inline bool alloc_shadow(Frame& f) noexcept {
+    if (f.shadow) lv_draw_buf_destroy(f.shadow);
+    f.cf = lv_display_get_color_format(f.disp);
+    f.shadow = lv_draw_buf_create_ex(draw::pool_handlers(), static_cast<uint32_t>(f.disp->hor_res),
+                                     static_cast<uint32_t>(f.disp->ver_res), f.cf, LV_STRIDE_AUTO);
+    f.valid = false;
+    return f.shadow != nullptr;
+}
+
+/// Copy the flushed `area` into the shadow; partial buffers hold the area alone, others the whole frame
+inline void copy_area(Frame& f, const lv_area_t* area, const uint8_t* px) noexcept {
+    const lv_display_t* disp = f.disp;
+    const lv_color_format_t cf = disp->color_format;
+    const uint32_t bpp = lv_color_format_get_size(cf);
+    lv_draw_buf_t* dst = f.shadow;
+    if (!dst || bpp != lv_color_format_get_size(dst->header.cf)) return;
+    f.cf = cf;
+
+    lv_area_t clip;
+    const lv_area_t bounds{0, 0, static_cast<int32_t>(dst->header.w) - 1, static_cast<int32_t>(dst->header.h) - 1};
+    if (!lv_area_intersect(&clip, area, &bounds)) return;
+    const bool partial = disp->render_mode == LV_DISPLAY_RENDER_MODE_PARTIAL;
+    const uint32_t src_stride = partial ? lv_draw_buf_width_to_stride(lv_area_get_width(area), cf)
+                                        : disp->buf_act->header.stride;
+    const int32_t ox = partial ? area->x1 : 0, oy = partial ? area->y1 : 0;
+    const size_t row = static_cast<size_t>(lv_area_get_width(&clip)) * bpp;
+    for (int32_t y = clip.y1; y <= clip.y2; ++y) {
+        std::memcpy(dst->data + static_cast<size_t>(y) * dst->header.stride + static_cast<size_t>(clip.x1) * bpp,
+                    px + static_cast<size_t>(y - oy) * src_stride + static_cast<size_t>(clip.x1 - ox) * bpp, row);
+    }
+    ++state().stats.copies;
+}
+
+inline void keeping_flush_cb(lv_display_t* disp, const lv_area_t* area, uint8_t* px) {
+    Frame* f = find(disp);
+    if (!f) {
+        lv_display_flush_ready(disp);
+        return;
+    }
+    copy_area(*f, area, px);
+    f->flush(disp, area, px);
+}
+
+/// The first refresh after keep_frame() covers the whole screen
+inline void refr_ready_cb(lv_event_t* e) noexcept {
+    auto* disp = static_cast<lv_display_t*>(lv_event_get_current_target(e));
+    if (Frame* f = find(disp)) f->valid = f->shadow != nullptr;
+    lv_display_remove_event_cb_with_user_data(disp, &refr_ready_cb, nullptr);
+}
+
+/// Invalidations while suspended stay queued; keep the timer from rendering them
+inline void refr_request_cb(lv_event_t* e) noexcept {
+    auto* disp = static_cast<lv_display_t*>(lv_event_get_current_target(e));
+    const Frame* f = find(disp);
+    if (!f || !f->suspended) return;
+    if (lv_timer_t* t = lv_display_get_refr_timer(disp)) lv_timer_pause(t);
+    ++state().stats.held;
+}
+
+inline void resolution_cb(lv_event_t* e) noexcept {
+    if (Frame* f = find(static_cast<lv_display_t*>(lv_event_get_current_target(e)))) {
+        if (!alloc_shadow(*f)) LV_LOG_WARN("resume: no memory for the resized frame");
+    }
+}
+
+inline void release(Frame& f) noexcept {
+    if (f.shadow) lv_draw_buf_destroy(f.shadow);
+    f = Frame{};
+}
+
+inline void delete_cb(lv_event_t* e) noexcept {
+    if (Frame* f = find(static_cast<lv_display_t*>(lv_event_get_current_target(e)))) release(*f);
+}
+
+/// Flush the way lv_refr does: as the last area of the frame, then wait for the driver
+inline void flush_frame(Frame& f, uint8_t* px) noexcept {
+    lv_display_t* disp = f.disp;
+    const lv_area_t full{0, 0, static_cast<int32_t>(f.shadow->header.w) - 1,
+                         static_cast<int32_t>(f.shadow->header.h) - 1};
+    const lv_color_format_t render_cf = disp->color_format;
+    const lv_display_rotation_t rot = disp->rotation;
+    disp->color_format = f.cf;
+    disp->rotation = LV_DISPLAY_ROTATION_0;
+    disp->flushing = 1;
+    disp->flushing_last = 1;
+    disp->last_area = 1;
+    disp->last_part = 1;
+    f.flush(disp, &full, px);
+    if (disp->flush_wait_cb) {
+        if (disp->flushing) disp->flush_wait_cb(disp);
+        disp->flushing = 0;
+    } else {
+        while (disp->flushing) {}
+    }
+    disp->color_format = render_cf;
+    disp->rotation = rot;
+}
+
+} // namespace detail
+
+/**
+ * @brief Keep a copy of every area `disp` flushes from now on
+ *
+ * Reserves a frame-sized buffer and invalidates the active screen once,
+ * so the kept frame is complete after the next refresh. A resolution
+ * change (display_mode::apply()) reserves the buffer again.
+ *
+ * @return false without a free slot (LV_CPP_RESUME_DISPLAYS), a flush
+ *         callback or memory
+ */
+inline bool keep_frame(lv_display_t* disp) noexcept {
+    if (!disp || !disp->flush_cb) return false;
+    if (detail::find(disp)) return true;
+    detail::Frame* f = detail::find(nullptr);
+    if (!f) {
+        LV_LOG_WARN("resume: raise LV_CPP_RESUME_DISPLAYS");
+        return false;
+    }
+    f->disp = disp;
+    if (!detail::alloc_shadow(*f)) {
+        *f = detail::Frame{};
+        return false;
+    }
+    f->flush = disp->flush_cb;
+    lv_display_set_flush_cb(disp, &detail::keeping_flush_cb);
+    lv_display_add_event_cb(disp, &detail::refr_request_cb, LV_EVENT_REFR_REQUEST, nullptr);
+    lv_display_add_event_cb(disp, &detail::refr_ready_cb, LV_EVENT_REFR_READY, nullptr);
+    lv_display_add_event_cb(disp, &detail::resolution_cb, LV_EVENT_RESOLUTION_CHANGED, nullptr);
+    lv_display_add_event_cb(disp, &detail::delete_cb, LV_EVENT_DELETE, nullptr);
+    lv_obj_invalidate(lv_display_get_screen_active(disp));
+    return true;
+}
+
+/// Give the driver its flush callback back and free the kept frame
+inline void release(lv_display_t* disp) noexcept {
+    detail::Frame* f = detail::find(disp);
+    if (!f) return;
+    if (f->suspended) {
+        if (lv_timer_t* t = lv_display_get_refr_timer(disp)) lv_timer_resume(t);
+    }
+    lv_display_set_flush_cb(disp, f->flush);
+    lv_display_remove_event_cb_with_user_data(disp, &detail::refr_request_cb, nullptr);
+    lv_display_remove_event_cb_with_user_data(disp, &detail::refr_ready_cb, nullptr);
+    lv_display_remove_event_cb_with_user_data(disp, &detail::resolution_cb, nullptr);
+    lv_display_remove_event_cb_with_user_data(disp, &detail::delete_cb, nullptr);
+    detail::release(*f);
+}
+
+/// A complete frame is kept for `disp`
+[[nodiscard]] inline bool has_frame(const lv_display_t* disp) noexcept {
+    const detail::Frame* f = detail::find(disp);
+    return f && f->valid;
+}
+
+[[nodiscard]] inline bool suspended(const lv_display_t* disp) noexcept {
+    const detail::Frame* f = detail::find(disp);
+    return f && f->suspended;
+}
+
+/**
+ * @brief Write the kept frame to `path` (an lv_fs path)
+ *
+ * Pending invalidations are rendered first, so the file holds what the
+ * UI shows now.
+ */
+inline bool save(lv_display_t* disp, const char* path) noexcept {
+    detail::Frame* f = detail::find(disp);
+    if (!f || !path) return false;
+    if (!f->suspended) lv_refr_now(disp);
+    if (!f->valid) return false;
+    const lv_image_header_t& h = f->shadow->header;
+    const detail::FileHeader head{detail::FRAME_MAGIC, h.w, h.h, h.stride, static_cast<uint32_t>(f->cf)};
+    File file(path, LV_FS_MODE_WR);
+    const uint32_t size = h.stride * h.h;
+    uint32_t written = 0;
+    if (!file || file.write(&head, sizeof(head)) != LV_FS_RES_OK ||
+        file.write(f->shadow->data, size, &written) != LV_FS_RES_OK || written != size) {
+        LV_LOG_WARN("resume: could not save the frame to %s", path);
+        return false;
+    }
+    ++detail::state().stats.saves;
+    return true;
+}
+
+/// Read a frame written by save() into the kept frame of `disp`
+inline bool load(lv_display_t* disp, const char* path) noexcept {
+    detail::Frame* f = detail::find(disp);
+    if (!f || !f->shadow || !path) return false;
+    File file(path);
+    detail::FileHeader head{};
+    uint32_t n = 0;
+    if (!file || file.read(&head, sizeof(head), &n) != LV_FS_RES_OK || n != sizeof(head)) return false;
+    const lv_image_header_t& h = f->shadow->header;
+    if (head.magic != detail::FRAME_MAGIC || head.w != h.w || head.h != h.h || head.stride != h.stride ||
+        lv_color_format_get_size(static_cast<lv_color_format_t>(head.cf)) != lv_color_format_get_size(h.cf)) {
+        LV_LOG_WARN("resume: %s was saved by another display", path);
+        return false;
+    }
+    const uint32_t size = h.stride * h.h;
+    if (file.read(f->shadow->data, size, &n) != LV_FS_RES_OK || n != size) return false;
+    f->cf = static_cast<lv_color_format_t>(head.cf);
+    f->valid = true;
+    ++detail::state().stats.loads;
+    return true;
+}
+
+/**
+ * @brief Flush the kept frame to the panel now, without rendering
+ *
+ * Partial displays get the kept buffer itself. Direct and full displays
+ * get it copied into their draw buffers (both, so the next refresh
+ * starts from it).
+ */
+inline bool present(lv_display_t* disp) noexcept {
+    detail::Frame* f = detail::find(disp);
+    if (!f || !f->valid || disp->flushing) return false;
+    const uint32_t start = detail::now_us();
+    if (disp->render_mode == LV_DISPLAY_RENDER_MODE_PARTIAL) {
+        detail::flush_frame(*f, f->shadow->data);
+    } else {
+        const uint32_t size = f->shadow->header.stride * f->shadow->header.h;
+        for (lv_draw_buf_t* buf : {disp->buf_1, disp->buf_2}) {
+            if (buf && buf->data_size >= size) std::memcpy(buf->data, f->shadow->data, size);
+        }
+        detail::flush_frame(*f, disp->buf_act->data);
+        if (lv_display_is_double_buffered(disp)) {
+            disp->buf_act = disp->buf_act == disp->buf_1 ? disp->buf_2 : disp->buf_1;
+        }
+    }
+    detail::Stats& st = detail::state().stats;
+    ++st.presents;
+    st.last_present_us = detail::now_us() - start;
+    return true;
+}
+
+/**
+ * @brief Stop rendering `disp`, optionally saving the kept frame to `path`
+ *
+ * Invalidations made while suspended are kept for resume().
+ */
+inline bool suspend(lv_display_t* disp, const char* path = nullptr) noexcept {
+    detail::Frame* f = detail::find(disp);
+    if (!f) return false;
+    const bool saved = !path || save(disp, path);
+    f->suspended = true;
+    if (lv_timer_t* t = lv_display_get_refr_timer(disp)) lv_timer_pause(t);
+    return saved;
+}
+
+/**
+ * @brief Show the kept frame (read from `path` first, if given) and render from there on
+ *
+ * Only the areas invalidated since suspend() are rendered by the next
+ * refresh. Without a kept frame the active screen is invalidated instead.
+ */
+inline bool resume(lv_display_t* disp, const char* path = nullptr) noexcept {
+    detail::Frame* f = detail::find(disp);
+    if (!f) return false;
+    f->suspended = false;
+    if (path) load(disp, path);
+    const bool shown = present(disp);
+    if (!shown) lv_obj_invalidate(lv_display_get_screen_active(disp));
+    if (lv_timer_t* t = lv_display_get_refr_timer(disp)) lv_timer_resume(t);
+    return shown;
+}
+
+[[nodiscard]] inline Stats stats() noexcept { return detail::state().stats; }
+
+inline void reset_stats() noexcept { detail::state().stats = Stats{}; }
+
+} // namespace lv::resume
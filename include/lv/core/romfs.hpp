@@ -0,0 +1,291 @@
+#pragma once
+
+/**
+ * @file romfs.hpp
+ * @brief Read-only lv_fs driver over assets linked into the firmware
+ *
+ * APIs that take lv_fs paths (Lottie::src_file, FreeType, image paths)
+ * cannot use an asset embedded as a C array without copying it somewhere
+ * first. RomFs registers a drive letter that serves a table of
+ * {path, data, size} entries, generated by scripts/romfs.py:
+ *
+ * @code
+ * #include "assets_romfs.hpp"               // scripts/romfs.py assets/ -o assets_romfs.hpp
+ * lv::fs::RomFs::mount('R', assets::files);
+ * lottie.src_file("R:/anim/loader.json");
+ * static lv::MappedImage bg("R:/img/bg.bin");  // points into the table, no copy
+ * @endcode
+ *
+ * lv_fs reads are a memcpy from the table. fs::MappedFile (and MappedImage,
+ * MappedFont, BinaryPack on top of it) recognises RomFs paths and uses the
+ * table data in place. Directories are implied by the paths and can be
+ * listed with fs::Directory. Writes fail with LV_FS_RES_NOT_IMP.
+ *
+ * The table must be sorted by path (the script emits it so); lookups are
+ * a binary search. Paths are stored without a leading '/'.
+ *
+ * Heap allocation: NONE (fixed drive and handle tables)
+ */
+
+#include <lvgl.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#ifndef LV_CPP_ROMFS_DRIVES
+/// RomFs drive letters mounted at once
+#define LV_CPP_ROMFS_DRIVES 2
+#endif
+
+#ifndef LV_CPP_ROMFS_HANDLES
+/// Files and directories open at once on all RomFs drives
+#define LV_CPP_ROMFS_HANDLES 8
+#endif
+
+namespace lv::fs {
+
+/// One embedded file
+struct RomEntry {
+    const char* path;       ///< Relative path, '/' separated, no leading '/'
+    const uint8_t* data;
+    uint32_t size;
+};
+
+class RomFs;
+
+namespace detail::romfs {
+
+struct Handle {
+    std::atomic<bool> used{false};
+    const RomEntry* entry = nullptr;    ///< File: the entry; directory: next entry to list
+    uint32_t pos = 0;                   ///< File: read position; directory: prefix length
+    const char* prefix = nullptr;       ///< Directory: its path ("dir/"), `pos` bytes long
+    const RomEntry* last_dir = nullptr; ///< Directory: entry whose subdirectory was listed last
+};
+
+[[nodiscard]] inline Handle* handles() noexcept {
+    static Handle table[LV_CPP_ROMFS_HANDLES];
+    return table;
+}
+
+[[nodiscard]] inline Handle* acquire() noexcept {
+    Handle* table = handles();
+    for (uint32_t i = 0; i < LV_CPP_ROMFS_HANDLES; ++i) {
+        bool expected = false;
+        if (table[i].used.compare_exchange_strong(expected, true, std::memory_order_acquire)) return &table[i];
+    }
+    LV_LOG_WARN("RomFs: all handles in use (raise LV_CPP_ROMFS_HANDLES)");
+    return nullptr;
+}
+
+inline void release(Handle* h) noexcept { h->used.store(false, std::memory_order_release); }
+
+[[nodiscard]] inline const char* skip_slashes(const char* path) noexcept {
+    while (*path == '/') ++path;
+    return path;
+}
+
+} // namespace detail::romfs
+
+/**
+ * @brief Drive serving a sorted RomEntry table
+ *
+ * Instances live in a static table (LV_CPP_ROMFS_DRIVES): LVGL keeps the
+ * driver registered for the rest of the program.
+ */
+class RomFs {
+    lv_fs_drv_t m_drv;
+    const RomEntry* m_entries = nullptr;
+    uint32_t m_count = 0;
+
+    using Handle = detail::romfs::Handle;
+
+    [[nodiscard]] static RomFs* drives() noexcept {
+        static RomFs table[LV_CPP_ROMFS_DRIVES];
+        return table;
+    }
+
+    [[nodiscard]] static RomFs& self(lv_fs_drv_t* drv) noexcept { return *static_cast<RomFs*>(drv->user_data); }
+
+    /// First entry not less than `path`
+    [[nodiscard]] const RomEntry* lower_bound(const char* path) const noexcept {
+        uint32_t lo = 0, hi = m_count;
+        while (lo < hi) {
+            const uint32_t mid = (lo + hi) / 2;
+            if (std::strcmp(m_entries[mid].path, path) < 0) lo = mid + 1;
+            else hi = mid;
+        }
+        return m_entries + lo;
+    }
+
+    static void* open_cb(lv_fs_drv_t* drv, const char* path, lv_fs_mode_t mode) {
+        if (mode & LV_FS_MODE_WR) return nullptr;
+        const RomEntry* e = self(drv).find(path);
+        if (!e) return nullptr;
+        Handle* h = detail::romfs::acquire();
+        if (!h) return nullptr;
+        h->entry = e;
+        h->pos = 0;
+        return h;
+    }
+
+    static lv_fs_res_t close_cb(lv_fs_drv_t*, void* file) {
+        detail::romfs::release(static_cast<Handle*>(file));
+        return LV_FS_RES_OK;
+    }
+
+    static lv_fs_res_t read_cb(lv_fs_drv_t*, void* file, void* buf, uint32_t btr, uint32_t* br) {
+        auto* h = static_cast<Handle*>(file);
+        const uint32_t left = h->entry->size - h->pos;
+        const uint32_t n = btr < left ? btr : left;
+        std::memcpy(buf, h->entry->data + h->pos, n);
+        h->pos += n;
+        *br = n;
+        return LV_FS_RES_OK;
+    }
+
+    static lv_fs_res_t seek_cb(lv_fs_drv_t*, void* file, uint32_t pos, lv_fs_whence_t whence) {
+        auto* h = static_cast<Handle*>(file);
+        const uint32_t size = h->entry->size;
+        uint64_t to = pos;
+        if (whence == LV_FS_SEEK_CUR) to += h->pos;
+        else if (whence == LV_FS_SEEK_END) to = pos < size ? size - pos : 0;
+        h->pos = to < size ? static_cast<uint32_t>(to) : size;
+        return LV_FS_RES_OK;
+    }
+
+    static lv_fs_res_t tell_cb(lv_fs_drv_t*, void* file, uint32_t* pos) {
+        *pos = static_cast<Handle*>(file)->pos;
+        return LV_FS_RES_OK;
+    }
+
+    static void* dir_open_cb(lv_fs_drv_t* drv, const char* path) {
+        const RomFs& fs = self(drv);
+        path = detail::romfs::skip_slashes(path);
+        uint32_t len = static_cast<uint32_t>(std::strlen(path));
+        while (len && path[len - 1] == '/') --len;
+        const RomEntry* first = fs.m_entries;
+        if (len) {
+            // Entries under "dir/" sort together, right after "dir/"
+            char prefix[LV_FS_MAX_PATH_LENGTH];
+            if (len + 2 > sizeof(prefix)) return nullptr;
+            std::memcpy(prefix, path, len);
+            prefix[len] = '/';
+            prefix[len + 1] = '\0';
+            first = fs.lower_bound(prefix);
+            if (first == fs.m_entries + fs.m_count || std::strncmp(first->path, prefix, len + 1) != 0) return nullptr;
+            ++len;
+        }
+        Handle* h = detail::romfs::acquire();
+        if (!h) return nullptr;
+        h->entry = first;
+        h->pos = len;
+        h->prefix = first != fs.end() ? first->path : "";
+        h->last_dir = nullptr;
+        return h;
+    }
+
+    static lv_fs_res_t dir_read_cb(lv_fs_drv_t* drv, void* dir, char* fn, uint32_t fn_len) {
+        const RomFs& fs = self(drv);
+        auto* h = static_cast<Handle*>(dir);
+        fn[0] = '\0';
+        for (; h->entry != fs.end(); ++h->entry) {
+            const RomEntry& e = *h->entry;
+            if (std::strncmp(e.path, h->prefix, h->pos) != 0) break;   // past the directory
+            const char* rest = e.path + h->pos;
+            const char* slash = std::strchr(rest, '/');
+            const auto n = static_cast<uint32_t>(slash ? slash - rest : std::strlen(rest));
+            if (slash) {
+                // Subdirectory: its entries are adjacent, list it once as "/name"
+                if (h->last_dir && std::strncmp(h->last_dir->path + h->pos, rest, n + 1) == 0) continue;
+                if (n + 2 > fn_len) return LV_FS_RES_INV_PARAM;
+                fn[0] = '/';
+                std::memcpy(fn + 1, rest, n);
+                fn[n + 1] = '\0';
+                h->last_dir = &e;
+            } else {
+                if (n + 1 > fn_len) return LV_FS_RES_INV_PARAM;
+                std::memcpy(fn, rest, n + 1);
+            }
+            ++h->entry;
+            return LV_FS_RES_OK;
+        }
+        return LV_FS_RES_OK;
+    }
+
+    static lv_fs_res_t dir_close_cb(lv_fs_drv_t*, void* dir) {
+        detail::romfs::release(static_cast<Handle*>(dir));
+        return LV_FS_RES_OK;
+    }
+
+public:
+    /**
+     * @brief Register `table` under drive `letter`
+     * @return The drive, or nullptr if the table is not sorted or no slot is free
+     */
+    static RomFs* mount(char letter, const RomEntry* table, uint32_t count) noexcept {
+        for (uint32_t i = 1; i < count; ++i) {
+            if (std::strcmp(table[i - 1].path, table[i].path) >= 0) {
+                LV_LOG_WARN("RomFs: table not sorted at %s", table[i].path);
+                return nullptr;
+            }
+        }
+        RomFs* slot = nullptr;
+        for (uint32_t i = 0; i < LV_CPP_ROMFS_DRIVES; ++i) {
+            RomFs& d = drives()[i];
+            if (d.m_entries && d.m_drv.letter == letter) slot = &d;   // remount: swap the table
+            else if (!slot && !d.m_entries) slot = &d;
+        }
+        if (!slot) {
+            LV_LOG_WARN("RomFs: no free drive (raise LV_CPP_ROMFS_DRIVES)");
+            return nullptr;
+        }
+        const bool registered = slot->m_entries != nullptr;
+        slot->m_entries = table;
+        slot->m_count = count;
+        if (registered) return slot;
+        lv_fs_drv_init(&slot->m_drv);
+        slot->m_drv.letter = letter;
+        slot->m_drv.open_cb = &RomFs::open_cb;
+        slot->m_drv.close_cb = &RomFs::close_cb;
+        slot->m_drv.read_cb = &RomFs::read_cb;
+        slot->m_drv.seek_cb = &RomFs::seek_cb;
+        slot->m_drv.tell_cb = &RomFs::tell_cb;
+        slot->m_drv.dir_open_cb = &RomFs::dir_open_cb;
+        slot->m_drv.dir_read_cb = &RomFs::dir_read_cb;
+        slot->m_drv.dir_close_cb = &RomFs::dir_close_cb;
+        slot->m_drv.user_data = slot;
+        lv_fs_drv_register(&slot->m_drv);
+        return slot;
+    }
+
+    template<size_t N>
+    static RomFs* mount(char letter, const RomEntry (&table)[N]) noexcept {
+        return mount(letter, table, static_cast<uint32_t>(N));
+    }
+
+    /// Entry for an LVGL path ("R:/img/bg.bin") on any mounted RomFs drive
+    [[nodiscard]] static const RomEntry* lookup(const char* path) noexcept {
+        if (!path || !path[0] || path[1] != ':') return nullptr;
+        for (uint32_t i = 0; i < LV_CPP_ROMFS_DRIVES; ++i) {
+            const RomFs& d = drives()[i];
+            if (d.m_entries && d.m_drv.letter == path[0]) return d.find(path + 2);
+        }
+        return nullptr;
+    }
+
+    /// Entry for a path on this drive (leading '/' optional), nullptr if absent
+    [[nodiscard]] const RomEntry* find(const char* path) const noexcept {
+        path = detail::romfs::skip_slashes(path);
+        const RomEntry* e = lower_bound(path);
+        return e != m_entries + m_count && std::strcmp(e->path, path) == 0 ? e : nullptr;
+    }
+
+    [[nodiscard]] char letter() const noexcept { return m_drv.letter; }
+    [[nodiscard]] uint32_t file_count() const noexcept { return m_count; }
+    [[nodiscard]] const RomEntry* begin() const noexcept { return m_entries; }
+    [[nodiscard]] const RomEntry* end() const noexcept { return m_entries + m_count; }
+};
+
+} // namespace lv::fs
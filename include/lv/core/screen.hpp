@@ -12,6 +12,12 @@
 #include "event.hpp"
 #include "style.hpp"
 #include "anim.hpp"
+#include "component.hpp"
+#include "snapshot.hpp"
+#include "thread.hpp"
+#include "prefetch.hpp"
+#include <cstddef>
+#include <cstdint>
 
 namespace lv {
 
@@ -59,6 +65,199 @@ namespace screen_anim {
     constexpr auto out_bottom = LV_SCR_LOAD_ANIM_OUT_BOTTOM;
 } // namespace screen_anim
 
+// ==================== Snapshot Transitions ====================
+
+/// How Navigator animates screen changes
+enum class TransitionMode : uint8_t {
+    live,       ///< lv_screen_load_anim(): both screens render every frame
+    snapshot,   ///< screen_load_snapshot(): two images render (needs LV_USE_SNAPSHOT)
+};
+
+#if LV_USE_SNAPSHOT && LV_USE_IMAGE
+
+namespace detail {
+
+/// The one running snapshot transition; the draw buffers are kept for the next one
+struct SnapshotTransition {
+    lv_draw_buf_t* bufs[2] = {nullptr, nullptr};
+    lv_obj_t* stage = nullptr;     ///< Temporary screen holding the two images
+    lv_obj_t* from_img = nullptr;
+    lv_obj_t* to_img = nullptr;
+    lv_obj_t* target = nullptr;    ///< Live screen loaded on completion
+    lv_screen_load_anim_t anim = LV_SCR_LOAD_ANIM_NONE;
+    int32_t w = 0;
+    int32_t h = 0;
+};
+
+[[nodiscard]] inline SnapshotTransition& snapshot_transition() noexcept {
+    static SnapshotTransition t;
+    return t;
+}
+
+/// Snapshot into a pooled buffer, reallocating it only if it is too small
+[[nodiscard]] inline lv_draw_buf_t* snapshot_into(lv_obj_t* obj, lv_draw_buf_t*& buf,
+                                                  lv_color_format_t cf) noexcept {
+    if (buf) {
+        lv_image_cache_drop(buf);    // same source pointer, new pixels
+        if (lv_snapshot_take_to_draw_buf(obj, cf, buf) == LV_RESULT_OK) return buf;
+        lv_draw_buf_destroy(buf);
+    }
+    buf = lv_snapshot_create_draw_buf(obj, cf);
+    if (buf && lv_snapshot_take_to_draw_buf(obj, cf, buf) != LV_RESULT_OK) {
+        lv_draw_buf_destroy(buf);
+        buf = nullptr;
+    }
+    return buf;
+}
+
+/// Position both images for progress 0..1000, mirroring lv_screen_load_anim()
+inline void snapshot_transition_exec(void*, int32_t progress) noexcept {
+    const SnapshotTransition& t = snapshot_transition();
+    auto at = [progress](int32_t start, int32_t end) { return start + (end - start) * progress / 1000; };
+    lv_obj_t* from = t.from_img;
+    lv_obj_t* to = t.to_img;
+    switch (t.anim) {
+    case LV_SCR_LOAD_ANIM_MOVE_LEFT:   lv_obj_set_x(from, at(0, -t.w)); lv_obj_set_x(to, at(t.w, 0)); break;
+    case LV_SCR_LOAD_ANIM_MOVE_RIGHT:  lv_obj_set_x(from, at(0, t.w));  lv_obj_set_x(to, at(-t.w, 0)); break;
+    case LV_SCR_LOAD_ANIM_MOVE_TOP:    lv_obj_set_y(from, at(0, -t.h)); lv_obj_set_y(to, at(t.h, 0)); break;
+    case LV_SCR_LOAD_ANIM_MOVE_BOTTOM: lv_obj_set_y(from, at(0, t.h));  lv_obj_set_y(to, at(-t.h, 0)); break;
+    case LV_SCR_LOAD_ANIM_OVER_LEFT:   lv_obj_set_x(to, at(t.w, 0)); break;
+    case LV_SCR_LOAD_ANIM_OVER_RIGHT:  lv_obj_set_x(to, at(-t.w, 0)); break;
+    case LV_SCR_LOAD_ANIM_OVER_TOP:    lv_obj_set_y(to, at(t.h, 0)); break;
+    case LV_SCR_LOAD_ANIM_OVER_BOTTOM: lv_obj_set_y(to, at(-t.h, 0)); break;
+    case LV_SCR_LOAD_ANIM_OUT_LEFT:    lv_obj_set_x(from, at(0, -t.w)); break;
+    case LV_SCR_LOAD_ANIM_OUT_RIGHT:   lv_obj_set_x(from, at(0, t.w)); break;
+    case LV_SCR_LOAD_ANIM_OUT_TOP:     lv_obj_set_y(from, at(0, -t.h)); break;
+    case LV_SCR_LOAD_ANIM_OUT_BOTTOM:  lv_obj_set_y(from, at(0, t.h)); break;
+    case LV_SCR_LOAD_ANIM_FADE_IN:     lv_obj_set_style_opa(to, static_cast<lv_opa_t>(at(0, 255)), 0); break;
+    case LV_SCR_LOAD_ANIM_FADE_OUT:    lv_obj_set_style_opa(from, static_cast<lv_opa_t>(at(255, 0)), 0); break;
+    default: break;
+    }
+}
+
+inline void snapshot_target_delete_cb(lv_event_t*) noexcept {
+    snapshot_transition().target = nullptr;
+}
+
+/// Swap the live target screen back in and drop the stage (buffers stay pooled)
+inline void snapshot_transition_done(lv_anim_t*) noexcept {
+    SnapshotTransition& t = snapshot_transition();
+    lv_obj_t* stage = t.stage;
+    lv_obj_t* target = t.target;
+    t.stage = t.from_img = t.to_img = t.target = nullptr;
+    if (target) {
+        lv_obj_remove_event_cb_with_user_data(target, &snapshot_target_delete_cb, nullptr);
+        lv_screen_load(target);
+    }
+    if (stage) lv_obj_delete(stage);
+}
+
+[[nodiscard]] inline lv_obj_t* snapshot_image(lv_obj_t* stage, lv_draw_buf_t* buf) noexcept {
+    lv_obj_t* img = lv_image_create(stage);
+    lv_obj_remove_style_all(img);
+    lv_image_set_src(img, buf);
+    return img;
+}
+
+} // namespace detail
+
+/**
+ * @brief Load a screen with a transition that animates snapshots
+ *
+ * lv_screen_load_anim() re-renders every widget of both screens on every
+ * frame. This takes one snapshot of the active and of the new screen into
+ * two pooled draw buffers (display color format, reused across
+ * transitions), loads a temporary screen with the two images and animates
+ * those instead. On completion the live `scr` is loaded and the temporary
+ * screen deleted. Widgets of both screens are frozen during the transition.
+ *
+ * The old screen receives SCREEN_UNLOAD_START/UNLOADED when the transition
+ * starts; `scr` receives SCREEN_LOAD_START/LOADED when it ends.
+ *
+ * Falls back to lv_screen_load_anim() if a snapshot cannot be allocated.
+ * A transition started while another runs completes the running one first.
+ *
+ * @return true if the snapshot transition runs
+ */
+inline bool screen_load_snapshot(ObjectView scr, lv_screen_load_anim_t anim, uint32_t time_ms) noexcept {
+    detail::SnapshotTransition& t = detail::snapshot_transition();
+    if (t.stage) {
+        lv_anim_delete(&t, &detail::snapshot_transition_exec);
+        detail::snapshot_transition_done(nullptr);
+    }
+
+    lv_obj_t* to = scr.get();
+    lv_obj_t* from = lv_screen_active();
+    if (!to) return false;
+    if (!from || from == to || anim == LV_SCR_LOAD_ANIM_NONE || time_ms == 0) {
+        lv_screen_load(to);
+        return false;
+    }
+
+    const lv_color_format_t cf = lv_display_get_color_format(lv_obj_get_display(to));
+    lv_obj_update_layout(to);
+    lv_draw_buf_t* from_buf = detail::snapshot_into(from, t.bufs[0], cf);
+    lv_draw_buf_t* to_buf = from_buf ? detail::snapshot_into(to, t.bufs[1], cf) : nullptr;
+    if (!to_buf) {
+        lv_screen_load_anim(to, anim, time_ms, 0, false);
+        return false;
+    }
+
+    t.stage = lv_obj_create(nullptr);
+    lv_obj_remove_style_all(t.stage);
+    lv_obj_remove_flag(t.stage, LV_OBJ_FLAG_SCROLLABLE);
+    // The image that moves over the other is created last
+    const bool from_on_top = anim == LV_SCR_LOAD_ANIM_FADE_OUT ||
+        anim == LV_SCR_LOAD_ANIM_OUT_LEFT || anim == LV_SCR_LOAD_ANIM_OUT_RIGHT ||
+        anim == LV_SCR_LOAD_ANIM_OUT_TOP || anim == LV_SCR_LOAD_ANIM_OUT_BOTTOM;
+    if (from_on_top) {
+        t.to_img = detail::snapshot_image(t.stage, to_buf);
+        t.from_img = detail::snapshot_image(t.stage, from_buf);
+    } else {
+        t.from_img = detail::snapshot_image(t.stage, from_buf);
+        t.to_img = detail::snapshot_image(t.stage, to_buf);
+    }
+    t.target = to;
+    t.anim = anim;
+    t.w = lv_obj_get_width(to);
+    t.h = lv_obj_get_height(to);
+    lv_obj_add_event_cb(to, &detail::snapshot_target_delete_cb, LV_EVENT_DELETE, nullptr);
+    detail::snapshot_transition_exec(nullptr, 0);
+    lv_screen_load(t.stage);
+
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, &t);
+    lv_anim_set_exec_cb(&a, &detail::snapshot_transition_exec);
+    lv_anim_set_values(&a, 0, 1000);
+    lv_anim_set_duration(&a, time_ms);
+    lv_anim_set_completed_cb(&a, &detail::snapshot_transition_done);
+    lv_anim_start(&a);
+    return true;
+}
+
+/// Whether a snapshot transition is running
+[[nodiscard]] inline bool snapshot_transition_running() noexcept {
+    return detail::snapshot_transition().stage != nullptr;
+}
+
+/// Free the pooled transition buffers (they are reallocated on the next transition)
+inline void release_transition_buffers() noexcept {
+    detail::SnapshotTransition& t = detail::snapshot_transition();
+    if (t.stage) {
+        lv_anim_delete(&t, &detail::snapshot_transition_exec);
+        detail::snapshot_transition_done(nullptr);
+    }
+    for (lv_draw_buf_t*& buf : t.bufs) {
+        if (!buf) continue;
+        lv_image_cache_drop(buf);
+        lv_draw_buf_destroy(buf);
+        buf = nullptr;
+    }
+}
+
+#endif // LV_USE_SNAPSHOT && LV_USE_IMAGE
+
 /**
  * @brief Screen class for creating managed screens
  *
@@ -140,53 +339,293 @@ inline Screen screen_active() noexcept {
     return Screen(lv::wrap, lv_screen_active());
 }
 
+#ifndef LV_CPP_NAV_MAX_DEPTH
+/// Maximum Navigator stack depth
+#define LV_CPP_NAV_MAX_DEPTH 32
+#endif
+
+#ifndef LV_CPP_NAV_MAX_SCREENS
+/// Maximum screens a Navigator tracks (stacked plus cached)
+#define LV_CPP_NAV_MAX_SCREENS 16
+#endif
+
+namespace detail {
+
+/// Type-erased ScreenComponent operations used by Navigator
+struct NavScreenOps {
+    lv_obj_t* (*build)(void* component);
+    void (*evict)(void* component);
+    lv_obj_t* (*screen)(void* component);
+    void (*prefetch)(void* component);
+};
+
+template<typename C>
+inline constexpr NavScreenOps nav_screen_ops{
+    [](void* c) { return static_cast<C*>(c)->mount_screen().get(); },
+    [](void* c) { static_cast<C*>(c)->unmount_screen(); },
+    [](void* c) { return static_cast<C*>(c)->screen().get(); },
+    [](void* c) { (void)::lv::prefetch::component(*static_cast<C*>(c)); },
+};
+
+} // namespace detail
+
 /**
- * @brief Simple screen navigator
+ * @brief Screen navigator with an LRU cache of component screens
  *
- * Manages a stack of screens for back navigation.
+ * Manages a stack of screens for back navigation. Plain screens
+ * (ObjectView) are owned by the application and always stay alive.
+ * ScreenComponent screens are built on first push and stay built while
+ * they are recently used, also after they are popped, so pushing them
+ * again is instant. When a memory budget is set and LVGL's heap usage
+ * (lv_mem_monitor) exceeds it, the least recently used component screens
+ * that are not on screen are unmounted; back() and push() rebuild them
+ * transparently. Component state (State<T> members) survives eviction.
+ *
+ * Components must outlive the Navigator or be removed with forget().
  *
  * Usage:
  *   lv::Navigator nav;
- *   nav.push(home_screen);
- *   nav.push(settings_screen, lv::screen_anim::slide_left, 300);
+ *   nav.budget(48 * 1024);                    // evict above 48 KiB of LVGL heap
+ *   nav.set_root(home_screen);
+ *   nav.push(settings, lv::screen_anim::move_left, 300);   // ScreenComponent
  *   nav.back();  // Returns to home with reverse animation
+ *
+ * Heap allocation: NONE (LV_CPP_NAV_MAX_DEPTH + LV_CPP_NAV_MAX_SCREENS fixed slots)
  */
 class Navigator {
-    static constexpr size_t MAX_SCREENS = 8;
-    ObjectView m_stack[MAX_SCREENS];
+    static constexpr uint16_t NONE = UINT16_MAX;
+
+    struct Entry {
+        void* component = nullptr;
+        const detail::NavScreenOps* ops = nullptr;   ///< nullptr: plain screen or free slot
+        lv_obj_t* screen = nullptr;                    ///< Plain screens only
+        uint32_t last_used = 0;
+        uint16_t stack_refs = 0;
+        uint16_t next = NONE;                          ///< Entry last pushed on top of this one
+        bool evicted = false;                          ///< Unmounted by the cache, rebuild on next use
+
+        [[nodiscard]] bool used() const noexcept { return ops || screen; }
+        [[nodiscard]] lv_obj_t* obj() const noexcept {
+            return ops ? ops->screen(component) : screen;
+        }
+    };
+
+    Entry m_entries[LV_CPP_NAV_MAX_SCREENS];
+    uint16_t m_stack[LV_CPP_NAV_MAX_DEPTH];
     size_t m_depth = 0;
+    size_t m_budget = 0;
+    uint32_t m_clock = 0;
+    uint16_t m_leaving = NONE;     ///< Entry animating out after the last navigation
+    uint32_t m_evictions = 0;
+    uint32_t m_rebuilds = 0;
+    TransitionMode m_mode = TransitionMode::live;
+    bool m_auto_prefetch = false;
+
+    [[nodiscard]] uint16_t find(const void* component, lv_obj_t* screen) const noexcept {
+        for (uint16_t i = 0; i < LV_CPP_NAV_MAX_SCREENS; ++i) {
+            const Entry& e = m_entries[i];
+            if (component ? e.component == component : (!e.ops && e.screen == screen)) return i;
+        }
+        return NONE;
+    }
+
+    [[nodiscard]] uint16_t top() const noexcept {
+        return m_depth > 0 ? m_stack[m_depth - 1] : NONE;
+    }
+
+    /// Built, unstacked and off screen: may be unmounted
+    [[nodiscard]] bool evictable(uint16_t i) const noexcept {
+        const Entry& e = m_entries[i];
+        if (!e.ops || e.stack_refs > 0 || i == m_leaving) return false;
+        lv_obj_t* scr = e.obj();
+        return scr && scr != lv_screen_active() &&
+               scr != lv_display_get_screen_prev(lv_obj_get_display(scr));
+    }
+
+    /// Evictable stacked screens are only unmounted when nothing unstacked is left
+    [[nodiscard]] uint16_t lru_victim(bool include_stacked) const noexcept {
+        uint16_t victim = NONE;
+        for (uint16_t i = 0; i < LV_CPP_NAV_MAX_SCREENS; ++i) {
+            const Entry& e = m_entries[i];
+            if (!e.ops || i == top() || i == m_leaving || (!include_stacked && e.stack_refs > 0)) continue;
+            lv_obj_t* scr = e.obj();
+            if (!scr || scr == lv_screen_active() ||
+                scr == lv_display_get_screen_prev(lv_obj_get_display(scr))) continue;
+            if (victim == NONE || e.last_used < m_entries[victim].last_used) victim = i;
+        }
+        return victim;
+    }
+
+    void evict(uint16_t i) {
+        Entry& e = m_entries[i];
+        e.ops->evict(e.component);
+        e.evicted = true;
+        ++m_evictions;
+    }
+
+    /// Slot for a new entry: free, then unbuilt, then the LRU evictable one
+    [[nodiscard]] uint16_t allocate() {
+        for (uint16_t i = 0; i < LV_CPP_NAV_MAX_SCREENS; ++i) {
+            if (!m_entries[i].used()) return i;
+        }
+        for (uint16_t i = 0; i < LV_CPP_NAV_MAX_SCREENS; ++i) {
+            const Entry& e = m_entries[i];
+            if (e.stack_refs == 0 && !e.obj()) {
+                m_entries[i] = Entry{};
+                return i;
+            }
+        }
+        const uint16_t victim = lru_victim(false);
+        if (victim == NONE) return NONE;
+        evict(victim);
+        m_entries[victim] = Entry{};
+        return victim;
+    }
+
+    /// Build the entry's screen if it was evicted (or never built)
+    [[nodiscard]] lv_obj_t* realize(uint16_t i) {
+        Entry& e = m_entries[i];
+        e.last_used = ++m_clock;
+        if (!e.ops) return e.screen;
+        lv_obj_t* scr = e.ops->screen(e.component);
+        if (scr) return scr;
+        if (e.evicted) ++m_rebuilds;
+        e.evicted = false;
+        return e.ops->build(e.component);
+    }
+
+    void release(uint16_t i) noexcept {
+        Entry& e = m_entries[i];
+        if (e.stack_refs > 0) --e.stack_refs;
+        if (e.stack_refs == 0 && !e.ops) e = Entry{};    // plain screens are not cached
+    }
+
+    void load(lv_obj_t* scr, lv_screen_load_anim_t anim, uint32_t time_ms) noexcept {
+        if (anim == LV_SCR_LOAD_ANIM_NONE) {
+            lv_screen_load(scr);
+            return;
+        }
+#if LV_USE_SNAPSHOT && LV_USE_IMAGE
+        if (m_mode == TransitionMode::snapshot) {
+            (void)screen_load_snapshot(ObjectView(scr), anim, time_ms);
+            return;
+        }
+#endif
+        lv_screen_load_anim(scr, anim, time_ms, 0, false);
+    }
+
+    bool push_entry(uint16_t i, lv_screen_load_anim_t anim, uint32_t time_ms) {
+        ui_thread();
+        if (m_depth >= LV_CPP_NAV_MAX_DEPTH) {
+            LV_LOG_WARN("Navigator stack full, raise LV_CPP_NAV_MAX_DEPTH");
+            return false;
+        }
+        lv_obj_t* scr = realize(i);
+        if (!scr) return false;
+        m_leaving = top();
+        if (m_leaving != NONE) m_entries[m_leaving].next = i;
+        m_stack[m_depth++] = i;
+        ++m_entries[i].stack_refs;
+        load(scr, anim, time_ms);
+        trim();
+        prefetch_next(i);
+        return true;
+    }
+
+    /// Queue a dry run of the screen usually pushed after entry `i` if it is not built
+    void prefetch_next(uint16_t i) noexcept {
+        if (!m_auto_prefetch) return;
+        const uint16_t n = m_entries[i].next;
+        if (n == NONE || n == i) return;
+        const Entry& e = m_entries[n];
+        if (e.ops && !e.obj()) e.ops->prefetch(e.component);
+    }
+
+    [[nodiscard]] static size_t lv_mem_used() noexcept {
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+        lv_mem_monitor_t mon;
+        lv_mem_monitor(&mon);
+        return mon.total_size - mon.free_size;
+#else
+        return 0;
+#endif
+    }
 
 public:
     Navigator() noexcept = default;
 
-    /// Push a screen onto the stack and load it
-    void push(ObjectView screen, lv_screen_load_anim_t anim = LV_SCR_LOAD_ANIM_NONE,
-              uint32_t time_ms = 0) noexcept {
-        if (m_depth < MAX_SCREENS) {
-            m_stack[m_depth++] = screen;
-            if (anim == LV_SCR_LOAD_ANIM_NONE) {
-                lv_screen_load(screen.get());
-            } else {
-                lv_screen_load_anim(screen.get(), anim, time_ms, 0, false);
+    // Non-copyable (two navigators would evict each other's screens)
+    Navigator(const Navigator&) = delete;
+    Navigator& operator=(const Navigator&) = delete;
+
+    // ==================== Navigation ====================
+
+    /**
+     * @brief Push a screen onto the stack and load it
+     *
+     * @return false if the stack (LV_CPP_NAV_MAX_DEPTH) or the screen table
+     *         (LV_CPP_NAV_MAX_SCREENS) is full; the screen is not loaded
+     */
+    bool push(ObjectView screen, lv_screen_load_anim_t anim = LV_SCR_LOAD_ANIM_NONE,
+              uint32_t time_ms = 0) {
+        if (!screen) return false;
+        uint16_t i = find(nullptr, screen.get());
+        if (i == NONE) {
+            i = allocate();
+            if (i == NONE) {
+                LV_LOG_WARN("Navigator screen table full, raise LV_CPP_NAV_MAX_SCREENS");
+                return false;
             }
+            m_entries[i].screen = screen.get();
         }
+        return push_entry(i, anim, time_ms);
     }
 
-    /// Go back to previous screen
-    bool back(uint32_t time_ms = 300) noexcept {
-        if (m_depth > 1) {
-            m_depth--;
-            ObjectView prev = m_stack[m_depth - 1];
-            // Use reverse animation
-            lv_screen_load_anim(prev.get(), LV_SCR_LOAD_ANIM_MOVE_RIGHT, time_ms, 0, false);
-            return true;
+    /**
+     * @brief Push a component screen, building it if it is not cached
+     *
+     * The Navigator mounts the component with mount_screen() and may later
+     * unmount it with unmount_screen() under memory pressure.
+     */
+    template<typename Derived>
+    bool push(ScreenComponent<Derived>& component, lv_screen_load_anim_t anim = LV_SCR_LOAD_ANIM_NONE,
+              uint32_t time_ms = 0) {
+        auto* self = static_cast<Derived*>(&component);
+        uint16_t i = find(self, nullptr);
+        if (i == NONE) {
+            i = allocate();
+            if (i == NONE) {
+                LV_LOG_WARN("Navigator screen table full, raise LV_CPP_NAV_MAX_SCREENS");
+                return false;
+            }
+            m_entries[i].component = self;
+            m_entries[i].ops = &detail::nav_screen_ops<Derived>;
         }
-        return false;
+        return push_entry(i, anim, time_ms);
+    }
+
+    /// Go back to previous screen (rebuilt first if it was evicted)
+    bool back(uint32_t time_ms = 300) {
+        ui_thread();
+        if (m_depth <= 1) return false;
+        const uint16_t leaving = m_stack[--m_depth];
+        lv_obj_t* prev = realize(top());
+        if (!prev) {
+            ++m_depth;
+            return false;
+        }
+        release(leaving);
+        m_leaving = m_entries[leaving].used() ? leaving : NONE;
+        // Use reverse animation
+        load(prev, LV_SCR_LOAD_ANIM_MOVE_RIGHT, time_ms);
+        trim();
+        prefetch_next(top());
+        return true;
     }
 
     /// Get current screen
     [[nodiscard]] ObjectView current() const noexcept {
-        return m_depth > 0 ? m_stack[m_depth - 1] : ObjectView(nullptr);
+        return m_depth > 0 ? ObjectView(m_entries[top()].obj()) : ObjectView(nullptr);
     }
 
     /// Get stack depth
@@ -199,17 +638,125 @@ public:
         return m_depth > 1;
     }
 
-    /// Clear the stack
+    /// Clear the stack (component screens stay cached until evicted)
     void clear() noexcept {
-        m_depth = 0;
+        while (m_depth > 0) release(m_stack[--m_depth]);
+        m_leaving = NONE;
     }
 
     /// Set root screen (clears stack and sets single screen)
-    void set_root(ObjectView screen) noexcept {
-        m_depth = 1;
-        m_stack[0] = screen;
-        lv_screen_load(screen.get());
+    void set_root(ObjectView screen) {
+        clear();
+        push(screen);
+    }
+
+    template<typename Derived>
+    void set_root(ScreenComponent<Derived>& component) {
+        clear();
+        push(component);
+    }
+
+    /// Stop tracking a component (e.g. before destroying it); removes it from the stack
+    template<typename Derived>
+    void forget(ScreenComponent<Derived>& component) noexcept {
+        const uint16_t i = find(static_cast<Derived*>(&component), nullptr);
+        if (i == NONE) return;
+        size_t kept = 0;
+        for (size_t k = 0; k < m_depth; ++k) {
+            if (m_stack[k] != i) m_stack[kept++] = m_stack[k];
+        }
+        m_depth = kept;
+        if (m_leaving == i) m_leaving = NONE;
+        m_entries[i] = Entry{};
+    }
+
+    /**
+     * @brief Animate push()/back() live (default) or with snapshots
+     *
+     * TransitionMode::snapshot uses screen_load_snapshot(); without
+     * LV_USE_SNAPSHOT it behaves like TransitionMode::live.
+     */
+    Navigator& transitions(TransitionMode mode) noexcept {
+        m_mode = mode;
+        return *this;
+    }
+
+    [[nodiscard]] TransitionMode transitions() const noexcept { return m_mode; }
+
+    // ==================== Prefetch ====================
+
+    /**
+     * @brief Warm the caches for `component` at idle time (see lv::prefetch)
+     *
+     * Builds it off screen, queues its images and label glyphs and unmounts
+     * it again, so the later push() decodes nothing.
+     */
+    template<typename Derived>
+    ::lv::prefetch::Ticket prefetch(ScreenComponent<Derived>& component) noexcept {
+        return ::lv::prefetch::component(*static_cast<Derived*>(&component));
     }
+
+    /**
+     * @brief After each navigation, prefetch the screen last pushed from the new top
+     *
+     * Off by default. Only component screens that are not built are
+     * prefetched; evicted ones stay evicted (the dry run unmounts again).
+     */
+    Navigator& auto_prefetch(bool on) noexcept {
+        m_auto_prefetch = on;
+        return *this;
+    }
+
+    [[nodiscard]] bool auto_prefetch() const noexcept { return m_auto_prefetch; }
+
+    // ==================== Memory Budget ====================
+
+    /**
+     * @brief Unmount LRU component screens while LVGL heap usage exceeds `bytes`
+     *
+     * Checked after every navigation. 0 (default) disables the budget.
+     * Usage is read with lv_mem_monitor(), so the budget only applies with
+     * LVGL's builtin allocator (LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN);
+     * otherwise only the LV_CPP_NAV_MAX_SCREENS limit evicts.
+     */
+    Navigator& budget(size_t bytes) {
+        m_budget = bytes;
+        trim();
+        return *this;
+    }
+
+    [[nodiscard]] size_t budget() const noexcept { return m_budget; }
+
+    /// Evict until usage is within the budget: unstacked screens first, then stacked ones
+    void trim() {
+        if (m_budget == 0) return;
+        while (lv_mem_used() > m_budget) {
+            uint16_t victim = lru_victim(false);
+            if (victim == NONE) victim = lru_victim(true);
+            if (victim == NONE) break;
+            evict(victim);
+        }
+    }
+
+    /// Unmount every cached component screen that is not on the stack or on screen
+    void evict_unused() {
+        for (uint16_t i = 0; i < LV_CPP_NAV_MAX_SCREENS; ++i) {
+            if (evictable(i)) evict(i);
+        }
+    }
+
+    /// Number of component screens currently built
+    [[nodiscard]] size_t built_count() const noexcept {
+        size_t n = 0;
+        for (const Entry& e : m_entries) n += e.ops && e.obj();
+        return n;
+    }
+
+    /// Component screens unmounted so far (budget or table pressure)
+    [[nodiscard]] uint32_t evictions() const noexcept { return m_evictions; }
+
+    /// Evicted component screens built again on push()/back()
+    [[nodiscard]] uint32_t rebuilds() const noexcept { return m_rebuilds; }
 };
 
 } // namespace lv
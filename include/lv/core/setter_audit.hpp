@@ -0,0 +1,215 @@
+#pragma once
+
+/**
+ * @file setter_audit.hpp
+ * @brief Debug counters for fluent setters called with the value already set
+ *
+ * Calling `bg_color()`, `hide()` or `text()` with what an object already
+ * has still refreshes its style or invalidates it, and code that pushes
+ * every value from a timer does this for every widget on every tick. With
+ * LV_CPP_SETTER_AUDIT, the hot setters of ObjectMixin, StyleMixin and
+ * Label take the caller's std::source_location (as lv::log::Fmt does) and
+ * count, per call site, the calls that changed nothing:
+ *
+ * @code
+ * // built with -DLV_CPP_SETTER_AUDIT=1
+ * lv::setter_audit::dump(10);     // the 10 call sites with the most redundant calls
+ * // 412 of 412 redundant: bg_color at dashboard.cpp:88 (update_tiles), last object 0x...
+ * @endcode
+ *
+ * LV_CPP_SET_IF_CHANGED=1 makes the same setters return without calling
+ * LVGL when nothing would change, with or without the audit. Style setters
+ * compare with the object's local style at the same selector, so a value
+ * equal only to the theme's is still set. Label::text() always skips an
+ * unchanged text (see text_cache.hpp); the audit counts it all the same.
+ *
+ * With both macros 0 (the default) the setters are unchanged: no extra
+ * parameter, no comparison.
+ *
+ * Heap allocation: NONE (fixed table of LV_CPP_SETTER_AUDIT_SITES call sites)
+ */
+
+#include <lvgl.h>
+#include <cstdint>
+
+#ifndef LV_CPP_SETTER_AUDIT
+/// 1: count setter calls that change nothing, per call site
+#define LV_CPP_SETTER_AUDIT 0
+#endif
+
+#ifndef LV_CPP_SET_IF_CHANGED
+/// 1: hot fluent setters skip the LVGL call when the value is already set
+#define LV_CPP_SET_IF_CHANGED 0
+#endif
+
+#ifndef LV_CPP_SETTER_AUDIT_SITES
+/// Call sites the setter audit tracks (power of two)
+#define LV_CPP_SETTER_AUDIT_SITES 128
+#endif
+
+static_assert((LV_CPP_SETTER_AUDIT_SITES & (LV_CPP_SETTER_AUDIT_SITES - 1)) == 0,
+              "LV_CPP_SETTER_AUDIT_SITES must be a power of two");
+
+#if LV_CPP_SETTER_AUDIT
+#include <source_location>
+
+/// Trailing setter parameter: the caller's location
+#define LV_CPP_SETTER_SITE , const std::source_location& site = std::source_location::current()
+/// Same, for setters without other parameters
+#define LV_CPP_SETTER_VOID_SITE const std::source_location& site = std::source_location::current()
+/// Forwards the caller's location to another instrumented setter
+#define LV_CPP_SETTER_SITE_ARG , site
+/// Count the call; true if the setter should return now
+#define LV_CPP_SETTER_UNCHANGED(name, obj, same) ::lv::setter_audit::detail::note(name, obj, (same), site)
+/// Count the call only (for setters that skip unchanged values anyway)
+#define LV_CPP_SETTER_RECORD(name, obj, same) ::lv::setter_audit::detail::record(name, obj, (same), site)
+#else
+#define LV_CPP_SETTER_SITE
+#define LV_CPP_SETTER_VOID_SITE
+#define LV_CPP_SETTER_SITE_ARG
+#if LV_CPP_SET_IF_CHANGED
+#define LV_CPP_SETTER_UNCHANGED(name, obj, same) (same)
+#else
+#define LV_CPP_SETTER_UNCHANGED(name, obj, same) false
+#endif
+#define LV_CPP_SETTER_RECORD(name, obj, same) ((void)0)
+#endif
+
+namespace lv::setter_audit {
+
+struct Stats {
+    uint32_t calls = 0;        ///< Instrumented setter calls
+    uint32_t redundant = 0;    ///< Calls that changed nothing
+    uint32_t sites = 0;        ///< Call sites tracked
+    uint32_t untracked = 0;    ///< Calls from sites beyond LV_CPP_SETTER_AUDIT_SITES
+};
+
+namespace detail {
+
+/// The object's local style already holds `v` for `prop` at `sel`
+[[nodiscard]] inline bool local_is(lv_obj_t* obj, lv_style_prop_t prop, int32_t v, lv_style_selector_t sel) noexcept {
+    lv_style_value_t cur;
+    return lv_obj_get_local_style_prop(obj, prop, &cur, sel) == LV_STYLE_RES_FOUND && cur.num == v;
+}
+
+[[nodiscard]] inline bool local_is(lv_obj_t* obj, lv_style_prop_t prop, lv_color_t v, lv_style_selector_t sel) noexcept {
+    lv_style_value_t cur;
+    return lv_obj_get_local_style_prop(obj, prop, &cur, sel) == LV_STYLE_RES_FOUND && lv_color_eq(cur.color, v);
+}
+
+[[nodiscard]] inline bool local_is(lv_obj_t* obj, lv_style_prop_t prop, const void* v, lv_style_selector_t sel) noexcept {
+    lv_style_value_t cur;
+    return lv_obj_get_local_style_prop(obj, prop, &cur, sel) == LV_STYLE_RES_FOUND && cur.ptr == v;
+}
+
+#if LV_CPP_SETTER_AUDIT
+
+struct Site {
+    const char* file = nullptr;     ///< nullptr: free slot
+    const char* function = nullptr;
+    const char* setter = nullptr;
+    uint32_t line = 0;
+    uint32_t column = 0;
+    uint32_t calls = 0;
+    uint32_t redundant = 0;
+    lv_obj_t* last = nullptr;       ///< Object of the last redundant call
+};
+
+struct Table {
+    Site sites[LV_CPP_SETTER_AUDIT_SITES];
+    Stats stats;
+};
+
+[[nodiscard]] inline Table& table() noexcept {
+    static Table t;
+    return t;
+}
+
+[[nodiscard]] inline Site* site_of(const std::source_location& loc, const char* setter) noexcept {
+    Table& t = table();
+    const auto h = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(loc.file_name()) >> 3) ^
+                   loc.line() * 2654435761u ^ loc.column();
+    for (uint32_t i = 0, s = h & (LV_CPP_SETTER_AUDIT_SITES - 1); i < LV_CPP_SETTER_AUDIT_SITES;
+         ++i, s = (s + 1) & (LV_CPP_SETTER_AUDIT_SITES - 1)) {
+        Site& e = t.sites[s];
+        if (!e.file) {
+            e.file = loc.file_name();
+            e.function = loc.function_name();
+            e.setter = setter;
+            e.line = loc.line();
+            e.column = loc.column();
+            ++t.stats.sites;
+            return &e;
+        }
+        if (e.line == loc.line() && e.column == loc.column() && e.setter == setter && e.file == loc.file_name()) {
+            return &e;
+        }
+    }
+    return nullptr;
+}
+
+/// Count a setter call from `loc` on `obj`; `same`: it changed nothing
+inline void record(const char* setter, lv_obj_t* obj, bool same, const std::source_location& loc) noexcept {
+    Stats& st = table().stats;
+    ++st.calls;
+    st.redundant += same;
+    Site* s = site_of(loc, setter);
+    if (!s) {
+        ++st.untracked;
+        return;
+    }
+    ++s->calls;
+    if (same) {
+        ++s->redundant;
+        s->last = obj;
+    }
+}
+
+/// record(), then true if the setter should skip the LVGL call
+[[nodiscard]] inline bool note(const char* setter, lv_obj_t* obj, bool same, const std::source_location& loc) noexcept {
+    record(setter, obj, same, loc);
+    return LV_CPP_SET_IF_CHANGED && same;
+}
+
+#endif // LV_CPP_SETTER_AUDIT
+
+} // namespace detail
+
+#if LV_CPP_SETTER_AUDIT
+
+[[nodiscard]] inline Stats stats() noexcept { return detail::table().stats; }
+
+/// Forget every call site and counter
+inline void reset() noexcept { detail::table() = detail::Table{}; }
+
+/// LV_LOG_USER the `n` call sites with the most redundant calls
+inline void dump(uint32_t n = 10) noexcept {
+    detail::Table& t = detail::table();
+    const Stats& st = t.stats;
+    LV_LOG_USER("setter audit: %u of %u calls redundant, %u sites (%u calls untracked)",
+                static_cast<unsigned>(st.redundant), static_cast<unsigned>(st.calls),
+                static_cast<unsigned>(st.sites), static_cast<unsigned>(st.untracked));
+    uint32_t below = UINT32_MAX;     // selection by descending count, one pass per line
+    const detail::Site* prev = nullptr;
+    for (uint32_t i = 0; i < n; ++i) {
+        const detail::Site* best = nullptr;
+        for (const detail::Site& s : t.sites) {
+            if (!s.file || !s.redundant) continue;
+            const bool after_prev = s.redundant < below || (s.redundant == below && &s > prev);
+            if (after_prev && (!best || s.redundant > best->redundant ||
+                               (s.redundant == best->redundant && &s < best))) {
+                best = &s;
+            }
+        }
+        if (!best) break;
+        LV_LOG_USER("  %u of %u redundant: %s at %s:%u (%s), last object %p", static_cast<unsigned>(best->redundant),
+                    static_cast<unsigned>(best->calls), best->setter, best->file, static_cast<unsigned>(best->line),
+                    best->function, static_cast<void*>(best->last));
+        below = best->redundant;
+        prev = best;
+    }
+}
+
+#endif // LV_CPP_SETTER_AUDIT
+
+} // namespace lv::setter_audit
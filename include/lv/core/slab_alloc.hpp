@@ -0,0 +1,538 @@
+#pragma once
+
+/**
+ * @file slab_alloc.hpp
+ * @brief Fragmentation-resistant LVGL heap: fixed-size slabs plus an arena
+ *
+ * With LV_STDLIB_CLIB every object, widget struct, event descriptor array
+ * and style property array is a separate malloc(); interleaving them with
+ * long-lived buffers fragments the system heap over days of uptime.
+ * This backend serves LVGL's allocations from static memory instead:
+ *
+ *   - requests up to the largest size class come from fixed-size slabs
+ *     (16 … 256 bytes by default: style property arrays and event
+ *     descriptor arrays in the small classes, lv_obj_t and the widget
+ *     structs in the larger ones). A freed block goes back to its class's
+ *     free list, so slabs cannot fragment;
+ *   - larger requests, and small ones whose class is exhausted, go to an
+ *     arena managed first-fit over an address-ordered free list with
+ *     immediate coalescing;
+ *   - when the arena is full, to malloc() (LV_CPP_SLAB_SYSTEM_FALLBACK).
+ *
+ * Selecting it, in lv_conf.h:
+ * @code
+ * #define LV_USE_STDLIB_MALLOC      LV_STDLIB_CUSTOM
+ * #define LV_CPP_SLAB_CLASS_SIZES   16, 32, 64, 96, 128, 192, 256   // optional tuning
+ * #define LV_CPP_SLAB_CLASS_BLOCKS  256, 256, 256, 128, 128, 64, 32
+ * #define LV_CPP_SLAB_ARENA_SIZE    (96 * 1024)
+ * @endcode
+ * and in exactly one source file:
+ * @code
+ * #define LV_CPP_SLAB_ALLOCATOR
+ * #include <lv/core/slab_alloc.hpp>
+ * @endcode
+ *
+ * lv_mem_monitor(), and with it the sysmon overlay and
+ * lv::sysmon::PerfSample, then reports the slabs and arena: total, free,
+ * biggest free block, peak use and the arena's fragmentation.
+ * lv::slab_alloc::stats() has the per-class figures for tuning the
+ * classes (a class with spills wants more blocks).
+ *
+ * Do not combine with mem_account.hpp's allocator: both provide
+ * lv_malloc_core(). Single-threaded like LVGL's builtin allocator.
+ * Heap allocation: NONE (static slabs and arena) unless the arena overflows
+ * to malloc()
+ */
+
+#include <lvgl.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_CUSTOM
+
+#ifndef LV_CPP_SLAB_CLASS_SIZES
+/// Slab block sizes in bytes, ascending multiples of 8
+#define LV_CPP_SLAB_CLASS_SIZES 16, 32, 64, 96, 128, 192, 256
+#endif
+
+#ifndef LV_CPP_SLAB_CLASS_BLOCKS
+/// Blocks per size class (same order as LV_CPP_SLAB_CLASS_SIZES)
+#define LV_CPP_SLAB_CLASS_BLOCKS 256, 256, 256, 128, 128, 64, 32
+#endif
+
+#ifndef LV_CPP_SLAB_ARENA_SIZE
+/// Bytes of the arena for large requests and exhausted classes
+#define LV_CPP_SLAB_ARENA_SIZE (64 * 1024)
+#endif
+
+#ifndef LV_CPP_SLAB_SYSTEM_FALLBACK
+/// Serve requests the arena cannot fit with malloc() instead of failing
+#define LV_CPP_SLAB_SYSTEM_FALLBACK 1
+#endif
+
+namespace lv::slab_alloc {
+
+/// One size class
+struct ClassStat {
+    uint32_t size;       ///< Block size in bytes
+    uint32_t blocks;     ///< Capacity
+    uint32_t used;
+    uint32_t peak;
+    uint32_t spills;     ///< Requests sent to the arena because the class was full
+};
+
+struct Stats {
+    static constexpr uint32_t max_classes = 16;
+    ClassStat classes[max_classes];
+    uint32_t class_count;
+    uint32_t arena_size;
+    uint32_t arena_used;          ///< Including block headers
+    uint32_t arena_peak;
+    uint32_t arena_free_blocks;
+    uint32_t arena_biggest_free;
+    uint8_t arena_frag_pct;       ///< 100 - biggest free block / free bytes
+    size_t system_bytes;          ///< Requested bytes held by malloc() fallback blocks
+    size_t system_peak;
+    uint32_t system_allocs;       ///< Requests that went to malloc()
+    uint32_t failures;            ///< Requests that returned nullptr
+    size_t peak;                  ///< Peak of all bytes in use (slab blocks, arena blocks, fallback)
+};
+
+namespace detail {
+
+inline constexpr uint32_t class_sizes[] = {LV_CPP_SLAB_CLASS_SIZES};
+inline constexpr uint32_t class_blocks[] = {LV_CPP_SLAB_CLASS_BLOCKS};
+inline constexpr uint32_t class_count = sizeof(class_sizes) / sizeof(class_sizes[0]);
+
+static_assert(class_count == sizeof(class_blocks) / sizeof(class_blocks[0]),
+              "LV_CPP_SLAB_CLASS_SIZES and LV_CPP_SLAB_CLASS_BLOCKS need the same number of entries");
+static_assert(class_count <= Stats::max_classes, "too many slab classes");
+
+[[nodiscard]] constexpr bool classes_valid() noexcept {
+    for (uint32_t i = 0; i < class_count; ++i) {
+        if (class_sizes[i] % 8 != 0 || class_sizes[i] < sizeof(void*)) return false;
+        if (i > 0 && class_sizes[i] <= class_sizes[i - 1]) return false;
+    }
+    return true;
+}
+
+static_assert(classes_valid(), "slab class sizes must be ascending multiples of 8");
+
+[[nodiscard]] constexpr uint32_t class_offset(uint32_t cls) noexcept {
+    uint32_t off = 0;
+    for (uint32_t i = 0; i < cls; ++i) off += class_sizes[i] * class_blocks[i];
+    return off;
+}
+
+inline constexpr uint32_t slab_bytes = class_offset(class_count);
+inline constexpr uint32_t arena_bytes = (LV_CPP_SLAB_ARENA_SIZE) / 16 * 16;
+
+/// Arena block header; size includes it and is a multiple of 16
+struct ArenaHeader {
+    uint32_t size;
+    uint32_t prev_size;   ///< Size of the block before (0 for the first)
+    uint32_t used;
+    uint32_t pad;
+};
+
+static_assert(sizeof(ArenaHeader) == 16, "arena headers keep 16-byte alignment");
+
+struct ArenaFree {
+    ArenaHeader h;
+    ArenaFree* prev;
+    ArenaFree* next;
+};
+
+inline constexpr uint32_t arena_min_block = (sizeof(ArenaFree) + 15) / 16 * 16;
+
+/// Header of a malloc() fallback block
+struct alignas(16) SystemHeader {
+    size_t size;
+};
+
+struct FreeSlot {
+    FreeSlot* next;
+};
+
+struct SlabClass {
+    FreeSlot* free;
+    uint32_t fresh;       ///< Blocks never handed out start here (no free-list setup)
+    uint32_t used;
+    uint32_t peak;
+    uint32_t spills;
+};
+
+struct Heap {
+    alignas(16) unsigned char slabs[slab_bytes];
+    alignas(16) unsigned char arena[arena_bytes ? arena_bytes : 16];
+    SlabClass classes[class_count];
+    ArenaFree* arena_free;   ///< Address-ordered
+    uint32_t arena_used;
+    uint32_t arena_peak;
+    size_t system_bytes;
+    size_t system_peak;
+    uint32_t system_allocs;
+    uint32_t failures;
+    size_t in_use;
+    size_t peak;
+    bool ready;
+};
+
+[[nodiscard]] inline Heap& heap() noexcept {
+    static Heap h;
+    return h;
+}
+
+inline void note_use(Heap& h, ptrdiff_t delta) noexcept {
+    h.in_use = static_cast<size_t>(static_cast<ptrdiff_t>(h.in_use) + delta);
+    if (h.in_use > h.peak) h.peak = h.in_use;
+}
+
+// ---- Arena ----
+
+[[nodiscard]] inline ArenaHeader* arena_next(Heap& h, ArenaHeader* b) noexcept {
+    unsigned char* n = reinterpret_cast<unsigned char*>(b) + b->size;
+    return n < h.arena + arena_bytes ? reinterpret_cast<ArenaHeader*>(n) : nullptr;
+}
+
+[[nodiscard]] inline ArenaHeader* arena_prev(ArenaHeader* b) noexcept {
+    return b->prev_size ? reinterpret_cast<ArenaHeader*>(reinterpret_cast<unsigned char*>(b) - b->prev_size) : nullptr;
+}
+
+inline void free_unlink(Heap& h, ArenaFree* f) noexcept {
+    if (f->prev) f->prev->next = f->next; else h.arena_free = f->next;
+    if (f->next) f->next->prev = f->prev;
+}
+
+/// Insert keeping address order
+inline void free_insert(Heap& h, ArenaFree* f) noexcept {
+    ArenaFree* prev = nullptr;
+    ArenaFree* cur = h.arena_free;
+    while (cur && cur < f) {
+        prev = cur;
+        cur = cur->next;
+    }
+    f->prev = prev;
+    f->next = cur;
+    if (prev) prev->next = f; else h.arena_free = f;
+    if (cur) cur->prev = f;
+}
+
+/// Forget every block (the storage itself is static and stays zero-initialized)
+inline void init(Heap& h) noexcept {
+    std::memset(h.classes, 0, sizeof(h.classes));
+    h.arena_free = nullptr;
+    h.arena_used = h.arena_peak = 0;
+    h.system_bytes = h.system_peak = 0;
+    h.system_allocs = h.failures = 0;
+    h.in_use = h.peak = 0;
+    if constexpr (arena_bytes >= arena_min_block) {
+        auto* f = reinterpret_cast<ArenaFree*>(h.arena);
+        f->h = ArenaHeader{arena_bytes, 0, 0, 0};
+        f->prev = f->next = nullptr;
+        h.arena_free = f;
+    }
+    h.ready = true;
+}
+
+[[nodiscard]] inline void* arena_alloc(Heap& h, size_t size) noexcept {
+    if (size > arena_bytes) return nullptr;
+    uint32_t need = static_cast<uint32_t>((size + 15) / 16 * 16 + sizeof(ArenaHeader));
+    if (need < arena_min_block) need = arena_min_block;
+    for (ArenaFree* f = h.arena_free; f; f = f->next) {
+        if (f->h.size < need) continue;
+        free_unlink(h, f);
+        ArenaHeader* b = &f->h;
+        if (b->size - need >= arena_min_block) {
+            // Split: the tail stays free
+            auto* rest = reinterpret_cast<ArenaFree*>(reinterpret_cast<unsigned char*>(b) + need);
+            rest->h = ArenaHeader{b->size - need, need, 0, 0};
+            if (ArenaHeader* n = arena_next(h, &rest->h)) n->prev_size = rest->h.size;
+            b->size = need;
+            free_insert(h, rest);
+        }
+        b->used = 1;
+        h.arena_used += b->size;
+        if (h.arena_used > h.arena_peak) h.arena_peak = h.arena_used;
+        note_use(h, b->size);
+        return b + 1;
+    }
+    return nullptr;
+}
+
+inline void arena_free(Heap& h, void* p) noexcept {
+    ArenaHeader* b = static_cast<ArenaHeader*>(p) - 1;
+    h.arena_used -= b->size;
+    note_use(h, -static_cast<ptrdiff_t>(b->size));
+    b->used = 0;
+    // Coalesce with the following block
+    if (ArenaHeader* n = arena_next(h, b); n && !n->used) {
+        free_unlink(h, reinterpret_cast<ArenaFree*>(n));
+        b->size += n->size;
+        if (ArenaHeader* nn = arena_next(h, b)) nn->prev_size = b->size;
+    }
+    // ... and with the preceding one, which is already listed
+    if (ArenaHeader* pb = arena_prev(b); pb && !pb->used) {
+        pb->size += b->size;
+        if (ArenaHeader* nn = arena_next(h, pb)) nn->prev_size = pb->size;
+        return;
+    }
+    free_insert(h, reinterpret_cast<ArenaFree*>(b));
+}
+
+[[nodiscard]] inline bool in_arena(Heap& h, const void* p) noexcept {
+    const auto* c = static_cast<const unsigned char*>(p);
+    return c >= h.arena && c < h.arena + arena_bytes;
+}
+
+// ---- Slabs ----
+
+/// Class serving `size`, or class_count if it is too large
+[[nodiscard]] inline uint32_t class_for(size_t size) noexcept {
+    for (uint32_t i = 0; i < class_count; ++i) {
+        if (size <= class_sizes[i]) return i;
+    }
+    return class_count;
+}
+
+/// Class owning slab pointer `p`, or class_count if `p` is not in the slabs
+[[nodiscard]] inline uint32_t class_of(Heap& h, const void* p) noexcept {
+    const auto* c = static_cast<const unsigned char*>(p);
+    if (c < h.slabs || c >= h.slabs + slab_bytes) return class_count;
+    const auto off = static_cast<uint32_t>(c - h.slabs);
+    uint32_t cls = 0;
+    while (cls + 1 < class_count && off >= class_offset(cls + 1)) ++cls;
+    return cls;
+}
+
+[[nodiscard]] inline void* slab_alloc(Heap& h, uint32_t cls) noexcept {
+    SlabClass& c = h.classes[cls];
+    void* p = nullptr;
+    if (c.free) {
+        p = c.free;
+        c.free = c.free->next;
+    } else if (c.fresh < class_blocks[cls]) {
+        p = h.slabs + class_offset(cls) + c.fresh++ * class_sizes[cls];
+    } else {
+        ++c.spills;
+        return nullptr;
+    }
+    if (++c.used > c.peak) c.peak = c.used;
+    note_use(h, class_sizes[cls]);
+    return p;
+}
+
+inline void slab_free(Heap& h, uint32_t cls, void* p) noexcept {
+    SlabClass& c = h.classes[cls];
+    auto* s = static_cast<FreeSlot*>(p);
+    s->next = c.free;
+    c.free = s;
+    --c.used;
+    note_use(h, -static_cast<ptrdiff_t>(class_sizes[cls]));
+}
+
+// ---- Front end ----
+
+[[nodiscard]] inline void* allocate(size_t size) noexcept {
+    Heap& h = heap();
+    if (!h.ready) init(h);
+    if (size == 0) size = 1;
+    const uint32_t cls = class_for(size);
+    if (cls < class_count) {
+        if (void* p = slab_alloc(h, cls)) return p;
+    }
+    if (void* p = arena_alloc(h, size)) return p;
+#if LV_CPP_SLAB_SYSTEM_FALLBACK
+    if (auto* s = static_cast<SystemHeader*>(std::malloc(sizeof(SystemHeader) + size))) {
+        s->size = size;
+        ++h.system_allocs;
+        h.system_bytes += size;
+        if (h.system_bytes > h.system_peak) h.system_peak = h.system_bytes;
+        note_use(h, static_cast<ptrdiff_t>(size));
+        return s + 1;
+    }
+#endif
+    ++h.failures;
+    return nullptr;
+}
+
+inline void release(void* p) noexcept {
+    if (!p) return;
+    Heap& h = heap();
+    if (const uint32_t cls = class_of(h, p); cls < class_count) {
+        slab_free(h, cls, p);
+    } else if (in_arena(h, p)) {
+        arena_free(h, p);
+    } else {
+        SystemHeader* s = static_cast<SystemHeader*>(p) - 1;
+        h.system_bytes -= s->size;
+        note_use(h, -static_cast<ptrdiff_t>(s->size));
+        std::free(s);
+    }
+}
+
+/// Usable bytes of block `p`
+[[nodiscard]] inline size_t capacity(void* p) noexcept {
+    Heap& h = heap();
+    if (const uint32_t cls = class_of(h, p); cls < class_count) return class_sizes[cls];
+    if (in_arena(h, p)) return (static_cast<ArenaHeader*>(p) - 1)->size - sizeof(ArenaHeader);
+    return (static_cast<SystemHeader*>(p) - 1)->size;
+}
+
+[[nodiscard]] inline void* reallocate(void* p, size_t size) noexcept {
+    if (!p) return allocate(size);
+    const size_t cap = capacity(p);
+    if (size <= cap && class_for(size) == class_for(cap)) return p;   // still the right home
+    void* n = allocate(size);
+    if (!n) return nullptr;
+    std::memcpy(n, p, size < cap ? size : cap);
+    release(p);
+    return n;
+}
+
+} // namespace detail
+
+/// Per-class, arena and fallback figures
+[[nodiscard]] inline Stats stats() noexcept {
+    detail::Heap& h = detail::heap();
+    Stats s{};
+    s.class_count = detail::class_count;
+    for (uint32_t i = 0; i < detail::class_count; ++i) {
+        const detail::SlabClass& c = h.classes[i];
+        s.classes[i] = ClassStat{detail::class_sizes[i], detail::class_blocks[i], c.used, c.peak, c.spills};
+    }
+    s.arena_size = detail::arena_bytes;
+    s.arena_used = h.arena_used;
+    s.arena_peak = h.arena_peak;
+    uint32_t free_bytes = 0;
+    for (const detail::ArenaFree* f = h.arena_free; f; f = f->next) {
+        ++s.arena_free_blocks;
+        free_bytes += f->h.size;
+        if (f->h.size > s.arena_biggest_free) s.arena_biggest_free = f->h.size;
+    }
+    if (!h.ready) free_bytes = s.arena_biggest_free = detail::arena_bytes;
+    s.arena_frag_pct = free_bytes ? static_cast<uint8_t>(100 - static_cast<uint64_t>(s.arena_biggest_free) * 100 / free_bytes) : 0;
+    s.system_bytes = h.system_bytes;
+    s.system_peak = h.system_peak;
+    s.system_allocs = h.system_allocs;
+    s.failures = h.failures;
+    s.peak = h.peak;
+    return s;
+}
+
+/// Restart the peaks and spill counters at the current use
+inline void reset_peaks() noexcept {
+    detail::Heap& h = detail::heap();
+    for (detail::SlabClass& c : h.classes) {
+        c.peak = c.used;
+        c.spills = 0;
+    }
+    h.arena_peak = h.arena_used;
+    h.system_peak = h.system_bytes;
+    h.peak = h.in_use;
+}
+
+/// LV_LOG_USER one line per class plus the arena
+inline void log() noexcept {
+    const Stats s = stats();
+    for (uint32_t i = 0; i < s.class_count; ++i) {
+        const ClassStat& c = s.classes[i];
+        LV_LOG_USER("slab %4u B: %u/%u used, peak %u, %u spilled",
+                    static_cast<unsigned>(c.size), static_cast<unsigned>(c.used), static_cast<unsigned>(c.blocks),
+                    static_cast<unsigned>(c.peak), static_cast<unsigned>(c.spills));
+        (void)c;
+    }
+    LV_LOG_USER("arena: %u/%u used, peak %u, %u free blocks, biggest %u, frag %u%%; malloc %u B (%u allocs), %u failed",
+                static_cast<unsigned>(s.arena_used), static_cast<unsigned>(s.arena_size),
+                static_cast<unsigned>(s.arena_peak), static_cast<unsigned>(s.arena_free_blocks),
+                static_cast<unsigned>(s.arena_biggest_free), static_cast<unsigned>(s.arena_frag_pct),
+                static_cast<unsigned>(s.system_bytes), static_cast<unsigned>(s.system_allocs),
+                static_cast<unsigned>(s.failures));
+    (void)s;
+}
+
+} // namespace lv::slab_alloc
+
+// ==================== LVGL stdlib backend (one translation unit) ====================
+
+#ifdef LV_CPP_SLAB_ALLOCATOR
+
+#ifdef LV_CPP_MEM_ACCOUNT_ALLOCATOR
+#error "LV_CPP_SLAB_ALLOCATOR and LV_CPP_MEM_ACCOUNT_ALLOCATOR both provide lv_malloc_core()"
+#endif
+
+void lv_mem_init(void) {
+    lv::slab_alloc::detail::init(lv::slab_alloc::detail::heap());
+}
+
+void lv_mem_deinit(void) {}
+
+lv_mem_pool_t lv_mem_add_pool(void* mem, size_t bytes) {
+    (void)mem;
+    (void)bytes;
+    return nullptr;
+}
+
+void lv_mem_remove_pool(lv_mem_pool_t pool) {
+    (void)pool;
+}
+
+void* lv_malloc_core(size_t size) {
+    return lv::slab_alloc::detail::allocate(size);
+}
+
+void* lv_realloc_core(void* p, size_t new_size) {
+    return lv::slab_alloc::detail::reallocate(p, new_size);
+}
+
+void lv_free_core(void* p) {
+    lv::slab_alloc::detail::release(p);
+}
+
+void lv_mem_monitor_core(lv_mem_monitor_t* mon_p) {
+    using namespace lv::slab_alloc;
+    lv_memzero(mon_p, sizeof(lv_mem_monitor_t));
+    const Stats s = stats();
+    size_t slab_total = 0;
+    size_t slab_free = 0;
+    uint32_t slab_free_cnt = 0;
+    uint32_t used_cnt = 0;
+    for (uint32_t i = 0; i < s.class_count; ++i) {
+        const ClassStat& c = s.classes[i];
+        slab_total += static_cast<size_t>(c.size) * c.blocks;
+        slab_free += static_cast<size_t>(c.size) * (c.blocks - c.used);
+        slab_free_cnt += c.blocks - c.used;
+        used_cnt += c.used;
+        if (c.used < c.blocks && c.size > mon_p->free_biggest_size) mon_p->free_biggest_size = c.size;
+    }
+    const size_t arena_free = s.arena_size - s.arena_used;
+    mon_p->total_size = slab_total + s.arena_size;
+    mon_p->free_size = slab_free + arena_free;
+    mon_p->free_cnt = slab_free_cnt + s.arena_free_blocks;
+    mon_p->used_cnt = used_cnt + s.system_allocs;
+    if (s.arena_biggest_free > mon_p->free_biggest_size) mon_p->free_biggest_size = s.arena_biggest_free;
+    mon_p->max_used = s.peak;
+    mon_p->used_pct = mon_p->total_size
+        ? static_cast<uint8_t>(100 - static_cast<uint64_t>(mon_p->free_size) * 100 / mon_p->total_size) : 0;
+    mon_p->frag_pct = s.arena_frag_pct;   // slabs cannot fragment
+}
+
+lv_result_t lv_mem_test_core(void) {
+    using namespace lv::slab_alloc::detail;
+    Heap& h = heap();
+    if (!h.ready || arena_bytes < arena_min_block) return LV_RESULT_OK;
+    uint32_t prev = 0;
+    uint32_t total = 0;
+    for (ArenaHeader* b = reinterpret_cast<ArenaHeader*>(h.arena); b; b = arena_next(h, b)) {
+        if (b->size < arena_min_block || b->size % 16 || b->prev_size != prev) return LV_RESULT_INVALID;
+        prev = b->size;
+        total += b->size;
+    }
+    return total == arena_bytes ? LV_RESULT_OK : LV_RESULT_INVALID;
+}
+
+#endif // LV_CPP_SLAB_ALLOCATOR
+
+#endif // LV_USE_STDLIB_MALLOC == LV_STDLIB_CUSTOM
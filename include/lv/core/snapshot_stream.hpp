@@ -0,0 +1,595 @@
+#pragma once
+
+/**
+ * @file snapshot_stream.hpp
+ * @brief Incremental, scaled and streamed snapshots (opt-in)
+ *
+ * Recorder keeps one pooled buffer per object for repeated captures (task
+ * switcher thumbnails, live previews). It re-renders only the area
+ * invalidated since the previous capture, and with a scale above 1 it
+ * renders in row bands and box-filters each band into the small output,
+ * so the full-size image never exists:
+ *
+ * @code
+ * #include <lv/core/snapshot_stream.hpp>
+ *
+ * static lv::snapshot::Recorder thumb(music_screen, {.scale = 4, .cf = LV_COLOR_FORMAT_RGB565});
+ * if (thumb.capture()) {                       // something changed
+ *     preview.src(thumb.buf());
+ *     preview.invalidate();
+ * }
+ * @endcode
+ *
+ * Invalidations are seen through the display's LV_EVENT_INVALIDATE_AREA,
+ * which LVGL only sends for objects on the active screen or a display
+ * layer. Objects elsewhere (a screen in the background) are re-rendered
+ * whole on every capture(); so are moved or resized objects.
+ *
+ * encode() streams a capture as QOI, PNG or an LVGL .bin image to an
+ * lv::fs::File or a callback, rendering one band at a time, so a
+ * screenshot of a 1024x600 screen needs a band buffer instead of 2.4 MB:
+ *
+ * @code
+ * lv::fs::File f("A:/tmp/shot.qoi", LV_FS_MODE_WR);
+ * lv::snapshot::encode(lv::screen_active(), lv::snapshot::Format::qoi, f);
+ * lv::snapshot::encode(screen, lv::snapshot::Format::png, [](const void* d, uint32_t n, void* sock) {
+ *     return send(*static_cast<int*>(sock), d, n, 0) == static_cast<ssize_t>(n);
+ * }, &sock);
+ * @endcode
+ *
+ * PNG output uses stored (uncompressed) deflate blocks: exact and cheap to
+ * produce, but about as large as the raw pixels; QOI is the compact choice.
+ *
+ * Not included by lv.hpp: bands are rendered the way lv_snapshot does it
+ * internally, by pointing lv_display_t::layer_head at a layer with its own
+ * _clip_area and marking the display as refreshing, none of which is
+ * public. Checked against LVGL 9.4 (see LV_CPP_INTERNALS_OK).
+ *
+ * Requires LV_USE_SNAPSHOT=1.
+ *
+ * Heap allocation: NONE in the wrapper; the output buffer and the band
+ * buffer (LV_CPP_SNAPSHOT_BAND_BYTES, during capture() and encode())
+ * come from draw::pool_handlers()
+ */
+
+#include <lvgl.h>
+#include "version.hpp"
+
+#if LV_USE_SNAPSHOT
+
+#if !LV_CPP_INTERNALS_OK
+#error "snapshot_stream.hpp reads LVGL internals checked against LVGL 9.4; see LV_CPP_INTERNALS_OK"
+#endif
+
+#include <src/core/lv_refr_private.h>         // lv_refr_set_disp_refreshing()
+#include <src/display/lv_display_private.h>   // layer_head
+#include <src/draw/lv_draw_private.h>         // lv_layer_t::_clip_area
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include "snapshot.hpp"
+#include "fs.hpp"
+#include "qoi.hpp"
+#include "../draw/draw_buf.hpp"
+
+#ifndef LV_CPP_SNAPSHOT_BAND_BYTES
+/// ARGB8888 band a scaled Recorder renders at once, before filtering it down
+#define LV_CPP_SNAPSHOT_BAND_BYTES (32u * 1024u)
+#endif
+
+#ifndef LV_CPP_SNAPSHOT_OUT_BYTES
+/// Encoded bytes collected (on the stack) before each sink call
+#define LV_CPP_SNAPSHOT_OUT_BYTES 512
+#endif
+
+namespace lv::snapshot {
+
+// ==================== Recorder ====================
+
+/// Output of a Recorder
+struct RecorderConfig {
+    uint8_t scale = 1;                               ///< 1: full size; n: 1/n per axis (box filter)
+    lv_color_format_t cf = LV_COLOR_FORMAT_ARGB8888; ///< ARGB8888, XRGB8888 or RGB565
+};
+
+struct RecorderStats {
+    uint32_t captures = 0;      ///< capture() calls that rendered
+    uint32_t full = 0;          ///< of these, whole-object renders
+    uint32_t clean = 0;         ///< capture() calls with nothing to do
+    uint64_t pixels = 0;        ///< Source pixels rendered
+    uint32_t last_us = 0;       ///< Duration of the last render
+    uint32_t max_us = 0;
+};
+
+namespace detail {
+
+/// Render `obj` into `layer` synchronously, as lv_snapshot_take_to_draw_buf() does
+inline void redraw(lv_obj_t* obj, lv_layer_t& layer) noexcept {
+    lv_display_t* disp = lv_obj_get_display(obj);
+    lv_display_t* disp_old = lv_refr_get_disp_refreshing();
+    lv_layer_t* head_old = disp->layer_head;
+    disp->layer_head = &layer;
+    lv_refr_set_disp_refreshing(disp);
+    lv_obj_redraw(&layer, obj);
+    while (layer.draw_task_head) {
+        lv_draw_dispatch_wait_for_request();
+        if (!lv_draw_dispatch_layer(disp, &layer)) {
+            lv_draw_wait_for_finish();
+            lv_draw_dispatch_request();
+        }
+    }
+    disp->layer_head = head_old;
+    lv_refr_set_disp_refreshing(disp_old);
+}
+
+/// Clear the ARGB8888 `band`, which covers `area`, and render the part of `obj` inside `bounds` into it
+inline void render_band(lv_obj_t* obj, lv_draw_buf_t* band, const lv_area_t& area, const lv_area_t& bounds) noexcept {
+    lv_draw_buf_clear(band, nullptr);
+    lv_area_t clip;
+    if (!lv_area_intersect(&clip, &area, &bounds)) return;
+    lv_layer_t layer;
+    lv_layer_init(&layer);
+    layer.draw_buf = band;
+    layer.color_format = LV_COLOR_FORMAT_ARGB8888;
+    layer.buf_area = area;
+    layer._clip_area = clip;
+    layer.phy_clip_area = clip;
+    redraw(obj, layer);
+}
+
+/// Average `s` x `s` ARGB8888 blocks of `src` (alpha weighted) into row `y` of `dst`, from column `x`
+inline void box_filter_row(const lv_draw_buf_t* src, uint32_t src_y, uint32_t blocks, uint32_t s,
+                           lv_draw_buf_t* dst, uint32_t x, uint32_t y) noexcept {
+    const auto cf = static_cast<lv_color_format_t>(dst->header.cf);
+    uint8_t* out = dst->data + static_cast<size_t>(y) * dst->header.stride;
+    const uint32_t area = s * s;
+    for (uint32_t b = 0; b < blocks; ++b) {
+        uint32_t sa = 0, sr = 0, sg = 0, sb = 0;
+        for (uint32_t yy = 0; yy < s; ++yy) {
+            const uint8_t* p = src->data + static_cast<size_t>(src_y + yy) * src->header.stride + b * s * 4;
+            for (uint32_t xx = 0; xx < s; ++xx, p += 4) {
+                const uint32_t a = p[3];
+                sb += p[0] * a;
+                sg += p[1] * a;
+                sr += p[2] * a;
+                sa += a;
+            }
+        }
+        const uint8_t r = sa ? static_cast<uint8_t>(sr / sa) : 0;
+        const uint8_t g = sa ? static_cast<uint8_t>(sg / sa) : 0;
+        const uint8_t bl = sa ? static_cast<uint8_t>(sb / sa) : 0;
+        const uint32_t ox = x + b;
+        if (cf == LV_COLOR_FORMAT_RGB565) {
+            const uint16_t c = static_cast<uint16_t>(((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (bl >> 3));
+            std::memcpy(out + ox * 2, &c, 2);
+        } else {
+            uint8_t* q = out + ox * 4;
+            q[0] = bl;
+            q[1] = g;
+            q[2] = r;
+            q[3] = cf == LV_COLOR_FORMAT_XRGB8888 ? 0xFF : static_cast<uint8_t>(sa / area);
+        }
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Repeated captures of one object into a pooled buffer, re-rendering only what changed
+ *
+ * Not movable: the display and object callbacks point at the recorder.
+ */
+class Recorder {
+    lv_obj_t* m_obj = nullptr;
+    lv_display_t* m_disp = nullptr;
+    RecorderConfig m_cfg;
+    lv_draw_buf_t* m_buf = nullptr;
+    lv_area_t m_area{};          ///< Snapshot area of the last capture (display coordinates)
+    lv_area_t m_dirty{};         ///< Invalidated since then, inside m_area
+    bool m_has_dirty = false;
+    bool m_full = true;          ///< Next capture renders everything
+    RecorderStats m_stats;
+
+    static void invalidate_cb(lv_event_t* e) noexcept {
+        auto* self = static_cast<Recorder*>(lv_event_get_user_data(e));
+        const auto* a = static_cast<const lv_area_t*>(lv_event_get_param(e));
+        lv_area_t hit;
+        if (!a || self->m_full || !lv_area_intersect(&hit, a, &self->m_area)) return;
+        if (self->m_has_dirty) {
+            self->m_dirty = {LV_MIN(self->m_dirty.x1, hit.x1), LV_MIN(self->m_dirty.y1, hit.y1),
+                             LV_MAX(self->m_dirty.x2, hit.x2), LV_MAX(self->m_dirty.y2, hit.y2)};
+        } else {
+            self->m_dirty = hit;
+            self->m_has_dirty = true;
+        }
+    }
+
+    static void delete_cb(lv_event_t* e) noexcept {
+        static_cast<Recorder*>(lv_event_get_user_data(e))->detach(true);
+    }
+
+    [[nodiscard]] static lv_area_t snapshot_area(lv_obj_t* obj) noexcept {
+        lv_area_t a;
+        lv_obj_get_coords(obj, &a);
+        const int32_t ext = lv_obj_get_ext_draw_size(obj);
+        lv_area_increase(&a, ext, ext);
+        return a;
+    }
+
+    /// Invalidations only reach the display for objects it can show
+    [[nodiscard]] bool tracked() const noexcept {
+        lv_obj_t* scr = lv_obj_get_screen(m_obj);
+        return scr == lv_display_get_screen_active(m_disp) || scr == lv_display_get_layer_top(m_disp) ||
+               scr == lv_display_get_layer_sys(m_disp) || scr == lv_display_get_layer_bottom(m_disp);
+    }
+
+    void detach(bool deleting) noexcept {
+        if (m_disp) lv_display_remove_event_cb_with_user_data(m_disp, &invalidate_cb, this);
+        if (m_obj && !deleting) lv_obj_remove_event_cb_with_user_data(m_obj, &delete_cb, this);
+        m_obj = nullptr;
+        m_disp = nullptr;
+    }
+
+    [[nodiscard]] bool ensure_buf(uint32_t w, uint32_t h) noexcept {
+        if (m_buf && m_buf->header.w == w && m_buf->header.h == h) return true;
+        if (m_buf) {
+            lv_image_cache_drop(m_buf);
+            lv_draw_buf_destroy(m_buf);
+        }
+        m_buf = lv_draw_buf_create_ex(draw::pool_handlers(), w, h, m_cfg.cf, LV_STRIDE_AUTO);
+        return m_buf != nullptr;
+    }
+
+    /// Full size: render straight into the output, clipped to `clip`
+    void render_direct(const lv_area_t& clip) noexcept {
+        lv_area_t rel = clip;
+        lv_area_move(&rel, -m_area.x1, -m_area.y1);
+        lv_draw_buf_clear(m_buf, &rel);
+        lv_layer_t layer;
+        lv_layer_init(&layer);
+        layer.draw_buf = m_buf;
+        layer.color_format = m_cfg.cf;
+        layer.buf_area = m_area;
+        layer._clip_area = clip;
+        layer.phy_clip_area = clip;
+        detail::redraw(m_obj, layer);
+    }
+
+    /// Scaled: render bands of `clip` (aligned to the scale) into a pooled buffer and filter them down
+    [[nodiscard]] bool render_scaled(const lv_area_t& clip) noexcept {
+        const uint32_t s = m_cfg.scale;
+        // Output cells covered by `clip`
+        const int32_t cx1 = (clip.x1 - m_area.x1) / static_cast<int32_t>(s);
+        const int32_t cx2 = (clip.x2 - m_area.x1) / static_cast<int32_t>(s);
+        const int32_t cy1 = (clip.y1 - m_area.y1) / static_cast<int32_t>(s);
+        const int32_t cy2 = (clip.y2 - m_area.y1) / static_cast<int32_t>(s);
+        const uint32_t cells = static_cast<uint32_t>(cx2 - cx1 + 1);
+        const uint32_t band_w = cells * s;
+        const uint32_t row_bytes = band_w * 4 * s;
+        const uint32_t band_cells = LV_MAX(1u, LV_CPP_SNAPSHOT_BAND_BYTES / row_bytes);
+        const uint32_t band_h = LV_MIN(band_cells, static_cast<uint32_t>(cy2 - cy1 + 1)) * s;
+        lv_draw_buf_t* band = lv_draw_buf_create_ex(draw::pool_handlers(), band_w, band_h, LV_COLOR_FORMAT_ARGB8888,
+                                                    LV_STRIDE_AUTO);
+        if (!band) return false;
+        for (int32_t cy = cy1; cy <= cy2; cy += static_cast<int32_t>(band_cells)) {
+            const uint32_t rows = LV_MIN(band_cells, static_cast<uint32_t>(cy2 - cy + 1));
+            lv_area_t area{m_area.x1 + cx1 * static_cast<int32_t>(s), m_area.y1 + cy * static_cast<int32_t>(s), 0, 0};
+            area.x2 = area.x1 + static_cast<int32_t>(band_w) - 1;
+            area.y2 = area.y1 + static_cast<int32_t>(rows * s) - 1;
+            detail::render_band(m_obj, band, area, m_area);
+            for (uint32_t r = 0; r < rows; ++r) {
+                detail::box_filter_row(band, r * s, cells, s, m_buf, static_cast<uint32_t>(cx1),
+                                       static_cast<uint32_t>(cy) + r);
+            }
+        }
+        lv_draw_buf_destroy(band);
+        return true;
+    }
+
+public:
+    Recorder(ObjectView obj, RecorderConfig cfg = {}) noexcept : m_cfg(cfg) {
+        if (m_cfg.scale == 0) m_cfg.scale = 1;
+        if (m_cfg.cf != LV_COLOR_FORMAT_RGB565 && m_cfg.cf != LV_COLOR_FORMAT_XRGB8888) {
+            m_cfg.cf = LV_COLOR_FORMAT_ARGB8888;
+        }
+        m_obj = obj.get();
+        if (!m_obj) return;
+        m_disp = lv_obj_get_display(m_obj);
+        lv_display_add_event_cb(m_disp, &invalidate_cb, LV_EVENT_INVALIDATE_AREA, this);
+        lv_obj_add_event_cb(m_obj, &delete_cb, LV_EVENT_DELETE, this);
+    }
+
+    ~Recorder() {
+        detach(false);
+        if (m_buf) {
+            lv_image_cache_drop(m_buf);
+            lv_draw_buf_destroy(m_buf);
+        }
+    }
+
+    Recorder(const Recorder&) = delete;
+    Recorder& operator=(const Recorder&) = delete;
+
+    /**
+     * @brief Bring the buffer up to date
+     * @return true if pixels changed (redraw whatever shows buf()), false if clean or failed
+     */
+    bool capture() noexcept {
+        if (!m_obj) return false;
+        const lv_area_t area = snapshot_area(m_obj);
+        const uint32_t s = m_cfg.scale;
+        const uint32_t w = static_cast<uint32_t>(lv_area_get_width(&area));
+        const uint32_t h = static_cast<uint32_t>(lv_area_get_height(&area));
+        if (!lv_area_is_equal(&area, &m_area)) m_full = true;
+        if (!tracked()) m_full = true;
+        if (!m_full && !m_has_dirty) {
+            ++m_stats.clean;
+            return false;
+        }
+        if (!ensure_buf((w + s - 1) / s, (h + s - 1) / s)) return false;
+        m_area = area;
+        const lv_area_t clip = m_full ? area : m_dirty;
+        m_full = false;
+        m_has_dirty = false;
+
+        const auto t0 = std::chrono::steady_clock::now();
+        lv_image_cache_drop(m_buf);
+        if (s == 1) {
+            render_direct(clip);
+        } else if (!render_scaled(clip)) {
+            m_full = true;
+            return false;
+        }
+        const auto us = static_cast<uint32_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - t0).count());
+        ++m_stats.captures;
+        if (lv_area_is_equal(&clip, &area)) ++m_stats.full;
+        m_stats.pixels += lv_area_get_size(&clip);
+        m_stats.last_us = us;
+        if (us > m_stats.max_us) m_stats.max_us = us;
+        return true;
+    }
+
+    /// Force the next capture() to render everything (content changed without invalidating)
+    void invalidate() noexcept { m_full = true; }
+
+    /// The captured image (nullptr before the first capture)
+    [[nodiscard]] const lv_draw_buf_t* buf() const noexcept { return m_buf; }
+    [[nodiscard]] const void* src() const noexcept { return m_buf; }
+
+    /// Object being recorded (nullptr once deleted)
+    [[nodiscard]] lv_obj_t* object() const noexcept { return m_obj; }
+
+    [[nodiscard]] const RecorderStats& stats() const noexcept { return m_stats; }
+    void reset_stats() noexcept { m_stats = RecorderStats{}; }
+};
+
+// ==================== Streaming encoders ====================
+
+/// Output format of encode()
+enum class Format : uint8_t {
+    qoi,    ///< QOI (RGBA or RGB), compact and fast
+    png,    ///< PNG with stored deflate blocks (no compression)
+    raw,    ///< LVGL .bin image, ARGB8888 (loadable by MappedImage and the bin decoder)
+};
+
+/// Receives encoded bytes in order; return false to abort
+using Sink = bool (*)(const void* data, uint32_t size, void* user);
+
+struct EncodeOptions {
+    bool alpha = false;     ///< Keep transparency (QOI/PNG RGBA); opaque RGB otherwise
+};
+
+namespace detail {
+
+/// Buffers output for the sink and keeps the PNG checksums
+class Writer {
+    Sink m_sink;
+    void* m_user;
+    uint8_t m_buf[LV_CPP_SNAPSHOT_OUT_BYTES];
+    uint32_t m_len = 0;
+    bool m_ok = true;
+
+public:
+    size_t total = 0;
+    uint32_t crc = 0;       ///< PNG chunk CRC (running)
+    uint32_t adler_a = 1;   ///< zlib Adler-32 halves
+    uint32_t adler_b = 0;
+
+    Writer(Sink sink, void* user) noexcept : m_sink(sink), m_user(user) {}
+
+    [[nodiscard]] bool ok() const noexcept { return m_ok; }
+
+    void flush() noexcept {
+        if (m_len && m_ok) m_ok = m_sink(m_buf, m_len, m_user);
+        m_len = 0;
+    }
+
+    void byte(uint8_t b) noexcept {
+        if (m_len == sizeof(m_buf)) flush();
+        m_buf[m_len++] = b;
+        ++total;
+        crc ^= b;
+        for (int k = 0; k < 8; ++k) crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+    }
+
+    void bytes(const void* p, uint32_t n) noexcept {
+        const auto* b = static_cast<const uint8_t*>(p);
+        for (uint32_t i = 0; i < n; ++i) byte(b[i]);
+    }
+
+    void be32(uint32_t v) noexcept {
+        byte(static_cast<uint8_t>(v >> 24));
+        byte(static_cast<uint8_t>(v >> 16));
+        byte(static_cast<uint8_t>(v >> 8));
+        byte(static_cast<uint8_t>(v));
+    }
+
+    /// Byte of the zlib stream: also updates Adler-32
+    void zbyte(uint8_t b) noexcept {
+        adler_a = (adler_a + b) % 65521u;
+        adler_b = (adler_b + adler_a) % 65521u;
+        byte(b);
+    }
+
+    void chunk_begin(uint32_t length, const char type[4]) noexcept {
+        be32(length);
+        crc = 0xFFFFFFFFu;
+        bytes(type, 4);
+    }
+
+    void chunk_end() noexcept { be32(crc ^ 0xFFFFFFFFu); }
+};
+
+} // namespace detail
+
+/**
+ * @brief Render `obj` band by band and stream it to `sink` as `format`
+ * @return Bytes written, 0 on failure (out of memory, or the sink refused)
+ */
+inline size_t encode(ObjectView obj, Format format, Sink sink, void* user, EncodeOptions opt = {}) noexcept {
+    lv_obj_t* o = obj.get();
+    if (!o || !sink) return 0;
+    lv_area_t area;
+    lv_obj_get_coords(o, &area);
+    const int32_t ext = lv_obj_get_ext_draw_size(o);
+    lv_area_increase(&area, ext, ext);
+    const uint32_t w = static_cast<uint32_t>(lv_area_get_width(&area));
+    const uint32_t h = static_cast<uint32_t>(lv_area_get_height(&area));
+    if (w == 0 || h == 0) return 0;
+    const uint32_t band_rows = LV_MIN(h, LV_MAX(1u, LV_CPP_SNAPSHOT_BAND_BYTES / (w * 4)));
+    lv_draw_buf_t* band = lv_draw_buf_create_ex(draw::pool_handlers(), w, band_rows, LV_COLOR_FORMAT_ARGB8888,
+                                                LV_STRIDE_AUTO);
+    if (!band) return 0;
+
+    detail::Writer out(sink, user);
+    qoi::Encoder qoi_state;
+    const uint8_t channels = opt.alpha ? 4 : 3;
+    // PNG: one row is a filter byte and the pixels; stored deflate blocks hold up to 65535 bytes
+    const uint32_t png_row = 1 + w * channels;
+    uint32_t block_left = 0;
+    uint32_t stream_left = png_row * h;
+    // Next byte of the deflate stream, opening a stored block (BFINAL on the last) when needed
+    auto zput = [&](uint8_t b) {
+        if (block_left == 0) {
+            block_left = LV_MIN(65535u, stream_left);
+            out.byte(block_left == stream_left ? 1 : 0);
+            out.byte(static_cast<uint8_t>(block_left));
+            out.byte(static_cast<uint8_t>(block_left >> 8));
+            out.byte(static_cast<uint8_t>(~block_left));
+            out.byte(static_cast<uint8_t>(~block_left >> 8));
+        }
+        out.zbyte(b);
+        --block_left;
+        --stream_left;
+    };
+
+    switch (format) {
+    case Format::qoi:
+        out.bytes("qoif", 4);
+        out.be32(w);
+        out.be32(h);
+        out.byte(channels);
+        out.byte(0);
+        break;
+    case Format::png: {
+        static constexpr uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+        out.bytes(signature, 8);
+        out.chunk_begin(13, "IHDR");
+        out.be32(w);
+        out.be32(h);
+        out.byte(8);
+        out.byte(opt.alpha ? 6 : 2);
+        out.byte(0);
+        out.byte(0);
+        out.byte(0);
+        out.chunk_end();
+        break;
+    }
+    case Format::raw: {
+        lv_image_header_t header{};
+        header.magic = LV_IMAGE_HEADER_MAGIC;
+        header.cf = LV_COLOR_FORMAT_ARGB8888;
+        header.w = w;
+        header.h = h;
+        header.stride = w * 4;
+        out.bytes(&header, sizeof(header));
+        break;
+    }
+    }
+
+    for (uint32_t y0 = 0; y0 < h && out.ok(); y0 += band_rows) {
+        const uint32_t rows = LV_MIN(band_rows, h - y0);
+        lv_area_t band_area{area.x1, area.y1 + static_cast<int32_t>(y0), area.x2, area.y1 + static_cast<int32_t>(y0 + rows) - 1};
+        detail::render_band(o, band, band_area, area);
+
+        if (format == Format::png) {
+            // One IDAT per band: [zlib header] stored blocks [Adler-32]
+            const bool first = y0 == 0;
+            const bool last = y0 + rows == h;
+            const uint32_t data = png_row * rows;
+            uint32_t headers = 0;   // stored block headers starting inside this band
+            for (uint32_t left = block_left, pos = 0; pos < data;) {
+                if (left == 0) {
+                    ++headers;
+                    left = LV_MIN(65535u, stream_left - pos);
+                }
+                const uint32_t n = LV_MIN(left, data - pos);
+                pos += n;
+                left -= n;
+            }
+            out.chunk_begin((first ? 2 : 0) + headers * 5 + data + (last ? 4 : 0), "IDAT");
+            if (first) {
+                out.byte(0x78);
+                out.byte(0x01);
+            }
+        }
+
+        for (uint32_t r = 0; r < rows && out.ok(); ++r) {
+            const uint8_t* row = band->data + static_cast<size_t>(r) * band->header.stride;
+            if (format == Format::raw) {
+                out.bytes(row, w * 4);
+                continue;
+            }
+            if (format == Format::png) zput(0);   // filter: none
+            for (uint32_t x = 0; x < w; ++x) {
+                const uint8_t* p = row + x * 4;
+                const uint8_t px[4] = {p[2], p[1], p[0], opt.alpha ? p[3] : uint8_t(255)};
+                if (format == Format::qoi) {
+                    qoi_state.pixel(out, px);
+                } else {
+                    for (uint8_t c = 0; c < channels; ++c) zput(px[c]);
+                }
+            }
+        }
+
+        if (format == Format::png) {
+            if (y0 + rows == h) out.be32(out.adler_b << 16 | out.adler_a);
+            out.chunk_end();
+        }
+    }
+    lv_draw_buf_destroy(band);
+
+    if (format == Format::qoi) {
+        qoi_state.flush(out);
+        out.bytes(qoi::end_marker, sizeof(qoi::end_marker));
+    } else if (format == Format::png) {
+        out.chunk_begin(0, "IEND");
+        out.chunk_end();
+    }
+    out.flush();
+    return out.ok() ? out.total : 0;
+}
+
+/// Stream `obj` to an open file as `format`
+inline size_t encode(ObjectView obj, Format format, fs::File& file, EncodeOptions opt = {}) noexcept {
+    if (!file) return 0;
+    return encode(obj, format, [](const void* data, uint32_t size, void* f) {
+        uint32_t written = 0;
+        return static_cast<fs::File*>(f)->write(data, size, &written) == LV_FS_RES_OK && written == size;
+    }, &file, opt);
+}
+
+} // namespace lv::snapshot
+
+#endif // LV_USE_SNAPSHOT
@@ -0,0 +1,358 @@
+#pragma once
+
+/**
+ * @file spatial_index.hpp
+ * @brief Sorted-axis index of a container's children for hit tests and directional focus
+ *
+ * With thousands of children a point lookup walks all of them, and
+ * finding "the next object to the right" (gridnav, D-pad focus) scans
+ * every child again per key press. SpatialIndex keeps the children's
+ * areas of one container in two arrays sorted by left and top edge. A
+ * query binary-searches the axis it moves along and stops as soon as no
+ * further entry can win, so lists, grids and tile walls answer in
+ * O(log n + k), k being the objects near the query.
+ *
+ * @code
+ * static lv::SpatialIndex<1024> tiles_index;
+ * tiles_index.attach(wall);                          // rebuilt lazily after layout changes
+ *
+ * lv::ObjectView hit = tiles_index.hit(point);       // topmost clickable child under `point`
+ * tiles_index.focus(LV_DIR_RIGHT, group);            // D-pad: nearest child to the right
+ * @endcode
+ *
+ * The areas are stored in the container's content space (scroll offset
+ * added back), so scrolling does not invalidate them. Adding, deleting,
+ * moving or resizing a child, and the container's own layout and size
+ * changes, mark the index dirty; the next query rebuilds it (n log n).
+ * Hidden children are skipped when queried. Only direct children are
+ * indexed: for nested widgets, continue with lv_indev_search_obj() from
+ * the child hit(). LVGL's own pointer search and LV_USE_GRIDNAV keep
+ * walking the tree; use hit() from a custom indev or event handler and
+ * focus() from a key handler instead of gridnav.
+ *
+ * With more than Capacity children the queries fall back to a linear scan
+ * (LV_LOG_WARN once per rebuild).
+ *
+ * Non-movable: the container's events keep a pointer to it.
+ * Heap allocation: NONE (the arrays are part of the object; LVGL
+ * allocates the event descriptors)
+ *
+ * @tparam Capacity Children that can be indexed (up to 65535)
+ */
+
+#include <lvgl.h>
+#include <algorithm>
+#include <cstdint>
+#include "object.hpp"
+
+namespace lv {
+
+namespace detail {
+
+/// Direction score of `b` seen from `a`: gap along `dir` plus twice the sideways center offset (-1: not in `dir`)
+[[nodiscard]] inline int32_t direction_score(const lv_area_t& a, const lv_area_t& b, lv_dir_t dir) noexcept {
+    // Doubled centers stay exact, so the score does not depend on the origin
+    const int32_t acx = a.x1 + a.x2, acy = a.y1 + a.y2;
+    const int32_t bcx = b.x1 + b.x2, bcy = b.y1 + b.y2;
+    int32_t gap = 0;
+    int32_t side = 0;
+    switch (dir) {
+    case LV_DIR_RIGHT: if (bcx <= acx) return -1; gap = b.x1 - a.x2; side = bcy - acy; break;
+    case LV_DIR_LEFT: if (bcx >= acx) return -1; gap = a.x1 - b.x2; side = bcy - acy; break;
+    case LV_DIR_BOTTOM: if (bcy <= acy) return -1; gap = b.y1 - a.y2; side = bcx - acx; break;
+    case LV_DIR_TOP: if (bcy >= acy) return -1; gap = a.y1 - b.y2; side = bcx - acx; break;
+    default: return -1;
+    }
+    if (gap < 0) gap = 0;
+    return gap + (side < 0 ? -side : side);
+}
+
+} // namespace detail
+
+template<uint32_t Capacity = 256>
+class SpatialIndex {
+    static_assert(Capacity > 0 && Capacity <= 65535, "SpatialIndex capacity must fit 16-bit indices");
+
+public:
+    struct Stats {
+        uint32_t rebuilds = 0;
+        uint32_t queries = 0;
+        uint32_t visited = 0;     ///< Entries examined by all queries
+        uint32_t fallbacks = 0;   ///< Queries answered by a linear scan (over capacity)
+    };
+
+private:
+    struct Entry {
+        lv_obj_t* obj;
+        lv_area_t area;           ///< Content space
+    };
+
+    Entry m_entries[Capacity];    ///< Child order (later is on top)
+    uint16_t m_by_x[Capacity];    ///< Sorted by area.x1
+    uint16_t m_by_y[Capacity];    ///< Sorted by area.y1
+    uint32_t m_count = 0;
+    int32_t m_max_w = 0;
+    int32_t m_max_h = 0;
+    lv_obj_t* m_obj = nullptr;
+    bool m_dirty = true;
+    bool m_overflow = false;
+    Stats m_stats;
+
+    static void event_cb(lv_event_t* e) noexcept {
+        auto* self = static_cast<SpatialIndex*>(lv_event_get_user_data(e));
+        if (lv_event_get_code(e) == LV_EVENT_DELETE) {
+            self->m_obj = nullptr;
+            self->m_count = 0;
+            return;
+        }
+        self->m_dirty = true;
+    }
+
+    /// Offset from screen to content space
+    [[nodiscard]] lv_point_t origin() const noexcept {
+        lv_area_t c;
+        lv_obj_get_coords(m_obj, &c);
+        return {c.x1 - lv_obj_get_scroll_x(m_obj), c.y1 - lv_obj_get_scroll_y(m_obj)};
+    }
+
+    void rebuild() noexcept {
+        m_dirty = false;
+        m_count = 0;
+        m_max_w = m_max_h = 0;
+        m_overflow = false;
+        if (!m_obj) return;
+        ++m_stats.rebuilds;
+        const lv_point_t o = origin();
+        const uint32_t n = lv_obj_get_child_count(m_obj);
+        if (n > Capacity) {
+            m_overflow = true;
+            LV_LOG_WARN("%u children over SpatialIndex capacity %u, scanning linearly",
+                        static_cast<unsigned>(n), static_cast<unsigned>(Capacity));
+            return;
+        }
+        for (uint32_t i = 0; i < n; ++i) {
+            Entry& e = m_entries[m_count];
+            e.obj = lv_obj_get_child(m_obj, static_cast<int32_t>(i));
+            lv_obj_get_coords(e.obj, &e.area);
+            lv_area_move(&e.area, -o.x, -o.y);
+            m_max_w = std::max(m_max_w, lv_area_get_width(&e.area));
+            m_max_h = std::max(m_max_h, lv_area_get_height(&e.area));
+            m_by_x[m_count] = static_cast<uint16_t>(m_count);
+            m_by_y[m_count] = static_cast<uint16_t>(m_count);
+            ++m_count;
+        }
+        std::sort(m_by_x, m_by_x + m_count, [this](uint16_t a, uint16_t b) {
+            return m_entries[a].area.x1 < m_entries[b].area.x1;
+        });
+        std::sort(m_by_y, m_by_y + m_count, [this](uint16_t a, uint16_t b) {
+            return m_entries[a].area.y1 < m_entries[b].area.y1;
+        });
+    }
+
+    [[nodiscard]] bool ready() noexcept {
+        if (!m_obj) return false;
+        if (m_dirty) rebuild();
+        ++m_stats.queries;
+        if (m_overflow) ++m_stats.fallbacks;
+        return true;
+    }
+
+    /// First position in `order` whose edge (x1 or y1) is >= v
+    [[nodiscard]] uint32_t lower_bound(const uint16_t* order, bool x, int32_t v) const noexcept {
+        const uint16_t* it = std::lower_bound(order, order + m_count, v, [this, x](uint16_t i, int32_t val) {
+            return (x ? m_entries[i].area.x1 : m_entries[i].area.y1) < val;
+        });
+        return static_cast<uint32_t>(it - order);
+    }
+
+    [[nodiscard]] static bool usable(lv_obj_t* obj, bool clickable) noexcept {
+        if (lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return false;
+        return !clickable || lv_obj_has_flag(obj, LV_OBJ_FLAG_CLICKABLE);
+    }
+
+    [[nodiscard]] lv_obj_t* neighbor_linear(lv_obj_t* from, const lv_area_t& a, lv_dir_t dir) noexcept {
+        const lv_point_t o = origin();
+        lv_obj_t* best = nullptr;
+        int32_t best_score = INT32_MAX;
+        const uint32_t n = lv_obj_get_child_count(m_obj);
+        for (uint32_t i = 0; i < n; ++i) {
+            lv_obj_t* c = lv_obj_get_child(m_obj, static_cast<int32_t>(i));
+            ++m_stats.visited;
+            if (c == from || !usable(c, false)) continue;
+            lv_area_t b;
+            lv_obj_get_coords(c, &b);
+            lv_area_move(&b, -o.x, -o.y);
+            const int32_t s = detail::direction_score(a, b, dir);
+            if (s >= 0 && s < best_score) {
+                best_score = s;
+                best = c;
+            }
+        }
+        return best;
+    }
+
+public:
+    SpatialIndex() noexcept = default;
+
+    /// Index the children of `container`
+    explicit SpatialIndex(ObjectView container) noexcept { attach(container); }
+
+    ~SpatialIndex() { detach(); }
+
+    SpatialIndex(const SpatialIndex&) = delete;
+    SpatialIndex& operator=(const SpatialIndex&) = delete;
+
+    /// Index the children of `container` instead
+    SpatialIndex& attach(ObjectView container) noexcept {
+        detach();
+        m_obj = container.get();
+        m_dirty = true;
+        if (!m_obj) return *this;
+        for (lv_event_code_t code : {LV_EVENT_CHILD_CHANGED, LV_EVENT_CHILD_CREATED, LV_EVENT_CHILD_DELETED,
+                                     LV_EVENT_SIZE_CHANGED, LV_EVENT_LAYOUT_CHANGED, LV_EVENT_DELETE}) {
+            lv_obj_add_event_cb(m_obj, &SpatialIndex::event_cb, code, this);
+        }
+        return *this;
+    }
+
+    void detach() noexcept {
+        if (m_obj) lv_obj_remove_event_cb_with_user_data(m_obj, &SpatialIndex::event_cb, this);
+        m_obj = nullptr;
+        m_count = 0;
+    }
+
+    /// Rebuild on the next query (for changes LVGL does not report, e.g. hiding a child)
+    void invalidate() noexcept { m_dirty = true; }
+
+    // ==================== Queries ====================
+
+    /**
+     * @brief Topmost child under `point` (screen coordinates)
+     * @param clickable_only Skip children without LV_OBJ_FLAG_CLICKABLE
+     */
+    [[nodiscard]] ObjectView hit(lv_point_t point, bool clickable_only = true) noexcept {
+        if (!ready()) return ObjectView();
+        if (m_overflow) {
+            for (int32_t i = static_cast<int32_t>(lv_obj_get_child_count(m_obj)) - 1; i >= 0; --i) {
+                lv_obj_t* c = lv_obj_get_child(m_obj, i);
+                ++m_stats.visited;
+                lv_area_t b;
+                lv_obj_get_coords(c, &b);
+                if (usable(c, clickable_only) && lv_area_is_point_on(&b, &point, 0)) return ObjectView(c);
+            }
+            return ObjectView();
+        }
+        const lv_point_t o = origin();
+        const lv_point_t p{point.x - o.x, point.y - o.y};
+        // Entries starting in [p.y - max height, p.y] are the only ones that can cover p
+        int32_t top = -1;
+        for (uint32_t k = lower_bound(m_by_y, false, p.y - m_max_h); k < m_count; ++k) {
+            const uint16_t i = m_by_y[k];
+            const Entry& e = m_entries[i];
+            if (e.area.y1 > p.y) break;
+            ++m_stats.visited;
+            if (static_cast<int32_t>(i) > top && lv_area_is_point_on(&e.area, &p, 0)
+                && usable(e.obj, clickable_only)) {
+                top = i;
+            }
+        }
+        return top >= 0 ? ObjectView(m_entries[top].obj) : ObjectView();
+    }
+
+    /// Nearest visible child from `from` in `dir` (LV_DIR_LEFT/RIGHT/TOP/BOTTOM), null if none
+    [[nodiscard]] ObjectView neighbor(ObjectView from, lv_dir_t dir) noexcept {
+        if (!from || !ready()) return ObjectView();
+        const lv_point_t o = origin();
+        lv_area_t a;
+        lv_obj_get_coords(from.get(), &a);
+        lv_area_move(&a, -o.x, -o.y);
+        if (m_overflow) return ObjectView(neighbor_linear(from.get(), a, dir));
+
+        const bool x = dir == LV_DIR_LEFT || dir == LV_DIR_RIGHT;
+        const uint16_t* order = x ? m_by_x : m_by_y;
+        const bool forward = dir == LV_DIR_RIGHT || dir == LV_DIR_BOTTOM;
+        const int32_t center = x ? (a.x1 + a.x2) / 2 : (a.y1 + a.y2) / 2;
+        const int32_t extent = x ? m_max_w : m_max_h;
+        lv_obj_t* best = nullptr;
+        int32_t best_score = INT32_MAX;
+        // Walk away from `from` along the axis; the gap alone bounds the score
+        uint32_t k = lower_bound(order, x, center - extent - 1);
+        if (forward) {
+            for (; k < m_count; ++k) {
+                const Entry& e = m_entries[order[k]];
+                const int32_t gap = (x ? e.area.x1 - a.x2 : e.area.y1 - a.y2);
+                if (gap > best_score) break;
+                ++m_stats.visited;
+                if (e.obj == from.get() || !usable(e.obj, false)) continue;
+                const int32_t s = detail::direction_score(a, e.area, dir);
+                if (s >= 0 && s < best_score) { best_score = s; best = e.obj; }
+            }
+        } else {
+            // Entries starting after from's center cannot be left of / above it
+            for (k = lower_bound(order, x, center + 1); k-- > 0;) {
+                const Entry& e = m_entries[order[k]];
+                const int32_t near_edge = (x ? e.area.x1 : e.area.y1) + extent;
+                const int32_t gap = (x ? a.x1 : a.y1) - near_edge;
+                if (gap > best_score) break;
+                ++m_stats.visited;
+                if (e.obj == from.get() || !usable(e.obj, false)) continue;
+                const int32_t s = detail::direction_score(a, e.area, dir);
+                if (s >= 0 && s < best_score) { best_score = s; best = e.obj; }
+            }
+        }
+        return ObjectView(best);
+    }
+
+    /**
+     * @brief Move the focus of `group` to the neighbor of its focused child in `dir`
+     *
+     * Starts at the first child if the focus is not on one. The new child
+     * is scrolled into view.
+     *
+     * @param group nullptr: the container's group, else the default group
+     * @return The newly focused child, null if there is none in `dir`
+     */
+    ObjectView focus(lv_dir_t dir, lv_group_t* group = nullptr, lv_anim_enable_t anim = LV_ANIM_ON) noexcept {
+        if (!m_obj) return ObjectView();
+        if (!group) group = lv_obj_get_group(m_obj);
+        if (!group) group = lv_group_get_default();
+        lv_obj_t* from = group ? lv_group_get_focused(group) : nullptr;
+        ObjectView to;
+        if (from && lv_obj_get_parent(from) == m_obj) {
+            to = neighbor(ObjectView(from), dir);
+        } else {
+            to = ObjectView(lv_obj_get_child(m_obj, 0));
+        }
+        if (!to) return to;
+        if (group) lv_group_focus_obj(to.get());
+        lv_obj_scroll_to_view(to.get(), anim);
+        return to;
+    }
+
+    /// Arrow key to direction (LV_DIR_NONE for other keys), for focus() from a key handler
+    [[nodiscard]] static constexpr lv_dir_t key_dir(uint32_t key) noexcept {
+        switch (key) {
+        case LV_KEY_LEFT: return LV_DIR_LEFT;
+        case LV_KEY_RIGHT: return LV_DIR_RIGHT;
+        case LV_KEY_UP: return LV_DIR_TOP;
+        case LV_KEY_DOWN: return LV_DIR_BOTTOM;
+        default: return LV_DIR_NONE;
+        }
+    }
+
+    // ==================== State ====================
+
+    [[nodiscard]] ObjectView container() const noexcept { return ObjectView(m_obj); }
+
+    /// Children indexed at the last rebuild
+    [[nodiscard]] uint32_t size() const noexcept { return m_count; }
+
+    [[nodiscard]] static constexpr uint32_t capacity() noexcept { return Capacity; }
+
+    [[nodiscard]] bool dirty() const noexcept { return m_dirty; }
+
+    [[nodiscard]] const Stats& stats() const noexcept { return m_stats; }
+    void reset_stats() noexcept { m_stats = {}; }
+};
+
+} // namespace lv
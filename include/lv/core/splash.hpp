@@ -0,0 +1,312 @@
+#pragma once
+
+/**
+ * @file splash.hpp
+ * @brief Boot image written straight to the framebuffer, before LVGL is up
+ *
+ * lv::init(), font loading and the first mount take a while, and the panel
+ * stays black meanwhile. splash::show_*() needs none of them: it writes a
+ * pre-converted image (an lv_image_dsc_t from LVGL's image converter,
+ * compiled in) centered on a solid background directly into the scanout
+ * memory, converting RGB565 / RGB888 / XRGB8888 to the framebuffer's
+ * 16 or 32 bpp on the way.
+ *
+ * @code
+ * extern const lv_image_dsc_t boot_logo;                 // RGB565 or XRGB8888
+ *
+ * int main() {
+ *     lv::startup::begin();
+ *     lv::Splash splash = lv::splash::show_fbdev("/dev/fb0", boot_logo, 0x101418);
+ *     lv::init();
+ *     lv::FBDisplay disp("/dev/fb0");
+ *     lv::splash::hand_over(splash, disp);                // released after LVGL's first flush
+ *     ...
+ * }
+ * @endcode
+ *
+ * Taking over without a black frame:
+ * - fbdev: LVGL's driver maps the same memory and does not clear it, so the
+ *   splash stays until the first frame overwrites it. Give the first
+ *   screen the splash background color (or the same image) and the
+ *   switch is invisible;
+ * - DRM: the splash lives in its own dumb buffer on the CRTC, and DRM
+ *   master is dropped right away so LVGL's driver can set its mode. Its
+ *   buffer replaces the splash at that point, so create the LVGL display
+ *   as late as possible: fonts and data first, then the display, mount
+ *   and the first lv_timer_handler();
+ * - show_memory(): any other linear framebuffer (MCU LCD controllers).
+ *
+ * hand_over() keeps the splash's file and mapping open until the display's
+ * first FLUSH_FINISH and then closes them. release() closes them at once.
+ *
+ * Heap allocation: NONE (the framebuffer is mmap()ed device memory)
+ */
+
+#include <lvgl.h>
+#include <cstdint>
+#include <cstring>
+#include "startup.hpp"
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <linux/fb.h>
+#if LV_USE_LINUX_DRM
+#include <xf86drm.h>
+#include <xf86drmMode.h>
+#endif
+#endif
+
+namespace lv {
+
+/// Resources of a shown splash; release() or hand_over() frees them
+struct Splash {
+    int fd = -1;
+    void* map = nullptr;
+    size_t map_size = 0;
+    uint32_t fb_id = 0;        ///< DRM framebuffer
+    uint32_t handle = 0;       ///< DRM dumb buffer
+    bool shown = false;
+
+    [[nodiscard]] explicit operator bool() const noexcept { return shown; }
+};
+
+namespace splash {
+
+namespace detail {
+
+[[nodiscard]] inline uint16_t to565(uint32_t rgb) noexcept {
+    return static_cast<uint16_t>(((rgb >> 8) & 0xF800) | ((rgb >> 5) & 0x07E0) | ((rgb >> 3) & 0x001F));
+}
+
+[[nodiscard]] inline uint32_t from565(uint16_t c) noexcept {
+    const uint32_t r = (c >> 11) & 0x1F;
+    const uint32_t g = (c >> 5) & 0x3F;
+    const uint32_t b = c & 0x1F;
+    return 0xFF000000u | ((r << 3 | r >> 2) << 16) | ((g << 2 | g >> 4) << 8) | (b << 3 | b >> 2);
+}
+
+/// Source pixel `x` of `row` as 0xAARRGGBB
+[[nodiscard]] inline uint32_t src_px(const uint8_t* row, uint32_t x, lv_color_format_t cf) noexcept {
+    switch (cf) {
+    case LV_COLOR_FORMAT_RGB565: {
+        uint16_t c;
+        std::memcpy(&c, row + x * 2, 2);
+        return from565(c);
+    }
+    case LV_COLOR_FORMAT_RGB888:
+        return 0xFF000000u | (uint32_t(row[x * 3 + 2]) << 16) | (uint32_t(row[x * 3 + 1]) << 8) | row[x * 3];
+    default: {
+        uint32_t c;
+        std::memcpy(&c, row + x * 4, 4);
+        return c | 0xFF000000u;
+    }
+    }
+}
+
+[[nodiscard]] inline bool supported(lv_color_format_t cf) noexcept {
+    return cf == LV_COLOR_FORMAT_RGB565 || cf == LV_COLOR_FORMAT_RGB888 ||
+           cf == LV_COLOR_FORMAT_XRGB8888 || cf == LV_COLOR_FORMAT_ARGB8888;
+}
+
+[[nodiscard]] inline uint32_t src_bpp(lv_color_format_t cf) noexcept {
+    return cf == LV_COLOR_FORMAT_RGB565 ? 16 : cf == LV_COLOR_FORMAT_RGB888 ? 24 : 32;
+}
+
+inline void unmap(Splash& s) noexcept {
+#if defined(__linux__)
+    if (s.map) munmap(s.map, s.map_size);
+#endif
+    s.map = nullptr;
+}
+
+inline void flush_finish_cb(lv_event_t* e) noexcept;
+
+} // namespace detail
+
+/**
+ * @brief Blit `image` centered on `bg` (0xRRGGBB) into a linear framebuffer
+ *
+ * @param fb       First pixel of the visible buffer
+ * @param stride   Bytes per framebuffer row
+ * @param bpp      16 (RGB565) or 32 (XRGB8888)
+ * @return false for an unsupported pixel format
+ */
+inline bool show_memory(void* fb, uint32_t width, uint32_t height, uint32_t stride, uint32_t bpp,
+                        const lv_image_dsc_t& image, uint32_t bg = 0x000000) noexcept {
+    const auto cf = static_cast<lv_color_format_t>(image.header.cf);
+    if (!fb || (bpp != 16 && bpp != 32) || !detail::supported(cf)) return false;
+    const uint32_t iw = image.header.w < width ? image.header.w : width;
+    const uint32_t ih = image.header.h < height ? image.header.h : height;
+    const uint32_t src_stride = image.header.stride ? image.header.stride : image.header.w * detail::src_bpp(cf) / 8;
+    const uint32_t x0 = (width - iw) / 2;
+    const uint32_t y0 = (height - ih) / 2;
+    const auto* src = static_cast<const uint8_t*>(image.data);
+    auto* dst = static_cast<uint8_t*>(fb);
+    const uint32_t bg32 = 0xFF000000u | bg;
+    const uint16_t bg16 = detail::to565(bg);
+    const bool same = (bpp == 16 && cf == LV_COLOR_FORMAT_RGB565) ||
+                      (bpp == 32 && (cf == LV_COLOR_FORMAT_XRGB8888 || cf == LV_COLOR_FORMAT_ARGB8888));
+
+    for (uint32_t y = 0; y < height; ++y) {
+        uint8_t* row = dst + static_cast<size_t>(y) * stride;
+        const bool img_row = y >= y0 && y < y0 + ih;
+        const uint8_t* s = img_row ? src + static_cast<size_t>(y - y0) * src_stride : nullptr;
+        for (uint32_t x = 0; x < width; ++x) {
+            const bool img_px = img_row && x >= x0 && x < x0 + iw;
+            if (img_px && same) {
+                // Copy the image span in one go, then continue after it
+                const uint32_t bytes = bpp / 8;
+                std::memcpy(row + x * bytes, s, static_cast<size_t>(iw) * bytes);
+                x += iw - 1;
+                continue;
+            }
+            const uint32_t c = img_px ? detail::src_px(s, x - x0, cf) : bg32;
+            if (bpp == 16) {
+                const uint16_t v = img_px ? detail::to565(c) : bg16;
+                std::memcpy(row + x * 2, &v, 2);
+            } else {
+                std::memcpy(row + x * 4, &c, 4);
+            }
+        }
+    }
+    startup::mark(startup::Phase::splash);
+    return true;
+}
+
+/// Free the splash's mapping, buffer and file now
+inline void release(Splash& s) noexcept {
+    detail::unmap(s);
+#if defined(__linux__)
+#if LV_USE_LINUX_DRM
+    if (s.fb_id) drmModeRmFB(s.fd, s.fb_id);
+    if (s.handle) {
+        drm_mode_destroy_dumb destroy{};
+        destroy.handle = s.handle;
+        drmIoctl(s.fd, DRM_IOCTL_MODE_DESTROY_DUMB, &destroy);
+    }
+#endif
+    if (s.fd >= 0) close(s.fd);
+#endif
+    s = Splash{};
+}
+
+#if defined(__linux__)
+
+/**
+ * @brief Show `image` on a Linux framebuffer device (e.g. "/dev/fb0")
+ *
+ * Writes the visible page (yoffset honored) of a 16 or 32 bpp framebuffer.
+ */
+[[nodiscard]] inline Splash show_fbdev(const char* device, const lv_image_dsc_t& image, uint32_t bg = 0x000000) noexcept {
+    Splash s;
+    s.fd = open(device, O_RDWR | O_CLOEXEC);
+    if (s.fd < 0) return s;
+    fb_var_screeninfo var{};
+    fb_fix_screeninfo fix{};
+    if (ioctl(s.fd, FBIOGET_VSCREENINFO, &var) == 0 && ioctl(s.fd, FBIOGET_FSCREENINFO, &fix) == 0) {
+        s.map_size = fix.smem_len;
+        void* m = mmap(nullptr, s.map_size, PROT_READ | PROT_WRITE, MAP_SHARED, s.fd, 0);
+        if (m != MAP_FAILED) {
+            s.map = m;
+            auto* page = static_cast<uint8_t*>(m) + static_cast<size_t>(var.yoffset) * fix.line_length +
+                         static_cast<size_t>(var.xoffset) * var.bits_per_pixel / 8;
+            s.shown = show_memory(page, var.xres, var.yres, fix.line_length, var.bits_per_pixel, image, bg);
+        }
+    }
+    if (!s.shown) {
+        detail::unmap(s);
+        close(s.fd);
+        s.fd = -1;
+    }
+    return s;
+}
+
+#if LV_USE_LINUX_DRM
+/**
+ * @brief Show `image` on the first connected DRM connector of `device` (e.g. "/dev/dri/card0")
+ *
+ * Scans out an XRGB8888 dumb buffer at the connector's preferred mode and
+ * drops DRM master so LVGL's driver can take over.
+ */
+[[nodiscard]] inline Splash show_drm(const char* device, const lv_image_dsc_t& image, uint32_t bg = 0x000000) noexcept {
+    Splash s;
+    s.fd = open(device, O_RDWR | O_CLOEXEC);
+    if (s.fd < 0) return s;
+    drmModeRes* res = drmModeGetResources(s.fd);
+    drmModeConnector* conn = nullptr;
+    for (int i = 0; res && i < res->count_connectors && !conn; ++i) {
+        drmModeConnector* c = drmModeGetConnector(s.fd, res->connectors[i]);
+        if (c && c->connection == DRM_MODE_CONNECTED && c->count_modes > 0) conn = c;
+        else if (c) drmModeFreeConnector(c);
+    }
+    uint32_t crtc = 0;
+    if (conn) {
+        if (drmModeEncoder* enc = conn->encoder_id ? drmModeGetEncoder(s.fd, conn->encoder_id) : nullptr) {
+            crtc = enc->crtc_id;
+            drmModeFreeEncoder(enc);
+        }
+        if (!crtc && res && res->count_crtcs > 0) crtc = res->crtcs[0];
+    }
+    if (conn && crtc) {
+        drmModeModeInfo mode = conn->modes[0];
+        drm_mode_create_dumb create{};
+        create.width = mode.hdisplay;
+        create.height = mode.vdisplay;
+        create.bpp = 32;
+        if (drmIoctl(s.fd, DRM_IOCTL_MODE_CREATE_DUMB, &create) == 0) {
+            s.handle = create.handle;
+            s.map_size = create.size;
+            drm_mode_map_dumb map{};
+            map.handle = create.handle;
+            if (drmModeAddFB(s.fd, create.width, create.height, 24, 32, create.pitch, create.handle, &s.fb_id) == 0 &&
+                drmIoctl(s.fd, DRM_IOCTL_MODE_MAP_DUMB, &map) == 0) {
+                void* m = mmap(nullptr, s.map_size, PROT_READ | PROT_WRITE, MAP_SHARED, s.fd, map.offset);
+                if (m != MAP_FAILED) {
+                    s.map = m;
+                    uint32_t conn_id = conn->connector_id;
+                    s.shown = show_memory(m, create.width, create.height, create.pitch, 32, image, bg) &&
+                              drmModeSetCrtc(s.fd, crtc, s.fb_id, 0, 0, &conn_id, 1, &mode) == 0;
+                }
+            }
+        }
+    }
+    if (conn) drmModeFreeConnector(conn);
+    if (res) drmModeFreeResources(res);
+    if (s.shown) {
+        drmDropMaster(s.fd);
+    } else {
+        release(s);
+    }
+    return s;
+}
+#endif // LV_USE_LINUX_DRM
+
+#endif // __linux__
+
+/// Keep the splash until `disp` has flushed its first frame, then release() it
+inline void hand_over(Splash& s, lv_display_t* disp) noexcept {
+    if (!disp || (s.fd < 0 && !s.map)) return;
+    static Splash pending;   // one splash per boot
+    release(pending);
+    pending = s;
+    s = Splash{};
+    lv_display_add_event_cb(disp, &detail::flush_finish_cb, LV_EVENT_FLUSH_FINISH, &pending);
+}
+
+namespace detail {
+
+inline void flush_finish_cb(lv_event_t* e) noexcept {
+    auto* s = static_cast<Splash*>(lv_event_get_user_data(e));
+    lv_display_remove_event_cb_with_user_data(static_cast<lv_display_t*>(lv_event_get_current_target(e)),
+                                              &flush_finish_cb, s);
+    release(*s);
+}
+
+} // namespace detail
+
+} // namespace splash
+
+} // namespace lv
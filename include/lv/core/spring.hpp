@@ -0,0 +1,265 @@
+#pragma once
+
+/**
+ * @file spring.hpp
+ * @brief Spring animations that can be retargeted while moving
+ *
+ * A fixed-duration Anim has to be deleted and recreated whenever a touch
+ * moves its destination, and the new one starts from zero velocity, so
+ * an interrupted swipe visibly jerks. lv::Spring drives one property
+ * with a damped spring (stiffness, damping, mass): to() only moves the
+ * target, and position and velocity carry over. There is one timer per
+ * spring, created by the first to() and paused once the spring has
+ * settled, so touch moves create no animations at all.
+ *
+ * @code
+ * static lv::Spring slide(page, lv::AnimProp::x);
+ * slide.stiffness(220).damping(24);
+ *
+ * // PRESSING: follow the finger; RELEASED: fling to the nearest page
+ * slide.jump(x0 + dx);
+ * slide.to(page_x, velocity_px_per_s);
+ * @endcode
+ *
+ * The motion is integrated in fixed LV_CPP_SPRING_STEP_MS steps
+ * (semi-implicit Euler) whatever the timer's jitter, so it is the same
+ * at any frame rate. The spring settles when it is within precision() of
+ * the target and slower than 10 * precision() per second; it then snaps to
+ * the target and calls on_settle(). Stiff, light springs need
+ * step * sqrt(stiffness / mass) < 2 s (about 250000 / mass for the
+ * default 4 ms step) to stay stable.
+ *
+ * Heap allocation: the timer (created by the first to()) and one
+ * delete-event descriptor
+ */
+
+#include <lvgl.h>
+#include <cstdint>
+#include "object.hpp"
+#include "anim_batch.hpp"
+
+#ifndef LV_CPP_SPRING_STEP_MS
+/// Integration step (ms)
+#define LV_CPP_SPRING_STEP_MS 4
+#endif
+
+#ifndef LV_CPP_SPRING_MAX_STEPS
+/// Steps integrated per timer pass at most; a longer stall is skipped, not replayed
+#define LV_CPP_SPRING_MAX_STEPS 32
+#endif
+
+namespace lv {
+
+/**
+ * @brief Damped spring driving one property of one object
+ *
+ * Non-movable: the timer and delete event keep a pointer to it.
+ */
+class Spring {
+public:
+    struct Stats {
+        uint32_t ticks = 0;     ///< Timer passes
+        uint32_t steps = 0;     ///< Integration steps
+        uint32_t applied = 0;   ///< Property writes
+        uint32_t settles = 0;   ///< Times the spring came to rest
+        uint32_t dropped = 0;   ///< Steps skipped after stalls (over LV_CPP_SPRING_MAX_STEPS)
+    };
+
+private:
+    lv_obj_t* m_obj = nullptr;
+    AnimProp m_prop = AnimProp::x;
+    float m_stiffness = 170.0f;
+    float m_damping = 26.0f;
+    float m_mass = 1.0f;
+    float m_precision = 0.5f;
+    float m_pos = 0.0f;
+    float m_vel = 0.0f;             ///< Units per second
+    int32_t m_target = 0;
+    int32_t m_applied = INT32_MIN;
+    uint32_t m_last_tick = 0;
+    uint32_t m_backlog = 0;         ///< ms not yet integrated
+    bool m_moving = false;
+    lv_timer_t* m_timer = nullptr;
+    void (*m_on_settle)(void*) = nullptr;
+    void* m_settle_ctx = nullptr;
+    Stats m_stats;
+
+    void apply() noexcept {
+        const int32_t v = value();
+        if (!m_obj || v == m_applied) return;
+        m_applied = v;
+        detail::anim_apply(m_obj, m_prop, v);
+        ++m_stats.applied;
+    }
+
+    /// One fixed step; true once at rest
+    [[nodiscard]] bool step() noexcept {
+        constexpr float h = LV_CPP_SPRING_STEP_MS / 1000.0f;
+        const float dx = m_pos - static_cast<float>(m_target);
+        const float acc = (-m_stiffness * dx - m_damping * m_vel) / m_mass;
+        m_vel += acc * h;
+        m_pos += m_vel * h;
+        ++m_stats.steps;
+        const float err = m_pos - static_cast<float>(m_target);
+        const float speed = m_vel < 0 ? -m_vel : m_vel;
+        return (err < 0 ? -err : err) <= m_precision && speed <= m_precision * 10.0f;
+    }
+
+    void settle() noexcept {
+        m_pos = static_cast<float>(m_target);
+        m_vel = 0.0f;
+        m_moving = false;
+        m_backlog = 0;
+        if (m_timer) lv_timer_pause(m_timer);
+        apply();
+        ++m_stats.settles;
+        if (m_on_settle) m_on_settle(m_settle_ctx);
+    }
+
+    void tick() noexcept {
+        ++m_stats.ticks;
+        const uint32_t now = lv_tick_get();
+        m_backlog += now - m_last_tick;
+        m_last_tick = now;
+        uint32_t n = m_backlog / LV_CPP_SPRING_STEP_MS;
+        m_backlog -= n * LV_CPP_SPRING_STEP_MS;
+        if (n > LV_CPP_SPRING_MAX_STEPS) {
+            m_stats.dropped += n - LV_CPP_SPRING_MAX_STEPS;
+            n = LV_CPP_SPRING_MAX_STEPS;
+        }
+        while (n--) {
+            if (step()) {
+                settle();
+                return;
+            }
+        }
+        apply();
+    }
+
+    static void timer_cb(lv_timer_t* t) noexcept {
+        static_cast<Spring*>(lv_timer_get_user_data(t))->tick();
+    }
+
+    static void delete_cb(lv_event_t* e) noexcept {
+        auto* self = static_cast<Spring*>(lv_event_get_user_data(e));
+        self->m_obj = nullptr;
+        self->stop();
+    }
+
+public:
+    Spring() noexcept = default;
+
+    /// Drive `prop` of `obj`, starting from value 0 until jump() or the first to()
+    Spring(ObjectView obj, AnimProp prop) noexcept { bind(obj, prop); }
+
+    ~Spring() {
+        if (m_obj) lv_obj_remove_event_cb_with_user_data(m_obj, &Spring::delete_cb, this);
+        if (m_timer) lv_timer_delete(m_timer);
+    }
+
+    Spring(const Spring&) = delete;
+    Spring& operator=(const Spring&) = delete;
+
+    // ==================== Setup ====================
+
+    /// Drive `prop` of `obj` instead (nullptr unbinds); position and velocity are kept
+    Spring& bind(ObjectView obj, AnimProp prop) noexcept {
+        if (m_obj) lv_obj_remove_event_cb_with_user_data(m_obj, &Spring::delete_cb, this);
+        m_obj = obj.get();
+        m_prop = prop;
+        m_applied = INT32_MIN;
+        if (m_obj) lv_obj_add_event_cb(m_obj, &Spring::delete_cb, LV_EVENT_DELETE, this);
+        return *this;
+    }
+
+    /// Spring constant (force per unit of distance); higher is snappier
+    Spring& stiffness(float k) noexcept {
+        m_stiffness = k > 0 ? k : m_stiffness;
+        return *this;
+    }
+
+    /// Friction (force per unit of speed); damping^2 >= 4 * stiffness * mass does not overshoot
+    Spring& damping(float c) noexcept {
+        m_damping = c >= 0 ? c : m_damping;
+        return *this;
+    }
+
+    /// Inertia; heavier springs respond and settle more slowly
+    Spring& mass(float m) noexcept {
+        m_mass = m > 0 ? m : m_mass;
+        return *this;
+    }
+
+    /// Distance from the target (in property units) that counts as arrived
+    Spring& precision(float units) noexcept {
+        m_precision = units > 0 ? units : m_precision;
+        return *this;
+    }
+
+    /// Call `(obj->*MemFn)()` whenever the spring comes to rest
+    template<auto MemFn, typename T>
+    Spring& on_settle(T* obj) noexcept {
+        m_settle_ctx = obj;
+        m_on_settle = [](void* ctx) { (static_cast<T*>(ctx)->*MemFn)(); };
+        return *this;
+    }
+
+    // ==================== Motion ====================
+
+    /**
+     * @brief Move towards `target`, keeping the current position and velocity
+     *
+     * Call it as often as needed (e.g. on every touch move); only the
+     * first call after the spring settled resumes the timer.
+     */
+    Spring& to(int32_t target) noexcept {
+        m_target = target;
+        if (m_moving) return *this;
+        if (!m_timer) {
+            m_timer = lv_timer_create(&Spring::timer_cb, LV_DEF_REFR_PERIOD, this);
+            if (!m_timer) return *this;
+        }
+        m_last_tick = lv_tick_get();
+        m_backlog = 0;
+        m_moving = true;
+        lv_timer_resume(m_timer);
+        return *this;
+    }
+
+    /// Move towards `target` starting at `velocity` units per second (a fling)
+    Spring& to(int32_t target, float velocity) noexcept {
+        m_vel = velocity;
+        return to(target);
+    }
+
+    /// Put the spring at `value` at rest and apply it (also retargets; stops motion)
+    Spring& jump(int32_t value) noexcept {
+        m_pos = static_cast<float>(value);
+        m_vel = 0.0f;
+        m_target = value;
+        stop();
+        apply();
+        return *this;
+    }
+
+    /// Stop where it is (no settle callback)
+    void stop() noexcept {
+        m_moving = false;
+        if (m_timer) lv_timer_pause(m_timer);
+    }
+
+    // ==================== State ====================
+
+    [[nodiscard]] bool moving() const noexcept { return m_moving; }
+    [[nodiscard]] int32_t target() const noexcept { return m_target; }
+    [[nodiscard]] float position() const noexcept { return m_pos; }
+    [[nodiscard]] float velocity() const noexcept { return m_vel; }
+    [[nodiscard]] int32_t value() const noexcept {
+        return static_cast<int32_t>(m_pos < 0 ? m_pos - 0.5f : m_pos + 0.5f);
+    }
+
+    [[nodiscard]] const Stats& stats() const noexcept { return m_stats; }
+    void reset_stats() noexcept { m_stats = {}; }
+};
+
+} // namespace lv
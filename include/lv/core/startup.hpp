@@ -0,0 +1,228 @@
+#pragma once
+
+/**
+ * @file startup.hpp
+ * @brief Boot timeline: when init, theme, fonts, first mount and first flush happened
+ *
+ * Boot-to-first-pixel is spread over lv::init(), display setup, font
+ * loading, the first Component::mount() and the first refresh. lv::startup
+ * records one timestamp per phase (microseconds, steady clock) so the
+ * time can be attributed:
+ *
+ * @code
+ * int main() {
+ *     lv::startup::begin();                          // t = 0
+ *     auto splash = lv::splash::show_fbdev("/dev/fb0", boot_logo);  // marks Phase::splash
+ *     lv::init();                                    // marks Phase::init
+ *     lv::FBDisplay disp("/dev/fb0");
+ *     lv::startup::watch(disp);                      // first render and flush
+ *     lv::startup::mark(lv::startup::Phase::display);
+ *     load_fonts();
+ *     lv::startup::mark(lv::startup::Phase::fonts);
+ *     app.mount(lv::screen_active());                // marks Phase::mount (first mount only)
+ *     lv::run();                                     // first_render, first_flush; then log()
+ * }
+ * @endcode
+ *
+ * lv::init() and the first Component::mount() mark their phases
+ * themselves. Every phase is recorded once, the first time it is marked.
+ * Custom steps go in as named marks (LV_CPP_STARTUP_MARKS of them); a
+ * Span also records how long its step took (LazyFont and LazyImage time
+ * their loading this way). Without begin() the first mark is t = 0.
+ *
+ * Heap allocation: NONE
+ */
+
+#include <lvgl.h>
+#include <chrono>
+#include <cstdint>
+
+#ifndef LV_CPP_STARTUP_MARKS
+/// Named marks recorded besides the fixed phases
+#define LV_CPP_STARTUP_MARKS 8
+#endif
+
+namespace lv::startup {
+
+enum class Phase : uint8_t {
+    splash,         ///< Splash image on screen
+    init,           ///< lv::init() returned
+    display,        ///< Display created
+    theme,          ///< Theme applied
+    fonts,          ///< Fonts loaded
+    mount,          ///< First Component::mount() returned
+    first_render,   ///< First refresh rendered
+    first_flush,    ///< First refresh on the panel (flush finished)
+    count_
+};
+
+inline constexpr uint32_t phase_count = static_cast<uint32_t>(Phase::count_);
+
+[[nodiscard]] inline const char* name(Phase p) noexcept {
+    static constexpr const char* names[phase_count] = {
+        "splash", "init", "display", "theme", "fonts", "mount", "first_render", "first_flush"};
+    return p < Phase::count_ ? names[static_cast<uint32_t>(p)] : "?";
+}
+
+/// One entry of the timeline
+struct Mark {
+    const char* name;
+    uint64_t us;            ///< Since begin() (end of the step for spans)
+    uint32_t took_us = 0;   ///< Duration of a Span, 0 for plain marks
+};
+
+namespace detail {
+
+struct Timeline {
+    uint64_t origin = 0;                         ///< steady clock at begin() (0: not begun)
+    uint64_t phases[phase_count] = {};           ///< 0: not reached (times are stored +1)
+    Mark marks[LV_CPP_STARTUP_MARKS] = {};
+    uint32_t mark_count = 0;
+    uint32_t dropped = 0;                        ///< Marks past LV_CPP_STARTUP_MARKS
+    lv_display_t* watched = nullptr;
+};
+
+[[nodiscard]] inline Timeline& timeline() noexcept {
+    static Timeline t;
+    return t;
+}
+
+[[nodiscard]] inline uint64_t now_us() noexcept {
+    using namespace std::chrono;
+    return static_cast<uint64_t>(duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+[[nodiscard]] inline uint64_t elapsed() noexcept {
+    Timeline& t = timeline();
+    const uint64_t now = now_us();
+    if (!t.origin) t.origin = now;
+    return now - t.origin;
+}
+
+inline void unwatch(lv_display_t* disp) noexcept;
+
+inline void render_ready_cb(lv_event_t*) noexcept;
+
+inline void flush_finish_cb(lv_event_t* e) noexcept;
+
+} // namespace detail
+
+/// Start the clock (t = 0); call first thing in main()
+inline void begin() noexcept {
+    detail::Timeline& t = detail::timeline();
+    t = detail::Timeline{};
+    t.origin = detail::now_us();
+}
+
+/// Record `p` now, unless it was recorded already
+inline void mark(Phase p) noexcept {
+    uint64_t& slot = detail::timeline().phases[static_cast<uint32_t>(p)];
+    if (!slot) slot = detail::elapsed() + 1;
+}
+
+/// Record a named step that took `took_us` and ends now (the string must outlive the timeline)
+inline void mark(const char* step, uint32_t took_us = 0) noexcept {
+    detail::Timeline& t = detail::timeline();
+    if (t.mark_count == LV_CPP_STARTUP_MARKS) {
+        if (t.dropped++ == 0) LV_LOG_WARN("startup marks exhausted, raise LV_CPP_STARTUP_MARKS");
+        return;
+    }
+    t.marks[t.mark_count++] = Mark{step, detail::elapsed(), took_us};
+}
+
+/**
+ * @brief Times a step from construction to destruction and records it as a mark
+ *
+ * @code
+ * { lv::startup::Span s("load config"); load_config(); }
+ * @endcode
+ */
+class Span {
+    const char* m_step;
+    uint64_t m_start;
+
+public:
+    explicit Span(const char* step) noexcept : m_step(step), m_start(detail::now_us()) {}
+    ~Span() { mark(m_step, static_cast<uint32_t>(detail::now_us() - m_start)); }
+
+    Span(const Span&) = delete;
+    Span& operator=(const Span&) = delete;
+};
+
+/// Microseconds from begin() to `p` (-1 if not reached)
+[[nodiscard]] inline int64_t at(Phase p) noexcept {
+    const uint64_t v = detail::timeline().phases[static_cast<uint32_t>(p)];
+    return v ? static_cast<int64_t>(v - 1) : -1;
+}
+
+[[nodiscard]] inline bool reached(Phase p) noexcept { return at(p) >= 0; }
+
+/// Mark first_render and first_flush from `disp`'s first refresh (the hooks remove themselves)
+inline void watch(lv_display_t* disp) noexcept {
+    detail::Timeline& t = detail::timeline();
+    if (!disp || t.watched) return;
+    t.watched = disp;
+    lv_display_add_event_cb(disp, &detail::render_ready_cb, LV_EVENT_RENDER_READY, nullptr);
+    lv_display_add_event_cb(disp, &detail::flush_finish_cb, LV_EVENT_FLUSH_FINISH, nullptr);
+}
+
+/**
+ * @brief Phases and named marks in time order
+ * @return Entries written to `out` (at most `max`)
+ */
+inline uint32_t report(Mark* out, uint32_t max) noexcept {
+    const detail::Timeline& t = detail::timeline();
+    uint32_t n = 0;
+    auto insert = [&](Mark m) {
+        uint32_t pos = n;
+        while (pos > 0 && out[pos - 1].us > m.us) {
+            if (pos < max) out[pos] = out[pos - 1];
+            --pos;
+        }
+        if (pos < max) out[pos] = m;
+        if (n < max) ++n;
+    };
+    for (uint32_t i = 0; i < phase_count; ++i) {
+        if (t.phases[i]) insert(Mark{name(static_cast<Phase>(i)), t.phases[i] - 1});
+    }
+    for (uint32_t i = 0; i < t.mark_count; ++i) insert(t.marks[i]);
+    return n;
+}
+
+/// LV_LOG_USER the timeline: time since begin() and since the previous entry (spans: their duration)
+inline void log() noexcept {
+    Mark m[phase_count + LV_CPP_STARTUP_MARKS];
+    const uint32_t n = report(m, phase_count + LV_CPP_STARTUP_MARKS);
+    uint64_t prev = 0;
+    for (uint32_t i = 0; i < n; ++i) {
+        const uint64_t step = m[i].took_us ? m[i].took_us : m[i].us - prev;
+        LV_LOG_USER("startup %-14s %7u.%03u ms  (%c%u.%03u)", m[i].name,
+                    static_cast<unsigned>(m[i].us / 1000), static_cast<unsigned>(m[i].us % 1000),
+                    m[i].took_us ? '=' : '+', static_cast<unsigned>(step / 1000), static_cast<unsigned>(step % 1000));
+        prev = m[i].us;
+    }
+    (void)prev;
+}
+
+namespace detail {
+
+inline void unwatch(lv_display_t* disp) noexcept {
+    lv_display_remove_event_cb_with_user_data(disp, &render_ready_cb, nullptr);
+    lv_display_remove_event_cb_with_user_data(disp, &flush_finish_cb, nullptr);
+    timeline().watched = nullptr;
+}
+
+inline void render_ready_cb(lv_event_t*) noexcept {
+    mark(Phase::first_render);
+}
+
+inline void flush_finish_cb(lv_event_t* e) noexcept {
+    mark(Phase::first_render);
+    mark(Phase::first_flush);
+    // LVGL defers removing descriptors of the list it is traversing
+    unwatch(static_cast<lv_display_t*>(lv_event_get_current_target(e)));
+}
+
+} // namespace detail
+
+} // namespace lv::startup
@@ -6,18 +6,369 @@
  *
  * State<T> wraps lv_subject_t for reactive updates without heap allocation.
  * The subject is embedded in the State object (stack-allocated when State is on stack).
+ *
+ * Batched updates (observers fire once per state, not once per set()):
+ * @code
+ * {
+ *     lv::StateBatch batch;
+ *     rpm.set(frame.rpm);
+ *     temp.set(frame.temp);
+ *     rpm.set(frame.rpm2);     // rpm observers still fire only once
+ * }                            // notified here
+ *
+ * speed.set_deferred(v);       // notified on the next lv_timer_handler() pass
+ * @endcode
+ *
+ * Subject per value type: integers up to 32 bits, pointers and lv_color_t
+ * use LVGL's own subjects, and so does float when LVGL has float subjects
+ * (LV_USE_FLOAT, 9.3+). Wider or other trivially copyable types (int64_t,
+ * double, structs) use a pointer subject pointing at the stored value.
+ * set() skips values equal to the current one for all of them, comparing
+ * with operator== where the type has one or bytewise where that is exact.
+ * StringState<N> keeps a string inline in LVGL's string subject.
+ *
+ * Worker threads (LV_CPP_STATE_ANY_THREAD=1, CMake -DLV_CPP_STATE_ANY_THREAD=ON):
+ * @code
+ * void telemetry_thread() {
+ *     for (;;) rpm.set_from_any_thread(read_rpm());    // no lock, no allocation
+ * }
+ * @endcode
+ *
+ * Throttled observers (at most one delivery per interval, latest value wins):
+ * @code
+ * using namespace std::chrono_literals;
+ * rpm.observe<&Gauge::on_rpm>(&gauge, lv::throttle{16ms});
+ * label.bind_text(rpm, "%d rpm", lv::throttle{16ms});
+ * @endcode
  */
 
 #include <lvgl.h>
+#include <chrono>
+#include <concepts>
 #include <type_traits>
 #include <cstdint>
 #include <cstring>
+#include <utility>
+#include "async.hpp"
+#include "callback.hpp"
+#include "thread.hpp"
+#include "profiler.hpp"
+#include "subscription.hpp"
+#include "text_cache.hpp"
+#include "version.hpp"
+#include <cstdarg>
 
 // Only available if LVGL observer is enabled
 #if LV_USE_OBSERVER
 
+#ifndef LV_CPP_STATE_ANY_THREAD
+/// Give State<T> set_from_any_thread() (adds a pending-list link and a value slot to every State)
+#define LV_CPP_STATE_ANY_THREAD 0
+#endif
+
+#if LV_USE_FLOAT && LV_VERSION_AT_LEAST(9, 3, 0)
+/// LVGL has float subjects (State<float> uses one instead of a pointer subject)
+#define LV_CPP_FLOAT_SUBJECTS 1
+#else
+#define LV_CPP_FLOAT_SUBJECTS 0
+#endif
+
 namespace lv {
 
+// ==================== Deferred Notification ====================
+
+namespace detail {
+
+/**
+ * Intrusive list of subjects with pending notifications.
+ *
+ * The link is stored in lv_subject_t::user_data, which State<T> owns, so
+ * deferring costs no extra bytes per State. nullptr = clean; the list is
+ * terminated by dirty_end() so the last dirty subject is non-null too.
+ */
+struct DirtyStates {
+    void* head = nullptr;
+    uint32_t depth = 0;       ///< Nesting level of active StateBatch scopes
+    bool scheduled = false;   ///< Flush timer pending
+};
+
+[[nodiscard]] inline DirtyStates& dirty_states() noexcept {
+    static DirtyStates states;
+    return states;
+}
+
+[[nodiscard]] inline void* dirty_end() noexcept {
+    static char end;
+    return &end;
+}
+
+[[nodiscard]] inline bool is_dirty(const lv_subject_t* subject) noexcept {
+    return subject->user_data != nullptr;
+}
+
+/// Notify every dirty subject once, in most-recently-dirtied order
+inline void flush_dirty_states() noexcept {
+    LV_PROFILE_SCOPE("lv::State deferred notify");
+    DirtyStates& d = dirty_states();
+    while (d.head && d.head != dirty_end()) {
+        auto* subject = static_cast<lv_subject_t*>(d.head);
+        d.head = subject->user_data;
+        subject->user_data = nullptr;
+        lv_subject_notify(subject);
+    }
+    d.head = nullptr;
+}
+
+inline void flush_timer_cb(lv_timer_t*) noexcept {
+    dirty_states().scheduled = false;
+    if (dirty_states().depth == 0) flush_dirty_states();
+}
+
+/// Queue a subject for notification (no-op if already queued)
+inline void mark_dirty(lv_subject_t* subject) noexcept {
+    DirtyStates& d = dirty_states();
+    if (!is_dirty(subject)) {
+        subject->user_data = d.head ? d.head : dirty_end();
+        d.head = subject;
+    }
+    if (d.depth > 0 || d.scheduled) return;
+    // Outside a batch: flush once on the next timer pass (one-shot, auto-deleted)
+    lv_timer_t* t = lv_timer_create(&flush_timer_cb, 0, nullptr);
+    if (!t) {
+        flush_dirty_states();
+        return;
+    }
+    lv_timer_set_repeat_count(t, 1);
+    d.scheduled = true;
+}
+
+/// Remove a subject from the dirty list (State destroyed while pending)
+inline void unmark_dirty(lv_subject_t* subject) noexcept {
+    if (!is_dirty(subject)) return;
+    void** link = &dirty_states().head;
+    while (*link && *link != dirty_end()) {
+        auto* s = static_cast<lv_subject_t*>(*link);
+        if (s == subject) {
+            *link = s->user_data;
+            break;
+        }
+        link = &s->user_data;
+    }
+    subject->user_data = nullptr;
+}
+
+#if LV_CPP_STATE_ANY_THREAD
+/// Latest value written by worker threads: a plain atomic where lock-free
+template<typename T, bool = std::atomic<T>::is_always_lock_free>
+struct SharedValue {
+    std::atomic<T> value{};
+
+    void store(const T& v) noexcept { value.store(v); }
+    [[nodiscard]] T load() const noexcept { return value.load(); }
+};
+
+/// Seqlock for larger types: writers serialise on an odd sequence, the reader retries on a torn copy
+template<typename T>
+struct SharedValue<T, false> {
+    std::atomic<uint32_t> seq{0};
+    T value{};
+
+    void store(const T& v) noexcept {
+        uint32_t s = seq.load(std::memory_order_relaxed);
+        for (;;) {
+            if (s & 1) {
+                s = seq.load(std::memory_order_relaxed);
+            } else if (seq.compare_exchange_weak(s, s + 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(static_cast<void*>(&value), &v, sizeof(T));
+        seq.store(s + 2, std::memory_order_release);
+    }
+
+    [[nodiscard]] T load() const noexcept {
+        T out{};
+        for (;;) {
+            const uint32_t s = seq.load(std::memory_order_acquire);
+            if (s & 1) continue;
+            std::memcpy(static_cast<void*>(&out), &value, sizeof(T));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq.load(std::memory_order_relaxed) == s) return out;
+        }
+    }
+};
+#endif
+
+} // namespace detail
+
+// ==================== Throttled Observers ====================
+
+#ifndef LV_CPP_MAX_THROTTLES
+/// Maximum number of simultaneously throttled observers
+#define LV_CPP_MAX_THROTTLES 16
+#endif
+
+/**
+ * @brief Minimum interval between deliveries of a throttled observer
+ *
+ * Accepts milliseconds or any std::chrono duration: `lv::throttle{16ms}`.
+ */
+struct throttle {
+    uint32_t ms;
+
+    constexpr explicit throttle(uint32_t interval_ms) noexcept : ms(interval_ms) {}
+
+    template<typename Rep, typename Period>
+    constexpr throttle(std::chrono::duration<Rep, Period> interval) noexcept
+        : ms(static_cast<uint32_t>(
+              std::chrono::duration_cast<std::chrono::milliseconds>(interval).count())) {}
+};
+
+namespace detail {
+
+/**
+ * One throttled observer. The first change after an idle interval is
+ * delivered immediately; later changes only set `pending`, and the timer
+ * delivers the latest value at the end of the interval (trailing edge).
+ * The timer pauses itself after an interval without changes.
+ */
+struct ThrottleSlot {
+    lv_subject_t* subject = nullptr;   ///< nullptr = free slot
+    lv_observer_t* observer = nullptr;
+    lv_timer_t* timer = nullptr;
+    void* target = nullptr;
+    lv_obj_t* owner = nullptr;         ///< Object whose deletion releases the slot
+    const char* fmt = nullptr;
+    void (*deliver)(ThrottleSlot& slot) noexcept = nullptr;
+    bool pending = false;
+    bool suspended = false;            ///< Owner not visible (core/visibility.hpp): changes stay pending
+};
+
+[[nodiscard]] inline ThrottleSlot* throttle_slots() noexcept {
+    static ThrottleSlot slots[LV_CPP_MAX_THROTTLES];
+    return slots;
+}
+
+inline void throttle_timer_cb(lv_timer_t* t) noexcept {
+    auto* slot = static_cast<ThrottleSlot*>(lv_timer_get_user_data(t));
+    if (slot->pending && !slot->suspended) {
+        slot->pending = false;
+        slot->deliver(*slot);
+    } else {
+        lv_timer_pause(t);
+    }
+}
+
+inline void throttle_observer_cb(lv_observer_t* observer, lv_subject_t*) noexcept {
+    auto* slot = static_cast<ThrottleSlot*>(lv_observer_get_user_data(observer));
+    if (slot->suspended) {
+        slot->pending = true;
+    } else if (lv_timer_get_paused(slot->timer)) {
+        slot->deliver(*slot);
+        lv_timer_reset(slot->timer);
+        lv_timer_resume(slot->timer);
+    } else {
+        slot->pending = true;
+    }
+}
+
+/// Reserve a slot and its (paused) interval timer; nullptr if the pool is exhausted
+[[nodiscard]] inline ThrottleSlot* acquire_throttle(lv_subject_t* subject, uint32_t ms) noexcept {
+    ThrottleSlot* slots = throttle_slots();
+    for (size_t i = 0; i < LV_CPP_MAX_THROTTLES; ++i) {
+        ThrottleSlot& slot = slots[i];
+        if (slot.subject) continue;
+        slot.timer = lv_timer_create(&throttle_timer_cb, ms > 0 ? ms : 1, &slot);
+        if (!slot.timer) return nullptr;
+        lv_timer_pause(slot.timer);
+        slot.subject = subject;
+        slot.pending = false;
+        return &slot;
+    }
+    return nullptr;
+}
+
+inline void throttle_target_deleted_cb(lv_event_t* e) noexcept;
+
+inline void release_throttle(ThrottleSlot& slot) noexcept {
+    if (slot.owner) {
+        lv_obj_remove_event_cb_with_user_data(slot.owner, &throttle_target_deleted_cb, &slot);
+    }
+    if (slot.timer) lv_timer_delete(slot.timer);
+    slot = ThrottleSlot{};
+}
+
+/// Release every throttle slot observing `subject` (called before lv_subject_deinit)
+inline void release_throttles(lv_subject_t* subject) noexcept {
+    ThrottleSlot* slots = throttle_slots();
+    for (size_t i = 0; i < LV_CPP_MAX_THROTTLES; ++i) {
+        if (slots[i].subject == subject) release_throttle(slots[i]);
+    }
+}
+
+/**
+ * Hold (or deliver the pending value of) every throttled observer bound to
+ * `root` or an object below it
+ */
+inline void suspend_throttles(lv_obj_t* root, bool suspended) noexcept {
+    ThrottleSlot* slots = throttle_slots();
+    for (size_t i = 0; i < LV_CPP_MAX_THROTTLES; ++i) {
+        ThrottleSlot& slot = slots[i];
+        if (!slot.subject || slot.suspended == suspended) continue;
+        lv_obj_t* o = slot.owner;
+        while (o && o != root) o = lv_obj_get_parent(o);
+        if (!o) continue;
+        slot.suspended = suspended;
+        if (!suspended && slot.pending) {
+            slot.pending = false;
+            slot.deliver(slot);
+            lv_timer_reset(slot.timer);
+            lv_timer_resume(slot.timer);
+        }
+    }
+}
+
+/// Release the slot of an object-bound throttled observer when the object is deleted
+inline void throttle_target_deleted_cb(lv_event_t* e) noexcept {
+    auto* slot = static_cast<ThrottleSlot*>(lv_event_get_user_data(e));
+    slot->owner = nullptr;    // the object is going away with its event list
+    release_throttle(*slot);
+}
+
+} // namespace detail
+
+/**
+ * @brief RAII scope that coalesces State<T> notifications
+ *
+ * While at least one StateBatch is alive, State::set() and State::notify()
+ * only record the new value and mark the state dirty. When the outermost
+ * batch ends, each dirty state notifies its observers exactly once with
+ * its latest value. Scopes nest; no heap allocation.
+ *
+ * Must be used on the LVGL thread (like State itself).
+ */
+class StateBatch {
+public:
+    StateBatch() noexcept { ++detail::dirty_states().depth; }
+
+    ~StateBatch() {
+        if (--detail::dirty_states().depth == 0) {
+            detail::flush_dirty_states();
+        }
+    }
+
+    StateBatch(const StateBatch&) = delete;
+    StateBatch& operator=(const StateBatch&) = delete;
+    StateBatch(StateBatch&&) = delete;
+    StateBatch& operator=(StateBatch&&) = delete;
+};
+
+/// Notify all deferred states now (instead of waiting for the next timer pass)
+inline void flush_states() noexcept {
+    detail::flush_dirty_states();
+}
+
 /**
  * @brief Reactive state container (stack-allocated)
  *
@@ -25,9 +376,11 @@ namespace lv {
  * When state changes, all bound widgets automatically update.
  *
  * Size: sizeof(lv_subject_t) + sizeof(T) - approximately 48-56 bytes
+ * (plus a pending-list link and a second T with LV_CPP_STATE_ANY_THREAD)
  * Heap allocation: NONE
  *
- * @tparam T Value type (int32_t, lv_color_t, pointer types supported)
+ * @tparam T Value type: integers, float, double, lv_color_t, pointers or
+ *           other trivially copyable types
  */
 template<typename T>
 class State {
@@ -37,6 +390,15 @@ class State {
 private:
     lv_subject_t m_subject;
     T m_value;
+#if LV_CPP_STATE_ANY_THREAD
+    detail::PendingNode m_pending;
+    detail::SharedValue<T> m_incoming;
+
+    static void apply_incoming(detail::PendingNode* node) noexcept {
+        auto* self = static_cast<State*>(node->owner);
+        self->set(self->m_incoming.load());
+    }
+#endif
 
     // Type-specific initialization
     void init_subject() noexcept {
@@ -46,10 +408,15 @@ private:
             lv_subject_init_pointer(&m_subject, static_cast<void*>(m_value));
         } else if constexpr (std::is_same_v<T, lv_color_t>) {
             lv_subject_init_color(&m_subject, m_value);
+#if LV_CPP_FLOAT_SUBJECTS
+        } else if constexpr (std::is_same_v<T, float>) {
+            lv_subject_init_float(&m_subject, m_value);
+#endif
         } else {
             // Generic: use pointer to value
             lv_subject_init_pointer(&m_subject, &m_value);
         }
+        m_subject.user_data = nullptr;    // dirty-list link, see detail::DirtyStates
     }
 
     // Type-specific update
@@ -60,21 +427,109 @@ private:
             lv_subject_set_pointer(&m_subject, static_cast<void*>(m_value));
         } else if constexpr (std::is_same_v<T, lv_color_t>) {
             lv_subject_set_color(&m_subject, m_value);
+#if LV_CPP_FLOAT_SUBJECTS
+        } else if constexpr (std::is_same_v<T, float>) {
+            lv_subject_set_float(&m_subject, m_value);
+#endif
         } else {
             // Notify observers (value changed in place)
             lv_subject_notify(&m_subject);
         }
     }
 
+    // Store the value in the subject without notifying, then queue a notification
+    void defer_subject() noexcept {
+        const bool first = !detail::is_dirty(&m_subject);
+        if constexpr (std::is_integral_v<T> && sizeof(T) <= sizeof(int32_t)) {
+            if (first) m_subject.prev_value.num = m_subject.value.num;
+            m_subject.value.num = static_cast<int32_t>(m_value);
+        } else if constexpr (std::is_pointer_v<T>) {
+            if (first) m_subject.prev_value.pointer = m_subject.value.pointer;
+            m_subject.value.pointer = static_cast<const void*>(m_value);
+        } else if constexpr (std::is_same_v<T, lv_color_t>) {
+            if (first) m_subject.prev_value.color = m_subject.value.color;
+            m_subject.value.color = m_value;
+#if LV_CPP_FLOAT_SUBJECTS
+        } else if constexpr (std::is_same_v<T, float>) {
+            if (first) m_subject.prev_value.float_v = m_subject.value.float_v;
+            m_subject.value.float_v = m_value;
+#endif
+        }
+        // Generic types: the subject already points at m_value
+        detail::mark_dirty(&m_subject);
+    }
+
+    void publish() noexcept {
+        LV_PROFILE_FUNCTION();
+        // Already queued: fold into the pending notification
+        if (detail::dirty_states().depth > 0 || detail::is_dirty(&m_subject)) {
+            defer_subject();
+        } else {
+            update_subject();
+        }
+    }
+
+    // Read the current value from a subject initialised by init_subject()
+    [[nodiscard]] static T value_of(lv_subject_t* subject) noexcept {
+        if constexpr (std::is_integral_v<T> && sizeof(T) <= sizeof(int32_t)) {
+            return static_cast<T>(lv_subject_get_int(subject));
+        } else if constexpr (std::is_same_v<T, lv_color_t>) {
+            return lv_subject_get_color(subject);
+        } else if constexpr (std::is_pointer_v<T>) {
+            return static_cast<T>(lv_subject_get_pointer(subject));
+#if LV_CPP_FLOAT_SUBJECTS
+        } else if constexpr (std::is_same_v<T, float>) {
+            return lv_subject_get_float(subject);
+#endif
+        } else {
+            // Fallback for other trivially copyable types stored via pointer
+            // The subject stores a pointer to the value in State::m_value
+            return *static_cast<const T*>(lv_subject_get_pointer(subject));
+        }
+    }
+
+    /// Observer trampoline for pooled capturing callables
+    template<typename F>
+    static void pooled_observer_cb(lv_observer_t* observer, lv_subject_t* subject) noexcept {
+        static_cast<detail::CallbackSlot*>(lv_observer_get_user_data(observer))->as<F>()(value_of(subject));
+    }
+
+    [[nodiscard]] bool changed_to(const T& new_value) const noexcept {
+        if constexpr (std::is_arithmetic_v<T> || std::is_pointer_v<T>) {
+            return m_value != new_value;    // NaN always counts as a change
+        } else if constexpr (std::is_same_v<T, lv_color_t>) {
+            return std::memcmp(&m_value, &new_value, sizeof(lv_color_t)) != 0;
+        } else if constexpr (std::equality_comparable<T>) {
+            return !(m_value == new_value);
+        } else if constexpr (std::has_unique_object_representations_v<T>) {
+            return std::memcmp(&m_value, &new_value, sizeof(T)) != 0;    // no padding: bytes are the value
+        } else {
+            return true;
+        }
+    }
+
 public:
     /// Construct with initial value
     explicit State(T initial = T{}) noexcept : m_value(initial) {
         init_subject();
+#if LV_CPP_STATE_ANY_THREAD
+        m_pending.apply = &State::apply_incoming;
+        m_pending.owner = this;
+#endif
     }
 
     /// Destructor
     ~State() noexcept {
+#if LV_CPP_STATE_ANY_THREAD
+        if (m_pending.queued.load()) detail::drain_pending();    // unlink before the node goes away
+#endif
+        detail::unmark_dirty(&m_subject);
+        detail::release_throttles(&m_subject);
+        detail::release_hub(&m_subject);
         lv_subject_deinit(&m_subject);
+        if constexpr (capturing_callbacks) {
+            detail::release_callbacks(&m_subject);
+        }
     }
 
     // Non-copyable (subjects can't be copied)
@@ -97,28 +552,60 @@ public:
         return m_value;
     }
 
-    /// Set new value (notifies observers if changed)
+    /// Set new value (notifies observers if changed; deferred inside a StateBatch)
     void set(T new_value) noexcept {
-        if constexpr (std::is_integral_v<T> || std::is_pointer_v<T>) {
-            if (m_value != new_value) {
-                m_value = new_value;
-                update_subject();
-            }
-        } else if constexpr (std::is_same_v<T, lv_color_t>) {
-            // Color comparison
-            if (std::memcmp(&m_value, &new_value, sizeof(lv_color_t)) != 0) {
-                m_value = new_value;
-                update_subject();
-            }
-        } else {
+        ui_thread();
+        if (changed_to(new_value)) {
             m_value = new_value;
-            update_subject();
+            publish();
         }
     }
 
+    /**
+     * @brief Set new value and notify once on the next lv_timer_handler() pass
+     *
+     * Repeated calls before the flush coalesce into a single notification
+     * carrying the latest value. Inside a StateBatch, behaves like set().
+     */
+    void set_deferred(T new_value) noexcept {
+        ui_thread();
+        if (changed_to(new_value)) {
+            m_value = new_value;
+            defer_subject();
+        }
+    }
+
+#if LV_CPP_STATE_ANY_THREAD
+    /**
+     * @brief Set the value from any thread, without locking or allocating
+     *
+     * Stores the value (atomically, or under a seqlock for types without
+     * lock-free atomics) and queues the state once on a lock-free pending
+     * list. lv::tick() applies the latest value with set() on the LVGL
+     * thread, so a burst of calls between two ticks notifies at most once,
+     * and not at all if the value ends up unchanged.
+     *
+     * Producer threads must stop calling it before the State is destroyed.
+     */
+    void set_from_any_thread(const T& new_value) noexcept {
+        m_incoming.store(new_value);
+        detail::push_pending(m_pending);
+    }
+#endif
+
+    /// Check whether a deferred notification is pending
+    [[nodiscard]] bool dirty() const noexcept {
+        return detail::is_dirty(&m_subject);
+    }
+
     /// Force notify all observers (even if value unchanged)
     void notify() noexcept {
-        lv_subject_notify(&m_subject);
+        LV_PROFILE_FUNCTION();
+        if (detail::dirty_states().depth > 0 || detail::is_dirty(&m_subject)) {
+            defer_subject();
+        } else {
+            lv_subject_notify(&m_subject);
+        }
     }
 
     // ==================== Modifiers (for numeric types) ====================
@@ -189,8 +676,9 @@ public:
      * Supported types:
      * - Integral types <= 32 bits (int, short, bool, etc.)
      * - lv_color_t
+     * - float (a float subject with LV_USE_FLOAT on LVGL 9.3+)
      * - Pointer types
-     * - Other trivially copyable types (accessed via pointer to stored value)
+     * - Other trivially copyable types, e.g. int64_t, double (accessed via pointer to stored value)
      *
      * @tparam MemFn Pointer to member function void(T) or void(const T&)
      * @param instance Pointer to object instance
@@ -201,21 +689,113 @@ public:
         return lv_subject_add_observer(&m_subject,
             [](lv_observer_t* observer, lv_subject_t* subject) {
                 auto* inst = static_cast<Instance*>(lv_observer_get_user_data(observer));
-                if constexpr (std::is_integral_v<T> && sizeof(T) <= sizeof(int32_t)) {
-                    (inst->*MemFn)(static_cast<T>(lv_subject_get_int(subject)));
-                } else if constexpr (std::is_same_v<T, lv_color_t>) {
-                    (inst->*MemFn)(lv_subject_get_color(subject));
-                } else if constexpr (std::is_pointer_v<T>) {
-                    (inst->*MemFn)(static_cast<T>(lv_subject_get_pointer(subject)));
-                } else {
-                    // Fallback for other trivially copyable types stored via pointer
-                    // The subject stores a pointer to the value in State::m_value
-                    auto* value_ptr = static_cast<const T*>(lv_subject_get_pointer(subject));
-                    (inst->*MemFn)(*value_ptr);
-                }
+                (inst->*MemFn)(value_of(subject));
             }, instance);
     }
 
+    /// Subscription trampoline calling (instance->*MemFn)(value), see Component::subscribe()
+    template<auto MemFn, typename Instance>
+    static void subscriber_cb(void* target, lv_subject_t* subject) noexcept {
+        (static_cast<Instance*>(target)->*MemFn)(value_of(subject));
+    }
+
+    /**
+     * @brief Subscribe a member function, unsubscribed when the handle goes away
+     *
+     * Like observe<MemFn>() but nothing is allocated per subscription and
+     * the returned lv::Subscription removes it when destroyed or reset().
+     * The callback runs once right away with the current value.
+     */
+    template<auto MemFn, typename Instance>
+        requires std::is_member_function_pointer_v<decltype(MemFn)>
+    [[nodiscard]] Subscription subscribe(Instance* instance) noexcept {
+        return Subscription(&m_subject, &State::subscriber_cb<MemFn, Instance>, instance);
+    }
+
+    /**
+     * @brief Add a throttled member function observer
+     *
+     * Delivers at most once per interval, always with the latest value, and
+     * always delivers the final value once changes stop (trailing edge).
+     * Use for sources that change faster than the display refreshes.
+     *
+     * Uses one of LV_CPP_MAX_THROTTLES slots and one lv_timer until the State
+     * is destroyed or the observer is passed to lv::remove_observer(). Falls
+     * back to an unthrottled observer if no slot is available.
+     */
+    template<auto MemFn, typename Instance>
+        requires std::is_member_function_pointer_v<decltype(MemFn)>
+    lv_observer_t* observe(Instance* instance, throttle interval) noexcept {
+        detail::ThrottleSlot* slot = detail::acquire_throttle(&m_subject, interval.ms);
+        if (!slot) return observe<MemFn>(instance);
+        slot->target = instance;
+        slot->deliver = [](detail::ThrottleSlot& s) noexcept {
+            (static_cast<Instance*>(s.target)->*MemFn)(value_of(s.subject));
+        };
+        slot->observer = lv_subject_add_observer(&m_subject, &detail::throttle_observer_cb, slot);
+        return slot->observer;
+    }
+
+#if LV_USE_LABEL
+    /**
+     * @brief Bind a label's text with at most one update per interval
+     *
+     * Backend of Label::bind_text(state, fmt, throttle). The observer and its
+     * throttle slot are released when the label is deleted. Falls back to
+     * an unthrottled binding if no slot is available. Updates that format to
+     * the current text are skipped (text_cache::set_label_text_fmt()).
+     */
+    template<typename U = T>
+        requires (std::is_integral_v<U> && sizeof(U) <= sizeof(int32_t))
+    lv_observer_t* bind_label_text(lv_obj_t* label, const char* fmt, throttle interval) noexcept {
+        detail::ThrottleSlot* slot = detail::acquire_throttle(&m_subject, interval.ms);
+        if (!slot) return text_cache::bind_label_int_text(label, &m_subject, fmt);
+        slot->target = label;
+        slot->owner = label;
+        slot->fmt = fmt;
+        slot->deliver = [](detail::ThrottleSlot& s) noexcept {
+            text_cache::set_label_text_fmt(static_cast<lv_obj_t*>(s.target), s.fmt,
+                                           static_cast<int>(lv_subject_get_int(s.subject)));
+        };
+        lv_obj_add_event_cb(label, &detail::throttle_target_deleted_cb, LV_EVENT_DELETE, slot);
+        slot->observer = lv_subject_add_observer_obj(&m_subject, &detail::throttle_observer_cb,
+                                                     label, slot);
+        return slot->observer;
+    }
+#endif
+
+    /**
+     * @brief Add capturing observer fn(T) (LV_CPP_USE_STD_FUNCTION mode)
+     *
+     * The callable lives in a callback pool slot until the State is
+     * destroyed. Returns nullptr if the pool is exhausted.
+     */
+    template<typename F>
+        requires (capturing_callbacks && !std::is_convertible_v<F, lv_observer_cb_t> &&
+                  std::is_invocable_v<std::decay_t<F>&, T>)
+    lv_observer_t* observe(F&& fn) noexcept {
+        detail::CallbackSlot* slot = detail::acquire_callback(std::forward<F>(fn), &m_subject);
+        if (!slot) return nullptr;
+        return lv_subject_add_observer(&m_subject, &State::pooled_observer_cb<std::decay_t<F>>, slot);
+    }
+
+    /**
+     * @brief Add capturing observer fn(T) tied to an object (LV_CPP_USE_STD_FUNCTION mode)
+     *
+     * Observer and pool slot are released when target_obj is deleted.
+     * Returns nullptr if the pool is exhausted.
+     */
+    template<typename F>
+        requires (capturing_callbacks && !std::is_convertible_v<F, lv_observer_cb_t> &&
+                  std::is_invocable_v<std::decay_t<F>&, T>)
+    lv_observer_t* observe_obj(lv_obj_t* target_obj, F&& fn) noexcept {
+        detail::CallbackSlot* slot = detail::acquire_callback(std::forward<F>(fn));
+        if (!slot) return nullptr;
+        lv_obj_add_event_cb(target_obj, &detail::callback_delete_cb, LV_EVENT_DELETE, slot);
+        return lv_subject_add_observer_obj(&m_subject, &State::pooled_observer_cb<std::decay_t<F>>,
+                                           target_obj, slot);
+    }
+
     /**
      * @brief Add observer with C-style callback
      *
@@ -266,19 +846,183 @@ using BoolState = State<bool>;
 /// Color state
 using ColorState = State<lv_color_t>;
 
+/// Float state (LVGL float subject where available)
+using FloatState = State<float>;
+
 // ==================== Zero-Cost Verification ====================
 
 // Static assertions to verify State<T> overhead is minimal
 // State must be exactly lv_subject_t + T (no vtable, no extra padding beyond alignment)
+#if !LV_CPP_STATE_ANY_THREAD
 static_assert(sizeof(IntState) <= sizeof(lv_subject_t) + sizeof(int32_t) + alignof(lv_subject_t),
     "IntState should have minimal overhead over lv_subject_t + value");
 static_assert(sizeof(BoolState) <= sizeof(lv_subject_t) + sizeof(bool) + alignof(lv_subject_t),
     "BoolState should have minimal overhead over lv_subject_t + value");
 static_assert(sizeof(ColorState) <= sizeof(lv_subject_t) + sizeof(lv_color_t) + alignof(lv_subject_t),
     "ColorState should have minimal overhead over lv_subject_t + value");
+#endif
+
+// ==================== String State ====================
+
+/**
+ * @brief Reactive string with inline storage (LVGL string subject)
+ *
+ * The text and LVGL's copy of the previous text live in two N-byte
+ * arrays inside the object, so set() never allocates. Longer texts are
+ * cut to N - 1 characters. set() and format() skip texts equal to the
+ * current one, and batch like State<T> inside a StateBatch.
+ *
+ * @code
+ * static lv::StringState<32> status("idle");
+ * label.bind_text(status);                      // label shows status' buffer, no copy
+ * status.format("%u files left", n);
+ * @endcode
+ *
+ * Heap allocation: NONE
+ */
+template<size_t N>
+class StringState {
+    static_assert(N > 1, "StringState needs room for a character and the terminator");
+
+    lv_subject_t m_subject;
+    char m_buf[N];
+    char m_prev[N];
+
+    [[nodiscard]] bool changed_to(const char* text) const noexcept {
+        return std::strncmp(m_buf, text, N - 1) != 0;
+    }
+
+    void store(const char* text) noexcept {
+        size_t n = 0;
+        for (; n + 1 < N && text[n]; ++n) m_buf[n] = text[n];
+        m_buf[n] = '\0';
+    }
+
+    void publish(const char* text) noexcept {
+        if (detail::dirty_states().depth > 0 || detail::is_dirty(&m_subject)) {
+            if (!detail::is_dirty(&m_subject)) std::memcpy(m_prev, m_buf, N);
+            store(text);
+            detail::mark_dirty(&m_subject);
+        } else {
+            lv_subject_copy_string(&m_subject, text);
+        }
+    }
+
+public:
+    explicit StringState(const char* initial = "") noexcept {
+        lv_subject_init_string(&m_subject, m_buf, m_prev, N, initial ? initial : "");
+        m_subject.user_data = nullptr;    // dirty-list link, see detail::DirtyStates
+    }
+
+    ~StringState() noexcept {
+        detail::unmark_dirty(&m_subject);
+        detail::release_throttles(&m_subject);
+        detail::release_hub(&m_subject);
+        lv_subject_deinit(&m_subject);
+        if constexpr (capturing_callbacks) {
+            detail::release_callbacks(&m_subject);
+        }
+    }
+
+    StringState(const StringState&) = delete;
+    StringState& operator=(const StringState&) = delete;
+    StringState(StringState&&) = delete;
+    StringState& operator=(StringState&&) = delete;
+
+    /// Current text (stays valid and at the same address for the lifetime of the state)
+    [[nodiscard]] const char* get() const noexcept { return m_buf; }
+
+    [[nodiscard]] operator const char*() const noexcept { return m_buf; }
+
+    /// Longest text kept
+    [[nodiscard]] static constexpr size_t capacity() noexcept { return N - 1; }
+
+    /// Set new text (notifies observers if changed; deferred inside a StateBatch)
+    void set(const char* text) noexcept {
+        ui_thread();
+        if (!text) text = "";
+        if (changed_to(text)) publish(text);
+    }
+
+    /// Set text from a printf format (formatted on the stack, notifies if changed)
+    void format(const char* fmt, ...) noexcept {
+        char text[N];
+        va_list args;
+        va_start(args, fmt);
+        lv_vsnprintf(text, N, fmt, args);
+        va_end(args);
+        set(text);
+    }
+
+    /// Set text and notify once on the next lv_timer_handler() pass
+    void set_deferred(const char* text) noexcept {
+        ui_thread();
+        if (!text) text = "";
+        if (!changed_to(text)) return;
+        if (!detail::is_dirty(&m_subject)) std::memcpy(m_prev, m_buf, N);
+        store(text);
+        detail::mark_dirty(&m_subject);
+    }
+
+    [[nodiscard]] bool dirty() const noexcept { return detail::is_dirty(&m_subject); }
+
+    /// Force notify all observers (even if the text is unchanged)
+    void notify() noexcept {
+        if (detail::dirty_states().depth > 0 || detail::is_dirty(&m_subject)) {
+            detail::mark_dirty(&m_subject);
+        } else {
+            lv_subject_notify(&m_subject);
+        }
+    }
+
+    [[nodiscard]] lv_subject_t* subject() noexcept { return &m_subject; }
+    [[nodiscard]] const lv_subject_t* subject() const noexcept { return &m_subject; }
+
+    /// Add observer with member function callback void(const char*) (zero-allocation)
+    template<auto MemFn, typename Instance>
+        requires std::is_member_function_pointer_v<decltype(MemFn)>
+    lv_observer_t* observe(Instance* instance) noexcept {
+        return lv_subject_add_observer(&m_subject,
+            [](lv_observer_t* observer, lv_subject_t* subject) {
+                auto* inst = static_cast<Instance*>(lv_observer_get_user_data(observer));
+                (inst->*MemFn)(lv_subject_get_string(subject));
+            }, instance);
+    }
+
+    template<auto MemFn, typename Instance>
+    static void subscriber_cb(void* target, lv_subject_t* subject) noexcept {
+        (static_cast<Instance*>(target)->*MemFn)(lv_subject_get_string(subject));
+    }
+
+    /// Subscribe a member function void(const char*) (see State::subscribe)
+    template<auto MemFn, typename Instance>
+        requires std::is_member_function_pointer_v<decltype(MemFn)>
+    [[nodiscard]] Subscription subscribe(Instance* instance) noexcept {
+        return Subscription(&m_subject, &StringState::subscriber_cb<MemFn, Instance>, instance);
+    }
+
+    lv_observer_t* observe_raw(lv_observer_cb_t cb, void* user_data = nullptr) noexcept {
+        return lv_subject_add_observer(&m_subject, cb, user_data);
+    }
+
+    lv_observer_t* observe_obj(lv_observer_cb_t cb, lv_obj_t* target_obj, void* user_data = nullptr) noexcept {
+        return lv_subject_add_observer_obj(&m_subject, cb, target_obj, user_data);
+    }
+};
 
 // ==================== Observer Helper Functions ====================
 
+/// Remove an observer, releasing its throttle slot if it was created with lv::throttle
+inline void remove_observer(lv_observer_t* observer) noexcept {
+    detail::ThrottleSlot* slots = detail::throttle_slots();
+    for (size_t i = 0; i < LV_CPP_MAX_THROTTLES; ++i) {
+        if (slots[i].subject && slots[i].observer == observer) {
+            detail::release_throttle(slots[i]);
+        }
+    }
+    lv_observer_remove(observer);
+}
+
 /// Get target object from observer (for use in observer callbacks)
 [[nodiscard]] inline lv_obj_t* observer_get_target_obj(lv_observer_t* observer) noexcept {
     return lv_observer_get_target_obj(observer);
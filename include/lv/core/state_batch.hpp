@@ -0,0 +1,99 @@
+#pragma once
+
+/**
+ * @file state_batch.hpp
+ * @brief Apply several state changes to an object at once
+ *
+ * Every lv_obj_add_state() / lv_obj_remove_state() compares the styles of
+ * the old and new state, invalidates the object, collects the style
+ * transitions into a heap buffer and refreshes the styles. Changing
+ * FOCUSED, FOCUS_KEY and EDITED one after another does all of that two or
+ * three times per focus move, and the intermediate state can start
+ * transitions that are immediately replaced. set_states() changes only the
+ * bits that differ, with at most one add and one remove:
+ *
+ * @code
+ * lv::set_states(row, LV_STATE_CHECKED, LV_STATE_PRESSED | LV_STATE_FOCUSED);
+ * btn.set_states(LV_STATE_CHECKED | LV_STATE_FOCUSED, LV_STATE_EDITED);
+ * @endcode
+ *
+ * The result is the same as lv_obj_add_state(add) followed by
+ * lv_obj_remove_state(remove). With state_update.hpp (opt-in) installed,
+ * it goes from the old state to the final one in a single update, and
+ * objects added through lv::Group afterwards get the focus states LVGL
+ * sets on LV_EVENT_FOCUSED applied that way as well.
+ *
+ * Heap allocation: NONE
+ */
+
+#include <lvgl.h>
+
+namespace lv {
+
+namespace detail {
+
+/// Single-update state change installed by state_update.hpp (nullptr: add, then remove)
+using state_update_fn = void (*)(lv_obj_t* obj, lv_state_t next);
+
+[[nodiscard]] inline state_update_fn& state_update_hook() noexcept {
+    static state_update_fn hook = nullptr;
+    return hook;
+}
+
+} // namespace detail
+
+/**
+ * @brief Add `add` and remove `remove` from the state of `obj`
+ *
+ * Same result as lv_obj_add_state(obj, add) followed by
+ * lv_obj_remove_state(obj, remove), skipping bits already set or clear;
+ * a single style update once state_update.hpp is installed.
+ */
+inline void set_states(lv_obj_t* obj, lv_state_t add, lv_state_t remove) noexcept {
+    if (!obj) return;
+    const lv_state_t prev = lv_obj_get_state(obj);
+    const auto next = static_cast<lv_state_t>((prev | add) & ~remove);
+    if (next == prev) return;
+    if (detail::state_update_hook()) {
+        detail::state_update_hook()(obj, next);
+        return;
+    }
+    if (next & ~prev) lv_obj_add_state(obj, static_cast<lv_state_t>(next & ~prev));
+    if (prev & ~next) lv_obj_remove_state(obj, static_cast<lv_state_t>(prev & ~next));
+}
+
+namespace detail {
+
+/**
+ * @brief LV_EVENT_FOCUSED preprocess handler: the focus states in one update
+ *
+ * lv_obj's class handler adds FOCUSED (and FOCUS_KEY for keypads and
+ * encoders, EDITED while editing) and then removes EDITED, one update
+ * each. Doing it first here leaves nothing for the class handler to change.
+ */
+inline void focus_states_cb(lv_event_t* e) noexcept {
+    auto* obj = static_cast<lv_obj_t*>(lv_event_get_current_target(e));
+    lv_state_t add = LV_STATE_FOCUSED;
+    lv_indev_t* indev = lv_indev_active();
+    if (!indev) indev = lv_event_get_indev(e);
+    const lv_indev_type_t type = lv_indev_get_type(indev);
+    if (type == LV_INDEV_TYPE_KEYPAD || type == LV_INDEV_TYPE_ENCODER) add |= LV_STATE_FOCUS_KEY;
+    const bool editing = lv_group_get_editing(lv_obj_get_group(obj));
+    if (editing) add |= LV_STATE_EDITED;
+    set_states(obj, add, editing ? 0 : LV_STATE_EDITED);
+}
+
+/// Let `obj`'s focus state changes go through focus_states_cb() (once per object; only with state_update.hpp installed)
+inline void batch_focus_states(lv_obj_t* obj) noexcept {
+    if (!state_update_hook()) return;
+    constexpr auto code = static_cast<lv_event_code_t>(LV_EVENT_FOCUSED | LV_EVENT_PREPROCESS);
+    const uint32_t n = lv_obj_get_event_count(obj);
+    for (uint32_t i = 0; i < n; ++i) {
+        if (lv_event_dsc_get_cb(lv_obj_get_event_dsc(obj, i)) == &focus_states_cb) return;
+    }
+    lv_obj_add_event_cb(obj, &focus_states_cb, code, nullptr);
+}
+
+} // namespace detail
+
+} // namespace lv
@@ -0,0 +1,114 @@
+#pragma once
+
+/**
+ * @file state_update.hpp
+ * @brief set_states() in a single style update (opt-in)
+ *
+ * set_states() changes the added bits and the removed bits with one
+ * lv_obj_add_state() and one lv_obj_remove_state(). Once installed, it
+ * goes from the old state to the final one in a single update: one style
+ * comparison, invalidation, style refresh and LV_EVENT_STATE_CHANGED with
+ * the previous state as parameter, transitions from the old state to the
+ * new one. Objects added to an lv::Group afterwards get their focus states
+ * this way as well:
+ *
+ * @code
+ * #include <lv/core/state_update.hpp>
+ *
+ * lv::state_update::install();   // once, before building groups
+ * @endcode
+ *
+ * Not included by lv.hpp: it writes lv_obj_t::state, walks obj->styles and
+ * calls lv_obj_style_state_compare(), lv_obj_style_create_transition() and
+ * lv_obj_update_layer_type(), which are declared in LVGL's private
+ * headers. Checked against LVGL 9.4 (see LV_CPP_INTERNALS_OK).
+ *
+ * Heap allocation: NONE (transition descriptors on the stack; LVGL
+ * allocates the transition animations as before)
+ */
+
+#include <lvgl.h>
+#include "version.hpp"
+
+#if !LV_CPP_INTERNALS_OK
+#error "state_update.hpp reads LVGL internals checked against LVGL 9.4; see LV_CPP_INTERNALS_OK"
+#endif
+
+#include <src/core/lv_obj_private.h>         // obj->state, obj->styles
+#include <src/core/lv_obj_style_private.h>   // lv_obj_style_state_compare(), lv_obj_style_create_transition()
+#include <src/core/lv_obj_draw_private.h>    // lv_obj_update_layer_type()
+#include "state_batch.hpp"
+
+#ifndef LV_CPP_STATE_TRANSITIONS_MAX
+/// Transition descriptors collected per state change (LVGL uses 32)
+#define LV_CPP_STATE_TRANSITIONS_MAX 32
+#endif
+
+namespace lv::state_update {
+
+namespace detail {
+
+/// detail::state_update_hook(): lv_obj_add_state()'s update from `obj->state` to `next`, with the transitions on the stack
+inline void update_state(lv_obj_t* obj, lv_state_t next) noexcept {
+    lv_state_t prev = obj->state;
+    const lv_style_state_cmp_t cmp = lv_obj_style_state_compare(obj, prev, next);
+    if (cmp == LV_STYLE_STATE_CMP_SAME) {
+        obj->state = next;
+        lv_obj_send_event(obj, LV_EVENT_STATE_CHANGED, &prev);
+        return;
+    }
+
+    lv_obj_invalidate(obj);
+    obj->state = next;
+    lv_obj_update_layer_type(obj);
+
+    lv_obj_style_transition_dsc_t ts[LV_CPP_STATE_TRANSITIONS_MAX];
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < obj->style_cnt && n < LV_CPP_STATE_TRANSITIONS_MAX; ++i) {
+        const lv_obj_style_t& s = obj->styles[i];
+        const lv_state_t state = lv_obj_style_get_selector_state(s.selector);
+        const lv_part_t part = lv_obj_style_get_selector_part(s.selector);
+        if ((state & ~next) || s.is_trans) continue;
+        lv_style_value_t v;
+        if (lv_style_get_prop_inlined(s.style, LV_STYLE_TRANSITION, &v) != LV_STYLE_RES_FOUND) continue;
+        const auto* tr = static_cast<const lv_style_transition_dsc_t*>(v.ptr);
+        for (uint32_t j = 0; tr->props[j] != 0 && n < LV_CPP_STATE_TRANSITIONS_MAX; ++j) {
+            // One transition per property and part, from the style with the most specific state
+            uint32_t t = 0;
+            while (t < n && !(ts[t].prop == tr->props[j] &&
+                              lv_obj_style_get_selector_part(ts[t].selector) == part &&
+                              lv_obj_style_get_selector_state(ts[t].selector) >= state)) {
+                ++t;
+            }
+            if (t < n) continue;
+            ts[n] = {};
+            ts[n].time = tr->time;
+            ts[n].delay = tr->delay;
+            ts[n].path_cb = tr->path_xcb;
+            ts[n].prop = tr->props[j];
+            ts[n].user_data = tr->user_data;
+            ts[n].selector = s.selector;
+            ++n;
+        }
+    }
+    for (uint32_t i = 0; i < n; ++i) {
+        lv_obj_style_create_transition(obj, lv_obj_style_get_selector_part(ts[i].selector), prev, next, &ts[i]);
+    }
+
+    if (cmp == LV_STYLE_STATE_CMP_DIFF_REDRAW || cmp == LV_STYLE_STATE_CMP_DIFF_LAYOUT) {
+        lv_obj_refresh_style(obj, LV_PART_ANY, LV_STYLE_PROP_ANY);
+    } else if (cmp == LV_STYLE_STATE_CMP_DIFF_DRAW_PAD) {
+        lv_obj_invalidate(obj);
+        lv_obj_refresh_ext_draw_size(obj);
+    }
+    lv_obj_send_event(obj, LV_EVENT_STATE_CHANGED, &prev);
+}
+
+} // namespace detail
+
+/// Make set_states() a single update from now on (LVGL thread)
+inline void install() noexcept {
+    lv::detail::state_update_hook() = &detail::update_state;
+}
+
+} // namespace lv::state_update
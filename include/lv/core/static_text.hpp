@@ -0,0 +1,227 @@
+#pragma once
+
+/**
+ * @file static_text.hpp
+ * @brief NUL-terminated static strings and caller-owned label text
+ *
+ * Label::text() copies into LVGL's heap. Texts that already live long
+ * enough can be referenced instead:
+ *
+ * @code
+ * label.text(lv::static_text{"License: MIT ..."});   // literal: no copy, no with_cstr()
+ *
+ * static lv::TextBuffer<64> status;
+ * status.assign(build_status());                     // copy into our own buffer
+ * label.text_view(status);                           // label points at it
+ *
+ * label.text_view(help_page, &help_owner);           // any NUL-terminated view + its owner
+ * @endcode
+ *
+ * static_text can only be made from string literals (consteval), so it is
+ * always NUL-terminated and never dangles; it converts to const char* and
+ * std::string_view wherever those are taken.
+ *
+ * A TextOwner marks memory labels reference. With LV_CPP_TEXT_LIFETIME_CHECKS
+ * (default: debug builds) each owner holds a slot in a generation table:
+ * the generation changes when the owner is destroyed or reports changed(),
+ * and a label drawing text whose owner's generation moved since
+ * text_view() asserts, catching both dangling text and in-place edits the
+ * label was not told about. Without checks TextOwner is empty and
+ * text_view() is just lv_label_set_text_static().
+ *
+ * Heap allocation: NONE
+ */
+
+#include <lvgl.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#ifndef LV_CPP_TEXT_LIFETIME_CHECKS
+/// Check referenced label texts against their owners (default: debug builds)
+#ifdef NDEBUG
+#define LV_CPP_TEXT_LIFETIME_CHECKS 0
+#else
+#define LV_CPP_TEXT_LIFETIME_CHECKS 1
+#endif
+#endif
+
+#ifndef LV_CPP_TEXT_OWNERS
+/// TextOwners tracked at once by the lifetime checks (further owners go unchecked)
+#define LV_CPP_TEXT_OWNERS 64
+#endif
+
+namespace lv {
+
+/**
+ * @brief A string literal: NUL-terminated and valid for the whole program
+ */
+class static_text {
+    const char* m_str;
+    size_t m_len;
+
+    constexpr static_text(const char* s, size_t n) noexcept : m_str(s), m_len(n) {}
+
+public:
+    template<size_t N>
+    consteval static_text(const char (&s)[N]) noexcept : m_str(s), m_len(N - 1) {
+        // A literal's last character is its terminator; embedded NULs shorten it
+        for (size_t i = 0; i + 1 < N; ++i) {
+            if (s[i] == '\0') {
+                m_len = i;
+                break;
+            }
+        }
+    }
+
+    /// Wrap a string the caller guarantees is NUL-terminated at `s[len]` and never freed
+    [[nodiscard]] static constexpr static_text unchecked(const char* s, size_t len) noexcept {
+        return static_text(s, len);
+    }
+
+    [[nodiscard]] constexpr const char* c_str() const noexcept { return m_str; }
+    [[nodiscard]] constexpr size_t size() const noexcept { return m_len; }
+    [[nodiscard]] constexpr bool empty() const noexcept { return m_len == 0; }
+    [[nodiscard]] constexpr std::string_view view() const noexcept { return {m_str, m_len}; }
+
+    constexpr operator const char*() const noexcept { return m_str; }
+    constexpr operator std::string_view() const noexcept { return view(); }
+};
+
+namespace detail {
+
+#if LV_CPP_TEXT_LIFETIME_CHECKS
+inline constexpr uint16_t no_text_owner = 0xFFFF;
+
+struct TextOwners {
+    uint16_t generation[LV_CPP_TEXT_OWNERS] = {};
+    bool used[LV_CPP_TEXT_OWNERS] = {};
+};
+
+[[nodiscard]] inline TextOwners& text_owners() noexcept {
+    static TextOwners t;
+    return t;
+}
+#endif
+
+} // namespace detail
+
+/**
+ * @brief Marks memory that labels show through Label::text_view()
+ *
+ * Destroying the owner, or calling changed() after editing the text in
+ * place, invalidates every text_view() taken before; with lifetime checks
+ * a label drawing such text asserts. Re-run text_view() after an edit.
+ */
+class TextOwner {
+#if LV_CPP_TEXT_LIFETIME_CHECKS
+    uint16_t m_slot = detail::no_text_owner;
+#endif
+
+public:
+    TextOwner() noexcept {
+#if LV_CPP_TEXT_LIFETIME_CHECKS
+        detail::TextOwners& t = detail::text_owners();
+        for (uint16_t i = 0; i < LV_CPP_TEXT_OWNERS; ++i) {
+            if (!t.used[i]) {
+                t.used[i] = true;
+                m_slot = i;
+                return;
+            }
+        }
+#endif
+    }
+
+    TextOwner(const TextOwner&) = delete;
+    TextOwner& operator=(const TextOwner&) = delete;
+
+    ~TextOwner() {
+#if LV_CPP_TEXT_LIFETIME_CHECKS
+        if (m_slot == detail::no_text_owner) return;
+        detail::TextOwners& t = detail::text_owners();
+        ++t.generation[m_slot];
+        t.used[m_slot] = false;
+#endif
+    }
+
+    /// The owned text was edited in place: earlier text_view()s are stale
+    void changed() noexcept {
+#if LV_CPP_TEXT_LIFETIME_CHECKS
+        if (m_slot != detail::no_text_owner) ++detail::text_owners().generation[m_slot];
+#endif
+    }
+
+    /// Slot and generation packed for a label's check (0: unchecked)
+    [[nodiscard]] uintptr_t ticket() const noexcept {
+#if LV_CPP_TEXT_LIFETIME_CHECKS
+        if (m_slot == detail::no_text_owner) return 0;
+        return (static_cast<uintptr_t>(m_slot + 1) << 16) | detail::text_owners().generation[m_slot];
+#else
+        return 0;
+#endif
+    }
+};
+
+/**
+ * @brief Fixed-capacity, always NUL-terminated text buffer with an owner
+ */
+template<size_t N>
+class TextBuffer : public TextOwner {
+    static_assert(N > 1, "TextBuffer needs room for a character and the terminator");
+    char m_buf[N] = {};
+    size_t m_len = 0;
+
+public:
+    TextBuffer() noexcept = default;
+
+    explicit TextBuffer(std::string_view sv) noexcept { assign(sv); }
+
+    /// Copy `sv` (cut to N - 1 bytes); labels showing the buffer must take text_view() again
+    TextBuffer& assign(std::string_view sv) noexcept {
+        m_len = sv.size() < N ? sv.size() : N - 1;
+        std::memcpy(m_buf, sv.data(), m_len);
+        m_buf[m_len] = '\0';
+        changed();
+        return *this;
+    }
+
+    [[nodiscard]] const char* c_str() const noexcept { return m_buf; }
+    [[nodiscard]] size_t size() const noexcept { return m_len; }
+    [[nodiscard]] static constexpr size_t capacity() noexcept { return N - 1; }
+    [[nodiscard]] std::string_view view() const noexcept { return {m_buf, m_len}; }
+};
+
+namespace detail {
+
+#if LV_CPP_TEXT_LIFETIME_CHECKS && LV_USE_LABEL
+/// Label draw check: the owner's generation must still be the one text_view() saw
+inline void text_ticket_cb(lv_event_t* e) noexcept {
+    const auto ticket = reinterpret_cast<uintptr_t>(lv_event_get_user_data(e));
+    const uint16_t slot = static_cast<uint16_t>((ticket >> 16) - 1);
+    const uint16_t gen = static_cast<uint16_t>(ticket & 0xFFFF);
+    LV_ASSERT_MSG(text_owners().generation[slot] == gen,
+                  "label shows text_view() text whose owner was destroyed or changed");
+    LV_UNUSED(slot);
+    LV_UNUSED(gen);
+}
+#endif
+
+#if LV_USE_LABEL
+/// Point `label` at `txt` without copying; track `owner` when lifetime checks are on
+inline void set_label_text_view(lv_obj_t* label, const char* txt, const TextOwner* owner) noexcept {
+#if LV_CPP_TEXT_LIFETIME_CHECKS
+    while (lv_obj_remove_event_cb(label, &text_ticket_cb)) {}
+    if (const uintptr_t ticket = owner ? owner->ticket() : 0) {
+        lv_obj_add_event_cb(label, &text_ticket_cb, LV_EVENT_DRAW_MAIN_BEGIN, reinterpret_cast<void*>(ticket));
+    }
+#else
+    LV_UNUSED(owner);
+#endif
+    lv_label_set_text_static(label, txt);
+}
+#endif
+
+} // namespace detail
+
+} // namespace lv
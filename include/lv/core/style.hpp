@@ -11,6 +11,7 @@
 #include <lvgl.h>
 #include <cstdint>
 #include <type_traits>
+#include "setter_audit.hpp"
 
 namespace lv {
 
@@ -536,7 +537,9 @@ static_assert(sizeof(Style) == sizeof(lv_style_t),
  * @brief Mixin for inline style setters
  *
  * These methods set local styles directly on the object.
- * Use Style class for shared styles.
+ * Use Style class for shared styles. The frequently refreshed ones (colors,
+ * opacities, border width, font, transforms) can skip unchanged values and
+ * report redundant calls; see setter_audit.hpp.
  */
 template<typename Derived>
 class StyleMixin {
@@ -549,15 +552,27 @@ private:
         return static_cast<const Derived*>(this)->get();
     }
 
+    /// Local style `prop` at `sel` is already `v` (LV_CPP_SETTER_AUDIT / LV_CPP_SET_IF_CHANGED)
+    template<typename V>
+    [[nodiscard]] bool local_is(lv_style_prop_t prop, V v, lv_style_selector_t sel) const noexcept {
+        return setter_audit::detail::local_is(obj(), prop, v, sel);
+    }
+
 public:
     // ==================== Background ====================
 
-    Derived& bg_color(lv_color_t color, lv_style_selector_t sel = 0) noexcept {
+    Derived& bg_color(lv_color_t color, lv_style_selector_t sel = 0 LV_CPP_SETTER_SITE) noexcept {
+        if (LV_CPP_SETTER_UNCHANGED("bg_color", obj(), local_is(LV_STYLE_BG_COLOR, color, sel))) {
+            return *static_cast<Derived*>(this);
+        }
         lv_obj_set_style_bg_color(obj(), color, sel);
         return *static_cast<Derived*>(this);
     }
 
-    Derived& bg_opa(lv_opa_t opa, lv_style_selector_t sel = 0) noexcept {
+    Derived& bg_opa(lv_opa_t opa, lv_style_selector_t sel = 0 LV_CPP_SETTER_SITE) noexcept {
+        if (LV_CPP_SETTER_UNCHANGED("bg_opa", obj(), local_is(LV_STYLE_BG_OPA, opa, sel))) {
+            return *static_cast<Derived*>(this);
+        }
         lv_obj_set_style_bg_opa(obj(), opa, sel);
         return *static_cast<Derived*>(this);
     }
@@ -595,12 +610,18 @@ public:
 
     // ==================== Border ====================
 
-    Derived& border_color(lv_color_t color, lv_style_selector_t sel = 0) noexcept {
+    Derived& border_color(lv_color_t color, lv_style_selector_t sel = 0 LV_CPP_SETTER_SITE) noexcept {
+        if (LV_CPP_SETTER_UNCHANGED("border_color", obj(), local_is(LV_STYLE_BORDER_COLOR, color, sel))) {
+            return *static_cast<Derived*>(this);
+        }
         lv_obj_set_style_border_color(obj(), color, sel);
         return *static_cast<Derived*>(this);
     }
 
-    Derived& border_width(int32_t width, lv_style_selector_t sel = 0) noexcept {
+    Derived& border_width(int32_t width, lv_style_selector_t sel = 0 LV_CPP_SETTER_SITE) noexcept {
+        if (LV_CPP_SETTER_UNCHANGED("border_width", obj(), local_is(LV_STYLE_BORDER_WIDTH, width, sel))) {
+            return *static_cast<Derived*>(this);
+        }
         lv_obj_set_style_border_width(obj(), width, sel);
         return *static_cast<Derived*>(this);
     }
@@ -668,7 +689,10 @@ public:
         return *static_cast<Derived*>(this);
     }
 
-    Derived& opa(lv_opa_t opa, lv_style_selector_t sel = 0) noexcept {
+    Derived& opa(lv_opa_t opa, lv_style_selector_t sel = 0 LV_CPP_SETTER_SITE) noexcept {
+        if (LV_CPP_SETTER_UNCHANGED("opa", obj(), local_is(LV_STYLE_OPA, opa, sel))) {
+            return *static_cast<Derived*>(this);
+        }
         lv_obj_set_style_opa(obj(), opa, sel);
         return *static_cast<Derived*>(this);
     }
@@ -680,12 +704,18 @@ public:
 
     // ==================== Text ====================
 
-    Derived& text_color(lv_color_t color, lv_style_selector_t sel = 0) noexcept {
+    Derived& text_color(lv_color_t color, lv_style_selector_t sel = 0 LV_CPP_SETTER_SITE) noexcept {
+        if (LV_CPP_SETTER_UNCHANGED("text_color", obj(), local_is(LV_STYLE_TEXT_COLOR, color, sel))) {
+            return *static_cast<Derived*>(this);
+        }
         lv_obj_set_style_text_color(obj(), color, sel);
         return *static_cast<Derived*>(this);
     }
 
-    Derived& text_font(const lv_font_t* font, lv_style_selector_t sel = 0) noexcept {
+    Derived& text_font(const lv_font_t* font, lv_style_selector_t sel = 0 LV_CPP_SETTER_SITE) noexcept {
+        if (LV_CPP_SETTER_UNCHANGED("text_font", obj(), local_is(LV_STYLE_TEXT_FONT, font, sel))) {
+            return *static_cast<Derived*>(this);
+        }
         lv_obj_set_style_text_font(obj(), font, sel);
         return *static_cast<Derived*>(this);
     }
@@ -702,17 +732,26 @@ public:
 
     // ==================== Image ====================
 
-    Derived& image_opa(lv_opa_t opa, lv_style_selector_t sel = 0) noexcept {
+    Derived& image_opa(lv_opa_t opa, lv_style_selector_t sel = 0 LV_CPP_SETTER_SITE) noexcept {
+        if (LV_CPP_SETTER_UNCHANGED("image_opa", obj(), local_is(LV_STYLE_IMAGE_OPA, opa, sel))) {
+            return *static_cast<Derived*>(this);
+        }
         lv_obj_set_style_image_opa(obj(), opa, sel);
         return *static_cast<Derived*>(this);
     }
 
-    Derived& image_recolor(lv_color_t color, lv_style_selector_t sel = 0) noexcept {
+    Derived& image_recolor(lv_color_t color, lv_style_selector_t sel = 0 LV_CPP_SETTER_SITE) noexcept {
+        if (LV_CPP_SETTER_UNCHANGED("image_recolor", obj(), local_is(LV_STYLE_IMAGE_RECOLOR, color, sel))) {
+            return *static_cast<Derived*>(this);
+        }
         lv_obj_set_style_image_recolor(obj(), color, sel);
         return *static_cast<Derived*>(this);
     }
 
-    Derived& image_recolor_opa(lv_opa_t opa, lv_style_selector_t sel = 0) noexcept {
+    Derived& image_recolor_opa(lv_opa_t opa, lv_style_selector_t sel = 0 LV_CPP_SETTER_SITE) noexcept {
+        if (LV_CPP_SETTER_UNCHANGED("image_recolor_opa", obj(), local_is(LV_STYLE_IMAGE_RECOLOR_OPA, opa, sel))) {
+            return *static_cast<Derived*>(this);
+        }
         lv_obj_set_style_image_recolor_opa(obj(), opa, sel);
         return *static_cast<Derived*>(this);
     }
@@ -724,7 +763,10 @@ public:
         return *static_cast<Derived*>(this);
     }
 
-    Derived& arc_color(lv_color_t color, lv_style_selector_t sel = 0) noexcept {
+    Derived& arc_color(lv_color_t color, lv_style_selector_t sel = 0 LV_CPP_SETTER_SITE) noexcept {
+        if (LV_CPP_SETTER_UNCHANGED("arc_color", obj(), local_is(LV_STYLE_ARC_COLOR, color, sel))) {
+            return *static_cast<Derived*>(this);
+        }
         lv_obj_set_style_arc_color(obj(), color, sel);
         return *static_cast<Derived*>(this);
     }
@@ -746,7 +788,10 @@ public:
         return *static_cast<Derived*>(this);
     }
 
-    Derived& line_color(lv_color_t color, lv_style_selector_t sel = 0) noexcept {
+    Derived& line_color(lv_color_t color, lv_style_selector_t sel = 0 LV_CPP_SETTER_SITE) noexcept {
+        if (LV_CPP_SETTER_UNCHANGED("line_color", obj(), local_is(LV_STYLE_LINE_COLOR, color, sel))) {
+            return *static_cast<Derived*>(this);
+        }
         lv_obj_set_style_line_color(obj(), color, sel);
         return *static_cast<Derived*>(this);
     }
@@ -779,12 +824,19 @@ public:
         return *static_cast<Derived*>(this);
     }
 
-    Derived& transform_rotation(int32_t angle, lv_style_selector_t sel = 0) noexcept {
+    Derived& transform_rotation(int32_t angle, lv_style_selector_t sel = 0 LV_CPP_SETTER_SITE) noexcept {
+        if (LV_CPP_SETTER_UNCHANGED("transform_rotation", obj(), local_is(LV_STYLE_TRANSFORM_ROTATION, angle, sel))) {
+            return *static_cast<Derived*>(this);
+        }
         lv_obj_set_style_transform_rotation(obj(), angle, sel);
         return *static_cast<Derived*>(this);
     }
 
-    Derived& transform_scale(int32_t scale, lv_style_selector_t sel = 0) noexcept {
+    Derived& transform_scale(int32_t scale, lv_style_selector_t sel = 0 LV_CPP_SETTER_SITE) noexcept {
+        if (LV_CPP_SETTER_UNCHANGED("transform_scale", obj(), local_is(LV_STYLE_TRANSFORM_SCALE_X, scale, sel) &&
+                                                              local_is(LV_STYLE_TRANSFORM_SCALE_Y, scale, sel))) {
+            return *static_cast<Derived*>(this);
+        }
         lv_obj_set_style_transform_scale(obj(), scale, sel);
         return *static_cast<Derived*>(this);
     }
@@ -935,13 +987,19 @@ public:
     // ==================== Transform / Translate ====================
 
     /// Set translate X
-    Derived& translate_x(int32_t x, lv_style_selector_t sel = 0) noexcept {
+    Derived& translate_x(int32_t x, lv_style_selector_t sel = 0 LV_CPP_SETTER_SITE) noexcept {
+        if (LV_CPP_SETTER_UNCHANGED("translate_x", obj(), local_is(LV_STYLE_TRANSLATE_X, x, sel))) {
+            return *static_cast<Derived*>(this);
+        }
         lv_obj_set_style_translate_x(obj(), x, sel);
         return *static_cast<Derived*>(this);
     }
 
     /// Set translate Y
-    Derived& translate_y(int32_t y, lv_style_selector_t sel = 0) noexcept {
+    Derived& translate_y(int32_t y, lv_style_selector_t sel = 0 LV_CPP_SETTER_SITE) noexcept {
+        if (LV_CPP_SETTER_UNCHANGED("translate_y", obj(), local_is(LV_STYLE_TRANSLATE_Y, y, sel))) {
+            return *static_cast<Derived*>(this);
+        }
         lv_obj_set_style_translate_y(obj(), y, sel);
         return *static_cast<Derived*>(this);
     }
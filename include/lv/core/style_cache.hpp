@@ -0,0 +1,376 @@
+#pragma once
+
+/**
+ * @file style_cache.hpp
+ * @brief Interning of identical styles and an audit for repeated local styles
+ *
+ * Every lv_style_t owns its own property array, so ten Style objects with the
+ * same background and padding cost ten arrays. StyleCache hashes a style's
+ * property set and hands out one shared, reference-counted `const Style*`
+ * per distinct set; duplicates are reset (their array freed) on intern.
+ *
+ * audit_local_styles() walks a widget tree and reports siblings that carry
+ * the same local style properties (StyleMixin setters), which are candidates
+ * for one shared Style.
+ *
+ * Usage:
+ * @code
+ * static lv::StyleCache<> styles;
+ *
+ * lv::Style s;
+ * s.bg_color(lv::colors::navy()).radius(6).pad_all(8);
+ * const lv::Style* card = styles.acquire(std::move(s));  // shared if seen before
+ * lv_obj_add_style(obj, card->get(), 0);
+ * ...
+ * styles.release(card);                                  // when no object uses it
+ *
+ * LV_LOG_USER("style dedup saved %u bytes", (unsigned)styles.bytes_saved());
+ * lv::audit_local_styles(lv::screen_active());            // debug builds only
+ * @endcode
+ *
+ * Only built-in properties are compared. Styles holding custom properties
+ * (registered with lv_style_register_prop()) or const styles are never
+ * interned; acquire() stores them unshared.
+ */
+
+#include <lvgl.h>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include "object.hpp"
+#include "style.hpp"
+
+namespace lv {
+
+#ifndef LV_CPP_STYLE_CACHE_SIZE
+/// Distinct styles a StyleCache can hold by default
+#define LV_CPP_STYLE_CACHE_SIZE 32
+#endif
+
+#ifndef LV_CPP_STYLE_AUDIT
+/// Enable audit_local_styles() (default: debug builds)
+#ifdef NDEBUG
+#define LV_CPP_STYLE_AUDIT 0
+#else
+#define LV_CPP_STYLE_AUDIT 1
+#endif
+#endif
+
+namespace detail {
+
+/// Heap bytes of a style's property array (one value + one prop id per property)
+[[nodiscard]] constexpr size_t style_props_bytes(uint32_t prop_cnt) noexcept {
+    return prop_cnt * (sizeof(lv_style_value_t) + sizeof(lv_style_prop_t));
+}
+
+/// Properties whose value is a pointer (fonts, images, descriptors)
+[[nodiscard]] constexpr bool style_prop_is_pointer(lv_style_prop_t prop) noexcept {
+    switch (prop) {
+    case LV_STYLE_BG_GRAD:
+    case LV_STYLE_BG_IMAGE_SRC:
+    case LV_STYLE_ARC_IMAGE_SRC:
+    case LV_STYLE_TEXT_FONT:
+    case LV_STYLE_COLOR_FILTER_DSC:
+    case LV_STYLE_ANIM:
+    case LV_STYLE_TRANSITION:
+    case LV_STYLE_BITMAP_MASK_SRC:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/// Properties whose value is an lv_color_t
+[[nodiscard]] constexpr bool style_prop_is_color(lv_style_prop_t prop) noexcept {
+    switch (prop) {
+    case LV_STYLE_BG_COLOR:
+    case LV_STYLE_BG_GRAD_COLOR:
+    case LV_STYLE_BG_IMAGE_RECOLOR:
+    case LV_STYLE_BORDER_COLOR:
+    case LV_STYLE_OUTLINE_COLOR:
+    case LV_STYLE_SHADOW_COLOR:
+    case LV_STYLE_IMAGE_RECOLOR:
+    case LV_STYLE_LINE_COLOR:
+    case LV_STYLE_ARC_COLOR:
+    case LV_STYLE_TEXT_COLOR:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/// Value reduced to its meaningful bytes (the union's unused bytes are unspecified)
+[[nodiscard]] inline uint64_t style_value_key(lv_style_prop_t prop, lv_style_value_t v) noexcept {
+    if (style_prop_is_pointer(prop)) return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(v.ptr));
+    if (style_prop_is_color(prop)) return lv_color_to_u32(v.color) & 0xFFFFFFu;
+    return static_cast<uint32_t>(v.num);
+}
+
+[[nodiscard]] constexpr uint32_t style_hash_step(uint32_t h, uint64_t x) noexcept {
+    // FNV-1a over the 8 bytes of x
+    for (int i = 0; i < 8; ++i) {
+        h ^= static_cast<uint32_t>(x & 0xFFu);
+        h *= 16777619u;
+        x >>= 8;
+    }
+    return h;
+}
+
+/// Property summary of a style: hash over (prop, value) in property order
+struct StyleSignature {
+    uint32_t hash = 2166136261u;
+    uint32_t count = 0;
+    bool complete = true;   ///< false: const style or custom properties (not comparable)
+};
+
+[[nodiscard]] inline StyleSignature style_signature(const lv_style_t* style) noexcept {
+    StyleSignature sig;
+    if (style->prop_cnt == LV_STYLE_PROP_CONST) {
+        sig.complete = false;
+        return sig;
+    }
+    for (uint32_t p = 1; p < LV_STYLE_NUM_BUILT_IN_PROPS; ++p) {
+        const auto prop = static_cast<lv_style_prop_t>(p);
+        lv_style_value_t v;
+        if (lv_style_get_prop(style, prop, &v) != LV_STYLE_RES_FOUND) continue;
+        sig.hash = style_hash_step(sig.hash, (static_cast<uint64_t>(p) << 56) ^ style_value_key(prop, v));
+        ++sig.count;
+    }
+    sig.complete = sig.count == style->prop_cnt;
+    return sig;
+}
+
+/// Same built-in properties with the same values (a and b have equal signatures)
+[[nodiscard]] inline bool style_props_equal(const lv_style_t* a, const lv_style_t* b) noexcept {
+    for (uint32_t p = 1; p < LV_STYLE_NUM_BUILT_IN_PROPS; ++p) {
+        const auto prop = static_cast<lv_style_prop_t>(p);
+        lv_style_value_t va;
+        lv_style_value_t vb;
+        const bool in_a = lv_style_get_prop(a, prop, &va) == LV_STYLE_RES_FOUND;
+        const bool in_b = lv_style_get_prop(b, prop, &vb) == LV_STYLE_RES_FOUND;
+        if (in_a != in_b) return false;
+        if (in_a && style_value_key(prop, va) != style_value_key(prop, vb)) return false;
+    }
+    return true;
+}
+
+} // namespace detail
+
+// ==================== Style Cache ====================
+
+/**
+ * @brief Fixed-capacity pool of shared styles, deduplicated by content
+ *
+ * Returned pointers stay valid until their last release(). Objects using a
+ * cached style must be deleted (or have the style removed) before that.
+ * Styles must not be modified after acquire(): others may share them.
+ *
+ * Heap allocation: NONE (besides the property arrays LVGL keeps per style)
+ *
+ * @tparam N Maximum number of distinct styles
+ */
+template<size_t N = LV_CPP_STYLE_CACHE_SIZE>
+class StyleCache {
+    struct Entry {
+        Style style;
+        uint32_t hash = 0;
+        uint32_t prop_cnt = 0;
+        uint32_t refs = 0;      ///< 0 = free entry
+        bool shareable = false;
+    };
+
+    Entry m_entries[N];
+    uint32_t m_hits = 0;
+
+public:
+    StyleCache() noexcept = default;
+
+    // Non-copyable, non-movable (hands out pointers into itself)
+    StyleCache(const StyleCache&) = delete;
+    StyleCache& operator=(const StyleCache&) = delete;
+
+    /**
+     * @brief Intern a style
+     *
+     * If an identical style is cached, its reference count is bumped and
+     * `style` is reset (freeing its property array). Otherwise `style` is
+     * moved into the cache.
+     *
+     * @return Shared style, or nullptr if the cache is full (`style` untouched)
+     */
+    [[nodiscard]] const Style* acquire(Style&& style) noexcept {
+        const detail::StyleSignature sig = detail::style_signature(style.get());
+        Entry* free_entry = nullptr;
+        for (Entry& e : m_entries) {
+            if (e.refs == 0) {
+                if (!free_entry) free_entry = &e;
+                continue;
+            }
+            if (sig.complete && e.shareable && e.hash == sig.hash && e.prop_cnt == sig.count &&
+                detail::style_props_equal(e.style.get(), style.get())) {
+                ++e.refs;
+                ++m_hits;
+                style.reset();
+                return &e.style;
+            }
+        }
+        if (!free_entry) return nullptr;
+        free_entry->style = std::move(style);
+        free_entry->hash = sig.hash;
+        free_entry->prop_cnt = sig.count;
+        free_entry->shareable = sig.complete;
+        free_entry->refs = 1;
+        return &free_entry->style;
+    }
+
+    /// Drop one reference; the style is reset when the last one goes
+    void release(const Style* style) noexcept {
+        for (Entry& e : m_entries) {
+            if (e.refs == 0 || &e.style != style) continue;
+            if (--e.refs == 0) e.style.reset();
+            return;
+        }
+    }
+
+    /// Distinct styles currently cached
+    [[nodiscard]] size_t size() const noexcept {
+        size_t n = 0;
+        for (const Entry& e : m_entries) n += e.refs != 0;
+        return n;
+    }
+
+    [[nodiscard]] static constexpr size_t capacity() noexcept { return N; }
+
+    /// Number of acquire() calls answered with an existing style
+    [[nodiscard]] uint32_t hits() const noexcept { return m_hits; }
+
+    /**
+     * @brief Property-array bytes not allocated thanks to sharing
+     *
+     * Counts, for every cached style, the arrays its extra references would
+     * have held as separate styles.
+     */
+    [[nodiscard]] size_t bytes_saved() const noexcept {
+        size_t bytes = 0;
+        for (const Entry& e : m_entries) {
+            if (e.refs > 1) bytes += (e.refs - 1) * detail::style_props_bytes(e.prop_cnt);
+        }
+        return bytes;
+    }
+};
+
+// ==================== Local Style Audit ====================
+
+/// One group of siblings with identical local style properties
+struct StyleAuditFinding {
+    lv_obj_t* parent;
+    lv_obj_t* first;          ///< First sibling of the group
+    uint32_t siblings;        ///< Number of siblings in the group
+    uint32_t props;           ///< Local properties each of them sets
+    size_t bytes_each;        ///< Estimated local style bytes per sibling
+};
+
+using StyleAuditCb = void (*)(const StyleAuditFinding& finding, void* user_data);
+
+#if LV_CPP_STYLE_AUDIT
+
+namespace detail {
+
+/// Signature of an object's local style for LV_PART_MAIN | LV_STATE_DEFAULT
+[[nodiscard]] inline StyleSignature local_style_signature(lv_obj_t* obj) noexcept {
+    StyleSignature sig;
+    for (uint32_t p = 1; p < LV_STYLE_NUM_BUILT_IN_PROPS; ++p) {
+        const auto prop = static_cast<lv_style_prop_t>(p);
+        lv_style_value_t v;
+        if (lv_obj_get_local_style_prop(obj, prop, &v, LV_PART_MAIN | LV_STATE_DEFAULT) != LV_STYLE_RES_FOUND) {
+            continue;
+        }
+        sig.hash = style_hash_step(sig.hash, (static_cast<uint64_t>(p) << 56) ^ style_value_key(prop, v));
+        ++sig.count;
+    }
+    return sig;
+}
+
+struct StyleAudit {
+    StyleAuditCb cb;
+    void* user_data;
+    uint32_t min_siblings;
+    uint32_t min_props;
+    uint32_t findings = 0;
+};
+
+inline void default_style_audit_cb(const StyleAuditFinding& f, void*) noexcept {
+    (void)f;    // unused when LV_USE_LOG is off
+    LV_LOG_WARN("%u siblings under %p repeat the same %u local style props (~%u bytes each): "
+                "use a shared lv::Style", static_cast<unsigned>(f.siblings), static_cast<void*>(f.parent),
+                static_cast<unsigned>(f.props), static_cast<unsigned>(f.bytes_each));
+}
+
+inline lv_obj_tree_walk_res_t style_audit_walk_cb(lv_obj_t* parent, void* user_data) noexcept {
+    auto& audit = *static_cast<StyleAudit*>(user_data);
+    constexpr uint32_t MAX_CHILDREN = 256;
+    uint32_t n = lv_obj_get_child_count(parent);
+    if (n > MAX_CHILDREN) n = MAX_CHILDREN;
+    if (n < audit.min_siblings) return LV_OBJ_TREE_WALK_NEXT;
+
+    // Static: keeps ~3 KB off small stacks; the tree walk is not re-entered
+    static StyleSignature sigs[MAX_CHILDREN];
+    static bool grouped[MAX_CHILDREN];
+    for (uint32_t i = 0; i < n; ++i) grouped[i] = false;
+    for (uint32_t i = 0; i < n; ++i) {
+        sigs[i] = local_style_signature(lv_obj_get_child(parent, static_cast<int32_t>(i)));
+    }
+    for (uint32_t i = 0; i < n; ++i) {
+        if (grouped[i] || sigs[i].count < audit.min_props) continue;
+        uint32_t same = 1;
+        for (uint32_t j = i + 1; j < n; ++j) {
+            if (!grouped[j] && sigs[j].count == sigs[i].count && sigs[j].hash == sigs[i].hash) {
+                grouped[j] = true;
+                ++same;
+            }
+        }
+        if (same < audit.min_siblings) continue;
+        const StyleAuditFinding finding{
+            parent, lv_obj_get_child(parent, static_cast<int32_t>(i)), same, sigs[i].count,
+            sizeof(lv_style_t) + style_props_bytes(sigs[i].count)};
+        audit.cb(finding, audit.user_data);
+        ++audit.findings;
+    }
+    return LV_OBJ_TREE_WALK_NEXT;
+}
+
+} // namespace detail
+
+/**
+ * @brief Report siblings that repeat the same local style properties
+ *
+ * Walks the tree under `root` and, per parent, groups children whose local
+ * styles (LV_PART_MAIN, default state) set the same properties to the same
+ * values. Each group of at least `min_siblings` children with at least
+ * `min_props` properties is reported; by default as an LVGL warning
+ * suggesting a shared lv::Style.
+ *
+ * Compiled only when LV_CPP_STYLE_AUDIT is 1 (default in debug builds);
+ * otherwise it does nothing and returns 0.
+ *
+ * @return Number of groups reported
+ */
+inline uint32_t audit_local_styles(ObjectView root, uint32_t min_siblings = 3, uint32_t min_props = 2,
+                                   StyleAuditCb cb = &detail::default_style_audit_cb,
+                                   void* user_data = nullptr) noexcept {
+    if (!root) return 0;
+    detail::StyleAudit audit{cb, user_data, min_siblings < 2 ? 2 : min_siblings, min_props};
+    lv_obj_tree_walk(root.get(), &detail::style_audit_walk_cb, &audit);
+    return audit.findings;
+}
+
+#else
+
+inline uint32_t audit_local_styles(ObjectView, uint32_t = 3, uint32_t = 2,
+                                   StyleAuditCb = nullptr, void* = nullptr) noexcept {
+    return 0;
+}
+
+#endif // LV_CPP_STYLE_AUDIT
+
+} // namespace lv
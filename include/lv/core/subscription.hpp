@@ -0,0 +1,286 @@
+#pragma once
+
+/**
+ * @file subscription.hpp
+ * @brief RAII observer handles and component-scoped subscriptions without per-observer allocation
+ *
+ * State::observe<&Fn>(instance) returns the raw lv_observer_t* LVGL
+ * allocated; forgetting lv::remove_observer() leaks it and leaves a
+ * callback into a destroyed object. Subscriptions fix both:
+ *
+ * @code
+ * class Dashboard : public lv::Component<Dashboard> {
+ *     lv::Subscription m_temp;                  // unsubscribes in its destructor
+ * public:
+ *     lv::ObjectView build(lv::ObjectView parent) {
+ *         subscribe<&Dashboard::on_rpm>(rpm);   // removed on unmount()
+ *         m_temp = temp.subscribe<&Dashboard::on_temp>(this);
+ *         ...
+ *     }
+ *     void on_rpm(int32_t v);
+ *     void on_temp(int32_t v);
+ * };
+ * @endcode
+ *
+ * A subject gets one LVGL observer (a "hub", LV_CPP_OBSERVER_HUBS fixed
+ * slots) the first time something subscribes to it. Subscriptions are
+ * intrusive nodes in the hub's list: a Subscription handle carries its
+ * node inline, and Component::subscribe() takes one from a fixed pool
+ * (LV_CPP_SUBSCRIPTION_POOL) tagged with the component. Subscribing and
+ * unsubscribing only link and unlink nodes, so recycling list rows does
+ * not touch the heap. Like LVGL observers, a new subscription is called
+ * once with the current value.
+ *
+ * State and StringState drop their hub when destroyed, which leaves the
+ * remaining subscriptions inert. Use from the LVGL thread.
+ *
+ * Heap allocation: one LVGL observer per subscribed subject (kept until the
+ * subject's State is destroyed); NONE per subscription
+ */
+
+#include <lvgl.h>
+#include <cstdint>
+
+#if LV_USE_OBSERVER
+
+#ifndef LV_CPP_OBSERVER_HUBS
+/// Subjects that can have subscriptions at once
+#define LV_CPP_OBSERVER_HUBS 64
+#endif
+
+#ifndef LV_CPP_SUBSCRIPTION_POOL
+/// Pooled subscriptions for Component::subscribe()
+#define LV_CPP_SUBSCRIPTION_POOL 128
+#endif
+
+namespace lv {
+
+namespace detail {
+
+struct ObserverHub;
+
+/// One subscriber in a hub's list
+struct SubNode {
+    SubNode* prev = nullptr;
+    SubNode* next = nullptr;
+    ObserverHub* hub = nullptr;                      ///< nullptr: not subscribed
+    void (*fn)(void* target, lv_subject_t* subject) = nullptr;
+    void* target = nullptr;
+    const void* owner = nullptr;                     ///< Pooled nodes: owning component
+};
+
+/// The single LVGL observer of a subject, fanning out to its subscribers
+struct ObserverHub {
+    lv_subject_t* subject = nullptr;                 ///< nullptr: free slot
+    lv_observer_t* observer = nullptr;
+    SubNode* head = nullptr;
+    SubNode* tail = nullptr;
+    SubNode* cursor = nullptr;                       ///< Next node of the running notification
+};
+
+struct SubscriptionPool {
+    ObserverHub hubs[LV_CPP_OBSERVER_HUBS];
+    SubNode nodes[LV_CPP_SUBSCRIPTION_POOL];
+    SubNode* free = nullptr;
+    uint32_t pooled = 0;                             ///< Pool nodes in use
+    bool init = false;
+};
+
+[[nodiscard]] inline SubscriptionPool& subscription_pool() noexcept {
+    static SubscriptionPool p;
+    if (!p.init) {
+        for (uint32_t i = LV_CPP_SUBSCRIPTION_POOL; i-- > 0;) {
+            p.nodes[i].next = p.free;
+            p.free = &p.nodes[i];
+        }
+        p.init = true;
+    }
+    return p;
+}
+
+inline void hub_cb(lv_observer_t* observer, lv_subject_t* subject) noexcept {
+    auto* hub = static_cast<ObserverHub*>(lv_observer_get_user_data(observer));
+    SubNode* const outer = hub->cursor;    // nested notification of the same subject
+    for (SubNode* n = hub->head; n; n = hub->cursor) {
+        hub->cursor = n->next;             // unlink() advances it if that node goes
+        n->fn(n->target, subject);
+    }
+    hub->cursor = outer;
+}
+
+[[nodiscard]] inline ObserverHub* find_hub(const lv_subject_t* subject) noexcept {
+    for (ObserverHub& h : subscription_pool().hubs) {
+        if (h.subject == subject) return &h;
+    }
+    return nullptr;
+}
+
+/// Hub of `subject`, created on first use (nullptr when all slots are taken)
+[[nodiscard]] inline ObserverHub* acquire_hub(lv_subject_t* subject) noexcept {
+    if (ObserverHub* h = find_hub(subject)) return h;
+    ObserverHub* h = find_hub(nullptr);
+    if (!h) {
+        LV_LOG_WARN("observer hubs exhausted, raise LV_CPP_OBSERVER_HUBS");
+        return nullptr;
+    }
+    *h = ObserverHub{};
+    h->subject = subject;
+    h->observer = lv_subject_add_observer(subject, &hub_cb, h);    // first call: empty list
+    return h;
+}
+
+inline void link(ObserverHub& hub, SubNode& n) noexcept {
+    n.hub = &hub;
+    n.next = nullptr;
+    n.prev = hub.tail;
+    if (hub.tail) hub.tail->next = &n; else hub.head = &n;
+    hub.tail = &n;
+}
+
+inline void unlink(SubNode& n) noexcept {
+    ObserverHub* hub = n.hub;
+    if (!hub) return;
+    if (hub->cursor == &n) hub->cursor = n.next;
+    if (n.prev) n.prev->next = n.next; else hub->head = n.next;
+    if (n.next) n.next->prev = n.prev; else hub->tail = n.prev;
+    n.prev = n.next = nullptr;
+    n.hub = nullptr;
+}
+
+/// Put `to` in `from`'s place in its hub list (moved Subscription handles)
+inline void relink(SubNode& from, SubNode& to) noexcept {
+    to = from;
+    if (ObserverHub* hub = from.hub) {
+        if (to.prev) to.prev->next = &to; else hub->head = &to;
+        if (to.next) to.next->prev = &to; else hub->tail = &to;
+        if (hub->cursor == &from) hub->cursor = &to;
+    }
+    from = SubNode{};
+}
+
+/// Subscribe `n` and deliver the current value once, as LVGL does for new observers
+[[nodiscard]] inline bool subscribe_node(lv_subject_t* subject, SubNode& n) noexcept {
+    ObserverHub* hub = acquire_hub(subject);
+    if (!hub) return false;
+    link(*hub, n);
+    n.fn(n.target, subject);
+    return true;
+}
+
+/// Drop the hub of a subject about to be deinitialised; its subscriptions become inert
+inline void release_hub(lv_subject_t* subject) noexcept {
+    ObserverHub* hub = find_hub(subject);
+    if (!hub) return;
+    for (SubNode* n = hub->head; n;) {
+        SubNode* next = n->next;
+        n->prev = n->next = nullptr;
+        n->hub = nullptr;
+        n = next;
+    }
+    lv_observer_remove(hub->observer);
+    *hub = ObserverHub{};
+}
+
+/// Subscribe a pool node owned by `owner` (Component::subscribe())
+[[nodiscard]] inline bool subscribe_pooled(lv_subject_t* subject, void (*fn)(void*, lv_subject_t*),
+                                           void* target, const void* owner) noexcept {
+    SubscriptionPool& p = subscription_pool();
+    SubNode* n = p.free;
+    if (!n) {
+        LV_LOG_WARN("subscription pool exhausted, raise LV_CPP_SUBSCRIPTION_POOL");
+        return false;
+    }
+    p.free = n->next;
+    *n = SubNode{};
+    n->fn = fn;
+    n->target = target;
+    n->owner = owner;
+    ++p.pooled;
+    if (subscribe_node(subject, *n)) return true;
+    n->owner = nullptr;
+    n->next = p.free;
+    p.free = n;
+    --p.pooled;
+    return false;
+}
+
+/// Unsubscribe and return every pool node of `owner`
+inline void unsubscribe_owner(const void* owner) noexcept {
+    SubscriptionPool& p = subscription_pool();
+    for (SubNode& n : p.nodes) {
+        if (p.pooled == 0) return;
+        if (n.owner != owner) continue;
+        unlink(n);
+        n = SubNode{};
+        n.next = p.free;
+        p.free = &n;
+        --p.pooled;
+    }
+}
+
+/// Move the pool nodes of a moved component to its new address
+inline void rebind_owner(const void* from, const void* to, void* target) noexcept {
+    SubscriptionPool& p = subscription_pool();
+    if (p.pooled == 0) return;
+    for (SubNode& n : p.nodes) {
+        if (n.owner != from) continue;
+        n.owner = to;
+        n.target = target;
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Owning handle of one subscription; unsubscribes when destroyed or reset
+ *
+ * The node lives inside the handle, so subscribing allocates nothing.
+ * Movable (the node is relinked, the callback target stays the same),
+ * not copyable.
+ */
+class Subscription {
+    detail::SubNode m_node;
+
+public:
+    Subscription() noexcept = default;
+
+    /// Subscribe `fn(target, subject)` to `subject` (inactive if the hubs are exhausted)
+    Subscription(lv_subject_t* subject, void (*fn)(void* target, lv_subject_t* subject), void* target) noexcept {
+        m_node.fn = fn;
+        m_node.target = target;
+        if (!detail::subscribe_node(subject, m_node)) m_node = detail::SubNode{};
+    }
+
+    ~Subscription() { reset(); }
+
+    Subscription(const Subscription&) = delete;
+    Subscription& operator=(const Subscription&) = delete;
+
+    Subscription(Subscription&& other) noexcept { detail::relink(other.m_node, m_node); }
+
+    Subscription& operator=(Subscription&& other) noexcept {
+        if (this != &other) {
+            reset();
+            detail::relink(other.m_node, m_node);
+        }
+        return *this;
+    }
+
+    /// Unsubscribe now
+    void reset() noexcept {
+        detail::unlink(m_node);
+        m_node = detail::SubNode{};
+    }
+
+    /// Subscribed to a live subject
+    [[nodiscard]] bool active() const noexcept { return m_node.hub != nullptr; }
+
+    explicit operator bool() const noexcept { return active(); }
+};
+
+/// Pooled subscriptions in use (Component::subscribe())
+[[nodiscard]] inline uint32_t pooled_subscriptions() noexcept { return detail::subscription_pool().pooled; }
+
+} // namespace lv
+
+#endif // LV_USE_OBSERVER
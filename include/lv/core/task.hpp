@@ -0,0 +1,505 @@
+#pragma once
+
+/**
+ * @file task.hpp
+ * @brief C++20 coroutines scheduled on the LVGL timer loop
+ *
+ * lv::Task turns multi-step UI flows into straight-line code. Every
+ * suspension point is an LVGL timer, display event or animation callback,
+ * so coroutines always resume on the LVGL thread and never block it.
+ *
+ * Awaitables:
+ * - lv::next_frame()        resume after the next display refresh
+ * - lv::sleep_for(ms)       resume after a delay (one-shot lv_timer)
+ * - co_await anim           start an Anim and resume when it is deleted
+ * - co_await timeline       start an AnimTimeline and resume when it ends
+ * - co_await file.read_async(buf, n)   chunked read, one chunk per tick
+ * - co_await other_task     resume when another Task completes
+ * - lv::yield_if_over_budget()   resume in the slack of a later frame (idle.hpp)
+ *
+ * Coroutine frames are allocated from a fixed-size FramePool, never from
+ * the general heap. If the pool is exhausted the returned Task is empty
+ * (valid() == false) and the coroutine body does not run.
+ *
+ * Usage:
+ * @code
+ * lv::Task build_dashboard(lv::ObjectView parent) {
+ *     for (int i = 0; i < 200; ++i) {
+ *         make_tile(parent, i);
+ *         if (i % 20 == 19) co_await lv::next_frame();  // spread over frames
+ *     }
+ *     co_await lv::anim_opa(parent, 0, 255).duration(300);
+ *     co_await lv::sleep_for(2000);
+ *     hide_splash();
+ * }
+ *
+ * build_dashboard(lv::screen_active()).detach();
+ * @endcode
+ */
+
+#include <lvgl.h>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <utility>
+#include "anim.hpp"
+#include "anim_timeline.hpp"
+
+/// Size of one coroutine frame block in the default pool (bytes)
+#ifndef LV_CPP_TASK_FRAME_SIZE
+#define LV_CPP_TASK_FRAME_SIZE 512
+#endif
+
+/// Number of frame blocks in the default pool
+#ifndef LV_CPP_TASK_FRAME_COUNT
+#define LV_CPP_TASK_FRAME_COUNT 16
+#endif
+
+namespace lv {
+
+// ==================== Frame Allocation ====================
+
+/**
+ * @brief Fixed-size block pool for coroutine frames
+ *
+ * Intrusive free list over statically sized storage; allocation and
+ * release are O(1). Requests larger than BlockSize fail (return nullptr).
+ */
+template<size_t BlockSize, size_t BlockCount>
+class FramePool {
+    union Block {
+        Block* next;
+        alignas(std::max_align_t) unsigned char bytes[BlockSize];
+    };
+
+    Block m_blocks[BlockCount];
+    Block* m_free = nullptr;
+    size_t m_used = 0;
+
+public:
+    FramePool() noexcept {
+        for (size_t i = 0; i < BlockCount; ++i) {
+            m_blocks[i].next = m_free;
+            m_free = &m_blocks[i];
+        }
+    }
+
+    FramePool(const FramePool&) = delete;
+    FramePool& operator=(const FramePool&) = delete;
+
+    /// Take a block, or nullptr if exhausted or size > BlockSize
+    [[nodiscard]] void* allocate(size_t size) noexcept {
+        if (size > BlockSize || !m_free) return nullptr;
+        Block* b = m_free;
+        m_free = b->next;
+        ++m_used;
+        return b->bytes;
+    }
+
+    /// Return a block obtained from allocate()
+    void deallocate(void* p) noexcept {
+        if (!p) return;
+        auto* b = static_cast<Block*>(p);
+        b->next = m_free;
+        m_free = b;
+        --m_used;
+    }
+
+    [[nodiscard]] static constexpr size_t block_size() noexcept { return BlockSize; }
+    [[nodiscard]] static constexpr size_t capacity() noexcept { return BlockCount; }
+    [[nodiscard]] size_t used() const noexcept { return m_used; }
+};
+
+/**
+ * @brief Pluggable allocator for coroutine frames
+ *
+ * Install once at startup, before any Task is created.
+ */
+struct TaskAllocator {
+    void* (*alloc)(void* ctx, size_t size) noexcept;
+    void (*free)(void* ctx, void* p, size_t size) noexcept;
+    void* ctx;
+};
+
+/// Default frame pool used when no allocator was installed
+using DefaultFramePool = FramePool<LV_CPP_TASK_FRAME_SIZE, LV_CPP_TASK_FRAME_COUNT>;
+
+namespace detail {
+
+template<typename Pool>
+[[nodiscard]] inline TaskAllocator pool_allocator(Pool& pool) noexcept {
+    return TaskAllocator{
+        [](void* ctx, size_t size) noexcept -> void* {
+            return static_cast<Pool*>(ctx)->allocate(size);
+        },
+        [](void* ctx, void* p, size_t) noexcept {
+            static_cast<Pool*>(ctx)->deallocate(p);
+        },
+        &pool
+    };
+}
+
+[[nodiscard]] inline DefaultFramePool& default_frame_pool() noexcept {
+    static DefaultFramePool pool;
+    return pool;
+}
+
+[[nodiscard]] inline TaskAllocator& task_allocator() noexcept {
+    static TaskAllocator allocator = pool_allocator(default_frame_pool());
+    return allocator;
+}
+
+} // namespace detail
+
+/// Install a custom frame allocator (call before creating any Task)
+inline void set_task_allocator(const TaskAllocator& allocator) noexcept {
+    detail::task_allocator() = allocator;
+}
+
+/// Allocate coroutine frames from the given pool (call before creating any Task)
+template<size_t BlockSize, size_t BlockCount>
+inline void use_task_pool(FramePool<BlockSize, BlockCount>& pool) noexcept {
+    detail::task_allocator() = detail::pool_allocator(pool);
+}
+
+// ==================== Task ====================
+
+/**
+ * @brief Eagerly started coroutine running on the LVGL thread
+ *
+ * The body runs synchronously until its first suspension. The Task object
+ * owns the frame: destroying it cancels the coroutine (pending timers and
+ * callbacks are released by the awaiters' destructors). Call detach() for
+ * fire-and-forget coroutines that clean up on completion.
+ *
+ * Move-only, sizeof(void*).
+ */
+class [[nodiscard]] Task {
+public:
+    struct promise_type;
+    using handle_type = std::coroutine_handle<promise_type>;
+
+private:
+    struct FinalAwaiter {
+        [[nodiscard]] bool await_ready() const noexcept { return false; }
+
+        std::coroutine_handle<> await_suspend(handle_type h) noexcept {
+            promise_type& p = h.promise();
+            if (p.continuation) return p.continuation;
+            if (p.detached) h.destroy();
+            return std::noop_coroutine();
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+public:
+    struct promise_type {
+        std::coroutine_handle<> continuation;
+        bool detached = false;
+
+        static void* operator new(size_t size) noexcept {
+            TaskAllocator& a = detail::task_allocator();
+            return a.alloc(a.ctx, size);
+        }
+
+        static void operator delete(void* p, size_t size) noexcept {
+            TaskAllocator& a = detail::task_allocator();
+            a.free(a.ctx, p, size);
+        }
+
+        /// Frame allocation failed: return an empty Task, body never runs
+        static Task get_return_object_on_allocation_failure() noexcept { return Task(); }
+
+        Task get_return_object() noexcept { return Task(handle_type::from_promise(*this)); }
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+        FinalAwaiter final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept { std::terminate(); }
+    };
+
+private:
+    handle_type m_handle;
+
+    explicit Task(handle_type h) noexcept : m_handle(h) {}
+
+public:
+    /// Empty task (allocation failure or moved-from)
+    Task() noexcept = default;
+
+    ~Task() {
+        if (m_handle) m_handle.destroy();
+    }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    Task(Task&& other) noexcept : m_handle(std::exchange(other.m_handle, {})) {}
+
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            if (m_handle) m_handle.destroy();
+            m_handle = std::exchange(other.m_handle, {});
+        }
+        return *this;
+    }
+
+    /// Check whether a coroutine frame was allocated
+    [[nodiscard]] bool valid() const noexcept { return static_cast<bool>(m_handle); }
+    explicit operator bool() const noexcept { return valid(); }
+
+    /// Check whether the coroutine ran to completion
+    [[nodiscard]] bool done() const noexcept { return !m_handle || m_handle.done(); }
+
+    /// Cancel: destroy the frame at its current suspension point
+    void cancel() noexcept {
+        if (m_handle) {
+            m_handle.destroy();
+            m_handle = {};
+        }
+    }
+
+    /// Release ownership; the frame frees itself when the coroutine finishes
+    void detach() noexcept {
+        if (!m_handle) return;
+        if (m_handle.done()) {
+            m_handle.destroy();
+        } else {
+            m_handle.promise().detached = true;
+        }
+        m_handle = {};
+    }
+
+    /// Awaiting a Task resumes the awaiting coroutine when it completes
+    [[nodiscard]] auto operator co_await() const noexcept {
+        struct Awaiter {
+            handle_type h;
+            [[nodiscard]] bool await_ready() const noexcept { return !h || h.done(); }
+            void await_suspend(std::coroutine_handle<> parent) const noexcept {
+                h.promise().continuation = parent;
+            }
+            void await_resume() const noexcept {}
+        };
+        return Awaiter{m_handle};
+    }
+};
+
+static_assert(sizeof(Task) == sizeof(void*), "Task must be pointer-sized");
+
+// ==================== Awaitables ====================
+
+/**
+ * @brief Awaitable that resumes after a delay
+ *
+ * Backed by a one-shot lv_timer; destroying a suspended coroutine deletes
+ * the pending timer.
+ */
+class SleepAwaiter {
+    uint32_t m_ms;
+    lv_timer_t* m_timer = nullptr;
+    std::coroutine_handle<> m_handle;
+
+    static void timer_cb(lv_timer_t* t) noexcept {
+        auto* self = static_cast<SleepAwaiter*>(lv_timer_get_user_data(t));
+        std::coroutine_handle<> h = self->m_handle;
+        self->m_timer = nullptr;
+        lv_timer_delete(t);
+        h.resume();
+    }
+
+public:
+    explicit SleepAwaiter(uint32_t ms) noexcept : m_ms(ms) {}
+    ~SleepAwaiter() {
+        if (m_timer) lv_timer_delete(m_timer);
+    }
+
+    SleepAwaiter(const SleepAwaiter&) = delete;
+    SleepAwaiter& operator=(const SleepAwaiter&) = delete;
+
+    [[nodiscard]] bool await_ready() const noexcept { return false; }
+
+    bool await_suspend(std::coroutine_handle<> h) noexcept {
+        m_handle = h;
+        m_timer = lv_timer_create(&SleepAwaiter::timer_cb, m_ms, this);
+        return m_timer != nullptr;  // timer allocation failed: continue immediately
+    }
+
+    void await_resume() const noexcept {}
+};
+
+/// Resume the coroutine after `ms` milliseconds
+[[nodiscard]] inline SleepAwaiter sleep_for(uint32_t ms) noexcept {
+    return SleepAwaiter(ms);
+}
+
+/**
+ * @brief Awaitable that resumes after the next display refresh
+ *
+ * Listens for LV_EVENT_REFR_READY on the display. If the refresh timer is
+ * paused (e.g. by EventLoop::idle_refresh) it is resumed so a frame happens.
+ */
+class NextFrameAwaiter {
+    lv_display_t* m_disp;
+    std::coroutine_handle<> m_handle;
+    bool m_pending = false;
+
+    static void refr_ready_cb(lv_event_t* e) noexcept {
+        auto* self = static_cast<NextFrameAwaiter*>(lv_event_get_user_data(e));
+        std::coroutine_handle<> h = self->m_handle;
+        self->unregister();
+        h.resume();
+    }
+
+    void unregister() noexcept {
+        if (!m_pending) return;
+        lv_display_remove_event_cb_with_user_data(m_disp, &NextFrameAwaiter::refr_ready_cb, this);
+        m_pending = false;
+    }
+
+public:
+    explicit NextFrameAwaiter(lv_display_t* disp) noexcept
+        : m_disp(disp ? disp : lv_display_get_default()) {}
+    ~NextFrameAwaiter() { unregister(); }
+
+    NextFrameAwaiter(const NextFrameAwaiter&) = delete;
+    NextFrameAwaiter& operator=(const NextFrameAwaiter&) = delete;
+
+    [[nodiscard]] bool await_ready() const noexcept { return m_disp == nullptr; }
+
+    void await_suspend(std::coroutine_handle<> h) noexcept {
+        m_handle = h;
+        lv_display_add_event_cb(m_disp, &NextFrameAwaiter::refr_ready_cb, LV_EVENT_REFR_READY, this);
+        m_pending = true;
+        if (lv_timer_t* t = lv_display_get_refr_timer(m_disp)) lv_timer_resume(t);
+    }
+
+    void await_resume() const noexcept {}
+};
+
+/// Resume the coroutine after the next refresh of `disp` (nullptr = default display)
+[[nodiscard]] inline NextFrameAwaiter next_frame(lv_display_t* disp = nullptr) noexcept {
+    return NextFrameAwaiter(disp);
+}
+
+/**
+ * @brief Awaitable that starts an Anim and resumes when LVGL deletes it
+ *
+ * Resumes on completion, and also if the animation is deleted early (for
+ * example because its target object was deleted). The animation's
+ * user_data and callbacks are left intact; a deleted_cb set on the Anim is
+ * chained. Pending awaiters are kept in an intrusive list (no allocation).
+ */
+class AnimAwaiter {
+    lv_anim_t m_anim;
+    lv_anim_t* m_running = nullptr;
+    lv_anim_deleted_cb_t m_user_deleted_cb = nullptr;
+    std::coroutine_handle<> m_handle;
+    AnimAwaiter* m_next = nullptr;
+
+    static AnimAwaiter*& pending() noexcept {
+        static AnimAwaiter* head = nullptr;
+        return head;
+    }
+
+    void unlink() noexcept {
+        for (AnimAwaiter** p = &pending(); *p; p = &(*p)->m_next) {
+            if (*p == this) {
+                *p = m_next;
+                break;
+            }
+        }
+        m_next = nullptr;
+        m_running = nullptr;
+    }
+
+    static void deleted_cb(lv_anim_t* a) noexcept {
+        for (AnimAwaiter* w = pending(); w; w = w->m_next) {
+            if (w->m_running != a) continue;
+            lv_anim_deleted_cb_t user_cb = w->m_user_deleted_cb;
+            std::coroutine_handle<> h = w->m_handle;
+            w->unlink();
+            if (user_cb) user_cb(a);
+            h.resume();
+            return;
+        }
+    }
+
+public:
+    explicit AnimAwaiter(const lv_anim_t& anim) noexcept : m_anim(anim) {}
+    ~AnimAwaiter() {
+        if (m_running) unlink();
+    }
+
+    AnimAwaiter(const AnimAwaiter&) = delete;
+    AnimAwaiter& operator=(const AnimAwaiter&) = delete;
+
+    [[nodiscard]] bool await_ready() const noexcept { return false; }
+
+    bool await_suspend(std::coroutine_handle<> h) noexcept {
+        m_handle = h;
+        m_user_deleted_cb = m_anim.deleted_cb;
+        lv_anim_set_deleted_cb(&m_anim, &AnimAwaiter::deleted_cb);
+        m_running = lv_anim_start(&m_anim);
+        if (!m_running) return false;
+        m_next = pending();
+        pending() = this;
+        return true;
+    }
+
+    void await_resume() const noexcept {}
+};
+
+/// Start the animation and resume when it has finished
+[[nodiscard]] inline AnimAwaiter operator co_await(const Anim& anim) noexcept {
+    return AnimAwaiter(*anim.get());
+}
+
+/**
+ * @brief Awaitable that starts an AnimTimeline and resumes when it ends
+ *
+ * LVGL timelines have no completion callback, so a timer polls (once per
+ * refresh period) for the timeline's internal animation to disappear.
+ */
+class TimelineAwaiter {
+    lv_anim_timeline_t* m_timeline;
+    lv_timer_t* m_timer = nullptr;
+    std::coroutine_handle<> m_handle;
+
+    static void poll_cb(lv_timer_t* t) noexcept {
+        auto* self = static_cast<TimelineAwaiter*>(lv_timer_get_user_data(t));
+        if (lv_anim_get(self->m_timeline, nullptr)) return;
+        std::coroutine_handle<> h = self->m_handle;
+        self->m_timer = nullptr;
+        lv_timer_delete(t);
+        h.resume();
+    }
+
+public:
+    explicit TimelineAwaiter(lv_anim_timeline_t* timeline) noexcept : m_timeline(timeline) {}
+    ~TimelineAwaiter() {
+        if (m_timer) lv_timer_delete(m_timer);
+    }
+
+    TimelineAwaiter(const TimelineAwaiter&) = delete;
+    TimelineAwaiter& operator=(const TimelineAwaiter&) = delete;
+
+    [[nodiscard]] bool await_ready() const noexcept { return m_timeline == nullptr; }
+
+    bool await_suspend(std::coroutine_handle<> h) noexcept {
+        m_handle = h;
+        lv_anim_timeline_start(m_timeline);
+        if (!lv_anim_get(m_timeline, nullptr)) return false;  // zero-length timeline
+        m_timer = lv_timer_create(&TimelineAwaiter::poll_cb, LV_DEF_REFR_PERIOD, this);
+        return m_timer != nullptr;
+    }
+
+    void await_resume() const noexcept {}
+};
+
+/// Start the timeline and resume when playback has finished
+[[nodiscard]] inline TimelineAwaiter operator co_await(AnimTimeline& timeline) noexcept {
+    return TimelineAwaiter(timeline.get());
+}
+
+} // namespace lv
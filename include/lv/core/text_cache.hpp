@@ -0,0 +1,333 @@
+#pragma once
+
+/**
+ * @file text_cache.hpp
+ * @brief Cached text measurement
+ *
+ * lv_text_get_size() walks the whole string through the line-break
+ * algorithm on every call, and status tables and flex layouts measure the
+ * same strings over and over. text_cache keeps the result in a small LRU
+ * table keyed by (font, text hash and length, max width, letter space,
+ * line space, flags):
+ *
+ * @code
+ * lv_point_t sz = lv::text_cache::measure(font, "Battery 87 %", 0, 0, 120);
+ * lv_point_t wrapped = lv::text_cache::layout(label, label.get_text(), 120).size;
+ * @endcode
+ *
+ * With text_lines.hpp (opt-in) installed, layouts also keep the line
+ * breaks (Layout::lines).
+ *
+ * Label::text_size() and Label::measure(), Table::cell_text_size() and
+ * Spangroup::span_text_size() go through the cache. Label::text(),
+ * Table::cell_value() and Spangroup::span_text() also skip setting a text
+ * equal to the current one, which otherwise makes LVGL lay the widget out
+ * again (and restarts a label's scroll animation); stats().unchanged
+ * counts those.
+ *
+ * set_label_text_fmt() formats into a stack buffer and only sets the text
+ * if it differs; bound label texts (Label::bind_text()) update through it,
+ * so a value that formats to the same string (a float rounded to one
+ * decimal, a clamped percentage) costs no realloc and no invalidation.
+ *
+ * Entries are keyed by the font pointer: drop(font) before freeing a font
+ * whose address may be reused.
+ *
+ * Heap allocation: NONE in the wrapper (fixed table; with text_lines.hpp,
+ * one lv_malloc per cached layout of more than LV_CPP_TEXT_CACHE_LINES
+ * lines)
+ */
+
+#include <lvgl.h>
+#include <cstdarg>
+#include <cstdint>
+#include <cstring>
+#include "frame_arena.hpp"
+#include "object.hpp"
+
+#ifndef LV_CPP_TEXT_CACHE
+/// Cached layouts (distinct text / font / width combinations)
+#define LV_CPP_TEXT_CACHE 64
+#endif
+
+#ifndef LV_CPP_TEXT_CACHE_LINES
+/// Line breaks stored in the entry itself; longer texts allocate
+#define LV_CPP_TEXT_CACHE_LINES 4
+#endif
+
+#ifndef LV_CPP_TEXT_FMT_BUF
+/// Stack buffer set_label_text_fmt() formats into (longer texts use FrameArena)
+#define LV_CPP_TEXT_FMT_BUF 64
+#endif
+
+namespace lv::text_cache {
+
+struct Stats {
+    uint32_t entries;
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+    uint32_t unchanged;    ///< Text sets skipped because the text did not change
+};
+
+/// One line of a layout
+struct Line {
+    uint32_t start;    ///< Byte offset in the text
+    uint32_t len;      ///< Bytes, including the break character
+    int32_t width;     ///< Pixels
+};
+
+/// Size and line breaks of a text; `lines` is valid until the next call into text_cache
+/// and empty (line_cnt 0) unless text_lines.hpp is installed
+struct Layout {
+    lv_point_t size;
+    uint32_t line_cnt;
+    const Line* lines;
+};
+
+namespace detail {
+
+struct Key {
+    const lv_font_t* font;
+    uint64_t hash;
+    uint32_t len;
+    int32_t max_width;
+    int32_t letter_space;
+    int32_t line_space;
+    uint32_t flags;
+
+    [[nodiscard]] bool operator==(const Key&) const noexcept = default;
+};
+
+struct Entry {
+    Key key;
+    lv_point_t size;
+    uint32_t line_cnt;
+    Line inline_lines[LV_CPP_TEXT_CACHE_LINES];
+    Line* heap_lines;     ///< lv_malloc'd when line_cnt > LV_CPP_TEXT_CACHE_LINES
+    uint32_t used;        ///< LRU stamp (0: free)
+};
+
+struct Tables {
+    Entry entries[LV_CPP_TEXT_CACHE];
+    uint32_t clock = 0;
+    Stats stats{};
+};
+
+[[nodiscard]] inline Tables& tables() noexcept {
+    static Tables t;
+    return t;
+}
+
+/// 64-bit FNV-1a of the text; also returns its length
+[[nodiscard]] inline uint64_t hash(const char* text, uint32_t& len) noexcept {
+    uint64_t h = 0xCBF29CE484222325ull;
+    const char* p = text;
+    for (; *p; ++p) {
+        h ^= static_cast<uint8_t>(*p);
+        h *= 0x100000001B3ull;
+    }
+    len = static_cast<uint32_t>(p - text);
+    return h;
+}
+
+/// Splits the next line off a text (set up by text_lines::install(), text_lines.hpp)
+using LineBreaker = uint32_t (*)(const char* text, uint32_t len, const Key& k, int32_t* width);
+
+[[nodiscard]] inline LineBreaker& line_breaker() noexcept {
+    static LineBreaker f = nullptr;
+    return f;
+}
+
+inline void free_entry(Tables& t, Entry& e) noexcept {
+    if (e.used) --t.stats.entries;
+    lv_free(e.heap_lines);
+    e = Entry{};
+}
+
+/// Free entry, else the least recently used one
+[[nodiscard]] inline Entry& victim(Tables& t) noexcept {
+    Entry* v = &t.entries[0];
+    for (Entry& e : t.entries) {
+        if (!e.used) return e;
+        if (e.used < v->used) v = &e;
+    }
+    ++t.stats.evictions;
+    return *v;
+}
+
+/// Measure `text` and store its lines in `e` (if a line breaker is set)
+inline void fill(Entry& e, const char* text) noexcept {
+    const Key& k = e.key;
+    lv_text_get_size(&e.size, text, k.font, k.letter_space, k.line_space, k.max_width,
+                     static_cast<lv_text_flag_t>(k.flags));
+    const LineBreaker next_line = line_breaker();
+    e.line_cnt = 0;
+    if (!next_line) return;
+
+    // Count first so long texts allocate once
+    uint32_t cnt = 0;
+    for (uint32_t pos = 0; pos < k.len;) {
+        int32_t w = 0;
+        const uint32_t n = next_line(text + pos, k.len - pos, k, &w);
+        if (n == 0) break;
+        pos += n;
+        ++cnt;
+    }
+    Line* lines = e.inline_lines;
+    if (cnt > LV_CPP_TEXT_CACHE_LINES) {
+        e.heap_lines = static_cast<Line*>(lv_malloc(cnt * sizeof(Line)));
+        if (!e.heap_lines) cnt = LV_CPP_TEXT_CACHE_LINES;    // size stays exact, lines truncated
+        else lines = e.heap_lines;
+    }
+    uint32_t i = 0;
+    for (uint32_t pos = 0; pos < k.len && i < cnt; ++i) {
+        int32_t w = 0;
+        const uint32_t n = next_line(text + pos, k.len - pos, k, &w);
+        if (n == 0) break;
+        lines[i] = Line{pos, n, w};
+        pos += n;
+    }
+    e.line_cnt = i;
+}
+
+} // namespace detail
+
+/**
+ * @brief Size and line breaks of `text` as lv_text_get_size() would compute them
+ *
+ * @param max_width Wrap width; LV_COORD_MAX for no wrapping
+ */
+[[nodiscard]] inline Layout layout(const lv_font_t* font, const char* text, int32_t letter_space,
+                                   int32_t line_space, int32_t max_width = LV_COORD_MAX,
+                                   lv_text_flag_t flags = LV_TEXT_FLAG_NONE) noexcept {
+    if (!font || !text) return Layout{{0, 0}, 0, nullptr};
+    detail::Tables& t = detail::tables();
+    detail::Key k;
+    std::memset(&k, 0, sizeof(k));
+    k.font = font;
+    k.hash = detail::hash(text, k.len);
+    k.max_width = max_width;
+    k.letter_space = letter_space;
+    k.line_space = line_space;
+    k.flags = static_cast<uint32_t>(flags);
+
+    for (detail::Entry& e : t.entries) {
+        if (e.used && e.key == k) {
+            ++t.stats.hits;
+            e.used = ++t.clock;
+            return Layout{e.size, e.line_cnt, e.heap_lines ? e.heap_lines : e.inline_lines};
+        }
+    }
+    ++t.stats.misses;
+    detail::Entry& e = detail::victim(t);
+    detail::free_entry(t, e);
+    e.key = k;
+    detail::fill(e, text);
+    e.used = ++t.clock;
+    ++t.stats.entries;
+    return Layout{e.size, e.line_cnt, e.heap_lines ? e.heap_lines : e.inline_lines};
+}
+
+/// Size of `text` (cached lv_text_get_size())
+[[nodiscard]] inline lv_point_t measure(const lv_font_t* font, const char* text, int32_t letter_space,
+                                        int32_t line_space, int32_t max_width = LV_COORD_MAX,
+                                        lv_text_flag_t flags = LV_TEXT_FLAG_NONE) noexcept {
+    return layout(font, text, letter_space, line_space, max_width, flags).size;
+}
+
+/// Layout of `text` with the font and spacing styles of `obj`'s `part`
+[[nodiscard]] inline Layout layout(ObjectView obj, const char* text, int32_t max_width = LV_COORD_MAX,
+                                   lv_part_t part = LV_PART_MAIN,
+                                   lv_text_flag_t flags = LV_TEXT_FLAG_NONE) noexcept {
+    lv_obj_t* o = obj.get();
+    return layout(lv_obj_get_style_text_font(o, part), text, lv_obj_get_style_text_letter_space(o, part),
+                  lv_obj_get_style_text_line_space(o, part), max_width, flags);
+}
+
+/// Forget layouts measured with `font` (before freeing it)
+inline void drop(const lv_font_t* font) noexcept {
+    detail::Tables& t = detail::tables();
+    for (detail::Entry& e : t.entries) {
+        if (e.used && e.key.font == font) detail::free_entry(t, e);
+    }
+}
+
+/// Forget every layout
+inline void drop() noexcept {
+    detail::Tables& t = detail::tables();
+    for (detail::Entry& e : t.entries) detail::free_entry(t, e);
+}
+
+[[nodiscard]] inline Stats stats() noexcept { return detail::tables().stats; }
+
+inline void reset_stats() noexcept {
+    Stats& s = detail::tables().stats;
+    s = Stats{s.entries, 0, 0, 0, 0};
+}
+
+/**
+ * @brief True if `next` equals the widget's `current` text (counted in stats().unchanged)
+ *
+ * For wrappers skipping a set that would only re-lay out the same text.
+ */
+[[nodiscard]] inline bool unchanged(const char* current, const char* next) noexcept {
+    // Same pointer is LVGL's "refresh" idiom: never skip it
+    if (!current || !next || current == next || std::strcmp(current, next) != 0) return false;
+    ++detail::tables().stats.unchanged;
+    return true;
+}
+
+#if LV_USE_LABEL
+/// printf-style set of `label`'s text, skipped if the result equals the current text; true if set
+inline bool set_label_text_vfmt(lv_obj_t* label, const char* fmt, va_list args) noexcept {
+    char buf[LV_CPP_TEXT_FMT_BUF];
+    va_list again;
+    va_copy(again, args);
+    const int n = lv_vsnprintf(buf, sizeof(buf), fmt, args);
+    bool set = false;
+    if (n >= 0 && static_cast<size_t>(n) < sizeof(buf)) {
+        set = !unchanged(lv_label_get_text(label), buf);
+        if (set) lv_label_set_text(label, buf);
+    } else if (n >= 0) {
+        FrameArena& arena = FrameArena::instance();
+        const FrameArena::Marker mark = arena.mark();
+        if (const char* s = arena.vformat(fmt, again)) {
+            set = !unchanged(lv_label_get_text(label), s);
+            if (set) lv_label_set_text(label, s);
+        }
+        arena.rewind(mark);
+    }
+    va_end(again);
+    return set;
+}
+
+inline bool set_label_text_fmt(lv_obj_t* label, const char* fmt, ...) noexcept {
+    va_list args;
+    va_start(args, fmt);
+    const bool set = set_label_text_vfmt(label, fmt, args);
+    va_end(args);
+    return set;
+}
+
+#if LV_USE_OBSERVER
+namespace detail {
+
+/// Observer of an integer subject bound to a label (user data: the format)
+inline void bound_int_text_cb(lv_observer_t* observer, lv_subject_t* subject) noexcept {
+    set_label_text_fmt(lv_observer_get_target_obj(observer),
+                       static_cast<const char*>(lv_observer_get_user_data(observer)),
+                       static_cast<int>(lv_subject_get_int(subject)));
+}
+
+} // namespace detail
+
+/// lv_label_bind_text() for integer subjects, skipping updates that format to the current text
+inline lv_observer_t* bind_label_int_text(lv_obj_t* label, lv_subject_t* subject, const char* fmt) noexcept {
+    return lv_subject_add_observer_obj(subject, &detail::bound_int_text_cb, label,
+                                       const_cast<char*>(fmt ? fmt : "%d"));
+}
+#endif
+#endif
+
+} // namespace lv::text_cache
@@ -0,0 +1,259 @@
+#pragma once
+
+/**
+ * @file text_document.hpp
+ * @brief Gap-buffer text storage with a paragraph index for large documents
+ *
+ * lv_textarea keeps its text as one string inside its label: every edit
+ * moves the tail of the string and re-lays out the whole label. TextDocument
+ * keeps the text in a gap buffer, so typing at one place costs only the
+ * inserted bytes; moving the edit point moves the bytes in between once.
+ * A sorted array of paragraph start offsets ('\n' separated) is patched on
+ * every edit, so line_of(pos) is a binary search and the text of one
+ * paragraph can be read without touching the rest.
+ *
+ * @code
+ * lv::TextDocument doc;
+ * doc.assign(config_text);
+ * doc.insert(doc.line_start(12), "timeout=30\n");
+ * doc.erase(pos, 5);
+ * doc.for_each_chunk([&](std::string_view part) { file.write(part.data(), part.size()); });
+ * @endcode
+ *
+ * Offsets are bytes of UTF-8 text. TextEditor (widgets/text_editor.hpp)
+ * shows a document with only the visible paragraphs laid out.
+ *
+ * Heap allocation: the gap buffer and the paragraph index (lv_malloc,
+ * doubling); nothing per edit once they are large enough
+ */
+
+#include <lvgl.h>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace lv {
+
+class TextDocument {
+    char* m_buf = nullptr;
+    uint32_t m_cap = 0;
+    uint32_t m_gap = 0;          ///< First byte of the gap
+    uint32_t m_gap_end = 0;      ///< First byte after the gap
+    uint32_t* m_lines = nullptr; ///< Paragraph start offsets; [0] is always 0
+    uint32_t m_line_cnt = 0;
+    uint32_t m_line_cap = 0;
+    uint32_t m_version = 0;
+
+    [[nodiscard]] uint32_t gap_len() const noexcept { return m_gap_end - m_gap; }
+
+    [[nodiscard]] char byte(uint32_t pos) const noexcept { return m_buf[pos < m_gap ? pos : pos + gap_len()]; }
+
+    void move_gap(uint32_t pos) noexcept {
+        if (pos < m_gap) {
+            const uint32_t n = m_gap - pos;
+            std::memmove(m_buf + m_gap_end - n, m_buf + pos, n);
+            m_gap = pos;
+            m_gap_end -= n;
+        } else if (pos > m_gap) {
+            const uint32_t n = pos - m_gap;
+            std::memmove(m_buf + m_gap, m_buf + m_gap_end, n);
+            m_gap += n;
+            m_gap_end += n;
+        }
+    }
+
+    [[nodiscard]] bool reserve_gap(uint32_t need) noexcept {
+        if (gap_len() >= need) return true;
+        const uint32_t used = size();
+        uint32_t cap = m_cap ? m_cap * 2 : 256;
+        while (cap - used < need) cap *= 2;
+        auto* buf = static_cast<char*>(lv_malloc(cap));
+        if (!buf) return false;
+        const uint32_t tail = m_cap - m_gap_end;
+        if (m_buf) {
+            std::memcpy(buf, m_buf, m_gap);
+            std::memcpy(buf + cap - tail, m_buf + m_gap_end, tail);
+            lv_free(m_buf);
+        }
+        m_buf = buf;
+        m_gap_end = cap - tail;
+        m_cap = cap;
+        return true;
+    }
+
+    [[nodiscard]] bool reserve_lines(uint32_t n) noexcept {
+        if (n <= m_line_cap) return true;
+        uint32_t cap = m_line_cap ? m_line_cap * 2 : 64;
+        while (cap < n) cap *= 2;
+        auto* lines = static_cast<uint32_t*>(lv_realloc(m_lines, sizeof(uint32_t) * cap));
+        if (!lines) return false;
+        m_lines = lines;
+        m_line_cap = cap;
+        return true;
+    }
+
+    [[nodiscard]] static uint32_t count_newlines(std::string_view text) noexcept {
+        uint32_t n = 0;
+        for (const char c : text) n += c == '\n';
+        return n;
+    }
+
+public:
+    TextDocument() noexcept { clear(); }
+
+    explicit TextDocument(std::string_view text) noexcept { assign(text); }
+
+    ~TextDocument() {
+        lv_free(m_buf);
+        lv_free(m_lines);
+    }
+
+    TextDocument(const TextDocument&) = delete;
+    TextDocument& operator=(const TextDocument&) = delete;
+
+    // ==================== Edits ====================
+
+    /// Replace the whole text
+    bool assign(std::string_view text) noexcept {
+        clear();
+        return insert(0, text);
+    }
+
+    void clear() noexcept {
+        m_gap = 0;
+        m_gap_end = m_cap;
+        if (reserve_lines(1)) {
+            m_lines[0] = 0;
+            m_line_cnt = 1;
+        }
+        ++m_version;
+    }
+
+    /**
+     * @brief Insert `text` at byte `pos` (clamped to size())
+     * @return false if out of memory (the document is unchanged)
+     */
+    bool insert(uint32_t pos, std::string_view text) noexcept {
+        if (text.empty()) return true;
+        if (pos > size()) pos = size();
+        const auto len = static_cast<uint32_t>(text.size());
+        const uint32_t nl = count_newlines(text);
+        if (!reserve_gap(len) || !reserve_lines(m_line_cnt + nl)) return false;
+        move_gap(pos);
+        std::memcpy(m_buf + m_gap, text.data(), len);
+        m_gap += len;
+
+        // Shift later paragraphs and open slots for the new ones after line_of(pos)
+        const uint32_t line = line_of(pos);
+        for (uint32_t i = line + 1; i < m_line_cnt; ++i) m_lines[i] += len;
+        if (nl) {
+            std::memmove(m_lines + line + 1 + nl, m_lines + line + 1, sizeof(uint32_t) * (m_line_cnt - line - 1));
+            uint32_t at = line + 1;
+            for (uint32_t i = 0; i < len; ++i) {
+                if (text[i] == '\n') m_lines[at++] = pos + i + 1;
+            }
+            m_line_cnt += nl;
+        }
+        ++m_version;
+        return true;
+    }
+
+    /// Remove `len` bytes at `pos` (clamped to the text)
+    void erase(uint32_t pos, uint32_t len) noexcept {
+        if (pos >= size() || len == 0) return;
+        if (len > size() - pos) len = size() - pos;
+        const uint32_t first = line_of(pos);
+        const uint32_t last = line_of(pos + len);    // paragraphs (first, last] lose their start
+        move_gap(pos);
+        m_gap_end += len;
+
+        const uint32_t removed = last - first;
+        if (removed) {
+            std::memmove(m_lines + first + 1, m_lines + last + 1, sizeof(uint32_t) * (m_line_cnt - last - 1));
+            m_line_cnt -= removed;
+        }
+        for (uint32_t i = first + 1; i < m_line_cnt; ++i) m_lines[i] -= len;
+        ++m_version;
+    }
+
+    // ==================== Reading ====================
+
+    [[nodiscard]] uint32_t size() const noexcept { return m_cap - gap_len(); }
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+    /// Byte at `pos` (pos < size())
+    [[nodiscard]] char at(uint32_t pos) const noexcept { return byte(pos); }
+
+    /// Copy up to `n` bytes from `pos` into `out` (not terminated); returns the count
+    uint32_t read(uint32_t pos, uint32_t n, char* out) const noexcept {
+        if (pos >= size()) return 0;
+        if (n > size() - pos) n = size() - pos;
+        uint32_t done = 0;
+        if (pos < m_gap) {
+            done = m_gap - pos < n ? m_gap - pos : n;
+            std::memcpy(out, m_buf + pos, done);
+        }
+        if (done < n) std::memcpy(out + done, m_buf + pos + done + gap_len(), n - done);
+        return n;
+    }
+
+    /// Call `f(std::string_view)` with the text in at most two pieces (e.g. to save it)
+    template<typename F>
+    void for_each_chunk(F&& f) const {
+        if (m_gap) f(std::string_view(m_buf, m_gap));
+        if (m_gap_end < m_cap) f(std::string_view(m_buf + m_gap_end, m_cap - m_gap_end));
+    }
+
+    /// The whole text, NUL-terminated; moves the gap to the end (O(n) once)
+    [[nodiscard]] const char* c_str() noexcept {
+        if (!reserve_gap(1)) return "";
+        move_gap(size());
+        m_buf[m_gap] = '\0';
+        return m_buf;
+    }
+
+    // ==================== Paragraphs ====================
+
+    /// Paragraphs ('\n' count + 1)
+    [[nodiscard]] uint32_t line_count() const noexcept { return m_line_cnt; }
+
+    [[nodiscard]] uint32_t line_start(uint32_t line) const noexcept {
+        return line < m_line_cnt ? m_lines[line] : size();
+    }
+
+    /// Bytes of paragraph `line` without its '\n'
+    [[nodiscard]] uint32_t line_length(uint32_t line) const noexcept {
+        if (line >= m_line_cnt) return 0;
+        const uint32_t end = line + 1 < m_line_cnt ? m_lines[line + 1] - 1 : size();
+        return end - m_lines[line];
+    }
+
+    /// Paragraph holding byte `pos`
+    [[nodiscard]] uint32_t line_of(uint32_t pos) const noexcept {
+        uint32_t lo = 0, hi = m_line_cnt;
+        while (hi - lo > 1) {
+            const uint32_t mid = (lo + hi) / 2;
+            if (m_lines[mid] <= pos) lo = mid;
+            else hi = mid;
+        }
+        return lo;
+    }
+
+    /// Copy paragraph `line` into `out` (cut to cap - 1 bytes) and terminate it
+    std::string_view line(uint32_t line, char* out, uint32_t cap) const noexcept {
+        if (cap == 0) return {};
+        uint32_t n = line_length(line);
+        if (n > cap - 1) n = cap - 1;
+        read(line_start(line), n, out);
+        out[n] = '\0';
+        return {out, n};
+    }
+
+    /// Bumped by every edit (for views caching layout)
+    [[nodiscard]] uint32_t version() const noexcept { return m_version; }
+
+    /// Bytes allocated for text (size() plus the gap)
+    [[nodiscard]] uint32_t capacity() const noexcept { return m_cap; }
+};
+
+} // namespace lv
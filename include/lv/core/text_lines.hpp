@@ -0,0 +1,67 @@
+#pragma once
+
+/**
+ * @file text_lines.hpp
+ * @brief Line breaks in text_cache layouts (opt-in)
+ *
+ * text_cache::layout() caches the size of a text; once installed, each
+ * cached layout also keeps where its lines break and how wide they are:
+ *
+ * @code
+ * #include <lv/core/text_lines.hpp>
+ *
+ * lv::text_lines::install();   // once, after lv_init()
+ *
+ * lv::text_cache::Layout l = lv::text_cache::layout(label, label.get_text(), 120);
+ * for (uint32_t i = 0; i < l.line_cnt; ++i) { ... l.lines[i].start, l.lines[i].width ... }
+ * @endcode
+ *
+ * Not included by lv.hpp: it breaks lines with lv_text_get_next_line(),
+ * which is declared in lv_text_private.h. Checked against LVGL 9.4 (see
+ * LV_CPP_INTERNALS_OK).
+ *
+ * Heap allocation: one lv_malloc per cached layout with more than
+ * LV_CPP_TEXT_CACHE_LINES lines
+ */
+
+#include <lvgl.h>
+#include "version.hpp"
+
+#if !LV_CPP_INTERNALS_OK
+#error "text_lines.hpp reads LVGL internals checked against LVGL 9.4; see LV_CPP_INTERNALS_OK"
+#endif
+
+#include <src/misc/lv_text_private.h>    // lv_text_get_next_line
+#include <cstdint>
+#include "text_cache.hpp"
+
+namespace lv::text_lines {
+
+namespace detail {
+
+/// text_cache::detail::LineBreaker over lv_text_get_next_line()
+[[nodiscard]] inline uint32_t next_line(const char* text, uint32_t len, const text_cache::detail::Key& k,
+                                        int32_t* width) noexcept {
+#if LV_VERSION_AT_LEAST(9, 4, 0)
+    lv_text_attributes_t attr{};
+    attr.letter_space = k.letter_space;
+    attr.line_space = k.line_space;
+    attr.max_width = k.max_width;
+    attr.text_flags = static_cast<lv_text_flag_t>(k.flags);
+    return lv_text_get_next_line(text, len, k.font, width, &attr);
+#else
+    return lv_text_get_next_line(text, len, k.font, k.letter_space, k.max_width, width,
+                                 static_cast<lv_text_flag_t>(k.flags));
+#endif
+}
+
+} // namespace detail
+
+/// Keep line breaks in text_cache layouts from now on (drops layouts cached without them)
+inline void install() noexcept {
+    if (text_cache::detail::line_breaker() == &detail::next_line) return;
+    text_cache::drop();
+    text_cache::detail::line_breaker() = &detail::next_line;
+}
+
+} // namespace lv::text_lines
@@ -8,11 +8,43 @@
  */
 
 #include <lvgl.h>
+#include <cstdint>
 #include "object.hpp"
 #include "version.hpp"
 
 namespace lv {
 
+// ==================== Theme Switching ====================
+
+/// Result of one lv::switch_theme() (theme_switch.hpp)
+struct ThemeSwitchStats {
+    uint32_t objects = 0;       ///< Objects restyled
+    uint32_t screens = 0;       ///< Screens and layers invalidated
+    uint32_t elapsed_ms = 0;    ///< Duration in LVGL ticks
+};
+
+/**
+ * @brief Instrumentation hooks around lv::switch_theme() (theme_switch.hpp)
+ *
+ * `begin` runs before the first object is touched, `end` after the last
+ * screen is invalidated. lv::Bench installs these to record the step with
+ * a microsecond clock.
+ */
+struct ThemeSwitchHooks {
+    void (*begin)(void* user_data) noexcept = nullptr;
+    void (*end)(const ThemeSwitchStats& stats, void* user_data) noexcept = nullptr;
+    void* user_data = nullptr;
+};
+
+namespace detail {
+
+[[nodiscard]] inline ThemeSwitchHooks& theme_switch_hooks() noexcept {
+    static ThemeSwitchHooks hooks;
+    return hooks;
+}
+
+} // namespace detail
+
 /**
  * @brief Theme wrapper
  *
@@ -66,6 +98,18 @@ public:
         lv_theme_set_apply_cb(m_theme, cb);
         return *this;
     }
+
+    // ==================== Switching ====================
+
+    /// Install instrumentation hooks for lv::switch_theme() (pass {} to remove)
+    static void instrument(const ThemeSwitchHooks& hooks) noexcept {
+        detail::theme_switch_hooks() = hooks;
+    }
+
+    /// Currently installed hooks
+    [[nodiscard]] static const ThemeSwitchHooks& instrumentation() noexcept {
+        return detail::theme_switch_hooks();
+    }
 };
 
 // ==================== Theme Helpers ====================
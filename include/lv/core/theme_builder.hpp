@@ -0,0 +1,243 @@
+#pragma once
+
+/**
+ * @file theme_builder.hpp
+ * @brief Themes with compile-time per-class shared styles (opt-in)
+ *
+ * lv::ThemeBuilder declares a theme's styles per widget class as a type.
+ * The styles are initialized once and shared by every object. Applying
+ * the theme to an object is one table lookup plus a pointer add per style:
+ * @code
+ * #include <lv/core/theme_builder.hpp>
+ *
+ * class AppTheme : public lv::ThemeBuilder<AppTheme> {
+ *     lv::Style m_card, m_button, m_pressed;
+ *
+ * public:
+ *     using rules = lv::ThemeRules<
+ *         lv::ThemeRule<&lv_obj_class, &AppTheme::m_card>,
+ *         lv::ThemeRule<&lv_button_class, &AppTheme::m_button>,
+ *         lv::ThemeRule<&lv_button_class, &AppTheme::m_pressed, LV_STATE_PRESSED>>;
+ *
+ *     void init_styles() {                         // once, from init()
+ *         m_card.bg_color(lv::colors::white()).radius(8);
+ *         ...
+ *     }
+ * };
+ *
+ * static AppTheme app_theme;
+ * lv_display_set_theme(display, app_theme.init(display));
+ * @endcode
+ *
+ * Not included by lv.hpp: the theme embeds an lv_theme_t and fills its
+ * parent, display and user_data, which only LVGL's private theme header
+ * declares. Checked against LVGL 9.4 (see LV_CPP_INTERNALS_OK).
+ *
+ * Heap allocation: NONE (the lv_theme_t and the styles are members)
+ */
+
+#include <lvgl.h>
+#include "version.hpp"
+
+#if !LV_CPP_INTERNALS_OK
+#error "theme_builder.hpp reads LVGL internals checked against LVGL 9.4; see LV_CPP_INTERNALS_OK"
+#endif
+
+#include <src/themes/lv_theme_private.h>       // lv_theme_t members
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "theme.hpp"
+
+namespace lv {
+
+/**
+ * @brief One shared style of a ThemeBuilder theme
+ * @tparam Class Widget class the style applies to (exact class, like LVGL's themes)
+ * @tparam StyleMember Pointer to an lv::Style, lv::ConstStyle or lv_style_t member of the theme
+ * @tparam Selector Part and state, e.g. LV_PART_INDICATOR | LV_STATE_CHECKED
+ */
+template<const lv_obj_class_t* Class, auto StyleMember, lv_style_selector_t Selector = LV_PART_MAIN>
+    requires std::is_member_object_pointer_v<decltype(StyleMember)>
+struct ThemeRule {
+    static constexpr const lv_obj_class_t* cls = Class;
+    static constexpr auto member = StyleMember;
+    static constexpr lv_style_selector_t selector = Selector;
+};
+
+/// Rule table of a ThemeBuilder (declare as `using rules = lv::ThemeRules<...>`)
+template<typename... Rs>
+struct ThemeRules {
+    static_assert(sizeof...(Rs) > 0, "lv::ThemeRules needs at least one lv::ThemeRule");
+    static constexpr size_t count = sizeof...(Rs);
+};
+
+/**
+ * @brief CRTP theme with per-class shared styles (see the file comment)
+ *
+ * Derived declares `using rules = lv::ThemeRules<...>` and may define
+ * public init_styles() (called once by the first init()) and
+ * on_apply(lv_obj_t*) for what the table cannot express, e.g. screens.
+ * Rules of the same class are applied in declaration order after the
+ * parent theme's styles. The style members themselves may be private.
+ *
+ * The theme must outlive every object it styled and must not move after
+ * init(): the lv_theme_t and the styles are members.
+ */
+template<typename Derived>
+class ThemeBuilder {
+    using AddFn = void (*)(Derived& self, lv_obj_t* obj) noexcept;
+
+    template<typename S>
+    [[nodiscard]] static const lv_style_t* style_of(S& s) noexcept {
+        if constexpr (std::is_same_v<std::remove_const_t<S>, lv_style_t>) return &s;
+        else return s.get();
+    }
+
+    template<typename R>
+    static void add(Derived& self, lv_obj_t* obj) noexcept {
+        lv_obj_add_style(obj, style_of(self.*R::member), R::selector);
+    }
+
+    template<typename R>
+    struct RulesOf;
+    template<typename... Rs>
+    struct RulesOf<ThemeRules<Rs...>> {
+        static constexpr size_t count = sizeof...(Rs);
+        static constexpr size_t buckets = std::bit_ceil(2 * count);
+        static constexpr const lv_obj_class_t* classes[] = {Rs::cls...};
+
+        /// Rules grouped by class, declaration order kept within a class
+        static constexpr auto grouped = [] {
+            struct Grouped {
+                AddFn fns[count];
+                const lv_obj_class_t* group_cls[count];
+                uint16_t group_first[count];
+                uint16_t group_count[count];
+                uint16_t groups;
+            } g{};
+            constexpr AddFn declared[] = {&add<Rs>...};
+            bool placed[count] = {};
+            uint16_t n = 0;
+            for (size_t i = 0; i < count; ++i) {
+                if (placed[i]) continue;
+                g.group_cls[g.groups] = classes[i];
+                g.group_first[g.groups] = n;
+                for (size_t j = i; j < count; ++j) {
+                    if (placed[j] || classes[j] != classes[i]) continue;
+                    placed[j] = true;
+                    g.fns[n++] = declared[j];
+                    ++g.group_count[g.groups];
+                }
+                ++g.groups;
+            }
+            return g;
+        }();
+    };
+
+    /// Deferred: Derived is incomplete while the base is instantiated
+    template<typename D>
+    using RulesFor = RulesOf<typename D::rules>;
+
+    /// Styles of one class: `count` entries of the grouped rules from `first`
+    struct ClassEntry {
+        const lv_obj_class_t* cls = nullptr;
+        uint16_t first = 0;
+        uint16_t count = 0;
+    };
+
+    [[nodiscard]] static size_t bucket_of(const lv_obj_class_t* cls, size_t buckets) noexcept {
+        return (reinterpret_cast<uintptr_t>(cls) >> 4) & (buckets - 1);
+    }
+
+    /// Class lookup table, open addressing on the class pointer (built on first use)
+    [[nodiscard]] static const ClassEntry* table() noexcept {
+        using Rules = RulesFor<Derived>;
+        static const auto buckets = [] {
+            struct Buckets {
+                ClassEntry e[Rules::buckets];
+            } t{};
+            const auto& g = Rules::grouped;
+            for (uint16_t k = 0; k < g.groups; ++k) {
+                size_t b = bucket_of(g.group_cls[k], Rules::buckets);
+                while (t.e[b].cls) b = (b + 1) & (Rules::buckets - 1);
+                t.e[b] = ClassEntry{g.group_cls[k], g.group_first[k], g.group_count[k]};
+            }
+            return t;
+        }();
+        return buckets.e;
+    }
+
+    [[nodiscard]] static const ClassEntry* find(const lv_obj_class_t* cls) noexcept {
+        using Rules = RulesFor<Derived>;
+        const ClassEntry* t = table();
+        for (size_t i = bucket_of(cls, Rules::buckets);; i = (i + 1) & (Rules::buckets - 1)) {
+            if (t[i].cls == cls) return &t[i];
+            if (!t[i].cls) return nullptr;
+        }
+    }
+
+    static void apply_cb(lv_theme_t* th, lv_obj_t* obj) {
+        auto& self = *static_cast<Derived*>(th->user_data);
+        const auto& fns = RulesFor<Derived>::grouped.fns;
+        if (const ClassEntry* e = find(lv_obj_get_class(obj))) {
+            for (uint16_t i = e->first; i < e->first + e->count; ++i) fns[i](self, obj);
+        }
+        if constexpr (requires { self.on_apply(obj); }) self.on_apply(obj);
+    }
+
+    lv_theme_t m_theme{};
+    bool m_styles_ready = false;
+
+protected:
+    ThemeBuilder() noexcept = default;
+
+public:
+    ThemeBuilder(const ThemeBuilder&) = delete;
+    ThemeBuilder& operator=(const ThemeBuilder&) = delete;
+
+    /**
+     * @brief Initialize the styles (first call only) and the theme for `disp`
+     *
+     * The display's current theme becomes the parent; its colors and fonts
+     * are inherited. Calling init() again only re-links the parent.
+     * @return The theme, for lv_display_set_theme() or lv::switch_theme()
+     */
+    lv_theme_t* init(lv_display_t* disp = nullptr) noexcept {
+        if (!disp) disp = lv_display_get_default();
+        auto& self = static_cast<Derived&>(*this);
+        if (!m_styles_ready) {
+            if constexpr (requires { self.init_styles(); }) self.init_styles();
+            (void)table();
+            m_styles_ready = true;
+        }
+        lv_theme_t* parent = disp ? lv_display_get_theme(disp) : nullptr;
+        if (parent == &m_theme) parent = m_theme.parent;
+        if (parent) m_theme = *parent;
+        m_theme.parent = parent;
+        m_theme.disp = disp;
+        m_theme.apply_cb = &ThemeBuilder::apply_cb;
+        m_theme.user_data = &self;
+        return &m_theme;
+    }
+
+    [[nodiscard]] lv_theme_t* get() noexcept { return &m_theme; }
+
+    /// Wrapper for the Theme API (parent(), apply_cb())
+    [[nodiscard]] Theme theme() noexcept { return Theme(&m_theme); }
+
+    /// Rules in the table
+    [[nodiscard]] static constexpr size_t rule_count() noexcept { return RulesFor<Derived>::count; }
+
+    /// Distinct widget classes in the table
+    [[nodiscard]] static constexpr size_t class_count() noexcept { return RulesFor<Derived>::grouped.groups; }
+
+    /// Styles the table applies to objects of exactly `cls`
+    [[nodiscard]] static size_t styles_for(const lv_obj_class_t* cls) noexcept {
+        const ClassEntry* e = find(cls);
+        return e ? e->count : 0;
+    }
+};
+
+} // namespace lv
@@ -0,0 +1,128 @@
+#pragma once
+
+/**
+ * @file theme_switch.hpp
+ * @brief Single-pass theme switching for whole displays (opt-in)
+ *
+ * Setting a theme and re-applying it object by object refreshes and
+ * invalidates each object's subtree for every style it removes or adds,
+ * which stalls for several frames on screens with 1000+ objects.
+ * switch_theme() instead:
+ *
+ * 1. suspends style refresh reporting and the display's invalidation,
+ * 2. swaps the styles of every object on every screen and layer in one
+ *    tree walk (the theme's styles are initialized by its init function,
+ *    so the walk only exchanges pointers),
+ * 3. refreshes each screen once and invalidates it once.
+ *
+ * @code
+ * #include <lv/core/theme_switch.hpp>
+ *
+ * lv::switch_theme(display, dark ? dark_theme : light_theme);
+ * @endcode
+ *
+ * Not included by lv.hpp: keeping local styles means walking lv_obj_t's
+ * style list, and reaching screens that are not loaded means walking the
+ * display's screen list, neither of which is public. Checked against
+ * LVGL 9.4 (see LV_CPP_INTERNALS_OK). Theme::instrument() and the stats
+ * types stay in theme.hpp.
+ *
+ * Heap allocation: NONE
+ */
+
+#include <lvgl.h>
+#include "version.hpp"
+
+#if !LV_CPP_INTERNALS_OK
+#error "theme_switch.hpp reads LVGL internals checked against LVGL 9.4; see LV_CPP_INTERNALS_OK"
+#endif
+
+#include <src/core/lv_obj_private.h>           // obj->styles, to keep local styles
+#include <src/core/lv_obj_style_private.h>
+#include <src/display/lv_display_private.h>    // disp->screens
+#include <src/themes/lv_theme_private.h>       // parent theme chain
+#include "theme.hpp"
+
+namespace lv {
+
+namespace detail {
+
+/// lv_theme_apply() without the remove_style_all(): parent themes first
+inline void apply_theme_chain(lv_theme_t* theme, lv_obj_t* obj) noexcept {
+    if (theme->parent) apply_theme_chain(theme->parent, obj);
+    if (theme->apply_cb) theme->apply_cb(theme, obj);
+}
+
+struct ThemeSwitch {
+    lv_theme_t* theme;
+    ThemeSwitchStats stats;
+};
+
+/// Swap shared styles for the new theme's (local styles stay); no refresh runs meanwhile
+inline lv_obj_tree_walk_res_t theme_switch_walk_cb(lv_obj_t* obj, void* user_data) noexcept {
+    auto& sw = *static_cast<ThemeSwitch*>(user_data);
+    uint32_t i = 0;
+    while (i < obj->style_cnt) {
+        const lv_obj_style_t& entry = obj->styles[i];
+        if (entry.is_local || entry.is_trans) {
+            ++i;
+            continue;
+        }
+        lv_obj_remove_style(obj, entry.style, entry.selector);
+    }
+    apply_theme_chain(sw.theme, obj);
+    lv_obj_refresh_ext_draw_size(obj);
+    lv_obj_mark_layout_as_dirty(obj);
+    ++sw.stats.objects;
+    return LV_OBJ_TREE_WALK_NEXT;
+}
+
+} // namespace detail
+
+/**
+ * @brief Make `theme` the display's theme and restyle all its objects at once
+ *
+ * Shared styles (add_style()) are replaced by the theme's, like
+ * lv_theme_apply() does; local styles set through the inline setters are
+ * kept. Re-add application shared styles afterwards if needed.
+ *
+ * @param disp Display to restyle (nullptr = default display)
+ * @param theme Initialized theme (its parent chain is applied too)
+ */
+inline ThemeSwitchStats switch_theme(lv_display_t* disp, lv_theme_t* theme) noexcept {
+    if (!disp) disp = lv_display_get_default();
+    if (!disp || !theme) return {};
+
+    const ThemeSwitchHooks hooks = detail::theme_switch_hooks();
+    if (hooks.begin) hooks.begin(hooks.user_data);
+    const uint32_t start = lv_tick_get();
+
+    detail::ThemeSwitch sw{theme, {}};
+    lv_display_set_theme(disp, theme);
+    lv_display_enable_invalidation(disp, false);
+    lv_obj_enable_style_refresh(false);
+    for (uint32_t i = 0; i < disp->screen_cnt; ++i) {
+        lv_obj_tree_walk(disp->screens[i], &detail::theme_switch_walk_cb, &sw);
+    }
+    lv_obj_enable_style_refresh(true);
+
+    // One recursive refresh per screen delivers LV_EVENT_STYLE_CHANGED to every object
+    for (uint32_t i = 0; i < disp->screen_cnt; ++i) {
+        lv_obj_refresh_style(disp->screens[i], LV_PART_ANY, LV_STYLE_PROP_ANY);
+    }
+    lv_display_enable_invalidation(disp, true);
+    for (uint32_t i = 0; i < disp->screen_cnt; ++i) {
+        lv_obj_invalidate(disp->screens[i]);
+    }
+    sw.stats.screens = disp->screen_cnt;
+    sw.stats.elapsed_ms = lv_tick_elaps(start);
+
+    if (hooks.end) hooks.end(sw.stats, hooks.user_data);
+    return sw.stats;
+}
+
+inline ThemeSwitchStats switch_theme(lv_display_t* disp, Theme& theme) noexcept {
+    return switch_theme(disp, theme.get());
+}
+
+} // namespace lv
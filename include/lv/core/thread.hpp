@@ -0,0 +1,124 @@
+#pragma once
+
+/**
+ * @file thread.hpp
+ * @brief LVGL locking and UI-thread checks for threaded builds
+ *
+ * With LV_USE_OS != LV_OS_NONE (configure with -DLV_RENDER_THREADS=N, which
+ * selects LV_OS_PTHREAD and LV_DRAW_SW_DRAW_UNIT_CNT=N) LVGL renders on N
+ * worker threads and guards its object tree with one recursive mutex that
+ * lv_timer_handler() holds while it runs. Any other thread touching LVGL
+ * must hold that mutex too:
+ *
+ * @code
+ * void sensor_thread() {
+ *     for (;;) {
+ *         const int32_t rpm = read_rpm();
+ *         lv::LockGuard lock;          // lv_lock() ... lv_unlock()
+ *         gauge.value(rpm);
+ *     }
+ * }
+ * @endcode
+ *
+ * lv::init() records the calling thread as the UI thread. ui_thread()
+ * asserts that the caller is that thread or holds a LockGuard; it is
+ * compiled in with LV_CPP_THREAD_CHECKS (default: debug builds) and used by
+ * the wrapper entry points most often misused from worker threads
+ * (State::set(), Navigator::push()/back()).
+ *
+ * Heap allocation: NONE
+ */
+
+#include <lvgl.h>
+#include <atomic>
+#include <cstdint>
+
+namespace lv {
+
+#ifndef LV_CPP_THREAD_CHECKS
+/// Enable ui_thread() assertions (default: debug builds)
+#ifdef NDEBUG
+#define LV_CPP_THREAD_CHECKS 0
+#else
+#define LV_CPP_THREAD_CHECKS 1
+#endif
+#endif
+
+/// Software render threads LVGL was built with (1 without an OS)
+[[nodiscard]] constexpr uint32_t render_threads() noexcept {
+#if LV_USE_OS != LV_OS_NONE && LV_USE_DRAW_SW
+    return LV_DRAW_SW_DRAW_UNIT_CNT;
+#else
+    return 1;
+#endif
+}
+
+namespace detail {
+
+/// LockGuard nesting depth of the calling thread
+[[nodiscard]] inline uint32_t& lock_depth() noexcept {
+    thread_local uint32_t depth = 0;
+    return depth;
+}
+
+[[nodiscard]] inline bool& is_ui_thread_flag() noexcept {
+    thread_local bool ui = false;
+    return ui;
+}
+
+/// Set once any thread was marked as the UI thread
+[[nodiscard]] inline std::atomic<bool>& ui_thread_known() noexcept {
+    static std::atomic<bool> known{false};
+    return known;
+}
+
+} // namespace detail
+
+/**
+ * @brief RAII holder of LVGL's global lock (lv_lock()/lv_unlock())
+ *
+ * The lock is recursive, so the UI thread can take it too. Without an OS
+ * both calls are no-ops. Non-copyable, non-movable.
+ */
+class LockGuard {
+public:
+    LockGuard() noexcept {
+        lv_lock();
+        ++detail::lock_depth();
+    }
+
+    ~LockGuard() {
+        --detail::lock_depth();
+        lv_unlock();
+    }
+
+    LockGuard(const LockGuard&) = delete;
+    LockGuard& operator=(const LockGuard&) = delete;
+    LockGuard(LockGuard&&) = delete;
+    LockGuard& operator=(LockGuard&&) = delete;
+};
+
+/// Record the calling thread as the one running lv_timer_handler() (done by lv::init())
+inline void mark_ui_thread() noexcept {
+    detail::is_ui_thread_flag() = true;
+    detail::ui_thread_known().store(true, std::memory_order_release);
+}
+
+/// Calling thread is the UI thread (true if no thread was marked yet)
+[[nodiscard]] inline bool is_ui_thread() noexcept {
+    return detail::is_ui_thread_flag() || !detail::ui_thread_known().load(std::memory_order_acquire);
+}
+
+/// Calling thread holds a LockGuard
+[[nodiscard]] inline bool holds_lock() noexcept {
+    return detail::lock_depth() > 0;
+}
+
+/// Assert that LVGL may be used from the calling thread (LV_CPP_THREAD_CHECKS)
+inline void ui_thread() noexcept {
+#if LV_CPP_THREAD_CHECKS
+    LV_ASSERT_MSG(is_ui_thread() || holds_lock(), "LVGL used off the UI thread without lv::LockGuard");
+#endif
+}
+
+} // namespace lv
@@ -0,0 +1,361 @@
+#pragma once
+
+/**
+ * @file tile_render.hpp
+ * @brief Tiled partial rendering with parallel tiles and pipelined flushes
+ *
+ * Large panels (1920x720) cannot keep full-frame buffers in fast memory,
+ * and one partial buffer renders and flushes strictly in turn. In tiled
+ * mode a display renders into two pooled buffers of `tiles` tiles each
+ * (tile_w x tile_h pixels, sized to stay in L2) and:
+ *
+ * - splits every invalidated area into tile_w wide columns at the start
+ *   of a refresh, so each partial chunk is `tiles` tiles stacked;
+ * - has LVGL render the tiles of a chunk in parallel on the SW draw
+ *   units (lv_display_set_tile_cnt(), LVGL 9.3+);
+ * - with an OS, runs the driver's flush callback on a worker thread, so
+ *   chunk N is flushed while chunk N+1 renders into the other buffer.
+ *
+ * @code
+ * #include <lv/core/tile_render.hpp>
+ *
+ * lv::Display disp = lv::Display::get_default();
+ * lv::tile_render::enable(disp, {.tile_w = 64, .tile_h = 64});   // tiles: one per render thread
+ * ...
+ * auto s = lv::tile_render::stats(disp);
+ * @endcode
+ *
+ * The worker calls the driver's flush callback, which must only touch its
+ * device and call lv_display_flush_ready() (as DMA completion handlers
+ * do). A convert_on_flush() RGB565 conversion or rotate_on_flush() switches
+ * the display's color format or rotation around the driver call, so either
+ * keeps flushes synchronous.
+ * Columns are only split while LVGL's invalidated-area list
+ * (LV_INV_BUF_SIZE) has room; they are then made wider.
+ *
+ * Not included by lv.hpp: it splits lv_display_t's inv_areas and swaps
+ * its buf_1/buf_2, render_mode and flush_cb, none of which has a public
+ * accessor that works mid-refresh. Checked against LVGL 9.4 (see
+ * LV_CPP_INTERNALS_OK).
+ *
+ * Heap allocation: NONE in the wrapper (LV_CPP_TILE_DISPLAYS fixed slots;
+ * render buffers come from draw::pool_handlers())
+ */
+
+#include <lvgl.h>
+#include "version.hpp"
+
+#if !LV_CPP_INTERNALS_OK
+#error "tile_render.hpp reads LVGL internals checked against LVGL 9.4; see LV_CPP_INTERNALS_OK"
+#endif
+
+#include <src/display/lv_display_private.h>   // buf_1/buf_2, render_mode, flush_cb, inv_areas
+#include <cstdint>
+#include "thread.hpp"
+#include "pixel_flush.hpp"
+#include "../draw/draw_buf.hpp"
+
+#ifndef LV_CPP_TILE_DISPLAYS
+/// Displays that can render tiled at once
+#define LV_CPP_TILE_DISPLAYS 2
+#endif
+
+#ifndef LV_CPP_TILE_FLUSH_STACK
+/// Stack of the flush worker thread
+#define LV_CPP_TILE_FLUSH_STACK (8 * 1024)
+#endif
+
+namespace lv {
+
+/// Geometry and pipelining of tile_render::enable()
+struct TileConfig {
+    uint16_t tile_w = 64;        ///< Column width invalidated areas are split into
+    uint16_t tile_h = 64;        ///< Rows of one tile
+    uint8_t tiles = 0;           ///< Tiles rendered at once, per buffer (0: render_threads())
+    bool async_flush = true;     ///< Flush on a worker thread (needs an OS)
+};
+
+namespace tile_render {
+
+/// Counters of a tiled display
+struct Stats {
+    uint32_t refreshes;        ///< refreshes with invalidated areas
+    uint32_t split_areas;      ///< areas split into columns
+    uint32_t columns;          ///< columns those areas became
+    uint32_t flushes;          ///< chunks flushed
+    uint32_t async_flushes;    ///< of these, flushed on the worker
+    uint32_t buffer_bytes;     ///< both render buffers
+};
+
+namespace detail {
+
+struct Hook {
+    lv_display_t* disp = nullptr;        ///< nullptr: free slot
+    TileConfig cfg{};
+    uint8_t tiles = 1;
+    lv_draw_buf_t* bufs[2] = {};
+    lv_draw_buf_t* prev_bufs[2] = {};    ///< restored by disable()
+    lv_display_render_mode_t prev_mode = LV_DISPLAY_RENDER_MODE_PARTIAL;
+    lv_display_flush_cb_t flush = nullptr;   ///< the driver's callback
+    Stats stats{};
+#if LV_USE_OS != LV_OS_NONE
+    lv_thread_t thread;
+    lv_thread_sync_t wake;
+    lv_mutex_t lock;
+    lv_area_t area{};
+    uint8_t* px = nullptr;
+    bool pending = false;
+    bool running = false;
+    bool stopping = false;
+#endif
+};
+
+[[nodiscard]] inline Hook* hooks() noexcept {
+    static Hook h[LV_CPP_TILE_DISPLAYS];
+    return h;
+}
+
+[[nodiscard]] inline Hook* find(lv_display_t* disp) noexcept {
+    Hook* h = hooks();
+    for (uint32_t i = 0; i < LV_CPP_TILE_DISPLAYS; ++i) {
+        if (h[i].disp == disp) return &h[i];
+    }
+    return nullptr;
+}
+
+/// Split the refresh's invalidated areas into columns of (a multiple of) tile_w
+inline void refr_start_cb(lv_event_t* e) noexcept {
+    auto* disp = static_cast<lv_display_t*>(lv_event_get_current_target(e));
+    Hook* h = find(disp);
+    if (!h || disp->inv_p == 0) return;
+    ++h->stats.refreshes;
+    const int32_t tile_w = h->cfg.tile_w;
+    const uint32_t n = disp->inv_p;
+    for (uint32_t i = 0; i < n; ++i) {
+        const lv_area_t a = disp->inv_areas[i];
+        const int32_t w = lv_area_get_width(&a);
+        if (w <= tile_w) continue;
+        const uint32_t free_slots = LV_INV_BUF_SIZE - disp->inv_p;
+        if (free_slots == 0) break;
+        const int32_t cols = (w + tile_w - 1) / tile_w;
+        // Wider columns (still whole tiles) when the list cannot take them all
+        const int32_t per = (cols + static_cast<int32_t>(free_slots)) / (static_cast<int32_t>(free_slots) + 1);
+        const int32_t step = tile_w * (per > 0 ? per : 1);
+        disp->inv_areas[i].x2 = a.x1 + step - 1;
+        uint32_t made = 1;
+        for (int32_t x = a.x1 + step; x <= a.x2; x += step) {
+            lv_area_t& col = disp->inv_areas[disp->inv_p];
+            col = a;
+            col.x1 = x;
+            col.x2 = x + step - 1 < a.x2 ? x + step - 1 : a.x2;
+            disp->inv_area_joined[disp->inv_p] = 0;
+            ++disp->inv_p;
+            ++made;
+        }
+        ++h->stats.split_areas;
+        h->stats.columns += made;
+    }
+}
+
+#if LV_USE_OS != LV_OS_NONE
+inline void flush_worker(void* arg) {
+    Hook& h = *static_cast<Hook*>(arg);
+    for (;;) {
+        bool take = false;
+        lv_area_t area;
+        uint8_t* px = nullptr;
+        lv_mutex_lock(&h.lock);
+        if (h.stopping) {
+            lv_mutex_unlock(&h.lock);
+            break;
+        }
+        if (h.pending) {
+            take = true;
+            area = h.area;
+            px = h.px;
+            h.pending = false;
+        }
+        lv_mutex_unlock(&h.lock);
+        // The driver calls lv_display_flush_ready(); LVGL renders the next chunk meanwhile
+        if (take) h.flush(h.disp, &area, px);
+        else lv_thread_sync_wait(&h.wake);
+    }
+}
+
+inline void start_worker(Hook& h) noexcept {
+    lv_mutex_init(&h.lock);
+    lv_thread_sync_init(&h.wake);
+    h.stopping = false;
+    h.pending = false;
+#if LV_VERSION_AT_LEAST(9, 3, 0)
+    const lv_result_t res = lv_thread_init(&h.thread, "lv_tile_flush", LV_THREAD_PRIO_HIGH, &flush_worker,
+                                           LV_CPP_TILE_FLUSH_STACK, &h);
+#else
+    const lv_result_t res = lv_thread_init(&h.thread, LV_THREAD_PRIO_HIGH, &flush_worker,
+                                           LV_CPP_TILE_FLUSH_STACK, &h);
+#endif
+    if (res != LV_RESULT_OK) {
+        lv_thread_sync_delete(&h.wake);
+        lv_mutex_delete(&h.lock);
+        LV_LOG_WARN("tile render: cannot start flush thread, flushing synchronously");
+        return;
+    }
+    h.running = true;
+}
+
+inline void stop_worker(Hook& h) noexcept {
+    if (!h.running) return;
+    // LVGL waits for the last flush of a refresh, so nothing is pending outside one
+    lv_mutex_lock(&h.lock);
+    h.stopping = true;
+    lv_mutex_unlock(&h.lock);
+    lv_thread_sync_signal(&h.wake);
+    lv_thread_delete(&h.thread);
+    lv_thread_sync_delete(&h.wake);
+    lv_mutex_delete(&h.lock);
+    h.running = false;
+}
+#endif
+
+inline void tile_flush_cb(lv_display_t* disp, const lv_area_t* area, uint8_t* px) {
+    Hook* h = find(disp);
+    if (!h) {
+        lv_display_flush_ready(disp);
+        return;
+    }
+    ++h->stats.flushes;
+#if LV_USE_OS != LV_OS_NONE
+    if (h->running) {
+        ++h->stats.async_flushes;
+        lv_mutex_lock(&h->lock);
+        h->area = *area;
+        h->px = px;
+        h->pending = true;
+        lv_mutex_unlock(&h->lock);
+        lv_thread_sync_signal(&h->wake);
+        return;
+    }
+#endif
+    h->flush(disp, area, px);
+}
+
+inline void free_buffers(Hook& h) noexcept {
+    for (lv_draw_buf_t*& b : h.bufs) {
+        if (b) lv_draw_buf_destroy(b);
+        b = nullptr;
+    }
+}
+
+inline void release(Hook& h, bool deleting) noexcept {
+#if LV_USE_OS != LV_OS_NONE
+    stop_worker(h);
+#endif
+    if (!deleting) {
+        lv_display_remove_event_cb_with_user_data(h.disp, &refr_start_cb, nullptr);
+        lv_display_set_flush_cb(h.disp, h.flush);
+#if LV_VERSION_AT_LEAST(9, 3, 0)
+        lv_display_set_tile_cnt(h.disp, 1);
+#endif
+        lv_display_set_draw_buffers(h.disp, h.prev_bufs[0], h.prev_bufs[1]);
+        lv_display_set_render_mode(h.disp, h.prev_mode);
+        lv_obj_invalidate(lv_display_get_screen_active(h.disp));
+    }
+    free_buffers(h);
+    h = Hook{};
+}
+
+inline void delete_cb(lv_event_t* e) noexcept {
+    if (Hook* h = find(static_cast<lv_display_t*>(lv_event_get_current_target(e)))) release(*h, true);
+}
+
+} // namespace detail
+
+/**
+ * @brief Render `disp` in tiles (see the file comment)
+ *
+ * Call after the driver has set its flush callback; enabling again
+ * applies a new configuration. The driver's own buffers are kept and
+ * come back with disable().
+ *
+ * @return false when LV_CPP_TILE_DISPLAYS is reached or the buffers cannot be allocated
+ */
+inline bool enable(lv_display_t* disp, const TileConfig& cfg = {}) noexcept {
+    if (!disp || cfg.tile_w == 0 || cfg.tile_h == 0) return false;
+    if (detail::Hook* old = detail::find(disp)) detail::release(*old, false);
+    detail::Hook* h = detail::find(nullptr);
+    if (!h) {
+        LV_LOG_WARN("tiled displays exhausted, raise LV_CPP_TILE_DISPLAYS");
+        return false;
+    }
+    const uint8_t tiles = cfg.tiles ? cfg.tiles : static_cast<uint8_t>(render_threads());
+    // A chunk must hold at least one full row of the widest area that could not be split
+    uint32_t rows = static_cast<uint32_t>(cfg.tile_h) * tiles;
+    const uint32_t hor = static_cast<uint32_t>(lv_display_get_horizontal_resolution(disp));
+    if (rows * cfg.tile_w < hor) rows = (hor + cfg.tile_w - 1) / cfg.tile_w;
+    const lv_color_format_t cf = lv_display_get_color_format(disp);
+    lv_draw_buf_t* a = lv_draw_buf_create_ex(draw::pool_handlers(), cfg.tile_w, rows, cf, 0);
+    lv_draw_buf_t* b = lv_draw_buf_create_ex(draw::pool_handlers(), cfg.tile_w, rows, cf, 0);
+    if (!a || !b) {
+        if (a) lv_draw_buf_destroy(a);
+        if (b) lv_draw_buf_destroy(b);
+        return false;
+    }
+    h->disp = disp;
+    h->cfg = cfg;
+    h->tiles = tiles;
+    h->bufs[0] = a;
+    h->bufs[1] = b;
+    h->prev_bufs[0] = disp->buf_1;
+    h->prev_bufs[1] = disp->buf_2;
+    h->prev_mode = disp->render_mode;
+    h->flush = disp->flush_cb;
+    h->stats.buffer_bytes = a->data_size + b->data_size;
+    lv_display_set_render_mode(disp, LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_draw_buffers(disp, a, b);
+#if LV_VERSION_AT_LEAST(9, 3, 0)
+    lv_display_set_tile_cnt(disp, tiles);
+#endif
+    lv_display_set_flush_cb(disp, &detail::tile_flush_cb);
+    lv_display_add_event_cb(disp, &detail::refr_start_cb, LV_EVENT_REFR_START, nullptr);
+    lv_display_remove_event_cb_with_user_data(disp, &detail::delete_cb, nullptr);
+    lv_display_add_event_cb(disp, &detail::delete_cb, LV_EVENT_DELETE, nullptr);
+#if LV_USE_OS != LV_OS_NONE
+    const pixel::detail::FlushHook* conv = pixel::detail::find_flush_hook(disp);
+    if (cfg.async_flush && !(conv && (pixel::detail::converts_to_565(conv->mode) || conv->rotate))) {
+        detail::start_worker(*h);
+    }
+#endif
+    lv_obj_invalidate(lv_display_get_screen_active(disp));
+    return true;
+}
+
+/// Back to the driver's buffers, render mode and synchronous flushes
+inline void disable(lv_display_t* disp) noexcept {
+    detail::Hook* h = disp ? detail::find(disp) : nullptr;
+    if (!h) return;
+    lv_display_remove_event_cb_with_user_data(disp, &detail::delete_cb, nullptr);
+    detail::release(*h, false);
+}
+
+[[nodiscard]] inline bool enabled(lv_display_t* disp) noexcept {
+    return disp && detail::find(disp);
+}
+
+/// Counters of a tiled display (zero if not tiled)
+[[nodiscard]] inline Stats stats(lv_display_t* disp) noexcept {
+    const detail::Hook* h = disp ? detail::find(disp) : nullptr;
+    return h ? h->stats : Stats{};
+}
+
+/// Zero the counters (buffer size is kept)
+inline void reset_stats(lv_display_t* disp) noexcept {
+    detail::Hook* h = disp ? detail::find(disp) : nullptr;
+    if (!h) return;
+    const uint32_t bytes = h->stats.buffer_bytes;
+    h->stats = Stats{};
+    h->stats.buffer_bytes = bytes;
+}
+
+} // namespace tile_render
+
+} // namespace lv
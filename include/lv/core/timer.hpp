@@ -12,20 +12,87 @@
  *
  *   m_timer = lv::Timer::create<&MyClass::on_tick>(100, this);
  *   m_timer = lv::timer_periodic<&MyClass::on_tick>(100, this);
+ *
+ * With LV_CPP_USE_STD_FUNCTION, capturing lambdas are accepted too (stored
+ * in the callback pool, released when the Timer deletes its timer or after
+ * the last run of a once()/repeat(n) timer):
+ *
+ *   m_timer = lv::Timer::create(100, [this, step]() { advance(step); });
+ *
+ * ## Timer Wheel
+ *
+ * LVGL walks its whole timer list on every lv_timer_handler() call. Many
+ * periodic jobs (clocks, polling, blinking LEDs) can share one lv_timer_t
+ * through a TimerWheel instead. Timers given some slack fire together in
+ * one wake-up:
+ *
+ *   m_poll = lv::Timer::create<&Sensor::poll>(1000, this, lv::slack{50ms});
+ *   m_blink = lv::TimerWheel::shared().create<&Led::toggle>(500, this);
+ *
+ * Heap allocation: NONE for wheel timers (LV_CPP_TIMER_WHEEL_TIMERS fixed
+ * entries; each wheel creates one lv_timer_t)
  */
 
 #include <lvgl.h>
+#include <chrono>
 #include <cstdint>
 #include <type_traits>
+#include <utility>
+#include "callback.hpp"
+#include "profiler.hpp"
+#include "timer_stats.hpp"
+
+#ifndef LV_CPP_TIMER_WHEEL_TIMERS
+/// Timers one TimerWheel can hold
+#define LV_CPP_TIMER_WHEEL_TIMERS 192
+#endif
+
+#ifndef LV_CPP_TIMER_WHEEL_SLOTS
+/// Buckets of a TimerWheel (power of two)
+#define LV_CPP_TIMER_WHEEL_SLOTS 64
+#endif
+
+#ifndef LV_CPP_TIMER_WHEEL_TICK
+/// Milliseconds covered by one TimerWheel bucket (power of two)
+#define LV_CPP_TIMER_WHEEL_TICK 8
+#endif
 
 namespace lv {
 
+class WheelTimer;
+
+/**
+ * @brief How late a wheel timer may fire so it can share a wake-up
+ *
+ * Accepts milliseconds or any std::chrono duration: `lv::slack{50ms}`.
+ */
+struct slack {
+    uint32_t ms;
+
+    constexpr explicit slack(uint32_t late_ms) noexcept : ms(late_ms) {}
+
+    template<typename Rep, typename Period>
+    constexpr slack(std::chrono::duration<Rep, Period> late) noexcept
+        : ms(static_cast<uint32_t>(
+              std::chrono::duration_cast<std::chrono::milliseconds>(late).count())) {}
+};
+
 namespace detail {
 
+/// Installed by core/visibility.hpp: drops visibility ties to a timer lv::Timer deletes
+using timer_deleted_fn = void (*)(lv_timer_t* timer);
+
+[[nodiscard]] inline timer_deleted_fn& timer_deleted_hook() noexcept {
+    static timer_deleted_fn hook = nullptr;
+    return hook;
+}
+
 /// Trampoline for member functions with lv_timer_t* signature (zero storage)
 template<auto MemFn, typename T>
 struct TimerMemberTrampoline {
     static void callback(lv_timer_t* t) {
+        LV_PROFILE_FUNCTION();
+        LV_CPP_TIMER_STATS_SCOPE(t);
         auto* instance = static_cast<T*>(lv_timer_get_user_data(t));
         (instance->*MemFn)(t);
     }
@@ -35,11 +102,32 @@ struct TimerMemberTrampoline {
 template<auto MemFn, typename T>
 struct TimerMemberTrampolineNoArg {
     static void callback(lv_timer_t* t) {
+        LV_PROFILE_FUNCTION();
+        LV_CPP_TIMER_STATS_SCOPE(t);
         auto* instance = static_cast<T*>(lv_timer_get_user_data(t));
         (instance->*MemFn)();
     }
 };
 
+/// Trampoline for pooled capturing callbacks, void() or void(lv_timer_t*)
+template<typename F>
+struct TimerCallbackTrampoline {
+    static void callback(lv_timer_t* t) {
+        LV_PROFILE_FUNCTION();
+        LV_CPP_TIMER_STATS_SCOPE(t);
+        auto* slot = static_cast<CallbackSlot*>(lv_timer_get_user_data(t));
+        F& fn = slot->as<F>();
+        if constexpr (std::is_invocable_v<F&, lv_timer_t*>) {
+            fn(t);
+        } else {
+            fn();
+        }
+        // Last run of once()/repeat(n): LVGL deletes the timer right after, so free the slot now
+        // (unless the callable deleted its timer itself, which released the slot already)
+        if (slot->owner == t && slot->runs > 0 && --slot->runs == 0) release_callback(slot);
+    }
+};
+
 /// Detect void() member function signature
 template<typename> struct is_void_member : std::false_type {};
 template<typename C> struct is_void_member<void(C::*)()> : std::true_type {};
@@ -71,6 +159,15 @@ class Timer {
     lv_timer_t* m_timer = nullptr;
     bool m_owned = true;
 
+    /// Delete a timer and free any capturing callback bound to it
+    static void delete_timer(lv_timer_t* timer) noexcept {
+        if (detail::timer_deleted_fn hook = detail::timer_deleted_hook()) hook(timer);
+        lv_timer_delete(timer);
+        if constexpr (capturing_callbacks) {
+            detail::release_callbacks(timer);
+        }
+    }
+
 public:
     /// Create timer with callback and period
     Timer(lv_timer_cb_t cb, uint32_t period_ms, void* user_data = nullptr) noexcept
@@ -97,9 +194,48 @@ public:
         }
     }
 
+    /**
+     * @brief Create a periodic void() member function timer on the shared TimerWheel
+     *
+     * It may fire up to `late.ms` after each period, so timers with
+     * overlapping windows fire in the same wake-up.
+     */
+    template<auto MemFn, typename T>
+    [[nodiscard]] static WheelTimer create(uint32_t period_ms, T* instance, slack late) noexcept;
+
+    /**
+     * @brief Create timer with a capturing callable (LV_CPP_USE_STD_FUNCTION mode)
+     *
+     * The callable, void() or void(lv_timer_t*), lives in a callback pool
+     * slot until this Timer (or the one it is moved into) deletes the
+     * timer. Timers that delete themselves after once() or repeat(n) free
+     * it after their last run (LVGL's default auto-delete must stay on), so
+     * fire-and-forget timers do not drain the pool:
+     *
+     *   lv::Timer::create(500, [this]() { hide_toast(); }).once().release();
+     *
+     * release() without once()/repeat(n) would keep the slot forever and
+     * asserts. Returns an invalid Timer if the pool is exhausted.
+     */
+    template<typename F>
+        requires (capturing_callbacks && !std::is_convertible_v<F, lv_timer_cb_t> &&
+                  (std::is_invocable_v<std::decay_t<F>&> ||
+                   std::is_invocable_v<std::decay_t<F>&, lv_timer_t*>))
+    [[nodiscard]] static Timer create(uint32_t period_ms, F&& fn) noexcept {
+        detail::CallbackSlot* slot = detail::acquire_callback(std::forward<F>(fn));
+        if (!slot) return Timer(nullptr);
+        Timer t(&detail::TimerCallbackTrampoline<std::decay_t<F>>::callback, period_ms, slot);
+        if (!t.m_timer) {
+            detail::release_callback(slot);
+        } else {
+            slot->owner = t.m_timer;
+        }
+        return t;
+    }
+
     ~Timer() {
         if (m_owned && m_timer) {
-            lv_timer_delete(m_timer);
+            delete_timer(m_timer);
         }
     }
 
@@ -116,7 +252,7 @@ public:
     Timer& operator=(Timer&& other) noexcept {
         if (this != &other) {
             if (m_owned && m_timer) {
-                lv_timer_delete(m_timer);
+                delete_timer(m_timer);
             }
             m_timer = other.m_timer;
             m_owned = other.m_owned;
@@ -159,9 +295,12 @@ public:
         return lv_timer_get_user_data(m_timer);
     }
 
-    /// Set repeat count (-1 for infinite)
+    /// Set repeat count (-1 for infinite); a capturing callable is freed after the last run
     Timer& repeat(int32_t count) noexcept {
         lv_timer_set_repeat_count(m_timer, count);
+        if constexpr (capturing_callbacks) {
+            if (detail::CallbackSlot* slot = detail::owned_callback(m_timer)) slot->runs = count > 0 ? count : -1;
+        }
         return *this;
     }
 
@@ -209,7 +348,7 @@ public:
     /// Delete the timer (releases ownership)
     void del() noexcept {
         if (m_timer) {
-            lv_timer_delete(m_timer);
+            delete_timer(m_timer);
             m_timer = nullptr;
             m_owned = false;
         }
@@ -217,11 +356,425 @@ public:
 
     /// Release ownership (timer won't be deleted in destructor)
     [[nodiscard]] lv_timer_t* release() noexcept {
+        if constexpr (capturing_callbacks) {
+            const detail::CallbackSlot* slot = detail::owned_callback(m_timer);
+            LV_ASSERT_MSG(!slot || slot->runs > 0, "released capturing timer never frees its slot: call once()/repeat(n) first");
+            (void)slot;
+        }
         m_owned = false;
         return m_timer;
     }
 };
 
+// ==================== Timer Wheel ====================
+
+/**
+ * @brief Many logical timers driven by one lv_timer_t
+ *
+ * Timers are hashed by fire time into LV_CPP_TIMER_WHEEL_SLOTS buckets of
+ * LV_CPP_TIMER_WHEEL_TICK ms (later laps share the buckets) and kept in
+ * intrusive lists, so adding and cancelling are O(1). After every
+ * wake-up the driver timer is re-armed for the earliest due timer and
+ * it is paused while the wheel is empty: there is no periodic tick.
+ *
+ * A timer with slack joins the earliest timer already due within
+ * [due, due + slack] and runs in the same wake-up. With none there, it
+ * takes the time in the window that is a multiple of the largest power
+ * of two, where later timers are likely to meet it. Inserting one scans
+ * the buckets its window spans; timers without slack stay O(1).
+ *
+ * Periods are kept from the due time, not the fire time, so slack does
+ * not make a timer drift; after a stall, missed periods are skipped.
+ *
+ * Non-movable: the driver timer and the WheelTimer handles keep a
+ * pointer to it, and it must outlive them.
+ */
+class TimerWheel {
+public:
+    struct Stats {
+        uint32_t timers = 0;      ///< Timers in the wheel (running or paused)
+        uint32_t wakeups = 0;     ///< Driver timer runs
+        uint32_t fired = 0;       ///< Callbacks run
+        uint32_t coalesced = 0;   ///< Callbacks that shared a wake-up with an earlier one
+    };
+
+private:
+    friend class WheelTimer;
+
+    static_assert((LV_CPP_TIMER_WHEEL_SLOTS & (LV_CPP_TIMER_WHEEL_SLOTS - 1)) == 0,
+                  "LV_CPP_TIMER_WHEEL_SLOTS must be a power of two");
+    static_assert((LV_CPP_TIMER_WHEEL_TICK & (LV_CPP_TIMER_WHEEL_TICK - 1)) == 0,
+                  "LV_CPP_TIMER_WHEEL_TICK must be a power of two");
+    static_assert(LV_CPP_TIMER_WHEEL_TIMERS < 0xFFFF, "LV_CPP_TIMER_WHEEL_TIMERS must fit 16 bits");
+
+    static constexpr uint16_t none = 0xFFFF;
+    static constexpr uint16_t due_list = LV_CPP_TIMER_WHEEL_SLOTS;   ///< List of the timers being run
+
+    struct Entry {
+        void (*cb)(void*) = nullptr;
+        void* ctx = nullptr;
+        uint32_t period = 0;
+        uint32_t slack = 0;
+        uint32_t due = 0;           ///< Time the period ends
+        uint32_t fire = 0;          ///< Time it runs (due moved by the slack)
+        uint16_t prev = none;
+        uint16_t next = none;       ///< Also links the free list
+        uint16_t list = none;       ///< Bucket, due_list, or none while paused or free
+        uint16_t gen = 0;           ///< Bumped on free so stale handles miss
+        bool used = false;
+        bool once = false;
+    };
+
+    Entry m_entries[LV_CPP_TIMER_WHEEL_TIMERS];
+    uint16_t m_heads[LV_CPP_TIMER_WHEEL_SLOTS + 1];
+    uint16_t m_free = 0;
+    lv_timer_t* m_driver = nullptr;
+    uint32_t m_last = 0;            ///< Time of the last run; its bucket is visited again
+    uint32_t m_armed = 0;           ///< Time the driver fires at, while m_active
+    bool m_active = false;
+    bool m_in_run = false;
+    Stats m_stats;
+
+    [[nodiscard]] static bool before(uint32_t a, uint32_t b) noexcept {
+        return static_cast<int32_t>(a - b) < 0;
+    }
+
+    [[nodiscard]] static uint16_t slot_of(uint32_t t) noexcept {
+        return static_cast<uint16_t>((t / LV_CPP_TIMER_WHEEL_TICK) & (LV_CPP_TIMER_WHEEL_SLOTS - 1));
+    }
+
+    /// Earliest time in [due, due + slack] another timer already fires at, else the most aligned one
+    [[nodiscard]] uint32_t fire_time(uint32_t due, uint32_t slack) const noexcept {
+        if (slack == 0) return due;
+        uint32_t buckets = (due + slack) / LV_CPP_TIMER_WHEEL_TICK - due / LV_CPP_TIMER_WHEEL_TICK + 1;
+        if (buckets > LV_CPP_TIMER_WHEEL_SLOTS) buckets = LV_CPP_TIMER_WHEEL_SLOTS;
+        for (uint32_t k = 0; k < buckets; ++k) {
+            bool found = false;
+            uint32_t best = 0;
+            for (uint16_t i = m_heads[slot_of(due + k * LV_CPP_TIMER_WHEEL_TICK)]; i != none; i = m_entries[i].next) {
+                const uint32_t f = m_entries[i].fire;
+                if (f - due <= slack && (!found || before(f, best))) {
+                    best = f;
+                    found = true;
+                }
+            }
+            if (found) return best;
+        }
+        for (uint32_t g = 1u << 31; g > 1; g >>= 1) {
+            const uint32_t t = (due + g - 1) & ~(g - 1);
+            if (t - due <= slack) return t;
+        }
+        return due;
+    }
+
+    void link(uint16_t i, uint16_t list) noexcept {
+        Entry& e = m_entries[i];
+        e.list = list;
+        e.prev = none;
+        e.next = m_heads[list];
+        if (e.next != none) m_entries[e.next].prev = i;
+        m_heads[list] = i;
+    }
+
+    void unlink(uint16_t i) noexcept {
+        Entry& e = m_entries[i];
+        if (e.list == none) return;
+        if (e.prev != none) m_entries[e.prev].next = e.next;
+        else m_heads[e.list] = e.next;
+        if (e.next != none) m_entries[e.next].prev = e.prev;
+        e.list = e.prev = e.next = none;
+    }
+
+    void arm(uint32_t t) noexcept {
+        if (m_in_run || (m_active && !before(t, m_armed))) return;
+        const uint32_t now = lv_tick_get();
+        if (!m_active) m_last = now;
+        lv_timer_set_period(m_driver, before(now, t) ? t - now : 0);
+        lv_timer_reset(m_driver);
+        lv_timer_resume(m_driver);
+        m_armed = t;
+        m_active = true;
+    }
+
+    void schedule(uint16_t i, uint32_t due) noexcept {
+        Entry& e = m_entries[i];
+        unlink(i);
+        e.due = due;
+        e.fire = fire_time(due, e.slack);
+        link(i, slot_of(e.fire));
+        arm(e.fire);
+    }
+
+    [[nodiscard]] uint16_t alloc(void (*cb)(void*), void* ctx, uint32_t period, uint32_t slack) noexcept {
+        if (!m_driver) {
+            m_driver = lv_timer_create(&TimerWheel::driver_cb, LV_CPP_TIMER_WHEEL_TICK, this);
+            if (!m_driver) return none;
+            lv_timer_pause(m_driver);
+        }
+        if (m_free == none) {
+            LV_LOG_WARN("timer wheel full (raise LV_CPP_TIMER_WHEEL_TIMERS)");
+            return none;
+        }
+        const uint16_t i = m_free;
+        Entry& e = m_entries[i];
+        m_free = e.next;
+        e.next = none;
+        e.cb = cb;
+        e.ctx = ctx;
+        e.period = period ? period : 1;
+        e.slack = slack;
+        e.used = true;
+        e.once = false;
+        ++m_stats.timers;
+        schedule(i, lv_tick_get() + e.period);
+        return i;
+    }
+
+    void free_entry(uint16_t i) noexcept {
+        Entry& e = m_entries[i];
+        unlink(i);
+        e.used = false;
+        e.cb = nullptr;
+        ++e.gen;
+        e.next = m_free;
+        m_free = i;
+        if (--m_stats.timers == 0 && !m_in_run) {
+            lv_timer_pause(m_driver);
+            m_active = false;
+        }
+    }
+
+    /// Earliest fire time; false if nothing is scheduled
+    [[nodiscard]] bool next_fire(uint32_t now, uint32_t& at) const noexcept {
+        bool found = false;
+        const uint32_t base = now / LV_CPP_TIMER_WHEEL_TICK;
+        for (uint32_t k = 0; k < LV_CPP_TIMER_WHEEL_SLOTS; ++k) {
+            for (uint16_t i = m_heads[(base + k) & (LV_CPP_TIMER_WHEEL_SLOTS - 1)]; i != none; i = m_entries[i].next) {
+                if (!found || before(m_entries[i].fire, at)) at = m_entries[i].fire;
+                found = true;
+            }
+            // Buckets further on hold only later times (this lap) or later laps
+            if (found && at / LV_CPP_TIMER_WHEEL_TICK - base <= k) break;
+        }
+        return found;
+    }
+
+    void run() noexcept {
+        ++m_stats.wakeups;
+        const uint32_t now = lv_tick_get();
+        m_in_run = true;
+
+        // Move what is due from the buckets passed since the last run
+        uint32_t span = now / LV_CPP_TIMER_WHEEL_TICK - m_last / LV_CPP_TIMER_WHEEL_TICK + 1;
+        if (span > LV_CPP_TIMER_WHEEL_SLOTS) span = LV_CPP_TIMER_WHEEL_SLOTS;
+        for (uint32_t k = 0; k < span; ++k) {
+            const uint16_t b = slot_of(m_last + k * LV_CPP_TIMER_WHEEL_TICK);
+            for (uint16_t i = m_heads[b]; i != none;) {
+                const uint16_t next = m_entries[i].next;
+                if (!before(now, m_entries[i].fire)) {
+                    unlink(i);
+                    link(i, due_list);
+                }
+                i = next;
+            }
+        }
+
+        // Reschedule before calling, so a callback may pause, change or delete its timer
+        uint32_t fired = 0;
+        while (m_heads[due_list] != none) {
+            const uint16_t i = m_heads[due_list];
+            Entry& e = m_entries[i];
+            void (*cb)(void*) = e.cb;
+            void* ctx = e.ctx;
+            if (e.once) {
+                free_entry(i);
+            } else {
+                uint32_t due = e.due + e.period;
+                if (!before(now, due)) due = now + e.period;
+                schedule(i, due);
+            }
+            ++m_stats.fired;
+            if (fired++) ++m_stats.coalesced;
+            cb(ctx);
+        }
+
+        m_last = now;
+        m_in_run = false;
+        uint32_t at = 0;
+        if (next_fire(now, at)) {
+            m_active = false;
+            arm(at);
+        } else {
+            lv_timer_pause(m_driver);
+            m_active = false;
+        }
+    }
+
+    static void driver_cb(lv_timer_t* t) noexcept {
+        LV_PROFILE_FUNCTION();
+        LV_CPP_TIMER_STATS_SCOPE(t);
+        static_cast<TimerWheel*>(lv_timer_get_user_data(t))->run();
+    }
+
+public:
+    TimerWheel() noexcept {
+        for (uint16_t& h : m_heads) h = none;
+        for (uint16_t i = 0; i < LV_CPP_TIMER_WHEEL_TIMERS; ++i) {
+            m_entries[i].next = i + 1 < LV_CPP_TIMER_WHEEL_TIMERS ? static_cast<uint16_t>(i + 1) : none;
+        }
+    }
+
+    ~TimerWheel() {
+        if (m_driver) lv_timer_delete(m_driver);
+    }
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    /// Wheel used by Timer::create(..., slack)
+    [[nodiscard]] static TimerWheel& shared() noexcept {
+        static TimerWheel wheel;
+        return wheel;
+    }
+
+    /// Call `cb(ctx)` every `period_ms`, up to `late.ms` late
+    [[nodiscard]] WheelTimer add(void (*cb)(void*), void* ctx, uint32_t period_ms, slack late = slack{0}) noexcept;
+
+    /// Call `(instance->*MemFn)()` every `period_ms`, up to `late.ms` late
+    template<auto MemFn, typename T>
+    [[nodiscard]] WheelTimer create(uint32_t period_ms, T* instance, slack late = slack{0}) noexcept;
+
+    [[nodiscard]] uint32_t size() const noexcept { return m_stats.timers; }
+    [[nodiscard]] static constexpr uint32_t capacity() noexcept { return LV_CPP_TIMER_WHEEL_TIMERS; }
+
+    [[nodiscard]] const Stats& stats() const noexcept { return m_stats; }
+
+    /// Zero the wake-up and fire counters (the timer count is kept)
+    void reset_stats() noexcept { m_stats = {m_stats.timers, 0, 0, 0}; }
+};
+
+/**
+ * @brief Handle of a TimerWheel timer (RAII, moveable)
+ *
+ * Deletes its timer when destroyed. A once() timer frees itself after
+ * firing, and the handle then reads as invalid.
+ */
+class WheelTimer {
+    friend class TimerWheel;
+
+    TimerWheel* m_wheel = nullptr;
+    uint16_t m_index = 0;
+    uint16_t m_gen = 0;
+
+    WheelTimer(TimerWheel* wheel, uint16_t index) noexcept
+        : m_wheel(index != TimerWheel::none ? wheel : nullptr), m_index(index),
+          m_gen(m_wheel ? wheel->m_entries[index].gen : 0) {}
+
+    [[nodiscard]] TimerWheel::Entry* entry() const noexcept {
+        if (!m_wheel) return nullptr;
+        TimerWheel::Entry& e = m_wheel->m_entries[m_index];
+        return e.used && e.gen == m_gen ? &e : nullptr;
+    }
+
+public:
+    WheelTimer() noexcept = default;
+
+    ~WheelTimer() { del(); }
+
+    WheelTimer(const WheelTimer&) = delete;
+    WheelTimer& operator=(const WheelTimer&) = delete;
+
+    WheelTimer(WheelTimer&& other) noexcept
+        : m_wheel(other.m_wheel), m_index(other.m_index), m_gen(other.m_gen) {
+        other.m_wheel = nullptr;
+    }
+
+    WheelTimer& operator=(WheelTimer&& other) noexcept {
+        if (this != &other) {
+            del();
+            m_wheel = other.m_wheel;
+            m_index = other.m_index;
+            m_gen = other.m_gen;
+            other.m_wheel = nullptr;
+        }
+        return *this;
+    }
+
+    /// The timer exists (not deleted, not a fired once() timer)
+    [[nodiscard]] bool valid() const noexcept { return entry() != nullptr; }
+    explicit operator bool() const noexcept { return valid(); }
+
+    /// Set the period; the current one restarts from now
+    WheelTimer& period(uint32_t ms) noexcept {
+        if (TimerWheel::Entry* e = entry()) {
+            e->period = ms ? ms : 1;
+            if (e->list != TimerWheel::none) reset();
+        }
+        return *this;
+    }
+
+    /// Set how late it may fire (applies from the next period)
+    WheelTimer& slack(lv::slack late) noexcept {
+        if (TimerWheel::Entry* e = entry()) e->slack = late.ms;
+        return *this;
+    }
+
+    /// Fire once more, then delete
+    WheelTimer& once() noexcept {
+        if (TimerWheel::Entry* e = entry()) e->once = true;
+        return *this;
+    }
+
+    WheelTimer& pause() noexcept {
+        if (entry()) m_wheel->unlink(m_index);
+        return *this;
+    }
+
+    /// Resume with a full period from now
+    WheelTimer& resume() noexcept {
+        TimerWheel::Entry* e = entry();
+        if (e && e->list == TimerWheel::none) reset();
+        return *this;
+    }
+
+    [[nodiscard]] bool is_paused() const noexcept {
+        const TimerWheel::Entry* e = entry();
+        return e && e->list == TimerWheel::none;
+    }
+
+    /// Restart the period from now
+    WheelTimer& reset() noexcept {
+        if (TimerWheel::Entry* e = entry()) m_wheel->schedule(m_index, lv_tick_get() + e->period);
+        return *this;
+    }
+
+    /// Fire at the next wake-up
+    WheelTimer& ready() noexcept {
+        if (entry()) m_wheel->schedule(m_index, lv_tick_get());
+        return *this;
+    }
+
+    void del() noexcept {
+        if (entry()) m_wheel->free_entry(m_index);
+        m_wheel = nullptr;
+    }
+};
+
+inline WheelTimer TimerWheel::add(void (*cb)(void*), void* ctx, uint32_t period_ms, slack late) noexcept {
+    return WheelTimer(this, alloc(cb, ctx, period_ms, late.ms));
+}
+
+template<auto MemFn, typename T>
+WheelTimer TimerWheel::create(uint32_t period_ms, T* instance, slack late) noexcept {
+    static_assert(detail::is_void_member_v<MemFn>, "wheel timers call void() member functions");
+    return add([](void* ctx) { (static_cast<T*>(ctx)->*MemFn)(); }, instance, period_ms, late);
+}
+
+template<auto MemFn, typename T>
+WheelTimer Timer::create(uint32_t period_ms, T* instance, slack late) noexcept {
+    return TimerWheel::shared().create<MemFn>(period_ms, instance, late);
+}
+
 // ==================== Timer Helpers ====================
 
 /// Create a one-shot timer (runs callback once after delay)
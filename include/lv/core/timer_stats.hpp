@@ -0,0 +1,304 @@
+#pragma once
+
+/**
+ * @file timer_stats.hpp
+ * @brief Opt-in timer lateness and CPU time tracking (per timer and handler)
+ *
+ * With LV_CPP_USE_TIMER_STATS=1 (CMake -DLV_CPP_USE_TIMER_STATS=ON) every
+ * callback run through an lv::Timer trampoline is timed. LVGL stamps
+ * `last_run` just before the callback, so each run is compared with the
+ * previous one: scheduled = previous run + period, lateness = actual -
+ * scheduled. A run more than one period late has missed periods (LVGL
+ * does not catch up; it runs once and starts over).
+ *
+ * Per (timer, handler) key the table keeps runs, a log2 lateness
+ * histogram, missed periods and callback time; report() sorts the keys by
+ * total CPU time. When the table is full, a key only gets in by spending
+ * more than the cheapest key held.
+ *
+ * Off (the default), LV_CPP_TIMER_STATS_SCOPE expands to nothing: the
+ * trampolines compile to the bare call. Raw lv_timer_create() timers are
+ * not timed; a TimerWheel shows up as its single driver timer.
+ *
+ * Usage:
+ * @code
+ * // analog clock: is the 100 ms update_time timer on time while rendering?
+ * lv::timer_stats::log(5);
+ *
+ * lv::timer_stats::TimerStat top[5];
+ * uint32_t n = lv::timer_stats::report(top, 5);
+ * uint32_t p99 = top[0].late.percentile_ms(99);
+ * @endcode
+ *
+ * Lateness has the 1 ms resolution of lv_tick_get(); callback time is
+ * measured in microseconds. A pause longer than the period counts as
+ * lateness of the first run after resume() (reset() it after resuming).
+ *
+ * With the option on, Scope reads lv_timer_t's period and last_run,
+ * which have no getters; the option requires LV_CPP_INTERNALS_OK and was
+ * checked against LVGL 9.4. Off, nothing private is included.
+ *
+ * Single-threaded: record and query from the LVGL thread.
+ * Heap allocation: NONE (fixed table)
+ */
+
+#include <lvgl.h>
+#include <cstdint>
+#include "version.hpp"
+#include "profiler.hpp"  // LV_CPP_PROFILE_FUNC_NAME
+
+#ifndef LV_CPP_USE_TIMER_STATS
+#define LV_CPP_USE_TIMER_STATS 0
+#endif
+
+#ifndef LV_CPP_TIMER_STATS_ENTRIES
+/// Distinct (timer, handler) keys kept, most CPU time first
+#define LV_CPP_TIMER_STATS_ENTRIES 32
+#endif
+
+#if LV_CPP_USE_TIMER_STATS
+
+#if !LV_CPP_INTERNALS_OK
+#error "LV_CPP_USE_TIMER_STATS reads LVGL internals checked against LVGL 9.4; see LV_CPP_INTERNALS_OK"
+#endif
+
+#include <src/misc/lv_timer_private.h>  // period, last_run
+#include <chrono>
+
+namespace lv::timer_stats {
+
+/// Lateness bucket count: bucket 0 is on time, bucket i is [2^(i-1), 2^i) ms late, the last is open-ended
+inline constexpr uint32_t kBuckets = 12;
+
+/// Lateness distribution of one timer
+struct LateHistogram {
+    uint32_t buckets[kBuckets];
+    uint32_t count;
+
+    /// Lower bound of bucket `i` in ms
+    [[nodiscard]] static constexpr uint32_t floor_ms(uint32_t i) noexcept {
+        return i == 0 ? 0 : 1u << (i - 1);
+    }
+
+    /// Upper bound (exclusive) of the bucket holding the p-th percentile
+    [[nodiscard]] uint32_t percentile_ms(uint32_t p) const noexcept {
+        if (count == 0) return 0;
+        const uint64_t want = (static_cast<uint64_t>(count) * p + 99) / 100;
+        uint64_t seen = 0;
+        for (uint32_t i = 0; i < kBuckets; ++i) {
+            seen += buckets[i];
+            if (seen >= want && seen) return i + 1 < kBuckets ? floor_ms(i + 1) : UINT32_MAX;
+        }
+        return UINT32_MAX;
+    }
+};
+
+/// Accumulated runs of one (timer, handler) key
+struct TimerStat {
+    lv_timer_t* timer;      ///< Identity only; may be deleted by now
+    const char* handler;    ///< Trampoline signature, names the callback
+    uint32_t period;        ///< Period at the last run (ms)
+    uint32_t runs;
+    uint32_t late_runs;     ///< Runs at least 1 ms after their scheduled time
+    uint32_t missed;        ///< Whole periods skipped by late runs
+    uint32_t max_late_ms;
+    uint32_t max_us;        ///< Longest callback
+    uint64_t total_late_ms;
+    uint64_t total_us;      ///< CPU time spent in the callback
+    LateHistogram late;     ///< Lateness of runs after the first
+    uint32_t last_run;      ///< lv_tick_get() of the previous run
+
+    [[nodiscard]] uint32_t avg_us() const noexcept {
+        return runs ? static_cast<uint32_t>(total_us / runs) : 0;
+    }
+
+    [[nodiscard]] uint32_t avg_late_ms() const noexcept {
+        return late.count ? static_cast<uint32_t>(total_late_ms / late.count) : 0;
+    }
+};
+
+namespace detail {
+
+struct Table {
+    TimerStat entries[LV_CPP_TIMER_STATS_ENTRIES];
+    uint32_t used = 0;
+    uint32_t evicted = 0;  ///< Keys pushed out (or refused) by costlier ones
+    bool enabled = true;
+};
+
+[[nodiscard]] inline Table& table() noexcept {
+    static Table t;
+    return t;
+}
+
+[[nodiscard]] inline uint64_t now_us() noexcept {
+    using namespace std::chrono;
+    return static_cast<uint64_t>(duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+[[nodiscard]] inline uint32_t bucket_of(uint32_t ms) noexcept {
+    uint32_t i = 0;
+    while (ms && i + 1 < kBuckets) { ms >>= 1; ++i; }
+    return i;
+}
+
+inline void record(lv_timer_t* timer, const char* handler, uint32_t run, uint32_t period, uint32_t us) noexcept {
+    Table& t = table();
+    TimerStat* slot = nullptr;
+    for (uint32_t i = 0; i < t.used; ++i) {
+        TimerStat& s = t.entries[i];
+        if (s.timer == timer && s.handler == handler) { slot = &s; break; }
+    }
+    if (!slot) {
+        if (t.used < LV_CPP_TIMER_STATS_ENTRIES) {
+            slot = &t.entries[t.used++];
+        } else {
+            TimerStat* cheapest = &t.entries[0];
+            for (uint32_t i = 1; i < t.used; ++i) {
+                if (t.entries[i].total_us < cheapest->total_us) cheapest = &t.entries[i];
+            }
+            ++t.evicted;
+            if (us <= cheapest->total_us) return;
+            slot = cheapest;
+        }
+        *slot = TimerStat{};
+        slot->timer = timer;
+        slot->handler = handler;
+    } else {
+        // lv_timer_ready() and reset() make a run early; count it as on time
+        const int32_t late = static_cast<int32_t>(run - (slot->last_run + period));
+        const uint32_t ms = late > 0 ? static_cast<uint32_t>(late) : 0;
+        LateHistogram& h = slot->late;
+        ++h.buckets[bucket_of(ms)];
+        ++h.count;
+        if (ms) {
+            ++slot->late_runs;
+            slot->total_late_ms += ms;
+            if (ms > slot->max_late_ms) slot->max_late_ms = ms;
+            if (period) slot->missed += ms / period;
+        }
+    }
+    slot->period = period;
+    slot->last_run = run;
+    ++slot->runs;
+    slot->total_us += us;
+    if (us > slot->max_us) slot->max_us = us;
+}
+
+} // namespace detail
+
+/**
+ * @brief RAII timer placed in the timer trampolines by LV_CPP_TIMER_STATS_SCOPE
+ *
+ * Reads the schedule before the callback runs, so callbacks that delete
+ * their own timer are still attributed.
+ */
+class Scope {
+    lv_timer_t* m_timer;
+    const char* m_handler;
+    uint64_t m_start;
+    uint32_t m_run;
+    uint32_t m_period;
+
+public:
+    Scope(lv_timer_t* t, const char* handler) noexcept
+        : m_timer(t)
+        , m_handler(handler)
+        , m_start(detail::now_us())
+        , m_run(t->last_run)
+        , m_period(t->period) {}
+
+    ~Scope() {
+        if (!detail::table().enabled) return;
+        const uint64_t us = detail::now_us() - m_start;
+        detail::record(m_timer, m_handler, m_run, m_period, us > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(us));
+    }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+};
+
+/// Pause or resume recording
+inline void enable(bool on) noexcept { detail::table().enabled = on; }
+
+[[nodiscard]] inline bool enabled() noexcept { return detail::table().enabled; }
+
+/// Keys currently held in the table
+[[nodiscard]] inline uint32_t size() noexcept { return detail::table().used; }
+
+/// Keys that did not fit (pushed out or too cheap to enter a full table)
+[[nodiscard]] inline uint32_t evicted() noexcept { return detail::table().evicted; }
+
+/// Stats of `timer` (the first handler seen on it), nullptr if not recorded
+[[nodiscard]] inline const TimerStat* find(lv_timer_t* timer) noexcept {
+    const detail::Table& t = detail::table();
+    for (uint32_t i = 0; i < t.used; ++i) {
+        if (t.entries[i].timer == timer) return &t.entries[i];
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Copy up to `max` entries into `out`, most total CPU time first
+ * @return Number of entries written
+ */
+inline uint32_t report(TimerStat* out, uint32_t max) noexcept {
+    const detail::Table& t = detail::table();
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < t.used; ++i) {
+        // Insertion into the bounded output, descending by total_us
+        const TimerStat& s = t.entries[i];
+        uint32_t pos = n;
+        while (pos > 0 && out[pos - 1].total_us < s.total_us) {
+            if (pos < max) out[pos] = out[pos - 1];
+            --pos;
+        }
+        if (pos < max) out[pos] = s;
+        if (n < max) ++n;
+    }
+    return n;
+}
+
+/// Visit all entries in table order
+template<typename F>
+void for_each(F&& fn) {
+    const detail::Table& t = detail::table();
+    for (uint32_t i = 0; i < t.used; ++i) fn(t.entries[i]);
+}
+
+inline void reset() noexcept {
+    detail::Table& t = detail::table();
+    t.used = 0;
+    t.evicted = 0;
+}
+
+/// LV_LOG_USER the `count` timers with the most CPU time, with their lateness
+inline void log(uint32_t count = 10) noexcept {
+    TimerStat top[8];
+    if (count > 8) count = 8;
+    const uint32_t n = report(top, count);
+    LV_LOG_USER("timers: %u keys, %u evicted", static_cast<unsigned>(size()), static_cast<unsigned>(evicted()));
+    for (uint32_t i = 0; i < n; ++i) {
+        const TimerStat& s = top[i];
+        LV_LOG_USER("  %u us total, avg %u max %u us x%u  period %u ms, late %u/%u (p99 < %u ms, max %u), missed %u  %p %s",
+                    static_cast<unsigned>(s.total_us), static_cast<unsigned>(s.avg_us()),
+                    static_cast<unsigned>(s.max_us), static_cast<unsigned>(s.runs),
+                    static_cast<unsigned>(s.period), static_cast<unsigned>(s.late_runs),
+                    static_cast<unsigned>(s.late.count), static_cast<unsigned>(s.late.percentile_ms(99)),
+                    static_cast<unsigned>(s.max_late_ms), static_cast<unsigned>(s.missed),
+                    static_cast<void*>(s.timer), s.handler);
+        (void)s;
+    }
+}
+
+} // namespace lv::timer_stats
+
+/// Time the enclosing timer trampoline; `t` is its lv_timer_t*
+#define LV_CPP_TIMER_STATS_SCOPE(t) \
+    ::lv::timer_stats::Scope lv_timer_stats_scope_((t), LV_CPP_PROFILE_FUNC_NAME)
+
+#else // !LV_CPP_USE_TIMER_STATS
+
+#define LV_CPP_TIMER_STATS_SCOPE(t) ((void)(t))
+
+#endif // LV_CPP_USE_TIMER_STATS
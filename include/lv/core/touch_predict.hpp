@@ -0,0 +1,253 @@
+#pragma once
+
+/**
+ * @file touch_predict.hpp
+ * @brief Pointer position prediction to hide drag and scroll latency
+ *
+ * By the time a frame reaches the glass the finger has moved on: a list
+ * scrolled at 1000 px/s trails it by 16 px per frame of latency. A
+ * predicting indev wraps its read callback and runs an alpha-beta filter
+ * (the steady-state Kalman filter of a constant-velocity model) over the
+ * pressed positions, then hands LVGL the position extrapolated `lead_ms`
+ * ahead. Scrolling, dragging and everything else that reads the pointer
+ * follow the predicted point; nothing else has to change.
+ *
+ * @code
+ * lv::Indev touch(lv_evdev_create(LV_INDEV_TYPE_POINTER, "/dev/input/event0"));
+ * touch.predict({.lead_ms = 24});                    // about 1.5 frames at 60 Hz
+ * ...
+ * lv::touch_predict::exclude(color_wheel);           // precise picking: raw points
+ * @endcode
+ *
+ * The press and the release always use the raw point, so clicks land
+ * where the finger touched. Slow moves (below `min_speed`) are not
+ * extrapolated, and the lead is capped at `max_px`, so a finger that stops
+ * shows at most a short overshoot that the filter pulls back over the next
+ * reads. Objects marked with exclude() (or a child of one) get raw points
+ * while they are pressed or scrolled.
+ *
+ * Set the indev's read callback before enabling; setting it again
+ * replaces the wrapper.
+ *
+ * Heap allocation: NONE in the wrapper (LV_CPP_TOUCH_PREDICT_MAX fixed
+ * slots; LVGL allocates the indev event descriptor)
+ */
+
+#include <lvgl.h>
+#include <cstdint>
+#include "object.hpp"
+
+#ifndef LV_CPP_TOUCH_PREDICT_MAX
+/// Pointer devices that can predict at once
+#define LV_CPP_TOUCH_PREDICT_MAX 2
+#endif
+
+#ifndef LV_CPP_TOUCH_PREDICT_OFF_FLAG
+/// Object flag marking objects (and their children) that want raw points
+#define LV_CPP_TOUCH_PREDICT_OFF_FLAG LV_OBJ_FLAG_USER_4
+#endif
+
+namespace lv {
+
+/// Tuning of a predicting pointer (see touch_predict.hpp)
+struct PredictConfig {
+    uint16_t lead_ms = LV_DEF_REFR_PERIOD * 3 / 2;  ///< How far ahead to extrapolate (input-to-photon latency)
+    uint16_t max_px = 32;                          ///< Longest extrapolation per axis
+    uint16_t min_speed = 50;                       ///< px/s below which the raw point is used
+    float alpha = 0.5f;                            ///< Position gain: higher follows the raw points more tightly
+    float beta = 0.1f;                             ///< Velocity gain: higher reacts faster, but more noisily
+};
+
+namespace touch_predict {
+
+/// Counters of a predicting indev
+struct Stats {
+    uint32_t reads;       ///< Pressed reads filtered
+    uint32_t predicted;   ///< Reads given a predicted point
+    uint32_t excluded;    ///< Reads left raw because the pressed object is excluded
+    uint32_t max_lead_px; ///< Largest distance between a raw and a predicted point (per axis)
+};
+
+namespace detail {
+
+struct Axis {
+    float pos = 0.0f;
+    float vel = 0.0f;   ///< px per ms
+
+    void reset(int32_t p) noexcept {
+        pos = static_cast<float>(p);
+        vel = 0.0f;
+    }
+
+    void update(int32_t meas, float dt, float alpha, float beta) noexcept {
+        const float guess = pos + vel * dt;
+        const float r = static_cast<float>(meas) - guess;
+        pos = guess + alpha * r;
+        vel += beta * r / dt;
+    }
+
+    /// Raw point moved by the capped lead
+    [[nodiscard]] int32_t predict(int32_t raw, const PredictConfig& cfg) const noexcept {
+        float lead = vel * cfg.lead_ms;
+        const float cap = cfg.max_px;
+        lead = lead > cap ? cap : lead < -cap ? -cap : lead;
+        return raw + static_cast<int32_t>(lead < 0 ? lead - 0.5f : lead + 0.5f);
+    }
+};
+
+struct Slot {
+    lv_indev_t* indev = nullptr;          ///< nullptr: free slot
+    lv_indev_read_cb_t read_cb = nullptr; ///< Wrapped driver callback
+    PredictConfig cfg{};
+    Axis x{};
+    Axis y{};
+    uint32_t last_tick = 0;
+    bool pressed = false;
+    Stats stats{};
+};
+
+[[nodiscard]] inline Slot* slots() noexcept {
+    static Slot s[LV_CPP_TOUCH_PREDICT_MAX];
+    return s;
+}
+
+[[nodiscard]] inline Slot* find(const lv_indev_t* indev) noexcept {
+    Slot* s = slots();
+    for (uint32_t i = 0; i < LV_CPP_TOUCH_PREDICT_MAX; ++i) {
+        if (s[i].indev == indev) return &s[i];
+    }
+    return nullptr;
+}
+
+[[nodiscard]] inline bool is_excluded(lv_obj_t* obj) noexcept {
+    for (; obj; obj = lv_obj_get_parent(obj)) {
+        if (lv_obj_has_flag(obj, LV_CPP_TOUCH_PREDICT_OFF_FLAG)) return true;
+    }
+    return false;
+}
+
+inline void filter(Slot& s, lv_indev_t* indev, lv_indev_data_t* data) noexcept {
+    const uint32_t now = lv_tick_get();
+    if (data->state != LV_INDEV_STATE_PRESSED) {
+        s.pressed = false;
+        return;
+    }
+    if (!s.pressed) {
+        // Press: start over from the raw point
+        s.pressed = true;
+        s.x.reset(data->point.x);
+        s.y.reset(data->point.y);
+        s.last_tick = now;
+        return;
+    }
+    ++s.stats.reads;
+    const uint32_t dt = now - s.last_tick;
+    if (dt > 0) {
+        s.last_tick = now;
+        s.x.update(data->point.x, static_cast<float>(dt), s.cfg.alpha, s.cfg.beta);
+        s.y.update(data->point.y, static_cast<float>(dt), s.cfg.alpha, s.cfg.beta);
+    }
+    if (is_excluded(lv_indev_get_active_obj()) || is_excluded(lv_indev_get_scroll_obj(indev))) {
+        ++s.stats.excluded;
+        return;
+    }
+    // px/ms squared against (px/s / 1000) squared
+    const float speed2 = s.x.vel * s.x.vel + s.y.vel * s.y.vel;
+    const float min = s.cfg.min_speed / 1000.0f;
+    if (speed2 < min * min) return;
+
+    const int32_t px = s.x.predict(data->point.x, s.cfg);
+    const int32_t py = s.y.predict(data->point.y, s.cfg);
+    const uint32_t dx = static_cast<uint32_t>(px > data->point.x ? px - data->point.x : data->point.x - px);
+    const uint32_t dy = static_cast<uint32_t>(py > data->point.y ? py - data->point.y : data->point.y - py);
+    const uint32_t lead = dx > dy ? dx : dy;
+    if (lead > s.stats.max_lead_px) s.stats.max_lead_px = lead;
+    data->point.x = px;
+    data->point.y = py;
+    ++s.stats.predicted;
+}
+
+inline void read_cb(lv_indev_t* indev, lv_indev_data_t* data) noexcept {
+    Slot* s = find(indev);
+    if (!s) return;
+    if (s->read_cb) s->read_cb(indev, data);
+    filter(*s, indev, data);
+}
+
+inline void release(Slot& s) noexcept {
+    if (lv_indev_get_read_cb(s.indev) == &read_cb) lv_indev_set_read_cb(s.indev, s.read_cb);
+    s = Slot{};
+}
+
+inline void delete_cb(lv_event_t* e) noexcept {
+    if (Slot* s = find(static_cast<lv_indev_t*>(lv_event_get_current_target(e)))) *s = Slot{};
+}
+
+} // namespace detail
+
+/**
+ * @brief Predict the pointer position of `indev` (see the file comment)
+ *
+ * Enabling again applies a new configuration (the counters are kept).
+ *
+ * @return false for non-pointer devices or when LV_CPP_TOUCH_PREDICT_MAX is reached
+ */
+inline bool enable(lv_indev_t* indev, const PredictConfig& cfg = {}) noexcept {
+    if (!indev || lv_indev_get_type(indev) != LV_INDEV_TYPE_POINTER) return false;
+    detail::Slot* s = detail::find(indev);
+    if (!s) {
+        s = detail::find(nullptr);
+        if (!s) {
+            LV_LOG_WARN("predicting pointers exhausted, raise LV_CPP_TOUCH_PREDICT_MAX");
+            return false;
+        }
+        s->indev = indev;
+        s->read_cb = lv_indev_get_read_cb(indev);
+        lv_indev_set_read_cb(indev, &detail::read_cb);
+        lv_indev_add_event_cb(indev, &detail::delete_cb, LV_EVENT_DELETE, nullptr);
+    }
+    s->cfg = cfg;
+    return true;
+}
+
+/// Back to raw points; the driver's read callback is restored
+inline void disable(lv_indev_t* indev) noexcept {
+    detail::Slot* s = indev ? detail::find(indev) : nullptr;
+    if (!s) return;
+    lv_indev_remove_event_cb_with_user_data(indev, &detail::delete_cb, nullptr);
+    detail::release(*s);
+}
+
+[[nodiscard]] inline bool enabled(lv_indev_t* indev) noexcept {
+    return indev && detail::find(indev);
+}
+
+/// Current tuning (defaults if not predicting)
+[[nodiscard]] inline PredictConfig config(lv_indev_t* indev) noexcept {
+    const detail::Slot* s = indev ? detail::find(indev) : nullptr;
+    return s ? s->cfg : PredictConfig{};
+}
+
+/// Give `obj` and its children raw points (or predicted ones again)
+inline void exclude(ObjectView obj, bool raw = true) noexcept {
+    if (!obj) return;
+    if (raw) {
+        lv_obj_add_flag(obj.get(), LV_CPP_TOUCH_PREDICT_OFF_FLAG);
+    } else {
+        lv_obj_remove_flag(obj.get(), LV_CPP_TOUCH_PREDICT_OFF_FLAG);
+    }
+}
+
+/// Counters of a predicting indev (zero if not predicting)
+[[nodiscard]] inline Stats stats(lv_indev_t* indev) noexcept {
+    const detail::Slot* s = indev ? detail::find(indev) : nullptr;
+    return s ? s->stats : Stats{};
+}
+
+inline void reset_stats(lv_indev_t* indev) noexcept {
+    if (detail::Slot* s = indev ? detail::find(indev) : nullptr) s->stats = Stats{};
+}
+
+} // namespace touch_predict
+
+} // namespace lv
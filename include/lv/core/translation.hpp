@@ -20,6 +20,26 @@
  *   // Set language and use
  *   lv::translation::set_language("de");
  *   label.text(lv::tr("hello"));  // Shows "Hallo"
+ *
+ * LVGL finds a tag by comparing it with every tag of every pack. For
+ * large tables, IndexedPack hashes the tags of a static pack once, and
+ * use() makes lv::tr() look there first:
+ *
+ *   static lv::translation::IndexedPack pack(langs, tags, trans);
+ *   pack.use();          // lv::tr(): one hash probe
+ *   pack.install();      // also for LVGL's own translation tags (linear)
+ *
+ * BinaryPack (translation_pack.hpp) serves a precompiled, mapped pack
+ * the same way.
+ *
+ * Labels bound with bind() (Label::translated()) are relabelled by
+ * switch_language() in one batch with one layout pass and invalidation
+ * per screen; preload() warms the new script's glyphs beforehand.
+ *
+ * Heap allocation: IndexedPack's hash table (8 bytes per slot, twice the
+ * tag count rounded up to a power of two), once per build(); bindings and
+ * the preload scratch are static (LV_CPP_TRANSLATION_LABELS,
+ * LV_CPP_TRANSLATION_PRELOAD_GLYPHS)
  */
 
 #include <lvgl.h>
@@ -27,20 +47,122 @@
 #if LV_USE_TRANSLATION
 
 #include <cstdint>
+#include <cstring>
+#include "prefetch.hpp"
+
+#ifndef LV_CPP_TRANSLATION_SOURCES
+/// Indexed packs lv::tr() searches before LVGL's own lookup
+#define LV_CPP_TRANSLATION_SOURCES 4
+#endif
+
+#ifndef LV_CPP_TRANSLATION_LABELS
+/// Labels bound with translation::bind() / Label::translated()
+#define LV_CPP_TRANSLATION_LABELS 128
+#endif
+
+#ifndef LV_CPP_TRANSLATION_PRELOAD_GLYPHS
+/// Distinct letters translation::preload() collects
+#define LV_CPP_TRANSLATION_PRELOAD_GLYPHS 256
+#endif
 
 namespace lv {
 
+namespace translation::detail {
+
+/// Tag hash shared with scripts/translation_pack.py (FNV-1a with a seed, then mixed)
+[[nodiscard]] inline uint32_t hash(const char* s, uint32_t seed) noexcept {
+    uint32_t h = 0x811C9DC5u ^ (seed * 0x9E3779B9u);
+    for (; *s; ++s) {
+        h ^= static_cast<uint8_t>(*s);
+        h *= 0x01000193u;
+    }
+    h ^= h >> 16;
+    h *= 0x85EBCA6Bu;
+    h ^= h >> 13;
+    return h;
+}
+
+/// Text of `tag` in `lang` (nullptr: the current language), or nullptr if the pack lacks either
+using lookup_fn = const char* (*)(const void* pack, const char* tag, const char* lang) noexcept;
+
+struct Source {
+    const void* pack;
+    lookup_fn lookup;
+};
+
+struct Sources {
+    Source slots[LV_CPP_TRANSLATION_SOURCES] = {};
+    uint8_t count = 0;
+};
+
+[[nodiscard]] inline Sources& sources() noexcept {
+    static Sources s;
+    return s;
+}
+
+inline bool add_source(const void* pack, lookup_fn lookup) noexcept {
+    Sources& s = sources();
+    for (uint8_t i = 0; i < s.count; ++i) {
+        if (s.slots[i].pack == pack) return true;
+    }
+    if (s.count == LV_CPP_TRANSLATION_SOURCES) {
+        LV_LOG_WARN("translation sources exhausted, raise LV_CPP_TRANSLATION_SOURCES");
+        return false;
+    }
+    s.slots[s.count++] = Source{pack, lookup};
+    return true;
+}
+
+inline void remove_source(const void* pack) noexcept {
+    Sources& s = sources();
+    for (uint8_t i = 0; i < s.count; ++i) {
+        if (s.slots[i].pack != pack) continue;
+        for (uint8_t j = i + 1; j < s.count; ++j) s.slots[j - 1] = s.slots[j];
+        --s.count;
+        return;
+    }
+}
+
+/// Index of the current language among `count` names, cached by language pointer and name
+struct LanguageCache {
+    const char* lang = nullptr;
+    int32_t index = -1;
+
+    template<typename NameAt>
+    [[nodiscard]] int32_t resolve(uint32_t count, NameAt&& name_at) noexcept {
+        const char* cur = lv_translation_get_language();
+        if (!cur) return -1;
+        if (cur == lang && index >= 0 && std::strcmp(cur, name_at(static_cast<uint32_t>(index))) == 0) return index;
+        lang = cur;
+        index = -1;
+        for (uint32_t i = 0; i < count; ++i) {
+            if (std::strcmp(cur, name_at(i)) == 0) {
+                index = static_cast<int32_t>(i);
+                break;
+            }
+        }
+        return index;
+    }
+};
+
+} // namespace translation::detail
+
 // ==================== Shorthand Translation Function ====================
 
 /**
  * @brief Get translated text for a tag
  *
- * Shorthand for lv_tr(). Returns the translation for the current language.
+ * Looks in the packs registered with use() first (hashed), then falls
+ * back to lv_tr(). Returns the translation for the current language.
  *
  * @param tag The tag/key to translate
  * @return Translated text, or the tag itself if not found
  */
 inline const char* tr(const char* tag) noexcept {
+    const translation::detail::Sources& s = translation::detail::sources();
+    for (uint8_t i = 0; i < s.count; ++i) {
+        if (const char* text = s.slots[i].lookup(s.slots[i].pack, tag, nullptr)) return text;
+    }
     return lv_tr(tag);
 }
 
@@ -82,12 +204,12 @@ inline const char* get_language() noexcept {
 }
 
 /**
- * @brief Get translated text for a tag
+ * @brief Get translated text for a tag (same lookup as lv::tr())
  * @param tag The tag/key to translate
  * @return Translated text
  */
 inline const char* get(const char* tag) noexcept {
-    return lv_translation_get(tag);
+    return tr(tag);
 }
 
 /**
@@ -116,12 +238,150 @@ inline lv_translation_pack_t* add_static(
     return lv_translation_add_static(languages, tags, translations);
 }
 
+// ==================== Indexed Static Pack ====================
+
+/**
+ * @brief Static translation arrays with a hashed tag index
+ *
+ * Takes the arrays of add_static() (which must stay valid) and builds an
+ * open-addressing table of tag hashes once, so a lookup is one probe and
+ * usually one strcmp() instead of a scan over all tags. The first of
+ * duplicate tags wins, as in LVGL.
+ *
+ * Not movable: use() registers its address.
+ */
+class IndexedPack {
+    struct Slot {
+        uint32_t hash;
+        uint32_t tag;    ///< Tag index + 1; 0 = empty
+    };
+
+    const char* const* m_langs = nullptr;
+    const char* const* m_tags = nullptr;
+    const char* const* m_texts = nullptr;
+    uint32_t m_lang_count = 0;
+    uint32_t m_tag_count = 0;
+    Slot* m_slots = nullptr;
+    uint32_t m_mask = 0;
+    mutable detail::LanguageCache m_current;
+
+    static const char* lookup_cb(const void* pack, const char* tag, const char* lang) noexcept {
+        const auto* self = static_cast<const IndexedPack*>(pack);
+        if (!lang) return self->get(tag);
+        const int32_t i = self->language_index(lang);
+        return i < 0 ? nullptr : self->get(tag, static_cast<uint32_t>(i));
+    }
+
+public:
+    IndexedPack() noexcept = default;
+
+    /// Same arrays as add_static(): null-terminated languages and tags, texts by tag then language
+    IndexedPack(const char* const* languages, const char* const* tags, const char* const* translations) noexcept {
+        build(languages, tags, translations);
+    }
+
+    ~IndexedPack() {
+        detail::remove_source(this);
+        lv_free(m_slots);
+    }
+
+    IndexedPack(const IndexedPack&) = delete;
+    IndexedPack& operator=(const IndexedPack&) = delete;
+
+    /**
+     * @brief Index the arrays (replaces a previous build)
+     * @return false if out of memory
+     */
+    bool build(const char* const* languages, const char* const* tags, const char* const* translations) noexcept {
+        lv_free(m_slots);
+        m_slots = nullptr;
+        m_mask = 0;
+        m_langs = languages;
+        m_tags = tags;
+        m_texts = translations;
+        m_lang_count = 0;
+        m_tag_count = 0;
+        m_current = {};
+        while (languages[m_lang_count]) ++m_lang_count;
+        while (tags[m_tag_count]) ++m_tag_count;
+
+        uint32_t size = 8;
+        while (size < m_tag_count * 2) size *= 2;
+        m_slots = static_cast<Slot*>(lv_malloc(sizeof(Slot) * size));
+        if (!m_slots) return false;
+        std::memset(m_slots, 0, sizeof(Slot) * size);
+        m_mask = size - 1;
+        for (uint32_t t = 0; t < m_tag_count; ++t) {
+            const uint32_t h = detail::hash(tags[t], 0);
+            uint32_t i = h & m_mask;
+            while (m_slots[i].tag && (m_slots[i].hash != h || std::strcmp(m_tags[m_slots[i].tag - 1], tags[t]) != 0)) {
+                i = (i + 1) & m_mask;
+            }
+            if (!m_slots[i].tag) m_slots[i] = Slot{h, t + 1};
+        }
+        return true;
+    }
+
+    /// Index of `tag`, or -1
+    [[nodiscard]] int32_t find(const char* tag) const noexcept {
+        if (!m_slots || !tag) return -1;
+        const uint32_t h = detail::hash(tag, 0);
+        for (uint32_t i = h & m_mask; m_slots[i].tag; i = (i + 1) & m_mask) {
+            if (m_slots[i].hash == h && std::strcmp(m_tags[m_slots[i].tag - 1], tag) == 0) {
+                return static_cast<int32_t>(m_slots[i].tag - 1);
+            }
+        }
+        return -1;
+    }
+
+    /// Text of `tag` in language `lang` (the tag if it has no text there), nullptr if not in the pack
+    [[nodiscard]] const char* get(const char* tag, uint32_t lang) const noexcept {
+        const int32_t t = find(tag);
+        if (t < 0 || lang >= m_lang_count) return nullptr;
+        const char* text = m_texts[static_cast<uint32_t>(t) * m_lang_count + lang];
+        return text ? text : m_tags[t];
+    }
+
+    /// Text of `tag` in the current language, nullptr if the pack lacks the tag or the language
+    [[nodiscard]] const char* get(const char* tag) const noexcept {
+        const int32_t lang = m_current.resolve(m_lang_count, [this](uint32_t i) { return m_langs[i]; });
+        return lang < 0 ? nullptr : get(tag, static_cast<uint32_t>(lang));
+    }
+
+    /// Index of `lang` in this pack, or -1
+    [[nodiscard]] int32_t language_index(const char* lang) const noexcept {
+        for (uint32_t i = 0; i < m_lang_count; ++i) {
+            if (std::strcmp(m_langs[i], lang) == 0) return static_cast<int32_t>(i);
+        }
+        return -1;
+    }
+
+    /// Make lv::tr() look here before LVGL's packs
+    bool use() noexcept { return m_slots && detail::add_source(this, &IndexedPack::lookup_cb); }
+
+    /// Stop lv::tr() from looking here
+    void unuse() noexcept { detail::remove_source(this); }
+
+    /// Also register the arrays with LVGL (for widgets with translation tags); they must outlive LVGL's use
+    lv_translation_pack_t* install() noexcept {
+        return lv_translation_add_static(const_cast<const char**>(m_langs), const_cast<const char**>(m_tags),
+                                         const_cast<const char**>(m_texts));
+    }
+
+    [[nodiscard]] uint32_t language_count() const noexcept { return m_lang_count; }
+    [[nodiscard]] uint32_t tag_count() const noexcept { return m_tag_count; }
+    [[nodiscard]] bool valid() const noexcept { return m_slots != nullptr; }
+    explicit operator bool() const noexcept { return valid(); }
+};
+
 // ==================== Dynamic Translation Pack ====================
 
 /**
  * @brief RAII wrapper for dynamic translation packs
  *
- * Allows adding languages and translations at runtime.
+ * Allows adding languages and translations at runtime. LVGL copies
+ * every tag and looks them up linearly; for thousands of strings prefer
+ * IndexedPack or a BinaryPack.
  *
  * Usage:
  *   lv::translation::DynamicPack pack;
@@ -215,6 +475,228 @@ public:
     }
 };
 
+// ==================== Language Switch ====================
+
+#if LV_USE_LABEL
+
+namespace detail {
+
+struct Bound {
+    lv_obj_t* label;
+    const char* tag;
+};
+
+struct Bindings {
+    Bound slots[LV_CPP_TRANSLATION_LABELS];
+    uint32_t count = 0;
+};
+
+[[nodiscard]] inline Bindings& bindings() noexcept {
+    static Bindings b;
+    return b;
+}
+
+inline void remove_binding(lv_obj_t* label) noexcept {
+    Bindings& b = bindings();
+    for (uint32_t i = 0; i < b.count; ++i) {
+        if (b.slots[i].label != label) continue;
+        b.slots[i] = b.slots[--b.count];
+        return;
+    }
+}
+
+inline void bound_delete_cb(lv_event_t* e) noexcept {
+    remove_binding(static_cast<lv_obj_t*>(lv_event_get_target(e)));
+}
+
+/// Unique letters per font collected by preload()
+struct PreloadScratch {
+    const lv_font_t* fonts[8] = {};
+    uint8_t font_of[LV_CPP_TRANSLATION_PRELOAD_GLYPHS] = {};
+    uint32_t letters[LV_CPP_TRANSLATION_PRELOAD_GLYPHS] = {};
+    uint32_t count = 0;
+    char utf8[LV_CPP_TRANSLATION_PRELOAD_GLYPHS * 4 + 1];
+};
+
+[[nodiscard]] inline PreloadScratch& preload_scratch() noexcept {
+    static PreloadScratch p;
+    return p;
+}
+
+[[nodiscard]] inline uint32_t encode_utf8(uint32_t c, char* out) noexcept {
+    if (c < 0x80) {
+        out[0] = static_cast<char>(c);
+        return 1;
+    }
+    if (c < 0x800) {
+        out[0] = static_cast<char>(0xC0 | (c >> 6));
+        out[1] = static_cast<char>(0x80 | (c & 0x3F));
+        return 2;
+    }
+    if (c < 0x10000) {
+        out[0] = static_cast<char>(0xE0 | (c >> 12));
+        out[1] = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+        out[2] = static_cast<char>(0x80 | (c & 0x3F));
+        return 3;
+    }
+    out[0] = static_cast<char>(0xF0 | (c >> 18));
+    out[1] = static_cast<char>(0x80 | ((c >> 12) & 0x3F));
+    out[2] = static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+    out[3] = static_cast<char>(0x80 | (c & 0x3F));
+    return 4;
+}
+
+} // namespace detail
+
+/**
+ * @brief Text of `tag` in `lang` from the packs registered with use()
+ * @return nullptr if no registered pack has the tag in that language
+ */
+[[nodiscard]] inline const char* lookup(const char* tag, const char* lang) noexcept {
+    const detail::Sources& s = detail::sources();
+    for (uint8_t i = 0; i < s.count; ++i) {
+        if (const char* text = s.slots[i].lookup(s.slots[i].pack, tag, lang)) return text;
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Show lv::tr(tag) on `label` and relabel it in switch_language()
+ *
+ * `tag` must stay valid while the label lives. Deleting the label drops
+ * the binding.
+ *
+ * @return false if all LV_CPP_TRANSLATION_LABELS bindings are taken
+ */
+inline bool bind(lv_obj_t* label, const char* tag) noexcept {
+    detail::Bindings& b = detail::bindings();
+    lv_label_set_text(label, tr(tag));
+    for (uint32_t i = 0; i < b.count; ++i) {
+        if (b.slots[i].label != label) continue;
+        b.slots[i].tag = tag;
+        return true;
+    }
+    if (b.count == LV_CPP_TRANSLATION_LABELS) {
+        LV_LOG_WARN("translated labels exhausted, raise LV_CPP_TRANSLATION_LABELS");
+        return false;
+    }
+    b.slots[b.count++] = detail::Bound{label, tag};
+    lv_obj_add_event_cb(label, &detail::bound_delete_cb, LV_EVENT_DELETE, nullptr);
+    return true;
+}
+
+/// Stop relabelling `label` (its text stays)
+inline void unbind(lv_obj_t* label) noexcept {
+    detail::remove_binding(label);
+    lv_obj_remove_event_cb_with_user_data(label, &detail::bound_delete_cb, nullptr);
+}
+
+/// Labels bound with bind()
+[[nodiscard]] inline uint32_t bound_count() noexcept {
+    return detail::bindings().count;
+}
+
+/**
+ * @brief Queue the glyphs the bound labels will show in `lang` (idle time)
+ *
+ * Resolves every bound tag in `lang` through the packs registered with
+ * use() (tags only LVGL knows are skipped), collects the distinct letters
+ * per label font (up to LV_CPP_TRANSLATION_PRELOAD_GLYPHS) and hands them
+ * to lv::prefetch, so Arabic or CJK glyphs are rendered into the font
+ * caches before switch_language() needs them:
+ *
+ * @code
+ * m_switch_to = "zh";
+ * m_ticket = lv::translation::preload("zh");
+ * ...   // later, e.g. from a timer
+ * if (lv::prefetch::pending(m_ticket) == 0) lv::translation::switch_language(m_switch_to);
+ * @endcode
+ */
+inline prefetch::Ticket preload(const char* lang, prefetch::Ticket t = 0) noexcept {
+    detail::Bindings& b = detail::bindings();
+    detail::PreloadScratch& p = detail::preload_scratch();
+    p.count = 0;
+    uint8_t font_cnt = 0;
+    for (uint32_t i = 0; i < b.count; ++i) {
+        const char* text = lookup(b.slots[i].tag, lang);
+        if (!text) continue;
+        const lv_font_t* font = lv_obj_get_style_text_font(b.slots[i].label, LV_PART_MAIN);
+        uint8_t f = 0;
+        while (f < font_cnt && p.fonts[f] != font) ++f;
+        if (f == font_cnt) {
+            if (font_cnt == sizeof(p.fonts) / sizeof(p.fonts[0])) continue;
+            p.fonts[font_cnt++] = font;
+        }
+        uint32_t at = 0;
+        while (text[at]) {
+            const uint32_t letter = lv_text_encoded_next(text, &at);
+            if (letter <= 0x20) continue;
+            bool seen = false;
+            for (uint32_t k = 0; k < p.count && !seen; ++k) seen = p.letters[k] == letter && p.font_of[k] == f;
+            if (seen) continue;
+            if (p.count == LV_CPP_TRANSLATION_PRELOAD_GLYPHS) break;
+            p.letters[p.count] = letter;
+            p.font_of[p.count++] = f;
+        }
+    }
+    for (uint8_t f = 0; f < font_cnt; ++f) {
+        uint32_t len = 0;
+        for (uint32_t k = 0; k < p.count; ++k) {
+            if (p.font_of[k] == f) len += detail::encode_utf8(p.letters[k], p.utf8 + len);
+        }
+        p.utf8[len] = '\0';
+        t = prefetch::text(p.fonts[f], p.utf8, t);
+    }
+    return t;
+}
+
+/**
+ * @brief Change the language and relabel in one batch
+ *
+ * lv_translation_set_language() alone makes every tag-bound label set its
+ * text, and each set invalidates the label's old and new area on its own.
+ * Here invalidation is off on all displays while LVGL relabels its
+ * tag-bound labels and the labels bound with bind() get their pre-resolved
+ * texts (labels whose text does not change are left alone). Then each
+ * display's active screen and layers get one layout pass and one
+ * invalidation.
+ *
+ * @return Bound labels whose text changed
+ */
+inline uint32_t switch_language(const char* lang) noexcept {
+    detail::Bindings& b = detail::bindings();
+    for (lv_display_t* d = lv_display_get_next(nullptr); d; d = lv_display_get_next(d)) {
+        lv_display_enable_invalidation(d, false);
+    }
+    lv_translation_set_language(lang);
+
+    // Resolve everything before touching a label
+    const char* texts[LV_CPP_TRANSLATION_LABELS];
+    for (uint32_t i = 0; i < b.count; ++i) texts[i] = tr(b.slots[i].tag);
+    uint32_t changed = 0;
+    for (uint32_t i = 0; i < b.count; ++i) {
+        if (std::strcmp(lv_label_get_text(b.slots[i].label), texts[i]) == 0) continue;
+        lv_label_set_text(b.slots[i].label, texts[i]);
+        ++changed;
+    }
+
+    for (lv_display_t* d = lv_display_get_next(nullptr); d; d = lv_display_get_next(d)) {
+        lv_obj_t* const screens[] = {lv_display_get_screen_active(d), lv_display_get_layer_top(d),
+                                     lv_display_get_layer_sys(d)};
+        for (lv_obj_t* scr : screens) {
+            if (scr) lv_obj_update_layout(scr);
+        }
+        lv_display_enable_invalidation(d, true);
+        for (lv_obj_t* scr : screens) {
+            if (scr) lv_obj_invalidate(scr);
+        }
+    }
+    return changed;
+}
+
+#endif // LV_USE_LABEL
+
+
 } // namespace translation
 
 } // namespace lv
@@ -0,0 +1,256 @@
+#pragma once
+
+/**
+ * @file translation_pack.hpp
+ * @brief Precompiled translation packs used straight from a mapped file
+ *
+ * scripts/translation_pack.py compiles lv_i18n style YAML files (one
+ * language per file, as in demos/ebike/translations) into one binary
+ * pack: a string table, offset tables and a minimal perfect hash of the
+ * tags. BinaryPack maps it with fs::MappedFile and answers lookups from
+ * the mapping, so no string is copied and a lookup is two hashes and one
+ * strcmp():
+ *
+ * @code
+ * static lv::translation::BinaryPack texts("A:/lang/ebike.ltp");
+ * texts.use();                        // lv::tr() looks here first
+ * lv::translation::set_language("ar");
+ * label.text(lv::tr("Battery"));
+ * @endcode
+ *
+ * install() also hands the pack to LVGL (for widgets with translation
+ * tags) through lv_translation_add_static(); that needs one pointer per
+ * string, and the pack must then stay open until lv_translation_deinit().
+ *
+ * Heap allocation: NONE when mapped (a pooled copy of the file otherwise);
+ * install() allocates the pointer arrays
+ */
+
+#include <lvgl.h>
+
+#if LV_USE_TRANSLATION
+
+#include <cstdint>
+#include <cstring>
+#include "mapped_file.hpp"
+#include "translation.hpp"
+
+namespace lv::translation {
+
+namespace detail::tpack {
+
+inline constexpr char magic[4] = {'L', 'V', 'T', 'P'};
+inline constexpr uint32_t missing = UINT32_MAX;
+
+/// File header; followed by uint32 language offsets, int32 displacements,
+/// uint32 tag offsets (in hash slot order), uint32 text offsets (by slot,
+/// then language; `missing` if untranslated) and the NUL-terminated strings.
+/// Offsets are relative to the string table.
+struct Head {
+    char magic[4];
+    uint16_t version;
+    uint16_t lang_count;
+    uint32_t tag_count;
+    uint32_t seed;          ///< Seed of the first-level hash
+    uint32_t strings_size;
+};
+static_assert(sizeof(Head) == 20, "translation pack header must be packed");
+
+[[nodiscard]] inline uint32_t u32(const uint8_t* table, uint32_t i) noexcept {
+    uint32_t v;
+    std::memcpy(&v, table + 4u * i, sizeof(v));
+    return v;
+}
+
+} // namespace detail::tpack
+
+/**
+ * @brief Translation pack over a mapped .ltp file (scripts/translation_pack.py)
+ *
+ * Not movable: use() registers its address and install() hands pointers
+ * into the mapping to LVGL.
+ */
+class BinaryPack {
+    fs::MappedFile m_file;
+    const uint8_t* m_data = nullptr;
+    detail::tpack::Head m_head{};
+    const uint8_t* m_lang_off = nullptr;
+    const uint8_t* m_disp = nullptr;
+    const uint8_t* m_tag_off = nullptr;
+    const uint8_t* m_text_off = nullptr;
+    const char* m_strings = nullptr;
+    const char** m_ptrs = nullptr;   ///< install(): languages, tags and texts for LVGL
+    mutable detail::LanguageCache m_current;
+
+    static const char* lookup_cb(const void* pack, const char* tag, const char* lang) noexcept {
+        const auto* self = static_cast<const BinaryPack*>(pack);
+        if (!lang) return self->get(tag);
+        const int32_t i = self->language_index(lang);
+        return i < 0 ? nullptr : self->get(tag, static_cast<uint32_t>(i));
+    }
+
+    [[nodiscard]] const char* str(uint32_t off) const noexcept { return m_strings + off; }
+
+    /// Check the layout and that every offset lands in the string table
+    [[nodiscard]] bool parse(const uint8_t* data, size_t size) noexcept {
+        namespace tp = detail::tpack;
+        if (size < sizeof(tp::Head)) return false;
+        std::memcpy(&m_head, data, sizeof(m_head));
+        if (std::memcmp(m_head.magic, tp::magic, sizeof(tp::magic)) != 0 || m_head.version != 1) return false;
+        const uint64_t tags = m_head.tag_count;
+        const uint64_t langs = m_head.lang_count;
+        const uint64_t tables = 4 * (langs + 2 * tags + tags * langs);
+        if (tags == 0 || sizeof(tp::Head) + tables + m_head.strings_size > size || m_head.strings_size == 0) return false;
+        m_lang_off = data + sizeof(tp::Head);
+        m_disp = m_lang_off + 4 * langs;
+        m_tag_off = m_disp + 4 * tags;
+        m_text_off = m_tag_off + 4 * tags;
+        m_strings = reinterpret_cast<const char*>(m_text_off + 4 * tags * langs);
+        if (m_strings[m_head.strings_size - 1] != '\0') return false;
+        const auto in_table = [this](uint32_t off) { return off < m_head.strings_size; };
+        for (uint32_t i = 0; i < langs; ++i) {
+            if (!in_table(tp::u32(m_lang_off, i))) return false;
+        }
+        for (uint32_t i = 0; i < tags; ++i) {
+            if (!in_table(tp::u32(m_tag_off, i))) return false;
+        }
+        for (uint32_t i = 0; i < tags * langs; ++i) {
+            const uint32_t off = tp::u32(m_text_off, i);
+            if (off != tp::missing && !in_table(off)) return false;
+        }
+        m_data = data;
+        return true;
+    }
+
+public:
+    BinaryPack() noexcept = default;
+
+    explicit BinaryPack(const char* path) noexcept { open(path); }
+
+    ~BinaryPack() { close(); }
+
+    BinaryPack(const BinaryPack&) = delete;
+    BinaryPack& operator=(const BinaryPack&) = delete;
+
+    /**
+     * @brief Map a pack (closes any current one first)
+     * @return false if the file is missing or not a valid pack
+     */
+    bool open(const char* path) noexcept {
+        close();
+        if (m_file.open(path) != LV_FS_RES_OK) return false;
+        if (!parse(m_file.data(), m_file.size())) {
+            LV_LOG_WARN("BinaryPack: %s is not a translation pack", path);
+            m_file.close();
+            return false;
+        }
+        return true;
+    }
+
+    /// Use a pack already in memory (e.g. linked in); `data` must outlive the pack
+    bool open(const uint8_t* data, size_t size) noexcept {
+        close();
+        return parse(data, size);
+    }
+
+    void close() noexcept {
+        detail::remove_source(this);
+        if (m_ptrs) LV_LOG_WARN("BinaryPack: closed while installed in LVGL");
+        lv_free(m_ptrs);
+        m_ptrs = nullptr;
+        m_data = nullptr;
+        m_current = {};
+        m_file.close();
+    }
+
+    [[nodiscard]] bool is_open() const noexcept { return m_data != nullptr; }
+    explicit operator bool() const noexcept { return is_open(); }
+
+    // ==================== Lookup ====================
+
+    /// Hash slot of `tag`, or -1
+    [[nodiscard]] int32_t find(const char* tag) const noexcept {
+        if (!m_data || !tag) return -1;
+        const uint32_t n = m_head.tag_count;
+        const auto d = static_cast<int32_t>(detail::tpack::u32(m_disp, detail::hash(tag, m_head.seed) % n));
+        const uint32_t slot = d < 0 ? static_cast<uint32_t>(-d - 1) : detail::hash(tag, static_cast<uint32_t>(d)) % n;
+        return std::strcmp(str(detail::tpack::u32(m_tag_off, slot)), tag) == 0 ? static_cast<int32_t>(slot) : -1;
+    }
+
+    /// Text of `tag` in language `lang` (the tag if untranslated there), nullptr if not in the pack
+    [[nodiscard]] const char* get(const char* tag, uint32_t lang) const noexcept {
+        const int32_t slot = find(tag);
+        if (slot < 0 || lang >= m_head.lang_count) return nullptr;
+        const uint32_t off = detail::tpack::u32(m_text_off, static_cast<uint32_t>(slot) * m_head.lang_count + lang);
+        return off == detail::tpack::missing ? str(detail::tpack::u32(m_tag_off, static_cast<uint32_t>(slot))) : str(off);
+    }
+
+    /// Text of `tag` in the current language, nullptr if the pack lacks the tag or the language
+    [[nodiscard]] const char* get(const char* tag) const noexcept {
+        if (!m_data) return nullptr;
+        const int32_t lang = m_current.resolve(m_head.lang_count, [this](uint32_t i) { return language(i); });
+        return lang < 0 ? nullptr : get(tag, static_cast<uint32_t>(lang));
+    }
+
+    [[nodiscard]] uint32_t language_count() const noexcept { return m_data ? m_head.lang_count : 0; }
+    [[nodiscard]] uint32_t tag_count() const noexcept { return m_data ? m_head.tag_count : 0; }
+
+    /// Code of language `i` ("en", "de", ...)
+    [[nodiscard]] const char* language(uint32_t i) const noexcept { return str(detail::tpack::u32(m_lang_off, i)); }
+
+    /// Index of `lang` in this pack, or -1
+    [[nodiscard]] int32_t language_index(const char* lang) const noexcept {
+        for (uint32_t i = 0; i < language_count(); ++i) {
+            if (std::strcmp(language(i), lang) == 0) return static_cast<int32_t>(i);
+        }
+        return -1;
+    }
+
+    /// True if backed by mmap() rather than a copy (always true for open(data, size))
+    [[nodiscard]] bool in_place() const noexcept { return m_data && (!m_file.is_open() || m_file.is_mapped()); }
+
+    // ==================== Registration ====================
+
+    /// Make lv::tr() look here before LVGL's packs
+    bool use() noexcept { return m_data && detail::add_source(this, &BinaryPack::lookup_cb); }
+
+    /// Stop lv::tr() from looking here
+    void unuse() noexcept { detail::remove_source(this); }
+
+    /**
+     * @brief Also register with LVGL (for widgets with translation tags)
+     *
+     * Builds null-terminated pointer arrays into the mapping; keep the pack
+     * open until lv_translation_deinit(). Untranslated texts show the tag.
+     */
+    lv_translation_pack_t* install() noexcept {
+        if (!m_data || m_ptrs) return nullptr;
+        const uint32_t langs = m_head.lang_count;
+        const uint32_t tags = m_head.tag_count;
+        m_ptrs = static_cast<const char**>(lv_malloc(sizeof(const char*) * (langs + 1 + tags + 1 + tags * langs)));
+        if (!m_ptrs) return nullptr;
+        const char** lang_ptrs = m_ptrs;
+        const char** tag_ptrs = lang_ptrs + langs + 1;
+        const char** text_ptrs = tag_ptrs + tags + 1;
+        for (uint32_t i = 0; i < langs; ++i) lang_ptrs[i] = language(i);
+        lang_ptrs[langs] = nullptr;
+        for (uint32_t t = 0; t < tags; ++t) {
+            tag_ptrs[t] = str(detail::tpack::u32(m_tag_off, t));
+            for (uint32_t l = 0; l < langs; ++l) {
+                const uint32_t off = detail::tpack::u32(m_text_off, t * langs + l);
+                text_ptrs[t * langs + l] = off == detail::tpack::missing ? tag_ptrs[t] : str(off);
+            }
+        }
+        tag_ptrs[tags] = nullptr;
+        return lv_translation_add_static(lang_ptrs, tag_ptrs, text_ptrs);
+    }
+
+    /// Heap bytes of install()'s pointer arrays
+    [[nodiscard]] size_t heap_bytes() const noexcept {
+        return m_ptrs ? sizeof(const char*) * (m_head.lang_count + 2u + m_head.tag_count * (m_head.lang_count + 1u)) : 0;
+    }
+};
+
+} // namespace lv::translation
+
+#endif // LV_USE_TRANSLATION
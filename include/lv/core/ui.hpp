@@ -0,0 +1,304 @@
+#pragma once
+
+/**
+ * @file ui.hpp
+ * @brief Declarative UI trees built in one pass
+ *
+ * A screen written as nested create() calls and fluent setters is easy to
+ * get out of order: a style added after the children are created makes
+ * LVGL refresh the styles of the whole subtree, and every call on a
+ * visible screen queues its own invalidated area. lv::ui describes the
+ * tree as nested values instead; build() walks it at compile time (the
+ * node types carry the structure, so the walk is a fold over tuples that
+ * inlines to the plain C calls) and, for every object:
+ *
+ *   1. creates it,
+ *   2. applies its text, shared styles, size and layout settings,
+ *   3. attaches its events (member-function trampolines, as on()),
+ *   4. only then builds its children,
+ *
+ * inside a BuildScope, so the built subtree is laid out and invalidated
+ * once.
+ *
+ * @code
+ * constexpr lv::ConstStyle card = lv::const_style().radius(8).pad_all(12);
+ *
+ * lv::ObjectView panel = lv::ui::build(screen,
+ *     lv::ui::box{lv::ui::style{card}, lv::ui::flex_col, lv::ui::gap{8},
+ *         lv::ui::label{"Settings"},
+ *         lv::ui::button{lv::ui::on_click<&App::save>(this), lv::ui::ref{&save_btn},
+ *             lv::ui::label{"Save"}}});
+ * @endcode
+ *
+ * Attributes and child nodes may be mixed in any order; attributes are
+ * always applied before any child is created. Other widgets are added with
+ * make<&lv_slider_create>(items...).
+ *
+ * Heap allocation: NONE beyond the LVGL objects and event descriptors
+ */
+
+#include <lvgl.h>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include "object.hpp"
+#include "event.hpp"
+#include "component.hpp"  // BuildScope
+
+namespace lv::ui {
+
+// ==================== Attributes ====================
+
+/// Flex flow (also sets LV_LAYOUT_FLEX)
+struct flow {
+    lv_flex_flow_t value;
+};
+
+inline constexpr flow flex_row{LV_FLEX_FLOW_ROW};
+inline constexpr flow flex_col{LV_FLEX_FLOW_COLUMN};
+inline constexpr flow flex_row_wrap{LV_FLEX_FLOW_ROW_WRAP};
+inline constexpr flow flex_col_wrap{LV_FLEX_FLOW_COLUMN_WRAP};
+
+/// Flex alignment (main, cross, track)
+struct flex_align {
+    lv_flex_align_t main;
+    lv_flex_align_t cross = LV_FLEX_ALIGN_START;
+    lv_flex_align_t track = LV_FLEX_ALIGN_START;
+};
+
+/// Flex grow of the object within its parent
+struct grow {
+    uint8_t value;
+};
+
+struct size {
+    int32_t w;
+    int32_t h;
+};
+
+struct width {
+    int32_t value;
+};
+
+struct height {
+    int32_t value;
+};
+
+/// Position relative to the parent (for objects outside a layout)
+struct align {
+    lv_align_t value;
+    int32_t x = 0;
+    int32_t y = 0;
+};
+
+/// Row and column gap
+struct gap {
+    int32_t value;
+};
+
+/// Padding on all sides
+struct pad {
+    int32_t value;
+};
+
+/// Shared style (ConstStyle, Style or any lv_style_t*); kept by pointer
+struct style {
+    const lv_style_t* value;
+    lv_style_selector_t selector = 0;
+
+    constexpr style(const lv_style_t* s, lv_style_selector_t sel = 0) noexcept : value(s), selector(sel) {}
+
+    template<typename S>
+        requires requires(const S& s) { { s.get() } -> std::convertible_to<const lv_style_t*>; }
+    constexpr style(const S& s, lv_style_selector_t sel = 0) noexcept : value(s.get()), selector(sel) {}
+};
+
+/// Add (or with `on` false, remove) an object flag
+struct flag {
+    lv_obj_flag_t value;
+    bool on = true;
+};
+
+/// Add a state (e.g. LV_STATE_CHECKED)
+struct state {
+    lv_state_t value;
+};
+
+/// Store the created object in `*out` (lv_obj_t* or ObjectView)
+template<typename T>
+struct ref {
+    T* out;
+};
+
+template<typename T>
+ref(T*) -> ref<T>;
+
+/// Member-function event handler, attached through a compile-time trampoline
+template<auto MemFn, typename T>
+struct on_event {
+    lv_event_code_t code;
+    T* instance;
+};
+
+template<auto MemFn, typename T>
+[[nodiscard]] constexpr on_event<MemFn, T> on(lv_event_code_t code, T* instance) noexcept {
+    return {code, instance};
+}
+
+template<auto MemFn, typename T>
+[[nodiscard]] constexpr on_event<MemFn, T> on_click(T* instance) noexcept {
+    return {LV_EVENT_CLICKED, instance};
+}
+
+template<auto MemFn, typename T>
+[[nodiscard]] constexpr on_event<MemFn, T> on_value_changed(T* instance) noexcept {
+    return {LV_EVENT_VALUE_CHANGED, instance};
+}
+
+// ==================== Nodes ====================
+
+/// Tag base of all nodes: build() recurses into these, everything else is an attribute
+struct node_tag {};
+
+template<typename T>
+inline constexpr bool is_node_v = std::is_base_of_v<node_tag, T>;
+
+namespace detail {
+
+inline void apply(lv_obj_t* obj, flow f) noexcept {
+    lv_obj_set_layout(obj, LV_LAYOUT_FLEX);
+    lv_obj_set_flex_flow(obj, f.value);
+}
+
+inline void apply(lv_obj_t* obj, flex_align a) noexcept { lv_obj_set_flex_align(obj, a.main, a.cross, a.track); }
+inline void apply(lv_obj_t* obj, grow g) noexcept { lv_obj_set_flex_grow(obj, g.value); }
+inline void apply(lv_obj_t* obj, size s) noexcept { lv_obj_set_size(obj, s.w, s.h); }
+inline void apply(lv_obj_t* obj, width w) noexcept { lv_obj_set_width(obj, w.value); }
+inline void apply(lv_obj_t* obj, height h) noexcept { lv_obj_set_height(obj, h.value); }
+inline void apply(lv_obj_t* obj, align a) noexcept { lv_obj_align(obj, a.value, a.x, a.y); }
+inline void apply(lv_obj_t* obj, gap g) noexcept { lv_obj_set_style_pad_gap(obj, g.value, 0); }
+inline void apply(lv_obj_t* obj, pad p) noexcept { lv_obj_set_style_pad_all(obj, p.value, 0); }
+inline void apply(lv_obj_t* obj, style s) noexcept { lv_obj_add_style(obj, s.value, s.selector); }
+inline void apply(lv_obj_t* obj, state s) noexcept { lv_obj_add_state(obj, s.value); }
+
+inline void apply(lv_obj_t* obj, flag f) noexcept {
+    if (f.on) {
+        lv_obj_add_flag(obj, f.value);
+    } else {
+        lv_obj_remove_flag(obj, f.value);
+    }
+}
+
+template<typename T>
+void apply(lv_obj_t* obj, ref<T> r) noexcept {
+    *r.out = T(obj);
+}
+
+template<auto MemFn, typename T>
+void apply(lv_obj_t* obj, on_event<MemFn, T> e) noexcept {
+    if constexpr (std::is_invocable_v<decltype(MemFn), T*, Event>) {
+        lv_obj_add_event_cb(obj, &lv::detail::MemberTrampolineEvent<MemFn, T>::callback, e.code, e.instance);
+    } else if constexpr (std::is_invocable_v<decltype(MemFn), T*, lv_event_t*>) {
+        lv_obj_add_event_cb(obj, &lv::detail::MemberTrampoline<MemFn, T>::callback, e.code, e.instance);
+    } else {
+        lv_obj_add_event_cb(obj, &lv::detail::MemberTrampolineNoArg<MemFn, T>::callback, e.code, e.instance);
+    }
+}
+
+template<typename Item>
+void apply_attr(lv_obj_t* obj, const Item& item) noexcept {
+    if constexpr (!is_node_v<Item>) apply(obj, item);
+}
+
+template<typename Item>
+void build_child(lv_obj_t* obj, const Item& item) noexcept {
+    if constexpr (is_node_v<Item>) item.build(obj);
+}
+
+/// Attributes of `items` first, then its child nodes, in declaration order
+template<typename... Items>
+void build_items(lv_obj_t* obj, const std::tuple<Items...>& items) noexcept {
+    std::apply([obj](const Items&... it) {
+        (apply_attr(obj, it), ...);
+        (build_child(obj, it), ...);
+    }, items);
+}
+
+} // namespace detail
+
+/// Any widget created by `Create(parent)`; see make()
+template<lv_obj_t* (*Create)(lv_obj_t*), typename... Items>
+struct widget : node_tag {
+    std::tuple<Items...> items;
+
+    constexpr explicit widget(Items... i) : items(i...) {}
+
+    lv_obj_t* build(lv_obj_t* parent) const noexcept {
+        lv_obj_t* obj = Create(parent);
+        detail::build_items(obj, items);
+        return obj;
+    }
+};
+
+/// Node for any widget: make<&lv_slider_create>(ui::width{200}, ...)
+template<lv_obj_t* (*Create)(lv_obj_t*), typename... Items>
+[[nodiscard]] constexpr widget<Create, Items...> make(Items... items) {
+    return widget<Create, Items...>(items...);
+}
+
+/// Plain container (lv_obj)
+template<typename... Items>
+struct box : widget<&lv_obj_create, Items...> {
+    constexpr box(Items... i) : widget<&lv_obj_create, Items...>(i...) {}
+};
+
+template<typename... Items>
+box(Items...) -> box<Items...>;
+
+#if LV_USE_BUTTON
+template<typename... Items>
+struct button : widget<&lv_button_create, Items...> {
+    constexpr button(Items... i) : widget<&lv_button_create, Items...>(i...) {}
+};
+
+template<typename... Items>
+button(Items...) -> button<Items...>;
+#endif
+
+#if LV_USE_LABEL
+/// Label with static text (the string must outlive the label)
+template<typename... Items>
+struct label : node_tag {
+    const char* text;
+    std::tuple<Items...> items;
+
+    constexpr label(const char* t, Items... i) : text(t), items(i...) {}
+
+    lv_obj_t* build(lv_obj_t* parent) const noexcept {
+        lv_obj_t* obj = lv_label_create(parent);
+        lv_label_set_text_static(obj, text);
+        detail::build_items(obj, items);
+        return obj;
+    }
+};
+
+template<typename... Items>
+label(const char*, Items...) -> label<Items...>;
+#endif
+
+// ==================== Build ====================
+
+/**
+ * @brief Create `tree` under `parent` in one pass (see the file comment)
+ * @return The root object of the tree
+ */
+template<typename Node>
+    requires is_node_v<Node>
+ObjectView build(ObjectView parent, const Node& tree) noexcept {
+    BuildScope scope(parent);
+    lv_obj_t* root = tree.build(parent.get());
+    scope.set_root(ObjectView(root));
+    return ObjectView(root);
+}
+
+} // namespace lv::ui
@@ -286,7 +286,8 @@ static_assert(sizeof(svg::RenderObj) == sizeof(void*),
 
 // ==================== State Types ====================
 
-#if LV_USE_OBSERVER
+// LV_CPP_STATE_ANY_THREAD adds a pending-list link and a value slot by design
+#if LV_USE_OBSERVER && !LV_CPP_STATE_ANY_THREAD
 static_assert(sizeof(IntState) <= sizeof(lv_subject_t) + sizeof(int32_t) + alignof(lv_subject_t),
     "IntState has excessive overhead");
 
@@ -14,3 +14,10 @@
      (LVGL_VERSION_MAJOR == (major) && LVGL_VERSION_MINOR > (minor)) || \
      (LVGL_VERSION_MAJOR == (major) && LVGL_VERSION_MINOR == (minor) && LVGL_VERSION_PATCH >= (patch)))
 #endif
+
+/// Opt-in headers that read LVGL's private structs were checked against
+/// LVGL 9.4 and stop with #error on other releases. Define as 1 after
+/// checking them against the release in use.
+#ifndef LV_CPP_INTERNALS_OK
+#define LV_CPP_INTERNALS_OK (LVGL_VERSION_MAJOR == 9 && LVGL_VERSION_MINOR == 4)
+#endif
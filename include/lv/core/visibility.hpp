@@ -0,0 +1,363 @@
+#pragma once
+
+/**
+ * @file visibility.hpp
+ * @brief Pause animations, timers, media and throttled observers of objects nobody can see
+ *
+ * A spinner scrolled out of its list, a Lottie on an inactive TileView
+ * tile or a gauge on a screen behind the active one keep animating and
+ * invalidating. Objects opted in with ObjectMixin::pause_when_hidden()
+ * (or visibility::watch()) are checked with lv_obj_is_visible() every
+ * LV_CPP_VISIBILITY_PERIOD ms. That test covers hidden flags up the
+ * parent chain, areas clipped away by scrolling parents, and screens that
+ * are not active. While an object is not visible:
+ *
+ * - the watched object's animation and those of tied objects (Lottie,
+ *   AnimImage, spinners) are paused, and tied GIFs stop;
+ * - animations started through lv::Anim on the watched object or a tied
+ *   object, and animations tied with tie(obj, var, exec_cb), are paused;
+ * - tied timers (tie(obj, timer)) are paused;
+ * - throttled State observers bound to the object or below it
+ *   (bind_text(state, fmt, lv::throttle{...})) hold their latest value
+ *   and deliver it once when it shows again.
+ *
+ * @code
+ * lv::Box card = lv::Box::create(list).pause_when_hidden();
+ * lv::visibility::tie(card, blink_timer);      // lv::Timer::create<&Card::blink>(...)
+ * lv::visibility::tie(card, spinner);          // any object with an animation, or a GIF
+ * lv::visibility::tie(card, &gauge_value, gauge_exec_cb);   // a raw lv_anim_t started elsewhere
+ * @endcode
+ *
+ * Animations are found with lv_anim_get(var, exec_cb) each time, so an
+ * animation that ended or was deleted meanwhile is simply not there; an
+ * object tie covers the first animation of that object (the only one of a
+ * Lottie, AnimImage or spinner). On reappearance only what the watcher
+ * paused is resumed: an animation or timer the application paused itself
+ * stays paused (a GIF, which has no public paused state, is resumed).
+ * lv::Timer tells the watcher when it deletes a tied timer; call untie()
+ * before deleting a tied raw lv_timer_t. Watched objects should not be
+ * nested.
+ *
+ * Public LVGL API only (lv_anim_get/pause/resume, lv_gif_pause/resume).
+ *
+ * Heap allocation: NONE (LV_CPP_VISIBILITY_OBJECTS entries of
+ * LV_CPP_VISIBILITY_TIES ties)
+ */
+
+#include <lvgl.h>
+#include <cstdint>
+#include "anim.hpp"
+#include "object.hpp"
+#include "timer.hpp"
+
+#if LV_USE_OBSERVER
+#include "state.hpp"
+#endif
+
+#ifndef LV_CPP_VISIBILITY_OBJECTS
+/// Objects the visibility watcher can follow
+#define LV_CPP_VISIBILITY_OBJECTS 32
+#endif
+
+#ifndef LV_CPP_VISIBILITY_TIES
+/// Timers, objects and animations tied to one watched object
+#define LV_CPP_VISIBILITY_TIES 12
+#endif
+
+#ifndef LV_CPP_VISIBILITY_PERIOD
+/// Milliseconds between visibility checks
+#define LV_CPP_VISIBILITY_PERIOD 100
+#endif
+
+namespace lv::visibility {
+
+struct Stats {
+    uint32_t checks = 0;      ///< Check passes
+    uint32_t hides = 0;       ///< Watched objects that went out of view
+    uint32_t shows = 0;       ///< ... and came back
+    uint32_t watched = 0;     ///< Objects watched now
+    uint32_t overflow = 0;    ///< Ties refused for lack of LV_CPP_VISIBILITY_TIES room
+};
+
+namespace detail {
+
+enum class Kind : uint8_t { timer, object, anim };
+
+struct Tie {
+    void* ptr = nullptr;      ///< nullptr: free; lv_timer_t, lv_obj_t or an animation's var
+    lv_anim_exec_xcb_t exec_cb = nullptr;   ///< Kind::anim
+    Kind kind = Kind::timer;
+    bool paused = false;      ///< Paused by the watcher
+};
+
+struct Entry {
+    lv_obj_t* obj = nullptr;  ///< nullptr: free slot
+    bool visible = true;
+    bool anim_paused = false; ///< The object's own animation was paused by the watcher
+    Tie ties[LV_CPP_VISIBILITY_TIES];
+};
+
+struct Watcher {
+    Entry entries[LV_CPP_VISIBILITY_OBJECTS];
+    lv_timer_t* timer = nullptr;
+    uint32_t period = LV_CPP_VISIBILITY_PERIOD;
+    Stats stats;
+};
+
+[[nodiscard]] inline Watcher& watcher() noexcept {
+    static Watcher w;
+    return w;
+}
+
+[[nodiscard]] inline Entry* find(const lv_obj_t* obj) noexcept {
+    for (Entry& e : watcher().entries) {
+        if (e.obj == obj) return &e;
+    }
+    return nullptr;
+}
+
+/// Pause the running animation of `var` (any exec_cb if nullptr); true if this paused it
+[[nodiscard]] inline bool pause_anim(void* var, lv_anim_exec_xcb_t exec_cb) noexcept {
+    lv_anim_t* a = lv_anim_get(var, exec_cb);
+    if (!a || lv_anim_is_paused(a)) return false;
+    lv_anim_pause(a);
+    return true;
+}
+
+inline void resume_anim(void* var, lv_anim_exec_xcb_t exec_cb) noexcept {
+    if (lv_anim_t* a = lv_anim_get(var, exec_cb)) lv_anim_resume(a);
+}
+
+inline void pause_tie(Tie& t) noexcept {
+    if (t.paused) return;
+    switch (t.kind) {
+    case Kind::timer: {
+        auto* timer = static_cast<lv_timer_t*>(t.ptr);
+        if (!lv_timer_get_paused(timer)) {
+            lv_timer_pause(timer);
+            t.paused = true;
+        }
+        break;
+    }
+    case Kind::object:
+        t.paused = pause_anim(t.ptr, nullptr);
+#if LV_USE_GIF
+        if (lv_obj_check_type(static_cast<lv_obj_t*>(t.ptr), &lv_gif_class)) {
+            lv_gif_pause(static_cast<lv_obj_t*>(t.ptr));
+            t.paused = true;
+        }
+#endif
+        break;
+    case Kind::anim:
+        t.paused = pause_anim(t.ptr, t.exec_cb);
+        break;
+    }
+}
+
+inline void resume_tie(Tie& t) noexcept {
+    if (!t.paused) return;
+    t.paused = false;
+    switch (t.kind) {
+    case Kind::timer: lv_timer_resume(static_cast<lv_timer_t*>(t.ptr)); break;
+    case Kind::object:
+        resume_anim(t.ptr, nullptr);
+#if LV_USE_GIF
+        if (lv_obj_check_type(static_cast<lv_obj_t*>(t.ptr), &lv_gif_class)) lv_gif_resume(static_cast<lv_obj_t*>(t.ptr));
+#endif
+        break;
+    case Kind::anim: resume_anim(t.ptr, t.exec_cb); break;
+    }
+}
+
+inline void suspend(Entry& e) noexcept {
+    if (!e.anim_paused) e.anim_paused = pause_anim(e.obj, nullptr);
+    for (Tie& t : e.ties) {
+        if (t.ptr) pause_tie(t);
+    }
+#if LV_USE_OBSERVER
+    lv::detail::suspend_throttles(e.obj, true);
+#endif
+}
+
+inline void wake(Entry& e) noexcept {
+    if (e.anim_paused) resume_anim(e.obj, nullptr);
+    e.anim_paused = false;
+    for (Tie& t : e.ties) resume_tie(t);
+#if LV_USE_OBSERVER
+    lv::detail::suspend_throttles(e.obj, false);
+#endif
+}
+
+inline void update(Entry& e) noexcept {
+    const bool visible = lv_obj_is_visible(e.obj);
+    if (visible == e.visible) return;
+    e.visible = visible;
+    if (visible) {
+        ++watcher().stats.shows;
+        wake(e);
+    } else {
+        ++watcher().stats.hides;
+        suspend(e);
+    }
+}
+
+inline void check_cb(lv_timer_t*) noexcept {
+    Watcher& w = watcher();
+    ++w.stats.checks;
+    for (Entry& e : w.entries) {
+        if (e.obj) update(e);
+    }
+}
+
+inline void tied_deleted_cb(lv_event_t* e) noexcept;
+
+/// Free `e`'s slot; `alive`: its object still exists (undo the pauses and event callbacks)
+inline void release(Entry& e, bool alive) noexcept;
+
+inline void watched_deleted_cb(lv_event_t* ev) noexcept {
+    if (Entry* e = find(lv_event_get_current_target_obj(ev))) release(*e, false);
+}
+
+inline void release(Entry& e, bool alive) noexcept {
+    if (alive) {
+        if (!e.visible) wake(e);
+        lv_obj_remove_event_cb_with_user_data(e.obj, &watched_deleted_cb, nullptr);
+    }
+    for (Tie& t : e.ties) {
+        if (t.ptr && t.kind == Kind::object) lv_obj_remove_event_cb_with_user_data(static_cast<lv_obj_t*>(t.ptr), &tied_deleted_cb, &e);
+    }
+    e = Entry{};
+    Watcher& w = watcher();
+    if (--w.stats.watched == 0 && w.timer) {
+        lv_timer_delete(w.timer);
+        w.timer = nullptr;
+    }
+}
+
+inline void tied_deleted_cb(lv_event_t* ev) noexcept {
+    auto* e = static_cast<Entry*>(lv_event_get_user_data(ev));
+    lv_obj_t* obj = lv_event_get_current_target_obj(ev);
+    for (Tie& t : e->ties) {
+        if (t.ptr == obj) t = Tie{};    // the object and the animations on it
+    }
+}
+
+inline void timer_deleted(lv_timer_t* timer) noexcept {
+    for (Entry& e : watcher().entries) {
+        for (Tie& t : e.ties) {
+            if (t.kind == Kind::timer && t.ptr == timer) t = Tie{};
+        }
+    }
+}
+
+[[nodiscard]] inline Entry* acquire(lv_obj_t* obj) noexcept {
+    if (Entry* e = find(obj)) return e;
+    Entry* e = find(nullptr);
+    if (!e) {
+        LV_LOG_WARN("visibility: raise LV_CPP_VISIBILITY_OBJECTS");
+        return nullptr;
+    }
+    Watcher& w = watcher();
+    if (!w.timer) w.timer = lv_timer_create(&check_cb, w.period, nullptr);
+    e->obj = obj;
+    e->visible = true;
+    ++w.stats.watched;
+    lv_obj_add_event_cb(obj, &watched_deleted_cb, LV_EVENT_DELETE, nullptr);
+    update(*e);
+    return e;
+}
+
+[[nodiscard]] inline bool add_tie(Entry& e, void* ptr, Kind kind, lv_anim_exec_xcb_t exec_cb = nullptr) noexcept {
+    Tie* slot = nullptr;
+    for (Tie& t : e.ties) {
+        if (t.ptr == ptr && t.kind == kind && t.exec_cb == exec_cb) return true;
+        if (!t.ptr && !slot) slot = &t;
+    }
+    if (!slot) {
+        ++watcher().stats.overflow;
+        LV_LOG_WARN("visibility: raise LV_CPP_VISIBILITY_TIES");
+        return false;
+    }
+    *slot = Tie{ptr, exec_cb, kind, false};
+    if (kind == Kind::object) lv_obj_add_event_cb(static_cast<lv_obj_t*>(ptr), &tied_deleted_cb, LV_EVENT_DELETE, &e);
+    if (!e.visible) pause_tie(*slot);   // joins a hidden object
+    return true;
+}
+
+[[nodiscard]] inline bool add_tie(lv_obj_t* owner, void* ptr, Kind kind, lv_anim_exec_xcb_t exec_cb = nullptr) noexcept {
+    if (!owner || !ptr) return false;
+    Entry* e = acquire(owner);
+    return e && add_tie(*e, ptr, kind, exec_cb);
+}
+
+/// lv::Anim start hook: follow animations on watched or tied objects
+inline void anim_started(void* var, lv_anim_exec_xcb_t exec_cb) noexcept {
+    for (Entry& e : watcher().entries) {
+        if (!e.obj) continue;
+        bool ours = var == e.obj;
+        for (const Tie& t : e.ties) ours = ours || (t.ptr == var && t.kind == Kind::object);
+        if (ours) (void)add_tie(e, var, Kind::anim, exec_cb);
+    }
+}
+
+} // namespace detail
+
+/// Start (or stop) pausing what belongs to `obj` while it is not visible
+inline bool watch(lv_obj_t* obj, bool on = true) noexcept {
+    if (!obj) return false;
+    if (on) return detail::acquire(obj) != nullptr;
+    if (detail::Entry* e = detail::find(obj)) detail::release(*e, true);
+    return true;
+}
+
+inline bool watch(ObjectView obj, bool on = true) noexcept { return watch(obj.get(), on); }
+
+/// Pause `timer` while `owner` is not visible (watches `owner`)
+inline bool tie(ObjectView owner, lv_timer_t* timer) noexcept {
+    return detail::add_tie(owner.get(), timer, detail::Kind::timer);
+}
+inline bool tie(ObjectView owner, Timer& timer) noexcept { return tie(owner, timer.get()); }
+
+/// Pause `media`'s animation (and a GIF's playback) while `owner` is not visible
+inline bool tie(ObjectView owner, ObjectView media) noexcept {
+    return detail::add_tie(owner.get(), media.get(), detail::Kind::object);
+}
+
+/// Pause the animation of `var` with `exec_cb` (any, if nullptr) while `owner` is not visible
+inline bool tie(ObjectView owner, void* var, lv_anim_exec_xcb_t exec_cb) noexcept {
+    return detail::add_tie(owner.get(), var, detail::Kind::anim, exec_cb);
+}
+
+/// Forget a tied timer before deleting it with lv_timer_delete()
+inline void untie(lv_timer_t* timer) noexcept { detail::timer_deleted(timer); }
+
+/// Whether `obj` was visible at the last check (true for unwatched objects)
+[[nodiscard]] inline bool visible(ObjectView obj) noexcept {
+    const detail::Entry* e = detail::find(obj.get());
+    return !e || e->visible;
+}
+
+/// Check every watched object now (e.g. right after loading a screen)
+inline void check() noexcept { detail::check_cb(nullptr); }
+
+/// Milliseconds between checks
+inline void period(uint32_t ms) noexcept {
+    detail::Watcher& w = detail::watcher();
+    w.period = ms ? ms : 1;
+    if (w.timer) lv_timer_set_period(w.timer, w.period);
+}
+
+[[nodiscard]] inline Stats stats() noexcept { return detail::watcher().stats; }
+
+inline void reset_stats() noexcept {
+    Stats& st = detail::watcher().stats;
+    st = Stats{.watched = st.watched};
+}
+
+namespace detail {
+inline const bool hooks_installed = (lv::detail::visibility_watch_hook() = &visibility::watch,
+                                      lv::detail::timer_deleted_hook() = &timer_deleted,
+                                      lv::detail::anim_started_hook() = &anim_started, true);
+} // namespace detail
+
+} // namespace lv::visibility
@@ -0,0 +1,68 @@
+#pragma once
+
+/**
+ * @file widget_profile.hpp
+ * @brief Which wrapper-only widget headers lv.hpp includes
+ *
+ * lv.hpp includes every widget wrapper LVGL has switched on, plus the
+ * wrapper-only widgets built on them (VirtualList, DataTable, LogView,
+ * ...). A product that uses three widgets still compiles LVGL's other
+ * twenty-seven, pulls their classes in through the default theme and
+ * parses their wrappers in every translation unit. lv_profile() in
+ * cmake/LvProfile.cmake names the widgets once for the whole build:
+ *
+ * @code
+ * # CMakeLists.txt
+ * lv_profile(NAME thermostat
+ *            WIDGETS label button arc slider
+ *            FEATURES flex observer
+ *            EXTRAS virtual_list)
+ * @endcode
+ *
+ * It generates a header, passed as LV_CPP_PROFILE_HEADER, that sets the
+ * LV_USE_<WIDGET> switches lv_conf.h reads and the LV_CPP_PROFILE_<EXTRA>
+ * switches below. Without a profile every extra stays on. Headers that
+ * read LVGL internals (LedBank, PolylineCache, ChartCurves, VideoView,
+ * the key atlas) are never included by lv.hpp and are not extras.
+ *
+ * Heap allocation: NONE (compile-time only)
+ */
+
+#include <lvgl.h>
+
+#if defined(LV_CPP_PROFILE_HEADER) && !defined(LV_CPP_PROFILE)
+#error "LV_CPP_PROFILE_HEADER is set but lv_conf.h does not include it (see cmake/LvProfile.cmake)"
+#endif
+
+#ifndef LV_CPP_PROFILE
+/// 1 when lv_conf.h took its widget switches from an lv_profile() header
+#define LV_CPP_PROFILE 0
+#endif
+
+#ifndef LV_CPP_PROFILE_TEXT_EDITOR
+#define LV_CPP_PROFILE_TEXT_EDITOR 1
+#endif
+#ifndef LV_CPP_PROFILE_LOG_VIEW
+#define LV_CPP_PROFILE_LOG_VIEW 1
+#endif
+#ifndef LV_CPP_PROFILE_NOTIFICATIONS
+#define LV_CPP_PROFILE_NOTIFICATIONS 1
+#endif
+#ifndef LV_CPP_PROFILE_CHART_DECIMATOR
+#define LV_CPP_PROFILE_CHART_DECIMATOR 1
+#endif
+#ifndef LV_CPP_PROFILE_STRIP_CHART
+#define LV_CPP_PROFILE_STRIP_CHART 1
+#endif
+#ifndef LV_CPP_PROFILE_VIRTUAL_LIST
+#define LV_CPP_PROFILE_VIRTUAL_LIST 1
+#endif
+#ifndef LV_CPP_PROFILE_FILE_BROWSER
+#define LV_CPP_PROFILE_FILE_BROWSER 1
+#endif
+#ifndef LV_CPP_PROFILE_DATA_TABLE
+#define LV_CPP_PROFILE_DATA_TABLE 1
+#endif
+#ifndef LV_CPP_PROFILE_VIRTUAL_OPTIONS
+#define LV_CPP_PROFILE_VIRTUAL_OPTIONS 1
+#endif
@@ -0,0 +1,393 @@
+#pragma once
+
+/**
+ * @file arc_cache.hpp
+ * @brief Cached anti-aliased arc masks, drawn as A8 blits; prerendered spinner frames
+ *
+ * The SW renderer rasterizes an arc through radius and angle masks on
+ * every draw, row by row, so a spinner costs the same mask work each
+ * frame and a loading screen with several of them keeps a core busy.
+ * This cache keeps arcs as A8 coverage masks, cropped to the arc, per
+ * (radius, width, rounded ends, start, span):
+ *
+ * - the same arc again is a plain recolored A8 blit,
+ * - the same span at another start angle is the mask drawn rotated,
+ * - anything else renders a new mask (once) and blits it.
+ *
+ * @code
+ * lv::arc_cache::bake_arcs(gauge);               // Arc: its arc draws via the cache
+ *
+ * auto spinner = lv::Spinner::create(screen, 1000, 60);
+ * lv::arc_cache::spinner(spinner, 24);           // 24 fixed frames per turn
+ * @endcode
+ *
+ * A spinner's animation moves both ends along different paths, so its
+ * arcs rarely repeat. spinner() swaps that animation for one stepping
+ * through a fixed set of frames on the same paths; after the first turn
+ * every frame is a blit.
+ *
+ * Masks handed to draw tasks stay pinned until the display's next
+ * REFR_READY; when every entry is pinned or the budget cannot hold a new
+ * mask, the draw falls back to LVGL. Arcs with an image source are left
+ * to LVGL.
+ *
+ * Heap allocation: NONE in the wrapper (fixed table; masks come from the
+ * DrawBufPool)
+ */
+
+#include <lvgl.h>
+#include <cmath>
+#include <cstdint>
+#include "draw_buf.hpp"
+#include "../core/object.hpp"
+
+#ifndef LV_CPP_ARC_CACHE
+/// Cached arc masks
+#define LV_CPP_ARC_CACHE 48
+#endif
+
+#ifndef LV_CPP_ARC_CACHE_BYTES
+/// Default mask bytes kept before the least recently used entries go (see budget())
+#define LV_CPP_ARC_CACHE_BYTES (128u * 1024u)
+#endif
+
+namespace lv::arc_cache {
+
+/// Counters of the arc mask cache
+struct Stats {
+    uint32_t entries;
+    uint32_t bytes;       ///< mask bytes
+    uint32_t hits;        ///< arcs blitted from their own mask
+    uint32_t rotated;     ///< arcs drawn from a mask of the same span, rotated
+    uint32_t misses;      ///< masks rendered
+    uint32_t fallbacks;   ///< arcs left to LVGL (image source, no free entry or over budget)
+};
+
+namespace detail {
+
+struct Entry {
+    int32_t radius = 0;
+    int32_t width = 0;
+    int32_t start = 0;                ///< 0..359
+    int32_t span = 0;                 ///< 1..360
+    bool rounded = false;
+    lv_draw_buf_t* buf = nullptr;     ///< A8 coverage, cropped to the arc
+    lv_point_t ofs{};                 ///< mask top-left relative to the arc's center
+    uint32_t used = 0;                ///< LRU stamp
+    bool pinned = false;              ///< read by a queued draw task
+};
+
+struct Tables {
+    Entry entries[LV_CPP_ARC_CACHE];
+    uint32_t budget = LV_CPP_ARC_CACHE_BYTES;
+    uint32_t clock = 0;
+    uint32_t pinned = 0;
+    Stats stats{};
+};
+
+[[nodiscard]] inline Tables& tables() noexcept {
+    static Tables t;
+    return t;
+}
+
+inline void free_entry(Tables& t, Entry& e) noexcept {
+    if (e.buf) {
+        t.stats.bytes -= e.buf->data_size;
+        --t.stats.entries;
+        lv_image_cache_drop(e.buf);
+        lv_draw_buf_destroy(e.buf);
+    }
+    e = Entry{};
+}
+
+/// A free entry, else the oldest unpinned one (or nullptr); `occupied_only` skips free entries
+[[nodiscard]] inline Entry* victim(Tables& t, bool occupied_only = false) noexcept {
+    Entry* v = nullptr;
+    for (Entry& e : t.entries) {
+        if (!e.buf) {
+            if (!occupied_only) return &e;
+            continue;
+        }
+        if (!e.pinned && (!v || e.used < v->used)) v = &e;
+    }
+    return v;
+}
+
+[[nodiscard]] constexpr float clamp01(float v) noexcept { return v < 0.0f ? 0.0f : v > 1.0f ? 1.0f : v; }
+
+/**
+ * Coverage (0..1) of the pixel centred at (px, py), relative to the arc's
+ * center, by the arc of outer radius `r` and width `w` from `start` over
+ * `span` degrees clockwise (LVGL's angles: 0 is 3 o'clock).
+ */
+[[nodiscard]] inline float coverage(float px, float py, float r, float w, float sx, float sy, float ex, float ey,
+                                    int32_t span, bool rounded) noexcept {
+    const float d = std::sqrt(px * px + py * py);
+    const float ring = w >= r ? clamp01(r - d + 0.5f) : std::fmin(clamp01(r - d + 0.5f), clamp01(d - (r - w) + 0.5f));
+    if (span >= 360) return ring;
+    // Signed distances to the start ray (inside: clockwise of it) and the end ray (inside: before it)
+    const float ds = clamp01(sx * py - sy * px + 0.5f);
+    const float de = clamp01(px * ey - py * ex + 0.5f);
+    float c = std::fmin(ring, span <= 180 ? std::fmin(ds, de) : std::fmax(ds, de));
+    if (rounded) {
+        const float rm = r - w / 2.0f;
+        const float half = w / 2.0f;
+        const float d0 = std::sqrt((px - rm * sx) * (px - rm * sx) + (py - rm * sy) * (py - rm * sy));
+        const float d1 = std::sqrt((px - rm * ex) * (px - rm * ex) + (py - rm * ey) * (py - rm * ey));
+        c = std::fmax(c, std::fmax(clamp01(half - d0 + 0.5f), clamp01(half - d1 + 0.5f)));
+    }
+    return c;
+}
+
+/// Render `e`'s mask into a new pooled A8 buffer cropped to its coverage; false if it does not fit
+[[nodiscard]] inline bool render(Tables& t, Entry& e) noexcept {
+    constexpr float rad = 3.14159265f / 180.0f;
+    const auto r = static_cast<float>(e.radius);
+    const auto w = static_cast<float>(e.width);
+    const float sx = std::cos(e.start * rad), sy = std::sin(e.start * rad);
+    const float ex = std::cos((e.start + e.span) * rad), ey = std::sin((e.start + e.span) * rad);
+    const int32_t size = 2 * e.radius;
+    auto cov = [&](int32_t x, int32_t y) noexcept {
+        return coverage(x + 0.5f - r, y + 0.5f - r, r, w, sx, sy, ex, ey, e.span, e.rounded);
+    };
+    // Crop: the rows and columns with any coverage
+    int32_t x1 = size, y1 = size, x2 = -1, y2 = -1;
+    for (int32_t y = 0; y < size; ++y) {
+        for (int32_t x = 0; x < size; ++x) {
+            if (cov(x, y) * 255.0f < 1.0f) continue;
+            if (x < x1) x1 = x;
+            if (x > x2) x2 = x;
+            if (y < y1) y1 = y;
+            y2 = y;
+        }
+    }
+    if (x2 < 0) return false;
+    const auto bw = static_cast<uint32_t>(x2 - x1 + 1);
+    const auto bh = static_cast<uint32_t>(y2 - y1 + 1);
+    const uint32_t need = lv_draw_buf_width_to_stride(bw, LV_COLOR_FORMAT_A8) * bh;
+    if (need > t.budget) return false;
+    while (t.stats.bytes + need > t.budget) {
+        Entry* old = victim(t, true);
+        if (!old) return false;
+        free_entry(t, *old);
+    }
+    lv_draw_buf_t* buf = lv_draw_buf_create_ex(draw::pool_handlers(), bw, bh, LV_COLOR_FORMAT_A8, 0);
+    if (!buf) return false;
+    for (int32_t y = y1; y <= y2; ++y) {
+        uint8_t* row = buf->data + (y - y1) * buf->header.stride;
+        for (int32_t x = x1; x <= x2; ++x) row[x - x1] = static_cast<uint8_t>(cov(x, y) * 255.0f + 0.5f);
+    }
+    e.buf = buf;
+    e.ofs = lv_point_t{x1 - e.radius, y1 - e.radius};
+    t.stats.bytes += buf->data_size;
+    ++t.stats.entries;
+    return true;
+}
+
+inline void refr_ready_cb(lv_event_t*) noexcept {
+    Tables& t = tables();
+    for (Entry& e : t.entries) e.pinned = false;
+    t.pinned = 0;
+}
+
+/// Keep `e` until the next refresh is done (queued draw tasks point at its mask)
+inline void pin(Entry& e) noexcept {
+    Tables& t = tables();
+    if (e.pinned) return;
+    e.pinned = true;
+    if (t.pinned++) return;
+    lv_display_t* disp = lv_display_get_default();
+    if (!disp) return;
+    lv_display_remove_event_cb_with_user_data(disp, &refr_ready_cb, nullptr);
+    lv_display_add_event_cb(disp, &refr_ready_cb, LV_EVENT_REFR_READY, nullptr);
+}
+
+/// draw() without the fallback: false if the arc cannot come from the cache
+[[nodiscard]] inline bool draw_cached(lv_layer_t* layer, const lv_draw_arc_dsc_t& dsc) noexcept {
+    if (dsc.img_src || dsc.width <= 0 || dsc.radius == 0) return false;
+    Tables& t = tables();
+    const auto a0 = static_cast<int32_t>(dsc.start_angle);
+    const auto a1 = static_cast<int32_t>(dsc.end_angle);
+    int32_t span = a1 - a0;
+    if (span >= 360 || span <= -360) span = 360;
+    else span = span <= 0 ? span + 360 : span;
+    const int32_t start = span == 360 ? 0 : ((a0 % 360) + 360) % 360;
+    const auto radius = static_cast<int32_t>(dsc.radius);
+    const int32_t width = dsc.width > radius ? radius : dsc.width;
+    const bool rounded = dsc.rounded && span < 360;
+
+    Entry* exact = nullptr;
+    Entry* turned = nullptr;
+    for (Entry& e : t.entries) {
+        if (!e.buf || e.radius != radius || e.width != width || e.span != span || e.rounded != rounded) continue;
+        if (e.start == start) {
+            exact = &e;
+            break;
+        }
+        if (!turned || e.used > turned->used) turned = &e;
+    }
+    Entry* e = exact ? exact : turned;
+    if (e) {
+        ++(exact ? t.stats.hits : t.stats.rotated);
+    } else {
+        e = victim(t);
+        if (!e) return false;
+        free_entry(t, *e);
+        e->radius = radius;
+        e->width = width;
+        e->start = start;
+        e->span = span;
+        e->rounded = rounded;
+        if (!render(t, *e)) {
+            *e = Entry{};
+            return false;
+        }
+        ++t.stats.misses;
+        exact = e;
+    }
+    e->used = ++t.clock;
+    pin(*e);
+
+    lv_draw_image_dsc_t img;
+    lv_draw_image_dsc_init(&img);
+    img.src = e->buf;
+    img.opa = dsc.opa;
+    img.recolor = dsc.color;             // A8 images are drawn in the recolor color
+    img.recolor_opa = LV_OPA_COVER;
+    img.base = dsc.base;
+    const lv_area_t coords{dsc.center.x + e->ofs.x, dsc.center.y + e->ofs.y,
+                           dsc.center.x + e->ofs.x + static_cast<int32_t>(e->buf->header.w) - 1,
+                           dsc.center.y + e->ofs.y + static_cast<int32_t>(e->buf->header.h) - 1};
+    if (e != exact) {
+        img.rotation = (start - e->start) * 10;
+        img.pivot = lv_point_t{-e->ofs.x, -e->ofs.y};
+    }
+    lv_draw_image(layer, &img, &coords);
+    return true;
+}
+
+inline void draw_task_cb(lv_event_t* ev) noexcept {
+    lv_draw_task_t* task = lv_event_get_draw_task(ev);
+    if (lv_draw_task_get_type(task) != LV_DRAW_TASK_TYPE_ARC) return;
+    auto* dsc = static_cast<lv_draw_arc_dsc_t*>(lv_draw_task_get_draw_dsc(task));
+    if (dsc->opa <= LV_OPA_MIN) return;
+    if (draw_cached(dsc->base.layer, *dsc)) {
+        dsc->opa = LV_OPA_TRANSP;   // LVGL's own arc task now draws nothing
+    } else {
+        ++tables().stats.fallbacks;
+    }
+}
+
+/// Spinner frame `value` of `a`: the ends where lv_spinner's two animations put them
+inline void spinner_frame_cb(lv_anim_t* a, int32_t value) noexcept {
+    auto* obj = static_cast<lv_obj_t*>(a->var);
+    const int32_t frames = a->end_value;
+    const auto arc_length = static_cast<int32_t>(reinterpret_cast<intptr_t>(lv_anim_get_user_data(a)));
+    const int32_t k = value % frames;
+    // lv_spinner: the end runs linearly from arc_length over a turn, the start eases in and out over one
+    lv_anim_t path;
+    lv_anim_init(&path);
+    path.duration = static_cast<int32_t>(frames);
+    path.act_time = k;
+    path.start_value = 0;
+    path.end_value = 360;
+    const int32_t start = lv_anim_path_ease_in_out(&path);
+    const int32_t end = arc_length + 360 * k / frames;
+    lv_arc_set_angles(obj, static_cast<lv_value_precise_t>(start), static_cast<lv_value_precise_t>(end));
+}
+
+} // namespace detail
+
+/**
+ * @brief Draw an arc from a cached mask
+ *
+ * Same geometry as lv_draw_arc(). An arc of a cached span at another
+ * start angle is drawn by rotating that span's mask.
+ *
+ * @return true if drawn from the cache, false if handed to lv_draw_arc()
+ */
+inline bool draw(lv_layer_t* layer, const lv_draw_arc_dsc_t& dsc) noexcept {
+    if (dsc.opa <= LV_OPA_MIN) return true;
+    if (detail::draw_cached(layer, dsc)) return true;
+    ++detail::tables().stats.fallbacks;
+    lv_draw_arc(layer, &dsc);
+    return false;
+}
+
+/**
+ * @brief Draw `obj`'s arcs (any part) from the cache on every redraw
+ *
+ * Replaces each arc draw task as LVGL adds it (through
+ * LV_EVENT_DRAW_TASK_ADDED); works for Arc, Spinner and custom drawing
+ * alike.
+ */
+inline void bake_arcs(ObjectView obj) noexcept {
+    lv_obj_remove_event_cb(obj.get(), &detail::draw_task_cb);
+    lv_obj_add_event_cb(obj.get(), &detail::draw_task_cb, LV_EVENT_DRAW_TASK_ADDED, nullptr);
+    lv_obj_add_flag(obj.get(), LV_OBJ_FLAG_SEND_DRAW_TASK_EVENTS);
+    lv_obj_invalidate(obj.get());
+}
+
+/// Let LVGL draw `obj`'s arcs again
+inline void unbake_arcs(ObjectView obj) noexcept {
+    if (!lv_obj_remove_event_cb(obj.get(), &detail::draw_task_cb)) return;
+    lv_obj_remove_flag(obj.get(), LV_OBJ_FLAG_SEND_DRAW_TASK_EVENTS);
+    lv_obj_invalidate(obj.get());
+}
+
+/**
+ * @brief Run `spinner` through `frames` fixed frames per turn, drawn from the cache
+ *
+ * Replaces the spinner's animation (pass the same `time_ms` and
+ * `arc_length` as to Spinner::create()/anim_params()) with one that
+ * steps through `frames` positions on the same paths, and bakes its
+ * arcs. The budget must hold the frames' masks: at 60 px and 24 frames
+ * that is around 60 KB.
+ */
+inline void spinner(ObjectView spinner, uint32_t frames = 24, uint32_t time_ms = 1000,
+                    uint32_t arc_length = 60) noexcept {
+    lv_obj_t* o = spinner.get();
+    if (!o || frames == 0) return;
+    lv_anim_delete(o, nullptr);
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, o);
+    lv_anim_set_custom_exec_cb(&a, &detail::spinner_frame_cb);
+    lv_anim_set_values(&a, 0, static_cast<int32_t>(frames));
+    lv_anim_set_duration(&a, time_ms);
+    lv_anim_set_repeat_count(&a, LV_ANIM_REPEAT_INFINITE);
+    lv_anim_set_user_data(&a, reinterpret_cast<void*>(static_cast<intptr_t>(arc_length)));
+    lv_anim_start(&a);
+    bake_arcs(spinner);
+}
+
+/// Set the mask byte budget; entries over it are evicted (pinned ones at their next use)
+inline void budget(uint32_t bytes) noexcept {
+    detail::Tables& t = detail::tables();
+    t.budget = bytes;
+    while (t.stats.bytes > t.budget) {
+        detail::Entry* old = detail::victim(t, true);
+        if (!old) break;
+        detail::free_entry(t, *old);
+    }
+}
+
+[[nodiscard]] inline uint32_t budget() noexcept { return detail::tables().budget; }
+
+[[nodiscard]] inline Stats stats() noexcept { return detail::tables().stats; }
+
+/// Zero the hit/miss/draw counters (sizes are kept)
+inline void reset_stats() noexcept {
+    Stats& s = detail::tables().stats;
+    s.hits = s.rotated = s.misses = s.fallbacks = 0;
+}
+
+/// Free every unpinned entry
+inline void drop() noexcept {
+    detail::Tables& t = detail::tables();
+    for (detail::Entry& e : t.entries) {
+        if (!e.pinned) detail::free_entry(t, e);
+    }
+}
+
+} // namespace lv::arc_cache
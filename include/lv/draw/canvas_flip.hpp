@@ -0,0 +1,300 @@
+#pragma once
+
+/**
+ * @file canvas_flip.hpp
+ * @brief Double-buffered Canvas: draw into a back buffer, flip at the next refresh
+ *
+ * A Canvas has one buffer. Drawing into it while the display reads it for
+ * a refresh (threaded draw units, draws spread over several calls) shows
+ * half-drawn content, so incremental updates either redraw everything or
+ * tear. canvas.double_buffer() gives the canvas two pooled buffers. Draws
+ * go into the back buffer and the changed areas are remembered; at the
+ * next LV_EVENT_REFR_START the buffers are flipped and only the union of
+ * the changed areas is invalidated:
+ *
+ * @code
+ * #include <lv/draw/canvas_flip.hpp>
+ *
+ * canvas.double_buffer();
+ * {
+ *     auto s = canvas.begin(lv::area(x, 0, x + 3, 99));   // sessions draw into the back buffer
+ *     s.rect(bg, lv::area(x, 0, x + 3, 99)).line(trace);
+ * }
+ * // or with a raw layer
+ * lv_layer_t layer;
+ * lv::canvas_flip::init_layer(canvas, layer);
+ * lv::draw::line(layer, dsc);
+ * lv::canvas_flip::finish_layer(canvas, layer, changed);
+ * @endcode
+ *
+ * The flip swaps the pixel memory of the two buffers, so the canvas keeps
+ * the same lv_draw_buf_t and LVGL's image source never changes. The areas
+ * drawn since the last flip are then copied from the new front to the new
+ * back buffer, so both hold the same picture and the next draws only have
+ * to touch what changes. Up to LV_CPP_CANVAS_FLIP_AREAS areas are kept;
+ * beyond that they are merged into their bounding box.
+ *
+ * Canvas::set_px(), fill_bg() and init_layer() still write the front
+ * buffer; use sessions or canvas_flip::init_layer() on a double-buffered
+ * canvas. double_buffer(false) copies the picture back into the canvas's
+ * own buffer and frees the pair, as does deleting the canvas.
+ *
+ * Not included by lv.hpp or draw.hpp: the layer over the back buffer is
+ * built by hand from lv_draw_private.h, as lv_canvas_init_layer() builds
+ * it over the front one. Checked against LVGL 9.4 (see
+ * LV_CPP_INTERNALS_OK). Canvas sessions reach it through
+ * detail::canvas_flip_hooks(), set by the first double_buffer().
+ *
+ * Heap allocation: two DrawBufPool buffers per double-buffered canvas;
+ * NONE per draw or flip
+ */
+
+#include <lvgl.h>
+#include "../core/version.hpp"
+
+#if LV_USE_CANVAS
+
+#if !LV_CPP_INTERNALS_OK
+#error "canvas_flip.hpp reads LVGL internals checked against LVGL 9.4; see LV_CPP_INTERNALS_OK"
+#endif
+
+#include <src/draw/lv_draw_private.h>             // lv_layer_t fields
+#include <cstdint>
+#include <utility>
+#include "draw_buf.hpp"
+#include "../widgets/canvas.hpp"
+
+#ifndef LV_CPP_CANVAS_FLIPS
+/// Double-buffered canvases at once
+#define LV_CPP_CANVAS_FLIPS 4
+#endif
+
+#ifndef LV_CPP_CANVAS_FLIP_AREAS
+/// Changed areas remembered per canvas between flips
+#define LV_CPP_CANVAS_FLIP_AREAS 8
+#endif
+
+namespace lv {
+
+namespace canvas_flip {
+
+struct Stats {
+    uint32_t flips = 0;        ///< Buffer swaps
+    uint32_t areas = 0;        ///< Changed areas invalidated and copied forward
+    uint32_t merged = 0;       ///< Times the area list was full and merged into one box
+    uint32_t copied_px = 0;    ///< Pixels copied to keep the back buffer in sync
+};
+
+namespace detail {
+
+struct Flip {
+    lv_obj_t* canvas = nullptr;        ///< nullptr: free slot
+    lv_draw_buf_t* front = nullptr;    ///< Set on the canvas; its pixels swap with back's
+    lv_draw_buf_t* back = nullptr;
+    lv_draw_buf_t* original = nullptr; ///< The canvas's buffer before double_buffer()
+    lv_display_t* disp = nullptr;
+    lv_area_t dirty[LV_CPP_CANVAS_FLIP_AREAS];
+    uint8_t count = 0;
+};
+
+struct Tables {
+    Flip flips[LV_CPP_CANVAS_FLIPS];
+    Stats stats;
+};
+
+[[nodiscard]] inline Tables& tables() noexcept {
+    static Tables t;
+    return t;
+}
+
+[[nodiscard]] inline Flip* find(const lv_obj_t* canvas) noexcept {
+    if (!canvas) return nullptr;
+    for (Flip& f : tables().flips) {
+        if (f.canvas == canvas) return &f;
+    }
+    return nullptr;
+}
+
+using lv::detail::canvas_invalidate;
+
+/// Swap the pixels, invalidate the changed areas and copy them to the new back buffer
+inline void flip(Flip& f) noexcept {
+    Stats& st = tables().stats;
+    std::swap(f.front->data, f.back->data);
+    std::swap(f.front->unaligned_data, f.back->unaligned_data);
+    lv_image_cache_drop(f.front);      // cached decodes point at the old pixels
+    for (uint8_t i = 0; i < f.count; ++i) {
+        lv_area_t& a = f.dirty[i];
+        lv_draw_buf_copy(f.back, &a, f.front, &a);
+        canvas_invalidate(f.canvas, f.front, a);
+        st.copied_px += static_cast<uint32_t>(lv_area_get_size(&a));
+    }
+    st.areas += f.count;
+    f.count = 0;
+    ++st.flips;
+}
+
+inline void refr_start_cb(lv_event_t* e) noexcept {
+    lv_display_t* disp = lv_event_get_current_target_display(e);
+    for (Flip& f : tables().flips) {
+        if (f.canvas && f.disp == disp && f.count) flip(f);
+    }
+}
+
+/// Pooled buffers back to the pool, the slot freed; the display hook goes with the last slot
+inline void release(Flip& f) noexcept {
+    lv_display_t* disp = f.disp;
+    lv_image_cache_drop(f.front);
+    lv_draw_buf_destroy(f.front);
+    lv_draw_buf_destroy(f.back);
+    f = Flip{};
+    if (!disp) return;
+    for (const Flip& o : tables().flips) {
+        if (o.canvas && o.disp == disp) return;
+    }
+    lv_display_remove_event_cb_with_user_data(disp, &refr_start_cb, nullptr);
+}
+
+inline void canvas_delete_cb(lv_event_t* e) noexcept {
+    if (Flip* f = find(static_cast<lv_obj_t*>(lv_event_get_current_target(e)))) release(*f);
+}
+
+} // namespace detail
+
+/// The buffer draws go to: the back buffer of a double-buffered canvas, else nullptr
+[[nodiscard]] inline lv_draw_buf_t* back(ObjectView canvas) noexcept {
+    const detail::Flip* f = detail::find(canvas.get());
+    return f ? f->back : nullptr;
+}
+
+/**
+ * @brief Remember `area` (canvas buffer coordinates) as changed in the back buffer
+ *
+ * Schedules a refresh; the flip happens at its start.
+ */
+inline void mark(ObjectView canvas, const lv_area_t& area) noexcept {
+    detail::Flip* f = detail::find(canvas.get());
+    if (!f) return;
+    const lv_area_t full{0, 0, static_cast<int32_t>(f->back->header.w) - 1,
+                         static_cast<int32_t>(f->back->header.h) - 1};
+    lv_area_t a;
+    if (!lv_area_intersect(&a, &area, &full)) return;
+    for (uint8_t i = 0; i < f->count; ++i) {
+        lv_area_t& d = f->dirty[i];
+        if (lv_area_is_in(&a, &d, 0)) return;
+        if (lv_area_is_on(&a, &d)) {
+            lv_area_join(&d, &d, &a);
+            return;
+        }
+    }
+    if (f->count == LV_CPP_CANVAS_FLIP_AREAS) {
+        for (uint8_t i = 1; i < f->count; ++i) lv_area_join(&f->dirty[0], &f->dirty[0], &f->dirty[i]);
+        f->count = 1;
+        ++detail::tables().stats.merged;
+        lv_area_join(&f->dirty[0], &f->dirty[0], &a);
+    } else {
+        f->dirty[f->count++] = a;
+    }
+    // Any on-screen area starts the refresh; the flip invalidates the rest
+    detail::canvas_invalidate(f->canvas, f->front, a);
+}
+
+/// Layer over the back buffer (the front buffer if the canvas is not double-buffered)
+inline void init_layer(ObjectView canvas, lv_layer_t& layer) noexcept {
+    lv_draw_buf_t* buf = back(canvas);
+    if (!buf) {
+        lv_canvas_init_layer(canvas.get(), &layer);
+        return;
+    }
+    const lv_area_t full{0, 0, static_cast<int32_t>(buf->header.w) - 1, static_cast<int32_t>(buf->header.h) - 1};
+    lv_layer_init(&layer);
+    layer.draw_buf = buf;
+    layer.color_format = static_cast<lv_color_format_t>(buf->header.cf);
+    layer.buf_area = full;
+    layer._clip_area = full;
+    layer.phy_clip_area = full;
+}
+
+/// Draw the layer's tasks and mark `changed` (canvas buffer coordinates) for the next flip
+inline void finish_layer(ObjectView canvas, lv_layer_t& layer, const lv_area_t& changed) noexcept {
+    if (!back(canvas)) {
+        lv_canvas_finish_layer(canvas.get(), &layer);
+        return;
+    }
+    while (layer.draw_task_head) {
+        lv_draw_dispatch_wait_for_request();
+        if (!lv_draw_dispatch_layer(lv_obj_get_display(canvas.get()), &layer)) {
+            lv_draw_wait_for_finish();
+            lv_draw_dispatch_request();
+        }
+    }
+    mark(canvas, changed);
+}
+
+namespace detail {
+
+/// CanvasFlipHooks::init_layer
+inline bool hook_init_layer(lv_obj_t* canvas, lv_layer_t& layer) noexcept {
+    if (!back(ObjectView(canvas))) return false;
+    init_layer(ObjectView(canvas), layer);
+    return true;
+}
+
+/// CanvasFlipHooks::mark
+inline void hook_mark(lv_obj_t* canvas, const lv_area_t& area) noexcept {
+    mark(ObjectView(canvas), area);
+}
+
+} // namespace detail
+
+[[nodiscard]] inline Stats stats() noexcept { return detail::tables().stats; }
+
+inline void reset_stats() noexcept { detail::tables().stats = Stats{}; }
+
+} // namespace canvas_flip
+
+inline bool Canvas::double_buffer(bool on) noexcept {
+    using namespace canvas_flip::detail;
+    Flip* f = find(m_obj);
+    if (!on) {
+        if (!f) return true;
+        if (f->count) flip(*f);       // the pending draws belong to the picture
+        lv_draw_buf_t* original = f->original;
+        lv_draw_buf_copy(original, nullptr, f->front, nullptr);
+        lv_obj_remove_event_cb_with_user_data(m_obj, &canvas_delete_cb, nullptr);
+        lv_canvas_set_draw_buf(m_obj, original);
+        release(*f);
+        return true;
+    }
+    if (f) return true;
+    lv::detail::canvas_flip_hooks() = lv::detail::CanvasFlipHooks{&hook_init_layer, &hook_mark};
+    lv_draw_buf_t* original = lv_canvas_get_draw_buf(m_obj);
+    if (!original) return false;
+    for (Flip& slot : tables().flips) {
+        if (slot.canvas) continue;
+        lv_draw_buf_t* front = lv_draw_buf_dup_ex(draw::pool_handlers(), original);
+        lv_draw_buf_t* back = front ? lv_draw_buf_dup_ex(draw::pool_handlers(), original) : nullptr;
+        if (!back) {
+            if (front) lv_draw_buf_destroy(front);
+            return false;
+        }
+        lv_display_t* disp = lv_obj_get_display(m_obj);
+        bool hooked = false;
+        for (const Flip& o : tables().flips) hooked = hooked || (o.canvas && o.disp == disp);
+        if (disp && !hooked) lv_display_add_event_cb(disp, &refr_start_cb, LV_EVENT_REFR_START, nullptr);
+        slot = Flip{m_obj, front, back, original, disp, {}, 0};
+        lv_obj_add_event_cb(m_obj, &canvas_delete_cb, LV_EVENT_DELETE, nullptr);
+        lv_canvas_set_draw_buf(m_obj, front);
+        return true;
+    }
+    LV_LOG_WARN("double-buffered canvases exhausted, raise LV_CPP_CANVAS_FLIPS");
+    return false;
+}
+
+inline bool Canvas::double_buffered() const noexcept {
+    return canvas_flip::detail::find(m_obj) != nullptr;
+}
+
+} // namespace lv
+
+#endif // LV_USE_CANVAS
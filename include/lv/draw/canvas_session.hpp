@@ -0,0 +1,401 @@
+#pragma once
+
+/**
+ * @file canvas_session.hpp
+ * @brief Batched Canvas drawing: record many primitives, submit them in one layer
+ *
+ * Drawing into a Canvas through init_layer() / finish_layer() pays a full
+ * dispatch loop and an invalidation of the whole canvas per cycle. A
+ * session records rect, line and label descriptors into a per-canvas
+ * arena and submits them in one layer with a single finish and a single
+ * invalidation of the union of what was drawn:
+ *
+ * @code
+ * {
+ *     auto s = canvas.begin();
+ *     s.rect(bg, lv::area(0, 0, 199, 99))
+ *      .line(grid)
+ *      .label(caption, lv::area(4, 4, 120, 20));
+ * }   // submitted here (or by s.submit())
+ *
+ * // Strip chart: only the newest column is redrawn, and only primitives
+ * // touching it become draw tasks
+ * auto s = canvas.begin(lv::area(x, 0, x + 3, 99));
+ * @endcode
+ *
+ * With a redraw region the layer is clipped to it, recorded primitives
+ * that do not touch it are dropped before any draw task is made, and only
+ * the region is invalidated. Pixels of the region that nothing covers keep
+ * their old content, so a partial redraw usually starts with a background
+ * rect over the region.
+ *
+ * On a double-buffered canvas (canvas_flip.hpp, opt-in) the session
+ * draws into the back buffer, and its region is shown at the next flip.
+ *
+ * Label text is copied into the arena, so temporary strings are fine. The
+ * arena is kept per canvas (LV_CPP_CANVAS_SESSIONS slots) and reused from
+ * frame to frame; it is released when the canvas is deleted. One session
+ * per canvas may be open at a time.
+ *
+ * Heap allocation: the per-canvas arena (lv_malloc, grown by doubling and
+ * reused); NONE per primitive in the wrapper
+ */
+
+#include <lvgl.h>
+#include <cstdint>
+#include <cstring>
+#include "layer.hpp"
+#include "draw_rect.hpp"
+#include "draw_line.hpp"
+#include "draw_label.hpp"
+#include "../widgets/canvas.hpp"
+
+#if LV_USE_CANVAS
+
+namespace lv {
+
+#ifndef LV_CPP_CANVAS_SESSIONS
+/// Canvases that keep a session arena at once
+#define LV_CPP_CANVAS_SESSIONS 4
+#endif
+
+namespace canvas_session {
+
+struct Stats {
+    uint32_t submits = 0;       ///< Layers finished
+    uint32_t recorded = 0;      ///< Primitives recorded
+    uint32_t drawn = 0;         ///< Primitives that became draw tasks
+    uint32_t culled = 0;        ///< Primitives outside the redraw region
+    uint32_t dropped = 0;       ///< Primitives lost to a failed arena allocation
+    uint32_t arena_bytes = 0;   ///< Bytes held by all arenas
+};
+
+namespace detail {
+
+enum class Op : uint8_t { rect, line, label };
+
+struct Cmd {
+    Op op;
+    lv_area_t bounds;    ///< Pixels the primitive can touch (culling, invalidation)
+    lv_area_t coords;    ///< rect / label area
+    uint32_t text;       ///< label: offset of the copied text in the arena
+    union {
+        lv_draw_rect_dsc_t rect;
+        lv_draw_line_dsc_t line;
+        lv_draw_label_dsc_t label;
+    } dsc;
+};
+
+struct Arena {
+    lv_obj_t* canvas = nullptr;    ///< nullptr: free slot
+    Cmd* cmds = nullptr;
+    uint32_t count = 0;
+    uint32_t cap = 0;
+    char* text = nullptr;
+    uint32_t text_len = 0;
+    uint32_t text_cap = 0;
+};
+
+struct Tables {
+    Arena arenas[LV_CPP_CANVAS_SESSIONS];
+    Stats stats;
+};
+
+[[nodiscard]] inline Tables& tables() noexcept {
+    static Tables t;
+    return t;
+}
+
+/// Grow `buf` to hold `need` elements (doubling)
+template <typename T>
+[[nodiscard]] inline bool grow(T*& buf, uint32_t& cap, uint32_t need) noexcept {
+    if (need <= cap) return true;
+    uint32_t n = cap ? cap : 64;
+    while (n < need) n *= 2;
+    void* p = lv_realloc(buf, static_cast<size_t>(n) * sizeof(T));
+    if (!p) return false;
+    tables().stats.arena_bytes += (n - cap) * static_cast<uint32_t>(sizeof(T));
+    buf = static_cast<T*>(p);
+    cap = n;
+    return true;
+}
+
+inline void release(Arena& a) noexcept {
+    tables().stats.arena_bytes -= a.cap * static_cast<uint32_t>(sizeof(Cmd)) + a.text_cap;
+    lv_free(a.cmds);
+    lv_free(a.text);
+    a = Arena{};
+}
+
+inline void canvas_delete_cb(lv_event_t* e) noexcept {
+    auto* canvas = static_cast<lv_obj_t*>(lv_event_get_current_target(e));
+    for (Arena& a : tables().arenas) {
+        if (a.canvas == canvas) release(a);
+    }
+}
+
+[[nodiscard]] inline Arena* arena_for(lv_obj_t* canvas) noexcept {
+    Arena* free_slot = nullptr;
+    for (Arena& a : tables().arenas) {
+        if (a.canvas == canvas) return &a;
+        if (!a.canvas && !free_slot) free_slot = &a;
+    }
+    if (!free_slot) {
+        LV_LOG_WARN("canvas session arenas exhausted, raise LV_CPP_CANVAS_SESSIONS");
+        return nullptr;
+    }
+    free_slot->canvas = canvas;
+    lv_obj_add_event_cb(canvas, &canvas_delete_cb, LV_EVENT_DELETE, nullptr);
+    return free_slot;
+}
+
+[[nodiscard]] inline lv_area_t grown(const lv_area_t& a, int32_t by) noexcept {
+    return {a.x1 - by, a.y1 - by, a.x2 + by, a.y2 + by};
+}
+
+/// Rect bounds including shadow and outline
+[[nodiscard]] inline lv_area_t rect_bounds(const lv_draw_rect_dsc_t& d, const lv_area_t& coords) noexcept {
+    int32_t ext = 0;
+    if (d.shadow_width > 0 || d.shadow_spread > 0) {
+        const int32_t ofs = LV_MAX(LV_ABS(d.shadow_offset_x), LV_ABS(d.shadow_offset_y));
+        ext = d.shadow_width / 2 + 1 + d.shadow_spread + ofs;
+    }
+    if (d.outline_width > 0) ext = LV_MAX(ext, d.outline_pad + d.outline_width);
+    return grown(coords, ext);
+}
+
+[[nodiscard]] inline lv_area_t line_bounds(const lv_draw_line_dsc_t& d) noexcept {
+    const auto x1 = static_cast<int32_t>(d.p1.x);
+    const auto y1 = static_cast<int32_t>(d.p1.y);
+    const auto x2 = static_cast<int32_t>(d.p2.x);
+    const auto y2 = static_cast<int32_t>(d.p2.y);
+    const lv_area_t a{LV_MIN(x1, x2), LV_MIN(y1, y2), LV_MAX(x1, x2), LV_MAX(y1, y2)};
+    return grown(a, d.width / 2 + 1);
+}
+
+} // namespace detail
+
+[[nodiscard]] inline Stats stats() noexcept { return detail::tables().stats; }
+
+inline void reset_stats() noexcept {
+    Stats& s = detail::tables().stats;
+    const uint32_t bytes = s.arena_bytes;
+    s = Stats{};
+    s.arena_bytes = bytes;
+}
+
+/// Free every arena (reallocated on the next begin()); not while a session is open
+inline void drop() noexcept {
+    for (detail::Arena& a : detail::tables().arenas) {
+        if (!a.canvas) continue;
+        lv_obj_remove_event_cb_with_user_data(a.canvas, &detail::canvas_delete_cb, nullptr);
+        detail::release(a);
+    }
+}
+
+} // namespace canvas_session
+
+/**
+ * @brief Recording of canvas draws, submitted in one layer (see canvas_session.hpp)
+ *
+ * Returned by Canvas::begin(). Submits on destruction unless submit() or
+ * cancel() ran first.
+ */
+class CanvasSession {
+    lv_obj_t* m_canvas = nullptr;
+    canvas_session::detail::Arena* m_arena = nullptr;
+    lv_area_t m_region{};
+    bool m_partial = false;
+
+    /// Slot for one more command; nullptr if the arena cannot grow
+    [[nodiscard]] canvas_session::detail::Cmd* push(canvas_session::detail::Op op, const lv_area_t& bounds) noexcept {
+        using namespace canvas_session::detail;
+        if (!m_arena) return nullptr;
+        if (!grow(m_arena->cmds, m_arena->cap, m_arena->count + 1)) {
+            ++tables().stats.dropped;
+            return nullptr;
+        }
+        ++tables().stats.recorded;
+        Cmd* c = &m_arena->cmds[m_arena->count++];
+        c->op = op;
+        c->bounds = bounds;
+        c->text = UINT32_MAX;
+        return c;
+    }
+
+    void clear() noexcept {
+        if (!m_arena) return;
+        m_arena->count = 0;
+        m_arena->text_len = 0;
+    }
+
+public:
+    CanvasSession() noexcept = default;
+
+    CanvasSession(lv_obj_t* canvas, const lv_area_t* region) noexcept
+        : m_canvas(canvas), m_arena(canvas ? canvas_session::detail::arena_for(canvas) : nullptr) {
+        clear();
+        if (region) {
+            m_region = *region;
+            m_partial = true;
+        }
+    }
+
+    CanvasSession(const CanvasSession&) = delete;
+    CanvasSession& operator=(const CanvasSession&) = delete;
+
+    CanvasSession(CanvasSession&& o) noexcept
+        : m_canvas(o.m_canvas), m_arena(o.m_arena), m_region(o.m_region), m_partial(o.m_partial) {
+        o.m_arena = nullptr;
+    }
+
+    CanvasSession& operator=(CanvasSession&& o) noexcept {
+        if (this != &o) {
+            submit();
+            m_canvas = o.m_canvas;
+            m_arena = o.m_arena;
+            m_region = o.m_region;
+            m_partial = o.m_partial;
+            o.m_arena = nullptr;
+        }
+        return *this;
+    }
+
+    ~CanvasSession() { submit(); }
+
+    // ==================== Recording ====================
+
+    /// Rectangle (background, border, shadow, outline) in canvas buffer coordinates
+    CanvasSession& rect(const RectDsc& dsc, const lv_area_t& coords) noexcept {
+        if (auto* c = push(canvas_session::detail::Op::rect, canvas_session::detail::rect_bounds(*dsc.get(), coords))) {
+            c->coords = coords;
+            c->dsc.rect = *dsc.get();
+        }
+        return *this;
+    }
+
+    CanvasSession& line(const LineDsc& dsc) noexcept {
+        if (auto* c = push(canvas_session::detail::Op::line, canvas_session::detail::line_bounds(*dsc.get()))) {
+            c->dsc.line = *dsc.get();
+        }
+        return *this;
+    }
+
+    /// Text is copied, so `dsc` may point at a temporary string
+    CanvasSession& label(const LabelDsc& dsc, const lv_area_t& coords) noexcept {
+        using namespace canvas_session::detail;
+        const lv_draw_label_dsc_t& d = *dsc.get();
+        if (!m_arena || !d.text) return *this;
+        const uint32_t len = d.text_length ? d.text_length : static_cast<uint32_t>(std::strlen(d.text));
+        if (!grow(m_arena->text, m_arena->text_cap, m_arena->text_len + len + 1)) {
+            ++tables().stats.dropped;
+            return *this;
+        }
+        if (Cmd* c = push(Op::label, coords)) {
+            c->coords = coords;
+            c->dsc.label = d;
+            c->text = m_arena->text_len;
+            std::memcpy(m_arena->text + m_arena->text_len, d.text, len);
+            m_arena->text[m_arena->text_len + len] = '\0';
+            m_arena->text_len += len + 1;
+        }
+        return *this;
+    }
+
+    /// Primitives recorded so far
+    [[nodiscard]] uint32_t size() const noexcept { return m_arena ? m_arena->count : 0; }
+
+    // ==================== Submission ====================
+
+    /// Drop everything recorded and close the session without drawing
+    void cancel() noexcept {
+        clear();
+        m_arena = nullptr;
+    }
+
+    /**
+     * @brief Draw everything recorded in one layer, finish once, invalidate once
+     *
+     * Closes the session; later calls do nothing.
+     */
+    void submit() noexcept {
+        using namespace canvas_session::detail;
+        Arena* a = m_arena;
+        m_arena = nullptr;
+        if (!a || a->count == 0) return;
+
+        lv_layer_t layer;
+        const lv::detail::CanvasFlipHooks& flip = lv::detail::canvas_flip_hooks();
+        const bool back = flip.init_layer && flip.init_layer(m_canvas, layer);
+        if (!back) lv_canvas_init_layer(m_canvas, &layer);
+        lv_area_t clip = layer._clip_area;
+        if (m_partial && !lv_area_intersect(&clip, &clip, &m_region)) {
+            tables().stats.culled += a->count;
+            a->count = 0;
+            a->text_len = 0;
+            return;
+        }
+        layer._clip_area = clip;
+        layer.phy_clip_area = clip;
+
+        Stats& st = tables().stats;
+        lv_area_t dirty{};
+        bool any = false;
+        for (uint32_t i = 0; i < a->count; ++i) {
+            Cmd& c = a->cmds[i];
+            lv_area_t touched;
+            if (!lv_area_intersect(&touched, &c.bounds, &clip)) {
+                ++st.culled;
+                continue;
+            }
+            if (any) {
+                dirty = {LV_MIN(dirty.x1, touched.x1), LV_MIN(dirty.y1, touched.y1),
+                         LV_MAX(dirty.x2, touched.x2), LV_MAX(dirty.y2, touched.y2)};
+            } else {
+                dirty = touched;
+                any = true;
+            }
+            ++st.drawn;
+            switch (c.op) {
+            case Op::rect: lv_draw_rect(&layer, &c.dsc.rect, &c.coords); break;
+            case Op::line: lv_draw_line(&layer, &c.dsc.line); break;
+            case Op::label:
+                c.dsc.label.text = a->text + c.text;
+                c.dsc.label.text_local = 0;
+                lv_draw_label(&layer, &c.dsc.label, &c.coords);
+                break;
+            }
+        }
+        a->count = 0;
+        a->text_len = 0;
+        if (!any) return;
+
+        // Same loop as lv_canvas_finish_layer(), without its full-canvas invalidation
+        while (layer.draw_task_head) {
+            lv_draw_dispatch_wait_for_request();
+            if (!lv_draw_dispatch_layer(lv_obj_get_display(m_canvas), &layer)) {
+                lv_draw_wait_for_finish();
+                lv_draw_dispatch_request();
+            }
+        }
+        ++st.submits;
+
+        if (back) {
+            flip.mark(m_canvas, dirty);
+        } else if (const lv_draw_buf_t* buf = lv_canvas_get_draw_buf(m_canvas)) {
+            lv::detail::canvas_invalidate(m_canvas, buf, dirty);
+        }
+    }
+};
+
+inline CanvasSession Canvas::begin() noexcept {
+    return CanvasSession(m_obj, nullptr);
+}
+
+inline CanvasSession Canvas::begin(const lv_area_t& region) noexcept {
+    return CanvasSession(m_obj, &region);
+}
+
+} // namespace lv
+
+#endif // LV_USE_CANVAS
@@ -75,12 +75,14 @@
 #include "draw_image.hpp"    // ImageDsc
 #include "draw_mask.hpp"     // MaskRectDsc (LVGL 9.5+, guarded internally)
 #include "draw_task.hpp"     // DrawTaskView, draw system utilities
+#include "canvas_session.hpp" // CanvasSession, Canvas::begin() (requires LV_USE_CANVAS)
 
 // 3D texture drawing (requires LV_USE_3DTEXTURE)
 #include "draw_3d.hpp"       // Draw3dDsc
 
 // Image decoding
-#include "image_decoder.hpp" // ImageDecoderDsc, ImageDecoder
+#include "image_decoder.hpp" // ImageDecoderDsc, ImageDecoder, ImageDecoderBase
+#include "image_codecs.hpp"  // QoiDecoder, Lz4ImageDecoder
 
 // Vector graphics (requires LV_USE_VECTOR_GRAPHIC)
 #include "draw_vector.hpp"   // VectorPath, VectorDsc
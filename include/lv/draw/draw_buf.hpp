@@ -2,10 +2,23 @@
 
 /**
  * @file draw_buf.hpp
- * @brief RAII wrapper for LVGL draw buffers
+ * @brief RAII wrapper for LVGL draw buffers and the pooled allocation routes
+ *
+ * DrawBuf::acquire() and the wrapper's caches allocate through
+ * draw::pool_handlers() / pool_malloc(). Those are LVGL's default
+ * allocator until DrawBufPool (draw_buf_pool.hpp, opt-in) is set up, which
+ * keeps freed pixel buffers in size-class buckets and hands them out again
+ * instead of going back to lv_malloc()/lv_free():
+ *
+ * @code
+ * lv::DrawBuf buf = lv::DrawBuf::acquire(200, 200, LV_COLOR_FORMAT_ARGB8888);
+ * canvas.draw_buf(buf.get());              // pooled once DrawBufPool is installed
+ * @endcode
  */
 
 #include <lvgl.h>
+#include <cstddef>
+#include <cstdint>
 #include <utility>
 #include "../core/wrap.hpp"
 
@@ -198,6 +211,17 @@ public:
         return DrawBuf(wrap, lv_draw_buf_dup_ex(handlers, src.m_buf));
     }
 
+    /**
+     * @brief Lease a buffer through draw::pool_handlers()
+     *
+     * With DrawBufPool set up (draw_buf_pool.hpp) the pixel memory comes
+     * from the pool and goes back to it when the DrawBuf is destroyed.
+     * Contents are not cleared; call clear() if the buffer is not fully
+     * overwritten.
+     */
+    [[nodiscard]] static DrawBuf acquire(uint32_t w, uint32_t h, lv_color_format_t cf,
+                                         uint32_t stride = LV_STRIDE_AUTO) noexcept;
+
     /// Create with custom handlers
     [[nodiscard]] static DrawBuf create_ex(const lv_draw_buf_handlers_t* handlers,
                                            uint32_t w, uint32_t h,
@@ -310,17 +334,92 @@ inline void buf_init_default_handlers(lv_draw_buf_handlers_t* handlers) noexcept
 
 /// Initialize handlers with custom callbacks
 inline void buf_handlers_init(lv_draw_buf_handlers_t* handlers,
-                              lv_draw_buf_malloc_cb_t malloc_cb,
-                              lv_draw_buf_free_cb_t free_cb,
-                              lv_draw_buf_copy_cb_t copy_cb,
-                              lv_draw_buf_align_cb_t align_cb,
-                              lv_draw_buf_cache_operation_cb_t invalidate_cache_cb,
-                              lv_draw_buf_cache_operation_cb_t flush_cache_cb,
-                              lv_draw_buf_width_to_stride_cb_t stride_cb) noexcept {
-    lv_draw_buf_handlers_init(handlers, malloc_cb, free_cb, copy_cb, align_cb,
+                              lv_draw_buf_malloc_cb malloc_cb,
+                              lv_draw_buf_free_cb free_cb,
+                              lv_draw_buf_align_cb align_cb,
+                              lv_draw_buf_cache_operation_cb invalidate_cache_cb,
+                              lv_draw_buf_cache_operation_cb flush_cache_cb,
+                              lv_draw_buf_width_to_stride_cb stride_cb) noexcept {
+    lv_draw_buf_handlers_init(handlers, malloc_cb, free_cb, align_cb,
                               invalidate_cache_cb, flush_cache_cb, stride_cb);
 }
 
 } // namespace draw
 
+// ==================== Pooled Allocation ====================
+
+/// DrawBufPool counters (see DrawBufPool::stats() in draw_buf_pool.hpp)
+struct DrawBufPoolStats {
+    uint32_t hits = 0;          ///< Requests served from an idle pooled buffer
+    uint32_t misses = 0;        ///< Requests that allocated a new buffer
+    uint32_t bypassed = 0;      ///< Requests left unpooled (no slot or over the cap)
+    uint32_t buffers = 0;       ///< Buffers currently held by the pool
+    size_t bytes = 0;           ///< Bytes held by the pool (idle + leased)
+    size_t idle_bytes = 0;      ///< Bytes waiting for reuse
+    size_t peak_bytes = 0;      ///< Highest `bytes` since the last reset_stats()
+};
+
+namespace detail {
+
+/// Allocation routes DrawBufPool (draw_buf_pool.hpp) takes over on first use
+struct DrawBufPoolHooks {
+    const lv_draw_buf_handlers_t* (*handlers)() noexcept = nullptr;
+    void* (*alloc)(size_t size, lv_color_format_t cf) noexcept = nullptr;
+    void (*release)(void* mem) noexcept = nullptr;
+    void (*trim)() noexcept = nullptr;
+    DrawBufPoolStats (*stats)() noexcept = nullptr;
+};
+
+[[nodiscard]] inline DrawBufPoolHooks& draw_buf_pool_hooks() noexcept {
+    static DrawBufPoolHooks hooks;
+    return hooks;
+}
+
+} // namespace detail
+
+namespace draw {
+
+/**
+ * @brief Handler set for the wrapper's own pixel buffers
+ *
+ * DrawBufPool's once draw_buf_pool.hpp has set the pool up, LVGL's
+ * default handlers until then.
+ */
+[[nodiscard]] inline const lv_draw_buf_handlers_t* pool_handlers() noexcept {
+    const detail::DrawBufPoolHooks& h = detail::draw_buf_pool_hooks();
+    return h.handlers ? h.handlers() : lv_draw_buf_get_handlers();
+}
+
+/// Raw bytes from the same allocator as pool_handlers(); give them back with pool_free()
+[[nodiscard]] inline void* pool_malloc(size_t size, lv_color_format_t cf) noexcept {
+    const detail::DrawBufPoolHooks& h = detail::draw_buf_pool_hooks();
+    return h.alloc ? h.alloc(size, cf) : lv_malloc(size);
+}
+
+inline void pool_free(void* mem) noexcept {
+    const detail::DrawBufPoolHooks& h = detail::draw_buf_pool_hooks();
+    if (h.release) {
+        h.release(mem);
+    } else {
+        lv_free(mem);
+    }
+}
+
+/// Release the pool's idle buffers (nothing without DrawBufPool)
+inline void pool_trim() noexcept {
+    if (detail::draw_buf_pool_hooks().trim) detail::draw_buf_pool_hooks().trim();
+}
+
+/// DrawBufPool counters (all zero without DrawBufPool)
+[[nodiscard]] inline DrawBufPoolStats pool_stats() noexcept {
+    const detail::DrawBufPoolHooks& h = detail::draw_buf_pool_hooks();
+    return h.stats ? h.stats() : DrawBufPoolStats{};
+}
+
+} // namespace draw
+
+inline DrawBuf DrawBuf::acquire(uint32_t w, uint32_t h, lv_color_format_t cf, uint32_t stride) noexcept {
+    return DrawBuf(wrap, lv_draw_buf_create_ex(draw::pool_handlers(), w, h, cf, stride));
+}
+
 } // namespace lv
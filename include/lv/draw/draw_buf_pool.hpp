@@ -0,0 +1,328 @@
+#pragma once
+
+/**
+ * @file draw_buf_pool.hpp
+ * @brief Pooled allocator for draw buffer pixel memory (opt-in)
+ *
+ * DrawBufPool keeps freed pixel buffers in size-class buckets and hands them
+ * out again instead of going back to lv_malloc()/lv_free(), so canvases,
+ * snapshots and layers stop fragmenting the heap. Once set up it also
+ * serves draw::pool_handlers() and pool_malloc() (draw_buf.hpp), which the
+ * wrapper's caches allocate through:
+ *
+ * @code
+ * #include <lv/draw/draw_buf_pool.hpp>
+ *
+ * lv::DrawBufPool::cap(4 * 1024 * 1024);   // optional: bytes held by the pool
+ * lv::DrawBufPool::install();              // LVGL layers and lv_draw_buf_create()
+ *
+ * lv::DrawBuf buf = lv::DrawBuf::acquire(200, 200, LV_COLOR_FORMAT_ARGB8888);
+ * canvas.draw_buf(buf.get());              // memory returns to the pool with `buf`
+ *
+ * auto s = lv::DrawBufPool::stats();
+ * LV_LOG_USER("draw buf pool: %u hits, %u misses", (unsigned)s.hits, (unsigned)s.misses);
+ * @endcode
+ *
+ * Not included by lv.hpp: it copies and patches lv_draw_buf_handlers_t,
+ * whose fields are not public. Checked against LVGL 9.4 (see
+ * LV_CPP_INTERNALS_OK).
+ *
+ * Heap allocation: pixel memory only (LV_CPP_DRAW_BUF_POOL_SLOTS fixed slots)
+ */
+
+#include <lvgl.h>
+#include "../core/version.hpp"
+
+#if !LV_CPP_INTERNALS_OK
+#error "draw_buf_pool.hpp reads LVGL internals checked against LVGL 9.4; see LV_CPP_INTERNALS_OK"
+#endif
+
+#include <src/draw/lv_draw_buf_private.h>  // lv_draw_buf_handlers_t fields
+#include <cstddef>
+#include <cstdint>
+#include "draw_buf.hpp"
+
+#ifndef LV_CPP_DRAW_BUF_POOL_SLOTS
+/// Maximum number of buffers (idle or leased) tracked by DrawBufPool
+#define LV_CPP_DRAW_BUF_POOL_SLOTS 32
+#endif
+
+namespace lv {
+
+namespace detail {
+
+struct DrawBufBlock {
+    void* mem = nullptr;        ///< nullptr: free slot
+    size_t size = 0;            ///< Size class in bytes
+    lv_color_format_t cf = LV_COLOR_FORMAT_UNKNOWN;
+    uint32_t last_used = 0;
+    bool leased = false;
+};
+
+struct DrawBufPoolState {
+    DrawBufBlock blocks[LV_CPP_DRAW_BUF_POOL_SLOTS];
+    lv_draw_buf_handlers_t handlers{};            ///< Pool handlers used by DrawBuf::acquire()
+    lv_draw_buf_handlers_t* target = nullptr;     ///< Handlers patched by install()
+    lv_draw_buf_malloc_cb base_malloc = nullptr;  ///< Allocator the pool draws from
+    lv_draw_buf_free_cb base_free = nullptr;
+    size_t cap = 0;
+    size_t bytes = 0;
+    uint32_t clock = 0;
+    DrawBufPoolStats stats;
+    lv_mutex_t lock;
+
+    DrawBufPoolState() noexcept { lv_mutex_init(&lock); }
+};
+
+[[nodiscard]] inline DrawBufPoolState& draw_buf_pool() noexcept {
+    static DrawBufPoolState pool;
+    return pool;
+}
+
+struct DrawBufPoolLock {
+    DrawBufPoolState& pool;
+    explicit DrawBufPoolLock(DrawBufPoolState& p) noexcept : pool(p) { lv_mutex_lock(&pool.lock); }
+    ~DrawBufPoolLock() { lv_mutex_unlock(&pool.lock); }
+    DrawBufPoolLock(const DrawBufPoolLock&) = delete;
+    DrawBufPoolLock& operator=(const DrawBufPoolLock&) = delete;
+};
+
+/// Round up to a quarter step of the enclosing power of two (at most 25% slack, 256 B minimum)
+[[nodiscard]] constexpr size_t draw_buf_size_class(size_t size) noexcept {
+    if (size <= 256) return 256;
+    size_t pow2 = 256;
+    while (pow2 * 2 < size) pow2 *= 2;
+    const size_t step = pow2 / 4;
+    return (size + step - 1) / step * step;
+}
+
+inline void draw_buf_release_block(DrawBufPoolState& pool, DrawBufBlock& b) noexcept {
+    pool.base_free(b.mem);
+    pool.bytes -= b.size;
+    b = DrawBufBlock{};
+}
+
+/// Free least recently used idle buffers until `need` more bytes fit under the cap
+/// and a slot is available; false if that is not possible
+inline bool draw_buf_make_room(DrawBufPoolState& pool, size_t need) noexcept {
+    for (;;) {
+        bool have_slot = false;
+        DrawBufBlock* lru = nullptr;
+        for (DrawBufBlock& b : pool.blocks) {
+            if (!b.mem) {
+                have_slot = true;
+            } else if (!b.leased && (!lru || b.last_used < lru->last_used)) {
+                lru = &b;
+            }
+        }
+        if (have_slot && (pool.cap == 0 || pool.bytes + need <= pool.cap)) return true;
+        if (!lru) return false;
+        draw_buf_release_block(pool, *lru);
+    }
+}
+
+/// Release idle buffers while the pool holds more than its cap
+inline void draw_buf_enforce_cap(DrawBufPoolState& pool) noexcept {
+    while (pool.cap && pool.bytes > pool.cap) {
+        DrawBufBlock* lru = nullptr;
+        for (DrawBufBlock& b : pool.blocks) {
+            if (b.mem && !b.leased && (!lru || b.last_used < lru->last_used)) lru = &b;
+        }
+        if (!lru) return;
+        draw_buf_release_block(pool, *lru);
+    }
+}
+
+inline void* draw_buf_pool_malloc_cb(size_t size, lv_color_format_t cf) noexcept {
+    DrawBufPoolState& pool = draw_buf_pool();
+    DrawBufPoolLock guard(pool);
+    const size_t cls = draw_buf_size_class(size);
+    for (DrawBufBlock& b : pool.blocks) {
+        if (b.mem && !b.leased && b.size == cls && b.cf == cf) {
+            b.leased = true;
+            ++pool.stats.hits;
+            return b.mem;
+        }
+    }
+    ++pool.stats.misses;
+    if (!draw_buf_make_room(pool, cls)) {
+        ++pool.stats.bypassed;
+        return pool.base_malloc(size, cf);
+    }
+    void* mem = pool.base_malloc(cls, cf);
+    if (!mem) {
+        // Out of memory: give every idle buffer back to the heap and retry once
+        for (DrawBufBlock& b : pool.blocks) {
+            if (b.mem && !b.leased) draw_buf_release_block(pool, b);
+        }
+        mem = pool.base_malloc(cls, cf);
+        if (!mem) return nullptr;
+    }
+    for (DrawBufBlock& b : pool.blocks) {
+        if (b.mem) continue;
+        b = DrawBufBlock{mem, cls, cf, 0, true};
+        break;
+    }
+    pool.bytes += cls;
+    if (pool.bytes > pool.stats.peak_bytes) pool.stats.peak_bytes = pool.bytes;
+    return mem;
+}
+
+inline void draw_buf_pool_free_cb(void* mem) noexcept {
+    if (!mem) return;
+    DrawBufPoolState& pool = draw_buf_pool();
+    DrawBufPoolLock guard(pool);
+    for (DrawBufBlock& b : pool.blocks) {
+        if (b.mem != mem) continue;
+        b.leased = false;
+        b.last_used = ++pool.clock;
+        draw_buf_enforce_cap(pool);
+        return;
+    }
+    pool.base_free(mem);    // allocated before install() or bypassed
+}
+
+inline void draw_buf_pool_trim() noexcept {
+    DrawBufPoolState& pool = draw_buf_pool();
+    DrawBufPoolLock guard(pool);
+    for (DrawBufBlock& b : pool.blocks) {
+        if (b.mem && !b.leased) draw_buf_release_block(pool, b);
+    }
+}
+
+[[nodiscard]] inline DrawBufPoolStats draw_buf_pool_stats() noexcept {
+    DrawBufPoolState& pool = draw_buf_pool();
+    DrawBufPoolLock guard(pool);
+    DrawBufPoolStats s = pool.stats;
+    s.bytes = pool.bytes;
+    for (const DrawBufBlock& b : pool.blocks) {
+        if (!b.mem) continue;
+        ++s.buffers;
+        if (!b.leased) s.idle_bytes += b.size;
+    }
+    return s;
+}
+
+[[nodiscard]] inline const lv_draw_buf_handlers_t* draw_buf_pool_handlers() noexcept {
+    return &draw_buf_pool().handlers;
+}
+
+/// Capture the base allocator, set up the pool's own handlers and take over
+/// draw::pool_handlers() / pool_malloc() (first use only)
+inline void draw_buf_pool_init(DrawBufPoolState& pool) noexcept {
+    if (pool.base_malloc) return;
+    const lv_draw_buf_handlers_t* base = lv_draw_buf_get_handlers();
+    pool.base_malloc = base->buf_malloc_cb;
+    pool.base_free = base->buf_free_cb;
+    pool.handlers = *base;
+    pool.handlers.buf_malloc_cb = &draw_buf_pool_malloc_cb;
+    pool.handlers.buf_free_cb = &draw_buf_pool_free_cb;
+    draw_buf_pool_hooks() = DrawBufPoolHooks{&draw_buf_pool_handlers, &draw_buf_pool_malloc_cb,
+                                             &draw_buf_pool_free_cb, &draw_buf_pool_trim, &draw_buf_pool_stats};
+}
+
+} // namespace detail
+
+/**
+ * @brief Pooled allocator for draw buffer pixel memory
+ *
+ * Buffers are bucketed by color format and by a size class of their byte
+ * size (stride * height, rounded up to a quarter power-of-two step), so
+ * buffers of similar (w, h, cf, stride) share one bucket. A freed buffer
+ * stays in the pool until it is requested again, trim() is called, the cap
+ * is reached or the pool runs out of slots (least recently used first).
+ * New memory comes from the allocator of lv_draw_buf_get_handlers() as it
+ * was on first use, so GPU-specific allocators keep working.
+ *
+ * install() routes one lv_draw_buf_handlers_t (by default LVGL's default
+ * handlers, used for layers and lv_draw_buf_create()) through the pool.
+ * From the first install() or handlers() call on, DrawBuf::acquire() and
+ * the wrapper's caches (draw::pool_handlers()) use the pool whether or not
+ * it is installed.
+ *
+ * Heap allocation: pixel memory only (LV_CPP_DRAW_BUF_POOL_SLOTS fixed slots)
+ */
+class DrawBufPool {
+public:
+    DrawBufPool() = delete;
+
+    /**
+     * @brief Route a handler set's buffer allocations through the pool
+     *
+     * Keeps the set's align, cache and stride callbacks. Buffers allocated
+     * before the call are freed through the original allocator.
+     */
+    static void install(lv_draw_buf_handlers_t* handlers = lv_draw_buf_get_handlers()) noexcept {
+        detail::DrawBufPoolState& pool = detail::draw_buf_pool();
+        detail::draw_buf_pool_init(pool);
+        if (!handlers || pool.target == handlers) return;
+        uninstall();
+        draw::buf_handlers_init(handlers, &detail::draw_buf_pool_malloc_cb, &detail::draw_buf_pool_free_cb,
+                                handlers->align_pointer_cb, handlers->invalidate_cache_cb,
+                                handlers->flush_cache_cb, handlers->width_to_stride_cb);
+        pool.target = handlers;
+    }
+
+    /**
+     * @brief Restore the installed handler set's allocator and release idle buffers
+     *
+     * Buffers still leased are no longer tracked; they go straight back to
+     * the original allocator when freed.
+     */
+    static void uninstall() noexcept {
+        detail::DrawBufPoolState& pool = detail::draw_buf_pool();
+        if (!pool.target) return;
+        detail::DrawBufPoolLock guard(pool);
+        pool.target->buf_malloc_cb = pool.base_malloc;
+        pool.target->buf_free_cb = pool.base_free;
+        pool.target = nullptr;
+        for (detail::DrawBufBlock& b : pool.blocks) {
+            if (!b.mem) continue;
+            if (b.leased) {
+                pool.bytes -= b.size;
+                b = detail::DrawBufBlock{};
+            } else {
+                detail::draw_buf_release_block(pool, b);
+            }
+        }
+    }
+
+    [[nodiscard]] static bool installed() noexcept { return detail::draw_buf_pool().target != nullptr; }
+
+    /// Limit the bytes held by the pool (0: unlimited); excess idle buffers are released
+    static void cap(size_t bytes) noexcept {
+        detail::DrawBufPoolState& pool = detail::draw_buf_pool();
+        detail::DrawBufPoolLock guard(pool);
+        pool.cap = bytes;
+        detail::draw_buf_enforce_cap(pool);
+    }
+
+    [[nodiscard]] static size_t cap() noexcept { return detail::draw_buf_pool().cap; }
+
+    /// Release every idle buffer back to the heap
+    static void trim() noexcept { detail::draw_buf_pool_trim(); }
+
+    [[nodiscard]] static DrawBufPoolStats stats() noexcept { return detail::draw_buf_pool_stats(); }
+
+    /// Zero the hit/miss/bypass counters and the peak
+    static void reset_stats() noexcept {
+        detail::DrawBufPoolState& pool = detail::draw_buf_pool();
+        detail::DrawBufPoolLock guard(pool);
+        pool.stats = DrawBufPoolStats{};
+        pool.stats.peak_bytes = pool.bytes;
+    }
+
+    /// Handler set allocating from the pool (for lv_draw_buf_create_ex() and friends)
+    [[nodiscard]] static const lv_draw_buf_handlers_t* handlers() noexcept {
+        detail::DrawBufPoolState& pool = detail::draw_buf_pool();
+        detail::draw_buf_pool_init(pool);
+        return &pool.handlers;
+    }
+
+    /// Bucket size for a request of `bytes`
+    [[nodiscard]] static constexpr size_t size_class(size_t bytes) noexcept {
+        return detail::draw_buf_size_class(bytes);
+    }
+};
+
+} // namespace lv
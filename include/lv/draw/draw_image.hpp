@@ -3,6 +3,9 @@
 /**
  * @file draw_image.hpp
  * @brief Wrapper for LVGL image drawing
+ *
+ * NineSlice describes a source image cut into 3x3 patches; nine_slice.hpp
+ * (opt-in) draws it.
  */
 
 #include <lvgl.h>
@@ -145,6 +148,28 @@ public:
     }
 };
 
+/// How the edges or the center of a NineSlice fill their area
+enum class SliceFill : uint8_t {
+    stretch,    ///< Scale the source strip to the area
+    repeat      ///< Repeat the source strip 1:1 (clipped at the far end)
+};
+
+/**
+ * @brief Source image cut into 3x3 patches by four insets
+ *
+ * The insets are in source pixels. `src` must stay valid as long as it is
+ * drawn; a `static constexpr` instance costs no RAM.
+ */
+struct NineSlice {
+    const void* src = nullptr;
+    int32_t left = 0;
+    int32_t top = 0;
+    int32_t right = 0;
+    int32_t bottom = 0;
+    SliceFill edges = SliceFill::stretch;
+    SliceFill center = SliceFill::stretch;
+};
+
 namespace draw {
 
 /// Draw an image
@@ -7,6 +7,7 @@
 
 #include <lvgl.h>
 #include "layer.hpp"
+#include "../core/frame_arena.hpp"
 #include "primitives.hpp"
 
 namespace lv {
@@ -55,6 +56,13 @@ public:
         return *this;
     }
 
+    /// Format the text into FrameArena::instance() (valid until the next refresh starts)
+    template<typename... Args>
+    LabelDsc& text_fmt(const char* fmt, Args... args) noexcept {
+        m_dsc.text = FrameArena::instance().format(fmt, args...);
+        return *this;
+    }
+
     /// Set text length (0 = until null terminator)
     LabelDsc& text_length(uint32_t len) noexcept {
         m_dsc.text_length = len;
@@ -6,6 +6,9 @@
  *
  * The struct lv_draw_mask_rect_dsc_t is opaque (private header) in LVGL 9.4.
  * It moved to the public header in 9.5, making stack allocation possible.
+ *
+ * A rect mask is recomputed on every draw. For rounded fills repeated at
+ * one radius, shadow_cache::fill_rounded() draws from cached corner masks.
  */
 
 #include <lvgl.h>
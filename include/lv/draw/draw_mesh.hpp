@@ -0,0 +1,563 @@
+#pragma once
+
+/**
+ * @file draw_mesh.hpp
+ * @brief Triangle meshes and polylines drawn as one draw task each
+ *
+ * lv_draw_triangle() and lv_draw_line() make one draw task per primitive;
+ * a gauge or sparkline of a few thousand segments spends most of its frame
+ * creating, evaluating and dispatching tasks. draw::triangles() and
+ * draw::polyline() queue the whole batch as a single task:
+ *
+ * @code
+ * #include <lv/draw/draw_mesh.hpp>
+ *
+ * lv::draw::triangles(layer, verts, vert_cnt, indices, index_cnt, colors);   // per-vertex colors
+ * lv::draw::triangles(layer, verts, vert_cnt, nullptr, 0, lv::rgb(0x2080F0));
+ *
+ * lv::LineDsc dsc;
+ * dsc.color(lv::rgb(0x20C060)).width(2).round_start(true).round_end(true);
+ * lv::draw::polyline(layer, points, n, dsc);
+ * @endcode
+ *
+ * The mesh (vertices as floats, 32-bit indices, colors) is copied into
+ * FrameArena::instance(), which is attached to the display being refreshed
+ * (or the default display) so it is reset every frame. The task is an
+ * LV_DRAW_TASK_TYPE_FILL task with opacity 0 that carries the mesh
+ * (mesh::from_task()); the software renderer skips it and the MeshUnit
+ * draw unit, installed on first use, bids 1 for it and rasterizes it:
+ *
+ * - rows top to bottom with an active-triangle list (triangles sorted by
+ *   their first row),
+ * - 4 sub-scanlines per row with exact horizontal coverage, accumulated
+ *   for the whole mesh before blending, so shared edges leave no seams,
+ * - per-vertex colors interpolated across each triangle (Gouraud),
+ * - one lv_draw_sw_blend() call per row span with the coverage as mask.
+ *
+ * A hardware draw unit accelerates meshes by bidding 0 for FILL tasks for
+ * which mesh::from_task() is non-null and drawing them itself (or calling
+ * mesh::sw_draw()). Units that accelerate plain fills should refuse those
+ * tasks in supports().
+ *
+ * Polylines become quads per segment with bevel joins and optional round
+ * caps; dashed lines go to lv_draw_line() per segment.
+ *
+ * Not included by lv.hpp: the task is created with lv_draw_add_task()
+ * and its fields set directly, MeshUnit is a draw_unit.hpp unit, and
+ * spans are blended through lv_draw_sw_blend_dsc_t, none of which is
+ * public. Checked against LVGL 9.4 (see LV_CPP_INTERNALS_OK).
+ *
+ * Heap allocation: the mesh copy in FrameArena; one lv_malloc() scratch
+ * block per mesh while it is rasterized
+ */
+
+#include <lvgl.h>
+#include "../core/version.hpp"
+
+#if !LV_CPP_INTERNALS_OK
+#error "draw_mesh.hpp reads LVGL internals checked against LVGL 9.4; see LV_CPP_INTERNALS_OK"
+#endif
+
+#include <src/draw/lv_draw_private.h>                  // lv_draw_task_t fields
+#include <src/draw/sw/blend/lv_draw_sw_blend_private.h> // lv_draw_sw_blend_dsc_t
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include "../core/frame_arena.hpp"
+#include "draw_line.hpp"
+#include "draw_triangle.hpp"
+#include "draw_unit.hpp"
+
+namespace lv {
+
+namespace mesh {
+
+/// A queued mesh: 3 indices per triangle into `xy`
+struct Mesh {
+    const float* xy;                ///< x, y per vertex
+    const uint32_t* idx;            ///< 3 per triangle
+    const lv_color32_t* colors;     ///< Per vertex; nullptr: `color` everywhere
+    uint32_t tri_cnt;
+    lv_color_t color;
+    lv_opa_t opa;
+};
+
+struct Stats {
+    uint32_t meshes = 0;       ///< Tasks queued
+    uint32_t triangles = 0;    ///< Triangles queued
+    uint32_t rows = 0;         ///< Rows blended by sw_draw()
+    uint32_t fallbacks = 0;    ///< Batches drawn per primitive (no unit, arena full, dashes)
+};
+
+namespace detail {
+
+/// Radius of the carrier fill task; with opa 0 no regular fill task looks like it
+inline constexpr int32_t carrier_radius = INT32_MIN + 0x4D45;
+
+[[nodiscard]] inline Stats& stats() noexcept {
+    static Stats s;
+    return s;
+}
+
+/// Triangle set up for scan conversion
+struct Tri {
+    float x[3], y[3];
+    int32_t row1, row2;    ///< First and last row touched
+    float c0[4], dx[4], dy[4];    ///< b, g, r, a = c0 + dx * x + dy * y
+};
+
+/// Left/right crossing of the horizontal line `ys` with the triangle; false if it misses
+[[nodiscard]] inline bool span_at(const Tri& t, float ys, float& xl, float& xr) noexcept {
+    bool hit = false;
+    for (int e = 0; e < 3; ++e) {
+        const int f = e == 2 ? 0 : e + 1;
+        const float ya = t.y[e];
+        const float yb = t.y[f];
+        if ((ys < ya) == (ys < yb)) continue;    // edge does not cross ys (half-open)
+        const float x = t.x[e] + (ys - ya) * (t.x[f] - t.x[e]) / (yb - ya);
+        if (!hit) {
+            xl = xr = x;
+            hit = true;
+        } else {
+            xl = std::min(xl, x);
+            xr = std::max(xr, x);
+        }
+    }
+    return hit && xr > xl;
+}
+
+[[nodiscard]] inline bool setup(Tri& t, const Mesh& m, uint32_t i) noexcept {
+    for (int k = 0; k < 3; ++k) {
+        const uint32_t v = m.idx[3 * i + k];
+        t.x[k] = m.xy[2 * v];
+        t.y[k] = m.xy[2 * v + 1];
+    }
+    const float e1x = t.x[1] - t.x[0], e1y = t.y[1] - t.y[0];
+    const float e2x = t.x[2] - t.x[0], e2y = t.y[2] - t.y[0];
+    const float area2 = e1x * e2y - e2x * e1y;
+    if (area2 == 0.0f) return false;
+    t.row1 = static_cast<int32_t>(std::floor(std::min({t.y[0], t.y[1], t.y[2]})));
+    t.row2 = static_cast<int32_t>(std::ceil(std::max({t.y[0], t.y[1], t.y[2]}))) - 1;
+    if (!m.colors) return true;
+    for (int ch = 0; ch < 4; ++ch) {
+        float c[3];
+        for (int k = 0; k < 3; ++k) {
+            const lv_color32_t& col = m.colors[m.idx[3 * i + k]];
+            c[k] = ch == 0 ? col.blue : ch == 1 ? col.green : ch == 2 ? col.red : col.alpha;
+        }
+        t.dx[ch] = ((c[1] - c[0]) * e2y - (c[2] - c[0]) * e1y) / area2;
+        t.dy[ch] = ((c[2] - c[0]) * e1x - (c[1] - c[0]) * e2x) / area2;
+        t.c0[ch] = c[0] - t.dx[ch] * t.x[0] - t.dy[ch] * t.y[0];
+    }
+    return true;
+}
+
+inline void blend_row(lv_draw_task_t* t, lv_draw_unit_t* u, lv_draw_sw_blend_dsc_t& bd) noexcept {
+#if LV_VERSION_AT_LEAST(9, 3, 0)
+    LV_UNUSED(u);
+    lv_draw_sw_blend(t, &bd);
+#else
+    LV_UNUSED(t);
+    lv_draw_sw_blend(u, &bd);
+#endif
+}
+
+} // namespace detail
+
+/// The mesh a task carries, or nullptr for any other task
+[[nodiscard]] inline const Mesh* from_task(DrawTaskView t) noexcept {
+    if (t.type() != LV_DRAW_TASK_TYPE_FILL) return nullptr;
+    const auto* dsc = t.draw_dsc_as<lv_draw_fill_dsc_t>();
+    if (!dsc || dsc->opa != LV_OPA_TRANSP || dsc->radius != detail::carrier_radius) return nullptr;
+    return static_cast<const Mesh*>(dsc->base.user_data);
+}
+
+/**
+ * @brief Rasterize a mesh task into its layer with the span rasterizer
+ *
+ * For draw units: `u` is the unit drawing the task (used before LVGL 9.3).
+ */
+inline void sw_draw(DrawTaskView task, lv_draw_unit_t* u = nullptr) noexcept {
+    const Mesh* m = from_task(task);
+    lv_draw_task_t* t = task.get();
+    if (!m || m->tri_cnt == 0) return;
+    lv_area_t clip;
+    if (!lv_area_intersect(&clip, &t->clip_area, &t->area)) return;
+    const int32_t w = lv_area_get_width(&clip);
+    const bool gouraud = m->colors != nullptr;
+
+    // Scratch: triangles, sort order, active list, coverage, color sums, mask, row colors
+    const size_t n = m->tri_cnt;
+    size_t bytes = n * sizeof(detail::Tri) + 2 * n * sizeof(uint32_t) + w * (sizeof(uint16_t) + 1);
+    if (gouraud) bytes += w * (4 * sizeof(float) + sizeof(lv_color32_t));
+    auto* mem = static_cast<uint8_t*>(lv_malloc(bytes));
+    if (!mem) return;
+    auto* tris = reinterpret_cast<detail::Tri*>(mem);
+    auto* order = reinterpret_cast<uint32_t*>(tris + n);
+    uint32_t* active = order + n;
+    auto* sums = reinterpret_cast<float*>(active + n);
+    auto* row_colors = reinterpret_cast<lv_color32_t*>(gouraud ? sums + 4 * w : sums);
+    auto* cov = reinterpret_cast<uint16_t*>(gouraud ? reinterpret_cast<uint8_t*>(row_colors + w)
+                                                    : reinterpret_cast<uint8_t*>(sums));
+    auto* mask = reinterpret_cast<uint8_t*>(cov + w);
+
+    lv_memzero(sums, static_cast<size_t>(mem + bytes - reinterpret_cast<uint8_t*>(sums)));
+
+    uint32_t cnt = 0;
+    for (uint32_t i = 0; i < n; ++i) {
+        if (!detail::setup(tris[cnt], *m, i)) continue;
+        if (tris[cnt].row2 < clip.y1 || tris[cnt].row1 > clip.y2) continue;
+        order[cnt] = cnt;
+        ++cnt;
+    }
+    std::sort(order, order + cnt, [tris](uint32_t a, uint32_t b) { return tris[a].row1 < tris[b].row1; });
+
+    lv_draw_sw_blend_dsc_t bd;
+    lv_memzero(&bd, sizeof(bd));
+    bd.opa = m->opa;
+    bd.blend_mode = LV_BLEND_MODE_NORMAL;
+    bd.mask_res = LV_DRAW_SW_MASK_RES_CHANGED;
+    bd.color = m->color;
+
+    uint32_t next = 0;
+    uint32_t na = 0;
+    for (int32_t y = clip.y1; y <= clip.y2; ++y) {
+        while (next < cnt && tris[order[next]].row1 <= y) active[na++] = order[next++];
+        // Drop finished triangles
+        uint32_t keep = 0;
+        for (uint32_t k = 0; k < na; ++k) {
+            if (tris[active[k]].row2 >= y) active[keep++] = active[k];
+        }
+        na = keep;
+        if (na == 0) {
+            if (next >= cnt) break;
+            continue;
+        }
+
+        int32_t lo = w;
+        int32_t hi = -1;
+        for (uint32_t k = 0; k < na; ++k) {
+            const detail::Tri& tr = tris[active[k]];
+            for (int s = 0; s < 4; ++s) {
+                const float ys = static_cast<float>(y) + (static_cast<float>(s) + 0.5f) * 0.25f;
+                float xl, xr;
+                if (!detail::span_at(tr, ys, xl, xr)) continue;
+                xl = std::max(xl, static_cast<float>(clip.x1)) - static_cast<float>(clip.x1);
+                xr = std::min(xr, static_cast<float>(clip.x2 + 1)) - static_cast<float>(clip.x1);
+                if (xr <= xl) continue;
+                const int32_t il = static_cast<int32_t>(xl);
+                const int32_t ir = std::min(static_cast<int32_t>(xr), w - 1);
+                lo = std::min(lo, il);
+                hi = std::max(hi, ir);
+                for (int32_t i = il; i <= ir; ++i) {
+                    const float a = std::max(xl, static_cast<float>(i));
+                    const float b = std::min(xr, static_cast<float>(i + 1));
+                    if (b <= a) continue;
+                    const float c = (b - a) * 64.0f;
+                    cov[i] = static_cast<uint16_t>(cov[i] + static_cast<uint16_t>(c + 0.5f));
+                    if (gouraud) {
+                        const float px = static_cast<float>(clip.x1 + i) + 0.5f;
+                        for (int ch = 0; ch < 4; ++ch) {
+                            sums[4 * i + ch] += c * (tr.c0[ch] + tr.dx[ch] * px + tr.dy[ch] * ys);
+                        }
+                    }
+                }
+            }
+        }
+        if (hi < lo) continue;
+
+        for (int32_t i = lo; i <= hi; ++i) {
+            const uint32_t c = cov[i];
+            mask[i] = static_cast<uint8_t>(c > 255 ? 255 : c);
+            if (gouraud) {
+                const float inv = c ? 1.0f / static_cast<float>(c) : 0.0f;
+                auto ch = [&](int k) {
+                    const float v = sums[4 * i + k] * inv;
+                    return static_cast<uint8_t>(v < 0.0f ? 0.0f : v > 255.0f ? 255.0f : v + 0.5f);
+                };
+                row_colors[i] = {ch(0), ch(1), ch(2), ch(3)};
+            }
+        }
+        const lv_area_t row{clip.x1 + lo, y, clip.x1 + hi, y};
+        bd.blend_area = &row;
+        bd.mask_area = &row;
+        bd.mask_buf = mask + lo;
+        if (gouraud) {
+            bd.src_buf = row_colors + lo;
+            bd.src_area = &row;
+            bd.src_stride = static_cast<uint32_t>(lv_area_get_width(&row)) * sizeof(lv_color32_t);
+            bd.src_color_format = LV_COLOR_FORMAT_ARGB8888;
+        }
+        detail::blend_row(t, u, bd);
+        ++detail::stats().rows;
+        std::fill(cov + lo, cov + hi + 1, uint16_t{0});    // rows only touch [lo, hi]
+        if (gouraud) std::fill(sums + 4 * lo, sums + 4 * (hi + 1), 0.0f);
+    }
+    lv_free(mem);
+}
+
+/**
+ * @brief Draw unit rasterizing mesh tasks in software (installed on first use)
+ *
+ * Bids 1, so hardware units bidding 0 for mesh tasks take precedence.
+ */
+class MeshUnit : public DrawUnit<MeshUnit> {
+public:
+    static constexpr uint8_t unit_id = 61;
+    static constexpr const char* unit_name = "mesh";
+    static constexpr DrawUnitCap accelerates[] = {{LV_DRAW_TASK_TYPE_FILL, 1}};
+
+    bool supports(DrawTaskView t) const noexcept { return from_task(t) != nullptr; }
+
+    void draw(DrawTaskView t, lv_layer_t*) noexcept { sw_draw(t, unit()); }
+
+    /// The shared unit (never destroyed: LVGL owns its lv_draw_unit_t)
+    [[nodiscard]] static MeshUnit& instance() noexcept {
+        alignas(MeshUnit) static unsigned char storage[sizeof(MeshUnit)];
+        static MeshUnit* unit = new (storage) MeshUnit();
+        return *unit;
+    }
+};
+
+[[nodiscard]] inline Stats stats() noexcept { return detail::stats(); }
+
+inline void reset_stats() noexcept { detail::stats() = Stats{}; }
+
+namespace detail {
+
+/// Displays FrameArena::instance() has been attached to for meshes
+[[nodiscard]] inline bool arena_ready() noexcept {
+    static lv_display_t* attached[4] = {};
+    lv_display_t* disp = lv_refr_get_disp_refreshing();
+    if (!disp) disp = lv_display_get_default();
+    if (!disp) return false;
+    for (lv_display_t*& d : attached) {
+        if (d == disp) return true;
+        if (!d) {
+            FrameArena::instance().attach(disp);
+            d = disp;
+            return true;
+        }
+    }
+    return true;    // table full: the arena is attached to other displays and still reset
+}
+
+/// Queue `m` (in the arena) as one carrier task covering `xy`
+[[nodiscard]] inline bool queue(lv_layer_t* layer, Mesh* m, uint32_t vert_cnt) noexcept {
+    MeshUnit& unit = MeshUnit::instance();
+    if (!unit.install()) return false;
+    float x1 = m->xy[0], y1 = m->xy[1], x2 = x1, y2 = y1;
+    for (uint32_t v = 1; v < vert_cnt; ++v) {
+        x1 = std::min(x1, m->xy[2 * v]);
+        x2 = std::max(x2, m->xy[2 * v]);
+        y1 = std::min(y1, m->xy[2 * v + 1]);
+        y2 = std::max(y2, m->xy[2 * v + 1]);
+    }
+    const lv_area_t bounds{static_cast<int32_t>(std::floor(x1)), static_cast<int32_t>(std::floor(y1)),
+                           static_cast<int32_t>(std::ceil(x2)), static_cast<int32_t>(std::ceil(y2))};
+    lv_area_t visible;
+    if (!lv_area_intersect(&visible, &bounds, &layer->_clip_area)) return true;
+
+    lv_draw_fill_dsc_t fill;
+    lv_draw_fill_dsc_init(&fill);
+    fill.base.layer = layer;
+    fill.base.user_data = m;
+    fill.opa = LV_OPA_TRANSP;
+    fill.radius = carrier_radius;
+#if LV_VERSION_AT_LEAST(9, 3, 0)
+    lv_draw_task_t* t = lv_draw_add_task(layer, &bounds, LV_DRAW_TASK_TYPE_FILL);
+    lv_memcpy(t->draw_dsc, &fill, sizeof(fill));
+#else
+    lv_draw_task_t* t = lv_draw_add_task(layer, &bounds);
+    t->draw_dsc = lv_malloc(sizeof(fill));
+    lv_memcpy(t->draw_dsc, &fill, sizeof(fill));
+    t->type = LV_DRAW_TASK_TYPE_FILL;
+#endif
+    lv_draw_finalize_task_creation(layer, t);
+    ++stats().meshes;
+    stats().triangles += m->tri_cnt;
+    return true;
+}
+
+/// Copy vertices into the arena as floats
+[[nodiscard]] inline float* copy_xy(const lv_point_precise_t* pts, uint32_t n) noexcept {
+    float* xy = FrameArena::instance().make_array<float>(2 * static_cast<size_t>(n));
+    if (!xy) return nullptr;
+    for (uint32_t i = 0; i < n; ++i) {
+        xy[2 * i] = static_cast<float>(pts[i].x);
+        xy[2 * i + 1] = static_cast<float>(pts[i].y);
+    }
+    return xy;
+}
+
+[[nodiscard]] inline Mesh* make_mesh(const lv_point_precise_t* vertices, uint32_t vert_cnt,
+                                     const uint16_t* indices, uint32_t index_cnt,
+                                     const lv_color32_t* colors, lv_color_t color, lv_opa_t opa) noexcept {
+    if (!arena_ready()) return nullptr;
+    FrameArena& arena = FrameArena::instance();
+    const uint32_t idx_cnt = indices ? index_cnt - index_cnt % 3 : vert_cnt - vert_cnt % 3;
+    Mesh* m = arena.make<Mesh>();
+    float* xy = copy_xy(vertices, vert_cnt);
+    uint32_t* idx = arena.make_array<uint32_t>(idx_cnt);
+    lv_color32_t* cols = colors ? arena.make_array<lv_color32_t>(vert_cnt) : nullptr;
+    if (!m || !xy || !idx || (colors && !cols)) return nullptr;
+    for (uint32_t i = 0; i < idx_cnt; ++i) {
+        idx[i] = indices ? indices[i] : i;
+        if (idx[i] >= vert_cnt) return nullptr;
+    }
+    if (cols) std::memcpy(cols, colors, vert_cnt * sizeof(lv_color32_t));
+    *m = Mesh{xy, idx, cols, idx_cnt / 3, color, opa};
+    return m;
+}
+
+/// Per-primitive fallback: one lv_draw_triangle() per triangle
+inline void triangles_fallback(lv_layer_t* layer, const lv_point_precise_t* v, uint32_t vert_cnt,
+                               const uint16_t* indices, uint32_t index_cnt, const lv_color32_t* colors,
+                               lv_color_t color, lv_opa_t opa) noexcept {
+    ++stats().fallbacks;
+    const uint32_t cnt = indices ? index_cnt / 3 : vert_cnt / 3;
+    TriangleDsc dsc;
+    dsc.opa(opa);
+    for (uint32_t i = 0; i < cnt; ++i) {
+        uint32_t k[3];
+        for (int j = 0; j < 3; ++j) k[j] = indices ? indices[3 * i + j] : 3 * i + j;
+        if (k[0] >= vert_cnt || k[1] >= vert_cnt || k[2] >= vert_cnt) continue;
+        dsc.points(v[k[0]].x, v[k[0]].y, v[k[1]].x, v[k[1]].y, v[k[2]].x, v[k[2]].y);
+        if (colors) {
+            const lv_color32_t& c = colors[k[0]];
+            dsc.color(lv_color_make(c.red, c.green, c.blue));
+        } else {
+            dsc.color(color);
+        }
+        lv_draw_triangle(layer, dsc.get());
+    }
+}
+
+} // namespace detail
+
+} // namespace mesh
+
+namespace draw {
+
+/**
+ * @brief Draw a triangle mesh with per-vertex colors as one draw task
+ *
+ * @param indices 3 per triangle into `vertices`; nullptr: consecutive triples
+ * @param colors  one per vertex (alpha included), interpolated across triangles
+ */
+inline void triangles(lv_layer_t* layer, const lv_point_precise_t* vertices, uint32_t vert_cnt,
+                      const uint16_t* indices, uint32_t index_cnt, const lv_color32_t* colors,
+                      lv_opa_t opa = LV_OPA_COVER) noexcept {
+    if (!vertices || vert_cnt < 3 || opa <= LV_OPA_MIN) return;
+    mesh::Mesh* m = mesh::detail::make_mesh(vertices, vert_cnt, indices, index_cnt, colors, lv_color_black(), opa);
+    if (!m || !mesh::detail::queue(layer, m, vert_cnt)) {
+        mesh::detail::triangles_fallback(layer, vertices, vert_cnt, indices, index_cnt, colors,
+                                         lv_color_black(), opa);
+    }
+}
+
+/// Single-color mesh as one draw task
+inline void triangles(lv_layer_t* layer, const lv_point_precise_t* vertices, uint32_t vert_cnt,
+                      const uint16_t* indices, uint32_t index_cnt, lv_color_t color,
+                      lv_opa_t opa = LV_OPA_COVER) noexcept {
+    if (!vertices || vert_cnt < 3 || opa <= LV_OPA_MIN) return;
+    mesh::Mesh* m = mesh::detail::make_mesh(vertices, vert_cnt, indices, index_cnt, nullptr, color, opa);
+    if (!m || !mesh::detail::queue(layer, m, vert_cnt)) {
+        mesh::detail::triangles_fallback(layer, vertices, vert_cnt, indices, index_cnt, nullptr, color, opa);
+    }
+}
+
+/**
+ * @brief Draw `n` connected points with `dsc`'s width, color and caps as one draw task
+ *
+ * Joins are beveled; round_start / round_end add round caps. The points in
+ * `dsc` are ignored. Dashed lines fall back to one lv_draw_line() per segment.
+ */
+inline void polyline(lv_layer_t* layer, const lv_point_precise_t* points, uint32_t n, const LineDsc& dsc) noexcept {
+    const lv_draw_line_dsc_t& d = *dsc.get();
+    if (!points || n < 2 || d.width <= 0 || d.opa <= LV_OPA_MIN) return;
+
+    constexpr uint32_t cap_tris = 8;
+    const uint32_t segs = n - 1;
+    const uint32_t tri_cnt = 2 * segs + 2 * (segs - 1) + (d.round_start ? cap_tris : 0) + (d.round_end ? cap_tris : 0);
+    const bool dashed = d.dash_width > 0 && d.dash_gap > 0;
+    float* xy = nullptr;
+    mesh::Mesh* m = nullptr;
+    uint32_t* idx = nullptr;
+    if (!dashed && mesh::detail::arena_ready()) {
+        FrameArena& arena = FrameArena::instance();
+        m = arena.make<mesh::Mesh>();
+        xy = arena.make_array<float>(6 * static_cast<size_t>(tri_cnt));
+        idx = arena.make_array<uint32_t>(3 * static_cast<size_t>(tri_cnt));
+    }
+    if (!m || !xy || !idx) {
+        ++mesh::detail::stats().fallbacks;
+        LineDsc seg = dsc;
+        for (uint32_t i = 0; i < segs; ++i) {
+            seg.get()->p1 = points[i];
+            seg.get()->p2 = points[i + 1];
+            lv_draw_line(layer, seg.get());
+        }
+        return;
+    }
+
+    const float hw = static_cast<float>(d.width) / 2.0f;
+    uint32_t v = 0;
+    auto tri = [&](float ax, float ay, float bx, float by, float cx, float cy) {
+        xy[2 * v] = ax; xy[2 * v + 1] = ay; ++v;
+        xy[2 * v] = bx; xy[2 * v + 1] = by; ++v;
+        xy[2 * v] = cx; xy[2 * v + 1] = cy; ++v;
+    };
+    auto normal = [&](uint32_t i, float& nx, float& ny) {
+        const float dx = static_cast<float>(points[i + 1].x - points[i].x);
+        const float dy = static_cast<float>(points[i + 1].y - points[i].y);
+        const float len = std::sqrt(dx * dx + dy * dy);
+        nx = len > 0.0f ? -dy / len * hw : 0.0f;
+        ny = len > 0.0f ? dx / len * hw : 0.0f;
+    };
+    auto cap = [&](float cx, float cy, float nx, float ny) {
+        // Half disc on the side opposite to the segment: fan from +n through -d to -n
+        const float a0 = std::atan2(ny, nx);
+        for (uint32_t k = 0; k < cap_tris; ++k) {
+            const float a = a0 + static_cast<float>(k) * 3.14159265f / cap_tris;
+            const float b = a0 + static_cast<float>(k + 1) * 3.14159265f / cap_tris;
+            tri(cx, cy, cx + hw * std::cos(a), cy + hw * std::sin(a), cx + hw * std::cos(b), cy + hw * std::sin(b));
+        }
+    };
+
+    float pnx = 0.0f, pny = 0.0f;
+    for (uint32_t i = 0; i < segs; ++i) {
+        float nx, ny;
+        normal(i, nx, ny);
+        const float ax = static_cast<float>(points[i].x), ay = static_cast<float>(points[i].y);
+        const float bx = static_cast<float>(points[i + 1].x), by = static_cast<float>(points[i + 1].y);
+        tri(ax + nx, ay + ny, ax - nx, ay - ny, bx + nx, by + ny);
+        tri(ax - nx, ay - ny, bx - nx, by - ny, bx + nx, by + ny);
+        if (i > 0) {
+            // Bevel: close the wedge between the previous segment's end and this one's start
+            tri(ax, ay, ax + pnx, ay + pny, ax + nx, ay + ny);
+            tri(ax, ay, ax - pnx, ay - pny, ax - nx, ay - ny);
+        }
+        if (i == 0 && d.round_start) cap(ax, ay, nx, ny);
+        if (i == segs - 1 && d.round_end) cap(bx, by, -nx, -ny);
+        pnx = nx;
+        pny = ny;
+    }
+    for (uint32_t i = 0; i < v; ++i) idx[i] = i;
+    *m = mesh::Mesh{xy, idx, nullptr, v / 3, d.color, d.opa};
+    if (!mesh::detail::queue(layer, m, v)) {
+        ++mesh::detail::stats().fallbacks;
+        LineDsc seg = dsc;
+        for (uint32_t i = 0; i < segs; ++i) {
+            seg.get()->p1 = points[i];
+            seg.get()->p2 = points[i + 1];
+            lv_draw_line(layer, seg.get());
+        }
+    }
+}
+
+} // namespace draw
+
+} // namespace lv
@@ -3,6 +3,9 @@
 /**
  * @file draw_rect.hpp
  * @brief Wrappers for LVGL rectangle drawing (fill, border, shadow, rect)
+ *
+ * For many shadows with the same radius and blur (cards), shadow_cache.hpp
+ * draws them from cached 9-slice bitmaps instead of blurring each one.
  */
 
 #include <lvgl.h>
@@ -0,0 +1,237 @@
+#pragma once
+
+/**
+ * @file draw_unit.hpp
+ * @brief CRTP base for custom LVGL draw units (blitters, GPUs, SIMD paths)
+ *
+ * A draw unit is one of LVGL's renderers. For every draw task each unit's
+ * evaluate_cb bids a preference score (lower wins, the software renderer
+ * bids 100) and the winner later picks the task up in dispatch_cb.
+ * DrawUnit<Derived> generates those callbacks at compile time from a table
+ * of accelerated task types and the Derived class' draw() function.
+ *
+ * Usage:
+ * @code
+ * class Blitter : public lv::DrawUnit<Blitter> {
+ * public:
+ *     static constexpr uint8_t unit_id = 40;           // unique among draw units
+ *     static constexpr const char* unit_name = "blitter";
+ *     static constexpr lv::DrawUnitCap accelerates[] = {
+ *         {LV_DRAW_TASK_TYPE_FILL, 20},
+ *         {LV_DRAW_TASK_TYPE_IMAGE, 60},
+ *     };
+ *
+ *     // Optional: refuse tasks the hardware cannot do
+ *     bool supports(lv::DrawTaskView t) const {
+ *         return t.type() != LV_DRAW_TASK_TYPE_FILL || t.fill_dsc()->radius == 0;
+ *     }
+ *
+ *     // Draw synchronously (void), or start the job and return false,
+ *     // then call finish() from the completion interrupt/thread
+ *     void draw(lv::DrawTaskView t, lv_layer_t* layer) { ... }
+ * };
+ *
+ * static Blitter blitter;
+ * blitter.install();     // after lv_init()
+ * @endcode
+ *
+ * Not included by lv.hpp or draw.hpp: LVGL keeps lv_draw_unit_t and the
+ * draw task fields a unit bids on and dispatches in its private headers.
+ * Checked against LVGL 9.4 (see LV_CPP_INTERNALS_OK).
+ *
+ * Heap allocation: one small lv_draw_unit_t per installed unit (owned by LVGL)
+ */
+
+#include <lvgl.h>
+#include "../core/version.hpp"
+
+#if !LV_CPP_INTERNALS_OK
+#error "draw_unit.hpp reads LVGL internals checked against LVGL 9.4; see LV_CPP_INTERNALS_OK"
+#endif
+
+#include <src/draw/lv_draw_private.h>  // lv_draw_unit_t and lv_draw_task_t fields
+#include <concepts>
+#include <cstdint>
+#include <type_traits>
+#include "draw_task.hpp"
+
+namespace lv {
+
+/// A task type a draw unit accelerates and its bid (0-99 to beat the software renderer)
+struct DrawUnitCap {
+    lv_draw_task_type_t type;
+    uint8_t score;
+};
+
+namespace detail {
+
+/// What LVGL allocates for the unit: the C unit followed by the C++ owner
+struct DrawUnitHolder {
+    lv_draw_unit_t base;
+    void* self;    ///< nullptr once the C++ object is gone
+};
+
+#if LV_VERSION_AT_LEAST(9, 3, 0)
+inline constexpr lv_draw_task_state_t draw_task_state_done = LV_DRAW_TASK_STATE_FINISHED;
+#else
+inline constexpr lv_draw_task_state_t draw_task_state_done = LV_DRAW_TASK_STATE_READY;
+#endif
+
+} // namespace detail
+
+/**
+ * @brief CRTP base class registering Derived as an LVGL draw unit
+ *
+ * Derived provides:
+ * - `static constexpr uint8_t unit_id`: id tasks are assigned to
+ * - `static constexpr DrawUnitCap accelerates[]`: types and bids
+ * - `draw(DrawTaskView, lv_layer_t*)`: returns void (done) or bool
+ *   (false: still running, finish() is called later)
+ *
+ * Optional: `unit_name`, `bool supports(DrawTaskView)` to refine the bid,
+ * and `void wait()` blocking until the hardware is idle (wait_for_finish_cb).
+ *
+ * LVGL cannot unregister a draw unit; after the Derived object is
+ * destroyed its unit stays registered but bids on nothing.
+ *
+ * One task is in flight at a time. Non-copyable, non-movable: LVGL keeps a
+ * pointer to the object.
+ */
+template<typename Derived>
+class DrawUnit {
+    detail::DrawUnitHolder* m_unit = nullptr;
+    lv_draw_task_t* m_task = nullptr;   ///< Task being drawn (nullptr: idle)
+    uint32_t m_claimed = 0;
+    uint32_t m_drawn = 0;
+
+    [[nodiscard]] static Derived* self(lv_draw_unit_t* u) noexcept {
+        return static_cast<Derived*>(reinterpret_cast<detail::DrawUnitHolder*>(u)->self);
+    }
+
+    static int32_t evaluate_cb(lv_draw_unit_t* u, lv_draw_task_t* t) {
+        Derived* d = self(u);
+        if (!d) return 0;
+        for (const DrawUnitCap& cap : Derived::accelerates) {
+            if (cap.type != t->type) continue;
+            if (cap.score >= t->preference_score) return 0;
+            if constexpr (requires { d->supports(DrawTaskView(t)); }) {
+                if (!d->supports(DrawTaskView(t))) return 0;
+            }
+            t->preference_score = cap.score;
+            t->preferred_draw_unit_id = Derived::unit_id;
+            ++static_cast<DrawUnit&>(*d).m_claimed;
+            return 0;
+        }
+        return 0;
+    }
+
+    static int32_t dispatch_cb(lv_draw_unit_t* u, lv_layer_t* layer) {
+        Derived* d = self(u);
+        if (!d) return LV_DRAW_UNIT_IDLE;
+        DrawUnit& base = *d;
+        if (base.m_task) return 0;    // an asynchronous task is still running
+
+        lv_draw_task_t* t = lv_draw_get_available_task(layer, nullptr, Derived::unit_id);
+        if (!t) return LV_DRAW_UNIT_IDLE;
+        if (!lv_draw_layer_alloc_buf(layer)) return LV_DRAW_UNIT_IDLE;
+
+        t->state = LV_DRAW_TASK_STATE_IN_PROGRESS;
+#if LV_VERSION_AT_LEAST(9, 3, 0)
+        t->draw_unit = u;
+#else
+        u->target_layer = layer;
+        u->clip_area = &t->clip_area;
+#endif
+        base.m_task = t;
+        if constexpr (std::is_same_v<decltype(d->draw(DrawTaskView(t), layer)), bool>) {
+            if (!d->draw(DrawTaskView(t), layer)) return 1;
+        } else {
+            d->draw(DrawTaskView(t), layer);
+        }
+        base.finish();
+        return 1;
+    }
+
+    static int32_t wait_for_finish_cb(lv_draw_unit_t* u) {
+        if (Derived* d = self(u)) d->wait();
+        return 0;
+    }
+
+    static int32_t delete_cb(lv_draw_unit_t* u) noexcept {
+        if (Derived* d = self(u)) static_cast<DrawUnit&>(*d).m_unit = nullptr;
+        return 0;
+    }
+
+protected:
+    DrawUnit() noexcept = default;
+
+    ~DrawUnit() {
+        if (m_unit) m_unit->self = nullptr;
+    }
+
+public:
+    DrawUnit(const DrawUnit&) = delete;
+    DrawUnit& operator=(const DrawUnit&) = delete;
+
+    /**
+     * @brief Register the unit with LVGL (once, after lv_init())
+     * @return false if LVGL could not allocate the unit
+     */
+    bool install() noexcept {
+        static_assert(requires { { Derived::unit_id } -> std::convertible_to<uint8_t>; },
+            "DrawUnit: Derived must declare static constexpr uint8_t unit_id");
+        static_assert(requires { Derived::accelerates[0].score; },
+            "DrawUnit: Derived must declare static constexpr DrawUnitCap accelerates[]");
+        if (m_unit) return true;
+
+        auto* holder = static_cast<detail::DrawUnitHolder*>(lv_draw_create_unit(sizeof(detail::DrawUnitHolder)));
+        if (!holder) return false;
+        holder->self = static_cast<Derived*>(this);
+        if constexpr (requires { Derived::unit_name; }) {
+            holder->base.name = Derived::unit_name;
+        } else {
+            holder->base.name = "CPP";
+        }
+        holder->base.evaluate_cb = &DrawUnit::evaluate_cb;
+        holder->base.dispatch_cb = &DrawUnit::dispatch_cb;
+        holder->base.delete_cb = &DrawUnit::delete_cb;
+        if constexpr (requires(Derived& d) { d.wait(); }) {
+            holder->base.wait_for_finish_cb = &DrawUnit::wait_for_finish_cb;
+        }
+        m_unit = holder;
+        return true;
+    }
+
+    /**
+     * @brief Mark the current task done and let LVGL dispatch the next one
+     *
+     * Called automatically after a synchronous draw(). Asynchronous units
+     * call it from their completion interrupt or thread.
+     */
+    void finish() noexcept {
+        if (!m_task) return;
+        m_task->state = detail::draw_task_state_done;
+        m_task = nullptr;
+        ++m_drawn;
+        lv_draw_dispatch_request();
+    }
+
+    [[nodiscard]] bool installed() const noexcept { return m_unit != nullptr; }
+
+    /// A task is being drawn
+    [[nodiscard]] bool busy() const noexcept { return m_task != nullptr; }
+
+    /// Task being drawn (empty view when idle)
+    [[nodiscard]] DrawTaskView current_task() const noexcept { return DrawTaskView(m_task); }
+
+    /// Underlying LVGL draw unit (nullptr before install())
+    [[nodiscard]] lv_draw_unit_t* unit() const noexcept { return m_unit ? &m_unit->base : nullptr; }
+
+    /// Tasks this unit won in evaluation
+    [[nodiscard]] uint32_t claimed() const noexcept { return m_claimed; }
+
+    /// Tasks this unit finished
+    [[nodiscard]] uint32_t drawn() const noexcept { return m_drawn; }
+};
+
+} // namespace lv
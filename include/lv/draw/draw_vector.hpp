@@ -25,19 +25,45 @@
  *    .add_path(path)
  *    .draw();
  * @endcode
+ *
+ * Static vector art should not be rebuilt in every draw event. Build it
+ * once into a SharedPath (immutable, reference-counted) and add that
+ * instead:
+ *
+ * @code
+ * static lv::SharedPath gauge = lv::SharedPath(std::move(
+ *     lv::VectorPath(LV_VECTOR_PATH_QUALITY_HIGH).arc(60, 60, 50, 135, 270)));
+ *
+ * // LV_EVENT_DRAW_MAIN
+ * lv::VectorDsc dsc(layer);
+ * dsc.scale(zoom).stroke_width(6).add_path(gauge).draw();
+ * @endcode
+ *
+ * path_cache.hpp (opt-in) additionally draws shared paths with their
+ * curves flattened per transform scale.
+ *
+ * Heap allocation: NONE in the wrapper (fixed slot table; path storage
+ * is LVGL's)
  */
 
 #include <lvgl.h>
+#include <cstdint>
 
 #if LV_USE_VECTOR_GRAPHIC
 
 #include <src/draw/lv_draw_vector.h>
 
+#ifndef LV_CPP_SHARED_PATHS
+/// SharedPath slots (distinct immutable paths alive at once)
+#define LV_CPP_SHARED_PATHS 16
+#endif
+
 namespace lv {
 
 // ==================== Forward Declarations ====================
 
 class VectorPath;
+class SharedPath;
 class VectorDsc;
 
 // ==================== Helper Types ====================
@@ -106,6 +132,13 @@ public:
     [[nodiscard]] bool valid() const noexcept { return m_path != nullptr; }
     explicit operator bool() const noexcept { return valid(); }
 
+    /// Give up ownership; the caller must lv_vector_path_delete() the result
+    [[nodiscard]] lv_vector_path_t* release() noexcept {
+        lv_vector_path_t* p = m_path;
+        m_path = nullptr;
+        return p;
+    }
+
     // ==================== Path Operations ====================
 
     /// Begin a new sub-path at point
@@ -241,6 +274,124 @@ public:
     }
 };
 
+// ==================== SharedPath ====================
+
+namespace detail {
+
+inline constexpr uint16_t NO_PATH = 0xFFFF;
+
+struct SharedSlot {
+    lv_vector_path_t* path = nullptr;
+    uint16_t refs = 0;
+};
+
+/// Flattened copies of shared paths; set up by path_cache::install() (path_cache.hpp)
+struct PathCacheHooks {
+    const lv_vector_path_t* (*flattened)(uint16_t slot, const lv_matrix_t& m) = nullptr;
+    void (*release)(uint16_t slot) = nullptr;   ///< Drop the copies of a path about to be deleted
+};
+
+struct SharedPaths {
+    SharedSlot slots[LV_CPP_SHARED_PATHS];
+    uint32_t live = 0;
+    PathCacheHooks hooks;
+};
+
+[[nodiscard]] inline SharedPaths& shared_paths() noexcept {
+    static SharedPaths t;
+    return t;
+}
+
+inline void release_shared(uint16_t slot) noexcept {
+    if (slot == NO_PATH) return;
+    SharedPaths& t = shared_paths();
+    SharedSlot& s = t.slots[slot];
+    if (--s.refs) return;
+    if (t.hooks.release) t.hooks.release(slot);
+    lv_vector_path_delete(s.path);
+    s.path = nullptr;
+    --t.live;
+}
+
+} // namespace detail
+
+/**
+ * @brief Immutable, reference-counted vector path
+ *
+ * Built once from a VectorPath (which it takes over) and shared by copy.
+ * The path is deleted, and its flattened copies dropped, with the last
+ * handle. Each distinct path takes one of LV_CPP_SHARED_PATHS slots; when
+ * none is free the handle is empty and the path is deleted (warning
+ * logged). Not thread-safe: use it from the LVGL thread.
+ */
+class SharedPath {
+    uint16_t m_slot = detail::NO_PATH;
+
+    friend class VectorDsc;
+
+public:
+    SharedPath() noexcept = default;
+
+    /// Take over `path`
+    explicit SharedPath(VectorPath&& path) noexcept {
+        lv_vector_path_t* p = path.release();
+        if (!p) return;
+        detail::SharedPaths& t = detail::shared_paths();
+        for (uint16_t i = 0; i < LV_CPP_SHARED_PATHS; ++i) {
+            if (t.slots[i].path) continue;
+            t.slots[i] = detail::SharedSlot{p, 1};
+            ++t.live;
+            m_slot = i;
+            return;
+        }
+        LV_LOG_WARN("SharedPath: all %d slots in use", LV_CPP_SHARED_PATHS);
+        lv_vector_path_delete(p);
+    }
+
+    SharedPath(const SharedPath& other) noexcept : m_slot(other.m_slot) {
+        if (m_slot != detail::NO_PATH) ++detail::shared_paths().slots[m_slot].refs;
+    }
+
+    SharedPath& operator=(const SharedPath& other) noexcept {
+        if (other.m_slot != detail::NO_PATH) ++detail::shared_paths().slots[other.m_slot].refs;
+        detail::release_shared(m_slot);
+        m_slot = other.m_slot;
+        return *this;
+    }
+
+    SharedPath(SharedPath&& other) noexcept : m_slot(other.m_slot) { other.m_slot = detail::NO_PATH; }
+
+    SharedPath& operator=(SharedPath&& other) noexcept {
+        if (this != &other) {
+            detail::release_shared(m_slot);
+            m_slot = other.m_slot;
+            other.m_slot = detail::NO_PATH;
+        }
+        return *this;
+    }
+
+    ~SharedPath() { detail::release_shared(m_slot); }
+
+    [[nodiscard]] bool valid() const noexcept { return m_slot != detail::NO_PATH; }
+    explicit operator bool() const noexcept { return valid(); }
+
+    /// The path as built (curves not flattened); nullptr if empty
+    [[nodiscard]] const lv_vector_path_t* get() const noexcept {
+        return valid() ? detail::shared_paths().slots[m_slot].path : nullptr;
+    }
+
+    /// Handles sharing this path (0 if empty)
+    [[nodiscard]] uint16_t use_count() const noexcept {
+        return valid() ? detail::shared_paths().slots[m_slot].refs : 0;
+    }
+
+    [[nodiscard]] lv_area_t bounding_box() const noexcept {
+        lv_area_t area{};
+        if (valid()) lv_vector_path_get_bounding(detail::shared_paths().slots[m_slot].path, &area);
+        return area;
+    }
+};
+
 // ==================== VectorDsc ====================
 
 /**
@@ -276,18 +427,21 @@ public:
  */
 class VectorDsc {
     lv_draw_vector_dsc_t* m_dsc = nullptr;
+    lv_matrix_t m_matrix;   ///< mirror of the current transform, for SharedPath flattening
 
 public:
     /// Create a vector descriptor for a layer
     explicit VectorDsc(lv_layer_t* layer) noexcept
-        : m_dsc(lv_draw_vector_dsc_create(layer)) {}
+        : m_dsc(lv_draw_vector_dsc_create(layer)) {
+        lv_matrix_identity(&m_matrix);
+    }
 
     /// Non-copyable
     VectorDsc(const VectorDsc&) = delete;
     VectorDsc& operator=(const VectorDsc&) = delete;
 
     /// Moveable
-    VectorDsc(VectorDsc&& other) noexcept : m_dsc(other.m_dsc) {
+    VectorDsc(VectorDsc&& other) noexcept : m_dsc(other.m_dsc), m_matrix(other.m_matrix) {
         other.m_dsc = nullptr;
     }
 
@@ -295,6 +449,7 @@ public:
         if (this != &other) {
             if (m_dsc) lv_draw_vector_dsc_delete(m_dsc);
             m_dsc = other.m_dsc;
+            m_matrix = other.m_matrix;
             other.m_dsc = nullptr;
         }
         return *this;
@@ -315,21 +470,27 @@ public:
 
     // ==================== Transform ====================
 
+    /// Current transformation (as set through this wrapper)
+    [[nodiscard]] const lv_matrix_t& matrix() const noexcept { return m_matrix; }
+
     /// Reset transformation to identity matrix
     VectorDsc& identity() noexcept {
         lv_draw_vector_dsc_identity(m_dsc);
+        lv_matrix_identity(&m_matrix);
         return *this;
     }
 
     /// Set custom transformation matrix
     VectorDsc& transform(const lv_matrix_t& matrix) noexcept {
         lv_draw_vector_dsc_set_transform(m_dsc, &matrix);
+        m_matrix = matrix;
         return *this;
     }
 
     /// Scale
     VectorDsc& scale(float sx, float sy) noexcept {
         lv_draw_vector_dsc_scale(m_dsc, sx, sy);
+        lv_matrix_scale(&m_matrix, sx, sy);
         return *this;
     }
 
@@ -340,18 +501,21 @@ public:
     /// Rotate (degrees)
     VectorDsc& rotate(float degrees) noexcept {
         lv_draw_vector_dsc_rotate(m_dsc, degrees);
+        lv_matrix_rotate(&m_matrix, degrees);
         return *this;
     }
 
     /// Translate
     VectorDsc& translate(float tx, float ty) noexcept {
         lv_draw_vector_dsc_translate(m_dsc, tx, ty);
+        lv_matrix_translate(&m_matrix, tx, ty);
         return *this;
     }
 
     /// Skew
     VectorDsc& skew(float sx, float sy) noexcept {
         lv_draw_vector_dsc_skew(m_dsc, sx, sy);
+        lv_matrix_skew(&m_matrix, sx, sy);
         return *this;
     }
 
@@ -522,6 +686,21 @@ public:
         return *this;
     }
 
+    /**
+     * @brief Add a shared path
+     *
+     * With path_cache.hpp installed, the path is added flattened for the
+     * current transform scale (set the transform before adding); LVGL
+     * copies it into the draw task, so eviction later never affects this
+     * draw.
+     */
+    VectorDsc& add_path(const SharedPath& path) noexcept {
+        if (!path) return *this;
+        const detail::PathCacheHooks& h = detail::shared_paths().hooks;
+        lv_draw_vector_dsc_add_path(m_dsc, h.flattened ? h.flattened(path.m_slot, m_matrix) : path.get());
+        return *this;
+    }
+
     /// Clear a rectangular area with current fill color
     VectorDsc& clear_area(const lv_area_t& rect) noexcept {
         lv_draw_vector_dsc_clear_area(m_dsc, &rect);
@@ -0,0 +1,578 @@
+#pragma once
+
+/**
+ * @file image_codecs.hpp
+ * @brief Built-in QOI and LZ4-banded image decoders
+ *
+ * Two decoders on ImageDecoderBase for assets that are too slow as PNG and
+ * too big as raw .bin:
+ * - QoiDecoder: standard QOI (".qoi"), decoded to ARGB8888 (XRGB8888 for
+ *   3-channel files)
+ * - Lz4ImageDecoder: ".lz4i", an LVGL image header followed by the pixel
+ *   rows in bands of `band_rows`, each band an independent LZ4 block, so
+ *   the pixels land in the display's color format without conversion
+ *
+ * Both accept file paths and C arrays (an lv_image_dsc_t with
+ * header.cf = LV_COLOR_FORMAT_RAW or RAW_ALPHA whose data is the file).
+ * Images up to LV_CPP_IMAGE_CODEC_FULL_MAX decoded bytes are decoded whole
+ * into a DrawBufPool buffer and handed to the image cache. Larger ones are
+ * streamed: get_area() decodes one band of rows at a time into a single
+ * band buffer, so a full-screen background needs a few KiB while drawn.
+ *
+ * @code
+ * lv::register_image_codecs();
+ * lv::Image::create(screen).src("A:/img/wallpaper.lz4i");
+ * @endcode
+ *
+ * scripts/image_codec_convert.py converts generated LVGL C arrays (such as
+ * demos/\*\/generated/image_*.c) into either format.
+ *
+ * Streamed images are decoded from their first band on every draw; keep
+ * them for large, rarely changing areas (backgrounds, photos).
+ *
+ * Heap allocation: decoded output and band buffers from the DrawBufPool;
+ * LV_CPP_IMAGE_CODEC_SESSIONS fixed decode sessions
+ */
+
+#include <lvgl.h>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include "image_decoder.hpp"
+
+#ifndef LV_CPP_IMAGE_CODEC_SESSIONS
+/// Concurrent decode sessions (draw threads decoding at the same time)
+#define LV_CPP_IMAGE_CODEC_SESSIONS 4
+#endif
+
+#ifndef LV_CPP_IMAGE_CODEC_IO
+/// File read buffer per session
+#define LV_CPP_IMAGE_CODEC_IO 256
+#endif
+
+#ifndef LV_CPP_IMAGE_CODEC_FULL_MAX
+/// Decoded size up to which an image is decoded whole and cached; above it is streamed in bands
+#define LV_CPP_IMAGE_CODEC_FULL_MAX (128 * 1024)
+#endif
+
+#ifndef LV_CPP_IMAGE_CODEC_BAND_ROWS
+/// Rows per band when streaming QOI (LZ4 images carry their own band height)
+#define LV_CPP_IMAGE_CODEC_BAND_ROWS 16
+#endif
+
+namespace lv {
+
+namespace codec {
+
+/// ".lz4i" file header, followed by lv_image_header_t and the bands
+struct Lz4ImageHeader {
+    char magic[4];          ///< "LZ4I"
+    uint8_t version;        ///< 1
+    uint8_t reserved;
+    uint16_t band_rows;     ///< Rows per LZ4 block (the last band may be shorter)
+};
+
+inline constexpr uint32_t kQoiHeaderSize = 14;
+inline constexpr uint32_t kLz4HeaderSize = sizeof(Lz4ImageHeader) + sizeof(lv_image_header_t);
+
+static_assert(sizeof(Lz4ImageHeader) == 8, "Lz4ImageHeader must be packed");
+
+} // namespace codec
+
+namespace detail {
+
+/// Sequential byte source over a file or a C array
+struct CodecReader {
+    const uint8_t* mem = nullptr;
+    uint32_t mem_size = 0;
+    uint32_t mem_pos = 0;
+    lv_fs_file_t file;
+    bool is_file = false;
+    uint8_t buf[LV_CPP_IMAGE_CODEC_IO];
+    uint32_t len = 0;
+    uint32_t at = 0;
+
+    [[nodiscard]] bool open(const lv_image_decoder_dsc_t& dsc) noexcept {
+        len = at = 0;
+        mem_pos = 0;
+        if (dsc.src_type == LV_IMAGE_SRC_FILE) {
+            is_file = lv_fs_open(&file, static_cast<const char*>(dsc.src), LV_FS_MODE_RD) == LV_FS_RES_OK;
+            return is_file;
+        }
+        const auto* img = static_cast<const lv_image_dsc_t*>(dsc.src);
+        is_file = false;
+        mem = img->data;
+        mem_size = img->data_size;
+        return mem != nullptr;
+    }
+
+    void close() noexcept {
+        if (is_file) lv_fs_close(&file);
+        is_file = false;
+        mem = nullptr;
+    }
+
+    [[nodiscard]] int get() noexcept {
+        if (!is_file) return mem_pos < mem_size ? mem[mem_pos++] : -1;
+        if (at == len) {
+            at = 0;
+            if (lv_fs_read(&file, buf, sizeof(buf), &len) != LV_FS_RES_OK || len == 0) {
+                len = 0;
+                return -1;
+            }
+        }
+        return buf[at++];
+    }
+
+    [[nodiscard]] bool read(uint8_t* out, uint32_t n) noexcept {
+        if (!is_file) {
+            if (n > mem_size - mem_pos) return false;
+            std::memcpy(out, mem + mem_pos, n);
+            mem_pos += n;
+            return true;
+        }
+        while (n > 0) {
+            if (at == len) {
+                // Large reads bypass the buffer
+                if (n >= sizeof(buf)) {
+                    uint32_t br = 0;
+                    return lv_fs_read(&file, out, n, &br) == LV_FS_RES_OK && br == n;
+                }
+                at = 0;
+                if (lv_fs_read(&file, buf, sizeof(buf), &len) != LV_FS_RES_OK || len == 0) {
+                    len = 0;
+                    return false;
+                }
+            }
+            uint32_t chunk = len - at;
+            if (chunk > n) chunk = n;
+            std::memcpy(out, buf + at, chunk);
+            at += chunk;
+            out += chunk;
+            n -= chunk;
+        }
+        return true;
+    }
+
+    [[nodiscard]] bool seek(uint32_t pos) noexcept {
+        if (!is_file) {
+            mem_pos = pos;
+            return pos <= mem_size;
+        }
+        len = at = 0;
+        return lv_fs_seek(&file, pos, LV_FS_SEEK_SET) == LV_FS_RES_OK;
+    }
+
+    [[nodiscard]] bool skip(uint32_t n) noexcept {
+        if (!is_file) return seek(mem_pos + n);
+        if (n <= len - at) {
+            at += n;
+            return true;
+        }
+        n -= len - at;
+        len = at = 0;
+        return lv_fs_seek(&file, n, LV_FS_SEEK_CUR) == LV_FS_RES_OK;
+    }
+};
+
+/// Per-open decoder state, claimed from a fixed pool (draw threads may decode concurrently)
+struct CodecSession {
+    std::atomic_flag busy;
+    CodecReader in;
+    lv_draw_buf_t* band = nullptr;
+    int32_t next_row = 0;       ///< First row the stream will produce next
+    // QOI
+    uint8_t px[4];
+    uint8_t index[64][4];
+    uint32_t run = 0;
+    // LZ4
+    uint32_t band_rows = 0;
+};
+
+[[nodiscard]] inline CodecSession* codec_session_acquire() noexcept {
+    static CodecSession sessions[LV_CPP_IMAGE_CODEC_SESSIONS];
+    for (CodecSession& s : sessions) {
+        if (!s.busy.test_and_set(std::memory_order_acquire)) return &s;
+    }
+    LV_LOG_WARN("image codecs: all sessions busy, raise LV_CPP_IMAGE_CODEC_SESSIONS");
+    return nullptr;
+}
+
+inline void codec_session_release(CodecSession* s) noexcept {
+    s->in.close();
+    if (s->band) lv_draw_buf_destroy(s->band);
+    s->band = nullptr;
+    s->busy.clear(std::memory_order_release);
+}
+
+/// First `n` bytes of a file or RAW C-array source
+[[nodiscard]] inline bool codec_read_prefix(const lv_image_decoder_dsc_t& dsc, uint8_t* out, uint32_t n) noexcept {
+    if (dsc.src_type == LV_IMAGE_SRC_FILE) {
+        lv_fs_file_t f;
+        if (lv_fs_open(&f, static_cast<const char*>(dsc.src), LV_FS_MODE_RD) != LV_FS_RES_OK) return false;
+        uint32_t br = 0;
+        const bool ok = lv_fs_read(&f, out, n, &br) == LV_FS_RES_OK && br == n;
+        lv_fs_close(&f);
+        return ok;
+    }
+    if (dsc.src_type != LV_IMAGE_SRC_VARIABLE) return false;
+    const auto* img = static_cast<const lv_image_dsc_t*>(dsc.src);
+    if (img->header.cf != LV_COLOR_FORMAT_RAW && img->header.cf != LV_COLOR_FORMAT_RAW_ALPHA) return false;
+    if (!img->data || img->data_size < n) return false;
+    std::memcpy(out, img->data, n);
+    return true;
+}
+
+[[nodiscard]] inline uint32_t be32(const uint8_t* p) noexcept {
+    return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | p[3];
+}
+
+/**
+ * @brief Decode one LZ4 block of `csize` input bytes into exactly `cap` bytes
+ *
+ * Back-references stay inside the block's own output, so the input streams
+ * byte by byte from the reader.
+ */
+[[nodiscard]] inline bool lz4_block(CodecReader& in, uint32_t csize, uint8_t* dst, uint32_t cap) noexcept {
+    uint32_t used = 0;
+    uint32_t out = 0;
+    auto next = [&]() -> int {
+        if (used == csize) return -1;
+        ++used;
+        return in.get();
+    };
+    auto length = [&](uint32_t n) -> int64_t {
+        if (n != 15) return n;
+        int b;
+        do {
+            b = next();
+            if (b < 0) return -1;
+            n += static_cast<uint32_t>(b);
+        } while (b == 255);
+        return n;
+    };
+    while (used < csize) {
+        const int token = next();
+        if (token < 0) return false;
+        const int64_t lit = length(static_cast<uint32_t>(token) >> 4);
+        if (lit < 0 || out + lit > cap || used + lit > csize) return false;
+        if (!in.read(dst + out, static_cast<uint32_t>(lit))) return false;
+        used += static_cast<uint32_t>(lit);
+        out += static_cast<uint32_t>(lit);
+        if (used == csize) break;   // the last sequence has literals only
+        const int lo = next();
+        const int hi = next();
+        if (lo < 0 || hi < 0) return false;
+        const uint32_t offset = static_cast<uint32_t>(lo) | (static_cast<uint32_t>(hi) << 8);
+        const int64_t match = length(static_cast<uint32_t>(token) & 15);
+        if (offset == 0 || offset > out || match < 0 || out + match + 4 > cap) return false;
+        const uint8_t* from = dst + out - offset;
+        for (int64_t i = 0; i < match + 4; ++i) dst[out++] = *from++;   // may overlap
+    }
+    return out == cap;
+}
+
+inline void qoi_reset(CodecSession& s) noexcept {
+    std::memset(s.index, 0, sizeof(s.index));
+    s.px[0] = s.px[1] = s.px[2] = 0;
+    s.px[3] = 255;
+    s.run = 0;
+    s.next_row = 0;
+}
+
+/// Advance the QOI stream by one pixel (RGBA in s.px)
+[[nodiscard]] inline bool qoi_next(CodecSession& s) noexcept {
+    if (s.run > 0) {
+        --s.run;
+        return true;
+    }
+    const int b1 = s.in.get();
+    if (b1 < 0) return false;
+    uint8_t* px = s.px;
+    if (b1 == 0xFE || b1 == 0xFF) {
+        if (!s.in.read(px, b1 == 0xFE ? 3 : 4)) return false;
+    } else {
+        switch (b1 & 0xC0) {
+        case 0x00:
+            std::memcpy(px, s.index[b1], 4);
+            return true;   // an index hit is already in the table
+        case 0x40:
+            px[0] = static_cast<uint8_t>(px[0] + ((b1 >> 4) & 3) - 2);
+            px[1] = static_cast<uint8_t>(px[1] + ((b1 >> 2) & 3) - 2);
+            px[2] = static_cast<uint8_t>(px[2] + (b1 & 3) - 2);
+            break;
+        case 0x80: {
+            const int b2 = s.in.get();
+            if (b2 < 0) return false;
+            const int vg = (b1 & 0x3F) - 32;
+            px[0] = static_cast<uint8_t>(px[0] + vg - 8 + ((b2 >> 4) & 0x0F));
+            px[1] = static_cast<uint8_t>(px[1] + vg);
+            px[2] = static_cast<uint8_t>(px[2] + vg - 8 + (b2 & 0x0F));
+            break;
+        }
+        default:
+            s.run = static_cast<uint32_t>(b1 & 0x3F);   // this pixel plus `run` repeats
+            break;
+        }
+    }
+    std::memcpy(s.index[(px[0] * 3 + px[1] * 5 + px[2] * 7 + px[3] * 11) % 64], px, 4);
+    return true;
+}
+
+/// Decode `rows` rows of `w` pixels as ARGB8888/XRGB8888 into `dst` (nullptr: discard)
+[[nodiscard]] inline bool qoi_rows(CodecSession& s, uint8_t* dst, uint32_t stride, uint32_t w, uint32_t rows,
+                                   bool alpha) noexcept {
+    for (uint32_t y = 0; y < rows; ++y) {
+        uint8_t* p = dst ? dst + y * stride : nullptr;
+        for (uint32_t x = 0; x < w; ++x) {
+            if (!qoi_next(s)) return false;
+            if (!p) continue;
+            p[0] = s.px[2];
+            p[1] = s.px[1];
+            p[2] = s.px[0];
+            p[3] = alpha ? s.px[3] : 0xFF;
+            p += 4;
+        }
+    }
+    s.next_row += static_cast<int32_t>(rows);
+    return true;
+}
+
+/// Rows [y1, y2] of the next band starting at `start`, clamped to the image
+inline void band_rows_at(int32_t start, uint32_t band, uint32_t h, int32_t& y1, int32_t& y2) noexcept {
+    y1 = start;
+    y2 = start + static_cast<int32_t>(band) - 1;
+    if (y2 > static_cast<int32_t>(h) - 1) y2 = static_cast<int32_t>(h) - 1;
+}
+
+[[nodiscard]] inline bool decoded_fits(const lv_image_header_t& h) noexcept {
+    const uint32_t stride = lv_draw_buf_width_to_stride(h.w, static_cast<lv_color_format_t>(h.cf));
+    return static_cast<uint64_t>(stride) * h.h <= LV_CPP_IMAGE_CODEC_FULL_MAX;
+}
+
+} // namespace detail
+
+// ==================== QOI ====================
+
+/**
+ * @brief QOI decoder (quite OK image format), ARGB8888 or XRGB8888 output
+ *
+ * QOI decodes about as fast as memcpy-bound raw images stream from flash
+ * while compressing photos and UI art to roughly PNG size.
+ */
+class QoiDecoder : public ImageDecoderBase<QoiDecoder> {
+public:
+    lv_result_t info(lv_image_decoder_dsc_t& dsc, lv_image_header_t& header) {
+        if (dsc.src_type == LV_IMAGE_SRC_FILE && !has_extension(dsc, "qoi")) return LV_RESULT_INVALID;
+        uint8_t h[codec::kQoiHeaderSize];
+        if (!detail::codec_read_prefix(dsc, h, sizeof(h)) || std::memcmp(h, "qoif", 4) != 0) {
+            return LV_RESULT_INVALID;
+        }
+        const uint32_t w = detail::be32(h + 4);
+        const uint32_t height = detail::be32(h + 8);
+        if (w == 0 || height == 0 || w > 0xFFFF || height > 0xFFFF) return LV_RESULT_INVALID;
+        std::memset(&header, 0, sizeof(header));
+        header.magic = LV_IMAGE_HEADER_MAGIC;
+        header.cf = h[12] == 3 ? LV_COLOR_FORMAT_XRGB8888 : LV_COLOR_FORMAT_ARGB8888;
+        header.w = w;
+        header.h = height;
+        header.stride = lv_draw_buf_width_to_stride(w, static_cast<lv_color_format_t>(header.cf));
+        return LV_RESULT_OK;
+    }
+
+    lv_result_t open(lv_image_decoder_dsc_t& dsc) {
+        detail::CodecSession* s = detail::codec_session_acquire();
+        if (!s) return LV_RESULT_INVALID;
+        if (!s->in.open(dsc) || !s->in.seek(codec::kQoiHeaderSize)) {
+            detail::codec_session_release(s);
+            return LV_RESULT_INVALID;
+        }
+        detail::qoi_reset(*s);
+        const lv_image_header_t& h = dsc.header;
+        const auto cf = static_cast<lv_color_format_t>(h.cf);
+        const bool alpha = cf == LV_COLOR_FORMAT_ARGB8888;
+        if (detail::decoded_fits(h)) {
+            lv_draw_buf_t* out = alloc_output(h.w, h.h, cf);
+            const bool ok = out && detail::qoi_rows(*s, out->data, out->header.stride, h.w, h.h, alpha);
+            detail::codec_session_release(s);
+            if (!ok) {
+                if (out) lv_draw_buf_destroy(out);
+                return LV_RESULT_INVALID;
+            }
+            return publish(dsc, out);
+        }
+        s->band = alloc_output(h.w, LV_CPP_IMAGE_CODEC_BAND_ROWS, cf);
+        if (!s->band) {
+            detail::codec_session_release(s);
+            return LV_RESULT_INVALID;
+        }
+        dsc.user_data = s;
+        dsc.decoded = nullptr;   // streamed through get_area()
+        return LV_RESULT_OK;
+    }
+
+    lv_result_t get_area(lv_image_decoder_dsc_t& dsc, const lv_area_t& full, lv_area_t& decoded) {
+        auto* s = static_cast<detail::CodecSession*>(dsc.user_data);
+        if (!s) return LV_RESULT_INVALID;
+        const lv_image_header_t& h = dsc.header;
+        const int32_t start = decoded.y1 == LV_COORD_MIN ? full.y1 : decoded.y2 + 1;
+        if (start > full.y2 || start >= static_cast<int32_t>(h.h)) return LV_RESULT_INVALID;
+        const bool alpha = h.cf == LV_COLOR_FORMAT_ARGB8888;
+        if (start < s->next_row) {
+            // A new pass over the image: rewind the stream
+            if (!s->in.seek(codec::kQoiHeaderSize)) return LV_RESULT_INVALID;
+            detail::qoi_reset(*s);
+        }
+        if (start > s->next_row &&
+            !detail::qoi_rows(*s, nullptr, 0, h.w, static_cast<uint32_t>(start - s->next_row), alpha)) {
+            return LV_RESULT_INVALID;
+        }
+        int32_t y1, y2;
+        detail::band_rows_at(start, LV_CPP_IMAGE_CODEC_BAND_ROWS, h.h, y1, y2);
+        const uint32_t rows = static_cast<uint32_t>(y2 - y1 + 1);
+        if (!detail::qoi_rows(*s, s->band->data, s->band->header.stride, h.w, rows, alpha)) return LV_RESULT_INVALID;
+        s->band->header.h = rows;
+        decoded = lv_area_t{0, y1, static_cast<int32_t>(h.w) - 1, y2};
+        dsc.decoded = s->band;
+        return LV_RESULT_OK;
+    }
+
+    void close(lv_image_decoder_dsc_t& dsc) {
+        auto* s = static_cast<detail::CodecSession*>(dsc.user_data);
+        if (!s) return;
+        if (dsc.decoded == s->band) dsc.decoded = nullptr;
+        detail::codec_session_release(s);
+        dsc.user_data = nullptr;
+    }
+};
+
+// ==================== LZ4 banded LVGL images ====================
+
+/**
+ * @brief Decoder for ".lz4i": LVGL pixel data in independently LZ4-compressed row bands
+ *
+ * Any non-indexed, non-planar LVGL color format (RGB565, ARGB8565,
+ * RGB888, ARGB8888, XRGB8888, A8, L8, ...). Each band is a little-endian
+ * uint32 compressed size followed by an LZ4 block that inflates to
+ * exactly stride * rows bytes.
+ */
+class Lz4ImageDecoder : public ImageDecoderBase<Lz4ImageDecoder> {
+    [[nodiscard]] static bool band(detail::CodecSession& s, uint8_t* dst, uint32_t bytes) noexcept {
+        uint8_t sz[4];
+        if (!s.in.read(sz, 4)) return false;
+        const uint32_t csize = uint32_t(sz[0]) | (uint32_t(sz[1]) << 8) | (uint32_t(sz[2]) << 16) | (uint32_t(sz[3]) << 24);
+        return detail::lz4_block(s.in, csize, dst, bytes);
+    }
+
+    [[nodiscard]] static bool skip_band(detail::CodecSession& s) noexcept {
+        uint8_t sz[4];
+        if (!s.in.read(sz, 4)) return false;
+        return s.in.skip(uint32_t(sz[0]) | (uint32_t(sz[1]) << 8) | (uint32_t(sz[2]) << 16) | (uint32_t(sz[3]) << 24));
+    }
+
+public:
+    lv_result_t info(lv_image_decoder_dsc_t& dsc, lv_image_header_t& header) {
+        if (dsc.src_type == LV_IMAGE_SRC_FILE && !has_extension(dsc, "lz4i")) return LV_RESULT_INVALID;
+        uint8_t h[codec::kLz4HeaderSize];
+        if (!detail::codec_read_prefix(dsc, h, sizeof(h))) return LV_RESULT_INVALID;
+        codec::Lz4ImageHeader file;
+        std::memcpy(&file, h, sizeof(file));
+        if (std::memcmp(file.magic, "LZ4I", 4) != 0 || file.version != 1 || file.band_rows == 0) {
+            return LV_RESULT_INVALID;
+        }
+        std::memcpy(&header, h + sizeof(file), sizeof(header));
+        const auto cf = static_cast<lv_color_format_t>(header.cf);
+        if (header.magic != LV_IMAGE_HEADER_MAGIC || LV_COLOR_FORMAT_IS_INDEXED(cf) ||
+            cf == LV_COLOR_FORMAT_RGB565A8 || header.w == 0 || header.h == 0) {
+            LV_LOG_WARN("Lz4ImageDecoder: unsupported image (cf %d)", static_cast<int>(cf));
+            return LV_RESULT_INVALID;
+        }
+        if (header.stride == 0) header.stride = lv_draw_buf_width_to_stride(header.w, cf);
+        header.flags = 0;
+        return LV_RESULT_OK;
+    }
+
+    lv_result_t open(lv_image_decoder_dsc_t& dsc) {
+        detail::CodecSession* s = detail::codec_session_acquire();
+        if (!s) return LV_RESULT_INVALID;
+        uint8_t h[codec::kLz4HeaderSize];
+        if (!s->in.open(dsc) || !s->in.read(h, sizeof(h))) {
+            detail::codec_session_release(s);
+            return LV_RESULT_INVALID;
+        }
+        codec::Lz4ImageHeader file;
+        std::memcpy(&file, h, sizeof(file));
+        s->band_rows = file.band_rows;
+        s->next_row = 0;
+        const lv_image_header_t& hd = dsc.header;
+        const auto cf = static_cast<lv_color_format_t>(hd.cf);
+        if (detail::decoded_fits(hd)) {
+            lv_draw_buf_t* out = alloc_output(hd.w, hd.h, cf, hd.stride);
+            bool ok = out != nullptr;
+            for (uint32_t y = 0; ok && y < hd.h; y += s->band_rows) {
+                const uint32_t rows = hd.h - y < s->band_rows ? hd.h - y : s->band_rows;
+                ok = band(*s, out->data + y * hd.stride, rows * hd.stride);
+            }
+            detail::codec_session_release(s);
+            if (!ok) {
+                if (out) lv_draw_buf_destroy(out);
+                return LV_RESULT_INVALID;
+            }
+            return publish(dsc, out);
+        }
+        s->band = alloc_output(hd.w, s->band_rows, cf, hd.stride);
+        if (!s->band) {
+            detail::codec_session_release(s);
+            return LV_RESULT_INVALID;
+        }
+        dsc.user_data = s;
+        dsc.decoded = nullptr;   // streamed through get_area()
+        return LV_RESULT_OK;
+    }
+
+    lv_result_t get_area(lv_image_decoder_dsc_t& dsc, const lv_area_t& full, lv_area_t& decoded) {
+        auto* s = static_cast<detail::CodecSession*>(dsc.user_data);
+        if (!s) return LV_RESULT_INVALID;
+        const lv_image_header_t& h = dsc.header;
+        int32_t start = decoded.y1 == LV_COORD_MIN ? full.y1 : decoded.y2 + 1;
+        if (start > full.y2 || start >= static_cast<int32_t>(h.h)) return LV_RESULT_INVALID;
+        start -= start % static_cast<int32_t>(s->band_rows);   // bands are fixed by the file
+        if (start < s->next_row) {
+            if (!s->in.seek(codec::kLz4HeaderSize)) return LV_RESULT_INVALID;
+            s->next_row = 0;
+        }
+        while (s->next_row < start) {
+            if (!skip_band(*s)) return LV_RESULT_INVALID;
+            s->next_row += static_cast<int32_t>(s->band_rows);
+        }
+        int32_t y1, y2;
+        detail::band_rows_at(start, s->band_rows, h.h, y1, y2);
+        const uint32_t rows = static_cast<uint32_t>(y2 - y1 + 1);
+        if (!band(*s, s->band->data, rows * h.stride)) return LV_RESULT_INVALID;
+        s->next_row += static_cast<int32_t>(s->band_rows);
+        s->band->header.h = rows;
+        decoded = lv_area_t{0, y1, static_cast<int32_t>(h.w) - 1, y2};
+        dsc.decoded = s->band;
+        return LV_RESULT_OK;
+    }
+
+    void close(lv_image_decoder_dsc_t& dsc) {
+        auto* s = static_cast<detail::CodecSession*>(dsc.user_data);
+        if (!s) return;
+        if (dsc.decoded == s->band) dsc.decoded = nullptr;
+        detail::codec_session_release(s);
+        dsc.user_data = nullptr;
+    }
+};
+
+/**
+ * @brief Register the QOI and LZ4 image decoders (idempotent; call after lv::init())
+ */
+inline bool register_image_codecs() noexcept {
+    static QoiDecoder qoi;
+    static Lz4ImageDecoder lz4;
+    if (qoi && lz4) return true;
+    return (qoi || qoi.create("QOI")) && (lz4 || lz4.create("LZ4I"));
+}
+
+} // namespace lv
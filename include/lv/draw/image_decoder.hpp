@@ -7,6 +7,7 @@
  * Provides:
  * - ImageDecoderDsc: RAII wrapper for decoding sessions (open/decode/close)
  * - ImageDecoder: Custom decoder registration with C++ callbacks
+ * - ImageDecoderBase<Derived>: CRTP decoder with member functions as callbacks
  * - Helper functions for getting image info
  *
  * @note Image decoders are used internally by LVGL for PNG, JPG, BMP, etc.
@@ -15,6 +16,8 @@
 
 #include <lvgl.h>
 #include <src/draw/lv_image_decoder_private.h>  // For full struct definitions
+#include <concepts>
+#include "draw_buf.hpp"
 
 namespace lv {
 
@@ -333,6 +336,168 @@ public:
     }
 };
 
+// ==================== CRTP Decoder ====================
+
+/**
+ * @brief Custom decoder whose callbacks are member functions of Derived
+ *
+ * Derived provides (get_area() and close() are optional):
+ * @code
+ * lv_result_t info(lv_image_decoder_dsc_t& dsc, lv_image_header_t& header);
+ * lv_result_t open(lv_image_decoder_dsc_t& dsc);
+ * lv_result_t get_area(lv_image_decoder_dsc_t& dsc, const lv_area_t& full, lv_area_t& decoded);
+ * void close(lv_image_decoder_dsc_t& dsc);
+ * @endcode
+ *
+ * The C callbacks are static functions instantiated per Derived that read
+ * the instance from the decoder's user_data, so dispatch is one indirect
+ * call with no storage. open() allocates its output with alloc_output()
+ * (from the DrawBufPool) and hands it over with publish(), which adds it
+ * to the image cache. The base close callback frees uncached output after
+ * Derived::close(), which only releases the decoder's own session state.
+ *
+ * @code
+ * class QoiDecoder : public lv::ImageDecoderBase<QoiDecoder> {
+ * public:
+ *     lv_result_t info(lv_image_decoder_dsc_t& dsc, lv_image_header_t& header) {
+ *         if (!has_extension(dsc, "qoi")) return LV_RESULT_INVALID;
+ *         ...  // read the QOI header from dsc.file
+ *         return LV_RESULT_OK;
+ *     }
+ *     lv_result_t open(lv_image_decoder_dsc_t& dsc) {
+ *         lv_draw_buf_t* out = alloc_output(dsc.header.w, dsc.header.h, LV_COLOR_FORMAT_ARGB8888);
+ *         if (!out) return LV_RESULT_INVALID;
+ *         ...  // decode into out->data
+ *         return publish(dsc, out);
+ *     }
+ * };
+ *
+ * static QoiDecoder qoi;
+ * qoi.create("QOI");
+ * @endcode
+ *
+ * Not copyable or movable: LVGL holds a pointer to the instance.
+ */
+template<typename Derived>
+class ImageDecoderBase {
+    lv_image_decoder_t* m_decoder = nullptr;
+
+    [[nodiscard]] static Derived& self(lv_image_decoder_t* d) noexcept {
+        return *static_cast<Derived*>(d->user_data);
+    }
+
+    static lv_result_t info_cb(lv_image_decoder_t* d, lv_image_decoder_dsc_t* dsc, lv_image_header_t* header) {
+        return self(d).info(*dsc, *header);
+    }
+
+    static lv_result_t open_cb(lv_image_decoder_t* d, lv_image_decoder_dsc_t* dsc) {
+        return self(d).open(*dsc);
+    }
+
+    static lv_result_t get_area_cb(lv_image_decoder_t* d, lv_image_decoder_dsc_t* dsc,
+                                   const lv_area_t* full_area, lv_area_t* decoded_area) {
+        return self(d).get_area(*dsc, *full_area, *decoded_area);
+    }
+
+    static void close_cb(lv_image_decoder_t* d, lv_image_decoder_dsc_t* dsc) {
+        if constexpr (requires(Derived& x, lv_image_decoder_dsc_t& s) { x.close(s); }) {
+            self(d).close(*dsc);
+        }
+        release_output(*dsc);
+    }
+
+protected:
+    ImageDecoderBase() noexcept = default;
+
+    ~ImageDecoderBase() { destroy(); }
+
+    // ==================== Helpers for Derived ====================
+
+    /// Decoded output buffer from the DrawBufPool (stride 0: minimal aligned stride)
+    [[nodiscard]] static lv_draw_buf_t* alloc_output(uint32_t w, uint32_t h, lv_color_format_t cf,
+                                                     uint32_t stride = 0) noexcept {
+        return lv_draw_buf_create_ex(draw::pool_handlers(), w, h, cf, stride);
+    }
+
+    /**
+     * @brief Set `buf` as the session's output and add it to the image cache
+     *
+     * With args.no_cache or the image cache disabled, the buffer is freed
+     * by close(). If the cache rejects it, it is freed here.
+     * @return LV_RESULT_OK, or LV_RESULT_INVALID (return it from open())
+     */
+    lv_result_t publish(lv_image_decoder_dsc_t& dsc, lv_draw_buf_t* buf) noexcept {
+        if (!buf) return LV_RESULT_INVALID;
+        dsc.decoded = buf;
+        if (dsc.args.no_cache || !lv_image_cache_is_enabled()) return LV_RESULT_OK;
+        lv_image_cache_data_t search_key{};
+        search_key.src_type = dsc.src_type;
+        search_key.src = dsc.src;
+        search_key.slot.size = buf->data_size;
+        lv_cache_entry_t* entry = lv_image_decoder_add_to_cache(m_decoder, &search_key, buf, nullptr);
+        if (!entry) {
+            lv_draw_buf_destroy(buf);
+            dsc.decoded = nullptr;
+            return LV_RESULT_INVALID;
+        }
+        dsc.cache_entry = entry;
+        return LV_RESULT_OK;
+    }
+
+    /// Free the session's output unless the image cache owns it
+    static void release_output(lv_image_decoder_dsc_t& dsc) noexcept {
+        if (!dsc.decoded || (!dsc.args.no_cache && lv_image_cache_is_enabled())) return;
+        lv_draw_buf_destroy(const_cast<lv_draw_buf_t*>(dsc.decoded));
+        dsc.decoded = nullptr;
+    }
+
+    /// True if the source is a file whose extension is `ext` (without the dot)
+    [[nodiscard]] static bool has_extension(const lv_image_decoder_dsc_t& dsc, const char* ext) noexcept {
+        if (dsc.src_type != LV_IMAGE_SRC_FILE) return false;
+        return lv_strcmp(lv_fs_get_ext(static_cast<const char*>(dsc.src)), ext) == 0;
+    }
+
+public:
+    ImageDecoderBase(const ImageDecoderBase&) = delete;
+    ImageDecoderBase& operator=(const ImageDecoderBase&) = delete;
+
+    /// Register the decoder (re-registers if already created)
+    [[nodiscard]] bool create(const char* name = nullptr) noexcept {
+        static_assert(requires(Derived& x, lv_image_decoder_dsc_t& s, lv_image_header_t& h) {
+            { x.info(s, h) } -> std::same_as<lv_result_t>;
+            { x.open(s) } -> std::same_as<lv_result_t>;
+        }, "Derived must define info(dsc, header) and open(dsc) returning lv_result_t");
+        destroy();
+        m_decoder = lv_image_decoder_create();
+        if (!m_decoder) return false;
+        m_decoder->user_data = static_cast<Derived*>(this);
+        if (name) m_decoder->name = name;
+        lv_image_decoder_set_info_cb(m_decoder, &info_cb);
+        lv_image_decoder_set_open_cb(m_decoder, &open_cb);
+        if constexpr (requires(Derived& x, lv_image_decoder_dsc_t& s, const lv_area_t& f, lv_area_t& a) {
+                          x.get_area(s, f, a);
+                      }) {
+            lv_image_decoder_set_get_area_cb(m_decoder, &get_area_cb);
+        }
+        lv_image_decoder_set_close_cb(m_decoder, &close_cb);
+        return true;
+    }
+
+    /// Unregister the decoder
+    void destroy() noexcept {
+        if (m_decoder) {
+            lv_image_decoder_delete(m_decoder);
+            m_decoder = nullptr;
+        }
+    }
+
+    [[nodiscard]] lv_image_decoder_t* get() noexcept { return m_decoder; }
+    [[nodiscard]] const lv_image_decoder_t* get() const noexcept { return m_decoder; }
+
+    [[nodiscard]] bool valid() const noexcept { return m_decoder != nullptr; }
+    explicit operator bool() const noexcept { return valid(); }
+};
+
 // ==================== Decoder Iteration ====================
 
 /**
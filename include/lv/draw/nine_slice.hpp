@@ -0,0 +1,191 @@
+#pragma once
+
+/**
+ * @file nine_slice.hpp
+ * @brief 9-slice image drawing (opt-in)
+ *
+ * draw::image_nine_slice() draws a small source image onto an area of any
+ * size: the four corners are copied 1:1, the edges and the center are
+ * stretched or repeated. Every patch is an lv_draw_image() of the source
+ * clipped to the patch, so no scaled copy of the image is ever allocated.
+ * Also defines Image::nine_slice(), declared in image.hpp:
+ *
+ * @code
+ * #include <lv/draw/nine_slice.hpp>
+ *
+ * static constexpr lv::NineSlice panel{&img_panel, 12, 12, 12, 12};   // 32x32 source
+ * lv::draw::image_nine_slice(layer, lv::ImageDsc{}, lv::area(0, 0, 399, 239), panel);
+ * lv::Image::create(parent).size(400, 240).nine_slice(panel);
+ * @endcode
+ *
+ * Not included by lv.hpp: it narrows lv_layer_t::_clip_area to each
+ * patch, which has no setter. Checked against LVGL 9.4 (see
+ * LV_CPP_INTERNALS_OK).
+ *
+ * Heap allocation: NONE
+ */
+
+#include <lvgl.h>
+#include "../core/version.hpp"
+
+#if !LV_CPP_INTERNALS_OK
+#error "nine_slice.hpp reads LVGL internals checked against LVGL 9.4; see LV_CPP_INTERNALS_OK"
+#endif
+
+#include <src/draw/lv_draw_private.h>  // lv_layer_t::_clip_area
+#include <algorithm>
+#include "draw_image.hpp"
+#include "../widgets/image.hpp"
+
+#ifndef LV_CPP_NINE_SLICE_TILES
+/// Most draw tasks a repeated patch may take per axis; beyond that it is stretched
+#define LV_CPP_NINE_SLICE_TILES 32
+#endif
+
+namespace lv {
+
+namespace detail {
+
+enum class SliceFit : uint8_t { fixed, stretch, repeat };
+
+/// One axis of a patch: source strip and destination span (inclusive)
+struct SliceSpan {
+    int32_t src;
+    int32_t len;
+    int32_t dst1;
+    int32_t dst2;
+};
+
+[[nodiscard]] inline SliceFit slice_fit(SliceFill f) noexcept {
+    return f == SliceFill::repeat ? SliceFit::repeat : SliceFit::stretch;
+}
+
+/**
+ * @brief Draw the source strip `x` x `y` of the image `d.src` into the destination spans
+ *
+ * The whole image is placed so that the strip lands on the destination
+ * and the layer's clip area is narrowed to the destination, so LVGL only
+ * reads and blends the strip.
+ */
+inline void draw_slice(lv_layer_t* layer, lv_draw_image_dsc_t& d, const lv_image_header_t& h, const lv_area_t& clip,
+                       SliceSpan x, SliceSpan y, SliceFit fx, SliceFit fy) noexcept {
+    if (x.len <= 0 || y.len <= 0 || x.dst2 < x.dst1 || y.dst2 < y.dst1) return;
+    const int32_t dw = x.dst2 - x.dst1 + 1;
+    const int32_t dh = y.dst2 - y.dst1 + 1;
+    // A narrow strip repeated many times looks the same stretched, in one draw task
+    if (fx == SliceFit::repeat && (dw + x.len - 1) / x.len > LV_CPP_NINE_SLICE_TILES) fx = SliceFit::stretch;
+    if (fy == SliceFit::repeat && (dh + y.len - 1) / y.len > LV_CPP_NINE_SLICE_TILES) fy = SliceFit::stretch;
+    d.scale_x = fx == SliceFit::stretch ? (dw * LV_SCALE_NONE + x.len - 1) / x.len : LV_SCALE_NONE;
+    d.scale_y = fy == SliceFit::stretch ? (dh * LV_SCALE_NONE + y.len - 1) / y.len : LV_SCALE_NONE;
+    d.pivot.x = x.src;
+    d.pivot.y = y.src;
+    const int32_t step_x = fx == SliceFit::repeat ? x.len : dw;
+    const int32_t step_y = fy == SliceFit::repeat ? y.len : dh;
+    for (int32_t ty = y.dst1; ty <= y.dst2; ty += step_y) {
+        for (int32_t tx = x.dst1; tx <= x.dst2; tx += step_x) {
+            const lv_area_t tile{tx, ty, std::min(tx + step_x - 1, x.dst2), std::min(ty + step_y - 1, y.dst2)};
+            if (!lv_area_intersect(&layer->_clip_area, &tile, &clip)) continue;
+            const lv_area_t coords{tx - x.src, ty - y.src, tx - x.src + static_cast<int32_t>(h.w) - 1,
+                                   ty - y.src + static_cast<int32_t>(h.h) - 1};
+            lv_draw_image(layer, &d, &coords);
+        }
+    }
+}
+
+/// Corner sizes on the destination: the insets, cut down proportionally when `avail` is too small
+inline void slice_corners(int32_t a, int32_t b, int32_t avail, int32_t& out_a, int32_t& out_b) noexcept {
+    if (a + b <= avail) {
+        out_a = a;
+        out_b = b;
+        return;
+    }
+    out_a = a + b > 0 ? avail * a / (a + b) : 0;
+    out_b = avail - out_a;
+}
+
+} // namespace detail
+
+namespace draw {
+
+/**
+ * @brief Draw `ns.src` 9-sliced onto `coords`
+ *
+ * `dsc` supplies opacity, recolor, blend mode and antialiasing; its
+ * source and transform are ignored. Corners keep their size (they are
+ * cropped when `coords` is smaller than two insets), edges and center
+ * follow `ns.edges` and `ns.center`.
+ */
+inline void image_nine_slice(lv_layer_t* layer, const ImageDsc& dsc, const lv_area_t& coords,
+                             const NineSlice& ns) noexcept {
+    lv_image_header_t h;
+    if (!ns.src || lv_image_decoder_get_info(ns.src, &h) != LV_RESULT_OK) return;
+    const auto iw = static_cast<int32_t>(h.w);
+    const auto ih = static_cast<int32_t>(h.h);
+    const int32_t l = std::clamp(ns.left, int32_t{0}, iw);
+    const int32_t r = std::clamp(ns.right, int32_t{0}, iw - l);
+    const int32_t t = std::clamp(ns.top, int32_t{0}, ih);
+    const int32_t b = std::clamp(ns.bottom, int32_t{0}, ih - t);
+
+    int32_t dl, dr, dt, db;
+    detail::slice_corners(l, r, lv_area_get_width(&coords), dl, dr);
+    detail::slice_corners(t, b, lv_area_get_height(&coords), dt, db);
+
+    lv_draw_image_dsc_t d = *dsc.get();
+    d.src = ns.src;
+    d.rotation = 0;
+    d.skew_x = 0;
+    d.skew_y = 0;
+    d.tile = 0;
+
+    // Columns and rows: source strip, destination span
+    const detail::SliceSpan cols[3] = {
+        {0, dl, coords.x1, coords.x1 + dl - 1},
+        {l, iw - l - r, coords.x1 + dl, coords.x2 - dr},
+        {iw - dr, dr, coords.x2 - dr + 1, coords.x2},
+    };
+    const detail::SliceSpan rows[3] = {
+        {0, dt, coords.y1, coords.y1 + dt - 1},
+        {t, ih - t - b, coords.y1 + dt, coords.y2 - db},
+        {ih - db, db, coords.y2 - db + 1, coords.y2},
+    };
+
+    const lv_area_t clip = layer->_clip_area;
+    for (int row = 0; row < 3; ++row) {
+        for (int col = 0; col < 3; ++col) {
+            const bool center = row == 1 && col == 1;
+            const SliceFill fill = center ? ns.center : ns.edges;
+            const detail::SliceFit fx = col == 1 ? detail::slice_fit(fill) : detail::SliceFit::fixed;
+            const detail::SliceFit fy = row == 1 ? detail::slice_fit(fill) : detail::SliceFit::fixed;
+            detail::draw_slice(layer, d, h, clip, cols[col], rows[row], fx, fy);
+        }
+    }
+    layer->_clip_area = clip;
+}
+
+} // namespace draw
+
+namespace detail {
+
+/// LV_EVENT_DRAW_MAIN of Image::nine_slice(); the user data is the NineSlice
+inline void nine_slice_draw_cb(lv_event_t* e) noexcept {
+    auto* obj = static_cast<lv_obj_t*>(lv_event_get_current_target(e));
+    const auto* ns = static_cast<const NineSlice*>(lv_event_get_user_data(e));
+    lv_area_t coords;
+    lv_obj_get_coords(obj, &coords);
+    draw::image_nine_slice(lv_event_get_layer(e), ImageDsc(obj, LV_PART_MAIN), coords, *ns);
+}
+
+/// Image::nine_slice() lands here (declared in image.hpp)
+template <typename>
+struct NineSliceImage {
+    static void set(lv_obj_t* obj, const NineSlice& ns) noexcept {
+        lv_obj_remove_event_cb(obj, &nine_slice_draw_cb);
+        lv_image_set_src(obj, nullptr);
+        lv_obj_add_event_cb(obj, &nine_slice_draw_cb, LV_EVENT_DRAW_MAIN, const_cast<NineSlice*>(&ns));
+        lv_obj_invalidate(obj);
+    }
+};
+
+} // namespace detail
+
+} // namespace lv
@@ -0,0 +1,238 @@
+#pragma once
+
+/**
+ * @file occlusion.hpp
+ * @brief Skip the active screen where an opaque top-layer object covers it
+ *
+ * For every dirty area, lv_refr starts drawing the active screen at its
+ * topmost object that fully covers the area, so opaque panels inside the
+ * screen already hide what is beneath them. The top and system layers are
+ * not part of that search. A modal on lv_layer_top() over a busy dashboard
+ * therefore lets LVGL draw the whole dashboard and then paint the modal
+ * over it. occlusion::enable() extends the search to these layers:
+ *
+ * @code
+ * #include <lv/draw/occlusion.hpp>
+ *
+ * lv::occlusion::enable();                 // default display
+ * auto modal = lv::Box::create(lv_layer_top()).size(lv::pct(100), lv::pct(100));
+ * modal.bg_opa(LV_OPA_COVER);              // dashboard no longer drawn beneath it
+ * ...
+ * auto st = lv::occlusion::stats();        // st.culled areas, st.objects skipped
+ * @endcode
+ *
+ * A cover test asks LVGL's own LV_EVENT_COVER_CHECK. An object counts only
+ * if it is fully opaque, has no radius over the area, has no transform,
+ * opacity or blend mode that needs a layer, and is inside such ancestors. The hook is an empty, style-less object kept as
+ * the active screen's last child. When a top- or sys-layer object covers
+ * the area being refreshed, this object reports that it covers the area
+ * too. lv_refr then starts at it, skipping the screen, its children and
+ * the bottom layer. The top and sys layers are drawn as before. Code that
+ * walks the screen's children will see the extra object.
+ *
+ * Not included by lv.hpp: it walks objects' coords and children arrays
+ * directly and sets lv_cover_check_info_t::res, none of which is public.
+ * Checked against LVGL 9.4 (see LV_CPP_INTERNALS_OK).
+ *
+ * Heap allocation: NONE in the wrapper (LV_CPP_OCCLUSION_DISPLAYS fixed
+ * slots); one LVGL object per enabled display
+ */
+
+#include <lvgl.h>
+#include "../core/version.hpp"
+
+#if !LV_CPP_INTERNALS_OK
+#error "occlusion.hpp reads LVGL internals checked against LVGL 9.4; see LV_CPP_INTERNALS_OK"
+#endif
+
+#include <src/core/lv_obj_private.h>          // coords, spec_attr->children
+#include <src/core/lv_obj_event_private.h>    // lv_cover_check_info_t::res
+#include <cstdint>
+#include <cstring>
+
+#ifndef LV_CPP_OCCLUSION_DISPLAYS
+/// Displays occlusion culling can be enabled on at once
+#define LV_CPP_OCCLUSION_DISPLAYS 2
+#endif
+
+namespace lv::occlusion {
+
+struct Stats {
+    uint32_t checked = 0;     ///< Dirty areas tested against the top and sys layers
+    uint32_t culled = 0;      ///< Areas where the active screen was skipped
+    uint64_t pixels = 0;      ///< Pixels of the culled areas
+    uint32_t objects = 0;     ///< Visible screen objects in culled areas that were not drawn
+};
+
+namespace detail {
+
+struct Slot {
+    lv_display_t* disp = nullptr;     ///< nullptr: free
+    lv_obj_t* screen = nullptr;
+    lv_obj_t* hook = nullptr;         ///< Cover hook, last child of `screen`
+};
+
+struct State {
+    Slot slots[LV_CPP_OCCLUSION_DISPLAYS];
+    Stats stats{};
+};
+
+[[nodiscard]] inline State& state() noexcept {
+    static State s;
+    return s;
+}
+
+[[nodiscard]] inline Slot* find(const lv_display_t* disp) noexcept {
+    for (Slot& s : state().slots) {
+        if (s.disp == disp) return &s;
+    }
+    return nullptr;
+}
+
+/// Drawn straight to the parent layer (no opacity, blending or transform layer)
+[[nodiscard]] inline bool plain(lv_obj_t* obj) noexcept {
+    return lv_obj_get_style_opa(obj, LV_PART_MAIN) == LV_OPA_COVER &&
+           lv_obj_get_style_opa_layered(obj, LV_PART_MAIN) == LV_OPA_COVER &&
+           lv_obj_get_style_blend_mode(obj, LV_PART_MAIN) == LV_BLEND_MODE_NORMAL &&
+           lv_obj_get_style_transform_rotation(obj, LV_PART_MAIN) == 0 &&
+           lv_obj_get_style_transform_scale_x(obj, LV_PART_MAIN) == LV_SCALE_NONE &&
+           lv_obj_get_style_transform_scale_y(obj, LV_PART_MAIN) == LV_SCALE_NONE &&
+           lv_obj_get_style_transform_skew_x(obj, LV_PART_MAIN) == 0 &&
+           lv_obj_get_style_transform_skew_y(obj, LV_PART_MAIN) == 0;
+}
+
+/// Topmost object under `obj` that covers `area`, as lv_refr searches the active screen
+[[nodiscard]] inline lv_obj_t* top_cover(lv_obj_t* obj, const lv_area_t& area) noexcept {
+    if (!lv_area_is_in(&area, &obj->coords, 0) || lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN) || !plain(obj)) {
+        return nullptr;
+    }
+    for (uint32_t i = lv_obj_get_child_count(obj); i-- > 0;) {
+        if (lv_obj_t* found = top_cover(obj->spec_attr->children[i], area)) return found;
+    }
+    lv_cover_check_info_t info{};
+    info.res = LV_COVER_RES_COVER;
+    info.area = &area;
+    lv_obj_send_event(obj, LV_EVENT_COVER_CHECK, &info);
+    return info.res == LV_COVER_RES_COVER ? obj : nullptr;
+}
+
+[[nodiscard]] inline bool covered(lv_display_t* disp, const lv_area_t& area) noexcept {
+    return top_cover(lv_display_get_layer_top(disp), area) || top_cover(lv_display_get_layer_sys(disp), area);
+}
+
+/// Visible objects under `obj` (itself excluded) intersecting `area`
+[[nodiscard]] inline uint32_t count_objects(const lv_obj_t* obj, const lv_area_t& area, const lv_obj_t* hook) noexcept {
+    uint32_t n = 0;
+    const uint32_t children = lv_obj_get_child_count(obj);
+    for (uint32_t i = 0; i < children; ++i) {
+        const lv_obj_t* child = obj->spec_attr->children[i];
+        if (child == hook || lv_obj_has_flag(child, LV_OBJ_FLAG_HIDDEN)) continue;
+        lv_area_t common;
+        if (!lv_area_intersect(&common, &area, &child->coords)) continue;
+        n += 1 + count_objects(child, area, hook);
+    }
+    return n;
+}
+
+inline void cover_cb(lv_event_t* e) {
+    auto* hook = static_cast<lv_obj_t*>(lv_event_get_current_target(e));
+    auto* info = static_cast<lv_cover_check_info_t*>(lv_event_get_param(e));
+    if (info->res == LV_COVER_RES_MASKED) return;
+    lv_display_t* disp = lv_obj_get_display(hook);
+    Stats& st = state().stats;
+    ++st.checked;
+    if (!covered(disp, *info->area)) return;
+    info->res = LV_COVER_RES_COVER;    // the class handler said NOT_COVER: no background
+    ++st.culled;
+    st.pixels += lv_area_get_size(info->area);
+    st.objects += count_objects(lv_obj_get_parent(hook), *info->area, hook);
+}
+
+inline void hook_delete_cb(lv_event_t* e) {
+    auto* hook = static_cast<lv_obj_t*>(lv_event_get_current_target(e));
+    for (Slot& s : state().slots) {
+        if (s.hook != hook) continue;
+        s.hook = nullptr;
+        s.screen = nullptr;
+    }
+}
+
+[[nodiscard]] inline lv_obj_t* create_hook(lv_obj_t* screen, lv_display_t* disp) noexcept {
+    lv_obj_t* hook = lv_obj_create(screen);
+    lv_obj_remove_style_all(hook);
+    lv_obj_remove_flag(hook, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_remove_flag(hook, LV_OBJ_FLAG_CLICK_FOCUSABLE);
+    lv_obj_remove_flag(hook, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_add_flag(hook, LV_OBJ_FLAG_FLOATING);
+    lv_obj_add_flag(hook, LV_OBJ_FLAG_IGNORE_LAYOUT);
+    lv_obj_set_pos(hook, 0, 0);
+    lv_obj_set_size(hook, lv_display_get_horizontal_resolution(disp), lv_display_get_vertical_resolution(disp));
+    lv_obj_add_event_cb(hook, &cover_cb, LV_EVENT_COVER_CHECK, nullptr);
+    lv_obj_add_event_cb(hook, &hook_delete_cb, LV_EVENT_DELETE, nullptr);
+    return hook;
+}
+
+/// Move the hook back to the top of its screen without invalidating anything (it draws nothing)
+inline void keep_last(lv_obj_t* hook) noexcept {
+    lv_obj_t* parent = lv_obj_get_parent(hook);
+    const uint32_t n = lv_obj_get_child_count(parent);
+    const auto idx = static_cast<uint32_t>(lv_obj_get_index(hook));
+    if (idx + 1 == n) return;
+    lv_obj_t** children = parent->spec_attr->children;
+    std::memmove(&children[idx], &children[idx + 1], (n - 1 - idx) * sizeof(lv_obj_t*));
+    children[n - 1] = hook;
+}
+
+/// Follow the active screen before each refresh
+inline void refr_start_cb(lv_event_t* e) {
+    auto* disp = static_cast<lv_display_t*>(lv_event_get_current_target(e));
+    Slot* s = find(disp);
+    if (!s) return;
+    lv_obj_t* act = lv_display_get_screen_active(disp);
+    if (s->screen != act) {
+        if (s->hook) lv_obj_delete(s->hook);   // inactive screen: invalidates nothing
+        s->hook = act ? create_hook(act, disp) : nullptr;
+        s->screen = act;
+    } else if (s->hook) {
+        keep_last(s->hook);
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Skip drawing the active screen under opaque top/sys-layer objects
+ * @param disp Display (nullptr: default)
+ * @return false if every slot is in use
+ */
+inline bool enable(lv_display_t* disp = nullptr) noexcept {
+    if (!disp) disp = lv_display_get_default();
+    if (!disp) return false;
+    if (detail::find(disp)) return true;
+    detail::Slot* s = detail::find(nullptr);
+    if (!s) return false;
+    *s = detail::Slot{disp, nullptr, nullptr};
+    lv_display_add_event_cb(disp, &detail::refr_start_cb, LV_EVENT_REFR_START, nullptr);
+    return true;
+}
+
+/// Stop culling on `disp` and remove the hook object
+inline void disable(lv_display_t* disp = nullptr) noexcept {
+    if (!disp) disp = lv_display_get_default();
+    detail::Slot* s = disp ? detail::find(disp) : nullptr;
+    if (!s) return;
+    lv_display_remove_event_cb_with_user_data(disp, &detail::refr_start_cb, nullptr);
+    if (s->hook) lv_obj_delete(s->hook);
+    *s = detail::Slot{};
+}
+
+[[nodiscard]] inline bool enabled(lv_display_t* disp = nullptr) noexcept {
+    if (!disp) disp = lv_display_get_default();
+    return disp && detail::find(disp);
+}
+
+[[nodiscard]] inline Stats stats() noexcept { return detail::state().stats; }
+
+inline void reset_stats() noexcept { detail::state().stats = Stats{}; }
+
+} // namespace lv::occlusion
@@ -0,0 +1,262 @@
+#pragma once
+
+/**
+ * @file path_cache.hpp
+ * @brief SharedPath draws with curves flattened once per scale (opt-in)
+ *
+ * Once installed, VectorDsc::add_path(SharedPath) adds a copy with every
+ * curve flattened into line segments for the dsc's current transform
+ * scale and the path quality, cached per (path, scale, quality), so
+ * redraws at the same scale skip both path construction and curve
+ * flattening:
+ *
+ * @code
+ * #include <lv/draw/path_cache.hpp>
+ *
+ * lv::path_cache::install();   // once, after lv_init()
+ *
+ * // LV_EVENT_DRAW_MAIN
+ * lv::VectorDsc dsc(layer);
+ * dsc.scale(zoom).stroke_width(6).add_path(gauge).draw();
+ * @endcode
+ *
+ * The flattening tolerance is 1/4, 1/2 or 1 device pixel for HIGH, MEDIUM
+ * and LOW quality. stats() reports hits and misses.
+ *
+ * Not included by lv.hpp: it reads lv_vector_path_t's quality, ops and
+ * points, none of which is public. Checked against LVGL 9.4 (see
+ * LV_CPP_INTERNALS_OK).
+ *
+ * Heap allocation: the flattened paths (LVGL's path storage, at most
+ * LV_CPP_PATH_CACHE of them)
+ */
+
+#include <lvgl.h>
+#include "../core/version.hpp"
+
+#if LV_USE_VECTOR_GRAPHIC
+
+#if !LV_CPP_INTERNALS_OK
+#error "path_cache.hpp reads LVGL internals checked against LVGL 9.4; see LV_CPP_INTERNALS_OK"
+#endif
+
+#include <src/draw/lv_draw_vector_private.h>  // lv_vector_path_t quality, ops, points
+#include <cmath>
+#include <cstdint>
+#include "draw_vector.hpp"
+
+#ifndef LV_CPP_PATH_CACHE
+/// Flattened (path, scale, quality) entries kept for SharedPath draws
+#define LV_CPP_PATH_CACHE 16
+#endif
+
+#ifndef LV_CPP_PATH_MAX_SEGMENTS
+/// Upper bound of line segments per flattened curve
+#define LV_CPP_PATH_MAX_SEGMENTS 64
+#endif
+
+namespace lv::path_cache {
+
+/// Counters of the flattened-path cache
+struct Stats {
+    uint32_t paths;     ///< live SharedPaths
+    uint32_t entries;   ///< cached flattened paths
+    uint32_t bytes;     ///< op and point storage of those
+    uint32_t hits;
+    uint32_t misses;
+};
+
+namespace detail {
+
+using lv::detail::NO_PATH;
+
+struct FlatEntry {
+    lv_vector_path_t* flat = nullptr;
+    uint16_t slot = NO_PATH;
+    uint16_t scale = 0;    ///< ceil(scale * 16)
+    uint32_t bytes = 0;
+    uint32_t used = 0;     ///< LRU stamp
+};
+
+struct FlatTable {
+    FlatEntry flat[LV_CPP_PATH_CACHE];
+    uint32_t clock = 0;
+    Stats stats{};
+};
+
+[[nodiscard]] inline FlatTable& table() noexcept {
+    static FlatTable t;
+    return t;
+}
+
+inline void free_flat(FlatTable& t, FlatEntry& e) noexcept {
+    if (e.flat) {
+        lv_vector_path_delete(e.flat);
+        --t.stats.entries;
+        t.stats.bytes -= e.bytes;
+    }
+    e = FlatEntry{};
+}
+
+/// PathCacheHooks::release: drop the copies of shared path `slot`
+inline void release(uint16_t slot) noexcept {
+    FlatTable& t = table();
+    for (FlatEntry& e : t.flat) {
+        if (e.slot == slot) free_flat(t, e);
+    }
+}
+
+/// Largest axis scale of `m`, in 1/16 steps rounded up (so cached paths are never coarser than needed)
+[[nodiscard]] inline uint16_t scale_key(const lv_matrix_t& m) noexcept {
+    const float sx = std::sqrt(m.m[0][0] * m.m[0][0] + m.m[1][0] * m.m[1][0]);
+    const float sy = std::sqrt(m.m[0][1] * m.m[0][1] + m.m[1][1] * m.m[1][1]);
+    const float q = std::ceil((sx > sy ? sx : sy) * 16.0f);
+    return q < 1.0f ? 1 : q > 65535.0f ? 65535 : static_cast<uint16_t>(q);
+}
+
+/// Allowed deviation from the true curve, in device pixels
+[[nodiscard]] inline float tolerance_px(lv_vector_path_quality_t quality) noexcept {
+    switch (quality) {
+        case LV_VECTOR_PATH_QUALITY_HIGH: return 0.25f;
+        case LV_VECTOR_PATH_QUALITY_LOW: return 1.0f;
+        default: return 0.5f;
+    }
+}
+
+[[nodiscard]] inline float dist(float x, float y) noexcept { return std::sqrt(x * x + y * y); }
+
+/// Segments keeping a Bezier of degree `degree` within `tol` (Wang's formula; `m` = max second difference)
+[[nodiscard]] inline uint32_t segments(float m, float tol, int degree) noexcept {
+    const float n = std::ceil(std::sqrt(static_cast<float>(degree * (degree - 1)) / 8.0f * m / tol));
+    return n < 1.0f ? 1 : n > LV_CPP_PATH_MAX_SEGMENTS ? LV_CPP_PATH_MAX_SEGMENTS : static_cast<uint32_t>(n);
+}
+
+/// Copy of `src` with quadratic and cubic curves replaced by line segments within `tol` (path units)
+[[nodiscard]] inline lv_vector_path_t* flatten(const lv_vector_path_t* src, float tol) noexcept {
+    lv_vector_path_t* out = lv_vector_path_create(src->quality);
+    if (!out) return nullptr;
+    const uint32_t nops = lv_array_size(&src->ops);
+    const uint32_t npts = lv_array_size(&src->points);
+    const auto* ops = static_cast<const lv_vector_path_op_t*>(lv_array_at(&src->ops, 0));
+    const auto* pts = static_cast<const lv_fpoint_t*>(lv_array_at(&src->points, 0));
+    lv_fpoint_t cur{0, 0};
+    lv_fpoint_t start{0, 0};
+    uint32_t pi = 0;
+    for (uint32_t i = 0; i < nops; ++i) {
+        switch (ops[i]) {
+            case LV_VECTOR_PATH_OP_MOVE_TO:
+                if (pi + 1 > npts) return out;
+                cur = start = pts[pi++];
+                lv_vector_path_move_to(out, &cur);
+                break;
+            case LV_VECTOR_PATH_OP_LINE_TO:
+                if (pi + 1 > npts) return out;
+                cur = pts[pi++];
+                lv_vector_path_line_to(out, &cur);
+                break;
+            case LV_VECTOR_PATH_OP_QUAD_TO: {
+                if (pi + 2 > npts) return out;
+                const lv_fpoint_t c = pts[pi];
+                const lv_fpoint_t e = pts[pi + 1];
+                pi += 2;
+                const uint32_t n = segments(dist(cur.x - 2 * c.x + e.x, cur.y - 2 * c.y + e.y), tol, 2);
+                for (uint32_t k = 1; k <= n; ++k) {
+                    const float t = static_cast<float>(k) / n;
+                    const float u = 1 - t;
+                    lv_fpoint_t p{u * u * cur.x + 2 * u * t * c.x + t * t * e.x,
+                                  u * u * cur.y + 2 * u * t * c.y + t * t * e.y};
+                    if (k == n) p = e;
+                    lv_vector_path_line_to(out, &p);
+                }
+                cur = e;
+                break;
+            }
+            case LV_VECTOR_PATH_OP_CUBIC_TO: {
+                if (pi + 3 > npts) return out;
+                const lv_fpoint_t c1 = pts[pi];
+                const lv_fpoint_t c2 = pts[pi + 1];
+                const lv_fpoint_t e = pts[pi + 2];
+                pi += 3;
+                const float d1 = dist(cur.x - 2 * c1.x + c2.x, cur.y - 2 * c1.y + c2.y);
+                const float d2 = dist(c1.x - 2 * c2.x + e.x, c1.y - 2 * c2.y + e.y);
+                const uint32_t n = segments(d1 > d2 ? d1 : d2, tol, 3);
+                for (uint32_t k = 1; k <= n; ++k) {
+                    const float t = static_cast<float>(k) / n;
+                    const float u = 1 - t;
+                    const float a = u * u * u, b = 3 * u * u * t, g = 3 * u * t * t, d = t * t * t;
+                    lv_fpoint_t p{a * cur.x + b * c1.x + g * c2.x + d * e.x,
+                                  a * cur.y + b * c1.y + g * c2.y + d * e.y};
+                    if (k == n) p = e;
+                    lv_vector_path_line_to(out, &p);
+                }
+                cur = e;
+                break;
+            }
+            case LV_VECTOR_PATH_OP_CLOSE:
+                lv_vector_path_close(out);
+                cur = start;
+                break;
+            default:
+                break;
+        }
+    }
+    return out;
+}
+
+[[nodiscard]] inline uint32_t path_bytes(const lv_vector_path_t* p) noexcept {
+    return lv_array_size(&p->ops) * sizeof(lv_vector_path_op_t) + lv_array_size(&p->points) * sizeof(lv_fpoint_t);
+}
+
+/// PathCacheHooks::flattened: cached flattening of shared path `slot` for transform `m`; the source path if flattening fails
+[[nodiscard]] inline const lv_vector_path_t* flattened(uint16_t slot, const lv_matrix_t& m) noexcept {
+    FlatTable& t = table();
+    const lv_vector_path_t* src = lv::detail::shared_paths().slots[slot].path;
+    const uint16_t scale = scale_key(m);
+    FlatEntry* victim = &t.flat[0];
+    for (FlatEntry& e : t.flat) {
+        if (e.slot == slot && e.scale == scale) {
+            e.used = ++t.clock;
+            ++t.stats.hits;
+            return e.flat;
+        }
+        if (!e.flat || (victim->flat && e.used < victim->used)) victim = &e;
+    }
+    ++t.stats.misses;
+    lv_vector_path_t* flat = flatten(src, tolerance_px(src->quality) * 16.0f / scale);
+    if (!flat) return src;
+    free_flat(t, *victim);
+    *victim = FlatEntry{flat, slot, scale, path_bytes(flat), ++t.clock};
+    ++t.stats.entries;
+    t.stats.bytes += victim->bytes;
+    return flat;
+}
+
+} // namespace detail
+
+/// Draw SharedPaths flattened from now on (LVGL thread)
+inline void install() noexcept {
+    lv::detail::shared_paths().hooks = lv::detail::PathCacheHooks{&detail::flattened, &detail::release};
+}
+
+[[nodiscard]] inline Stats stats() noexcept {
+    Stats s = detail::table().stats;
+    s.paths = lv::detail::shared_paths().live;
+    return s;
+}
+
+/// Zero the hit/miss counters (sizes are kept)
+inline void reset_stats() noexcept {
+    Stats& s = detail::table().stats;
+    s.hits = 0;
+    s.misses = 0;
+}
+
+/// Delete every flattened path (SharedPaths stay valid and re-flatten on their next draw)
+inline void drop() noexcept {
+    detail::FlatTable& t = detail::table();
+    for (detail::FlatEntry& e : t.flat) detail::free_flat(t, e);
+}
+
+} // namespace lv::path_cache
+
+#endif // LV_USE_VECTOR_GRAPHIC
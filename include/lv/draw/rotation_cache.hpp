@@ -0,0 +1,505 @@
+#pragma once
+
+/**
+ * @file rotation_cache.hpp
+ * @brief Cached rotated images: clock hands and needles drawn as plain blits
+ *
+ * A rotated or scaled image is transformed pixel by pixel on every draw:
+ * the SW renderer maps each destination pixel back into the source and
+ * interpolates it. A clock hand or gauge needle is redrawn whenever
+ * anything moves over or under it, mostly at an angle it was already
+ * drawn at. This cache keeps the transformed result per (source, angle,
+ * scale, pivot, recolor) in a pooled ARGB8888 bitmap covering the
+ * transformed bounding area, and swaps it into the image's draw task, so
+ * a repeated angle is a plain blit.
+ *
+ * Each enabled image has an angle step (0.1 degree units). Angles on that
+ * grid are cached; others are drawn by LVGL as before. rotate() sets an
+ * image's rotation snapped to its step, so the caller can pass the exact
+ * angle. For small images, precompute() renders the whole turn up front.
+ *
+ * @code
+ * #include <lv/draw/rotation_cache.hpp>
+ *
+ * lv::rotation_cache::enable(minute_hand, 5);   // 0.5 degree steps
+ * lv::rotation_cache::rotate(minute_hand, minutes * 60 + seconds);
+ *
+ * lv::rotation_cache::enable(spinner_icon, 60);
+ * lv::rotation_cache::precompute(spinner_icon); // all 60 angles now
+ * @endcode
+ *
+ * A miss is drawn by LVGL and its bitmap rendered at the display's
+ * REFR_READY. Bitmaps handed to draw tasks stay pinned until then; the
+ * least recently used ones go when the budget() is exceeded, precomputed
+ * ones only through disable() or drop(). Entries are keyed by the source
+ * pointer: after changing an image's pixels in place, call drop().
+ *
+ * Not included by lv.hpp: it swaps the image's draw task for a blit,
+ * reading lv_draw_task_t's area and _real_area and walking
+ * lv_display_t::layer_head, none of which is public. Checked against LVGL
+ * 9.4 (see LV_CPP_INTERNALS_OK).
+ *
+ * Heap allocation: NONE in the wrapper (fixed tables; bitmaps come from
+ * the DrawBufPool)
+ */
+
+#include <lvgl.h>
+#include "../core/version.hpp"
+
+#if !LV_CPP_INTERNALS_OK
+#error "rotation_cache.hpp reads LVGL internals checked against LVGL 9.4; see LV_CPP_INTERNALS_OK"
+#endif
+
+#include <src/draw/lv_draw_private.h>             // lv_draw_task_t::area, _real_area
+#include <src/display/lv_display_private.h>       // lv_display_t::layer_head
+#include <cstdint>
+#include "draw_buf.hpp"
+#include "../core/object.hpp"
+
+#if LV_USE_IMAGE
+
+#ifndef LV_CPP_ROTATION_CACHE
+/// Cached (source, angle, scale, pivot) bitmaps of all images together
+#define LV_CPP_ROTATION_CACHE 64
+#endif
+
+#ifndef LV_CPP_ROTATION_CACHE_IMAGES
+/// Images that can use the rotation cache at the same time
+#define LV_CPP_ROTATION_CACHE_IMAGES 8
+#endif
+
+#ifndef LV_CPP_ROTATION_CACHE_BYTES
+/// Default bitmap bytes kept before the least recently used entries go (see budget())
+#define LV_CPP_ROTATION_CACHE_BYTES (512u * 1024u)
+#endif
+
+namespace lv::rotation_cache {
+
+/// Counters of the rotation cache
+struct Stats {
+    uint32_t images;     ///< images with the cache enabled
+    uint32_t entries;    ///< bitmaps rendered and held
+    uint32_t bytes;      ///< bitmap bytes held
+    uint32_t renders;    ///< bitmaps rendered
+    uint32_t hits;       ///< draws served by a bitmap
+    uint32_t misses;     ///< draws left to LVGL on the grid (bitmap pending, over budget or no slot)
+    uint32_t off_grid;   ///< draws left to LVGL at an angle off the image's step
+};
+
+namespace detail {
+
+struct Key {
+    const void* src = nullptr;
+    int32_t w = 0, h = 0;        ///< source size
+    int32_t angle = 0;           ///< 0..3599
+    int32_t scale_x = LV_SCALE_NONE;
+    int32_t scale_y = LV_SCALE_NONE;
+    lv_point_t pivot{};
+    lv_color_t recolor{};
+    lv_opa_t recolor_opa = LV_OPA_TRANSP;
+    bool antialias = true;
+};
+
+[[nodiscard]] inline bool same(const Key& a, const Key& b) noexcept {
+    return a.src == b.src && a.w == b.w && a.h == b.h && a.angle == b.angle && a.scale_x == b.scale_x &&
+           a.scale_y == b.scale_y && a.pivot.x == b.pivot.x && a.pivot.y == b.pivot.y &&
+           a.recolor_opa == b.recolor_opa && (a.recolor_opa == LV_OPA_TRANSP || lv_color_eq(a.recolor, b.recolor)) &&
+           a.antialias == b.antialias;
+}
+
+struct Entry {
+    Key key;
+    lv_area_t area{};                 ///< transformed area relative to the image's top-left
+    lv_display_t* disp = nullptr;
+    lv_draw_buf_t* buf = nullptr;     ///< nullptr: requested, rendered at REFR_READY
+    uint32_t used = 0;                ///< LRU stamp
+    bool taken = false;
+    bool pinned = false;              ///< read by a queued draw task
+    bool kept = false;                ///< precomputed: not evicted for the budget
+    bool failed = false;              ///< out of memory or budget: drawn by LVGL
+};
+
+struct Image {
+    lv_obj_t* obj = nullptr;
+    int32_t step = 1;
+};
+
+struct Tables {
+    Entry entries[LV_CPP_ROTATION_CACHE];
+    Image images[LV_CPP_ROTATION_CACHE_IMAGES];
+    uint32_t budget = LV_CPP_ROTATION_CACHE_BYTES;
+    uint32_t clock = 0;
+    Stats stats{};
+};
+
+[[nodiscard]] inline Tables& tables() noexcept {
+    static Tables t;
+    return t;
+}
+
+[[nodiscard]] inline Image* find_image(lv_obj_t* obj) noexcept {
+    for (Image& im : tables().images) {
+        if (im.obj == obj) return &im;
+    }
+    return nullptr;
+}
+
+[[nodiscard]] inline Entry* find(const Key& k) noexcept {
+    for (Entry& e : tables().entries) {
+        if (e.taken && same(e.key, k)) return &e;
+    }
+    return nullptr;
+}
+
+[[nodiscard]] inline int32_t normalize(int32_t angle) noexcept {
+    angle %= 3600;
+    return angle < 0 ? angle + 3600 : angle;
+}
+
+/// Bitmap bytes of `area`
+[[nodiscard]] inline uint32_t bytes_of(const lv_area_t& area) noexcept {
+    return lv_draw_buf_width_to_stride(static_cast<uint32_t>(lv_area_get_width(&area)), LV_COLOR_FORMAT_ARGB8888) *
+           static_cast<uint32_t>(lv_area_get_height(&area));
+}
+
+inline void free_entry(Tables& t, Entry& e) noexcept {
+    if (e.buf) {
+        t.stats.bytes -= e.buf->data_size;
+        --t.stats.entries;
+        lv_image_cache_drop(e.buf);
+        lv_draw_buf_destroy(e.buf);
+    }
+    e = Entry{};
+}
+
+/// A free entry, else the oldest evictable one (or nullptr); `occupied_only` skips free entries
+[[nodiscard]] inline Entry* victim(Tables& t, bool occupied_only = false) noexcept {
+    Entry* v = nullptr;
+    for (Entry& e : t.entries) {
+        if (!e.taken) {
+            if (!occupied_only) return &e;
+            continue;
+        }
+        if ((e.buf || e.failed) && !e.pinned && !e.kept && (!v || e.used < v->used)) v = &e;
+    }
+    return v;
+}
+
+/// Make room for `need` more bytes by evicting; false if the budget cannot hold them
+[[nodiscard]] inline bool reserve(Tables& t, uint32_t need) noexcept {
+    while (t.stats.bytes + need > t.budget) {
+        Entry* old = victim(t, true);
+        if (!old) return false;
+        free_entry(t, *old);
+    }
+    return true;
+}
+
+/// Take a slot for `k`, transformed to `area`; nullptr if none is free or evictable
+[[nodiscard]] inline Entry* claim(Tables& t, const Key& k, const lv_area_t& area, lv_display_t* disp) noexcept {
+    Entry* e = victim(t);
+    if (!e) return nullptr;
+    free_entry(t, *e);
+    e->key = k;
+    e->area = area;
+    e->disp = disp;
+    e->taken = true;
+    e->used = ++t.clock;
+    return e;
+}
+
+/// Render the transformed source of `e` into a new pooled bitmap
+[[nodiscard]] inline bool render(Tables& t, Entry& e) noexcept {
+    const uint32_t need = bytes_of(e.area);
+    if (!reserve(t, need)) return false;
+    const auto bw = static_cast<uint32_t>(lv_area_get_width(&e.area));
+    const auto bh = static_cast<uint32_t>(lv_area_get_height(&e.area));
+    lv_draw_buf_t* buf = lv_draw_buf_create_ex(draw::pool_handlers(), bw, bh, LV_COLOR_FORMAT_ARGB8888, 0);
+    if (!buf) return false;
+    lv_draw_buf_clear(buf, nullptr);
+    lv_layer_t layer;
+    lv_layer_init(&layer);
+    layer.draw_buf = buf;
+    layer.color_format = LV_COLOR_FORMAT_ARGB8888;
+    layer.buf_area = lv_area_t{0, 0, static_cast<int32_t>(bw) - 1, static_cast<int32_t>(bh) - 1};
+    layer._clip_area = layer.buf_area;
+    layer.phy_clip_area = layer.buf_area;
+
+    const Key& k = e.key;
+    lv_draw_image_dsc_t img;
+    lv_draw_image_dsc_init(&img);
+    img.src = k.src;
+    img.rotation = k.angle;
+    img.scale_x = k.scale_x;
+    img.scale_y = k.scale_y;
+    img.pivot = k.pivot;
+    img.recolor = k.recolor;
+    img.recolor_opa = k.recolor_opa;
+    img.antialias = k.antialias;
+    // The image's top-left sits where the transformed area's top-left lands on (0, 0)
+    const lv_area_t coords{-e.area.x1, -e.area.y1, -e.area.x1 + k.w - 1, -e.area.y1 + k.h - 1};
+
+    // Finish the draw tasks synchronously, as snapshot::detail::redraw() does
+    lv_display_t* disp = e.disp;
+    lv_display_t* disp_old = lv_refr_get_disp_refreshing();
+    lv_layer_t* head_old = disp->layer_head;
+    disp->layer_head = &layer;
+    lv_refr_set_disp_refreshing(disp);
+    lv_draw_image(&layer, &img, &coords);
+    while (layer.draw_task_head) {
+        lv_draw_dispatch_wait_for_request();
+        if (!lv_draw_dispatch_layer(disp, &layer)) {
+            lv_draw_wait_for_finish();
+            lv_draw_dispatch_request();
+        }
+    }
+    disp->layer_head = head_old;
+    lv_refr_set_disp_refreshing(disp_old);
+
+    e.buf = buf;
+    t.stats.bytes += buf->data_size;
+    ++t.stats.entries;
+    ++t.stats.renders;
+    return true;
+}
+
+/// Unpin the bitmaps of the finished frame and render the ones requested during it
+inline void refr_ready_cb(lv_event_t* ev) noexcept {
+    auto* disp = static_cast<lv_display_t*>(lv_event_get_current_target(ev));
+    Tables& t = tables();
+    for (Entry& e : t.entries) {
+        if (e.disp == disp) e.pinned = false;
+    }
+    for (Entry& e : t.entries) {
+        if (!e.taken || e.buf || e.failed || e.disp != disp) continue;
+        // Keep the slot so the angle is not requested again every frame; it ages out like the others
+        e.failed = !render(t, e);
+    }
+}
+
+/// The transform of an image draw task as a cache key; false if it is not one to cache
+[[nodiscard]] inline bool key_of(const lv_draw_image_dsc_t& dsc, const lv_area_t& coords, Key& k) noexcept {
+    if (dsc.tile || dsc.bitmap_mask_src) return false;
+    if (dsc.rotation == 0 && dsc.scale_x == LV_SCALE_NONE && dsc.scale_y == LV_SCALE_NONE) return false;
+    k.src = dsc.src;
+    k.w = lv_area_get_width(&coords);
+    k.h = lv_area_get_height(&coords);
+    k.angle = normalize(dsc.rotation);
+    k.scale_x = dsc.scale_x;
+    k.scale_y = dsc.scale_y;
+    k.pivot = dsc.pivot;
+    k.recolor = dsc.recolor;
+    k.recolor_opa = dsc.recolor_opa;
+    k.antialias = dsc.antialias;
+    return true;
+}
+
+[[nodiscard]] inline lv_area_t transformed(const Key& k) noexcept {
+    lv_area_t a;
+    lv_image_buf_get_transformed_area(&a, k.w, k.h, k.angle, k.scale_x, k.scale_y, &k.pivot);
+    return a;
+}
+
+/// Swap the image's own draw task for a blit of its cached bitmap, or request one
+inline void draw_task_cb(lv_event_t* ev) noexcept {
+    lv_draw_task_t* task = lv_event_get_draw_task(ev);
+    if (lv_draw_task_get_type(task) != LV_DRAW_TASK_TYPE_IMAGE) return;
+    auto* dsc = static_cast<lv_draw_image_dsc_t*>(lv_draw_task_get_draw_dsc(task));
+    auto* obj = static_cast<lv_obj_t*>(lv_event_get_current_target(ev));
+    Image* im = find_image(obj);
+    if (!im || dsc->base.part != LV_PART_MAIN || dsc->src != lv_image_get_src(obj)) return;
+    Key k;
+    if (!key_of(*dsc, task->area, k)) return;
+    Tables& t = tables();
+    if (k.angle % im->step) {
+        ++t.stats.off_grid;
+        return;
+    }
+    Entry* e = find(k);
+    if (!e || !e->buf) {
+        ++t.stats.misses;
+        const lv_area_t area = transformed(k);
+        if (!e && bytes_of(area) <= t.budget) (void)claim(t, k, area, lv_obj_get_display(obj));
+        return;
+    }
+    ++t.stats.hits;
+    e->used = ++t.clock;
+    e->pinned = true;
+    lv_area_t real = e->area;
+    lv_area_move(&real, task->area.x1, task->area.y1);
+    dsc->src = e->buf;
+    dsc->header = e->buf->header;
+    dsc->rotation = 0;
+    dsc->scale_x = LV_SCALE_NONE;
+    dsc->scale_y = LV_SCALE_NONE;
+    dsc->pivot = lv_point_t{0, 0};
+    dsc->recolor_opa = LV_OPA_TRANSP;   // already in the bitmap
+    dsc->image_area = real;
+    task->area = real;
+    task->_real_area = real;
+}
+
+inline void release_image(Tables& t, Image& im) noexcept {
+    const void* src = lv_image_get_src(im.obj);
+    --t.stats.images;
+    im = Image{};
+    // Entries are shared by source: keep them while another image shows it
+    for (const Image& other : t.images) {
+        if (other.obj && lv_image_get_src(other.obj) == src) return;
+    }
+    for (Entry& e : t.entries) {
+        if (e.taken && e.key.src == src && !e.pinned) free_entry(t, e);
+    }
+}
+
+inline void delete_cb(lv_event_t* ev) noexcept {
+    Image* im = find_image(static_cast<lv_obj_t*>(lv_event_get_current_target(ev)));
+    if (im) release_image(tables(), *im);
+}
+
+} // namespace detail
+
+/**
+ * @brief Draw `image` from cached transformed bitmaps at angles on a `step` grid
+ *
+ * `step` is in 0.1 degree units (5 = 0.5 degrees). Returns false if all
+ * LV_CPP_ROTATION_CACHE_IMAGES slots are in use. Enabling again changes
+ * the step.
+ */
+inline bool enable(ObjectView image, int32_t step = 1) noexcept {
+    lv_obj_t* o = image.get();
+    if (!o || !lv_obj_has_class(o, &lv_image_class) || step <= 0) return false;
+    detail::Tables& t = detail::tables();
+    detail::Image* im = detail::find_image(o);
+    if (im) {
+        im->step = step;
+        return true;
+    }
+    im = detail::find_image(nullptr);
+    if (!im) return false;
+    im->obj = o;
+    im->step = step;
+    ++t.stats.images;
+    lv_obj_add_event_cb(o, &detail::draw_task_cb, LV_EVENT_DRAW_TASK_ADDED, nullptr);
+    lv_obj_add_event_cb(o, &detail::delete_cb, LV_EVENT_DELETE, nullptr);
+    lv_obj_add_flag(o, LV_OBJ_FLAG_SEND_DRAW_TASK_EVENTS);
+    lv_display_t* disp = lv_obj_get_display(o);
+    lv_display_remove_event_cb_with_user_data(disp, &detail::refr_ready_cb, nullptr);
+    lv_display_add_event_cb(disp, &detail::refr_ready_cb, LV_EVENT_REFR_READY, nullptr);
+    return true;
+}
+
+/// Let LVGL transform `image` again and free its bitmaps (unless another image shows the same source)
+inline void disable(ObjectView image) noexcept {
+    lv_obj_t* o = image.get();
+    detail::Image* im = o ? detail::find_image(o) : nullptr;
+    if (!im) return;
+    lv_obj_remove_event_cb(o, &detail::draw_task_cb);
+    lv_obj_remove_event_cb(o, &detail::delete_cb);
+    lv_obj_remove_flag(o, LV_OBJ_FLAG_SEND_DRAW_TASK_EVENTS);
+    detail::release_image(detail::tables(), *im);
+    lv_obj_invalidate(o);
+}
+
+/// Whether the rotation cache is enabled for `image`
+[[nodiscard]] inline bool enabled(ObjectView image) noexcept {
+    return image.get() && detail::find_image(image.get());
+}
+
+/// Set `image`'s rotation to `angle` (0.1 degree units) rounded to its step
+inline void rotate(ObjectView image, int32_t angle) noexcept {
+    const detail::Image* im = image.get() ? detail::find_image(image.get()) : nullptr;
+    const int32_t step = im ? im->step : 1;
+    const int32_t half = angle < 0 ? -step / 2 : step / 2;
+    lv_image_set_rotation(image.get(), (angle + half) / step * step);
+}
+
+/**
+ * @brief Render `image` at every angle of its step grid now
+ *
+ * Meant for small images: the whole turn (3600 / step bitmaps at the
+ * image's current source, scale, pivot and recolor) must fit the free
+ * slots and the budget, else nothing is rendered and false is returned.
+ * Precomputed bitmaps are not evicted for the budget. Call outside
+ * rendering, after the image has its source.
+ */
+inline bool precompute(ObjectView image) noexcept {
+    lv_obj_t* o = image.get();
+    const detail::Image* im = o ? detail::find_image(o) : nullptr;
+    if (!im) return false;
+    detail::Tables& t = detail::tables();
+    lv_image_header_t header;
+    const void* src = lv_image_get_src(o);
+    if (!src || lv_image_decoder_get_info(src, &header) != LV_RESULT_OK) return false;
+    detail::Key k;
+    k.src = src;
+    k.w = static_cast<int32_t>(header.w);
+    k.h = static_cast<int32_t>(header.h);
+    k.scale_x = lv_image_get_scale_x(o);
+    k.scale_y = lv_image_get_scale_y(o);
+    lv_image_get_pivot(o, &k.pivot);
+    k.recolor = lv_obj_get_style_image_recolor(o, LV_PART_MAIN);
+    k.recolor_opa = lv_obj_get_style_image_recolor_opa(o, LV_PART_MAIN);
+    k.antialias = lv_image_get_antialias(o);
+
+    // Check the whole set first: slots not yet taken by it, and its bytes
+    uint32_t slots = 0, need = 0;
+    for (int32_t a = 0; a < 3600; a += im->step) {
+        k.angle = a;
+        const detail::Entry* e = detail::find(k);
+        if (e && e->buf) continue;
+        if (!e) ++slots;
+        need += detail::bytes_of(detail::transformed(k));
+    }
+    uint32_t free_slots = 0, evictable = 0;
+    for (const detail::Entry& e : t.entries) {
+        if (!e.taken) ++free_slots;
+        else if (e.buf && !e.pinned && !e.kept) evictable += e.buf->data_size;
+    }
+    if (slots > free_slots || t.stats.bytes - evictable + need > t.budget) return false;
+
+    lv_display_t* disp = lv_obj_get_display(o);
+    bool ok = true;
+    for (int32_t a = 0; a < 3600 && ok; a += im->step) {
+        k.angle = a;
+        detail::Entry* e = detail::find(k);
+        if (!e) e = detail::claim(t, k, detail::transformed(k), disp);
+        if (!e) {
+            ok = false;
+            break;
+        }
+        e->kept = true;
+        e->failed = false;
+        if (!e->buf) ok = detail::render(t, *e);
+    }
+    return ok;
+}
+
+/// Set the bitmap byte budget; entries over it are evicted (pinned and precomputed ones stay)
+inline void budget(uint32_t bytes) noexcept {
+    detail::Tables& t = detail::tables();
+    t.budget = bytes;
+    (void)detail::reserve(t, 0);
+}
+
+[[nodiscard]] inline uint32_t budget() noexcept { return detail::tables().budget; }
+
+[[nodiscard]] inline Stats stats() noexcept { return detail::tables().stats; }
+
+/// Zero the hit/miss/render counters (sizes are kept)
+inline void reset_stats() noexcept {
+    Stats& s = detail::tables().stats;
+    s.renders = s.hits = s.misses = s.off_grid = 0;
+}
+
+/// Free every unpinned bitmap, precomputed ones included
+inline void drop() noexcept {
+    detail::Tables& t = detail::tables();
+    for (detail::Entry& e : t.entries) {
+        if (e.taken && !e.pinned) detail::free_entry(t, e);
+    }
+}
+
+} // namespace lv::rotation_cache
+
+#endif // LV_USE_IMAGE
@@ -0,0 +1,471 @@
+#pragma once
+
+/**
+ * @file shadow_cache.hpp
+ * @brief Cached box-shadow and rounded-corner bitmaps, drawn as 9-slices
+ *
+ * The SW renderer blurs a shadow's corners again for every object it
+ * draws, so a screen of same-looking cards pays for the same blur once
+ * per card and frame. The shape of a shadow only depends on its corner
+ * radius and blur width: the spread and the card size just move the
+ * corners apart. This cache keeps, per (radius, width):
+ *
+ * - four A8 corner tiles (the blurred rounded corner, mirrored),
+ * - four 1-pixel edge profiles, stretched along the sides,
+ *
+ * and draws the rest as a plain fill, so one entry serves every card
+ * size with that radius and blur. With a blur width of 0 the tiles are
+ * the anti-aliased rounded-corner masks, which fill_rounded() uses for
+ * rounded fills.
+ *
+ * @code
+ * lv::shadow_cache::budget(32 * 1024);
+ * lv::shadow_cache::bake_shadow(card);        // card's style shadow via the cache
+ *
+ * // or from custom draw code
+ * lv::BoxShadowDsc sh;
+ * sh.color(lv::rgb(0x000000)).width(24).radius(12).opa(LV_OPA_40);
+ * lv::shadow_cache::draw(layer, sh, card_area);
+ * @endcode
+ *
+ * The blur is a box blur of the anti-aliased core shape over the same
+ * extent LVGL uses (width / 2 + 1 outside the core), so cached shadows
+ * match LVGL's in size and closely in falloff. Shapes too small for the
+ * 9-slice (the core shorter than twice radius + blur) go to
+ * lv_draw_box_shadow() unchanged.
+ *
+ * Pieces handed to draw tasks stay pinned until the display's next
+ * REFR_READY; when every entry is pinned, the draw falls back to LVGL.
+ *
+ * Heap allocation: NONE in the wrapper (fixed table; pieces come from
+ * the DrawBufPool; the blur scratch of a miss comes from lv_malloc()
+ * and is freed right away)
+ */
+
+#include <lvgl.h>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include "draw_rect.hpp"
+#include "draw_buf.hpp"
+#include "../core/object.hpp"
+
+#ifndef LV_CPP_SHADOW_CACHE
+/// Cached (radius, blur width) combinations
+#define LV_CPP_SHADOW_CACHE 8
+#endif
+
+#ifndef LV_CPP_SHADOW_CACHE_BYTES
+/// Default piece bytes kept before the least recently used entries go (see budget())
+#define LV_CPP_SHADOW_CACHE_BYTES (64u * 1024u)
+#endif
+
+namespace lv::shadow_cache {
+
+/// Counters of the shadow/mask cache
+struct Stats {
+    uint32_t entries;
+    uint32_t bytes;       ///< piece pixel bytes
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t cached;      ///< draws served by 9-slice pieces
+    uint32_t fallbacks;   ///< draws left to LVGL (too small, or no free entry)
+};
+
+namespace detail {
+
+enum Piece : uint8_t { top_left, top_right, bottom_left, bottom_right, top, bottom, left, right, piece_count };
+
+struct Entry {
+    int32_t radius = 0;
+    int32_t width = 0;               ///< blur width
+    int32_t corner = 0;              ///< tile size: pad + radius + half blur
+    lv_draw_buf_t* pieces[piece_count] = {};
+    uint32_t bytes = 0;
+    uint32_t used = 0;               ///< LRU stamp
+    bool pinned = false;             ///< read by a queued draw task
+};
+
+struct Tables {
+    Entry entries[LV_CPP_SHADOW_CACHE];
+    uint32_t budget = LV_CPP_SHADOW_CACHE_BYTES;
+    uint32_t clock = 0;
+    uint32_t pinned = 0;
+    Stats stats{};
+};
+
+[[nodiscard]] inline Tables& tables() noexcept {
+    static Tables t;
+    return t;
+}
+
+/// Pixels the shadow reaches outside its core (same as LVGL's SW renderer)
+[[nodiscard]] constexpr int32_t pad(int32_t width) noexcept { return width / 2 + 1; }
+
+/// Size of one corner tile
+[[nodiscard]] constexpr int32_t corner_size(int32_t radius, int32_t width) noexcept {
+    return pad(width) + radius + width / 2;
+}
+
+/// Anti-aliased coverage (0..255) of a rounded square of radius `r` whose corner circle is centred at (c, c)
+[[nodiscard]] inline uint8_t coverage(int32_t x, int32_t y, int32_t origin, int32_t r) noexcept {
+    if (x < origin || y < origin) return 0;
+    const int32_t c = origin + r;
+    if (x >= c || y >= c) return 255;
+    const float dx = static_cast<float>(c - x) - 0.5f;
+    const float dy = static_cast<float>(c - y) - 0.5f;
+    const float d = static_cast<float>(r) + 0.5f - std::sqrt(dx * dx + dy * dy);
+    return d <= 0.0f ? 0 : d >= 1.0f ? 255 : static_cast<uint8_t>(d * 255.0f);
+}
+
+[[nodiscard]] inline lv_draw_buf_t* piece_buf(uint32_t w, uint32_t h) noexcept {
+    return lv_draw_buf_create_ex(draw::pool_handlers(), w, h, LV_COLOR_FORMAT_A8, 0);
+}
+
+inline void free_entry(Tables& t, Entry& e) noexcept {
+    if (e.bytes) {   // counted once fully rendered
+        t.stats.bytes -= e.bytes;
+        --t.stats.entries;
+    }
+    for (lv_draw_buf_t*& p : e.pieces) {
+        if (!p) continue;
+        lv_image_cache_drop(p);
+        lv_draw_buf_destroy(p);
+    }
+    e = Entry{};
+}
+
+/**
+ * Blur the top-left quadrant of the shape and cut it into the pieces.
+ *
+ * The core starts `pad` pixels in; the quadrant's blurred values are
+ * needed up to the tile edge `c`, which reads the mask `half` further.
+ */
+[[nodiscard]] inline bool render(Entry& e) noexcept {
+    const int32_t half = e.width / 2;
+    const int32_t origin = pad(e.width);
+    const int32_t c = e.corner;
+    const int32_t q = c + half + 1;             // mask extent read by the blur
+    auto* mask = static_cast<uint8_t*>(lv_malloc(static_cast<size_t>(q) * q + static_cast<size_t>(q) * (c + 1)));
+    if (!mask) return false;
+    uint8_t* rows = mask + static_cast<size_t>(q) * q;   // horizontal pass, q rows x (c + 1)
+    for (int32_t y = 0; y < q; ++y) {
+        for (int32_t x = 0; x < q; ++x) mask[y * q + x] = coverage(x, y, origin, e.radius);
+    }
+    const int32_t win = 2 * half + 1;
+    for (int32_t y = 0; y < q; ++y) {
+        for (int32_t x = 0; x <= c; ++x) {
+            uint32_t sum = 0;
+            for (int32_t k = x - half; k <= x + half; ++k) sum += k < 0 ? 0 : mask[y * q + k];
+            rows[y * (c + 1) + x] = static_cast<uint8_t>(sum / win);
+        }
+    }
+    // Vertical pass straight into the quadrant (c + 1)^2, reusing the mask memory
+    uint8_t* quad = mask;
+    for (int32_t x = 0; x <= c; ++x) {
+        for (int32_t y = 0; y <= c; ++y) {
+            uint32_t sum = 0;
+            for (int32_t k = y - half; k <= y + half; ++k) sum += k < 0 ? 0 : rows[k * (c + 1) + x];
+            quad[y * (c + 1) + x] = static_cast<uint8_t>(sum / win);
+        }
+    }
+
+    const uint32_t uc = static_cast<uint32_t>(c);
+    e.pieces[top_left] = piece_buf(uc, uc);
+    e.pieces[top_right] = piece_buf(uc, uc);
+    e.pieces[bottom_left] = piece_buf(uc, uc);
+    e.pieces[bottom_right] = piece_buf(uc, uc);
+    e.pieces[top] = piece_buf(1, uc);
+    e.pieces[bottom] = piece_buf(1, uc);
+    e.pieces[left] = piece_buf(uc, 1);
+    e.pieces[right] = piece_buf(uc, 1);
+    bool ok = true;
+    for (lv_draw_buf_t* p : e.pieces) ok = ok && p;
+    if (ok) {
+        auto px = [](lv_draw_buf_t* b, int32_t x, int32_t y) noexcept -> uint8_t& {
+            return b->data[y * b->header.stride + x];
+        };
+        for (int32_t y = 0; y < c; ++y) {
+            for (int32_t x = 0; x < c; ++x) {
+                const uint8_t a = quad[y * (c + 1) + x];
+                px(e.pieces[top_left], x, y) = a;
+                px(e.pieces[top_right], c - 1 - x, y) = a;
+                px(e.pieces[bottom_left], x, c - 1 - y) = a;
+                px(e.pieces[bottom_right], c - 1 - x, c - 1 - y) = a;
+            }
+            // The middle column/row is past every corner: the side profile (the shape is symmetric)
+            const uint8_t a = quad[y * (c + 1) + c];
+            px(e.pieces[top], 0, y) = a;
+            px(e.pieces[bottom], 0, c - 1 - y) = a;
+            px(e.pieces[left], y, 0) = a;
+            px(e.pieces[right], c - 1 - y, 0) = a;
+        }
+        for (lv_draw_buf_t* p : e.pieces) e.bytes += p->data_size;
+    }
+    lv_free(mask);
+    return ok;
+}
+
+/// A free entry, else the oldest unpinned one (or nullptr); `occupied_only` skips free entries
+[[nodiscard]] inline Entry* victim(Tables& t, bool occupied_only = false) noexcept {
+    Entry* v = nullptr;
+    for (Entry& e : t.entries) {
+        if (!e.pieces[0]) {
+            if (!occupied_only) return &e;
+            continue;
+        }
+        if (!e.pinned && (!v || e.used < v->used)) v = &e;
+    }
+    return v;
+}
+
+/// Cached pieces for (radius, width), rendered on a miss; nullptr if none can be made
+[[nodiscard]] inline Entry* entry(int32_t radius, int32_t width) noexcept {
+    Tables& t = tables();
+    for (Entry& e : t.entries) {
+        if (e.pieces[0] && e.radius == radius && e.width == width) {
+            ++t.stats.hits;
+            e.used = ++t.clock;
+            return &e;
+        }
+    }
+    ++t.stats.misses;
+    const int32_t c = corner_size(radius, width);
+    const uint32_t stride = lv_draw_buf_width_to_stride(static_cast<uint32_t>(c), LV_COLOR_FORMAT_A8);
+    const uint32_t need = 4 * stride * static_cast<uint32_t>(c) + 2 * stride +
+                          2 * lv_draw_buf_width_to_stride(1, LV_COLOR_FORMAT_A8) * static_cast<uint32_t>(c);
+    if (need > t.budget) return nullptr;
+    // Trim to the budget (pinned entries cannot go: then draw uncached), then take a slot
+    while (t.stats.bytes + need > t.budget) {
+        Entry* old = victim(t, true);
+        if (!old) return nullptr;
+        free_entry(t, *old);
+    }
+    Entry* e = victim(t);
+    if (!e) return nullptr;
+    free_entry(t, *e);
+    e->radius = radius;
+    e->width = width;
+    e->corner = c;
+    if (!render(*e)) {
+        free_entry(t, *e);
+        return nullptr;
+    }
+    e->used = ++t.clock;
+    ++t.stats.entries;
+    t.stats.bytes += e->bytes;
+    return e;
+}
+
+inline void refr_ready_cb(lv_event_t*) noexcept {
+    Tables& t = tables();
+    for (Entry& e : t.entries) e.pinned = false;
+    t.pinned = 0;
+}
+
+/// Keep `e` until the next refresh is done (queued draw tasks point at its pieces)
+inline void pin(Entry& e) noexcept {
+    Tables& t = tables();
+    if (e.pinned) return;
+    e.pinned = true;
+    if (t.pinned++) return;
+    lv_display_t* disp = lv_display_get_default();
+    if (!disp) return;
+    lv_display_remove_event_cb_with_user_data(disp, &refr_ready_cb, nullptr);
+    lv_display_add_event_cb(disp, &refr_ready_cb, LV_EVENT_REFR_READY, nullptr);
+}
+
+/// Draw piece `p` at (x, y), stretched to `len` pixels along its 1-pixel axis if it is a side
+inline void draw_piece(lv_layer_t* layer, const Entry& e, Piece p, int32_t x, int32_t y, int32_t len,
+                       lv_color_t color, lv_opa_t opa) noexcept {
+    const lv_draw_buf_t* buf = e.pieces[p];
+    lv_draw_image_dsc_t img;
+    lv_draw_image_dsc_init(&img);
+    img.src = buf;
+    img.opa = opa;
+    img.recolor = color;                 // A8 images are drawn in the recolor color
+    img.recolor_opa = LV_OPA_COVER;
+    img.antialias = 0;
+    img.pivot = lv_point_t{0, 0};
+    lv_area_t coords{x, y, x + static_cast<int32_t>(buf->header.w) - 1, y + static_cast<int32_t>(buf->header.h) - 1};
+    if (p == top || p == bottom) img.scale_x = len * LV_SCALE_NONE;
+    if (p == left || p == right) img.scale_y = len * LV_SCALE_NONE;
+    lv_draw_image(layer, &img, &coords);
+}
+
+/// Draw the 9-slice of `e` around `core`; the middle is filled unless `skip_middle`
+inline void draw_slices(lv_layer_t* layer, Entry& e, const lv_area_t& core, lv_color_t color, lv_opa_t opa,
+                        bool skip_middle) noexcept {
+    const int32_t c = e.corner;
+    const int32_t p = pad(e.width);
+    const lv_area_t out{core.x1 - p, core.y1 - p, core.x2 + p, core.y2 + p};
+    const int32_t mid_w = lv_area_get_width(&out) - 2 * c;
+    const int32_t mid_h = lv_area_get_height(&out) - 2 * c;
+    pin(e);
+    draw_piece(layer, e, top_left, out.x1, out.y1, 0, color, opa);
+    draw_piece(layer, e, top_right, out.x2 - c + 1, out.y1, 0, color, opa);
+    draw_piece(layer, e, bottom_left, out.x1, out.y2 - c + 1, 0, color, opa);
+    draw_piece(layer, e, bottom_right, out.x2 - c + 1, out.y2 - c + 1, 0, color, opa);
+    draw_piece(layer, e, top, out.x1 + c, out.y1, mid_w, color, opa);
+    draw_piece(layer, e, bottom, out.x1 + c, out.y2 - c + 1, mid_w, color, opa);
+    draw_piece(layer, e, left, out.x1, out.y1 + c, mid_h, color, opa);
+    draw_piece(layer, e, right, out.x2 - c + 1, out.y1 + c, mid_h, color, opa);
+    if (skip_middle) return;
+    lv_draw_fill_dsc_t fill;
+    lv_draw_fill_dsc_init(&fill);
+    fill.color = color;
+    fill.opa = opa;
+    const lv_area_t mid{out.x1 + c, out.y1 + c, out.x2 - c, out.y2 - c};
+    lv_draw_fill(layer, &fill, &mid);
+}
+
+} // namespace detail
+
+namespace detail {
+
+/// draw() without the fallback: false if the shadow cannot come from the cache
+[[nodiscard]] inline bool draw_cached(lv_layer_t* layer, const lv_draw_box_shadow_dsc_t& dsc,
+                                      const lv_area_t& coords) noexcept {
+    const lv_area_t core{coords.x1 + dsc.ofs_x - dsc.spread, coords.y1 + dsc.ofs_y - dsc.spread,
+                         coords.x2 + dsc.ofs_x + dsc.spread, coords.y2 + dsc.ofs_y + dsc.spread};
+    const int32_t w = lv_area_get_width(&core);
+    const int32_t h = lv_area_get_height(&core);
+    if (w <= 0 || h <= 0) return true;
+    const int32_t short_side = w < h ? w : h;
+    const int32_t radius = dsc.radius > short_side / 2 ? short_side / 2 : dsc.radius;
+    const int32_t width = dsc.width < 0 ? 0 : dsc.width;
+    // The side profiles must be clear of both corners' blur
+    const bool fits = short_side >= 2 * (radius + width / 2) + 1;
+    Entry* e = fits ? entry(radius, width) : nullptr;
+    if (!e) return false;
+    ++tables().stats.cached;
+    // The middle sits `radius + width / 2` inside the core; skip it where the background covers it
+    const int32_t inset = radius + width / 2;
+    const lv_area_t mid{core.x1 + inset, core.y1 + inset, core.x2 - inset, core.y2 - inset};
+    draw_slices(layer, *e, core, dsc.color, dsc.opa, dsc.bg_cover && lv_area_is_in(&mid, &coords, 0));
+    return true;
+}
+
+} // namespace detail
+
+/**
+ * @brief Draw a box shadow from cached 9-slice pieces
+ *
+ * Same geometry as lv_draw_box_shadow(): `coords` is the object, the
+ * shadow's core is it moved by the offset and grown by the spread.
+ *
+ * @return true if drawn from the cache, false if handed to lv_draw_box_shadow()
+ */
+inline bool draw(lv_layer_t* layer, const lv_draw_box_shadow_dsc_t& dsc, const lv_area_t& coords) noexcept {
+    if (dsc.opa <= LV_OPA_MIN) return true;
+    if (detail::draw_cached(layer, dsc, coords)) return true;
+    ++detail::tables().stats.fallbacks;
+    lv_draw_box_shadow(layer, &dsc, &coords);
+    return false;
+}
+
+/// BoxShadowDsc overload of draw()
+inline bool draw(lv_layer_t* layer, const BoxShadowDsc& dsc, const lv_area_t& coords) noexcept {
+    return draw(layer, *dsc.get(), coords);
+}
+
+/**
+ * @brief Fill a rounded rectangle from cached anti-aliased corner masks
+ *
+ * @return true if drawn from the cache, false if handed to lv_draw_fill()
+ */
+inline bool fill_rounded(lv_layer_t* layer, const lv_area_t& area, int32_t radius, lv_color_t color,
+                         lv_opa_t opa = LV_OPA_COVER) noexcept {
+    detail::Tables& t = detail::tables();
+    const int32_t w = lv_area_get_width(&area);
+    const int32_t h = lv_area_get_height(&area);
+    if (w <= 0 || h <= 0 || opa <= LV_OPA_MIN) return true;
+    const int32_t short_side = w < h ? w : h;
+    const int32_t r = radius > short_side / 2 ? short_side / 2 : radius;
+    // Blur width 0: the tiles are the anti-aliased corners; their pad ring is fully transparent
+    detail::Entry* e = r > 0 && short_side >= 2 * r + 1 ? detail::entry(r, 0) : nullptr;
+    if (!e) {
+        if (r > 0) ++t.stats.fallbacks;
+        lv_draw_fill_dsc_t fill;
+        lv_draw_fill_dsc_init(&fill);
+        fill.color = color;
+        fill.opa = opa;
+        fill.radius = radius;
+        lv_draw_fill(layer, &fill, &area);
+        return false;
+    }
+    ++t.stats.cached;
+    detail::draw_slices(layer, *e, area, color, opa, false);
+    return true;
+}
+
+namespace detail {
+
+inline void draw_task_cb(lv_event_t* ev) noexcept {
+    lv_draw_task_t* task = lv_event_get_draw_task(ev);
+    if (lv_draw_task_get_type(task) != LV_DRAW_TASK_TYPE_BOX_SHADOW) return;
+    auto* dsc = static_cast<lv_draw_box_shadow_dsc_t*>(lv_draw_task_get_draw_dsc(task));
+    if (dsc->base.part != LV_PART_MAIN) return;
+    lv_area_t coords;
+    lv_obj_get_coords(static_cast<lv_obj_t*>(lv_event_get_current_target(ev)), &coords);
+    if (dsc->opa <= LV_OPA_MIN) return;
+    if (draw_cached(dsc->base.layer, *dsc, coords)) {
+        dsc->opa = LV_OPA_TRANSP;   // LVGL's own shadow task now draws nothing
+    } else {
+        ++tables().stats.fallbacks;
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Draw `obj`'s style box shadow from the cache on every redraw
+ *
+ * Replaces the main part's shadow draw task as LVGL adds it (through
+ * LV_EVENT_DRAW_TASK_ADDED), so the object's shadow styles stay the
+ * single source of truth.
+ */
+inline void bake_shadow(ObjectView obj) noexcept {
+    lv_obj_remove_event_cb(obj.get(), &detail::draw_task_cb);
+    lv_obj_add_event_cb(obj.get(), &detail::draw_task_cb, LV_EVENT_DRAW_TASK_ADDED, nullptr);
+    lv_obj_add_flag(obj.get(), LV_OBJ_FLAG_SEND_DRAW_TASK_EVENTS);
+    lv_obj_invalidate(obj.get());
+}
+
+/// Let LVGL draw `obj`'s shadow again
+inline void unbake_shadow(ObjectView obj) noexcept {
+    if (!lv_obj_remove_event_cb(obj.get(), &detail::draw_task_cb)) return;
+    lv_obj_remove_flag(obj.get(), LV_OBJ_FLAG_SEND_DRAW_TASK_EVENTS);
+    lv_obj_invalidate(obj.get());
+}
+
+/// Set the piece byte budget; entries over it are evicted (pinned ones at their next use)
+inline void budget(uint32_t bytes) noexcept {
+    detail::Tables& t = detail::tables();
+    t.budget = bytes;
+    while (t.stats.bytes > t.budget) {
+        detail::Entry* old = detail::victim(t, true);
+        if (!old) break;
+        detail::free_entry(t, *old);
+    }
+}
+
+[[nodiscard]] inline uint32_t budget() noexcept { return detail::tables().budget; }
+
+[[nodiscard]] inline Stats stats() noexcept { return detail::tables().stats; }
+
+/// Zero the hit/miss/draw counters (sizes are kept)
+inline void reset_stats() noexcept {
+    Stats& s = detail::tables().stats;
+    s.hits = s.misses = s.cached = s.fallbacks = 0;
+}
+
+/// Free every unpinned entry
+inline void drop() noexcept {
+    detail::Tables& t = detail::tables();
+    for (detail::Entry& e : t.entries) {
+        if (!e.pinned) detail::free_entry(t, e);
+    }
+}
+
+} // namespace lv::shadow_cache
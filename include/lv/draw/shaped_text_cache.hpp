@@ -0,0 +1,410 @@
+#pragma once
+
+/**
+ * @file shaped_text_cache.hpp
+ * @brief Cached shaped and bidi-reordered label text, drawn as A8 blits
+ *
+ * LVGL shapes Arabic and Persian text when it is set, but the SW renderer
+ * breaks the lines, runs the bidi algorithm over each line (with an
+ * lv_malloc per line) and looks up every glyph again on every draw of a
+ * label. RTL screens pay that per redraw, although the text did not
+ * change. For labels enabled here, the rendered result is kept per
+ * (text, font, base direction, text box size, spacing, alignment) as an
+ * A8 coverage bitmap and drawn as a recolored image:
+ *
+ * @code
+ * #include <lv/draw/shaped_text_cache.hpp>
+ *
+ * lv::shaped_text_cache::budget(96 * 1024);
+ * lv::shaped_text_cache::enable_tree(settings_screen);   // every label on it
+ * lv::shaped_text_cache::enable(title);
+ * ...
+ * lv::shaped_text_cache::dump();   // hits, renders, bytes held
+ * @endcode
+ *
+ * Color and opacity are applied at draw time, so pressed/checked styles
+ * and fades keep hitting. Labels with the same text and style share an
+ * entry; a changed text is a new key and the old bitmap ages out. A miss
+ * is drawn by LVGL and its bitmap rendered at the display's REFR_READY,
+ * as the rotation cache does. Bitmaps handed to draw tasks stay pinned
+ * until then; the least recently used ones go when the budget() is
+ * exceeded.
+ *
+ * Draws that cannot be served from a still bitmap go to LVGL unchanged:
+ * scrolling labels (LV_LABEL_LONG_MODE_SCROLL*), selected text, text
+ * outlines and sub-pixel fonts. Entries are keyed by the font pointer:
+ * drop() before freeing a font whose address may be reused.
+ *
+ * Not included by lv.hpp: it reads lv_draw_task_t::area and
+ * lv_display_t::layer_head, neither of which is public. Checked against
+ * LVGL 9.4 (see LV_CPP_INTERNALS_OK).
+ *
+ * Heap allocation: NONE in the wrapper (fixed table; bitmaps, and the
+ * ARGB8888 scratch a miss is rendered into, come from the DrawBufPool)
+ */
+
+#include <lvgl.h>
+#include "../core/version.hpp"
+
+#if !LV_CPP_INTERNALS_OK
+#error "shaped_text_cache.hpp reads LVGL internals checked against LVGL 9.4; see LV_CPP_INTERNALS_OK"
+#endif
+
+#include <src/draw/lv_draw_private.h>             // lv_draw_task_t::area
+#include <src/display/lv_display_private.h>       // lv_display_t::layer_head
+#include <cstdint>
+#include "draw_buf.hpp"
+#include "../core/object.hpp"
+#include "../core/text_cache.hpp"
+
+#if LV_USE_LABEL
+
+#ifndef LV_CPP_SHAPED_TEXT_CACHE
+/// Cached (text, font, direction, box) bitmaps of all labels together
+#define LV_CPP_SHAPED_TEXT_CACHE 32
+#endif
+
+#ifndef LV_CPP_SHAPED_TEXT_CACHE_BYTES
+/// Default bitmap bytes kept before the least recently used entries go (see budget())
+#define LV_CPP_SHAPED_TEXT_CACHE_BYTES (64u * 1024u)
+#endif
+
+namespace lv::shaped_text_cache {
+
+/// Counters of the shaped text cache
+struct Stats {
+    uint32_t entries;    ///< bitmaps rendered and held
+    uint32_t bytes;      ///< bitmap bytes held
+    uint32_t renders;    ///< bitmaps rendered
+    uint32_t hits;       ///< draws served by a bitmap
+    uint32_t misses;     ///< draws left to LVGL (bitmap pending, over budget or no slot)
+    uint32_t skipped;    ///< draws LVGL must do itself (scrolling, selection, outline, sub-pixel font)
+};
+
+namespace detail {
+
+struct Key {
+    uint64_t hash = 0;              ///< text_cache::detail::hash() of the text
+    uint32_t len = 0;
+    const lv_font_t* font = nullptr;
+    int32_t w = 0, h = 0;           ///< text box size
+    int32_t letter_space = 0;
+    int32_t line_space = 0;
+    lv_base_dir_t dir = LV_BASE_DIR_LTR;
+    lv_text_align_t align = LV_TEXT_ALIGN_LEFT;
+    lv_text_flag_t flag = LV_TEXT_FLAG_NONE;
+    lv_text_decor_t decor = LV_TEXT_DECOR_NONE;
+
+    [[nodiscard]] bool operator==(const Key&) const noexcept = default;
+};
+
+struct Entry {
+    Key key;
+    lv_obj_t* obj = nullptr;          ///< label to render a requested entry from (nullptr once deleted)
+    lv_draw_label_dsc_t dsc{};        ///< its draw descriptor, text excluded
+    lv_display_t* disp = nullptr;
+    lv_draw_buf_t* buf = nullptr;     ///< nullptr: requested, rendered at REFR_READY
+    uint32_t used = 0;                ///< LRU stamp
+    bool taken = false;
+    bool pinned = false;              ///< read by a queued draw task
+    bool failed = false;              ///< out of memory or budget, or the text changed: drawn by LVGL
+};
+
+struct Tables {
+    Entry entries[LV_CPP_SHAPED_TEXT_CACHE];
+    uint32_t budget = LV_CPP_SHAPED_TEXT_CACHE_BYTES;
+    uint32_t clock = 0;
+    Stats stats{};
+};
+
+[[nodiscard]] inline Tables& tables() noexcept {
+    static Tables t;
+    return t;
+}
+
+[[nodiscard]] inline Entry* find(const Key& k) noexcept {
+    for (Entry& e : tables().entries) {
+        if (e.taken && e.key == k) return &e;
+    }
+    return nullptr;
+}
+
+/// A8 bitmap bytes of a `w` x `h` text box
+[[nodiscard]] inline uint32_t bytes_of(int32_t w, int32_t h) noexcept {
+    return lv_draw_buf_width_to_stride(static_cast<uint32_t>(w), LV_COLOR_FORMAT_A8) * static_cast<uint32_t>(h);
+}
+
+inline void free_entry(Tables& t, Entry& e) noexcept {
+    if (e.buf) {
+        t.stats.bytes -= e.buf->data_size;
+        --t.stats.entries;
+        lv_image_cache_drop(e.buf);
+        lv_draw_buf_destroy(e.buf);
+    }
+    e = Entry{};
+}
+
+/// A free entry, else the oldest evictable one (or nullptr); `occupied_only` skips free entries
+[[nodiscard]] inline Entry* victim(Tables& t, bool occupied_only = false) noexcept {
+    Entry* v = nullptr;
+    for (Entry& e : t.entries) {
+        if (!e.taken) {
+            if (!occupied_only) return &e;
+            continue;
+        }
+        if ((e.buf || e.failed) && !e.pinned && (!v || e.used < v->used)) v = &e;
+    }
+    return v;
+}
+
+/// Make room for `need` more bytes by evicting; false if the budget cannot hold them
+[[nodiscard]] inline bool reserve(Tables& t, uint32_t need) noexcept {
+    while (t.stats.bytes + need > t.budget) {
+        Entry* old = victim(t, true);
+        if (!old) return false;
+        free_entry(t, *old);
+    }
+    return true;
+}
+
+/// Render the text of `e` in white into ARGB8888 scratch and keep its alpha as an A8 bitmap
+[[nodiscard]] inline bool render(Tables& t, Entry& e) noexcept {
+    const char* text = e.obj ? lv_label_get_text(e.obj) : nullptr;
+    uint32_t len = 0;
+    if (!text || text_cache::detail::hash(text, len) != e.key.hash || len != e.key.len) return false;
+    const auto bw = static_cast<uint32_t>(e.key.w);
+    const auto bh = static_cast<uint32_t>(e.key.h);
+    if (!reserve(t, bytes_of(e.key.w, e.key.h))) return false;
+    lv_draw_buf_t* scratch = lv_draw_buf_create_ex(draw::pool_handlers(), bw, bh, LV_COLOR_FORMAT_ARGB8888, 0);
+    if (!scratch) return false;
+    lv_draw_buf_clear(scratch, nullptr);
+    lv_layer_t layer;
+    lv_layer_init(&layer);
+    layer.draw_buf = scratch;
+    layer.color_format = LV_COLOR_FORMAT_ARGB8888;
+    layer.buf_area = lv_area_t{0, 0, static_cast<int32_t>(bw) - 1, static_cast<int32_t>(bh) - 1};
+    layer._clip_area = layer.buf_area;
+    layer.phy_clip_area = layer.buf_area;
+
+    lv_draw_label_dsc_t dsc = e.dsc;
+    dsc.base = lv_draw_dsc_base_t{};     // no obj: no DRAW_TASK_ADDED back into the cache
+    dsc.text = text;
+    dsc.text_local = 0;
+    dsc.color = lv_color_white();
+    dsc.opa = LV_OPA_COVER;
+    dsc.blend_mode = LV_BLEND_MODE_NORMAL;
+    dsc.hint = nullptr;
+
+    // Finish the draw tasks synchronously, as rotation_cache::detail::render() does
+    lv_display_t* disp = e.disp;
+    lv_display_t* disp_old = lv_refr_get_disp_refreshing();
+    lv_layer_t* head_old = disp->layer_head;
+    disp->layer_head = &layer;
+    lv_refr_set_disp_refreshing(disp);
+    lv_draw_label(&layer, &dsc, &layer.buf_area);
+    while (layer.draw_task_head) {
+        lv_draw_dispatch_wait_for_request();
+        if (!lv_draw_dispatch_layer(disp, &layer)) {
+            lv_draw_wait_for_finish();
+            lv_draw_dispatch_request();
+        }
+    }
+    disp->layer_head = head_old;
+    lv_refr_set_disp_refreshing(disp_old);
+
+    lv_draw_buf_t* buf = lv_draw_buf_create_ex(draw::pool_handlers(), bw, bh, LV_COLOR_FORMAT_A8, 0);
+    if (buf) {
+        for (uint32_t y = 0; y < bh; ++y) {
+            const uint8_t* src = scratch->data + y * scratch->header.stride;
+            uint8_t* dst = buf->data + y * buf->header.stride;
+            for (uint32_t x = 0; x < bw; ++x) dst[x] = src[4 * x + 3];
+        }
+    }
+    lv_draw_buf_destroy(scratch);
+    if (!buf) return false;
+
+    e.buf = buf;
+    t.stats.bytes += buf->data_size;
+    ++t.stats.entries;
+    ++t.stats.renders;
+    return true;
+}
+
+/// Unpin the bitmaps of the finished frame and render the ones requested during it
+inline void refr_ready_cb(lv_event_t* ev) noexcept {
+    auto* disp = static_cast<lv_display_t*>(lv_event_get_current_target(ev));
+    Tables& t = tables();
+    for (Entry& e : t.entries) {
+        if (e.disp == disp) e.pinned = false;
+    }
+    for (Entry& e : t.entries) {
+        if (!e.taken || e.buf || e.failed || e.disp != disp) continue;
+        // Keep the slot so the text is not requested again every frame; it ages out like the others
+        e.failed = !render(t, e);
+        e.obj = nullptr;
+    }
+}
+
+/// The text of a label draw task as a cache key; false if LVGL has to draw it
+[[nodiscard]] inline bool key_of(const lv_draw_label_dsc_t& dsc, const lv_area_t& coords, Key& k) noexcept {
+    if (!dsc.text || !dsc.font || dsc.ofs_x || dsc.ofs_y || dsc.rotation) return false;
+    if (dsc.sel_start != LV_DRAW_LABEL_NO_TXT_SEL && dsc.sel_start != dsc.sel_end) return false;
+    if (dsc.outline_stroke_width > 0 || dsc.font->subpx != LV_FONT_SUBPX_NONE) return false;
+    k.hash = text_cache::detail::hash(dsc.text, k.len);
+    if (!k.len) return false;
+    k.font = dsc.font;
+    k.w = lv_area_get_width(&coords);
+    k.h = lv_area_get_height(&coords);
+    k.letter_space = dsc.letter_space;
+    k.line_space = dsc.line_space;
+    k.dir = dsc.bidi_dir;
+    k.align = dsc.align;
+    k.flag = dsc.flag;
+    k.decor = dsc.decor;
+    return k.w > 0 && k.h > 0;
+}
+
+/// Blit the label's cached bitmap in its text color and blank its own draw task, or request one
+inline void draw_task_cb(lv_event_t* ev) noexcept {
+    lv_draw_task_t* task = lv_event_get_draw_task(ev);
+    if (lv_draw_task_get_type(task) != LV_DRAW_TASK_TYPE_LABEL) return;
+    auto* dsc = static_cast<lv_draw_label_dsc_t*>(lv_draw_task_get_draw_dsc(task));
+    if (dsc->base.part != LV_PART_MAIN || dsc->opa <= LV_OPA_MIN) return;
+    Tables& t = tables();
+    Key k;
+    if (!key_of(*dsc, task->area, k)) {
+        ++t.stats.skipped;
+        return;
+    }
+    Entry* e = find(k);
+    if (!e || !e->buf) {
+        ++t.stats.misses;
+        if (e || bytes_of(k.w, k.h) > t.budget) return;
+        e = victim(t);
+        if (!e) return;
+        free_entry(t, *e);
+        e->key = k;
+        e->obj = static_cast<lv_obj_t*>(lv_event_get_current_target(ev));
+        e->dsc = *dsc;
+        e->dsc.text = nullptr;
+        e->disp = lv_obj_get_display(e->obj);
+        e->taken = true;
+        e->used = ++t.clock;
+        return;
+    }
+    ++t.stats.hits;
+    e->used = ++t.clock;
+    e->pinned = true;
+    lv_draw_image_dsc_t img;
+    lv_draw_image_dsc_init(&img);
+    img.base = dsc->base;
+    img.src = e->buf;
+    img.recolor = dsc->color;        // A8 images are drawn in the recolor color
+    img.recolor_opa = LV_OPA_COVER;
+    img.opa = dsc->opa;
+    img.blend_mode = dsc->blend_mode;
+    const lv_area_t area = task->area;
+    lv_draw_image(dsc->base.layer, &img, &area);
+    dsc->opa = LV_OPA_TRANSP;          // LVGL's own label task now draws nothing
+}
+
+/// A deleted label can no longer render its pending entries
+inline void delete_cb(lv_event_t* ev) noexcept {
+    auto* obj = static_cast<lv_obj_t*>(lv_event_get_current_target(ev));
+    for (Entry& e : tables().entries) {
+        if (e.obj == obj) {
+            e.obj = nullptr;
+            if (!e.buf) e.failed = true;
+        }
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Draw `label`'s text from cached bitmaps from now on
+ *
+ * Returns false if `label` is not an lv_label. Enabling again is harmless.
+ */
+inline bool enable(ObjectView label) noexcept {
+    lv_obj_t* o = label.get();
+    if (!o || !lv_obj_has_class(o, &lv_label_class)) return false;
+    lv_obj_remove_event_cb(o, &detail::draw_task_cb);
+    lv_obj_remove_event_cb(o, &detail::delete_cb);
+    lv_obj_add_event_cb(o, &detail::draw_task_cb, LV_EVENT_DRAW_TASK_ADDED, nullptr);
+    lv_obj_add_event_cb(o, &detail::delete_cb, LV_EVENT_DELETE, nullptr);
+    lv_obj_add_flag(o, LV_OBJ_FLAG_SEND_DRAW_TASK_EVENTS);
+    lv_display_t* disp = lv_obj_get_display(o);
+    lv_display_remove_event_cb_with_user_data(disp, &detail::refr_ready_cb, nullptr);
+    lv_display_add_event_cb(disp, &detail::refr_ready_cb, LV_EVENT_REFR_READY, nullptr);
+    return true;
+}
+
+/// enable() every label in `parent`'s tree (an RTL screen); returns how many
+inline uint32_t enable_tree(ObjectView parent) noexcept {
+    lv_obj_t* p = parent.get();
+    if (!p) return 0;
+    uint32_t n = enable(p) ? 1 : 0;
+    const uint32_t cnt = lv_obj_get_child_count(p);
+    for (uint32_t i = 0; i < cnt; ++i) n += enable_tree(ObjectView(lv_obj_get_child(p, static_cast<int32_t>(i))));
+    return n;
+}
+
+/// Let LVGL draw `label`'s text again (its bitmaps stay shared until they age out)
+inline void disable(ObjectView label) noexcept {
+    lv_obj_t* o = label.get();
+    if (!o || !lv_obj_remove_event_cb(o, &detail::draw_task_cb)) return;
+    lv_obj_remove_event_cb(o, &detail::delete_cb);
+    lv_obj_remove_flag(o, LV_OBJ_FLAG_SEND_DRAW_TASK_EVENTS);
+    lv_obj_invalidate(o);
+}
+
+/// Whether `label`'s text is drawn through the cache
+[[nodiscard]] inline bool enabled(ObjectView label) noexcept {
+    lv_obj_t* o = label.get();
+    if (!o) return false;
+    const uint32_t n = lv_obj_get_event_count(o);
+    for (uint32_t i = 0; i < n; ++i) {
+        if (lv_event_dsc_get_cb(lv_obj_get_event_dsc(o, i)) == &detail::draw_task_cb) return true;
+    }
+    return false;
+}
+
+/// Set the bitmap byte budget; entries over it are evicted (pinned ones stay)
+inline void budget(uint32_t bytes) noexcept {
+    detail::Tables& t = detail::tables();
+    t.budget = bytes;
+    (void)detail::reserve(t, 0);
+}
+
+[[nodiscard]] inline uint32_t budget() noexcept { return detail::tables().budget; }
+
+[[nodiscard]] inline Stats stats() noexcept { return detail::tables().stats; }
+
+/// Zero the hit/miss/render counters (sizes are kept)
+inline void reset_stats() noexcept {
+    Stats& s = detail::tables().stats;
+    s.renders = s.hits = s.misses = s.skipped = 0;
+}
+
+/// LV_LOG_USER the counters and the bytes held against the budget
+inline void dump() noexcept {
+    const detail::Tables& t = detail::tables();
+    const Stats& s = t.stats;
+    LV_LOG_USER("shaped text cache: %u hits, %u misses, %u skipped, %u renders, %u entries, %u / %u bytes",
+                static_cast<unsigned>(s.hits), static_cast<unsigned>(s.misses), static_cast<unsigned>(s.skipped),
+                static_cast<unsigned>(s.renders), static_cast<unsigned>(s.entries), static_cast<unsigned>(s.bytes),
+                static_cast<unsigned>(t.budget));
+}
+
+/// Free every unpinned bitmap (e.g. before freeing a font)
+inline void drop() noexcept {
+    detail::Tables& t = detail::tables();
+    for (detail::Entry& e : t.entries) {
+        if (e.taken && !e.pinned) detail::free_entry(t, e);
+    }
+}
+
+} // namespace lv::shaped_text_cache
+
+#endif // LV_USE_LABEL
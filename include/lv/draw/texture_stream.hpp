@@ -0,0 +1,656 @@
+#pragma once
+
+/**
+ * @file texture_stream.hpp
+ * @brief Zero-copy camera and video frames for Texture3D and Draw3dDsc
+ *
+ * Texture3D::src() and Draw3dDsc::texture() take a GL texture. Filling one
+ * from a camera or video decoder with glTexSubImage2D() copies every frame
+ * through the CPU. A TextureStream imports the producer's DMA-BUF as an
+ * EGLImage and lets the GPU sample it in place:
+ *
+ * @code
+ * lv::TextureStream stream;
+ * stream.init(egl_display, 3);                   // triple buffered
+ * stream.on_release(&requeue_buffer, &camera);   // back to the driver
+ * stream.attach(lv::Texture3D::create(screen).size(1280, 720));
+ *
+ * // UI thread (lv::post() from the capture thread), per dequeued buffer:
+ * lv::DmaBufFrame f{DRM_FORMAT_NV12, 1280, 720};
+ * f.planes[0] = {buf.fd, 0, 1280};
+ * f.planes[1] = {buf.fd, 1280 * 720, 1280};
+ * f.n_planes = 2;
+ * f.acquire_fence = buf.fence_fd;                // or -1: already written
+ * f.token = &buf;
+ * if (!stream.push(f)) requeue_buffer(&buf, &camera);   // all in flight: drop
+ * @endcode
+ *
+ * RGB buffers are bound to a GL_TEXTURE_2D and shown directly. YUV buffers
+ * (and OES textures from push_external()) are bound to
+ * GL_TEXTURE_EXTERNAL_OES, which LVGL's OpenGL ES renderer cannot sample,
+ * so the GPU converts them into one of the stream's ring textures with a
+ * single quad. No pixel passes through the CPU either way.
+ *
+ * Imports are cached per (fd, offset, format, size): V4L2 and decoder pools
+ * cycle through a fixed set of buffers, so each is imported once. Call
+ * forget_imports() when the producer reallocates its pool.
+ *
+ * A frame stays in flight until it has left the screen and the GPU has
+ * finished the last refresh that sampled it: the stream puts an EGL fence
+ * after that refresh and hands the token back through on_release() once it
+ * signals. push() returns false when every slot is in flight. An
+ * acquire_fence (sync_file fd) is waited for on the GPU with
+ * EGL_ANDROID_native_fence_sync, else on the CPU.
+ *
+ * Needs EGL and OpenGL ES 2 headers; enable with LV_CPP_USE_EGL_IMPORT.
+ * All calls must come from the LVGL thread with LVGL's GL context current.
+ *
+ * Heap allocation: NONE in the wrapper (fixed slot and import tables); the
+ * GL and EGL objects live in the driver
+ */
+
+#include <lvgl.h>
+
+#ifndef LV_CPP_USE_EGL_IMPORT
+/// Build TextureStream (needs EGL/GLES2 headers and libraries)
+#define LV_CPP_USE_EGL_IMPORT 0
+#endif
+
+#if LV_USE_3DTEXTURE && LV_CPP_USE_EGL_IMPORT
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <GLES2/gl2.h>
+#include <GLES2/gl2ext.h>
+#include <poll.h>
+#include <unistd.h>
+#include <cstdint>
+#include <cstring>
+#include "../core/object.hpp"
+
+#ifndef LV_CPP_TEXTURE_STREAM_SLOTS
+/// Most frames one stream keeps in flight (on screen or awaiting their fence)
+#define LV_CPP_TEXTURE_STREAM_SLOTS 3
+#endif
+
+#ifndef LV_CPP_TEXTURE_STREAM_IMPORTS
+/// Producer buffers one stream keeps imported as EGLImages
+#define LV_CPP_TEXTURE_STREAM_IMPORTS 8
+#endif
+
+namespace lv {
+
+/// One plane of a DMA-BUF frame
+struct DmaBufPlane {
+    int fd = -1;
+    uint32_t offset = 0;
+    uint32_t pitch = 0;
+};
+
+/// A frame exported by a camera or decoder as DMA-BUF planes
+struct DmaBufFrame {
+    uint32_t fourcc = 0;            ///< DRM_FORMAT_* code
+    int32_t w = 0;
+    int32_t h = 0;
+    DmaBufPlane planes[3];
+    uint8_t n_planes = 1;
+    uint64_t modifier = UINT64_MAX; ///< DRM format modifier (UINT64_MAX: implicit)
+    bool bt709 = false;             ///< YUV: BT.709 instead of BT.601
+    bool full_range = false;        ///< YUV: full instead of narrow range
+    int acquire_fence = -1;         ///< sync_file signalled when written; the stream closes it
+    void* token = nullptr;          ///< Handed back through on_release()
+};
+
+/// Counters for one TextureStream
+struct TextureStreamStats {
+    uint32_t frames = 0;            ///< Frames pushed and shown
+    uint32_t dropped = 0;           ///< push() refused: every slot in flight
+    uint32_t imports = 0;           ///< EGLImages created
+    uint32_t import_hits = 0;       ///< Frames that reused an import
+    uint32_t converted = 0;         ///< Frames drawn through the OES pass
+    uint32_t failed = 0;            ///< Imports or conversions that failed
+};
+
+namespace detail::texture_stream {
+
+[[nodiscard]] constexpr uint32_t fourcc(char a, char b, char c, char d) noexcept {
+    return uint32_t(uint8_t(a)) | uint32_t(uint8_t(b)) << 8 | uint32_t(uint8_t(c)) << 16 |
+           uint32_t(uint8_t(d)) << 24;
+}
+
+/// Formats GL_TEXTURE_2D can sample from an EGLImage (everything else goes through OES)
+[[nodiscard]] constexpr bool is_rgb(uint32_t f) noexcept {
+    return f == fourcc('X', 'R', '2', '4') || f == fourcc('A', 'R', '2', '4') ||
+           f == fourcc('X', 'B', '2', '4') || f == fourcc('A', 'B', '2', '4') ||
+           f == fourcc('R', 'G', '1', '6');
+}
+
+struct Procs {
+    PFNEGLCREATEIMAGEKHRPROC create_image = nullptr;
+    PFNEGLDESTROYIMAGEKHRPROC destroy_image = nullptr;
+    PFNEGLCREATESYNCKHRPROC create_sync = nullptr;
+    PFNEGLDESTROYSYNCKHRPROC destroy_sync = nullptr;
+    PFNEGLCLIENTWAITSYNCKHRPROC client_wait = nullptr;
+    PFNEGLWAITSYNCKHRPROC wait_sync = nullptr;          ///< nullptr: CPU wait on acquire fences
+    PFNGLEGLIMAGETARGETTEXTURE2DOESPROC image_target = nullptr;
+    bool native_fence = false;
+
+    [[nodiscard]] bool load(EGLDisplay dpy) noexcept {
+        create_image = reinterpret_cast<PFNEGLCREATEIMAGEKHRPROC>(eglGetProcAddress("eglCreateImageKHR"));
+        destroy_image = reinterpret_cast<PFNEGLDESTROYIMAGEKHRPROC>(eglGetProcAddress("eglDestroyImageKHR"));
+        create_sync = reinterpret_cast<PFNEGLCREATESYNCKHRPROC>(eglGetProcAddress("eglCreateSyncKHR"));
+        destroy_sync = reinterpret_cast<PFNEGLDESTROYSYNCKHRPROC>(eglGetProcAddress("eglDestroySyncKHR"));
+        client_wait = reinterpret_cast<PFNEGLCLIENTWAITSYNCKHRPROC>(eglGetProcAddress("eglClientWaitSyncKHR"));
+        image_target = reinterpret_cast<PFNGLEGLIMAGETARGETTEXTURE2DOESPROC>(
+            eglGetProcAddress("glEGLImageTargetTexture2DOES"));
+        const char* ext = eglQueryString(dpy, EGL_EXTENSIONS);
+        native_fence = ext && std::strstr(ext, "EGL_ANDROID_native_fence_sync");
+        if (native_fence) {
+            wait_sync = reinterpret_cast<PFNEGLWAITSYNCKHRPROC>(eglGetProcAddress("eglWaitSyncKHR"));
+        }
+        return ext && std::strstr(ext, "EGL_EXT_image_dma_buf_import") && create_image && destroy_image &&
+               create_sync && destroy_sync && client_wait && image_target;
+    }
+};
+
+struct Import {
+    int fd = -1;                    ///< -1: free
+    uint32_t offset = 0;
+    uint32_t fourcc = 0;
+    int32_t w = 0;
+    int32_t h = 0;
+    EGLImageKHR image = EGL_NO_IMAGE_KHR;
+    GLuint tex = 0;
+    bool external = false;          ///< Bound to GL_TEXTURE_EXTERNAL_OES
+    uint32_t used = 0;              ///< LRU stamp
+};
+
+enum class SlotState : uint8_t { free, shown, retired, fenced };
+
+struct Slot {
+    GLuint tex = 0;                 ///< Ring texture the OES pass draws into
+    GLuint fbo = 0;
+    int32_t w = 0;
+    int32_t h = 0;
+    const Import* direct = nullptr; ///< RGB import shown as is (no ring texture)
+    void* token = nullptr;
+    EGLSyncKHR fence = EGL_NO_SYNC_KHR;
+    SlotState state = SlotState::free;
+};
+
+inline constexpr const char* oes_vs =
+    "attribute vec2 p;\n"
+    "varying vec2 uv;\n"
+    "void main() { uv = p * 0.5 + 0.5; gl_Position = vec4(p, 0.0, 1.0); }\n";
+
+inline constexpr const char* oes_fs =
+    "#extension GL_OES_EGL_image_external : require\n"
+    "precision mediump float;\n"
+    "uniform samplerExternalOES t;\n"
+    "varying vec2 uv;\n"
+    "void main() { gl_FragColor = texture2D(t, uv); }\n";
+
+[[nodiscard]] inline GLuint compile(GLenum type, const char* src) noexcept {
+    GLuint s = glCreateShader(type);
+    glShaderSource(s, 1, &src, nullptr);
+    glCompileShader(s);
+    GLint ok = 0;
+    glGetShaderiv(s, GL_COMPILE_STATUS, &ok);
+    if (!ok) {
+        glDeleteShader(s);
+        return 0;
+    }
+    return s;
+}
+
+/// GL state the OES pass touches, restored so LVGL's renderer sees no change
+struct SavedGl {
+    GLint fbo = 0, program = 0, array_buf = 0, active = 0, external = 0;
+    GLint viewport[4] = {};
+    GLboolean blend = GL_FALSE, scissor = GL_FALSE;
+
+    SavedGl() noexcept {
+        glGetIntegerv(GL_FRAMEBUFFER_BINDING, &fbo);
+        glGetIntegerv(GL_CURRENT_PROGRAM, &program);
+        glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &array_buf);
+        glGetIntegerv(GL_ACTIVE_TEXTURE, &active);
+        glGetIntegerv(GL_VIEWPORT, viewport);
+        blend = glIsEnabled(GL_BLEND);
+        scissor = glIsEnabled(GL_SCISSOR_TEST);
+        glActiveTexture(GL_TEXTURE0);
+        glGetIntegerv(GL_TEXTURE_BINDING_EXTERNAL_OES, &external);
+    }
+    ~SavedGl() {
+        glBindTexture(GL_TEXTURE_EXTERNAL_OES, static_cast<GLuint>(external));
+        glActiveTexture(static_cast<GLenum>(active));
+        glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(fbo));
+        glUseProgram(static_cast<GLuint>(program));
+        glBindBuffer(GL_ARRAY_BUFFER, static_cast<GLuint>(array_buf));
+        glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+        if (blend) glEnable(GL_BLEND);
+        if (scissor) glEnable(GL_SCISSOR_TEST);
+    }
+    SavedGl(const SavedGl&) = delete;
+    SavedGl& operator=(const SavedGl&) = delete;
+};
+
+} // namespace detail::texture_stream
+
+/**
+ * @brief Ring of zero-copy frames shown through a Texture3D or Draw3dDsc
+ *
+ * Not copyable; destroy it (or call shutdown()) with the GL context current.
+ */
+class TextureStream {
+    using Import = detail::texture_stream::Import;
+    using Slot = detail::texture_stream::Slot;
+    using SlotState = detail::texture_stream::SlotState;
+
+    detail::texture_stream::Procs m_gl;
+    EGLDisplay m_dpy = EGL_NO_DISPLAY;
+    lv_display_t* m_disp = nullptr;
+    lv_obj_t* m_obj = nullptr;
+    void (*m_release)(void* token, void* user) = nullptr;
+    void* m_release_user = nullptr;
+    Slot m_slots[LV_CPP_TEXTURE_STREAM_SLOTS];
+    Import m_imports[LV_CPP_TEXTURE_STREAM_IMPORTS];
+    Slot* m_current = nullptr;
+    uint8_t m_buffers = 0;
+    uint32_t m_clock = 0;
+    GLuint m_program = 0;
+    GLuint m_quad = 0;
+    GLint m_attr = -1;
+    TextureStreamStats m_stats;
+
+    static void refr_ready_cb(lv_event_t* e) {
+        static_cast<TextureStream*>(lv_event_get_user_data(e))->fence_retired();
+    }
+
+    static void obj_delete_cb(lv_event_t* e) {
+        static_cast<TextureStream*>(lv_event_get_user_data(e))->m_obj = nullptr;
+    }
+
+    /// Fence the frames replaced before this refresh, release the signalled ones
+    void fence_retired() noexcept {
+        for (Slot& s : m_slots) {
+            if (s.state == SlotState::retired) {
+                s.fence = m_gl.create_sync(m_dpy, EGL_SYNC_FENCE_KHR, nullptr);
+                s.state = SlotState::fenced;
+            }
+        }
+        glFlush();
+        reap(0);
+    }
+
+    /// Release fenced slots whose fence signalled within `timeout_ns`
+    void reap(EGLTimeKHR timeout_ns) noexcept {
+        for (Slot& s : m_slots) {
+            if (s.state != SlotState::fenced) continue;
+            if (s.fence != EGL_NO_SYNC_KHR) {
+                if (m_gl.client_wait(m_dpy, s.fence, 0, timeout_ns) != EGL_CONDITION_SATISFIED_KHR) continue;
+                m_gl.destroy_sync(m_dpy, s.fence);
+                s.fence = EGL_NO_SYNC_KHR;
+            }
+            release(s);
+        }
+    }
+
+    void release(Slot& s) noexcept {
+        if (m_release && s.token) m_release(s.token, m_release_user);
+        s.token = nullptr;
+        s.direct = nullptr;
+        s.state = SlotState::free;
+    }
+
+    [[nodiscard]] Slot* free_slot() noexcept {
+        for (uint8_t i = 0; i < m_buffers; ++i) {
+            if (m_slots[i].state == SlotState::free) return &m_slots[i];
+        }
+        return nullptr;
+    }
+
+    [[nodiscard]] bool in_use(const Import& im) const noexcept {
+        for (const Slot& s : m_slots) {
+            if (s.state != SlotState::free && s.direct == &im) return true;
+        }
+        return false;
+    }
+
+    void destroy(Import& im) noexcept {
+        if (im.tex) glDeleteTextures(1, &im.tex);
+        if (im.image != EGL_NO_IMAGE_KHR) m_gl.destroy_image(m_dpy, im.image);
+        im = Import{};
+    }
+
+    /// Cached EGLImage for `f`, imported on a miss (LRU among unused imports)
+    [[nodiscard]] Import* import(const DmaBufFrame& f) noexcept {
+        Import* victim = nullptr;
+        for (Import& im : m_imports) {
+            if (im.fd == f.planes[0].fd && im.offset == f.planes[0].offset && im.fourcc == f.fourcc &&
+                im.w == f.w && im.h == f.h) {
+                im.used = ++m_clock;
+                ++m_stats.import_hits;
+                return &im;
+            }
+            if (in_use(im)) continue;
+            if (!victim || im.fd < 0 || (victim->fd >= 0 && im.used < victim->used)) victim = &im;
+        }
+        if (!victim) return nullptr;
+        if (victim->fd >= 0) destroy(*victim);
+
+        static constexpr EGLint fd_attr[3] = {EGL_DMA_BUF_PLANE0_FD_EXT, EGL_DMA_BUF_PLANE1_FD_EXT,
+                                              EGL_DMA_BUF_PLANE2_FD_EXT};
+        static constexpr EGLint offset_attr[3] = {EGL_DMA_BUF_PLANE0_OFFSET_EXT, EGL_DMA_BUF_PLANE1_OFFSET_EXT,
+                                                  EGL_DMA_BUF_PLANE2_OFFSET_EXT};
+        static constexpr EGLint pitch_attr[3] = {EGL_DMA_BUF_PLANE0_PITCH_EXT, EGL_DMA_BUF_PLANE1_PITCH_EXT,
+                                                 EGL_DMA_BUF_PLANE2_PITCH_EXT};
+#ifdef EGL_DMA_BUF_PLANE0_MODIFIER_LO_EXT
+        static constexpr EGLint mod_lo_attr[3] = {EGL_DMA_BUF_PLANE0_MODIFIER_LO_EXT,
+                                                  EGL_DMA_BUF_PLANE1_MODIFIER_LO_EXT,
+                                                  EGL_DMA_BUF_PLANE2_MODIFIER_LO_EXT};
+        static constexpr EGLint mod_hi_attr[3] = {EGL_DMA_BUF_PLANE0_MODIFIER_HI_EXT,
+                                                  EGL_DMA_BUF_PLANE1_MODIFIER_HI_EXT,
+                                                  EGL_DMA_BUF_PLANE2_MODIFIER_HI_EXT};
+#endif
+        EGLint a[48];
+        int n = 0;
+        a[n++] = EGL_WIDTH;                 a[n++] = f.w;
+        a[n++] = EGL_HEIGHT;                a[n++] = f.h;
+        a[n++] = EGL_LINUX_DRM_FOURCC_EXT;  a[n++] = static_cast<EGLint>(f.fourcc);
+        const uint8_t planes = f.n_planes > 3 ? 3 : f.n_planes;
+        for (uint8_t i = 0; i < planes; ++i) {
+            a[n++] = fd_attr[i];     a[n++] = f.planes[i].fd;
+            a[n++] = offset_attr[i]; a[n++] = static_cast<EGLint>(f.planes[i].offset);
+            a[n++] = pitch_attr[i];  a[n++] = static_cast<EGLint>(f.planes[i].pitch);
+#ifdef EGL_DMA_BUF_PLANE0_MODIFIER_LO_EXT
+            if (f.modifier != UINT64_MAX) {
+                a[n++] = mod_lo_attr[i]; a[n++] = static_cast<EGLint>(f.modifier & 0xffffffffu);
+                a[n++] = mod_hi_attr[i]; a[n++] = static_cast<EGLint>(f.modifier >> 32);
+            }
+#endif
+        }
+        const bool external = !detail::texture_stream::is_rgb(f.fourcc);
+        if (external) {
+            a[n++] = EGL_YUV_COLOR_SPACE_HINT_EXT;
+            a[n++] = f.bt709 ? EGL_ITU_REC709_EXT : EGL_ITU_REC601_EXT;
+            a[n++] = EGL_SAMPLE_RANGE_HINT_EXT;
+            a[n++] = f.full_range ? EGL_YUV_FULL_RANGE_EXT : EGL_YUV_NARROW_RANGE_EXT;
+        }
+        a[n++] = EGL_NONE;
+
+        EGLImageKHR image = m_gl.create_image(m_dpy, EGL_NO_CONTEXT, EGL_LINUX_DMA_BUF_EXT, nullptr, a);
+        if (image == EGL_NO_IMAGE_KHR) {
+            ++m_stats.failed;
+            return nullptr;
+        }
+        const GLenum target = external ? GL_TEXTURE_EXTERNAL_OES : GL_TEXTURE_2D;
+        GLint prev = 0;
+        glGetIntegerv(external ? GL_TEXTURE_BINDING_EXTERNAL_OES : GL_TEXTURE_BINDING_2D, &prev);
+        GLuint tex = 0;
+        glGenTextures(1, &tex);
+        glBindTexture(target, tex);
+        glTexParameteri(target, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(target, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(target, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        m_gl.image_target(target, static_cast<GLeglImageOES>(image));
+        glBindTexture(target, static_cast<GLuint>(prev));
+
+        *victim = Import{f.planes[0].fd, f.planes[0].offset, f.fourcc, f.w, f.h, image, tex, external, ++m_clock};
+        ++m_stats.imports;
+        return victim;
+    }
+
+    /// Wait (GPU side when possible) for the producer's write fence, taking ownership of `fd`
+    void acquire(int fd) noexcept {
+        if (fd < 0) return;
+        if (m_gl.wait_sync) {
+            const EGLint attr[] = {EGL_SYNC_NATIVE_FENCE_FD_ANDROID, fd, EGL_NONE};
+            EGLSyncKHR sync = m_gl.create_sync(m_dpy, EGL_SYNC_NATIVE_FENCE_ANDROID, attr);
+            if (sync != EGL_NO_SYNC_KHR) {   // EGL owns `fd` now
+                m_gl.wait_sync(m_dpy, sync, 0);
+                m_gl.destroy_sync(m_dpy, sync);
+                return;
+            }
+        }
+        pollfd p{fd, POLLIN, 0};
+        (void)poll(&p, 1, -1);
+        close(fd);
+    }
+
+    [[nodiscard]] bool ensure_program() noexcept {
+        if (m_program) return true;
+        using namespace detail::texture_stream;
+        GLuint vs = compile(GL_VERTEX_SHADER, oes_vs);
+        GLuint fs = compile(GL_FRAGMENT_SHADER, oes_fs);
+        if (vs && fs) {
+            m_program = glCreateProgram();
+            glAttachShader(m_program, vs);
+            glAttachShader(m_program, fs);
+            glLinkProgram(m_program);
+            GLint ok = 0;
+            glGetProgramiv(m_program, GL_LINK_STATUS, &ok);
+            if (!ok) {
+                glDeleteProgram(m_program);
+                m_program = 0;
+            }
+        }
+        if (vs) glDeleteShader(vs);
+        if (fs) glDeleteShader(fs);
+        if (!m_program) return false;
+        m_attr = glGetAttribLocation(m_program, "p");
+        static constexpr GLfloat quad[] = {-1.f, -1.f, 1.f, -1.f, -1.f, 1.f, 1.f, 1.f};
+        glGenBuffers(1, &m_quad);
+        glBindBuffer(GL_ARRAY_BUFFER, m_quad);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(quad), quad, GL_STATIC_DRAW);
+        return true;
+    }
+
+    /// Ring texture of `s` sized w x h (reallocated when the frame size changes)
+    void ensure_target(Slot& s, int32_t w, int32_t h) noexcept {
+        if (s.tex && s.w == w && s.h == h) return;
+        GLint prev = 0;
+        glGetIntegerv(GL_TEXTURE_BINDING_2D, &prev);
+        if (!s.tex) {
+            glGenTextures(1, &s.tex);
+            glGenFramebuffers(1, &s.fbo);
+        }
+        glBindTexture(GL_TEXTURE_2D, s.tex);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(prev));
+        GLint prev_fbo = 0;
+        glGetIntegerv(GL_FRAMEBUFFER_BINDING, &prev_fbo);
+        glBindFramebuffer(GL_FRAMEBUFFER, s.fbo);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, s.tex, 0);
+        glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(prev_fbo));
+        s.w = w;
+        s.h = h;
+    }
+
+    /// Draw external OES texture `oes` into the ring texture of `s`
+    [[nodiscard]] bool convert(Slot& s, GLuint oes, int32_t w, int32_t h) noexcept {
+        detail::texture_stream::SavedGl saved;
+        if (!ensure_program()) return false;
+        ensure_target(s, w, h);
+        glBindFramebuffer(GL_FRAMEBUFFER, s.fbo);
+        glViewport(0, 0, w, h);
+        glDisable(GL_BLEND);
+        glDisable(GL_SCISSOR_TEST);
+        glUseProgram(m_program);
+        glBindTexture(GL_TEXTURE_EXTERNAL_OES, oes);
+        glUniform1i(glGetUniformLocation(m_program, "t"), 0);
+        glBindBuffer(GL_ARRAY_BUFFER, m_quad);
+        glEnableVertexAttribArray(static_cast<GLuint>(m_attr));
+        glVertexAttribPointer(static_cast<GLuint>(m_attr), 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+        glDisableVertexAttribArray(static_cast<GLuint>(m_attr));
+        ++m_stats.converted;
+        return true;
+    }
+
+    /// Make `s` the frame on screen; the previous one retires at the next refresh
+    void show(Slot& s, void* token) noexcept {
+        s.token = token;
+        s.state = SlotState::shown;
+        if (m_current) m_current->state = SlotState::retired;
+        m_current = &s;
+        ++m_stats.frames;
+        if (m_obj) {
+            lv_3dtexture_set_src(m_obj, texture());
+            lv_obj_invalidate(m_obj);
+        }
+    }
+
+public:
+    TextureStream() noexcept = default;
+    TextureStream(const TextureStream&) = delete;
+    TextureStream& operator=(const TextureStream&) = delete;
+    ~TextureStream() { shutdown(); }
+
+    /**
+     * @brief Load the EGL/GL entry points and hook the display's refresh
+     * @param dpy EGL display LVGL renders with
+     * @param buffers Frames kept in flight: 2 (double) or 3 (triple buffering),
+     *                at most LV_CPP_TEXTURE_STREAM_SLOTS
+     * @param disp Display whose refreshes sample the frames (nullptr: default)
+     * @return false if EGL_EXT_image_dma_buf_import or a needed entry point is missing
+     */
+    [[nodiscard]] bool init(EGLDisplay dpy, uint8_t buffers = 3, lv_display_t* disp = nullptr) noexcept {
+        shutdown();
+        if (!m_gl.load(dpy)) return false;
+        m_dpy = dpy;
+        m_buffers = buffers < 2 ? 2 : buffers > LV_CPP_TEXTURE_STREAM_SLOTS ? LV_CPP_TEXTURE_STREAM_SLOTS
+                                                                            : buffers;
+        m_disp = disp ? disp : lv_display_get_default();
+        if (m_disp) lv_display_add_event_cb(m_disp, &refr_ready_cb, LV_EVENT_REFR_READY, this);
+        return true;
+    }
+
+    /// Show new frames on this Texture3D (nullptr: only texture() is updated)
+    TextureStream& attach(lv_obj_t* texture3d) noexcept {
+        if (m_obj) lv_obj_remove_event_cb_with_user_data(m_obj, &obj_delete_cb, this);
+        m_obj = texture3d;
+        if (m_obj) {
+            lv_obj_add_event_cb(m_obj, &obj_delete_cb, LV_EVENT_DELETE, this);
+            if (m_current) lv_3dtexture_set_src(m_obj, texture());
+        }
+        return *this;
+    }
+    TextureStream& attach(ObjectView texture3d) noexcept { return attach(texture3d.get()); }
+
+    /// Called with a frame's token once the GPU no longer reads its buffer
+    TextureStream& on_release(void (*cb)(void* token, void* user), void* user = nullptr) noexcept {
+        m_release = cb;
+        m_release_user = user;
+        return *this;
+    }
+
+    /**
+     * @brief Show a DMA-BUF frame without copying it
+     * @return false if the frame was not taken: every slot in flight, or the
+     *         import or conversion failed. Its token is never released; its
+     *         acquire_fence is closed once the import succeeded
+     */
+    [[nodiscard]] bool push(const DmaBufFrame& f) noexcept {
+        if (m_dpy == EGL_NO_DISPLAY) return false;
+        reap(0);
+        Slot* s = free_slot();
+        if (!s) {
+            ++m_stats.dropped;
+            return false;
+        }
+        Import* im = import(f);
+        if (!im) return false;
+        acquire(f.acquire_fence);
+        if (im->external) {
+            if (!convert(*s, im->tex, f.w, f.h)) {
+                ++m_stats.failed;
+                return false;
+            }
+        } else {
+            s->direct = im;
+        }
+        show(*s, f.token);
+        return true;
+    }
+
+    /**
+     * @brief Show a frame a decoder rendered into an external OES texture
+     *
+     * `oes_tex` is converted on the GPU into a ring texture; `token` is
+     * released once the conversion finished and the frame left the screen.
+     * @return false if every slot is in flight
+     */
+    [[nodiscard]] bool push_external(GLuint oes_tex, int32_t w, int32_t h, void* token = nullptr) noexcept {
+        if (m_dpy == EGL_NO_DISPLAY) return false;
+        reap(0);
+        Slot* s = free_slot();
+        if (!s) {
+            ++m_stats.dropped;
+            return false;
+        }
+        if (!convert(*s, oes_tex, w, h)) {
+            ++m_stats.failed;
+            return false;
+        }
+        show(*s, token);
+        return true;
+    }
+
+    /// Texture of the frame on screen, for Texture3D::src() or Draw3dDsc::texture() (0: none)
+    [[nodiscard]] lv_3dtexture_id_t texture() const noexcept {
+        if (!m_current) return 0;
+        return static_cast<lv_3dtexture_id_t>(m_current->direct ? m_current->direct->tex : m_current->tex);
+    }
+
+    /// Frames pushed and not yet released (on screen included)
+    [[nodiscard]] uint32_t in_flight() const noexcept {
+        uint32_t n = 0;
+        for (const Slot& s : m_slots) n += s.state != SlotState::free;
+        return n;
+    }
+
+    /// Destroy cached imports not on screen (after the producer reallocated its buffers)
+    void forget_imports() noexcept {
+        for (Import& im : m_imports) {
+            if (im.fd >= 0 && !in_use(im)) destroy(im);
+        }
+    }
+
+    [[nodiscard]] const TextureStreamStats& stats() const noexcept { return m_stats; }
+    void reset_stats() noexcept { m_stats = TextureStreamStats{}; }
+
+    /// Wait for the GPU, release every frame and free all GL/EGL objects
+    void shutdown() noexcept {
+        if (m_dpy == EGL_NO_DISPLAY) return;
+        if (m_disp) lv_display_remove_event_cb_with_user_data(m_disp, &refr_ready_cb, this);
+        attach(nullptr);
+        glFinish();
+        for (Slot& s : m_slots) {
+            if (s.fence != EGL_NO_SYNC_KHR) m_gl.destroy_sync(m_dpy, s.fence);
+            s.fence = EGL_NO_SYNC_KHR;
+            if (s.state != SlotState::free) release(s);
+            if (s.fbo) glDeleteFramebuffers(1, &s.fbo);
+            if (s.tex) glDeleteTextures(1, &s.tex);
+            s = Slot{};
+        }
+        for (Import& im : m_imports) {
+            if (im.fd >= 0) destroy(im);
+        }
+        if (m_quad) glDeleteBuffers(1, &m_quad);
+        if (m_program) glDeleteProgram(m_program);
+        m_quad = 0;
+        m_program = 0;
+        m_current = nullptr;
+        m_disp = nullptr;
+        m_dpy = EGL_NO_DISPLAY;
+    }
+};
+
+} // namespace lv
+
+#endif // LV_USE_3DTEXTURE && LV_CPP_USE_EGL_IMPORT
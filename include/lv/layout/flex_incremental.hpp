@@ -0,0 +1,235 @@
+#pragma once
+
+/**
+ * @file flex_incremental.hpp
+ * @brief Incremental flex layout for long single-track containers (opt-in)
+ *
+ * LVGL's flex re-reads every child's grow and margin styles and rebuilds
+ * all tracks whenever one child changes size, so a new label text in one
+ * row of a 300-row column costs a 300-row layout. An incremental container
+ * runs a single-track layout that only reads the children's coordinates
+ * and moves just the children whose position changed: a row that grows
+ * shifts the rows below it, and the subtrees of the rows above are not
+ * touched. It handles ROW and COLUMN flows with main place START, any
+ * cross place, gaps and hidden/floating children. A child with flex_grow
+ * or a margin, wrapping, reverse, RTL rows and other main places fall back
+ * to LVGL's flex for that pass. stats() counts the passes of each
+ * container.
+ *
+ * Not included by lv.hpp: the layout moves children through lv_obj_t's
+ * coords and reaches LVGL's own flex through the layout list, neither of
+ * which is public. Checked against LVGL 9.4 (see LV_CPP_INTERNALS_OK).
+ *
+ * @code
+ * #include <lv/layout/flex_incremental.hpp>
+ *
+ * lv::Flex rows = lv::vbox(parent).gap(4);
+ * lv::flex_incremental::enable(rows);
+ * @endcode
+ *
+ * Heap allocation: NONE (LV_CPP_FLEX_INCREMENTAL_MAX fixed slots)
+ */
+
+#include <lvgl.h>
+#include "../core/version.hpp"
+
+#if !LV_CPP_INTERNALS_OK
+#error "flex_incremental.hpp reads LVGL internals checked against LVGL 9.4; see LV_CPP_INTERNALS_OK"
+#endif
+
+#include <src/core/lv_global.h>              // layout_list
+#include <src/core/lv_obj_private.h>         // coords
+#include <src/layouts/lv_layout_private.h>   // lv_layout_dsc_t
+#include "flex.hpp"
+
+#ifndef LV_CPP_FLEX_INCREMENTAL_MAX
+/// Containers that can use incremental flex at once
+#define LV_CPP_FLEX_INCREMENTAL_MAX 16
+#endif
+
+namespace lv {
+
+namespace flex_incremental {
+
+/// Layout passes of one incremental container
+struct Stats {
+    uint32_t passes;       ///< Layout runs
+    uint32_t fallbacks;    ///< Runs handed to LVGL's flex (grow, margin, wrap, reverse, RTL, main place)
+    uint32_t visited;      ///< Children examined by incremental runs
+    uint32_t moved;        ///< Children actually moved (with their subtrees)
+};
+
+namespace detail {
+
+struct Slot {
+    lv_obj_t* obj = nullptr;    ///< nullptr: free slot
+    Stats stats{};
+};
+
+[[nodiscard]] inline Slot* slots() noexcept {
+    static Slot s[LV_CPP_FLEX_INCREMENTAL_MAX];
+    return s;
+}
+
+[[nodiscard]] inline Slot* find(const lv_obj_t* obj) noexcept {
+    Slot* s = slots();
+    for (uint32_t i = 0; i < LV_CPP_FLEX_INCREMENTAL_MAX; ++i) {
+        if (s[i].obj == obj) return &s[i];
+    }
+    return nullptr;
+}
+
+[[nodiscard]] inline bool skipped(lv_obj_t* child) noexcept {
+    return lv_obj_has_flag_any(child, static_cast<lv_obj_flag_t>(LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_IGNORE_LAYOUT
+                                                                  | LV_OBJ_FLAG_FLOATING));
+}
+
+/// Move `child` and its subtree to (x, y), the way LVGL's flex places its items
+inline void place(lv_obj_t* child, int32_t x, int32_t y) noexcept {
+    const int32_t dx = x - child->coords.x1;
+    const int32_t dy = y - child->coords.y1;
+    lv_obj_invalidate(child);
+    lv_area_move(&child->coords, dx, dy);
+    lv_obj_invalidate(child);
+    lv_obj_move_children_by(child, dx, dy, false);
+}
+
+/// Whether LVGL's flex would size or offset `child` (grow or any margin)
+[[nodiscard]] inline bool needs_flex(lv_obj_t* child) noexcept {
+    return lv_obj_get_style_flex_grow(child, LV_PART_MAIN) != 0
+        || lv_obj_get_style_margin_left(child, LV_PART_MAIN) != 0
+        || lv_obj_get_style_margin_right(child, LV_PART_MAIN) != 0
+        || lv_obj_get_style_margin_top(child, LV_PART_MAIN) != 0
+        || lv_obj_get_style_margin_bottom(child, LV_PART_MAIN) != 0;
+}
+
+/// Hand the whole pass to LVGL's flex
+inline void fall_back(lv_obj_t* cont, Slot* slot) noexcept {
+    if (slot) ++slot->stats.fallbacks;
+    const lv_layout_dsc_t& flex = LV_GLOBAL_DEFAULT()->layout_list[LV_LAYOUT_FLEX];
+    flex.cb(cont, flex.user_data);
+}
+
+inline void update_cb(lv_obj_t* cont, void*) noexcept {
+    Slot* slot = find(cont);
+    if (slot) ++slot->stats.passes;
+    const lv_flex_flow_t flow = lv_obj_get_style_flex_flow(cont, LV_PART_MAIN);
+    const bool row = (flow & LV_FLEX_COLUMN) == 0;
+    if (!slot || (flow & (LV_FLEX_WRAP | LV_FLEX_REVERSE))
+        || lv_obj_get_style_flex_main_place(cont, LV_PART_MAIN) != LV_FLEX_ALIGN_START
+        || (row && lv_obj_get_style_base_dir(cont, LV_PART_MAIN) == LV_BASE_DIR_RTL)) {
+        fall_back(cont, slot);
+        return;
+    }
+
+    const int32_t gap = row ? lv_obj_get_style_pad_column(cont, LV_PART_MAIN)
+                            : lv_obj_get_style_pad_row(cont, LV_PART_MAIN);
+    const lv_flex_align_t cross_place = lv_obj_get_style_flex_cross_place(cont, LV_PART_MAIN);
+    const int32_t abs_x = cont->coords.x1 + lv_obj_get_style_space_left(cont, LV_PART_MAIN) - lv_obj_get_scroll_x(cont);
+    const int32_t abs_y = cont->coords.y1 + lv_obj_get_style_space_top(cont, LV_PART_MAIN) - lv_obj_get_scroll_y(cont);
+    const uint32_t n = lv_obj_get_child_count(cont);
+
+    // The track spans the content box, or the widest child of a content-sized container
+    int32_t track = row ? lv_obj_get_content_height(cont) : lv_obj_get_content_width(cont);
+    const int32_t cross_set = row ? lv_obj_get_style_height(cont, LV_PART_MAIN) : lv_obj_get_style_width(cont, LV_PART_MAIN);
+    if (cross_place != LV_FLEX_ALIGN_START && cross_set == LV_SIZE_CONTENT) {
+        track = 0;
+        for (uint32_t i = 0; i < n; ++i) {
+            lv_obj_t* c = lv_obj_get_child(cont, static_cast<int32_t>(i));
+            if (skipped(c)) continue;
+            const int32_t size = row ? lv_obj_get_height(c) : lv_obj_get_width(c);
+            if (size > track) track = size;
+        }
+    }
+
+    int32_t main = row ? abs_x : abs_y;
+    for (uint32_t i = 0; i < n; ++i) {
+        lv_obj_t* c = lv_obj_get_child(cont, static_cast<int32_t>(i));
+        ++slot->stats.visited;
+        if (skipped(c)) continue;
+        if (needs_flex(c)) {
+            // LVGL's flex places every child again, including those moved above
+            fall_back(cont, slot);
+            return;
+        }
+        const int32_t w = lv_obj_get_width(c);
+        const int32_t h = lv_obj_get_height(c);
+        const int32_t free = track - (row ? h : w);
+        const int32_t cross = (row ? abs_y : abs_x)
+                            + (cross_place == LV_FLEX_ALIGN_CENTER ? free / 2 : cross_place == LV_FLEX_ALIGN_END ? free : 0);
+        const int32_t x = row ? main : cross;
+        const int32_t y = row ? cross : main;
+        if (c->coords.x1 != x || c->coords.y1 != y) {
+            place(c, x, y);
+            ++slot->stats.moved;
+        }
+        main += (row ? w : h) + gap;
+    }
+
+    const int32_t w_set = lv_obj_get_style_width(cont, LV_PART_MAIN);
+    const int32_t h_set = lv_obj_get_style_height(cont, LV_PART_MAIN);
+    if (w_set == LV_SIZE_CONTENT || h_set == LV_SIZE_CONTENT) lv_obj_refr_size(cont);
+    lv_obj_send_event(cont, LV_EVENT_LAYOUT_CHANGED, nullptr);
+}
+
+/// Id of the incremental layout (registered on first use)
+[[nodiscard]] inline uint32_t layout() noexcept {
+    static const uint32_t id = lv_layout_register(&update_cb, nullptr);
+    return id;
+}
+
+inline void delete_cb(lv_event_t* e) noexcept {
+    if (Slot* s = find(static_cast<lv_obj_t*>(lv_event_get_current_target(e)))) *s = Slot{};
+}
+
+} // namespace detail
+
+/**
+ * @brief Lay out the flex container `obj` incrementally (see the file comment)
+ *
+ * Keeps its flex styles (flow, gaps, cross place); only the layout
+ * algorithm changes.
+ *
+ * @return false when LV_CPP_FLEX_INCREMENTAL_MAX is reached (obj keeps LVGL's flex)
+ */
+inline bool enable(ObjectView obj) noexcept {
+    if (!obj) return false;
+    if (!detail::find(obj.get())) {
+        detail::Slot* s = detail::find(nullptr);
+        if (!s) {
+            LV_LOG_WARN("incremental flex containers exhausted, raise LV_CPP_FLEX_INCREMENTAL_MAX");
+            return false;
+        }
+        s->obj = obj.get();
+        lv_obj_add_event_cb(obj.get(), &detail::delete_cb, LV_EVENT_DELETE, nullptr);
+    }
+    lv_obj_set_layout(obj.get(), detail::layout());
+    return true;
+}
+
+/// Back to LVGL's flex
+inline void disable(ObjectView obj) noexcept {
+    detail::Slot* s = obj ? detail::find(obj.get()) : nullptr;
+    if (!s) return;
+    lv_obj_remove_event_cb_with_user_data(obj.get(), &detail::delete_cb, nullptr);
+    *s = detail::Slot{};
+    lv_obj_set_layout(obj.get(), LV_LAYOUT_FLEX);
+}
+
+[[nodiscard]] inline bool enabled(ObjectView obj) noexcept {
+    return obj && detail::find(obj.get());
+}
+
+/// Layout pass counters of `obj` (zero if not incremental)
+[[nodiscard]] inline Stats stats(ObjectView obj) noexcept {
+    const detail::Slot* s = obj ? detail::find(obj.get()) : nullptr;
+    return s ? s->stats : Stats{};
+}
+
+inline void reset_stats(ObjectView obj) noexcept {
+    if (detail::Slot* s = obj ? detail::find(obj.get()) : nullptr) s->stats = Stats{};
+}
+
+} // namespace flex_incremental
+
+} // namespace lv
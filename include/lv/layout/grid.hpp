@@ -125,6 +125,15 @@ public:
         return *this;
     }
 
+    // ==================== Compile-time template ====================
+
+    /// Use the descriptors and layout of a GridTemplate (grid_template.hpp)
+    template<typename Template>
+    Grid& use() noexcept {
+        Template::apply(*this);
+        return *this;
+    }
+
     // size(), width(), height(), size_content(), fill_width(), fill_height(), fill()
     // are inherited from ObjectMixin<Grid>.
 };
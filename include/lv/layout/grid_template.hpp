@@ -0,0 +1,281 @@
+#pragma once
+
+/**
+ * @file grid_template.hpp
+ * @brief Compile-time grid templates with precomputed tracks (opt-in)
+ *
+ * GridTemplate<GridTracks<...>, GridTracks<...>> holds the column and row
+ * descriptors as static constexpr arrays and classifies every track as px,
+ * fr or content at compile time. A template without content tracks
+ * registers its own layout: the track offsets are resolved from the
+ * container's content size and gaps, kept until those change (a resize or
+ * rotation recomputes only the fr tracks), and the children are then moved
+ * or resized only where their cell changed. Content tracks, RTL, track
+ * alignment other than START on an axis without fr tracks and children
+ * with margins use LVGL's grid.
+ *
+ * Not included by lv.hpp: the layout writes lv_obj_t's coords and
+ * w_layout/h_layout and reaches LVGL's own grid through the layout list,
+ * none of which is public. Checked against LVGL 9.4 (see
+ * LV_CPP_INTERNALS_OK). Plain Grid stays on the public API.
+ *
+ * @code
+ * #include <lv/layout/grid_template.hpp>
+ *
+ * using Dash = lv::GridTemplate<lv::GridTracks<80, LV_GRID_FR(1), 80>,
+ *                               lv::GridTracks<50, LV_GRID_FR(1)>>;
+ * auto dash = lv::grid(screen).use<Dash>();
+ * @endcode
+ *
+ * Heap allocation: NONE (one static track cache per template)
+ */
+
+#include <lvgl.h>
+#include "../core/version.hpp"
+
+#if !LV_CPP_INTERNALS_OK
+#error "grid_template.hpp reads LVGL internals checked against LVGL 9.4; see LV_CPP_INTERNALS_OK"
+#endif
+
+#include <src/core/lv_global.h>              // layout_list
+#include <src/core/lv_obj_private.h>         // coords, w_layout, h_layout
+#include <src/layouts/lv_layout_private.h>   // lv_layout_dsc_t
+#include "grid.hpp"
+
+namespace lv {
+
+namespace grid_track {
+
+[[nodiscard]] constexpr bool is_content(int32_t v) noexcept { return v == LV_GRID_CONTENT; }
+[[nodiscard]] constexpr bool is_fr(int32_t v) noexcept { return v >= LV_GRID_FR(0) && v != LV_GRID_TEMPLATE_LAST; }
+[[nodiscard]] constexpr int32_t fr_of(int32_t v) noexcept { return is_fr(v) ? v - LV_GRID_FR(0) : 0; }
+[[nodiscard]] constexpr int32_t px_of(int32_t v) noexcept { return is_fr(v) || is_content(v) ? 0 : v; }
+
+} // namespace grid_track
+
+/**
+ * @brief One axis of a GridTemplate: px sizes, LV_GRID_FR(n) and LV_GRID_CONTENT
+ *
+ * `dsc` is the LV_GRID_TEMPLATE_LAST terminated array LVGL expects, with
+ * static storage.
+ */
+template<int32_t... Tracks>
+struct GridTracks {
+    static_assert(sizeof...(Tracks) > 0, "GridTracks needs at least one track");
+    static_assert(((Tracks != LV_GRID_TEMPLATE_LAST) && ...), "GridTracks adds the terminator itself");
+
+    static constexpr uint32_t count = sizeof...(Tracks);
+    static constexpr int32_t dsc[] = {Tracks..., LV_GRID_TEMPLATE_LAST};
+    static constexpr int32_t fixed_px = (0 + ... + grid_track::px_of(Tracks));
+    static constexpr int32_t fr_sum = (0 + ... + grid_track::fr_of(Tracks));
+    static constexpr bool has_content = (false || ... || grid_track::is_content(Tracks));
+
+    /// Offsets and sizes for `avail` px of content and `gap` px between tracks
+    static void resolve(int32_t avail, int32_t gap, int32_t* pos, int32_t* size) noexcept {
+        int32_t free = avail - fixed_px - gap * static_cast<int32_t>(count - 1);
+        if (free < 0) free = 0;
+        int32_t fr_left = fr_sum;
+        int32_t p = 0;
+        for (uint32_t i = 0; i < count; ++i) {
+            const int32_t fr = grid_track::fr_of(dsc[i]);
+            int32_t s = dsc[i];
+            if (fr) {
+                // The last fr track takes the rounding remainder
+                s = free * fr / fr_left;
+                free -= s;
+                fr_left -= fr;
+            }
+            pos[i] = p;
+            size[i] = s;
+            p += s + gap;
+        }
+    }
+};
+
+/// Layout passes of the containers using one GridTemplate
+struct GridTemplateStats {
+    uint32_t passes;      ///< Layout runs
+    uint32_t reused;      ///< Runs that kept the resolved tracks of the previous run
+    uint32_t fallbacks;   ///< Runs handed to LVGL's grid (RTL, track alignment, margins)
+    uint32_t moved;       ///< Children moved
+    uint32_t resized;     ///< Children stretched to a new cell size
+};
+
+/**
+ * @brief Column and row templates fixed at compile time
+ *
+ * Stateless; the resolved tracks are shared by all containers using the
+ * template (a single-entry cache, keyed by content size and gaps).
+ *
+ * @tparam Cols GridTracks of the columns
+ * @tparam Rows GridTracks of the rows
+ */
+template<typename Cols, typename Rows>
+class GridTemplate {
+    static constexpr uint32_t NC = Cols::count;
+    static constexpr uint32_t NR = Rows::count;
+
+    struct Cache {
+        int32_t avail_w = -1;
+        int32_t avail_h = -1;
+        int32_t gap_col = 0;
+        int32_t gap_row = 0;
+        int32_t col_pos[NC];
+        int32_t col_size[NC];
+        int32_t row_pos[NR];
+        int32_t row_size[NR];
+        GridTemplateStats stats{};
+    };
+
+    [[nodiscard]] static Cache& cache() noexcept {
+        static Cache c;
+        return c;
+    }
+
+    /// Content size on one axis: fixed tracks only when the container sizes to its content
+    [[nodiscard]] static int32_t avail(lv_obj_t* cont, bool x, int32_t gap) noexcept {
+        const int32_t set = x ? lv_obj_get_style_width(cont, LV_PART_MAIN) : lv_obj_get_style_height(cont, LV_PART_MAIN);
+        if (set == LV_SIZE_CONTENT) {
+            return x ? Cols::fixed_px + gap * static_cast<int32_t>(NC - 1)
+                     : Rows::fixed_px + gap * static_cast<int32_t>(NR - 1);
+        }
+        return x ? lv_obj_get_content_width(cont) : lv_obj_get_content_height(cont);
+    }
+
+    [[nodiscard]] static int32_t cell_offset(lv_grid_align_t align, int32_t cell, int32_t& size) noexcept {
+        switch (align) {
+        case LV_GRID_ALIGN_STRETCH: size = cell; return 0;
+        case LV_GRID_ALIGN_CENTER: return (cell - size) / 2;
+        case LV_GRID_ALIGN_END: return cell - size;
+        default: return 0;
+        }
+    }
+
+    [[nodiscard]] static bool has_margin(lv_obj_t* item) noexcept {
+        return lv_obj_get_style_margin_left(item, LV_PART_MAIN) != 0
+            || lv_obj_get_style_margin_right(item, LV_PART_MAIN) != 0
+            || lv_obj_get_style_margin_top(item, LV_PART_MAIN) != 0
+            || lv_obj_get_style_margin_bottom(item, LV_PART_MAIN) != 0;
+    }
+
+    /// Hand the whole pass to LVGL's grid
+    static void fall_back(lv_obj_t* cont, Cache& c) noexcept {
+        ++c.stats.fallbacks;
+        const lv_layout_dsc_t& grid = LV_GLOBAL_DEFAULT()->layout_list[LV_LAYOUT_GRID];
+        grid.cb(cont, grid.user_data);
+    }
+
+    static void update_cb(lv_obj_t* cont, void*) noexcept {
+        Cache& c = cache();
+        ++c.stats.passes;
+        if (lv_obj_get_style_base_dir(cont, LV_PART_MAIN) == LV_BASE_DIR_RTL
+            || (Cols::fr_sum == 0 && lv_obj_get_style_grid_column_align(cont, LV_PART_MAIN) != LV_GRID_ALIGN_START)
+            || (Rows::fr_sum == 0 && lv_obj_get_style_grid_row_align(cont, LV_PART_MAIN) != LV_GRID_ALIGN_START)) {
+            fall_back(cont, c);
+            return;
+        }
+
+        const int32_t gap_col = lv_obj_get_style_pad_column(cont, LV_PART_MAIN);
+        const int32_t gap_row = lv_obj_get_style_pad_row(cont, LV_PART_MAIN);
+        const int32_t w = avail(cont, true, gap_col);
+        const int32_t h = avail(cont, false, gap_row);
+        if (w == c.avail_w && h == c.avail_h && gap_col == c.gap_col && gap_row == c.gap_row) {
+            ++c.stats.reused;
+        } else {
+            Cols::resolve(w, gap_col, c.col_pos, c.col_size);
+            Rows::resolve(h, gap_row, c.row_pos, c.row_size);
+            c.avail_w = w;
+            c.avail_h = h;
+            c.gap_col = gap_col;
+            c.gap_row = gap_row;
+        }
+
+        const int32_t abs_x = cont->coords.x1 + lv_obj_get_style_space_left(cont, LV_PART_MAIN) - lv_obj_get_scroll_x(cont);
+        const int32_t abs_y = cont->coords.y1 + lv_obj_get_style_space_top(cont, LV_PART_MAIN) - lv_obj_get_scroll_y(cont);
+        const uint32_t n = lv_obj_get_child_count(cont);
+        for (uint32_t i = 0; i < n; ++i) {
+            lv_obj_t* item = lv_obj_get_child(cont, static_cast<int32_t>(i));
+            if (lv_obj_has_flag_any(item, static_cast<lv_obj_flag_t>(LV_OBJ_FLAG_HIDDEN | LV_OBJ_FLAG_IGNORE_LAYOUT
+                                                                      | LV_OBJ_FLAG_FLOATING))) {
+                continue;
+            }
+            if (has_margin(item)) {
+                // LVGL's grid places every child again, including those moved above
+                fall_back(cont, c);
+                return;
+            }
+            const uint32_t col = static_cast<uint32_t>(lv_obj_get_style_grid_cell_column_pos(item, LV_PART_MAIN));
+            const uint32_t col_span = static_cast<uint32_t>(lv_obj_get_style_grid_cell_column_span(item, LV_PART_MAIN));
+            const uint32_t row = static_cast<uint32_t>(lv_obj_get_style_grid_cell_row_pos(item, LV_PART_MAIN));
+            const uint32_t row_span = static_cast<uint32_t>(lv_obj_get_style_grid_cell_row_span(item, LV_PART_MAIN));
+            if (col_span == 0 || row_span == 0 || col + col_span > NC || row + row_span > NR) continue;
+
+            const uint32_t last_col = col + col_span - 1;
+            const uint32_t last_row = row + row_span - 1;
+            const int32_t cell_w = c.col_pos[last_col] + c.col_size[last_col] - c.col_pos[col];
+            const int32_t cell_h = c.row_pos[last_row] + c.row_size[last_row] - c.row_pos[row];
+            const lv_grid_align_t x_align = lv_obj_get_style_grid_cell_x_align(item, LV_PART_MAIN);
+            const lv_grid_align_t y_align = lv_obj_get_style_grid_cell_y_align(item, LV_PART_MAIN);
+            int32_t item_w = lv_area_get_width(&item->coords);
+            int32_t item_h = lv_area_get_height(&item->coords);
+            const int32_t x = abs_x + c.col_pos[col] + cell_offset(x_align, cell_w, item_w);
+            const int32_t y = abs_y + c.row_pos[row] + cell_offset(y_align, cell_h, item_h);
+            if (x_align == LV_GRID_ALIGN_STRETCH) item->w_layout = 1;
+            if (y_align == LV_GRID_ALIGN_STRETCH) item->h_layout = 1;
+
+            if (item_w != lv_area_get_width(&item->coords) || item_h != lv_area_get_height(&item->coords)) {
+                lv_area_t old_coords = item->coords;
+                lv_obj_invalidate(item);
+                lv_area_set_width(&item->coords, item_w);
+                lv_area_set_height(&item->coords, item_h);
+                lv_obj_invalidate(item);
+                lv_obj_send_event(item, LV_EVENT_SIZE_CHANGED, &old_coords);
+                lv_obj_send_event(cont, LV_EVENT_CHILD_CHANGED, item);
+                lv_obj_mark_layout_as_dirty(item);
+                ++c.stats.resized;
+            }
+            const int32_t dx = x - item->coords.x1;
+            const int32_t dy = y - item->coords.y1;
+            if (dx || dy) {
+                lv_obj_invalidate(item);
+                lv_area_move(&item->coords, dx, dy);
+                lv_obj_invalidate(item);
+                lv_obj_move_children_by(item, dx, dy, false);
+                ++c.stats.moved;
+            }
+        }
+
+        const int32_t w_set = lv_obj_get_style_width(cont, LV_PART_MAIN);
+        const int32_t h_set = lv_obj_get_style_height(cont, LV_PART_MAIN);
+        if (w_set == LV_SIZE_CONTENT || h_set == LV_SIZE_CONTENT) lv_obj_refr_size(cont);
+        lv_obj_send_event(cont, LV_EVENT_LAYOUT_CHANGED, nullptr);
+    }
+
+public:
+    using columns = Cols;
+    using rows = Rows;
+
+    /// True when the template has no content tracks and gets its own layout
+    static constexpr bool precomputed = !Cols::has_content && !Rows::has_content;
+
+    /// Layout id for containers using this template (LV_LAYOUT_GRID with content tracks)
+    [[nodiscard]] static uint32_t layout() noexcept {
+        if constexpr (precomputed) {
+            static const uint32_t id = lv_layout_register(&GridTemplate::update_cb, nullptr);
+            return id;
+        } else {
+            return LV_LAYOUT_GRID;
+        }
+    }
+
+    /// Set the descriptors and the layout on `grid`
+    static void apply(ObjectView grid) noexcept {
+        lv_obj_set_grid_dsc_array(grid.get(), Cols::dsc, Rows::dsc);
+        lv_obj_set_layout(grid.get(), layout());
+    }
+
+    [[nodiscard]] static GridTemplateStats stats() noexcept { return cache().stats; }
+    static void reset_stats() noexcept { cache().stats = {}; }
+};
+
+} // namespace lv
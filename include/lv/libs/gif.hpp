@@ -37,6 +37,10 @@ namespace lv {
  *       .center();
  * @endcode
  *
+ * Frames are decoded by the widget's timer as they are shown. To decode
+ * ahead in idle time, or keep a short loop fully decoded, play the GIF
+ * into an lv::Image with lv::GifPlayer (core/frame_ahead.hpp) instead.
+ *
  * Size: sizeof(void*) - 4 or 8 bytes
  */
 class GIF : public ObjectView,
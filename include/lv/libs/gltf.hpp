@@ -14,6 +14,7 @@
 #include "../core/object.hpp"
 #include "../core/event.hpp"
 #include "../core/style.hpp"
+#include "gltf_loader.hpp"
 
 namespace lv {
 
@@ -92,6 +93,19 @@ public:
         return lv_gltf_load_model_from_file(m_obj, path);
     }
 
+    /**
+     * @brief Read a glTF model in the background and attach it when done
+     *
+     * Shows a placeholder meanwhile; LV_EVENT_READY carries the
+     * lv_gltf_model_t* (nullptr on failure). Viewers loading the same
+     * path share one read (see gltf_loader.hpp).
+     * @param path File path; copied
+     */
+    GLTF& load_async(const char* path) noexcept {
+        (void)gltf_loader::load(m_obj, path);
+        return *this;
+    }
+
     /**
      * @brief Set environment for IBL (Image-Based Lighting)
      * @param env Environment pointer (can be shared across viewers)
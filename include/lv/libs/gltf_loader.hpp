@@ -0,0 +1,245 @@
+#pragma once
+
+/**
+ * @file gltf_loader.hpp
+ * @brief glTF models read in the background, shared by path, with a placeholder
+ *
+ * lv_gltf_load_model_from_file() reads the file, parses it and uploads
+ * its meshes and textures on the UI thread. A multi-megabyte .glb from an
+ * SD card spends most of that time in the read. GLTF::load_async(path)
+ * (or gltf_loader::load()) shows a placeholder over the viewer and reads
+ * the file on the fs_async I/O worker. Once the bytes are in memory, it
+ * hands them to lv_gltf_load_model_from_bytes() on the UI thread and
+ * sends LV_EVENT_READY to the viewer:
+ *
+ * @code
+ * lv::gltf_loader::set_placeholder(&model_placeholder);
+ * auto viewer = lv::GLTF(screen).size(400, 300);
+ * viewer.load_async("A:/models/helmet.glb");
+ * viewer.on(LV_EVENT_READY, [](lv::Event e) { ... });   // model attached
+ * @endcode
+ *
+ * Viewers loading the same path share one read and one buffer, which is
+ * reference counted and freed when the last of them is deleted; a viewer
+ * created after the read attaches at once. Without a placeholder source,
+ * a spinner is shown (with LV_USE_SPINNER).
+ *
+ * Parsing and GPU upload stay on the UI thread: LVGL owns the only GL
+ * context, and lv_gltf has no API to parse into a model without a
+ * viewer. Only the file I/O moves to the worker.
+ *
+ * Heap allocation: NONE in the wrapper (fixed model/view tables); file
+ * bytes come from the DrawBufPool through fs::read_async()
+ */
+
+#include <lvgl.h>
+
+#if LV_USE_GLTF
+
+#include <cstdint>
+#include <cstring>
+#include "../core/fs_async.hpp"
+
+#ifndef LV_CPP_GLTF_LOADER_MODELS
+/// Distinct model files being read or held at once
+#define LV_CPP_GLTF_LOADER_MODELS 4
+#endif
+
+#ifndef LV_CPP_GLTF_LOADER_VIEWS
+/// Viewers waiting for or showing an async-loaded model
+#define LV_CPP_GLTF_LOADER_VIEWS 8
+#endif
+
+#ifndef LV_CPP_GLTF_LOADER_PATH
+/// Longest path stored (longer ones load synchronously)
+#define LV_CPP_GLTF_LOADER_PATH 64
+#endif
+
+namespace lv::gltf_loader {
+
+namespace detail {
+
+enum class ModelState : uint8_t { free, reading, ready, failed };
+
+struct Model {
+    char path[LV_CPP_GLTF_LOADER_PATH];
+    uint8_t* bytes = nullptr;       ///< File contents (pooled, ready)
+    uint32_t len = 0;
+    uint32_t io = 0;                ///< fs::read_async() request
+    uint32_t refs = 0;              ///< Views using it
+    ModelState state = ModelState::free;
+
+    void on_read(fs::IoResult& r) noexcept;
+};
+
+struct View {
+    lv_obj_t* obj = nullptr;        ///< nullptr: free slot
+    Model* model = nullptr;
+    lv_obj_t* placeholder = nullptr;
+    bool waiting = false;           ///< Model not attached yet
+};
+
+struct Loader {
+    Model models[LV_CPP_GLTF_LOADER_MODELS];
+    View views[LV_CPP_GLTF_LOADER_VIEWS];
+    const void* placeholder = nullptr;
+};
+
+[[nodiscard]] inline Loader& loader() noexcept {
+    static Loader l;
+    return l;
+}
+
+[[nodiscard]] inline View* find_view(Loader& l, const lv_obj_t* obj) noexcept {
+    for (View& v : l.views) {
+        if (v.obj == obj) return &v;
+    }
+    return nullptr;
+}
+
+/// Drop a model no view uses any more
+inline void maybe_free_model(Model& m) noexcept {
+    if (m.refs != 0 || m.state == ModelState::free) return;
+    if (m.state == ModelState::reading) fs::cancel(m.io);
+    fs::release_buffer(m.bytes);
+    m = Model{};
+}
+
+inline void unbind(View& v) noexcept {
+    if (v.placeholder) lv_obj_delete(v.placeholder);
+    if (v.model) {
+        --v.model->refs;
+        maybe_free_model(*v.model);
+    }
+    v = View{};
+}
+
+inline void delete_cb(lv_event_t* ev) {
+    View* v = find_view(loader(), static_cast<lv_obj_t*>(lv_event_get_current_target(ev)));
+    if (!v) return;
+    v->placeholder = nullptr;   // deleted with the viewer
+    unbind(*v);
+}
+
+/// Placeholder over `obj`: the configured source, else a spinner
+[[nodiscard]] inline lv_obj_t* show_placeholder(lv_obj_t* obj, const void* src) noexcept {
+    lv_obj_t* p = nullptr;
+    if (src) {
+        p = lv_image_create(obj);
+        lv_image_set_src(p, src);
+    } else {
+#if LV_USE_SPINNER
+        p = lv_spinner_create(obj);
+        lv_obj_set_size(p, 48, 48);
+#endif
+    }
+    if (p) {
+        lv_obj_center(p);
+        lv_obj_add_flag(p, LV_OBJ_FLAG_IGNORE_LAYOUT);
+        lv_obj_remove_flag(p, LV_OBJ_FLAG_CLICKABLE);
+    }
+    return p;
+}
+
+/// Give the read model to `v`'s viewer (UI thread)
+inline void attach(View& v) noexcept {
+    v.waiting = false;
+    if (v.placeholder) {
+        lv_obj_delete(v.placeholder);
+        v.placeholder = nullptr;
+    }
+    Model& m = *v.model;
+    lv_gltf_model_t* model = nullptr;
+    if (m.state == ModelState::ready) model = lv_gltf_load_model_from_bytes(v.obj, m.bytes, m.len);
+    else model = lv_gltf_load_model_from_file(v.obj, m.path);   // synchronous fallback reports the error
+    lv_obj_send_event(v.obj, LV_EVENT_READY, model);
+}
+
+inline void Model::on_read(fs::IoResult& r) noexcept {
+    if (r.ok() && r.bytes) {
+        bytes = r.take();
+        len = r.bytes;
+        state = ModelState::ready;
+    } else {
+        state = ModelState::failed;
+    }
+    io = 0;
+    for (View& v : loader().views) {
+        if (v.obj && v.waiting && v.model == this) attach(v);
+    }
+}
+
+[[nodiscard]] inline Model* find_or_read_model(Loader& l, const char* path) noexcept {
+    Model* free_model = nullptr;
+    for (Model& m : l.models) {
+        if (m.state == ModelState::free) {
+            if (!free_model) free_model = &m;
+        } else if (m.state != ModelState::failed && std::strcmp(m.path, path) == 0) {
+            return &m;
+        }
+    }
+    if (!free_model) return nullptr;
+    std::memcpy(free_model->path, path, std::strlen(path) + 1);
+    free_model->state = ModelState::reading;
+    free_model->io = fs::read_async<&Model::on_read>(free_model->path, free_model);
+    if (!free_model->io) {
+        *free_model = Model{};
+        return nullptr;
+    }
+    return free_model;
+}
+
+} // namespace detail
+
+/// Default placeholder source shown over a loading viewer (nullptr: a spinner)
+inline void set_placeholder(const void* src) noexcept { detail::loader().placeholder = src; }
+
+/**
+ * @brief Read `path` in the background and attach it to viewer `obj` when done
+ * @param path File path; copied, must be shorter than LV_CPP_GLTF_LOADER_PATH
+ * @return false if it was loaded synchronously (path too long, tables full)
+ */
+inline bool load(lv_obj_t* obj, const char* path) noexcept {
+    if (!obj || !path) return false;
+    detail::Loader& l = detail::loader();
+    detail::View* v = detail::find_view(l, obj);
+    if (v) {
+        detail::unbind(*v);
+    } else {
+        v = detail::find_view(l, nullptr);
+        if (v) lv_obj_add_event_cb(obj, &detail::delete_cb, LV_EVENT_DELETE, nullptr);
+    }
+    detail::Model* m = nullptr;
+    if (v && std::strlen(path) < LV_CPP_GLTF_LOADER_PATH) m = detail::find_or_read_model(l, path);
+    if (!m) {
+        if (v) lv_obj_remove_event_cb_with_user_data(obj, &detail::delete_cb, nullptr);
+        lv_obj_send_event(obj, LV_EVENT_READY, lv_gltf_load_model_from_file(obj, path));
+        return false;
+    }
+    ++m->refs;
+    *v = detail::View{obj, m, nullptr, true};
+    if (m->state == detail::ModelState::ready) {
+        detail::attach(*v);   // already read for another viewer
+    } else {
+        v->placeholder = detail::show_placeholder(obj, l.placeholder);
+    }
+    return true;
+}
+
+/// Viewers still waiting for their model
+[[nodiscard]] inline uint32_t pending() noexcept {
+    uint32_t n = 0;
+    for (const detail::View& v : detail::loader().views) n += v.obj && v.waiting;
+    return n;
+}
+
+/// Model files currently held in memory (shared by the viewers showing them)
+[[nodiscard]] inline uint32_t cached() noexcept {
+    uint32_t n = 0;
+    for (const detail::Model& m : detail::loader().models) n += m.state == detail::ModelState::ready;
+    return n;
+}
+
+} // namespace lv::gltf_loader
+
+#endif // LV_USE_GLTF
@@ -0,0 +1,467 @@
+#pragma once
+
+/**
+ * @file qr_encoder.hpp
+ * @brief QR code encoding on a worker thread, with encoded results cached by payload
+ *
+ * lv_qrcode_update() encodes on the caller's thread. Picking the mask
+ * pattern runs the whole symbol eight times, so a version 20+ code costs
+ * tens of milliseconds on an MCU, inside an event handler or a screen's
+ * first frame. qr_encoder::update() queues the encoding for a worker.
+ * When the worker is done, an LVGL timer draws the modules into the
+ * widget's canvas on the UI thread:
+ *
+ * @code
+ * #include <lv/libs/qr_encoder.hpp>
+ *
+ * auto qr = lv::QRCode(screen).size(200);
+ * lv::qr_encoder::update(qr, uri.data(), static_cast<uint32_t>(uri.size()));   // canvas stays light until encoded
+ * @endcode
+ *
+ * Encoded module matrices are cached by payload: showing the same data
+ * in another QR code (another screen, another size or other colors)
+ * draws from the cache without encoding again. LV_CPP_QR_ENCODER_JOBS
+ * payloads are kept; the least recently used unreferenced one is reused
+ * for a new payload.
+ *
+ * The async path draws the modules itself: scaled by the largest integer
+ * that fits the canvas, centred, with a 4-module margin when the quiet
+ * zone is on. Its version is the smallest that fits the data at medium
+ * error correction; LVGL's own update may pick a larger version to
+ * fill the canvas. A synchronous update through the QRCode wrapper
+ * cancels a pending async one.
+ *
+ * Threads: with LV_USE_OS != LV_OS_NONE, one lv_thread worker encodes.
+ * Without an OS, the timer encodes one payload per tick on the UI thread.
+ *
+ * Not included by lv.hpp: it reads lv_qrcode_t's dark_color, light_color
+ * and quiet_zone, which have no getters. Checked against LVGL 9.4 (see
+ * LV_CPP_INTERNALS_OK).
+ *
+ * Heap allocation: NONE in the wrapper (fixed job/binding tables); payload
+ * copies and module matrices come from the DrawBufPool
+ */
+
+#include <lvgl.h>
+#include "../core/version.hpp"
+
+#if LV_USE_QRCODE
+
+#if !LV_CPP_INTERNALS_OK
+#error "qr_encoder.hpp reads LVGL internals checked against LVGL 9.4; see LV_CPP_INTERNALS_OK"
+#endif
+
+#include <src/libs/qrcode/qrcodegen.h>
+#include <src/libs/qrcode/lv_qrcode_private.h>   // lv_qrcode_t::dark_color, light_color, quiet_zone
+#include <cstdint>
+#include <cstring>
+#include "../draw/draw_buf.hpp"
+#include "qrcode.hpp"
+
+#ifndef LV_CPP_QR_ENCODER_JOBS
+/// Payloads queued, encoding or cached at once
+#define LV_CPP_QR_ENCODER_JOBS 8
+#endif
+
+#ifndef LV_CPP_QR_ENCODER_BINDINGS
+/// QR codes waiting for an async result
+#define LV_CPP_QR_ENCODER_BINDINGS 8
+#endif
+
+#ifndef LV_CPP_QR_ENCODER_STACK
+/// Stack of the encoder thread in bytes
+#define LV_CPP_QR_ENCODER_STACK (8 * 1024)
+#endif
+
+#ifndef LV_CPP_QR_ENCODER_POLL_MS
+/// Period of the UI-thread timer drawing encoded results
+#define LV_CPP_QR_ENCODER_POLL_MS 15
+#endif
+
+namespace lv::qr_encoder {
+
+/// Counters of the QR encoder
+struct Stats {
+    uint32_t encoded;     ///< payloads encoded
+    uint32_t hits;        ///< updates drawn from a cached encoding
+    uint32_t pending;     ///< QR codes waiting for a result
+    uint32_t cached;      ///< encoded payloads held
+};
+
+namespace detail {
+
+enum class JobState : uint8_t { free, queued, encoding, done, failed };
+
+struct Job {
+    uint8_t* data = nullptr;        ///< Payload copy (pooled)
+    uint32_t len = 0;
+    uint32_t hash = 0;
+    uint8_t* modules = nullptr;     ///< qrcodegen output (pooled, done)
+    JobState state = JobState::free;
+    uint32_t refs = 0;              ///< Bindings waiting for it
+    uint32_t used = 0;              ///< Queue order, then LRU stamp
+};
+
+struct Binding {
+    lv_obj_t* obj = nullptr;        ///< nullptr: free slot
+    Job* job = nullptr;
+};
+
+struct Encoder {
+    Job jobs[LV_CPP_QR_ENCODER_JOBS];
+    Binding bindings[LV_CPP_QR_ENCODER_BINDINGS];
+    lv_timer_t* timer = nullptr;
+    uint32_t clock = 0;
+    Stats stats{};
+    lv_mutex_t lock;
+#if LV_USE_OS != LV_OS_NONE
+    lv_thread_t thread;
+    lv_thread_sync_t wake;
+    bool running = false;
+    bool stopping = false;
+#endif
+
+    Encoder() noexcept { lv_mutex_init(&lock); }
+};
+
+[[nodiscard]] inline Encoder& encoder() noexcept {
+    static Encoder e;
+    return e;
+}
+
+struct EncoderLock {
+    Encoder& e;
+    explicit EncoderLock(Encoder& encoder) noexcept : e(encoder) { lv_mutex_lock(&e.lock); }
+    ~EncoderLock() { lv_mutex_unlock(&e.lock); }
+    EncoderLock(const EncoderLock&) = delete;
+    EncoderLock& operator=(const EncoderLock&) = delete;
+};
+
+[[nodiscard]] inline uint8_t* pool_alloc(uint32_t bytes) noexcept {
+    return static_cast<uint8_t*>(draw::pool_malloc(bytes, LV_COLOR_FORMAT_RAW));
+}
+
+inline void pool_free(uint8_t* p) noexcept {
+    if (p) draw::pool_free(p);
+}
+
+/// FNV-1a of the payload
+[[nodiscard]] inline uint32_t hash(const uint8_t* data, uint32_t len) noexcept {
+    uint32_t h = 2166136261u;
+    for (uint32_t i = 0; i < len; ++i) h = (h ^ data[i]) * 16777619u;
+    return h;
+}
+
+/// Encode `len` bytes into a pooled module matrix (nullptr if they do not fit a QR code)
+[[nodiscard]] inline uint8_t* encode(const uint8_t* data, uint32_t len) noexcept {
+    uint8_t* temp = pool_alloc(qrcodegen_BUFFER_LEN_MAX);
+    uint8_t* out = pool_alloc(qrcodegen_BUFFER_LEN_MAX);
+    bool ok = temp && out;
+    if (ok) {
+        std::memcpy(temp, data, len);
+        ok = qrcodegen_encodeBinary(temp, len, out, qrcodegen_Ecc_MEDIUM, qrcodegen_VERSION_MIN,
+                                    qrcodegen_VERSION_MAX, qrcodegen_Mask_AUTO, true);
+    }
+    pool_free(temp);
+    if (ok) return out;
+    pool_free(out);
+    return nullptr;
+}
+
+/// Oldest queued job, marked encoding (call with the lock held)
+[[nodiscard]] inline Job* take_job(Encoder& e) noexcept {
+    Job* next = nullptr;
+    for (Job& j : e.jobs) {
+        if (j.state == JobState::queued && (!next || j.used - next->used > UINT32_MAX / 2)) next = &j;
+    }
+    if (next) next->state = JobState::encoding;
+    return next;
+}
+
+inline void run_job(Encoder& e, Job& j) noexcept {
+    uint8_t* modules = encode(j.data, j.len);
+    EncoderLock lock(e);
+    j.modules = modules;
+    j.state = modules ? JobState::done : JobState::failed;
+    if (modules) ++e.stats.encoded;
+}
+
+#if LV_USE_OS != LV_OS_NONE
+inline void worker_main(void*) {
+    Encoder& e = encoder();
+    for (;;) {
+        Job* j = nullptr;
+        {
+            EncoderLock lock(e);
+            if (e.stopping) break;
+            j = take_job(e);
+        }
+        if (j) run_job(e, *j);
+        else lv_thread_sync_wait(&e.wake);
+    }
+}
+
+inline void start_worker(Encoder& e) noexcept {
+    if (e.running) return;
+    lv_thread_sync_init(&e.wake);
+#if LV_VERSION_AT_LEAST(9, 3, 0)
+    const lv_result_t res = lv_thread_init(&e.thread, "lv_qr_encoder", LV_THREAD_PRIO_LOW, &worker_main,
+                                           LV_CPP_QR_ENCODER_STACK, nullptr);
+#else
+    const lv_result_t res = lv_thread_init(&e.thread, LV_THREAD_PRIO_LOW, &worker_main, LV_CPP_QR_ENCODER_STACK,
+                                           nullptr);
+#endif
+    if (res != LV_RESULT_OK) {
+        lv_thread_sync_delete(&e.wake);
+        LV_LOG_WARN("qr encoder: cannot start worker thread");
+        return;
+    }
+    e.running = true;
+}
+
+inline void stop_worker(Encoder& e) noexcept {
+    if (!e.running) return;
+    {
+        EncoderLock lock(e);
+        e.stopping = true;
+    }
+    lv_thread_sync_signal(&e.wake);
+    lv_thread_delete(&e.thread);
+    lv_thread_sync_delete(&e.wake);
+    EncoderLock lock(e);
+    e.running = false;
+    e.stopping = false;
+}
+#endif
+
+/// Release a job's buffers (call with the lock held; not while encoding)
+inline void free_job(Job& j) noexcept {
+    pool_free(j.data);
+    pool_free(j.modules);
+    j = Job{};
+}
+
+[[nodiscard]] inline Binding* find_binding(Encoder& e, const lv_obj_t* obj) noexcept {
+    for (Binding& b : e.bindings) {
+        if (b.obj == obj) return &b;
+    }
+    return nullptr;
+}
+
+/// Drop `b`; a queued job nobody waits for any more is dropped too (call with the lock held)
+inline void unbind(Encoder& e, Binding& b) noexcept {
+    if (b.job && --b.job->refs == 0 && b.job->state == JobState::queued) free_job(*b.job);
+    if (b.obj) --e.stats.pending;
+    b = Binding{};
+}
+
+inline void delete_cb(lv_event_t* ev) {
+    Encoder& e = encoder();
+    EncoderLock lock(e);
+    if (Binding* b = find_binding(e, static_cast<lv_obj_t*>(lv_event_get_current_target(ev)))) unbind(e, *b);
+}
+
+/// Set `len` pixels from `x` in an I1 row to index 1
+inline void set_bits(uint8_t* row, int32_t x, int32_t len) noexcept {
+    for (int32_t i = x; i < x + len; ++i) row[i >> 3] |= static_cast<uint8_t>(0x80 >> (i & 7));
+}
+
+/// Row `y` of an I1 canvas buffer (after its palette, as lv_canvas addresses it)
+[[nodiscard]] inline uint8_t* row(lv_draw_buf_t* buf, int32_t y) noexcept {
+    return buf->data + LV_COLOR_INDEXED_PALETTE_SIZE(LV_COLOR_FORMAT_I1) * sizeof(lv_color32_t) +
+           static_cast<uint32_t>(y) * buf->header.stride;
+}
+
+/// Clear `obj`'s canvas to its light color; nullptr if it has no buffer
+inline lv_draw_buf_t* clear(lv_obj_t* obj) noexcept {
+    auto* q = reinterpret_cast<lv_qrcode_t*>(obj);
+    lv_draw_buf_t* buf = lv_canvas_get_draw_buf(obj);
+    if (!buf) return nullptr;
+    lv_draw_buf_clear(buf, nullptr);
+    lv_canvas_set_palette(obj, 0, lv_color_to_32(q->light_color, LV_OPA_COVER));
+    lv_canvas_set_palette(obj, 1, lv_color_to_32(q->dark_color, LV_OPA_COVER));
+    lv_image_cache_drop(buf);
+    lv_obj_invalidate(obj);
+    return buf;
+}
+
+/// Draw an encoded module matrix into `obj`'s canvas (UI thread)
+inline void draw(lv_obj_t* obj, const uint8_t* modules) noexcept {
+    lv_draw_buf_t* buf = clear(obj);
+    if (!buf) return;
+    const int32_t n = qrcodegen_getSize(modules);
+    const int32_t margin = reinterpret_cast<lv_qrcode_t*>(obj)->quiet_zone ? 4 : 0;
+    const int32_t w = static_cast<int32_t>(buf->header.w);
+    const int32_t scale = w / (n + 2 * margin);
+    if (scale <= 0) return;
+    const int32_t ofs = (w - n * scale) / 2;
+    for (int32_t my = 0; my < n; ++my) {
+        uint8_t* first = row(buf, ofs + my * scale);
+        for (int32_t mx = 0; mx < n;) {
+            if (!qrcodegen_getModule(modules, mx, my)) {
+                ++mx;
+                continue;
+            }
+            int32_t run = 1;
+            while (mx + run < n && qrcodegen_getModule(modules, mx + run, my)) ++run;
+            set_bits(first, ofs + mx * scale, run * scale);
+            mx += run;
+        }
+        // Repeat the module row down its scale
+        for (int32_t r = 1; r < scale; ++r) std::memcpy(row(buf, ofs + my * scale + r), first, buf->header.stride);
+    }
+}
+
+inline void poll_cb(lv_timer_t* t) {
+    Encoder& e = encoder();
+    bool here = true;   // no worker: encode one payload per tick
+#if LV_USE_OS != LV_OS_NONE
+    here = !e.running;
+#endif
+    if (here) {
+        Job* next = nullptr;
+        {
+            EncoderLock lock(e);
+            next = take_job(e);
+        }
+        if (next) run_job(e, *next);
+    }
+    EncoderLock lock(e);
+    bool busy = false;
+    for (Binding& b : e.bindings) {
+        if (!b.obj) continue;
+        if (b.job->state == JobState::done) {
+            b.job->used = ++e.clock;
+            draw(b.obj, b.job->modules);
+        } else if (b.job->state != JobState::failed) {
+            busy = true;
+            continue;
+        }
+        lv_obj_remove_event_cb(b.obj, &delete_cb);
+        Job* j = b.job;
+        unbind(e, b);
+        if (j->state == JobState::failed && j->refs == 0) free_job(*j);
+    }
+    if (!busy) lv_timer_pause(t);
+}
+
+/// Cached or in-flight job for the payload, else a new queued one; nullptr if the table is busy
+[[nodiscard]] inline Job* find_or_queue_job(Encoder& e, const uint8_t* data, uint32_t len) noexcept {
+    const uint32_t h = hash(data, len);
+    Job* slot = nullptr;
+    for (Job& j : e.jobs) {
+        if (j.state == JobState::free) {
+            if (!slot || slot->state != JobState::free) slot = &j;
+            continue;
+        }
+        if (j.state != JobState::failed && j.hash == h && j.len == len && std::memcmp(j.data, data, len) == 0) {
+            return &j;
+        }
+        // The least recently used cached result nobody waits for can go
+        if (j.state == JobState::done && j.refs == 0 && (!slot || (slot->state != JobState::free && j.used < slot->used))) {
+            slot = &j;
+        }
+    }
+    if (!slot) return nullptr;
+    if (slot->state == JobState::done) free_job(*slot);
+    uint8_t* copy = pool_alloc(len ? len : 1);
+    if (!copy) return nullptr;
+    std::memcpy(copy, data, len);
+    slot->data = copy;
+    slot->len = len;
+    slot->hash = h;
+    slot->state = JobState::queued;
+    slot->refs = 0;
+    slot->used = ++e.clock;
+    return slot;
+}
+
+} // namespace detail
+
+inline void cancel(lv_obj_t* obj) noexcept;
+
+/**
+ * @brief Show `len` bytes of `data` in QR code `obj` once encoded in the background
+ *
+ * `data` is copied. A cached payload is drawn right away. The canvas is
+ * cleared to the light color until the result arrives.
+ *
+ * @return false if the payload is too long for a QR code or the tables
+ *         are full (nothing changes then)
+ */
+inline bool update(lv_obj_t* obj, const void* data, uint32_t len) noexcept {
+    if (!obj || !data || len > qrcodegen_BUFFER_LEN_MAX) return false;
+    lv::detail::qr_cancel_hook() = &cancel;   // QRCode's synchronous setters cancel from now on
+    detail::Encoder& e = detail::encoder();
+    {
+        detail::EncoderLock lock(e);
+        detail::Binding* b = detail::find_binding(e, obj);
+        if (b) detail::unbind(e, *b);
+        detail::Job* j = detail::find_or_queue_job(e, static_cast<const uint8_t*>(data), len);
+        if (!j) return false;
+        if (j->state == detail::JobState::done) {
+            j->used = ++e.clock;
+            ++e.stats.hits;
+            lv_obj_remove_event_cb(obj, &detail::delete_cb);
+            detail::draw(obj, j->modules);
+            return true;
+        }
+        if (!b) b = detail::find_binding(e, nullptr);
+        if (!b) {
+            if (j->refs == 0 && j->state == detail::JobState::queued) detail::free_job(*j);
+            return false;
+        }
+        lv_obj_remove_event_cb(obj, &detail::delete_cb);
+        lv_obj_add_event_cb(obj, &detail::delete_cb, LV_EVENT_DELETE, nullptr);
+        ++j->refs;
+        *b = detail::Binding{obj, j};
+        ++e.stats.pending;
+        (void)detail::clear(obj);   // light meanwhile, as lv_qrcode_update() leaves it on failure
+    }
+    if (!e.timer) e.timer = lv_timer_create(&detail::poll_cb, LV_CPP_QR_ENCODER_POLL_MS, nullptr);
+    else lv_timer_resume(e.timer);
+#if LV_USE_OS != LV_OS_NONE
+    detail::start_worker(e);
+    if (e.running) lv_thread_sync_signal(&e.wake);
+#endif
+    return true;
+}
+
+/// Forget a pending update of `obj` (its canvas keeps what it shows)
+inline void cancel(lv_obj_t* obj) noexcept {
+    detail::Encoder& e = detail::encoder();
+    detail::EncoderLock lock(e);
+    detail::Binding* b = detail::find_binding(e, obj);
+    if (!b) return;
+    lv_obj_remove_event_cb(obj, &detail::delete_cb);
+    detail::unbind(e, *b);
+}
+
+[[nodiscard]] inline Stats stats() noexcept {
+    detail::Encoder& e = detail::encoder();
+    detail::EncoderLock lock(e);
+    Stats s = e.stats;
+    s.cached = 0;
+    for (const detail::Job& j : e.jobs) s.cached += j.state == detail::JobState::done;
+    return s;
+}
+
+/// Free every cached encoding nobody waits for
+inline void drop() noexcept {
+    detail::Encoder& e = detail::encoder();
+    detail::EncoderLock lock(e);
+    for (detail::Job& j : e.jobs) {
+        if (j.state == detail::JobState::done && j.refs == 0) detail::free_job(j);
+    }
+}
+
+/// Stop the worker thread (pending updates wait until the next update())
+inline void shutdown() noexcept {
+#if LV_USE_OS != LV_OS_NONE
+    detail::stop_worker(detail::encoder());
+#endif
+}
+
+} // namespace lv::qr_encoder
+
+#endif // LV_USE_QRCODE
@@ -18,6 +18,17 @@
 
 namespace lv {
 
+namespace detail {
+
+/// Pending-update cancel hook installed by qr_encoder.hpp (nullptr: nothing encoded in the background)
+using qr_cancel_fn = void (*)(lv_obj_t* obj);
+
+[[nodiscard]] inline qr_cancel_fn& qr_cancel_hook() noexcept {
+    static qr_cancel_fn hook = nullptr;
+    return hook;
+}
+} // namespace detail
+
 /**
  * @brief QR Code widget wrapper
  *
@@ -33,6 +44,9 @@ namespace lv {
  *       .center();
  * @endcode
  *
+ * qr_encoder::update() (qr_encoder.hpp, opt-in) encodes on a worker
+ * thread instead; data() and update() cancel a pending one.
+ *
  * Size: sizeof(void*) - 4 or 8 bytes
  */
 class QRCode : public ObjectView,
@@ -98,6 +112,7 @@ public:
      * @param text Text to encode
      */
     QRCode& data(const char* text) noexcept {
+        if (detail::qr_cancel_hook()) detail::qr_cancel_hook()(m_obj);
         lv_qrcode_set_data(m_obj, text);
         return *this;
     }
@@ -108,6 +123,7 @@ public:
      */
     QRCode& data(std::string_view text) noexcept {
         // lv_qrcode_update handles the length, so we can use it directly
+        if (detail::qr_cancel_hook()) detail::qr_cancel_hook()(m_obj);
         lv_qrcode_update(m_obj, text.data(), static_cast<uint32_t>(text.size()));
         return *this;
     }
@@ -119,6 +135,7 @@ public:
      * @return true if successful
      */
     [[nodiscard]] bool update(const void* data, uint32_t len) noexcept {
+        if (detail::qr_cancel_hook()) detail::qr_cancel_hook()(m_obj);
         return lv_qrcode_update(m_obj, data, len) == LV_RESULT_OK;
     }
 };
@@ -9,15 +9,242 @@
  * Usage:
  *   lv::svg::Node doc(svg_data, data_len);
  *   lv::svg::draw(layer, doc);
+ *
+ * draw() keeps the render list compiled from each document (LVGL's
+ * flattened paths with their paint) in a small LRU cache, so drawing an
+ * icon 50 times builds it once; the scale comes from the draw transform,
+ * so one entry serves every size. For static icons at a fixed size,
+ * raster() renders once into a pooled ARGB8888 buffer shared by all
+ * handles of the same (document, size), and images just blit it:
+ *
+ * @code
+ * static lv::svg::Node gear(gear_svg);
+ * lv::svg::Raster icon = lv::svg::raster(gear, 24, 24);
+ * for (auto& row : rows) lv::Image::create(row).src(icon.src());
+ * @endcode
+ *
+ * raster() draws synchronously into an off-screen layer: call it from UI
+ * code, not from inside a draw event. Both caches are dropped for a
+ * document when its Node is destroyed (rasters still held by handles stay
+ * until the last handle goes). svg::stats() reports hits and misses.
+ *
+ * Heap allocation: NONE in the wrapper (fixed tables; render lists are
+ * LVGL's, raster pixels come from the DrawBufPool)
  */
 
 #include <lvgl.h>
+#include <cstdint>
 #include <cstring>
 
 #if LV_USE_SVG
 
+#include "../draw/draw_buf.hpp"
+
+#ifndef LV_CPP_SVG_COMPILED
+/// Documents whose compiled render list is kept
+#define LV_CPP_SVG_COMPILED 16
+#endif
+
+#ifndef LV_CPP_SVG_RASTERS
+/// Distinct (document, size) rasters cached
+#define LV_CPP_SVG_RASTERS 32
+#endif
+
+#ifndef LV_CPP_SVG_RASTER_BYTES
+/// Pixel bytes unreferenced rasters may keep before the least recently used go
+#define LV_CPP_SVG_RASTER_BYTES (256u * 1024u)
+#endif
+
 namespace lv::svg {
 
+/// Hit/miss counters of both caches
+struct Stats {
+    uint32_t compiled;         ///< documents with a cached render list
+    uint32_t compiled_bytes;   ///< lv_svg_render_get_size() of those lists
+    uint32_t compile_hits;
+    uint32_t compile_misses;
+    uint32_t rasters;          ///< cached rasters
+    uint32_t raster_bytes;
+    uint32_t raster_hits;
+    uint32_t raster_misses;
+};
+
+namespace detail {
+
+struct Compiled {
+    const lv_svg_node_t* doc = nullptr;
+    lv_svg_render_obj_t* list = nullptr;
+    uint32_t bytes = 0;
+    uint32_t used = 0;    ///< LRU stamp
+};
+
+struct RasterEntry {
+    const lv_svg_node_t* doc = nullptr;   ///< nullptr once the document is gone
+    lv_draw_buf_t* buf = nullptr;
+    uint16_t w = 0;
+    uint16_t h = 0;
+    uint16_t refs = 0;
+    uint32_t used = 0;
+};
+
+struct Caches {
+    Compiled compiled[LV_CPP_SVG_COMPILED];
+    RasterEntry rasters[LV_CPP_SVG_RASTERS];
+    uint32_t clock = 0;
+    Stats stats{};
+};
+
+[[nodiscard]] inline Caches& caches() noexcept {
+    static Caches c;
+    return c;
+}
+
+/// Cached render list of `doc`, compiled on a miss (evicting the least recently used)
+[[nodiscard]] inline lv_svg_render_obj_t* compiled(const lv_svg_node_t* doc) noexcept {
+    if (!doc) return nullptr;
+    Caches& c = caches();
+    Compiled* victim = &c.compiled[0];
+    for (Compiled& e : c.compiled) {
+        if (e.doc == doc) {
+            e.used = ++c.clock;
+            ++c.stats.compile_hits;
+            return e.list;
+        }
+        if (!e.doc || (victim->doc && e.used < victim->used)) victim = &e;
+    }
+    ++c.stats.compile_misses;
+    lv_svg_render_obj_t* list = lv_svg_render_create(doc);
+    if (!list) return nullptr;
+    if (victim->list) lv_svg_render_delete(victim->list);
+    *victim = Compiled{doc, list, lv_svg_render_get_size(list), ++c.clock};
+    return list;
+}
+
+[[nodiscard]] inline uint32_t idle_raster_bytes(const Caches& c) noexcept {
+    uint32_t n = 0;
+    for (const RasterEntry& e : c.rasters) {
+        if (e.buf && !e.refs) n += e.buf->data_size;
+    }
+    return n;
+}
+
+inline void free_raster(RasterEntry& e) noexcept {
+    if (e.buf) {
+        lv_image_cache_drop(e.buf);
+        lv_draw_buf_destroy(e.buf);
+    }
+    e = RasterEntry{};
+}
+
+/// Evict unreferenced rasters (oldest first) until `extra` more bytes fit the cap
+inline void trim_rasters(Caches& c, uint32_t extra) noexcept {
+    while (idle_raster_bytes(c) + extra > LV_CPP_SVG_RASTER_BYTES) {
+        RasterEntry* oldest = nullptr;
+        for (RasterEntry& e : c.rasters) {
+            if (e.buf && !e.refs && (!oldest || e.used < oldest->used)) oldest = &e;
+        }
+        if (!oldest) return;
+        free_raster(*oldest);
+    }
+}
+
+/// Forget everything cached for `doc` (called when its Node goes)
+inline void forget(const lv_svg_node_t* doc) noexcept {
+    Caches& c = caches();
+    for (Compiled& e : c.compiled) {
+        if (e.doc != doc) continue;
+        lv_svg_render_delete(e.list);
+        e = Compiled{};
+    }
+    for (RasterEntry& e : c.rasters) {
+        if (e.doc != doc) continue;
+        if (e.refs) {
+            e.doc = nullptr;   // handles keep the pixels; no new hits
+        } else {
+            free_raster(e);
+        }
+    }
+}
+
+/// Draw `list` scaled uniformly into `area` (centered), or untransformed if area is null
+inline void draw_list(lv_layer_t* layer, lv_svg_render_obj_t* list, const lv_area_t* area) noexcept {
+    lv_draw_vector_dsc_t* dsc = lv_draw_vector_dsc_create(layer);
+    if (!dsc) return;
+    float vw = 0, vh = 0;
+    if (area && lv_svg_render_get_viewport_size(list, &vw, &vh) == LV_RESULT_OK && vw > 0 && vh > 0) {
+        const float aw = static_cast<float>(lv_area_get_width(area));
+        const float ah = static_cast<float>(lv_area_get_height(area));
+        const float scale = aw / vw < ah / vh ? aw / vw : ah / vh;
+        lv_draw_vector_dsc_translate(dsc, area->x1 + (aw - vw * scale) / 2, area->y1 + (ah - vh * scale) / 2);
+        lv_draw_vector_dsc_scale(dsc, scale, scale);
+    } else if (area) {
+        lv_draw_vector_dsc_translate(dsc, static_cast<float>(area->x1), static_cast<float>(area->y1));
+    }
+    lv_draw_svg_render(dsc, list);
+    lv_draw_vector(dsc);
+    lv_draw_vector_dsc_delete(dsc);
+}
+
+/// Render `list` into a new w x h ARGB8888 pooled buffer (off-screen, synchronous)
+[[nodiscard]] inline lv_draw_buf_t* rasterize(lv_svg_render_obj_t* list, uint16_t w, uint16_t h) noexcept {
+    lv_draw_buf_t* buf = lv_draw_buf_create_ex(draw::pool_handlers(), w, h, LV_COLOR_FORMAT_ARGB8888, 0);
+    if (!buf) return nullptr;
+    lv_draw_buf_clear(buf, nullptr);
+    const lv_area_t area{0, 0, static_cast<int32_t>(w) - 1, static_cast<int32_t>(h) - 1};
+    lv_layer_t layer;
+    lv_layer_init(&layer);
+    layer.draw_buf = buf;
+    layer.color_format = LV_COLOR_FORMAT_ARGB8888;
+    layer.buf_area = area;
+    layer._clip_area = area;
+    layer.phy_clip_area = area;
+    draw_list(&layer, list, &area);
+    // Same loop as lv_canvas_finish_layer()
+    while (layer.draw_task_head) {
+        lv_draw_dispatch_wait_for_request();
+        if (!lv_draw_dispatch_layer(lv_display_get_default(), &layer)) {
+            lv_draw_wait_for_finish();
+            lv_draw_dispatch_request();
+        }
+    }
+    return buf;
+}
+
+/// Referenced raster of (doc, w, h), rendered on a miss; nullptr if it cannot be made
+[[nodiscard]] inline RasterEntry* acquire_raster(const lv_svg_node_t* doc, uint16_t w, uint16_t h) noexcept {
+    Caches& c = caches();
+    RasterEntry* free_slot = nullptr;
+    for (RasterEntry& e : c.rasters) {
+        if (e.buf && e.doc == doc && e.w == w && e.h == h) {
+            ++c.stats.raster_hits;
+            ++e.refs;
+            e.used = ++c.clock;
+            return &e;
+        }
+        if (!e.buf && !free_slot) free_slot = &e;
+    }
+    ++c.stats.raster_misses;
+    lv_svg_render_obj_t* list = compiled(doc);
+    if (!list) return nullptr;
+    trim_rasters(c, lv_draw_buf_width_to_stride(w, LV_COLOR_FORMAT_ARGB8888) * h);
+    if (!free_slot) {
+        for (RasterEntry& e : c.rasters) {
+            if (!e.refs && (!free_slot || e.used < free_slot->used)) free_slot = &e;
+        }
+        if (!free_slot) {
+            LV_LOG_WARN("svg::raster: all rasters referenced, raise LV_CPP_SVG_RASTERS");
+            return nullptr;
+        }
+        free_raster(*free_slot);
+    }
+    lv_draw_buf_t* buf = rasterize(list, w, h);
+    if (!buf) return nullptr;
+    *free_slot = RasterEntry{doc, buf, w, h, 1, ++c.clock};
+    return free_slot;
+}
+
+} // namespace detail
+
 /**
  * @brief RAII wrapper for an SVG DOM tree
  *
@@ -43,7 +270,10 @@ public:
     Node(adopt_t, lv_svg_node_t* node) noexcept : m_node(node) {}
 
     ~Node() noexcept {
-        if (m_node) lv_svg_node_delete(m_node);
+        if (m_node) {
+            detail::forget(m_node);
+            lv_svg_node_delete(m_node);
+        }
     }
 
     // Move-only
@@ -56,7 +286,10 @@ public:
 
     Node& operator=(Node&& other) noexcept {
         if (this != &other) {
-            if (m_node) lv_svg_node_delete(m_node);
+            if (m_node) {
+                detail::forget(m_node);
+                lv_svg_node_delete(m_node);
+            }
             m_node = other.m_node;
             other.m_node = nullptr;
         }
@@ -144,9 +377,118 @@ inline void init(const lv_svg_render_hal_t* hal) noexcept {
     lv_svg_render_init(hal);
 }
 
-/// Draw an SVG document directly to a layer (convenience, parses + renders)
+/// Draw an SVG document to a layer (render list compiled once, then cached)
 inline void draw(lv_layer_t* layer, const Node& doc) noexcept {
-    lv_draw_svg(layer, doc.get());
+    if (lv_svg_render_obj_t* list = detail::compiled(doc.get())) detail::draw_list(layer, list, nullptr);
+}
+
+/// Draw an SVG document scaled to fit `area` (uniform scale, centered)
+inline void draw(lv_layer_t* layer, const Node& doc, const lv_area_t& area) noexcept {
+    if (lv_svg_render_obj_t* list = detail::compiled(doc.get())) detail::draw_list(layer, list, &area);
+}
+
+/**
+ * @brief Shared handle to a cached w x h rendering of a document
+ *
+ * Copyable; the pixels stay valid while any handle exists. Unreferenced
+ * rasters stay cached up to LV_CPP_SVG_RASTER_BYTES for the next raster().
+ */
+class Raster {
+    detail::RasterEntry* m_entry = nullptr;
+
+    explicit Raster(detail::RasterEntry* e) noexcept : m_entry(e) {}
+    void release() noexcept {
+        if (!m_entry) return;
+        if (--m_entry->refs == 0) {
+            if (!m_entry->doc) {
+                detail::free_raster(*m_entry);
+            } else {
+                detail::trim_rasters(detail::caches(), 0);
+            }
+        }
+        m_entry = nullptr;
+    }
+
+    friend Raster raster(const Node& doc, uint16_t w, uint16_t h) noexcept;
+
+public:
+    Raster() noexcept = default;
+    ~Raster() { release(); }
+
+    Raster(const Raster& other) noexcept : m_entry(other.m_entry) {
+        if (m_entry) ++m_entry->refs;
+    }
+    Raster& operator=(const Raster& other) noexcept {
+        if (this != &other) {
+            if (other.m_entry) ++other.m_entry->refs;
+            release();
+            m_entry = other.m_entry;
+        }
+        return *this;
+    }
+    Raster(Raster&& other) noexcept : m_entry(other.m_entry) { other.m_entry = nullptr; }
+    Raster& operator=(Raster&& other) noexcept {
+        if (this != &other) {
+            release();
+            m_entry = other.m_entry;
+            other.m_entry = nullptr;
+        }
+        return *this;
+    }
+
+    /// Image source for Image::src() or lv_draw_image_dsc_t::src
+    [[nodiscard]] const void* src() const noexcept { return m_entry ? m_entry->buf : nullptr; }
+    [[nodiscard]] const lv_draw_buf_t* buf() const noexcept { return m_entry ? m_entry->buf : nullptr; }
+
+    [[nodiscard]] bool valid() const noexcept { return m_entry != nullptr; }
+    explicit operator bool() const noexcept { return valid(); }
+};
+
+/**
+ * @brief Cached w x h ARGB8888 rendering of `doc` (fit and centered)
+ *
+ * Renders on the first request for this (document, size); later requests
+ * share the pixels. Invalid handle if the document does not compile or
+ * memory runs out.
+ */
+[[nodiscard]] inline Raster raster(const Node& doc, uint16_t w, uint16_t h) noexcept {
+    if (!doc || !w || !h) return Raster();
+    return Raster(detail::acquire_raster(doc.get(), w, h));
+}
+
+/// Counters and occupancy of the compiled and raster caches
+[[nodiscard]] inline Stats stats() noexcept {
+    const detail::Caches& c = detail::caches();
+    Stats s = c.stats;
+    s.compiled = s.compiled_bytes = s.rasters = s.raster_bytes = 0;
+    for (const detail::Compiled& e : c.compiled) {
+        if (!e.doc) continue;
+        ++s.compiled;
+        s.compiled_bytes += e.bytes;
+    }
+    for (const detail::RasterEntry& e : c.rasters) {
+        if (!e.buf) continue;
+        ++s.rasters;
+        s.raster_bytes += e.buf->data_size;
+    }
+    return s;
+}
+
+/// Zero the hit/miss counters
+inline void reset_stats() noexcept {
+    detail::caches().stats = Stats{};
+}
+
+/// Free all compiled lists and unreferenced rasters
+inline void drop_cache() noexcept {
+    detail::Caches& c = detail::caches();
+    for (detail::Compiled& e : c.compiled) {
+        if (e.list) lv_svg_render_delete(e.list);
+        e = detail::Compiled{};
+    }
+    for (detail::RasterEntry& e : c.rasters) {
+        if (e.buf && !e.refs) detail::free_raster(e);
+    }
 }
 
 } // namespace lv::svg
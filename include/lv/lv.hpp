@@ -42,6 +42,7 @@
 
 // LVGL base
 #include <lvgl.h>
+#include "core/widget_profile.hpp"
 
 // Core
 #include "core/version.hpp"
@@ -49,23 +50,64 @@
 #include "core/object.hpp"
 #include "core/event.hpp"
 #include "core/style.hpp"
+#include "core/style_cache.hpp"
+#include "core/const_style.hpp"
 #include "core/color.hpp"
+#include "core/color_batch.hpp"
 #include "core/font.hpp"
 #include "core/display.hpp"
+#include "core/pixel.hpp"
+#include "core/page_flip.hpp"
 #include "core/app.hpp"
+#include "core/startup.hpp"
+#include "core/splash.hpp"
+#include "core/event_loop.hpp"
 #include "core/component.hpp"
+#include "core/component_pool.hpp"
+#include "core/ui.hpp"
 #include "core/anim.hpp"
 #include "core/anim_timeline.hpp"
+#include "core/anim_batch.hpp"
+#include "core/keyframes.hpp"
+#include "core/spring.hpp"
 #include "core/theme.hpp"
 #include "core/screen.hpp"
+#include "core/page_stack.hpp"
+#include "core/prefetch.hpp"
 #include "core/indev.hpp"
+#include "core/indev_queue.hpp"
+#include "core/hw_cursor.hpp"
 #include "core/focus.hpp"
+#include "core/key_nav.hpp"
+#include "core/spatial_index.hpp"
+#include "core/name_index.hpp"
 #include "core/timer.hpp"
+#include "core/visibility.hpp"
 #include "core/image.hpp"
+#include "core/atlas.hpp"
 #include "core/fs.hpp"
+#include "core/buffered_file.hpp"
+#include "core/fs_async.hpp"
+#include "core/romfs.hpp"
+#include "core/dir_cache.hpp"
+#include "core/glyph_cache.hpp"
+#include "core/font_bake.hpp"
 #include "core/font_loader.hpp"
+#include "core/font_chain.hpp"
 #include "core/string_utils.hpp"
+#include "core/format.hpp"
+#include "core/static_text.hpp"
+#include "core/frame_arena.hpp"
+#include "core/slab_alloc.hpp"
+#include "core/memory.hpp"
+#include "core/mem_budget.hpp"
+#include "core/text_cache.hpp"
+#include "core/text_document.hpp"
 #include "core/async.hpp"
+#include "core/thread.hpp"
+#include "core/profiler.hpp"
+#include "core/task.hpp"
+#include "core/idle.hpp"
 
 #include "core/log.hpp"
 
@@ -87,10 +129,8 @@
 #include "core/gridnav.hpp"
 #endif
 
-// System monitor (requires LV_USE_SYSMON)
-#if LV_USE_SYSMON
+// System monitor (overlay requires LV_USE_SYSMON, metrics do not)
 #include "others/sysmon.hpp"
-#endif
 
 // Monkey testing (requires LV_USE_MONKEY)
 #if LV_USE_MONKEY
@@ -147,6 +187,17 @@
 #if LV_USE_TEXTAREA
 #include "widgets/textarea.hpp"
 #endif
+#if LV_USE_LABEL
+#if LV_CPP_PROFILE_TEXT_EDITOR
+#include "widgets/text_editor.hpp"
+#endif
+#if LV_CPP_PROFILE_LOG_VIEW
+#include "widgets/log_view.hpp"
+#endif
+#if LV_CPP_PROFILE_NOTIFICATIONS
+#include "widgets/notifications.hpp"
+#endif
+#endif
 #if LV_USE_SPINBOX
 #include "widgets/spinbox.hpp"
 #endif
@@ -169,6 +220,9 @@
 #endif
 #if LV_USE_CHART
 #include "widgets/chart.hpp"
+#if LV_CPP_PROFILE_CHART_DECIMATOR
+#include "widgets/chart_decimator.hpp"
+#endif
 #endif
 #if LV_USE_SCALE
 #include "widgets/scale.hpp"
@@ -178,6 +232,9 @@
 #endif
 #if LV_USE_CANVAS
 #include "widgets/canvas.hpp"
+#if LV_CPP_PROFILE_STRIP_CHART
+#include "widgets/strip_chart.hpp"
+#endif
 #endif
 #if LV_USE_ANIMIMG
 #include "widgets/animimage.hpp"
@@ -189,6 +246,18 @@
 // Widgets - Containers
 #if LV_USE_LIST
 #include "widgets/list.hpp"
+#if LV_CPP_PROFILE_VIRTUAL_LIST
+#include "widgets/virtual_list.hpp"
+#endif
+#if LV_CPP_PROFILE_FILE_BROWSER
+#include "widgets/file_browser.hpp"
+#endif
+#if LV_CPP_PROFILE_DATA_TABLE
+#include "widgets/data_table.hpp"
+#endif
+#endif
+#if LV_CPP_PROFILE_VIRTUAL_OPTIONS
+#include "widgets/virtual_options.hpp"
 #endif
 #if LV_USE_MENU
 #include "widgets/menu.hpp"
@@ -249,6 +318,10 @@
 // State (requires LV_USE_OBSERVER)
 #if LV_USE_OBSERVER
 #include "core/state.hpp"
+#include "core/subscription.hpp"
+#include "core/bindings.hpp"
+#include "core/computed.hpp"
+#include "core/list_state.hpp"
 #endif
 
 /**
@@ -284,6 +357,7 @@
  * - `Style` - RAII style object
  * - `StyleMixin` - Inline style setters
  * - `colors::` - Common color constants
+ * - `color::` - Batch color operations over spans (mix, lookup, HSV, fade)
  *
  * ### Events
  * - `EventMixin` - Zero-cost event callbacks
@@ -300,7 +374,8 @@
  * ## Thread Safety
  *
  * LVGL is single-threaded. All lv:: operations must be called
- * from the same thread as lv_timer_handler().
+ * from the same thread as lv_timer_handler(). Other threads hand
+ * work to the UI with lv::post(), which lv::tick() drains.
  */
 namespace lv {
 
@@ -11,6 +11,9 @@
  *
  * @note Complex gradients require LV_USE_DRAW_SW_COMPLEX_GRADIENTS=1 in lv_conf.h
  * @note Multi-stop gradients (>2 colors) require increasing LV_GRADIENT_MAX_STOPS
+ *
+ * For gradients redrawn every frame (animated cards), gradient_cache.hpp
+ * caches the color ramp and draws one-axis gradients from a baked strip.
  */
 
 #include <lvgl.h>
@@ -0,0 +1,393 @@
+#pragma once
+
+/**
+ * @file gradient_cache.hpp
+ * @brief Cached gradient color ramps and baked linear gradients
+ *
+ * The SW renderer rebuilds a gradient's color ramp from its stops on every
+ * draw of every object using it. This keeps ramps in a small LRU cache
+ * keyed by the stops, the extend mode, the axis and the length, stored as
+ * pooled ARGB8888 strips (one pixel thick):
+ *
+ * - grad_cache::lut(grad, length) returns the ramp as `length` colors, for
+ *   custom draw code that samples gradients itself.
+ * - grad_cache::draw(layer, grad, area) draws horizontal, vertical and
+ *   axis-aligned linear gradients by stretching the cached strip across
+ *   the area (nearest-neighbour, so the cross axis just repeats the
+ *   strip), instead of evaluating the stops per pixel. Other gradients
+ *   (diagonal, radial, conical) are drawn by LVGL as usual.
+ * - grad_cache::bake_bg(obj, grad) does that for an object's background
+ *   on every redraw, e.g. for animated cards:
+ *
+ * @code
+ * static auto sunset = lv::GradDsc()
+ *     .stop(lv::rgb(0xFF5F6D), 0).stop(lv::rgb(0xFFC371), 160).stop(lv::rgb(0x2C3E50), 255)
+ *     .vertical();
+ * card.bg_opa(LV_OPA_TRANSP);          // the baked strip replaces the background
+ * lv::grad_cache::bake_bg(card, sunset);
+ * @endcode
+ *
+ * A strip handed to a draw task stays pinned until the display's next
+ * REFR_READY, so eviction never frees pixels a queued task still reads.
+ * If every entry is pinned, the draw falls back to LVGL's gradient.
+ *
+ * Heap allocation: NONE in the wrapper (fixed table; strips come from the
+ * DrawBufPool)
+ */
+
+#include <lvgl.h>
+#include <cstdint>
+#include <cstring>
+#include "gradient.hpp"
+#include "../core/object.hpp"
+#include "../draw/draw_buf.hpp"
+
+#ifndef LV_CPP_GRAD_CACHE
+/// Cached ramps (distinct stops / extend / axis / length combinations)
+#define LV_CPP_GRAD_CACHE 16
+#endif
+
+#ifndef LV_CPP_GRAD_CACHE_BYTES
+/// Strip bytes kept before the least recently used ramps go
+#define LV_CPP_GRAD_CACHE_BYTES (64u * 1024u)
+#endif
+
+namespace lv::grad_cache {
+
+/// Counters of the ramp cache
+struct Stats {
+    uint32_t entries;
+    uint32_t bytes;       ///< strip pixel bytes
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t baked;       ///< draw() calls served by a stretched strip
+    uint32_t fallbacks;   ///< draw() calls left to LVGL (not axis-aligned, or no free entry)
+};
+
+namespace detail {
+
+/// Everything a strip's pixels depend on; compared bytewise (padding zeroed)
+struct RampKey {
+    lv_grad_stop_t stops[LV_GRADIENT_MAX_STOPS];
+    int32_t start;       ///< strip pixel of frac 0
+    int32_t end;         ///< strip pixel of frac 255
+    uint16_t length;
+    uint8_t count;
+    uint8_t extend;
+    uint8_t vertical;    ///< 1 x length strip instead of length x 1
+};
+
+struct Ramp {
+    RampKey key;
+    lv_draw_buf_t* buf = nullptr;
+    uint32_t used = 0;     ///< LRU stamp
+    bool pinned = false;   ///< read by a queued draw task
+};
+
+struct Tables {
+    Ramp ramps[LV_CPP_GRAD_CACHE];
+    uint32_t clock = 0;
+    uint32_t pinned = 0;
+    Stats stats{};
+};
+
+[[nodiscard]] inline Tables& tables() noexcept {
+    static Tables t;
+    return t;
+}
+
+/// Key of a strip `length` pixels long, frac 0..255 running from `start` to `end`
+[[nodiscard]] inline RampKey make_key(const lv_grad_dsc_t& grad, uint16_t length, bool vertical,
+                                      int32_t start, int32_t end) noexcept {
+    RampKey k;
+    std::memset(&k, 0, sizeof(k));
+    k.count = grad.stops_count > LV_GRADIENT_MAX_STOPS ? LV_GRADIENT_MAX_STOPS : grad.stops_count;
+    std::memcpy(k.stops, grad.stops, k.count * sizeof(lv_grad_stop_t));
+    k.start = start;
+    k.end = end;
+    k.length = length;
+    k.extend = static_cast<uint8_t>(grad.extend);
+    k.vertical = vertical;
+    return k;
+}
+
+/// Gradient position 0..255 of strip pixel `pos` under the key's extend mode
+[[nodiscard]] inline int32_t frac_at(const RampKey& k, int32_t pos) noexcept {
+    int32_t num = pos - k.start;
+    int32_t den = k.end - k.start;
+    if (den < 0) {
+        num = -num;
+        den = -den;
+    }
+    if (den == 0) return num < 0 ? 0 : 255;
+    if (k.extend == LV_GRAD_EXTEND_REPEAT) {
+        num = (num % den + den) % den;
+    } else if (k.extend == LV_GRAD_EXTEND_REFLECT) {
+        num = (num % (2 * den) + 2 * den) % (2 * den);
+        if (num > den) num = 2 * den - num;
+    } else {
+        num = num < 0 ? 0 : num > den ? den : num;
+    }
+    return num * 255 / den;
+}
+
+/// Color of the stops at position `frac` (same interpolation as LVGL: linear between neighbours)
+[[nodiscard]] inline lv_color32_t color_at(const RampKey& k, int32_t frac) noexcept {
+    if (k.count == 0) return lv_color32_t{0, 0, 0, 0};
+    const lv_grad_stop_t& first = k.stops[0];
+    const lv_grad_stop_t& last = k.stops[k.count - 1];
+    if (frac <= first.frac) return lv_color32_t{first.color.blue, first.color.green, first.color.red, first.opa};
+    if (frac >= last.frac) return lv_color32_t{last.color.blue, last.color.green, last.color.red, last.opa};
+    uint8_t s = 1;
+    while (s < k.count - 1 && frac > k.stops[s].frac) ++s;
+    const lv_grad_stop_t* a = &k.stops[s - 1];
+    const lv_grad_stop_t* b = &k.stops[s];
+    const int32_t span = b->frac - a->frac;
+    const int32_t mix = span > 0 ? (frac - a->frac) * 255 / span : 0;
+    auto lerp = [mix](int32_t from, int32_t to) noexcept {
+        return static_cast<uint8_t>(from + (to - from) * mix / 255);
+    };
+    return lv_color32_t{lerp(a->color.blue, b->color.blue), lerp(a->color.green, b->color.green),
+                        lerp(a->color.red, b->color.red), lerp(a->opa, b->opa)};
+}
+
+[[nodiscard]] inline lv_draw_buf_t* render_strip(const RampKey& k) noexcept {
+    const uint32_t w = k.vertical ? 1 : k.length;
+    const uint32_t h = k.vertical ? k.length : 1;
+    lv_draw_buf_t* buf = lv_draw_buf_create_ex(draw::pool_handlers(), w, h, LV_COLOR_FORMAT_ARGB8888, 0);
+    if (!buf) return nullptr;
+    const uint32_t step = k.vertical ? buf->header.stride : sizeof(lv_color32_t);
+    uint8_t* px = buf->data;
+    for (int32_t i = 0; i < k.length; ++i, px += step) {
+        const lv_color32_t c = color_at(k, frac_at(k, i));
+        std::memcpy(px, &c, sizeof(c));
+    }
+    return buf;
+}
+
+[[nodiscard]] inline uint32_t cached_bytes(const Tables& t) noexcept {
+    uint32_t n = 0;
+    for (const Ramp& r : t.ramps) {
+        if (r.buf) n += r.buf->data_size;
+    }
+    return n;
+}
+
+inline void free_ramp(Tables& t, Ramp& r) noexcept {
+    if (r.buf) {
+        t.stats.bytes -= r.buf->data_size;
+        --t.stats.entries;
+        lv_image_cache_drop(r.buf);
+        lv_draw_buf_destroy(r.buf);
+    }
+    r = Ramp{};
+}
+
+/// A free entry, else the oldest unpinned one (or nullptr); `occupied_only` skips free entries
+[[nodiscard]] inline Ramp* victim(Tables& t, bool occupied_only = false) noexcept {
+    Ramp* v = nullptr;
+    for (Ramp& r : t.ramps) {
+        if (!r.buf) {
+            if (!occupied_only) return &r;
+            continue;
+        }
+        if (!r.pinned && (!v || r.used < v->used)) v = &r;
+    }
+    return v;
+}
+
+/// Cached strip of `k`, rendered on a miss; nullptr if none can be made
+[[nodiscard]] inline Ramp* ramp(const RampKey& k) noexcept {
+    Tables& t = tables();
+    for (Ramp& r : t.ramps) {
+        if (r.buf && std::memcmp(&r.key, &k, sizeof(k)) == 0) {
+            ++t.stats.hits;
+            r.used = ++t.clock;
+            return &r;
+        }
+    }
+    ++t.stats.misses;
+    const uint32_t need = k.vertical ? lv_draw_buf_width_to_stride(1, LV_COLOR_FORMAT_ARGB8888) * k.length
+                                     : lv_draw_buf_width_to_stride(k.length, LV_COLOR_FORMAT_ARGB8888);
+    // Trim to the byte cap (pinned strips cannot go: then draw uncached), then take a slot
+    while (cached_bytes(t) + need > LV_CPP_GRAD_CACHE_BYTES) {
+        Ramp* old = victim(t, true);
+        if (!old) return nullptr;
+        free_ramp(t, *old);
+    }
+    Ramp* r = victim(t);
+    if (!r) return nullptr;
+    free_ramp(t, *r);
+    lv_draw_buf_t* buf = render_strip(k);
+    if (!buf) return nullptr;
+    r->key = k;
+    r->buf = buf;
+    r->used = ++t.clock;
+    ++t.stats.entries;
+    t.stats.bytes += buf->data_size;
+    return r;
+}
+
+inline void refr_ready_cb(lv_event_t*) noexcept {
+    Tables& t = tables();
+    for (Ramp& r : t.ramps) r.pinned = false;
+    t.pinned = 0;
+}
+
+/// Keep `r` until the next refresh is done (queued draw tasks point at it)
+inline void pin(Ramp& r) noexcept {
+    Tables& t = tables();
+    if (r.pinned) return;
+    r.pinned = true;
+    if (t.pinned++) return;
+    lv_display_t* disp = lv_display_get_default();
+    if (!disp) return;
+    lv_display_remove_event_cb_with_user_data(disp, &refr_ready_cb, nullptr);
+    lv_display_add_event_cb(disp, &refr_ready_cb, LV_EVENT_REFR_READY, nullptr);
+}
+
+[[nodiscard]] inline int32_t resolve(int32_t v, int32_t size) noexcept {
+    return LV_COORD_IS_PCT(v) ? lv_pct_to_px(v, size) : v;
+}
+
+/// Strip key for `grad` over `area`; false if the gradient does not vary along one axis only
+[[nodiscard]] inline bool strip_key(const lv_grad_dsc_t& grad, const lv_area_t& area, RampKey& out) noexcept {
+    const int32_t w = lv_area_get_width(&area);
+    const int32_t h = lv_area_get_height(&area);
+    if (w <= 0 || h <= 0 || w > 0xFFFF || h > 0xFFFF || grad.stops_count == 0) return false;
+    switch (grad.dir) {
+        case LV_GRAD_DIR_HOR:
+            out = make_key(grad, static_cast<uint16_t>(w), false, 0, w - 1);
+            return true;
+        case LV_GRAD_DIR_VER:
+            out = make_key(grad, static_cast<uint16_t>(h), true, 0, h - 1);
+            return true;
+#if LV_USE_DRAW_SW_COMPLEX_GRADIENTS
+        case LV_GRAD_DIR_LINEAR: {
+            const lv_point_t& s = grad.params.linear.start;
+            const lv_point_t& e = grad.params.linear.end;
+            const int32_t sx = resolve(s.x, w), sy = resolve(s.y, h);
+            const int32_t ex = resolve(e.x, w), ey = resolve(e.y, h);
+            if (sy == ey && sx != ex) {
+                out = make_key(grad, static_cast<uint16_t>(w), false, sx, ex);
+                return true;
+            }
+            if (sx == ex && sy != ey) {
+                out = make_key(grad, static_cast<uint16_t>(h), true, sy, ey);
+                return true;
+            }
+            return false;
+        }
+#endif
+        default:
+            return false;
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Color ramp of `grad`'s stops, `length` entries from frac 0 to 255
+ *
+ * Ignores the gradient's direction and geometry. The array stays valid
+ * until the next call into grad_cache; nullptr if out of memory.
+ */
+[[nodiscard]] inline const lv_color32_t* lut(const lv_grad_dsc_t& grad, uint16_t length) noexcept {
+    if (length == 0) return nullptr;
+    lv_grad_dsc_t pad = grad;
+    pad.extend = LV_GRAD_EXTEND_PAD;
+    detail::Ramp* r = detail::ramp(detail::make_key(pad, length, false, 0, length - 1));
+    return r ? reinterpret_cast<const lv_color32_t*>(r->buf->data) : nullptr;
+}
+
+/**
+ * @brief Draw `grad` filling `area`, from a cached strip when it varies along one axis
+ *
+ * @param radius Corner radius the fill is clipped to
+ * @param opa    Opacity of the whole fill (stop opacities still apply)
+ * @return true if drawn from a strip, false if handed to lv_draw_rect()
+ */
+inline bool draw(lv_layer_t* layer, const lv_grad_dsc_t& grad, const lv_area_t& area,
+                 int32_t radius = 0, lv_opa_t opa = LV_OPA_COVER) noexcept {
+    detail::Tables& t = detail::tables();
+    detail::RampKey key;
+    detail::Ramp* r = detail::strip_key(grad, area, key) ? detail::ramp(key) : nullptr;
+    if (!r) {
+        ++t.stats.fallbacks;
+        lv_draw_rect_dsc_t rect;
+        lv_draw_rect_dsc_init(&rect);
+        rect.bg_opa = opa;
+        rect.bg_grad = grad;
+        rect.radius = radius;
+        lv_draw_rect(layer, &rect, &area);
+        return false;
+    }
+    ++t.stats.baked;
+    detail::pin(*r);
+    lv_draw_image_dsc_t img;
+    lv_draw_image_dsc_init(&img);
+    img.src = r->buf;
+    img.opa = opa;
+    img.clip_radius = radius;
+    img.antialias = 0;   // nearest: the stretched axis repeats the strip exactly
+    img.pivot = lv_point_t{0, 0};
+    lv_area_t coords = area;
+    if (key.vertical) {
+        img.scale_x = static_cast<int32_t>(lv_area_get_width(&area)) * LV_SCALE_NONE;
+        coords.x2 = coords.x1;
+    } else {
+        img.scale_y = static_cast<int32_t>(lv_area_get_height(&area)) * LV_SCALE_NONE;
+        coords.y2 = coords.y1;
+    }
+    lv_draw_image(layer, &img, &coords);
+    return true;
+}
+
+namespace detail {
+
+inline void bake_bg_cb(lv_event_t* e) noexcept {
+    auto* obj = static_cast<lv_obj_t*>(lv_event_get_current_target(e));
+    const auto* grad = static_cast<const lv_grad_dsc_t*>(lv_event_get_user_data(e));
+    lv_area_t coords;
+    lv_obj_get_coords(obj, &coords);
+    grad_cache::draw(lv_event_get_layer(e), *grad, coords, lv_obj_get_style_radius(obj, LV_PART_MAIN));
+}
+
+} // namespace detail
+
+/**
+ * @brief Draw `grad` under `obj`'s content on every redraw, through draw()
+ *
+ * `grad` is referenced, not copied: keep it alive (static) as LVGL requires
+ * for bg_grad anyway. Give the object a transparent background, or it is
+ * drawn over the gradient. Baking again replaces the gradient.
+ */
+inline void bake_bg(ObjectView obj, const lv_grad_dsc_t& grad) noexcept {
+    lv_obj_remove_event_cb(obj.get(), &detail::bake_bg_cb);
+    lv_obj_add_event_cb(obj.get(), &detail::bake_bg_cb, LV_EVENT_DRAW_MAIN_BEGIN,
+                        const_cast<lv_grad_dsc_t*>(&grad));
+    lv_obj_invalidate(obj.get());
+}
+
+/// Stop drawing a baked background
+inline void unbake_bg(ObjectView obj) noexcept {
+    if (lv_obj_remove_event_cb(obj.get(), &detail::bake_bg_cb)) lv_obj_invalidate(obj.get());
+}
+
+[[nodiscard]] inline Stats stats() noexcept { return detail::tables().stats; }
+
+/// Zero the hit/miss/draw counters (sizes are kept)
+inline void reset_stats() noexcept {
+    Stats& s = detail::tables().stats;
+    s.hits = s.misses = s.baked = s.fallbacks = 0;
+}
+
+/// Free every unpinned strip
+inline void drop() noexcept {
+    detail::Tables& t = detail::tables();
+    for (detail::Ramp& r : t.ramps) {
+        if (!r.pinned) detail::free_ramp(t, r);
+    }
+}
+
+} // namespace lv::grad_cache
@@ -0,0 +1,433 @@
+#pragma once
+
+/**
+ * @file anim_governor.hpp
+ * @brief Lower animation quality while rendering is over its frame budget
+ *
+ * When rendering cannot keep up, every animation stutters alike. The
+ * governor times the display's last LV_CPP_ANIM_GOVERNOR_FRAMES renders
+ * and, while their average is over the budget, steps down one Quality
+ * level per window:
+ *
+ * - `thin`: low priority animations apply only every
+ *   LV_CPP_ANIM_GOVERNOR_STRIDE-th value (their first and last values
+ *   always apply, so timing and end state are unchanged)
+ * - `plain`: objects registered with simplify() lose shadows and layer
+ *   opacity while governed animations run
+ * - `cached`: subtrees registered with cache() are drawn through
+ *   lv::cached_layer, and normal priority animations are thinned too
+ *
+ * A window averaging under 3/4 of the budget steps back up one level;
+ * once no governed animation runs, full quality returns at once.
+ *
+ * @code
+ * lv::anim_governor::start();                  // default display, LV_DEF_REFR_PERIOD budget
+ * lv::anim_governor::simplify(card);           // shadowed card, fine to flatten in motion
+ * lv::anim_governor::cache(gauge);             // static dial moved by x/y
+ *
+ * lv::anim_x(bubble, 0, 200).duration(800).priority(lv::AnimPriority::low).start();
+ * lv::anim_opa(toast, 0, 255).duration(150).priority(lv::AnimPriority::high).start();
+ * @endcode
+ *
+ * While the governor runs, every lv::Anim::start() goes through it
+ * (animations made with lv_anim_start() directly are not governed). A
+ * governed animation is stored with a custom exec callback, so
+ * lv::anim_delete(obj) finds it but anim_delete(obj, exec_cb) and
+ * anim_get() do not. The user data, completed and deleted callbacks are
+ * kept. simplify() adds a style, so local shadow/opa_layered properties
+ * set on the object still win. cached_layer drops a cache on style
+ * changes, so caching pays off for subtrees moved by x/y, not by
+ * style translate.
+ *
+ * Heap allocation: NONE (fixed tables; LVGL allocates the event
+ * descriptors and, at `cached`, the layer bitmaps)
+ */
+
+#include <lvgl.h>
+#include <cstdint>
+#include "../core/object.hpp"
+#include "../core/anim.hpp"
+#include "sysmon.hpp"
+#if LV_USE_SNAPSHOT
+#include "../core/cached_layer.hpp"
+#endif
+
+#ifndef LV_CPP_ANIM_GOVERNOR_FRAMES
+/// Renders averaged before the quality changes
+#define LV_CPP_ANIM_GOVERNOR_FRAMES 8
+#endif
+
+#ifndef LV_CPP_ANIM_GOVERNOR_ANIMS
+/// Governed animations running at the same time
+#define LV_CPP_ANIM_GOVERNOR_ANIMS 32
+#endif
+
+#ifndef LV_CPP_ANIM_GOVERNOR_OBJECTS
+/// Objects registered with simplify() or cache()
+#define LV_CPP_ANIM_GOVERNOR_OBJECTS 8
+#endif
+
+#ifndef LV_CPP_ANIM_GOVERNOR_STRIDE
+/// A thinned animation applies one value in this many
+#define LV_CPP_ANIM_GOVERNOR_STRIDE 2
+#endif
+
+namespace lv::anim_governor {
+
+/// Quality levels, each including the reductions of the ones before
+enum class Quality : uint8_t {
+    full,    ///< nothing reduced
+    thin,    ///< low priority animations skip values
+    plain,   ///< simplify() objects lose shadows and layer opacity in motion
+    cached,  ///< cache() subtrees drawn from bitmaps, normal priority thinned
+};
+
+/// Counters of the governor
+struct Stats {
+    uint32_t frames;     ///< renders timed
+    uint32_t frame_us;   ///< average render time of the last full window
+    uint32_t degrades;   ///< steps down
+    uint32_t restores;   ///< steps up (including returns to full when idle)
+    uint32_t applied;    ///< animation values applied
+    uint32_t skipped;    ///< animation values skipped while thinning
+    uint32_t untracked;  ///< animations started ungoverned (table full)
+};
+
+namespace detail {
+
+struct AnimEntry {
+    lv_anim_t* anim = nullptr;
+    lv_anim_exec_xcb_t exec = nullptr;
+    lv_anim_deleted_cb_t deleted = nullptr;
+    AnimPriority prio = AnimPriority::normal;
+    bool used = false;
+    uint8_t tick = 0;
+};
+
+enum : uint8_t { simplify_flag = 1, cache_flag = 2 };
+
+struct ObjEntry {
+    lv_obj_t* obj = nullptr;
+    uint8_t flags = 0;
+    bool styled = false;   ///< the plain style is added
+    bool cached = false;   ///< the governor enabled its cached layer
+};
+
+struct Governor {
+    lv_display_t* disp = nullptr;
+    uint32_t budget_us = 0;
+    uint64_t render_start = 0;
+    uint32_t ring[LV_CPP_ANIM_GOVERNOR_FRAMES] = {};
+    uint32_t head = 0;
+    uint32_t filled = 0;
+    uint32_t running = 0;
+    Quality level = Quality::full;
+    AnimEntry* pending = nullptr;   ///< entry being started (early apply runs before the handle is known)
+    AnimEntry anims[LV_CPP_ANIM_GOVERNOR_ANIMS];
+    ObjEntry objs[LV_CPP_ANIM_GOVERNOR_OBJECTS];
+    Stats stats{};
+};
+
+[[nodiscard]] inline Governor& governor() noexcept {
+    static Governor g;
+    return g;
+}
+
+/// Style layered on simplify() objects at `plain`
+[[nodiscard]] inline lv_style_t* plain_style() noexcept {
+    static lv_style_t style;
+    static bool init = false;
+    if (!init) {
+        lv_style_init(&style);
+        lv_style_set_shadow_width(&style, 0);
+        lv_style_set_shadow_opa(&style, LV_OPA_TRANSP);
+        lv_style_set_opa_layered(&style, LV_OPA_COVER);
+        init = true;
+    }
+    return &style;
+}
+
+[[nodiscard]] inline AnimEntry* find_anim(lv_anim_t* a) noexcept {
+    Governor& g = governor();
+    for (AnimEntry& e : g.anims) {
+        if (e.used && e.anim == a) return &e;
+    }
+    // Early apply: lv_anim_start() runs the first value before returning the handle
+    if (g.pending && !g.pending->anim) {
+        g.pending->anim = a;
+        return g.pending;
+    }
+    return nullptr;
+}
+
+[[nodiscard]] inline ObjEntry* find_obj(lv_obj_t* obj) noexcept {
+    for (ObjEntry& e : governor().objs) {
+        if (e.obj == obj) return &e;
+    }
+    return nullptr;
+}
+
+/// Bring registered objects in line with the level and whether anything moves
+inline void apply(Governor& g) noexcept {
+    const bool plain = g.level >= Quality::plain && g.running > 0;
+    [[maybe_unused]] const bool cached = g.level >= Quality::cached;
+    for (ObjEntry& o : g.objs) {
+        if (!o.obj) continue;
+        const bool style = plain && (o.flags & simplify_flag);
+        if (style != o.styled) {
+            if (style) lv_obj_add_style(o.obj, plain_style(), LV_PART_MAIN);
+            else lv_obj_remove_style(o.obj, plain_style(), LV_PART_MAIN);
+            o.styled = style;
+        }
+#if LV_USE_SNAPSHOT
+        const bool cache = cached && (o.flags & cache_flag);
+        if (cache && !o.cached && !cached_layer::enabled(o.obj)) {
+            o.cached = cached_layer::enable(o.obj);
+        } else if (!cache && o.cached) {
+            cached_layer::disable(o.obj);
+            o.cached = false;
+        }
+#endif
+    }
+}
+
+inline void set_level(Governor& g, Quality level) noexcept {
+    if (level == g.level) return;
+    if (level > g.level) ++g.stats.degrades;
+    else ++g.stats.restores;
+    g.level = level;
+    g.filled = 0;
+    g.head = 0;
+    apply(g);
+}
+
+[[nodiscard]] inline uint8_t stride(const Governor& g, AnimPriority prio) noexcept {
+    if (prio == AnimPriority::low && g.level >= Quality::thin) return LV_CPP_ANIM_GOVERNOR_STRIDE;
+    if (prio == AnimPriority::normal && g.level >= Quality::cached) return LV_CPP_ANIM_GOVERNOR_STRIDE;
+    return 1;
+}
+
+inline void exec_cb(lv_anim_t* a, int32_t v) {
+    Governor& g = governor();
+    AnimEntry* e = find_anim(a);
+    if (!e) return;
+    const uint8_t n = stride(g, e->prio);
+    if (n > 1 && v != a->start_value && v != a->end_value && ++e->tick % n) {
+        ++g.stats.skipped;
+        return;
+    }
+    ++g.stats.applied;
+    e->exec(a->var, v);
+}
+
+inline void deleted_cb(lv_anim_t* a) {
+    Governor& g = governor();
+    AnimEntry* e = find_anim(a);
+    if (!e) return;
+    lv_anim_deleted_cb_t user = e->deleted;
+    *e = AnimEntry{};
+    if (g.running) --g.running;
+    if (!g.running) {
+        set_level(g, Quality::full);   // idle: full quality at once
+        apply(g);                      // and nothing in motion to simplify
+    }
+    if (user) user(a);
+}
+
+inline lv_anim_t* start_hook(lv_anim_t* tmpl, AnimPriority prio) {
+    Governor& g = governor();
+    // Custom exec callbacks are already someone's trampoline; leave them alone
+    if (!tmpl->exec_cb || tmpl->custom_exec_cb) return lv_anim_start(tmpl);
+    AnimEntry* e = nullptr;
+    for (AnimEntry& slot : g.anims) {
+        if (!slot.used) {
+            e = &slot;
+            break;
+        }
+    }
+    if (!e) {
+        ++g.stats.untracked;
+        LV_LOG_WARN("animation started ungoverned (raise LV_CPP_ANIM_GOVERNOR_ANIMS)");
+        return lv_anim_start(tmpl);
+    }
+
+    // lv_anim_start() replaces an animation with the same var and exec
+    // callback; a governed one has none, so hand it back its own first
+    bool replaced = false;
+    for (AnimEntry& o : g.anims) {
+        if (o.used && o.anim && o.anim->var == tmpl->var && o.exec == tmpl->exec_cb) {
+            o.anim->exec_cb = o.exec;
+            o.anim->custom_exec_cb = nullptr;
+            replaced = true;
+        }
+    }
+    if (replaced) lv_anim_delete(tmpl->var, tmpl->exec_cb);
+
+    *e = AnimEntry{nullptr, tmpl->exec_cb, tmpl->deleted_cb, prio, true, 0};
+    lv_anim_t a = *tmpl;
+    a.exec_cb = nullptr;
+    lv_anim_set_custom_exec_cb(&a, &exec_cb);
+    lv_anim_set_deleted_cb(&a, &deleted_cb);
+    g.pending = e;
+    lv_anim_t* started = lv_anim_start(&a);
+    g.pending = nullptr;
+    if (!started) {
+        *e = AnimEntry{};
+        return nullptr;
+    }
+    e->anim = started;
+    if (++g.running == 1) apply(g);
+    return started;
+}
+
+inline void display_event_cb(lv_event_t* ev) noexcept {
+    Governor& g = governor();
+    switch (lv_event_get_code(ev)) {
+    case LV_EVENT_RENDER_START:
+        g.render_start = sysmon::detail::perf_now_us();
+        break;
+    case LV_EVENT_RENDER_READY: {
+        const auto us = static_cast<uint32_t>(sysmon::detail::perf_now_us() - g.render_start);
+        ++g.stats.frames;
+        g.ring[g.head] = us;
+        g.head = (g.head + 1) % LV_CPP_ANIM_GOVERNOR_FRAMES;
+        if (++g.filled < LV_CPP_ANIM_GOVERNOR_FRAMES) break;
+        uint64_t sum = 0;
+        for (uint32_t t : g.ring) sum += t;
+        const auto avg = static_cast<uint32_t>(sum / LV_CPP_ANIM_GOVERNOR_FRAMES);
+        g.stats.frame_us = avg;
+        g.filled = 0;
+        if (avg > g.budget_us && g.level < Quality::cached) {
+            set_level(g, static_cast<Quality>(static_cast<uint8_t>(g.level) + 1));
+        } else if (uint64_t(avg) * 4 < uint64_t(g.budget_us) * 3 && g.level > Quality::full) {
+            set_level(g, static_cast<Quality>(static_cast<uint8_t>(g.level) - 1));
+        }
+        break;
+    }
+    case LV_EVENT_DELETE:
+        g.disp = nullptr;
+        lv::detail::anim_start_hook() = nullptr;
+        set_level(g, Quality::full);
+        break;
+    default:
+        break;
+    }
+}
+
+inline void obj_delete_cb(lv_event_t* ev) noexcept {
+    if (ObjEntry* o = find_obj(lv_event_get_target_obj(ev))) *o = ObjEntry{};
+}
+
+inline bool add_obj(lv_obj_t* obj, uint8_t flag) noexcept {
+    if (!obj) return false;
+    ObjEntry* o = find_obj(obj);
+    if (!o) {
+        o = find_obj(nullptr);
+        if (!o) {
+            LV_LOG_WARN("anim governor objects exhausted (raise LV_CPP_ANIM_GOVERNOR_OBJECTS)");
+            return false;
+        }
+        o->obj = obj;
+        lv_obj_add_event_cb(obj, &obj_delete_cb, LV_EVENT_DELETE, nullptr);
+    }
+    o->flags |= flag;
+    apply(governor());
+    return true;
+}
+
+} // namespace detail
+
+/**
+ * @brief Govern lv::Anim animations by the render time of `disp`
+ *
+ * @param disp Display (nullptr = default display)
+ * @param budget_us Render time per frame to stay under (0 = LV_DEF_REFR_PERIOD)
+ * @return false without a display
+ */
+inline bool start(lv_display_t* disp = nullptr, uint32_t budget_us = 0) noexcept {
+    detail::Governor& g = detail::governor();
+    if (!disp) disp = lv_display_get_default();
+    if (!disp) return false;
+    if (g.disp != disp) {
+        if (g.disp) lv_display_remove_event_cb_with_user_data(g.disp, &detail::display_event_cb, &g);
+        lv_display_add_event_cb(disp, &detail::display_event_cb, LV_EVENT_RENDER_START, &g);
+        lv_display_add_event_cb(disp, &detail::display_event_cb, LV_EVENT_RENDER_READY, &g);
+        lv_display_add_event_cb(disp, &detail::display_event_cb, LV_EVENT_DELETE, &g);
+        g.disp = disp;
+    }
+    g.budget_us = budget_us ? budget_us : LV_DEF_REFR_PERIOD * 1000u;
+    g.filled = 0;
+    g.head = 0;
+    lv::detail::anim_start_hook() = &detail::start_hook;
+    return true;
+}
+
+/**
+ * @brief Stop governing and return to full quality
+ *
+ * Animations already running stay governed until they end, thinned no
+ * more.
+ */
+inline void stop() noexcept {
+    detail::Governor& g = detail::governor();
+    if (g.disp) lv_display_remove_event_cb_with_user_data(g.disp, &detail::display_event_cb, &g);
+    g.disp = nullptr;
+    lv::detail::anim_start_hook() = nullptr;
+    detail::set_level(g, Quality::full);
+}
+
+/// The governor is timing a display
+[[nodiscard]] inline bool running() noexcept { return detail::governor().disp != nullptr; }
+
+/// Change the render time per frame to stay under
+inline void budget(uint32_t us) noexcept { detail::governor().budget_us = us; }
+
+[[nodiscard]] inline uint32_t budget() noexcept { return detail::governor().budget_us; }
+
+/// Current quality level
+[[nodiscard]] inline Quality quality() noexcept { return detail::governor().level; }
+
+/// Governed animations running
+[[nodiscard]] inline uint32_t animations() noexcept { return detail::governor().running; }
+
+/**
+ * @brief Drop `obj`'s shadow and layer opacity while animations run at `plain` or lower
+ *
+ * Returns false if all LV_CPP_ANIM_GOVERNOR_OBJECTS slots are in use.
+ */
+inline bool simplify(ObjectView obj) noexcept {
+    return detail::add_obj(obj.get(), detail::simplify_flag);
+}
+
+/**
+ * @brief Draw `obj`'s subtree through lv::cached_layer at `cached`
+ *
+ * Objects that already have a cached layer are left as they are.
+ * Returns false if all LV_CPP_ANIM_GOVERNOR_OBJECTS slots are in use or
+ * LV_USE_SNAPSHOT is off.
+ */
+inline bool cache(ObjectView obj) noexcept {
+#if LV_USE_SNAPSHOT
+    return detail::add_obj(obj.get(), detail::cache_flag);
+#else
+    (void)obj;
+    return false;
+#endif
+}
+
+/// Undo simplify() and cache() for `obj`
+inline void forget(ObjectView obj) noexcept {
+    detail::ObjEntry* o = obj.get() ? detail::find_obj(obj.get()) : nullptr;
+    if (!o) return;
+    o->flags = 0;
+    detail::apply(detail::governor());
+    lv_obj_remove_event_cb(o->obj, &detail::obj_delete_cb);
+    *o = detail::ObjEntry{};
+}
+
+[[nodiscard]] inline Stats stats() noexcept { return detail::governor().stats; }
+
+/// Zero the counters
+inline void reset_stats() noexcept { detail::governor().stats = Stats{}; }
+
+} // namespace lv::anim_governor
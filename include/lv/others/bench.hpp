@@ -0,0 +1,524 @@
+#pragma once
+
+/**
+ * @file bench.hpp
+ * @brief Headless benchmark harness with per-phase frame timing
+ *
+ * Drives LVGL deterministically and measures where frame time goes:
+ *
+ * - a virtual tick (lv_tick_set_cb) that advances a fixed step per frame,
+ *   so animations and timers behave the same on every run
+ * - a scripted pointer device (press/move/release/swipe)
+ * - wall-clock timing of input, layout, render and flush phases, taken
+ *   from display events (REFR_START, RENDER_START/READY, FLUSH_START/FINISH)
+ * - wall-clock timing of lv::switch_theme() calls
+ * - p50/p99/max per phase, frame-time histograms and peak memory, as JSON
+ *
+ * Pair with lv::MemoryDisplay for runs without X11/SDL. Applications can
+ * expose a `--bench` mode with bench_options() and run_script().
+ *
+ * Usage:
+ * @code
+ * lv::init();
+ * static lv::MemoryDisplay<800, 480> display;
+ * static lv::Bench bench(display);
+ *
+ * build_ui();
+ * bench.reset();
+ * bench.swipe(700, 240, 100, 240, 20);
+ * bench.run(300);
+ * bench.write_json(stdout, "swipe");
+ * @endcode
+ *
+ * Scripted application benchmark:
+ * @code
+ * constexpr lv::BenchStep script[] = {
+ *     lv::BenchStep::swipe(300, 190, 60, 190, 8),
+ *     lv::BenchStep::wait(90),
+ *     lv::BenchStep::click(458, 100),
+ * };
+ * auto opts = lv::bench_options(argc, argv);    // --bench [--frames N] [--out FILE]
+ * if (opts.enabled) return bench.run_script(opts, "my_app", script) ? 0 : 1;
+ * @endcode
+ */
+
+#include <lvgl.h>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "../core/app.hpp"
+#include "../core/theme.hpp"
+#include "../core/thread.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+namespace lv {
+
+#ifndef LV_CPP_BENCH_MAX_SAMPLES
+/// Samples kept per phase (later samples are dropped)
+#define LV_CPP_BENCH_MAX_SAMPLES 4096
+#endif
+
+/**
+ * @brief Fixed-capacity list of microsecond samples with percentile queries
+ *
+ * percentile() reorders the stored samples; insertion order is not kept.
+ */
+template<size_t N = LV_CPP_BENCH_MAX_SAMPLES>
+class BenchSamples {
+    uint32_t m_us[N];
+    size_t m_count = 0;
+    uint32_t m_max = 0;
+    uint64_t m_total = 0;
+
+public:
+    void add(uint32_t us) noexcept {
+        if (m_count < N) m_us[m_count++] = us;
+        if (us > m_max) m_max = us;
+        m_total += us;
+    }
+
+    void clear() noexcept {
+        m_count = 0;
+        m_max = 0;
+        m_total = 0;
+    }
+
+    [[nodiscard]] size_t count() const noexcept { return m_count; }
+    [[nodiscard]] uint32_t max() const noexcept { return m_max; }
+    [[nodiscard]] uint64_t total() const noexcept { return m_total; }
+
+    /// Value at percentile p (0-100), nearest-rank
+    [[nodiscard]] uint32_t percentile(uint32_t p) noexcept {
+        if (m_count == 0) return 0;
+        size_t rank = (static_cast<size_t>(p) * m_count + 99) / 100;
+        size_t k = rank > 0 ? rank - 1 : 0;
+        if (k >= m_count) k = m_count - 1;
+        std::nth_element(m_us, m_us + k, m_us + m_count);
+        return m_us[k];
+    }
+
+    /**
+     * @brief Count samples into fixed-width buckets
+     *
+     * out[i] counts samples in [i*bucket_us, (i+1)*bucket_us); the last
+     * bucket also collects everything above the range.
+     */
+    void histogram(uint32_t bucket_us, uint32_t* out, size_t buckets) const noexcept {
+        if (buckets == 0 || bucket_us == 0) return;
+        std::fill(out, out + buckets, 0u);
+        for (size_t i = 0; i < m_count; ++i) {
+            size_t b = m_us[i] / bucket_us;
+            ++out[b < buckets ? b : buckets - 1];
+        }
+    }
+};
+
+/// One step of a scripted input sequence (see Bench::play())
+struct BenchStep {
+    enum class Kind : uint8_t { wait, click, swipe };
+
+    Kind kind = Kind::wait;
+    int32_t x0 = 0, y0 = 0, x1 = 0, y1 = 0;
+    uint32_t frames = 0;
+
+    /// Run `n` frames without input
+    [[nodiscard]] static constexpr BenchStep wait(uint32_t n) noexcept {
+        return {Kind::wait, 0, 0, 0, 0, n};
+    }
+
+    /// Press and release at (x, y) (2 frames)
+    [[nodiscard]] static constexpr BenchStep click(int32_t x, int32_t y) noexcept {
+        return {Kind::click, x, y, x, y, 2};
+    }
+
+    /// Drag from (x0, y0) to (x1, y1) over `n` frames, then release (n + 2 frames)
+    [[nodiscard]] static constexpr BenchStep swipe(int32_t x0, int32_t y0, int32_t x1, int32_t y1,
+                                                   uint32_t n = 8) noexcept {
+        return {Kind::swipe, x0, y0, x1, y1, n};
+    }
+};
+
+/// Command line options of an application `--bench` mode
+struct BenchOptions {
+    bool enabled = false;          ///< --bench given
+    uint32_t frames = 1000;        ///< --frames N: total frames to run
+    uint32_t bucket_us = 1000;     ///< --bucket-us N: histogram bucket width
+    const char* out = nullptr;     ///< --out FILE (default stdout)
+};
+
+/// Parse `--bench [--frames N] [--bucket-us N] [--out FILE]`; unknown arguments are ignored
+[[nodiscard]] inline BenchOptions bench_options(int argc, char** argv) noexcept {
+    BenchOptions opt;
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (std::strcmp(arg, "--bench") == 0) {
+            opt.enabled = true;
+        } else if (std::strcmp(arg, "--frames") == 0 && has_value) {
+            opt.frames = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(arg, "--bucket-us") == 0 && has_value) {
+            opt.bucket_us = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(arg, "--out") == 0 && has_value) {
+            opt.out = argv[++i];
+        }
+    }
+    return opt;
+}
+
+/**
+ * @brief Headless benchmark driver for one display
+ *
+ * Installs a virtual tick and a scripted pointer indev on construction and
+ * restores the tick source on destruction. Only one Bench may exist at a
+ * time. Non-copyable, non-movable (display events hold `this`).
+ */
+class Bench {
+public:
+    using Samples = BenchSamples<>;
+
+    /// Per-phase timings (microseconds)
+    struct Phases {
+        Samples frame;    ///< Whole frame: input + timers + refresh
+        Samples event;    ///< Input read and event dispatch
+        Samples layout;   ///< Layout update before rendering
+        Samples render;   ///< Rendering of all invalidated areas in one refresh
+        Samples flush;    ///< Flush callbacks in one refresh
+        Samples theme;    ///< lv::switch_theme() calls
+    };
+
+private:
+    using clock = std::chrono::steady_clock;
+
+    lv_display_t* m_disp = nullptr;
+    lv_indev_t* m_indev = nullptr;
+    lv_point_t m_point{0, 0};
+    bool m_pressed = false;
+    uint32_t m_step_ms = LV_DEF_REFR_PERIOD;
+    uint32_t m_frames = 0;
+    uint32_t m_refreshes = 0;
+    Phases m_phases;
+
+    clock::time_point m_render_start{};
+    clock::time_point m_flush_start{};
+    clock::time_point m_theme_start{};
+    uint32_t m_render_acc = 0;
+    uint32_t m_flush_acc = 0;
+
+    static uint32_t& now_ms() noexcept {
+        static uint32_t now = 0;
+        return now;
+    }
+
+    static uint32_t tick_cb() noexcept { return now_ms(); }
+
+    static uint32_t elapsed_us(clock::time_point since) noexcept {
+        return static_cast<uint32_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - since).count());
+    }
+
+    static void read_cb(lv_indev_t* indev, lv_indev_data_t* data) noexcept {
+        auto* self = static_cast<Bench*>(lv_indev_get_user_data(indev));
+        data->point = self->m_point;
+        data->state = self->m_pressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+    }
+
+    static void theme_begin_cb(void* user_data) noexcept {
+        static_cast<Bench*>(user_data)->m_theme_start = clock::now();
+    }
+
+    static void theme_end_cb(const ThemeSwitchStats&, void* user_data) noexcept {
+        auto* self = static_cast<Bench*>(user_data);
+        self->m_phases.theme.add(elapsed_us(self->m_theme_start));
+    }
+
+    static void refr_event_cb(lv_event_t* e) noexcept {
+        auto* self = static_cast<Bench*>(lv_event_get_user_data(e));
+        switch (lv_event_get_code(e)) {
+        case LV_EVENT_REFR_START: {
+            // Run the layout pass here so it is timed on its own; the refresh
+            // then finds nothing left to lay out.
+            auto t0 = clock::now();
+            lv_obj_update_layout(lv_display_get_screen_active(self->m_disp));
+            lv_obj_update_layout(lv_display_get_layer_top(self->m_disp));
+            lv_obj_update_layout(lv_display_get_layer_sys(self->m_disp));
+            self->m_phases.layout.add(elapsed_us(t0));
+            self->m_render_acc = 0;
+            self->m_flush_acc = 0;
+            break;
+        }
+        case LV_EVENT_RENDER_START:
+            self->m_render_start = clock::now();
+            break;
+        case LV_EVENT_RENDER_READY:
+            self->m_render_acc += elapsed_us(self->m_render_start);
+            break;
+        case LV_EVENT_FLUSH_START:
+            self->m_flush_start = clock::now();
+            break;
+        case LV_EVENT_FLUSH_FINISH:
+            self->m_flush_acc += elapsed_us(self->m_flush_start);
+            break;
+        case LV_EVENT_REFR_READY:
+            self->m_phases.render.add(self->m_render_acc);
+            self->m_phases.flush.add(self->m_flush_acc);
+            ++self->m_refreshes;
+            break;
+        default:
+            break;
+        }
+    }
+
+public:
+    /// Attach to a display (nullptr = default display)
+    explicit Bench(lv_display_t* disp = nullptr) noexcept
+        : m_disp(disp ? disp : lv_display_get_default()) {
+        lv_tick_set_cb(&Bench::tick_cb);
+        Theme::instrument({&Bench::theme_begin_cb, &Bench::theme_end_cb, this});
+        if (!m_disp) return;
+
+        m_indev = lv_indev_create();
+        if (m_indev) {
+            lv_indev_set_type(m_indev, LV_INDEV_TYPE_POINTER);
+            lv_indev_set_read_cb(m_indev, &Bench::read_cb);
+            lv_indev_set_user_data(m_indev, this);
+            lv_indev_set_display(m_indev, m_disp);
+            lv_indev_set_mode(m_indev, LV_INDEV_MODE_EVENT);    // read once per frame, timed
+        }
+
+        lv_display_add_event_cb(m_disp, &Bench::refr_event_cb, LV_EVENT_REFR_START, this);
+        lv_display_add_event_cb(m_disp, &Bench::refr_event_cb, LV_EVENT_RENDER_START, this);
+        lv_display_add_event_cb(m_disp, &Bench::refr_event_cb, LV_EVENT_RENDER_READY, this);
+        lv_display_add_event_cb(m_disp, &Bench::refr_event_cb, LV_EVENT_FLUSH_START, this);
+        lv_display_add_event_cb(m_disp, &Bench::refr_event_cb, LV_EVENT_FLUSH_FINISH, this);
+        lv_display_add_event_cb(m_disp, &Bench::refr_event_cb, LV_EVENT_REFR_READY, this);
+    }
+
+    ~Bench() {
+        if (m_disp) lv_display_remove_event_cb_with_user_data(m_disp, &Bench::refr_event_cb, this);
+        if (m_indev) lv_indev_delete(m_indev);
+        if (Theme::instrumentation().user_data == this) Theme::instrument({});
+        lv_tick_set_cb(nullptr);
+    }
+
+    Bench(const Bench&) = delete;
+    Bench& operator=(const Bench&) = delete;
+    Bench(Bench&&) = delete;
+    Bench& operator=(Bench&&) = delete;
+
+    // ==================== Configuration ====================
+
+    /// Virtual time advanced per frame (default LV_DEF_REFR_PERIOD)
+    Bench& step(uint32_t ms) noexcept {
+        m_step_ms = ms > 0 ? ms : 1;
+        return *this;
+    }
+
+    /// Clear all samples (call after building the scenario's UI)
+    void reset() noexcept {
+        m_phases.frame.clear();
+        m_phases.event.clear();
+        m_phases.layout.clear();
+        m_phases.render.clear();
+        m_phases.flush.clear();
+        m_phases.theme.clear();
+        m_frames = 0;
+        m_refreshes = 0;
+    }
+
+    // ==================== Driving ====================
+
+    /// Advance virtual time by one step and run one timed frame
+    void frame() noexcept {
+        now_ms() += m_step_ms;
+        auto t0 = clock::now();
+        if (m_indev) {
+            auto te = clock::now();
+            lv_indev_read(m_indev);
+            m_phases.event.add(elapsed_us(te));
+        }
+        tick();
+        m_phases.frame.add(elapsed_us(t0));
+        ++m_frames;
+    }
+
+    /// Run `frames` frames
+    void run(uint32_t frames) noexcept {
+        for (uint32_t i = 0; i < frames; ++i) frame();
+    }
+
+    /// Press the virtual pointer at (x, y) and run one frame
+    void press(int32_t x, int32_t y) noexcept {
+        m_point = {x, y};
+        m_pressed = true;
+        frame();
+    }
+
+    /// Move the virtual pointer (keeps the pressed state) and run one frame
+    void move(int32_t x, int32_t y) noexcept {
+        m_point = {x, y};
+        frame();
+    }
+
+    /// Release the virtual pointer and run one frame
+    void release() noexcept {
+        m_pressed = false;
+        frame();
+    }
+
+    /// Press and release at (x, y)
+    void click(int32_t x, int32_t y) noexcept {
+        press(x, y);
+        release();
+    }
+
+    /// Drag from (x0, y0) to (x1, y1) over `frames` frames, then release
+    void swipe(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t frames = 10) noexcept {
+        if (frames == 0) frames = 1;
+        press(x0, y0);
+        for (uint32_t i = 1; i <= frames; ++i) {
+            int32_t f = static_cast<int32_t>(i);
+            int32_t n = static_cast<int32_t>(frames);
+            move(x0 + (x1 - x0) * f / n, y0 + (y1 - y0) * f / n);
+        }
+        release();
+    }
+
+    /// Execute one scripted step
+    void play(const BenchStep& step) noexcept {
+        switch (step.kind) {
+        case BenchStep::Kind::wait:
+            run(step.frames);
+            break;
+        case BenchStep::Kind::click:
+            click(step.x0, step.y0);
+            break;
+        case BenchStep::Kind::swipe:
+            swipe(step.x0, step.y0, step.x1, step.y1, step.frames);
+            break;
+        }
+    }
+
+    /// Repeat a script until at least `total_frames` frames have run since reset()
+    void play(const BenchStep* steps, size_t count, uint32_t total_frames) noexcept {
+        if (count == 0) {
+            run(total_frames);
+            return;
+        }
+        while (m_frames < total_frames) {
+            for (size_t i = 0; i < count && m_frames < total_frames; ++i) play(steps[i]);
+        }
+    }
+
+    /**
+     * @brief Run a scripted application benchmark and write its report
+     *
+     * Settles for a few frames, resets the samples, plays the script for
+     * opts.frames frames and writes {"name", "stats", "frame_histogram"}
+     * to opts.out (or stdout).
+     *
+     * @return false if the output file could not be opened
+     */
+    template<size_t N>
+    bool run_script(const BenchOptions& opts, const char* name, const BenchStep (&steps)[N]) noexcept {
+        return run_script(opts, name, steps, N);
+    }
+
+    bool run_script(const BenchOptions& opts, const char* name,
+                    const BenchStep* steps, size_t count) noexcept {
+        run(10);    // let the first layout and screen load settle
+        reset();
+        play(steps, count, opts.frames);
+
+        FILE* out = opts.out ? std::fopen(opts.out, "w") : stdout;
+        if (!out) return false;
+        std::fprintf(out, "{\"name\":\"%s\",\"stats\":", name);
+        write_json(out, name);
+        std::fprintf(out, ",\"frame_histogram\":");
+        write_histogram_json(out, opts.bucket_us);
+        std::fprintf(out, "}\n");
+        if (out != stdout) std::fclose(out);
+        return true;
+    }
+
+    // ==================== Results ====================
+
+    [[nodiscard]] Phases& phases() noexcept { return m_phases; }
+    [[nodiscard]] uint32_t frames() const noexcept { return m_frames; }
+    [[nodiscard]] uint32_t refreshes() const noexcept { return m_refreshes; }
+
+    /// Peak LVGL heap usage in bytes (0 unless LVGL's builtin allocator is used)
+    [[nodiscard]] static size_t peak_lv_mem() noexcept {
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
+        lv_mem_monitor_t mon;
+        lv_mem_monitor(&mon);
+        return mon.max_used;
+#else
+        return 0;
+#endif
+    }
+
+    /// Peak resident set size of the process in KiB (0 where unavailable)
+    [[nodiscard]] static long peak_rss_kb() noexcept {
+#if defined(__unix__) || defined(__APPLE__)
+        rusage usage{};
+        if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#if defined(__APPLE__)
+        return usage.ru_maxrss / 1024;    // bytes on macOS
+#else
+        return usage.ru_maxrss;
+#endif
+#else
+        return 0;
+#endif
+    }
+
+    /**
+     * @brief Write one scenario result as a JSON object
+     *
+     * {"scenario":..., "frames":..., "refreshes":..., "frame_us":{"p50","p99","max"},
+     *  "event_us":..., "layout_us":..., "render_us":..., "flush_us":..., "theme_us":...,
+     *  "peak_lv_mem_bytes":..., "peak_rss_kb":..., "render_threads":...}
+     */
+    void write_json(FILE* out, const char* scenario) noexcept {
+        std::fprintf(out, "{\"scenario\":\"%s\",\"frames\":%u,\"refreshes\":%u",
+                     scenario, static_cast<unsigned>(m_frames), static_cast<unsigned>(m_refreshes));
+        write_phase(out, "frame_us", m_phases.frame);
+        write_phase(out, "event_us", m_phases.event);
+        write_phase(out, "layout_us", m_phases.layout);
+        write_phase(out, "render_us", m_phases.render);
+        write_phase(out, "flush_us", m_phases.flush);
+        write_phase(out, "theme_us", m_phases.theme);
+        std::fprintf(out, ",\"peak_lv_mem_bytes\":%zu,\"peak_rss_kb\":%ld,\"render_threads\":%u}",
+                     peak_lv_mem(), peak_rss_kb(), static_cast<unsigned>(render_threads()));
+    }
+
+    /// Write the frame-time histogram as a JSON array of bucket counts
+    void write_histogram_json(FILE* out, uint32_t bucket_us = 1000, size_t buckets = 50) noexcept {
+        uint32_t counts[256];
+        if (buckets > 256) buckets = 256;
+        m_phases.frame.histogram(bucket_us, counts, buckets);
+        std::fprintf(out, "{\"bucket_us\":%u,\"counts\":[", static_cast<unsigned>(bucket_us));
+        for (size_t i = 0; i < buckets; ++i) {
+            std::fprintf(out, i ? ",%u" : "%u", static_cast<unsigned>(counts[i]));
+        }
+        std::fprintf(out, "]}");
+    }
+
+private:
+    static void write_phase(FILE* out, const char* name, Samples& s) noexcept {
+        const uint32_t p50 = s.percentile(50);
+        const uint32_t p99 = s.percentile(99);
+        std::fprintf(out, ",\"%s\":{\"p50\":%u,\"p99\":%u,\"max\":%u}", name,
+                     static_cast<unsigned>(p50), static_cast<unsigned>(p99),
+                     static_cast<unsigned>(s.max()));
+    }
+};
+
+} // namespace lv
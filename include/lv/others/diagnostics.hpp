@@ -0,0 +1,315 @@
+#pragma once
+
+/**
+ * @file diagnostics.hpp
+ * @brief On-device diagnostics screen built from the metrics and profiling APIs
+ *
+ * The sysmon overlay shows two lines of numbers. lv::diagnostics::Screen
+ * is a whole screen of them, read from the APIs the library already has:
+ *
+ * - FPS and frame time (average and worst) sparklines, CPU, render and
+ *   flush time: sysmon::snapshot()
+ * - heap use, fragmentation and the largest free block: sysmon as well
+ * - image, glyph and draw buffer cache hit rates since the previous
+ *   update: image_cache, glyph_cache and DrawBufPool stats
+ * - redrawn share of the screen per frame: perf::dirty_regions, without
+ *   the per-invalidation culprit search
+ * - slowest event handlers (LV_CPP_USE_EVENT_STATS), late runs and missed
+ *   periods of timers and the costliest ones (LV_CPP_USE_TIMER_STATS)
+ *
+ * @code
+ * static lv::diagnostics::Screen diag;
+ * diag.mount_and_load();                 // e.g. from a hidden long-press
+ * ...
+ * lv_screen_load(home);                  // diag keeps sampling in the background
+ * @endcode
+ *
+ * It costs one timer run per sysmon window (LV_CPP_SYSMON_PERIOD). While
+ * the screen is not the active one, the run only stores the window's
+ * points. Once it is active again, the points go to the charts in one
+ * Chart::append() each. The labels are formatted only while the screen is
+ * shown. Stats::self_pct_x100 reports the time spent in those runs as a
+ * share of the window. The screen's own redraws count in the figures it
+ * shows.
+ *
+ * Heap allocation: NONE besides the LVGL objects of the screen (points
+ * are kept in the component, LV_CPP_DIAGNOSTICS_POINTS per series)
+ */
+
+#include <lvgl.h>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include "../core/component.hpp"
+#include "../core/image_cache_stats.hpp"
+#include "../core/glyph_cache.hpp"
+#include "../core/event_stats.hpp"
+#include "../core/timer_stats.hpp"
+#include "../draw/draw_buf.hpp"
+#include "../widgets/chart.hpp"
+#include "dirty_regions.hpp"
+#include "sysmon.hpp"
+
+#if LV_USE_CHART && LV_USE_LABEL
+
+#ifndef LV_CPP_DIAGNOSTICS_POINTS
+/// Windows shown by each sparkline
+#define LV_CPP_DIAGNOSTICS_POINTS 60
+#endif
+
+#ifndef LV_CPP_DIAGNOSTICS_TOP
+/// Slow event handlers and late timers listed
+#define LV_CPP_DIAGNOSTICS_TOP 3
+#endif
+
+namespace lv::diagnostics {
+
+struct Stats {
+    uint32_t windows = 0;          ///< Metrics windows taken
+    uint32_t updates = 0;          ///< Windows shown (the screen was active)
+    uint32_t points = 0;           ///< Points handed to the charts
+    uint32_t self_us = 0;          ///< Time of the last run
+    uint32_t self_pct_x100 = 0;    ///< That time as a share of the window, in 1/100 %
+};
+
+/**
+ * @brief Live performance screen; sample in the background, draw while loaded
+ *
+ * Non-movable: its timer keeps a pointer to it.
+ */
+class Screen : public ScreenComponent<Screen> {
+    static constexpr uint32_t POINTS = LV_CPP_DIAGNOSTICS_POINTS;
+    enum Row : uint32_t { perf_row, heap_row, cache_row, dirty_row, handler_row, timer_row, self_row, ROWS };
+
+    // Windows not yet on the charts, oldest first
+    int32_t m_fps[POINTS] = {};
+    int32_t m_frame[POINTS] = {};        ///< 0.1 ms
+    int32_t m_frame_max[POINTS] = {};
+    uint32_t m_pending = 0;
+
+    Chart m_fps_chart;
+    Chart m_frame_chart;
+    lv_chart_series_t* m_fps_series = nullptr;
+    lv_chart_series_t* m_frame_series = nullptr;
+    lv_chart_series_t* m_max_series = nullptr;
+    lv_obj_t* m_rows[ROWS] = {};
+
+    lv_timer_t* m_timer = nullptr;
+    lv_display_t* m_disp = nullptr;
+    uint32_t m_last_window = 0;          ///< Timestamp of the last sysmon window taken
+    bool m_own_dirty = false;            ///< dirty_regions started by the screen
+    uint64_t m_dirty_px = 0;
+    uint32_t m_dirty_frames = 0;
+    image_cache::Stats m_image{};
+    glyph_cache::Stats m_glyph{};
+    DrawBufPoolStats m_pool{};
+    Stats m_stats;
+
+    [[nodiscard]] static uint32_t rate(uint32_t hits, uint32_t misses) noexcept {
+        return hits + misses ? static_cast<uint32_t>(static_cast<uint64_t>(hits) * 100 / (hits + misses)) : 0;
+    }
+
+    void store(const sysmon::PerfSample& s) noexcept {
+        if (m_pending == POINTS) {
+            std::memmove(m_fps, m_fps + 1, sizeof(int32_t) * (POINTS - 1));
+            std::memmove(m_frame, m_frame + 1, sizeof(int32_t) * (POINTS - 1));
+            std::memmove(m_frame_max, m_frame_max + 1, sizeof(int32_t) * (POINTS - 1));
+            --m_pending;
+        }
+        m_fps[m_pending] = static_cast<int32_t>(s.fps);
+        m_frame[m_pending] = static_cast<int32_t>((s.render_us + s.flush_us) / 100);
+        m_frame_max[m_pending] = static_cast<int32_t>(s.render_max_us / 100);
+        ++m_pending;
+    }
+
+    void flush_points() noexcept {
+        if (!m_pending) return;
+        m_fps_chart.append(m_fps_series, std::span<const int32_t>(m_fps, m_pending));
+        m_frame_chart.append(m_frame_series, std::span<const int32_t>(m_frame, m_pending));
+        m_frame_chart.append(m_max_series, std::span<const int32_t>(m_frame_max, m_pending));
+        m_stats.points += m_pending;
+        m_pending = 0;
+    }
+
+    void show_perf(const sysmon::PerfSample& s) noexcept {
+        const uint32_t frame = s.render_us + s.flush_us;
+        lv_label_set_text_fmt(m_rows[perf_row], "%u fps   CPU %u%%   frame %u.%u ms (worst %u.%u)   flush %u.%u ms",
+                              static_cast<unsigned>(s.fps), static_cast<unsigned>(s.cpu),
+                              static_cast<unsigned>(frame / 1000), static_cast<unsigned>(frame / 100 % 10),
+                              static_cast<unsigned>(s.render_max_us / 1000),
+                              static_cast<unsigned>(s.render_max_us / 100 % 10),
+                              static_cast<unsigned>(s.flush_us / 1000), static_cast<unsigned>(s.flush_us / 100 % 10));
+        lv_label_set_text_fmt(m_rows[heap_row], "Heap %u / %u kB (%u%%)   fragmentation %u%%   largest free %u kB",
+                              static_cast<unsigned>(s.mem_used / 1024), static_cast<unsigned>(s.mem_total / 1024),
+                              static_cast<unsigned>(s.mem_used_pct), static_cast<unsigned>(s.mem_frag_pct),
+                              static_cast<unsigned>(s.mem_biggest_free / 1024));
+    }
+
+    void show_caches() noexcept {
+        const image_cache::Stats img = image_cache::stats();
+        const glyph_cache::Stats glyph = glyph_cache::stats();
+        const DrawBufPoolStats pool = draw::pool_stats();
+        lv_label_set_text_fmt(m_rows[cache_row], "Hit rate   image %u%%   glyph %u%%   draw buffer %u%%",
+                              static_cast<unsigned>(rate(img.hits - m_image.hits, img.misses - m_image.misses)),
+                              static_cast<unsigned>(rate(glyph.hits - m_glyph.hits, glyph.misses - m_glyph.misses)),
+                              static_cast<unsigned>(rate(pool.hits - m_pool.hits, pool.misses - m_pool.misses)));
+        m_image = img;
+        m_glyph = glyph;
+        m_pool = pool;
+    }
+
+    void show_dirty() noexcept {
+        const perf::DirtyRegions d(m_disp);
+        const uint32_t frames = d.frames() - m_dirty_frames;
+        const uint64_t px = d.total_pixels() - m_dirty_px;
+        const uint64_t screen = static_cast<uint64_t>(lv_display_get_horizontal_resolution(m_disp)) *
+                                static_cast<uint64_t>(lv_display_get_vertical_resolution(m_disp));
+        const uint32_t pct = frames && screen ? static_cast<uint32_t>(px * 100 / (screen * frames)) : 0;
+        lv_label_set_text_fmt(m_rows[dirty_row], "Redrawn %u%% of the screen per frame (%u frames)",
+                              static_cast<unsigned>(pct), static_cast<unsigned>(frames));
+        m_dirty_frames = d.frames();
+        m_dirty_px = d.total_pixels();
+    }
+
+    void show_handlers() noexcept {
+#if LV_CPP_USE_EVENT_STATS
+        event_stats::HandlerStat top[LV_CPP_DIAGNOSTICS_TOP];
+        const uint32_t n = event_stats::slowest(top, LV_CPP_DIAGNOSTICS_TOP);
+        char text[64 * (LV_CPP_DIAGNOSTICS_TOP + 1)];
+        int len = lv_snprintf(text, sizeof(text), "Slowest handlers (p99 %u us)",
+                              static_cast<unsigned>(event_stats::histogram().percentile_us(99)));
+        for (uint32_t i = 0; i < n && len > 0 && static_cast<size_t>(len) < sizeof(text); ++i) {
+            len += lv_snprintf(text + len, sizeof(text) - static_cast<size_t>(len), "\n  %.32s  %u us max, %u us avg",
+                               top[i].name[0] ? top[i].name : top[i].handler, static_cast<unsigned>(top[i].max_us),
+                               static_cast<unsigned>(top[i].avg_us()));
+        }
+        lv_label_set_text(m_rows[handler_row], text);
+#else
+        lv_label_set_text_static(m_rows[handler_row], "Slowest handlers: build with LV_CPP_USE_EVENT_STATS");
+#endif
+    }
+
+    void show_timers() noexcept {
+#if LV_CPP_USE_TIMER_STATS
+        timer_stats::TimerStat top[LV_CPP_DIAGNOSTICS_TOP];
+        const uint32_t n = timer_stats::report(top, LV_CPP_DIAGNOSTICS_TOP);
+        uint32_t late = 0, missed = 0;
+        timer_stats::for_each([&](const timer_stats::TimerStat& t) {
+            late += t.late_runs;
+            missed += t.missed;
+        });
+        char text[64 * (LV_CPP_DIAGNOSTICS_TOP + 1)];
+        int len = lv_snprintf(text, sizeof(text), "Timers: %u late runs, %u missed periods",
+                              static_cast<unsigned>(late), static_cast<unsigned>(missed));
+        for (uint32_t i = 0; i < n && len > 0 && static_cast<size_t>(len) < sizeof(text); ++i) {
+            len += lv_snprintf(text + len, sizeof(text) - static_cast<size_t>(len), "\n  %.32s  %u us avg, %u missed",
+                               top[i].handler, static_cast<unsigned>(top[i].avg_us()),
+                               static_cast<unsigned>(top[i].missed));
+        }
+        lv_label_set_text(m_rows[timer_row], text);
+#else
+        lv_label_set_text_static(m_rows[timer_row], "Timer overruns: build with LV_CPP_USE_TIMER_STATS");
+#endif
+    }
+
+    void run() noexcept {
+        const uint64_t start = sysmon::detail::perf_now_us();
+        const sysmon::PerfSample s = sysmon::snapshot();
+        if (s.timestamp == m_last_window || s.window_ms == 0) return;
+        m_last_window = s.timestamp;
+        ++m_stats.windows;
+        store(s);
+        if (!this->is_mounted() || lv_obj_get_screen(this->root().get()) != lv_display_get_screen_active(m_disp)) {
+            return;
+        }
+
+        ++m_stats.updates;
+        flush_points();
+        show_perf(s);
+        show_caches();
+        show_dirty();
+        show_handlers();
+        show_timers();
+        m_stats.self_us = static_cast<uint32_t>(sysmon::detail::perf_now_us() - start);
+        m_stats.self_pct_x100 = static_cast<uint32_t>(static_cast<uint64_t>(m_stats.self_us) * 10 / s.window_ms);
+        lv_label_set_text_fmt(m_rows[self_row], "This screen: %u us per window (%u.%02u%% CPU)",
+                              static_cast<unsigned>(m_stats.self_us),
+                              static_cast<unsigned>(m_stats.self_pct_x100 / 100),
+                              static_cast<unsigned>(m_stats.self_pct_x100 % 100));
+    }
+
+    static void timer_cb(lv_timer_t* t) noexcept {
+        static_cast<Screen*>(lv_timer_get_user_data(t))->run();
+    }
+
+    [[nodiscard]] static Chart sparkline(lv_obj_t* parent, int32_t max) noexcept {
+        Chart c = Chart::create(parent);
+        lv_obj_set_size(c.get(), lv_pct(100), 60);
+        lv_chart_set_type(c.get(), LV_CHART_TYPE_LINE);
+        lv_chart_set_point_count(c.get(), POINTS);
+        lv_chart_set_update_mode(c.get(), LV_CHART_UPDATE_MODE_SHIFT);
+        lv_chart_set_axis_range(c.get(), LV_CHART_AXIS_PRIMARY_Y, 0, max);
+        lv_chart_set_div_line_count(c.get(), 3, 0);
+        lv_obj_set_style_size(c.get(), 0, 0, LV_PART_INDICATOR);
+        return c;
+    }
+
+public:
+    Screen() noexcept = default;
+
+    ~Screen() {
+        if (m_timer) lv_timer_delete(m_timer);
+        if (m_own_dirty) perf::DirtyRegions(m_disp).stop();
+    }
+
+    /// Component build(): charts and one label per row of figures
+    ObjectView build(ObjectView parent) {
+        m_disp = lv_obj_get_display(parent.get());
+        lv_obj_t* root = lv_obj_create(parent.get());
+        lv_obj_set_size(root, lv_pct(100), lv_pct(100));
+        lv_obj_set_flex_flow(root, LV_FLEX_FLOW_COLUMN);
+        lv_obj_set_style_pad_row(root, 4, 0);
+
+        lv_obj_t* title = lv_label_create(root);
+        lv_label_set_text_static(title, "Diagnostics");
+        const int32_t fps_max = 1000 / LV_DEF_REFR_PERIOD;
+        m_fps_chart = sparkline(root, fps_max + fps_max / 4);
+        m_fps_series = m_fps_chart.add_series(lv_palette_main(LV_PALETTE_GREEN));
+        m_frame_chart = sparkline(root, 2 * LV_DEF_REFR_PERIOD * 10);   // 0.1 ms units
+        m_frame_series = m_frame_chart.add_series(lv_palette_main(LV_PALETTE_BLUE));
+        m_max_series = m_frame_chart.add_series(lv_palette_main(LV_PALETTE_RED));
+        for (lv_obj_t*& row : m_rows) {
+            row = lv_label_create(root);
+            lv_label_set_text_static(row, "");
+        }
+
+        image_cache::enable_stats();
+        if (!perf::DirtyRegions(m_disp).active()) {
+            m_own_dirty = perf::dirty_regions(m_disp).find_culprits(false).active();
+        }
+        if (!sysmon::running()) sysmon::start(m_disp);
+        if (!m_timer) m_timer = lv_timer_create(&Screen::timer_cb, LV_CPP_SYSMON_PERIOD, this);
+        return ObjectView(root);
+    }
+
+    void on_unmount() noexcept {
+        m_fps_chart = Chart();
+        m_frame_chart = Chart();
+        m_fps_series = m_frame_series = m_max_series = nullptr;
+        for (lv_obj_t*& row : m_rows) row = nullptr;
+    }
+
+    /// Sample every `ms` (match sysmon::start()'s period)
+    Screen& period(uint32_t ms) noexcept {
+        if (m_timer) lv_timer_set_period(m_timer, ms);
+        return *this;
+    }
+
+    [[nodiscard]] const Stats& stats() const noexcept { return m_stats; }
+
+    void reset_stats() noexcept { m_stats = Stats{}; }
+};
+
+} // namespace lv::diagnostics
+
+#endif // LV_USE_CHART && LV_USE_LABEL
@@ -0,0 +1,471 @@
+#pragma once
+
+/**
+ * @file dirty_regions.hpp
+ * @brief Per-refresh invalidation tracking and a redraw flashing overlay
+ *
+ * lv::perf::dirty_regions(display) starts recording, for every refresh:
+ * - each invalidated area and the object that most likely caused it
+ * - the merged areas LVGL actually redraws (after lv_refr joins them)
+ * - pixels redrawn versus the screen size
+ *
+ * Across frames it ranks the objects invalidating the most pixels, which is
+ * how e.g. a ticking clock label invalidating a whole card shows up.
+ *
+ * Usage:
+ * @code
+ * #include <lv/others/dirty_regions.hpp>
+ *
+ * auto dirty = lv::perf::dirty_regions();          // default display
+ * dirty.show_overlay();                            // flash redrawn areas
+ * dirty.on_frame([](const lv::perf::DirtyFrame& f, void*) {
+ *     if (f.coverage() > 0.5f) LV_LOG_USER("frame %u redrew %u px", f.frame, f.pixels);
+ * });
+ * ...
+ * dirty.log_culprits();
+ * @endcode
+ *
+ * LVGL has no hook inside lv_obj_invalidate(), so the culprit is inferred:
+ * the smallest visible object whose drawing area (coords + ext draw size)
+ * contains the invalidated area. This walks the screen for every
+ * invalidation. It is a debugging aid; stop() when done.
+ *
+ * The overlay's own fading rectangles are redrawn too; their invalidations
+ * are not recorded but do count in DirtyFrame::pixels while it is shown.
+ *
+ * Not included by lv.hpp: the invalidation hook reads lv_display_t's
+ * inv_areas, inv_area_joined and inv_p, which have no getters. Checked
+ * against LVGL 9.4 (see LV_CPP_INTERNALS_OK).
+ *
+ * Heap allocation: NONE (LV_CPP_DIRTY_MAX_DISPLAYS fixed trackers)
+ */
+
+#include <lvgl.h>
+#include "../core/version.hpp"
+
+#if !LV_CPP_INTERNALS_OK
+#error "dirty_regions.hpp reads LVGL internals checked against LVGL 9.4; see LV_CPP_INTERNALS_OK"
+#endif
+
+#include <src/display/lv_display_private.h>   // inv_areas, inv_area_joined, inv_p
+#include <cstdint>
+#include "../core/object.hpp"
+
+namespace lv::perf {
+
+#ifndef LV_CPP_DIRTY_MAX_DISPLAYS
+/// Displays that can be tracked at once
+#define LV_CPP_DIRTY_MAX_DISPLAYS 2
+#endif
+
+#ifndef LV_CPP_DIRTY_MAX_AREAS
+/// Invalidated areas recorded per frame (more are counted, not stored)
+#define LV_CPP_DIRTY_MAX_AREAS 32
+#endif
+
+#ifndef LV_CPP_DIRTY_MAX_CULPRITS
+/// Objects ranked by invalidated pixels
+#define LV_CPP_DIRTY_MAX_CULPRITS 16
+#endif
+
+#ifndef LV_CPP_DIRTY_FLASH_RECTS
+/// Rectangles the overlay can flash at once
+#define LV_CPP_DIRTY_FLASH_RECTS 8
+#endif
+
+#ifndef LV_CPP_DIRTY_FLASH_MS
+/// Fade-out time of an overlay flash
+#define LV_CPP_DIRTY_FLASH_MS 400
+#endif
+
+/// One lv_inv_area() call
+struct DirtyArea {
+    lv_area_t area;
+    lv_obj_t* culprit;    ///< Inferred invalidating object (may be deleted since)
+};
+
+/// What one refresh invalidated and redrew
+struct DirtyFrame {
+    uint32_t frame = 0;                           ///< Refresh counter since tracking started
+    DirtyArea invalidated[LV_CPP_DIRTY_MAX_AREAS];
+    uint32_t invalidated_count = 0;               ///< Stored entries of invalidated[]
+    uint32_t invalidations = 0;                   ///< All lv_inv_area() calls, stored or not
+    lv_area_t merged[LV_INV_BUF_SIZE];            ///< Areas LVGL redrew after joining
+    uint32_t merged_count = 0;
+    uint32_t pixels = 0;                          ///< Sum of merged areas
+    uint32_t screen_pixels = 0;
+
+    /// Redrawn share of the screen (1.0: full redraw)
+    [[nodiscard]] float coverage() const noexcept {
+        return screen_pixels ? static_cast<float>(pixels) / static_cast<float>(screen_pixels) : 0.0f;
+    }
+};
+
+/// Accumulated invalidations of one object
+struct DirtyCulprit {
+    lv_obj_t* obj = nullptr;
+    const lv_obj_class_t* cls = nullptr;
+    uint32_t invalidations = 0;
+    uint64_t pixels = 0;
+};
+
+using dirty_frame_cb = void (*)(const DirtyFrame& frame, void* user_data);
+
+namespace detail {
+
+struct DirtyTracker {
+    lv_display_t* disp = nullptr;         ///< nullptr: free slot
+    DirtyFrame pending;                   ///< Being collected
+    DirtyFrame last;                      ///< Last completed refresh
+    DirtyCulprit culprits[LV_CPP_DIRTY_MAX_CULPRITS];
+    uint64_t total_pixels = 0;
+    uint32_t frames = 0;
+    dirty_frame_cb cb = nullptr;
+    void* cb_user_data = nullptr;
+    bool find_culprits = true;
+    bool overlay = false;
+    bool updating_overlay = false;
+    lv_obj_t* flash[LV_CPP_DIRTY_FLASH_RECTS] = {};
+    uint32_t next_flash = 0;
+};
+
+[[nodiscard]] inline DirtyTracker* dirty_trackers() noexcept {
+    static DirtyTracker trackers[LV_CPP_DIRTY_MAX_DISPLAYS];
+    return trackers;
+}
+
+[[nodiscard]] inline DirtyTracker* find_dirty_tracker(lv_display_t* disp) noexcept {
+    DirtyTracker* t = dirty_trackers();
+    for (uint32_t i = 0; i < LV_CPP_DIRTY_MAX_DISPLAYS; ++i) {
+        if (t[i].disp == disp) return &t[i];
+    }
+    return nullptr;
+}
+
+[[nodiscard]] inline uint32_t area_pixels(const lv_area_t& a) noexcept {
+    return static_cast<uint32_t>(lv_area_get_width(&a)) * static_cast<uint32_t>(lv_area_get_height(&a));
+}
+
+[[nodiscard]] inline bool area_contains(const lv_area_t& outer, const lv_area_t& inner) noexcept {
+    return inner.x1 >= outer.x1 && inner.y1 >= outer.y1 && inner.x2 <= outer.x2 && inner.y2 <= outer.y2;
+}
+
+[[nodiscard]] inline bool is_flash_rect(const DirtyTracker& t, const lv_obj_t* obj) noexcept {
+    for (const lv_obj_t* f : t.flash) {
+        if (f == obj) return true;
+    }
+    return false;
+}
+
+/// Deepest, smallest visible object whose drawing area contains `a` (overlay excluded)
+inline void find_culprit(const DirtyTracker& t, lv_obj_t* obj, const lv_area_t& a,
+                         lv_obj_t*& best, uint32_t& best_px) noexcept {
+    if (lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN) || is_flash_rect(t, obj)) return;
+    lv_area_t draw;
+    lv_obj_get_coords(obj, &draw);
+    const int32_t ext = lv_obj_get_ext_draw_size(obj);
+    lv_area_increase(&draw, ext, ext);
+    if (area_contains(draw, a)) {
+        const uint32_t px = area_pixels(draw);
+        if (px <= best_px) {
+            best = obj;
+            best_px = px;
+        }
+    }
+    const uint32_t n = lv_obj_get_child_count(obj);
+    for (uint32_t i = 0; i < n; ++i) find_culprit(t, lv_obj_get_child(obj, static_cast<int32_t>(i)), a, best, best_px);
+}
+
+inline void add_culprit(DirtyTracker& t, lv_obj_t* obj, uint32_t px) noexcept {
+    DirtyCulprit* slot = nullptr;
+    DirtyCulprit* weakest = &t.culprits[0];
+    for (DirtyCulprit& c : t.culprits) {
+        if (c.obj == obj) {
+            slot = &c;
+            break;
+        }
+        if (!slot && !c.obj) slot = &c;
+        if (c.pixels < weakest->pixels) weakest = &c;
+    }
+    if (!slot) slot = weakest;    // table full: replace the smallest offender
+    if (slot->obj != obj) *slot = DirtyCulprit{obj, lv_obj_get_class(obj), 0, 0};
+    ++slot->invalidations;
+    slot->pixels += px;
+}
+
+[[nodiscard]] inline lv_obj_t* culprit_of(const DirtyTracker& t, const lv_area_t& a) noexcept {
+    lv_obj_t* best = nullptr;
+    uint32_t best_px = UINT32_MAX;
+    lv_obj_t* roots[] = {
+        lv_display_get_screen_active(t.disp),
+        lv_display_get_layer_top(t.disp),
+        lv_display_get_layer_sys(t.disp),
+    };
+    for (lv_obj_t* root : roots) {
+        if (root) find_culprit(t, root, a, best, best_px);
+    }
+    return best;
+}
+
+inline void start_flash(DirtyTracker& t, const lv_area_t& a);
+
+inline void dirty_event_cb(lv_event_t* e) {
+    auto* disp = static_cast<lv_display_t*>(lv_event_get_current_target(e));
+    DirtyTracker* t = find_dirty_tracker(disp);
+    if (!t) return;
+    switch (lv_event_get_code(e)) {
+    case LV_EVENT_INVALIDATE_AREA: {
+        const auto* a = static_cast<const lv_area_t*>(lv_event_get_param(e));
+        if (!a || t->updating_overlay) return;
+        lv_obj_t* culprit = t->find_culprits ? culprit_of(*t, *a) : nullptr;
+        DirtyFrame& f = t->pending;
+        ++f.invalidations;
+        if (f.invalidated_count < LV_CPP_DIRTY_MAX_AREAS) f.invalidated[f.invalidated_count++] = {*a, culprit};
+        if (culprit) add_culprit(*t, culprit, area_pixels(*a));
+        break;
+    }
+    case LV_EVENT_RENDER_START: {
+        // Areas are joined by now and not yet cleared
+        DirtyFrame& f = t->pending;
+        f.merged_count = 0;
+        f.pixels = 0;
+        for (uint32_t i = 0; i < disp->inv_p && i < LV_INV_BUF_SIZE; ++i) {
+            if (disp->inv_area_joined[i]) continue;
+            f.merged[f.merged_count++] = disp->inv_areas[i];
+            f.pixels += area_pixels(disp->inv_areas[i]);
+        }
+        break;
+    }
+    case LV_EVENT_REFR_READY: {
+        DirtyFrame& f = t->pending;
+        if (f.merged_count == 0 && f.invalidations == 0) return;
+        f.frame = t->frames++;
+        f.screen_pixels = static_cast<uint32_t>(lv_display_get_horizontal_resolution(disp)) *
+                          static_cast<uint32_t>(lv_display_get_vertical_resolution(disp));
+        t->total_pixels += f.pixels;
+        t->last = f;
+        t->pending = DirtyFrame{};
+        if (t->overlay) {
+            t->updating_overlay = true;
+            for (uint32_t i = 0; i < t->last.merged_count; ++i) {
+                // Only flash areas something other than the overlay invalidated
+                for (uint32_t j = 0; j < t->last.invalidated_count; ++j) {
+                    if (lv_area_is_on(&t->last.merged[i], &t->last.invalidated[j].area)) {
+                        start_flash(*t, t->last.merged[i]);
+                        break;
+                    }
+                }
+            }
+            t->updating_overlay = false;
+        }
+        if (t->cb) t->cb(t->last, t->cb_user_data);
+        break;
+    }
+    case LV_EVENT_DELETE:
+        *t = DirtyTracker{};
+        break;
+    default:
+        break;
+    }
+}
+
+/// Run `fn` on a flash rectangle without recording the invalidations it causes
+template<typename F>
+inline void overlay_update(lv_obj_t* flash, F&& fn) {
+    DirtyTracker* t = find_dirty_tracker(lv_obj_get_display(flash));
+    if (t) t->updating_overlay = true;
+    fn(flash);
+    if (t) t->updating_overlay = false;
+}
+
+inline void flash_fade_cb(void* obj, int32_t v) {
+    overlay_update(static_cast<lv_obj_t*>(obj), [v](lv_obj_t* f) {
+        lv_obj_set_style_bg_opa(f, static_cast<lv_opa_t>(v), 0);
+        lv_obj_set_style_border_opa(f, static_cast<lv_opa_t>(v * 2 > 255 ? 255 : v * 2), 0);
+    });
+}
+
+inline void flash_done_cb(lv_anim_t* a) {
+    overlay_update(static_cast<lv_obj_t*>(lv_anim_get_user_data(a)),
+                   [](lv_obj_t* f) { lv_obj_add_flag(f, LV_OBJ_FLAG_HIDDEN); });
+}
+
+inline void start_flash(DirtyTracker& t, const lv_area_t& a) {
+    lv_obj_t*& f = t.flash[t.next_flash];
+    t.next_flash = (t.next_flash + 1) % LV_CPP_DIRTY_FLASH_RECTS;
+    if (!f) {
+        f = lv_obj_create(lv_display_get_layer_sys(t.disp));
+        if (!f) return;
+        lv_obj_remove_style_all(f);
+        lv_obj_remove_flag(f, LV_OBJ_FLAG_CLICKABLE);
+        lv_obj_add_flag(f, LV_OBJ_FLAG_IGNORE_LAYOUT);
+        lv_obj_set_style_bg_color(f, lv_color_hex(0xFF2060), 0);
+        lv_obj_set_style_border_color(f, lv_color_hex(0xFF2060), 0);
+        lv_obj_set_style_border_width(f, 1, 0);
+    }
+    lv_obj_set_pos(f, a.x1, a.y1);
+    lv_obj_set_size(f, lv_area_get_width(&a), lv_area_get_height(&a));
+    lv_obj_remove_flag(f, LV_OBJ_FLAG_HIDDEN);
+    lv_anim_t anim;
+    lv_anim_init(&anim);
+    lv_anim_set_var(&anim, f);
+    lv_anim_set_user_data(&anim, f);
+    lv_anim_set_exec_cb(&anim, &flash_fade_cb);
+    lv_anim_set_values(&anim, LV_OPA_40, LV_OPA_TRANSP);
+    lv_anim_set_duration(&anim, LV_CPP_DIRTY_FLASH_MS);
+    lv_anim_set_completed_cb(&anim, &flash_done_cb);
+    lv_anim_start(&anim);
+}
+
+inline void delete_flash_rects(DirtyTracker& t) noexcept {
+    for (lv_obj_t*& f : t.flash) {
+        if (f) lv_obj_delete(f);
+        f = nullptr;
+    }
+    t.next_flash = 0;
+}
+
+} // namespace detail
+
+/**
+ * @brief Handle to the dirty-region tracker of one display
+ *
+ * Cheap to copy; all state lives in a static slot until stop().
+ */
+class DirtyRegions {
+    lv_display_t* m_disp;
+
+    [[nodiscard]] detail::DirtyTracker* tracker() const noexcept { return detail::find_dirty_tracker(m_disp); }
+
+public:
+    explicit constexpr DirtyRegions(lv_display_t* disp) noexcept : m_disp(disp) {}
+
+    /// Tracking is active (false if all LV_CPP_DIRTY_MAX_DISPLAYS slots were taken)
+    [[nodiscard]] bool active() const noexcept { return m_disp && tracker(); }
+
+    /// Last completed refresh (empty frame when inactive)
+    [[nodiscard]] const DirtyFrame& last() const noexcept {
+        static const DirtyFrame none{};
+        const detail::DirtyTracker* t = tracker();
+        return t ? t->last : none;
+    }
+
+    /// Refreshes recorded so far
+    [[nodiscard]] uint32_t frames() const noexcept {
+        const detail::DirtyTracker* t = tracker();
+        return t ? t->frames : 0;
+    }
+
+    /// Pixels redrawn over all recorded refreshes
+    [[nodiscard]] uint64_t total_pixels() const noexcept {
+        const detail::DirtyTracker* t = tracker();
+        return t ? t->total_pixels : 0;
+    }
+
+    /// Called after every recorded refresh (nullptr to remove)
+    DirtyRegions& on_frame(dirty_frame_cb cb, void* user_data = nullptr) noexcept {
+        if (detail::DirtyTracker* t = tracker()) {
+            t->cb = cb;
+            t->cb_user_data = user_data;
+        }
+        return *this;
+    }
+
+    /// Infer culprit objects (default on; off skips the per-invalidation tree walk)
+    DirtyRegions& find_culprits(bool enable) noexcept {
+        if (detail::DirtyTracker* t = tracker()) t->find_culprits = enable;
+        return *this;
+    }
+
+    /**
+     * @brief Objects that invalidated the most pixels, unsorted
+     * @param count Receives the number of valid entries
+     */
+    [[nodiscard]] const DirtyCulprit* culprits(uint32_t& count) const noexcept {
+        count = 0;
+        const detail::DirtyTracker* t = tracker();
+        if (!t) return nullptr;
+        for (const DirtyCulprit& c : t->culprits) count += c.obj != nullptr;
+        return t->culprits;    // free entries have obj == nullptr
+    }
+
+    /// Object with the most invalidated pixels (nullptr if none)
+    [[nodiscard]] ObjectView top_culprit() const noexcept {
+        const detail::DirtyTracker* t = tracker();
+        if (!t) return ObjectView(nullptr);
+        const DirtyCulprit* top = nullptr;
+        for (const DirtyCulprit& c : t->culprits) {
+            if (c.obj && (!top || c.pixels > top->pixels)) top = &c;
+        }
+        return ObjectView(top ? top->obj : nullptr);
+    }
+
+    /// Log the culprit table and the last frame's coverage (LV_LOG_USER)
+    void log_culprits() const noexcept {
+        const detail::DirtyTracker* t = tracker();
+        if (!t) return;
+        LV_LOG_USER("dirty regions: %u frames, last redrew %u of %u px",
+                    static_cast<unsigned>(t->frames), static_cast<unsigned>(t->last.pixels),
+                    static_cast<unsigned>(t->last.screen_pixels));
+        for (const DirtyCulprit& c : t->culprits) {
+            if (!c.obj) continue;
+            LV_LOG_USER("  %p: %u invalidations, %lu px", static_cast<void*>(c.obj),
+                        static_cast<unsigned>(c.invalidations), static_cast<unsigned long>(c.pixels));
+        }
+    }
+
+    /// Clear counters and culprits (tracking continues)
+    void reset() noexcept {
+        detail::DirtyTracker* t = tracker();
+        if (!t) return;
+        for (DirtyCulprit& c : t->culprits) c = DirtyCulprit{};
+        t->total_pixels = 0;
+        t->frames = 0;
+        t->last = DirtyFrame{};
+    }
+
+    /// Flash redrawn areas on the display's system layer
+    DirtyRegions& show_overlay(bool show = true) noexcept {
+        detail::DirtyTracker* t = tracker();
+        if (!t) return *this;
+        t->overlay = show;
+        if (!show) detail::delete_flash_rects(*t);
+        return *this;
+    }
+
+    void hide_overlay() noexcept { show_overlay(false); }
+
+    /// Stop tracking and remove the overlay
+    void stop() noexcept {
+        detail::DirtyTracker* t = tracker();
+        if (!t) return;
+        detail::delete_flash_rects(*t);
+        lv_display_remove_event_cb_with_user_data(m_disp, &detail::dirty_event_cb, nullptr);
+        *t = detail::DirtyTracker{};
+    }
+
+    [[nodiscard]] lv_display_t* display() const noexcept { return m_disp; }
+};
+
+/**
+ * @brief Start (or get) dirty-region tracking of a display
+ * @param disp Display (nullptr = default display)
+ */
+inline DirtyRegions dirty_regions(lv_display_t* disp = nullptr) noexcept {
+    if (!disp) disp = lv_display_get_default();
+    if (!disp) return DirtyRegions(nullptr);
+    if (detail::find_dirty_tracker(disp)) return DirtyRegions(disp);
+    detail::DirtyTracker* t = detail::find_dirty_tracker(nullptr);
+    if (!t) {
+        LV_LOG_WARN("dirty region trackers exhausted, raise LV_CPP_DIRTY_MAX_DISPLAYS");
+        return DirtyRegions(disp);
+    }
+    t->disp = disp;
+    lv_display_add_event_cb(disp, &detail::dirty_event_cb, LV_EVENT_INVALIDATE_AREA, nullptr);
+    lv_display_add_event_cb(disp, &detail::dirty_event_cb, LV_EVENT_RENDER_START, nullptr);
+    lv_display_add_event_cb(disp, &detail::dirty_event_cb, LV_EVENT_REFR_READY, nullptr);
+    lv_display_add_event_cb(disp, &detail::dirty_event_cb, LV_EVENT_DELETE, nullptr);
+    return DirtyRegions(disp);
+}
+
+} // namespace lv::perf
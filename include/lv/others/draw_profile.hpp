@@ -0,0 +1,591 @@
+#pragma once
+
+/**
+ * @file draw_profile.hpp
+ * @brief Software render time per draw task type and per widget, with a heatmap overlay
+ *
+ * lv::perf::draw_profile(display) times every task the software draw unit
+ * renders and adds the time to two tables:
+ * - per task type (fill, border, box shadow, label, image, vector, ...),
+ *   one DrawSample per window, published like lv::sysmon's metrics
+ * - per (object, task type) key, keeping the LV_CPP_DRAW_PROFILE_ENTRIES
+ *   most expensive keys, so "card / box shadow" shows up as such
+ *
+ * Fills with a gradient are kept apart from plain fills (`gradient`).
+ *
+ * Usage:
+ * @code
+ * #include <lv/others/draw_profile.hpp>
+ *
+ * auto prof = lv::perf::draw_profile();            // default display, 1 s windows
+ * prof.show_overlay();                             // heatmap of the last window
+ * prof.on_window([](const lv::perf::DrawSample& s, void*) {
+ *     metrics.gauge("ui_draw_us", s.draw_us);
+ *     metrics.gauge("ui_shadow_us", s.type(LV_DRAW_TASK_TYPE_BOX_SHADOW).total_us);
+ * });
+ * ...
+ * prof.log_costs();
+ * @endcode
+ *
+ * The timer wraps the dispatch callback of LVGL's "SW" draw units. With
+ * LV_OS_NONE the unit renders inside dispatch, so a task's time is exact.
+ * With an OS the unit renders on its own thread; the task is then finished
+ * when the next dispatch on the LVGL thread finds the unit idle, and the
+ * time includes that wake-up latency. Tasks taken by other draw units are
+ * not timed. The overlay's own draws are excluded, but the overlay redraws
+ * the screen once per window while it is shown.
+ *
+ * Needs LV_USE_DRAW_SW.
+ *
+ * Not included by lv.hpp: it wraps the software draw units found through
+ * LVGL's global draw_info.unit_head and reads the unit's active task, none
+ * of which is public. Checked against LVGL 9.4 (see LV_CPP_INTERNALS_OK).
+ *
+ * Heap allocation: NONE (fixed tables)
+ */
+
+#include <lvgl.h>
+#include "../core/version.hpp"
+
+#if !LV_CPP_INTERNALS_OK
+#error "draw_profile.hpp reads LVGL internals checked against LVGL 9.4; see LV_CPP_INTERNALS_OK"
+#endif
+
+#include <src/core/lv_global.h>              // draw_info.unit_head
+#include <src/draw/lv_draw_private.h>        // lv_draw_unit_t, lv_draw_task_t::area
+#include <src/draw/sw/lv_draw_sw_private.h>  // lv_draw_sw_unit_t::task_act, DRAW_UNIT_ID_SW
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include "../core/object.hpp"
+#include "../core/state.hpp"
+
+#if LV_USE_DRAW_SW
+
+namespace lv::perf {
+
+#ifndef LV_CPP_DRAW_PROFILE_ENTRIES
+/// (object, task type) keys kept, most expensive first
+#define LV_CPP_DRAW_PROFILE_ENTRIES 32
+#endif
+
+#ifndef LV_CPP_DRAW_PROFILE_NAME
+/// Bytes of the object name copied into an entry (LV_USE_OBJ_NAME)
+#define LV_CPP_DRAW_PROFILE_NAME 24
+#endif
+
+#ifndef LV_CPP_DRAW_PROFILE_UNITS
+/// Software draw units that can be timed (LV_DRAW_SW_DRAW_UNIT_CNT)
+#define LV_CPP_DRAW_PROFILE_UNITS 4
+#endif
+
+#ifndef LV_CPP_DRAW_PROFILE_PERIOD
+/// Default length of a profiling window in milliseconds
+#define LV_CPP_DRAW_PROFILE_PERIOD 1000
+#endif
+
+/// Task type slots of DrawSample (higher types share the last slot)
+inline constexpr uint32_t kDrawTypeSlots = 16;
+
+/// Short name of a draw task type ("fill", "box_shadow", ...)
+[[nodiscard]] inline const char* draw_task_type_name(lv_draw_task_type_t type) noexcept {
+    switch (type) {
+    case LV_DRAW_TASK_TYPE_FILL: return "fill";
+    case LV_DRAW_TASK_TYPE_BORDER: return "border";
+    case LV_DRAW_TASK_TYPE_BOX_SHADOW: return "box_shadow";
+    case LV_DRAW_TASK_TYPE_LABEL: return "label";
+    case LV_DRAW_TASK_TYPE_IMAGE: return "image";
+    case LV_DRAW_TASK_TYPE_LAYER: return "layer";
+    case LV_DRAW_TASK_TYPE_LINE: return "line";
+    case LV_DRAW_TASK_TYPE_ARC: return "arc";
+    case LV_DRAW_TASK_TYPE_TRIANGLE: return "triangle";
+    case LV_DRAW_TASK_TYPE_MASK_RECTANGLE: return "mask_rect";
+    case LV_DRAW_TASK_TYPE_MASK_BITMAP: return "mask_bitmap";
+#if LV_VERSION_AT_LEAST(9, 3, 0)
+    case LV_DRAW_TASK_TYPE_LETTER: return "letter";
+#endif
+#if LV_USE_VECTOR_GRAPHIC
+    case LV_DRAW_TASK_TYPE_VECTOR: return "vector";
+#endif
+    default: return "other";
+    }
+}
+
+/// Render time of one task type
+struct DrawTypeCost {
+    uint32_t tasks = 0;
+    uint32_t max_us = 0;
+    uint64_t total_us = 0;
+};
+
+/// Software render time of one window, per task type
+struct DrawSample {
+    uint32_t timestamp = 0;       ///< lv_tick_get() at the end of the window
+    uint32_t window_ms = 0;
+    uint32_t refreshes = 0;
+    uint32_t tasks = 0;
+    uint64_t draw_us = 0;         ///< Sum of all task times
+    uint32_t gradient_tasks = 0;  ///< Fills with a gradient (also counted as fill)
+    uint64_t gradient_us = 0;
+    DrawTypeCost types[kDrawTypeSlots];
+
+    [[nodiscard]] static constexpr uint32_t slot(lv_draw_task_type_t type) noexcept {
+        return static_cast<uint32_t>(type) < kDrawTypeSlots ? static_cast<uint32_t>(type) : kDrawTypeSlots - 1;
+    }
+
+    [[nodiscard]] const DrawTypeCost& type(lv_draw_task_type_t t) const noexcept { return types[slot(t)]; }
+};
+
+/// Accumulated render time of one (object, task type) key
+struct DrawCost {
+    lv_obj_t* obj = nullptr;       ///< Identity only; may be deleted by now (nullptr: free entry)
+    const lv_obj_class_t* cls = nullptr;
+    lv_draw_task_type_t type = LV_DRAW_TASK_TYPE_NONE;
+    bool gradient = false;         ///< Fill with a gradient
+    char name[LV_CPP_DRAW_PROFILE_NAME] = {};  ///< Object name when first seen ("" if none)
+    lv_area_t area{};              ///< Union of the task areas in the current window
+    uint32_t tasks = 0;
+    uint32_t max_us = 0;
+    uint64_t total_us = 0;
+    uint64_t window_us = 0;        ///< Part of total_us in the current window
+
+    [[nodiscard]] uint32_t avg_us() const noexcept {
+        return tasks ? static_cast<uint32_t>(total_us / tasks) : 0;
+    }
+};
+
+using draw_sample_cb = void (*)(const DrawSample& sample, void* user_data);
+
+namespace detail {
+
+/// A task handed to a threaded SW unit, captured so the task itself is never touched again
+struct DrawPending {
+    lv_obj_t* obj = nullptr;
+    const lv_obj_class_t* cls = nullptr;
+    lv_draw_task_type_t type = LV_DRAW_TASK_TYPE_NONE;
+    bool gradient = false;
+    bool active = false;
+    lv_area_t area{};
+    uint64_t start = 0;
+};
+
+struct DrawUnitHook {
+    lv_draw_sw_unit_t* unit = nullptr;
+    int32_t (*dispatch)(lv_draw_unit_t*, lv_layer_t*) = nullptr;   ///< LVGL's own callback
+    DrawPending pending;
+};
+
+struct DrawProfiler {
+    lv_display_t* disp = nullptr;         ///< nullptr: not running
+    lv_timer_t* timer = nullptr;
+    DrawUnitHook units[LV_CPP_DRAW_PROFILE_UNITS];
+    DrawCost costs[LV_CPP_DRAW_PROFILE_ENTRIES];
+    uint32_t evicted = 0;
+    DrawSample window;                    ///< Being collected
+    DrawSample last;                      ///< Last completed window
+    uint32_t window_start = 0;
+    draw_sample_cb cb = nullptr;
+    void* cb_user_data = nullptr;
+    lv_obj_t* overlay = nullptr;
+    DrawCost heat[LV_CPP_DRAW_PROFILE_ENTRIES];   ///< Per-object copy shown by the overlay
+    uint64_t heat_max_us = 0;
+};
+
+[[nodiscard]] inline DrawProfiler& draw_profiler() noexcept {
+    static DrawProfiler p;
+    return p;
+}
+
+[[nodiscard]] inline uint64_t draw_now_us() noexcept {
+    using namespace std::chrono;
+    return static_cast<uint64_t>(duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+#if LV_USE_OBSERVER
+[[nodiscard]] inline State<DrawSample>& draw_subject() noexcept {
+    static State<DrawSample> state;
+    return state;
+}
+#endif
+
+inline void copy_draw_name(DrawCost& c, lv_obj_t* obj) noexcept {
+    c.name[0] = '\0';
+#if LV_USE_OBJ_NAME
+    const char* n = lv_obj_get_name(obj);
+    if (!n) return;
+    uint32_t i = 0;
+    for (; n[i] && i + 1 < LV_CPP_DRAW_PROFILE_NAME; ++i) c.name[i] = n[i];
+    c.name[i] = '\0';
+#else
+    (void)obj;
+#endif
+}
+
+inline void record_draw(DrawProfiler& p, const DrawPending& t, uint64_t end) noexcept {
+    const uint64_t d = end - t.start;
+    const uint32_t us = d > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(d);
+
+    DrawSample& w = p.window;
+    ++w.tasks;
+    w.draw_us += us;
+    DrawTypeCost& tc = w.types[DrawSample::slot(t.type)];
+    ++tc.tasks;
+    tc.total_us += us;
+    if (us > tc.max_us) tc.max_us = us;
+    if (t.gradient) {
+        ++w.gradient_tasks;
+        w.gradient_us += us;
+    }
+    if (!t.obj) return;
+
+    DrawCost* slot = nullptr;
+    DrawCost* cheapest = nullptr;
+    for (DrawCost& c : p.costs) {
+        if (c.obj == t.obj && c.type == t.type && c.gradient == t.gradient) { slot = &c; break; }
+        if (!cheapest || !c.obj || (cheapest->obj && c.total_us < cheapest->total_us)) cheapest = &c;
+    }
+    if (!slot) {
+        if (cheapest->obj) {
+            ++p.evicted;
+            if (us <= cheapest->total_us) return;
+        }
+        slot = cheapest;
+        *slot = DrawCost{};
+        slot->obj = t.obj;
+        slot->cls = t.cls;
+        slot->type = t.type;
+        slot->gradient = t.gradient;
+        slot->area = t.area;
+        copy_draw_name(*slot, t.obj);
+    }
+    if (slot->window_us == 0) {
+        slot->area = t.area;
+    } else {
+        lv_area_join(&slot->area, &slot->area, &t.area);
+    }
+    ++slot->tasks;
+    slot->total_us += us;
+    slot->window_us += us;
+    if (us > slot->max_us) slot->max_us = us;
+}
+
+/// Finish the task a threaded unit was given once the unit is idle again
+inline void reap_draw(DrawProfiler& p, DrawUnitHook& h, bool force) noexcept {
+    if (!h.pending.active) return;
+    if (!force && h.unit->task_act) return;
+    h.pending.active = false;
+    record_draw(p, h.pending, draw_now_us());
+}
+
+[[nodiscard]] inline DrawPending capture_draw(lv_draw_task_t* t, uint64_t start) noexcept {
+    DrawPending c;
+    auto* base = static_cast<lv_draw_dsc_base_t*>(lv_draw_task_get_draw_dsc(t));
+    c.obj = base ? base->obj : nullptr;
+    c.cls = c.obj ? lv_obj_get_class(c.obj) : nullptr;
+    c.type = lv_draw_task_get_type(t);
+    if (c.type == LV_DRAW_TASK_TYPE_FILL) {
+        c.gradient = lv_draw_task_get_fill_dsc(t)->grad.dir != LV_GRAD_DIR_NONE;
+    }
+    c.area = t->area;
+    c.start = start;
+    c.active = true;
+    return c;
+}
+
+inline int32_t dispatch_cb(lv_draw_unit_t* u, lv_layer_t* layer) {
+    DrawProfiler& p = draw_profiler();
+    DrawUnitHook* h = nullptr;
+    for (DrawUnitHook& x : p.units) {
+        if (&x.unit->base_unit == u) { h = &x; break; }
+    }
+    if (!h) return LV_DRAW_UNIT_IDLE;
+    reap_draw(p, *h, false);
+    if (h->unit->task_act) return h->dispatch(u, layer);
+
+    // The SW unit takes the first available task; look it up the same way
+    lv_draw_task_t* t = lv_draw_get_available_task(layer, nullptr, DRAW_UNIT_ID_SW);
+    if (!t) return h->dispatch(u, layer);
+    const DrawPending task = capture_draw(t, draw_now_us());
+    const int32_t taken = h->dispatch(u, layer);
+    if (taken <= 0 || (task.obj && task.obj == p.overlay)) return taken;
+    if (h->unit->task_act) {
+        h->pending = task;    // rendering on the unit's thread
+    } else {
+        record_draw(p, task, draw_now_us());
+    }
+    return taken;
+}
+
+inline void draw_event_cb(lv_event_t* e) {
+    DrawProfiler& p = draw_profiler();
+    switch (lv_event_get_code(e)) {
+    case LV_EVENT_REFR_READY:
+        for (DrawUnitHook& h : p.units) {
+            if (h.unit) reap_draw(p, h, false);
+        }
+        ++p.window.refreshes;
+        break;
+    case LV_EVENT_DELETE:
+        p.overlay = nullptr;    // deleted with the display's layers
+        unhook_sw_units(p);
+        if (p.timer) lv_timer_delete(p.timer);
+        p.timer = nullptr;
+        p.disp = nullptr;
+        break;
+    default:
+        break;
+    }
+}
+
+/// Sum the window time of every key per object, for the overlay
+inline void build_heat(DrawProfiler& p) noexcept {
+    uint32_t n = 0;
+    p.heat_max_us = 0;
+    for (DrawCost& h : p.heat) h = DrawCost{};
+    for (const DrawCost& c : p.costs) {
+        if (!c.obj || !c.window_us) continue;
+        DrawCost* h = nullptr;
+        for (uint32_t i = 0; i < n; ++i) {
+            if (p.heat[i].obj == c.obj) { h = &p.heat[i]; break; }
+        }
+        if (!h) {
+            h = &p.heat[n++];
+            *h = c;
+            h->total_us = 0;
+        } else {
+            lv_area_join(&h->area, &h->area, &c.area);
+        }
+        h->total_us += c.window_us;
+        if (h->total_us > p.heat_max_us) p.heat_max_us = h->total_us;
+    }
+}
+
+inline void overlay_draw_cb(lv_event_t* e) {
+    const DrawProfiler& p = draw_profiler();
+    if (!p.heat_max_us) return;
+    lv_layer_t* layer = lv_event_get_layer(e);
+    for (const DrawCost& h : p.heat) {
+        if (!h.obj) continue;
+        const auto heat = static_cast<uint8_t>(h.total_us * 255 / p.heat_max_us);
+        lv_draw_rect_dsc_t rect;
+        lv_draw_rect_dsc_init(&rect);
+        rect.bg_color = lv_color_mix(lv_palette_main(LV_PALETTE_RED), lv_palette_main(LV_PALETTE_BLUE), heat);
+        rect.bg_opa = static_cast<lv_opa_t>(LV_OPA_10 + heat * (LV_OPA_60 - LV_OPA_10) / 255);
+        rect.border_color = rect.bg_color;
+        rect.border_opa = LV_OPA_COVER;
+        rect.border_width = 1;
+        lv_draw_rect(layer, &rect, &h.area);
+
+        lv_draw_label_dsc_t label;
+        lv_draw_label_dsc_init(&label);
+        char text[16];
+        std::snprintf(text, sizeof(text), "%u us", static_cast<unsigned>(h.total_us));
+        label.text = text;
+        label.text_local = 1;
+        label.color = lv_color_white();
+        lv_area_t at = h.area;
+        at.x1 += 2;
+        at.y1 += 1;
+        lv_draw_label(layer, &label, &at);
+    }
+}
+
+inline void window_timer_cb(lv_timer_t*) {
+    DrawProfiler& p = draw_profiler();
+    DrawSample s = p.window;
+    s.timestamp = lv_tick_get();
+    s.window_ms = lv_tick_elaps(p.window_start);
+    p.last = s;
+    p.window = DrawSample{};
+    p.window_start = s.timestamp;
+    if (p.overlay) {
+        build_heat(p);
+        lv_obj_invalidate(p.overlay);
+    }
+    for (DrawCost& c : p.costs) c.window_us = 0;
+#if LV_USE_OBSERVER
+    draw_subject().set(s);
+#endif
+    if (p.cb) p.cb(s, p.cb_user_data);
+}
+
+/// Wrap the dispatch callback of every "SW" draw unit
+inline void hook_sw_units(DrawProfiler& p) noexcept {
+    if (p.units[0].unit) return;    // already wrapped
+    uint32_t n = 0;
+    for (lv_draw_unit_t* u = LV_GLOBAL_DEFAULT()->draw_info.unit_head; u; u = u->next) {
+        if (!u->name || std::strcmp(u->name, "SW") != 0 || u->dispatch_cb == &dispatch_cb) continue;
+        if (n == LV_CPP_DRAW_PROFILE_UNITS) {
+            LV_LOG_WARN("draw profile: more SW units than LV_CPP_DRAW_PROFILE_UNITS");
+            break;
+        }
+        p.units[n++] = DrawUnitHook{reinterpret_cast<lv_draw_sw_unit_t*>(u), u->dispatch_cb, {}};
+        u->dispatch_cb = &dispatch_cb;
+    }
+}
+
+inline void unhook_sw_units(DrawProfiler& p) noexcept {
+    for (DrawUnitHook& h : p.units) {
+        if (h.unit) h.unit->base_unit.dispatch_cb = h.dispatch;
+        h = DrawUnitHook{};
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Handle to the draw profiler
+ *
+ * Cheap to copy; all state is static until stop(). Use it from the LVGL
+ * thread.
+ */
+class DrawProfile {
+    [[nodiscard]] static detail::DrawProfiler& p() noexcept { return detail::draw_profiler(); }
+
+public:
+    /// Profiling is running
+    [[nodiscard]] bool active() const noexcept { return p().disp != nullptr; }
+
+    /// Last completed window (all zero before the first one)
+    [[nodiscard]] const DrawSample& snapshot() const noexcept { return p().last; }
+
+    /// Called at the end of every window (nullptr to remove)
+    DrawProfile& on_window(draw_sample_cb cb, void* user_data = nullptr) noexcept {
+        p().cb = cb;
+        p().cb_user_data = user_data;
+        return *this;
+    }
+
+#if LV_USE_OBSERVER
+    /// State updated at the end of every window, for State observers and bindings
+    [[nodiscard]] State<DrawSample>& state() const noexcept { return detail::draw_subject(); }
+#endif
+
+    /**
+     * @brief Most expensive (object, task type) keys, unsorted
+     * @param count Receives the number of valid entries
+     */
+    [[nodiscard]] const DrawCost* costs(uint32_t& count) const noexcept {
+        count = 0;
+        for (const DrawCost& c : p().costs) count += c.obj != nullptr;
+        return p().costs;    // free entries have obj == nullptr
+    }
+
+    /// Most expensive key so far (nullptr if none)
+    [[nodiscard]] const DrawCost* top() const noexcept {
+        const DrawCost* top = nullptr;
+        for (const DrawCost& c : p().costs) {
+            if (c.obj && (!top || c.total_us > top->total_us)) top = &c;
+        }
+        return top;
+    }
+
+    /// Keys pushed out of (or refused by) the full table
+    [[nodiscard]] uint32_t evicted() const noexcept { return p().evicted; }
+
+    /// Log the last window per type and the key table (LV_LOG_USER)
+    void log_costs() const noexcept {
+        const DrawSample& s = p().last;
+        LV_LOG_USER("draw profile: %u tasks, %lu us in %u refreshes (gradient fills %lu us)",
+                    static_cast<unsigned>(s.tasks), static_cast<unsigned long>(s.draw_us),
+                    static_cast<unsigned>(s.refreshes), static_cast<unsigned long>(s.gradient_us));
+        for (uint32_t i = 0; i < kDrawTypeSlots; ++i) {
+            const DrawTypeCost& t = s.types[i];
+            if (!t.tasks) continue;
+            LV_LOG_USER("  %s: %u tasks, %lu us, max %u us",
+                        draw_task_type_name(static_cast<lv_draw_task_type_t>(i)), static_cast<unsigned>(t.tasks),
+                        static_cast<unsigned long>(t.total_us), static_cast<unsigned>(t.max_us));
+        }
+        for (const DrawCost& c : p().costs) {
+            if (!c.obj) continue;
+            LV_LOG_USER("  %p %s %s%s: %u tasks, %lu us, max %u us", static_cast<void*>(c.obj), c.name,
+                        draw_task_type_name(c.type), c.gradient ? " (gradient)" : "",
+                        static_cast<unsigned>(c.tasks), static_cast<unsigned long>(c.total_us),
+                        static_cast<unsigned>(c.max_us));
+        }
+    }
+
+    /// Clear the key table and the windows (profiling continues)
+    void reset() noexcept {
+        for (DrawCost& c : p().costs) c = DrawCost{};
+        for (DrawCost& h : p().heat) h = DrawCost{};
+        p().heat_max_us = 0;
+        p().evicted = 0;
+        p().window = DrawSample{};
+        p().last = DrawSample{};
+    }
+
+    /**
+     * @brief Show a heatmap of the last window on the system layer
+     *
+     * Every object drawn in the window gets a rectangle over the area its
+     * tasks covered, from blue (cheap) to red (the most expensive object),
+     * labelled with its render time in microseconds.
+     */
+    DrawProfile& show_overlay(bool show = true) noexcept {
+        detail::DrawProfiler& s = p();
+        if (!s.disp) return *this;
+        if (show && !s.overlay) {
+            s.overlay = lv_obj_create(lv_display_get_layer_sys(s.disp));
+            lv_obj_remove_style_all(s.overlay);
+            lv_obj_remove_flag(s.overlay, LV_OBJ_FLAG_CLICKABLE);
+            lv_obj_remove_flag(s.overlay, LV_OBJ_FLAG_SCROLLABLE);
+            lv_obj_set_size(s.overlay, LV_PCT(100), LV_PCT(100));
+            lv_obj_add_event_cb(s.overlay, &detail::overlay_draw_cb, LV_EVENT_DRAW_MAIN, nullptr);
+            detail::build_heat(s);
+        } else if (!show && s.overlay) {
+            lv_obj_delete(s.overlay);
+            s.overlay = nullptr;
+        }
+        return *this;
+    }
+
+    void hide_overlay() noexcept { show_overlay(false); }
+
+    /// Stop timing, restore the draw units and remove the overlay
+    void stop() noexcept {
+        detail::DrawProfiler& s = p();
+        if (!s.disp) return;
+        hide_overlay();
+        detail::unhook_sw_units(s);
+        if (s.timer) lv_timer_delete(s.timer);
+        lv_display_remove_event_cb_with_user_data(s.disp, &detail::draw_event_cb, nullptr);
+        s.timer = nullptr;
+        s.disp = nullptr;
+    }
+};
+
+/**
+ * @brief Start (or get) draw profiling
+ *
+ * Draw units are global, so one profiler times every display; `disp`
+ * carries the overlay and counts the refreshes of a window. Calling it
+ * again with another display re-targets them.
+ *
+ * @param disp Display (nullptr = default display)
+ * @param period_ms Window length
+ */
+inline DrawProfile draw_profile(lv_display_t* disp = nullptr, uint32_t period_ms = LV_CPP_DRAW_PROFILE_PERIOD) noexcept {
+    detail::DrawProfiler& p = detail::draw_profiler();
+    if (!disp) disp = lv_display_get_default();
+    if (!disp) return DrawProfile{};
+    if (p.disp != disp) {
+        if (p.disp) {
+            DrawProfile{}.hide_overlay();
+            lv_display_remove_event_cb_with_user_data(p.disp, &detail::draw_event_cb, nullptr);
+        }
+        lv_display_add_event_cb(disp, &detail::draw_event_cb, LV_EVENT_REFR_READY, nullptr);
+        lv_display_add_event_cb(disp, &detail::draw_event_cb, LV_EVENT_DELETE, nullptr);
+        p.disp = disp;
+    }
+    detail::hook_sw_units(p);
+    if (!p.timer) p.timer = lv_timer_create(&detail::window_timer_cb, period_ms, nullptr);
+    if (p.timer) lv_timer_set_period(p.timer, period_ms);
+    p.window_start = lv_tick_get();
+    return DrawProfile{};
+}
+
+} // namespace lv::perf
+
+#endif // LV_USE_DRAW_SW
@@ -0,0 +1,102 @@
+#pragma once
+
+/**
+ * @file fragment_page.hpp
+ * @brief Fragment classes as PageStack pages (opt-in)
+ *
+ * lv::FragmentPage runs an existing fragment class as a page of an
+ * lv::PageStack (core/page_stack.hpp). The fragment instance, and with it
+ * the state in its struct, lives as long as the FragmentPage; its objects
+ * are created when the page comes on top and deleted when the stack
+ * evicts or pops it, where a fragment stack keeps them all:
+ *
+ * @code
+ * #include <lv/others/fragment_page.hpp>
+ *
+ * lv::FragmentPage list(&list_fragment_class), detail(&detail_fragment_class, &args);
+ * lv::PageStack pages(container);
+ * pages.keep(0).push(list);
+ * pages.push(detail);            // list's objects are deleted, its instance kept
+ * pages.pop();                   // list_fragment_class.create_obj_cb runs again
+ * @endcode
+ *
+ * Not included by lv.hpp: it reads and clears lv_fragment_t::obj, which
+ * has no public accessor. Checked against LVGL 9.4 (see
+ * LV_CPP_INTERNALS_OK).
+ *
+ * Heap allocation: the fragment instance (lv_fragment_create())
+ */
+
+#include <lvgl.h>
+#include "../core/version.hpp"
+
+#if LV_USE_FRAGMENT
+
+#if !LV_CPP_INTERNALS_OK
+#error "fragment_page.hpp reads LVGL internals checked against LVGL 9.4; see LV_CPP_INTERNALS_OK"
+#endif
+
+#include <src/others/fragment/lv_fragment_private.h>   // lv_fragment_t::obj
+#include "../core/object.hpp"
+
+namespace lv {
+
+/**
+ * @brief An lv_fragment_class_t instance as a PageStack page
+ *
+ * Owns the fragment instance (created on construction, deleted on
+ * destruction). mount() creates its objects with lv_fragment_create_obj(),
+ * unmount() deletes them with lv_fragment_delete_obj(); the class's
+ * obj_created/obj_will_delete/obj_deleted callbacks run as under a
+ * fragment manager. The fragment must not be added to a manager as well.
+ *
+ * Non-movable: the objects' delete event points at it.
+ */
+class FragmentPage {
+    lv_fragment_t* m_frag = nullptr;
+
+    static void delete_cb(lv_event_t* e) noexcept {
+        // Deleted with its container: the instance stays, and must not delete the objects again
+        static_cast<FragmentPage*>(lv_event_get_user_data(e))->m_frag->obj = nullptr;
+    }
+
+public:
+    /// Create an instance of `cls` (its constructor_cb receives `args`)
+    explicit FragmentPage(const lv_fragment_class_t* cls, void* args = nullptr) noexcept
+        : m_frag(lv_fragment_create(cls, args)) {}
+
+    /// Take ownership of an unmanaged fragment instance
+    explicit FragmentPage(lv_fragment_t* frag) noexcept : m_frag(frag) {}
+
+    ~FragmentPage() {
+        unmount();
+        if (m_frag) lv_fragment_delete(m_frag);
+    }
+
+    FragmentPage(const FragmentPage&) = delete;
+    FragmentPage& operator=(const FragmentPage&) = delete;
+
+    /// Create the fragment's objects in `container`
+    void mount(ObjectView container) {
+        if (!m_frag) return;
+        unmount();
+        lv_obj_t* obj = lv_fragment_create_obj(m_frag, container.get());
+        if (obj) lv_obj_add_event_cb(obj, &FragmentPage::delete_cb, LV_EVENT_DELETE, this);
+    }
+
+    /// Delete the fragment's objects; the instance keeps its state
+    void unmount() {
+        if (!is_mounted()) return;
+        lv_obj_remove_event_cb_with_user_data(m_frag->obj, &FragmentPage::delete_cb, this);
+        lv_fragment_delete_obj(m_frag);
+        m_frag->obj = nullptr;
+    }
+
+    [[nodiscard]] bool is_mounted() const noexcept { return m_frag && m_frag->obj; }
+    [[nodiscard]] ObjectView root() const noexcept { return ObjectView(m_frag ? m_frag->obj : nullptr); }
+    [[nodiscard]] lv_fragment_t* get() const noexcept { return m_frag; }
+};
+
+} // namespace lv
+
+#endif // LV_USE_FRAGMENT
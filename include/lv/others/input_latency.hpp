@@ -0,0 +1,476 @@
+#pragma once
+
+/**
+ * @file input_latency.hpp
+ * @brief Input-to-flush latency measurement (indev read → flush ready)
+ *
+ * lv::perf::input_latency(indev) wraps the input device's read callback and
+ * hooks its display. Each read that produces an event (press, release,
+ * drag, key, encoder step) is timestamped. The first refresh that renders
+ * an invalidation made after that read carries the input, and the sample
+ * completes when that refresh's last flush is ready. Further reads before
+ * this happens are folded into the same sample (counted as "coalesced").
+ *
+ * Usage:
+ * @code
+ * #include <lv/others/input_latency.hpp>
+ *
+ * auto lat = lv::perf::input_latency(touch.get());
+ * lat.corner_marker();                       // for a photodiode on the top-left corner
+ * lat.on_marker([](bool level, void*) { gpio_write(PIN_SCOPE, level); });
+ * ...
+ * lv::perf::InputLatencyStats s = lat.stats();
+ * LV_LOG_USER("input->flush p50 %u us p99 %u us", s.p50_us, s.p99_us);
+ * @endcode
+ *
+ * For external validation the marker callback goes high when the input is
+ * read and low when its frame is flushed. The corner marker flips color in
+ * the first frame rendered after the input, so with a photodiode the edge
+ * shows the earliest possible photon for that input.
+ *
+ * Caveats:
+ * - Any invalidation after the input counts as its response, so a running
+ *   animation makes every sample about one refresh long.
+ * - Completion is detected from the display's flush state at the last
+ *   FLUSH_FINISH, FLUSH_WAIT_FINISH, REFR_START/READY and the next indev
+ *   read. With asynchronous flushing a sample can read late by up to
+ *   one indev read period.
+ * - Start tracking after the indev's read callback is set. Setting it
+ *   again replaces the wrapper.
+ *
+ * Not included by lv.hpp: completion is read from lv_display_t::flushing,
+ * which has no getter. Checked against LVGL 9.4 (see LV_CPP_INTERNALS_OK).
+ *
+ * Heap allocation: NONE (LV_CPP_INPUT_LATENCY_MAX fixed trackers)
+ */
+
+#include <lvgl.h>
+#include "../core/version.hpp"
+
+#if !LV_CPP_INTERNALS_OK
+#error "input_latency.hpp reads LVGL internals checked against LVGL 9.4; see LV_CPP_INTERNALS_OK"
+#endif
+
+#include <src/display/lv_display_private.h>   // flushing
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include "../core/indev.hpp"
+
+namespace lv::perf {
+
+#ifndef LV_CPP_INPUT_LATENCY_MAX
+/// Input devices that can be tracked at once
+#define LV_CPP_INPUT_LATENCY_MAX 2
+#endif
+
+#ifndef LV_CPP_INPUT_LATENCY_SAMPLES
+/// Latencies kept for the distribution (oldest are overwritten)
+#define LV_CPP_INPUT_LATENCY_SAMPLES 128
+#endif
+
+#ifndef LV_CPP_INPUT_LATENCY_TIMEOUT_MS
+/// An input with no invalidation within this time is dropped as unanswered
+#define LV_CPP_INPUT_LATENCY_TIMEOUT_MS 500
+#endif
+
+#ifndef LV_CPP_INPUT_LATENCY_MARKER_SIZE
+/// Side of the corner marker square in pixels
+#define LV_CPP_INPUT_LATENCY_MARKER_SIZE 16
+#endif
+
+/// Latency distribution over the kept samples (all times input read → flush ready)
+struct InputLatencyStats {
+    uint32_t count = 0;        ///< Samples measured since start/reset
+    uint32_t unanswered = 0;   ///< Inputs dropped without a redraw
+    uint32_t coalesced = 0;    ///< Reads folded into an already pending sample
+    uint32_t min_us = 0;
+    uint32_t max_us = 0;
+    uint32_t avg_us = 0;
+    uint32_t p50_us = 0;       ///< Percentiles over the last LV_CPP_INPUT_LATENCY_SAMPLES
+    uint32_t p90_us = 0;
+    uint32_t p99_us = 0;
+};
+
+using input_latency_cb = void (*)(uint32_t latency_us, void* user_data);
+
+/// Marker callback: level is true when the input is read, false when its frame is flushed
+using input_marker_cb = void (*)(bool level, void* user_data);
+
+namespace detail {
+
+struct LatencyTracker {
+    lv_indev_t* indev = nullptr;          ///< nullptr: free slot
+    lv_display_t* disp = nullptr;
+    lv_indev_read_cb_t read_cb = nullptr; ///< Wrapped driver callback
+    // Previous read, to tell event-producing reads apart
+    lv_indev_state_t last_state = LV_INDEV_STATE_RELEASED;
+    lv_point_t last_point = {0, 0};
+    uint32_t last_key = 0;
+    // Input waiting for its redraw
+    uint64_t input_us = 0;                ///< 0: none
+    bool responded = false;               ///< Something invalidated since input_us
+    // Frame carrying an input, waiting for its flush
+    uint64_t frame_input_us = 0;          ///< 0: none
+    bool rendered = false;                ///< Last area handed to flush_cb
+    // Results
+    uint32_t samples[LV_CPP_INPUT_LATENCY_SAMPLES] = {};
+    uint32_t count = 0;
+    uint32_t unanswered = 0;
+    uint32_t coalesced = 0;
+    uint32_t min_us = UINT32_MAX;
+    uint32_t max_us = 0;
+    uint64_t total_us = 0;
+    input_latency_cb cb = nullptr;
+    void* cb_user_data = nullptr;
+    input_marker_cb marker_cb = nullptr;
+    void* marker_user_data = nullptr;
+    lv_obj_t* marker = nullptr;
+    bool marker_level = false;
+    bool updating_marker = false;
+};
+
+[[nodiscard]] inline LatencyTracker* latency_trackers() noexcept {
+    static LatencyTracker trackers[LV_CPP_INPUT_LATENCY_MAX];
+    return trackers;
+}
+
+[[nodiscard]] inline LatencyTracker* find_latency_tracker(const lv_indev_t* indev) noexcept {
+    LatencyTracker* t = latency_trackers();
+    for (uint32_t i = 0; i < LV_CPP_INPUT_LATENCY_MAX; ++i) {
+        if (t[i].indev == indev) return &t[i];
+    }
+    return nullptr;
+}
+
+[[nodiscard]] inline uint64_t latency_now_us() noexcept {
+    using namespace std::chrono;
+    // +1 keeps 0 free as "no timestamp"
+    return static_cast<uint64_t>(duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count()) + 1;
+}
+
+inline void set_marker(LatencyTracker& t, bool level) {
+    if (t.marker_cb) t.marker_cb(level, t.marker_user_data);
+    if (!t.marker || !level) return;
+    // The corner flips at every input, so each new input is a visible edge
+    t.marker_level = !t.marker_level;
+    t.updating_marker = true;
+    lv_obj_set_style_bg_color(t.marker, t.marker_level ? lv_color_white() : lv_color_black(), 0);
+    t.updating_marker = false;
+}
+
+inline void complete_sample(LatencyTracker& t, uint64_t now) {
+    const uint64_t d = now - t.frame_input_us;
+    const uint32_t us = d > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(d);
+    t.frame_input_us = 0;
+    t.rendered = false;
+    t.samples[t.count % LV_CPP_INPUT_LATENCY_SAMPLES] = us;
+    ++t.count;
+    t.total_us += us;
+    if (us < t.min_us) t.min_us = us;
+    if (us > t.max_us) t.max_us = us;
+    set_marker(t, false);
+    if (t.cb) t.cb(us, t.cb_user_data);
+}
+
+/// Complete the in-flight frame if its last flush is done
+inline void poll_flush(LatencyTracker& t) {
+    if (t.frame_input_us && t.rendered && !t.disp->flushing) complete_sample(t, latency_now_us());
+}
+
+[[nodiscard]] inline bool input_expired(const LatencyTracker& t, uint64_t now) noexcept {
+    return t.input_us && !t.responded && now - t.input_us > LV_CPP_INPUT_LATENCY_TIMEOUT_MS * 1000ull;
+}
+
+[[nodiscard]] inline bool produces_event(const LatencyTracker& t, lv_indev_type_t type,
+                                         const lv_indev_data_t& d) noexcept {
+    if (d.state != t.last_state) return true;
+    switch (type) {
+    case LV_INDEV_TYPE_POINTER:
+        return d.state == LV_INDEV_STATE_PRESSED && (d.point.x != t.last_point.x || d.point.y != t.last_point.y);
+    case LV_INDEV_TYPE_KEYPAD:
+        return d.state == LV_INDEV_STATE_PRESSED && d.key != t.last_key;
+    case LV_INDEV_TYPE_ENCODER:
+        return d.enc_diff != 0;
+    default:
+        return false;
+    }
+}
+
+inline void latency_read_cb(lv_indev_t* indev, lv_indev_data_t* data) {
+    LatencyTracker* t = find_latency_tracker(indev);
+    if (!t) return;
+    if (t->read_cb) t->read_cb(indev, data);
+    poll_flush(*t);
+
+    const bool event = produces_event(*t, lv_indev_get_type(indev), *data);
+    t->last_state = data->state;
+    t->last_point = data->point;
+    t->last_key = data->key;
+    if (!event) return;
+
+    const uint64_t now = latency_now_us();
+    if (input_expired(*t, now)) {
+        ++t->unanswered;
+        t->input_us = 0;
+    }
+    if (t->input_us) {
+        ++t->coalesced;
+        return;
+    }
+    t->input_us = now;
+    t->responded = false;
+    set_marker(*t, true);
+}
+
+inline void latency_display_event(LatencyTracker& t, lv_event_code_t code) {
+    switch (code) {
+    case LV_EVENT_INVALIDATE_AREA:
+        if (t.input_us && !t.updating_marker) t.responded = true;
+        break;
+    case LV_EVENT_RENDER_START:
+        if (input_expired(t, latency_now_us())) {
+            ++t.unanswered;
+            t.input_us = 0;
+        }
+        // A previous frame still in flight keeps its sample; this input waits for the next one
+        if (t.input_us && t.responded && !t.frame_input_us) {
+            t.frame_input_us = t.input_us;
+            t.rendered = false;
+            t.input_us = 0;
+            t.responded = false;
+        }
+        break;
+    case LV_EVENT_FLUSH_FINISH:
+        if (t.frame_input_us && lv_display_flush_is_last(t.disp)) t.rendered = true;
+        poll_flush(t);
+        break;
+    case LV_EVENT_FLUSH_WAIT_FINISH:
+    case LV_EVENT_REFR_START:
+    case LV_EVENT_REFR_READY:
+        poll_flush(t);
+        break;
+    default:
+        break;
+    }
+}
+
+/// Give the driver callback back to the indev and free the slot
+inline void release_tracker(LatencyTracker& t) noexcept {
+    if (lv_indev_get_read_cb(t.indev) == &latency_read_cb) lv_indev_set_read_cb(t.indev, t.read_cb);
+    t = LatencyTracker{};
+}
+
+inline void latency_indev_delete_cb(lv_event_t* e);
+
+inline void latency_event_cb(lv_event_t* e) {
+    auto* disp = static_cast<lv_display_t*>(lv_event_get_current_target(e));
+    const lv_event_code_t code = lv_event_get_code(e);
+    LatencyTracker* trackers = latency_trackers();
+    for (uint32_t i = 0; i < LV_CPP_INPUT_LATENCY_MAX; ++i) {
+        LatencyTracker& t = trackers[i];
+        if (!t.indev || t.disp != disp) continue;
+        if (code == LV_EVENT_DELETE) {
+            // The marker goes with the display
+            lv_indev_remove_event_cb_with_user_data(t.indev, &latency_indev_delete_cb, nullptr);
+            release_tracker(t);
+        } else {
+            latency_display_event(t, code);
+        }
+    }
+}
+
+inline void delete_marker(LatencyTracker& t) noexcept {
+    if (t.marker) lv_obj_delete(t.marker);
+    t.marker = nullptr;
+}
+
+/**
+ * @brief Remove the marker, unhook the display (unless shared) and free the slot
+ * @param unhook_indev Also remove the indev DELETE hook (false while it is being dispatched)
+ */
+inline void stop_tracker(LatencyTracker& t, bool unhook_indev = true) {
+    delete_marker(t);
+    if (unhook_indev) lv_indev_remove_event_cb_with_user_data(t.indev, &latency_indev_delete_cb, nullptr);
+    bool display_shared = false;
+    LatencyTracker* trackers = latency_trackers();
+    for (uint32_t i = 0; i < LV_CPP_INPUT_LATENCY_MAX; ++i) {
+        if (&trackers[i] != &t && trackers[i].indev && trackers[i].disp == t.disp) display_shared = true;
+    }
+    if (!display_shared) lv_display_remove_event_cb_with_user_data(t.disp, &latency_event_cb, nullptr);
+    release_tracker(t);
+}
+
+/// The tracked input device is being deleted
+inline void latency_indev_delete_cb(lv_event_t* e) {
+    LatencyTracker* t = find_latency_tracker(static_cast<lv_indev_t*>(lv_event_get_current_target(e)));
+    if (t) stop_tracker(*t, false);
+}
+
+} // namespace detail
+
+/**
+ * @brief Handle to the input latency tracker of one input device
+ *
+ * Cheap to copy; all state lives in a static slot until stop().
+ */
+class InputLatency {
+    lv_indev_t* m_indev;
+
+    [[nodiscard]] detail::LatencyTracker* tracker() const noexcept {
+        return m_indev ? detail::find_latency_tracker(m_indev) : nullptr;
+    }
+
+public:
+    explicit constexpr InputLatency(lv_indev_t* indev) noexcept : m_indev(indev) {}
+
+    /// Tracking is active (false if all LV_CPP_INPUT_LATENCY_MAX slots were taken)
+    [[nodiscard]] bool active() const noexcept { return tracker() != nullptr; }
+
+    /// Distribution of the measured latencies
+    [[nodiscard]] InputLatencyStats stats() const noexcept {
+        InputLatencyStats s;
+        const detail::LatencyTracker* t = tracker();
+        if (!t) return s;
+        s.count = t->count;
+        s.unanswered = t->unanswered;
+        s.coalesced = t->coalesced;
+        if (t->count == 0) return s;
+        s.min_us = t->min_us;
+        s.max_us = t->max_us;
+        s.avg_us = static_cast<uint32_t>(t->total_us / t->count);
+        uint32_t sorted[LV_CPP_INPUT_LATENCY_SAMPLES];
+        const uint32_t n = t->count < LV_CPP_INPUT_LATENCY_SAMPLES ? t->count : LV_CPP_INPUT_LATENCY_SAMPLES;
+        std::copy(t->samples, t->samples + n, sorted);
+        std::sort(sorted, sorted + n);
+        // Nearest rank
+        s.p50_us = sorted[(n * 50 + 99) / 100 - 1];
+        s.p90_us = sorted[(n * 90 + 99) / 100 - 1];
+        s.p99_us = sorted[(n * 99 + 99) / 100 - 1];
+        return s;
+    }
+
+    /// Visit the kept latencies (us), oldest first
+    template<typename F>
+    void for_each_sample(F&& fn) const {
+        const detail::LatencyTracker* t = tracker();
+        if (!t) return;
+        const uint32_t n = t->count < LV_CPP_INPUT_LATENCY_SAMPLES ? t->count : LV_CPP_INPUT_LATENCY_SAMPLES;
+        for (uint32_t k = 0; k < n; ++k) fn(t->samples[(t->count - n + k) % LV_CPP_INPUT_LATENCY_SAMPLES]);
+    }
+
+    /// Called with every measured latency (nullptr to remove)
+    InputLatency& on_sample(input_latency_cb cb, void* user_data = nullptr) noexcept {
+        if (detail::LatencyTracker* t = tracker()) {
+            t->cb = cb;
+            t->cb_user_data = user_data;
+        }
+        return *this;
+    }
+
+    /// Called high at the input read, low at its flush; drive a GPIO from it (nullptr to remove)
+    InputLatency& on_marker(input_marker_cb cb, void* user_data = nullptr) noexcept {
+        if (detail::LatencyTracker* t = tracker()) {
+            t->marker_cb = cb;
+            t->marker_user_data = user_data;
+        }
+        return *this;
+    }
+
+    /// Square on the system layer's top-left corner that flips black/white at each input
+    InputLatency& corner_marker(bool show = true) noexcept {
+        detail::LatencyTracker* t = tracker();
+        if (!t) return *this;
+        if (!show) {
+            detail::delete_marker(*t);
+            return *this;
+        }
+        if (t->marker) return *this;
+        t->marker = lv_obj_create(lv_display_get_layer_sys(t->disp));
+        if (!t->marker) return *this;
+        lv_obj_remove_style_all(t->marker);
+        lv_obj_remove_flag(t->marker, LV_OBJ_FLAG_CLICKABLE);
+        lv_obj_add_flag(t->marker, LV_OBJ_FLAG_IGNORE_LAYOUT);
+        lv_obj_set_size(t->marker, LV_CPP_INPUT_LATENCY_MARKER_SIZE, LV_CPP_INPUT_LATENCY_MARKER_SIZE);
+        lv_obj_set_style_bg_opa(t->marker, LV_OPA_COVER, 0);
+        lv_obj_set_style_bg_color(t->marker, lv_color_black(), 0);
+        t->marker_level = false;
+        return *this;
+    }
+
+    /// Log the distribution (LV_LOG_USER)
+    void log() const noexcept {
+        const InputLatencyStats s = stats();
+        LV_LOG_USER("input->flush: %u samples, min %u avg %u p50 %u p90 %u p99 %u max %u us, "
+                    "%u unanswered, %u coalesced",
+                    static_cast<unsigned>(s.count), static_cast<unsigned>(s.min_us),
+                    static_cast<unsigned>(s.avg_us), static_cast<unsigned>(s.p50_us),
+                    static_cast<unsigned>(s.p90_us), static_cast<unsigned>(s.p99_us),
+                    static_cast<unsigned>(s.max_us), static_cast<unsigned>(s.unanswered),
+                    static_cast<unsigned>(s.coalesced));
+        (void)s;
+    }
+
+    /// Clear the samples (tracking continues)
+    void reset() noexcept {
+        detail::LatencyTracker* t = tracker();
+        if (!t) return;
+        t->count = 0;
+        t->unanswered = 0;
+        t->coalesced = 0;
+        t->min_us = UINT32_MAX;
+        t->max_us = 0;
+        t->total_us = 0;
+    }
+
+    /// Stop tracking: restore the read callback, remove the marker
+    void stop() noexcept {
+        if (detail::LatencyTracker* t = tracker()) detail::stop_tracker(*t);
+    }
+
+    [[nodiscard]] lv_indev_t* indev() const noexcept { return m_indev; }
+};
+
+/**
+ * @brief Start (or get) input latency tracking of an input device
+ * @param indev Input device with its read callback set (nullptr = first one)
+ * @param disp Display it drives (nullptr = the indev's display, else the default)
+ */
+inline InputLatency input_latency(lv_indev_t* indev = nullptr, lv_display_t* disp = nullptr) noexcept {
+    if (!indev) indev = lv_indev_get_next(nullptr);
+    if (!indev) return InputLatency(nullptr);
+    if (detail::find_latency_tracker(indev)) return InputLatency(indev);
+    if (!disp) disp = lv_indev_get_display(indev);
+    if (!disp) disp = lv_display_get_default();
+    if (!disp) return InputLatency(nullptr);
+    detail::LatencyTracker* t = detail::find_latency_tracker(nullptr);
+    if (!t) {
+        LV_LOG_WARN("input latency trackers exhausted, raise LV_CPP_INPUT_LATENCY_MAX");
+        return InputLatency(indev);
+    }
+    bool display_hooked = false;
+    detail::LatencyTracker* trackers = detail::latency_trackers();
+    for (uint32_t i = 0; i < LV_CPP_INPUT_LATENCY_MAX; ++i) {
+        if (trackers[i].indev && trackers[i].disp == disp) display_hooked = true;
+    }
+    t->indev = indev;
+    t->disp = disp;
+    t->read_cb = lv_indev_get_read_cb(indev);
+    lv_indev_set_read_cb(indev, &detail::latency_read_cb);
+    lv_indev_add_event_cb(indev, &detail::latency_indev_delete_cb, LV_EVENT_DELETE, nullptr);
+    if (!display_hooked) {
+        for (lv_event_code_t code : {LV_EVENT_INVALIDATE_AREA, LV_EVENT_RENDER_START, LV_EVENT_FLUSH_FINISH,
+                                     LV_EVENT_FLUSH_WAIT_FINISH, LV_EVENT_REFR_START, LV_EVENT_REFR_READY,
+                                     LV_EVENT_DELETE}) {
+            lv_display_add_event_cb(disp, &detail::latency_event_cb, code, nullptr);
+        }
+    }
+    return InputLatency(indev);
+}
+
+/// Start (or get) input latency tracking of a wrapped input device
+inline InputLatency input_latency(Indev& indev, lv_display_t* disp = nullptr) noexcept {
+    return input_latency(indev.get(), disp);
+}
+
+} // namespace lv::perf
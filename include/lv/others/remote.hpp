@@ -0,0 +1,595 @@
+#pragma once
+
+/**
+ * @file remote.hpp
+ * @brief Screen mirroring over a slow link: dirty rectangles, QOI-coded, with input back
+ *
+ * lv::remote::Mirror taps a display for remote support. At each flush it
+ * copies the areas LVGL actually redrew into a shadow frame (a memcpy of
+ * the redrawn rows) and merges them into at most LV_CPP_REMOTE_RECTS
+ * dirty rectangles. Everything else happens in a timer, outside the
+ * refresh: the rectangles are QOI-coded (runs, a 64-color cache and small
+ * deltas, so flat UI surfaces cost a few bytes per run) and handed to a
+ * non-blocking transport.
+ *
+ * @code
+ * #include <lv/others/remote.hpp>
+ *
+ * static lv::remote::Mirror mirror;
+ * mirror.start([](const void* data, uint32_t size, void* sock) -> int32_t {
+ *     const ssize_t n = send(*static_cast<int*>(sock), data, size, MSG_DONTWAIT);
+ *     if (n >= 0) return static_cast<int32_t>(n);
+ *     return errno == EAGAIN ? 0 : -1;                 // would block / link broken
+ * }, &sock);
+ * mirror.enable_input();
+ *
+ * // socket reader thread
+ * mirror.feed(buf, n);                                // pointer and key packets
+ * @endcode
+ *
+ * Backpressure: when the transport takes fewer bytes than offered, the rest
+ * waits and nothing new is coded. Later refreshes only grow the dirty
+ * rectangles, so intermediate frames are dropped and the viewer jumps to
+ * the current picture once the link drains. Memory use is fixed: the
+ * shadow frame plus LV_CPP_REMOTE_OUT_BYTES of output. A negative return
+ * from the transport (broken link) restarts the stream with a hello and a
+ * full frame at the next tick; resync() does the same for a new viewer.
+ *
+ * Stream (all integers little-endian). Every packet has an 8-byte header,
+ * {u8 type, u8 flags (0), u16 reserved, u32 body length}, then the body:
+ * - hello (1): u16 width, u16 height, u8 encoding (0 = QOI RGB). A full frame follows.
+ * - rect (2): u16 x, y, w, h, then QOI ops for w * h pixels, row by row,
+ *   without the .qoi header or end marker; the QOI state starts fresh in
+ *   every rect packet. Large rectangles come as several bands.
+ * - frame (3): u32 frame number, u32 frames dropped before it. Show the
+ *   picture now.
+ * - pointer (16, viewer to device): i16 x, i16 y, u8 pressed
+ * - key (17, viewer to device): u32 key (LV_KEY_* or a character), u8 pressed
+ *
+ * The mirror shows the rendered frame before any flush conversion or
+ * rotation done by the driver. RGB565, RGB888, XRGB8888 and ARGB8888
+ * displays are supported.
+ *
+ * Threading: start(), stop(), resync() and the timer on the LVGL thread;
+ * feed() from one other thread (the injected input goes through an
+ * IndevQueue).
+ *
+ * Not included by lv.hpp: the flush hook reads lv_display_t's active
+ * buffer, render mode, offsets and invalidated areas, which have no
+ * getters. Checked against LVGL 9.4 (see LV_CPP_INTERNALS_OK).
+ *
+ * Heap allocation: the shadow frame (DrawBufPool), the output buffer, the
+ * timer and, with enable_input(), two input devices
+ */
+
+#include <lvgl.h>
+#include "../core/version.hpp"
+
+#if !LV_CPP_INTERNALS_OK
+#error "remote.hpp reads LVGL internals checked against LVGL 9.4; see LV_CPP_INTERNALS_OK"
+#endif
+
+#include <src/display/lv_display_private.h>   // buf_act, render_mode, inv_areas, offset_x
+#include <cstdint>
+#include <cstring>
+#include "../core/indev_queue.hpp"
+#include "../core/qoi.hpp"
+#include "../draw/draw_buf.hpp"
+
+#ifndef LV_CPP_REMOTE_RECTS
+/// Dirty rectangles kept between two sent frames (more are merged)
+#define LV_CPP_REMOTE_RECTS 16
+#endif
+
+#ifndef LV_CPP_REMOTE_OUT_BYTES
+/// Output buffer; grown to hold at least one worst-case row of the display
+#define LV_CPP_REMOTE_OUT_BYTES 8192
+#endif
+
+#ifndef LV_CPP_REMOTE_TICK_BYTES
+/// Encoded bytes produced per timer tick at most (bounds the time spent per tick)
+#define LV_CPP_REMOTE_TICK_BYTES 32768
+#endif
+
+#ifndef LV_CPP_REMOTE_PERIOD_MS
+/// Period of the encode and send timer (it also runs right after each refresh)
+#define LV_CPP_REMOTE_PERIOD_MS 20
+#endif
+
+namespace lv::remote {
+
+/// Packet types of the stream
+enum class Packet : uint8_t {
+    hello = 1,
+    rect = 2,
+    frame = 3,
+    pointer = 16,
+    key = 17,
+};
+
+/// Packet header size in bytes
+inline constexpr uint32_t header_size = 8;
+
+/**
+ * @brief Non-blocking send of `size` bytes
+ * @return Bytes taken (0 when the link would block), negative when the link is broken
+ */
+using Transport = int32_t (*)(const void* data, uint32_t size, void* user);
+
+struct MirrorStats {
+    uint32_t frames = 0;      ///< Frame packets sent
+    uint32_t dropped = 0;     ///< Local refreshes merged into a later frame
+    uint32_t rects = 0;       ///< Rect packets sent
+    uint64_t pixels = 0;      ///< Pixels sent
+    uint64_t bytes = 0;       ///< Bytes taken by the transport
+    uint32_t stalls = 0;      ///< Ticks that found the transport full
+    uint32_t resyncs = 0;     ///< Streams restarted (start, resync(), broken link)
+    uint32_t inputs = 0;      ///< Pointer and key packets received
+    uint32_t bad_inputs = 0;  ///< Unknown or malformed packets skipped by feed()
+};
+
+/**
+ * @brief Display tap streaming dirty rectangles to a remote viewer
+ *
+ * Non-movable: the display events, the timer and the input queues point to it.
+ */
+class Mirror {
+    lv_display_t* m_disp = nullptr;
+    Transport m_send = nullptr;
+    void* m_user = nullptr;
+    lv_timer_t* m_timer = nullptr;
+    lv_draw_buf_t* m_shadow = nullptr;
+    uint32_t m_bpp = 0;
+
+    lv_area_t m_dirty[LV_CPP_REMOTE_RECTS] = {};    ///< Changed since the current frame was started
+    uint32_t m_dirty_count = 0;
+    uint32_t m_refreshes = 0;                       ///< Local refreshes not sent yet
+    bool m_refresh_dirty = false;                   ///< The running refresh changed the shadow
+
+    lv_area_t m_sending[LV_CPP_REMOTE_RECTS] = {};  ///< Frame being coded
+    uint32_t m_send_count = 0;
+    uint32_t m_send_index = 0;
+    int32_t m_send_row = 0;                         ///< Next row of m_sending[m_send_index]
+    bool m_frame_open = false;
+    bool m_hello = false;
+    uint32_t m_frame = 0;
+
+    uint8_t* m_out = nullptr;
+    uint32_t m_out_cap = 0;
+    uint32_t m_out_len = 0;
+    uint32_t m_out_sent = 0;
+
+    lv_indev_t* m_pointer = nullptr;
+    lv_indev_t* m_keypad = nullptr;
+    IndevQueue<16> m_pointer_queue;
+    IndevQueue<16> m_key_queue;
+    uint8_t m_in[header_size + 8] = {};
+    uint32_t m_in_len = 0;
+    uint32_t m_skip = 0;
+
+    MirrorStats m_stats;
+
+    /// Appends to the output buffer; used by the QOI encoder
+    struct Out {
+        Mirror& m;
+        void byte(uint8_t b) noexcept { m.m_out[m.m_out_len++] = b; }
+        void bytes(const void* p, uint32_t n) noexcept {
+            std::memcpy(m.m_out + m.m_out_len, p, n);
+            m.m_out_len += n;
+        }
+        void le16(uint32_t v) noexcept {
+            byte(static_cast<uint8_t>(v));
+            byte(static_cast<uint8_t>(v >> 8));
+        }
+        void le32(uint32_t v) noexcept {
+            le16(v & 0xFFFF);
+            le16(v >> 16);
+        }
+    };
+
+    /// Start a packet; returns the offset of its header for end_packet()
+    uint32_t begin_packet(Packet type) noexcept {
+        const uint32_t at = m_out_len;
+        Out out{*this};
+        out.byte(static_cast<uint8_t>(type));
+        out.byte(0);
+        out.le16(0);
+        out.le32(0);
+        return at;
+    }
+
+    void end_packet(uint32_t at) noexcept {
+        const uint32_t length = m_out_len - at - header_size;
+        for (uint32_t i = 0; i < 4; ++i) m_out[at + 4 + i] = static_cast<uint8_t>(length >> (8 * i));
+    }
+
+    [[nodiscard]] lv_area_t screen() const noexcept {
+        return {0, 0, static_cast<int32_t>(m_shadow->header.w) - 1, static_cast<int32_t>(m_shadow->header.h) - 1};
+    }
+
+    [[nodiscard]] static lv_area_t join(const lv_area_t& a, const lv_area_t& b) noexcept {
+        return {LV_MIN(a.x1, b.x1), LV_MIN(a.y1, b.y1), LV_MAX(a.x2, b.x2), LV_MAX(a.y2, b.y2)};
+    }
+
+    /// Merge `a` into the dirty rectangles (join when that does not grow the area)
+    void add_dirty(const lv_area_t& a) noexcept {
+        for (uint32_t i = 0; i < m_dirty_count; ++i) {
+            const lv_area_t joined = join(m_dirty[i], a);
+            if (lv_area_get_size(&joined) <= lv_area_get_size(&m_dirty[i]) + lv_area_get_size(&a)) {
+                m_dirty[i] = joined;
+                return;
+            }
+        }
+        if (m_dirty_count < LV_CPP_REMOTE_RECTS) {
+            m_dirty[m_dirty_count++] = a;
+            return;
+        }
+        // Full: join the rectangle that grows least
+        uint32_t best = 0;
+        uint64_t best_growth = UINT64_MAX;
+        for (uint32_t i = 0; i < m_dirty_count; ++i) {
+            const lv_area_t joined = join(m_dirty[i], a);
+            const uint64_t growth = lv_area_get_size(&joined) - lv_area_get_size(&m_dirty[i]);
+            if (growth < best_growth) {
+                best_growth = growth;
+                best = i;
+            }
+        }
+        m_dirty[best] = join(m_dirty[best], a);
+    }
+
+    /// Copy `area` (screen coordinates, inside the shadow) from the flushed buffer
+    void copy(const lv_area_t& area, const uint8_t* src, int32_t src_x, int32_t src_y, uint32_t src_stride) noexcept {
+        const uint32_t row_bytes = static_cast<uint32_t>(lv_area_get_width(&area)) * m_bpp;
+        for (int32_t y = area.y1; y <= area.y2; ++y) {
+            std::memcpy(m_shadow->data + static_cast<size_t>(y) * m_shadow->header.stride + area.x1 * m_bpp,
+                        src + static_cast<size_t>(y - src_y) * src_stride + (area.x1 - src_x) * m_bpp, row_bytes);
+        }
+        add_dirty(area);
+        m_refresh_dirty = true;
+    }
+
+    void on_flush(const lv_area_t& flushed) noexcept {
+        const lv_draw_buf_t* buf = m_disp->buf_act;
+        if (!buf || !buf->data) return;
+        lv_area_t area = flushed;
+        lv_area_move(&area, -m_disp->offset_x, -m_disp->offset_y);
+        // Partial buffers hold just the flushed area; direct and full ones the whole screen
+        const bool partial = m_disp->render_mode == LV_DISPLAY_RENDER_MODE_PARTIAL;
+        const int32_t src_x = partial ? area.x1 : 0;
+        const int32_t src_y = partial ? area.y1 : 0;
+        const lv_area_t bounds = screen();
+        if (!lv_area_intersect(&area, &area, &bounds)) return;
+        // Only the redrawn parts: a full-mode flush covers the screen but changed little
+        bool any = false;
+        for (uint32_t i = 0; i < m_disp->inv_p && i < LV_INV_BUF_SIZE; ++i) {
+            if (m_disp->inv_area_joined[i]) continue;
+            lv_area_t part;
+            if (lv_area_intersect(&part, &area, &m_disp->inv_areas[i])) {
+                copy(part, buf->data, src_x, src_y, buf->header.stride);
+                any = true;
+            }
+        }
+        if (!any && m_disp->inv_p == 0) copy(area, buf->data, src_x, src_y, buf->header.stride);
+    }
+
+    /// Convert shadow pixel `p` to R, G, B, 255
+    void rgb(const uint8_t* p, uint8_t px[4]) const noexcept {
+        if (m_bpp == 2) {
+            const uint32_t v = p[0] | p[1] << 8;
+            const uint32_t r = (v >> 11) & 0x1F, g = (v >> 5) & 0x3F, b = v & 0x1F;
+            px[0] = static_cast<uint8_t>(r << 3 | r >> 2);
+            px[1] = static_cast<uint8_t>(g << 2 | g >> 4);
+            px[2] = static_cast<uint8_t>(b << 3 | b >> 2);
+        } else {
+            px[0] = p[2];
+            px[1] = p[1];
+            px[2] = p[0];
+        }
+        px[3] = 255;
+    }
+
+    /// Output needed for one row of the current rectangle (QOI worst case: 4 bytes a pixel)
+    [[nodiscard]] uint32_t row_need() const noexcept {
+        return header_size + 8 + 4 * static_cast<uint32_t>(lv_area_get_width(&m_sending[m_send_index]));
+    }
+
+    /// Code the next band of the frame's current rectangle (at least row_need() bytes free)
+    void code_band() noexcept {
+        const lv_area_t& r = m_sending[m_send_index];
+        const uint32_t w = static_cast<uint32_t>(lv_area_get_width(&r));
+        const uint32_t fit = (m_out_cap - m_out_len - header_size - 8) / (w * 4);
+        const int32_t rows = LV_MIN(r.y2 - m_send_row + 1, static_cast<int32_t>(fit));
+        const uint32_t at = begin_packet(Packet::rect);
+        Out out{*this};
+        out.le16(static_cast<uint32_t>(r.x1));
+        out.le16(static_cast<uint32_t>(m_send_row));
+        out.le16(w);
+        out.le16(static_cast<uint32_t>(rows));
+        qoi::Encoder qoi_state;
+        for (int32_t y = m_send_row; y < m_send_row + rows; ++y) {
+            const uint8_t* p = m_shadow->data + static_cast<size_t>(y) * m_shadow->header.stride + r.x1 * m_bpp;
+            for (uint32_t x = 0; x < w; ++x, p += m_bpp) {
+                uint8_t px[4];
+                rgb(p, px);
+                qoi_state.pixel(out, px);
+            }
+        }
+        qoi_state.flush(out);
+        end_packet(at);
+        ++m_stats.rects;
+        m_stats.pixels += static_cast<uint64_t>(w) * rows;
+        m_send_row += rows;
+        if (m_send_row > r.y2 && ++m_send_index < m_send_count) m_send_row = m_sending[m_send_index].y1;
+    }
+
+    /**
+     * @brief Hand the pending output to the transport
+     * @return true when all of it was taken
+     */
+    bool drain() noexcept {
+        while (m_out_sent < m_out_len) {
+            const int32_t n = m_send(m_out + m_out_sent, m_out_len - m_out_sent, m_user);
+            if (n < 0) {
+                LV_LOG_WARN("remote: transport failed, restarting the stream");
+                resync();
+                return false;
+            }
+            if (n == 0) {
+                ++m_stats.stalls;
+                return false;
+            }
+            m_out_sent += static_cast<uint32_t>(n);
+            m_stats.bytes += static_cast<uint32_t>(n);
+        }
+        m_out_len = 0;
+        m_out_sent = 0;
+        return true;
+    }
+
+    /// Send what is pending, then code until the budget is spent or the frame is out
+    void pump() noexcept {
+        uint32_t budget = LV_CPP_REMOTE_TICK_BYTES;
+        while (drain() && budget) {
+            if (!m_frame_open) {
+                if (m_hello) {
+                    const uint32_t at = begin_packet(Packet::hello);
+                    Out out{*this};
+                    out.le16(m_shadow->header.w);
+                    out.le16(m_shadow->header.h);
+                    out.byte(0);
+                    end_packet(at);
+                    m_hello = false;
+                    continue;
+                }
+                if (m_dirty_count == 0) return;
+                std::memcpy(m_sending, m_dirty, sizeof(lv_area_t) * m_dirty_count);
+                m_send_count = m_dirty_count;
+                m_send_index = 0;
+                m_send_row = m_sending[0].y1;
+                m_dirty_count = 0;
+                m_frame_open = true;
+            }
+            // Several packets go out per transport call
+            while (m_send_index < m_send_count && m_out_cap - m_out_len >= row_need()) {
+                const uint32_t before = m_out_len;
+                code_band();
+                const uint32_t produced = m_out_len - before;
+                budget = produced < budget ? budget - produced : 0;
+                if (!budget) break;
+            }
+            if (m_send_index == m_send_count && m_out_cap - m_out_len >= header_size + 8) {
+                const uint32_t dropped = m_refreshes > 1 ? m_refreshes - 1 : 0;
+                const uint32_t at = begin_packet(Packet::frame);
+                Out out{*this};
+                out.le32(++m_frame);
+                out.le32(dropped);
+                end_packet(at);
+                ++m_stats.frames;
+                m_stats.dropped += dropped;
+                m_refreshes = 0;
+                m_frame_open = false;
+            }
+        }
+    }
+
+    void handle_input(uint8_t type, const uint8_t* body, uint32_t length) noexcept {
+        if (type == static_cast<uint8_t>(Packet::pointer) && length >= 5) {
+            const auto x = static_cast<int16_t>(body[0] | body[1] << 8);
+            const auto y = static_cast<int16_t>(body[2] | body[3] << 8);
+            m_pointer_queue.push_point(x, y, body[4] != 0);
+        } else if (type == static_cast<uint8_t>(Packet::key) && length >= 5) {
+            const uint32_t key = body[0] | body[1] << 8 | body[2] << 16 | static_cast<uint32_t>(body[3]) << 24;
+            m_key_queue.push_key(key, body[4] != 0);
+        } else {
+            ++m_stats.bad_inputs;
+            return;
+        }
+        ++m_stats.inputs;
+    }
+
+    static void flush_start_cb(lv_event_t* e) noexcept {
+        auto* m = static_cast<Mirror*>(lv_event_get_user_data(e));
+        if (const auto* area = static_cast<const lv_area_t*>(lv_event_get_param(e))) m->on_flush(*area);
+    }
+
+    static void refr_ready_cb(lv_event_t* e) noexcept {
+        auto* m = static_cast<Mirror*>(lv_event_get_user_data(e));
+        if (!m->m_refresh_dirty) return;
+        m->m_refresh_dirty = false;
+        ++m->m_refreshes;
+        lv_timer_ready(m->m_timer);
+    }
+
+    static void delete_cb(lv_event_t* e) noexcept {
+        static_cast<Mirror*>(lv_event_get_user_data(e))->stop();
+    }
+
+    static void timer_cb(lv_timer_t* t) noexcept {
+        static_cast<Mirror*>(lv_timer_get_user_data(t))->pump();
+    }
+
+public:
+    Mirror() noexcept = default;
+
+    ~Mirror() {
+        stop();
+        destroy_input();
+    }
+
+    Mirror(const Mirror&) = delete;
+    Mirror& operator=(const Mirror&) = delete;
+
+    /**
+     * @brief Mirror `disp` (nullptr: the default display) through `send`
+     * @return false if the display's color format is not supported or out of memory
+     */
+    bool start(Transport send, void* user = nullptr, lv_display_t* disp = nullptr) noexcept {
+        stop();
+        if (!disp) disp = lv_display_get_default();
+        if (!disp || !send) return false;
+        const lv_color_format_t cf = lv_display_get_color_format(disp);
+        if (cf != LV_COLOR_FORMAT_RGB565 && cf != LV_COLOR_FORMAT_RGB888 && cf != LV_COLOR_FORMAT_XRGB8888 &&
+            cf != LV_COLOR_FORMAT_ARGB8888) {
+            LV_LOG_WARN("remote: color format %d not supported", static_cast<int>(cf));
+            return false;
+        }
+        const uint32_t w = static_cast<uint32_t>(lv_display_get_horizontal_resolution(disp));
+        const uint32_t h = static_cast<uint32_t>(lv_display_get_vertical_resolution(disp));
+        m_shadow = lv_draw_buf_create_ex(draw::pool_handlers(), w, h, cf, LV_STRIDE_AUTO);
+        m_out_cap = LV_MAX(static_cast<uint32_t>(LV_CPP_REMOTE_OUT_BYTES), header_size + 8 + 4 * w);
+        m_out = static_cast<uint8_t*>(lv_malloc(m_out_cap));
+        if (!m_shadow || !m_out) {
+            stop();
+            return false;
+        }
+        lv_draw_buf_clear(m_shadow, nullptr);
+        m_bpp = lv_color_format_get_size(cf);
+        m_disp = disp;
+        m_send = send;
+        m_user = user;
+        lv_display_add_event_cb(disp, &Mirror::flush_start_cb, LV_EVENT_FLUSH_START, this);
+        lv_display_add_event_cb(disp, &Mirror::refr_ready_cb, LV_EVENT_REFR_READY, this);
+        lv_display_add_event_cb(disp, &Mirror::delete_cb, LV_EVENT_DELETE, this);
+        m_timer = lv_timer_create(&Mirror::timer_cb, LV_CPP_REMOTE_PERIOD_MS, this);
+        resync();
+        // The shadow starts empty: take the whole screen with the next refresh
+        lv_obj_invalidate(lv_display_get_screen_active(disp));
+        return true;
+    }
+
+    /// Stop mirroring and free the buffers (the input devices stay until destruction)
+    void stop() noexcept {
+        if (m_timer) lv_timer_delete(m_timer);
+        m_timer = nullptr;
+        if (m_disp) {
+            lv_display_remove_event_cb_with_user_data(m_disp, &Mirror::flush_start_cb, this);
+            lv_display_remove_event_cb_with_user_data(m_disp, &Mirror::refr_ready_cb, this);
+            lv_display_remove_event_cb_with_user_data(m_disp, &Mirror::delete_cb, this);
+        }
+        m_disp = nullptr;
+        if (m_shadow) lv_draw_buf_destroy(m_shadow);
+        m_shadow = nullptr;
+        lv_free(m_out);
+        m_out = nullptr;
+        m_out_len = m_out_sent = 0;
+        m_dirty_count = 0;
+        m_frame_open = false;
+        m_send = nullptr;
+    }
+
+    [[nodiscard]] bool is_active() const noexcept { return m_disp != nullptr; }
+
+    /// Restart the stream: hello and the whole screen at the next tick (e.g. a new viewer connected)
+    void resync() noexcept {
+        if (!m_shadow) return;
+        m_out_len = m_out_sent = 0;
+        m_frame_open = false;
+        m_dirty[0] = screen();
+        m_dirty_count = 1;
+        m_hello = true;
+        ++m_stats.resyncs;
+    }
+
+    // ==================== Input ====================
+
+    /**
+     * @brief Create a pointer and a keypad input device fed by feed() and inject_*()
+     *
+     * Add keypad_indev() to a group to route keys. Call on the LVGL thread.
+     */
+    Mirror& enable_input() noexcept {
+        if (m_pointer) return *this;
+        m_pointer = lv_indev_create();
+        lv_indev_set_type(m_pointer, LV_INDEV_TYPE_POINTER);
+        m_keypad = lv_indev_create();
+        lv_indev_set_type(m_keypad, LV_INDEV_TYPE_KEYPAD);
+        if (m_disp) {
+            lv_indev_set_display(m_pointer, m_disp);
+            lv_indev_set_display(m_keypad, m_disp);
+        }
+        m_pointer_queue.attach(m_pointer);
+        m_key_queue.attach(m_keypad);
+        return *this;
+    }
+
+    [[nodiscard]] lv_indev_t* pointer_indev() const noexcept { return m_pointer; }
+    [[nodiscard]] lv_indev_t* keypad_indev() const noexcept { return m_keypad; }
+
+    /// Delete the input devices (done on destruction)
+    void destroy_input() noexcept {
+        m_pointer_queue.detach();
+        m_key_queue.detach();
+        if (m_pointer) lv_indev_delete(m_pointer);
+        if (m_keypad) lv_indev_delete(m_keypad);
+        m_pointer = m_keypad = nullptr;
+    }
+
+    /**
+     * @brief Parse pointer and key packets from the viewer (any chunking)
+     *
+     * Other packet types are skipped. Call from one thread only.
+     */
+    void feed(const void* data, uint32_t size) noexcept {
+        const auto* p = static_cast<const uint8_t*>(data);
+        while (size) {
+            if (m_skip) {
+                const uint32_t n = LV_MIN(m_skip, size);
+                m_skip -= n;
+                p += n;
+                size -= n;
+                continue;
+            }
+            m_in[m_in_len++] = *p++;
+            --size;
+            if (m_in_len < header_size) continue;
+            const uint32_t length = m_in[4] | m_in[5] << 8 | m_in[6] << 16 | static_cast<uint32_t>(m_in[7]) << 24;
+            if (length > sizeof(m_in) - header_size) {
+                ++m_stats.bad_inputs;
+                m_skip = length;
+                m_in_len = 0;
+                continue;
+            }
+            if (m_in_len < header_size + length) continue;
+            handle_input(m_in[0], m_in + header_size, length);
+            m_in_len = 0;
+        }
+    }
+
+    /// Inject a pointer sample directly (screen coordinates)
+    bool inject_pointer(int32_t x, int32_t y, bool pressed) noexcept { return m_pointer_queue.push_point(x, y, pressed); }
+
+    /// Inject a key press or release directly
+    bool inject_key(uint32_t key, bool pressed) noexcept { return m_key_queue.push_key(key, pressed); }
+
+    // ==================== Statistics ====================
+
+    /// Dirty rectangles waiting for the next frame
+    [[nodiscard]] uint32_t pending_rects() const noexcept { return m_dirty_count; }
+
+    [[nodiscard]] const MirrorStats& stats() const noexcept { return m_stats; }
+
+    void reset_stats() noexcept { m_stats = {}; }
+};
+
+} // namespace lv::remote
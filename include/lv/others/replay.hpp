@@ -0,0 +1,607 @@
+#pragma once
+
+/**
+ * @file replay.hpp
+ * @brief Record input and external data on a device, replay it headless in virtual time
+ *
+ * A slowdown seen in the field depends on what the user touched and what
+ * the sensors said at the time, and is gone by the time someone looks.
+ * lv::replay records both: every input device read that changed something
+ * and every value routed through replay::set() / replay::input(), each
+ * with its time since the start. play() feeds the recording back through
+ * an lv::Bench on a headless display, one record at a time at its
+ * recorded tick, and measures every frame. Each frame's flushed pixels
+ * are hashed, so a baseline run catches both rendering changes and
+ * frame-time regressions:
+ *
+ * @code
+ * // On the device (or during a soak run that showed the problem)
+ * lv::replay::bind(0, speed);                          // same ids in the replaying build
+ * lv::replay::start_recording();                       // wraps the read callback of every indev
+ * ...  lv::replay::set(speed, read_speed());           // from the sensor timer
+ * lv::replay::stop_recording();
+ * lv::replay::save("/data/trip.lvrp");
+ *
+ * // In CI
+ * static lv::MemoryDisplay<800, 480> display;
+ * static lv::Bench bench(display);
+ * lv::replay::bind(0, speed);
+ * build_ui();
+ * lv::replay::load("trip.lvrp");
+ * lv::replay::PlayConfig cfg;
+ * cfg.baseline = "trip.baseline";                      // written with cfg.save_baseline on a good build
+ * return lv::replay::play(bench, cfg).passed() ? 0 : 1;
+ * @endcode
+ *
+ * Recording keeps LV_CPP_REPLAY_RECORDS 16-byte records in RAM (later ones
+ * are dropped and counted). While playing, bound states take their values
+ * from the recording only: set() from application timers is ignored and
+ * input() returns the recorded value, so the run does not depend on
+ * hardware. States changed by the UI itself need no binding; the input
+ * stream reproduces them. The recording stores the display size, and the
+ * replaying build needs the same UI, fonts and theme for identical hashes.
+ *
+ * Frame times are wall-clock and compared by median (PlayConfig::
+ * regression_pct); pixel hashes must match exactly.
+ *
+ * Heap allocation: NONE (fixed record and frame tables; play() creates
+ * one indev per recorded input device)
+ */
+
+#include <lvgl.h>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+#include "bench.hpp"
+#include "../core/state.hpp"
+
+#ifndef LV_CPP_REPLAY_RECORDS
+/// Records kept by a recording (16 bytes each)
+#define LV_CPP_REPLAY_RECORDS 8192
+#endif
+
+#ifndef LV_CPP_REPLAY_FRAMES
+/// Frames whose hash and time play() keeps for the baseline
+#define LV_CPP_REPLAY_FRAMES 4096
+#endif
+
+#ifndef LV_CPP_REPLAY_INDEVS
+/// Input devices recorded (up to 8)
+#define LV_CPP_REPLAY_INDEVS 4
+#endif
+
+#ifndef LV_CPP_REPLAY_CHANNELS
+/// State / input() channel ids
+#define LV_CPP_REPLAY_CHANNELS 16
+#endif
+
+static_assert(LV_CPP_REPLAY_INDEVS <= 8, "a recording stores up to 8 input devices");
+
+namespace lv::replay {
+
+enum class Kind : uint8_t {
+    input,      ///< An input device read: channel = device, a/b = point, key, diff or button
+    value,      ///< A bound state or input() value: channel = id, a/b = its bytes
+};
+
+struct Record {
+    uint32_t t_ms = 0;         ///< Since the start of the recording
+    Kind kind = Kind::input;
+    uint8_t channel = 0;
+    uint16_t state = 0;        ///< lv_indev_state_t of input records
+    int32_t a = 0;
+    int32_t b = 0;
+};
+
+static_assert(sizeof(Record) == 16, "replay records are written as 16 bytes");
+
+struct Stats {
+    uint32_t records = 0;      ///< Records held
+    uint32_t dropped = 0;      ///< Records lost to a full table
+    uint32_t duration_ms = 0;  ///< Length of the recording
+    uint32_t indevs = 0;       ///< Input devices recorded
+};
+
+struct PlayConfig {
+    uint32_t frames = 0;                     ///< Frames to run (0: to the last record, then settle_frames)
+    uint32_t settle_frames = 30;
+    uint32_t step_ms = LV_DEF_REFR_PERIOD;   ///< Virtual time per frame
+    const char* baseline = nullptr;          ///< Baseline to compare with
+    const char* save_baseline = nullptr;     ///< Write this run as a baseline
+    const char* report = nullptr;            ///< JSON report path (nullptr: stdout)
+    uint32_t regression_pct = 20;            ///< Median frame time growth that fails the run
+    lv_display_t* display = nullptr;         ///< Display to hash (nullptr: default)
+};
+
+struct Result {
+    uint32_t frames = 0;
+    uint32_t applied = 0;                    ///< Records played
+    uint64_t hash = 0;                       ///< Hash of all frame hashes
+    uint32_t frame_p50_us = 0;
+    uint32_t frame_p99_us = 0;
+    bool compared = false;                   ///< A baseline was read
+    uint32_t mismatched = 0;                 ///< Frames whose pixels differ from the baseline
+    uint32_t first_mismatch = UINT32_MAX;
+    uint32_t base_p50_us = 0;
+    uint32_t base_p99_us = 0;
+    bool regression = false;
+
+    [[nodiscard]] bool passed() const noexcept { return !mismatched && !regression; }
+};
+
+namespace detail {
+
+enum class Mode : uint8_t { off, recording, playing };
+
+struct Header {
+    char magic[4] = {'L', 'V', 'R', 'P'};
+    uint16_t version = 1;
+    uint16_t indevs = 0;
+    int32_t hor_res = 0;
+    int32_t ver_res = 0;
+    uint8_t types[8] = {};                   ///< lv_indev_type_t per input channel
+    uint32_t count = 0;
+    uint32_t duration_ms = 0;
+};
+
+struct Input {
+    lv_indev_t* indev = nullptr;
+    lv_indev_read_cb_t read_cb = nullptr;    ///< Driver callback while recording
+    Record last;                             ///< Last recorded (recording) or current (playing) read
+};
+
+struct Channel {
+    void* state = nullptr;                   ///< Bound State<T> (nullptr: input() only)
+    void (*apply)(void* state, int64_t raw) = nullptr;
+    int64_t value = 0;                       ///< Last recorded or played raw value
+    bool seen = false;
+};
+
+struct Frame {
+    uint64_t hash = 0;
+    uint32_t us = 0;
+    uint32_t reserved = 0;
+};
+
+struct Session {
+    Mode mode = Mode::off;
+    Header header;
+    Record records[LV_CPP_REPLAY_RECORDS];
+    uint32_t dropped = 0;
+    uint32_t start = 0;
+    Input inputs[LV_CPP_REPLAY_INDEVS];
+    Channel channels[LV_CPP_REPLAY_CHANNELS];
+    Frame frames[LV_CPP_REPLAY_FRAMES];
+    uint32_t frame_count = 0;
+    uint64_t frame_hash = 0;                 ///< Of the frame being played
+};
+
+[[nodiscard]] inline Session& session() noexcept {
+    static Session s;
+    return s;
+}
+
+inline void push(Session& s, const Record& r) noexcept {
+    if (s.header.count == LV_CPP_REPLAY_RECORDS) {
+        ++s.dropped;
+        return;
+    }
+    s.records[s.header.count++] = r;
+    s.header.duration_ms = r.t_ms;
+}
+
+template<typename T>
+[[nodiscard]] int64_t to_raw(const T& v) noexcept {
+    static_assert(std::is_trivially_copyable_v<T> && sizeof(T) <= sizeof(int64_t),
+                  "replayed values must be trivially copyable and at most 8 bytes");
+    int64_t raw = 0;
+    std::memcpy(&raw, &v, sizeof(T));
+    return raw;
+}
+
+template<typename T>
+[[nodiscard]] T from_raw(int64_t raw) noexcept {
+    T v;
+    std::memcpy(&v, &raw, sizeof(T));
+    return v;
+}
+
+template<typename T>
+void apply_state(void* state, int64_t raw) noexcept {
+    static_cast<State<T>*>(state)->set(from_raw<T>(raw));
+}
+
+/// Record `raw` on channel `id` if it changed
+inline void note_value(uint8_t id, int64_t raw) noexcept {
+    Session& s = session();
+    if (id >= LV_CPP_REPLAY_CHANNELS || s.mode != Mode::recording) return;
+    Channel& c = s.channels[id];
+    if (c.seen && c.value == raw) return;
+    c.value = raw;
+    c.seen = true;
+    push(s, Record{lv_tick_elaps(s.start), Kind::value, id, 0, static_cast<int32_t>(raw),
+                   static_cast<int32_t>(static_cast<uint64_t>(raw) >> 32)});
+}
+
+/// A read as a record: state plus the fields of the device's type
+[[nodiscard]] inline Record capture(lv_indev_type_t type, const lv_indev_data_t& d) noexcept {
+    Record r;
+    r.state = static_cast<uint16_t>(d.state);
+    switch (type) {
+    case LV_INDEV_TYPE_POINTER:
+        r.a = d.point.x;
+        r.b = d.point.y;
+        break;
+    case LV_INDEV_TYPE_KEYPAD:
+        r.a = static_cast<int32_t>(d.key);
+        break;
+    case LV_INDEV_TYPE_ENCODER:
+        r.a = d.enc_diff;
+        break;
+    case LV_INDEV_TYPE_BUTTON:
+        r.a = static_cast<int32_t>(d.btn_id);
+        break;
+    default:
+        break;
+    }
+    return r;
+}
+
+inline void record_read_cb(lv_indev_t* indev, lv_indev_data_t* data) noexcept {
+    Session& s = session();
+    for (uint8_t i = 0; i < s.header.indevs; ++i) {
+        Input& in = s.inputs[i];
+        if (in.indev != indev) continue;
+        in.read_cb(indev, data);
+        Record r = capture(lv_indev_get_type(indev), *data);
+        const bool diff = lv_indev_get_type(indev) == LV_INDEV_TYPE_ENCODER && r.a != 0;
+        if (!diff && r.state == in.last.state && r.a == in.last.a && r.b == in.last.b) return;
+        r.t_ms = lv_tick_elaps(s.start);
+        r.kind = Kind::input;
+        r.channel = i;
+        in.last = r;
+        push(s, r);
+        return;
+    }
+}
+
+inline void play_read_cb(lv_indev_t* indev, lv_indev_data_t* data) noexcept {
+    auto* in = static_cast<Input*>(lv_indev_get_user_data(indev));
+    Record& r = in->last;
+    data->state = static_cast<lv_indev_state_t>(r.state);
+    switch (lv_indev_get_type(indev)) {
+    case LV_INDEV_TYPE_POINTER:
+        data->point = {r.a, r.b};
+        break;
+    case LV_INDEV_TYPE_KEYPAD:
+        data->key = static_cast<uint32_t>(r.a);
+        break;
+    case LV_INDEV_TYPE_ENCODER:
+        data->enc_diff = static_cast<int16_t>(r.a);
+        r.a = 0;                             // a diff is consumed by one read
+        break;
+    case LV_INDEV_TYPE_BUTTON:
+        data->btn_id = static_cast<uint32_t>(r.a);
+        break;
+    default:
+        break;
+    }
+}
+
+/// FNV-1a over the rows of each flushed area, folded into the frame's hash
+inline void flush_cb(lv_event_t* e) noexcept {
+    Session& s = session();
+    auto* disp = static_cast<lv_display_t*>(lv_event_get_current_target(e));
+    const auto* area = static_cast<const lv_area_t*>(lv_event_get_param(e));
+    lv_draw_buf_t* buf = lv_display_get_buf_active(disp);
+    if (!area || !buf || !buf->data) return;
+    const auto cf = lv_display_get_color_format(disp);
+    const uint32_t px = lv_color_format_get_size(cf);
+    const auto w = static_cast<uint32_t>(lv_area_get_width(area));
+    const bool partial = lv_display_get_render_mode(disp) == LV_DISPLAY_RENDER_MODE_PARTIAL;
+    const uint32_t stride = partial ? lv_draw_buf_width_to_stride(w, cf) : buf->header.stride;
+    uint64_t h = s.frame_hash ^ 1469598103934665603ull;
+    for (int32_t c : {area->x1, area->y1, area->x2, area->y2}) h = (h ^ static_cast<uint32_t>(c)) * 1099511628211ull;
+    for (int32_t y = 0; y < lv_area_get_height(area); ++y) {
+        const uint8_t* row = partial ? buf->data + static_cast<uint32_t>(y) * stride
+                                     : buf->data + static_cast<uint32_t>(area->y1 + y) * stride +
+                                           static_cast<uint32_t>(area->x1) * px;
+        for (uint32_t i = 0; i < w * px; ++i) h = (h ^ row[i]) * 1099511628211ull;
+    }
+    s.frame_hash = h;
+}
+
+/// Compare the played frames with a baseline file
+inline void compare(const Session& s, const PlayConfig& cfg, Result& r) noexcept {
+    FILE* in = std::fopen(cfg.baseline, "rb");
+    if (!in) {
+        LV_LOG_WARN("replay: cannot read baseline %s", cfg.baseline);
+        return;
+    }
+    char magic[4] = {};
+    uint32_t n = 0;
+    if (std::fread(magic, 1, 4, in) != 4 || std::memcmp(magic, "LVRB", 4) != 0 ||
+        std::fread(&n, sizeof(n), 1, in) != 1) {
+        LV_LOG_WARN("replay: %s is not a baseline", cfg.baseline);
+        std::fclose(in);
+        return;
+    }
+    static BenchSamples<LV_CPP_REPLAY_FRAMES> base;
+    base.clear();
+    Frame f;
+    for (uint32_t i = 0; i < n && std::fread(&f, sizeof(f), 1, in) == 1; ++i) {
+        base.add(f.us);
+        if (i >= s.frame_count) continue;
+        if (f.hash != s.frames[i].hash) {
+            if (!r.mismatched) r.first_mismatch = i;
+            ++r.mismatched;
+        }
+    }
+    std::fclose(in);
+    if (n != s.frame_count) {
+        r.mismatched += n > s.frame_count ? n - s.frame_count : s.frame_count - n;
+        if (r.first_mismatch == UINT32_MAX) r.first_mismatch = LV_MIN(n, s.frame_count);
+    }
+    r.compared = true;
+    r.base_p50_us = base.percentile(50);
+    r.base_p99_us = base.percentile(99);
+    r.regression = r.base_p50_us &&
+                   uint64_t(r.frame_p50_us) * 100 > uint64_t(r.base_p50_us) * (100 + cfg.regression_pct);
+}
+
+inline void save_baseline(const Session& s, const char* path) noexcept {
+    FILE* out = std::fopen(path, "wb");
+    if (!out) {
+        LV_LOG_WARN("replay: cannot write %s", path);
+        return;
+    }
+    std::fwrite("LVRB", 1, 4, out);
+    std::fwrite(&s.frame_count, sizeof(s.frame_count), 1, out);
+    std::fwrite(s.frames, sizeof(Frame), s.frame_count, out);
+    std::fclose(out);
+}
+
+inline void write_report(const Result& r, FILE* out) noexcept {
+    std::fprintf(out,
+                 "{\"frames\":%u,\"applied\":%u,\"hash\":\"%016llx\",\"frame_us\":{\"p50\":%u,\"p99\":%u}",
+                 static_cast<unsigned>(r.frames), static_cast<unsigned>(r.applied),
+                 static_cast<unsigned long long>(r.hash), static_cast<unsigned>(r.frame_p50_us),
+                 static_cast<unsigned>(r.frame_p99_us));
+    if (r.compared) {
+        std::fprintf(out, ",\"baseline\":{\"frame_us\":{\"p50\":%u,\"p99\":%u},\"mismatched\":%u,"
+                          "\"first_mismatch\":%d,\"regression\":%s}",
+                     static_cast<unsigned>(r.base_p50_us), static_cast<unsigned>(r.base_p99_us),
+                     static_cast<unsigned>(r.mismatched),
+                     r.mismatched ? static_cast<int>(r.first_mismatch) : -1, r.regression ? "true" : "false");
+    }
+    std::fprintf(out, ",\"passed\":%s}\n", r.passed() ? "true" : "false");
+}
+
+} // namespace detail
+
+/**
+ * @brief Replay channel `id` into `state`
+ *
+ * Needed on both sides: recording logs replay::set() calls on the state,
+ * playing sets it from the recording.
+ */
+template<typename T>
+void bind(uint8_t id, State<T>& state) noexcept {
+    if (id >= LV_CPP_REPLAY_CHANNELS) return;
+    detail::Channel& c = detail::session().channels[id];
+    c.state = &state;
+    c.apply = &detail::apply_state<T>;
+}
+
+/// Set a bound state from outside the UI; recorded, and ignored while playing
+template<typename T>
+void set(State<T>& state, T value) noexcept {
+    detail::Session& s = detail::session();
+    for (uint8_t i = 0; i < LV_CPP_REPLAY_CHANNELS; ++i) {
+        if (s.channels[i].state != &state) continue;
+        if (s.mode == detail::Mode::playing) return;
+        detail::note_value(i, detail::to_raw(value));
+        break;
+    }
+    state.set(value);
+}
+
+/**
+ * @brief Pass an external reading through channel `id`
+ *
+ * Returns `value` (recorded if it changed), or the recorded value at the
+ * current virtual time while playing.
+ */
+template<typename T>
+[[nodiscard]] T input(uint8_t id, T value) noexcept {
+    detail::Session& s = detail::session();
+    if (id < LV_CPP_REPLAY_CHANNELS && s.mode == detail::Mode::playing) {
+        const detail::Channel& c = s.channels[id];
+        return c.seen ? detail::from_raw<T>(c.value) : value;
+    }
+    detail::note_value(id, detail::to_raw(value));
+    return value;
+}
+
+/// Start a new recording of every input device of `disp` (nullptr: default display)
+inline bool start_recording(lv_display_t* disp = nullptr) noexcept {
+    detail::Session& s = detail::session();
+    if (s.mode != detail::Mode::off) return false;
+    if (!disp) disp = lv_display_get_default();
+    s.header = detail::Header{};
+    s.dropped = 0;
+    for (detail::Channel& c : s.channels) c.seen = false;
+    if (disp) {
+        s.header.hor_res = lv_display_get_horizontal_resolution(disp);
+        s.header.ver_res = lv_display_get_vertical_resolution(disp);
+    }
+    for (lv_indev_t* indev = lv_indev_get_next(nullptr); indev; indev = lv_indev_get_next(indev)) {
+        if (disp && lv_indev_get_display(indev) && lv_indev_get_display(indev) != disp) continue;
+        if (s.header.indevs == LV_CPP_REPLAY_INDEVS) {
+            LV_LOG_WARN("replay: input devices beyond LV_CPP_REPLAY_INDEVS are not recorded");
+            break;
+        }
+        detail::Input& in = s.inputs[s.header.indevs];
+        in = detail::Input{indev, lv_indev_get_read_cb(indev), {}};
+        in.last.state = UINT16_MAX;          // the first read is always recorded
+        s.header.types[s.header.indevs++] = static_cast<uint8_t>(lv_indev_get_type(indev));
+        lv_indev_set_read_cb(indev, &detail::record_read_cb);
+    }
+    s.start = lv_tick_get();
+    s.mode = detail::Mode::recording;
+    return true;
+}
+
+/// Give the input devices their read callbacks back
+inline void stop_recording() noexcept {
+    detail::Session& s = detail::session();
+    if (s.mode != detail::Mode::recording) return;
+    for (uint16_t i = 0; i < s.header.indevs; ++i) {
+        detail::Input& in = s.inputs[i];
+        if (lv_indev_get_read_cb(in.indev) == &detail::record_read_cb) lv_indev_set_read_cb(in.indev, in.read_cb);
+        in.indev = nullptr;
+    }
+    s.header.duration_ms = lv_tick_elaps(s.start);
+    s.mode = detail::Mode::off;
+}
+
+/// Write the recording (a header and the records, host byte order)
+inline bool save(const char* path) noexcept {
+    const detail::Session& s = detail::session();
+    FILE* out = std::fopen(path, "wb");
+    if (!out) return false;
+    const bool ok = std::fwrite(&s.header, sizeof(s.header), 1, out) == 1 &&
+                    std::fwrite(s.records, sizeof(Record), s.header.count, out) == s.header.count;
+    return std::fclose(out) == 0 && ok;
+}
+
+/// Read a recording written by save()
+inline bool load(const char* path) noexcept {
+    detail::Session& s = detail::session();
+    if (s.mode != detail::Mode::off) return false;
+    FILE* in = std::fopen(path, "rb");
+    if (!in) return false;
+    detail::Header h;
+    bool ok = std::fread(&h, sizeof(h), 1, in) == 1 && std::memcmp(h.magic, "LVRP", 4) == 0 && h.version == 1 &&
+              h.indevs <= LV_CPP_REPLAY_INDEVS && h.count <= LV_CPP_REPLAY_RECORDS;
+    ok = ok && std::fread(s.records, sizeof(Record), h.count, in) == h.count;
+    std::fclose(in);
+    if (!ok) {
+        LV_LOG_WARN("replay: %s is not a recording this build can play", path);
+        return false;
+    }
+    s.header = h;
+    s.dropped = 0;
+    return true;
+}
+
+/**
+ * @brief Play the loaded (or last) recording through `bench` and report on it
+ *
+ * Creates one indev per recorded device, applies every record before the
+ * frame whose virtual time reaches it (each input record is read on its
+ * own, so a press and release inside one frame both happen), and hashes
+ * what each frame flushes. Writes the JSON report to cfg.report or stdout.
+ */
+inline Result play(Bench& bench, const PlayConfig& cfg = {}) noexcept {
+    using clock = std::chrono::steady_clock;
+    detail::Session& s = detail::session();
+    Result r;
+    if (s.mode != detail::Mode::off) return r;
+    lv_display_t* disp = cfg.display ? cfg.display : lv_display_get_default();
+    if (disp && s.header.hor_res && (lv_display_get_horizontal_resolution(disp) != s.header.hor_res ||
+                                     lv_display_get_vertical_resolution(disp) != s.header.ver_res)) {
+        LV_LOG_WARN("replay: recorded at %dx%d, playing on another size", static_cast<int>(s.header.hor_res),
+                    static_cast<int>(s.header.ver_res));
+    }
+    s.mode = detail::Mode::playing;
+    for (detail::Channel& c : s.channels) c.seen = false;
+    for (uint16_t i = 0; i < s.header.indevs; ++i) {
+        detail::Input& in = s.inputs[i];
+        in = detail::Input{lv_indev_create(), nullptr, {}};
+        if (!in.indev) continue;
+        lv_indev_set_type(in.indev, static_cast<lv_indev_type_t>(s.header.types[i]));
+        lv_indev_set_read_cb(in.indev, &detail::play_read_cb);
+        lv_indev_set_user_data(in.indev, &in);
+        lv_indev_set_mode(in.indev, LV_INDEV_MODE_EVENT);      // read only when a record is due
+        if (disp) lv_indev_set_display(in.indev, disp);
+    }
+    if (disp) lv_display_add_event_cb(disp, &detail::flush_cb, LV_EVENT_FLUSH_START, nullptr);
+
+    const uint32_t step = cfg.step_ms ? cfg.step_ms : 1;
+    const uint32_t frames = cfg.frames ? cfg.frames : s.header.duration_ms / step + 1 + cfg.settle_frames;
+    static BenchSamples<LV_CPP_REPLAY_FRAMES> times;
+    times.clear();
+    s.frame_count = 0;
+    bench.step(step);
+    uint32_t next = 0;
+    uint64_t all = 1469598103934665603ull;
+    for (uint32_t f = 0; f < frames; ++f) {
+        const uint32_t now = (f + 1) * step;
+        uint8_t read = 0;
+        for (; next < s.header.count && s.records[next].t_ms <= now; ++next) {
+            const Record& rec = s.records[next];
+            ++r.applied;
+            if (rec.kind == Kind::value) {
+                if (rec.channel >= LV_CPP_REPLAY_CHANNELS) continue;
+                detail::Channel& c = s.channels[rec.channel];
+                c.value = static_cast<int64_t>((static_cast<uint64_t>(static_cast<uint32_t>(rec.b)) << 32) |
+                                               static_cast<uint32_t>(rec.a));
+                c.seen = true;
+                if (c.apply) c.apply(c.state, c.value);
+            } else if (rec.channel < s.header.indevs && s.inputs[rec.channel].indev) {
+                s.inputs[rec.channel].last = rec;
+                lv_indev_read(s.inputs[rec.channel].indev);
+                read |= static_cast<uint8_t>(1u << rec.channel);
+            }
+        }
+        // Devices without a record this frame are read once so long presses and repeats advance
+        for (uint16_t i = 0; i < s.header.indevs; ++i) {
+            if (!(read & (1u << i)) && s.inputs[i].indev) lv_indev_read(s.inputs[i].indev);
+        }
+        s.frame_hash = 0;
+        const clock::time_point t0 = clock::now();
+        bench.frame();
+        const auto us = static_cast<uint32_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - t0).count());
+        all = (all ^ s.frame_hash) * 1099511628211ull;
+        times.add(us);
+        if (s.frame_count < LV_CPP_REPLAY_FRAMES) s.frames[s.frame_count++] = detail::Frame{s.frame_hash, us, 0};
+    }
+
+    if (disp) lv_display_remove_event_cb_with_user_data(disp, &detail::flush_cb, nullptr);
+    for (uint16_t i = 0; i < s.header.indevs; ++i) {
+        if (s.inputs[i].indev) lv_indev_delete(s.inputs[i].indev);
+        s.inputs[i] = detail::Input{};
+    }
+    s.mode = detail::Mode::off;
+
+    r.frames = frames;
+    r.hash = all;
+    r.frame_p50_us = times.percentile(50);
+    r.frame_p99_us = times.percentile(99);
+    if (cfg.baseline) detail::compare(s, cfg, r);
+    if (cfg.save_baseline) detail::save_baseline(s, cfg.save_baseline);
+    FILE* out = cfg.report ? std::fopen(cfg.report, "w") : stdout;
+    if (out) {
+        detail::write_report(r, out);
+        if (out != stdout) std::fclose(out);
+    }
+    LV_LOG_USER("replay: %u frames, %u records, p50 %u us%s", static_cast<unsigned>(r.frames),
+                static_cast<unsigned>(r.applied), static_cast<unsigned>(r.frame_p50_us),
+                !r.compared ? "" : r.passed() ? ", matches the baseline" : ", FAILED against the baseline");
+    return r;
+}
+
+[[nodiscard]] inline bool recording() noexcept { return detail::session().mode == detail::Mode::recording; }
+
+[[nodiscard]] inline bool playing() noexcept { return detail::session().mode == detail::Mode::playing; }
+
+[[nodiscard]] inline Stats stats() noexcept {
+    const detail::Session& s = detail::session();
+    return Stats{s.header.count, s.dropped, s.header.duration_ms, s.header.indevs};
+}
+
+} // namespace lv::replay
@@ -0,0 +1,530 @@
+#pragma once
+
+/**
+ * @file soak.hpp
+ * @brief Long monkey runs with leak and frame-time regression detection
+ *
+ * lv::soak::run() lets an lv::Monkey loose on a set of screens for hours.
+ * It periodically records frame time, LVGL heap use and fragmentation, the
+ * process RSS (Linux), the number of objects and the number of timers. At
+ * the end it flags leaks and frame-time regressions and writes a JSON
+ * report:
+ *
+ * @code
+ * #include <lv/others/soak.hpp>
+ *
+ * constexpr lv::soak::Screen screens[] = {
+ *     lv::soak::component<HomeScreen>("home"),
+ *     lv::soak::component<SettingsScreen>("settings"),
+ *     {"charts", [](lv_obj_t* screen, void*) { build_charts(screen); }},
+ * };
+ * lv::Monkey monkey(LV_INDEV_TYPE_POINTER, 10, 100);
+ * lv::soak::Config cfg;
+ * cfg.duration_ms = 8 * 3600 * 1000;
+ * cfg.report = "/data/soak.json";
+ * const lv::soak::Result r = lv::soak::run(monkey, screens, cfg);
+ * return r.passed() ? 0 : 1;
+ * @endcode
+ *
+ * Every Config::switch_ms the next screen is built on a fresh screen
+ * object and loaded. The previous one is torn down and deleted, so a
+ * screen that leaks leaks again on every visit.
+ *
+ * Leak detection looks at the floor, not the peaks. The samples after
+ * Config::warmup_ms (caches filling up) are cut into four quarters. A
+ * figure leaks when its minimum rises from quarter to quarter and the
+ * last minimum exceeds the first by more than the tolerance. The
+ * tolerances are Config::leak_bytes for the heap and RSS, and zero for
+ * objects and timers. A frame-time regression is when the last quarter's
+ * average render time is over the first quarter's by Config::regression_pct.
+ *
+ * Samples are kept in a fixed table (LV_CPP_SOAK_SAMPLES). When it fills
+ * up, neighbouring samples are merged and the period doubles, so any
+ * duration fits. Merged samples keep the lower memory, object and timer
+ * figures, the higher frame maximum and the combined average. With
+ * Config::report set, the report is rewritten after every sample: a
+ * crash or watchdog reset still leaves the data up to then.
+ *
+ * Heap use needs LVGL's builtin allocator (or lv::slab_alloc); with
+ * another allocator, heap figures are 0 and the RSS covers it.
+ *
+ * Not included by lv.hpp: the object count walks lv_display_t's screens
+ * and screen_cnt, which have no getters. Checked against LVGL 9.4 (see
+ * LV_CPP_INTERNALS_OK).
+ *
+ * Heap allocation: NONE in the harness (two timers and display event
+ * descriptors); the screens allocate what they build
+ */
+
+#include <lvgl.h>
+#include "../core/version.hpp"
+
+#if !LV_CPP_INTERNALS_OK
+#error "soak.hpp reads LVGL internals checked against LVGL 9.4; see LV_CPP_INTERNALS_OK"
+#endif
+
+#include <src/display/lv_display_private.h>   // screens, screen_cnt
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <new>
+#include "monkey.hpp"
+#include "../core/app.hpp"
+#include "../core/object.hpp"
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+#if LV_USE_MONKEY
+
+#ifndef LV_CPP_SOAK_SAMPLES
+/// Samples kept; more are merged pairwise (the sampling period doubles)
+#define LV_CPP_SOAK_SAMPLES 256
+#endif
+
+namespace lv::soak {
+
+/// Build one screen of the rotation into `screen` (a fresh lv_obj_create(nullptr))
+using build_fn = void (*)(lv_obj_t* screen, void* user_data);
+
+/// Called before the screen is deleted (e.g. destroy a Component)
+using teardown_fn = void (*)(void* user_data);
+
+struct Screen {
+    const char* name;
+    build_fn build;
+    void* user_data = nullptr;
+    teardown_fn teardown = nullptr;
+};
+
+namespace detail {
+
+/// Static storage for the Component of a component<C>() screen
+template<typename C>
+struct ComponentSlot {
+    alignas(C) static inline unsigned char storage[sizeof(C)];
+    static inline C* instance = nullptr;
+
+    static void build(lv_obj_t* screen, void*) {
+        instance = new (storage) C();
+        instance->mount(ObjectView(screen));
+    }
+
+    static void teardown(void*) {
+        if (instance) instance->~C();
+        instance = nullptr;
+    }
+};
+
+} // namespace detail
+
+/// Screen that constructs and mounts a new `C` on each visit and destroys it on leaving
+template<typename C>
+[[nodiscard]] constexpr Screen component(const char* name) noexcept {
+    return Screen{name, &detail::ComponentSlot<C>::build, nullptr, &detail::ComponentSlot<C>::teardown};
+}
+
+struct Config {
+    uint32_t duration_ms = 60u * 60u * 1000u;    ///< Length of the run
+    uint32_t sample_ms = 10u * 1000u;            ///< Initial sampling period
+    uint32_t switch_ms = 60u * 1000u;            ///< Screen rotation period (0: stay on the first)
+    uint32_t warmup_ms = 5u * 60u * 1000u;       ///< Samples ignored by the checks
+    uint32_t leak_bytes = 16u * 1024u;           ///< Floor growth of heap or RSS that counts as a leak
+    uint32_t regression_pct = 20;                ///< Render time growth that counts as a regression
+    const char* report = nullptr;                ///< JSON report path (nullptr: stdout at the end)
+    lv_display_t* display = nullptr;             ///< Display to time (nullptr: default)
+};
+
+/// One sampling period
+struct Sample {
+    uint32_t t_ms = 0;              ///< End of the period since the start
+    uint32_t frames = 0;            ///< Refreshes that rendered
+    uint32_t frame_avg_us = 0;      ///< Average render time (REFR_START to REFR_READY)
+    uint32_t frame_max_us = 0;
+    uint32_t cpu = 0;               ///< LVGL busy percentage
+    uint32_t mem_used = 0;          ///< LVGL heap bytes in use
+    uint32_t mem_biggest_free = 0;
+    uint32_t frag_pct = 0;
+    uint32_t rss_kb = 0;            ///< Process resident set (0 off Linux)
+    uint32_t objects = 0;           ///< Objects on all screens and layers
+    uint32_t timers = 0;
+    uint16_t screen = 0;            ///< Index of the screen shown at the end
+};
+
+/// Growth of one figure's floor between the first and the last quarter
+struct Trend {
+    int64_t first = 0;      ///< Minimum of the first quarter after warm-up
+    int64_t last = 0;       ///< Minimum of the last quarter
+    bool monotonic = false; ///< The minimum rose from quarter to quarter
+    bool flagged = false;
+
+    [[nodiscard]] int64_t growth() const noexcept { return last - first; }
+};
+
+struct Result {
+    uint32_t elapsed_ms = 0;
+    uint32_t samples = 0;
+    uint32_t sample_ms = 0;         ///< Final sampling period (after merging)
+    uint32_t switches = 0;          ///< Screen changes
+    bool conclusive = false;        ///< At least four samples after warm-up
+    Trend heap;
+    Trend rss;
+    Trend objects;
+    Trend timers;
+    uint32_t frame_first_us = 0;    ///< Average render time of the first quarter after warm-up
+    uint32_t frame_last_us = 0;     ///< ... and of the last quarter
+    bool frame_regression = false;
+
+    [[nodiscard]] bool leaked() const noexcept {
+        return heap.flagged || rss.flagged || objects.flagged || timers.flagged;
+    }
+
+    [[nodiscard]] bool passed() const noexcept { return conclusive && !leaked() && !frame_regression; }
+};
+
+namespace detail {
+
+struct Session {
+    Config cfg;
+    const Screen* screens = nullptr;
+    size_t screen_count = 0;
+    size_t current = 0;
+    lv_obj_t* screen_obj = nullptr;
+    lv_display_t* disp = nullptr;
+    lv_timer_t* sample_timer = nullptr;
+    lv_timer_t* switch_timer = nullptr;
+    uint32_t start = 0;
+    uint32_t period = 0;
+    uint32_t switches = 0;
+    bool done = false;
+
+    // Current period
+    uint64_t refr_start = 0;
+    bool rendered = false;
+    uint32_t frames = 0;
+    uint64_t frame_total_us = 0;
+    uint32_t frame_max_us = 0;
+
+    Sample samples[LV_CPP_SOAK_SAMPLES];
+    uint32_t count = 0;
+};
+
+[[nodiscard]] inline Session& session() noexcept {
+    static Session s;
+    return s;
+}
+
+[[nodiscard]] inline uint64_t now_us() noexcept {
+    using namespace std::chrono;
+    return static_cast<uint64_t>(duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+inline lv_obj_tree_walk_res_t count_cb(lv_obj_t*, void* n) noexcept {
+    ++*static_cast<uint32_t*>(n);
+    return LV_OBJ_TREE_WALK_NEXT;
+}
+
+/// Objects on every screen and layer of every display
+[[nodiscard]] inline uint32_t object_count() noexcept {
+    uint32_t n = 0;
+    for (lv_display_t* d = lv_display_get_next(nullptr); d; d = lv_display_get_next(d)) {
+        for (uint32_t i = 0; i < d->screen_cnt; ++i) lv_obj_tree_walk(d->screens[i], &count_cb, &n);
+        for (lv_obj_t* layer : {d->bottom_layer, d->top_layer, d->sys_layer}) {
+            if (layer) lv_obj_tree_walk(layer, &count_cb, &n);
+        }
+    }
+    return n;
+}
+
+[[nodiscard]] inline uint32_t timer_count() noexcept {
+    uint32_t n = 0;
+    for (lv_timer_t* t = lv_timer_get_next(nullptr); t; t = lv_timer_get_next(t)) ++n;
+    return n;
+}
+
+[[nodiscard]] inline uint32_t rss_kb() noexcept {
+#if defined(__linux__)
+    FILE* f = std::fopen("/proc/self/statm", "r");
+    if (!f) return 0;
+    unsigned long size = 0, resident = 0;
+    const int n = std::fscanf(f, "%lu %lu", &size, &resident);
+    std::fclose(f);
+    return n == 2 ? static_cast<uint32_t>(resident * static_cast<unsigned long>(sysconf(_SC_PAGESIZE)) / 1024) : 0;
+#else
+    return 0;
+#endif
+}
+
+inline void refr_cb(lv_event_t* e) noexcept {
+    Session& s = session();
+    switch (lv_event_get_code(e)) {
+    case LV_EVENT_REFR_START:
+        s.refr_start = now_us();
+        s.rendered = false;
+        break;
+    case LV_EVENT_RENDER_START:
+        s.rendered = true;
+        break;
+    case LV_EVENT_REFR_READY:
+        if (s.rendered) {
+            const auto us = static_cast<uint32_t>(now_us() - s.refr_start);
+            ++s.frames;
+            s.frame_total_us += us;
+            if (us > s.frame_max_us) s.frame_max_us = us;
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+/// Merge samples pairwise: half the table, twice the period
+inline void decimate(Session& s) noexcept {
+    const uint32_t half = s.count / 2;
+    for (uint32_t i = 0; i < half; ++i) {
+        const Sample& a = s.samples[2 * i];
+        const Sample& b = s.samples[2 * i + 1];
+        Sample m = b;
+        m.frames = a.frames + b.frames;
+        m.frame_avg_us = m.frames ? static_cast<uint32_t>((uint64_t(a.frame_avg_us) * a.frames +
+                                                           uint64_t(b.frame_avg_us) * b.frames) / m.frames) : 0;
+        m.frame_max_us = LV_MAX(a.frame_max_us, b.frame_max_us);
+        m.cpu = (a.cpu + b.cpu) / 2;
+        m.mem_used = LV_MIN(a.mem_used, b.mem_used);
+        m.rss_kb = LV_MIN(a.rss_kb, b.rss_kb);
+        m.objects = LV_MIN(a.objects, b.objects);
+        m.timers = LV_MIN(a.timers, b.timers);
+        s.samples[i] = m;
+    }
+    if (s.count % 2) s.samples[half] = s.samples[s.count - 1];
+    s.count = half + s.count % 2;
+    s.period *= 2;
+    lv_timer_set_period(s.sample_timer, s.period);
+}
+
+/// Floor of one figure in each quarter of samples [first, count)
+template<typename Get>
+[[nodiscard]] Trend floor_trend(const Session& s, uint32_t first, int64_t tolerance, Get get) noexcept {
+    Trend t;
+    const uint32_t n = s.count - first;
+    int64_t minima[4];
+    for (uint32_t q = 0; q < 4; ++q) {
+        const uint32_t from = first + n * q / 4;
+        const uint32_t to = first + n * (q + 1) / 4;
+        minima[q] = INT64_MAX;
+        for (uint32_t i = from; i < to; ++i) minima[q] = LV_MIN(minima[q], get(s.samples[i]));
+    }
+    t.first = minima[0];
+    t.last = minima[3];
+    t.monotonic = minima[0] < minima[1] && minima[1] < minima[2] && minima[2] < minima[3];
+    t.flagged = t.monotonic && t.growth() > tolerance;
+    return t;
+}
+
+/// Average render time over samples [from, to)
+[[nodiscard]] inline uint32_t frame_avg(const Session& s, uint32_t from, uint32_t to) noexcept {
+    uint64_t total = 0;
+    uint64_t frames = 0;
+    for (uint32_t i = from; i < to; ++i) {
+        total += uint64_t(s.samples[i].frame_avg_us) * s.samples[i].frames;
+        frames += s.samples[i].frames;
+    }
+    return frames ? static_cast<uint32_t>(total / frames) : 0;
+}
+
+[[nodiscard]] inline Result analyse(const Session& s) noexcept {
+    Result r;
+    r.elapsed_ms = lv_tick_elaps(s.start);
+    r.samples = s.count;
+    r.sample_ms = s.period;
+    r.switches = s.switches;
+    uint32_t first = 0;
+    while (first < s.count && s.samples[first].t_ms < s.cfg.warmup_ms) ++first;
+    const uint32_t n = s.count - first;
+    if (n < 4) return r;
+    r.conclusive = true;
+    const int64_t bytes = s.cfg.leak_bytes;
+    r.heap = floor_trend(s, first, bytes, [](const Sample& x) { return int64_t(x.mem_used); });
+    r.rss = floor_trend(s, first, bytes / 1024, [](const Sample& x) { return int64_t(x.rss_kb); });
+    r.objects = floor_trend(s, first, 0, [](const Sample& x) { return int64_t(x.objects); });
+    r.timers = floor_trend(s, first, 0, [](const Sample& x) { return int64_t(x.timers); });
+    r.frame_first_us = frame_avg(s, first, first + n / 4);
+    r.frame_last_us = frame_avg(s, first + n * 3 / 4, s.count);
+    r.frame_regression = r.frame_first_us &&
+                         uint64_t(r.frame_last_us) * 100 > uint64_t(r.frame_first_us) * (100 + s.cfg.regression_pct);
+    return r;
+}
+
+inline void write_trend(FILE* out, const char* name, const Trend& t) noexcept {
+    std::fprintf(out, ",\"%s\":{\"first\":%lld,\"last\":%lld,\"monotonic\":%s,\"leak\":%s}", name,
+                 static_cast<long long>(t.first), static_cast<long long>(t.last),
+                 t.monotonic ? "true" : "false", t.flagged ? "true" : "false");
+}
+
+inline void write_report(const Session& s, const Result& r, FILE* out) noexcept {
+    std::fprintf(out, "{\"elapsed_ms\":%u,\"sample_ms\":%u,\"switches\":%u,\"screens\":[",
+                 static_cast<unsigned>(r.elapsed_ms), static_cast<unsigned>(r.sample_ms),
+                 static_cast<unsigned>(r.switches));
+    for (size_t i = 0; i < s.screen_count; ++i) {
+        std::fprintf(out, i ? ",\"%s\"" : "\"%s\"", s.screens[i].name ? s.screens[i].name : "");
+    }
+    std::fprintf(out, "],\"samples\":[");
+    for (uint32_t i = 0; i < s.count; ++i) {
+        const Sample& x = s.samples[i];
+        std::fprintf(out,
+                     "%s{\"t_ms\":%u,\"frames\":%u,\"frame_avg_us\":%u,\"frame_max_us\":%u,\"cpu\":%u,"
+                     "\"mem_used\":%u,\"mem_biggest_free\":%u,\"frag_pct\":%u,\"rss_kb\":%u,"
+                     "\"objects\":%u,\"timers\":%u,\"screen\":%u}",
+                     i ? "," : "", static_cast<unsigned>(x.t_ms), static_cast<unsigned>(x.frames),
+                     static_cast<unsigned>(x.frame_avg_us), static_cast<unsigned>(x.frame_max_us),
+                     static_cast<unsigned>(x.cpu), static_cast<unsigned>(x.mem_used),
+                     static_cast<unsigned>(x.mem_biggest_free), static_cast<unsigned>(x.frag_pct),
+                     static_cast<unsigned>(x.rss_kb), static_cast<unsigned>(x.objects),
+                     static_cast<unsigned>(x.timers), static_cast<unsigned>(x.screen));
+    }
+    std::fprintf(out, "],\"conclusive\":%s", r.conclusive ? "true" : "false");
+    write_trend(out, "heap", r.heap);
+    write_trend(out, "rss_kb", r.rss);
+    write_trend(out, "objects", r.objects);
+    write_trend(out, "timers", r.timers);
+    std::fprintf(out, ",\"frame_us\":{\"first\":%u,\"last\":%u,\"regression\":%s},\"passed\":%s}\n",
+                 static_cast<unsigned>(r.frame_first_us), static_cast<unsigned>(r.frame_last_us),
+                 r.frame_regression ? "true" : "false", r.passed() ? "true" : "false");
+}
+
+inline void save_report(const Session& s) noexcept {
+    if (!s.cfg.report) return;
+    FILE* out = std::fopen(s.cfg.report, "w");
+    if (!out) {
+        LV_LOG_WARN("soak: cannot write %s", s.cfg.report);
+        return;
+    }
+    write_report(s, analyse(s), out);
+    std::fclose(out);
+}
+
+inline void sample_cb(lv_timer_t*) noexcept {
+    Session& s = session();
+    if (s.count == LV_CPP_SOAK_SAMPLES) decimate(s);
+    Sample& x = s.samples[s.count++];
+    x = Sample{};
+    x.t_ms = lv_tick_elaps(s.start);
+    x.frames = s.frames;
+    x.frame_avg_us = s.frames ? static_cast<uint32_t>(s.frame_total_us / s.frames) : 0;
+    x.frame_max_us = s.frame_max_us;
+    const uint32_t idle = lv_timer_get_idle();
+    x.cpu = idle < 100 ? 100 - idle : 0;
+    lv_mem_monitor_t mem;
+    lv_mem_monitor(&mem);
+    x.mem_used = mem.total_size > mem.free_size ? static_cast<uint32_t>(mem.total_size - mem.free_size) : 0;
+    x.mem_biggest_free = static_cast<uint32_t>(mem.free_biggest_size);
+    x.frag_pct = mem.frag_pct;
+    x.rss_kb = rss_kb();
+    x.objects = object_count();
+    x.timers = timer_count();
+    x.screen = static_cast<uint16_t>(s.current);
+    s.frames = 0;
+    s.frame_total_us = 0;
+    s.frame_max_us = 0;
+    save_report(s);
+    if (x.t_ms >= s.cfg.duration_ms) s.done = true;
+}
+
+/// Build screen `index` on a fresh screen object, load it, then drop the previous one
+inline void show(Session& s, size_t index) noexcept {
+    const Screen& next = s.screens[index];
+    lv_obj_t* old = s.screen_obj;
+    lv_obj_t* scr = lv_obj_create(nullptr);
+    if (!scr) return;
+    if (old && s.screens[s.current].teardown) s.screens[s.current].teardown(s.screens[s.current].user_data);
+    next.build(scr, next.user_data);
+    lv_screen_load(scr);
+    if (old) lv_obj_delete(old);
+    s.screen_obj = scr;
+    s.current = index;
+}
+
+inline void switch_cb(lv_timer_t*) noexcept {
+    Session& s = session();
+    show(s, (s.current + 1) % s.screen_count);
+    ++s.switches;
+}
+
+} // namespace detail
+
+/**
+ * @brief Run `monkey` on `screens` for cfg.duration_ms, driving the main loop
+ *
+ * Blocks (lv::tick() and sleep) until the duration is over, then disables
+ * the monkey, deletes the last screen and returns the findings. The
+ * screen that was active before is loaded again. Without screens the
+ * monkey plays on the active screen. Not re-entrant.
+ */
+inline Result run(Monkey& monkey, const Screen* screens, size_t count, const Config& cfg = {}) noexcept {
+    detail::Session& s = detail::session();
+    s = detail::Session{};
+    s.cfg = cfg;
+    s.screens = screens;
+    s.screen_count = count;
+    s.period = cfg.sample_ms ? cfg.sample_ms : 1000;
+    s.disp = cfg.display ? cfg.display : lv_display_get_default();
+    lv_obj_t* original = lv_screen_active();
+    if (s.disp) {
+        for (lv_event_code_t code : {LV_EVENT_REFR_START, LV_EVENT_RENDER_START, LV_EVENT_REFR_READY}) {
+            lv_display_add_event_cb(s.disp, &detail::refr_cb, code, &s);
+        }
+    }
+    if (count) {
+        detail::show(s, 0);
+        if (count > 1 && cfg.switch_ms) s.switch_timer = lv_timer_create(&detail::switch_cb, cfg.switch_ms, nullptr);
+    }
+    s.start = lv_tick_get();
+    s.sample_timer = lv_timer_create(&detail::sample_cb, s.period, nullptr);
+    monkey.enable();
+
+    run_with([&s] { return !s.done && s.sample_timer; });
+
+    monkey.disable();
+    if (s.switch_timer) lv_timer_delete(s.switch_timer);
+    if (s.sample_timer) lv_timer_delete(s.sample_timer);
+    s.switch_timer = s.sample_timer = nullptr;
+    if (s.disp) lv_display_remove_event_cb_with_user_data(s.disp, &detail::refr_cb, &s);
+    const Result r = detail::analyse(s);
+    if (s.cfg.report) {
+        detail::save_report(s);
+    } else {
+        detail::write_report(s, r, stdout);
+    }
+    if (s.screen_obj) {
+        if (original) lv_screen_load(original);
+        if (s.screens[s.current].teardown) s.screens[s.current].teardown(s.screens[s.current].user_data);
+        lv_obj_delete(s.screen_obj);
+        s.screen_obj = nullptr;
+    }
+    LV_LOG_USER("soak: %u samples over %u s, %s", static_cast<unsigned>(r.samples),
+                static_cast<unsigned>(r.elapsed_ms / 1000),
+                !r.conclusive ? "inconclusive (too short after warm-up)" :
+                r.passed()    ? "passed" : "FAILED (leak or frame-time regression)");
+    return r;
+}
+
+template<size_t N>
+inline Result run(Monkey& monkey, const Screen (&screens)[N], const Config& cfg = {}) noexcept {
+    return run(monkey, screens, N, cfg);
+}
+
+/// Run on the active screen
+inline Result run(Monkey& monkey, const Config& cfg = {}) noexcept { return run(monkey, nullptr, 0, cfg); }
+
+/// Run on the active screen for `duration_ms` with the default settings
+inline Result run(Monkey& monkey, uint32_t duration_ms) noexcept {
+    Config cfg;
+    cfg.duration_ms = duration_ms;
+    return run(monkey, cfg);
+}
+
+} // namespace lv::soak
+
+#endif // LV_USE_MONKEY
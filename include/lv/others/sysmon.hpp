@@ -2,22 +2,236 @@
 
 /**
  * @file sysmon.hpp
- * @brief Zero-cost wrapper for LVGL system monitor
+ * @brief Zero-cost wrapper for LVGL system monitor, plus a metrics API
  *
- * On-screen display of CPU usage, FPS, and memory stats.
+ * On-screen display of CPU usage, FPS, and memory stats (LV_USE_SYSMON).
  *
  * Usage:
  *   lv::sysmon::show_performance();   // show CPU/FPS overlay
  *   lv::sysmon::show_memory();        // show memory overlay
+ *
+ * The same numbers without the overlay label, for telemetry (no
+ * LV_USE_SYSMON needed):
+ * @code
+ * lv::sysmon::start();                                 // default display, 1 s windows
+ * lv::sysmon::subscribe([](const lv::sysmon::PerfSample& s, void*) {
+ *     metrics.gauge("ui_fps", s.fps);
+ *     metrics.gauge("ui_render_us", s.render_us);
+ * });
+ * lv::sysmon::PerfSample now = lv::sysmon::snapshot();  // last completed window
+ * label.bind_text(lv::sysmon::perf_state(), ...);      // or observe it as State
+ * @endcode
  */
 
 #include <lvgl.h>
+#include <chrono>
+#include <cstdint>
 #include "../core/object.hpp"
-
-#if LV_USE_SYSMON
+#include "../core/state.hpp"
 
 namespace lv::sysmon {
 
+#ifndef LV_CPP_SYSMON_PERIOD
+/// Default length of a metrics window in milliseconds
+#define LV_CPP_SYSMON_PERIOD 1000
+#endif
+
+// ==================== Metrics ====================
+
+/// Performance and memory figures of one metrics window
+struct PerfSample {
+    uint32_t timestamp = 0;         ///< lv_tick_get() at the end of the window
+    uint32_t window_ms = 0;
+    uint32_t fps = 0;               ///< Refreshes per second
+    uint32_t cpu = 0;               ///< LVGL busy percentage (100 - lv_timer_get_idle())
+    uint32_t refreshes = 0;
+    uint32_t render_us = 0;         ///< Average render time per refresh (includes flushes issued while rendering)
+    uint32_t render_max_us = 0;
+    uint32_t flush_us = 0;          ///< Average flush callback time per refresh
+    uint32_t mem_total = 0;         ///< Bytes (0 unless LVGL's builtin allocator or lv::slab_alloc is used)
+    uint32_t mem_used = 0;
+    uint32_t mem_free = 0;
+    uint32_t mem_biggest_free = 0;
+    uint32_t mem_max_used = 0;
+    uint8_t mem_used_pct = 0;
+    uint8_t mem_frag_pct = 0;
+};
+
+using perf_cb = void (*)(const PerfSample& sample, void* user_data);
+
+namespace detail {
+
+struct PerfMonitor {
+    lv_display_t* disp = nullptr;
+    lv_timer_t* timer = nullptr;
+    uint32_t window_start = 0;
+    uint32_t refreshes = 0;
+    uint64_t render_us = 0;
+    uint32_t render_max_us = 0;
+    uint64_t flush_us = 0;
+    uint64_t render_start = 0;
+    uint64_t flush_start = 0;
+    PerfSample sample;
+    perf_cb cb = nullptr;
+    void* cb_user_data = nullptr;
+};
+
+[[nodiscard]] inline PerfMonitor& perf_monitor() noexcept {
+    static PerfMonitor monitor;
+    return monitor;
+}
+
+[[nodiscard]] inline uint64_t perf_now_us() noexcept {
+    using namespace std::chrono;
+    return static_cast<uint64_t>(duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+#if LV_USE_OBSERVER
+[[nodiscard]] inline State<PerfSample>& perf_subject() noexcept {
+    static State<PerfSample> state;
+    return state;
+}
+#endif
+
+inline void perf_event_cb(lv_event_t* e) noexcept {
+    PerfMonitor& m = perf_monitor();
+    switch (lv_event_get_code(e)) {
+    case LV_EVENT_RENDER_START:
+        m.render_start = perf_now_us();
+        break;
+    case LV_EVENT_RENDER_READY: {
+        const auto us = static_cast<uint32_t>(perf_now_us() - m.render_start);
+        m.render_us += us;
+        if (us > m.render_max_us) m.render_max_us = us;
+        break;
+    }
+    case LV_EVENT_FLUSH_START:
+        m.flush_start = perf_now_us();
+        break;
+    case LV_EVENT_FLUSH_FINISH:
+        m.flush_us += perf_now_us() - m.flush_start;
+        break;
+    case LV_EVENT_REFR_READY:
+        ++m.refreshes;
+        break;
+    case LV_EVENT_DELETE:
+        if (m.timer) lv_timer_delete(m.timer);
+        m.timer = nullptr;
+        m.disp = nullptr;
+        break;
+    default:
+        break;
+    }
+}
+
+inline void perf_timer_cb(lv_timer_t*) {
+    PerfMonitor& m = perf_monitor();
+    PerfSample s;
+    s.timestamp = lv_tick_get();
+    s.window_ms = lv_tick_elaps(m.window_start);
+    s.refreshes = m.refreshes;
+    s.fps = s.window_ms ? (m.refreshes * 1000 + s.window_ms / 2) / s.window_ms : 0;
+    const uint32_t idle = lv_timer_get_idle();
+    s.cpu = idle < 100 ? 100 - idle : 0;
+    if (m.refreshes) {
+        s.render_us = static_cast<uint32_t>(m.render_us / m.refreshes);
+        s.flush_us = static_cast<uint32_t>(m.flush_us / m.refreshes);
+    }
+    s.render_max_us = m.render_max_us;
+
+    lv_mem_monitor_t mem;
+    lv_mem_monitor(&mem);
+    s.mem_total = static_cast<uint32_t>(mem.total_size);
+    s.mem_free = static_cast<uint32_t>(mem.free_size);
+    s.mem_used = s.mem_total > s.mem_free ? s.mem_total - s.mem_free : 0;
+    s.mem_biggest_free = static_cast<uint32_t>(mem.free_biggest_size);
+    s.mem_max_used = static_cast<uint32_t>(mem.max_used);
+    s.mem_used_pct = mem.used_pct;
+    s.mem_frag_pct = mem.frag_pct;
+
+    m.sample = s;
+    m.window_start = s.timestamp;
+    m.refreshes = 0;
+    m.render_us = 0;
+    m.render_max_us = 0;
+    m.flush_us = 0;
+#if LV_USE_OBSERVER
+    perf_subject().set(s);
+#endif
+    if (m.cb) m.cb(s, m.cb_user_data);
+}
+
+} // namespace detail
+
+/**
+ * @brief Start collecting metrics for a display
+ *
+ * Hooks the display's refresh events (no label, no sysmon timer) and
+ * closes a window every `period_ms`. Calling it again re-targets the
+ * monitor. One display at a time.
+ *
+ * @param disp Display (nullptr = default display)
+ * @return false without a display or if the timer could not be created
+ */
+inline bool start(lv_display_t* disp = nullptr, uint32_t period_ms = LV_CPP_SYSMON_PERIOD) noexcept {
+    detail::PerfMonitor& m = detail::perf_monitor();
+    if (!disp) disp = lv_display_get_default();
+    if (!disp) return false;
+    if (m.disp != disp) {
+        if (m.disp) lv_display_remove_event_cb_with_user_data(m.disp, &detail::perf_event_cb, &m);
+        lv_display_add_event_cb(disp, &detail::perf_event_cb, LV_EVENT_RENDER_START, &m);
+        lv_display_add_event_cb(disp, &detail::perf_event_cb, LV_EVENT_RENDER_READY, &m);
+        lv_display_add_event_cb(disp, &detail::perf_event_cb, LV_EVENT_FLUSH_START, &m);
+        lv_display_add_event_cb(disp, &detail::perf_event_cb, LV_EVENT_FLUSH_FINISH, &m);
+        lv_display_add_event_cb(disp, &detail::perf_event_cb, LV_EVENT_REFR_READY, &m);
+        lv_display_add_event_cb(disp, &detail::perf_event_cb, LV_EVENT_DELETE, &m);
+        m.disp = disp;
+    }
+    if (!m.timer) m.timer = lv_timer_create(&detail::perf_timer_cb, period_ms, nullptr);
+    if (!m.timer) return false;
+    lv_timer_set_period(m.timer, period_ms);
+    m.window_start = lv_tick_get();
+    return true;
+}
+
+/// Stop collecting (the last sample stays available)
+inline void stop() noexcept {
+    detail::PerfMonitor& m = detail::perf_monitor();
+    if (m.disp) lv_display_remove_event_cb_with_user_data(m.disp, &detail::perf_event_cb, &m);
+    if (m.timer) lv_timer_delete(m.timer);
+    m.disp = nullptr;
+    m.timer = nullptr;
+}
+
+/// Metrics are being collected
+[[nodiscard]] inline bool running() noexcept { return detail::perf_monitor().timer != nullptr; }
+
+/// Last completed window (all zero before the first one; starts the monitor if needed)
+[[nodiscard]] inline PerfSample snapshot() noexcept {
+    if (!running()) start();
+    return detail::perf_monitor().sample;
+}
+
+/// Call `cb` at the end of every window (nullptr to unsubscribe); starts the monitor if needed
+inline void subscribe(perf_cb cb, void* user_data = nullptr) noexcept {
+    detail::PerfMonitor& m = detail::perf_monitor();
+    m.cb = cb;
+    m.cb_user_data = user_data;
+    if (cb && !running()) start();
+}
+
+#if LV_USE_OBSERVER
+/// State updated at the end of every window, for State observers and bindings
+[[nodiscard]] inline State<PerfSample>& perf_state() noexcept {
+    if (!running()) start();
+    return detail::perf_subject();
+}
+#endif
+
+// ==================== On-Screen Monitor ====================
+
+#if LV_USE_SYSMON
+
 /// Create a system monitor label on the display's system layer
 inline ObjectView create(lv_display_t* disp) noexcept {
     return ObjectView(lv_sysmon_create(disp));
@@ -66,6 +280,6 @@ inline void hide_memory(lv_display_t* disp = nullptr) noexcept {
 
 #endif // LV_USE_MEM_MONITOR
 
-} // namespace lv::sysmon
-
 #endif // LV_USE_SYSMON
+
+} // namespace lv::sysmon
@@ -121,22 +121,13 @@ public:
 
     /// Set checked state
     Button& checked(bool v) noexcept {
-        if (v) {
-            lv_obj_add_state(m_obj, LV_STATE_CHECKED);
-        } else {
-            lv_obj_remove_state(m_obj, LV_STATE_CHECKED);
-        }
+        lv::set_states(m_obj, v ? LV_STATE_CHECKED : 0, v ? 0 : LV_STATE_CHECKED);
         return *this;
     }
 
     /// Toggle checked state
     Button& toggle() noexcept {
-        if (lv_obj_has_state(m_obj, LV_STATE_CHECKED)) {
-            lv_obj_remove_state(m_obj, LV_STATE_CHECKED);
-        } else {
-            lv_obj_add_state(m_obj, LV_STATE_CHECKED);
-        }
-        return *this;
+        return checked(!checked());
     }
 
     /// Disable the button
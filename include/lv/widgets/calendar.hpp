@@ -3,15 +3,183 @@
 /**
  * @file calendar.hpp
  * @brief Zero-cost wrapper for LVGL calendar widget
+ *
+ * lv_calendar_set_showed_date() prints all 42 day numbers, then clears
+ * and sets the disabled, today and highlight bits button by button, and
+ * each of those calls invalidates its button. Calendar::shown_date() skips
+ * an unchanged month; calendar_months.hpp (opt-in) also copies new months
+ * from an LRU of printed month grids. refresh_highlights() changes only
+ * the buttons whose highlight differs, and highlight_day() flips one:
+ *
+ * @code
+ * static const lv::CalendarLocale de({"So", "Mo", "Di", "Mi", "Do", "Fr", "Sa"},
+ *     {"Januar", "Februar", "März", "April", "Mai", "Juni", "Juli",
+ *      "August", "September", "Oktober", "November", "Dezember"});
+ * lv::Calendar cal = lv::Calendar::create(screen);
+ * (void)cal.header_arrow();
+ * cal.locale(de).shown_date(2026, 3);      // swipe handlers call shown_date() per month
+ * cal.highlight_day(14, true);             // one button, no rescan
+ * @endcode
+ *
+ * A CalendarLocale joins its month names into the header dropdown's
+ * option string once, when it is constructed. locale() then gives the day
+ * names, the arrow header's label and the dropdown to the calendar
+ * without copying. The locale must outlive the calendar.
+ *
+ * Heap allocation: NONE (locale strings are static)
  */
 
 #include <lvgl.h>
+#include <cstdint>
+#include <cstring>
 #include "../core/object.hpp"
 #include "../core/event.hpp"
 #include "../core/style.hpp"
 
+#if LV_USE_CALENDAR
+
+#ifndef LV_CPP_CALENDAR_MONTH_OPTIONS
+/// Bytes for a CalendarLocale's joined month names
+#define LV_CPP_CALENDAR_MONTH_OPTIONS 160
+#endif
+
 namespace lv {
 
+/**
+ * @brief Day and month names of one language, with the dropdown options joined once
+ */
+class CalendarLocale {
+    const char* m_days[7];
+    const char* m_months[12];
+    char m_options[LV_CPP_CALENDAR_MONTH_OPTIONS] = {};
+    bool m_year_first;
+
+public:
+    /**
+     * @param days Day names starting with Sunday (Monday with LV_CALENDAR_WEEK_STARTS_MONDAY)
+     * @param months Month names, January first
+     * @param year_first Arrow header shows "2026 März" instead of "März 2026"
+     */
+    CalendarLocale(const char* const (&days)[7], const char* const (&months)[12], bool year_first = false) noexcept
+        : m_year_first(year_first) {
+        for (int i = 0; i < 7; ++i) m_days[i] = days[i];
+        size_t n = 0;
+        for (int i = 0; i < 12; ++i) {
+            m_months[i] = months[i];
+            const size_t len = std::strlen(months[i]);
+            if (n + len + 1 >= sizeof(m_options)) {
+                LV_LOG_WARN("CalendarLocale: month names cut, raise LV_CPP_CALENDAR_MONTH_OPTIONS");
+                break;
+            }
+            if (i > 0) m_options[n++] = '\n';
+            std::memcpy(m_options + n, months[i], len);
+            n += len;
+        }
+        m_options[n] = '\0';
+    }
+
+    CalendarLocale(const CalendarLocale&) = delete;
+    CalendarLocale& operator=(const CalendarLocale&) = delete;
+
+    [[nodiscard]] const char* const* days() const noexcept { return m_days; }
+    [[nodiscard]] const char* month(uint32_t m) const noexcept { return m_months[(m - 1) % 12]; }
+    [[nodiscard]] const char* month_options() const noexcept { return m_options; }
+    [[nodiscard]] bool year_first() const noexcept { return m_year_first; }
+};
+
+namespace calendar {
+
+struct Stats {
+    uint32_t shows = 0;       ///< Calendar::shown_date() calls
+    uint32_t unchanged = 0;   ///< Calls for the month already shown
+};
+
+namespace detail {
+
+// Button bits of the day cells, as lv_calendar.c
+inline constexpr lv_buttonmatrix_ctrl_t today_ctrl = LV_BUTTONMATRIX_CTRL_CUSTOM_1;
+inline constexpr lv_buttonmatrix_ctrl_t highlight_ctrl = LV_BUTTONMATRIX_CTRL_CUSTOM_2;
+
+/// Weekday of a date (0: first column), the formula of lv_calendar.c
+[[nodiscard]] inline uint32_t day_of_week(uint32_t year, uint32_t month, uint32_t day) noexcept {
+    const uint32_t a = month < 3 ? 1 : 0;
+    const uint32_t b = year - a;
+    const uint32_t d = day + (31 * (month - 2 + 12 * a) / 12) + b + (b / 4) - (b / 100) + (b / 400);
+#if LV_CALENDAR_WEEK_STARTS_MONDAY
+    return (d - 1) % 7;
+#else
+    return d % 7;
+#endif
+}
+
+[[nodiscard]] inline uint32_t month_length(int32_t year, int32_t month) noexcept {
+    if (month < 1) {
+        --year;
+        month += 12;
+    } else if (month > 12) {
+        ++year;
+        month -= 12;
+    }
+    const bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    return month == 2 ? 28u + leap : 31u - static_cast<uint32_t>(month - 1) % 7 % 2;
+}
+
+[[nodiscard]] inline Stats& stats() noexcept {
+    static Stats s;
+    return s;
+}
+
+/// Today and highlighted cells of the shown month, one bit per cell
+struct Marks {
+    uint64_t today = 0;
+    uint64_t highlight = 0;
+
+    [[nodiscard]] lv_buttonmatrix_ctrl_t at(uint32_t cell) const noexcept {
+        return static_cast<lv_buttonmatrix_ctrl_t>(((today >> cell) & 1 ? today_ctrl : 0) |
+                                                   ((highlight >> cell) & 1 ? highlight_ctrl : 0));
+    }
+};
+
+[[nodiscard]] inline Marks marks(lv_obj_t* cal, uint32_t first, uint32_t length) noexcept {
+    const lv_calendar_date_t* shown = lv_calendar_get_showed_date(cal);
+    const uint32_t y = shown->year, m = shown->month;
+    const auto cell = [&](const lv_calendar_date_t& d) -> uint64_t {
+        if (d.year != y || static_cast<uint32_t>(d.month) != m || d.day < 1 || static_cast<uint32_t>(d.day) > length) {
+            return 0;
+        }
+        return uint64_t{1} << (first + static_cast<uint32_t>(d.day) - 1);
+    };
+    Marks r;
+    r.today = cell(*lv_calendar_get_today_date(cal));
+    const lv_calendar_date_t* dates = lv_calendar_get_highlighted_dates(cal);
+    const size_t count = lv_calendar_get_highlighted_dates_num(cal);
+    for (size_t i = 0; dates && i < count; ++i) r.highlight |= cell(dates[i]);
+    return r;
+}
+
+#if LV_USE_CALENDAR_HEADER_ARROW
+/// Arrow header relabel in the calendar's language, after LVGL's own handler
+inline void arrow_header_cb(lv_event_t* e) {
+    auto* loc = static_cast<const CalendarLocale*>(lv_event_get_user_data(e));
+    lv_obj_t* header = lv_event_get_current_target_obj(e);
+    lv_obj_t* label = lv_obj_get_child(header, 1);
+    const lv_calendar_date_t* d = lv_calendar_get_showed_date(lv_obj_get_parent(header));
+    if (!label || !d) return;
+    if (loc->year_first()) {
+        lv_label_set_text_fmt(label, "%d %s", static_cast<int>(d->year), loc->month(d->month));
+    } else {
+        lv_label_set_text_fmt(label, "%s %d", loc->month(d->month), static_cast<int>(d->year));
+    }
+}
+#endif
+
+} // namespace detail
+
+[[nodiscard]] inline Stats stats() noexcept { return detail::stats(); }
+inline void reset_stats() noexcept { detail::stats() = Stats{}; }
+
+} // namespace calendar
+
 /**
  * @brief Calendar widget wrapper
  *
@@ -38,8 +206,15 @@ public:
 
     // ==================== Date ====================
 
-    /// Set currently shown date (month/year view)
+    /// Set currently shown date (month/year view); an unchanged month costs nothing
     Calendar& shown_date(uint32_t year, uint32_t month) noexcept {
+        calendar::Stats& st = calendar::detail::stats();
+        ++st.shows;
+        const lv_calendar_date_t* d = lv_calendar_get_showed_date(m_obj);
+        if (d && d->year == year && d->month == month) {
+            ++st.unchanged;
+            return *this;
+        }
         lv_calendar_set_showed_date(m_obj, year, month);
         return *this;
     }
@@ -83,6 +258,57 @@ public:
         return lv_calendar_get_highlighted_dates_num(m_obj);
     }
 
+    /**
+     * @brief Re-read today and the highlighted dates array after changing it in place
+     *
+     * Only day buttons whose highlight or today mark changes are updated
+     * and invalidated.
+     */
+    Calendar& refresh_highlights() noexcept {
+        const lv_calendar_date_t* shown = lv_calendar_get_showed_date(m_obj);
+        if (shown->month < 1 || shown->month > 12) {
+            lv_calendar_set_highlighted_dates(m_obj, const_cast<lv_calendar_date_t*>(lv_calendar_get_highlighted_dates(m_obj)),
+                                              lv_calendar_get_highlighted_dates_num(m_obj));
+            return *this;
+        }
+        const uint32_t first = calendar::detail::day_of_week(shown->year, shown->month, 1);
+        const uint32_t length = calendar::detail::month_length(shown->year, shown->month);
+        const calendar::detail::Marks marks = calendar::detail::marks(m_obj, first, length);
+        lv_obj_t* btnm = lv_calendar_get_btnmatrix(m_obj);
+        for (uint32_t cell = first; cell < first + length; ++cell) {
+            const lv_buttonmatrix_ctrl_t want = marks.at(cell);
+            lv_buttonmatrix_ctrl_t has = 0;
+            if (lv_buttonmatrix_has_button_ctrl(btnm, cell + 7, calendar::detail::today_ctrl)) {
+                has |= calendar::detail::today_ctrl;
+            }
+            if (lv_buttonmatrix_has_button_ctrl(btnm, cell + 7, calendar::detail::highlight_ctrl)) {
+                has |= calendar::detail::highlight_ctrl;
+            }
+            if (has & ~want) lv_buttonmatrix_clear_button_ctrl(btnm, cell + 7, static_cast<lv_buttonmatrix_ctrl_t>(has & ~want));
+            if (want & ~has) lv_buttonmatrix_set_button_ctrl(btnm, cell + 7, static_cast<lv_buttonmatrix_ctrl_t>(want & ~has));
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Highlight or clear one day of the shown month by its button
+     *
+     * The highlighted dates array is not changed, so the mark lasts until
+     * the month changes or refresh_highlights() re-reads the array.
+     */
+    Calendar& highlight_day(uint32_t day, bool on) noexcept {
+        const lv_calendar_date_t* shown = lv_calendar_get_showed_date(m_obj);
+        if (day < 1 || day > calendar::detail::month_length(shown->year, shown->month)) return *this;
+        const uint32_t btn = calendar::detail::day_of_week(shown->year, shown->month, 1) + day - 1 + 7;
+        lv_obj_t* btnm = lv_calendar_get_btnmatrix(m_obj);
+        if (on) {
+            lv_buttonmatrix_set_button_ctrl(btnm, btn, calendar::detail::highlight_ctrl);
+        } else {
+            lv_buttonmatrix_clear_button_ctrl(btnm, btn, calendar::detail::highlight_ctrl);
+        }
+        return *this;
+    }
+
     // ==================== Day Names ====================
 
     /// Set custom day names (array of 7 strings, must remain valid)
@@ -91,6 +317,36 @@ public:
         return *this;
     }
 
+    /**
+     * @brief Use a language's day and month names, here and in existing headers
+     *
+     * Call after creating the header; the locale must outlive the calendar.
+     */
+    Calendar& locale(const CalendarLocale& loc) noexcept {
+        lv_calendar_set_day_names(m_obj, const_cast<const char**>(loc.days()));
+        const uint32_t n = lv_obj_get_child_count(m_obj);
+        for (uint32_t i = 0; i < n; ++i) {
+            lv_obj_t* child = lv_obj_get_child(m_obj, static_cast<int32_t>(i));
+#if LV_USE_CALENDAR_HEADER_ARROW
+            if (lv_obj_check_type(child, &lv_calendar_header_arrow_class)) {
+                lv_obj_remove_event_cb(child, &calendar::detail::arrow_header_cb);
+                lv_obj_add_event_cb(child, &calendar::detail::arrow_header_cb, LV_EVENT_VALUE_CHANGED,
+                                    const_cast<CalendarLocale*>(&loc));
+                lv_obj_send_event(child, LV_EVENT_VALUE_CHANGED, m_obj);
+            }
+#endif
+#if LV_USE_CALENDAR_HEADER_DROPDOWN
+            if (lv_obj_check_type(child, &lv_calendar_header_dropdown_class)) {
+                lv_obj_t* month_dd = lv_obj_get_child(child, 1);
+                const uint32_t sel = lv_dropdown_get_selected(month_dd);
+                lv_dropdown_set_options_static(month_dd, loc.month_options());
+                lv_dropdown_set_selected(month_dd, sel);
+            }
+#endif
+        }
+        return *this;
+    }
+
     // ==================== Header ====================
 
     /// Add header with month/year and navigation arrows
@@ -113,3 +369,5 @@ public:
 };
 
 } // namespace lv
+
+#endif // LV_USE_CALENDAR
@@ -0,0 +1,172 @@
+#pragma once
+
+/**
+ * @file calendar_months.hpp
+ * @brief Calendar month changes from an LRU of printed month grids (opt-in)
+ *
+ * Calendar::shown_date() skips an unchanged month, but a new one still
+ * goes through lv_calendar_set_showed_date(): 42 day numbers printed, then
+ * the disabled, today and highlight bits set button by button, each call
+ * invalidating its button. show() copies the day numbers from a small LRU
+ * of month grids (LV_CPP_CALENDAR_MONTHS, shared by all calendars), writes
+ * the button bits in one pass and invalidates the grid once:
+ *
+ * @code
+ * #include <lv/widgets/calendar_months.hpp>
+ *
+ * lv::calendar_months::show(cal, 2026, 3);   // swipe handlers call this per month
+ * @endcode
+ *
+ * Calendars showing Chinese calendar days (LV_USE_CALENDAR_CHINESE) go
+ * through LVGL's own path.
+ *
+ * Not included by lv.hpp: it writes lv_calendar_t's nums and showed_date
+ * and the button matrix's ctrl_bits, none of which is public. Checked
+ * against LVGL 9.4 (see LV_CPP_INTERNALS_OK).
+ *
+ * Heap allocation: NONE (the month LRU is static)
+ */
+
+#include <lvgl.h>
+#include "../core/version.hpp"
+
+#if LV_USE_CALENDAR
+
+#if !LV_CPP_INTERNALS_OK
+#error "calendar_months.hpp reads LVGL internals checked against LVGL 9.4; see LV_CPP_INTERNALS_OK"
+#endif
+
+#include <src/widgets/calendar/lv_calendar_private.h>          // nums, showed_date
+#include <src/widgets/buttonmatrix/lv_buttonmatrix_private.h>  // ctrl_bits, btn_cnt
+#include <cstring>
+#include "calendar.hpp"
+
+#ifndef LV_CPP_CALENDAR_MONTHS
+/// Month grids kept by the calendar LRU
+#define LV_CPP_CALENDAR_MONTHS 6
+#endif
+
+namespace lv::calendar_months {
+
+struct Stats {
+    uint32_t hits = 0;        ///< Month grids taken from the LRU
+    uint32_t misses = 0;      ///< Month grids printed
+};
+
+namespace detail {
+
+struct Month {
+    uint32_t year = 0;
+    uint32_t month = 0;       ///< 0: free entry
+    uint32_t first = 0;       ///< Cell of day 1
+    uint32_t length = 0;
+    uint32_t used = 0;        ///< LRU clock
+    char nums[6 * 7][4] = {};
+};
+
+struct Cache {
+    Month months[LV_CPP_CALENDAR_MONTHS];
+    uint32_t clock = 0;
+    Stats stats;
+};
+
+[[nodiscard]] inline Cache& cache() noexcept {
+    static Cache c;
+    return c;
+}
+
+/// The grid of a month, printed on a miss into the least recently used entry
+[[nodiscard]] inline const Month& month(uint32_t year, uint32_t mon) noexcept {
+    using lv::calendar::detail::day_of_week;
+    using lv::calendar::detail::month_length;
+    Cache& c = cache();
+    Month* lru = &c.months[0];
+    for (Month& m : c.months) {
+        if (m.month == mon && m.year == year) {
+            m.used = ++c.clock;
+            ++c.stats.hits;
+            return m;
+        }
+        if (m.used < lru->used) lru = &m;
+    }
+    ++c.stats.misses;
+    Month& m = *lru;
+    m.year = year;
+    m.month = mon;
+    m.first = day_of_week(year, mon, 1);
+    m.length = month_length(static_cast<int32_t>(year), static_cast<int32_t>(mon));
+    m.used = ++c.clock;
+    const uint32_t prev = month_length(static_cast<int32_t>(year), static_cast<int32_t>(mon) - 1);
+    for (uint32_t i = 0; i < 6 * 7; ++i) {
+        const uint32_t day = i < m.first ? prev - m.first + i + 1
+                           : i < m.first + m.length ? i - m.first + 1
+                                                    : i - m.first - m.length + 1;
+        lv_snprintf(m.nums[i], sizeof(m.nums[i]), "%u", static_cast<unsigned>(day));
+    }
+    return m;
+}
+
+[[nodiscard]] inline bool chinese([[maybe_unused]] const lv_calendar_t* c) noexcept {
+#if LV_USE_CALENDAR_CHINESE
+    return c->use_chinese_calendar;
+#else
+    return false;
+#endif
+}
+
+/// Tell the headers (every child but the grid) the shown month changed, as LVGL does
+inline void notify_headers(lv_calendar_t* c) noexcept {
+    auto* obj = reinterpret_cast<lv_obj_t*>(c);
+    const uint32_t n = lv_obj_get_child_count(obj);
+    for (uint32_t i = 0; i < n; ++i) {
+        lv_obj_t* child = lv_obj_get_child(obj, static_cast<int32_t>(i));
+        if (child != c->btnm) lv_obj_send_event(child, LV_EVENT_VALUE_CHANGED, obj);
+    }
+}
+
+} // namespace detail
+
+/// Calendar::shown_date() with new months copied from the LRU (see the file comment)
+inline void show(Calendar cal, uint32_t year, uint32_t month) noexcept {
+    auto* c = reinterpret_cast<lv_calendar_t*>(cal.get());
+    if ((c->showed_date.year == year && c->showed_date.month == month) || detail::chinese(c)
+        || month < 1 || month > 12) {
+        cal.shown_date(year, month);
+        return;
+    }
+    ++lv::calendar::detail::stats().shows;
+    const detail::Month& grid = detail::month(year, month);
+    c->showed_date.year = static_cast<decltype(c->showed_date.year)>(year);
+    c->showed_date.month = static_cast<decltype(c->showed_date.month)>(month);
+    c->showed_date.day = 1;
+    static_assert(sizeof(c->nums) == sizeof(grid.nums), "lv_calendar_t::nums layout changed");
+    std::memcpy(c->nums, grid.nums, sizeof(grid.nums));
+
+    using lv::calendar::detail::today_ctrl;
+    using lv::calendar::detail::highlight_ctrl;
+    const lv::calendar::detail::Marks marks = lv::calendar::detail::marks(cal.get(), grid.first, grid.length);
+    auto* btnm = reinterpret_cast<lv_buttonmatrix_t*>(c->btnm);
+    constexpr lv_buttonmatrix_ctrl_t cleared = LV_BUTTONMATRIX_CTRL_DISABLED | today_ctrl | highlight_ctrl;
+    for (uint32_t i = 7; i < btnm->btn_cnt; ++i) {
+        const uint32_t cell = i - 7;
+        lv_buttonmatrix_ctrl_t bits = btnm->ctrl_bits[i] & ~cleared;
+        if (cell < grid.first || cell >= grid.first + grid.length) {
+            bits |= LV_BUTTONMATRIX_CTRL_DISABLED;
+        } else {
+            bits |= marks.at(cell);
+        }
+        btnm->ctrl_bits[i] = bits;
+    }
+    if (lv_buttonmatrix_get_selected_button(c->btnm) != LV_BUTTONMATRIX_BUTTON_NONE) {
+        lv_buttonmatrix_set_selected_button(c->btnm, grid.first + 7);
+    }
+    lv_obj_invalidate(cal.get());
+    detail::notify_headers(c);
+}
+
+[[nodiscard]] inline Stats stats() noexcept { return detail::cache().stats; }
+inline void reset_stats() noexcept { detail::cache().stats = Stats{}; }
+
+} // namespace lv::calendar_months
+
+#endif // LV_USE_CALENDAR
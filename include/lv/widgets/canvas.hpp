@@ -17,17 +17,52 @@
  * lv::draw::line(layer, line_dsc);
  * canvas.finish_layer(layer);
  * ```
+ *
+ * Many primitives per frame: begin() from <lv/draw/canvas_session.hpp>
+ * records them and submits one layer with one invalidation.
  */
 
 #include <lvgl.h>
+#include <span>
 #include "../core/object.hpp"
 #include "../core/event.hpp"
 #include "../core/style.hpp"
 
 namespace lv {
 
-// Forward declaration
+// Forward declarations
 class Layer;
+class CanvasSession;
+
+namespace detail {
+
+/// Back-buffer hooks installed by canvas_flip.hpp (nullptr: no canvas double-buffered yet)
+struct CanvasFlipHooks {
+    /// Set `layer` up over the canvas's back buffer; false if it has none
+    bool (*init_layer)(lv_obj_t* canvas, lv_layer_t& layer) = nullptr;
+    /// Remember `area` (canvas buffer coordinates) as changed in the back buffer
+    void (*mark)(lv_obj_t* canvas, const lv_area_t& area) = nullptr;
+};
+
+[[nodiscard]] inline CanvasFlipHooks& canvas_flip_hooks() noexcept {
+    static CanvasFlipHooks hooks;
+    return hooks;
+}
+
+/// Canvas buffer area `a` on screen (the whole canvas if the widget is not its buffer's size)
+inline void canvas_invalidate(lv_obj_t* canvas, const lv_draw_buf_t* buf, lv_area_t a) noexcept {
+    lv_area_t content;
+    lv_obj_get_content_coords(canvas, &content);
+    if (lv_area_get_width(&content) == static_cast<int32_t>(buf->header.w) &&
+        lv_area_get_height(&content) == static_cast<int32_t>(buf->header.h)) {
+        lv_area_move(&a, content.x1, content.y1);
+        lv_obj_invalidate_area(canvas, &a);
+    } else {
+        lv_obj_invalidate(canvas);
+    }
+}
+
+} // namespace detail
 
 /**
  * @brief Canvas widget wrapper
@@ -84,6 +119,22 @@ public:
         return lv_canvas_get_px(m_obj, x, y);
     }
 
+    /**
+     * @brief Row `y` of a 32-bit (ARGB8888/XRGB8888) buffer, for the lv::color batch functions
+     *
+     * Empty for other formats or rows outside the buffer. Writing through
+     * it bypasses LVGL: invalidate the canvas afterwards.
+     */
+    [[nodiscard]] std::span<lv_color32_t> row32(int32_t y) const noexcept {
+        lv_draw_buf_t* buf = lv_canvas_get_draw_buf(m_obj);
+        if (!buf || lv_color_format_get_size(static_cast<lv_color_format_t>(buf->header.cf)) != 4 || y < 0 ||
+            y >= static_cast<int32_t>(buf->header.h)) {
+            return {};
+        }
+        return {reinterpret_cast<lv_color32_t*>(buf->data + static_cast<size_t>(y) * buf->header.stride),
+                buf->header.w};
+    }
+
     /// Set palette color (for indexed formats)
     Canvas& set_palette(uint8_t index, lv_color32_t color) noexcept {
         lv_canvas_set_palette(m_obj, index, color);
@@ -120,6 +171,17 @@ public:
         lv_canvas_finish_layer(m_obj, layer.get());
     }
 
+    /// Record draws and submit them in one layer (defined in draw/canvas_session.hpp)
+    [[nodiscard]] CanvasSession begin() noexcept;
+
+    /// Same, redrawing only `region` (canvas buffer coordinates)
+    [[nodiscard]] CanvasSession begin(const lv_area_t& region) noexcept;
+
+    /// Draw into a pooled back buffer flipped at the next refresh (defined in draw/canvas_flip.hpp, opt-in)
+    bool double_buffer(bool on = true) noexcept;
+
+    [[nodiscard]] bool double_buffered() const noexcept;
+
     /// Get image descriptor
     [[nodiscard]] lv_image_dsc_t* get_image() const noexcept {
         return lv_canvas_get_image(m_obj);
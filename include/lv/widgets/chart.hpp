@@ -3,9 +3,17 @@
 /**
  * @file chart.hpp
  * @brief Zero-cost wrapper for LVGL chart widget
+ *
+ * Besides the lv_chart API, Chart::append() adds a batch of points with
+ * one invalidation, Chart::mark_dirty() redraws only the columns of points
+ * changed in place, and Chart::bind_ring() draws a series straight from a
+ * ChartRing filled by another thread.
  */
 
 #include <lvgl.h>
+#include <atomic>
+#include <cstdint>
+#include <span>
 #include "../core/version.hpp"
 #include "../core/object.hpp"
 #include "../core/event.hpp"
@@ -13,6 +21,187 @@
 
 namespace lv {
 
+class Chart;
+
+namespace detail {
+
+/// Invalidate the columns of display positions [a, b] plus one either side (line segments, bar width)
+inline void chart_invalidate_columns(lv_obj_t* chart, lv_chart_series_t* ser, uint32_t a, uint32_t b) noexcept {
+    const uint32_t n = lv_chart_get_point_count(chart);
+    lv_point_t p0, p1;
+    lv_chart_get_point_pos_by_id(chart, ser, a > 0 ? a - 1 : 0, &p0);
+    lv_chart_get_point_pos_by_id(chart, ser, b + 1 < n ? b + 1 : n - 1, &p1);
+    const int32_t pad = lv_obj_get_style_line_width(chart, LV_PART_ITEMS) +
+                        lv_obj_get_style_width(chart, LV_PART_INDICATOR) / 2 +
+                        lv_obj_get_content_width(chart) / static_cast<int32_t>(n) + 1;
+    lv_area_t area;
+    lv_obj_get_coords(chart, &area);
+    const int32_t x0 = area.x1;
+    const bool rtl = p1.x < p0.x;
+    area.x1 = x0 + (rtl ? p1.x : p0.x) - pad;
+    area.x2 = x0 + (rtl ? p0.x : p1.x) + pad;
+    lv_obj_invalidate_area(chart, &area);
+}
+
+/// Invalidate what changes when array points [first, last] of `ser` change
+inline void chart_mark_dirty(lv_obj_t* chart, lv_chart_series_t* ser, uint32_t first, uint32_t last) noexcept {
+    const uint32_t n = lv_chart_get_point_count(chart);
+    if (n == 0 || first > last || first >= n) return;
+    if (last >= n) last = n - 1;
+    if (n < 3 || last - first + 2 >= n || lv_chart_get_type(chart) == LV_CHART_TYPE_SCATTER) {
+        lv_obj_invalidate(chart);
+        return;
+    }
+    uint32_t a = first, b = last;
+    if (lv_chart_get_update_mode(chart) == LV_CHART_UPDATE_MODE_SHIFT) {
+        // Shift mode draws the array starting at the start point
+        const uint32_t start = lv_chart_get_x_start_point(chart, ser);
+        a = (first + n - start) % n;
+        b = (last + n - start) % n;
+        if (b < a) {
+            chart_invalidate_columns(chart, ser, a, n - 1);
+            chart_invalidate_columns(chart, ser, 0, b);
+            return;
+        }
+    }
+    chart_invalidate_columns(chart, ser, a, b);
+}
+
+/**
+ * @brief Invalidate after `count` points were written from array index `from`
+ *
+ * In circular mode only the written points and the new start point (the
+ * sweep gap) are redrawn; in shift mode every point moved.
+ */
+inline void chart_mark_written(lv_obj_t* chart, lv_chart_series_t* ser, uint32_t from, uint32_t count) noexcept {
+    const uint32_t n = lv_chart_get_point_count(chart);
+    if (lv_chart_get_update_mode(chart) != LV_CHART_UPDATE_MODE_CIRCULAR || count + 1 >= n) {
+        lv_obj_invalidate(chart);
+        return;
+    }
+    const uint32_t last = from + count;    // the new start point
+    if (last < n) {
+        chart_mark_dirty(chart, ser, from, last);
+    } else {
+        chart_mark_dirty(chart, ser, from, n - 1);
+        chart_mark_dirty(chart, ser, 0, last - n);
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Sample ring that a chart series draws from without copying
+ *
+ * One producer thread calls push(); the chart uses the ring's array as
+ * its external Y array (Chart::bind_ring()). A timer on the UI thread
+ * moves the series start point to the oldest sample and invalidates the
+ * chart when new samples arrived, at most once per period, however fast
+ * they come in (in circular mode only the columns of the new samples). Samples are plain int32 stores read by the renderer
+ * without a lock: one written while the chart draws shows up in that
+ * frame or the next.
+ *
+ * Non-movable: the timer and the chart's delete event keep a pointer to it.
+ * Heap allocation: NONE (the samples are part of the object)
+ *
+ * @tparam Points Samples kept and chart point count (power of two)
+ */
+template<uint32_t Points>
+class ChartRing {
+    static_assert(Points > 0 && (Points & (Points - 1)) == 0, "ChartRing size must be a power of two");
+
+    int32_t m_data[Points] = {};
+    std::atomic<uint32_t> m_head{0};    ///< Samples pushed (wraps)
+    lv_obj_t* m_chart = nullptr;
+    lv_chart_series_t* m_series = nullptr;
+    lv_timer_t* m_timer = nullptr;
+    uint32_t m_shown = 0;
+
+    friend class Chart;
+
+    static void timer_cb(lv_timer_t* t) noexcept {
+        static_cast<ChartRing*>(lv_timer_get_user_data(t))->sync();
+    }
+
+    static void chart_delete_cb(lv_event_t* e) noexcept {
+        auto* self = static_cast<ChartRing*>(lv_event_get_user_data(e));
+        if (self->m_timer) lv_timer_delete(self->m_timer);
+        self->m_timer = nullptr;
+        self->m_chart = nullptr;
+        self->m_series = nullptr;
+    }
+
+    void attach(lv_obj_t* chart, lv_chart_series_t* series, uint32_t period) noexcept {
+        detach();
+        m_chart = chart;
+        m_series = series;
+        m_shown = m_head.load(std::memory_order_acquire);
+        lv_obj_add_event_cb(chart, &ChartRing::chart_delete_cb, LV_EVENT_DELETE, this);
+        m_timer = lv_timer_create(&ChartRing::timer_cb, period, this);
+        lv_chart_set_x_start_point(chart, series, m_shown & (Points - 1));
+        lv_obj_invalidate(chart);
+    }
+
+public:
+    ChartRing() noexcept = default;
+
+    ~ChartRing() {
+        detach();
+    }
+
+    ChartRing(const ChartRing&) = delete;
+    ChartRing& operator=(const ChartRing&) = delete;
+
+    // ==================== Producer ====================
+
+    /// Add one sample (single producer, any thread)
+    void push(int32_t value) noexcept {
+        const uint32_t head = m_head.load(std::memory_order_relaxed);
+        m_data[head & (Points - 1)] = value;
+        m_head.store(head + 1, std::memory_order_release);
+    }
+
+    /// Add a batch of samples; only the last Points are kept
+    void push(std::span<const int32_t> values) noexcept {
+        uint32_t head = m_head.load(std::memory_order_relaxed);
+        if (values.size() > Points) {
+            head += static_cast<uint32_t>(values.size() - Points);
+            values = values.last(Points);
+        }
+        for (int32_t v : values) m_data[head++ & (Points - 1)] = v;
+        m_head.store(head, std::memory_order_release);
+    }
+
+    // ==================== UI thread ====================
+
+    /// Show the samples pushed so far now instead of on the next timer tick
+    void sync() noexcept {
+        if (!m_chart) return;
+        const uint32_t head = m_head.load(std::memory_order_acquire);
+        if (head == m_shown) return;
+        const uint32_t fresh = head - m_shown;
+        const uint32_t from = m_shown & (Points - 1);
+        m_shown = head;
+        lv_chart_set_x_start_point(m_chart, m_series, head & (Points - 1));
+        detail::chart_mark_written(m_chart, m_series, from, fresh < Points ? fresh : Points);
+    }
+
+    /// Stop updating the chart (it keeps drawing the array as it is)
+    void detach() noexcept {
+        if (m_timer) lv_timer_delete(m_timer);
+        m_timer = nullptr;
+        if (m_chart) lv_obj_remove_event_cb_with_user_data(m_chart, &ChartRing::chart_delete_cb, this);
+        m_chart = nullptr;
+        m_series = nullptr;
+    }
+
+    [[nodiscard]] int32_t* data() noexcept { return m_data; }
+    [[nodiscard]] static constexpr uint32_t capacity() noexcept { return Points; }
+
+    /// Samples pushed so far (wraps at 2^32)
+    [[nodiscard]] uint32_t written() const noexcept { return m_head.load(std::memory_order_acquire); }
+};
+
 /**
  * @brief Chart widget wrapper
  *
@@ -123,12 +312,71 @@ public:
         return *this;
     }
 
-    /// Set next value in series
+    /// Set next value in series (invalidates the chart; see append() for batches)
     Chart& set_next_value(lv_chart_series_t* series, int32_t value) noexcept {
         lv_chart_set_next_value(m_obj, series, value);
         return *this;
     }
 
+    /**
+     * @brief Append values to a line or bar series with one invalidation
+     *
+     * Same result as set_next_value() for each value, which invalidates
+     * the chart per call. Values beyond point_count() only advance the
+     * start point. In circular mode only the columns written are redrawn.
+     */
+    Chart& append(lv_chart_series_t* series, std::span<const int32_t> values) noexcept {
+        const uint32_t n = lv_chart_get_point_count(m_obj);
+        if (n == 0 || values.empty()) return *this;
+        int32_t* y = lv_chart_get_series_y_array(m_obj, series);
+        uint32_t at = lv_chart_get_x_start_point(m_obj, series);
+        if (values.size() > n) {
+            at = static_cast<uint32_t>((at + (values.size() - n)) % n);
+            values = values.last(n);
+        }
+        const uint32_t from = at;
+        for (int32_t v : values) {
+            y[at] = v;
+            if (++at == n) at = 0;
+        }
+        lv_chart_set_x_start_point(m_obj, series, at);
+        detail::chart_mark_written(m_obj, series, from, static_cast<uint32_t>(values.size()));
+        return *this;
+    }
+
+    /**
+     * @brief Redraw only points [first, last] of `series` after writing its array
+     *
+     * Use instead of refresh() after changing values in place (e.g. in an
+     * external array): invalidates the x-span of those points plus the
+     * segments joining their neighbours, over the full chart height.
+     * Indices are array indices; in shift mode they are mapped through the
+     * start point. Scatter charts and spans covering almost every point
+     * invalidate the whole chart.
+     */
+    Chart& mark_dirty(lv_chart_series_t* series, uint32_t first, uint32_t last) noexcept {
+        detail::chart_mark_dirty(m_obj, series, first, last);
+        return *this;
+    }
+
+    /**
+     * @brief Draw `series` from `ring` without copying
+     *
+     * Sets the chart's point count to Points (for every series) and the
+     * ring's array as the series' external Y array. The ring then moves
+     * the start point and invalidates the chart from a timer every
+     * `period` ms while samples come in, until the chart is deleted or
+     * ring.detach(). Use update_shift() to scroll, update_circular() to sweep.
+     */
+    template<uint32_t Points>
+    Chart& bind_ring(lv_chart_series_t* series, ChartRing<Points>& ring,
+                     uint32_t period = LV_DEF_REFR_PERIOD) noexcept {
+        lv_chart_set_point_count(m_obj, Points);
+        lv_chart_set_ext_y_array(m_obj, series, ring.data());
+        ring.attach(m_obj, series, period);
+        return *this;
+    }
+
     /// Set value at index
     Chart& set_value_by_id(lv_chart_series_t* series, uint32_t id, int32_t value) noexcept {
         lv_chart_set_value_by_id(m_obj, series, id, value);
@@ -0,0 +1,350 @@
+#pragma once
+
+/**
+ * @file chart_curves.hpp
+ * @brief Smooth chart series drawn from a cached vector path
+ *
+ * A curve chart (LV_CHART_TYPE_CURVE on LVGL 9.5) builds a new vector
+ * path for every series on every redraw: one cubic per segment, allocated
+ * and grown point by point, then tessellated. With live data that is the
+ * whole series per frame for one new sample. ChartCurves draws one series
+ * from a path it keeps:
+ *
+ * @code
+ * #include <lv/widgets/chart_curves.hpp>
+ *
+ * static lv::ChartCurves curve;
+ * curve.attach(chart, ser);                           // LVGL's own drawing of `ser` is hidden
+ * curve.quality(LV_VECTOR_PATH_QUALITY_HIGH);         // for sparse points
+ * ...
+ * chart.set_value_by_id(ser, 17, adc);                // two segments are recomputed
+ * @endcode
+ *
+ * Each segment is a cubic with horizontal tangents at both points, so a
+ * point only shapes its two neighbouring segments and a curve never
+ * leaves the y range of its points (Chart::mark_dirty() areas stay
+ * valid). On each draw the series values are compared with the ones the
+ * path was built from, and only the segments next to changed points get
+ * new coordinates, written in place. The path is rebuilt from scratch
+ * when the geometry changes: size, padding, scroll, point count, axis
+ * range, the start point in shift mode (every point moves), or points
+ * appearing or vanishing (LV_CHART_POINT_NONE gaps).
+ *
+ * The curve detail follows the point density. Points closer than
+ * line_below() pixels are joined by straight lines (nothing to tessellate,
+ * and a curve would not look different). Up to 12 px apart the path
+ * quality is LOW, up to 32 px at most MEDIUM, and the set quality() above.
+ *
+ * Stroke width and opacity come from the chart's LV_PART_ITEMS line
+ * styles, the color from the series. For line and curve charts.
+ *
+ * Not included by lv.hpp: it reads lv_chart_t's axis ranges, point count
+ * and update mode, the series' start point and axis, writes the path's
+ * quality and points in place (lv_vector_path_t is not public) and
+ * narrows lv_layer_t::_clip_area. Checked against LVGL 9.4 (see
+ * LV_CPP_INTERNALS_OK).
+ *
+ * Heap allocation: a copy of the series values (lv_malloc, one int32_t
+ * per point) and LVGL's path storage, reused across rebuilds
+ */
+
+#include <lvgl.h>
+#include "../core/version.hpp"
+
+#if LV_USE_CHART && LV_USE_VECTOR_GRAPHIC
+
+#if !LV_CPP_INTERNALS_OK
+#error "chart_curves.hpp reads LVGL internals checked against LVGL 9.4; see LV_CPP_INTERNALS_OK"
+#endif
+
+#include <src/widgets/chart/lv_chart_private.h>   // lv_chart_t::ymin/ymax, lv_chart_series_t::y_axis_sec
+#include <src/draw/lv_draw_vector_private.h>      // lv_vector_path_t quality, ops, points
+#include <src/draw/lv_draw_private.h>             // lv_layer_t::_clip_area
+#include <cstdint>
+#include "chart.hpp"
+#include "../draw/draw_vector.hpp"
+
+namespace lv {
+
+/**
+ * @brief Draws a chart series as a smooth curve from a path updated in place
+ *
+ * Non-movable: the chart's draw and delete events keep a pointer to it.
+ */
+class ChartCurves {
+public:
+    struct Stats {
+        uint32_t draws = 0;
+        uint32_t rebuilds = 0;    ///< Paths built from scratch
+        uint32_t segments = 0;    ///< Segments given new coordinates in place
+        uint32_t reused = 0;      ///< Segments drawn as they were
+    };
+
+private:
+    /// What every point position depends on besides its value
+    struct Geometry {
+        int32_t w = 0, h = 0;       ///< Content size
+        int32_t ox = 0, oy = 0;     ///< Content offset in the chart
+        int32_t sx = 0, sy = 0;     ///< Scroll
+        int32_t ymin = 0, ymax = 0;
+        uint32_t points = 0;
+        uint32_t start = 0;         ///< Start point in shift mode
+
+        [[nodiscard]] bool operator==(const Geometry&) const noexcept = default;
+    };
+
+    lv_obj_t* m_chart = nullptr;
+    lv_chart_series_t* m_series = nullptr;
+    lv_vector_path_t* m_path = nullptr;
+    int32_t* m_values = nullptr;  ///< Values the path was built from, in array order
+    uint32_t m_capacity = 0;
+    Geometry m_geo;
+    bool m_valid = false;
+    bool m_lines = false;         ///< Straight segments (dense points)
+    bool m_gaps = false;          ///< LV_CHART_POINT_NONE in the series
+    lv_vector_path_quality_t m_quality = LV_VECTOR_PATH_QUALITY_MEDIUM;
+    int32_t m_line_below = 4;
+    Stats m_stats;
+
+    static void draw_cb(lv_event_t* e) noexcept {
+        static_cast<ChartCurves*>(lv_event_get_user_data(e))->draw(lv_event_get_layer(e));
+    }
+
+    static void delete_cb(lv_event_t* e) noexcept {
+        auto* self = static_cast<ChartCurves*>(lv_event_get_user_data(e));
+        self->m_chart = nullptr;
+        self->m_series = nullptr;
+        self->m_valid = false;
+    }
+
+    [[nodiscard]] Geometry geometry() const noexcept {
+        const auto* c = reinterpret_cast<const lv_chart_t*>(m_chart);
+        lv_area_t coords, content;
+        lv_obj_get_coords(m_chart, &coords);
+        lv_obj_get_content_coords(m_chart, &content);
+        Geometry g;
+        g.w = lv_area_get_width(&content);
+        g.h = lv_area_get_height(&content);
+        g.ox = content.x1 - coords.x1;
+        g.oy = content.y1 - coords.y1;
+        g.sx = lv_obj_get_scroll_x(m_chart);
+        g.sy = lv_obj_get_scroll_y(m_chart);
+        g.ymin = c->ymin[m_series->y_axis_sec];
+        g.ymax = c->ymax[m_series->y_axis_sec];
+        g.points = c->point_cnt;
+        g.start = c->update_mode == LV_CHART_UPDATE_MODE_SHIFT ? m_series->start_point : 0;
+        return g;
+    }
+
+    /// Position of display point `id`, relative to the chart's top-left
+    [[nodiscard]] FPoint pos(uint32_t id) const noexcept {
+        lv_point_t p;
+        lv_chart_get_point_pos_by_id(m_chart, m_series, id, &p);
+        return fpoint(static_cast<float>(p.x), static_cast<float>(p.y));
+    }
+
+    [[nodiscard]] static FPoint ctrl1(const FPoint& a, const FPoint& b) noexcept {
+        return fpoint(a.x + (b.x - a.x) / 2, a.y);
+    }
+
+    [[nodiscard]] static FPoint ctrl2(const FPoint& a, const FPoint& b) noexcept {
+        return fpoint(b.x - (b.x - a.x) / 2, b.y);
+    }
+
+    /// Path quality for points `spacing` px apart
+    [[nodiscard]] lv_vector_path_quality_t quality_for(int32_t spacing) const noexcept {
+        if (spacing < 12) return LV_VECTOR_PATH_QUALITY_LOW;
+        if (spacing < 32 && m_quality == LV_VECTOR_PATH_QUALITY_HIGH) return LV_VECTOR_PATH_QUALITY_MEDIUM;
+        return m_quality;
+    }
+
+    [[nodiscard]] bool reserve(uint32_t n) noexcept {
+        if (n <= m_capacity) return true;
+        auto* v = static_cast<int32_t*>(lv_realloc(m_values, sizeof(int32_t) * n));
+        if (!v) {
+            LV_LOG_WARN("ChartCurves: out of memory for %u points", static_cast<unsigned>(n));
+            return false;
+        }
+        m_values = v;
+        m_capacity = n;
+        return true;
+    }
+
+    /// Build the whole path from `ys` (array order)
+    void rebuild(const int32_t* ys, const Geometry& g) noexcept {
+        const uint32_t n = g.points;
+        const int32_t spacing = n > 1 ? g.w / static_cast<int32_t>(n - 1) : g.w;
+        m_lines = spacing < m_line_below;
+        lv_vector_path_clear(m_path);
+        m_path->quality = quality_for(spacing);
+        m_gaps = false;
+        bool pen = false;
+        FPoint prev{};
+        for (uint32_t id = 0; id < n; ++id) {
+            const int32_t y = ys[(g.start + id) % n];
+            if (y == LV_CHART_POINT_NONE) {
+                m_gaps = true;
+                pen = false;
+                continue;
+            }
+            const FPoint p = pos(id);
+            if (!pen) {
+                lv_vector_path_move_to(m_path, &p);
+            } else if (m_lines) {
+                lv_vector_path_line_to(m_path, &p);
+            } else {
+                const FPoint c1 = ctrl1(prev, p);
+                const FPoint c2 = ctrl2(prev, p);
+                lv_vector_path_cubic_to(m_path, &c1, &c2, &p);
+            }
+            pen = true;
+            prev = p;
+        }
+        lv_memcpy(m_values, ys, sizeof(int32_t) * n);
+        m_geo = g;
+        m_valid = true;
+        ++m_stats.rebuilds;
+    }
+
+    /**
+     * @brief New coordinates for the points whose value changed and their segments
+     * @return false if the path has to be rebuilt instead
+     */
+    [[nodiscard]] bool patch(const int32_t* ys, const Geometry& g) noexcept {
+        if (m_gaps) {
+            for (uint32_t k = 0; k < g.points; ++k) {
+                if (ys[k] != m_values[k]) return false;
+            }
+            return true;
+        }
+        const uint32_t n = g.points;
+        auto* pts = static_cast<FPoint*>(lv_array_at(&m_path->points, 0));
+        const uint32_t stride = m_lines ? 1 : 3;    // points per segment
+        uint32_t touched = 0;
+        for (uint32_t k = 0; k < n; ++k) {
+            if (ys[k] == m_values[k]) continue;
+            if (ys[k] == LV_CHART_POINT_NONE) return false;
+            m_values[k] = ys[k];
+            const uint32_t id = (k + n - g.start) % n;
+            pts[id * stride] = pos(id);
+            if (m_lines) {
+                ++touched;
+                continue;
+            }
+            // The segments ending and starting at `id`
+            for (uint32_t s = id > 0 ? id - 1 : 0; s <= id && s + 1 < n; ++s) {
+                pts[3 * s + 1] = ctrl1(pts[3 * s], pts[3 * s + 3]);
+                pts[3 * s + 2] = ctrl2(pts[3 * s], pts[3 * s + 3]);
+                ++touched;
+            }
+        }
+        m_stats.segments += touched;
+        m_stats.reused += n - 1 > touched ? n - 1 - touched : 0;
+        return true;
+    }
+
+    /// Bring the path up to date with the series
+    void update() noexcept {
+        const Geometry g = geometry();
+        if (g.points == 0 || !reserve(g.points)) return;
+        const int32_t* ys = lv_chart_get_series_y_array(m_chart, m_series);
+        if (!ys) return;
+        if (!m_valid || !(g == m_geo) || !patch(ys, g)) rebuild(ys, g);
+    }
+
+    void draw(lv_layer_t* layer) noexcept {
+        if (!m_series || !m_path) return;
+        update();
+        ++m_stats.draws;
+        if (lv_array_size(&m_path->ops) < 2) return;
+        lv_area_t coords, clip;
+        lv_obj_get_coords(m_chart, &coords);
+        if (!lv_area_intersect(&clip, &coords, &layer->_clip_area)) return;
+        const lv_area_t clip_old = layer->_clip_area;
+        layer->_clip_area = clip;
+        VectorDsc dsc(layer);
+        dsc.translate(static_cast<float>(coords.x1), static_cast<float>(coords.y1))
+           .fill_opa(LV_OPA_TRANSP)
+           .stroke_color(lv_chart_get_series_color(m_chart, m_series))
+           .stroke_opa(lv_obj_get_style_line_opa(m_chart, LV_PART_ITEMS))
+           .stroke_width(static_cast<float>(lv_obj_get_style_line_width(m_chart, LV_PART_ITEMS)))
+           .stroke_cap(LV_VECTOR_STROKE_CAP_ROUND)
+           .stroke_join(LV_VECTOR_STROKE_JOIN_ROUND);
+        lv_draw_vector_dsc_add_path(dsc.get(), m_path);
+        dsc.draw();
+        layer->_clip_area = clip_old;
+    }
+
+public:
+    ChartCurves() noexcept = default;
+
+    ~ChartCurves() {
+        detach();
+        if (m_path) lv_vector_path_delete(m_path);
+        lv_free(m_values);
+    }
+
+    ChartCurves(const ChartCurves&) = delete;
+    ChartCurves& operator=(const ChartCurves&) = delete;
+
+    // ==================== Setup ====================
+
+    /// Draw `series` of `chart` from now on (LVGL's own drawing of it is hidden)
+    bool attach(Chart chart, lv_chart_series_t* series) noexcept {
+        detach();
+        if (!chart.get() || !series) return false;
+        if (!m_path) m_path = lv_vector_path_create(m_quality);
+        if (!m_path) return false;
+        m_chart = chart.get();
+        m_series = series;
+        m_valid = false;
+        lv_chart_hide_series(m_chart, m_series, true);
+        lv_obj_add_event_cb(m_chart, &ChartCurves::draw_cb, LV_EVENT_DRAW_MAIN, this);
+        lv_obj_add_event_cb(m_chart, &ChartCurves::delete_cb, LV_EVENT_DELETE, this);
+        lv_obj_invalidate(m_chart);
+        return true;
+    }
+
+    /// Let LVGL draw the series again
+    void detach() noexcept {
+        if (m_chart) {
+            lv_obj_remove_event_cb_with_user_data(m_chart, &ChartCurves::draw_cb, this);
+            lv_obj_remove_event_cb_with_user_data(m_chart, &ChartCurves::delete_cb, this);
+            lv_chart_hide_series(m_chart, m_series, false);
+        }
+        m_chart = nullptr;
+        m_series = nullptr;
+        m_valid = false;
+    }
+
+    /// Path quality for sparse points (lowered for denser ones, see the file comment)
+    ChartCurves& quality(lv_vector_path_quality_t q) noexcept {
+        m_quality = q;
+        refresh();
+        return *this;
+    }
+
+    /// Join points closer than `px` pixels with straight lines
+    ChartCurves& line_below(int32_t px) noexcept {
+        m_line_below = px;
+        refresh();
+        return *this;
+    }
+
+    [[nodiscard]] int32_t line_below() const noexcept { return m_line_below; }
+
+    /// Rebuild the path on the next draw (after changes the geometry check cannot see)
+    void refresh() noexcept {
+        m_valid = false;
+        if (m_chart) lv_obj_invalidate(m_chart);
+    }
+
+    // ==================== State ====================
+
+    [[nodiscard]] const Stats& stats() const noexcept { return m_stats; }
+    void reset_stats() noexcept { m_stats = {}; }
+};
+
+} // namespace lv
+
+#endif // LV_USE_CHART && LV_USE_VECTOR_GRAPHIC
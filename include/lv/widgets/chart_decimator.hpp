@@ -0,0 +1,438 @@
+#pragma once
+
+/**
+ * @file chart_decimator.hpp
+ * @brief Per-pixel-column decimation of large chart series
+ *
+ * lv_chart draws every point of a series, so 100000 points on a 400 px
+ * wide plot cost 100000 line segments per redraw. ChartDecimator keeps the
+ * data outside the chart and feeds the series one or two points per pixel
+ * column:
+ *
+ * - Decimation::min_max: the minimum and maximum of each column, in the
+ *   order they occur. Peaks survive, the line looks like the full plot.
+ * - Decimation::lttb: Largest-Triangle-Three-Buckets, one point per
+ *   column chosen to keep the shape. Smoother, but can drop single spikes.
+ *
+ * @code
+ * static int32_t samples[3600 * 100];     // an hour at 100 Hz
+ * static uint32_t n = 0;
+ * static lv::ChartDecimator deci;
+ * deci.attach(chart, series);             // columns = chart content width
+ * ...
+ * samples[n++] = read_sensor();
+ * deci.data(samples, n);                  // scans only the new samples
+ * deci.view_last(60 * 100);               // or view(first, count) / view_all()
+ * @endcode
+ *
+ * Columns cover a power-of-two number of samples aligned to absolute
+ * sample indices, so appending scans only the new samples, a sliding
+ * window reuses every column it keeps, and when the data outgrows the
+ * plot adjacent columns are merged in pairs. Only moving to a finer zoom
+ * or passing a different array rescans the visible range. With lttb the
+ * chosen points are recomputed from the first changed column on.
+ *
+ * The series gets an external Y array of at most 2 * (columns + 1)
+ * points, and the chart's point count (shared by all its series) follows
+ * the number of decimated points. Use it for line charts, in shift mode
+ * or circular mode (the start point is kept at 0).
+ *
+ * Heap allocation: the column table and the output array (lv_malloc,
+ * sized by the column count)
+ */
+
+#include <lvgl.h>
+#include <cstdint>
+#include <cstring>
+#include "chart.hpp"
+
+#if LV_USE_CHART
+
+namespace lv {
+
+/// How ChartDecimator reduces each pixel column
+enum class Decimation : uint8_t {
+    min_max,    ///< Two points per column: minimum and maximum
+    lttb,       ///< One point per column: Largest-Triangle-Three-Buckets
+};
+
+/**
+ * @brief Feeds a chart series a per-column reduction of a large data set
+ *
+ * Non-movable: the chart's size and delete events keep a pointer to it.
+ */
+class ChartDecimator {
+public:
+    struct Stats {
+        uint32_t updates = 0;     ///< update() calls that changed the view
+        uint32_t rebuilds = 0;    ///< Updates that rescanned the whole range
+        uint32_t merges = 0;      ///< Column widths doubled by merging pairs
+        uint64_t scanned = 0;     ///< Source samples read
+        uint32_t points = 0;      ///< Points given to the chart last time
+    };
+
+private:
+    struct Column {
+        uint32_t id;              ///< Absolute index / m_width
+        uint32_t lo, hi;          ///< Samples scanned: [lo, hi)
+        int32_t min, max;
+        uint32_t min_at, max_at;
+        int64_t sum;
+        uint32_t pick_at;         ///< lttb: sample chosen for this column
+    };
+
+    enum class View : uint8_t { all, last, fixed };
+
+    lv_obj_t* m_chart = nullptr;
+    lv_chart_series_t* m_series = nullptr;
+    const int32_t* m_data = nullptr;
+    uint32_t m_count = 0;
+    const int32_t* m_scanned_data = nullptr;  ///< Array the columns were scanned from
+    Column* m_cols = nullptr;
+    uint32_t m_ncols = 0;
+    int32_t* m_out = nullptr;
+    uint32_t m_columns = 0;       ///< Pixel columns (capacity: m_columns + 1)
+    bool m_auto_columns = false;
+    uint32_t m_width = 0;         ///< Samples per column (power of two), 0 = none
+    View m_view = View::all;
+    uint32_t m_view_first = 0;
+    uint32_t m_view_count = 0;
+    Decimation m_mode = Decimation::min_max;
+    Stats m_stats;
+
+    static void size_cb(lv_event_t* e) noexcept {
+        auto* self = static_cast<ChartDecimator*>(lv_event_get_user_data(e));
+        const int32_t w = lv_obj_get_content_width(self->m_chart);
+        if (w > 0 && static_cast<uint32_t>(w) != self->m_columns) self->columns(static_cast<uint32_t>(w));
+    }
+
+    static void delete_cb(lv_event_t* e) noexcept {
+        auto* self = static_cast<ChartDecimator*>(lv_event_get_user_data(e));
+        self->m_chart = nullptr;
+        self->m_series = nullptr;
+    }
+
+    [[nodiscard]] bool alloc(uint32_t columns) noexcept {
+        lv_free(m_cols);
+        lv_free(m_out);
+        m_cols = static_cast<Column*>(lv_malloc(sizeof(Column) * (columns + 1)));
+        m_out = static_cast<int32_t*>(lv_malloc(sizeof(int32_t) * 2 * (columns + 1)));
+        m_ncols = 0;
+        m_width = 0;
+        if (!m_cols || !m_out) {
+            LV_LOG_WARN("ChartDecimator: out of memory for %u columns", static_cast<unsigned>(columns));
+            lv_free(m_cols);
+            lv_free(m_out);
+            m_cols = nullptr;
+            m_out = nullptr;
+            m_columns = 0;
+            return false;
+        }
+        m_columns = columns;
+        return true;
+    }
+
+    /// Samples shown: [first, end)
+    void range(uint32_t& first, uint32_t& end) const noexcept {
+        first = 0;
+        end = m_count;
+        if (m_view == View::last) {
+            if (m_count > m_view_count) first = m_count - m_view_count;
+        } else if (m_view == View::fixed) {
+            first = m_view_first < m_count ? m_view_first : m_count;
+            end = m_view_count < m_count - first ? first + m_view_count : m_count;
+        }
+    }
+
+    void scan(Column& c, uint32_t from, uint32_t to) noexcept {
+        for (uint32_t i = from; i < to; ++i) {
+            const int32_t v = m_data[i];
+            if (v < c.min) { c.min = v; c.min_at = i; }
+            if (v > c.max) { c.max = v; c.max_at = i; }
+            c.sum += v;
+        }
+        m_stats.scanned += to - from;
+    }
+
+    void fill(Column& c, uint32_t id, uint32_t lo, uint32_t hi) noexcept {
+        c.id = id;
+        c.lo = lo;
+        c.hi = hi;
+        c.min = INT32_MAX;
+        c.max = INT32_MIN;
+        c.min_at = c.max_at = c.pick_at = lo;
+        c.sum = 0;
+        scan(c, lo, hi);
+    }
+
+    /// Double the column width: columns with the same id / 2 become one
+    void merge() noexcept {
+        uint32_t n = 0;
+        for (uint32_t i = 0; i < m_ncols; ++i) {
+            Column c = m_cols[i];
+            c.id >>= 1;
+            if (n && m_cols[n - 1].id == c.id) {
+                Column& d = m_cols[n - 1];
+                if (c.min < d.min) { d.min = c.min; d.min_at = c.min_at; }
+                if (c.max > d.max) { d.max = c.max; d.max_at = c.max_at; }
+                d.sum += c.sum;
+                d.hi = c.hi;
+            } else {
+                m_cols[n++] = c;
+            }
+        }
+        m_ncols = n;
+        m_width <<= 1;
+        ++m_stats.merges;
+    }
+
+    /// Bring the columns to [first, end) at `width` samples each; returns the first column changed
+    uint32_t rescan(uint32_t first, uint32_t end, uint32_t width) noexcept {
+        if (m_data != m_scanned_data || width < m_width || m_width == 0) {
+            m_ncols = 0;
+            m_width = width;
+            m_scanned_data = m_data;
+            ++m_stats.rebuilds;
+        }
+        const bool merged = m_width < width;
+        while (m_width < width) merge();
+
+        const uint32_t id0 = first / width;
+        const uint32_t id_end = (end - 1) / width + 1;
+        // Drop columns that left the range
+        uint32_t keep_from = 0;
+        while (keep_from < m_ncols && m_cols[keep_from].id < id0) ++keep_from;
+        uint32_t keep_to = m_ncols;
+        while (keep_to > keep_from && m_cols[keep_to - 1].id >= id_end) --keep_to;
+        if (keep_from) std::memmove(m_cols, m_cols + keep_from, sizeof(Column) * (keep_to - keep_from));
+        m_ncols = keep_to - keep_from;
+        // Columns that came in at the front
+        const uint32_t front = m_ncols ? m_cols[0].id - id0 : 0;
+        if (front) std::memmove(m_cols + front, m_cols, sizeof(Column) * m_ncols);
+
+        uint32_t changed = UINT32_MAX;
+        for (uint32_t id = id0, i = 0; id < id_end; ++id, ++i) {
+            const uint32_t lo = id * width > first ? id * width : first;
+            const uint32_t hi = (id + 1) * width < end ? (id + 1) * width : end;
+            Column& c = m_cols[i];
+            const bool have = i >= front && i < front + m_ncols;
+            if (have && c.lo == lo && c.hi == hi) continue;
+            if (have && c.lo == lo && c.hi < hi) {
+                scan(c, c.hi, hi);     // appended samples only
+                c.hi = hi;
+            } else {
+                fill(c, id, lo, hi);
+            }
+            if (changed == UINT32_MAX) changed = i;
+        }
+        m_ncols = id_end - id0;
+        if (keep_from || front || merged) return 0;    // columns moved: every output point changes
+        return changed == UINT32_MAX ? m_ncols : changed;
+    }
+
+    uint32_t emit_min_max() noexcept {
+        uint32_t n = 0;
+        for (uint32_t i = 0; i < m_ncols; ++i) {
+            const Column& c = m_cols[i];
+            const bool min_first = c.min_at <= c.max_at;
+            m_out[n++] = min_first ? c.min : c.max;
+            m_out[n++] = min_first ? c.max : c.min;
+        }
+        return n;
+    }
+
+    /**
+     * @brief One point per column into m_out
+     *
+     * A column's pick depends on the previous pick and the next column's
+     * mean, so picks are recomputed from the column before the first
+     * changed one; earlier columns keep theirs.
+     */
+    uint32_t emit_lttb(uint32_t changed, uint32_t first, uint32_t end) noexcept {
+        if (m_ncols == 0) return 0;
+        m_cols[0].pick_at = first;
+        m_out[0] = m_data[first];
+        const uint32_t from = changed > 1 ? changed - 1 : 1;
+        uint32_t prev_at = m_cols[from - 1].pick_at;
+        for (uint32_t k = from; k + 1 < m_ncols; ++k) {
+            const Column& c = m_cols[k];
+            const Column& next = m_cols[k + 1];
+            const double ax = prev_at;
+            const double ay = m_data[prev_at];
+            const double cx = (static_cast<double>(next.lo) + next.hi - 1) / 2;
+            const double cy = static_cast<double>(next.sum) / (next.hi - next.lo);
+            double best = -1;
+            uint32_t best_at = c.lo;
+            for (uint32_t i = c.lo; i < c.hi; ++i) {
+                double area = (ax - cx) * (m_data[i] - ay) - (ax - i) * (cy - ay);
+                if (area < 0) area = -area;
+                if (area > best) { best = area; best_at = i; }
+            }
+            m_stats.scanned += c.hi - c.lo;
+            m_cols[k].pick_at = best_at;
+            m_out[k] = m_data[best_at];
+            prev_at = best_at;
+        }
+        if (m_ncols > 1) {
+            m_cols[m_ncols - 1].pick_at = end - 1;
+            m_out[m_ncols - 1] = m_data[end - 1];
+        }
+        return m_ncols;
+    }
+
+    void push(uint32_t points) noexcept {
+        if (!m_chart) return;
+        m_stats.points = points;
+        if (points == 0) {
+            m_out[0] = LV_CHART_POINT_NONE;
+            points = 1;
+        }
+        if (lv_chart_get_point_count(m_chart) != points) lv_chart_set_point_count(m_chart, points);
+        lv_chart_set_x_start_point(m_chart, m_series, 0);
+        lv_obj_invalidate(m_chart);
+    }
+
+public:
+    ChartDecimator() noexcept = default;
+
+    ~ChartDecimator() {
+        detach();
+        lv_free(m_cols);
+        lv_free(m_out);
+    }
+
+    ChartDecimator(const ChartDecimator&) = delete;
+    ChartDecimator& operator=(const ChartDecimator&) = delete;
+
+    // ==================== Setup ====================
+
+    /**
+     * @brief Feed `series` of `chart` from now on
+     * @param columns Pixel columns; 0 = the chart's content width, followed on resize
+     */
+    bool attach(Chart chart, lv_chart_series_t* series, uint32_t columns = 0) noexcept {
+        detach();
+        m_auto_columns = columns == 0;
+        if (m_auto_columns) {
+            lv_obj_update_layout(chart.get());
+            const int32_t w = lv_obj_get_content_width(chart.get());
+            columns = w > 0 ? static_cast<uint32_t>(w) : 1;
+        }
+        if (columns != m_columns || !m_cols) {
+            if (!alloc(columns)) return false;
+        }
+        m_chart = chart.get();
+        m_series = series;
+        lv_chart_set_ext_y_array(m_chart, m_series, m_out);
+        lv_obj_add_event_cb(m_chart, &ChartDecimator::delete_cb, LV_EVENT_DELETE, this);
+        if (m_auto_columns) lv_obj_add_event_cb(m_chart, &ChartDecimator::size_cb, LV_EVENT_SIZE_CHANGED, this);
+        refresh();
+        return true;
+    }
+
+    /// Stop feeding the chart (the series keeps pointing at the last output)
+    void detach() noexcept {
+        if (m_chart) {
+            lv_obj_remove_event_cb_with_user_data(m_chart, &ChartDecimator::delete_cb, this);
+            lv_obj_remove_event_cb_with_user_data(m_chart, &ChartDecimator::size_cb, this);
+        }
+        m_chart = nullptr;
+        m_series = nullptr;
+    }
+
+    /// Change the number of pixel columns (rescans the visible range)
+    ChartDecimator& columns(uint32_t n) noexcept {
+        if (n == 0) n = 1;
+        if (n != m_columns && alloc(n)) {
+            if (m_chart) lv_chart_set_ext_y_array(m_chart, m_series, m_out);
+            refresh();
+        }
+        return *this;
+    }
+
+    ChartDecimator& mode(Decimation d) noexcept {
+        if (d != m_mode) {
+            m_mode = d;
+            refresh();
+        }
+        return *this;
+    }
+
+    // ==================== Data and view ====================
+
+    /**
+     * @brief Set the source samples (not copied; must stay valid)
+     *
+     * Call again with a larger `count` after appending to the same array:
+     * only the new samples are scanned.
+     */
+    ChartDecimator& data(const int32_t* values, uint32_t count) noexcept {
+        m_data = values;
+        m_count = values ? count : 0;
+        update();
+        return *this;
+    }
+
+    /// Show every sample (the default)
+    ChartDecimator& view_all() noexcept {
+        m_view = View::all;
+        update();
+        return *this;
+    }
+
+    /// Show the newest `count` samples, following appends
+    ChartDecimator& view_last(uint32_t count) noexcept {
+        m_view = View::last;
+        m_view_count = count;
+        update();
+        return *this;
+    }
+
+    /// Show samples [first, first + count)
+    ChartDecimator& view(uint32_t first, uint32_t count) noexcept {
+        m_view = View::fixed;
+        m_view_first = first;
+        m_view_count = count;
+        update();
+        return *this;
+    }
+
+    /// Bring the chart up to date with data() and the view
+    void update() noexcept {
+        if (!m_cols || !m_out) return;
+        uint32_t first, end;
+        range(first, end);
+        if (end <= first) {
+            m_ncols = 0;
+            push(0);
+            return;
+        }
+        const uint32_t span = end - first;
+        uint32_t width = 1;
+        while (span > static_cast<uint64_t>(width) * m_columns) width <<= 1;
+        const uint32_t changed = rescan(first, end, width);
+        ++m_stats.updates;
+        push(m_mode == Decimation::lttb ? emit_lttb(changed, first, end) : emit_min_max());
+    }
+
+    /// Rescan the visible range (after samples already scanned were changed)
+    void refresh() noexcept {
+        m_width = 0;
+        update();
+    }
+
+    // ==================== State ====================
+
+    /// Points given to the chart (at most 2 * (columns + 1))
+    [[nodiscard]] uint32_t point_count() const noexcept { return m_stats.points; }
+
+    /// Samples per pixel column
+    [[nodiscard]] uint32_t samples_per_column() const noexcept { return m_width; }
+
+    [[nodiscard]] const Stats& stats() const noexcept { return m_stats; }
+    void reset_stats() noexcept { m_stats = {}; }
+};
+
+} // namespace lv
+
+#endif // LV_USE_CHART
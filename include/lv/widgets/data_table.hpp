@@ -0,0 +1,522 @@
+#pragma once
+
+/**
+ * @file data_table.hpp
+ * @brief Virtualized table that asks a provider for the visible cells only
+ *
+ * lv_table copies every cell string into the widget and measures every
+ * row, so a 10k x 6 table holds megabytes and relayouts all of it on
+ * each change. DataTable<Provider, Cols> keeps no data: rows are recycled
+ * by a VirtualList, and the text of a row is fetched from the provider
+ * when the row scrolls into view. The last LV_CPP_DATA_TABLE_CACHE rows
+ * are kept formatted, so scrolling back and forth does not format them
+ * again.
+ *
+ * @code
+ * struct Readings {
+ *     const Sample* s;
+ *     uint32_t n;
+ *     uint32_t count() const { return n; }
+ *     void cell(uint32_t row, uint32_t col, char* out, uint32_t size) {
+ *         if (col == 0) lv_snprintf(out, size, "%s", s[row].sensor);
+ *         else lv_snprintf(out, size, "%d", s[row].value);
+ *     }
+ *     // Optional:
+ *     const char* header(uint32_t col) { return col ? "Value" : "Sensor"; }
+ *     bool selected(uint32_t row) { return s[row].flagged; }
+ *     uint8_t cell_style(uint32_t row, uint32_t col) { return col && s[row].value > 90 ? 1 : 0; }
+ *     int compare(uint32_t a, uint32_t b, uint32_t col) { return s[a].value - s[b].value; }
+ * };
+ *
+ * Readings data{samples, 10000};
+ * lv::DataTable<Readings, 2> table(data, 32);
+ * table.mount(screen);
+ * table.cell_style(1, &warn_style);
+ * table.autosize();                 // column widths from sampled rows
+ * table.sort(1, false);             // highest value first
+ * @endcode
+ *
+ * sort() builds a permutation index over the provider's rows (one
+ * uint32_t per row); the data itself is never copied or moved. Without a
+ * compare() the formatted cell texts are compared.
+ *
+ * Heap allocation: the sort index (lv_realloc) besides the MaxRows row
+ * objects with Cols labels each; the row cache is part of the object
+ */
+
+#include <lvgl.h>
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include "../core/object.hpp"
+#include "../core/component.hpp"
+#include "virtual_list.hpp"
+
+#if LV_USE_LIST
+
+#ifndef LV_CPP_DATA_TABLE_CACHE
+/// Formatted rows a DataTable keeps (least recently shown dropped first)
+#define LV_CPP_DATA_TABLE_CACHE 48
+#endif
+
+#ifndef LV_CPP_DATA_TABLE_CELL
+/// Longest cell text kept in the row cache (bytes, including the terminator)
+#define LV_CPP_DATA_TABLE_CELL 32
+#endif
+
+#ifndef LV_CPP_DATA_TABLE_STYLES
+/// Cell style slots; cell_style() index 0 means "no extra style"
+#define LV_CPP_DATA_TABLE_STYLES 4
+#endif
+
+#ifndef LV_CPP_DATA_TABLE_SAMPLES
+/// Rows autosize() measures per column
+#define LV_CPP_DATA_TABLE_SAMPLES 32
+#endif
+
+namespace lv {
+
+/// Data source for DataTable: row count and the text of a cell
+template<typename P>
+concept TableProvider = requires(P& p, uint32_t row, uint32_t col, char* out, uint32_t size) {
+    { p.count() } -> std::convertible_to<uint32_t>;
+    p.cell(row, col, out, size);
+};
+
+/**
+ * @brief Header row over a virtualized list of provider rows
+ *
+ * Row indices passed to the provider and to on_select() are data rows;
+ * with a sort() active they differ from display positions. Non-movable:
+ * events and the list provider keep a pointer to it.
+ *
+ * @tparam Provider Type satisfying TableProvider (held by reference)
+ * @tparam Cols Column count
+ * @tparam MaxRows Upper bound for the row pool
+ */
+template<TableProvider Provider, uint32_t Cols, uint32_t MaxRows = 32>
+class DataTable : public Component<DataTable<Provider, Cols, MaxRows>> {
+    static_assert(Cols > 0, "DataTable needs at least one column");
+    static constexpr uint32_t NONE = UINT32_MAX;
+
+public:
+    struct Stats {
+        uint32_t hits = 0;        ///< Rows shown from the cache
+        uint32_t misses = 0;      ///< Rows formatted by the provider
+        uint32_t binds = 0;       ///< Row objects rebound
+        uint32_t sorts = 0;       ///< sort() index builds
+    };
+
+private:
+    struct Rows {
+        DataTable* self;
+        [[nodiscard]] uint32_t count() const noexcept { return self->view_count(); }
+        ObjectView create_row(ObjectView parent) noexcept { return ObjectView(self->make_row(parent.get())); }
+        void bind(ObjectView row, uint32_t i) noexcept { self->bind_row(row.get(), i); }
+    };
+
+    struct Entry {
+        uint32_t row = NONE;
+        uint32_t used = 0;
+        uint8_t style[Cols] = {};
+        char text[Cols][LV_CPP_DATA_TABLE_CELL] = {};
+    };
+
+    Provider& m_provider;
+    Rows m_rows{this};
+    VirtualList<Rows, MaxRows> m_list;
+    int32_t m_row_height;
+    lv_obj_t* m_header = nullptr;
+    int32_t m_widths[Cols];
+    const lv_style_t* m_styles[LV_CPP_DATA_TABLE_STYLES] = {};
+
+    Entry m_cache[LV_CPP_DATA_TABLE_CACHE];
+    uint32_t m_clock = 0;
+
+    uint32_t* m_view = nullptr;       ///< Display position -> data row while sorted
+    uint32_t m_view_cap = 0;
+    uint32_t m_view_count = 0;
+    uint32_t m_sort_col = NONE;
+    bool m_ascending = true;
+
+    void (*m_on_select)(void*, uint32_t) = nullptr;
+    void* m_select_ctx = nullptr;
+    Stats m_stats;
+
+    using Component<DataTable>::m_root;
+
+    [[nodiscard]] uint32_t view_count() const noexcept {
+        return m_sort_col != NONE ? m_view_count : static_cast<uint32_t>(m_provider.count());
+    }
+
+    [[nodiscard]] uint32_t data_row(uint32_t display) const noexcept {
+        return m_sort_col != NONE ? m_view[display] : display;
+    }
+
+    /// Formatted row `row`, from the cache or the provider
+    [[nodiscard]] const Entry& fetch(uint32_t row) noexcept {
+        Entry* victim = &m_cache[0];
+        for (Entry& e : m_cache) {
+            if (e.row == row) {
+                ++m_stats.hits;
+                e.used = ++m_clock;
+                return e;
+            }
+            if (e.used < victim->used) victim = &e;
+        }
+        ++m_stats.misses;
+        Entry& e = *victim;
+        e.row = row;
+        e.used = ++m_clock;
+        for (uint32_t c = 0; c < Cols; ++c) {
+            e.text[c][0] = '\0';
+            m_provider.cell(row, c, e.text[c], LV_CPP_DATA_TABLE_CELL);
+            if constexpr (requires { m_provider.cell_style(row, c); }) {
+                const auto s = static_cast<uint8_t>(m_provider.cell_style(row, c));
+                e.style[c] = s < LV_CPP_DATA_TABLE_STYLES ? s : 0;
+            }
+        }
+        return e;
+    }
+
+    void drop(uint32_t row) noexcept {
+        for (Entry& e : m_cache) {
+            if (e.row == row) e = Entry{};
+        }
+    }
+
+    [[nodiscard]] lv_obj_t* make_row(lv_obj_t* parent) noexcept {
+        lv_obj_t* row = lv_list_add_button(parent, nullptr, nullptr);
+        lv_obj_set_size(row, LV_SIZE_CONTENT, m_row_height);
+        lv_obj_set_style_min_width(row, lv_pct(100), LV_PART_MAIN);
+        for (uint32_t c = 0; c < Cols; ++c) {
+            lv_obj_t* label = lv_label_create(row);
+            lv_label_set_long_mode(label, LV_LABEL_LONG_DOT);
+            lv_obj_set_width(label, m_widths[c]);
+            lv_label_set_text_static(label, "");
+        }
+        lv_obj_add_event_cb(row, &DataTable::click_cb, LV_EVENT_CLICKED, this);
+        return row;
+    }
+
+    /// Swap the style slot of a cell label (the slot in use is kept in its user data)
+    void set_cell_style(lv_obj_t* label, uint8_t slot) noexcept {
+        const auto old = static_cast<uint8_t>(reinterpret_cast<uintptr_t>(lv_obj_get_user_data(label)));
+        if (old == slot) return;
+        if (old && m_styles[old]) lv_obj_remove_style(label, const_cast<lv_style_t*>(m_styles[old]), LV_PART_MAIN);
+        if (slot && m_styles[slot]) lv_obj_add_style(label, const_cast<lv_style_t*>(m_styles[slot]), LV_PART_MAIN);
+        lv_obj_set_user_data(label, reinterpret_cast<void*>(static_cast<uintptr_t>(slot)));
+    }
+
+    void bind_row(lv_obj_t* row, uint32_t display) noexcept {
+        ++m_stats.binds;
+        lv_obj_set_user_data(row, reinterpret_cast<void*>(static_cast<uintptr_t>(display)));
+        const uint32_t data = data_row(display);
+        const Entry& e = fetch(data);
+        for (uint32_t c = 0; c < Cols; ++c) {
+            lv_obj_t* label = lv_obj_get_child(row, static_cast<int32_t>(c));
+            lv_label_set_text(label, e.text[c]);
+            set_cell_style(label, e.style[c]);
+        }
+        if constexpr (requires { m_provider.selected(data); }) {
+            lv_obj_set_state(row, LV_STATE_CHECKED, m_provider.selected(data));
+        }
+    }
+
+    /// Calls `fn(row object)` for every row object of the list
+    template<typename Fn>
+    void each_row(Fn&& fn) noexcept {
+        if (!m_root) return;
+        lv_obj_t* list = m_list.root().get();
+        const uint32_t n = lv_obj_get_child_count(list);
+        for (uint32_t i = 1; i < n; ++i) fn(lv_obj_get_child(list, static_cast<int32_t>(i)));   // 0 is the spacer
+    }
+
+    void apply_widths() noexcept {
+        if (m_header) {
+            for (uint32_t c = 0; c < Cols; ++c) {
+                lv_obj_set_width(lv_obj_get_child(m_header, static_cast<int32_t>(c)), m_widths[c]);
+            }
+        }
+        each_row([this](lv_obj_t* row) {
+            for (uint32_t c = 0; c < Cols; ++c) {
+                lv_obj_set_width(lv_obj_get_child(row, static_cast<int32_t>(c)), m_widths[c]);
+            }
+        });
+    }
+
+    static void click_cb(lv_event_t* e) noexcept {
+        auto* self = static_cast<DataTable*>(lv_event_get_user_data(e));
+        auto* row = static_cast<lv_obj_t*>(lv_event_get_current_target(e));
+        const auto display = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(lv_obj_get_user_data(row)));
+        if (self->m_on_select && display < self->view_count()) {
+            self->m_on_select(self->m_select_ctx, self->data_row(display));
+        }
+    }
+
+    /// Keep the header aligned with horizontally scrolled rows
+    static void scroll_cb(lv_event_t* e) noexcept {
+        auto* self = static_cast<DataTable*>(lv_event_get_user_data(e));
+        if (!self->m_header) return;
+        const int32_t x = lv_obj_get_scroll_x(self->m_list.root().get());
+        if (lv_obj_get_scroll_x(self->m_header) != x) lv_obj_scroll_to_x(self->m_header, x, LV_ANIM_OFF);
+    }
+
+    [[nodiscard]] int compare(uint32_t a, uint32_t b, uint32_t col) noexcept {
+        if constexpr (requires { m_provider.compare(a, b, col); }) {
+            return m_provider.compare(a, b, col);
+        } else {
+            char ta[LV_CPP_DATA_TABLE_CELL] = {};
+            char tb[LV_CPP_DATA_TABLE_CELL] = {};
+            m_provider.cell(a, col, ta, sizeof(ta));
+            m_provider.cell(b, col, tb, sizeof(tb));
+            return std::strcmp(ta, tb);
+        }
+    }
+
+    /// Rebuild the sort index for the current row count
+    [[nodiscard]] bool build_view() noexcept {
+        const auto n = static_cast<uint32_t>(m_provider.count());
+        if (n > m_view_cap) {
+            auto* view = static_cast<uint32_t*>(lv_realloc(m_view, sizeof(uint32_t) * n));
+            if (!view) {
+                LV_LOG_WARN("DataTable: no memory to sort %u rows", static_cast<unsigned>(n));
+                return false;
+            }
+            m_view = view;
+            m_view_cap = n;
+        }
+        for (uint32_t i = 0; i < n; ++i) m_view[i] = i;
+        const uint32_t col = m_sort_col;
+        const bool asc = m_ascending;
+        std::sort(m_view, m_view + n, [this, col, asc](uint32_t a, uint32_t b) {
+            const int r = compare(a, b, col);
+            if (r != 0) return asc ? r < 0 : r > 0;
+            return a < b;     // keep equal rows in data order
+        });
+        m_view_count = n;
+        ++m_stats.sorts;
+        return true;
+    }
+
+public:
+    /**
+     * @param provider Data source (must outlive the table)
+     * @param row_height Height of every row in pixels
+     * @param col_width Initial width of every column (see column_width(), autosize())
+     */
+    DataTable(Provider& provider, int32_t row_height = 32, int32_t col_width = 80) noexcept
+        : m_provider(provider), m_list(m_rows, row_height), m_row_height(row_height) {
+        for (int32_t& w : m_widths) w = col_width;
+    }
+
+    // Unmount here, while on_unmount() can still run on a live object
+    ~DataTable() {
+        this->unmount();
+        lv_free(m_view);
+    }
+
+    DataTable(DataTable&&) = delete;
+    DataTable& operator=(DataTable&&) = delete;
+
+    /// Component build(): header row (if the provider has header()) over the row list
+    ObjectView build(ObjectView parent) {
+        lv_obj_t* box = lv_obj_create(parent.get());
+        lv_obj_set_flex_flow(box, LV_FLEX_FLOW_COLUMN);
+        lv_obj_remove_flag(box, LV_OBJ_FLAG_SCROLLABLE);
+
+        if constexpr (requires { m_provider.header(0u); }) {
+            m_header = lv_obj_create(box);
+            lv_obj_remove_style_all(m_header);
+            lv_obj_set_size(m_header, lv_pct(100), LV_SIZE_CONTENT);
+            lv_obj_set_flex_flow(m_header, LV_FLEX_FLOW_ROW);
+            lv_obj_remove_flag(m_header, LV_OBJ_FLAG_CLICKABLE);
+            lv_obj_set_scrollbar_mode(m_header, LV_SCROLLBAR_MODE_OFF);
+            for (uint32_t c = 0; c < Cols; ++c) {
+                lv_obj_t* label = lv_label_create(m_header);
+                lv_label_set_long_mode(label, LV_LABEL_LONG_DOT);
+                lv_obj_set_width(label, m_widths[c]);
+                const char* text = m_provider.header(c);
+                lv_label_set_text(label, text ? text : "");
+            }
+        }
+
+        m_list.mount(ObjectView(box));
+        lv_obj_t* list = m_list.root().get();
+        lv_obj_set_width(list, lv_pct(100));
+        lv_obj_set_flex_grow(list, 1);
+        lv_obj_add_event_cb(list, &DataTable::scroll_cb, LV_EVENT_SCROLL, this);
+
+        if (m_header && lv_obj_get_child_count(list) > 1) {
+            // Line the header cells up with the cells of the first row
+            lv_obj_t* row = lv_obj_get_child(list, 1);
+            lv_obj_set_style_pad_left(m_header, lv_obj_get_style_pad_left(list, LV_PART_MAIN) +
+                                      lv_obj_get_style_pad_left(row, LV_PART_MAIN), LV_PART_MAIN);
+            lv_obj_set_style_pad_column(m_header, lv_obj_get_style_pad_column(row, LV_PART_MAIN), LV_PART_MAIN);
+        }
+        return ObjectView(box);
+    }
+
+    void on_unmount() noexcept {
+        m_header = nullptr;
+    }
+
+    // ==================== Columns ====================
+
+    /// Set the width of column `col` in pixels
+    DataTable& column_width(uint32_t col, int32_t width) noexcept {
+        if (col < Cols) {
+            m_widths[col] = width;
+            apply_widths();
+        }
+        return *this;
+    }
+
+    [[nodiscard]] int32_t column_width(uint32_t col) const noexcept {
+        return col < Cols ? m_widths[col] : 0;
+    }
+
+    /**
+     * @brief Size every column to its widest text among the header and `samples` rows
+     *
+     * The rows are spread evenly over the data (first and last included),
+     * so the cost does not depend on the row count.
+     */
+    DataTable& autosize(uint32_t samples = LV_CPP_DATA_TABLE_SAMPLES, int32_t max_width = LV_COORD_MAX) noexcept {
+        if (!m_root) return *this;
+        lv_obj_t* list = m_list.root().get();
+        const lv_font_t* font = lv_obj_get_style_text_font(list, LV_PART_MAIN);
+        const int32_t letter = lv_obj_get_style_text_letter_space(list, LV_PART_MAIN);
+        const auto n = static_cast<uint32_t>(m_provider.count());
+        if (samples > n) samples = n;
+
+        int32_t widths[Cols] = {};
+        char text[LV_CPP_DATA_TABLE_CELL];
+        auto measure = [&](uint32_t c, const char* t) {
+            lv_point_t size;
+            lv_text_get_size(&size, t, font, letter, 0, LV_COORD_MAX, LV_TEXT_FLAG_NONE);
+            if (size.x > widths[c]) widths[c] = size.x;
+        };
+        for (uint32_t c = 0; c < Cols; ++c) {
+            if constexpr (requires { m_provider.header(0u); }) {
+                const char* h = m_provider.header(c);
+                if (h) measure(c, h);
+            }
+            for (uint32_t s = 0; s < samples; ++s) {
+                const uint32_t row = samples > 1 ? static_cast<uint32_t>(static_cast<uint64_t>(s) * (n - 1) / (samples - 1)) : 0;
+                text[0] = '\0';
+                m_provider.cell(row, c, text, sizeof(text));
+                measure(c, text);
+            }
+        }
+        for (uint32_t c = 0; c < Cols; ++c) m_widths[c] = LV_MIN(widths[c] + 1, max_width);   // +1: rounding of the glyph advance
+        apply_widths();
+        return *this;
+    }
+
+    /// Style added to cells whose provider cell_style() returns `slot` (1..LV_CPP_DATA_TABLE_STYLES-1)
+    DataTable& cell_style(uint8_t slot, const lv_style_t* style) noexcept {
+        if (slot == 0 || slot >= LV_CPP_DATA_TABLE_STYLES) {
+            LV_LOG_WARN("DataTable: style slot %u out of range (raise LV_CPP_DATA_TABLE_STYLES)", static_cast<unsigned>(slot));
+            return *this;
+        }
+        // Cells keep the style they were given; take it off before replacing the slot
+        each_row([this, slot](lv_obj_t* row) {
+            for (uint32_t c = 0; c < Cols; ++c) {
+                lv_obj_t* label = lv_obj_get_child(row, static_cast<int32_t>(c));
+                if (reinterpret_cast<uintptr_t>(lv_obj_get_user_data(label)) == slot) set_cell_style(label, 0);
+            }
+        });
+        m_styles[slot] = style;
+        m_list.refresh();
+        return *this;
+    }
+
+    // ==================== Sorting ====================
+
+    /**
+     * @brief Show the rows ordered by column `col`
+     *
+     * Uses the provider's compare(a, b, col) if it has one, else the cell
+     * texts. Equal rows keep their data order.
+     * @return false if the index could not be allocated (the order is unchanged)
+     */
+    bool sort(uint32_t col, bool ascending = true) noexcept {
+        if (col >= Cols) return false;
+        const uint32_t prev_col = m_sort_col;
+        const bool prev_asc = m_ascending;
+        m_sort_col = col;
+        m_ascending = ascending;
+        if (!build_view()) {
+            m_sort_col = prev_col;
+            m_ascending = prev_asc;
+            return false;
+        }
+        m_list.refresh();
+        return true;
+    }
+
+    /// Back to data order (the index memory is kept for the next sort())
+    void unsort() noexcept {
+        m_sort_col = NONE;
+        m_list.refresh();
+    }
+
+    /// Sorted column, or UINT32_MAX in data order
+    [[nodiscard]] uint32_t sort_column() const noexcept { return m_sort_col; }
+
+    [[nodiscard]] bool sort_ascending() const noexcept { return m_ascending; }
+
+    // ==================== Updates ====================
+
+    /// Rows changed, were added or removed: drop the cache, re-sort and rebind the visible rows
+    void refresh() noexcept {
+        for (Entry& e : m_cache) e = Entry{};
+        if (m_sort_col != NONE && !build_view()) m_sort_col = NONE;
+        m_list.refresh();
+    }
+
+    /**
+     * @brief Data row `row` changed in place (text, style or selection)
+     *
+     * Rebinds it if it is on screen. Does not re-sort: call refresh() if
+     * the sorted column changed.
+     */
+    void refresh_row(uint32_t row) noexcept {
+        drop(row);
+        each_row([this, row](lv_obj_t* obj) {
+            if (lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return;
+            const auto display = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(lv_obj_get_user_data(obj)));
+            if (display < view_count() && data_row(display) == row) bind_row(obj, display);
+        });
+    }
+
+    /// Scroll so that display position `index` is at the top
+    void scroll_to(uint32_t index, bool anim = false) noexcept {
+        m_list.scroll_to(index, anim);
+    }
+
+    /// Call `(obj->*MemFn)(uint32_t row)` with the data row of a clicked row
+    template<auto MemFn, typename T>
+    DataTable& on_select(T* obj) noexcept {
+        m_select_ctx = obj;
+        m_on_select = [](void* ctx, uint32_t row) { (static_cast<T*>(ctx)->*MemFn)(row); };
+        return *this;
+    }
+
+    // ==================== State ====================
+
+    /// Rows shown (the provider's count() as of the last refresh)
+    [[nodiscard]] uint32_t row_count() const noexcept { return m_list.item_count(); }
+
+    /// Row objects created so far (at most MaxRows)
+    [[nodiscard]] uint32_t row_objects() const noexcept { return m_list.row_count(); }
+
+    [[nodiscard]] const Stats& stats() const noexcept { return m_stats; }
+    void reset_stats() noexcept { m_stats = {}; }
+};
+
+} // namespace lv
+
+#endif // LV_USE_LIST
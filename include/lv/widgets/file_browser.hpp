@@ -0,0 +1,277 @@
+#pragma once
+
+/**
+ * @file file_browser.hpp
+ * @brief Directory browser over cached listings and recycled rows
+ *
+ * lv_file_explorer (FileExplorer) reads and sorts the whole directory on
+ * every navigation and creates a table row per entry, so a 5000-file
+ * folder blocks the UI and holds 5000 rows. FileBrowser shows a
+ * fs::DirListing from the dir_cache through a VirtualList: the first
+ * entries are on screen after one batch, the rest stream in from a timer
+ * (LV_CPP_FILE_BROWSER_STEP entries per tick), and the widget never holds
+ * more than MaxRows rows. Going back to a cached folder shows it at once.
+ *
+ * @code
+ * struct Player : lv::Component<Player> {
+ *     lv::FileBrowser<> browser;
+ *     ObjectView build(ObjectView parent) {
+ *         auto box = lv::Box::create(parent);
+ *         browser.mount(box);
+ *         browser.on_select<&Player::play>(this);
+ *         browser.open("A:/media");
+ *         return box;
+ *     }
+ *     void play(const char* path);      // "A:/media/clip.mp4"
+ * };
+ * @endcode
+ *
+ * Directories are listed first, then files, both case-insensitively by
+ * name. Clicking a directory (or the ".." row) navigates; clicking a file
+ * calls the select callback with its full path.
+ *
+ * Heap allocation: none besides the listings (see dir_cache.hpp) and the
+ * MaxRows + 2 LVGL objects
+ */
+
+#include <lvgl.h>
+#include <cstdint>
+#include <cstring>
+#include "../core/object.hpp"
+#include "../core/component.hpp"
+#include "../core/dir_cache.hpp"
+#include "virtual_list.hpp"
+
+#if LV_USE_LIST
+
+#ifndef LV_CPP_FILE_BROWSER_STEP
+/// Directory entries a FileBrowser reads per timer tick while a listing loads
+#define LV_CPP_FILE_BROWSER_STEP 64
+#endif
+
+namespace lv {
+
+/**
+ * @brief Header with the current path over a virtualized entry list
+ *
+ * Non-movable: events, the timer and the list provider keep a pointer to it.
+ *
+ * @tparam MaxRows Upper bound for the row pool
+ */
+template<uint32_t MaxRows = 32>
+class FileBrowser : public Component<FileBrowser<MaxRows>> {
+    static constexpr uint32_t SELECTED_MAX = LV_CPP_DIR_CACHE_PATH + LV_CPP_DIR_CACHE_NAME;
+
+    struct Rows {
+        FileBrowser* self;
+        [[nodiscard]] uint32_t count() const noexcept { return self->item_count(); }
+        ObjectView create_row(ObjectView parent) noexcept { return ObjectView(self->make_row(parent.get())); }
+        void bind(ObjectView row, uint32_t i) noexcept { self->bind_row(row.get(), i); }
+    };
+
+    Rows m_rows{this};
+    VirtualList<Rows, MaxRows> m_list;
+    fs::DirListing* m_dir = nullptr;
+    lv_obj_t* m_header = nullptr;
+    lv_timer_t* m_timer = nullptr;
+    uint32_t m_version = 0;           ///< Listing version the rows show
+    char m_path[LV_CPP_DIR_CACHE_PATH] = {};
+    char m_selected[SELECTED_MAX] = {};
+    void (*m_on_select)(void*, const char*) = nullptr;
+    void* m_select_ctx = nullptr;
+
+    using Component<FileBrowser>::m_root;
+
+    /// Something above the current path ("A:/media" has, "A:/" has not)
+    [[nodiscard]] bool has_parent() const noexcept {
+        const char* rest = m_path[0] && m_path[1] == ':' ? m_path + 2 : m_path;
+        while (*rest == '/') ++rest;
+        return *rest != '\0';
+    }
+
+    [[nodiscard]] uint32_t item_count() const noexcept {
+        return (m_dir ? m_dir->count() : 0) + (has_parent() ? 1 : 0);
+    }
+
+    [[nodiscard]] lv_obj_t* make_row(lv_obj_t* parent) noexcept {
+        lv_obj_t* row = lv_list_add_button(parent, LV_SYMBOL_FILE, "");
+        lv_label_set_long_mode(lv_obj_get_child(row, 1), LV_LABEL_LONG_DOT);
+        lv_obj_add_event_cb(row, &FileBrowser::click_cb, LV_EVENT_CLICKED, this);
+        return row;
+    }
+
+    void bind_row(lv_obj_t* row, uint32_t i) noexcept {
+        lv_obj_set_user_data(row, reinterpret_cast<void*>(static_cast<uintptr_t>(i)));
+        const char* name = "..";
+        bool is_dir = true;
+        if (has_parent()) --i;
+        if (i != UINT32_MAX) {
+            const fs::DirEntry e = m_dir->at(i);
+            name = e.name;
+            is_dir = e.is_dir;
+        }
+        lv_image_set_src(lv_obj_get_child(row, 0), is_dir ? LV_SYMBOL_DIRECTORY : LV_SYMBOL_FILE);
+        lv_label_set_text(lv_obj_get_child(row, 1), name);
+    }
+
+    static void click_cb(lv_event_t* e) noexcept {
+        auto* self = static_cast<FileBrowser*>(lv_event_get_user_data(e));
+        auto* row = static_cast<lv_obj_t*>(lv_event_get_current_target(e));
+        self->activate(static_cast<uint32_t>(reinterpret_cast<uintptr_t>(lv_obj_get_user_data(row))));
+    }
+
+    /// Row `i` clicked: navigate into a directory or report a file
+    void activate(uint32_t i) noexcept {
+        if (has_parent() && i-- == 0) {
+            up();
+            return;
+        }
+        if (!m_dir || i >= m_dir->count()) return;
+        const fs::DirEntry e = m_dir->at(i);
+        if (!join(m_selected, sizeof(m_selected), e.name)) return;
+        if (e.is_dir) open(m_selected);
+        else if (m_on_select) m_on_select(m_select_ctx, m_selected);
+    }
+
+    /// m_path + '/' + name into `out`
+    [[nodiscard]] bool join(char* out, size_t n, const char* name) const noexcept {
+        const size_t len = std::strlen(m_path);
+        const bool slash = len && m_path[len - 1] != '/';
+        const size_t need = len + (slash ? 1 : 0) + std::strlen(name) + 1;
+        if (need > n) return false;
+        std::memcpy(out, m_path, len);
+        if (slash) out[len] = '/';
+        std::strcpy(out + len + (slash ? 1 : 0), name);
+        return true;
+    }
+
+    /// Read a batch and rebind the visible rows if anything arrived
+    void step() noexcept {
+        if (!m_dir) return;
+        m_dir->load(LV_CPP_FILE_BROWSER_STEP);
+        if (m_dir->version() != m_version) {
+            m_version = m_dir->version();
+            m_list.refresh();
+        }
+        if (m_timer) {
+            if (m_dir->complete()) lv_timer_pause(m_timer);
+            else lv_timer_resume(m_timer);
+        }
+    }
+
+    static void timer_cb(lv_timer_t* t) noexcept {
+        static_cast<FileBrowser*>(lv_timer_get_user_data(t))->step();
+    }
+
+public:
+    /**
+     * @param row_height Height of every row in pixels
+     */
+    explicit FileBrowser(int32_t row_height = 40) noexcept
+        : m_list(m_rows, row_height) {}
+
+    // Unmount here, while on_unmount() can still run on a live object
+    ~FileBrowser() {
+        this->unmount();
+        fs::dir_cache::release(m_dir);
+    }
+
+    FileBrowser(FileBrowser&&) = delete;
+    FileBrowser& operator=(FileBrowser&&) = delete;
+
+    /// Component build(): path header, entry list and the loading timer
+    ObjectView build(ObjectView parent) {
+        lv_obj_t* box = lv_obj_create(parent.get());
+        lv_obj_set_flex_flow(box, LV_FLEX_FLOW_COLUMN);
+        lv_obj_remove_flag(box, LV_OBJ_FLAG_SCROLLABLE);
+
+        m_header = lv_label_create(box);
+        lv_label_set_long_mode(m_header, LV_LABEL_LONG_DOT);
+        lv_obj_set_width(m_header, lv_pct(100));
+        lv_label_set_text(m_header, m_path);
+
+        m_list.mount(ObjectView(box));
+        lv_obj_set_width(m_list.root().get(), lv_pct(100));
+        lv_obj_set_flex_grow(m_list.root().get(), 1);
+
+        m_timer = lv_timer_create(&FileBrowser::timer_cb, LV_DEF_REFR_PERIOD, this);
+        lv_timer_pause(m_timer);
+        m_version = m_dir ? m_dir->version() : 0;
+        if (m_dir && !m_dir->complete()) lv_timer_resume(m_timer);
+        return ObjectView(box);
+    }
+
+    void on_unmount() noexcept {
+        if (m_timer) lv_timer_delete(m_timer);
+        m_timer = nullptr;
+        m_header = nullptr;
+    }
+
+    // ==================== Navigation ====================
+
+    /**
+     * @brief Show directory `path` ("A:/media")
+     *
+     * A cached listing is shown as it is; otherwise the first
+     * LV_CPP_FILE_BROWSER_STEP entries are read now and the rest on
+     * later timer ticks.
+     * @return false if the listing could not be opened (the view is unchanged)
+     */
+    bool open(const char* path) noexcept {
+        fs::DirListing* dir = fs::dir_cache::open(path);
+        if (!dir) return false;
+        fs::dir_cache::release(m_dir);
+        m_dir = dir;
+        if (path != m_path) std::strcpy(m_path, path);
+        if (m_header) lv_label_set_text(m_header, m_path);
+        m_version = m_dir->version() - 1;     // rebind even if nothing new arrives
+        step();
+        m_list.scroll_to(0);
+        return true;
+    }
+
+    /// Show the parent directory; false if already at the drive root
+    bool up() noexcept {
+        if (!has_parent()) return false;
+        char parent[LV_CPP_DIR_CACHE_PATH];
+        std::strcpy(parent, m_path);
+        size_t len = std::strlen(parent);
+        while (len && parent[len - 1] == '/') --len;
+        while (len && parent[len - 1] != '/' && parent[len - 1] != ':') --len;
+        if (len && parent[len - 1] == '/' && len > 1 && parent[len - 2] != ':') --len;   // keep "A:/"
+        parent[len] = '\0';
+        return open(parent);
+    }
+
+    /// Re-read the current directory (after writing to a drive without timestamps)
+    void reload() noexcept {
+        if (!m_dir) return;
+        fs::dir_cache::invalidate(m_path);
+        open(m_path);
+    }
+
+    /// Call `(obj->*MemFn)(const char* path)` when a file is clicked
+    template<auto MemFn, typename T>
+    FileBrowser& on_select(T* obj) noexcept {
+        m_select_ctx = obj;
+        m_on_select = [](void* ctx, const char* path) { (static_cast<T*>(ctx)->*MemFn)(path); };
+        return *this;
+    }
+
+    // ==================== State ====================
+
+    [[nodiscard]] const char* path() const noexcept { return m_path; }
+
+    /// The listing shown (nullptr before open())
+    [[nodiscard]] const fs::DirListing* listing() const noexcept { return m_dir; }
+
+    /// Whole directory read
+    [[nodiscard]] bool loaded() const noexcept { return m_dir && m_dir->complete(); }
+
+    /// Row objects created so far (at most MaxRows)
+    [[nodiscard]] uint32_t row_count() const noexcept { return m_list.row_count(); }
+};
+
+} // namespace lv
+
+#endif // LV_USE_LIST
@@ -5,6 +5,10 @@
  * @brief Zero-cost wrapper for LVGL file explorer widget
  *
  * Requires LV_USE_FILE_EXPLORER to be enabled in lv_conf.h.
+ *
+ * The widget reads and sorts the whole directory on every navigation and
+ * creates one table row per entry; for large folders see FileBrowser
+ * (file_browser.hpp).
  */
 
 #include <lvgl.h>
@@ -9,9 +9,17 @@
 #include "../core/object.hpp"
 #include "../core/event.hpp"
 #include "../core/style.hpp"
+#include "../core/image_loader.hpp"
+#include "../core/image_set.hpp"
+#include "../draw/draw_image.hpp"
 
 namespace lv {
 
+namespace detail {
+/// Defined in nine_slice.hpp; include it to use Image::nine_slice()
+template <typename> struct NineSliceImage;
+} // namespace detail
+
 /**
  * @brief Image widget wrapper
  *
@@ -42,11 +50,57 @@ public:
         return *this;
     }
 
+    /**
+     * @brief Show the variant of `set` for this object's display DPI
+     *
+     * Resampled once when no variant fits (see image_set.hpp); the scale is
+     * reset, or set to the needed zoom when resampling is not possible.
+     * `set` must outlive the image: image_set::rescale() resolves it again
+     * after a DPI change.
+     */
+    template<size_t N>
+    Image& src(const ImageSet<N>& set) noexcept {
+        const ResolvedImage r = set.resolve_for(lv_obj_get_display(m_obj));
+        lv_image_set_src(m_obj, r.src);
+        lv_image_set_scale(m_obj, static_cast<uint32_t>(r.scale));
+        image_set::detail::bind(m_obj, set.variants, N);
+        return *this;
+    }
+
     /// Get image source
     [[nodiscard]] const void* src() const noexcept {
         return lv_image_get_src(m_obj);
     }
 
+    /**
+     * @brief Decode a file in the background, showing the loader's placeholder meanwhile
+     *
+     * See image_loader.hpp. Falls back to src(path) when the loader tables are full.
+     */
+    Image& src_async(const char* path) noexcept {
+        image_loader::load(m_obj, path);
+        return *this;
+    }
+
+    /// src_async() with an explicit placeholder and fade-in time
+    Image& src_async(const char* path, const void* placeholder, uint32_t fade_ms = 0) noexcept {
+        image_loader::load(m_obj, path, placeholder, fade_ms);
+        return *this;
+    }
+
+    /**
+     * @brief Fill the whole object with `ns.src`, 9-sliced (see draw::image_nine_slice())
+     *
+     * Replaces src(): the widget draws no image of its own, so give it a
+     * size. `ns` is referenced, not copied. Style opacity and recolor apply.
+     * (requires #include <lv/draw/nine_slice.hpp>)
+     */
+    template <typename Self = Image>
+    Self& nine_slice(const NineSlice& ns) noexcept {
+        detail::NineSliceImage<Self>::set(m_obj, ns);
+        return *static_cast<Self*>(this);
+    }
+
     // ==================== Transform ====================
 
     /// Set rotation angle (0.1 degree units, 3600 = 360 degrees)
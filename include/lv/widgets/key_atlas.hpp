@@ -0,0 +1,567 @@
+#pragma once
+
+/**
+ * @file key_atlas.hpp
+ * @brief Pre-rendered key backgrounds and per-key redraws for ButtonMatrix and Keyboard
+ *
+ * LVGL draws a button matrix by walking every key on each redraw: it
+ * resolves the key's styles, builds a rect and a label descriptor,
+ * measures the text and queues both, whether or not the key is inside
+ * the area being refreshed. Pressing a key also changes the matrix's
+ * own state, which makes LVGL invalidate the whole matrix because its
+ * item styles differ between states. On a keyboard with shadows,
+ * gradients or rounded keys every keystroke repaints all of it.
+ *
+ * With the key atlas enabled on a matrix:
+ *
+ * - Each distinct key background (width, height, state) is rendered once
+ *   into a pooled ARGB8888 bitmap and afterwards drawn as an image.
+ * - Only keys intersecting the refreshed area are drawn at all.
+ * - The whole-matrix invalidation caused by the pressed state change is
+ *   narrowed to the key being pressed or released (grown by the gaps,
+ *   as the matrix invalidates keys itself).
+ * - Each map's key-to-text index and text sizes are cached, so keyboard
+ *   mode switches reuse them instead of measuring every label again.
+ *
+ * @code
+ * #include <lv/widgets/key_atlas.hpp>
+ *
+ * auto kb = lv::Keyboard::create(screen);
+ * lv::key_atlas::enable(kb);
+ * @endcode
+ *
+ * Bitmaps are rendered at the display's REFR_READY; until a key's bitmap
+ * exists it is drawn directly. Styles are re-resolved and the bitmaps
+ * dropped on LV_EVENT_STYLE_CHANGED (so also on theme switches). The
+ * matrix's MAIN part no longer repaints for the pressed state, so pressed
+ * styles on the background itself do not show. Keys are drawn with their
+ * id in `base.id1` like LVGL does, but through image draw tasks, so
+ * LV_EVENT_DRAW_TASK_ADDED handlers that restyle key rectangles do not
+ * apply. Matrices with more than LV_CPP_KEY_ATLAS_KEYS keys are left to
+ * LVGL.
+ *
+ * Not included by lv.hpp: it reads lv_buttonmatrix_t's key areas, map
+ * and control bits, hides the keys from LVGL's draw by zeroing btn_cnt,
+ * switches lv_obj_t::state to render each state, and renders bitmaps
+ * through lv_display_t::layer_head. None of these is public. Checked
+ * against LVGL 9.4 (see LV_CPP_INTERNALS_OK).
+ *
+ * Heap allocation: NONE in the wrapper (fixed tables; bitmaps come from
+ * draw::pool_handlers())
+ */
+
+#include <lvgl.h>
+#include "../core/version.hpp"
+
+#if LV_USE_BUTTONMATRIX
+
+#if !LV_CPP_INTERNALS_OK
+#error "key_atlas.hpp reads LVGL internals checked against LVGL 9.4; see LV_CPP_INTERNALS_OK"
+#endif
+
+#include <src/core/lv_obj_private.h>                      // lv_obj_t::state, skip_trans
+#include <src/draw/lv_draw_private.h>                     // lv_layer_t::_clip_area
+#include <src/display/lv_display_private.h>               // lv_display_t::layer_head
+#include <src/widgets/buttonmatrix/lv_buttonmatrix_private.h>  // button_areas, btn_cnt, map_p
+#include <cstdint>
+#include <cstring>
+#include "../core/object.hpp"
+#include "../draw/draw_buf.hpp"
+
+#ifndef LV_CPP_KEY_ATLASES
+/// Matrices that can use the key atlas at the same time
+#define LV_CPP_KEY_ATLASES 2
+#endif
+
+#ifndef LV_CPP_KEY_ATLAS_KEYS
+/// Keys per map whose geometry is cached; larger matrices are drawn by LVGL
+#define LV_CPP_KEY_ATLAS_KEYS 48
+#endif
+
+#ifndef LV_CPP_KEY_ATLAS_MAPS
+/// Maps per matrix whose geometry is cached (a keyboard has one per mode)
+#define LV_CPP_KEY_ATLAS_MAPS 4
+#endif
+
+#ifndef LV_CPP_KEY_ATLAS_STATES
+/// Key states per matrix whose draw descriptors are cached
+#define LV_CPP_KEY_ATLAS_STATES 6
+#endif
+
+#ifndef LV_CPP_KEY_ATLAS_BITMAPS
+/// Pre-rendered key backgrounds of all matrices together
+#define LV_CPP_KEY_ATLAS_BITMAPS 32
+#endif
+
+#ifndef LV_CPP_KEY_ATLAS_BYTES
+/// Bitmap bytes all key atlases may hold together
+#define LV_CPP_KEY_ATLAS_BYTES (256u * 1024u)
+#endif
+
+namespace lv::key_atlas {
+
+/// Counters of the key atlases
+struct Stats {
+    uint32_t matrices;      ///< matrices with the atlas enabled
+    uint32_t bitmaps;       ///< key backgrounds rendered and held
+    uint32_t bytes;         ///< bitmap bytes held
+    uint32_t renders;       ///< key backgrounds rendered
+    uint32_t atlas_draws;   ///< keys drawn from a bitmap
+    uint32_t direct_draws;  ///< keys drawn directly (bitmap pending or over the cap)
+    uint32_t skipped;       ///< keys outside the refreshed area, not drawn
+    uint32_t narrowed;      ///< whole-matrix invalidations narrowed to one key
+};
+
+namespace detail {
+
+/// Draw descriptors of the ITEMS part in one key state
+struct Look {
+    lv_state_t state = LV_STATE_DEFAULT;
+    bool used = false;
+    int32_t ext = 0;                 ///< shadow/outline reach outside the key
+    lv_draw_rect_dsc_t rect;
+    lv_draw_label_dsc_t label;
+};
+
+struct Key {
+    const char* text = nullptr;   ///< map_p[txt] when measured
+    uint16_t txt = 0;             ///< index in the map, "\n" rows skipped
+    int16_t w = 0, h = 0;         ///< text size
+};
+
+/// Per-map geometry: where each key's text is and how large it is
+struct Geometry {
+    const char* const* map = nullptr;
+    uint32_t btn_cnt = 0;
+    int32_t width = 0;             ///< matrix width the text was measured against
+    Key keys[LV_CPP_KEY_ATLAS_KEYS];
+};
+
+struct Matrix {
+    lv_obj_t* obj = nullptr;
+    Look looks[LV_CPP_KEY_ATLAS_STATES];
+    uint8_t next_look = 0;
+    Geometry maps[LV_CPP_KEY_ATLAS_MAPS];
+    uint8_t next_map = 0;
+    uint32_t btn_cnt = 0;          ///< hidden key count, restored at DRAW_MAIN_END
+    bool substituted = false;
+};
+
+struct Bitmap {
+    lv_obj_t* obj = nullptr;
+    int32_t w = 0, h = 0;
+    lv_state_t state = LV_STATE_DEFAULT;
+    lv_draw_buf_t* buf = nullptr;   ///< nullptr: requested, rendered at REFR_READY
+    int32_t ext = 0;
+    bool failed = false;            ///< over the byte cap or out of memory: drawn directly
+};
+
+struct Tables {
+    Matrix matrices[LV_CPP_KEY_ATLASES];
+    Bitmap bitmaps[LV_CPP_KEY_ATLAS_BITMAPS];
+    lv_obj_t* pressing = nullptr;   ///< matrix whose pressed state is changing
+    lv_area_t target{};             ///< key area the state change is narrowed to
+    Stats stats{};
+};
+
+[[nodiscard]] inline Tables& tables() noexcept {
+    static Tables t;
+    return t;
+}
+
+[[nodiscard]] inline Matrix* find(lv_obj_t* obj) noexcept {
+    for (Matrix& m : tables().matrices) {
+        if (m.obj == obj) return &m;
+    }
+    return nullptr;
+}
+
+[[nodiscard]] inline lv_buttonmatrix_t* btnm(lv_obj_t* obj) noexcept {
+    return reinterpret_cast<lv_buttonmatrix_t*>(obj);
+}
+
+/// State key `i` is drawn in, as the matrix's draw_main() derives it
+[[nodiscard]] inline lv_state_t key_state(lv_obj_t* obj, uint32_t i) noexcept {
+    const lv_buttonmatrix_t* b = btnm(obj);
+    const lv_buttonmatrix_ctrl_t ctrl = b->ctrl_bits[i];
+    lv_state_t s = LV_STATE_DEFAULT;
+    if (ctrl & LV_BUTTONMATRIX_CTRL_CHECKED) s |= LV_STATE_CHECKED;
+    if (ctrl & LV_BUTTONMATRIX_CTRL_DISABLED) {
+        s |= LV_STATE_DISABLED;
+    } else if (i == b->btn_id_sel) {
+        s |= lv_obj_get_state(obj) &
+             (LV_STATE_PRESSED | LV_STATE_FOCUSED | LV_STATE_FOCUS_KEY | LV_STATE_EDITED);
+    }
+    return s;
+}
+
+/// Key `i`'s area on screen
+[[nodiscard]] inline lv_area_t key_area(lv_obj_t* obj, uint32_t i) noexcept {
+    lv_area_t a = btnm(obj)->button_areas[i];
+    lv_area_move(&a, obj->coords.x1, obj->coords.y1);
+    return a;
+}
+
+[[nodiscard]] inline Look& look(Matrix& m, lv_state_t state) noexcept {
+    for (Look& l : m.looks) {
+        if (l.used && l.state == state) return l;
+    }
+    Look& l = m.looks[m.next_look];
+    m.next_look = static_cast<uint8_t>((m.next_look + 1) % LV_CPP_KEY_ATLAS_STATES);
+    lv_obj_t* obj = m.obj;
+    const lv_state_t saved = obj->state;
+    obj->state = state;
+    obj->skip_trans = 1;
+    lv_draw_rect_dsc_init(&l.rect);
+    lv_obj_init_draw_rect_dsc(obj, LV_PART_ITEMS, &l.rect);
+    lv_draw_label_dsc_init(&l.label);
+    lv_obj_init_draw_label_dsc(obj, LV_PART_ITEMS, &l.label);
+    l.ext = lv_obj_calculate_ext_draw_size(obj, LV_PART_ITEMS);
+    obj->state = saved;
+    obj->skip_trans = 0;
+    l.state = state;
+    l.used = true;
+    return l;
+}
+
+/// Geometry of the current map, measured on first use; nullptr if it has too many keys
+[[nodiscard]] inline Geometry* geometry(Matrix& m) noexcept {
+    const lv_buttonmatrix_t* b = btnm(m.obj);
+    if (b->btn_cnt > LV_CPP_KEY_ATLAS_KEYS) return nullptr;
+    const int32_t width = lv_obj_get_width(m.obj);
+    for (Geometry& g : m.maps) {
+        if (g.map == b->map_p && g.btn_cnt == b->btn_cnt && g.width == width) return &g;
+    }
+    Geometry& g = m.maps[m.next_map];
+    m.next_map = static_cast<uint8_t>((m.next_map + 1) % LV_CPP_KEY_ATLAS_MAPS);
+    g.map = b->map_p;
+    g.btn_cnt = b->btn_cnt;
+    g.width = width;
+    uint16_t txt = 0;
+    for (uint32_t i = 0; i < b->btn_cnt; ++i, ++txt) {
+        while (std::strcmp(b->map_p[txt], "\n") == 0) ++txt;
+        g.keys[i] = Key{nullptr, txt, 0, 0};   // text measured when first drawn
+    }
+    return &g;
+}
+
+[[nodiscard]] inline Bitmap* find_bitmap(lv_obj_t* obj, int32_t w, int32_t h, lv_state_t state) noexcept {
+    for (Bitmap& bm : tables().bitmaps) {
+        if (bm.obj == obj && bm.w == w && bm.h == h && bm.state == state) return &bm;
+    }
+    return nullptr;
+}
+
+inline void free_bitmap(Bitmap& bm) noexcept {
+    Stats& s = tables().stats;
+    if (bm.buf) {
+        s.bytes -= bm.buf->data_size;
+        --s.bitmaps;
+        lv_image_cache_drop(bm.buf);
+        lv_draw_buf_destroy(bm.buf);
+    }
+    bm = Bitmap{};
+}
+
+inline void free_bitmaps(lv_obj_t* obj) noexcept {
+    for (Bitmap& bm : tables().bitmaps) {
+        if (bm.obj == obj) free_bitmap(bm);
+    }
+}
+
+/// Render `l`'s rectangle for a `w` x `h` key into a new pooled bitmap
+[[nodiscard]] inline lv_draw_buf_t* render(lv_display_t* disp, const Look& l, int32_t w, int32_t h) noexcept {
+    Stats& s = tables().stats;
+    const auto bw = static_cast<uint32_t>(w + 2 * l.ext);
+    const auto bh = static_cast<uint32_t>(h + 2 * l.ext);
+    const uint32_t need = lv_draw_buf_width_to_stride(bw, LV_COLOR_FORMAT_ARGB8888) * bh;
+    if (s.bytes + need > LV_CPP_KEY_ATLAS_BYTES) return nullptr;
+    lv_draw_buf_t* buf = lv_draw_buf_create_ex(draw::pool_handlers(), bw, bh, LV_COLOR_FORMAT_ARGB8888, 0);
+    if (!buf) return nullptr;
+    lv_draw_buf_clear(buf, nullptr);
+    lv_layer_t layer;
+    lv_layer_init(&layer);
+    layer.draw_buf = buf;
+    layer.color_format = LV_COLOR_FORMAT_ARGB8888;
+    layer.buf_area = lv_area_t{0, 0, static_cast<int32_t>(bw) - 1, static_cast<int32_t>(bh) - 1};
+    layer._clip_area = layer.buf_area;
+    layer.phy_clip_area = layer.buf_area;
+    const lv_area_t a{l.ext, l.ext, l.ext + w - 1, l.ext + h - 1};
+    // Finish the draw tasks synchronously, as snapshot::detail::redraw() does
+    lv_display_t* disp_old = lv_refr_get_disp_refreshing();
+    lv_layer_t* head_old = disp->layer_head;
+    disp->layer_head = &layer;
+    lv_refr_set_disp_refreshing(disp);
+    lv_draw_rect(&layer, &l.rect, &a);
+    while (layer.draw_task_head) {
+        lv_draw_dispatch_wait_for_request();
+        if (!lv_draw_dispatch_layer(disp, &layer)) {
+            lv_draw_wait_for_finish();
+            lv_draw_dispatch_request();
+        }
+    }
+    disp->layer_head = head_old;
+    lv_refr_set_disp_refreshing(disp_old);
+    s.bytes += buf->data_size;
+    ++s.bitmaps;
+    ++s.renders;
+    return buf;
+}
+
+/// Render the bitmaps requested while drawing
+inline void refr_ready_cb(lv_event_t* ev) noexcept {
+    auto* disp = static_cast<lv_display_t*>(lv_event_get_current_target(ev));
+    for (Bitmap& bm : tables().bitmaps) {
+        if (!bm.obj || bm.buf || bm.failed || lv_obj_get_display(bm.obj) != disp) continue;
+        Matrix* m = find(bm.obj);
+        if (!m) {
+            bm = Bitmap{};
+            continue;
+        }
+        const Look& l = look(*m, bm.state);
+        bm.ext = l.ext;
+        bm.buf = render(disp, l, bm.w, bm.h);
+        // Keep the slot so the key is not requested again every frame
+        bm.failed = !bm.buf;
+    }
+}
+
+/// Narrow the whole-matrix invalidation of a pressed state change to the key
+inline void invalidate_area_cb(lv_event_t* ev) noexcept {
+    Tables& t = tables();
+    if (!t.pressing) return;
+    auto* a = static_cast<lv_area_t*>(lv_event_get_param(ev));
+    // The state change invalidates first; the matrix's own per-key areas are never larger than a key
+    if (a && lv_area_is_in(&t.target, a, 0) && lv_area_get_size(a) > lv_area_get_size(&t.target)) {
+        *a = t.target;
+        ++t.stats.narrowed;
+    }
+    t.pressing = nullptr;
+}
+
+/// Key a press or release changes: the one under the pointer, else the selected one
+[[nodiscard]] inline uint32_t pressed_key(lv_obj_t* obj, lv_event_code_t code) noexcept {
+    const lv_buttonmatrix_t* b = btnm(obj);
+    lv_indev_t* indev = lv_indev_active();
+    if (code != LV_EVENT_PRESSED || !indev || lv_indev_get_type(indev) != LV_INDEV_TYPE_POINTER) {
+        return b->btn_id_sel;
+    }
+    lv_point_t p;
+    lv_indev_get_point(indev, &p);
+    for (uint32_t i = 0; i < b->btn_cnt; ++i) {
+        const lv_area_t a = key_area(obj, i);
+        if (lv_area_is_point_on(&a, &p, 0)) return i;
+    }
+    return LV_BUTTONMATRIX_BUTTON_NONE;
+}
+
+/// Preprocess: runs before lv_obj adds or removes LV_STATE_PRESSED
+inline void press_cb(lv_event_t* ev) noexcept {
+    auto* obj = static_cast<lv_obj_t*>(lv_event_get_current_target(ev));
+    const uint32_t i = pressed_key(obj, lv_event_get_code(ev));
+    if (i == LV_BUTTONMATRIX_BUTTON_NONE || i >= btnm(obj)->btn_cnt) return;
+    Tables& t = tables();
+    t.target = key_area(obj, i);
+    // Same growth as the matrix's invalidate_button_area()
+    const int32_t col_gap = lv_obj_get_style_pad_column(obj, LV_PART_MAIN);
+    const int32_t row_gap = lv_obj_get_style_pad_row(obj, LV_PART_MAIN);
+    lv_area_increase(&t.target, col_gap, row_gap);
+    t.pressing = obj;
+}
+
+inline void press_done_cb(lv_event_t*) noexcept {
+    tables().pressing = nullptr;
+}
+
+/// Let the class draw only the background: hide the keys until DRAW_MAIN_END
+inline void draw_main_begin_cb(lv_event_t* ev) noexcept {
+    Matrix* m = find(static_cast<lv_obj_t*>(lv_event_get_current_target(ev)));
+    if (!m || !geometry(*m)) return;
+    lv_buttonmatrix_t* b = btnm(m->obj);
+    m->btn_cnt = b->btn_cnt;
+    b->btn_cnt = 0;
+    m->substituted = true;
+}
+
+inline void draw_key(Matrix& m, Geometry& g, lv_layer_t* layer, uint32_t i) noexcept {
+    Tables& t = tables();
+    lv_obj_t* obj = m.obj;
+    const lv_area_t a = key_area(obj, i);
+    const lv_state_t state = key_state(obj, i);
+    Look& l = look(m, state);
+    lv_area_t reach = a;
+    lv_area_increase(&reach, l.ext, l.ext);
+    lv_area_t clip;
+    if (!lv_area_intersect(&clip, &reach, &layer->_clip_area)) {
+        ++t.stats.skipped;
+        return;
+    }
+
+    const int32_t w = lv_area_get_width(&a);
+    const int32_t h = lv_area_get_height(&a);
+    Bitmap* bm = find_bitmap(obj, w, h, state);
+    if (!bm) {
+        bm = find_bitmap(nullptr, 0, 0, LV_STATE_DEFAULT);
+        if (bm) *bm = Bitmap{obj, w, h, state, nullptr, 0, false};
+    }
+    if (bm && bm->buf) {
+        lv_draw_image_dsc_t img;
+        lv_draw_image_dsc_init(&img);
+        img.src = bm->buf;
+        img.base.id1 = i;
+        const lv_area_t ia{a.x1 - bm->ext, a.y1 - bm->ext, a.x2 + bm->ext, a.y2 + bm->ext};
+        lv_draw_image(layer, &img, &ia);
+        ++t.stats.atlas_draws;
+    } else {
+        l.rect.base.id1 = i;
+        lv_draw_rect(layer, &l.rect, &a);
+        ++t.stats.direct_draws;
+    }
+
+    Key& k = g.keys[i];
+    const char* text = btnm(obj)->map_p[k.txt];
+    if (k.text != text) {
+        lv_point_t size;
+        lv_text_get_size(&size, text, l.label.font, l.label.letter_space, l.label.line_space,
+                         g.width, LV_TEXT_FLAG_NONE);
+        k.text = text;
+        k.w = static_cast<int16_t>(size.x);
+        k.h = static_cast<int16_t>(size.y);
+    }
+    lv_area_t ta;
+    ta.x1 = a.x1 + (w - k.w) / 2;
+    ta.y1 = a.y1 + (h - k.h) / 2;
+    ta.x2 = ta.x1 + k.w;
+    ta.y2 = ta.y1 + k.h;
+    l.label.text = text;
+    l.label.base.id1 = i;
+    lv_draw_label(layer, &l.label, &ta);
+}
+
+/// Draw the keys inside the refreshed area and give the matrix its keys back
+inline void draw_main_end_cb(lv_event_t* ev) noexcept {
+    Matrix* m = find(static_cast<lv_obj_t*>(lv_event_get_current_target(ev)));
+    if (!m || !m->substituted) return;
+    lv_buttonmatrix_t* b = btnm(m->obj);
+    b->btn_cnt = m->btn_cnt;
+    m->substituted = false;
+    Geometry* g = geometry(*m);
+    if (!g) return;
+    lv_layer_t* layer = lv_event_get_layer(ev);
+    for (uint32_t i = 0; i < b->btn_cnt; ++i) {
+        if (b->ctrl_bits[i] & LV_BUTTONMATRIX_CTRL_HIDDEN) continue;
+        draw_key(*m, *g, layer, i);
+    }
+}
+
+/// Re-resolve the key styles and render the backgrounds again
+inline void forget(Matrix& m) noexcept {
+    for (Look& l : m.looks) l.used = false;
+    for (Geometry& g : m.maps) g.map = nullptr;
+    free_bitmaps(m.obj);
+}
+
+inline void style_cb(lv_event_t* ev) noexcept {
+    Matrix* m = find(static_cast<lv_obj_t*>(lv_event_get_current_target(ev)));
+    if (m) forget(*m);
+}
+
+inline void release(Matrix& m, bool deleting) noexcept {
+    Tables& t = tables();
+    if (!deleting) {
+        lv_obj_remove_event_cb(m.obj, &press_cb);
+        lv_obj_remove_event_cb(m.obj, &press_done_cb);
+        lv_obj_remove_event_cb(m.obj, &draw_main_begin_cb);
+        lv_obj_remove_event_cb(m.obj, &draw_main_end_cb);
+        lv_obj_remove_event_cb(m.obj, &style_cb);
+        lv_obj_invalidate(m.obj);
+    }
+    if (t.pressing == m.obj) t.pressing = nullptr;
+    free_bitmaps(m.obj);
+    --t.stats.matrices;
+    m = Matrix{};
+}
+
+inline void delete_cb(lv_event_t* ev) noexcept {
+    Matrix* m = find(static_cast<lv_obj_t*>(lv_event_get_current_target(ev)));
+    if (m) release(*m, true);
+}
+
+} // namespace detail
+
+/**
+ * @brief Draw `matrix`'s keys from pre-rendered backgrounds, only where refreshed
+ *
+ * `matrix` must be a ButtonMatrix or a Keyboard. Returns false if all
+ * LV_CPP_KEY_ATLASES slots are in use. Enabling twice is a no-op.
+ */
+inline bool enable(ObjectView matrix) noexcept {
+    lv_obj_t* o = matrix.get();
+    if (!o || !lv_obj_has_class(o, &lv_buttonmatrix_class)) return false;
+    if (detail::find(o)) return true;
+    detail::Matrix* m = detail::find(nullptr);
+    if (!m) return false;
+    m->obj = o;
+    ++detail::tables().stats.matrices;
+    for (lv_event_code_t code : {LV_EVENT_PRESSED, LV_EVENT_RELEASED, LV_EVENT_PRESS_LOST}) {
+        lv_obj_add_event_cb(o, &detail::press_cb, static_cast<lv_event_code_t>(code | LV_EVENT_PREPROCESS),
+                            nullptr);
+        lv_obj_add_event_cb(o, &detail::press_done_cb, code, nullptr);
+    }
+    lv_obj_add_event_cb(o, &detail::draw_main_begin_cb, LV_EVENT_DRAW_MAIN_BEGIN, nullptr);
+    lv_obj_add_event_cb(o, &detail::draw_main_end_cb, LV_EVENT_DRAW_MAIN_END, nullptr);
+    lv_obj_add_event_cb(o, &detail::style_cb, LV_EVENT_STYLE_CHANGED, nullptr);
+    lv_obj_add_event_cb(o, &detail::delete_cb, LV_EVENT_DELETE, nullptr);
+    lv_display_t* disp = lv_obj_get_display(o);
+    lv_display_remove_event_cb_with_user_data(disp, &detail::refr_ready_cb, nullptr);
+    lv_display_add_event_cb(disp, &detail::refr_ready_cb, LV_EVENT_REFR_READY, nullptr);
+    lv_display_remove_event_cb_with_user_data(disp, &detail::invalidate_area_cb, nullptr);
+    lv_display_add_event_cb(disp, &detail::invalidate_area_cb, LV_EVENT_INVALIDATE_AREA, nullptr);
+    lv_obj_invalidate(o);
+    return true;
+}
+
+/// Let LVGL draw `matrix` again and free its bitmaps
+inline void disable(ObjectView matrix) noexcept {
+    detail::Matrix* m = matrix.get() ? detail::find(matrix.get()) : nullptr;
+    if (!m) return;
+    lv_obj_remove_event_cb(m->obj, &detail::delete_cb);
+    detail::release(*m, false);
+}
+
+/// Whether the key atlas is enabled for `matrix`
+[[nodiscard]] inline bool enabled(ObjectView matrix) noexcept {
+    return matrix.get() && detail::find(matrix.get());
+}
+
+/**
+ * @brief Measure the key texts and render the backgrounds again
+ *
+ * Needed after editing a map array in place with styles or texts whose
+ * size changes, or after changing styles without LV_EVENT_STYLE_CHANGED.
+ */
+inline void refresh(ObjectView matrix) noexcept {
+    detail::Matrix* m = matrix.get() ? detail::find(matrix.get()) : nullptr;
+    if (!m) return;
+    detail::forget(*m);
+    lv_obj_invalidate(m->obj);
+}
+
+[[nodiscard]] inline Stats stats() noexcept { return detail::tables().stats; }
+
+/// Zero the render/draw counters (sizes are kept)
+inline void reset_stats() noexcept {
+    Stats& s = detail::tables().stats;
+    s.renders = s.atlas_draws = s.direct_draws = s.skipped = s.narrowed = 0;
+}
+
+/// Free every bitmap; keys are drawn directly until they are rendered again
+inline void drop() noexcept {
+    for (detail::Bitmap& bm : detail::tables().bitmaps) {
+        if (bm.obj) detail::free_bitmap(bm);
+    }
+}
+
+} // namespace lv::key_atlas
+
+#endif // LV_USE_BUTTONMATRIX
@@ -10,14 +10,38 @@
 #include "../core/event.hpp"
 #include "../core/style.hpp"
 #include "../core/string_utils.hpp"
+#include "../core/text_cache.hpp"
+#include "../core/format.hpp"
+#include "../core/static_text.hpp"
+#include "../core/translation.hpp"
+#include <cstddef>
+#include <cstring>
 #include <string_view>
 #include <type_traits>
 
 namespace lv {
 
-// Forward declaration – full definition in core/state.hpp.
-// bind_text() below requires State<T> to be complete at the point of instantiation.
+// Forward declarations – full definitions in core/state.hpp and core/computed.hpp.
+// bind_text() below requires State<T>/Computed to be complete at the point of instantiation.
 template<typename T> class State;
+template<size_t N> class StringState;
+template<typename T, typename F, typename... Deps> class Computed;
+struct throttle;
+
+/**
+ * @brief Storage for Label::bind_text(state, storage): the format and the text it produces
+ *
+ * @code
+ * static lv::StaticText<16> rpm_text{"%d rpm"};
+ * label.bind_text(rpm, rpm_text);
+ * @endcode
+ */
+template<size_t N>
+struct StaticText {
+    static_assert(N > 1, "StaticText needs room for a character and the terminator");
+    const char* fmt;
+    char buf[N] = {};
+};
 
 /**
  * @brief Label widget wrapper
@@ -53,8 +77,11 @@ public:
 
     // ==================== Text ====================
 
-    /// Set label text (LVGL copies the string)
-    Label& text(const char* txt) noexcept {
+    /// Set label text (LVGL copies the string; skipped if the text is unchanged)
+    Label& text(const char* txt LV_CPP_SETTER_SITE) noexcept {
+        const bool same = text_cache::unchanged(lv_label_get_text(m_obj), txt);
+        LV_CPP_SETTER_RECORD("text", m_obj, same);
+        if (same) return *this;
         lv_label_set_text(m_obj, txt);
         return *this;
     }
@@ -66,6 +93,12 @@ public:
         return *this;
     }
 
+    /// Set label text with a compile-time format: `text(lv::fmt<"{} km/h">, v)`
+    template<FixedString F, typename... Args>
+    Label& text(const Format<F>& f, const Args&... args) noexcept {
+        return text(f(args...).c_str());
+    }
+
     /// Set label text (static - string must remain valid)
     Label& text_static(const char* txt) noexcept {
         lv_label_set_text_static(m_obj, txt);
@@ -73,10 +106,36 @@ public:
     }
 
     /// Set text from string_view (safely copies to ensure null-termination)
-    Label& text(std::string_view txt) noexcept {
-        with_cstr(txt, [this](const char* cstr) {
-            lv_label_set_text(m_obj, cstr);
-        });
+    Label& text(std::string_view txt LV_CPP_SETTER_SITE) noexcept {
+        with_cstr(txt, [&](const char* cstr) { text(cstr LV_CPP_SETTER_SITE_ARG); });
+        return *this;
+    }
+
+    /// Set a string literal as text without copying it
+    Label& text(static_text txt) noexcept {
+        lv_label_set_text_static(m_obj, txt.c_str());
+        return *this;
+    }
+
+    /**
+     * @brief Show caller-owned text without copying it
+     *
+     * `txt` must be followed by a NUL (`txt.data()[txt.size()] == '\0'`,
+     * as for literals, std::string and TextBuffer) and stay valid while the
+     * label shows it. Pass its `owner` to have the lifetime checked.
+     */
+    Label& text_view(std::string_view txt, const TextOwner* owner = nullptr) noexcept {
+#if LV_CPP_TEXT_LIFETIME_CHECKS
+        LV_ASSERT_MSG(txt.data() && txt.data()[txt.size()] == '\0', "text_view() needs NUL-terminated text");
+#endif
+        detail::set_label_text_view(m_obj, txt.data(), owner);
+        return *this;
+    }
+
+    /// Show a TextBuffer without copying it (checked against the buffer's lifetime)
+    template<size_t N>
+    Label& text_view(const TextBuffer<N>& buf) noexcept {
+        detail::set_label_text_view(m_obj, buf.c_str(), &buf);
         return *this;
     }
 
@@ -157,6 +216,12 @@ public:
         lv_label_set_translation_tag(m_obj, tag);
         return *this;
     }
+
+    /// Show lv::tr(tag) and relabel in translation::switch_language() (hashed lookup, batched)
+    Label& translated(const char* tag) noexcept {
+        translation::bind(m_obj, tag);
+        return *this;
+    }
 #endif
 
     // ==================== Style Shortcuts ====================
@@ -217,16 +282,14 @@ public:
 
     // ==================== Geometry ====================
 
-    /// Get text size info
+    /// Get text size info (wrapped at the label's width; cached in text_cache)
     [[nodiscard]] lv_point_t text_size() const noexcept {
-        lv_point_t size;
-        lv_text_get_size(&size, lv_label_get_text(m_obj),
-                         lv_obj_get_style_text_font(m_obj, LV_PART_MAIN),
-                         lv_obj_get_style_text_letter_space(m_obj, LV_PART_MAIN),
-                         lv_obj_get_style_text_line_space(m_obj, LV_PART_MAIN),
-                         lv_obj_get_width(m_obj),
-                         LV_TEXT_FLAG_NONE);
-        return size;
+        return measure(lv_obj_get_width(m_obj));
+    }
+
+    /// Size of the current text wrapped at `max_width` (cached in text_cache)
+    [[nodiscard]] lv_point_t measure(int32_t max_width = LV_COORD_MAX) const noexcept {
+        return text_cache::layout(*this, lv_label_get_text(m_obj), max_width).size;
     }
 
     // ==================== Binding (for reactive state) ====================
@@ -238,13 +301,104 @@ public:
         return *this;
     }
 
-    /// Bind to State<int>
+    /// Bind to State<int> (updates that format to the current text are skipped)
     template<typename T>
         requires std::is_integral_v<T>
     Label& bind_text(State<T>& state, const char* fmt = "%d") noexcept {
-        lv_label_bind_text(m_obj, state.subject(), fmt);
+        text_cache::bind_label_int_text(m_obj, state.subject(), fmt);
+        return *this;
+    }
+
+    /// Bind to State<int> with a compile-time format: `bind_text(rpm, lv::fmt<"{} rpm">)`
+    template<typename T, FixedString F>
+        requires std::is_integral_v<T>
+    Label& bind_text(State<T>& state, const Format<F>&) noexcept {
+        static_assert(Format<F>::arg_count == 1, "bind_text: the format needs exactly one field");
+        lv_subject_add_observer_obj(state.subject(), &format_text_cb<T, F>, m_obj, nullptr);
+        return *this;
+    }
+
+    /**
+     * @brief Bind to State<int>, formatting into caller-owned storage
+     *
+     * The label shows `storage.buf` as static text, so an update that
+     * changes the text neither reallocates it nor copies it twice. `storage`
+     * must outlive the label; texts longer than N - 1 are cut.
+     */
+    template<typename T, size_t N>
+        requires (std::is_integral_v<T> && sizeof(T) <= sizeof(int32_t))
+    Label& bind_text(State<T>& state, StaticText<N>& storage) noexcept {
+        lv_subject_add_observer_obj(state.subject(), &static_text_cb<N>, m_obj, &storage);
+        return *this;
+    }
+
+    /// Bind to State<int>, updating the text at most once per interval (latest value wins)
+    template<typename T>
+        requires (std::is_integral_v<T> && sizeof(T) <= sizeof(int32_t))
+    Label& bind_text(State<T>& state, const char* fmt, const throttle& interval) noexcept {
+        state.bind_label_text(m_obj, fmt, interval);
+        return *this;
+    }
+
+    /**
+     * @brief Bind to a StringState: the label shows the state's buffer as static text
+     *
+     * Updates neither allocate nor copy the text. The state must outlive
+     * the label.
+     */
+    template<size_t N>
+    Label& bind_text(StringState<N>& state) noexcept {
+        lv_subject_add_observer_obj(state.subject(), &string_state_cb, m_obj, nullptr);
+        return *this;
+    }
+
+    /// Bind to an integer Computed
+    template<typename T, typename F, typename... Deps>
+        requires std::is_integral_v<T>
+    Label& bind_text(Computed<T, F, Deps...>& value, const char* fmt = "%d") noexcept {
+        text_cache::bind_label_int_text(m_obj, value.subject(), fmt);
+        return *this;
+    }
+
+    /// Bind to an integer Computed with a compile-time format
+    template<typename T, typename F, typename... Deps, FixedString S>
+        requires std::is_integral_v<T>
+    Label& bind_text(Computed<T, F, Deps...>& value, const Format<S>&) noexcept {
+        static_assert(Format<S>::arg_count == 1, "bind_text: the format needs exactly one field");
+        lv_subject_add_observer_obj(value.subject(), &format_text_cb<T, S>, m_obj, nullptr);
         return *this;
     }
+
+    /// Bind to an integer Computed, updating the text at most once per interval
+    template<typename T, typename F, typename... Deps>
+        requires std::is_integral_v<T>
+    Label& bind_text(Computed<T, F, Deps...>& value, const char* fmt, const throttle& interval) noexcept {
+        value.bind_label_text(m_obj, fmt, interval);
+        return *this;
+    }
+
+private:
+    static void string_state_cb(lv_observer_t* observer, lv_subject_t* subject) noexcept {
+        lv_label_set_text_static(lv_observer_get_target_obj(observer), lv_subject_get_string(subject));
+    }
+
+    template<typename T, FixedString F>
+    static void format_text_cb(lv_observer_t* observer, lv_subject_t* subject) noexcept {
+        const auto s = fmt<F>(static_cast<T>(lv_subject_get_int(subject)));
+        lv_obj_t* label = lv_observer_get_target_obj(observer);
+        if (!text_cache::unchanged(lv_label_get_text(label), s.c_str())) lv_label_set_text(label, s.c_str());
+    }
+
+    template<size_t N>
+    static void static_text_cb(lv_observer_t* observer, lv_subject_t* subject) noexcept {
+        auto* st = static_cast<StaticText<N>*>(lv_observer_get_user_data(observer));
+        char buf[N];
+        lv_snprintf(buf, N, st->fmt, static_cast<int>(lv_subject_get_int(subject)));
+        lv_obj_t* label = lv_observer_get_target_obj(observer);
+        if (lv_label_get_text(label) == st->buf && text_cache::unchanged(st->buf, buf)) return;
+        std::memcpy(st->buf, buf, N);
+        lv_label_set_text_static(label, st->buf);
+    }
 #endif
 };
 
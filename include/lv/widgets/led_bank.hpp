@@ -0,0 +1,249 @@
+#pragma once
+
+/**
+ * @file led_bank.hpp
+ * @brief Hundreds of status lights drawn by one object from a packed state array
+ *
+ * Every lv::Led is an lv_obj_t with its own style list, shadow and
+ * invalidation, several hundred bytes each, so a 256-light status panel
+ * costs tens of kilobytes and a tree walk per refresh. A LedBank is one
+ * object that draws N lights on a grid fixed at compile time (Cols
+ * columns, Pitch pixels apart, Size pixels wide) from a bitset and one
+ * brightness byte per light:
+ *
+ * @code
+ * #include <lv/widgets/led_bank.hpp>
+ *
+ * static lv::LedBank<256, 16> panel;              // 16 x 16 lights, 20 px pitch
+ * panel.mount(screen);
+ * panel.color(lv_palette_main(LV_PALETTE_GREEN)).glow(3);
+ * panel.set(17, true);                            // invalidates light 17 only
+ * panel.brightness(18, 128);
+ * panel.assign(status_words);                     // uint32_t[8] from the PLC, diffed
+ * @endcode
+ *
+ * set(), toggle(), brightness() and assign() invalidate only the lights
+ * that change, including their glow. The draw handler walks only the cells
+ * under the clip area. index_at() maps a point to a light for click
+ * handlers.
+ *
+ * Not included by lv.hpp: the draw handler culls against
+ * lv_layer_t::_clip_area, which has no getter. Checked against LVGL 9.4
+ * (see LV_CPP_INTERNALS_OK).
+ *
+ * Heap allocation: NONE besides the one LVGL object (N / 8 + N bytes of
+ * state in the component)
+ */
+
+#include <lvgl.h>
+#include "../core/version.hpp"
+
+#if !LV_CPP_INTERNALS_OK
+#error "led_bank.hpp reads LVGL internals checked against LVGL 9.4; see LV_CPP_INTERNALS_OK"
+#endif
+
+#include <src/draw/lv_draw_private.h>   // lv_layer_t::_clip_area
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include "../core/object.hpp"
+#include "../core/component.hpp"
+
+namespace lv {
+
+/**
+ * @brief N lights in rows of Cols, drawn by one object
+ *
+ * Non-movable: its draw event keeps a pointer to it.
+ *
+ * @tparam N Lights
+ * @tparam Cols Lights per row
+ * @tparam Pitch Distance between light centres (px)
+ * @tparam Size Light diameter (px)
+ */
+template<uint32_t N, uint32_t Cols, int32_t Pitch = 20, int32_t Size = 14>
+class LedBank : public Component<LedBank<N, Cols, Pitch, Size>> {
+    static_assert(N > 0 && Cols > 0, "LedBank needs lights and columns");
+    static_assert(Size > 0 && Size <= Pitch, "LedBank lights must fit their pitch");
+
+public:
+    static constexpr uint32_t ROWS = (N + Cols - 1) / Cols;
+    static constexpr uint32_t WORDS = (N + 31) / 32;   ///< uint32_t words of the on/off bitset
+
+private:
+    static constexpr int32_t INSET = (Pitch - Size) / 2;
+
+    uint32_t m_on[WORDS] = {};
+    uint8_t m_bright[N];
+    lv_color_t m_color = lv_color_hex(0x4caf50);
+    lv_opa_t m_off_mix = 50;       ///< Share of the color left in an off light
+    int32_t m_glow = 0;
+
+    [[nodiscard]] bool bit(uint32_t i) const noexcept { return (m_on[i / 32] >> (i % 32)) & 1u; }
+
+    /// Screen area of light `i` (without glow)
+    [[nodiscard]] lv_area_t cell(const lv_area_t& coords, uint32_t i) const noexcept {
+        lv_area_t a;
+        a.x1 = coords.x1 + static_cast<int32_t>(i % Cols) * Pitch + INSET;
+        a.y1 = coords.y1 + static_cast<int32_t>(i / Cols) * Pitch + INSET;
+        a.x2 = a.x1 + Size - 1;
+        a.y2 = a.y1 + Size - 1;
+        return a;
+    }
+
+    void invalidate(uint32_t i) noexcept {
+        if (!this->is_mounted()) return;
+        lv_obj_t* obj = this->root().get();
+        lv_area_t coords;
+        lv_obj_get_coords(obj, &coords);
+        lv_area_t a = cell(coords, i);
+        lv_area_increase(&a, m_glow, m_glow);
+        lv_obj_invalidate_area(obj, &a);
+    }
+
+    void invalidate_all() noexcept {
+        if (this->is_mounted()) lv_obj_invalidate(this->root().get());
+    }
+
+    void draw(lv_layer_t* layer) noexcept {
+        lv_area_t coords;
+        lv_obj_get_coords(this->root().get(), &coords);
+        const lv_area_t& clip = layer->_clip_area;
+        if (clip.x2 < coords.x1 - m_glow || clip.y2 < coords.y1 - m_glow) return;
+        const auto first = [](int32_t from, int32_t limit) {
+            return from <= 0 ? 0 : static_cast<uint32_t>(LV_MIN(from / Pitch, limit));
+        };
+        const uint32_t c0 = first(clip.x1 - coords.x1 - m_glow, static_cast<int32_t>(Cols));
+        const uint32_t c1 = first(clip.x2 - coords.x1 + m_glow, static_cast<int32_t>(Cols) - 1);
+        const uint32_t r0 = first(clip.y1 - coords.y1 - m_glow, static_cast<int32_t>(ROWS));
+        const uint32_t r1 = first(clip.y2 - coords.y1 + m_glow, static_cast<int32_t>(ROWS) - 1);
+
+        lv_draw_rect_dsc_t dsc;
+        lv_draw_rect_dsc_init(&dsc);
+        dsc.radius = LV_RADIUS_CIRCLE;
+        dsc.shadow_color = m_color;
+        const lv_color_t off = lv_color_mix(m_color, lv_color_black(), m_off_mix);
+        for (uint32_t r = r0; r <= r1; ++r) {
+            for (uint32_t c = c0; c <= c1 && c < Cols; ++c) {
+                const uint32_t i = r * Cols + c;
+                if (i >= N) break;
+                const bool on = bit(i);
+                dsc.bg_color = on ? lv_color_mix(m_color, lv_color_black(), m_bright[i]) : off;
+                dsc.shadow_width = on ? m_glow : 0;
+                dsc.shadow_opa = m_bright[i];
+                const lv_area_t a = cell(coords, i);
+                lv_draw_rect(layer, &dsc, &a);
+            }
+        }
+    }
+
+    static void draw_cb(lv_event_t* e) noexcept {
+        static_cast<LedBank*>(lv_event_get_user_data(e))->draw(lv_event_get_layer(e));
+    }
+
+    static void ext_draw_cb(lv_event_t* e) noexcept {
+        lv_event_set_ext_draw_size(e, static_cast<LedBank*>(lv_event_get_user_data(e))->m_glow);
+    }
+
+public:
+    LedBank() noexcept { std::memset(m_bright, LV_OPA_COVER, sizeof(m_bright)); }
+
+    ~LedBank() { this->unmount(); }
+
+    LedBank(LedBank&&) = delete;
+    LedBank& operator=(LedBank&&) = delete;
+
+    /// Component build(): one plain object the size of the grid
+    ObjectView build(ObjectView parent) {
+        lv_obj_t* obj = lv_obj_create(parent.get());
+        lv_obj_remove_style_all(obj);
+        lv_obj_remove_flag(obj, LV_OBJ_FLAG_SCROLLABLE);
+        lv_obj_set_size(obj, static_cast<int32_t>(Cols) * Pitch, static_cast<int32_t>(ROWS) * Pitch);
+        lv_obj_add_event_cb(obj, &LedBank::draw_cb, LV_EVENT_DRAW_MAIN, this);
+        lv_obj_add_event_cb(obj, &LedBank::ext_draw_cb, LV_EVENT_REFR_EXT_DRAW_SIZE, this);
+        return ObjectView(obj);
+    }
+
+    // ==================== Appearance ====================
+
+    /// Color of a light at full brightness
+    LedBank& color(lv_color_t c) noexcept {
+        m_color = c;
+        invalidate_all();
+        return *this;
+    }
+
+    /// Share of the color an off light keeps (0: black)
+    LedBank& off_mix(lv_opa_t mix) noexcept {
+        m_off_mix = mix;
+        invalidate_all();
+        return *this;
+    }
+
+    /// Shadow width around lit lights (px); 0 draws no shadow
+    LedBank& glow(int32_t width) noexcept {
+        m_glow = width;
+        if (this->is_mounted()) lv_obj_refresh_ext_draw_size(this->root().get());
+        invalidate_all();
+        return *this;
+    }
+
+    // ==================== State ====================
+
+    /// Turn light `i` on or off; redraws it only if it changes
+    LedBank& set(uint32_t i, bool on) noexcept {
+        if (i >= N || bit(i) == on) return *this;
+        m_on[i / 32] ^= 1u << (i % 32);
+        invalidate(i);
+        return *this;
+    }
+
+    LedBank& toggle(uint32_t i) noexcept {
+        if (i < N) set(i, !bit(i));
+        return *this;
+    }
+
+    /// Brightness of light `i` when on (255: full color)
+    LedBank& brightness(uint32_t i, uint8_t value) noexcept {
+        if (i >= N || m_bright[i] == value) return *this;
+        m_bright[i] = value;
+        if (bit(i)) invalidate(i);
+        return *this;
+    }
+
+    /// Take the whole on/off state (bit i of word i / 32), redrawing the lights that change
+    LedBank& assign(const uint32_t (&words)[WORDS]) noexcept {
+        for (uint32_t w = 0; w < WORDS; ++w) {
+            uint32_t diff = m_on[w] ^ words[w];
+            if (w == WORDS - 1 && N % 32) diff &= (1u << (N % 32)) - 1;
+            m_on[w] ^= diff;
+            for (; diff; diff &= diff - 1) invalidate(w * 32 + static_cast<uint32_t>(std::countr_zero(diff)));
+        }
+        return *this;
+    }
+
+    /// Turn every light on or off
+    LedBank& set_all(bool on) noexcept {
+        uint32_t words[WORDS];
+        std::memset(words, on ? 0xFF : 0, sizeof(words));
+        return assign(words);
+    }
+
+    [[nodiscard]] bool is_on(uint32_t i) const noexcept { return i < N && bit(i); }
+    [[nodiscard]] uint8_t brightness(uint32_t i) const noexcept { return i < N ? m_bright[i] : 0; }
+    [[nodiscard]] const uint32_t (&state() const noexcept)[WORDS] { return m_on; }
+
+    /// Light under the screen point `p`, or N if none
+    [[nodiscard]] uint32_t index_at(lv_point_t p) const noexcept {
+        if (!this->is_mounted()) return N;
+        lv_area_t coords;
+        lv_obj_get_coords(this->root().get(), &coords);
+        const int32_t x = p.x - coords.x1, y = p.y - coords.y1;
+        if (x < 0 || y < 0) return N;
+        const uint32_t c = static_cast<uint32_t>(x / Pitch), r = static_cast<uint32_t>(y / Pitch);
+        const uint32_t i = r * Cols + c;
+        return c < Cols && i < N ? i : N;
+    }
+};
+
+} // namespace lv
@@ -0,0 +1,469 @@
+#pragma once
+
+/**
+ * @file log_view.hpp
+ * @brief Live log viewer over a fixed ring of lines
+ *
+ * Appending to a Label or Textarea and trimming its head copies the whole
+ * text and re-lays out the label on every line. LogView keeps lines in a
+ * ring: one byte arena plus a line table of fixed size, where a new line
+ * overwrites the oldest ones. Only the visible lines are bound to labels
+ * (recycled like VirtualList), all lines share one height, so scrolling
+ * and trimming never measure text.
+ *
+ * @code
+ * static lv::LogView<> logs;
+ * logs.mount(screen);
+ * logs.root().size(lv::pct(100), lv::pct(100));
+ * logs.capture_log();                   // LVGL's own LV_LOG_* output
+ * ...
+ * logs.append("sensor: 21.5 C");        // any thread
+ * @endcode
+ *
+ * append() only copies the text into the ring (under an lv_mutex when
+ * LVGL runs with an OS), so it is safe from any thread and from LVGL's log
+ * print callback, which may run in the middle of drawing. The first line
+ * after a flush posts one call through lv::post(); it resumes a timer that
+ * applies the lines that arrived meanwhile at most once per
+ * LV_DEF_REFR_PERIOD and pauses again when no lines come in.
+ *
+ * The view follows the newest line until the user scrolls it; scrolling
+ * back to the bottom follows again. Lines are cut at
+ * LV_CPP_LOG_VIEW_LINE_MAX bytes, tabs are shown as spaces, warnings and
+ * errors are coloured. The view must outlive its producers and the calls
+ * they posted.
+ *
+ * Heap allocation: none (the ring is part of the object) besides the
+ * MaxRows LVGL labels
+ */
+
+#include <lvgl.h>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include "../core/object.hpp"
+#include "../core/component.hpp"
+#include "../core/async.hpp"
+#include "../core/log.hpp"
+
+#if LV_USE_LABEL
+
+#ifndef LV_CPP_LOG_VIEW_LINE_MAX
+/// Longest line kept by a LogView (bytes, including the terminator)
+#define LV_CPP_LOG_VIEW_LINE_MAX 256
+#endif
+
+namespace lv {
+
+/**
+ * @brief Scrollable log over a ring of at most Lines lines in Bytes bytes
+ *
+ * Non-movable: events, the timer and posted calls keep a pointer to it.
+ *
+ * @tparam Lines Lines kept (older ones are dropped)
+ * @tparam Bytes Arena for their text (each line takes its length + 1)
+ * @tparam MaxRows Labels in the pool (visible lines plus one above and below)
+ */
+template<uint32_t Lines = 512, uint32_t Bytes = 32 * 1024, uint32_t MaxRows = 48>
+class LogView : public Component<LogView<Lines, Bytes, MaxRows>> {
+    static_assert(Bytes >= 2 * LV_CPP_LOG_VIEW_LINE_MAX, "LogView arena must hold at least two full lines");
+    static_assert(LV_CPP_LOG_VIEW_LINE_MAX <= 0x10000, "LV_CPP_LOG_VIEW_LINE_MAX must fit 16 bits");
+
+public:
+    struct Stats {
+        uint32_t lines = 0;       ///< Lines appended
+        uint32_t dropped = 0;     ///< Oldest lines overwritten
+        uint32_t cut = 0;         ///< Lines longer than LV_CPP_LOG_VIEW_LINE_MAX
+        uint32_t flushes = 0;     ///< Batches applied to the view
+        uint32_t bound = 0;       ///< Label texts set
+    };
+
+private:
+    static constexpr uint32_t UNBOUND = UINT32_MAX;
+
+    struct Entry {
+        uint32_t off;
+        uint16_t len;
+        uint8_t level;
+    };
+
+    // Ring (shared with producers; guarded by m_lock)
+    char m_arena[Bytes];
+    Entry m_entries[Lines];
+    uint32_t m_first = 0;         ///< Sequence number of the oldest line
+    uint32_t m_next = 0;          ///< Sequence number of the next line
+    uint32_t m_wr = 0;            ///< Arena write offset
+    Stats m_stats;
+#if LV_USE_OS != LV_OS_NONE
+    lv_mutex_t m_lock;
+#endif
+    std::atomic<bool> m_dirty{false};
+
+    // View (LVGL thread)
+    lv_obj_t* m_spacer = nullptr;
+    lv_timer_t* m_timer = nullptr;
+    lv_obj_t* m_rows[MaxRows] = {};
+    uint32_t m_bound[MaxRows];
+    uint8_t m_row_level[MaxRows];
+    uint32_t m_created = 0;
+    uint32_t m_shown_first = 0;   ///< Ring range the spacer and rows were laid out for
+    uint32_t m_shown_next = 0;
+    bool m_follow = true;
+    char m_text[LV_CPP_LOG_VIEW_LINE_MAX];
+
+#if LV_USE_LOG
+    static inline std::atomic<LogView*> s_sink{nullptr};
+    static inline lv_log_print_g_cb_t s_forward = nullptr;
+#endif
+
+    using Component<LogView>::m_root;
+
+    void lock() noexcept {
+#if LV_USE_OS != LV_OS_NONE
+        lv_mutex_lock(&m_lock);
+#endif
+    }
+
+    void unlock() noexcept {
+#if LV_USE_OS != LV_OS_NONE
+        lv_mutex_unlock(&m_lock);
+#endif
+    }
+
+    // ==================== Ring ====================
+
+    [[nodiscard]] Entry& entry(uint32_t seq) noexcept { return m_entries[seq % Lines]; }
+
+    void drop_oldest() noexcept {
+        ++m_first;
+        ++m_stats.dropped;
+    }
+
+    /// Store one line (locked); `text` has no '\n'
+    void push(std::string_view text, uint8_t level) noexcept {
+        if (!text.empty() && text.back() == '\r') text.remove_suffix(1);
+        auto len = static_cast<uint32_t>(text.size());
+        if (len > LV_CPP_LOG_VIEW_LINE_MAX - 1) {
+            len = LV_CPP_LOG_VIEW_LINE_MAX - 1;
+            ++m_stats.cut;
+        }
+        if (m_next - m_first == Lines) drop_oldest();
+        if (m_wr + len + 1 > Bytes) {
+            // Lines behind the write offset are the oldest; give up the arena tail
+            while (m_first != m_next && entry(m_first).off >= m_wr) drop_oldest();
+            m_wr = 0;
+        }
+        while (m_first != m_next && entry(m_first).off >= m_wr && entry(m_first).off < m_wr + len + 1) drop_oldest();
+
+        char* out = m_arena + m_wr;
+        for (uint32_t i = 0; i < len; ++i) out[i] = text[i] == '\t' ? ' ' : text[i];
+        out[len] = '\0';
+        entry(m_next) = Entry{m_wr, static_cast<uint16_t>(len), level};
+        ++m_next;
+        m_wr += len + 1;
+        ++m_stats.lines;
+    }
+
+    /// Copy line `seq` into m_text; returns its level, or UINT8_MAX if it was dropped
+    uint8_t copy_line(uint32_t seq) noexcept {
+        lock();
+        uint8_t level = UINT8_MAX;
+        m_text[0] = '\0';
+        if (static_cast<int32_t>(seq - m_first) >= 0 && static_cast<int32_t>(seq - m_next) < 0) {
+            const Entry& e = entry(seq);
+            std::memcpy(m_text, m_arena + e.off, e.len + 1u);
+            level = e.level;
+        }
+        unlock();
+        return level;
+    }
+
+    /// First line since the last flush: wake the timer from the LVGL thread
+    void schedule() noexcept {
+        if (m_dirty.exchange(true, std::memory_order_acq_rel)) return;
+        if (!post<&LogView::kick>(this)) m_dirty.store(false, std::memory_order_release);
+    }
+
+    void kick() noexcept {
+        if (m_timer) lv_timer_resume(m_timer);
+    }
+
+#if LV_USE_LOG
+    static void print_cb(lv_log_level_t level, const char* buf) {
+        if (s_forward) s_forward(level, buf);
+        if (LogView* view = s_sink.load(std::memory_order_acquire)) view->append(buf, level);
+    }
+#endif
+
+    // ==================== View ====================
+
+    [[nodiscard]] int32_t line_height() const noexcept {
+        return lv_font_get_line_height(lv_obj_get_style_text_font(m_root, LV_PART_MAIN));
+    }
+
+    [[nodiscard]] lv_obj_t* make_row() noexcept {
+        lv_obj_t* row = lv_label_create(m_root);
+        lv_label_set_long_mode(row, LV_LABEL_LONG_CLIP);
+        lv_obj_remove_flag(row, LV_OBJ_FLAG_CLICKABLE);
+        return row;
+    }
+
+    void unbind(uint32_t slot) noexcept {
+        m_bound[slot] = UNBOUND;
+        lv_obj_add_flag(m_rows[slot], LV_OBJ_FLAG_HIDDEN);
+    }
+
+    void bind(uint32_t slot, uint32_t seq, int32_t h) noexcept {
+        m_bound[slot] = seq;
+        const uint8_t level = copy_line(seq);
+        lv_obj_t* row = m_rows[slot];
+        lv_label_set_text(row, m_text);
+        lv_obj_set_y(row, static_cast<int32_t>(seq - m_shown_first) * h);
+        lv_obj_remove_flag(row, LV_OBJ_FLAG_HIDDEN);
+        if (level != m_row_level[slot]) {
+            m_row_level[slot] = level;
+            if (level == LV_LOG_LEVEL_ERROR) lv_obj_set_style_text_color(row, lv_palette_main(LV_PALETTE_RED), LV_PART_MAIN);
+            else if (level == LV_LOG_LEVEL_WARN) lv_obj_set_style_text_color(row, lv_palette_main(LV_PALETTE_ORANGE), LV_PART_MAIN);
+            else lv_obj_remove_local_style_prop(row, LV_STYLE_TEXT_COLOR, LV_PART_MAIN);
+        }
+        ++m_stats.bound;
+    }
+
+    [[nodiscard]] bool is_bound(uint32_t seq) const noexcept {
+        for (uint32_t i = 0; i < m_created; ++i) {
+            if (m_bound[i] == seq) return true;
+        }
+        return false;
+    }
+
+    /// Bind the visible lines (plus one either side) to rows, reusing rows already bound
+    void update() noexcept {
+        if (!m_root) return;
+        const uint32_t count = m_shown_next - m_shown_first;
+        const int32_t h = line_height();
+        if (h <= 0) return;
+        const int32_t top = lv_obj_get_scroll_y(m_root);
+        const int32_t bottom = top + lv_obj_get_content_height(m_root);
+        uint32_t first = top > h ? static_cast<uint32_t>(top / h) - 1 : 0;
+        uint32_t end = bottom > 0 ? static_cast<uint32_t>(bottom / h) + 2 : 1;
+        if (end > count) end = count;
+        if (first > end) first = end;
+        if (end - first > MaxRows) end = first + MaxRows;
+
+        for (uint32_t i = 0; i < m_created; ++i) {
+            if (m_bound[i] == UNBOUND) continue;
+            const uint32_t at = m_bound[i] - m_shown_first;
+            if (static_cast<int32_t>(at) < 0 || at < first || at >= end) unbind(i);
+            else lv_obj_set_y(m_rows[i], static_cast<int32_t>(at) * h);
+        }
+        uint32_t free_slot = 0;
+        for (uint32_t at = first; at < end; ++at) {
+            const uint32_t seq = m_shown_first + at;
+            if (is_bound(seq)) continue;
+            while (free_slot < m_created && m_bound[free_slot] != UNBOUND) ++free_slot;
+            if (free_slot == m_created) {
+                if (m_created == MaxRows) break;
+                m_row_level[m_created] = UINT8_MAX;
+                m_rows[m_created++] = make_row();
+            }
+            bind(free_slot, seq, h);
+        }
+    }
+
+    /// Apply the lines appended since the last flush (LVGL thread)
+    void flush() noexcept {
+        if (!m_root) return;
+        lock();
+        const uint32_t first = m_first;
+        const uint32_t next = m_next;
+        unlock();
+        const int32_t h = line_height();
+        const uint32_t dropped = first - m_shown_first;
+        m_shown_first = first;
+        m_shown_next = next;
+        ++m_stats.flushes;
+
+        const int32_t total = static_cast<int32_t>(next - first) * h;
+        lv_obj_set_height(m_spacer, total);
+        lv_obj_update_layout(m_root);
+        if (m_follow) {
+            const int32_t y = total - lv_obj_get_content_height(m_root);
+            lv_obj_scroll_to_y(m_root, y > 0 ? y : 0, LV_ANIM_OFF);
+        } else if (dropped) {
+            // Keep the lines the user is reading in place while the head is trimmed
+            const int32_t y = lv_obj_get_scroll_y(m_root) - static_cast<int32_t>(dropped) * h;
+            lv_obj_scroll_to_y(m_root, y > 0 ? y : 0, LV_ANIM_OFF);
+        }
+        update();
+    }
+
+    static void timer_cb(lv_timer_t* t) noexcept {
+        auto* self = static_cast<LogView*>(lv_timer_get_user_data(t));
+        if (!self->m_dirty.exchange(false, std::memory_order_acq_rel)) {
+            lv_timer_pause(t);
+            return;
+        }
+        self->flush();
+    }
+
+    static void scroll_cb(lv_event_t* e) noexcept {
+        static_cast<LogView*>(lv_event_get_user_data(e))->update();
+    }
+
+    /// A drag by the user stops following; ending at the bottom follows again
+    static void scroll_state_cb(lv_event_t* e) noexcept {
+        auto* self = static_cast<LogView*>(lv_event_get_user_data(e));
+        if (lv_event_get_code(e) == LV_EVENT_SCROLL_BEGIN) {
+            if (lv_indev_active()) self->m_follow = false;
+        } else if (lv_obj_get_scroll_bottom(self->m_root) <= self->line_height()) {
+            self->m_follow = true;
+        }
+    }
+
+    static void size_cb(lv_event_t* e) noexcept {
+        auto* self = static_cast<LogView*>(lv_event_get_user_data(e));
+        if (self->m_follow) self->flush();
+        else self->update();
+    }
+
+public:
+    LogView() noexcept {
+#if LV_USE_OS != LV_OS_NONE
+        lv_mutex_init(&m_lock);
+#endif
+        for (uint32_t i = 0; i < MaxRows; ++i) m_bound[i] = UNBOUND;
+    }
+
+    // Unmount here, while on_unmount() can still run on a live object
+    ~LogView() {
+#if LV_USE_LOG
+        if (s_sink.load(std::memory_order_acquire) == this) {
+            s_sink.store(nullptr, std::memory_order_release);
+            lv_log_register_print_cb(s_forward);
+        }
+#endif
+        this->unmount();
+#if LV_USE_OS != LV_OS_NONE
+        lv_mutex_delete(&m_lock);
+#endif
+    }
+
+    LogView(LogView&&) = delete;
+    LogView& operator=(LogView&&) = delete;
+
+    /// Component build(): scrollable container, spacer and the flush timer
+    ObjectView build(ObjectView parent) {
+        lv_obj_t* box = lv_obj_create(parent.get());
+        lv_obj_set_layout(box, LV_LAYOUT_NONE);    // rows are positioned absolutely
+
+        m_spacer = lv_obj_create(box);
+        lv_obj_remove_style_all(m_spacer);
+        lv_obj_remove_flag(m_spacer, LV_OBJ_FLAG_CLICKABLE);
+        lv_obj_set_size(m_spacer, 1, 0);
+
+        lv_obj_add_event_cb(box, &LogView::scroll_cb, LV_EVENT_SCROLL, this);
+        lv_obj_add_event_cb(box, &LogView::scroll_state_cb, LV_EVENT_SCROLL_BEGIN, this);
+        lv_obj_add_event_cb(box, &LogView::scroll_state_cb, LV_EVENT_SCROLL_END, this);
+        lv_obj_add_event_cb(box, &LogView::size_cb, LV_EVENT_SIZE_CHANGED, this);
+
+        m_timer = lv_timer_create(&LogView::timer_cb, LV_DEF_REFR_PERIOD, this);
+        lv_timer_pause(m_timer);
+
+        m_root = box;    // make_row() needs the parent before mount() stores it
+        m_created = 0;
+        for (uint32_t i = 0; i < MaxRows; ++i) m_bound[i] = UNBOUND;
+        m_dirty.store(false, std::memory_order_release);
+        flush();
+        return ObjectView(box);
+    }
+
+    void on_unmount() noexcept {
+        if (m_timer) lv_timer_delete(m_timer);
+        m_timer = nullptr;
+        m_spacer = nullptr;
+        m_created = 0;
+    }
+
+    // ==================== Lines ====================
+
+    /**
+     * @brief Add text; each '\n' starts a new line (any thread)
+     *
+     * A trailing '\n' does not add an empty line.
+     */
+    void append(std::string_view text, lv_log_level_t level = LV_LOG_LEVEL_INFO) noexcept {
+        if (!text.empty() && text.back() == '\n') text.remove_suffix(1);
+        lock();
+        for (;;) {
+            const size_t nl = text.find('\n');
+            push(text.substr(0, nl), static_cast<uint8_t>(level));
+            if (nl == std::string_view::npos) break;
+            text.remove_prefix(nl + 1);
+        }
+        unlock();
+        schedule();
+    }
+
+    /// Drop all lines (any thread)
+    void clear() noexcept {
+        lock();
+        m_first = m_next;
+        m_wr = 0;
+        unlock();
+        schedule();
+    }
+
+    /// Lines in the ring
+    [[nodiscard]] uint32_t line_count() noexcept {
+        lock();
+        const uint32_t n = m_next - m_first;
+        unlock();
+        return n;
+    }
+
+#if LV_USE_LOG
+    /**
+     * @brief Show LVGL's log output here
+     *
+     * Replaces the LVGL print callback; `forward` (e.g. a UART writer)
+     * still receives every message. Undone by the destructor.
+     */
+    void capture_log(lv_log_print_g_cb_t forward = nullptr) noexcept {
+        s_forward = forward;
+        s_sink.store(this, std::memory_order_release);
+        lv::log::set_print_cb(&LogView::print_cb);
+    }
+#endif
+
+    // ==================== Scrolling ====================
+
+    /// Keep the newest line in view (set false to hold the position)
+    LogView& follow(bool enable) noexcept {
+        m_follow = enable;
+        if (enable && m_root) flush();
+        return *this;
+    }
+
+    [[nodiscard]] bool following() const noexcept { return m_follow; }
+
+    /// Labels created so far
+    [[nodiscard]] uint32_t row_count() const noexcept { return m_created; }
+
+    [[nodiscard]] Stats stats() noexcept {
+        lock();
+        const Stats s = m_stats;
+        unlock();
+        return s;
+    }
+
+    void reset_stats() noexcept {
+        lock();
+        m_stats = Stats{};
+        unlock();
+    }
+};
+
+} // namespace lv
+
+#endif // LV_USE_LABEL
@@ -41,6 +41,11 @@ namespace lv {
  *       .center();
  * @endcode
  *
+ * Every frame is rendered by ThorVG on the UI thread. For short loops,
+ * lv::frames::cache() (core/frame_ahead.hpp) renders each frame once and
+ * plays the cached buffers; longer ones can render a few frames ahead in
+ * idle time.
+ *
  * Size: sizeof(void*) - 4 or 8 bytes
  */
 class Lottie : public ObjectView,
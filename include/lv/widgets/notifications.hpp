@@ -0,0 +1,330 @@
+#pragma once
+
+/**
+ * @file notifications.hpp
+ * @brief Toast notifications from a fixed set of reused boxes, coalesced and rate limited
+ *
+ * Creating an lv::Msgbox per message costs its objects and styles every
+ * time, and an alarm flood of hundreds of messages a second creates
+ * widgets faster than anyone can read them. Notifications owns Slots toast
+ * boxes, built on first use and hidden, not deleted, when they expire, so
+ * at most Slots toasts are visible and LVGL never holds more. post() only
+ * copies the message:
+ *
+ * - equal to a visible toast (same level and text): that toast's counter
+ *   goes up and its timeout restarts;
+ * - equal to a queued message: the queued counter goes up;
+ * - anything else waits in a ring of Queue messages, the oldest dropped
+ *   when the ring is full.
+ *
+ * @code
+ * static lv::Notifications<3, 32> notes;         // 3 visible, 32 waiting
+ * notes.mount(lv::ObjectView(lv_layer_top()));
+ * notes.show_ms(4000).interval_ms(250).align(LV_ALIGN_TOP_RIGHT, -8, 8);
+ * ...
+ * notes.post("Coolant temperature high", lv::NoticeLevel::error);
+ * @endcode
+ *
+ * One timer, paused while nothing is shown or queued, expires toasts,
+ * updates changed counters ("text (12)") at most once per
+ * LV_DEF_REFR_PERIOD and moves queued messages into free slots, one per
+ * interval_ms(). Clicking a toast dismisses it. Messages posted while the
+ * component is not mounted wait in the ring. post() runs on the UI thread;
+ * other threads go through lv::post().
+ *
+ * Heap allocation: none for messages (the ring is part of the object,
+ * LV_CPP_NOTIFY_TEXT bytes per message) besides the host box and two
+ * LVGL objects per slot, created once
+ */
+
+#include <lvgl.h>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include "../core/object.hpp"
+#include "../core/component.hpp"
+#include "../core/thread.hpp"
+
+#if LV_USE_LABEL
+
+#ifndef LV_CPP_NOTIFY_TEXT
+/// Longest notification text kept (bytes, including the terminator)
+#define LV_CPP_NOTIFY_TEXT 96
+#endif
+
+namespace lv {
+
+enum class NoticeLevel : uint8_t { info, warning, error };
+
+/**
+ * @brief At most Slots toasts on screen, Queue more waiting without LVGL objects
+ */
+template<uint32_t Slots = 3, uint32_t Queue = 32>
+class Notifications : public Component<Notifications<Slots, Queue>> {
+    static_assert(Slots > 0 && Queue > 0, "Notifications needs at least one slot and one queue entry");
+
+public:
+    struct Stats {
+        uint32_t posted = 0;
+        uint32_t shown = 0;       ///< Messages that got a toast
+        uint32_t coalesced = 0;   ///< Posts folded into an equal visible or queued message
+        uint32_t dropped = 0;     ///< Queued messages pushed out of a full ring
+        uint32_t builds = 0;      ///< Toast boxes created
+    };
+
+private:
+    struct Message {
+        uint32_t hash = 0;
+        uint32_t count = 0;
+        NoticeLevel level = NoticeLevel::info;
+        char text[LV_CPP_NOTIFY_TEXT] = {};
+
+        [[nodiscard]] bool same(uint32_t h, NoticeLevel l, std::string_view t) const noexcept {
+            return hash == h && level == l && t == text;
+        }
+    };
+
+    struct Toast {
+        lv_obj_t* box = nullptr;
+        lv_obj_t* label = nullptr;
+        Message msg;
+        uint32_t until = 0;       ///< lv_tick_get() at which it expires
+        uint32_t labelled = 0;    ///< msg.count the label shows
+        bool active = false;
+    };
+
+    Toast m_toasts[Slots];
+    Message m_queue[Queue];
+    uint32_t m_head = 0;
+    uint32_t m_queued = 0;
+    lv_timer_t* m_timer = nullptr;
+    uint32_t m_show_ms = 3000;
+    uint32_t m_interval_ms = 200;
+    uint32_t m_last_show = 0;
+    bool m_shown_any = false;
+    lv_align_t m_align = LV_ALIGN_BOTTOM_MID;
+    int32_t m_x = 0;
+    int32_t m_y = -16;
+    Stats m_stats;
+
+    [[nodiscard]] static uint32_t hash(std::string_view text, NoticeLevel level) noexcept {
+        uint32_t h = 2166136261u ^ static_cast<uint32_t>(level);   // FNV-1a
+        for (char c : text) h = (h ^ static_cast<uint8_t>(c)) * 16777619u;
+        return h;
+    }
+
+    /// Cut to LV_CPP_NOTIFY_TEXT - 1 bytes without splitting a UTF-8 sequence
+    [[nodiscard]] static std::string_view fit(std::string_view text) noexcept {
+        if (text.size() < LV_CPP_NOTIFY_TEXT) return text;
+        size_t n = LV_CPP_NOTIFY_TEXT - 1;
+        while (n > 0 && (static_cast<uint8_t>(text[n]) & 0xC0) == 0x80) --n;
+        return text.substr(0, n);
+    }
+
+    [[nodiscard]] static lv_color_t color_of(NoticeLevel level) noexcept {
+        switch (level) {
+            case NoticeLevel::warning: return lv_palette_darken(LV_PALETTE_ORANGE, 2);
+            case NoticeLevel::error: return lv_palette_darken(LV_PALETTE_RED, 2);
+            default: return lv_palette_darken(LV_PALETTE_GREY, 3);
+        }
+    }
+
+    void resume() noexcept {
+        if (m_timer) lv_timer_resume(m_timer);
+    }
+
+    void relabel(Toast& t) noexcept {
+        if (t.msg.count > 1) {
+            lv_label_set_text_fmt(t.label, "%s (%u)", t.msg.text, static_cast<unsigned>(t.msg.count));
+        } else {
+            lv_label_set_text(t.label, t.msg.text);
+        }
+        t.labelled = t.msg.count;
+    }
+
+    void build(Toast& t) {
+        t.box = lv_obj_create(this->root().get());
+        lv_obj_set_size(t.box, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
+        lv_obj_remove_flag(t.box, LV_OBJ_FLAG_SCROLLABLE);
+        lv_obj_add_flag(t.box, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_set_style_border_width(t.box, 0, 0);
+        lv_obj_set_style_text_color(t.box, lv_color_white(), 0);
+        lv_obj_add_event_cb(t.box, &Notifications::clicked_cb, LV_EVENT_CLICKED, this);
+        t.label = lv_label_create(t.box);
+        lv_obj_set_style_max_width(t.label, LV_DPX(280), 0);
+        ++m_stats.builds;
+    }
+
+    void show(Toast& t, const Message& m, uint32_t now) {
+        if (!t.box) build(t);
+        t.msg = m;
+        relabel(t);
+        lv_obj_set_style_bg_color(t.box, color_of(m.level), 0);
+        lv_obj_move_to_index(t.box, -1);     // newest last in the column
+        lv_obj_remove_flag(t.box, LV_OBJ_FLAG_HIDDEN);
+        t.until = now + m_show_ms;
+        t.active = true;
+        m_last_show = now;
+        m_shown_any = true;
+        ++m_stats.shown;
+    }
+
+    void hide(Toast& t) noexcept {
+        if (t.box) lv_obj_add_flag(t.box, LV_OBJ_FLAG_HIDDEN);
+        t.active = false;
+    }
+
+    void tick() {
+        const uint32_t now = lv_tick_get();
+        for (Toast& t : m_toasts) {
+            if (!t.active) continue;
+            if (static_cast<int32_t>(now - t.until) >= 0) {
+                hide(t);
+            } else if (t.labelled != t.msg.count) {
+                relabel(t);
+            }
+        }
+        while (m_queued > 0 && (!m_shown_any || now - m_last_show >= m_interval_ms)) {
+            Toast* slot = nullptr;
+            for (Toast& t : m_toasts) {
+                if (!t.active) {
+                    slot = &t;
+                    break;
+                }
+            }
+            if (!slot) break;
+            show(*slot, m_queue[m_head], now);
+            m_head = (m_head + 1) % Queue;
+            --m_queued;
+        }
+        if (m_queued == 0 && visible() == 0) lv_timer_pause(m_timer);
+    }
+
+    static void timer_cb(lv_timer_t* timer) {
+        static_cast<Notifications*>(lv_timer_get_user_data(timer))->tick();
+    }
+
+    static void clicked_cb(lv_event_t* e) {
+        auto* self = static_cast<Notifications*>(lv_event_get_user_data(e));
+        lv_obj_t* box = lv_event_get_current_target_obj(e);
+        for (Toast& t : self->m_toasts) {
+            if (t.box == box) self->hide(t);
+        }
+        self->resume();   // a queued message may take the slot
+    }
+
+public:
+    Notifications() = default;
+
+    ~Notifications() { this->unmount(); }
+
+    // ==================== Component ====================
+
+    /// Host column for the toasts; the boxes are created on first use
+    ObjectView build(ObjectView parent) {
+        lv_obj_t* host = lv_obj_create(parent.get());
+        lv_obj_remove_style_all(host);
+        lv_obj_remove_flag(host, LV_OBJ_FLAG_CLICKABLE);
+        lv_obj_remove_flag(host, LV_OBJ_FLAG_SCROLLABLE);
+        lv_obj_set_size(host, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
+        lv_obj_set_flex_flow(host, LV_FLEX_FLOW_COLUMN);
+        lv_obj_set_flex_align(host, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+        lv_obj_set_style_pad_row(host, LV_DPX(6), 0);
+        lv_obj_align(host, m_align, m_x, m_y);
+        m_timer = lv_timer_create(&Notifications::timer_cb, LV_DEF_REFR_PERIOD, this);
+        if (m_queued == 0) lv_timer_pause(m_timer);
+        return ObjectView(host);
+    }
+
+    void on_unmount() noexcept {
+        if (m_timer) lv_timer_delete(m_timer);
+        m_timer = nullptr;
+        for (Toast& t : m_toasts) t = Toast{};    // deleted with the host
+    }
+
+    // ==================== Configuration ====================
+
+    /// How long a toast stays up after its last post (ms)
+    Notifications& show_ms(uint32_t ms) noexcept {
+        m_show_ms = ms;
+        return *this;
+    }
+
+    /// Minimum gap between two queued messages getting a toast (ms)
+    Notifications& interval_ms(uint32_t ms) noexcept {
+        m_interval_ms = ms;
+        return *this;
+    }
+
+    /// Where the toast column sits in its parent
+    Notifications& align(lv_align_t align, int32_t x = 0, int32_t y = 0) noexcept {
+        m_align = align;
+        m_x = x;
+        m_y = y;
+        if (this->is_mounted()) lv_obj_align(this->root().get(), align, x, y);
+        return *this;
+    }
+
+    // ==================== Messages ====================
+
+    /// Show `text`, or count it against an equal visible or queued message (UI thread)
+    void post(std::string_view text, NoticeLevel level = NoticeLevel::info) noexcept {
+        ui_thread();
+        ++m_stats.posted;
+        text = fit(text);
+        const uint32_t h = hash(text, level);
+        for (Toast& t : m_toasts) {
+            if (t.active && t.msg.same(h, level, text)) {
+                ++t.msg.count;
+                t.until = lv_tick_get() + m_show_ms;
+                ++m_stats.coalesced;
+                return;
+            }
+        }
+        for (uint32_t i = 0; i < m_queued; ++i) {
+            Message& m = m_queue[(m_head + i) % Queue];
+            if (m.same(h, level, text)) {
+                ++m.count;
+                ++m_stats.coalesced;
+                return;
+            }
+        }
+        if (m_queued == Queue) {
+            m_head = (m_head + 1) % Queue;
+            --m_queued;
+            ++m_stats.dropped;
+        }
+        Message& m = m_queue[(m_head + m_queued) % Queue];
+        m.hash = h;
+        m.count = 1;
+        m.level = level;
+        std::memcpy(m.text, text.data(), text.size());
+        m.text[text.size()] = '\0';
+        ++m_queued;
+        resume();
+    }
+
+    /// Hide every toast and forget the queue
+    void clear() noexcept {
+        for (Toast& t : m_toasts) hide(t);
+        m_head = 0;
+        m_queued = 0;
+    }
+
+    // ==================== Queries ====================
+
+    [[nodiscard]] uint32_t visible() const noexcept {
+        uint32_t n = 0;
+        for (const Toast& t : m_toasts) n += t.active;
+        return n;
+    }
+
+    [[nodiscard]] uint32_t queued() const noexcept { return m_queued; }
+
+    [[nodiscard]] const Stats& stats() const noexcept { return m_stats; }
+    void reset_stats() noexcept { m_stats = Stats{}; }
+};
+
+} // namespace lv
+
+#endif // LV_USE_LABEL
@@ -0,0 +1,313 @@
+#pragma once
+
+/**
+ * @file pinyin_trie.hpp
+ * @brief Mapped trie dictionary for the Pinyin IME (opt-in)
+ *
+ * LVGL looks candidates up in an array of (syllable, characters) pairs,
+ * scanning all syllables of the input's first letter, and keeps the
+ * whole array in memory. PinyinTrie maps a dictionary compiled by
+ * scripts/pinyin_dict.py instead: a trie over the syllable letters whose
+ * nodes point at frequency-ranked candidate strings, so a lookup walks
+ * one node per input letter and nothing is copied:
+ *
+ * @code
+ * #include <lv/widgets/pinyin_trie.hpp>
+ *
+ * static lv::PinyinTrie dict("A:ime/pinyin.lpy");
+ * auto ime = lv::IMEPinyin::create(screen).keyboard(kb);
+ * dict.attach(ime);
+ * @endcode
+ *
+ * Not included by lv.hpp: attach() reads lv_ime_pinyin_t's input_char and
+ * mode, which have no getters. Checked against LVGL 9.4 (see
+ * LV_CPP_INTERNALS_OK).
+ *
+ * Heap allocation: NONE in the wrapper when mapped (a pooled copy of the
+ * file otherwise)
+ */
+
+#include <lvgl.h>
+#include "../core/version.hpp"
+
+#if LV_USE_IME_PINYIN
+
+#if !LV_CPP_INTERNALS_OK
+#error "pinyin_trie.hpp reads LVGL internals checked against LVGL 9.4; see LV_CPP_INTERNALS_OK"
+#endif
+
+#include <src/others/ime/lv_ime_pinyin_private.h>   // input_char, mode
+#include <cstdint>
+#include <cstring>
+#include "../core/mapped_file.hpp"
+#include "ime_pinyin.hpp"
+
+namespace lv {
+
+namespace detail::pinyin_trie {
+
+inline constexpr char magic[4] = {'L', 'V', 'P', 'Y'};
+
+/// File header; followed by `node_count` Nodes in breadth-first order and
+/// the string pool of NUL-terminated candidate strings
+struct Head {
+    char magic[4];
+    uint16_t version;
+    uint16_t top;           ///< Candidates kept for a syllable prefix
+    uint32_t node_count;
+    uint32_t pool_size;
+    uint32_t reserved;
+};
+static_assert(sizeof(Head) == 20, "pinyin dictionary header must be packed");
+
+struct Node {
+    uint32_t first_child;   ///< Children are contiguous and sorted by label
+    uint32_t cands;         ///< Pool offset of the candidate string
+    uint8_t child_count;
+    uint8_t label;          ///< Letter of the edge into this node
+    uint16_t cand_count;    ///< Characters (3 UTF-8 bytes each) in the candidate string
+};
+static_assert(sizeof(Node) == 12, "pinyin dictionary node must be packed");
+
+/// lv_pinyin_dict_t with assignable members (LVGL declares them const)
+struct Entry {
+    const char* py;
+    const char* py_mb;
+};
+static_assert(sizeof(Entry) == sizeof(lv_pinyin_dict_t), "Entry must match lv_pinyin_dict_t");
+
+} // namespace detail::pinyin_trie
+
+/**
+ * @brief Pinyin dictionary over a mapped .lpy file (scripts/pinyin_dict.py)
+ *
+ * lookup() returns the candidates of a syllable or syllable prefix, most
+ * frequent first, as a pointer into the mapping. attach() feeds them to an
+ * IMEPinyin in 26-key mode: the IME gets a 26 entry dictionary whose entry
+ * for the input's first letter is pointed at the trie's answer just
+ * before the IME searches, so memory use does not depend on the
+ * dictionary size. The 9-key modes keep searching that small dictionary
+ * and find no candidates.
+ *
+ * Not movable: attach() registers its address.
+ */
+class PinyinTrie {
+    static constexpr size_t input_max = sizeof(lv_ime_pinyin_t::input_char);
+
+    fs::MappedFile m_file;
+    const uint8_t* m_data = nullptr;
+    detail::pinyin_trie::Head m_head{};
+    const uint8_t* m_nodes = nullptr;
+    const char* m_pool = nullptr;
+
+    lv_obj_t* m_ime = nullptr;
+    lv_obj_t* m_kb = nullptr;
+    lv_pinyin_dict_t* m_prev = nullptr;          ///< IME dictionary before attach()
+    detail::pinyin_trie::Entry m_entries[27]{};  ///< a-z and the terminator
+    char m_letters[26][2]{};
+    char m_input[input_max]{};
+    int m_letter = -1;                           ///< Entry currently pointing at m_input
+
+    [[nodiscard]] detail::pinyin_trie::Node node(uint32_t i) const noexcept {
+        detail::pinyin_trie::Node n;
+        std::memcpy(&n, m_nodes + sizeof(n) * i, sizeof(n));
+        return n;
+    }
+
+    /// Check the layout and that every node stays inside the tables
+    [[nodiscard]] bool parse(const uint8_t* data, size_t size) noexcept {
+        namespace pt = detail::pinyin_trie;
+        if (size < sizeof(pt::Head)) return false;
+        std::memcpy(&m_head, data, sizeof(m_head));
+        if (std::memcmp(m_head.magic, pt::magic, sizeof(pt::magic)) != 0 || m_head.version != 1) return false;
+        const uint64_t nodes = m_head.node_count;
+        if (nodes == 0 || m_head.pool_size == 0 ||
+            sizeof(pt::Head) + nodes * sizeof(pt::Node) + m_head.pool_size > size) {
+            return false;
+        }
+        m_nodes = data + sizeof(pt::Head);
+        m_pool = reinterpret_cast<const char*>(m_nodes + nodes * sizeof(pt::Node));
+        for (uint32_t i = 0; i < nodes; ++i) {
+            const pt::Node n = node(i);
+            // Children lie behind their parent, so lookups always terminate
+            if (n.child_count && (n.first_child <= i || n.first_child + uint64_t{n.child_count} > nodes)) return false;
+            if (n.cands + 3 * uint64_t{n.cand_count} >= m_head.pool_size ||
+                m_pool[n.cands + 3 * n.cand_count] != '\0') {
+                return false;
+            }
+        }
+        m_data = data;
+        return true;
+    }
+
+    /// Point the IME's entry for `input`'s first letter at `input`'s candidates
+    void prepare(const char* input) noexcept {
+        if (m_letter >= 0) m_entries[m_letter] = {m_letters[m_letter], ""};
+        m_letter = -1;
+        if (input[0] < 'a' || input[0] > 'z') return;
+        std::strncpy(m_input, input, input_max - 1);
+        m_letter = input[0] - 'a';
+        m_entries[m_letter] = {m_input, lookup(m_input).text};
+    }
+
+    /// Preprocess: runs before the IME's own handler appends the key and searches
+    static void kb_cb(lv_event_t* e) noexcept {
+        auto* self = static_cast<PinyinTrie*>(lv_event_get_user_data(e));
+        const auto* ime = reinterpret_cast<const lv_ime_pinyin_t*>(self->m_ime);
+        if (ime->mode != LV_IME_PINYIN_MODE_K26) return;
+        auto* kb = static_cast<lv_obj_t*>(lv_event_get_current_target(e));
+        const uint32_t id = lv_buttonmatrix_get_selected_button(kb);
+        if (id == LV_BUTTONMATRIX_BUTTON_NONE) return;
+        const char* txt = lv_buttonmatrix_get_button_text(kb, id);
+        if (!txt) return;
+        // The input the IME is about to search for
+        char next[input_max];
+        size_t len = 0;
+        while (len < input_max - 1 && ime->input_char[len]) {
+            next[len] = ime->input_char[len];
+            ++len;
+        }
+        if (std::strcmp(txt, LV_SYMBOL_BACKSPACE) == 0) {
+            if (len < 2) return;
+            --len;
+        } else if (txt[0] >= 'a' && txt[0] <= 'z' && txt[1] == '\0') {
+            if (len + 1 >= input_max) return;
+            next[len++] = txt[0];
+        } else {
+            return;
+        }
+        next[len] = '\0';
+        self->prepare(next);
+    }
+
+    static void kb_delete_cb(lv_event_t* e) noexcept {
+        static_cast<PinyinTrie*>(lv_event_get_user_data(e))->m_kb = nullptr;
+    }
+
+    static void ime_delete_cb(lv_event_t* e) noexcept {
+        auto* self = static_cast<PinyinTrie*>(lv_event_get_user_data(e));
+        self->unhook();
+        self->m_ime = nullptr;
+    }
+
+    void unhook() noexcept {
+        if (m_kb) {
+            lv_obj_remove_event_cb_with_user_data(m_kb, &kb_cb, this);
+            lv_obj_remove_event_cb_with_user_data(m_kb, &kb_delete_cb, this);
+        }
+        m_kb = nullptr;
+        m_prev = nullptr;
+        m_letter = -1;
+    }
+
+public:
+    /// Candidates of an input, most frequent first
+    struct Candidates {
+        const char* text;   ///< NUL-terminated UTF-8, 3 bytes per character
+        uint32_t count;     ///< Characters in `text`
+    };
+
+    PinyinTrie() noexcept = default;
+
+    explicit PinyinTrie(const char* path) noexcept { open(path); }
+
+    ~PinyinTrie() { close(); }
+
+    PinyinTrie(const PinyinTrie&) = delete;
+    PinyinTrie& operator=(const PinyinTrie&) = delete;
+
+    /**
+     * @brief Map a dictionary (closes any current one first)
+     * @return false if the file is missing or not a valid dictionary
+     */
+    bool open(const char* path) noexcept {
+        close();
+        if (m_file.open(path) != LV_FS_RES_OK) return false;
+        if (!parse(m_file.data(), m_file.size())) {
+            LV_LOG_WARN("PinyinTrie: %s is not a pinyin dictionary", path);
+            m_file.close();
+            return false;
+        }
+        return true;
+    }
+
+    /// Use a dictionary already in memory (e.g. linked in); `data` must outlive the trie
+    bool open(const uint8_t* data, size_t size) noexcept {
+        close();
+        return parse(data, size);
+    }
+
+    void close() noexcept {
+        detach();
+        m_data = nullptr;
+        m_file.close();
+    }
+
+    [[nodiscard]] bool is_open() const noexcept { return m_data != nullptr; }
+    explicit operator bool() const noexcept { return is_open(); }
+
+    [[nodiscard]] uint32_t node_count() const noexcept { return m_data ? m_head.node_count : 0; }
+
+    /// Candidates of a syllable or syllable prefix ("zh", "zhong"); empty if none
+    [[nodiscard]] Candidates lookup(const char* input) const noexcept {
+        if (!m_data || !input || !input[0]) return {"", 0};
+        detail::pinyin_trie::Node n = node(0);
+        for (const char* p = input; *p; ++p) {
+            const uint32_t end = n.first_child + n.child_count;
+            uint32_t i = n.first_child;
+            while (i < end && node(i).label < static_cast<uint8_t>(*p)) ++i;
+            if (i == end || node(i).label != static_cast<uint8_t>(*p)) return {"", 0};
+            n = node(i);
+        }
+        return {m_pool + n.cands, n.cand_count};
+    }
+
+    // ==================== IME ====================
+
+    /**
+     * @brief Serve `ime`'s candidate lookups from this dictionary
+     *
+     * Set the IME's keyboard first; the previous dictionary is restored by
+     * detach(). Returns false if the dictionary is not open or the IME has
+     * no keyboard.
+     */
+    bool attach(ObjectView ime) noexcept {
+        detach();
+        lv_obj_t* obj = ime.get();
+        if (!m_data || !obj) return false;
+        lv_obj_t* kb = lv_ime_pinyin_get_kb(obj);
+        if (!kb) {
+            LV_LOG_WARN("PinyinTrie: set the IME's keyboard before attaching the dictionary");
+            return false;
+        }
+        for (int i = 0; i < 26; ++i) {
+            m_letters[i][0] = static_cast<char>('a' + i);
+            m_entries[i] = {m_letters[i], ""};
+        }
+        m_entries[26] = {nullptr, nullptr};
+        m_ime = obj;
+        m_kb = kb;
+        m_prev = const_cast<lv_pinyin_dict_t*>(lv_ime_pinyin_get_dict(obj));
+        lv_ime_pinyin_set_dict(obj, reinterpret_cast<lv_pinyin_dict_t*>(m_entries));
+        lv_obj_add_event_cb(kb, &kb_cb, static_cast<lv_event_code_t>(LV_EVENT_VALUE_CHANGED | LV_EVENT_PREPROCESS),
+                            this);
+        lv_obj_add_event_cb(kb, &kb_delete_cb, LV_EVENT_DELETE, this);
+        lv_obj_add_event_cb(obj, &ime_delete_cb, LV_EVENT_DELETE, this);
+        return true;
+    }
+
+    /// Give the IME its previous dictionary back
+    void detach() noexcept {
+        if (!m_ime) return;
+        lv_obj_remove_event_cb_with_user_data(m_ime, &ime_delete_cb, this);
+        if (m_prev) lv_ime_pinyin_set_dict(m_ime, m_prev);
+        unhook();
+        m_ime = nullptr;
+    }
+
+    [[nodiscard]] bool attached() const noexcept { return m_ime != nullptr; }
+};
+
+} // namespace lv
+
+#endif // LV_USE_IME_PINYIN
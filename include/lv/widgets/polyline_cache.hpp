@@ -0,0 +1,393 @@
+#pragma once
+
+/**
+ * @file polyline_cache.hpp
+ * @brief Simplified, spatially bucketed drawing of large Line point arrays
+ *
+ * lv_line makes one draw task per segment and walks the whole array on
+ * every redraw, so a 50000-point GPS track or plot costs 50000 tasks per
+ * frame, scrolled or zoomed, on screen or not. PolylineCache takes over
+ * drawing a Line's points:
+ *
+ * @code
+ * #include <lv/widgets/polyline_cache.hpp>
+ *
+ * static lv_point_precise_t track[50000];   // line-local pixels, kept valid
+ * static lv::PolylineCache cache;
+ * cache.attach(line, track, n);             // the line sizes itself to the track
+ * cache.tolerance(0.5f);                    // Douglas-Peucker, in screen pixels
+ * ...
+ * track[i] = gps_point(); cache.refresh();  // after changing points in place
+ * @endcode
+ *
+ * - The points are simplified with Douglas-Peucker at the current scale:
+ *   the product of the transform scales of the line and its parents,
+ *   rounded up to a power of two. Up to LV_CPP_POLYLINE_LEVELS scales are
+ *   cached, so zooming back and forth does not re-simplify.
+ * - The simplified points are split into buckets of LV_CPP_POLYLINE_BUCKET
+ *   points with a bounding box each. On a draw only buckets that touch the
+ *   clip area (plus half the line width) are drawn; each run of adjacent
+ *   visible buckets is one draw::polyline() task.
+ *
+ * The line's style (width, color, opacity, rounded ends, dashes) applies
+ * as before, and so does y_invert(). Joins are beveled, as in
+ * draw::polyline(). Points are pixels; LV_PCT coordinates are not
+ * supported. The line itself gets a single point at the track's maximum
+ * so that LV_SIZE_CONTENT still fits it.
+ *
+ * Not included by lv.hpp: it culls against lv_layer_t::_clip_area and
+ * draws through draw_mesh.hpp, both LVGL internals. Checked against LVGL
+ * 9.4 (see LV_CPP_INTERNALS_OK).
+ *
+ * Heap allocation: per cached scale, the simplified points and their
+ * bucket boxes (lv_malloc); one byte per point while simplifying; the
+ * visible runs are copied into FrameArena per draw
+ */
+
+#include <lvgl.h>
+#include "../core/version.hpp"
+
+#if LV_USE_LINE
+
+#if !LV_CPP_INTERNALS_OK
+#error "polyline_cache.hpp reads LVGL internals checked against LVGL 9.4; see LV_CPP_INTERNALS_OK"
+#endif
+
+#include <src/draw/lv_draw_private.h>   // lv_layer_t::_clip_area
+#include <cmath>
+#include <cstdint>
+#include "line.hpp"
+#include "../draw/draw_mesh.hpp"
+
+#ifndef LV_CPP_POLYLINE_LEVELS
+/// Scales whose simplification is kept per PolylineCache
+#define LV_CPP_POLYLINE_LEVELS 3
+#endif
+
+#ifndef LV_CPP_POLYLINE_BUCKET
+/// Simplified points per culling bucket
+#define LV_CPP_POLYLINE_BUCKET 64
+#endif
+
+namespace lv {
+
+/**
+ * @brief Draws a Line's large point array simplified and culled per bucket
+ *
+ * Non-movable: the line's draw and delete events keep a pointer to it.
+ */
+class PolylineCache {
+public:
+    struct Stats {
+        uint32_t draws = 0;
+        uint32_t simplifications = 0;    ///< Douglas-Peucker passes over the source
+        uint32_t points_in = 0;          ///< Source points
+        uint32_t points_kept = 0;        ///< Simplified points at the last drawn scale
+        uint32_t points_drawn = 0;       ///< Points in visible buckets, last draw
+        uint32_t buckets_drawn = 0;      ///< Last draw
+        uint32_t buckets_culled = 0;     ///< Last draw
+    };
+
+private:
+    struct Box {
+        float x1, y1, x2, y2;
+    };
+
+    struct Level {
+        lv_point_precise_t* pts = nullptr;
+        Box* boxes = nullptr;
+        uint32_t n = 0;
+        uint32_t nb = 0;
+        uint32_t used = 0;         ///< LRU stamp (0: free)
+        int8_t exp = 0;            ///< Scale 2^exp
+    };
+
+    lv_obj_t* m_line = nullptr;
+    const lv_point_precise_t* m_src = nullptr;
+    uint32_t m_count = 0;
+    lv_point_precise_t m_extent{};
+    Level m_levels[LV_CPP_POLYLINE_LEVELS];
+    uint32_t m_clock = 0;
+    float m_tolerance = 0.5f;
+    Stats m_stats;
+
+    static void draw_cb(lv_event_t* e) noexcept {
+        static_cast<PolylineCache*>(lv_event_get_user_data(e))->draw(lv_event_get_layer(e));
+    }
+
+    static void delete_cb(lv_event_t* e) noexcept {
+        auto* self = static_cast<PolylineCache*>(lv_event_get_user_data(e));
+        self->m_line = nullptr;
+    }
+
+    static void free_level(Level& l) noexcept {
+        lv_free(l.pts);
+        lv_free(l.boxes);
+        l = Level{};
+    }
+
+    /// Scale of the line on screen, rounded up to a power of two
+    [[nodiscard]] int8_t scale_exp() const noexcept {
+        float s = 1.0f;
+        for (lv_obj_t* o = m_line; o; o = lv_obj_get_parent(o)) {
+            const int32_t sx = lv_obj_get_style_transform_scale_x(o, LV_PART_MAIN);
+            const int32_t sy = lv_obj_get_style_transform_scale_y(o, LV_PART_MAIN);
+            s *= static_cast<float>(sx > sy ? sx : sy) / LV_SCALE_NONE;
+        }
+        const float e = std::ceil(std::log2(s > 0.0f ? s : 1.0f));
+        return static_cast<int8_t>(e < -16.0f ? -16 : e > 16.0f ? 16 : e);
+    }
+
+    /// Squared distance of `p` from the segment a-b
+    [[nodiscard]] static float dist2(const lv_point_precise_t& p, const lv_point_precise_t& a,
+                                     const lv_point_precise_t& b) noexcept {
+        const float ax = static_cast<float>(a.x), ay = static_cast<float>(a.y);
+        const float dx = static_cast<float>(b.x) - ax, dy = static_cast<float>(b.y) - ay;
+        float px = static_cast<float>(p.x) - ax, py = static_cast<float>(p.y) - ay;
+        const float len2 = dx * dx + dy * dy;
+        if (len2 > 0.0f) {
+            float t = (px * dx + py * dy) / len2;
+            t = t < 0.0f ? 0.0f : t > 1.0f ? 1.0f : t;
+            px -= t * dx;
+            py -= t * dy;
+        }
+        return px * px + py * py;
+    }
+
+    /**
+     * @brief Douglas-Peucker flags for the source points within `tol` (source units)
+     *
+     * Iterative: the span being refined ends at the next kept point, found
+     * by scanning `keep`, so no stack is needed. 0 tolerance keeps all.
+     */
+    void simplify(uint8_t* keep, float tol) const noexcept {
+        const uint32_t n = m_count;
+        if (tol <= 0.0f) {
+            lv_memset(keep, 1, n);
+            return;
+        }
+        lv_memzero(keep, n);
+        keep[0] = keep[n - 1] = 1;
+        const float tol2 = tol * tol;
+        uint32_t a = 0;
+        while (a < n - 1) {
+            uint32_t b = a + 1;
+            while (!keep[b]) ++b;
+            float best = 0.0f;
+            uint32_t k = a;
+            for (uint32_t i = a + 1; i < b; ++i) {
+                const float d = dist2(m_src[i], m_src[a], m_src[b]);
+                if (d > best) {
+                    best = d;
+                    k = i;
+                }
+            }
+            if (best > tol2) keep[k] = 1;   // refine [a, k] next
+            else a = b;
+        }
+    }
+
+    /// The level for scale 2^exp, simplified now if not cached
+    [[nodiscard]] Level* level(int8_t exp) noexcept {
+        Level* victim = &m_levels[0];
+        for (Level& l : m_levels) {
+            if (l.used && l.exp == exp) {
+                l.used = ++m_clock;
+                return &l;
+            }
+            if (!l.used || (victim->used && l.used < victim->used)) victim = &l;
+        }
+        auto* keep = static_cast<uint8_t*>(lv_malloc(m_count));
+        if (!keep) return nullptr;
+        simplify(keep, m_tolerance / std::ldexp(1.0f, exp));
+        uint32_t kept = 0;
+        for (uint32_t i = 0; i < m_count; ++i) kept += keep[i];
+        const uint32_t nb = (kept - 1 + LV_CPP_POLYLINE_BUCKET - 1) / LV_CPP_POLYLINE_BUCKET;
+        free_level(*victim);
+        auto* pts = static_cast<lv_point_precise_t*>(lv_malloc(sizeof(lv_point_precise_t) * kept));
+        auto* boxes = static_cast<Box*>(lv_malloc(sizeof(Box) * nb));
+        if (!pts || !boxes) {
+            LV_LOG_WARN("PolylineCache: out of memory for %u points", static_cast<unsigned>(kept));
+            lv_free(keep);
+            lv_free(pts);
+            lv_free(boxes);
+            return nullptr;
+        }
+        for (uint32_t i = 0, j = 0; i < m_count; ++i) {
+            if (keep[i]) pts[j++] = m_src[i];
+        }
+        lv_free(keep);
+        // Bucket b covers points [b * BUCKET, (b + 1) * BUCKET], sharing its last point with the next
+        for (uint32_t b = 0; b < nb; ++b) {
+            const uint32_t first = b * LV_CPP_POLYLINE_BUCKET;
+            const uint32_t last = first + LV_CPP_POLYLINE_BUCKET < kept - 1 ? first + LV_CPP_POLYLINE_BUCKET : kept - 1;
+            Box box{static_cast<float>(pts[first].x), static_cast<float>(pts[first].y),
+                    static_cast<float>(pts[first].x), static_cast<float>(pts[first].y)};
+            for (uint32_t i = first + 1; i <= last; ++i) {
+                const float x = static_cast<float>(pts[i].x), y = static_cast<float>(pts[i].y);
+                box.x1 = x < box.x1 ? x : box.x1;
+                box.x2 = x > box.x2 ? x : box.x2;
+                box.y1 = y < box.y1 ? y : box.y1;
+                box.y2 = y > box.y2 ? y : box.y2;
+            }
+            boxes[b] = box;
+        }
+        *victim = Level{pts, boxes, kept, nb, ++m_clock, exp};
+        ++m_stats.simplifications;
+        return victim;
+    }
+
+    /// Draw points [first, last] of `l` as one polyline, moved to the layer
+    void draw_run(lv_layer_t* layer, const Level& l, uint32_t first, uint32_t last, const LineDsc& dsc,
+                  int32_t x_ofs, int32_t y_ofs, int32_t h, bool y_inv) const noexcept {
+        const uint32_t n = last - first + 1;
+        auto map = [&](const lv_point_precise_t& p) {
+            lv_point_precise_t q;
+            q.x = p.x + x_ofs;
+            q.y = y_inv ? y_ofs + h - p.y : p.y + y_ofs;
+            return q;
+        };
+        auto* pts = FrameArena::instance().make_array<lv_point_precise_t>(n);
+        if (pts) {
+            for (uint32_t i = 0; i < n; ++i) pts[i] = map(l.pts[first + i]);
+            draw::polyline(layer, pts, n, dsc);
+            return;
+        }
+        LineDsc seg = dsc;
+        for (uint32_t i = first; i < last; ++i) {
+            seg.get()->p1 = map(l.pts[i]);
+            seg.get()->p2 = map(l.pts[i + 1]);
+            lv_draw_line(layer, seg.get());
+        }
+    }
+
+    void draw(lv_layer_t* layer) noexcept {
+        if (!m_line || !m_src || m_count < 2) return;
+        ++m_stats.draws;
+        LineDsc dsc;
+        lv_obj_init_draw_line_dsc(m_line, LV_PART_MAIN, dsc.get());
+        if (dsc.get()->opa <= LV_OPA_MIN || dsc.get()->width <= 0) return;
+        const Level* l = level(scale_exp());
+        if (!l) return;
+
+        // As lv_line places its points
+        lv_area_t coords;
+        lv_obj_get_coords(m_line, &coords);
+        const int32_t x_ofs = coords.x1 - lv_obj_get_scroll_x(m_line);
+        const int32_t y_ofs = coords.y1 - lv_obj_get_scroll_y(m_line);
+        const int32_t h = lv_obj_get_height(m_line);
+        const bool y_inv = lv_line_get_y_invert(m_line);
+
+        // The clip area in line-local units, grown by half the line width
+        const lv_area_t& clip = layer->_clip_area;
+        const float hw = static_cast<float>(dsc.get()->width) / 2 + 1;
+        const float vx1 = static_cast<float>(clip.x1 - x_ofs) - hw;
+        const float vx2 = static_cast<float>(clip.x2 - x_ofs) + hw;
+        const float vy1 = static_cast<float>(y_inv ? h - (clip.y2 - y_ofs) : clip.y1 - y_ofs) - hw;
+        const float vy2 = static_cast<float>(y_inv ? h - (clip.y1 - y_ofs) : clip.y2 - y_ofs) + hw;
+
+        m_stats.points_in = m_count;
+        m_stats.points_kept = l->n;
+        m_stats.points_drawn = m_stats.buckets_drawn = m_stats.buckets_culled = 0;
+        uint32_t run = UINT32_MAX;    // first bucket of the open run
+        for (uint32_t b = 0; b <= l->nb; ++b) {
+            const bool visible = b < l->nb && l->boxes[b].x2 >= vx1 && l->boxes[b].x1 <= vx2 &&
+                                 l->boxes[b].y2 >= vy1 && l->boxes[b].y1 <= vy2;
+            if (visible) {
+                ++m_stats.buckets_drawn;
+                if (run == UINT32_MAX) run = b;
+                continue;
+            }
+            if (b < l->nb) ++m_stats.buckets_culled;
+            if (run == UINT32_MAX) continue;
+            const uint32_t first = run * LV_CPP_POLYLINE_BUCKET;
+            const uint32_t last = b * LV_CPP_POLYLINE_BUCKET < l->n - 1 ? b * LV_CPP_POLYLINE_BUCKET : l->n - 1;
+            draw_run(layer, *l, first, last, dsc, x_ofs, y_ofs, h, y_inv);
+            m_stats.points_drawn += last - first + 1;
+            run = UINT32_MAX;
+        }
+    }
+
+    void drop_levels() noexcept {
+        for (Level& l : m_levels) free_level(l);
+    }
+
+public:
+    PolylineCache() noexcept = default;
+
+    ~PolylineCache() {
+        detach();
+        drop_levels();
+    }
+
+    PolylineCache(const PolylineCache&) = delete;
+    PolylineCache& operator=(const PolylineCache&) = delete;
+
+    // ==================== Setup ====================
+
+    /// Draw `count` points of `points` (kept valid by the caller) on `line` from now on
+    bool attach(Line line, const lv_point_precise_t* points, uint32_t count) noexcept {
+        detach();
+        if (!line.get()) return false;
+        m_line = line.get();
+        lv_obj_add_event_cb(m_line, &PolylineCache::draw_cb, LV_EVENT_DRAW_MAIN, this);
+        lv_obj_add_event_cb(m_line, &PolylineCache::delete_cb, LV_EVENT_DELETE, this);
+        this->points(points, count);
+        return true;
+    }
+
+    /// Stop drawing (the line is left without points)
+    void detach() noexcept {
+        if (m_line) {
+            lv_obj_remove_event_cb_with_user_data(m_line, &PolylineCache::draw_cb, this);
+            lv_obj_remove_event_cb_with_user_data(m_line, &PolylineCache::delete_cb, this);
+            lv_line_set_points(m_line, nullptr, 0);
+        }
+        m_line = nullptr;
+    }
+
+    /// Draw another point array (kept valid by the caller)
+    PolylineCache& points(const lv_point_precise_t* points, uint32_t count) noexcept {
+        m_src = points;
+        m_count = points ? count : 0;
+        refresh();
+        return *this;
+    }
+
+    /**
+     * @brief Maximum deviation of the simplified line, in screen pixels
+     *
+     * 0 keeps every point (buckets are still culled).
+     */
+    PolylineCache& tolerance(float px) noexcept {
+        m_tolerance = px;
+        drop_levels();
+        if (m_line) lv_obj_invalidate(m_line);
+        return *this;
+    }
+
+    [[nodiscard]] float tolerance() const noexcept { return m_tolerance; }
+
+    /// Re-simplify after the points changed in place; also refits the line's size
+    void refresh() noexcept {
+        drop_levels();
+        m_extent = lv_point_precise_t{};
+        for (uint32_t i = 0; i < m_count; ++i) {
+            if (m_src[i].x > m_extent.x) m_extent.x = m_src[i].x;
+            if (m_src[i].y > m_extent.y) m_extent.y = m_src[i].y;
+        }
+        if (!m_line) return;
+        // One point draws nothing in lv_line but still sizes it
+        lv_line_set_points(m_line, &m_extent, m_count ? 1 : 0);
+        lv_obj_invalidate(m_line);
+    }
+
+    // ==================== State ====================
+
+    [[nodiscard]] const Stats& stats() const noexcept { return m_stats; }
+    void reset_stats() noexcept { m_stats = {}; }
+};
+
+} // namespace lv
+
+#endif // LV_USE_LINE
@@ -3,6 +3,26 @@
 /**
  * @file scale.hpp
  * @brief Zero-cost wrapper for LVGL scale widget
+ *
+ * A scale recomputes and draws every tick, label and section whenever
+ * anything over it redraws, which for a gauge is every needle step.
+ * cache_static() (LV_USE_SNAPSHOT, defined in scale_cache.hpp) renders the
+ * scale's own drawing once into a cached_layer bitmap and leaves the
+ * needles, which are children of the scale, to redraw live on top of it:
+ *
+ * @code
+ * #include <lv/widgets/scale_cache.hpp>
+ *
+ * auto gauge = lv::Scale::create(screen).mode_round_inner().range(0, 60).ticks(31, 5);
+ * lv_obj_t* needle = lv_line_create(gauge);
+ * gauge.cache_static(true);
+ * lv_scale_set_line_needle_value(gauge, needle, 80, speed);   // only the needle redraws
+ * @endcode
+ *
+ * The bitmap is retaken when the mode, range, tick counts, label
+ * visibility, angle range or rotation change (checked before each cached
+ * draw, so also through the C API), through this wrapper's section and
+ * text setters, and on style or size changes.
  */
 
 #include <lvgl.h>
@@ -12,6 +32,20 @@
 
 namespace lv {
 
+namespace detail {
+/// Defined in scale_cache.hpp; include it to use Scale::cache_static()
+template <typename> struct ScaleCache;
+
+/// Static-part change hook installed by scale_cache.hpp (nullptr: no scale cached)
+/// `drop` is true when the cache no longer applies (post_draw(true))
+using scale_changed_fn = void (*)(lv_obj_t* obj, bool drop);
+
+[[nodiscard]] inline scale_changed_fn& scale_changed_hook() noexcept {
+    static scale_changed_fn hook = nullptr;
+    return hook;
+}
+} // namespace detail
+
 /**
  * @brief Scale widget wrapper
  *
@@ -23,6 +57,11 @@ class Scale : public ObjectView,
             public ObjectMixin<Scale>,
               public EventMixin<Scale>,
               public StyleMixin<Scale> {
+    /// Retake the static bitmap after a change the fingerprint does not see
+    void static_changed() noexcept {
+        if (detail::scale_changed_hook()) detail::scale_changed_hook()(m_obj, false);
+    }
+
 public:
     constexpr Scale() noexcept : ObjectView(nullptr) {}
     constexpr Scale(wrap_t, lv_obj_t* obj) noexcept : ObjectView(obj) {}
@@ -112,11 +151,13 @@ public:
     /// Set custom text source (array of strings for each major tick)
     Scale& text_src(const char* txt_src[]) noexcept {
         lv_scale_set_text_src(m_obj, txt_src);
+        static_changed();
         return *this;
     }
 
     /// Set post-draw callback for custom drawing
     Scale& post_draw(bool enable) noexcept {
+        if (enable && detail::scale_changed_hook()) detail::scale_changed_hook()(m_obj, true);
         lv_scale_set_post_draw(m_obj, enable);
         return *this;
     }
@@ -125,18 +166,21 @@ public:
 
     /// Add a section (colored range)
     [[nodiscard]] lv_scale_section_t* add_section() noexcept {
+        static_changed();
         return lv_scale_add_section(m_obj);
     }
 
     /// Set section range
     Scale& section_range(lv_scale_section_t* section, int32_t min, int32_t max) noexcept {
         lv_scale_section_set_range(section, min, max);
+        static_changed();
         return *this;
     }
 
     /// Set section style
     Scale& section_style(lv_scale_section_t* section, lv_part_t part, lv_style_t* style) noexcept {
         lv_scale_section_set_style(section, part, style);
+        static_changed();
         return *this;
     }
 
@@ -154,6 +198,29 @@ public:
         return *this;
     }
 
+    // ==================== Static Cache ====================
+
+#if LV_USE_SNAPSHOT
+    /**
+     * @brief Draw ticks, labels and sections from a cached bitmap; children (needles) stay live
+     *
+     * Not available with post_draw(true), where LVGL draws the ticks over
+     * the children every frame anyway.
+     * (requires #include <lv/widgets/scale_cache.hpp>)
+     */
+    template <typename Self = Scale>
+    Self& cache_static(bool en = true) noexcept {
+        detail::ScaleCache<Self>::set(m_obj, en);
+        return *static_cast<Self*>(this);
+    }
+
+    /// Whether the static parts are currently drawn from the bitmap
+    template <typename Self = Scale>
+    [[nodiscard]] bool is_static_cached() const noexcept {
+        return detail::ScaleCache<Self>::valid(m_obj);
+    }
+#endif
+
     // ==================== Size ====================
 
     /// Set size
@@ -0,0 +1,95 @@
+#pragma once
+
+/**
+ * @file scale_cache.hpp
+ * @brief Scale::cache_static(): ticks and labels from a cached bitmap (opt-in)
+ *
+ * Defines Scale::cache_static() and is_static_cached(), declared in
+ * scale.hpp. The scale's own drawing goes through cached_layer with
+ * Content::self, so children (needles) redraw live over the bitmap:
+ *
+ * @code
+ * #include <lv/widgets/scale_cache.hpp>
+ *
+ * gauge.cache_static(true);
+ * lv_scale_set_line_needle_value(gauge, needle, 80, speed);   // only the needle redraws
+ * @endcode
+ *
+ * The fingerprint compared before each cached draw covers the mode, range,
+ * tick counts, label visibility, angle range and rotation; the wrapper's
+ * section and text setters retake the bitmap through
+ * detail::scale_changed_hook().
+ *
+ * Not included by lv.hpp: cache_static() reads lv_scale_t::post_draw,
+ * which has no getter. Checked against LVGL 9.4 (see LV_CPP_INTERNALS_OK).
+ *
+ * Heap allocation: one cached_layer slot per cached scale
+ */
+
+#include <lvgl.h>
+#include "../core/version.hpp"
+
+#if LV_USE_SCALE && LV_USE_SNAPSHOT
+
+#if !LV_CPP_INTERNALS_OK
+#error "scale_cache.hpp reads LVGL internals checked against LVGL 9.4; see LV_CPP_INTERNALS_OK"
+#endif
+
+#include <src/widgets/scale/lv_scale_private.h>   // lv_scale_t::post_draw
+#include "../core/cached_layer.hpp"
+#include "scale.hpp"
+
+namespace lv {
+
+namespace detail {
+
+/// Properties LVGL changes without an event
+inline uint32_t scale_fingerprint(lv_obj_t* obj) noexcept {
+    const uint32_t parts[] = {
+        static_cast<uint32_t>(lv_scale_get_mode(obj)),
+        static_cast<uint32_t>(lv_scale_get_range_min_value(obj)),
+        static_cast<uint32_t>(lv_scale_get_range_max_value(obj)),
+        lv_scale_get_total_tick_count(obj),
+        lv_scale_get_major_tick_every(obj),
+        lv_scale_get_label_show(obj) ? 1u : 0u,
+        lv_scale_get_angle_range(obj),
+        static_cast<uint32_t>(lv_scale_get_rotation(obj)),
+    };
+    uint32_t h = 0x811C9DC5u;
+    for (uint32_t p : parts) h = (h ^ p) * 0x01000193u;
+    return h;
+}
+
+/// scale_changed_hook(): retake the bitmap, or drop it for post_draw(true)
+inline void scale_changed(lv_obj_t* obj, bool drop) noexcept {
+    if (drop) {
+        cached_layer::disable(ObjectView(obj));
+    } else {
+        cached_layer::invalidate(ObjectView(obj));
+    }
+}
+
+/// Scale::cache_static() lands here (declared in scale.hpp)
+template <typename>
+struct ScaleCache {
+    static void set(lv_obj_t* obj, bool en) noexcept {
+        if (!en) {
+            cached_layer::disable(ObjectView(obj));
+        } else if (reinterpret_cast<lv_scale_t*>(obj)->post_draw) {
+            LV_LOG_WARN("Scale: cache_static() does not apply with post_draw(true)");
+        } else {
+            scale_changed_hook() = &scale_changed;
+            cached_layer::enable(ObjectView(obj), cached_layer::Content::self, &scale_fingerprint);
+        }
+    }
+
+    [[nodiscard]] static bool valid(lv_obj_t* obj) noexcept {
+        return cached_layer::valid(ObjectView(obj));
+    }
+};
+
+} // namespace detail
+
+} // namespace lv
+
+#endif // LV_USE_SCALE && LV_USE_SNAPSHOT
@@ -3,15 +3,170 @@
 /**
  * @file span.hpp
  * @brief Zero-cost wrapper for LVGL span widget
+ *
+ * Setting a span's text or style makes LVGL invalidate the whole group.
+ * update_span_text() and update_span() (LVGL 9.2+) redraw only the lines
+ * that changed instead: they record the coordinates of the changed span
+ * and the spans after it, apply the change with the display's
+ * invalidation disabled, then compare the new coordinates span by span
+ * from the changed one and stop at the first following span whose lines
+ * came out the same. Only the rows between the first and the last
+ * differing line are invalidated, across the group's full width (aligned
+ * lines move as a whole). The spans are reached through
+ * lv_spangroup_get_child(), which walks from the head of the group, so the
+ * bookkeeping grows with the changed span's position:
+ *
+ * @code
+ * lv_span_t* typing = chat.new_span();
+ * chat.update_span_text(typing, "Anna is typing...");   // its own lines only
+ * @endcode
+ *
+ * Heap allocation: NONE in the wrapper (LVGL copies span texts)
  */
 
 #include <lvgl.h>
+#include <cstring>
+#include <utility>
 #include "../core/object.hpp"
 #include "../core/event.hpp"
 #include "../core/style.hpp"
+#include "../core/text_cache.hpp"
+#include "../core/version.hpp"
+
+#ifndef LV_CPP_SPAN_WALK
+/// Spans after a changed one compared for re-converged lines; beyond it the rest of the group is redrawn
+#define LV_CPP_SPAN_WALK 32
+#endif
 
 namespace lv {
 
+namespace span_layout {
+
+/// Counters of incremental span updates
+struct Stats {
+    uint32_t updates;    ///< update_span() / update_span_text() calls
+    uint32_t spans;      ///< spans whose coordinates were compared
+    uint32_t rows;       ///< pixel rows invalidated
+    uint32_t to_end;     ///< updates that redrew to the end (LV_CPP_SPAN_WALK reached or no coordinates)
+};
+
+namespace detail {
+
+[[nodiscard]] inline Stats& stats() noexcept {
+    static Stats s;
+    return s;
+}
+
+#if LV_VERSION_AT_LEAST(9, 2, 0)
+
+/// Grow [y1, y2] by the rows of `a`; unused parts of lv_span_coords_t are all zero
+inline void add_rows(const lv_area_t& a, int32_t& y1, int32_t& y2) noexcept {
+    if (a.x1 == 0 && a.y1 == 0 && a.x2 == 0 && a.y2 == 0) return;
+    if (a.y1 < y1) y1 = a.y1;
+    if (a.y2 > y2) y2 = a.y2;
+}
+
+inline void add_rows(const lv_span_coords_t& c, int32_t& y1, int32_t& y2) noexcept {
+    add_rows(c.heading, y1, y2);
+    add_rows(c.middle, y1, y2);
+    add_rows(c.trailing, y1, y2);
+}
+
+[[nodiscard]] inline bool same(const lv_span_coords_t& a, const lv_span_coords_t& b) noexcept {
+    return std::memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+/// Index of `span` in `group`, -1 if not found (lv_spangroup_get_child() walks from the head)
+[[nodiscard]] inline int32_t index_of(lv_obj_t* group, lv_span_t* span, uint32_t count) noexcept {
+    for (uint32_t i = 0; i < count; ++i) {
+        if (lv_spangroup_get_child(group, static_cast<int32_t>(i)) == span) return static_cast<int32_t>(i);
+    }
+    return -1;
+}
+
+/// Apply `change` to `span` and invalidate only the rows whose layout changed
+template <typename F>
+inline void update(lv_obj_t* group, lv_span_t* span, F&& change, bool refresh) noexcept {
+    Stats& st = stats();
+    ++st.updates;
+    // Span coordinates come from the last layout pass; make sure it is current
+    const int32_t width = lv_obj_get_content_width(group);
+    lv_spangroup_get_expand_height(group, width);
+    const uint32_t count = lv_spangroup_get_span_count(group);
+    const int32_t first = index_of(group, span, count);
+    if (first < 0) {   // not a span of this group: LVGL's own invalidation
+        ++st.to_end;
+        change();
+        if (refresh) lv_spangroup_refr_mode(group);
+        return;
+    }
+    lv_span_t* spans[LV_CPP_SPAN_WALK];
+    lv_span_coords_t before[LV_CPP_SPAN_WALK];
+    uint32_t n = 0;
+    for (uint32_t i = static_cast<uint32_t>(first); i < count && n < LV_CPP_SPAN_WALK; ++i, ++n) {
+        spans[n] = lv_spangroup_get_child(group, static_cast<int32_t>(i));
+        before[n] = lv_spangroup_get_span_coords(group, spans[n]);
+    }
+    const bool more = static_cast<uint32_t>(first) + n < count;
+
+    lv_display_t* disp = lv_obj_get_display(group);
+    const bool enabled = lv_display_is_invalidation_enabled(disp);
+    lv_display_enable_invalidation(disp, false);
+    change();
+    if (refresh) lv_spangroup_refr_mode(group);
+    lv_display_enable_invalidation(disp, enabled);
+    if (!enabled) return;
+
+    lv_spangroup_get_expand_height(group, width);
+    int32_t y1 = INT32_MAX, y2 = INT32_MIN;
+    bool converged = false;
+    for (uint32_t i = 0; i < n; ++i) {
+        const lv_span_coords_t after = lv_spangroup_get_span_coords(group, spans[i]);
+        ++st.spans;
+        // Same start and same lines: everything behind it lays out as before
+        if (i > 0 && same(after, before[i])) {
+            converged = true;
+            break;
+        }
+        add_rows(before[i], y1, y2);
+        add_rows(after, y1, y2);
+    }
+    lv_area_t content;
+    lv_obj_get_content_coords(group, &content);
+    lv_area_t a;
+    lv_obj_get_coords(group, &a);
+    if (!converged && more) {
+        ++st.to_end;
+        if (y1 == INT32_MAX) y1 = 0;
+        y2 = a.y2 - content.y1;
+    }
+    if (y1 > y2) return;   // nothing moved (e.g. a color set to the same value)
+    a.y1 = content.y1 + y1;
+    a.y2 = content.y1 + y2;
+    st.rows += static_cast<uint32_t>(lv_area_get_height(&a));
+    lv_obj_invalidate_area(group, &a);
+}
+
+#else
+
+template <typename F>
+inline void update(lv_obj_t* group, lv_span_t*, F&& change, bool refresh) noexcept {
+    ++stats().updates;
+    ++stats().to_end;
+    change();
+    if (refresh) lv_spangroup_refr_mode(group);
+}
+
+#endif
+
+} // namespace detail
+
+[[nodiscard]] inline Stats stats() noexcept { return detail::stats(); }
+
+inline void reset_stats() noexcept { detail::stats() = Stats{}; }
+
+} // namespace span_layout
+
 /**
  * @brief Spangroup widget wrapper
  *
@@ -54,8 +209,11 @@ public:
 
     // ==================== Span Text ====================
 
-    /// Set span text
+    /// Set span text (skipped if unchanged)
     static void span_text(lv_span_t* span, const char* txt) noexcept {
+#if LV_VERSION_AT_LEAST(9, 2, 0)
+        if (text_cache::unchanged(lv_span_get_text(span), txt)) return;
+#endif
         lv_span_set_text(span, txt);
     }
 
@@ -64,6 +222,45 @@ public:
         lv_span_set_text_static(span, txt);
     }
 
+    /// Set span text and redraw only the lines that changed (skipped if unchanged)
+    Spangroup& update_span_text(lv_span_t* span, const char* txt) noexcept {
+#if LV_VERSION_AT_LEAST(9, 2, 0)
+        if (text_cache::unchanged(lv_span_get_text(span), txt)) return *this;
+#endif
+        span_layout::detail::update(m_obj, span, [&] { lv_span_set_text(span, txt); }, false);
+        return *this;
+    }
+
+    /**
+     * @brief Change a span's style in `fn` and redraw only the lines that changed
+     *
+     * @code
+     * chat.update_span(stamp, [&] { lv_style_set_text_color(lv::Spangroup::span_style(stamp), grey); });
+     * @endcode
+     */
+    template <typename F>
+    Spangroup& update_span(lv_span_t* span, F&& fn) noexcept {
+        span_layout::detail::update(m_obj, span, std::forward<F>(fn), true);
+        return *this;
+    }
+
+#if LV_VERSION_AT_LEAST(9, 2, 0)
+    /// Size of a span's text wrapped at `max_width` (cached in text_cache)
+    ///
+    /// Uses the span style's font and spacing where set, else the group's.
+    [[nodiscard]] lv_point_t span_text_size(lv_span_t* span, int32_t max_width = LV_COORD_MAX) const noexcept {
+        lv_style_t* st = lv_span_get_style(span);
+        lv_style_value_t v;
+        const lv_font_t* font = lv_style_get_prop(st, LV_STYLE_TEXT_FONT, &v) == LV_STYLE_RES_FOUND
+            ? static_cast<const lv_font_t*>(v.ptr) : lv_obj_get_style_text_font(m_obj, LV_PART_MAIN);
+        const int32_t letter = lv_style_get_prop(st, LV_STYLE_TEXT_LETTER_SPACE, &v) == LV_STYLE_RES_FOUND
+            ? v.num : lv_obj_get_style_text_letter_space(m_obj, LV_PART_MAIN);
+        const int32_t line = lv_style_get_prop(st, LV_STYLE_TEXT_LINE_SPACE, &v) == LV_STYLE_RES_FOUND
+            ? v.num : lv_obj_get_style_text_line_space(m_obj, LV_PART_MAIN);
+        return text_cache::measure(font, lv_span_get_text(span), letter, line, max_width);
+    }
+#endif
+
     // ==================== Span Style ====================
 
     /// Get span style for modification
@@ -0,0 +1,371 @@
+#pragma once
+
+/**
+ * @file strip_chart.hpp
+ * @brief Scrolling strip chart that shifts its pixels instead of redrawing the plot
+ *
+ * A Chart in shift mode redraws every line segment of every series for
+ * each new sample. StripChart keeps the traces in a transparent canvas
+ * buffer: new samples move the existing pixels left by `spacing` pixels
+ * per sample (one memmove per row) and only the segments ending in the
+ * new columns are drawn, in one CanvasSession clipped to that strip. The
+ * grid lines are drawn by the container underneath the canvas, so they
+ * stay in place while the traces scroll over them.
+ *
+ * @code
+ * static lv::StripChart ecg(2);                  // 2 px per sample
+ * ecg.mount(health_page);
+ * ecg.root().size(lv::pct(100), 120);
+ * const uint32_t lead = ecg.add_series(lv_palette_main(LV_PALETTE_GREEN));
+ * ecg.range(-500, 1500).div_lines(3, 0);
+ * ...
+ * ecg.append(sample_mv);                         // LVGL thread, e.g. from lv::post()
+ * @endcode
+ *
+ * Samples are queued and drawn by a timer at most once per
+ * LV_DEF_REFR_PERIOD, so a 500 Hz feed scrolls once per frame by all the
+ * columns that arrived. The last columns that fit are kept, and the
+ * whole trace is redrawn from them after a resize, range() or when more
+ * columns arrive at once than the plot is wide. Axis labels are not part
+ * of the widget (place a Scale next to it).
+ *
+ * Heap allocation: the sample history (lv_malloc, one int32 per visible
+ * column and series) and the canvas buffer (DrawBufPool)
+ */
+
+#include <lvgl.h>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include "../core/object.hpp"
+#include "../core/component.hpp"
+#include "../draw/draw_buf.hpp"
+#include "../draw/canvas_session.hpp"
+
+#if LV_USE_CANVAS
+
+#ifndef LV_CPP_STRIP_CHART_SERIES
+/// Series per StripChart
+#define LV_CPP_STRIP_CHART_SERIES 4
+#endif
+
+namespace lv {
+
+/**
+ * @brief Grid container with a scrolling trace canvas on top
+ *
+ * Non-movable: events and the timer keep a pointer to it.
+ */
+class StripChart : public Component<StripChart> {
+public:
+    struct Stats {
+        uint32_t samples = 0;     ///< Columns appended
+        uint32_t scrolls = 0;     ///< Pixel shifts (one per drawn batch)
+        uint32_t segments = 0;    ///< Line segments drawn
+        uint32_t full = 0;        ///< Whole-trace redraws
+    };
+
+private:
+    static constexpr uint32_t N = LV_CPP_STRIP_CHART_SERIES;
+
+    struct Series {
+        lv_color_t color;
+        int32_t width;
+    };
+
+    Series m_series[N] = {};
+    uint32_t m_nseries = 0;
+    int32_t m_spacing;
+    int32_t m_min = 0;
+    int32_t m_max = 100;
+    uint8_t m_hdiv = 3;
+    uint8_t m_vdiv = 5;
+
+    int32_t* m_hist = nullptr;      ///< Column c of series s at [(c % m_cap) * N + s]
+    uint32_t m_cap = 0;
+    uint32_t m_written = 0;         ///< Columns appended
+    uint32_t m_drawn = 0;           ///< Columns on the canvas
+    bool m_full = true;
+
+    lv_obj_t* m_canvas = nullptr;
+    lv_timer_t* m_timer = nullptr;
+    DrawBuf m_buf;
+    Stats m_stats;
+
+    using Component<StripChart>::m_root;
+
+    /// Margin on the right (and top/bottom) so line caps are not cut
+    [[nodiscard]] int32_t pad() const noexcept {
+        int32_t w = 1;
+        for (uint32_t s = 0; s < m_nseries; ++s) w = LV_MAX(w, m_series[s].width);
+        return w / 2 + 1;
+    }
+
+    [[nodiscard]] int32_t value_y(int32_t v) const noexcept {
+        const int32_t p = pad();
+        const int32_t h = static_cast<int32_t>(m_buf.height()) - 1 - 2 * p;
+        if (v < m_min) v = m_min;
+        if (v > m_max) v = m_max;
+        const int64_t span = static_cast<int64_t>(m_max) - m_min;
+        const int32_t off = span > 0 ? static_cast<int32_t>((static_cast<int64_t>(v) - m_min) * h / span) : 0;
+        return p + h - off;
+    }
+
+    /// x of column `c` with the newest column at the right edge
+    [[nodiscard]] int32_t column_x(uint32_t c) const noexcept {
+        const int32_t newest = static_cast<int32_t>(m_buf.width()) - 1 - pad();
+        return newest - static_cast<int32_t>(m_written - 1 - c) * m_spacing;
+    }
+
+    [[nodiscard]] int32_t& hist(uint32_t c, uint32_t s) noexcept { return m_hist[(c % m_cap) * N + s]; }
+
+    /// Record the segments from column c - 1 to c of every series
+    void segments(CanvasSession& session, uint32_t c) noexcept {
+        const int32_t x0 = column_x(c - 1);
+        const int32_t x1 = column_x(c);
+        for (uint32_t s = 0; s < m_nseries; ++s) {
+            LineDsc line;
+            line.points(x0, value_y(hist(c - 1, s)), x1, value_y(hist(c, s)))
+                .color(m_series[s].color)
+                .width(m_series[s].width)
+                .rounded();
+            session.line(line);
+            ++m_stats.segments;
+        }
+    }
+
+    /// Oldest column still in the history and on screen
+    [[nodiscard]] uint32_t oldest_visible() const noexcept {
+        uint32_t first = m_written > m_cap ? m_written - m_cap : 0;
+        if (first == 0) first = 1;      // segments start at column 1
+        return first;
+    }
+
+    void redraw_all() noexcept {
+        m_buf.clear().flush_cache();
+        ++m_stats.full;
+        if (m_written > 1) {
+            CanvasSession session(m_canvas, nullptr);
+            for (uint32_t c = oldest_visible(); c < m_written; ++c) segments(session, c);
+        }
+        m_full = false;
+    }
+
+    /// Move every row left by `shift` pixels and clear the freed strip
+    void scroll(int32_t shift) noexcept {
+        const uint32_t w = m_buf.width();
+        const uint32_t h = m_buf.height();
+        const uint32_t stride = m_buf.stride();
+        const uint32_t bpp = 4;
+        const auto move = static_cast<size_t>(w - static_cast<uint32_t>(shift)) * bpp;
+        for (uint32_t y = 0; y < h; ++y) {
+            uint8_t* row = m_buf.data() + static_cast<size_t>(y) * stride;
+            std::memmove(row, row + static_cast<size_t>(shift) * bpp, move);
+        }
+        ++m_stats.scrolls;
+    }
+
+    /// Draw the columns appended since the last call
+    void render() noexcept {
+        if (!m_buf || !m_canvas) return;
+        const uint32_t fresh = m_written - m_drawn;
+        if (fresh == 0 && !m_full) return;
+        const int32_t w = static_cast<int32_t>(m_buf.width());
+        const int32_t h = static_cast<int32_t>(m_buf.height());
+        const int64_t shift = static_cast<int64_t>(fresh) * m_spacing;
+        if (m_full || shift >= w - pad()) {
+            redraw_all();
+        } else {
+            // Everything right of the previous newest point is redrawn from the new segments
+            const int32_t from = w - pad() - static_cast<int32_t>(shift);
+            scroll(static_cast<int32_t>(shift));
+            const lv_area_t strip{from, 0, w - 1, h - 1};
+            m_buf.clear(&strip);
+            m_buf.flush_cache();
+            CanvasSession session(m_canvas, &strip);
+            for (uint32_t c = m_drawn > 1 ? m_drawn : 1; c < m_written; ++c) segments(session, c);
+        }
+        m_drawn = m_written;
+        lv_obj_invalidate(m_canvas);
+    }
+
+    /// Allocate the canvas buffer and history for the current content size
+    void resize() noexcept {
+        const int32_t w = lv_obj_get_content_width(m_root);
+        const int32_t h = lv_obj_get_content_height(m_root);
+        if (w <= 0 || h <= 0) return;
+        if (m_buf && static_cast<int32_t>(m_buf.width()) == w && static_cast<int32_t>(m_buf.height()) == h) return;
+
+        DrawBuf buf = DrawBuf::acquire(static_cast<uint32_t>(w), static_cast<uint32_t>(h), LV_COLOR_FORMAT_ARGB8888);
+        if (!buf) {
+            LV_LOG_WARN("StripChart: no memory for a %dx%d canvas", static_cast<int>(w), static_cast<int>(h));
+            return;
+        }
+        const uint32_t cap = static_cast<uint32_t>(w / m_spacing) + 2;
+        auto* hist = static_cast<int32_t*>(lv_malloc(sizeof(int32_t) * N * cap));
+        if (!hist) {
+            LV_LOG_WARN("StripChart: no memory for %u columns", static_cast<unsigned>(cap));
+            return;
+        }
+        // Keep the newest columns that fit
+        const uint32_t keep_from = m_written > LV_MIN(cap, m_cap) ? m_written - LV_MIN(cap, m_cap) : 0;
+        for (uint32_t c = keep_from; c < m_written; ++c) {
+            std::memcpy(hist + (c % cap) * N, m_hist + (c % m_cap) * N, sizeof(int32_t) * N);
+        }
+        lv_free(m_hist);
+        m_hist = hist;
+        m_cap = cap;
+        m_buf = static_cast<DrawBuf&&>(buf);
+        lv_canvas_set_draw_buf(m_canvas, m_buf.get());
+        m_full = true;
+        render();
+    }
+
+    static void timer_cb(lv_timer_t* t) noexcept {
+        auto* self = static_cast<StripChart*>(lv_timer_get_user_data(t));
+        self->render();
+        lv_timer_pause(t);
+    }
+
+    static void size_cb(lv_event_t* e) noexcept {
+        static_cast<StripChart*>(lv_event_get_user_data(e))->resize();
+    }
+
+    /// Grid lines of the container, under the canvas
+    static void grid_cb(lv_event_t* e) noexcept {
+        auto* self = static_cast<StripChart*>(lv_event_get_user_data(e));
+        lv_layer_t* layer = lv_event_get_layer(e);
+        lv_area_t c;
+        lv_obj_get_content_coords(self->m_root, &c);
+        LineDsc line(self->m_root, LV_PART_MAIN);
+        if (line.get()->width <= 0) return;
+        const int32_t w = lv_area_get_width(&c);
+        const int32_t h = lv_area_get_height(&c);
+        for (uint32_t i = 1; i <= self->m_hdiv; ++i) {
+            const int32_t y = c.y1 + static_cast<int32_t>(i) * h / (self->m_hdiv + 1);
+            line.points(c.x1, y, c.x2, y);
+            lv_draw_line(layer, line.get());
+        }
+        for (uint32_t i = 1; i <= self->m_vdiv; ++i) {
+            const int32_t x = c.x1 + static_cast<int32_t>(i) * w / (self->m_vdiv + 1);
+            line.points(x, c.y1, x, c.y2);
+            lv_draw_line(layer, line.get());
+        }
+    }
+
+public:
+    /**
+     * @param spacing Pixels between consecutive samples
+     */
+    explicit StripChart(int32_t spacing = 2) noexcept : m_spacing(spacing > 0 ? spacing : 1) {}
+
+    // Unmount here, while on_unmount() can still run on a live object
+    ~StripChart() {
+        this->unmount();
+        lv_free(m_hist);
+    }
+
+    StripChart(StripChart&&) = delete;
+    StripChart& operator=(StripChart&&) = delete;
+
+    /// Component build(): grid container, trace canvas and the draw timer
+    ObjectView build(ObjectView parent) {
+        lv_obj_t* box = lv_obj_create(parent.get());
+        lv_obj_remove_flag(box, LV_OBJ_FLAG_SCROLLABLE);
+        lv_obj_set_style_line_width(box, 1, LV_PART_MAIN);
+        lv_obj_set_style_line_color(box, lv_palette_lighten(LV_PALETTE_GREY, 1), LV_PART_MAIN);
+        lv_obj_add_event_cb(box, &StripChart::grid_cb, LV_EVENT_DRAW_MAIN, this);
+        lv_obj_add_event_cb(box, &StripChart::size_cb, LV_EVENT_SIZE_CHANGED, this);
+
+        m_canvas = lv_canvas_create(box);
+        lv_obj_remove_flag(m_canvas, LV_OBJ_FLAG_CLICKABLE);
+
+        m_timer = lv_timer_create(&StripChart::timer_cb, LV_DEF_REFR_PERIOD, this);
+        lv_timer_pause(m_timer);
+
+        m_full = true;
+        return ObjectView(box);
+    }
+
+    void on_unmount() noexcept {
+        if (m_timer) lv_timer_delete(m_timer);
+        m_timer = nullptr;
+        m_canvas = nullptr;
+        m_buf = DrawBuf();
+    }
+
+    // ==================== Setup ====================
+
+    /**
+     * @brief Add a trace
+     * @return Its index in append() columns, or UINT32_MAX if LV_CPP_STRIP_CHART_SERIES are in use
+     */
+    uint32_t add_series(lv_color_t color, int32_t width = 2) noexcept {
+        if (m_nseries == N) {
+            LV_LOG_WARN("StripChart: series table full (raise LV_CPP_STRIP_CHART_SERIES)");
+            return UINT32_MAX;
+        }
+        m_series[m_nseries] = {color, width > 0 ? width : 1};
+        for (uint32_t c = m_written > m_cap ? m_written - m_cap : 0; c < m_written; ++c) {
+            hist(c, m_nseries) = m_min;
+        }
+        m_full = true;
+        return m_nseries++;
+    }
+
+    /// Value range mapped to the plot height (redraws the traces)
+    StripChart& range(int32_t min, int32_t max) noexcept {
+        m_min = min;
+        m_max = max;
+        m_full = true;
+        if (m_timer) lv_timer_resume(m_timer);
+        return *this;
+    }
+
+    /// Horizontal and vertical grid lines (drawn with the container's line style)
+    StripChart& div_lines(uint8_t hdiv, uint8_t vdiv) noexcept {
+        m_hdiv = hdiv;
+        m_vdiv = vdiv;
+        if (m_root) lv_obj_invalidate(m_root);
+        return *this;
+    }
+
+    // ==================== Samples ====================
+
+    /// Add one column: a value for each series in add_series() order (LVGL thread)
+    void append(std::span<const int32_t> column) noexcept {
+        ++m_written;
+        ++m_stats.samples;
+        if (!m_hist) {
+            m_drawn = m_written;
+            return;
+        }
+        for (uint32_t s = 0; s < m_nseries; ++s) hist(m_written - 1, s) = s < column.size() ? column[s] : m_min;
+        if (m_timer) lv_timer_resume(m_timer);
+    }
+
+    /// Add one sample to a single-series chart
+    void append(int32_t value) noexcept {
+        append(std::span<const int32_t>(&value, 1));
+    }
+
+    /// Drop every sample and clear the traces
+    void clear() noexcept {
+        m_written = 0;
+        m_drawn = 0;
+        m_full = true;
+        if (m_timer) lv_timer_resume(m_timer);
+    }
+
+    // ==================== State ====================
+
+    /// Columns kept for redraws (plot width / spacing + 2)
+    [[nodiscard]] uint32_t capacity() const noexcept { return m_cap; }
+
+    [[nodiscard]] const Stats& stats() const noexcept { return m_stats; }
+    void reset_stats() noexcept { m_stats = {}; }
+};
+
+} // namespace lv
+
+#endif // LV_USE_CANVAS
@@ -47,11 +47,7 @@ public:
 
     /// Set switch state
     Switch& on(bool value = true) noexcept {
-        if (value) {
-            lv_obj_add_state(m_obj, LV_STATE_CHECKED);
-        } else {
-            lv_obj_remove_state(m_obj, LV_STATE_CHECKED);
-        }
+        lv::set_states(m_obj, value ? LV_STATE_CHECKED : 0, value ? 0 : LV_STATE_CHECKED);
         return *this;
     }
 
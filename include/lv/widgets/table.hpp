@@ -3,19 +3,62 @@
 /**
  * @file table.hpp
  * @brief Zero-cost wrapper for LVGL table widget
+ *
+ * Bulk fills: lv_table_set_cell_value() reallocates the cell and
+ * re-measures its row on every call. assign() and update_rows() format
+ * each cell into a stack buffer and pass only the cells whose text
+ * changed to lv_table_set_cell_value() (a periodic refresh usually changes
+ * a few). table_bulk.hpp (opt-in) also skips the reallocation and
+ * re-measures the rows once at the end:
+ *
+ * @code
+ * table.assign(500, 3, [&](uint32_t row, uint32_t col, char* buf, uint32_t size) {
+ *     lv_snprintf(buf, size, "%d", values[row][col]);
+ * });
+ * @endcode
+ *
+ * Heap allocation: LVGL's, per changed cell
  */
 
 #include <lvgl.h>
 #include "../core/object.hpp"
 #include "../core/event.hpp"
 #include "../core/style.hpp"
+#include "../core/text_cache.hpp"
+#include "../core/format.hpp"
+
+#ifndef LV_CPP_TABLE_CELL_MAX
+/// Longest cell text assign() and update_rows() format (bytes, including the terminator)
+#define LV_CPP_TABLE_CELL_MAX 128
+#endif
 
 namespace lv {
 
+namespace detail {
+
+/// Format cells of rows [first, first + count) and set those whose text changed
+template<typename Fn>
+void table_fill(lv_obj_t* obj, uint32_t first, uint32_t count, Fn& fn) noexcept {
+    const uint32_t cols = lv_table_get_column_count(obj);
+    char buf[LV_CPP_TABLE_CELL_MAX];
+    for (uint32_t row = first; row < first + count; ++row) {
+        for (uint32_t col = 0; col < cols; ++col) {
+            buf[0] = '\0';
+            fn(row, col, buf, static_cast<uint32_t>(sizeof(buf)));
+            if (text_cache::unchanged(lv_table_get_cell_value(obj, row, col), buf)) continue;
+            lv_table_set_cell_value(obj, row, col, buf);
+        }
+    }
+}
+
+} // namespace detail
+
 /**
  * @brief Table widget wrapper
  *
- * A grid of cells for displaying tabular data.
+ * A grid of cells for displaying tabular data. Every cell string is
+ * copied into the widget; for thousands of rows use DataTable
+ * (data_table.hpp), which formats only the visible ones.
  *
  * Size: sizeof(void*) - 4 or 8 bytes
  */
@@ -60,12 +103,22 @@ public:
 
     // ==================== Cell Content ====================
 
-    /// Set cell value
+    /// Set cell value (skipped if unchanged, which would re-measure the row)
     Table& cell_value(uint32_t row, uint32_t col, const char* txt) noexcept {
+        if (row < lv_table_get_row_count(m_obj) && col < lv_table_get_column_count(m_obj) &&
+            text_cache::unchanged(lv_table_get_cell_value(m_obj, row, col), txt)) {
+            return *this;
+        }
         lv_table_set_cell_value(m_obj, row, col, txt);
         return *this;
     }
 
+    /// Set cell value with a compile-time format (skipped if unchanged)
+    template<FixedString F, typename... Args>
+    Table& cell_value(uint32_t row, uint32_t col, const Format<F>& f, const Args&... args) noexcept {
+        return cell_value(row, col, f(args...).c_str());
+    }
+
     /// Set cell value with format string
     template<typename... Args>
     Table& cell_value_fmt(uint32_t row, uint32_t col, const char* fmt, Args... args) noexcept {
@@ -73,11 +126,54 @@ public:
         return *this;
     }
 
+    /**
+     * @brief Resize to rows x cols and fill every cell from `fn`
+     *
+     * `fn(row, col, char* buf, uint32_t size)` writes the cell's text into
+     * `buf` (LV_CPP_TABLE_CELL_MAX bytes). Only cells whose text changed
+     * are set, each re-measuring its row.
+     */
+    template<typename Fn>
+    Table& assign(uint32_t rows, uint32_t cols, Fn&& fn) noexcept {
+        if (cols != lv_table_get_column_count(m_obj)) lv_table_set_column_count(m_obj, cols);
+        if (rows != lv_table_get_row_count(m_obj)) lv_table_set_row_count(m_obj, rows);
+        detail::table_fill(m_obj, 0, rows, fn);
+        return *this;
+    }
+
+    /**
+     * @brief Refill rows [first, first + count) from `fn` (see assign())
+     *
+     * Rows past row_count() are ignored.
+     */
+    template<typename Fn>
+    Table& update_rows(uint32_t first, uint32_t count, Fn&& fn) noexcept {
+        const uint32_t rows = lv_table_get_row_count(m_obj);
+        if (first >= rows) return *this;
+        if (count > rows - first) count = rows - first;
+        detail::table_fill(m_obj, first, count, fn);
+        return *this;
+    }
+
+    /// Measure every row height again and redraw (after cells were written directly, see table_bulk.hpp)
+    Table& remeasure() noexcept {
+        // Setting a column width is LVGL's public path to a full row re-measure
+        if (lv_table_get_column_count(m_obj) > 0) {
+            lv_table_set_column_width(m_obj, 0, lv_table_get_column_width(m_obj, 0));
+        }
+        return *this;
+    }
+
     /// Get cell value
     [[nodiscard]] const char* cell_value(uint32_t row, uint32_t col) const noexcept {
         return lv_table_get_cell_value(m_obj, row, col);
     }
 
+    /// Size of a cell's text wrapped at `max_width`, with the items' font (cached in text_cache)
+    [[nodiscard]] lv_point_t cell_text_size(uint32_t row, uint32_t col, int32_t max_width = LV_COORD_MAX) const noexcept {
+        return text_cache::layout(*this, lv_table_get_cell_value(m_obj, row, col), max_width, LV_PART_ITEMS).size;
+    }
+
     // ==================== Column Width ====================
 
     /// Set column width
@@ -0,0 +1,113 @@
+#pragma once
+
+/**
+ * @file table_bulk.hpp
+ * @brief Table bulk fills with one row measure per fill (opt-in)
+ *
+ * Table::assign() and update_rows() set each changed cell through
+ * lv_table_set_cell_value(), which reallocates the cell and re-measures
+ * its row, so refilling 500 rows measures rows thousands of times. The
+ * functions here write the text into the cell's existing allocation when
+ * it fits (most periodic refreshes change digits, not lengths), skip
+ * unchanged cells, and re-measure the rows once at the end:
+ *
+ * @code
+ * #include <lv/widgets/table_bulk.hpp>
+ *
+ * lv::table_bulk::assign(table, 500, 3, [&](uint32_t row, uint32_t col, char* buf, uint32_t size) {
+ *     lv_snprintf(buf, size, "%d", values[row][col]);
+ * });
+ * @endcode
+ *
+ * Not included by lv.hpp: it writes lv_table_t's cell_data and the
+ * lv_table_cell_t layout, neither of which is public. Checked against
+ * LVGL 9.4 (see LV_CPP_INTERNALS_OK).
+ *
+ * Heap allocation: a cell is reallocated only when its text grows
+ */
+
+#include <lvgl.h>
+#include "../core/version.hpp"
+
+#if !LV_CPP_INTERNALS_OK
+#error "table_bulk.hpp reads LVGL internals checked against LVGL 9.4; see LV_CPP_INTERNALS_OK"
+#endif
+
+#include <src/widgets/table/lv_table_private.h>  // lv_table_t cell_data, lv_table_cell_t
+#include <cstring>
+#include "table.hpp"
+
+namespace lv::table_bulk {
+
+namespace detail {
+
+/**
+ * @brief Put `txt` into cell `i` of `t` without re-measuring its row
+ *
+ * Keeps the allocation if the text fits in it (never shrinks) and the
+ * cell's ctrl flags either way.
+ * @return false if the text was unchanged or could not be stored
+ */
+[[nodiscard]] inline bool store(lv_table_t* t, uint32_t i, const char* txt) noexcept {
+    lv_table_cell_t* cell = t->cell_data[i];
+    const size_t len = std::strlen(txt);
+    if (cell) {
+        if (std::strcmp(cell->txt, txt) == 0) return false;
+        if (std::strlen(cell->txt) < len) {
+            auto* grown = static_cast<lv_table_cell_t*>(lv_realloc(cell, sizeof(lv_table_cell_t) + len + 1));
+            if (!grown) return false;
+            cell = grown;
+        }
+    } else {
+        cell = static_cast<lv_table_cell_t*>(lv_malloc_zeroed(sizeof(lv_table_cell_t) + len + 1));
+        if (!cell) return false;
+    }
+    std::memcpy(cell->txt, txt, len + 1);
+    t->cell_data[i] = cell;
+    return true;
+}
+
+/// Format and store cells of rows [first, first + count); true if any changed
+template<typename Fn>
+[[nodiscard]] bool fill(lv_obj_t* obj, uint32_t first, uint32_t count, Fn& fn) noexcept {
+#if LV_USE_ARABIC_PERSIAN_CHARS
+    // Cells hold shaped text: let LVGL shape it (one row measure per changed cell)
+    lv::detail::table_fill(obj, first, count, fn);
+    return false;
+#else
+    auto* t = reinterpret_cast<lv_table_t*>(obj);
+    char buf[LV_CPP_TABLE_CELL_MAX];
+    bool changed = false;
+    for (uint32_t row = first; row < first + count; ++row) {
+        for (uint32_t col = 0; col < t->col_cnt; ++col) {
+            buf[0] = '\0';
+            fn(row, col, buf, static_cast<uint32_t>(sizeof(buf)));
+            changed |= store(t, row * t->col_cnt + col, buf);
+        }
+    }
+    return changed;
+#endif
+}
+
+} // namespace detail
+
+/// Table::assign() measuring the rows once, after all cells are written (plus once per changed dimension)
+template<typename Fn>
+void assign(Table table, uint32_t rows, uint32_t cols, Fn&& fn) noexcept {
+    lv_obj_t* obj = table.get();
+    if (cols != lv_table_get_column_count(obj)) lv_table_set_column_count(obj, cols);
+    if (rows != lv_table_get_row_count(obj)) lv_table_set_row_count(obj, rows);
+    if (detail::fill(obj, 0, rows, fn)) table.remeasure();
+}
+
+/// Table::update_rows() with one row measure at the end; none if no cell changed
+template<typename Fn>
+void update_rows(Table table, uint32_t first, uint32_t count, Fn&& fn) noexcept {
+    lv_obj_t* obj = table.get();
+    const uint32_t rows = lv_table_get_row_count(obj);
+    if (first >= rows) return;
+    if (count > rows - first) count = rows - first;
+    if (detail::fill(obj, first, count, fn)) table.remeasure();
+}
+
+} // namespace lv::table_bulk
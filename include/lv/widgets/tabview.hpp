@@ -9,9 +9,26 @@
 #include "../core/object.hpp"
 #include "../core/event.hpp"
 #include "../core/style.hpp"
+#include "../core/lazy_page.hpp"
 
 namespace lv {
 
+namespace detail {
+
+inline constexpr LazyViewOps tabview_lazy_ops{
+    [](lv_obj_t* view) {
+        return lv_obj_get_child(lv_tabview_get_content(view),
+                                static_cast<int32_t>(lv_tabview_get_tab_active(view)));
+    },
+    [](lv_obj_t* view) { return lv_tabview_get_content(view); },
+    [](lv_obj_t*, lv_obj_t* a, lv_obj_t* b) {
+        const int32_t d = lv_obj_get_index(a) - lv_obj_get_index(b);
+        return d == 1 || d == -1;
+    },
+};
+
+} // namespace detail
+
 /**
  * @brief Tabview widget wrapper
  *
@@ -43,6 +60,21 @@ public:
         return ObjectView(lv_tabview_add_tab(m_obj, name));
     }
 
+    /**
+     * @brief Add a tab whose Component is mounted when the tab is first shown
+     *
+     * See lazy_page.hpp. The component must outlive the tab.
+     *
+     * @param unmount_after_ms Unmount again after this long hidden (0 = never)
+     * @return The tab content object (the component's parent)
+     */
+    template<typename Comp>
+    ObjectView add_tab_lazy(const char* name, Comp& component, uint32_t unmount_after_ms = 0) {
+        lv_obj_t* tab = lv_tabview_add_tab(m_obj, name);
+        if (tab) lazy_page(m_obj, detail::tabview_lazy_ops, tab, component, unmount_after_ms);
+        return ObjectView(tab);
+    }
+
     /// Rename a tab
     Tabview& rename_tab(uint32_t idx, const char* name) noexcept {
         lv_tabview_rename_tab(m_obj, idx, name);
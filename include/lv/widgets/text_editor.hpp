@@ -0,0 +1,510 @@
+#pragma once
+
+/**
+ * @file text_editor.hpp
+ * @brief Editor for large texts: gap-buffer storage, per-paragraph layout, recycled rows
+ *
+ * Textarea (lv_textarea) holds its text in one label, so an edit in the
+ * middle of a 50 KB file moves the tail of the string and lays out the
+ * whole label again. TextEditor keeps the text in a TextDocument and shows
+ * it like a VirtualList: one label per visible paragraph, positioned over
+ * a spacer that gives the full scroll height.
+ *
+ * @code
+ * static lv::TextDocument doc;
+ * doc.assign(config_text);
+ * static lv::TextEditor<> editor(doc);
+ * editor.mount(screen);
+ * editor.root().size(lv::pct(100), lv::pct(100));
+ * ...
+ * doc.for_each_chunk([&](std::string_view s) { file.write(s.data(), s.size()); });
+ * @endcode
+ *
+ * Layout keeps the top y of every paragraph. Without wrapping every
+ * paragraph is one font line and nothing is measured; with wrap(true) a
+ * paragraph is measured once, and an edit re-measures only the paragraphs
+ * it touched and shifts the y of the ones below. A width change measures
+ * all paragraphs again. Scrolling binds paragraphs to at most MaxRows
+ * labels.
+ *
+ * Editing: keys from the object's group (arrows, HOME/END, BACKSPACE, DEL,
+ * ENTER and text), clicks place the cursor, and insert() / erase() /
+ * cursor() for programmatic edits. Edit the document through the editor
+ * while it is mounted, or call refresh() after editing it directly.
+ * Paragraphs longer than LV_CPP_TEXT_EDITOR_LINE_MAX bytes are shown cut.
+ *
+ * Heap allocation: the paragraph y table (lv_malloc, doubling) besides the
+ * document and the MaxRows LVGL labels
+ */
+
+#include <lvgl.h>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include "../core/object.hpp"
+#include "../core/component.hpp"
+#include "../core/text_document.hpp"
+
+#if LV_USE_LABEL
+
+#ifndef LV_CPP_TEXT_EDITOR_LINE_MAX
+/// Longest paragraph shown by a TextEditor (bytes, including the terminator)
+#define LV_CPP_TEXT_EDITOR_LINE_MAX 1024
+#endif
+
+namespace lv {
+
+/**
+ * @brief Scrollable text editor over a TextDocument
+ *
+ * Non-movable: events keep a pointer to this object.
+ *
+ * @tparam MaxRows Labels in the pool (visible paragraphs plus one above and below)
+ */
+template<uint32_t MaxRows = 64>
+class TextEditor : public Component<TextEditor<MaxRows>> {
+public:
+    struct Stats {
+        uint32_t measured = 0;    ///< Paragraphs measured for wrapping
+        uint32_t bound = 0;       ///< Label texts set
+    };
+
+private:
+    static constexpr uint32_t UNBOUND = UINT32_MAX;
+
+    TextDocument& m_doc;
+    bool m_wrap = false;
+    lv_obj_t* m_spacer = nullptr;
+    lv_obj_t* m_caret = nullptr;
+    lv_obj_t* m_rows[MaxRows] = {};
+    uint32_t m_bound[MaxRows];
+    uint32_t m_created = 0;
+    int32_t* m_y = nullptr;       ///< Top of each paragraph; [line_count()] is the total height
+    uint32_t m_y_cap = 0;
+    uint32_t m_lines = 0;         ///< Paragraphs in m_y
+    int32_t m_width = -1;         ///< Content width m_y was measured for
+    uint32_t m_cursor = 0;
+    Stats m_stats;
+    char m_text[LV_CPP_TEXT_EDITOR_LINE_MAX];
+
+    using Component<TextEditor>::m_root;
+
+    // ==================== Layout ====================
+
+    [[nodiscard]] const lv_font_t* font() const noexcept { return lv_obj_get_style_text_font(m_root, LV_PART_MAIN); }
+
+    [[nodiscard]] int32_t line_height() const noexcept { return lv_font_get_line_height(font()); }
+
+    [[nodiscard]] int32_t measure(uint32_t line) noexcept {
+        if (!m_wrap) return line_height();
+        const std::string_view t = m_doc.line(line, m_text, sizeof(m_text));
+        if (t.empty()) return line_height();
+        ++m_stats.measured;
+        lv_point_t size;
+        lv_text_get_size(&size, m_text, font(), lv_obj_get_style_text_letter_space(m_root, LV_PART_MAIN),
+                         lv_obj_get_style_text_line_space(m_root, LV_PART_MAIN), m_width, LV_TEXT_FLAG_NONE);
+        return size.y;
+    }
+
+    [[nodiscard]] bool reserve_y(uint32_t n) noexcept {
+        if (n <= m_y_cap) return true;
+        uint32_t cap = m_y_cap ? m_y_cap * 2 : 256;
+        while (cap < n) cap *= 2;
+        auto* y = static_cast<int32_t*>(lv_realloc(m_y, sizeof(int32_t) * cap));
+        if (!y) return false;
+        m_y = y;
+        m_y_cap = cap;
+        return true;
+    }
+
+    void layout_all() noexcept {
+        const uint32_t n = m_doc.line_count();
+        m_width = lv_obj_get_content_width(m_root);
+        if (!reserve_y(n + 1)) return;
+        int32_t y = 0;
+        for (uint32_t i = 0; i < n; ++i) {
+            m_y[i] = y;
+            y += measure(i);
+        }
+        m_y[n] = y;
+        m_lines = n;
+        lv_obj_set_height(m_spacer, y);
+    }
+
+    /// Paragraphs [first, first + before) became [first, first + after): measure those, shift the rest
+    void layout_edit(uint32_t first, uint32_t before, uint32_t after) noexcept {
+        const uint32_t n = m_doc.line_count();
+        if (!reserve_y(n + 1) || first + before > m_lines) {
+            layout_all();
+            return;
+        }
+        std::memmove(m_y + first + after, m_y + first + before, sizeof(int32_t) * (m_lines + 1 - first - before));
+        int32_t y = m_y[first];
+        for (uint32_t i = first; i < first + after; ++i) {
+            m_y[i] = y;
+            y += measure(i);
+        }
+        const int32_t shift = y - m_y[first + after];
+        if (shift) {
+            for (uint32_t i = first + after; i <= n; ++i) m_y[i] += shift;
+        }
+        m_lines = n;
+        lv_obj_set_height(m_spacer, m_y[n]);
+    }
+
+    /// Paragraph at content y (binary search over m_y)
+    [[nodiscard]] uint32_t line_at(int32_t y) const noexcept {
+        uint32_t lo = 0, hi = m_lines;
+        while (hi - lo > 1) {
+            const uint32_t mid = (lo + hi) / 2;
+            if (m_y[mid] <= y) lo = mid;
+            else hi = mid;
+        }
+        return lo;
+    }
+
+    // ==================== Rows ====================
+
+    [[nodiscard]] lv_obj_t* make_row() noexcept {
+        lv_obj_t* row = lv_label_create(m_root);
+        lv_label_set_long_mode(row, m_wrap ? LV_LABEL_LONG_WRAP : LV_LABEL_LONG_CLIP);
+        lv_obj_set_width(row, m_wrap ? lv_pct(100) : LV_SIZE_CONTENT);
+        lv_obj_add_flag(row, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_EVENT_BUBBLE);
+        lv_obj_add_event_cb(row, &TextEditor::click_cb, LV_EVENT_CLICKED, this);
+        return row;
+    }
+
+    void unbind_all() noexcept {
+        for (uint32_t i = 0; i < MaxRows; ++i) m_bound[i] = UNBOUND;
+    }
+
+    void bind(uint32_t slot, uint32_t line) noexcept {
+        m_bound[slot] = line;
+        m_doc.line(line, m_text, sizeof(m_text));
+        lv_label_set_text(m_rows[slot], m_text);
+        lv_obj_set_y(m_rows[slot], m_y[line]);
+        lv_obj_remove_flag(m_rows[slot], LV_OBJ_FLAG_HIDDEN);
+        ++m_stats.bound;
+    }
+
+    [[nodiscard]] int32_t slot_of(uint32_t line) const noexcept {
+        for (uint32_t i = 0; i < m_created; ++i) {
+            if (m_bound[i] == line) return static_cast<int32_t>(i);
+        }
+        return -1;
+    }
+
+    /// Bind the visible paragraphs (plus one either side) to rows, reusing rows already bound
+    void update() noexcept {
+        if (!m_root || m_lines == 0) return;
+        const int32_t top = lv_obj_get_scroll_y(m_root);
+        const int32_t bottom = top + lv_obj_get_content_height(m_root);
+        uint32_t first = line_at(top);
+        first = first ? first - 1 : 0;
+        uint32_t end = line_at(bottom) + 2;
+        if (end > m_lines) end = m_lines;
+        if (end - first > MaxRows) end = first + MaxRows;
+
+        for (uint32_t i = 0; i < m_created; ++i) {
+            if (m_bound[i] == UNBOUND) continue;
+            if (m_bound[i] < first || m_bound[i] >= end) {
+                m_bound[i] = UNBOUND;
+                lv_obj_add_flag(m_rows[i], LV_OBJ_FLAG_HIDDEN);
+            } else {
+                lv_obj_set_y(m_rows[i], m_y[m_bound[i]]);
+            }
+        }
+        uint32_t free_slot = 0;
+        for (uint32_t line = first; line < end; ++line) {
+            if (slot_of(line) >= 0) continue;
+            while (free_slot < m_created && m_bound[free_slot] != UNBOUND) ++free_slot;
+            if (free_slot == m_created) {
+                if (m_created == MaxRows) break;
+                m_rows[m_created++] = make_row();
+            }
+            bind(free_slot, line);
+        }
+        place_caret();
+    }
+
+    // ==================== Cursor ====================
+
+    void place_caret() noexcept {
+        if (!m_caret) return;
+        const uint32_t line = m_doc.line_of(m_cursor);
+        const int32_t slot = slot_of(line);
+        if (slot < 0) {
+            lv_obj_add_flag(m_caret, LV_OBJ_FLAG_HIDDEN);
+            return;
+        }
+        lv_obj_t* row = m_rows[slot];
+        const char* txt = lv_label_get_text(row);
+        uint32_t byte = m_cursor - m_doc.line_start(line);
+        if (byte > sizeof(m_text) - 1) byte = sizeof(m_text) - 1;
+        lv_point_t p;
+        lv_label_get_letter_pos(row, lv_text_encoded_get_char_id(txt, byte), &p);
+        lv_obj_set_pos(m_caret, p.x, m_y[line] + p.y);
+        lv_obj_set_height(m_caret, line_height());
+        lv_obj_remove_flag(m_caret, LV_OBJ_FLAG_HIDDEN);
+    }
+
+    void scroll_to_cursor() noexcept {
+        const uint32_t line = m_doc.line_of(m_cursor);
+        const int32_t top = lv_obj_get_scroll_y(m_root);
+        const int32_t view = lv_obj_get_content_height(m_root);
+        if (m_y[line] < top) {
+            lv_obj_scroll_to_y(m_root, m_y[line], LV_ANIM_OFF);
+        } else if (m_y[line + 1] > top + view) {
+            lv_obj_scroll_to_y(m_root, m_y[line + 1] - view, LV_ANIM_OFF);
+        }
+    }
+
+    [[nodiscard]] uint32_t prev_char(uint32_t pos) const noexcept {
+        if (pos == 0) return 0;
+        --pos;
+        while (pos > 0 && (static_cast<uint8_t>(m_doc.at(pos)) & 0xC0) == 0x80) --pos;
+        return pos;
+    }
+
+    [[nodiscard]] uint32_t next_char(uint32_t pos) const noexcept {
+        if (pos >= m_doc.size()) return m_doc.size();
+        ++pos;
+        while (pos < m_doc.size() && (static_cast<uint8_t>(m_doc.at(pos)) & 0xC0) == 0x80) ++pos;
+        return pos;
+    }
+
+    /// Same byte column (clamped) in the paragraph `delta` away
+    [[nodiscard]] uint32_t vertical(int32_t delta) const noexcept {
+        const uint32_t line = m_doc.line_of(m_cursor);
+        const int64_t target = static_cast<int64_t>(line) + delta;
+        if (target < 0 || target >= m_doc.line_count()) return m_cursor;
+        const auto t = static_cast<uint32_t>(target);
+        uint32_t col = m_cursor - m_doc.line_start(line);
+        if (col > m_doc.line_length(t)) col = m_doc.line_length(t);
+        uint32_t pos = m_doc.line_start(t) + col;
+        while (pos > m_doc.line_start(t) && (static_cast<uint8_t>(m_doc.at(pos)) & 0xC0) == 0x80) --pos;
+        return pos;
+    }
+
+    /// After a document edit of paragraphs [first, first + before) -> [first, first + after)
+    void edited(uint32_t first, uint32_t before, uint32_t after) noexcept {
+        if (!m_root) return;
+        layout_edit(first, before, after);
+        if (before == after) {
+            // Same paragraph count: only the edited paragraphs need new text
+            for (uint32_t line = first; line < first + after; ++line) {
+                const int32_t slot = slot_of(line);
+                if (slot >= 0) bind(static_cast<uint32_t>(slot), line);
+            }
+        } else {
+            for (uint32_t i = 0; i < m_created; ++i) {
+                if (m_bound[i] != UNBOUND && m_bound[i] >= first) {
+                    m_bound[i] = UNBOUND;
+                    lv_obj_add_flag(m_rows[i], LV_OBJ_FLAG_HIDDEN);
+                }
+            }
+        }
+        scroll_to_cursor();
+        update();
+    }
+
+    static void scroll_cb(lv_event_t* e) noexcept {
+        static_cast<TextEditor*>(lv_event_get_user_data(e))->update();
+    }
+
+    static void size_cb(lv_event_t* e) noexcept {
+        auto* self = static_cast<TextEditor*>(lv_event_get_user_data(e));
+        if (self->m_wrap && lv_obj_get_content_width(self->m_root) != self->m_width) self->refresh();
+        else self->update();
+    }
+
+    static void key_cb(lv_event_t* e) noexcept {
+        static_cast<TextEditor*>(lv_event_get_user_data(e))->key(lv_event_get_key(e));
+    }
+
+    static void click_cb(lv_event_t* e) noexcept {
+        auto* self = static_cast<TextEditor*>(lv_event_get_user_data(e));
+        auto* row = static_cast<lv_obj_t*>(lv_event_get_current_target(e));
+        lv_indev_t* indev = lv_indev_active();
+        if (!indev) return;
+        lv_point_t p;
+        lv_indev_get_point(indev, &p);
+        lv_area_t a;
+        lv_obj_get_coords(row, &a);
+        p.x -= a.x1;
+        p.y -= a.y1;
+        for (uint32_t i = 0; i < self->m_created; ++i) {
+            if (self->m_rows[i] != row || self->m_bound[i] == UNBOUND) continue;
+            const uint32_t letter = lv_label_get_letter_on(row, &p, false);
+            const uint32_t byte = lv_text_encoded_get_byte_id(lv_label_get_text(row), letter);
+            self->cursor(self->m_doc.line_start(self->m_bound[i]) + byte);
+            return;
+        }
+    }
+
+public:
+    /// @param doc Text to show and edit (must outlive the editor)
+    explicit TextEditor(TextDocument& doc) noexcept : m_doc(doc) { unbind_all(); }
+
+    // Unmount here, while on_unmount() can still run on a live object
+    ~TextEditor() {
+        this->unmount();
+        lv_free(m_y);
+    }
+
+    TextEditor(TextEditor&&) = delete;
+    TextEditor& operator=(TextEditor&&) = delete;
+
+    /// Component build(): scrollable container, spacer, caret and input hooks
+    ObjectView build(ObjectView parent) {
+        lv_obj_t* box = lv_obj_create(parent.get());
+        lv_obj_set_layout(box, LV_LAYOUT_NONE);    // rows are positioned absolutely
+        if (lv_group_t* g = lv_group_get_default()) lv_group_add_obj(g, box);
+
+        m_spacer = lv_obj_create(box);
+        lv_obj_remove_style_all(m_spacer);
+        lv_obj_remove_flag(m_spacer, LV_OBJ_FLAG_CLICKABLE);
+        lv_obj_set_size(m_spacer, 1, 0);
+
+        m_caret = lv_obj_create(box);
+        lv_obj_remove_style_all(m_caret);
+        lv_obj_remove_flag(m_caret, LV_OBJ_FLAG_CLICKABLE);
+        lv_obj_set_style_bg_opa(m_caret, LV_OPA_COVER, LV_PART_MAIN);
+        lv_obj_set_style_bg_color(m_caret, lv_obj_get_style_text_color(box, LV_PART_MAIN), LV_PART_MAIN);
+        lv_obj_set_width(m_caret, 2);
+
+        lv_obj_add_event_cb(box, &TextEditor::scroll_cb, LV_EVENT_SCROLL, this);
+        lv_obj_add_event_cb(box, &TextEditor::size_cb, LV_EVENT_SIZE_CHANGED, this);
+        lv_obj_add_event_cb(box, &TextEditor::key_cb, LV_EVENT_KEY, this);
+
+        m_root = box;    // make_row() needs the parent before mount() stores it
+        m_created = 0;
+        unbind_all();
+        refresh();
+        return ObjectView(box);
+    }
+
+    void on_unmount() noexcept {
+        m_spacer = nullptr;
+        m_caret = nullptr;
+        m_created = 0;
+        m_lines = 0;
+    }
+
+    // ==================== Document ====================
+
+    /// Measure every paragraph and rebind the visible rows (after direct document edits or style changes)
+    void refresh() noexcept {
+        if (!m_root) return;
+        if (m_cursor > m_doc.size()) m_cursor = m_doc.size();
+        layout_all();
+        for (uint32_t i = 0; i < m_created; ++i) {
+            m_bound[i] = UNBOUND;
+            lv_obj_add_flag(m_rows[i], LV_OBJ_FLAG_HIDDEN);
+        }
+        update();
+    }
+
+    /// Wrap paragraphs at the editor width (default: one line per paragraph, scroll sideways)
+    TextEditor& wrap(bool enable) noexcept {
+        if (m_wrap == enable) return *this;
+        m_wrap = enable;
+        for (uint32_t i = 0; i < m_created; ++i) {
+            lv_label_set_long_mode(m_rows[i], enable ? LV_LABEL_LONG_WRAP : LV_LABEL_LONG_CLIP);
+            lv_obj_set_width(m_rows[i], enable ? lv_pct(100) : LV_SIZE_CONTENT);
+        }
+        refresh();
+        return *this;
+    }
+
+    /// Insert at the cursor and move the cursor behind the text
+    TextEditor& insert(std::string_view text) noexcept {
+        const uint32_t line = m_doc.line_of(m_cursor);
+        const uint32_t before = m_doc.line_count();
+        if (!m_doc.insert(m_cursor, text)) return *this;
+        m_cursor += static_cast<uint32_t>(text.size());
+        edited(line, 1, 1 + m_doc.line_count() - before);
+        return *this;
+    }
+
+    /// Remove `len` bytes at `pos`; the cursor keeps its place in the text
+    TextEditor& erase(uint32_t pos, uint32_t len) noexcept {
+        if (pos >= m_doc.size() || len == 0) return *this;
+        if (len > m_doc.size() - pos) len = m_doc.size() - pos;
+        const uint32_t first = m_doc.line_of(pos);
+        const uint32_t last = m_doc.line_of(pos + len);
+        m_doc.erase(pos, len);
+        if (m_cursor >= pos + len) m_cursor -= len;
+        else if (m_cursor > pos) m_cursor = pos;
+        edited(first, last - first + 1, 1);
+        return *this;
+    }
+
+    /// Move the cursor to byte `pos` (clamped) and scroll it into view
+    TextEditor& cursor(uint32_t pos) noexcept {
+        m_cursor = pos < m_doc.size() ? pos : m_doc.size();
+        if (!m_root) return *this;
+        scroll_to_cursor();
+        update();
+        return *this;
+    }
+
+    [[nodiscard]] uint32_t cursor() const noexcept { return m_cursor; }
+
+    /// Apply a key as the editor's group would deliver it
+    void key(uint32_t k) noexcept {
+        switch (k) {
+        case LV_KEY_LEFT: cursor(prev_char(m_cursor)); break;
+        case LV_KEY_RIGHT: cursor(next_char(m_cursor)); break;
+        case LV_KEY_UP: cursor(vertical(-1)); break;
+        case LV_KEY_DOWN: cursor(vertical(1)); break;
+        case LV_KEY_HOME: cursor(m_doc.line_start(m_doc.line_of(m_cursor))); break;
+        case LV_KEY_END: {
+            const uint32_t line = m_doc.line_of(m_cursor);
+            cursor(m_doc.line_start(line) + m_doc.line_length(line));
+            break;
+        }
+        case LV_KEY_BACKSPACE: {
+            const uint32_t from = prev_char(m_cursor);
+            erase(from, m_cursor - from);
+            break;
+        }
+        case LV_KEY_DEL: erase(m_cursor, next_char(m_cursor) - m_cursor); break;
+        case LV_KEY_ENTER: insert("\n"); break;
+        default:
+            if (k >= 0x20 && k != 0x7F) {
+                char utf8[4];
+                uint32_t n = 0;
+                if (k < 0x80) {
+                    utf8[n++] = static_cast<char>(k);
+                } else if (k < 0x800) {
+                    utf8[n++] = static_cast<char>(0xC0 | (k >> 6));
+                    utf8[n++] = static_cast<char>(0x80 | (k & 0x3F));
+                } else if (k < 0x10000) {
+                    utf8[n++] = static_cast<char>(0xE0 | (k >> 12));
+                    utf8[n++] = static_cast<char>(0x80 | ((k >> 6) & 0x3F));
+                    utf8[n++] = static_cast<char>(0x80 | (k & 0x3F));
+                } else {
+                    utf8[n++] = static_cast<char>(0xF0 | (k >> 18));
+                    utf8[n++] = static_cast<char>(0x80 | ((k >> 12) & 0x3F));
+                    utf8[n++] = static_cast<char>(0x80 | ((k >> 6) & 0x3F));
+                    utf8[n++] = static_cast<char>(0x80 | (k & 0x3F));
+                }
+                insert(std::string_view(utf8, n));
+            }
+            break;
+        }
+    }
+
+    [[nodiscard]] TextDocument& document() noexcept { return m_doc; }
+
+    /// Labels created so far
+    [[nodiscard]] uint32_t row_count() const noexcept { return m_created; }
+
+    [[nodiscard]] const Stats& stats() const noexcept { return m_stats; }
+    void reset_stats() noexcept { m_stats = Stats{}; }
+};
+
+} // namespace lv
+
+#endif // LV_USE_LABEL
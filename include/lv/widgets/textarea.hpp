@@ -16,6 +16,8 @@ namespace lv {
  * @brief Textarea widget wrapper
  *
  * A multi-line text input area.
+ * The text lives in one label, so edits cost O(text length); for
+ * documents beyond a few KB use TextEditor (text_editor.hpp).
  *
  * Size: sizeof(void*) - 4 or 8 bytes
  */
@@ -0,0 +1,536 @@
+#pragma once
+
+/**
+ * @file tile_map.hpp
+ * @brief Zoomable image pyramid drawn from 256x256 tiles loaded on demand
+ *
+ * A site map or floor plan shown as an Image in a scrolling container is
+ * decoded whole: 8192x6144 is 200 MB of ARGB8888 before the first frame.
+ * A TileMap shows the image from a pyramid of 256x256 tile files. Level 0
+ * is full resolution and each further level is half the size of the one
+ * before. Only the tiles on screen are read, each one decoded on an
+ * lv::executor() worker, and kept in a budgeted LRU tile table:
+ *
+ * @code
+ * #include <lv/widgets/tile_map.hpp>
+ *
+ * static lv::TileMap plan;
+ * plan.mount(screen);
+ * plan.root().size(480, 320);
+ * plan.source("A:/plan/%u/%u_%u.png", 8192, 6144, 6);   // level, column, row
+ * plan.zoom(64);                                         // 1/4 size: level 2 tiles
+ * ...
+ * plan.dump();            // tiles, bytes, loads, fallbacks, blanks
+ * @endcode
+ *
+ * The zoom is in LV_SCALE_NONE units. It picks the coarsest level whose
+ * tiles are not magnified, and draws those tiles scaled. A tile that is
+ * not loaded yet is drawn from the nearest coarser level in the table,
+ * magnified and clipped to the tile, so the view sharpens as tiles arrive
+ * instead of showing holes. The top level's tiles under the viewport are
+ * requested first for that reason. While scrolling, the row or column
+ * beyond the viewport in the scroll direction is requested too.
+ *
+ * At most LV_CPP_TILE_MAP_INFLIGHT tiles load at once. Tiles drawn in a
+ * refresh are pinned until it is ready; the least recently drawn others
+ * are evicted to stay within the budget, which must hold a screenful.
+ * Loads are cancelled with the root, as for any Component.
+ *
+ * Not included by lv.hpp: it narrows lv_layer_t::_clip_area to draw
+ * magnified fallback tiles, which is not public. Checked against LVGL 9.4
+ * (see LV_CPP_INTERNALS_OK).
+ *
+ * Heap allocation: none in the wrapper (fixed tile table); tile pixels
+ * come from the DrawBufPool
+ */
+
+#include <lvgl.h>
+#include "../core/version.hpp"
+
+#if !LV_CPP_INTERNALS_OK
+#error "tile_map.hpp reads LVGL internals checked against LVGL 9.4; see LV_CPP_INTERNALS_OK"
+#endif
+
+#include <src/draw/lv_draw_private.h>             // lv_layer_t::_clip_area
+#include <cstdint>
+#include <utility>
+#include "../core/object.hpp"
+#include "../core/component.hpp"
+#include "../core/executor.hpp"
+#include "../core/image_loader.hpp"
+
+#ifndef LV_CPP_TILE_MAP_TILES
+/// Tiles a TileMap keeps loaded or loading
+#define LV_CPP_TILE_MAP_TILES 64
+#endif
+
+#ifndef LV_CPP_TILE_MAP_BYTES
+/// Default pixel budget of a TileMap's tiles
+#define LV_CPP_TILE_MAP_BYTES (4 * 1024 * 1024)
+#endif
+
+#ifndef LV_CPP_TILE_MAP_INFLIGHT
+/// Tiles a TileMap loads at once
+#define LV_CPP_TILE_MAP_INFLIGHT 4
+#endif
+
+#ifndef LV_CPP_TILE_MAP_PATH
+/// Longest tile path
+#define LV_CPP_TILE_MAP_PATH 64
+#endif
+
+namespace lv {
+
+/**
+ * @brief Scrollable view of a tiled image pyramid
+ *
+ * Non-movable: events and the display hook keep a pointer to it.
+ */
+class TileMap : public Component<TileMap> {
+public:
+    static constexpr int32_t TILE = 256;       ///< Tile edge in pixels at every level
+    static constexpr uint8_t MAX_LEVELS = 16;
+
+    struct Stats {
+        uint32_t tiles = 0;        ///< Tiles loaded now
+        uint32_t bytes = 0;        ///< Their pixel bytes
+        uint32_t loads = 0;        ///< Tiles decoded
+        uint32_t failed = 0;       ///< Tiles that could not be read or decoded
+        uint32_t dropped = 0;      ///< Decoded tiles discarded (over budget, or the source changed)
+        uint32_t hits = 0;         ///< Tiles drawn at the wanted level
+        uint32_t fallbacks = 0;    ///< Tiles drawn from a coarser level
+        uint32_t blanks = 0;       ///< Tiles with nothing to draw yet
+        uint32_t prefetches = 0;   ///< Tiles requested ahead of the scroll direction
+        uint32_t evictions = 0;
+    };
+
+private:
+    enum class State : uint8_t { free, loading, ready, failed };
+
+    struct Tile {
+        lv_draw_buf_t* buf = nullptr;
+        uint32_t used = 0;         ///< Refresh it was last drawn in (LRU)
+        uint16_t x = 0;
+        uint16_t y = 0;
+        uint8_t level = 0;
+        State state = State::free;
+        bool pinned = false;       ///< Drawn in the current refresh
+    };
+
+    /// A decoded tile on its way to the UI thread; frees the pixels unless taken
+    struct Loaded {
+        lv_draw_buf_t* buf;
+        uint32_t gen;
+        uint16_t x;
+        uint16_t y;
+        uint8_t level;
+
+        Loaded(lv_draw_buf_t* b, uint32_t g, uint16_t tx, uint16_t ty, uint8_t l) noexcept
+            : buf(b), gen(g), x(tx), y(ty), level(l) {}
+        Loaded(Loaded&& o) noexcept
+            : buf(std::exchange(o.buf, nullptr)), gen(o.gen), x(o.x), y(o.y), level(o.level) {}
+        Loaded(const Loaded&) = delete;
+        Loaded& operator=(const Loaded&) = delete;
+        Loaded& operator=(Loaded&&) = delete;
+        ~Loaded() {
+            if (buf) lv_draw_buf_destroy(buf);
+        }
+    };
+
+    /// Tile columns and rows covering an area
+    struct Range {
+        int32_t x1, y1, x2, y2;
+    };
+
+    Tile m_tiles[LV_CPP_TILE_MAP_TILES];
+    lv_obj_t* m_canvas = nullptr;
+    lv_display_t* m_disp = nullptr;
+    const char* m_pattern = nullptr;
+    int32_t m_w = 0;
+    int32_t m_h = 0;
+    uint8_t m_levels = 1;
+    int32_t m_scale = LV_SCALE_NONE;
+    uint32_t m_budget = LV_CPP_TILE_MAP_BYTES;
+    uint32_t m_bytes = 0;
+    uint32_t m_clock = 0;
+    uint32_t m_gen = 0;            ///< Source generation; results of older ones are dropped
+    int32_t m_scroll_x = 0;
+    int32_t m_scroll_y = 0;
+    int8_t m_dir_x = 0;            ///< Scroll direction, -1, 0 or 1
+    int8_t m_dir_y = 0;
+    Stats m_stats;
+
+    /// Level drawn at the current zoom: the coarsest one whose tiles are not magnified
+    [[nodiscard]] uint8_t wanted_level() const noexcept {
+        uint8_t k = 0;
+        while (k + 1 < m_levels && (m_scale << (k + 1)) <= LV_SCALE_NONE) ++k;
+        return k;
+    }
+
+    /// On-screen edge of a level-`k` tile
+    [[nodiscard]] int32_t span(uint8_t k) const noexcept { return m_scale << k; }
+
+    [[nodiscard]] int32_t columns(uint8_t k) const noexcept { return (m_w + (TILE << k) - 1) / (TILE << k); }
+    [[nodiscard]] int32_t rows(uint8_t k) const noexcept { return (m_h + (TILE << k) - 1) / (TILE << k); }
+
+    /// Tiles of level `k` under `area` (which lies inside `map`)
+    [[nodiscard]] Range range(uint8_t k, const lv_area_t& map, const lv_area_t& area) const noexcept {
+        const int32_t s = span(k);
+        return Range{(area.x1 - map.x1) / s, (area.y1 - map.y1) / s,
+                     LV_MIN((area.x2 - map.x1) / s, columns(k) - 1), LV_MIN((area.y2 - map.y1) / s, rows(k) - 1)};
+    }
+
+    [[nodiscard]] Tile* find(uint8_t k, int32_t x, int32_t y) noexcept {
+        for (Tile& t : m_tiles) {
+            if (t.state != State::free && t.level == k && t.x == x && t.y == y) return &t;
+        }
+        return nullptr;
+    }
+
+    [[nodiscard]] uint32_t loading() const noexcept {
+        uint32_t n = 0;
+        for (const Tile& t : m_tiles) n += t.state == State::loading;
+        return n;
+    }
+
+    void free_tile(Tile& t) noexcept {
+        if (t.buf) {
+            lv_image_cache_drop(t.buf);
+            m_bytes -= t.buf->data_size;
+            lv_draw_buf_destroy(t.buf);
+        }
+        t = Tile{};
+    }
+
+    /// Least recently drawn tile not on screen (failed ones included)
+    [[nodiscard]] Tile* victim() noexcept {
+        Tile* v = nullptr;
+        for (Tile& t : m_tiles) {
+            if ((t.state == State::ready || t.state == State::failed) && !t.pinned &&
+                (!v || static_cast<int32_t>(t.used - v->used) < 0)) {
+                v = &t;
+            }
+        }
+        return v;
+    }
+
+    [[nodiscard]] Tile* evict() noexcept {
+        Tile* v = victim();
+        if (!v) return nullptr;
+        free_tile(*v);
+        ++m_stats.evictions;
+        return v;
+    }
+
+    [[nodiscard]] Tile* free_slot() noexcept {
+        for (Tile& t : m_tiles) {
+            if (t.state == State::free) return &t;
+        }
+        return evict();
+    }
+
+    void free_all() noexcept {
+        for (Tile& t : m_tiles) free_tile(t);
+        m_bytes = 0;
+        ++m_gen;
+    }
+
+    /// Start loading tile (k, x, y) unless it is in the table; false if nothing was started
+    bool request(uint8_t k, int32_t x, int32_t y) noexcept {
+        if (x < 0 || y < 0 || x >= columns(k) || y >= rows(k) || find(k, x, y)) return false;
+        if (loading() >= LV_CPP_TILE_MAP_INFLIGHT) return false;
+        Tile* t = free_slot();
+        if (!t) return false;
+        const auto tx = static_cast<uint16_t>(x);
+        const auto ty = static_cast<uint16_t>(y);
+        *t = Tile{nullptr, m_clock, tx, ty, k, State::loading, false};
+        const uint32_t id = executor().submit([pattern = m_pattern, gen = m_gen, tx, ty, k] {
+            char path[LV_CPP_TILE_MAP_PATH];
+            lv_snprintf(path, sizeof(path), pattern, static_cast<unsigned>(k), static_cast<unsigned>(tx),
+                        static_cast<unsigned>(ty));
+            return Loaded(image_loader::detail::decode(path), gen, tx, ty, k);
+        }).then_on_ui<&TileMap::on_tile>(this);
+        if (!id) *t = Tile{};      // job table full: try again on a later refresh
+        return id != 0;
+    }
+
+    void on_tile(Loaded& r) noexcept {
+        Tile* t = r.gen == m_gen ? find(r.level, r.x, r.y) : nullptr;
+        if (!t || t->state != State::loading) {
+            if (r.buf) ++m_stats.dropped;
+            return;
+        }
+        if (!r.buf) {
+            t->state = State::failed;
+            ++m_stats.failed;
+            LV_LOG_WARN("tile map: no tile %u/%u_%u", static_cast<unsigned>(r.level), static_cast<unsigned>(r.x),
+                        static_cast<unsigned>(r.y));
+            return;
+        }
+        const uint32_t size = r.buf->data_size;
+        while (m_bytes + size > m_budget && evict()) {}
+        if (m_bytes + size > m_budget) {
+            *t = Tile{};
+            ++m_stats.dropped;
+            return;
+        }
+        t->buf = std::exchange(r.buf, nullptr);
+        t->state = State::ready;
+        m_bytes += size;
+        ++m_stats.loads;
+        invalidate(*t);
+    }
+
+    /// Screen area of tile `t` at the current zoom
+    [[nodiscard]] lv_area_t area_of(const lv_area_t& map, uint8_t k, int32_t x, int32_t y) const noexcept {
+        const int32_t s = span(k);
+        lv_area_t a;
+        a.x1 = map.x1 + x * s;
+        a.y1 = map.y1 + y * s;
+        a.x2 = a.x1 + s - 1;
+        a.y2 = a.y1 + s - 1;
+        return a;
+    }
+
+    void invalidate(const Tile& t) noexcept {
+        if (!m_canvas) return;
+        lv_area_t map;
+        lv_obj_get_coords(m_canvas, &map);
+        const lv_area_t a = area_of(map, t.level, t.x, t.y);
+        lv_obj_invalidate_area(m_canvas, &a);
+    }
+
+    void resize() noexcept {
+        if (!m_canvas) return;
+        lv_obj_set_size(m_canvas, static_cast<int32_t>(static_cast<int64_t>(m_w) * m_scale / LV_SCALE_NONE),
+                        static_cast<int32_t>(static_cast<int64_t>(m_h) * m_scale / LV_SCALE_NONE));
+    }
+
+    /// The top level and level `k` under the viewport, then the tiles the scroll is heading to
+    void request_view(uint8_t k, const lv_area_t& map) noexcept {
+        lv_area_t view;
+        lv_obj_get_coords(m_root, &view);
+        if (!lv_area_intersect(&view, &view, &map)) return;
+        const Range top = range(m_levels - 1, map, view);
+        for (int32_t y = top.y1; y <= top.y2; ++y) {
+            for (int32_t x = top.x1; x <= top.x2; ++x) request(m_levels - 1, x, y);
+        }
+        const Range r = range(k, map, view);
+        for (int32_t y = r.y1; y <= r.y2; ++y) {
+            for (int32_t x = r.x1; x <= r.x2; ++x) request(k, x, y);
+        }
+        if (m_dir_x) {
+            const int32_t x = m_dir_x > 0 ? r.x2 + 1 : r.x1 - 1;
+            for (int32_t y = r.y1; y <= r.y2; ++y) m_stats.prefetches += request(k, x, y);
+        }
+        if (m_dir_y) {
+            const int32_t y = m_dir_y > 0 ? r.y2 + 1 : r.y1 - 1;
+            for (int32_t x = r.x1; x <= r.x2; ++x) m_stats.prefetches += request(k, x, y);
+        }
+    }
+
+    /// Draw `t` at its level's scale, clipped to `clip` if given
+    void blit(lv_layer_t* layer, const lv_area_t& map, Tile& t, const lv_area_t* clip) noexcept {
+        const lv_area_t saved = layer->_clip_area;
+        lv_area_t narrowed;
+        if (clip && !lv_area_intersect(&narrowed, &saved, clip)) return;
+        lv_area_t coords = area_of(map, t.level, t.x, t.y);
+        coords.x2 = coords.x1 + static_cast<int32_t>(t.buf->header.w) - 1;   // untransformed; scaled around the top-left
+        coords.y2 = coords.y1 + static_cast<int32_t>(t.buf->header.h) - 1;
+        lv_draw_image_dsc_t dsc;
+        lv_draw_image_dsc_init(&dsc);
+        dsc.src = t.buf;
+        dsc.scale_x = span(t.level);
+        dsc.scale_y = dsc.scale_x;
+        dsc.pivot = lv_point_t{0, 0};
+        dsc.antialias = dsc.scale_x != LV_SCALE_NONE;
+        if (clip) layer->_clip_area = narrowed;
+        lv_draw_image(layer, &dsc, &coords);
+        layer->_clip_area = saved;
+        t.pinned = true;
+        t.used = m_clock;
+    }
+
+    /// Tile (k, x, y), or the nearest coarser loaded tile over it
+    void draw_tile(lv_layer_t* layer, const lv_area_t& map, uint8_t k, int32_t x, int32_t y) noexcept {
+        for (uint8_t j = 0; k + j < m_levels; ++j) {
+            Tile* t = find(static_cast<uint8_t>(k + j), x >> j, y >> j);
+            if (!t || t->state != State::ready) continue;
+            if (j == 0) {
+                ++m_stats.hits;
+                blit(layer, map, *t, nullptr);
+            } else {
+                ++m_stats.fallbacks;
+                const lv_area_t clip = area_of(map, k, x, y);
+                blit(layer, map, *t, &clip);
+            }
+            return;
+        }
+        ++m_stats.blanks;
+    }
+
+    void draw(lv_layer_t* layer) noexcept {
+        if (!m_pattern || m_w <= 0 || m_h <= 0) return;
+        ++m_clock;
+        lv_area_t map;
+        lv_obj_get_coords(m_canvas, &map);
+        const uint8_t k = wanted_level();
+        request_view(k, map);
+        lv_area_t clip;
+        if (!lv_area_intersect(&clip, &layer->_clip_area, &map)) return;
+        const Range r = range(k, map, clip);
+        for (int32_t y = r.y1; y <= r.y2; ++y) {
+            for (int32_t x = r.x1; x <= r.x2; ++x) draw_tile(layer, map, k, x, y);
+        }
+    }
+
+    static void draw_cb(lv_event_t* e) noexcept {
+        static_cast<TileMap*>(lv_event_get_user_data(e))->draw(lv_event_get_layer(e));
+    }
+
+    static void scroll_cb(lv_event_t* e) noexcept {
+        auto* self = static_cast<TileMap*>(lv_event_get_user_data(e));
+        if (lv_event_get_code(e) == LV_EVENT_SCROLL_END) {
+            self->m_dir_x = 0;
+            self->m_dir_y = 0;
+            return;
+        }
+        const int32_t sx = lv_obj_get_scroll_x(self->m_root);
+        const int32_t sy = lv_obj_get_scroll_y(self->m_root);
+        if (sx != self->m_scroll_x) self->m_dir_x = sx > self->m_scroll_x ? 1 : -1;
+        if (sy != self->m_scroll_y) self->m_dir_y = sy > self->m_scroll_y ? 1 : -1;
+        self->m_scroll_x = sx;
+        self->m_scroll_y = sy;
+    }
+
+    // The refresh is drawn: its tiles may be evicted again
+    static void refr_ready_cb(lv_event_t* e) noexcept {
+        auto* self = static_cast<TileMap*>(lv_event_get_user_data(e));
+        for (Tile& t : self->m_tiles) t.pinned = false;
+    }
+
+public:
+    TileMap() = default;
+
+    // Unmount here, while on_unmount() can still run on a live object
+    ~TileMap() {
+        this->unmount();
+        free_all();
+    }
+
+    TileMap(TileMap&&) = delete;
+    TileMap& operator=(TileMap&&) = delete;
+
+    /// Component build(): a scrolling viewport over a map-sized drawing surface
+    ObjectView build(ObjectView parent) {
+        lv_obj_t* box = lv_obj_create(parent.get());
+        lv_obj_set_style_pad_all(box, 0, 0);
+        lv_obj_add_event_cb(box, &TileMap::scroll_cb, LV_EVENT_SCROLL, this);
+        lv_obj_add_event_cb(box, &TileMap::scroll_cb, LV_EVENT_SCROLL_END, this);
+        m_canvas = lv_obj_create(box);
+        lv_obj_remove_style_all(m_canvas);
+        lv_obj_remove_flag(m_canvas, LV_OBJ_FLAG_SCROLLABLE);
+        lv_obj_remove_flag(m_canvas, LV_OBJ_FLAG_CLICKABLE);   // drags scroll the viewport
+        lv_obj_add_event_cb(m_canvas, &TileMap::draw_cb, LV_EVENT_DRAW_MAIN, this);
+        m_disp = lv_obj_get_display(box);
+        if (m_disp) lv_display_add_event_cb(m_disp, &TileMap::refr_ready_cb, LV_EVENT_REFR_READY, this);
+        resize();
+        return ObjectView(box);
+    }
+
+    void on_unmount() noexcept {
+        if (m_disp) lv_display_remove_event_cb_with_user_data(m_disp, &TileMap::refr_ready_cb, this);
+        m_disp = nullptr;
+        m_canvas = nullptr;
+        free_all();
+    }
+
+    /**
+     * @brief Show the pyramid whose tiles are at `pattern`
+     *
+     * @param pattern Tile path with three `%u`: level, column and row
+     *                ("A:/plan/%u/%u_%u.png"); must outlive the map
+     * @param w, h    Image size at level 0
+     * @param levels  Levels in the pyramid; level k is downscaled by 2^k
+     */
+    void source(const char* pattern, int32_t w, int32_t h, uint8_t levels) noexcept {
+        free_all();
+        m_pattern = pattern;
+        m_w = w;
+        m_h = h;
+        m_levels = static_cast<uint8_t>(LV_CLAMP(1, levels, MAX_LEVELS));
+        resize();
+        if (m_canvas) lv_obj_invalidate(m_canvas);
+    }
+
+    /**
+     * @brief Zoom to `scale` (LV_SCALE_NONE: 1:1) around the viewport's center
+     */
+    void zoom(int32_t scale) noexcept {
+        scale = LV_CLAMP(1, scale, 16 * LV_SCALE_NONE);
+        if (scale == m_scale) return;
+        if (!m_root) {
+            m_scale = scale;
+            return;
+        }
+        const int32_t vw = lv_obj_get_content_width(m_root);
+        const int32_t vh = lv_obj_get_content_height(m_root);
+        const int64_t cx = (static_cast<int64_t>(lv_obj_get_scroll_x(m_root)) + vw / 2) * scale / m_scale;
+        const int64_t cy = (static_cast<int64_t>(lv_obj_get_scroll_y(m_root)) + vh / 2) * scale / m_scale;
+        m_scale = scale;
+        resize();
+        lv_obj_update_layout(m_root);
+        lv_obj_scroll_to(m_root, static_cast<int32_t>(cx - vw / 2), static_cast<int32_t>(cy - vh / 2), LV_ANIM_OFF);
+        m_scroll_x = lv_obj_get_scroll_x(m_root);
+        m_scroll_y = lv_obj_get_scroll_y(m_root);
+        m_dir_x = 0;
+        m_dir_y = 0;
+        lv_obj_invalidate(m_canvas);
+    }
+
+    [[nodiscard]] int32_t zoom() const noexcept { return m_scale; }
+
+    /// Pyramid level drawn at the current zoom
+    [[nodiscard]] uint8_t level() const noexcept { return wanted_level(); }
+
+    // ==================== Cache ====================
+
+    /// Pixel bytes kept in tiles; lowering it evicts now
+    void budget(uint32_t bytes) noexcept {
+        m_budget = bytes;
+        while (m_bytes > m_budget && evict()) {}
+    }
+
+    [[nodiscard]] uint32_t budget() const noexcept { return m_budget; }
+
+    /// Free every loaded tile not on screen (failed tiles are retried)
+    void drop() noexcept {
+        for (Tile& t : m_tiles) {
+            if ((t.state == State::ready || t.state == State::failed) && !t.pinned) free_tile(t);
+        }
+    }
+
+    [[nodiscard]] Stats stats() const noexcept {
+        Stats s = m_stats;
+        for (const Tile& t : m_tiles) s.tiles += t.state == State::ready;
+        s.bytes = m_bytes;
+        return s;
+    }
+
+    void reset_stats() noexcept { m_stats = Stats{}; }
+
+    /// LV_LOG_USER the tile table and load counters
+    void dump() const noexcept {
+        const Stats s = stats();
+        LV_LOG_USER("tile map: level %u at zoom %d, %u tiles (%u of %u bytes), %u loading",
+                    static_cast<unsigned>(level()), static_cast<int>(m_scale), static_cast<unsigned>(s.tiles),
+                    static_cast<unsigned>(s.bytes), static_cast<unsigned>(m_budget), static_cast<unsigned>(loading()));
+        LV_LOG_USER("  %u loads, %u failed, %u dropped, %u prefetched, %u evicted",
+                    static_cast<unsigned>(s.loads), static_cast<unsigned>(s.failed), static_cast<unsigned>(s.dropped),
+                    static_cast<unsigned>(s.prefetches), static_cast<unsigned>(s.evictions));
+        LV_LOG_USER("  drawn: %u hits, %u from a coarser level, %u blank",
+                    static_cast<unsigned>(s.hits), static_cast<unsigned>(s.fallbacks), static_cast<unsigned>(s.blanks));
+    }
+};
+
+} // namespace lv
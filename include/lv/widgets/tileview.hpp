@@ -9,9 +9,26 @@
 #include "../core/object.hpp"
 #include "../core/event.hpp"
 #include "../core/style.hpp"
+#include "../core/lazy_page.hpp"
 
 namespace lv {
 
+namespace detail {
+
+inline constexpr LazyViewOps tileview_lazy_ops{
+    [](lv_obj_t* view) { return lv_tileview_get_tile_active(view); },
+    [](lv_obj_t* view) { return view; },
+    [](lv_obj_t*, lv_obj_t* a, lv_obj_t* b) {
+        const int32_t dx = lv_obj_get_x(a) - lv_obj_get_x(b);
+        const int32_t dy = lv_obj_get_y(a) - lv_obj_get_y(b);
+        const int32_t w = lv_obj_get_width(a);
+        const int32_t h = lv_obj_get_height(a);
+        return (dy == 0 && (dx == w || dx == -w)) || (dx == 0 && (dy == h || dy == -h));
+    },
+};
+
+} // namespace detail
+
 /**
  * @brief Tileview widget wrapper
  *
@@ -43,6 +60,22 @@ public:
         return ObjectView(lv_tileview_add_tile(m_obj, col, row, dir));
     }
 
+    /**
+     * @brief Add a tile whose Component is mounted when the tile is first shown
+     *
+     * See lazy_page.hpp. The component must outlive the tile.
+     *
+     * @param unmount_after_ms Unmount again after this long hidden (0 = never)
+     * @return The tile content object (the component's parent)
+     */
+    template<typename Comp>
+    ObjectView add_tile_lazy(uint8_t col, uint8_t row, lv_dir_t dir, Comp& component,
+                             uint32_t unmount_after_ms = 0) {
+        lv_obj_t* tile = lv_tileview_add_tile(m_obj, col, row, dir);
+        if (tile) lazy_page(m_obj, detail::tileview_lazy_ops, tile, component, unmount_after_ms);
+        return ObjectView(tile);
+    }
+
     /// Get active tile
     [[nodiscard]] ObjectView active_tile() const noexcept {
         return ObjectView(lv_tileview_get_tile_active(m_obj));
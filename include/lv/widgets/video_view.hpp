@@ -0,0 +1,502 @@
+#pragma once
+
+/**
+ * @file video_view.hpp
+ * @brief Video frames presented on display refresh from a bounded queue
+ *
+ * Putting each decoded frame into an Image with lv_image_set_src() and
+ * invalidating it drops and re-adds the frame in LVGL's image cache on
+ * every frame, which evicts the UI's real images. A VideoView owns a small
+ * set of pooled DrawBufs. The decoder fills them and queues them with a
+ * presentation timestamp, and the view shows the due frame at the start of
+ * each display refresh:
+ *
+ * @code
+ * #include <lv/widgets/video_view.hpp>
+ *
+ * static lv::VideoView video;
+ * video.mount(screen);
+ * video.root().size(640, 360);
+ * video.format(640, 360, LV_COLOR_FORMAT_RGB565);
+ * video.play();
+ *
+ * // Decoder thread:
+ * if (lv_draw_buf_t* buf = video.acquire()) {
+ *     decode_into(buf->data, buf->header.stride);
+ *     video.submit(buf, pts_us);
+ * }   // nullptr: every frame is queued or on screen, decode later
+ * @endcode
+ *
+ * Timing: the first frame after play() or flush() sets the clock. At
+ * LV_EVENT_REFR_START, the view shows the newest queued frame that is due
+ * by the middle of the coming refresh period. Older due frames are dropped
+ * unseen. Frames ahead of the clock stay queued, so a decoder running ahead
+ * is paced by acquire() returning nullptr. sync() rebases the clock on an
+ * external master, such as the audio position.
+ *
+ * Frames are drawn with lv_draw_layer(), as LVGL composites its own
+ * layers, so they never go through lv_image_set_src() or the image cache.
+ * They are scaled to fit the content area and keep their aspect ratio. With
+ * LV_CPP_USE_EGL_IMPORT, submit(DmaBufFrame, pts) queues DMA-BUF frames
+ * on the same clock and shows them through a TextureStream.
+ *
+ * acquire(), submit(), discard() and sync() are safe from any thread
+ * (under an lv_mutex when LVGL runs with an OS); the rest must run on the
+ * LVGL thread. The view must outlive its producer.
+ *
+ * Not included by lv.hpp: each frame is drawn as a layer built over its
+ * buffer, which sets lv_layer_t's buffer and clip areas directly. Checked
+ * against LVGL 9.4 (see LV_CPP_INTERNALS_OK).
+ *
+ * Heap allocation: none in the wrapper (fixed frame table); pixel memory
+ * of the LV_CPP_VIDEO_VIEW_FRAMES buffers comes from the DrawBufPool
+ */
+
+#include <lvgl.h>
+#include "../core/version.hpp"
+
+#if !LV_CPP_INTERNALS_OK
+#error "video_view.hpp reads LVGL internals checked against LVGL 9.4; see LV_CPP_INTERNALS_OK"
+#endif
+
+#include <src/draw/lv_draw_private.h>             // lv_layer_t fields
+#include <cstdint>
+#include "../core/object.hpp"
+#include "../core/component.hpp"
+#include "../draw/draw_buf.hpp"
+#include "../draw/draw_3d.hpp"
+#include "../draw/texture_stream.hpp"
+
+#ifndef LV_CPP_VIDEO_VIEW_FRAMES
+/// Frames per VideoView: the one on screen plus those queued or being decoded
+#define LV_CPP_VIDEO_VIEW_FRAMES 4
+#endif
+
+namespace lv {
+
+/**
+ * @brief Video surface fed by a bounded, timestamped frame queue
+ *
+ * Non-movable: events, the display hook and producers keep a pointer to it.
+ */
+class VideoView : public Component<VideoView> {
+    static_assert(LV_CPP_VIDEO_VIEW_FRAMES >= 2, "VideoView needs one frame on screen and one to decode");
+
+public:
+    struct Stats {
+        uint32_t presented = 0;   ///< Frames shown
+        uint32_t dropped = 0;     ///< Due frames replaced by a newer one before being shown
+        uint32_t refused = 0;     ///< acquire() with no free frame (decoder ahead)
+        uint32_t starved = 0;     ///< Refreshes while playing with nothing queued
+    };
+
+private:
+    enum class State : uint8_t { free, decoding, queued, shown };
+
+    struct Frame {
+        lv_draw_buf_t* buf = nullptr;
+        lv_layer_t layer{};       ///< Source of the layer draw task
+        int64_t pts = 0;
+        uint32_t seq = 0;         ///< Queue order
+        State state = State::free;
+#if LV_USE_3DTEXTURE && LV_CPP_USE_EGL_IMPORT
+        DmaBufFrame dma{};
+        bool is_dma = false;
+#endif
+    };
+
+    Frame m_frames[LV_CPP_VIDEO_VIEW_FRAMES];
+    Frame* m_shown = nullptr;
+    uint32_t m_seq = 0;
+    int32_t m_w = 0;
+    int32_t m_h = 0;
+    lv_display_t* m_disp = nullptr;
+
+    // Clock: media time = m_base_pts + elapsed ticks since m_base_tick
+    int64_t m_base_pts = 0;
+    uint32_t m_base_tick = 0;
+    bool m_clock_set = false;
+    bool m_playing = false;
+    Stats m_stats;
+#if LV_USE_OS != LV_OS_NONE
+    lv_mutex_t m_lock;
+#endif
+
+#if LV_USE_3DTEXTURE && LV_CPP_USE_EGL_IMPORT
+    TextureStream m_stream;
+    void (*m_release)(void* token, void* user) = nullptr;
+    void* m_release_user = nullptr;
+    bool m_gpu = false;           ///< The last frame shown came through m_stream
+#endif
+
+    void lock() noexcept {
+#if LV_USE_OS != LV_OS_NONE
+        lv_mutex_lock(&m_lock);
+#endif
+    }
+
+    void unlock() noexcept {
+#if LV_USE_OS != LV_OS_NONE
+        lv_mutex_unlock(&m_lock);
+#endif
+    }
+
+    /// Return a frame to the free list (caller holds the lock)
+    void recycle(Frame& f) noexcept {
+#if LV_USE_3DTEXTURE && LV_CPP_USE_EGL_IMPORT
+        if (f.is_dma) {
+            if (m_release && f.dma.token) m_release(f.dma.token, m_release_user);
+            if (f.dma.acquire_fence >= 0) close(f.dma.acquire_fence);
+            f.dma = DmaBufFrame{};
+            f.is_dma = false;
+        }
+#endif
+        f.state = State::free;
+    }
+
+    [[nodiscard]] Frame* find(const lv_draw_buf_t* buf) noexcept {
+        for (Frame& f : m_frames) {
+            if (buf && f.buf == buf) return &f;
+        }
+        return nullptr;
+    }
+
+    [[nodiscard]] int64_t media_time(uint32_t tick) const noexcept {
+        return m_base_pts + static_cast<int64_t>(lv_tick_diff(tick, m_base_tick)) * 1000;
+    }
+
+    void enqueue(Frame& f, int64_t pts_us) noexcept {
+        f.pts = pts_us;
+        f.seq = m_seq++;
+        f.state = State::queued;
+    }
+
+    /// Pick the frame due at this refresh; older due frames are dropped
+    void present() noexcept {
+        if (!m_root || !m_playing) return;
+        const uint32_t now = lv_tick_get();
+        Frame* next = nullptr;
+        lock();
+        bool any = false;
+        for (;;) {
+            Frame* oldest = nullptr;
+            for (Frame& f : m_frames) {
+                if (f.state == State::queued && (!oldest || static_cast<int32_t>(f.seq - oldest->seq) < 0)) {
+                    oldest = &f;
+                }
+            }
+            if (!oldest) break;
+            any = true;
+            if (!m_clock_set) {
+                m_base_pts = oldest->pts;
+                m_base_tick = now;
+                m_clock_set = true;
+            }
+            const int64_t due_by = media_time(now) + LV_DEF_REFR_PERIOD * 500;
+            if (oldest->pts > due_by) break;
+            if (next) {
+                recycle(*next);
+                ++m_stats.dropped;
+            }
+            next = oldest;
+            next->state = State::shown;   // out of the queue while the loop looks for a newer one
+        }
+        if (!any) ++m_stats.starved;
+        if (!next) {
+            unlock();
+            return;
+        }
+#if LV_USE_3DTEXTURE && LV_CPP_USE_EGL_IMPORT
+        if (next->is_dma) {
+            // The stream owns the buffer from here and releases it through the same callback
+            if (m_stream.push(next->dma)) {
+                next->dma = DmaBufFrame{};
+                next->is_dma = false;
+                if (m_shown) recycle(*m_shown);
+                m_shown = nullptr;
+                m_gpu = true;
+                ++m_stats.presented;
+            } else {
+                ++m_stats.dropped;   // stream has every slot in flight
+            }
+            recycle(*next);
+            unlock();
+            lv_obj_invalidate(m_root);
+            return;
+        }
+        m_gpu = false;
+#endif
+        if (m_shown) recycle(*m_shown);   // the last refresh finished drawing it
+        m_shown = next;
+        ++m_stats.presented;
+        unlock();
+        lv_obj_invalidate(m_root);
+    }
+
+    static void refr_start_cb(lv_event_t* e) noexcept {
+        static_cast<VideoView*>(lv_event_get_user_data(e))->present();
+    }
+
+    /// Frame size scaled to fit `area` (aspect kept), centered
+    void fit(const lv_area_t& area, lv_area_t& coords, int32_t& scale) const noexcept {
+        const int32_t aw = lv_area_get_width(&area);
+        const int32_t ah = lv_area_get_height(&area);
+        scale = LV_SCALE_NONE;
+        if (m_w != aw || m_h != ah) {
+            const int32_t sx = aw * LV_SCALE_NONE / m_w;
+            const int32_t sy = ah * LV_SCALE_NONE / m_h;
+            scale = sx < sy ? sx : sy;
+        }
+        const int32_t dw = m_w * scale / LV_SCALE_NONE;
+        const int32_t dh = m_h * scale / LV_SCALE_NONE;
+        coords.x1 = area.x1 + (aw - dw) / 2;
+        coords.y1 = area.y1 + (ah - dh) / 2;
+        coords.x2 = coords.x1 + m_w - 1;    // untransformed; scaled around the top-left
+        coords.y2 = coords.y1 + m_h - 1;
+    }
+
+    static void draw_cb(lv_event_t* e) noexcept {
+        auto* self = static_cast<VideoView*>(lv_event_get_user_data(e));
+        lv_layer_t* layer = lv_event_get_layer(e);
+        lv_area_t area;
+        lv_obj_get_content_coords(self->m_root, &area);
+#if LV_USE_3DTEXTURE && LV_CPP_USE_EGL_IMPORT
+        if (self->m_gpu) {
+            lv_draw_3d_dsc_t dsc;
+            lv_draw_3d_dsc_init(&dsc);
+            dsc.tex_id = self->m_stream.texture();
+            lv_draw_3d(layer, &dsc, &area);
+            return;
+        }
+#endif
+        Frame* f = self->m_shown;
+        if (!f || !f->buf || self->m_w <= 0 || self->m_h <= 0) return;
+        lv_area_t coords;
+        int32_t scale;
+        self->fit(area, coords, scale);
+        lv_draw_image_dsc_t dsc;
+        lv_draw_image_dsc_init(&dsc);
+        dsc.src = &f->layer;
+        dsc.scale_x = scale;
+        dsc.scale_y = scale;
+        dsc.pivot = lv_point_t{0, 0};
+        dsc.antialias = scale != LV_SCALE_NONE;
+        lv_draw_layer(layer, &dsc, &coords);
+    }
+
+    void release_buffers() noexcept {
+        lock();
+        for (Frame& f : m_frames) {
+            if (f.state != State::free) recycle(f);
+            if (f.buf) {
+                lv_image_cache_drop(f.buf);
+                lv_draw_buf_destroy(f.buf);
+            }
+            f = Frame{};
+        }
+        m_shown = nullptr;
+        unlock();
+    }
+
+public:
+    VideoView() noexcept {
+#if LV_USE_OS != LV_OS_NONE
+        lv_mutex_init(&m_lock);
+#endif
+    }
+
+    // Unmount here, while on_unmount() can still run on a live object
+    ~VideoView() {
+        this->unmount();
+        release_buffers();
+#if LV_USE_OS != LV_OS_NONE
+        lv_mutex_delete(&m_lock);
+#endif
+    }
+
+    VideoView(VideoView&&) = delete;
+    VideoView& operator=(VideoView&&) = delete;
+
+    /// Component build(): a black, non-scrolling surface hooked to its display's refresh
+    ObjectView build(ObjectView parent) {
+        lv_obj_t* obj = lv_obj_create(parent.get());
+        lv_obj_remove_style_all(obj);
+        lv_obj_set_style_bg_color(obj, lv_color_black(), 0);
+        lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+        lv_obj_remove_flag(obj, LV_OBJ_FLAG_SCROLLABLE);
+        lv_obj_remove_flag(obj, LV_OBJ_FLAG_CLICKABLE);
+        lv_obj_add_event_cb(obj, &VideoView::draw_cb, LV_EVENT_DRAW_MAIN, this);
+        m_disp = lv_obj_get_display(obj);
+        if (m_disp) lv_display_add_event_cb(m_disp, &VideoView::refr_start_cb, LV_EVENT_REFR_START, this);
+        return ObjectView(obj);
+    }
+
+    void on_unmount() noexcept {
+        if (m_disp) lv_display_remove_event_cb_with_user_data(m_disp, &VideoView::refr_start_cb, this);
+        m_disp = nullptr;
+    }
+
+    /**
+     * @brief Allocate the frame buffers (LVGL thread, producer idle)
+     *
+     * Frames queued or on screen are dropped.
+     * @return false if the pool could not supply every buffer
+     */
+    bool format(int32_t w, int32_t h, lv_color_format_t cf = LV_COLOR_FORMAT_NATIVE) noexcept {
+        release_buffers();
+        m_w = w;
+        m_h = h;
+        m_clock_set = false;
+        for (Frame& f : m_frames) {
+            f.buf = lv_draw_buf_create_ex(draw::pool_handlers(), static_cast<uint32_t>(w),
+                                          static_cast<uint32_t>(h), cf, LV_STRIDE_AUTO);
+            if (!f.buf) {
+                release_buffers();
+                return false;
+            }
+            lv_layer_init(&f.layer);
+            f.layer.draw_buf = f.buf;
+            f.layer.color_format = cf;
+            f.layer.buf_area = lv_area_t{0, 0, w - 1, h - 1};
+            f.layer._clip_area = f.layer.buf_area;
+            f.layer.phy_clip_area = f.layer.buf_area;
+        }
+        if (m_root) lv_obj_invalidate(m_root);
+        return true;
+    }
+
+    // ==================== Producer (any thread) ====================
+
+    /// A free frame buffer to decode into (nullptr: all queued or on screen)
+    [[nodiscard]] lv_draw_buf_t* acquire() noexcept {
+        lock();
+        for (Frame& f : m_frames) {
+            if (f.buf && f.state == State::free) {
+                f.state = State::decoding;
+                unlock();
+                return f.buf;
+            }
+        }
+        ++m_stats.refused;
+        unlock();
+        return nullptr;
+    }
+
+    /// Queue a decoded frame for presentation at `pts_us` (microseconds, any origin)
+    bool submit(lv_draw_buf_t* buf, int64_t pts_us) noexcept {
+        lock();
+        Frame* f = find(buf);
+        const bool ok = f && f->state == State::decoding;
+        if (ok) enqueue(*f, pts_us);
+        unlock();
+        return ok;
+    }
+
+    /// Give back an acquired buffer without queueing it
+    void discard(lv_draw_buf_t* buf) noexcept {
+        lock();
+        Frame* f = find(buf);
+        if (f && f->state == State::decoding) f->state = State::free;
+        unlock();
+    }
+
+    /// Rebase the clock: the media time is `pts_us` now (audio master)
+    void sync(int64_t pts_us) noexcept {
+        lock();
+        m_base_pts = pts_us;
+        m_base_tick = lv_tick_get();
+        m_clock_set = true;
+        unlock();
+    }
+
+#if LV_USE_3DTEXTURE && LV_CPP_USE_EGL_IMPORT
+    /**
+     * @brief Show DMA-BUF frames too, through a TextureStream (LVGL thread)
+     * @param buffers Frames the stream keeps in flight (2 or 3)
+     */
+    [[nodiscard]] bool gpu(EGLDisplay dpy, uint8_t buffers = 3) noexcept {
+        return m_stream.init(dpy, buffers, m_disp);
+    }
+
+    /// Called with a DMA-BUF frame's token when the view no longer needs its buffer
+    VideoView& on_release(void (*cb)(void* token, void* user), void* user = nullptr) noexcept {
+        m_release = cb;
+        m_release_user = user;
+        m_stream.on_release(cb, user);
+        return *this;
+    }
+
+    /// Queue a DMA-BUF frame (any thread); false: the queue is full, `frame` not taken
+    bool submit(const DmaBufFrame& frame, int64_t pts_us) noexcept {
+        lock();
+        for (Frame& f : m_frames) {
+            if (f.state != State::free) continue;
+            f.dma = frame;
+            f.is_dma = true;
+            enqueue(f, pts_us);
+            unlock();
+            return true;
+        }
+        ++m_stats.refused;
+        unlock();
+        return false;
+    }
+#endif
+
+    // ==================== Playback (LVGL thread) ====================
+
+    /// Start presenting; the next queued frame sets the clock
+    void play() noexcept {
+        lock();
+        m_clock_set = false;
+        m_playing = true;
+        unlock();
+    }
+
+    /// Keep the current frame; queued frames wait
+    void pause() noexcept { m_playing = false; }
+
+    [[nodiscard]] bool playing() const noexcept { return m_playing; }
+
+    /// Drop every queued frame (seek); the next one sets the clock
+    void flush() noexcept {
+        lock();
+        for (Frame& f : m_frames) {
+            if (f.state == State::queued) recycle(f);
+        }
+        m_clock_set = false;
+        unlock();
+    }
+
+    /// Current media time in microseconds (0 before the first frame)
+    [[nodiscard]] int64_t position() noexcept {
+        lock();
+        const int64_t t = m_clock_set ? media_time(lv_tick_get()) : 0;
+        unlock();
+        return t;
+    }
+
+    /// Frames waiting for their presentation time
+    [[nodiscard]] uint32_t queued() noexcept {
+        lock();
+        uint32_t n = 0;
+        for (const Frame& f : m_frames) n += f.state == State::queued;
+        unlock();
+        return n;
+    }
+
+    [[nodiscard]] Stats stats() noexcept {
+        lock();
+        const Stats s = m_stats;
+        unlock();
+        return s;
+    }
+
+    void reset_stats() noexcept {
+        lock();
+        m_stats = Stats{};
+        unlock();
+    }
+};
+
+} // namespace lv
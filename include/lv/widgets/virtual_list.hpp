@@ -0,0 +1,380 @@
+#pragma once
+
+/**
+ * @file virtual_list.hpp
+ * @brief Virtualized list that recycles a fixed pool of row objects
+ *
+ * List::add_button() creates one lv_obj_t per item, so memory and layout
+ * cost grow with the item count. VirtualList<Provider> creates only enough
+ * rows to fill the viewport plus an overscan margin, positions them
+ * absolutely over a spacer that gives the list its full scroll height, and
+ * rebinds rows as they scroll into view. A 10k-item list costs the same as
+ * a 20-item one.
+ *
+ * Usage:
+ * @code
+ * struct LogRows {
+ *     const LogEntry* entries;
+ *     uint32_t n;
+ *     uint32_t count() const { return n; }
+ *     void bind(lv::ObjectView row, uint32_t i) {
+ *         lv_label_set_text(lv_obj_get_child(row.get(), 0), entries[i].text);
+ *     }
+ * };
+ *
+ * LogRows rows{log, 10000};
+ * lv::VirtualList<LogRows> list(rows, 40);   // 40 px rows
+ * list.mount(screen);
+ * list.root().size(lv::pct(100), lv::pct(100));
+ * @endcode
+ *
+ * Providers may also define `ObjectView create_row(ObjectView parent)` to
+ * build custom rows; otherwise each row is an lv_list button.
+ *
+ * Keypad navigation: focus_group() adds the list (not its rows) to a
+ * group as one focus stop. Up/down keys move the focused item, scrolling
+ * it into view, and the row currently bound to it shows the focused
+ * state; Enter sends LV_EVENT_CLICKED to that row. The focus follows the
+ * item while rows are recycled. With lv::key_nav attached to the keypad
+ * or encoder, the presses and repeats of one frame become a single
+ * focus_item(): one scroll and one rebind however fast the key repeats.
+ */
+
+#include <lvgl.h>
+#include <concepts>
+#include <cstdint>
+#include "../core/object.hpp"
+#include "../core/component.hpp"
+#include "../core/list_state.hpp"
+#include "../core/key_nav.hpp"
+#include "list.hpp"
+
+#if LV_USE_LIST
+
+namespace lv {
+
+/// Data source for VirtualList: item count and how to show item `i` in a row
+template<typename P>
+concept RowProvider = requires(P& p, ObjectView row, uint32_t i) {
+    { p.count() } -> std::convertible_to<uint32_t>;
+    p.bind(row, i);
+};
+
+/**
+ * @brief Scrollable list that binds a fixed pool of rows to a large data set
+ *
+ * All rows have the same height. Non-movable: scroll and size events keep
+ * a pointer to this object.
+ *
+ * Heap allocation: NONE (besides the MaxRows LVGL row objects)
+ *
+ * @tparam Provider Type satisfying RowProvider (held by reference)
+ * @tparam MaxRows Upper bound for the row pool
+ */
+template<RowProvider Provider, uint32_t MaxRows = 32>
+class VirtualList : public Component<VirtualList<Provider, MaxRows>> {
+    static constexpr uint32_t UNBOUND = UINT32_MAX;
+
+    Provider& m_provider;
+    int32_t m_row_height;
+    uint32_t m_overscan;
+    lv_obj_t* m_spacer = nullptr;
+    lv_obj_t* m_rows[MaxRows] = {};
+    uint32_t m_bound[MaxRows];
+    uint32_t m_created = 0;
+    uint32_t m_active = 0;     ///< Rows in use for the current viewport
+    uint32_t m_count = 0;
+    uint32_t m_focus = 0;      ///< Focused item (with focus_group())
+    lv_obj_t* m_focus_row = nullptr;
+
+    using Component<VirtualList>::m_root;
+
+    static void layout_cb(lv_event_t* e) noexcept {
+        static_cast<VirtualList*>(lv_event_get_user_data(e))->update();
+    }
+
+    static void key_cb(lv_event_t* e) noexcept {
+        auto* self = static_cast<VirtualList*>(lv_event_get_user_data(e));
+        switch (lv_event_get_code(e)) {
+        case LV_EVENT_KEY:
+            switch (lv_event_get_key(e)) {
+            case LV_KEY_DOWN:
+            case LV_KEY_RIGHT:
+                if (self->m_focus + 1 < self->m_count) self->focus_item(self->m_focus + 1);
+                break;
+            case LV_KEY_UP:
+            case LV_KEY_LEFT:
+                if (self->m_focus > 0) self->focus_item(self->m_focus - 1);
+                break;
+            case LV_KEY_HOME: self->focus_item(0); break;
+            case LV_KEY_END: if (self->m_count) self->focus_item(self->m_count - 1); break;
+            case LV_KEY_ENTER:
+                if (self->m_focus_row) lv_obj_send_event(self->m_focus_row, LV_EVENT_CLICKED, nullptr);
+                break;
+            default: break;
+            }
+            break;
+        default:    // FOCUSED / DEFOCUSED
+            self->mark_focus();
+            break;
+        }
+    }
+
+    /// key_nav step: several arrow presses land as one focus_item()
+    static void step_cb(lv_obj_t*, void* ctx, int32_t dx, int32_t dy) noexcept {
+        auto* self = static_cast<VirtualList*>(ctx);
+        const int64_t to = static_cast<int64_t>(self->m_focus) + dx + dy;
+        self->focus_item(to <= 0 ? 0u : to >= self->m_count ? self->m_count : static_cast<uint32_t>(to));
+    }
+
+    /// Show the focused state on the row bound to m_focus (none while the list is not focused)
+    void mark_focus() noexcept {
+        lv_obj_t* row = nullptr;
+        if (m_active && m_root && lv_obj_has_state(m_root, LV_STATE_FOCUSED)) {
+            const uint32_t slot = m_focus % m_active;
+            if (m_bound[slot] == m_focus) row = m_rows[slot];
+        }
+        if (row == m_focus_row) return;
+        constexpr lv_state_t focus_states = LV_STATE_FOCUSED | LV_STATE_FOCUS_KEY;
+        if (m_focus_row) lv_obj_remove_state(m_focus_row, focus_states);
+        if (row) lv_obj_add_state(row, focus_states);
+        m_focus_row = row;
+    }
+
+    [[nodiscard]] lv_obj_t* make_row() noexcept {
+        if constexpr (requires { m_provider.create_row(ObjectView(m_root)); }) {
+            return ObjectView(m_provider.create_row(ObjectView(m_root))).get();
+        } else {
+            return lv_list_add_button(m_root, nullptr, "");
+        }
+    }
+
+    void unbind_all() noexcept {
+        for (uint32_t i = 0; i < MaxRows; ++i) m_bound[i] = UNBOUND;
+    }
+
+    /// Map visible items onto pool slots (slot = index % active), binding only new ones
+    void update() noexcept {
+        if (!m_root) return;
+        const int32_t viewport = lv_obj_get_content_height(m_root);
+        uint32_t want = static_cast<uint32_t>(viewport / m_row_height) + 1 + 2 * m_overscan;
+        if (want > MaxRows) want = MaxRows;
+        if (want > m_count) want = m_count;
+
+        while (m_created < want) {
+            lv_obj_t* row = make_row();
+            if (!row) break;
+            lv_obj_add_flag(row, LV_OBJ_FLAG_HIDDEN);
+            m_rows[m_created++] = row;
+        }
+        if (want > m_created) want = m_created;
+        if (want != m_active) {
+            m_active = want;
+            unbind_all();
+        }
+
+        int32_t first = lv_obj_get_scroll_y(m_root) / m_row_height - static_cast<int32_t>(m_overscan);
+        if (first > static_cast<int32_t>(m_count - m_active)) first = static_cast<int32_t>(m_count - m_active);
+        if (first < 0) first = 0;
+
+        for (uint32_t i = 0; i < m_active; ++i) {
+            const uint32_t index = static_cast<uint32_t>(first) + i;
+            const uint32_t slot = index % m_active;
+            if (m_bound[slot] == index) continue;
+            bind_slot(slot, index);
+        }
+        for (uint32_t slot = m_active; slot < m_created; ++slot) {
+            lv_obj_add_flag(m_rows[slot], LV_OBJ_FLAG_HIDDEN);
+        }
+        mark_focus();
+    }
+
+    void bind_slot(uint32_t slot, uint32_t index) noexcept {
+        lv_obj_t* row = m_rows[slot];
+        m_bound[slot] = index;
+        lv_obj_set_pos(row, 0, static_cast<int32_t>(index) * m_row_height);
+        lv_obj_remove_flag(row, LV_OBJ_FLAG_HIDDEN);
+        m_provider.bind(ObjectView(row), index);
+    }
+
+#if LV_USE_OBSERVER
+    static void list_change_cb(lv_observer_t* observer, lv_subject_t* subject) noexcept {
+        auto* self = static_cast<VirtualList*>(lv_observer_get_user_data(observer));
+        self->apply(*static_cast<const ListChange*>(lv_subject_get_pointer(subject)));
+    }
+#endif
+
+    /// Highest item index currently bound to a row (UNBOUND if none)
+    [[nodiscard]] uint32_t last_bound() const noexcept {
+        uint32_t last = UNBOUND;
+        for (uint32_t i = 0; i < m_active; ++i) {
+            if (m_bound[i] != UNBOUND && (last == UNBOUND || m_bound[i] > last)) last = m_bound[i];
+        }
+        return last;
+    }
+
+public:
+    /**
+     * @param provider Data source (must outlive the list)
+     * @param row_height Height of every row in pixels
+     * @param overscan Extra rows kept bound above and below the viewport
+     */
+    VirtualList(Provider& provider, int32_t row_height, uint32_t overscan = 2) noexcept
+        : m_provider(provider), m_row_height(row_height > 0 ? row_height : 1), m_overscan(overscan) {
+        unbind_all();
+    }
+
+    // Unmount here, while on_unmount() can still run on a live object
+    ~VirtualList() {
+        this->unmount();
+    }
+
+    VirtualList(VirtualList&&) = delete;
+    VirtualList& operator=(VirtualList&&) = delete;
+
+    /// Component build(): list container, spacer and scroll/size hooks
+    ObjectView build(ObjectView parent) {
+        lv_obj_t* list = lv_list_create(parent.get());
+        lv_obj_set_layout(list, LV_LAYOUT_NONE);    // rows are positioned absolutely
+
+        m_spacer = lv_obj_create(list);
+        lv_obj_remove_style_all(m_spacer);
+        lv_obj_remove_flag(m_spacer, LV_OBJ_FLAG_CLICKABLE);
+        lv_obj_set_size(m_spacer, 1, 0);
+
+        lv_obj_add_event_cb(list, &VirtualList::layout_cb, LV_EVENT_SCROLL, this);
+        lv_obj_add_event_cb(list, &VirtualList::layout_cb, LV_EVENT_SIZE_CHANGED, this);
+
+        m_root = list;    // make_row() needs the parent before mount() stores it
+        m_created = 0;
+        m_active = 0;
+        unbind_all();
+        refresh();
+        return ObjectView(list);
+    }
+
+    void on_unmount() noexcept {
+        m_spacer = nullptr;
+        m_focus_row = nullptr;
+        m_created = 0;
+        m_active = 0;
+    }
+
+    // ==================== Updates ====================
+
+    /// Re-read count() and rebind every visible row
+    void refresh() noexcept {
+        if (!m_root) return;
+        m_count = m_provider.count();
+        if (m_focus >= m_count) m_focus = m_count ? m_count - 1 : 0;
+        lv_obj_set_height(m_spacer, static_cast<int32_t>(m_count) * m_row_height);
+        unbind_all();
+        update();
+    }
+
+    /// Rebind a single item if it is currently bound to a row
+    void refresh_row(uint32_t index) noexcept {
+        if (m_active == 0) return;
+        const uint32_t slot = index % m_active;
+        if (m_bound[slot] == index) bind_slot(slot, index);
+    }
+
+#if LV_USE_OBSERVER
+    /**
+     * @brief Apply a ListState diff
+     *
+     * Updates rebind one row. Inserts/removes below the bound rows only
+     * resize the spacer; anything else rebinds the visible rows (at most
+     * MaxRows binds, independent of the item count).
+     */
+    void apply(const ListChange& change) noexcept {
+        if (!m_root) return;
+        if (change.op == ListOp::update) {
+            refresh_row(change.index);
+            return;
+        }
+        const uint32_t last = last_bound();
+        if ((change.op == ListOp::insert || change.op == ListOp::remove) &&
+            last != UNBOUND && change.index > last) {
+            m_count = m_provider.count();
+            lv_obj_set_height(m_spacer, static_cast<int32_t>(m_count) * m_row_height);
+            update();
+            return;
+        }
+        refresh();
+    }
+
+    /**
+     * @brief Follow a ListState: each diff patches only the rows that changed
+     *
+     * The observer is tied to the list object and removed with it.
+     */
+    template<typename T, size_t Capacity>
+    VirtualList& bind_list(ListState<T, Capacity>& list) noexcept {
+        if (m_root) list.observe_obj(&VirtualList::list_change_cb, m_root, this);
+        return *this;
+    }
+#endif
+
+    /// Change the row height (before mount, or rebinding every visible row)
+    void row_height(int32_t h) noexcept {
+        m_row_height = h > 0 ? h : 1;
+        refresh();
+    }
+
+    /// Scroll so that item `index` is at the top
+    void scroll_to(uint32_t index, bool anim = false) noexcept {
+        if (!m_root) return;
+        lv_obj_scroll_to_y(m_root, static_cast<int32_t>(index) * m_row_height,
+                           anim ? LV_ANIM_ON : LV_ANIM_OFF);
+    }
+
+    // ==================== Keypad focus ====================
+
+    /**
+     * @brief Make the list one focus stop of `group` with item-wise key navigation
+     *
+     * The rows stay out of the group, so its size does not depend on the
+     * item count or on which rows are bound.
+     */
+    VirtualList& focus_group(lv_group_t* group) noexcept {
+        if (!m_root || !group) return *this;
+        lv_group_add_obj(group, m_root);
+        lv_obj_remove_flag(m_root, LV_OBJ_FLAG_SCROLL_WITH_ARROW);    // the keys move the item focus instead
+        lv_obj_remove_event_cb_with_user_data(m_root, &VirtualList::key_cb, this);
+        lv_obj_add_event_cb(m_root, &VirtualList::key_cb, LV_EVENT_KEY, this);
+        lv_obj_add_event_cb(m_root, &VirtualList::key_cb, LV_EVENT_FOCUSED, this);
+        lv_obj_add_event_cb(m_root, &VirtualList::key_cb, LV_EVENT_DEFOCUSED, this);
+        key_nav::add(m_root, &VirtualList::step_cb, this);
+        mark_focus();
+        return *this;
+    }
+
+    /// Move the focus to item `index` and scroll the least needed to show it
+    void focus_item(uint32_t index, bool anim = false) noexcept {
+        if (!m_root || m_count == 0) return;
+        m_focus = index < m_count ? index : m_count - 1;
+        const int32_t top = static_cast<int32_t>(m_focus) * m_row_height;
+        const int32_t scroll = lv_obj_get_scroll_y(m_root);
+        const int32_t viewport = lv_obj_get_content_height(m_root);
+        if (top < scroll) {
+            lv_obj_scroll_to_y(m_root, top, anim ? LV_ANIM_ON : LV_ANIM_OFF);
+        } else if (top + m_row_height > scroll + viewport) {
+            lv_obj_scroll_to_y(m_root, top + m_row_height - viewport, anim ? LV_ANIM_ON : LV_ANIM_OFF);
+        }
+        update();
+    }
+
+    /// Focused item (0 before any navigation)
+    [[nodiscard]] uint32_t focused_item() const noexcept { return m_focus; }
+
+    /// Number of row objects created so far
+    [[nodiscard]] uint32_t row_count() const noexcept { return m_created; }
+
+    /// Item count as of the last refresh()
+    [[nodiscard]] uint32_t item_count() const noexcept { return m_count; }
+};
+
+} // namespace lv
+
+#endif // LV_USE_LIST
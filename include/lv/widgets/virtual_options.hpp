@@ -0,0 +1,515 @@
+#pragma once
+
+/**
+ * @file virtual_options.hpp
+ * @brief Roller and dropdown over a provider that formats only the options on screen
+ *
+ * lv_roller_set_options() and lv_dropdown_set_options() take every option
+ * as one newline-joined string. A roller in infinite mode copies it
+ * several times, and an open dropdown lays all of it out as one label, so
+ * 400 time zones cost 400 options of memory and measuring on every open.
+ *
+ * VirtualRoller<Provider, Window> hands LVGL a window of Window options
+ * around the selection (LVGL's normal mode) and moves the window once the
+ * roller settles. Infinite wrap is an index modulo count() in that window,
+ * so no text is repeated. VirtualDropdown<Provider, MaxRows> keeps LVGL's
+ * dropdown button for the look and opens a VirtualList popup instead of
+ * LVGL's list, binding only the rows in view.
+ *
+ * @code
+ * struct Zones {
+ *     uint32_t count() const { return zone_count; }
+ *     void text(uint32_t i, char* buf, uint32_t size) const { lv_snprintf(buf, size, "%s", zones[i].name); }
+ * };
+ *
+ * Zones zones;
+ * lv::VirtualRoller<Zones> tz(zones, 5, lv::VirtualRoller<Zones>::infinite);
+ * tz.mount(screen);
+ * tz.roller().on_value_changed<&Settings::on_zone>(this);   // read tz.selected()
+ *
+ * lv::VirtualDropdown<Countries> country(countries);
+ * country.mount(screen);
+ * @endcode
+ *
+ * Both can follow a ListState with bind_list(); the provider then reads
+ * from the list. LVGL's own index getters (lv_roller_get_selected(),
+ * lv_dropdown_get_selected()) refer to the window, so use selected().
+ *
+ * Heap allocation: NONE (LVGL copies the Window options of a roller; a
+ * dropdown popup creates up to MaxRows rows while open)
+ */
+
+#include <lvgl.h>
+#include <concepts>
+#include <cstdint>
+#include "../core/object.hpp"
+#include "../core/component.hpp"
+#include "../core/list_state.hpp"
+
+#ifndef LV_CPP_OPTION_TEXT_MAX
+/// Longest option text formatted by an OptionProvider (bytes including the terminator)
+#define LV_CPP_OPTION_TEXT_MAX 64
+#endif
+
+namespace lv {
+
+/// Data source for VirtualRoller / VirtualDropdown: option count and text of option `i`
+template<typename P>
+concept OptionProvider = requires(P& p, uint32_t i, char* buf, uint32_t size) {
+    { p.count() } -> std::convertible_to<uint32_t>;
+    p.text(i, buf, size);
+};
+
+} // namespace lv
+
+#if LV_USE_ROLLER
+
+#include "roller.hpp"
+
+namespace lv {
+
+/**
+ * @brief Roller showing a provider's options through a window of Window options
+ *
+ * With count() <= Window the options are set once (infinite mode then uses
+ * LVGL's). Larger sets keep Window options around the selection and move
+ * the window when the roller has settled (after the release or key
+ * animation) with the selection within Window / 4 of an edge. Re-windowing
+ * replaces the text and the window index without moving the label, so it
+ * is not visible. A fast fling stops at the window edge until the release.
+ *
+ * Non-movable: the roller's events keep a pointer to this object.
+ *
+ * @tparam Provider Type satisfying OptionProvider (held by reference)
+ * @tparam Window Options handed to LVGL at a time (more than the visible rows)
+ */
+template<OptionProvider Provider, uint32_t Window = 24>
+class VirtualRoller : public Component<VirtualRoller<Provider, Window>> {
+    static_assert(Window >= 4, "VirtualRoller window too small");
+
+    Provider& m_provider;
+    uint32_t m_rows;
+    bool m_infinite;
+    uint32_t m_count = 0;
+    uint32_t m_first = 0;      ///< Item shown as window option 0
+    uint32_t m_window = 0;     ///< Options handed to LVGL (min(count, Window))
+    uint32_t m_selected = 0;   ///< Selected item before the roller exists / while empty
+    lv_timer_t* m_settle = nullptr;
+
+    using Component<VirtualRoller>::m_root;
+
+    [[nodiscard]] bool windowed() const noexcept { return m_count > Window; }
+
+    /// Item at window option `k`
+    [[nodiscard]] uint32_t item(uint32_t k) const noexcept {
+        const uint32_t i = m_first + k;
+        return i < m_count ? i : i - m_count;
+    }
+
+    /// Hand LVGL the options from `first` and select item `sel` among them
+    void set_window(uint32_t first, uint32_t sel) noexcept {
+        static char text[Window * LV_CPP_OPTION_TEXT_MAX];
+        m_first = first;
+        uint32_t len = 0;
+        for (uint32_t k = 0; k < m_window; ++k) {
+            if (k) text[len++] = '\n';
+            char* out = text + len;
+            out[0] = '\0';
+            m_provider.text(item(k), out, LV_CPP_OPTION_TEXT_MAX - 1);
+            while (text[len]) {
+                if (text[len] == '\n') text[len] = ' ';   // one line per option
+                ++len;
+            }
+        }
+        text[len] = '\0';
+        const lv_roller_mode_t mode = m_infinite && !windowed() ? LV_ROLLER_MODE_INFINITE : LV_ROLLER_MODE_NORMAL;
+        lv_roller_set_options(m_root, text, mode);
+        lv_roller_set_selected(m_root, (sel + m_count - m_first) % m_count, LV_ANIM_OFF);
+    }
+
+    /// First window item that centers `sel`
+    [[nodiscard]] uint32_t centered(uint32_t sel) const noexcept {
+        const uint32_t half = Window / 2;
+        if (m_infinite) return (sel + m_count - half % m_count) % m_count;
+        if (sel < half) return 0;
+        return sel - half > m_count - Window ? m_count - Window : sel - half;
+    }
+
+    /// Move the window if the selection came within Window / 4 of an edge that can move
+    void recenter() noexcept {
+        if (!m_root || !windowed()) return;
+        const uint32_t k = lv_roller_get_selected(m_root);
+        const uint32_t sel = item(k);
+        const uint32_t first = centered(sel);
+        if (first == m_first) return;
+        if (k >= Window / 4 && k < Window - Window / 4) return;
+        set_window(first, sel);
+    }
+
+    static void changed_cb(lv_event_t* e) noexcept {
+        auto* self = static_cast<VirtualRoller*>(lv_event_get_user_data(e));
+        if (self->m_settle) lv_timer_resume(self->m_settle);
+    }
+
+    static void delete_cb(lv_event_t* e) noexcept {
+        auto* self = static_cast<VirtualRoller*>(lv_event_get_user_data(e));
+        if (self->m_settle) lv_timer_delete(self->m_settle);
+        self->m_settle = nullptr;
+    }
+
+    /// Wait for the settle animation and the release before swapping the text
+    static void settle_cb(lv_timer_t* t) noexcept {
+        auto* self = static_cast<VirtualRoller*>(lv_timer_get_user_data(t));
+        if (!self->m_root) return;
+        lv_obj_t* label = lv_obj_get_child(self->m_root, 0);
+        if ((label && lv_anim_get(label, nullptr)) || lv_obj_has_state(self->m_root, LV_STATE_PRESSED)) return;
+        lv_timer_pause(t);
+        self->recenter();
+    }
+
+#if LV_USE_OBSERVER
+    static void list_change_cb(lv_observer_t* observer, lv_subject_t*) noexcept {
+        static_cast<VirtualRoller*>(lv_observer_get_user_data(observer))->refresh();
+    }
+#endif
+
+public:
+    /// Pass as `infinite` to wrap from the last option to the first
+    static constexpr bool infinite = true;
+
+    /**
+     * @param provider Data source (must outlive the roller)
+     * @param visible_rows Rows shown by the roller
+     * @param wrap_around Wrap from the last option to the first, like LV_ROLLER_MODE_INFINITE
+     */
+    explicit VirtualRoller(Provider& provider, uint32_t visible_rows = 5, bool wrap_around = false) noexcept
+        : m_provider(provider), m_rows(visible_rows), m_infinite(wrap_around) {}
+
+    ~VirtualRoller() {
+        this->unmount();
+    }
+
+    VirtualRoller(VirtualRoller&&) = delete;
+    VirtualRoller& operator=(VirtualRoller&&) = delete;
+
+    /// Component build(): the roller, its first window and the settle hook
+    ObjectView build(ObjectView parent) {
+        lv_obj_t* roller = lv_roller_create(parent.get());
+        lv_roller_set_visible_row_count(roller, m_rows);
+        lv_obj_add_event_cb(roller, &VirtualRoller::changed_cb, LV_EVENT_VALUE_CHANGED, this);
+        lv_obj_add_event_cb(roller, &VirtualRoller::delete_cb, LV_EVENT_DELETE, this);
+        m_settle = lv_timer_create(&VirtualRoller::settle_cb, 30, this);
+        lv_timer_pause(m_settle);
+        m_root = roller;    // refresh() needs the roller before mount() stores it
+        refresh();
+        return ObjectView(roller);
+    }
+
+    void on_unmount() noexcept {
+        m_selected = selected();
+    }
+
+    /// The LVGL roller (styling, events); its own selection index is window-relative
+    [[nodiscard]] Roller roller() const noexcept { return Roller(wrap, m_root); }
+
+    /// Re-read count() and every option in the window, keeping the selected index
+    void refresh() noexcept {
+        if (!m_root) return;
+        const uint32_t sel = selected();
+        m_count = m_provider.count();
+        if (m_count == 0) {
+            m_window = 0;
+            m_first = 0;
+            lv_roller_set_options(m_root, "", LV_ROLLER_MODE_NORMAL);
+            return;
+        }
+        m_window = windowed() ? Window : m_count;
+        const uint32_t s = sel < m_count ? sel : m_count - 1;
+        set_window(windowed() ? centered(s) : 0, s);
+    }
+
+    /// Selected item (not the window option)
+    [[nodiscard]] uint32_t selected() const noexcept {
+        if (!m_root || m_count == 0) return m_selected;
+        return item(lv_roller_get_selected(m_root) % m_window);
+    }
+
+    /// Select item `index`; with `anim` the roller scrolls there if it is in the window
+    VirtualRoller& selected(uint32_t index, bool anim = false) noexcept {
+        m_selected = index;
+        if (!m_root || m_count == 0) return *this;
+        if (index >= m_count) index = m_count - 1;
+        const uint32_t k = (index + m_count - m_first) % m_count;
+        if (anim && k < m_window) {
+            lv_roller_set_selected(m_root, k, LV_ANIM_ON);
+            if (m_settle) lv_timer_resume(m_settle);
+        } else if (windowed()) {
+            set_window(centered(index), index);
+        } else {
+            lv_roller_set_selected(m_root, index, LV_ANIM_OFF);
+        }
+        return *this;
+    }
+
+    /// Number of options (count() as of the last refresh())
+    [[nodiscard]] uint32_t option_count() const noexcept { return m_count; }
+
+    /// Selected option text
+    void selected_str(char* buf, uint32_t size) const noexcept {
+        if (!size) return;
+        buf[0] = '\0';
+        if (m_count) m_provider.text(selected(), buf, size);
+    }
+
+#if LV_USE_OBSERVER
+    /// Follow a ListState: every change re-reads the window (at most Window options)
+    template<typename T, size_t Capacity>
+    VirtualRoller& bind_list(ListState<T, Capacity>& list) noexcept {
+        if (m_root) list.observe_obj(&VirtualRoller::list_change_cb, m_root, this);
+        return *this;
+    }
+#endif
+};
+
+} // namespace lv
+
+#endif // LV_USE_ROLLER
+
+#if LV_USE_DROPDOWN && LV_USE_LIST
+
+#include "dropdown.hpp"
+#include "virtual_list.hpp"
+
+namespace lv {
+
+/**
+ * @brief Dropdown whose open list is a VirtualList over a provider
+ *
+ * The closed dropdown shows the selected option's text. Opening it
+ * (click, or Enter with a keypad) hides LVGL's list and opens a popup on
+ * the top layer, under the dropdown or above it when there is no room,
+ * with `visible_rows` rows and the selection in view. Clicking an option
+ * selects it, closes the popup and sends LV_EVENT_VALUE_CHANGED to the
+ * dropdown; clicking outside or Esc closes it. With the dropdown in a
+ * group, the popup takes the keypad focus while open.
+ *
+ * Non-movable: the dropdown's events and the popup keep a pointer to this object.
+ *
+ * @tparam Provider Type satisfying OptionProvider (held by reference)
+ * @tparam MaxRows Upper bound for the popup's row pool
+ */
+template<OptionProvider Provider, uint32_t MaxRows = 16>
+class VirtualDropdown : public Component<VirtualDropdown<Provider, MaxRows>> {
+    /// VirtualList provider over the options
+    struct Rows {
+        VirtualDropdown* owner;
+
+        [[nodiscard]] uint32_t count() const { return owner->m_count; }
+
+        ObjectView create_row(ObjectView parent) {
+            lv_obj_t* row = lv_list_add_button(parent.get(), nullptr, "");
+            lv_obj_add_event_cb(row, &VirtualDropdown::row_clicked_cb, LV_EVENT_CLICKED, owner);
+            return ObjectView(row);
+        }
+
+        void bind(ObjectView row, uint32_t i) {
+            char text[LV_CPP_OPTION_TEXT_MAX];
+            text[0] = '\0';
+            owner->m_provider.text(i, text, sizeof(text));
+            lv_label_set_text(lv_obj_get_child(row.get(), 0), text);
+            lv_obj_set_user_data(row.get(), reinterpret_cast<void*>(static_cast<uintptr_t>(i)));
+            const bool sel = i == owner->m_selected;
+            lv::set_states(row.get(), sel ? LV_STATE_CHECKED : 0, sel ? 0 : LV_STATE_CHECKED);
+        }
+    };
+
+    Provider& m_provider;
+    uint32_t m_rows;
+    int32_t m_row_height;
+    uint32_t m_count = 0;
+    uint32_t m_selected = 0;
+    char m_text[LV_CPP_OPTION_TEXT_MAX] = {};   ///< Shown by the closed dropdown (not copied by LVGL)
+    Rows m_list_rows{this};
+    VirtualList<Rows, MaxRows> m_list;
+    lv_obj_t* m_backdrop = nullptr;
+
+    using Component<VirtualDropdown>::m_root;
+
+    void show_selected() noexcept {
+        m_text[0] = '\0';
+        if (m_count) m_provider.text(m_selected, m_text, sizeof(m_text));
+        if (m_root) lv_dropdown_set_text(m_root, m_text);   // also invalidates
+    }
+
+    /// LVGL opened its (one empty option) list: hide it and toggle the popup instead
+    static void ready_cb(lv_event_t* e) noexcept {
+        auto* self = static_cast<VirtualDropdown*>(lv_event_get_user_data(e));
+        lv_obj_t* list = lv_dropdown_get_list(self->m_root);
+        if (list) lv_obj_add_flag(list, LV_OBJ_FLAG_HIDDEN);
+        if (self->m_backdrop) self->close();
+        else self->open();
+    }
+
+    static void delete_cb(lv_event_t* e) noexcept {
+        static_cast<VirtualDropdown*>(lv_event_get_user_data(e))->close_popup(false);
+    }
+
+    static void backdrop_cb(lv_event_t* e) noexcept {
+        auto* self = static_cast<VirtualDropdown*>(lv_event_get_user_data(e));
+        if (lv_event_get_target(e) == self->m_backdrop) self->close();
+    }
+
+    static void key_cb(lv_event_t* e) noexcept {
+        if (lv_event_get_key(e) == LV_KEY_ESC) static_cast<VirtualDropdown*>(lv_event_get_user_data(e))->close();
+    }
+
+    static void row_clicked_cb(lv_event_t* e) noexcept {
+        auto* self = static_cast<VirtualDropdown*>(lv_event_get_user_data(e));
+        const auto* row = static_cast<lv_obj_t*>(lv_event_get_current_target(e));
+        const uint32_t index = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(lv_obj_get_user_data(row)));
+        self->m_selected = index;
+        self->show_selected();
+        lv_obj_t* dropdown = self->m_root;
+        self->close();
+        if (dropdown) lv_obj_send_event(dropdown, LV_EVENT_VALUE_CHANGED, nullptr);
+    }
+
+    void open() noexcept {
+        if (!m_root || m_backdrop || m_count == 0) return;
+        lv_obj_t* layer = lv_layer_top();
+        m_backdrop = lv_obj_create(layer);
+        lv_obj_remove_style_all(m_backdrop);
+        lv_obj_set_size(m_backdrop, lv_pct(100), lv_pct(100));
+        lv_obj_add_flag(m_backdrop, LV_OBJ_FLAG_CLICKABLE);
+        lv_obj_add_event_cb(m_backdrop, &VirtualDropdown::backdrop_cb, LV_EVENT_CLICKED, this);
+
+        m_list.mount(ObjectView(m_backdrop));
+        lv_obj_t* list = m_list.root().get();
+        const uint32_t rows = m_count < m_rows ? m_count : m_rows;
+        const int32_t frame = lv_obj_get_style_pad_top(list, LV_PART_MAIN) +
+                              lv_obj_get_style_pad_bottom(list, LV_PART_MAIN) +
+                              2 * lv_obj_get_style_border_width(list, LV_PART_MAIN);
+        const int32_t h = static_cast<int32_t>(rows) * m_row_height + frame;
+        lv_area_t a;
+        lv_obj_get_coords(m_root, &a);
+        int32_t y = a.y2;
+        if (y + h > lv_obj_get_height(layer) && a.y1 - h >= 0) y = a.y1 - h;
+        lv_obj_set_size(list, lv_area_get_width(&a), h);
+        lv_obj_set_pos(list, a.x1, y);
+        lv_obj_add_event_cb(list, &VirtualDropdown::key_cb, LV_EVENT_KEY, this);
+        lv_obj_update_layout(list);    // size the row pool now
+
+        const uint32_t top = m_selected >= rows / 2 ? m_selected - rows / 2 : 0;
+        m_list.scroll_to(top);
+        if (lv_group_t* group = lv_obj_get_group(m_root)) {
+            m_list.focus_group(group);
+            lv_group_focus_obj(list);
+            m_list.focus_item(m_selected);
+        }
+    }
+
+    /// Drop the popup; with `to_lvgl` also tell the dropdown it closed
+    void close_popup(bool to_lvgl) noexcept {
+        if (!m_backdrop) return;
+        lv_obj_t* backdrop = m_backdrop;
+        m_backdrop = nullptr;
+        m_list.unmount();
+        lv_obj_delete(backdrop);
+        if (to_lvgl && m_root) {
+            lv_dropdown_close(m_root);
+            if (lv_obj_get_group(m_root)) lv_group_focus_obj(m_root);
+        }
+    }
+
+#if LV_USE_OBSERVER
+    static void list_change_cb(lv_observer_t* observer, lv_subject_t* subject) noexcept {
+        auto* self = static_cast<VirtualDropdown*>(lv_observer_get_user_data(observer));
+        self->m_count = self->m_provider.count();
+        if (self->m_selected >= self->m_count) self->m_selected = self->m_count ? self->m_count - 1 : 0;
+        self->show_selected();
+        if (self->m_backdrop) self->m_list.apply(*static_cast<const ListChange*>(lv_subject_get_pointer(subject)));
+    }
+#endif
+
+public:
+    /**
+     * @param provider Data source (must outlive the dropdown)
+     * @param visible_rows Rows the open popup shows at most
+     * @param row_height Popup row height in pixels (0: the dropdown font's line height plus 16)
+     */
+    explicit VirtualDropdown(Provider& provider, uint32_t visible_rows = 8, int32_t row_height = 0) noexcept
+        : m_provider(provider), m_rows(visible_rows ? visible_rows : 1), m_row_height(row_height),
+          m_list(m_list_rows, row_height > 0 ? row_height : 1, 1) {}
+
+    ~VirtualDropdown() {
+        close_popup(false);
+        this->unmount();
+    }
+
+    VirtualDropdown(VirtualDropdown&&) = delete;
+    VirtualDropdown& operator=(VirtualDropdown&&) = delete;
+
+    /// Component build(): LVGL dropdown with fixed text and the open/close hooks
+    ObjectView build(ObjectView parent) {
+        lv_obj_t* dropdown = lv_dropdown_create(parent.get());
+        lv_dropdown_set_options_static(dropdown, "");
+        lv_obj_add_event_cb(dropdown, &VirtualDropdown::ready_cb, LV_EVENT_READY, this);
+        lv_obj_add_event_cb(dropdown, &VirtualDropdown::delete_cb, LV_EVENT_DELETE, this);
+        if (m_row_height <= 0) {
+            const lv_font_t* font = lv_obj_get_style_text_font(dropdown, LV_PART_MAIN);
+            m_row_height = lv_font_get_line_height(font) + 16;
+            m_list.row_height(m_row_height);
+        }
+        m_root = dropdown;
+        refresh();
+        return ObjectView(dropdown);
+    }
+
+    void on_unmount() noexcept {
+        close_popup(false);
+    }
+
+    /// The LVGL dropdown (styling, events); its own selection index is meaningless
+    [[nodiscard]] Dropdown dropdown() const noexcept { return Dropdown(wrap, m_root); }
+
+    /// Re-read count() and the selected option's text (and the open popup's rows)
+    void refresh() noexcept {
+        m_count = m_provider.count();
+        if (m_selected >= m_count) m_selected = m_count ? m_count - 1 : 0;
+        show_selected();
+        if (m_backdrop) m_list.refresh();
+    }
+
+    [[nodiscard]] uint32_t selected() const noexcept { return m_selected; }
+
+    /// Select item `index` (no LV_EVENT_VALUE_CHANGED)
+    VirtualDropdown& selected(uint32_t index) noexcept {
+        m_selected = m_count == 0 ? 0 : index < m_count ? index : m_count - 1;
+        show_selected();
+        if (m_backdrop) m_list.refresh();
+        return *this;
+    }
+
+    [[nodiscard]] uint32_t option_count() const noexcept { return m_count; }
+
+    [[nodiscard]] bool is_open() const noexcept { return m_backdrop != nullptr; }
+
+    /// Open the popup (as a click would)
+    void open_list() noexcept { open(); }
+
+    /// Close the popup
+    void close() noexcept { close_popup(true); }
+
+#if LV_USE_OBSERVER
+    /// Follow a ListState: the closed text and the open popup's rows track each change
+    template<typename T, size_t Capacity>
+    VirtualDropdown& bind_list(ListState<T, Capacity>& list) noexcept {
+        if (m_root) list.observe_obj(&VirtualDropdown::list_change_cb, m_root, this);
+        return *this;
+    }
+#endif
+};
+
+} // namespace lv
+
+#endif // LV_USE_DROPDOWN && LV_USE_LIST
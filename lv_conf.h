@@ -6,6 +6,12 @@
 #ifndef LV_CONF_H
 #define LV_CONF_H
 
+/* Builds that call lv_profile() (cmake/LvProfile.cmake) get their widget
+ * switches from the generated header instead of the block below */
+#ifdef LV_CPP_PROFILE_HEADER
+#include LV_CPP_PROFILE_HEADER
+#endif
+
 /*====================
    COLOR SETTINGS
  *====================*/
@@ -34,7 +40,11 @@
 /*=================
  * OPERATING SYSTEM
  *=================*/
+/* Threaded builds (-DLV_RENDER_THREADS=N) define LV_USE_OS=LV_OS_PTHREAD
+ * and LV_DRAW_SW_DRAW_UNIT_CNT=N on the command line */
+#ifndef LV_USE_OS
 #define LV_USE_OS   LV_OS_NONE
+#endif
 
 /*=====================
  * RENDERING CONFIG
@@ -52,6 +62,7 @@
  * FEATURE CONFIGURATION
  *=======================*/
 
+#if !LV_CPP_PROFILE
 /* Observer - REQUIRED for State<T> */
 #define LV_USE_OBSERVER 1
 
@@ -92,6 +103,7 @@
 #define LV_USE_TABVIEW    1
 #define LV_USE_TILEVIEW   1
 #define LV_USE_WIN        1
+#endif /* !LV_CPP_PROFILE */
 
 /* OpenGL ES driver (for 3D texture support) */
 #define LV_USE_OPENGLES   1
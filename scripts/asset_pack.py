@@ -0,0 +1,211 @@
+#!/usr/bin/env python3
+"""Bundle images, fonts and translations into one lv::AssetPack file.
+
+  scripts/asset_pack.py demos/analog_clock/generated/images/ui_img_*.c \\
+      inter_14=fonts/inter_14.bin \\
+      ebike=demos/ebike/translations/en.yml,demos/ebike/translations/ar.yml \\
+      --color-format RGB565 -o build/assets.lap
+
+Each input is `[name=]path`; the name defaults to the file name without
+extension. The kind follows from the input:
+
+  *.c                 generated LVGL image (lv_image_dsc_t array)
+  *.bin               LVGL .bin image, or an lv_binfont font (lv_font_conv --format bin)
+  *.png, *.jpg        image, needs Pillow
+  *.yml, *.yaml       lv_i18n translations, one language per file; several
+                      files (comma separated) make one multi-language pack
+  *.ltp               translation pack from scripts/translation_pack.py
+  anything else       raw bytes
+
+Images are stored as LVGL .bin images. With --color-format they are
+converted to the display's format first (RGB565, RGB888, XRGB8888 or
+ARGB8888), so nothing is converted on the device. Their pixel data starts
+at a multiple of --align (LV_DRAW_BUF_ALIGN, default 4); other assets are
+4-byte aligned. On the device:
+
+  static lv::AssetPack assets("A:/data/assets.lap");
+  lv::Image::create(screen).src(assets.image("ui_img_img_bg_analog_png"));
+
+The table of contents is sorted by the 32-bit FNV-1a hash of the names
+(lv::asset_hash()); names whose hashes collide are refused. See
+include/lv/core/asset_pack.hpp.
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from image_codec_convert import BPP, CF, LV_IMAGE_HEADER_MAGIC, parse_c_array, to_rgba  # noqa: E402
+from translation_pack import compile_pack  # noqa: E402
+
+MAGIC = b"LVAP"
+VERSION = 1
+HEAD = struct.Struct("<4sHHII")
+ENTRY = struct.Struct("<IB3xIII")
+IMAGE_HEAD = struct.Struct("<BBHHHHH")
+MASK = 0xFFFFFFFF
+
+RAW, IMAGE, FONT, TRANSLATIONS = range(4)
+KIND_NAMES = ("raw", "image", "font", "translations")
+
+
+def asset_hash(name):
+    """Same as lv::asset_hash()."""
+    h = 0x811C9DC5
+    for b in name.encode("utf-8"):
+        h = ((h ^ b) * 0x01000193) & MASK
+    return h
+
+
+def encode_pixels(rgba, cf):
+    """RGBA tuples as rows of `cf`; returns the bytes and the stride."""
+    out = bytearray()
+    for r, g, b, a in rgba:
+        if cf == "RGB565":
+            out += struct.pack("<H", ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3))
+        elif cf == "RGB888":
+            out += bytes((b, g, r))
+        elif cf == "XRGB8888":
+            out += bytes((b, g, r, 0xFF))
+        else:
+            out += bytes((b, g, r, a))
+    return bytes(out)
+
+
+def image_asset(cf, w, h, stride, data, target):
+    """(.bin image header, pixels), converted to `target` if given."""
+    if target and target != cf:
+        rgba = to_rgba(cf, w, h, stride, data)
+        cf, stride, data = target, w * BPP[target], encode_pixels(rgba, target)
+    stride = stride or w * BPP.get(cf, 2)
+    return IMAGE_HEAD.pack(LV_IMAGE_HEADER_MAGIC, CF[cf], 0, w, h, stride, 0), data
+
+
+def load_image_file(path, target):
+    try:
+        from PIL import Image
+    except ImportError:
+        raise ValueError(f"{path}: PNG and JPEG inputs need Pillow (pip install pillow)")
+    img = Image.open(path).convert("RGBA")
+    w, h = img.size
+    cf = target or "ARGB8888"
+    return image_asset("ARGB8888", w, h, w * 4, encode_pixels(list(img.getdata()), "ARGB8888"), cf)
+
+
+def load_bin(path, data, target):
+    """Font or image from a .bin file."""
+    if len(data) >= 8 and data[4:8] == b"head":
+        return FONT, None, data
+    if len(data) >= IMAGE_HEAD.size and data[0] == LV_IMAGE_HEADER_MAGIC:
+        magic, cf_raw, flags, w, h, stride, _ = IMAGE_HEAD.unpack_from(data)
+        cf = next((k for k, v in CF.items() if v == cf_raw), None)
+        if flags & 0x08:
+            raise ValueError(f"{path}: compressed images cannot be used in place")
+        if cf is None:
+            return IMAGE, data[:IMAGE_HEAD.size], data[IMAGE_HEAD.size:]
+        head, pixels = image_asset(cf, w, h, stride, data[IMAGE_HEAD.size:], target)
+        return IMAGE, head, pixels
+    raise ValueError(f"{path}: neither an LVGL .bin image nor an lv_binfont")
+
+
+def load(spec, target):
+    """(name, kind, image header or None, payload) of one input."""
+    name, sep, paths = spec.partition("=")
+    if not sep:
+        name, paths = "", spec
+    paths = paths.split(",")
+    first = paths[0]
+    if not name:
+        name = os.path.splitext(os.path.basename(first))[0]
+    ext = os.path.splitext(first)[1].lower()
+    if ext in (".yml", ".yaml"):
+        data, _, _, _ = compile_pack(paths)
+        return name, TRANSLATIONS, None, data
+    if len(paths) > 1:
+        raise ValueError(f"{spec}: only translations take several files")
+    if ext == ".c":
+        try:
+            _, cf, w, h, stride, data = parse_c_array(first)
+        except (ValueError, AttributeError) as e:
+            raise ValueError(f"{first}: {e} (fonts: convert with lv_font_conv --format bin)")
+        head, pixels = image_asset(cf, w, h, stride, data, target)
+        return name, IMAGE, head, pixels
+    if ext in (".png", ".jpg", ".jpeg"):
+        head, pixels = load_image_file(first, target)
+        return name, IMAGE, head, pixels
+    with open(first, "rb") as f:
+        data = f.read()
+    if ext == ".bin":
+        kind, head, payload = load_bin(first, data, target)
+        return name, kind, head, payload
+    if ext == ".ltp":
+        if data[:4] != b"LVTP":
+            raise ValueError(f"{first}: not a translation pack")
+        return name, TRANSLATIONS, None, data
+    return name, RAW, None, data
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("inputs", nargs="+", help="[name=]path[,path...]")
+    ap.add_argument("-o", "--out", required=True, help="output pack path")
+    ap.add_argument("--color-format", choices=("RGB565", "RGB888", "XRGB8888", "ARGB8888"),
+                    help="convert every image to the display's color format")
+    ap.add_argument("--align", type=int, default=4, help="pixel data alignment, LV_DRAW_BUF_ALIGN (default 4)")
+    args = ap.parse_args()
+    if args.align < 4 or args.align & (args.align - 1) or args.align > 0x8000:
+        ap.error("--align must be a power of two from 4 to 32768")
+
+    assets = {}
+    for spec in args.inputs:
+        try:
+            name, kind, head, payload = load(spec, args.color_format)
+        except (OSError, ValueError) as e:
+            sys.exit(str(e))
+        h = asset_hash(name)
+        if name in assets:
+            sys.exit(f"{spec}: {name} is already in the pack")
+        clash = next((n for n, a in assets.items() if a[0] == h), None)
+        if clash:
+            sys.exit(f"{spec}: the hash of {name} collides with {clash}, rename one")
+        assets[name] = (h, kind, head, payload)
+
+    order = sorted(assets.items(), key=lambda kv: kv[1][0])
+    names = bytearray()
+    name_off = {}
+    for name, _ in order:
+        name_off[name] = len(names)
+        names += name.encode("utf-8") + b"\0"
+
+    offset = HEAD.size + ENTRY.size * len(order) + len(names)
+    table, blobs = [], []
+    for name, (h, kind, head, payload) in order:
+        if head:
+            # Pixels, not the 12 byte header, start on the alignment
+            offset = (offset + IMAGE_HEAD.size + args.align - 1) // args.align * args.align - IMAGE_HEAD.size
+            blob = head + payload
+        else:
+            offset = (offset + 3) & ~3
+            blob = payload
+        table.append(ENTRY.pack(h, kind, name_off[name], offset, len(blob)))
+        blobs.append((offset, blob))
+        offset += len(blob)
+
+    with open(args.out, "wb") as f:
+        f.write(HEAD.pack(MAGIC, VERSION, args.align, len(order), len(names)))
+        for entry in table:
+            f.write(entry)
+        f.write(names)
+        for at, blob in blobs:
+            f.write(b"\0" * (at - f.tell()))
+            f.write(blob)
+
+    for name, (h, kind, head, payload) in order:
+        print(f"  {KIND_NAMES[kind]:12s} {len(payload) + len(head or b''):9d} bytes  {name}")
+    print(f"{args.out}: {len(order)} assets, {offset} bytes")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,127 @@
+#!/usr/bin/env python3
+"""Pack generated LVGL image C arrays into one sprite sheet for lv::Atlas.
+
+  scripts/atlas_pack.py demos/smartwatch/generated/image_*_icon.c -o build/icons
+
+writes build/icons.c (the sheet, an lv_image_dsc_t named `icons_sheet`) and
+build/icons.hpp (`icons_rects`, an lv::AtlasRect table, and an `icons_id`
+enum indexing it):
+
+  #include "icons.hpp"
+  static lv::Atlas icons(icons_sheet, icons_rects);
+  lv::Image::create(parent).src(icons["battery_icon"]);
+
+Icons are shelf-packed, tallest first. The sheet is ARGB8565 when every
+input is 16-bit (RGB565/RGB565A8), ARGB8888 otherwise; planar RGB565A8
+cannot be split into sub-images (see include/lv/core/atlas.hpp). Use
+--pad 1 for icons drawn rotated or scaled, so filtering does not bleed
+in neighbours.
+"""
+
+import argparse
+import math
+import os
+import re
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from image_codec_convert import parse_c_array, to_rgba  # noqa: E402
+
+
+def shelf_pack(sizes, width, pad):
+    """Return (x, y) per size and the sheet height, packing tallest first."""
+    order = sorted(range(len(sizes)), key=lambda i: (-sizes[i][1], -sizes[i][0]))
+    pos = [None] * len(sizes)
+    x = y = shelf_h = 0
+    for i in order:
+        w, h = sizes[i]
+        if x and x + w > width:
+            x, y = 0, y + shelf_h + pad
+            shelf_h = 0
+        pos[i] = (x, y)
+        x += w + pad
+        shelf_h = max(shelf_h, h)
+    return pos, y + shelf_h
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("inputs", nargs="+", help="generated LVGL image .c files")
+    ap.add_argument("-o", "--out", required=True, help="output path without extension")
+    ap.add_argument("--width", type=int, default=0, help="sheet width (default: about square)")
+    ap.add_argument("--pad", type=int, default=0, help="pixels between icons")
+    ap.add_argument("--strip-prefix", default="image_", help="removed from icon names")
+    args = ap.parse_args()
+
+    icons = []
+    for path in args.inputs:
+        try:
+            name, cf, w, h, stride, data = parse_c_array(path)
+        except (ValueError, AttributeError) as e:
+            print("skip %s: %s" % (path, e), file=sys.stderr)
+            continue
+        if name.startswith(args.strip_prefix):
+            name = name[len(args.strip_prefix):]
+        icons.append((name, cf, w, h, to_rgba(cf, w, h, stride, data)))
+    if not icons:
+        return 1
+
+    wide = any(cf not in ("RGB565", "RGB565A8") for _, cf, _, _, _ in icons)
+    bpp = 4 if wide else 3
+    sizes = [(w, h) for _, _, w, h, _ in icons]
+    area = sum((w + args.pad) * (h + args.pad) for w, h in sizes)
+    width = args.width or max(max(w for w, _ in sizes), int(math.sqrt(area) * 1.1))
+    pos, height = shelf_pack(sizes, width, args.pad)
+
+    stride = width * bpp
+    sheet = bytearray(stride * height)
+    for (name, _, w, h, rgba), (x0, y0) in zip(icons, pos):
+        for y in range(h):
+            for x in range(w):
+                r, g, b, a = rgba[y * w + x]
+                o = (y0 + y) * stride + (x0 + x) * bpp
+                if wide:
+                    sheet[o:o + 4] = bytes((b, g, r, a))
+                else:
+                    v = ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3)
+                    sheet[o:o + 3] = bytes((v & 0xFF, v >> 8, a))
+
+    base = os.path.basename(args.out)
+    ident = re.sub(r"\W", "_", base)
+    os.makedirs(os.path.dirname(args.out) or ".", exist_ok=True)
+    cf = "LV_COLOR_FORMAT_ARGB8888" if wide else "LV_COLOR_FORMAT_ARGB8565"
+    lines = ["#include \"lvgl.h\"", "",
+             "static const LV_ATTRIBUTE_MEM_ALIGN LV_ATTRIBUTE_LARGE_CONST uint8_t %s_sheet_map[] = {" % ident]
+    for i in range(0, len(sheet), 24):
+        lines.append("  " + ", ".join("0x%02x" % v for v in sheet[i:i + 24]) + ",")
+    lines += ["};", "",
+              "const lv_image_dsc_t %s_sheet = {" % ident,
+              "  .header.magic = LV_IMAGE_HEADER_MAGIC,",
+              "  .header.cf = %s," % cf,
+              "  .header.w = %d," % width,
+              "  .header.h = %d," % height,
+              "  .header.stride = %d," % stride,
+              "  .data_size = sizeof(%s_sheet_map)," % ident,
+              "  .data = %s_sheet_map," % ident,
+              "};", ""]
+    open(args.out + ".c", "w", encoding="utf-8").write("\n".join(lines))
+
+    hdr = ["#pragma once", "", "// Generated by scripts/atlas_pack.py", "",
+           "#include <lv/core/atlas.hpp>", "",
+           "extern \"C\" const lv_image_dsc_t %s_sheet;" % ident, "",
+           "inline constexpr lv::AtlasRect %s_rects[] = {" % ident]
+    for (name, _, w, h, _), (x, y) in zip(icons, pos):
+        hdr.append("    {\"%s\", %d, %d, %d, %d}," % (name, x, y, w, h))
+    hdr += ["};", "", "enum %s_id : int {" % ident]
+    hdr += ["    %s_%s," % (ident, re.sub(r"\W", "_", name)) for name, _, _, _, _ in icons]
+    hdr += ["};", ""]
+    open(args.out + ".hpp", "w", encoding="utf-8").write("\n".join(hdr))
+
+    used = sum(w * h for w, h in sizes)
+    print("%d icons -> %dx%d %s sheet, %d bytes, %.0f%% filled" %
+          (len(icons), width, height, cf.replace("LV_COLOR_FORMAT_", ""), len(sheet), 100.0 * used / (width * height)))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,30 @@
+#!/bin/bash
+# Render-thread scaling: build lv_bench with 1, 2 and 4 SW render threads
+# and print the render phase of each scenario side by side.
+#
+# Usage: scripts/bench_render_threads.sh [thread counts...]   (default: 1 2 4)
+
+set -e
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+PROJECT_ROOT="$(dirname "$SCRIPT_DIR")"
+THREADS=("$@")
+[ ${#THREADS[@]} -eq 0 ] && THREADS=(1 2 4)
+
+for n in "${THREADS[@]}"; do
+    build="$PROJECT_ROOT/build-bench-t$n"
+    echo "=== LV_RENDER_THREADS=$n ==="
+    cmake -S "$PROJECT_ROOT" -B "$build" -DCMAKE_BUILD_TYPE=Release \
+        -DLV_BUILD_BENCH=ON -DLV_BUILD_EXAMPLES=OFF -DLV_BUILD_DEMOS=OFF \
+        -DLV_RENDER_THREADS="$n" > /dev/null
+    cmake --build "$build" --target lv_bench -j"$(nproc)" > /dev/null
+    "$build/bench/lv_bench" --out "$build/results.json"
+done
+
+echo ""
+echo "render_us p50 per scenario:"
+for n in "${THREADS[@]}"; do
+    printf "  %2s threads: " "$n"
+    grep -o '"scenario":"[a-z_]*"\|"render_us":{"p50":[0-9]*' "$PROJECT_ROOT/build-bench-t$n/results.json" | \
+        sed 's/"scenario":"\(.*\)"/\1=/; s/"render_us":{"p50"://' | paste -sd' ' | sed 's/= /=/g'
+done
@@ -0,0 +1,81 @@
+#!/usr/bin/env python3
+"""Bundle LVGL binary fonts (lv_font_conv --format bin) into one lv::FontPack file.
+
+  lv_font_conv --font Inter.ttf -r 0x20-0x7F --bpp 4 --size 14 --format bin -o inter_14.bin
+  lv_font_conv --font Inter.ttf -r 0x20-0x7F --bpp 4 --size 28 --format bin -o inter_28.bin
+  scripts/font_pack.py inter_14.bin inter_28.bin inter_bold_14.bin@1 -o inter.fpk
+
+Each font is keyed by the pixel size in its head table and an optional
+style number (`path@style`, default 0), which FontPack::font(size, style)
+looks up:
+
+  static lv::FontPack inter("A:fonts/inter.fpk");
+  label.text_font(inter.font(14));
+
+Fonts are stored 4-byte aligned and unchanged, so their glyph bitmaps can
+be used from the mapped file (see include/lv/core/mapped_font.hpp).
+Build the fonts with --no-compress for fastest drawing; prefer bpp and
+sizes whose glyph headers come out byte aligned, otherwise the loader
+copies the bitmaps to the heap.
+"""
+
+import argparse
+import struct
+import sys
+
+MAGIC = b"LVFP"
+VERSION = 1
+HEAD = struct.Struct("<4sHH")
+ENTRY = struct.Struct("<HHII")
+
+
+def font_size(data, path):
+    """Pixel size from the head table of an lv_binfont."""
+    if len(data) < 16 or data[4:8] != b"head":
+        raise ValueError(f"{path}: not an LVGL binary font")
+    return struct.unpack_from("<H", data, 14)[0]
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("inputs", nargs="+", help="lv_binfont files, optionally suffixed with @style")
+    ap.add_argument("-o", "--out", required=True, help="output pack path")
+    args = ap.parse_args()
+
+    fonts = []
+    for arg in args.inputs:
+        path, _, style = arg.partition("@")
+        with open(path, "rb") as f:
+            data = f.read()
+        try:
+            size = font_size(data, path)
+        except ValueError as e:
+            sys.exit(str(e))
+        key = (size, int(style or 0))
+        if any(k == key for k, _ in fonts):
+            sys.exit(f"{path}: size {key[0]} style {key[1]} is already in the pack")
+        fonts.append((key, data))
+
+    offset = HEAD.size + ENTRY.size * len(fonts)
+    table, blobs = [], []
+    for (size, style), data in fonts:
+        offset = (offset + 3) & ~3
+        table.append(ENTRY.pack(size, style, offset, len(data)))
+        blobs.append((offset, data))
+        offset += len(data)
+
+    with open(args.out, "wb") as f:
+        f.write(HEAD.pack(MAGIC, VERSION, len(fonts)))
+        for entry in table:
+            f.write(entry)
+        for at, data in blobs:
+            f.write(b"\0" * (at - f.tell()))
+            f.write(data)
+
+    for (size, style), data in fonts:
+        print(f"  {size:3d} px  style {style}  {len(data):8d} bytes")
+    print(f"{args.out}: {len(fonts)} fonts, {offset} bytes")
+
+
+if __name__ == "__main__":
+    main()
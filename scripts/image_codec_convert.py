@@ -0,0 +1,264 @@
+#!/usr/bin/env python3
+"""Convert generated LVGL image C arrays into QOI or banded-LZ4 (.lz4i) assets.
+
+Input is an LVGL image converter C file (e.g. demos/smartwatch/generated/
+image_*.c) with an lv_image_dsc_t in RGB565, RGB565A8, RGB888, ARGB8888 or
+XRGB8888. Output is a file for lv::QoiDecoder / lv::Lz4ImageDecoder
+(include/lv/draw/image_codecs.hpp), or with --c-array a C file embedding it
+as an LV_COLOR_FORMAT_RAW(_ALPHA) lv_image_dsc_t.
+
+  scripts/image_codec_convert.py --format qoi  demos/smartwatch/generated/image_*.c -o out/
+  scripts/image_codec_convert.py --format lz4 --band-rows 16 bg.c -o out/ --c-array
+
+QOI output is RGBA/RGB; .lz4i keeps the source color format (RGB565A8 is
+interleaved to ARGB8565, as bands cannot carry a separate alpha plane).
+Uses the `lz4` module when installed, otherwise a built-in compressor.
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+CF = {
+    "RGB565": 0x12,
+    "ARGB8565": 0x13,
+    "RGB565A8": 0x14,
+    "RGB888": 0x0F,
+    "ARGB8888": 0x10,
+    "XRGB8888": 0x11,
+}
+BPP = {"RGB565": 2, "ARGB8565": 3, "RGB888": 3, "ARGB8888": 4, "XRGB8888": 4}
+LV_IMAGE_HEADER_MAGIC = 0x19
+LV_COLOR_FORMAT_RAW = 0x01
+LV_COLOR_FORMAT_RAW_ALPHA = 0x02
+
+
+# ==================== Input ====================
+
+def parse_c_array(path):
+    text = open(path, encoding="utf-8").read()
+    body = re.search(r"_(?:map|data)\[\]\s*=\s*\{(.*?)\};", text, re.S)
+    if not body:
+        raise ValueError("no pixel array")
+    data = bytes(int(v, 16) for v in re.findall(r"0x([0-9a-fA-F]{2})", body.group(1)))
+
+    def field(name, default=None):
+        m = re.search(r"\.header\.%s\s*=\s*([^,\n]+)" % name, text)
+        if not m:
+            if default is None:
+                raise ValueError("missing header.%s" % name)
+            return default
+        return m.group(1).strip()
+
+    cf = field("cf").replace("LV_COLOR_FORMAT_", "")
+    if cf not in CF:
+        raise ValueError("unsupported color format %s" % cf)
+    w = int(field("w"), 0)
+    h = int(field("h"), 0)
+    stride = int(field("stride", "0"), 0)
+    name = re.search(r"lv_image_dsc_t\s+(\w+)\s*=", text).group(1)
+    return name, cf, w, h, stride, data
+
+
+def to_rgba(cf, w, h, stride, data):
+    """Pixels as RGBA tuples, row-major."""
+    out = []
+    if cf in ("RGB565", "RGB565A8"):
+        stride = stride or w * 2
+        alpha = data[stride * h:] if cf == "RGB565A8" else None
+        for y in range(h):
+            for x in range(w):
+                v = data[y * stride + 2 * x] | (data[y * stride + 2 * x + 1] << 8)
+                r, g, b = (v >> 11) & 0x1F, (v >> 5) & 0x3F, v & 0x1F
+                a = alpha[y * (stride // 2) + x] if alpha else 255
+                out.append(((r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2), a))
+    else:
+        bpp = BPP[cf]
+        stride = stride or w * bpp
+        for y in range(h):
+            for x in range(w):
+                p = data[y * stride + bpp * x:y * stride + bpp * x + bpp]
+                a = p[3] if cf == "ARGB8888" else 255
+                out.append((p[2], p[1], p[0], a))
+    return out
+
+
+# ==================== QOI ====================
+
+def encode_qoi(w, h, pixels, channels):
+    out = bytearray(b"qoif" + struct.pack(">IIBB", w, h, channels, 0))
+    index = [(0, 0, 0, 0)] * 64
+    prev = (0, 0, 0, 255)
+    run = 0
+    for i, px in enumerate(pixels):
+        if px == prev:
+            run += 1
+            if run == 62 or i == len(pixels) - 1:
+                out.append(0xC0 | (run - 1))
+                run = 0
+            continue
+        if run:
+            out.append(0xC0 | (run - 1))
+            run = 0
+        r, g, b, a = px
+        h_ = (r * 3 + g * 5 + b * 7 + a * 11) % 64
+        if index[h_] == px:
+            out.append(h_)
+        else:
+            index[h_] = px
+            if a == prev[3]:
+                dr = (r - prev[0] + 128) % 256 - 128
+                dg = (g - prev[1] + 128) % 256 - 128
+                db = (b - prev[2] + 128) % 256 - 128
+                dr_dg, db_dg = dr - dg, db - dg
+                if -2 <= dr <= 1 and -2 <= dg <= 1 and -2 <= db <= 1:
+                    out.append(0x40 | ((dr + 2) << 4) | ((dg + 2) << 2) | (db + 2))
+                elif -32 <= dg <= 31 and -8 <= dr_dg <= 7 and -8 <= db_dg <= 7:
+                    out += bytes((0x80 | (dg + 32), ((dr_dg + 8) << 4) | (db_dg + 8)))
+                else:
+                    out += bytes((0xFE, r, g, b))
+            else:
+                out += bytes((0xFF, r, g, b, a))
+        prev = px
+    out += b"\x00" * 7 + b"\x01"
+    return bytes(out)
+
+
+# ==================== LZ4 ====================
+
+def lz4_compress_block(src):
+    try:
+        import lz4.block
+        return lz4.block.compress(src, store_size=False)
+    except ImportError:
+        pass
+    # Greedy single-probe hash matcher; valid LZ4 block format, ~zlib -1 ratio
+    out = bytearray()
+    table = {}
+    n = len(src)
+    anchor = i = 0
+    limit = n - 12   # LZ4: the last match must start 12 bytes before the end
+
+    def emit(lit_end, match_len, offset):
+        lit = lit_end - anchor
+        token = (min(lit, 15) << 4) | (min(match_len - 4, 15) if match_len else 0)
+        out.append(token)
+        if lit >= 15:
+            rest = lit - 15
+            while rest >= 255:
+                out.append(255)
+                rest -= 255
+            out.append(rest)
+        out.extend(src[anchor:lit_end])
+        if match_len:
+            out.extend(struct.pack("<H", offset))
+            if match_len - 4 >= 15:
+                rest = match_len - 4 - 15
+                while rest >= 255:
+                    out.append(255)
+                    rest -= 255
+                out.append(rest)
+
+    while i < limit:
+        key = src[i:i + 4]
+        cand = table.get(key)
+        table[key] = i
+        if cand is not None and i - cand <= 0xFFFF:
+            m = 4
+            while i + m < n - 5 and src[cand + m] == src[i + m]:
+                m += 1
+            emit(i, m, i - cand)
+            i += m
+            anchor = i
+        else:
+            i += 1
+    emit(n, 0, 0)
+    return bytes(out)
+
+
+def to_argb8565(w, h, stride, data):
+    stride = stride or w * 2
+    alpha = data[stride * h:]
+    out = bytearray()
+    for y in range(h):
+        for x in range(w):
+            out += data[y * stride + 2 * x:y * stride + 2 * x + 2]
+            out.append(alpha[y * (stride // 2) + x])
+    return bytes(out)
+
+
+def encode_lz4i(cf, w, h, stride, data, band_rows):
+    if cf == "RGB565A8":
+        data, cf, stride = to_argb8565(w, h, stride, data), "ARGB8565", w * 3
+    stride = stride or w * BPP[cf]
+    out = bytearray(b"LZ4I" + struct.pack("<BBH", 1, 0, band_rows))
+    out += struct.pack("<BBHHHHH", LV_IMAGE_HEADER_MAGIC, CF[cf], 0, w, h, stride, 0)
+    for y in range(0, h, band_rows):
+        rows = min(band_rows, h - y)
+        block = lz4_compress_block(data[y * stride:(y + rows) * stride])
+        out += struct.pack("<I", len(block)) + block
+    return bytes(out), cf
+
+
+# ==================== Output ====================
+
+def write_c_array(path, name, payload, w, h, cf_raw):
+    lines = ["#include \"lvgl.h\"", "",
+             "static const LV_ATTRIBUTE_LARGE_CONST uint8_t %s_map[] = {" % name]
+    for i in range(0, len(payload), 16):
+        lines.append("  " + ", ".join("0x%02x" % b for b in payload[i:i + 16]) + ",")
+    lines += ["};", "",
+              "const lv_image_dsc_t %s = {" % name,
+              "  .header.magic = LV_IMAGE_HEADER_MAGIC,",
+              "  .header.cf = %s," % cf_raw,
+              "  .header.w = %d," % w,
+              "  .header.h = %d," % h,
+              "  .data_size = sizeof(%s_map)," % name,
+              "  .data = %s_map," % name,
+              "};", ""]
+    open(path, "w", encoding="utf-8").write("\n".join(lines))
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("inputs", nargs="+", help="generated LVGL image .c files")
+    ap.add_argument("--format", choices=("qoi", "lz4"), required=True)
+    ap.add_argument("--band-rows", type=int, default=16, help="rows per LZ4 band (default 16)")
+    ap.add_argument("--c-array", action="store_true", help="emit a C array instead of a binary file")
+    ap.add_argument("-o", "--out", default=".", help="output directory")
+    args = ap.parse_args()
+    if not 1 <= args.band_rows <= 0xFFFF:
+        ap.error("--band-rows must be 1..65535")
+    os.makedirs(args.out, exist_ok=True)
+
+    failed = 0
+    for src in args.inputs:
+        try:
+            name, cf, w, h, stride, data = parse_c_array(src)
+        except (ValueError, AttributeError) as e:
+            print("skip %s: %s" % (src, e), file=sys.stderr)
+            failed += 1
+            continue
+        has_alpha = cf in ("RGB565A8", "ARGB8888")
+        if args.format == "qoi":
+            pixels = to_rgba(cf, w, h, stride, data)
+            payload = encode_qoi(w, h, pixels, 4 if has_alpha else 3)
+            ext, out_cf = "qoi", "RGBA" if has_alpha else "RGB"
+        else:
+            payload, out_cf = encode_lz4i(cf, w, h, stride, data, args.band_rows)
+            ext = "lz4i"
+        base = os.path.join(args.out, name)
+        if args.c_array:
+            raw = "LV_COLOR_FORMAT_RAW_ALPHA" if has_alpha else "LV_COLOR_FORMAT_RAW"
+            write_c_array(base + "_%s.c" % ext, name + "_" + ext, payload, w, h, raw)
+        else:
+            open(base + "." + ext, "wb").write(payload)
+        print("%s: %dx%d %s -> %s %s, %d bytes (%.0f%% of raw)" %
+              (name, w, h, cf, ext, out_cf, len(payload), 100.0 * len(payload) / max(len(data), 1)))
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
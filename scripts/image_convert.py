@@ -0,0 +1,174 @@
+#!/usr/bin/env python3
+"""Convert images to the display's color format at build time, as C arrays.
+
+  scripts/image_convert.py --format RGB565 --lv-conf lv_conf.h \\
+      demos/analog_clock/generated/images/ui_img_*.c -o build/assets/
+
+Inputs are generated LVGL image C files (lv_image_dsc_t in RGB565,
+RGB565A8, RGB888, ARGB8888 or XRGB8888) or PNG/JPEG files (needs Pillow).
+Each is written to <out>/<input name>.c and defines an lv_image_dsc_t with
+the same name, so it replaces the input in a build without code changes.
+CMake's lv_add_assets() (cmake/LvAssets.cmake) runs this per file.
+
+--format is the display format. An opaque image is stored in it as is
+(RGB565, RGB888 or XRGB8888), so LVGL blits it with memcpy. An image with
+transparent pixels gets the matching alpha format instead (RGB565 ->
+RGB565A8, RGB888/XRGB8888 -> ARGB8888), unless the format already has
+alpha. --keep-alpha keeps the alpha format even for opaque images.
+--premultiply stores the colors premultiplied by alpha and sets
+LV_IMAGE_FLAGS_PREMULTIPLIED.
+
+Rows are padded to --stride-align bytes. By default the value is read
+from LV_DRAW_BUF_STRIDE_ALIGN in --lv-conf, or 1 without one. C files in
+other formats (indexed, alpha-only, compressed) are copied unchanged.
+"""
+
+import argparse
+import os
+import re
+import shutil
+import struct
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from image_codec_convert import BPP, parse_c_array, to_rgba  # noqa: E402
+
+FORMATS = ("RGB565", "RGB565A8", "RGB888", "XRGB8888", "ARGB8888")
+WITH_ALPHA = {"RGB565": "RGB565A8", "RGB888": "ARGB8888", "XRGB8888": "ARGB8888"}
+WITHOUT_ALPHA = {"RGB565A8": "RGB565", "ARGB8888": "XRGB8888"}
+
+
+def stride_align_from(lv_conf):
+    text = open(lv_conf, encoding="utf-8").read()
+    m = re.search(r"^\s*#\s*define\s+LV_DRAW_BUF_STRIDE_ALIGN\s+(\d+)", text, re.M)
+    return int(m.group(1)) if m else 1
+
+
+def round_up(v, align):
+    return (v + align - 1) // align * align
+
+
+def pick_format(target, rgba, keep_alpha):
+    opaque = all(p[3] == 255 for p in rgba)
+    if not opaque and target in WITH_ALPHA:
+        return WITH_ALPHA[target]
+    if opaque and not keep_alpha and target in WITHOUT_ALPHA:
+        return WITHOUT_ALPHA[target]
+    return target
+
+
+def premultiplied(rgba):
+    return [((r * a + 127) // 255, (g * a + 127) // 255, (b * a + 127) // 255, a) for r, g, b, a in rgba]
+
+
+def encode(rgba, cf, w, h, align):
+    """Pixel bytes of `cf` with rows padded to `align`; returns (data, stride)."""
+    if cf in ("RGB565", "RGB565A8"):
+        # The A8 plane of RGB565A8 uses stride / 2, so keep both planes aligned
+        stride = round_up(w * 2, align * 2 if cf == "RGB565A8" else align)
+    else:
+        stride = round_up(w * BPP[cf], align)
+    out = bytearray()
+    for y in range(h):
+        row = bytearray()
+        for r, g, b, a in rgba[y * w:(y + 1) * w]:
+            if cf in ("RGB565", "RGB565A8"):
+                row += struct.pack("<H", ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3))
+            elif cf == "RGB888":
+                row += bytes((b, g, r))
+            elif cf == "XRGB8888":
+                row += bytes((b, g, r, 0xFF))
+            else:
+                row += bytes((b, g, r, a))
+        out += row + bytes(stride - len(row))
+    if cf == "RGB565A8":
+        for y in range(h):
+            row = bytes(p[3] for p in rgba[y * w:(y + 1) * w])
+            out += row + bytes(stride // 2 - len(row))
+    return bytes(out), stride
+
+
+def load_png(path):
+    try:
+        from PIL import Image
+    except ImportError:
+        raise ValueError("PNG and JPEG inputs need Pillow (pip install pillow)")
+    img = Image.open(path).convert("RGBA")
+    w, h = img.size
+    name = re.sub(r"\W", "_", os.path.splitext(os.path.basename(path))[0])
+    return name, w, h, list(img.getdata())
+
+
+def write_c(path, name, cf, flags, w, h, stride, data):
+    lines = ["#include \"lvgl.h\"", "",
+             "#ifndef LV_ATTRIBUTE_MEM_ALIGN",
+             "#define LV_ATTRIBUTE_MEM_ALIGN",
+             "#endif", "",
+             "#ifndef LV_ATTRIBUTE_LARGE_CONST",
+             "#define LV_ATTRIBUTE_LARGE_CONST",
+             "#endif", "",
+             "static const LV_ATTRIBUTE_MEM_ALIGN LV_ATTRIBUTE_LARGE_CONST uint8_t %s_map[] = {" % name]
+    for i in range(0, len(data), 16):
+        lines.append("    " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+    lines += ["};", "",
+              "const lv_image_dsc_t %s = {" % name,
+              "    .header.magic = LV_IMAGE_HEADER_MAGIC,",
+              "    .header.cf = LV_COLOR_FORMAT_%s," % cf,
+              "    .header.flags = %s," % flags,
+              "    .header.w = %d," % w,
+              "    .header.h = %d," % h,
+              "    .header.stride = %d," % stride,
+              "    .data_size = sizeof(%s_map)," % name,
+              "    .data = %s_map," % name,
+              "};", ""]
+    open(path, "w", encoding="utf-8").write("\n".join(lines))
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("inputs", nargs="+", help="generated LVGL image .c files or PNG/JPEG files")
+    ap.add_argument("--format", choices=FORMATS, required=True, help="display color format")
+    ap.add_argument("--premultiply", action="store_true", help="premultiply colors by alpha")
+    ap.add_argument("--keep-alpha", action="store_true", help="keep an alpha format for opaque images")
+    ap.add_argument("--stride-align", type=int, help="row alignment in bytes (LV_DRAW_BUF_STRIDE_ALIGN)")
+    ap.add_argument("--lv-conf", help="lv_conf.h to read LV_DRAW_BUF_STRIDE_ALIGN from")
+    ap.add_argument("-o", "--out", default=".", help="output directory")
+    args = ap.parse_args()
+    align = args.stride_align or (stride_align_from(args.lv_conf) if args.lv_conf else 1)
+    if align < 1:
+        ap.error("--stride-align must be at least 1")
+    os.makedirs(args.out, exist_ok=True)
+
+    failed = 0
+    for src in args.inputs:
+        out = os.path.join(args.out, os.path.splitext(os.path.basename(src))[0] + ".c")
+        try:
+            if src.lower().endswith(".c"):
+                try:
+                    name, cf, w, h, stride, data = parse_c_array(src)
+                except (ValueError, AttributeError) as e:
+                    shutil.copyfile(src, out)
+                    print("%s: copied (%s)" % (os.path.basename(src), e))
+                    continue
+                rgba = to_rgba(cf, w, h, stride, data)
+            else:
+                name, w, h, rgba = load_png(src)
+                cf = "PNG"
+        except (OSError, ValueError) as e:
+            print("error %s: %s" % (src, e), file=sys.stderr)
+            failed += 1
+            continue
+        out_cf = pick_format(args.format, rgba, args.keep_alpha)
+        flags = "0"
+        if args.premultiply and out_cf in ("RGB565A8", "ARGB8888"):
+            rgba = premultiplied(rgba)
+            flags = "LV_IMAGE_FLAGS_PREMULTIPLIED"
+        data_out, stride_out = encode(rgba, out_cf, w, h, align)
+        write_c(out, name, out_cf, flags, w, h, stride_out, data_out)
+        print("%s: %dx%d %s -> %s%s, stride %d" %
+              (name, w, h, cf, out_cf, " premultiplied" if flags != "0" else "", stride_out))
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,124 @@
+#!/usr/bin/env python3
+"""Compile JSON keyframe sequences into constexpr lv::Keyframes (a C++ header).
+
+  scripts/keyframes.py ui/arc_intro.json -o src/arc_intro_keys.hpp --namespace anims
+
+The JSON holds one sequence or a list of them:
+
+  {"name": "arc_intro",
+   "tracks": [
+     {"target": 0, "prop": "arc_value",
+      "keys": [[0, 0], [400, 75, "ease_out"], [900, 60, "ease_in_out"]]},
+     {"target": 1, "prop": "opa", "keys": [[0, 0], [200, 255]]}
+   ]}
+
+Each key is [time_ms, value] or [time_ms, value, ease]; the ease shapes the
+segment arriving at that key (default linear). Keys are sorted by time and
+must not repeat a time. Each sequence becomes an lv::Keyframes `name`:
+
+  #include "arc_intro_keys.hpp"
+  static lv::KeyframePlayer intro(anims::arc_intro);
+  intro.bind(0, arc).bind(1, label).play();
+"""
+
+import argparse
+import json
+import re
+import sys
+
+PROPS = ["translate_x", "translate_y", "opa", "scale", "rotation", "x", "y",
+         "width", "height", "arc_value", "arc_end_angle"]
+EASES = ["linear", "ease_in", "ease_out", "ease_in_out", "overshoot", "bounce", "step"]
+
+
+def fail(where, msg):
+    sys.exit(f"{where}: {msg}")
+
+
+def compile_sequence(seq, where):
+    name = seq.get("name")
+    if not isinstance(name, str) or not re.fullmatch(r"[A-Za-z_]\w*", name):
+        fail(where, f"sequence name {name!r} is not a C++ identifier")
+    tracks = seq.get("tracks")
+    if not isinstance(tracks, list) or not tracks:
+        fail(name, "no tracks")
+
+    out = []
+    entries = []
+    duration = 0
+    for t, track in enumerate(tracks):
+        here = f"{name}.tracks[{t}]"
+        prop = track.get("prop")
+        if prop not in PROPS:
+            fail(here, f"unknown prop {prop!r} (one of {', '.join(PROPS)})")
+        target = track.get("target", 0)
+        if not isinstance(target, int) or not 0 <= target < 256:
+            fail(here, f"target {target!r} is not a slot number")
+        keys = []
+        for k in track.get("keys", []):
+            if not isinstance(k, list) or len(k) not in (2, 3):
+                fail(here, f"key {k!r} is not [time, value] or [time, value, ease]")
+            ease = k[2] if len(k) == 3 else "linear"
+            if ease not in EASES:
+                fail(here, f"unknown ease {ease!r} (one of {', '.join(EASES)})")
+            keys.append((int(k[0]), int(k[1]), ease))
+        if not keys:
+            fail(here, "no keys")
+        keys.sort(key=lambda k: k[0])
+        for a, b in zip(keys, keys[1:]):
+            if a[0] == b[0]:
+                fail(here, f"two keys at {a[0]} ms")
+
+        duration = max(duration, keys[-1][0])
+        symbol = f"{name}_t{t}"
+        body = ", ".join(f"{{{tm}, {v}, lv::Ease::{e}}}" for tm, v, e in keys)
+        out.append(f"inline constexpr lv::Keyframe {symbol}[] = {{{body}}};")
+        entries.append(f"    {{{target}, lv::AnimProp::{prop}, {symbol}}},")
+
+    out.append(f"inline constexpr lv::KeyTrack {name}_tracks[] = {{")
+    out.extend(entries)
+    out.append("};")
+    out.append(f"inline constexpr lv::Keyframes {name}{{{name}_tracks}};")
+    out.append(f"static_assert({name}.valid(), \"{name}: raise LV_CPP_KEYFRAME_TRACKS or LV_CPP_KEYFRAME_TARGETS\");")
+    out.append("")
+    return name, len(tracks), duration, out
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("inputs", nargs="+", help="JSON files with one sequence or a list of sequences")
+    ap.add_argument("-o", "--out", required=True, help="output header")
+    ap.add_argument("--namespace", default="keyframes", help="C++ namespace of the sequences (default: keyframes)")
+    args = ap.parse_args()
+
+    out = [
+        "// Generated by scripts/keyframes.py; do not edit.",
+        "#pragma once",
+        "",
+        "#include <lv/core/keyframes.hpp>",
+        "",
+        f"namespace {args.namespace} {{",
+        "",
+    ]
+    summary = []
+    for path in args.inputs:
+        with open(path, encoding="utf-8") as f:
+            try:
+                data = json.load(f)
+            except json.JSONDecodeError as e:
+                fail(path, str(e))
+        for seq in data if isinstance(data, list) else [data]:
+            name, tracks, duration, lines = compile_sequence(seq, path)
+            out.extend(lines)
+            summary.append(f"  {name}: {tracks} tracks, {duration} ms")
+    out.append(f"}} // namespace {args.namespace}")
+    out.append("")
+
+    with open(args.out, "w") as f:
+        f.write("\n".join(out))
+    print("\n".join(summary))
+    print(f"{args.out}: {len(summary)} sequences")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,153 @@
+#!/usr/bin/env python3
+"""Compile a Pinyin dictionary into one lv::PinyinTrie file.
+
+  scripts/pinyin_dict.py pinyin.txt -o pinyin.lpy
+  scripts/pinyin_dict.py pinyin.txt --top 24 -o pinyin.lpy
+
+Each input line is a syllable followed by its characters, either one
+character with a frequency or several characters, most frequent first:
+
+  zhong 中 9820
+  zhong 种 2210
+  zhang 张长章彰     # ranked by position
+
+Lines starting with # are ignored; frequencies of repeated (syllable,
+character) pairs add up. On the device:
+
+  #include <lv/widgets/pinyin_trie.hpp>
+
+  static lv::PinyinTrie dict("A:ime/pinyin.lpy");
+  dict.attach(ime);
+
+The file is a trie over the syllable letters: a node table in
+breadth-first order (children of a node are contiguous and sorted) and a
+string pool. Every node points at a NUL-terminated candidate string in the
+pool: a complete syllable at its own characters by frequency, a prefix at
+the --top most frequent characters below it. Identical strings are stored
+once. See include/lv/widgets/pinyin_trie.hpp.
+"""
+
+import argparse
+import struct
+import sys
+
+MAGIC = b"LVPY"
+VERSION = 1
+HEAD = struct.Struct("<4sHHIII")
+NODE = struct.Struct("<IIBBH")
+MAX_INPUT = 15   # LVGL's input_char[16]
+
+
+def load(paths):
+    """{syllable: {char: frequency}} of the dictionary files."""
+    words = {}
+    for path in paths:
+        with open(path, encoding="utf-8") as f:
+            for n, line in enumerate(f, 1):
+                line = line.split("#", 1)[0].strip()
+                if not line:
+                    continue
+                parts = line.split()
+                py = parts[0].lower()
+                if not py.isascii() or not py.isalpha() or len(py) > MAX_INPUT:
+                    raise ValueError(f"{path}:{n}: '{parts[0]}' is not a syllable of up to {MAX_INPUT} letters")
+                if len(parts) == 3 and parts[2].isdigit():
+                    ranked = [(parts[1], int(parts[2]))]
+                elif len(parts) >= 2:
+                    chars = "".join(parts[1:])
+                    ranked = [(c, len(chars) - i) for i, c in enumerate(chars)]
+                else:
+                    raise ValueError(f"{path}:{n}: no characters for '{py}'")
+                for ch, freq in ranked:
+                    if len(ch) != 1 or len(ch.encode("utf-8")) != 3:
+                        raise ValueError(f"{path}:{n}: '{ch}' is not one 3-byte UTF-8 character "
+                                         "(the LVGL candidate panel needs those)")
+                    table = words.setdefault(py, {})
+                    table[ch] = table.get(ch, 0) + freq
+    if not words:
+        raise ValueError("no syllables found")
+    return words
+
+
+def ranked(freqs):
+    return [c for c, _ in sorted(freqs.items(), key=lambda kv: -kv[1])]
+
+
+def compile_dict(words, top):
+    """File bytes, node count and pool size of a {syllable: {char: frequency}} dictionary."""
+    root = {}
+    for py in words:
+        node = root
+        for ch in py:
+            node = node.setdefault(ch, {})
+        node[""] = py   # terminal marker
+
+    def below(node, prefix, acc):
+        if "" in node:
+            for ch, freq in words[node[""]].items():
+                acc[ch] = max(acc.get(ch, 0), freq)
+        for label, child in node.items():
+            if label:
+                below(child, prefix + label, acc)
+        return acc
+
+    pool = bytearray(b"\0")   # offset 0: no candidates
+    offsets = {"": 0}
+
+    def intern(s):
+        if s not in offsets:
+            offsets[s] = len(pool)
+            pool.extend(s.encode("utf-8") + b"\0")
+        return offsets[s]
+
+    # Breadth-first: children of each node end up contiguous
+    order = [("", root)]
+    index = 0
+    records = []
+    while index < len(order):
+        prefix, node = order[index]
+        index += 1
+        labels = sorted(k for k in node if k)
+        if "" in node:
+            cands = "".join(ranked(words[node[""]]))
+        else:
+            cands = "".join(ranked(below(node, prefix, {}))[:top])
+        first = len(order)
+        for label in labels:
+            order.append((prefix + label, node[label]))
+        records.append((first if labels else 0, intern(cands), len(labels),
+                        ord(prefix[-1]) if prefix else 0, len(cands)))
+    while len(pool) % 4:
+        pool.append(0)
+
+    data = b"".join((
+        HEAD.pack(MAGIC, VERSION, top, len(records), len(pool), 0),
+        b"".join(NODE.pack(*r) for r in records),
+        bytes(pool),
+    ))
+    return data, len(records), len(pool)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("inputs", nargs="+", help="dictionary text files")
+    ap.add_argument("-o", "--out", required=True, help="output dictionary path")
+    ap.add_argument("--top", type=int, default=32, help="candidates kept for a syllable prefix (default 32)")
+    args = ap.parse_args()
+    if not 1 <= args.top <= 0xFFFF:
+        sys.exit("--top must be between 1 and 65535")
+
+    try:
+        words = load(args.inputs)
+        data, nodes, pool = compile_dict(words, args.top)
+    except (OSError, ValueError) as e:
+        sys.exit(str(e))
+
+    with open(args.out, "wb") as f:
+        f.write(data)
+
+    print(f"{args.out}: {len(words)} syllables, {nodes} nodes, {pool} pool bytes, {len(data)} bytes")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,105 @@
+#!/usr/bin/env python3
+"""Embed asset files as an lv::fs::RomFs table (a C++ header).
+
+  scripts/romfs.py assets/ -o src/assets_romfs.hpp --namespace assets
+
+Every file under the given directories (or each file given directly) becomes
+a 4-byte aligned constexpr array; `files` lists them sorted by path, relative
+to the directory they were found in:
+
+  #include "assets_romfs.hpp"
+  lv::fs::RomFs::mount('R', assets::files);
+  lottie.src_file("R:/anim/loader.json");
+
+The arrays are const, so the linker keeps them in flash. Paths use '/' and
+have no leading '/'. Hidden files are skipped.
+"""
+
+import argparse
+import json
+import os
+import re
+import sys
+
+
+def collect(inputs):
+    """(path in the table, file system path) for every input file."""
+    files = {}
+    for arg in inputs:
+        if os.path.isdir(arg):
+            for root, dirs, names in os.walk(arg):
+                dirs[:] = sorted(d for d in dirs if not d.startswith("."))
+                for name in names:
+                    if name.startswith("."):
+                        continue
+                    full = os.path.join(root, name)
+                    files[os.path.relpath(full, arg).replace(os.sep, "/")] = full
+        elif os.path.isfile(arg):
+            files[os.path.basename(arg)] = arg
+        else:
+            sys.exit(f"{arg}: no such file or directory")
+    return sorted(files.items(), key=lambda kv: kv[0].encode())
+
+
+def c_bytes(data, indent="    "):
+    lines = []
+    for i in range(0, len(data), 16):
+        lines.append(indent + ", ".join(f"0x{b:02x}" for b in data[i:i + 16]) + ",")
+    return "\n".join(lines) if lines else indent + "0x00,"
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("inputs", nargs="+", help="directories or files to embed")
+    ap.add_argument("-o", "--out", required=True, help="output header")
+    ap.add_argument("--namespace", default="romfs", help="C++ namespace of the table (default: romfs)")
+    ap.add_argument("--name", default="files", help="name of the RomEntry array (default: files)")
+    args = ap.parse_args()
+
+    files = collect(args.inputs)
+    if not files:
+        sys.exit("no files to embed")
+
+    out = [
+        "// Generated by scripts/romfs.py; do not edit.",
+        "#pragma once",
+        "",
+        "#include <cstdint>",
+        "#include <lv/core/romfs.hpp>",
+        "",
+        f"namespace {args.namespace} {{",
+        "",
+        "namespace data {",
+    ]
+    total = 0
+    for i, (path, full) in enumerate(files):
+        with open(full, "rb") as f:
+            data = f.read()
+        total += len(data)
+        symbol = re.sub(r"\W", "_", path)
+        out.append(f"// {path}")
+        out.append(f"alignas(4) inline constexpr uint8_t f{i}_{symbol}[] = {{")
+        out.append(c_bytes(data))
+        out.append("};")
+    out.append("} // namespace data")
+    out.append("")
+    out.append(f"inline constexpr lv::fs::RomEntry {args.name}[] = {{")
+    for i, (path, full) in enumerate(files):
+        symbol = re.sub(r"\W", "_", path)
+        size = os.path.getsize(full)
+        out.append(f"    {{{json.dumps(path, ensure_ascii=False)}, data::f{i}_{symbol}, {size}}},")
+    out.append("};")
+    out.append("")
+    out.append(f"}} // namespace {args.namespace}")
+    out.append("")
+
+    with open(args.out, "w") as f:
+        f.write("\n".join(out))
+
+    for path, full in files:
+        print(f"  {os.path.getsize(full):8d}  {path}")
+    print(f"{args.out}: {len(files)} files, {total} bytes")
+
+
+if __name__ == "__main__":
+    main()
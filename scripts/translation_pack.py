@@ -0,0 +1,196 @@
+#!/usr/bin/env python3
+"""Compile lv_i18n style YAML translations into one lv::translation::BinaryPack file.
+
+  scripts/translation_pack.py demos/ebike/translations/{en,zh,ar}.yml -o ebike.ltp
+
+Each YAML file holds one language, as lv_i18n writes them:
+
+  de:
+    Battery: Akku
+    March %d: ~          # untranslated: shown as the tag
+
+The first file's keys come first; keys that only appear in later files are
+added behind them. On the device:
+
+  static lv::translation::BinaryPack texts("A:lang/ebike.ltp");
+  texts.use();
+  label.text(lv::tr("Battery"));
+
+The pack is a string table, offset tables and a minimal perfect hash of
+the tags (hash and displace), used from the mapped file without copying
+(see include/lv/core/translation_pack.hpp).
+"""
+
+import argparse
+import struct
+import sys
+
+MAGIC = b"LVTP"
+VERSION = 1
+HEAD = struct.Struct("<4sHHIII")
+MISSING = 0xFFFFFFFF
+MASK = 0xFFFFFFFF
+
+
+def tag_hash(data, seed):
+    """Same as lv::translation::detail::hash()."""
+    h = 0x811C9DC5 ^ ((seed * 0x9E3779B9) & MASK)
+    for b in data:
+        h = ((h ^ b) * 0x01000193) & MASK
+    h ^= h >> 16
+    h = (h * 0x85EBCA6B) & MASK
+    h ^= h >> 13
+    return h
+
+
+def unquote(s):
+    s = s.strip()
+    if len(s) >= 2 and s[0] == s[-1] and s[0] in "'\"":
+        body = s[1:-1]
+        return body.replace("''", "'") if s[0] == "'" else bytes(body, "utf-8").decode("unicode_escape")
+    return s
+
+
+def load_yaml(path):
+    """Language code and {key: text or None} of an lv_i18n YAML file."""
+    try:
+        import yaml
+    except ImportError:
+        yaml = None
+    with open(path, encoding="utf-8") as f:
+        text = f.read()
+    if yaml:
+        doc = yaml.safe_load(text)
+        if not isinstance(doc, dict) or len(doc) != 1:
+            raise ValueError(f"{path}: expected one language at the top level")
+        lang, entries = next(iter(doc.items()))
+        return str(lang), {str(k): (None if v is None else str(v)) for k, v in (entries or {}).items()}
+
+    # Minimal reader for the flat layout lv_i18n writes
+    lang, entries = None, {}
+    for line in text.splitlines():
+        if not line.strip() or line.lstrip().startswith("#"):
+            continue
+        if not line.startswith((" ", "\t")):
+            lang = unquote(line.rstrip().rstrip(":"))
+            continue
+        key, sep, value = line.strip().partition(": ")
+        if not sep:
+            key, value = line.strip().rstrip(":"), "~"
+        value = value.strip()
+        entries[unquote(key)] = None if value in ("~", "null", "") else unquote(value)
+    if lang is None:
+        raise ValueError(f"{path}: no language key")
+    return lang, entries
+
+
+def perfect_hash(keys):
+    """Displacements and slot order: slot = d < 0 ? -d - 1 : hash(key, d) % n, d = disp[hash(key, 0) % n]."""
+    n = len(keys)
+    buckets = [[] for _ in range(n)]
+    for k in keys:
+        buckets[tag_hash(k, 0) % n].append(k)
+    disp = [0] * n
+    slots = [None] * n
+    order = sorted(range(n), key=lambda b: -len(buckets[b]))
+    for b in order:
+        bucket = buckets[b]
+        if len(bucket) <= 1:
+            break
+        d = 1
+        while True:
+            used = [tag_hash(k, d) % n for k in bucket]
+            if len(set(used)) == len(used) and all(slots[s] is None for s in used):
+                break
+            d += 1
+        disp[b] = d
+        for k, s in zip(bucket, used):
+            slots[s] = k
+    free = iter(i for i in range(n) if slots[i] is None)
+    for b in order:
+        if len(buckets[b]) != 1:
+            continue
+        s = next(free)
+        disp[b] = -s - 1
+        slots[s] = buckets[b][0]
+    return disp, slots
+
+
+def compile_pack(paths):
+    """Pack bytes, languages, tag count and untranslated count of lv_i18n YAML files.
+
+    Raises ValueError (or OSError) for unreadable or conflicting inputs.
+    """
+    langs, tables, keys = [], [], {}
+    for path in paths:
+        lang, entries = load_yaml(path)
+        if lang in langs:
+            raise ValueError(f"{path}: language {lang} is already in the pack")
+        langs.append(lang)
+        tables.append(entries)
+        for k in entries:
+            keys.setdefault(k, None)
+    if not keys:
+        raise ValueError("no translations found")
+
+    enc = {k: k.encode("utf-8") for k in keys}
+    disp, slots = perfect_hash([enc[k] for k in keys])
+    by_bytes = {v: k for k, v in enc.items()}
+
+    strings = bytearray()
+    offsets = {}
+
+    def intern(s):
+        b = s.encode("utf-8")
+        if b not in offsets:
+            offsets[b] = len(strings)
+            strings.extend(b + b"\0")
+        return offsets[b]
+
+    lang_off = [intern(l) for l in langs]
+    tag_off, text_off = [], []
+    untranslated = 0
+    for slot in slots:
+        key = by_bytes[slot]
+        tag_off.append(intern(key))
+        for table in tables:
+            text = table.get(key)
+            if text is None:
+                untranslated += 1
+                text_off.append(MISSING)
+            else:
+                text_off.append(intern(text))
+    while len(strings) % 4:
+        strings.append(0)
+
+    data = b"".join((
+        HEAD.pack(MAGIC, VERSION, len(langs), len(keys), 0, len(strings)),
+        struct.pack(f"<{len(lang_off)}I", *lang_off),
+        struct.pack(f"<{len(disp)}i", *disp),
+        struct.pack(f"<{len(tag_off)}I", *tag_off),
+        struct.pack(f"<{len(text_off)}I", *text_off),
+        bytes(strings),
+    ))
+    return data, langs, len(keys), untranslated
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("inputs", nargs="+", help="lv_i18n YAML files, one language each")
+    ap.add_argument("-o", "--out", required=True, help="output pack path")
+    args = ap.parse_args()
+
+    try:
+        data, langs, tags, untranslated = compile_pack(args.inputs)
+    except (OSError, ValueError) as e:
+        sys.exit(str(e))
+
+    with open(args.out, "wb") as f:
+        f.write(data)
+
+    print(f"{args.out}: {len(langs)} languages ({', '.join(langs)}), {tags} tags, "
+          f"{untranslated} untranslated, {len(data)} bytes")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,232 @@
+#!/usr/bin/env python3
+"""Codegen and binary-size regression check for the zero-cost claims.
+
+  scripts/zero_cost_check.py --lvgl ../lvgl
+  scripts/zero_cost_check.py --lvgl ../lvgl --update-baseline
+
+tests/zero_cost_test.cpp pairs a C function `test_c_<name>` with its C++
+wrapper version `test_cpp_<name>`. Every pair is compiled at -O2 and -Os for
+each target (host, Cortex-M4, Cortex-A53) and the instruction count and
+symbol size of both sides are compared:
+
+  x86-64 -O2   label      c  12 insn  48 B   cpp  12 insn  48 B   +0
+  cortex-m4 -Os event     c   9 insn  26 B   cpp  10 insn  30 B   +1  (baseline +1)
+
+The C++ side also counts the out-of-line code it pulls in (trampolines,
+template instances), i.e. every .text symbol that is not a `test_c_*` or
+`c_*` C helper. With --examples the examples are compiled too and the
+`.text` of each object file is recorded, with the part in `lv::` symbols
+(the wrapper's out-of-line code) next to it.
+
+Results are compared with tests/zero_cost_baseline.json (written by
+--update-baseline): the check fails when a pair's instruction delta grows
+past its baseline (or past --slack for pairs without one) or when an example's .text grows by more than
+--text-slack percent. A target whose compiler is not installed is skipped.
+"""
+
+import argparse
+import json
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+# name: (compiler, flags)
+TARGETS = {
+    "x86-64": ("c++", []),
+    "cortex-m4": ("arm-none-eabi-g++",
+                  ["-mcpu=cortex-m4", "-mthumb", "-fno-exceptions", "-fno-rtti"]),
+    "cortex-a53": ("aarch64-linux-gnu-g++", ["-mcpu=cortex-a53"]),
+}
+LEVELS = ["-O2", "-Os"]
+COMMON = ["-std=c++20", "-c", "-ffunction-sections", "-fno-asynchronous-unwind-tables"]
+
+
+def tool(compiler, name):
+    """nm/objdump/size matching `compiler` (arm-none-eabi-g++ -> arm-none-eabi-nm)."""
+    base = os.path.basename(compiler)
+    m = re.match(r"(.*-)(?:g\+\+|c\+\+|clang\+\+)(-[\d.]+)?$", base)
+    prefixed = (m.group(1) if m else "") + name
+    return shutil.which(os.path.join(os.path.dirname(compiler), prefixed)) or shutil.which(prefixed)
+
+
+def compile_object(compiler, flags, source, includes, out):
+    cmd = [compiler, *COMMON, *flags, *[f"-I{d}" for d in includes], source, "-o", out]
+    r = subprocess.run(cmd, capture_output=True, text=True)
+    return r.returncode == 0, r.stderr
+
+
+def symbols(nm, obj):
+    """{demangled name: size} of the .text symbols in `obj`."""
+    out = subprocess.run([nm, "-S", "-C", "--defined-only", obj],
+                         capture_output=True, text=True, check=True).stdout
+    sizes = {}
+    for line in out.splitlines():
+        parts = line.split(None, 3)
+        if len(parts) == 4 and parts[2] in "tTwW":
+            sizes[parts[3]] = sizes.get(parts[3], 0) + int(parts[1], 16)
+    return sizes
+
+
+def instructions(objdump, obj):
+    """{demangled name: instruction count} from the disassembly of `obj`."""
+    out = subprocess.run([objdump, "-d", "-C", "--no-show-raw-insn", obj],
+                         capture_output=True, text=True, check=True).stdout
+    counts, current = {}, None
+    for line in out.splitlines():
+        head = re.match(r"^[0-9a-f]+ <(.*)>:$", line)
+        if head:
+            current = head.group(1)
+            counts.setdefault(current, 0)
+        elif current and re.match(r"^\s+[0-9a-f]+:\s+\S", line):
+            op = line.split(":", 1)[1].split()[0]
+            if not op.startswith(".") and op != "(bad)":
+                counts[current] += 1
+    return counts
+
+
+def plain(name):
+    """`test_cpp_label(_lv_obj_t*)` -> `test_cpp_label`."""
+    return name.split("(", 1)[0]
+
+
+def is_c_side(name):
+    n = plain(name)
+    return n.startswith("test_c_") or n.startswith("c_")
+
+
+def is_shared(name):
+    """Application code both sides call (the Handler the event tests dispatch to)."""
+    return plain(name) == "main" or name.startswith("Handler::")
+
+
+def measure_pairs(objdump, nm, obj):
+    sizes, insns = symbols(nm, obj), instructions(objdump, obj)
+    c = {plain(s)[len("test_c_"):]: s for s in sizes if plain(s).startswith("test_c_")}
+    cpp = {plain(s)[len("test_cpp_"):]: s for s in sizes if plain(s).startswith("test_cpp_")}
+    pairs = {}
+    for name in sorted(c.keys() & cpp.keys()):
+        pairs[name] = {
+            "c_insn": insns.get(c[name], 0), "c_bytes": sizes[c[name]],
+            "cpp_insn": insns.get(cpp[name], 0), "cpp_bytes": sizes[cpp[name]],
+        }
+    side = {"c": 0, "cpp": 0}
+    for s, size in sizes.items():
+        if not is_shared(s):
+            side["c" if is_c_side(s) else "cpp"] += size
+    return pairs, side
+
+
+def text_size(size_tool, obj):
+    out = subprocess.run([size_tool, "-A", obj], capture_output=True, text=True, check=True).stdout
+    return sum(int(p[1]) for p in (l.split() for l in out.splitlines())
+               if len(p) >= 2 and p[0].startswith(".text") and p[1].isdigit())
+
+
+def parse_target(arg):
+    name, _, rest = arg.partition("=")
+    compiler, *flags = rest.split(",")
+    if not name or not compiler:
+        sys.exit(f"--target {arg}: expected name=compiler[,flag...]")
+    return name, (compiler, [f for f in flags if f])
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("--lvgl", default=os.environ.get("LVGL_DIR", os.path.join(ROOT, "..", "lvgl")),
+                    help="LVGL source directory (default: $LVGL_DIR or ../lvgl)")
+    ap.add_argument("-I", dest="includes", action="append", default=[], help="extra include directory")
+    ap.add_argument("--target", action="append", default=[], metavar="NAME=CXX[,FLAG...]",
+                    help="replace the default targets (repeatable)")
+    ap.add_argument("--host-cxx", default=None, help="compiler for the x86-64 target (default: c++)")
+    ap.add_argument("--examples", action="store_true", help="also record .text of examples/*.cpp")
+    ap.add_argument("--baseline", default=os.path.join(ROOT, "tests", "zero_cost_baseline.json"))
+    ap.add_argument("--update-baseline", action="store_true", help="write the results as the new baseline")
+    ap.add_argument("--slack", type=int, default=None,
+                    help="instructions the C++ side may exceed C by for pairs without a baseline "
+                         "(default: only report them)")
+    ap.add_argument("--text-slack", type=float, default=2.0, help="allowed .text growth of an example in percent")
+    ap.add_argument("--json", help="also write the results here")
+    args = ap.parse_args()
+
+    targets = dict(parse_target(t) for t in args.target) if args.target else dict(TARGETS)
+    if args.host_cxx and "x86-64" in targets:
+        targets["x86-64"] = (args.host_cxx, targets["x86-64"][1])
+    includes = [os.path.join(ROOT, "include"), args.lvgl, ROOT, *args.includes]
+    source = os.path.join(ROOT, "tests", "zero_cost_test.cpp")
+    examples = sorted(f for f in os.listdir(os.path.join(ROOT, "examples")) if f.endswith(".cpp")) \
+        if args.examples else []
+
+    baseline = {}
+    if os.path.exists(args.baseline):
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+
+    results, failures, skipped = {}, [], []
+    with tempfile.TemporaryDirectory() as tmp:
+        for tname, (compiler, flags) in targets.items():
+            cxx = shutil.which(compiler)
+            nm, objdump, size = (tool(compiler, t) for t in ("nm", "objdump", "size"))
+            if not cxx or not nm or not objdump:
+                skipped.append(f"{tname}: {compiler} not found")
+                continue
+            for level in LEVELS:
+                key = f"{tname} {level}"
+                obj = os.path.join(tmp, f"{tname}{level}.o")
+                ok, err = compile_object(cxx, [*flags, level], source, includes, obj)
+                if not ok:
+                    failures.append(f"{key}: zero_cost_test.cpp does not compile\n{err}")
+                    continue
+                pairs, side = measure_pairs(objdump, nm, obj)
+                entry = {"pairs": pairs, "c_text": side["c"], "cpp_text": side["cpp"], "examples": {}}
+                base = baseline.get(key, {})
+                for name, p in pairs.items():
+                    delta = p["cpp_insn"] - p["c_insn"]
+                    allowed = base.get("pairs", {}).get(name)
+                    limit = allowed["cpp_insn"] - allowed["c_insn"] if allowed else args.slack
+                    note = f"  (baseline {limit:+d})" if allowed else "  (no baseline)" if limit is None else ""
+                    print(f"{key:16} {name:10} c {p['c_insn']:4} insn {p['c_bytes']:5} B   "
+                          f"cpp {p['cpp_insn']:4} insn {p['cpp_bytes']:5} B   {delta:+d}{note}")
+                    if limit is not None and delta > limit:
+                        failures.append(f"{key} {name}: C++ is {delta:+d} instructions (allowed {limit:+d})")
+                print(f"{key:16} total      c {side['c']:5} B   cpp {side['cpp']:5} B")
+                for ex in examples:
+                    ex_obj = os.path.join(tmp, f"{tname}{level}-{ex}.o")
+                    ok, _ = compile_object(cxx, [*flags, level], os.path.join(ROOT, "examples", ex),
+                                           includes, ex_obj)
+                    if not ok or not size:
+                        skipped.append(f"{key} {ex}: does not build for this target")
+                        continue
+                    text = text_size(size, ex_obj)
+                    wrapper = sum(n for s, n in symbols(nm, ex_obj).items() if s.startswith("lv::"))
+                    entry["examples"][ex] = {"text": text, "wrapper": wrapper}
+                    before = base.get("examples", {}).get(ex, {}).get("text")
+                    growth = f"  ({(text - before) * 100.0 / before:+.1f}%)" if before else ""
+                    print(f"{key:16} {ex:24} .text {text:7} B   lv:: {wrapper:7} B{growth}")
+                    if before and text > before * (1 + args.text_slack / 100.0):
+                        failures.append(f"{key} {ex}: .text {before} -> {text} B")
+                results[key] = entry
+
+    for s in skipped:
+        print(f"skipped: {s}")
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump(results, f, indent=1, sort_keys=True)
+    if args.update_baseline:
+        baseline.update(results)
+        with open(args.baseline, "w") as f:
+            json.dump(baseline, f, indent=1, sort_keys=True)
+            f.write("\n")
+        print(f"baseline written to {args.baseline}")
+        return 0
+    for msg in failures:
+        print(f"FAIL {msg}", file=sys.stderr)
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -11,8 +11,84 @@
 
 #include <lv/lv.hpp>
 #include <lv/core/verify.hpp>
+#include <lv/draw/draw_buf.hpp>
+#include <lv/draw/image_codecs.hpp>
 #include <lv/draw/draw_mask.hpp>
 #include <lv/draw/draw_task.hpp>
+#include <lv/draw/draw_unit.hpp>
+#include <lv/others/dirty_regions.hpp>
+#include <lv/others/draw_profile.hpp>
+#include <lv/others/input_latency.hpp>
+#include <lv/others/anim_governor.hpp>
+#include <lv/others/remote.hpp>
+#include <lv/others/soak.hpp>
+#include <lv/others/replay.hpp>
+#include <lv/core/image_cache.hpp>
+#include <lv/core/mapped_file.hpp>
+#include <lv/core/buffered_file.hpp>
+#include <lv/core/fs_async.hpp>
+#include <lv/core/executor.hpp>
+#include <lv/widgets/tile_map.hpp>
+#include <lv/core/romfs.hpp>
+#include <lv/core/dir_cache.hpp>
+#include <lv/core/mapped_font.hpp>
+#include <lv/core/translation_pack.hpp>
+#include <lv/core/asset_pack.hpp>
+#include <lv/core/lazy_asset.hpp>
+#include <lv/core/frame_ahead.hpp>
+#include <lv/core/anim_clock.hpp>
+#include <lv/layout/flex_incremental.hpp>
+#include <lv/layout/grid_template.hpp>
+#include <lv/core/theme_switch.hpp>
+#include <lv/core/theme_builder.hpp>
+#include <lv/core/group_list.hpp>
+#include <lv/widgets/table_bulk.hpp>
+#include <lv/widgets/calendar_months.hpp>
+#include <lv/widgets/scale_cache.hpp>
+#include <lv/draw/draw_buf_pool.hpp>
+#include <lv/core/pixel_flush.hpp>
+#include <lv/core/image_cache_stats.hpp>
+#include <lv/draw/path_cache.hpp>
+#include <lv/core/tile_render.hpp>
+#include <lv/core/text_lines.hpp>
+#include <lv/core/frame_pacing.hpp>
+#include <lv/core/snapshot_stream.hpp>
+#include <lv/widgets/key_atlas.hpp>
+#include <lv/widgets/pinyin_trie.hpp>
+#include <lv/libs/qr_encoder.hpp>
+#include <lv/widgets/video_view.hpp>
+#include <lv/core/state_update.hpp>
+#include <lv/draw/nine_slice.hpp>
+#include <lv/widgets/chart_curves.hpp>
+#include <lv/widgets/polyline_cache.hpp>
+#include <lv/others/fragment_page.hpp>
+#include <lv/core/resume.hpp>
+#include <lv/assets/cursor.hpp>
+#include <lv/others/diagnostics.hpp>
+#include <lv/misc/gradient_cache.hpp>
+#include <lv/core/cached_layer.hpp>
+#include <lv/core/kinetic_scroll.hpp>
+#include <lv/core/resolved_style.hpp>
+#include <lv/draw/shadow_cache.hpp>
+#include <lv/draw/rotation_cache.hpp>
+#include <lv/draw/shaped_text_cache.hpp>
+#include <lv/draw/arc_cache.hpp>
+#include <lv/draw/texture_stream.hpp>
+#include <lv/draw/occlusion.hpp>
+#include <lv/draw/canvas_session.hpp>
+#include <lv/draw/canvas_flip.hpp>
+#include <lv/draw/draw_mesh.hpp>
+#include <lv/core/text_cache.hpp>
+#include <lv/core/format.hpp>
+#include <lv/core/static_text.hpp>
+#include <lv/core/glyph_cache.hpp>
+#include <lv/core/font_bake.hpp>
+#include <lv/core/font_loader.hpp>
+#include <lv/core/text_document.hpp>
+#include <lv/widgets/text_editor.hpp>
+#include <lv/widgets/log_view.hpp>
+#include <lv/widgets/notifications.hpp>
+#include <lv/widgets/led_bank.hpp>
 
 // ============================================================
 // user_data: no ambiguity on widgets or raw ObjectView
@@ -264,6 +340,3227 @@ struct Dummy {
 }
 #endif
 
+// ============================================================
+// EventLoop: fd registration overloads (Linux only)
+// ============================================================
+
+#if defined(__linux__)
+struct FdHandler {
+    void on_ready(int, uint32_t) {}
+};
+
+[[maybe_unused]] static void test_event_loop() {
+    lv::EventLoop loop;
+    FdHandler h;
+
+    loop.watch(0, static_cast<lv_indev_t*>(nullptr))
+        .watch(1, [](int, uint32_t, void*) {})
+        .watch<&FdHandler::on_ready>(2, &h)
+        .idle_refresh();
+
+    [[maybe_unused]] uint32_t next = loop.run_once(0);
+    loop.run_with([]() { return false; });
+    loop.wake();
+    loop.quit();
+    [[maybe_unused]] bool removed = loop.unwatch(2);
+
+    lv::RefreshConfig rc;
+    rc.boost_ms = 11;
+    loop.adaptive_refresh(nullptr, rc);
+}
+#endif
+
+// ============================================================
+// Cross-thread post queue
+// ============================================================
+
+struct PostTarget {
+    void refresh() {}
+};
+
+[[maybe_unused]] static void test_dispatcher() {
+    PostTarget t;
+    int value = 42;
+
+    [[maybe_unused]] bool a = lv::post([value] { (void)value; });
+    [[maybe_unused]] bool b = lv::post<&PostTarget::refresh>(&t);
+
+    lv::Dispatcher<16, 32> local;
+    [[maybe_unused]] bool c = local.post([&t, value] { (void)t; (void)value; });
+    [[maybe_unused]] size_t ran = local.drain();
+    [[maybe_unused]] bool idle = local.empty();
+}
+
+// ============================================================
+// Coroutine tasks
+// ============================================================
+
+[[maybe_unused]] static lv::Task fade_in(lv::ObjectView obj, lv::File& file) {
+    co_await lv::next_frame();
+    co_await lv::sleep_for(100);
+    co_await lv::Anim().exec_opa(obj).values(0, 255).duration(200);
+    char buf[64];
+    [[maybe_unused]] lv::ReadResult r = co_await file.read_async(buf, sizeof(buf));
+}
+
+[[maybe_unused]] static void test_task() {
+    lv::File file;
+    lv::Task t = fade_in(lv::ObjectView(nullptr), file);
+    [[maybe_unused]] bool running = t.valid() && !t.done();
+    t.detach();
+}
+
+// ============================================================
+// Frame-paced idle work
+// ============================================================
+
+[[maybe_unused]] static lv::Task build_rows(lv::ObjectView list, uint32_t n) {
+    for (uint32_t i = 0; i < n; ++i) {
+        lv::Label::create(list).text("row");
+        co_await lv::yield_if_over_budget(lv::idle::Priority::low);
+    }
+}
+
+struct TableFiller {
+    lv::Table table;
+    uint32_t row = 0;
+    bool fill_row() {
+        table.cell_value(row, 0, "-");
+        return ++row < 200;
+    }
+};
+
+[[maybe_unused]] static void test_idle(lv::ObjectView list, TableFiller& filler) {
+    lv::idle::configure({.display = nullptr, .margin_us = 2000, .min_chunks = 1});
+    build_rows(list, 500).detach();
+    lv::idle::schedule<&TableFiller::fill_row>(&filler, lv::idle::Priority::high);
+    const uint32_t id = lv::idle::schedule([n = 0]() mutable { return ++n < 10; });
+    lv::idle::cancel(id);
+    [[maybe_unused]] bool busy = lv::idle::pending() > 0 && lv::idle::over_budget();
+    const lv::idle::Stats s = lv::idle::stats();
+    [[maybe_unused]] uint32_t total = s.frames + s.chunks + s.starved_frames + s.render_us + s.slack_us + s.used_us;
+    lv::idle::reset_stats();
+}
+
+// ============================================================
+// Batched animations
+// ============================================================
+
+struct HomeScreen {
+    lv::AnimBatch<64> entrance;
+    void ready() {}
+};
+
+[[maybe_unused]] static void test_anim_batch(lv::ObjectView* cards, uint32_t n, lv::ObjectView arc) {
+    static HomeScreen home;
+    home.entrance.clear();
+    for (uint32_t i = 0; i < n; ++i) {
+        home.entrance.add(cards[i], lv::AnimProp::translate_y, 40, 0, 300);
+        home.entrance.add(cards[i], lv::AnimProp::opa, LV_OPA_TRANSP, LV_OPA_COVER, 300, 0, lv::Ease::linear);
+    }
+    [[maybe_unused]] uint32_t ring = home.entrance.add(arc, lv::AnimProp::arc_value, 0, 75, 800, 0, lv::Ease::overshoot);
+    home.entrance.stagger(20, 0, 2).on_done<&HomeScreen::ready>(&home);
+    home.entrance.start();
+    [[maybe_unused]] bool busy = home.entrance.running() && home.entrance.size() <= home.entrance.capacity();
+    [[maybe_unused]] int32_t v = home.entrance.value(0);
+    home.entrance.finish();
+    home.entrance.reverse().start();
+    home.entrance.stop();
+    [[maybe_unused]] uint32_t writes = home.entrance.stats().applied + home.entrance.stats().skipped + home.entrance.stats().ticks;
+    home.entrance.reset_stats();
+}
+
+inline constexpr lv::Keyframe arc_sweep[] = {{0, 0}, {400, 75, lv::Ease::ease_out}, {900, 60, lv::Ease::ease_in_out}};
+inline constexpr lv::Keyframe label_fade[] = {{0, LV_OPA_TRANSP}, {200, LV_OPA_COVER}};
+inline constexpr lv::KeyTrack arc_intro_tracks[] = {
+    {0, lv::AnimProp::arc_value, arc_sweep},
+    {1, lv::AnimProp::opa, label_fade},
+};
+inline constexpr lv::Keyframes arc_intro{arc_intro_tracks};
+static_assert(arc_intro.valid() && arc_intro.duration() == 900);
+
+[[maybe_unused]] static void test_keyframes(lv::ObjectView arc, lv::ObjectView label) {
+    static HomeScreen home;
+    static lv::KeyframePlayer intro(arc_intro);
+    intro.bind(0, arc).bind(1, label).repeat(1).on_done<&HomeScreen::ready>(&home);
+    intro.play();
+    intro.seek(450).reverse().play();
+    intro.pause();
+    [[maybe_unused]] bool back = intro.playing() || intro.reversed();
+    [[maybe_unused]] uint32_t at = intro.position() + intro.duration();
+    [[maybe_unused]] uint32_t work = intro.stats().ticks + intro.stats().searches + intro.stats().applied;
+    intro.reset_stats();
+    intro.bind(1, lv::ObjectView(nullptr));
+}
+
+[[maybe_unused]] static void test_spring(lv::ObjectView page, int32_t dx) {
+    static HomeScreen home;
+    static lv::Spring slide(page, lv::AnimProp::x);
+    slide.stiffness(220).damping(24).mass(1).precision(0.5f).on_settle<&HomeScreen::ready>(&home);
+    slide.jump(dx);                                 // finger down and dragging
+    slide.to(0, -1200.0f);                          // released with a fling
+    slide.to(-240);                                 // retargeted mid-flight
+    [[maybe_unused]] bool busy = slide.moving();
+    [[maybe_unused]] int32_t at = slide.value() + slide.target();
+    [[maybe_unused]] float v = slide.velocity() + slide.position();
+    [[maybe_unused]] uint32_t work = slide.stats().steps + slide.stats().settles + slide.stats().dropped;
+    slide.reset_stats();
+    slide.stop();
+    slide.bind(lv::ObjectView(nullptr), lv::AnimProp::x);
+}
+
+// ============================================================
+// Batched state notifications
+// ============================================================
+
+[[maybe_unused]] static void test_state_batch() {
+    lv::State<int32_t> rpm{0};
+    lv::State<int32_t> temp{0};
+    {
+        lv::StateBatch batch;
+        rpm.set(1200);
+        temp.set(80);
+        rpm.set(1300);
+    }
+    rpm.set_deferred(1400);
+    [[maybe_unused]] bool pending = rpm.dirty();
+    lv::flush_states();
+}
+
+// ============================================================
+// Wide, float and string states
+// ============================================================
+
+struct TripView {
+    void on_odometer(int64_t) {}
+    void on_speed(float) {}
+    void on_status(const char*) {}
+};
+
+[[maybe_unused]] static void test_state_types() {
+    static TripView view;
+    lv::State<int64_t> odometer{0};
+    lv::FloatState speed{0.0f};
+    lv::State<double> lat{0.0};
+    odometer.observe<&TripView::on_odometer>(&view);
+    speed.observe<&TripView::on_speed>(&view);
+    odometer.set(5'000'000'000LL);
+    odometer.set(5'000'000'000LL);     // unchanged: no notification
+    speed.set(42.5f);
+    lat.set_deferred(55.67);
+
+    static lv::StringState<32> status("idle");
+    status.observe<&TripView::on_status>(&view);
+    lv::Label::create(lv::screen_active()).bind_text(status);
+    status.set("syncing");
+    status.format("%d files left", 3);
+    {
+        lv::StateBatch batch;
+        status.set("done");
+    }
+    static_assert(lv::StringState<32>::capacity() == 31);
+}
+
+// ============================================================
+// Subscriptions (RAII and component-scoped)
+// ============================================================
+
+struct RpmGaugeSub {
+    void on_rpm(int32_t) {}
+};
+
+class FuelPanel : public lv::Component<FuelPanel> {
+    lv::Subscription m_level;
+
+public:
+    lv::State<int32_t>* litres = nullptr;
+    lv::StringState<16>* grade = nullptr;
+
+    lv::ObjectView build(lv::ObjectView parent) {
+        subscribe<&FuelPanel::on_litres>(*litres);     // removed on unmount()
+        m_level = litres->subscribe<&FuelPanel::on_litres>(this);
+        subscribe<&FuelPanel::on_grade>(*grade);
+        return lv::Box::create(parent);
+    }
+    void on_litres(int32_t) {}
+    void on_grade(const char*) {}
+};
+
+[[maybe_unused]] static void test_subscription() {
+    static lv::State<int32_t> litres{40};
+    static lv::StringState<16> grade("95");
+    {
+        FuelPanel panel;
+        panel.litres = &litres;
+        panel.grade = &grade;
+        panel.mount(lv::screen_active());
+        litres.set(39);
+        panel.unmount();                   // pooled subscriptions released
+        litres.set(38);
+    }
+    [[maybe_unused]] uint32_t live = lv::pooled_subscriptions();    // 0
+
+    RpmGaugeSub gauge;
+    lv::Subscription sub = litres.subscribe<&RpmGaugeSub::on_rpm>(&gauge);
+    lv::Subscription moved = std::move(sub);
+    [[maybe_unused]] bool active = moved.active() && !sub.active();
+    moved.reset();
+}
+
+// ============================================================
+// Compile-time binding tables
+// ============================================================
+
+class EnginePanel : public lv::Component<EnginePanel> {
+    lv::Label m_rpm_label;
+    lv::Bar m_rpm_bar;
+    lv::Led m_warn;
+
+public:
+    lv::State<int32_t> rpm{0};
+    lv::State<bool> overheat{false};
+
+    using bindings = lv::Bindings<
+        lv::Bind<&EnginePanel::rpm, &EnginePanel::m_rpm_label, lv::prop::text<"{} rpm">>,
+        lv::Bind<&EnginePanel::rpm, &EnginePanel::m_rpm_bar, lv::prop::value>,
+        lv::Bind<&EnginePanel::overheat, &EnginePanel::m_warn, lv::prop::visible>>;
+
+    lv::ObjectView build(lv::ObjectView parent) {
+        auto root = lv::vbox(parent);
+        m_rpm_label = lv::Label::create(root);
+        m_rpm_bar = lv::Bar::create(root).range(0, 8000);
+        m_warn = lv::Led::create(root);
+        return root;
+    }
+};
+
+[[maybe_unused]] static void test_bindings() {
+    static_assert(EnginePanel::bindings::state_count == 2);
+    EnginePanel panel;
+    panel.mount(lv::screen_active());    // two subscriptions, widgets applied once
+    panel.rpm.set(4200);                 // label and bar in one call
+    panel.overheat.set(true);
+    panel.unmount();
+}
+
+// ============================================================
+// Worker-thread state updates (LV_CPP_STATE_ANY_THREAD)
+// ============================================================
+
+#if LV_CPP_STATE_ANY_THREAD
+struct GpsFix {
+    double lat;
+    double lon;
+};
+
+[[maybe_unused]] static void test_state_any_thread() {
+    static lv::State<int32_t> rpm{0};
+    static lv::State<GpsFix> fix{GpsFix{0.0, 0.0}};
+    rpm.set_from_any_thread(1200);    // from a worker
+    rpm.set_from_any_thread(1300);    // coalesced: applied once
+    fix.set_from_any_thread(GpsFix{55.67, 12.56});
+    [[maybe_unused]] size_t applied = lv::detail::drain_pending();    // what lv::tick() runs
+}
+#endif
+
+// ============================================================
+// Throttled observers
+// ============================================================
+
+struct RpmGauge {
+    void on_rpm(int32_t) {}
+};
+
+[[maybe_unused]] static void test_throttle() {
+    using namespace std::chrono_literals;
+    lv::State<int32_t> rpm{0};
+    RpmGauge gauge;
+    lv::Label label;
+
+    lv_observer_t* o = rpm.observe<&RpmGauge::on_rpm>(&gauge, lv::throttle{16ms});
+    label.bind_text(rpm, "%d rpm", lv::throttle{LV_DEF_REFR_PERIOD});
+    lv::remove_observer(o);
+}
+
+[[maybe_unused]] static void test_bound_text_skip(lv::Label label) {
+    lv::State<int32_t> pct{50};
+    static lv::StaticText<16> pct_text{"%d %%"};
+    label.bind_text(pct, "%d %%");
+    label.bind_text(pct, pct_text);
+    [[maybe_unused]] bool set = lv::text_cache::set_label_text_fmt(label.get(), "%d.%d V", 12, 3);
+}
+
+[[maybe_unused]] static void test_compile_time_format(lv::Label label, lv::Table table) {
+    label.text(lv::fmt<"Speed: {} km/h">, 87);
+    label.text(lv::fmt<"{:.1} V / {:04X}">, 12.34f, 0xBEEFu);
+    lv::State<int32_t> rpm{0};
+    label.bind_text(rpm, lv::fmt<"{:5} rpm">);
+    table.cell_value(0, 1, lv::fmt<"{}/{} {}">, 3, 10, "ok");
+
+    constexpr auto pct = lv::fmt<"{}%">;
+    static_assert(decltype(pct)::arg_count == 1);
+    auto s = pct(42);
+    [[maybe_unused]] std::string_view v = s.view();
+    char buf[8];
+    [[maybe_unused]] int n = lv::snprintf(buf, sizeof(buf), lv::fmt<"{{{}}}">, -5);
+}
+
+[[maybe_unused]] static void test_static_text(lv::Label label) {
+    constexpr lv::static_text license{"Permission is hereby granted, free of charge, ..."};
+    static_assert(license.size() > 0);
+    label.text(license);
+    [[maybe_unused]] std::string_view v = license;
+
+    static lv::TextBuffer<32> status;
+    status.assign("Charging");
+    label.text_view(status);
+    static lv::TextOwner help_owner;
+    static const char help[] = "Press OK to continue";
+    label.text_view(help, &help_owner);
+    help_owner.changed();
+}
+
+// ============================================================
+// Glyph cache: per-font sizing, shared budget and stats
+// ============================================================
+
+[[maybe_unused]] static void test_glyph_cache(lv_font_t* font) {
+    lv::glyph_cache::budget(64 * 1024);
+    [[maybe_unused]] bool ok = lv::glyph_cache::attach(font);
+    [[maybe_unused]] lv::glyph_cache::FontStats fs = lv::glyph_cache::stats(font);
+    [[maybe_unused]] lv::glyph_cache::Stats st = lv::glyph_cache::stats();
+    [[maybe_unused]] uint32_t bytes = st.bytes + fs.bytes + lv::glyph_cache::budget();
+    lv::glyph_cache::reset_stats();
+    lv::glyph_cache::drop(font);
+    lv::glyph_cache::detach(font);
+
+#if LV_USE_TINY_TTF
+    static const uint8_t ttf[4] = {};
+    lv::TinyTTFFont cjk = lv::TinyTTFFont::create(ttf, sizeof(ttf), 20, lv::FontCache{.glyphs = 1024, .shared = true});
+    cjk.set_size(24);
+#endif
+}
+
+// ============================================================
+// Font pre-warm and baking
+// ============================================================
+
+[[maybe_unused]] static void test_font_bake(lv::DynamicFont& ttf, lv::Label label) {
+    [[maybe_unused]] lv::prefetch::Ticket t = ttf.prewarm(u8"0123456789:.-km/h");
+    lv::BakedFont speed = lv::BakedFont::load("A:cache/speed48.bin");
+    if (!speed) {
+        speed = ttf.bake(u8"0123456789:.-km/h");
+        speed.fallback(ttf.get());
+        [[maybe_unused]] bool saved = speed.save("A:cache/speed48.bin");
+    }
+    lv::Font f = speed;
+    label.text_font(f);
+    [[maybe_unused]] size_t bytes = speed.bytes() + speed.glyph_count();
+    lv::BakedFont digits = lv::bake_font(ttf.get(), "0123456789");
+}
+
+// ============================================================
+// Font fallback chains
+// ============================================================
+
+[[maybe_unused]] static void test_font_chain(lv::DynamicFont& cjk, lv::DynamicFont& emoji, lv::Label label) {
+    static lv::FontChain text_font{lv_font_get_default(), cjk.get(), emoji.get()};
+    label.text_font(text_font).text("Speed 速度 \xF0\x9F\x9A\xB2");
+    [[maybe_unused]] lv::FontChainStats s = text_font.stats();
+    [[maybe_unused]] uint32_t by_cjk = s.resolved[1] + s.skipped + s.missing;
+    text_font.dump();
+    text_font.reset_stats();
+    if (cjk.set_size(20)) text_font.refresh();
+    text_font.clear();
+}
+
+// ============================================================
+// Computed state
+// ============================================================
+
+[[maybe_unused]] static void test_computed() {
+    lv::State<int32_t> battery{80};
+    lv::State<int32_t> efficiency{5};
+    lv::Computed range{[](int32_t b, int32_t e) { return b * e; }, battery, efficiency};
+    lv::Computed doubled{[](int32_t r) { return r * 2; }, range};
+    RpmGauge gauge;
+    lv::Label label;
+
+    [[maybe_unused]] int32_t km = range.get();
+    [[maybe_unused]] bool stale = range.stale();
+    label.bind_text(range, "%d km");
+    doubled.observe<&RpmGauge::on_rpm>(&gauge);
+    static_assert(decltype(range)::dependency_count() == 2);
+}
+
+// ============================================================
+// List state diffs
+// ============================================================
+
+struct AlarmRow {
+    uint32_t id;
+    uint8_t severity;
+};
+
+struct AlarmView {
+    void on_alarms(const lv::ListChange& c) { (void)c.op; (void)c.index; }
+};
+
+[[maybe_unused]] static void test_list_state() {
+    lv::ListState<AlarmRow, 64> alarms;
+    AlarmView view;
+    alarms.observe<&AlarmView::on_alarms>(&view);
+
+    [[maybe_unused]] bool ok = alarms.push_back({1, 3});
+    ok = alarms.insert(0, {2, 1});
+    ok = alarms.set(1, {1, 2});
+    ok = alarms.update(0, [](AlarmRow& r) { r.severity = 0; });
+    ok = alarms.move(0, 1);
+    ok = alarms.erase(0);
+    for ([[maybe_unused]] const AlarmRow& r : alarms) {}
+    alarms.clear();
+}
+
+// ============================================================
+// Chart batches and ring-buffer series
+// ============================================================
+
+[[maybe_unused]] static void test_chart_batches(lv::Chart chart) {
+    lv_chart_series_t* raw = chart.add_series(lv_palette_main(LV_PALETTE_BLUE));
+    const int32_t block[] = {1, 2, 3, 4};
+    chart.append(raw, block);
+    chart.append(raw, std::span<const int32_t>(block, 2));
+    static int32_t trace[512];
+    chart.point_count(512).update_circular().set_ext_y_array(raw, trace);
+    trace[40] = trace[41] = 7;
+    chart.mark_dirty(raw, 40, 41);
+
+    static lv::ChartRing<1024> feed;
+    lv_chart_series_t* live = chart.add_series(lv_palette_main(LV_PALETTE_RED));
+    chart.update_shift().bind_ring(live, feed);
+    feed.push(42);                          // acquisition thread
+    feed.push(block);
+    feed.sync();
+    [[maybe_unused]] uint32_t n = feed.written() + feed.capacity();
+    feed.detach();
+}
+
+[[maybe_unused]] static void test_chart_decimator(lv::Chart chart, const int32_t* samples, uint32_t n) {
+    static lv::ChartDecimator deci;
+    lv_chart_series_t* ser = chart.add_series(lv_palette_main(LV_PALETTE_GREEN));
+    deci.attach(chart, ser);
+    deci.mode(lv::Decimation::lttb).mode(lv::Decimation::min_max);
+    deci.data(samples, n).view_last(6000);
+    deci.view(0, n / 2).view_all();
+    deci.columns(200).refresh();
+    [[maybe_unused]] uint32_t pts = deci.point_count() + deci.samples_per_column();
+    const lv::ChartDecimator::Stats& s = deci.stats();
+    [[maybe_unused]] uint64_t work = s.scanned + s.updates + s.rebuilds + s.merges + s.points;
+    deci.reset_stats();
+    deci.detach();
+}
+
+[[maybe_unused]] static void test_polyline_cache(lv::ObjectView parent, const lv_point_precise_t* track, uint32_t n) {
+    static lv::PolylineCache cache;
+    auto line = lv::Line::create(parent);
+    line.width(3).rounded();
+    [[maybe_unused]] bool ok = cache.attach(line, track, n);
+    cache.tolerance(0.5f).points(track, n / 2);
+    [[maybe_unused]] float tol = cache.tolerance();
+    cache.refresh();
+    const lv::PolylineCache::Stats& s = cache.stats();
+    [[maybe_unused]] uint32_t work = s.draws + s.simplifications + s.points_kept + s.points_drawn + s.buckets_culled;
+    cache.reset_stats();
+    cache.detach();
+}
+
+#if LV_USE_VECTOR_GRAPHIC
+[[maybe_unused]] static void test_chart_curves(lv::Chart chart) {
+    static lv::ChartCurves curve;
+    lv_chart_series_t* ser = chart.add_series(lv_palette_main(LV_PALETTE_BLUE));
+    [[maybe_unused]] bool ok = curve.attach(chart, ser);
+    curve.quality(LV_VECTOR_PATH_QUALITY_HIGH).line_below(3);
+    [[maybe_unused]] int32_t px = curve.line_below();
+    chart.set_value_by_id(ser, 17, 42);
+    curve.refresh();
+    const lv::ChartCurves::Stats& s = curve.stats();
+    [[maybe_unused]] uint32_t work = s.draws + s.rebuilds + s.segments + s.reused;
+    curve.reset_stats();
+    curve.detach();
+}
+#endif
+
+#if LV_USE_CANVAS
+[[maybe_unused]] static void test_strip_chart(lv::ObjectView page, std::span<const int32_t> leads) {
+    static lv::StripChart ecg(2);
+    ecg.mount(page);
+    const uint32_t lead1 = ecg.add_series(lv_palette_main(LV_PALETTE_GREEN));
+    [[maybe_unused]] const uint32_t lead2 = ecg.add_series(lv_palette_main(LV_PALETTE_RED), 1);
+    ecg.range(-500, 1500).div_lines(3, 0);
+    ecg.append(leads);
+    ecg.append(static_cast<int32_t>(lead1));
+    [[maybe_unused]] uint32_t cap = ecg.capacity();
+    const lv::StripChart::Stats& s = ecg.stats();
+    [[maybe_unused]] uint32_t work = s.samples + s.scrolls + s.segments + s.full;
+    ecg.reset_stats();
+    ecg.clear();
+    ecg.unmount();
+}
+#endif
+
+// ============================================================
+// Virtualized list
+// ============================================================
+
+#if LV_USE_LIST
+struct AlarmRows {
+    lv::ListState<AlarmRow, 64>* alarms;
+    uint32_t count() const { return alarms->size(); }
+    void bind(lv::ObjectView row, uint32_t i) { (void)row; (void)(*alarms)[i]; }
+};
+
+[[maybe_unused]] static void test_virtual_list() {
+    lv::ListState<AlarmRow, 64> alarms;
+    AlarmRows rows{&alarms};
+    static_assert(lv::RowProvider<AlarmRows>);
+
+    lv::VirtualList<AlarmRows, 24> list(rows, 40);
+    list.mount(lv::screen_active());
+    list.bind_list(alarms);
+    list.refresh_row(0);
+    list.scroll_to(10);
+    [[maybe_unused]] uint32_t created = list.row_count();
+
+    lv::Group keys;
+    list.focus_group(keys).focus_item(30);
+    [[maybe_unused]] uint32_t focused = list.focused_item();
+}
+
+struct ZoneOptions {
+    lv::ListState<AlarmRow, 64>* zones;
+    uint32_t count() const { return zones->size(); }
+    void text(uint32_t i, char* buf, uint32_t size) const {
+        lv_snprintf(buf, size, "Zone %u", static_cast<unsigned>(i));
+    }
+};
+
+[[maybe_unused]] static void test_virtual_options() {
+    lv::ListState<AlarmRow, 64> zones;
+    ZoneOptions options{&zones};
+    static_assert(lv::OptionProvider<ZoneOptions>);
+
+#if LV_USE_ROLLER
+    lv::VirtualRoller<ZoneOptions> roller(options, 5, lv::VirtualRoller<ZoneOptions>::infinite);
+    roller.mount(lv::screen_active());
+    roller.bind_list(zones);
+    roller.selected(30).selected(31, true);
+    roller.roller().width(160);
+    char zone[LV_CPP_OPTION_TEXT_MAX];
+    roller.selected_str(zone, sizeof(zone));
+    [[maybe_unused]] uint32_t sel = roller.selected() + roller.option_count();
+#endif
+
+#if LV_USE_DROPDOWN
+    lv::VirtualDropdown<ZoneOptions, 12> country(options, 8);
+    country.mount(lv::screen_active());
+    country.bind_list(zones);
+    country.selected(3).refresh();
+    country.dropdown().width(200);
+    country.open_list();
+    [[maybe_unused]] bool open = country.is_open() && country.selected() < country.option_count();
+    country.close();
+#endif
+}
+
+struct ReadingRows {
+    const int32_t* values;
+    uint32_t n;
+    uint32_t count() const { return n; }
+    void cell(uint32_t row, uint32_t col, char* out, uint32_t size) {
+        if (col == 0) lv_snprintf(out, size, "#%u", static_cast<unsigned>(row));
+        else lv_snprintf(out, size, "%d", static_cast<int>(values[row]));
+    }
+    const char* header(uint32_t col) { return col ? "Value" : "Sample"; }
+    bool selected(uint32_t row) { return row == 0; }
+    uint8_t cell_style(uint32_t row, uint32_t col) { return col && values[row] > 90 ? 1 : 0; }
+    int compare(uint32_t a, uint32_t b, uint32_t col) {
+        return col ? (values[a] > values[b]) - (values[a] < values[b]) : (a > b) - (a < b);
+    }
+};
+
+class ReadingsPage : public lv::Component<ReadingsPage> {
+    ReadingRows m_rows;
+    lv::DataTable<ReadingRows, 2, 24> m_table{m_rows, 32};
+
+    void pick(uint32_t row) { [[maybe_unused]] int32_t v = m_rows.values[row]; }
+
+public:
+    ReadingsPage(const int32_t* values, uint32_t n) : m_rows{values, n} {}
+
+    lv::ObjectView build(lv::ObjectView parent) {
+        auto box = lv::Box::create(parent);
+        m_table.mount(box);
+        m_table.on_select<&ReadingsPage::pick>(this);
+        return box;
+    }
+    void show(const lv_style_t* warn) {
+        m_table.cell_style(1, warn).autosize().column_width(0, 60);
+        if (!m_table.sort(1, false)) m_table.unsort();
+        m_table.refresh_row(0);
+        m_table.refresh();
+        m_table.scroll_to(0);
+        [[maybe_unused]] uint32_t n = m_table.row_count() + m_table.row_objects() + m_table.sort_column();
+        [[maybe_unused]] uint32_t work = m_table.stats().hits + m_table.stats().misses + m_table.stats().sorts;
+        m_table.reset_stats();
+    }
+};
+
+[[maybe_unused]] static void test_data_table(const int32_t* values, uint32_t n, const lv_style_t* warn) {
+    static_assert(lv::TableProvider<ReadingRows>);
+    ReadingsPage page(values, n);
+    page.mount(lv::screen_active());
+    page.show(warn);
+}
+#endif
+
+// ============================================================
+// Large-document editor
+// ============================================================
+
+[[maybe_unused]] static void test_text_editor() {
+    static lv::TextDocument doc("[net]\nhost=10.0.0.2\nport=8080\n");
+    doc.insert(doc.line_start(2), "timeout=30\n");
+    doc.erase(0, 1);
+    [[maybe_unused]] uint32_t line = doc.line_of(12) + doc.line_length(1);
+    char buf[64];
+    [[maybe_unused]] std::string_view first = doc.line(0, buf, sizeof(buf));
+    doc.for_each_chunk([](std::string_view part) { (void)part; });
+
+    static lv::TextEditor<32> editor(doc);
+    editor.mount(lv::screen_active());
+    editor.wrap(true).cursor(doc.line_start(1)).insert("# comment\n").erase(0, 2);
+    editor.key(LV_KEY_BACKSPACE);
+    editor.key('x');
+    editor.refresh();
+    [[maybe_unused]] uint32_t measured = editor.stats().measured + editor.row_count() + editor.cursor();
+    [[maybe_unused]] const char* all = editor.document().c_str();
+}
+
+// ============================================================
+// Translation lookup
+// ============================================================
+
+#if LV_USE_TRANSLATION
+[[maybe_unused]] static void test_translation_index() {
+    static const char* const langs[] = {"en", "de", nullptr};
+    static const char* const tags[] = {"hello", "bye", nullptr};
+    static const char* const trans[] = {"Hello", "Hallo", "Goodbye", nullptr};
+    static lv::translation::IndexedPack pack(langs, tags, trans);
+    pack.use();
+    [[maybe_unused]] int32_t idx = pack.find("bye") + pack.language_index("de");
+    [[maybe_unused]] const char* de = pack.get("hello", 1);
+    [[maybe_unused]] const char* text = lv::tr("hello");
+
+    static lv::translation::BinaryPack texts("A:/lang/ebike.ltp");
+    if (texts) {
+        texts.use();
+        [[maybe_unused]] lv_translation_pack_t* lvgl_pack = texts.install();
+        [[maybe_unused]] const char* battery = texts.get("Battery", 0);
+        [[maybe_unused]] uint32_t n = texts.tag_count() + texts.language_count();
+        [[maybe_unused]] bool mapped = texts.in_place();
+    }
+}
+
+[[maybe_unused]] static void test_language_switch() {
+    auto title = lv::Label::create(lv::screen_active()).translated("hello");
+    lv::translation::bind(lv::Label::create(lv::screen_active()).get(), "bye");
+    [[maybe_unused]] const char* de = lv::translation::lookup("hello", "de");
+    lv::prefetch::Ticket t = lv::translation::preload("de");
+    if (lv::prefetch::pending(t) == 0) {
+        [[maybe_unused]] uint32_t changed = lv::translation::switch_language("de");
+    }
+    lv::translation::unbind(title.get());
+    [[maybe_unused]] uint32_t n = lv::translation::bound_count();
+}
+#endif
+
+// ============================================================
+// Pinyin trie dictionary
+// ============================================================
+
+#if LV_USE_IME_PINYIN && LV_USE_KEYBOARD
+[[maybe_unused]] static void test_pinyin_trie(lv::ObjectView parent) {
+    static lv::PinyinTrie dict("A:/ime/pinyin.lpy");
+    if (!dict) return;
+    lv::PinyinTrie::Candidates c = dict.lookup("zhong");
+    [[maybe_unused]] const char* first = c.count ? c.text : nullptr;
+    [[maybe_unused]] uint32_t nodes = dict.node_count();
+
+    auto kb = lv::Keyboard::create(parent);
+    auto ime = lv::IMEPinyin::create(parent).keyboard(kb);
+    dict.attach(ime);
+    [[maybe_unused]] bool attached = dict.attached();
+    dict.detach();
+}
+#endif
+
+// ============================================================
+// Logging
+// ============================================================
+
+[[maybe_unused]] static void test_log() {
+    lv::log::trace("frame %u", 7u);
+    lv::log::info("value = %d, name = %s", 42, "rpm");
+    lv::log::warn("plain message");
+#if LV_USE_LOG && LV_CPP_LOG_DEFERRED
+    lv::log::drain_in_idle();
+    [[maybe_unused]] size_t n = lv::log::drain(32);
+    [[maybe_unused]] bool more = lv::log::pending();
+    [[maybe_unused]] uint32_t dropped = lv::log::stats().dropped;
+    lv::log::reset_stats();
+#endif
+}
+
+// ============================================================
+// Log viewer
+// ============================================================
+
+[[maybe_unused]] static void test_log_view() {
+    static lv::LogView<256, 16 * 1024, 32> logs;
+    logs.mount(lv::screen_active());
+#if LV_USE_LOG
+    logs.capture_log([](lv_log_level_t, const char* buf) { (void)buf; });
+#endif
+    logs.append("boot ok");
+    logs.append("sensor: 21.5 C\nsensor: 21.6 C\n", LV_LOG_LEVEL_USER);
+    logs.append("disk full", LV_LOG_LEVEL_ERROR);
+    logs.follow(false).follow(true);
+    [[maybe_unused]] bool tail = logs.following();
+    [[maybe_unused]] uint32_t n = logs.line_count() + logs.row_count() + logs.stats().dropped;
+    logs.clear();
+    logs.reset_stats();
+}
+
+[[maybe_unused]] static void test_led_bank() {
+    static lv::LedBank<256, 16> panel;
+    panel.mount(lv::screen_active());
+    panel.color(lv_palette_main(LV_PALETTE_GREEN)).off_mix(40).glow(3);
+    panel.set(17, true).toggle(18).brightness(18, 128);
+    uint32_t words[decltype(panel)::WORDS] = {0x0000FFFFu, 0x80000001u};
+    panel.assign(words).set_all(false);
+    [[maybe_unused]] bool on = panel.is_on(17);
+    [[maybe_unused]] uint32_t n = panel.brightness(18) + panel.state()[0] + panel.index_at({25, 5});
+}
+
+#if LV_USE_CALENDAR
+[[maybe_unused]] static void test_calendar() {
+    static const lv::CalendarLocale de({"So", "Mo", "Di", "Mi", "Do", "Fr", "Sa"},
+                                       {"Januar", "Februar", "M\xc3\xa4rz", "April", "Mai", "Juni", "Juli", "August",
+                                        "September", "Oktober", "November", "Dezember"});
+    static lv_calendar_date_t marked[] = {{2026, 3, 14}, {2026, 4, 1}};
+    lv::Calendar cal = lv::Calendar::create(lv::screen_active());
+    (void)cal.header_arrow();
+    cal.locale(de).today_date(2026, 3, 9).highlighted_dates(marked, 2);
+    for (uint32_t m = 1; m <= 12; ++m) cal.shown_date(2026, m);
+    cal.shown_date(2026, 3).shown_date(2026, 3);
+    for (uint32_t m = 1; m <= 12; ++m) lv::calendar_months::show(cal, 2027, m);
+    lv::calendar_months::show(cal, 2027, 1);
+    marked[1].month = 3;
+    cal.refresh_highlights().highlight_day(20, true).highlight_day(20, false);
+    const lv::calendar::Stats st = lv::calendar::stats();
+    const lv::calendar_months::Stats months = lv::calendar_months::stats();
+    [[maybe_unused]] uint32_t n = st.shows + st.unchanged + months.hits + months.misses;
+    lv::calendar::reset_stats();
+    lv::calendar_months::reset_stats();
+}
+#endif
+
+[[maybe_unused]] static void test_notifications() {
+    static lv::Notifications<3, 32> notes;
+    notes.mount(lv::ObjectView(lv_layer_top()));
+    notes.show_ms(4000).interval_ms(250).align(LV_ALIGN_TOP_RIGHT, -8, 8);
+    for (int i = 0; i < 100; ++i) notes.post("Coolant temperature high", lv::NoticeLevel::error);
+    notes.post("Door open", lv::NoticeLevel::warning);
+    notes.post("Trip saved");
+    const auto& st = notes.stats();
+    [[maybe_unused]] uint32_t n = notes.visible() + notes.queued() + st.posted + st.shown + st.coalesced +
+                                  st.dropped + st.builds;
+    notes.clear();
+    notes.reset_stats();
+}
+
+// ============================================================
+// Video view
+// ============================================================
+
+[[maybe_unused]] static void test_video_view() {
+    static lv::VideoView video;
+    video.mount(lv::screen_active());
+    video.root().size(320, 180);
+    [[maybe_unused]] bool ok = video.format(320, 180, LV_COLOR_FORMAT_RGB565);
+    video.play();
+    if (lv_draw_buf_t* buf = video.acquire()) video.submit(buf, 0);
+    if (lv_draw_buf_t* buf = video.acquire()) video.discard(buf);
+    video.sync(40000);
+    [[maybe_unused]] int64_t t = video.position();
+    [[maybe_unused]] uint32_t n = video.queued();
+    [[maybe_unused]] lv::VideoView::Stats st = video.stats();
+    video.pause();
+    [[maybe_unused]] bool on = video.playing();
+    video.flush();
+    video.reset_stats();
+}
+
+// ============================================================
+// Tile map
+// ============================================================
+
+[[maybe_unused]] static void test_tile_map() {
+    static lv::TileMap plan;
+    plan.mount(lv::screen_active());
+    plan.root().size(480, 320);
+    plan.source("A:/plan/%u/%u_%u.png", 8192, 6144, 6);
+    plan.zoom(64);
+    [[maybe_unused]] uint8_t level = plan.level();
+    [[maybe_unused]] int32_t scale = plan.zoom();
+    plan.budget(2 * 1024 * 1024);
+    [[maybe_unused]] uint32_t bytes = plan.budget();
+    const lv::TileMap::Stats s = plan.stats();
+    [[maybe_unused]] uint32_t drawn = s.tiles + s.bytes + s.loads + s.failed + s.dropped + s.hits + s.fallbacks +
+                                      s.blanks + s.prefetches + s.evictions;
+    plan.dump();
+    plan.drop();
+    plan.reset_stats();
+    plan.unmount();
+}
+
+// ============================================================
+// Event delegation
+// ============================================================
+
+struct Keypad {
+    int32_t last = -1;
+    void on_key(lv::DelegateEvent e) {
+        last = e.index();
+        [[maybe_unused]] const char* name = e.name();
+        [[maybe_unused]] lv::ObjectView key = e.child();
+    }
+};
+
+[[maybe_unused]] static void test_delegate() {
+    static Keypad pad;
+    auto grid = lv::Box::create(lv::screen_active());
+    for (int i = 0; i < 12; ++i) lv::Button::create(grid);
+    grid.delegate<&Keypad::on_key>(&pad);
+    grid.delegate<&Keypad::on_key, &lv_button_class>(&pad, lv::kEvent::long_pressed);
+}
+
+// ============================================================
+// Build scope
+// ============================================================
+
+[[maybe_unused]] static void test_build_scope() {
+    lv::ObjectView screen = lv::screen_active();
+    {
+        lv::BuildScope scope(screen);
+        lv::BuildScope nested(screen);    // no-op inside an open scope
+        [[maybe_unused]] bool owner = scope.active() && !nested.active();
+        lv::ObjectView box(lv_obj_create(screen.get()));
+        scope.set_root(box);
+    }
+}
+
+// ============================================================
+// Style cache
+// ============================================================
+
+[[maybe_unused]] static void test_style_cache() {
+    static lv::StyleCache<8> cache;
+    lv::Style a;
+    a.radius(6).pad_all(8);
+    lv::Style b;
+    b.radius(6).pad_all(8);
+    const lv::Style* sa = cache.acquire(std::move(a));
+    const lv::Style* sb = cache.acquire(std::move(b));    // same contents: shared
+    [[maybe_unused]] size_t saved = cache.bytes_saved();
+    [[maybe_unused]] uint32_t hits = cache.hits();
+    cache.release(sb);
+    cache.release(sa);
+    [[maybe_unused]] uint32_t findings = lv::audit_local_styles(lv::screen_active());
+}
+
+// ============================================================
+// Constant styles
+// ============================================================
+
+static constexpr lv::ConstStyle kCardStyle = lv::const_style()
+    .bg_color(lv::const_rgb(0x202020))
+    .bg_opa(LV_OPA_COVER)
+    .radius(8)
+    .pad_all(12)
+    .text_font(LV_FONT_DEFAULT);
+static_assert(kCardStyle.size() == 7);
+
+[[maybe_unused]] static void test_const_style() {
+    lv::Box box = lv::Box::create(lv::screen_active());
+    box.add_style(kCardStyle);
+    box.remove_style(kCardStyle.get());
+}
+
+// ============================================================
+// Theme switching
+// ============================================================
+
+[[maybe_unused]] static void theme_begin(void*) noexcept {}
+[[maybe_unused]] static void theme_end(const lv::ThemeSwitchStats&, void*) noexcept {}
+
+[[maybe_unused]] static void test_theme_switch() {
+    lv::Theme::instrument({&theme_begin, &theme_end, nullptr});
+    lv_display_t* disp = lv_display_get_default();
+    lv::Theme current(lv_display_get_theme(disp));
+    lv::ThemeSwitchStats stats = lv::switch_theme(disp, current);
+    [[maybe_unused]] uint32_t n = stats.objects + stats.screens + stats.elapsed_ms;
+    lv::Theme::instrument({});
+}
+
+class PanelTheme : public lv::ThemeBuilder<PanelTheme> {
+    lv::Style m_screen, m_card, m_button, m_pressed;
+
+public:
+    using rules = lv::ThemeRules<
+        lv::ThemeRule<&lv_obj_class, &PanelTheme::m_card>,
+        lv::ThemeRule<&lv_button_class, &PanelTheme::m_button>,
+        lv::ThemeRule<&lv_button_class, &PanelTheme::m_pressed, LV_STATE_PRESSED>>;
+
+    void init_styles() {
+        m_screen.bg_color(lv::colors::black());
+        m_card.bg_color(lv::colors::white()).radius(8);
+        m_button.radius(4);
+        m_pressed.bg_color(lv::colors::black());
+    }
+    void on_apply(lv_obj_t* obj) {
+        if (!lv_obj_get_parent(obj)) lv_obj_add_style(obj, m_screen.get(), LV_PART_MAIN);
+    }
+};
+
+[[maybe_unused]] static void test_theme_builder() {
+    static PanelTheme panel_theme;
+    static_assert(PanelTheme::rule_count() == 3);
+    lv_display_t* disp = lv_display_get_default();
+    lv::switch_theme(disp, panel_theme.init(disp));
+    [[maybe_unused]] size_t n = PanelTheme::class_count() + PanelTheme::styles_for(&lv_button_class);
+}
+
+// ============================================================
+// Resolved-style cache
+// ============================================================
+
+[[maybe_unused]] static void resolved_draw_cb(lv_event_t* e) {
+    lv_obj_t* obj = lv_event_get_current_target_obj(e);
+    lv_draw_rect_dsc_t rect;
+    lv_draw_rect_dsc_init(&rect);
+    rect.shadow_opa = LV_OPA_TRANSP;    // no shadow: a separate cache entry
+    lv::resolved_style::init_rect_dsc(obj, LV_PART_INDICATOR, &rect);
+    lv_draw_label_dsc_t label;
+    lv_draw_label_dsc_init(&label);
+    lv::resolved_style::init_label_dsc(obj, LV_PART_INDICATOR, &label);
+    label.text = "42";
+    lv_area_t area;
+    lv_obj_get_coords(obj, &area);
+    lv_draw_rect(lv_event_get_layer(e), &rect, &area);
+    lv_draw_label(lv_event_get_layer(e), &label, &area);
+}
+
+[[maybe_unused]] static void test_resolved_style(lv::ObjectView gauge) {
+    lv::resolved_style::enable(gauge);
+    lv_obj_add_event_cb(gauge.get(), &resolved_draw_cb, LV_EVENT_DRAW_MAIN_END, nullptr);
+    lv_obj_add_state(gauge.get(), LV_STATE_PRESSED);     // drops the cache
+    lv::resolved_style::invalidate(gauge);
+    const lv::resolved_style::Stats s = lv::resolved_style::stats();
+    [[maybe_unused]] uint32_t total = s.hits + s.misses + s.uncached + s.invalidations;
+    [[maybe_unused]] bool on = lv::resolved_style::enabled(gauge);
+    lv::resolved_style::reset_stats();
+    lv::resolved_style::disable(gauge);
+}
+
+// ============================================================
+// Batched state changes
+// ============================================================
+
+[[maybe_unused]] static void test_set_states(lv::ObjectView parent) {
+    auto btn = lv::Button::create(parent);
+    btn.add_state(LV_STATE_PRESSED)
+       .set_states(LV_STATE_CHECKED | LV_STATE_FOCUSED, LV_STATE_PRESSED);   // one add, one remove
+    lv::state_update::install();
+    btn.set_states(LV_STATE_PRESSED, LV_STATE_CHECKED);   // one STATE_CHANGED
+    lv::set_states(btn.get(), 0, LV_STATE_FOCUSED | LV_STATE_FOCUS_KEY);
+}
+
+// ============================================================
+// Navigator screen cache
+// ============================================================
+
+class SettingsScreen : public lv::ScreenComponent<SettingsScreen> {
+public:
+    lv::ObjectView build(lv::ObjectView parent) {
+        return lv::Label::create(parent).text("Settings");
+    }
+};
+
+[[maybe_unused]] static void test_navigator_cache() {
+    static SettingsScreen settings;
+    static lv::Navigator nav;
+    nav.budget(32 * 1024);
+    nav.set_root(lv::screen_active());
+    [[maybe_unused]] bool pushed = nav.push(settings, lv::screen_anim::move_left, 300);
+    nav.back();
+    nav.evict_unused();
+    [[maybe_unused]] size_t built = nav.built_count();
+    [[maybe_unused]] uint32_t evicted = nav.evictions() + nav.rebuilds();
+    nav.forget(settings);
+}
+
+// ============================================================
+// Idle-time prefetch
+// ============================================================
+
+[[maybe_unused]] static void test_prefetch(const lv_image_dsc_t& icon) {
+    lv::prefetch::Ticket t = lv::prefetch::images({"A:/img/map.png", &icon});
+    lv::prefetch::glyphs(lv_font_default(), 0x20, 0x7E, t);
+    lv::prefetch::text(lv_font_default(), "Einstellungen", t);
+    lv::prefetch::fonts({{lv_font_default(), 0x30, 0x39}});
+    lv::prefetch::component<SettingsScreen>(t);
+    static SettingsScreen settings;
+    static lv::Navigator nav;
+    nav.auto_prefetch(true);
+    [[maybe_unused]] lv::prefetch::Ticket nt = nav.prefetch(settings);
+    [[maybe_unused]] uint32_t left = lv::prefetch::pending(t);
+    [[maybe_unused]] lv::prefetch::Stats s = lv::prefetch::stats();
+    [[maybe_unused]] bool more = lv::prefetch::run_idle(5);
+    lv::prefetch::cancel(t);
+    lv::prefetch::cancel_all();
+}
+
+#if LV_USE_SNAPSHOT && LV_USE_IMAGE
+[[maybe_unused]] static void test_snapshot_transition() {
+    static lv::Navigator nav;
+    nav.transitions(lv::TransitionMode::snapshot);
+    lv::Screen next;
+    [[maybe_unused]] bool animated = lv::screen_load_snapshot(next, lv::screen_anim::move_left, 300);
+    [[maybe_unused]] bool running = lv::snapshot_transition_running();
+    lv::release_transition_buffers();
+}
+#endif
+
+// ============================================================
+// Lazy tab/tile pages
+// ============================================================
+
+class HeavyPage : public lv::Component<HeavyPage> {
+public:
+    lv::ObjectView build(lv::ObjectView parent) {
+        return lv::Label::create(parent).text("Page");
+    }
+};
+
+#if LV_USE_TABVIEW && LV_USE_TILEVIEW
+[[maybe_unused]] static void test_lazy_pages() {
+    static HeavyPage status, settings, tile_a, tile_b;
+    lv::Tabview tabs = lv::Tabview::create(lv::screen_active());
+    [[maybe_unused]] lv::ObjectView t0 = tabs.add_tab_lazy("Status", status);
+    [[maybe_unused]] lv::ObjectView t1 = tabs.add_tab_lazy("Settings", settings, 30000);
+
+    lv::Tileview tiles = lv::Tileview::create(lv::screen_active());
+    (void)tiles.add_tile_lazy(0, 0, LV_DIR_RIGHT, tile_a);
+    (void)tiles.add_tile_lazy(1, 0, LV_DIR_LEFT, tile_b, 10000);
+    [[maybe_unused]] uint32_t mounted = lv::lazy_pages_mounted();
+}
+#endif
+
+// ============================================================
+// Draw buffer pool
+// ============================================================
+
+static_assert(lv::DrawBufPool::size_class(1000) == 1024);
+static_assert(lv::DrawBufPool::size_class(1100) == 1280);
+
+[[maybe_unused]] static void test_draw_buf_pool() {
+    lv::DrawBufPool::cap(2 * 1024 * 1024);
+    lv::DrawBufPool::install();
+    {
+        lv::DrawBuf buf = lv::DrawBuf::acquire(64, 64, LV_COLOR_FORMAT_ARGB8888);
+        buf.clear();
+    }
+    lv::DrawBufPoolStats stats = lv::DrawBufPool::stats();
+    [[maybe_unused]] uint32_t requests = stats.hits + stats.misses;
+    lv::DrawBufPool::reset_stats();
+    lv::DrawBufPool::trim();
+    lv::DrawBufPool::uninstall();
+    void* raw = lv::draw::pool_malloc(100, LV_COLOR_FORMAT_RAW);
+    lv::draw::pool_free(raw);
+    [[maybe_unused]] lv::DrawBufPoolStats routed = lv::draw::pool_stats();
+}
+
+// ============================================================
+// CRTP image decoders
+// ============================================================
+
+class TestRleDecoder : public lv::ImageDecoderBase<TestRleDecoder> {
+public:
+    lv_result_t info(lv_image_decoder_dsc_t& dsc, lv_image_header_t& header) {
+        if (!has_extension(dsc, "rle")) return LV_RESULT_INVALID;
+        header.w = 16;
+        header.h = 16;
+        header.cf = LV_COLOR_FORMAT_ARGB8888;
+        return LV_RESULT_OK;
+    }
+
+    lv_result_t open(lv_image_decoder_dsc_t& dsc) {
+        lv_draw_buf_t* out = alloc_output(dsc.header.w, dsc.header.h, LV_COLOR_FORMAT_ARGB8888);
+        if (!out) return LV_RESULT_INVALID;
+        lv_draw_buf_clear(out, nullptr);
+        return publish(dsc, out);
+    }
+
+    void close(lv_image_decoder_dsc_t& dsc) { dsc.user_data = nullptr; }
+};
+
+[[maybe_unused]] static void test_image_decoder_base() {
+    static TestRleDecoder rle;
+    [[maybe_unused]] bool ok = rle.create("RLE") && rle.valid();
+    [[maybe_unused]] lv_image_decoder_t* raw = rle.get();
+    rle.destroy();
+}
+
+[[maybe_unused]] static void test_image_codecs() {
+    [[maybe_unused]] bool ok = lv::register_image_codecs();
+    static lv::QoiDecoder qoi;
+    (void)qoi.create("QOI-2");
+    static_assert(lv::codec::kLz4HeaderSize == 20);
+}
+
+// ============================================================
+// Custom draw units
+// ============================================================
+
+class TestBlitter : public lv::DrawUnit<TestBlitter> {
+public:
+    static constexpr uint8_t unit_id = 40;
+    static constexpr const char* unit_name = "test_blitter";
+    static constexpr lv::DrawUnitCap accelerates[] = {
+        {LV_DRAW_TASK_TYPE_FILL, 20},
+        {LV_DRAW_TASK_TYPE_IMAGE, 60},
+    };
+
+    bool supports(lv::DrawTaskView t) const {
+        return t.type() != LV_DRAW_TASK_TYPE_FILL || t.fill_dsc()->radius == 0;
+    }
+
+    void draw(lv::DrawTaskView t, lv_layer_t*) { (void)t.draw_dsc(); }
+};
+
+class TestAsyncUnit : public lv::DrawUnit<TestAsyncUnit> {
+public:
+    static constexpr uint8_t unit_id = 41;
+    static constexpr lv::DrawUnitCap accelerates[] = {{LV_DRAW_TASK_TYPE_IMAGE, 50}};
+
+    bool draw(lv::DrawTaskView, lv_layer_t*) { return false; }   // finish() from the IRQ
+    void wait() {}
+};
+
+[[maybe_unused]] static void test_draw_unit() {
+    static TestBlitter blitter;
+    static TestAsyncUnit async_unit;
+    [[maybe_unused]] bool ok = blitter.install() && async_unit.install();
+    async_unit.finish();
+    [[maybe_unused]] uint32_t won = blitter.claimed() + blitter.drawn();
+    [[maybe_unused]] bool busy = async_unit.busy();
+}
+
+// ============================================================
+// Threading
+// ============================================================
+
+static_assert(lv::render_threads() >= 1);
+static_assert(lv::Display::render_threads() == lv::render_threads());
+
+[[maybe_unused]] static void test_threading() {
+    lv::ui_thread();
+    [[maybe_unused]] bool ui = lv::is_ui_thread();
+    {
+        lv::LockGuard lock;
+        [[maybe_unused]] bool held = lv::holds_lock();
+        lv::LockGuard nested;    // recursive
+        lv::ui_thread();
+    }
+}
+
+// ============================================================
+// Pixel kernels
+// ============================================================
+
+[[maybe_unused]] static void test_pixel() {
+    static uint8_t argb[4 * 32];
+    static uint8_t rgb565[2 * 32];
+    lv::pixel::argb8888_to_rgb565(rgb565, argb, 32);
+    lv::pixel::argb8888_to_rgb565_dither(rgb565, argb, 32, 0, 0);
+    lv::pixel::argb8888_to_rgb565(argb, argb, 32);    // in place
+    lv::pixel::rgb565_swap(rgb565, 32);
+    lv::pixel::premultiply(argb, argb, 32);
+    lv::pixel::unpremultiply(argb, argb, 32);
+    lv::pixel::copy_opaque(argb, argb, 32);
+    [[maybe_unused]] lv::pixel::Isa isa = lv::pixel::isa();
+    lv::pixel::force_isa(lv::pixel::Isa::scalar);
+
+    lv::MemoryDisplay<64, 32> display;
+    lv::pixel::convert_on_flush(display, lv::pixel::FlushConvert::rgb565_dither_swap);
+    lv::pixel::convert_on_flush(display, lv::pixel::FlushConvert::none);
+
+    static uint8_t rotated[4 * 32];
+    lv::pixel::rotate_xrgb8888(rotated, 4 * 4, argb, 4 * 8, 8, 4, LV_DISPLAY_ROTATION_90);
+    lv::pixel::rotate_rgb565(rotated, 2 * 8, rgb565, 2 * 8, 8, 4, LV_DISPLAY_ROTATION_180, true);
+    lv::pixel::rotate_xrgb8888_to_rgb565(rotated, 2 * 4, argb, 4 * 8, 8, 4, LV_DISPLAY_ROTATION_270, true, false, 0, 0);
+    lv::pixel::rotate_on_flush(display);
+    lv::pixel::rotate_on_flush(display, false);
+    display.rotation(LV_DISPLAY_ROTATION_90);
+    lv::pixel::rotate_on_flush(display);
+}
+
+static_assert(lv::pixel::detail::rotate_pos(LV_DISPLAY_ROTATION_90, 8, 4, 0, 0).x == 3);
+
+// ============================================================
+// Batch color operations
+// ============================================================
+
+[[maybe_unused]] static void test_color_batch(lv::Canvas canvas) {
+    static lv_color32_t ramp[256];
+    static lv_color_t base[40], accent[40], tints[40];
+    static lv_color_hsv_t hsv[40];
+    static uint8_t levels[64];
+    lv::color::gradient(ramp, lv::rgb(0x1a237e), lv::rgb(0xffeb3b));
+    lv::color::gradient(std::span<lv_color_t>(tints), lv::rgb(0x000000), lv::rgb(0xffffff));
+    lv::color::mix(tints, base, accent, 64);
+    lv::color::mix(tints, base, lv::rgb(0xff0000), LV_OPA_30);
+    lv::color::lookup(canvas.row32(0), levels, ramp);
+    lv::color::lookup(tints, levels, std::span<const lv_color_t>(base, 4));
+    lv::color::hsv_to_rgb(tints, hsv);
+    lv::color::rgb_to_hsv(hsv, tints);
+    std::span<lv_color32_t> row = canvas.row32(1);
+    lv::color::premultiply(row);
+    lv::color::fade(row, LV_OPA_50);
+    lv::color::fade_premultiplied(row, LV_OPA_50);
+    lv::color::mix(row, row, std::span<const lv_color32_t>(ramp, row.size()), 128);
+}
+
+static_assert(lv::color::detail::div255(255 * 255) == 255);
+
+static_assert(lv::pixel::detail::to565(0xFFFFFFFF) == 0xFFFF);
+static_assert(lv::pixel::detail::to565(0xFFFF0000) == 0xF800);
+static_assert(lv::pixel::detail::premul(0x80FF8040) == 0x80804020);
+
+// ============================================================
+// Page-flipping displays
+// ============================================================
+
+#if defined(__linux__) && LV_USE_LINUX_DRM
+[[maybe_unused]] static void test_drm_flip_display() {
+    static lv::DRMFlipDisplay display("/dev/dri/card0", lv::FlushMode::partial);
+    if (!display.ok()) return;
+    lv::EventLoop loop;
+    loop.watch<&lv::DRMFlipDisplay::on_readable>(display.fd(), &display);
+    [[maybe_unused]] bool pending = display.flip_pending();
+    [[maybe_unused]] uint32_t flips = display.flips();
+    [[maybe_unused]] uint32_t hz = display.refresh_rate();
+}
+
+[[maybe_unused]] static void test_drm_hotplug(lv::EventLoop& loop) {
+    static lv::DRMFlipDisplay display("/dev/dri/card0", lv::FlushMode::direct);
+    if (!display.ok()) return;
+    static lv::DRMHotplug hotplug(display);
+    loop.watch<&lv::DRMHotplug::on_readable>(hotplug.fd(), &hotplug);
+    [[maybe_unused]] bool switched = display.set_mode(1280, 720, 60) || display.hotplug();
+    [[maybe_unused]] uint32_t n = display.mode_changes() + hotplug.events() + display.mode_info().hdisplay;
+    [[maybe_unused]] bool plugged = display.connected();
+}
+
+[[maybe_unused]] static void test_drm_cursor(lv_indev_t* mouse) {
+    static lv::DRMFlipDisplay display("/dev/dri/card0");
+    if (!display.cursor(mouse, &lv::cursor_arrow)) return;
+    [[maybe_unused]] bool shown = display.has_cursor() && lv::hw_cursor::following(mouse);
+    display.hide_cursor();
+}
+#endif
+
+// ============================================================
+// Hardware cursor
+// ============================================================
+
+[[maybe_unused]] static void test_hw_cursor(lv_indev_t* mouse) {
+    lv::hw_cursor::follow(mouse, [](void*, int32_t x, int32_t y) { (void)x; (void)y; });
+    lv::hw_cursor::repeat(mouse);
+    const lv::hw_cursor::Stats st = lv::hw_cursor::stats();
+    [[maybe_unused]] uint32_t n = st.reads + st.moves;
+    lv::hw_cursor::reset_stats();
+    lv::hw_cursor::unfollow(mouse);
+#if LV_USE_SDL
+    [[maybe_unused]] bool sdl = lv::SDLDisplay::cursor(&lv::cursor_arrow, 0, 0) && lv::SDLDisplay::cursor(nullptr);
+#endif
+}
+
+// ============================================================
+// Coalesced keypad navigation
+// ============================================================
+
+[[maybe_unused]] static void test_key_nav(lv_indev_t* keypad, lv::ObjectView grid) {
+    [[maybe_unused]] bool ok = lv::key_nav::attach(keypad) && lv::key_nav::attached(keypad);
+    lv::key_nav::add(grid.get(), [](lv_obj_t*, void*, int32_t dx, int32_t dy) { (void)dx; (void)dy; },
+                     nullptr, lv::key_nav::vertical);
+    lv::key_nav::repeat_timing(keypad, 500, 80);
+    lv::key_nav::flush();
+    const lv::key_nav::Stats st = lv::key_nav::stats();
+    [[maybe_unused]] uint32_t n = st.steps + st.moves + st.max_batch;
+    lv::key_nav::reset_stats();
+    lv::key_nav::remove(grid.get());
+    lv::key_nav::detach(keypad);
+
+    lv::Group group;
+    group.focus_by(5).focus_by(-2);
+}
+
+#if defined(__linux__) && LV_USE_LINUX_FBDEV
+[[maybe_unused]] static void test_fb_flip_display() {
+    lv::FBFlipDisplay display("/dev/fb0", lv::FlushMode::direct);
+    [[maybe_unused]] bool ok = display.ok() && display.mode() == lv::FlushMode::direct;
+    [[maybe_unused]] uint32_t front = display.front();
+}
+
+[[maybe_unused]] static void test_fb_in_place_display() {
+    static lv::FBFlipDisplay display("/dev/fb0", lv::FlushMode::in_place);
+    [[maybe_unused]] bool ok = display.ok() && display.mode() == lv::FlushMode::in_place;
+    [[maybe_unused]] uint32_t frames = display.flips();
+}
+#endif
+
+// ============================================================
+// Dirty-region tracking
+// ============================================================
+
+[[maybe_unused]] static void test_dirty_regions() {
+    lv::perf::DirtyRegions dirty = lv::perf::dirty_regions();
+    dirty.find_culprits(true)
+         .show_overlay()
+         .on_frame([](const lv::perf::DirtyFrame& f, void*) {
+             [[maybe_unused]] float coverage = f.coverage();
+             for (uint32_t i = 0; i < f.invalidated_count; ++i) (void)f.invalidated[i].culprit;
+         });
+    const lv::perf::DirtyFrame& last = dirty.last();
+    [[maybe_unused]] uint32_t merged = last.merged_count;
+    uint32_t n = 0;
+    [[maybe_unused]] const lv::perf::DirtyCulprit* culprits = dirty.culprits(n);
+    [[maybe_unused]] lv::ObjectView top = dirty.top_culprit();
+    dirty.log_culprits();
+    dirty.reset();
+    dirty.hide_overlay();
+    dirty.stop();
+}
+
+// ============================================================
+// Draw profile
+// ============================================================
+
+#if LV_USE_DRAW_SW
+[[maybe_unused]] static void test_draw_profile() {
+    lv::perf::DrawProfile prof = lv::perf::draw_profile(nullptr, 500);
+    prof.show_overlay()
+        .on_window([](const lv::perf::DrawSample& s, void*) {
+            [[maybe_unused]] uint64_t shadow = s.type(LV_DRAW_TASK_TYPE_BOX_SHADOW).total_us;
+            [[maybe_unused]] uint64_t grad = s.gradient_us;
+        });
+    [[maybe_unused]] const lv::perf::DrawSample& last = prof.snapshot();
+    uint32_t n = 0;
+    [[maybe_unused]] const lv::perf::DrawCost* costs = prof.costs(n);
+    if (const lv::perf::DrawCost* top = prof.top()) {
+        [[maybe_unused]] const char* type = lv::perf::draw_task_type_name(top->type);
+        [[maybe_unused]] uint32_t avg = top->avg_us();
+    }
+    [[maybe_unused]] uint32_t evicted = prof.evicted();
+    prof.log_costs();
+    prof.reset();
+    prof.hide_overlay();
+    prof.stop();
+}
+#endif
+
+// ============================================================
+// Async image decoding
+// ============================================================
+
+#if LV_USE_IMAGE
+[[maybe_unused]] static void test_image_loader() {
+    static const char* placeholder = LV_SYMBOL_IMAGE;
+    lv::image_loader::set_concurrency(2);
+    lv::image_loader::set_placeholder(placeholder);
+    lv::image_loader::set_fade(150);
+    lv::Image icon = lv::Image::create(lv::screen_active());
+    icon.src_async("A:/icons/home.png");
+    lv::Image::create(lv::screen_active()).src_async("A:/icons/home.png", placeholder, 0);
+    [[maybe_unused]] uint32_t waiting = lv::image_loader::pending() + lv::image_loader::cached();
+    [[maybe_unused]] bool queued = lv::image_loader::load(icon.get(), "A:/icons/gear.png");
+    lv::image_loader::shutdown();
+}
+#endif
+
+// ============================================================
+// Sprite sheets
+// ============================================================
+
+inline constexpr lv::AtlasRect kTestIconRects[] = {
+    {"battery", 0, 0, 16, 16},
+    {"wifi", 16, 0, 16, 16},
+};
+
+[[maybe_unused]] static void test_atlas(const lv_image_dsc_t& sheet) {
+    static lv::Atlas icons(sheet, kTestIconRects);
+    static_assert(decltype(icons)::capacity() == 2);
+    [[maybe_unused]] const lv_image_dsc_t* battery = icons["battery"];
+    [[maybe_unused]] const lv_image_dsc_t* first = icons[0];
+    [[maybe_unused]] int32_t wifi = icons.find("wifi");
+    static lv::Atlas<8> runtime(sheet, kTestIconRects, 2);
+    runtime.load(sheet, kTestIconRects, 1);
+    [[maybe_unused]] size_t n = runtime.size();
+}
+
+// ============================================================
+// Frame decode-ahead
+// ============================================================
+
+[[maybe_unused]] static bool test_idle_fn(uint32_t) { return false; }
+
+[[maybe_unused]] static void test_frame_ahead(lv::ObjectView parent, const lv_image_dsc_t& gif_bytes) {
+    [[maybe_unused]] bool installed = lv::idle_handler(&test_idle_fn);
+    lv::remove_idle_handler(&test_idle_fn);
+
+    auto img = lv::Image::create(parent);
+    lv::GifPlayer gif = lv::GifPlayer::play(img, "A:/anim/loading.gif");
+    lv::GifPlayer ring = lv::GifPlayer::play(lv::Image::create(parent), &gif_bytes, {.ahead = 4, .cache_loop = false});
+    if (gif) {
+        gif.pause();
+        gif.resume();
+        gif.restart();
+    }
+    [[maybe_unused]] bool cached = ring.fully_cached();
+    [[maybe_unused]] uint32_t frames = ring.frame_count() + ring.bytes();
+    ring.stop();
+
+    static const void* walk[] = {"A:/walk/0.png", "A:/walk/1.png", &gif_bytes};
+    auto anim = lv::AnimImage::create(parent);
+    [[maybe_unused]] bool ok = lv::frames::predecode(anim, walk, 3);
+    anim.duration(300).start();
+    lv::frames::release(anim);
+    [[maybe_unused]] bool more = lv::frames::run_idle(4);
+    [[maybe_unused]] lv::frames::Stats st = lv::frames::stats();
+}
+
+[[maybe_unused]] static void test_anim_clock(lv::ObjectView parent) {
+    auto& clock = lv::AnimationClock::shared().attach(lv_display_get_default());
+    auto walker = lv::AnimImage::create(parent);
+    [[maybe_unused]] bool added = clock.add(walker);
+#if LV_USE_GIF
+    lv::GIF fan(parent);
+    fan.src("A:/icons/fan.gif");
+    added = clock.add(fan) && clock.contains(fan);
+    clock.pause(fan).resume(fan);
+    clock.remove(fan);
+#endif
+    clock.pause().resume();
+    [[maybe_unused]] bool stopped = clock.paused();
+    const lv::AnimationClock::Stats& st = clock.stats();
+    [[maybe_unused]] uint32_t n = st.ticks + st.steps + st.skipped + st.media;
+    clock.reset_stats();
+    clock.detach();
+}
+
+[[maybe_unused]] static void test_visibility(lv::ObjectView parent) {
+    static lv::Timer blink = lv::Timer::create(500, []() {});
+    auto card = lv::Box::create(parent).pause_when_hidden();
+    auto spinner = lv::Spinner::create(card);
+    [[maybe_unused]] bool tied = lv::visibility::tie(card, blink) && lv::visibility::tie(card, spinner);
+    lv::anim_x(card, 0, 10).start();    // followed while card is watched
+    tied = lv::visibility::tie(card, spinner.get(), nullptr);
+    lv::visibility::period(50);
+    lv::visibility::check();
+    [[maybe_unused]] bool shown = lv::visibility::visible(card);
+    card.pause_when_hidden(false);
+    lv::visibility::untie(blink.get());
+    const lv::visibility::Stats st = lv::visibility::stats();
+    [[maybe_unused]] uint32_t n = st.checks + st.hides + st.shows + st.watched + st.overflow;
+    lv::visibility::reset_stats();
+}
+
+#if LV_USE_LOTTIE
+[[maybe_unused]] static void test_lottie_cache(lv::ObjectView parent, const uint8_t* json, size_t size) {
+    static uint8_t buf[64 * 64 * 4];
+    auto lottie = lv::Lottie::create(parent).buffer(64, 64, buf).src_data(json, size);
+    [[maybe_unused]] bool whole = lv::frames::cache(lottie, {.max_bytes = 512 * 1024, .cf = LV_COLOR_FORMAT_ARGB8565});
+    [[maybe_unused]] bool ring = lv::frames::cache(lottie, {.ahead = 2});
+    lottie.loop().pause().resume();
+    lv::frames::uncache(lottie);
+}
+#endif
+
+// ============================================================
+// Shared vector paths
+// ============================================================
+
+#if LV_USE_VECTOR_GRAPHIC
+[[maybe_unused]] static void test_shared_path(lv_layer_t* layer, float zoom) {
+    lv::VectorPath built(LV_VECTOR_PATH_QUALITY_HIGH);
+    built.move_to(10, 10).cubic_to(10, 60, 60, 60, 60, 10).close();
+    static lv::SharedPath shape(std::move(built));
+    lv::SharedPath again = shape;
+    [[maybe_unused]] uint16_t refs = again.use_count();
+    [[maybe_unused]] lv_area_t box = shape.bounding_box();
+
+    lv::path_cache::install();
+    lv::VectorDsc dsc(layer);
+    dsc.scale(zoom).fill_color(lv::rgb(0x2196F3)).add_path(shape).draw();
+    [[maybe_unused]] const lv_matrix_t& m = dsc.matrix();
+
+    [[maybe_unused]] lv::path_cache::Stats st = lv::path_cache::stats();
+    lv::path_cache::reset_stats();
+    lv::path_cache::drop();
+}
+#endif
+
+// ============================================================
+// Gradient ramp cache
+// ============================================================
+
+[[maybe_unused]] static void test_gradient_cache(lv::ObjectView card, lv_layer_t* layer) {
+    static auto fade = lv::GradDsc()
+        .stop(lv::rgb(0xFF5F6D), 0)
+        .stop(lv::rgb(0xFFC371), 160)
+        .stop(lv::rgb(0x2C3E50), 255)
+        .vertical();
+    lv::grad_cache::bake_bg(card, fade);
+    lv::grad_cache::unbake_bg(card);
+
+    [[maybe_unused]] bool baked = lv::grad_cache::draw(layer, fade, lv_area_t{0, 0, 99, 49}, 8);
+    [[maybe_unused]] const lv_color32_t* ramp = lv::grad_cache::lut(fade, 256);
+
+    [[maybe_unused]] lv::grad_cache::Stats st = lv::grad_cache::stats();
+    lv::grad_cache::reset_stats();
+    lv::grad_cache::drop();
+}
+
+// ============================================================
+// Cached layers
+// ============================================================
+
+#if LV_USE_SNAPSHOT
+[[maybe_unused]] static void test_cached_layer(lv::ObjectView parent) {
+    auto dash = lv::CachedLayer::create(parent).size(240, 240);
+    lv::Label::create(dash).text("km/h");
+    dash.invalidate_cache();
+    [[maybe_unused]] bool cached = dash.is_cached();
+    [[maybe_unused]] uint32_t bytes = dash.cache_bytes();
+
+    auto panel = lv::Box::create(parent).cache_as_bitmap(true);
+    lv::cached_layer::invalidate(panel);
+    panel.cache_as_bitmap(false);
+
+    [[maybe_unused]] lv::cached_layer::Stats st = lv::cached_layer::stats();
+    lv::cached_layer::reset_stats();
+    lv::cached_layer::drop();
+}
+#endif
+
+// ============================================================
+// Kinetic scrolling
+// ============================================================
+
+[[maybe_unused]] static void test_kinetic_scroll(lv::ObjectView parent) {
+    auto list = lv::Box::create(parent).size(240, 320);
+    for (int i = 0; i < 100; ++i) lv::Label::create(list).text("row");
+    lv::kinetic_scroll::enable(list);
+    lv::kinetic_scroll::enable(list, {.decay_ms = 250, .margin_px = 96});    // retune
+    lv::kinetic_scroll::fling(list, 0.0f, -2400.0f);
+    [[maybe_unused]] bool moving = lv::kinetic_scroll::flinging(list);
+    lv::kinetic_scroll::stop(list);
+    lv::kinetic_scroll::invalidate(list);
+    [[maybe_unused]] lv::kinetic_scroll::Stats st = lv::kinetic_scroll::stats();
+    lv::kinetic_scroll::reset_stats();
+    lv::kinetic_scroll::disable(list);
+}
+
+#if LV_USE_SNAPSHOT && LV_USE_SCALE && LV_USE_LINE
+[[maybe_unused]] static void test_scale_cache(lv::ObjectView parent) {
+    auto gauge = lv::Scale::create(parent).mode_round_inner().range(0, 60).ticks(31, 5);
+    lv_obj_t* needle = lv_line_create(gauge);
+    gauge.cache_static(true);
+    lv_scale_set_line_needle_value(gauge, needle, 80, 42);
+    gauge.range(0, 80);                          // fingerprint changes: retaken
+    [[maybe_unused]] bool cached = gauge.is_static_cached();
+    lv::cached_layer::enable(parent, lv::cached_layer::Content::self);
+    gauge.cache_static(false);
+}
+#endif
+
+// ============================================================
+// Key atlas
+// ============================================================
+
+#if LV_USE_KEYBOARD
+[[maybe_unused]] static void test_key_atlas(lv::ObjectView parent) {
+    auto kb = lv::Keyboard::create(parent);
+    [[maybe_unused]] bool on = lv::key_atlas::enable(kb);
+    [[maybe_unused]] bool enabled = lv::key_atlas::enabled(kb);
+    lv::key_atlas::refresh(kb);
+
+    static const char* const keys[] = {"1", "2", "3", "\n", "4", "5", "6", ""};
+    auto pad = lv::ButtonMatrix::create(parent).map(keys);
+    lv::key_atlas::enable(pad);
+    lv::key_atlas::disable(pad);
+
+    [[maybe_unused]] lv::key_atlas::Stats st = lv::key_atlas::stats();
+    lv::key_atlas::reset_stats();
+    lv::key_atlas::drop();
+}
+#endif
+
+// ============================================================
+// Tiled rendering
+// ============================================================
+
+[[maybe_unused]] static void test_tiled_display() {
+    lv::Display disp = lv::Display::get_default();
+    lv::TileConfig cfg;
+    cfg.tile_w = 64;
+    cfg.tile_h = 64;
+    cfg.tiles = 4;
+    lv::tile_render::enable(disp, cfg);
+    [[maybe_unused]] bool tiled = lv::tile_render::enabled(disp);
+    [[maybe_unused]] lv::tile_render::Stats st = lv::tile_render::stats(disp);
+    lv::tile_render::reset_stats(disp);
+    lv::tile_render::disable(disp);
+}
+
+// ============================================================
+// Adaptive refresh rate
+// ============================================================
+
+[[maybe_unused]] static void test_adaptive_refresh() {
+    lv::Display disp = lv::Display::get_default();
+    lv::RefreshConfig cfg;
+    cfg.boost_ms = 11;              // 90 Hz while scrolling
+    cfg.normal_ms = 33;
+    cfg.idle_ms = 0;                // event-driven when idle
+    cfg.idle_after_ms = 500;
+    disp.adaptive_refresh(cfg);
+    [[maybe_unused]] bool idle = disp.refresh_mode() == lv::refresh_rate::Mode::idle;
+    [[maybe_unused]] bool on = lv::refresh_rate::enabled(disp);
+    [[maybe_unused]] lv::refresh_rate::Stats st = lv::refresh_rate::stats(disp);
+    lv::refresh_rate::reset_stats(disp);
+    disp.fixed_refresh();
+}
+
+// ============================================================
+// Diagnostics screen
+// ============================================================
+
+#if LV_USE_CHART && LV_USE_LABEL
+[[maybe_unused]] static void test_diagnostics() {
+    static lv::diagnostics::Screen diag;
+    diag.mount_and_load();
+    diag.period(LV_CPP_SYSMON_PERIOD);
+    const lv::diagnostics::Stats& st = diag.stats();
+    [[maybe_unused]] uint32_t n = st.windows + st.updates + st.points + st.self_us + st.self_pct_x100;
+    diag.reset_stats();
+    diag.unmount_screen();
+}
+#endif
+
+// ============================================================
+// Display mode changes
+// ============================================================
+
+[[maybe_unused]] static void test_display_mode() {
+    lv::Display disp = lv::Display::get_default();
+    disp.pooled_buffers(48);
+    lv::display_mode::listen([](const lv::display_mode::Change& c, void*) {
+        [[maybe_unused]] bool both = c.resized() && c.rescaled();
+    });
+    [[maybe_unused]] bool changed = disp.resize(1280, 720, 200);
+    const lv::display_mode::Stats st = lv::display_mode::stats();
+    [[maybe_unused]] uint32_t n = st.changes + st.rebuffers + st.images + st.last_us;
+    lv::display_mode::reset_stats();
+}
+
+// ============================================================
+// Kept frame for instant resume
+// ============================================================
+
+[[maybe_unused]] static void test_resume(lv_display_t* disp) {
+    [[maybe_unused]] bool kept = lv::resume::keep_frame(disp);
+    [[maybe_unused]] bool ready = lv::resume::has_frame(disp);
+    lv::resume::suspend(disp);
+    [[maybe_unused]] bool asleep = lv::resume::suspended(disp);
+    [[maybe_unused]] bool shown = lv::resume::resume(disp);
+    lv::resume::suspend(disp, "A:/var/frame.bin");
+    lv::resume::resume(disp, "A:/var/frame.bin");
+    [[maybe_unused]] bool loaded = lv::resume::load(disp, "A:/var/frame.bin") && lv::resume::present(disp);
+    [[maybe_unused]] bool saved = lv::resume::save(disp, "A:/var/frame.bin");
+    const lv::resume::Stats st = lv::resume::stats();
+    [[maybe_unused]] uint32_t n = st.copies + st.presents + st.saves + st.loads + st.held + st.last_present_us;
+    lv::resume::reset_stats();
+    lv::resume::release(disp);
+}
+
+// ============================================================
+// Frame pacing for displays sharing one loop
+// ============================================================
+
+[[maybe_unused]] static void test_frame_pacing(lv::Display main_disp, lv::Display cluster) {
+    lv::PacingConfig cfg;
+    cfg.budget_us = 8000;
+    cfg.min_rows = 8;
+    lv::frame_pacing::enable(main_disp, cfg);
+    lv::frame_pacing::enable(cluster, {.budget_us = 0});
+    const lv::frame_pacing::Stats s = lv::frame_pacing::stats(cluster);
+    [[maybe_unused]] uint32_t jank = s.late_frames + s.interval_max_ms + s.render_max_us + s.render_avg_us;
+    [[maybe_unused]] uint32_t cuts = lv::frame_pacing::stats(main_disp).cut_frames;
+    [[maybe_unused]] bool on = lv::frame_pacing::enabled(main_disp);
+    lv::frame_pacing::reset_stats(main_disp);
+    lv::frame_pacing::disable(main_disp);
+}
+
+// ============================================================
+// Shadow / rounded mask cache
+// ============================================================
+
+[[maybe_unused]] static void test_shadow_cache(lv::ObjectView card, lv_layer_t* layer) {
+    lv::shadow_cache::budget(32 * 1024);
+    [[maybe_unused]] uint32_t cap = lv::shadow_cache::budget();
+    lv::shadow_cache::bake_shadow(card);
+    lv::shadow_cache::unbake_shadow(card);
+
+    lv::BoxShadowDsc sh;
+    sh.color(lv::rgb(0x000000)).width(24).spread(2).radius(12).opa(LV_OPA_40);
+    [[maybe_unused]] bool cached = lv::shadow_cache::draw(layer, sh, lv_area_t{10, 10, 209, 109});
+    lv::shadow_cache::fill_rounded(layer, lv_area_t{10, 10, 209, 109}, 12, lv::rgb(0xFFFFFF));
+
+    [[maybe_unused]] lv::shadow_cache::Stats st = lv::shadow_cache::stats();
+    lv::shadow_cache::reset_stats();
+    lv::shadow_cache::drop();
+}
+
+// ============================================================
+// QR encoder
+// ============================================================
+
+#if LV_USE_QRCODE
+[[maybe_unused]] static void test_qr_encoder(lv::ObjectView parent) {
+    auto qr = lv::QRCode(parent).size(150);
+    [[maybe_unused]] bool queued = lv::qr_encoder::update(qr, "https://lvgl.io", 15);
+    qr.data("https://lvgl.io");   // cancels the pending update
+    queued = lv::qr_encoder::update(qr, "\x01\x02", 2);
+    lv::qr_encoder::cancel(qr);
+
+    [[maybe_unused]] lv::qr_encoder::Stats st = lv::qr_encoder::stats();
+    lv::qr_encoder::drop();
+    lv::qr_encoder::shutdown();
+}
+#endif
+
+// ============================================================
+// glTF loader
+// ============================================================
+
+#if LV_USE_GLTF
+[[maybe_unused]] static void test_gltf_loader(lv::ObjectView parent) {
+    lv::gltf_loader::set_placeholder(nullptr);
+    auto viewer = lv::GLTF(parent).size(200, 150);
+    viewer.load_async("A:/models/cube.glb");
+    [[maybe_unused]] uint32_t waiting = lv::gltf_loader::pending();
+    [[maybe_unused]] uint32_t held = lv::gltf_loader::cached();
+}
+#endif
+
+// ============================================================
+// Arc cache
+// ============================================================
+
+#if LV_USE_ARC && LV_USE_SPINNER
+[[maybe_unused]] static void test_arc_cache(lv::ObjectView parent, lv_layer_t* layer) {
+    auto gauge = lv::Arc::create(parent);
+    lv::arc_cache::bake_arcs(gauge);
+    lv::arc_cache::unbake_arcs(gauge);
+
+    auto spinner = lv::Spinner::create(parent, 1000, 60);
+    lv::arc_cache::spinner(spinner, 24, 1000, 60);
+
+    lv_draw_arc_dsc_t arc;
+    lv_draw_arc_dsc_init(&arc);
+    arc.center = lv_point_t{50, 50};
+    arc.radius = 40;
+    arc.width = 8;
+    arc.start_angle = 30;
+    arc.end_angle = 120;
+    [[maybe_unused]] bool cached = lv::arc_cache::draw(layer, arc);
+
+    lv::arc_cache::budget(64 * 1024);
+    [[maybe_unused]] uint32_t cap = lv::arc_cache::budget();
+    [[maybe_unused]] lv::arc_cache::Stats st = lv::arc_cache::stats();
+    lv::arc_cache::reset_stats();
+    lv::arc_cache::drop();
+}
+#endif
+
+// ============================================================
+// Rotation cache
+// ============================================================
+
+#if LV_USE_IMAGE
+[[maybe_unused]] static void test_rotation_cache(lv::ObjectView parent) {
+    auto hand = lv::Image::create(parent);
+    hand.pivot(9, 90);
+    [[maybe_unused]] bool on = lv::rotation_cache::enable(hand, 5);
+    [[maybe_unused]] bool enabled = lv::rotation_cache::enabled(hand);
+    lv::rotation_cache::rotate(hand, 1234);   // drawn at 1235
+    [[maybe_unused]] bool all = lv::rotation_cache::precompute(hand);
+
+    lv::rotation_cache::budget(256 * 1024);
+    [[maybe_unused]] uint32_t cap = lv::rotation_cache::budget();
+    [[maybe_unused]] lv::rotation_cache::Stats st = lv::rotation_cache::stats();
+    lv::rotation_cache::reset_stats();
+    lv::rotation_cache::drop();
+    lv::rotation_cache::disable(hand);
+}
+#endif
+
+// ============================================================
+// Shaped text cache
+// ============================================================
+
+#if LV_USE_LABEL
+[[maybe_unused]] static void test_shaped_text_cache(lv::ObjectView screen, lv::Label title) {
+    title.text("\xD8\xA7\xD9\x84\xD8\xB3\xD8\xB1\xD8\xB9\xD8\xA9");   // "السرعة"
+    lv_obj_set_style_base_dir(title.get(), LV_BASE_DIR_RTL, 0);
+    [[maybe_unused]] bool on = lv::shaped_text_cache::enable(title);
+    [[maybe_unused]] bool enabled = lv::shaped_text_cache::enabled(title);
+    [[maybe_unused]] uint32_t n = lv::shaped_text_cache::enable_tree(screen);
+
+    lv::shaped_text_cache::budget(96 * 1024);
+    [[maybe_unused]] uint32_t cap = lv::shaped_text_cache::budget();
+    [[maybe_unused]] lv::shaped_text_cache::Stats st = lv::shaped_text_cache::stats();
+    lv::shaped_text_cache::dump();
+    lv::shaped_text_cache::reset_stats();
+    lv::shaped_text_cache::drop();
+    lv::shaped_text_cache::disable(title);
+}
+#endif
+
+// ============================================================
+// Texture stream (zero-copy DMA-BUF / OES frames)
+// ============================================================
+
+#if LV_USE_3DTEXTURE && LV_CPP_USE_EGL_IMPORT
+[[maybe_unused]] static void test_texture_stream(lv::ObjectView parent, EGLDisplay dpy, int fd, GLuint oes) {
+    static lv::TextureStream stream;
+    if (!stream.init(dpy, 2)) return;
+    stream.on_release([](void*, void*) {}, nullptr);
+    stream.attach(lv::Texture3D::create(parent).size(320, 240));
+
+    lv::DmaBufFrame f;
+    f.fourcc = lv::detail::texture_stream::fourcc('N', 'V', '1', '2');
+    f.w = 320;
+    f.h = 240;
+    f.planes[0] = {fd, 0, 320};
+    f.planes[1] = {fd, 320 * 240, 320};
+    f.n_planes = 2;
+    [[maybe_unused]] bool shown = stream.push(f);
+    [[maybe_unused]] bool ext = stream.push_external(oes, 320, 240);
+
+    lv::Draw3dDsc dsc;
+    dsc.texture(stream.texture());
+    [[maybe_unused]] uint32_t n = stream.in_flight();
+    [[maybe_unused]] lv::TextureStreamStats st = stream.stats();
+    stream.reset_stats();
+    stream.forget_imports();
+    stream.shutdown();
+}
+#endif
+
+// ============================================================
+// Occlusion culling
+// ============================================================
+
+[[maybe_unused]] static void test_occlusion(lv_display_t* disp) {
+    [[maybe_unused]] bool on = lv::occlusion::enable(disp);
+    [[maybe_unused]] bool enabled = lv::occlusion::enabled(disp);
+    auto modal = lv::Box::create(lv_layer_top()).size(lv::pct(100), lv::pct(100));
+    modal.bg_opa(LV_OPA_COVER);
+    [[maybe_unused]] lv::occlusion::Stats st = lv::occlusion::stats();
+    lv::occlusion::reset_stats();
+    lv::occlusion::disable(disp);
+}
+
+// ============================================================
+// Frame arena
+// ============================================================
+
+[[maybe_unused]] static void test_frame_arena(lv_display_t* disp) {
+    lv::FrameArena& arena = lv::FrameArena::instance();
+    arena.attach(disp);
+    [[maybe_unused]] void* raw = arena.alloc(64, 16);
+    [[maybe_unused]] lv_point_precise_t* pts = arena.make_array<lv_point_precise_t>(32);
+    [[maybe_unused]] lv_area_t* a = arena.make<lv_area_t>();
+    [[maybe_unused]] const char* s = arena.format("%d rpm", 1200);
+    [[maybe_unused]] char* c = arena.copy("label");
+    const lv::FrameArena::Marker m = arena.mark();
+    arena.rewind(m);
+#if LV_CPP_FRAME_ARENA_PMR
+    std::pmr::memory_resource* res = &arena;
+    [[maybe_unused]] void* p = res->allocate(32, 8);
+#endif
+    lv::LabelDsc dsc;
+    dsc.text_fmt("%d%%", 42);
+    lv::with_cstr(std::string_view("long text ..."), [](const char*) {});
+    [[maybe_unused]] lv::FrameArena::Stats st = arena.stats();
+    arena.reset_stats();
+    arena.reset();
+    arena.detach(disp);
+
+    lv::FrameArena local(1024);
+    [[maybe_unused]] const char* t = local.copy("own arena");
+}
+
+// ============================================================
+// 9-slice images
+// ============================================================
+
+LV_IMAGE_DECLARE(img_panel_32);
+
+[[maybe_unused]] static void test_nine_slice(lv_layer_t* layer, lv::ObjectView parent) {
+    static constexpr lv::NineSlice panel{&img_panel_32, 12, 12, 12, 12};
+    static constexpr lv::NineSlice tiled{&img_panel_32, 8, 8, 8, 8, lv::SliceFill::repeat, lv::SliceFill::repeat};
+    lv::ImageDsc dsc;
+    dsc.opa(LV_OPA_80);
+    lv::draw::image_nine_slice(layer, dsc, lv::area(0, 0, 399, 239), panel);
+    lv::draw::image_nine_slice(layer, lv::ImageDsc{}, lv::area_from_size(0, 250, 300, 40), tiled);
+    lv::Image::create(parent).size(400, 240).nine_slice(panel);
+}
+
+// ============================================================
+// Density variants
+// ============================================================
+
+LV_IMAGE_DECLARE(img_logo_1x);
+LV_IMAGE_DECLARE(img_logo_2x);
+
+[[maybe_unused]] static void test_image_set(lv::ObjectView parent) {
+    static constexpr lv::ImageSet logo{{{lv::density::x1, &img_logo_1x}, {lv::density::x2, &img_logo_2x}}};
+    lv::Image::create(parent).src(logo);
+    [[maybe_unused]] lv::ResolvedImage r = logo.resolve(195);
+    [[maybe_unused]] uint32_t rescaled = lv::image_set::rescale(lv_display_get_default());
+    [[maybe_unused]] lv::image_set::Stats s = lv::image_set::stats();
+    lv::image_set::reset_stats();
+    lv::image_set::drop_all();
+}
+
+// ============================================================
+// Triangle meshes and polylines
+// ============================================================
+
+[[maybe_unused]] static void test_draw_mesh(lv_layer_t* layer) {
+    static const lv_point_precise_t quad[] = {{10, 10}, {110, 10}, {110, 60}, {10, 60}};
+    static const uint16_t idx[] = {0, 1, 2, 0, 2, 3};
+    static const lv_color32_t cols[] = {{0, 0, 255, 255}, {0, 255, 0, 255}, {255, 0, 0, 255}, {255, 255, 255, 128}};
+    lv::draw::triangles(layer, quad, 4, idx, 6, cols);
+    lv::draw::triangles(layer, quad, 3, nullptr, 0, lv::rgb(0x2080F0), LV_OPA_50);
+
+    static const lv_point_precise_t pts[] = {{0, 80}, {20, 70}, {40, 90}, {60, 75}};
+    lv::LineDsc dsc;
+    dsc.color(lv::rgb(0x20C060)).width(3).round_start().round_end();
+    lv::draw::polyline(layer, pts, 4, dsc);
+
+    [[maybe_unused]] lv::mesh::MeshUnit& unit = lv::mesh::MeshUnit::instance();
+    [[maybe_unused]] lv::mesh::Stats st = lv::mesh::stats();
+    lv::mesh::reset_stats();
+}
+
+// ============================================================
+// Table bulk fill
+// ============================================================
+
+[[maybe_unused]] static void test_table_bulk(lv::Table table, const int32_t (*values)[3]) {
+    table.assign(500, 3, [&](uint32_t row, uint32_t col, char* buf, uint32_t size) {
+        lv_snprintf(buf, size, "%d", static_cast<int>(values[row][col]));
+    });
+    table.update_rows(100, 50, [&](uint32_t row, uint32_t col, char* buf, uint32_t size) {
+        if (col == 0) lv_snprintf(buf, size, "#%u", static_cast<unsigned>(row));
+    });
+    table.remeasure();
+    lv::table_bulk::assign(table, 500, 3, [&](uint32_t row, uint32_t col, char* buf, uint32_t size) {
+        lv_snprintf(buf, size, "%d", static_cast<int>(values[row][col]));
+    });
+    lv::table_bulk::update_rows(table, 100, 50, [](uint32_t row, uint32_t col, char* buf, uint32_t size) {
+        if (col == 0) lv_snprintf(buf, size, "#%u", static_cast<unsigned>(row));
+    });
+}
+
+// ============================================================
+// Text layout cache
+// ============================================================
+
+[[maybe_unused]] static void test_text_cache(lv::Label label, lv::Table table, lv::Spangroup spans) {
+    const lv_font_t* font = LV_FONT_DEFAULT;
+    [[maybe_unused]] lv_point_t sz = lv::text_cache::measure(font, "Battery 87 %", 0, 0, 120);
+    lv::text_lines::install();
+    lv::text_cache::Layout l = lv::text_cache::layout(label, "two\nlines", 80);
+    [[maybe_unused]] uint32_t first_width = l.line_cnt ? static_cast<uint32_t>(l.lines[0].width) : 0;
+
+    label.text("OK").text("OK");                  // second set skipped
+    [[maybe_unused]] lv_point_t ls = label.text_size();
+    [[maybe_unused]] lv_point_t lm = label.measure(100);
+    table.cell_value(0, 0, "idle").cell_value(0, 0, "idle");
+    [[maybe_unused]] lv_point_t cs = table.cell_text_size(0, 0, 60);
+#if LV_USE_SPAN && LV_VERSION_AT_LEAST(9, 2, 0)
+    lv_span_t* span = spans.new_span();
+    lv::Spangroup::span_text(span, "rich");
+    [[maybe_unused]] lv_point_t ss = spans.span_text_size(span);
+#else
+    (void)spans;
+#endif
+
+    [[maybe_unused]] lv::text_cache::Stats st = lv::text_cache::stats();
+    lv::text_cache::reset_stats();
+    lv::text_cache::drop(font);
+    lv::text_cache::drop();
+}
+
+// ============================================================
+// Incremental span updates
+// ============================================================
+
+#if LV_USE_SPAN
+[[maybe_unused]] static void test_span_update(lv::Spangroup chat) {
+    lv_span_t* name = chat.new_span();
+    lv_span_t* typing = chat.new_span();
+    lv::Spangroup::span_text(name, "Anna: ");
+    chat.update_span_text(typing, "is typing...").update_span_text(typing, "is typing...");
+    chat.update_span(name, [&] { lv_style_set_text_color(lv::Spangroup::span_style(name), lv_color_hex(0x808080)); });
+
+    [[maybe_unused]] lv::span_layout::Stats st = lv::span_layout::stats();
+    lv::span_layout::reset_stats();
+}
+#endif
+
+// ============================================================
+// Canvas sessions
+// ============================================================
+
+#if LV_USE_CANVAS
+[[maybe_unused]] static void test_canvas_session(lv::Canvas canvas) {
+    lv::RectDsc bg;
+    bg.bg_color(lv::rgb(0xFFFFFF)).radius(4);
+    lv::LineDsc grid;
+    grid.points(0, 50, 199, 50).color(lv::rgb(0xCCCCCC)).width(1);
+    lv::LabelDsc caption;
+    char buf[16] = "42 V";
+    caption.text(buf).color(lv::rgb(0x000000));
+    {
+        auto s = canvas.begin();
+        s.rect(bg, lv::area(0, 0, 199, 99)).line(grid).label(caption, lv::area(4, 4, 120, 20));
+        [[maybe_unused]] uint32_t n = s.size();
+    }
+    auto part = canvas.begin(lv::area(196, 0, 199, 99));
+    part.rect(bg, lv::area(196, 0, 199, 99)).line(grid);
+    part.submit();
+    canvas.begin().cancel();
+
+    [[maybe_unused]] lv::canvas_session::Stats st = lv::canvas_session::stats();
+    lv::canvas_session::reset_stats();
+    lv::canvas_session::drop();
+}
+
+[[maybe_unused]] static void test_canvas_flip(lv::Canvas canvas) {
+    [[maybe_unused]] bool ok = canvas.double_buffer();
+    [[maybe_unused]] bool on = canvas.double_buffered();
+    lv::RectDsc bg;
+    bg.bg_color(lv::rgb(0xFFFFFF));
+    canvas.begin(lv::area(0, 0, 3, 99)).rect(bg, lv::area(0, 0, 3, 99)).submit();
+    lv_layer_t layer;
+    lv::canvas_flip::init_layer(canvas, layer);
+    lv::draw::rect(&layer, bg, lv::area(4, 0, 7, 99));
+    lv::canvas_flip::finish_layer(canvas, layer, lv::area(4, 0, 7, 99));
+    lv::canvas_flip::mark(canvas, lv::area(8, 0, 9, 9));
+    [[maybe_unused]] lv_draw_buf_t* back = lv::canvas_flip::back(canvas);
+    const lv::canvas_flip::Stats st = lv::canvas_flip::stats();
+    [[maybe_unused]] uint32_t n = st.flips + st.areas + st.merged + st.copied_px;
+    lv::canvas_flip::reset_stats();
+    canvas.double_buffer(false);
+}
+#endif
+
+// ============================================================
+// SVG caches
+// ============================================================
+
+#if LV_USE_SVG
+[[maybe_unused]] static void test_svg_cache(lv::ObjectView parent, lv_layer_t* layer) {
+    static lv::svg::Node gear("<svg width='24' height='24'><circle cx='12' cy='12' r='8'/></svg>");
+    lv::svg::draw(layer, gear);
+    lv::svg::draw(layer, gear, lv_area_t{0, 0, 47, 47});
+    lv::svg::Raster icon = lv::svg::raster(gear, 24, 24);
+    lv::svg::Raster same = icon;
+    if (icon) lv::Image::create(parent).src(same.src());
+    [[maybe_unused]] lv::svg::Stats st = lv::svg::stats();
+    [[maybe_unused]] uint32_t hits = st.compile_hits + st.raster_hits;
+    lv::svg::reset_stats();
+    lv::svg::drop_cache();
+}
+#endif
+
+// ============================================================
+// Image cache control
+// ============================================================
+
+[[maybe_unused]] static void test_image_cache() {
+    lv::image_cache::enable_stats();
+    lv::image_cache::set_budget(2 * 1024 * 1024);
+    [[maybe_unused]] bool on = lv::image_cache::enabled() && lv::image_cache::budget() > 0;
+    lv::image_cache::Stats s = lv::image_cache::stats();
+    [[maybe_unused]] uint32_t rate = s.hit_rate_pct() + s.entries + s.bytes + s.evictions;
+    lv::Screen screen;
+    [[maybe_unused]] bool pinned = lv::image_cache::pin("A:/icons/home.png", screen.get());
+    lv::image_cache::pin("A:/icons/logo.png");
+    [[maybe_unused]] uint32_t n = lv::image_cache::pinned();
+    lv::image_cache::unpin("A:/icons/logo.png");
+    lv::image_cache::unpin_screen(screen.get());
+    lv::image_cache::drop("A:/icons/home.png");
+    lv::image_cache::drop_all();
+    lv::image_cache::reset_stats();
+    lv::image_cache::dump();
+
+    lv::image_cache::header::set_budget(64);
+    [[maybe_unused]] lv::image_cache::Stats hs = lv::image_cache::header::stats();
+    [[maybe_unused]] uint32_t hb = lv::image_cache::header::budget();
+    lv::image_cache::header::drop("A:/icons/home.png");
+    lv::image_cache::header::drop_all();
+    [[maybe_unused]] uint32_t cached = lv::image_cache::entries() + lv::image_cache::header::entries();
+}
+
+// ============================================================
+// Buffered files
+// ============================================================
+
+[[maybe_unused]] static void test_buffered_file() {
+    lv::fs::BufferedFile cfg("A:/etc/app.conf");
+    std::string_view line;
+    while (cfg.read_line(line)) {
+        [[maybe_unused]] bool comment = !line.empty() && line[0] == '#';
+    }
+    cfg.seek(0);
+    std::string_view rec;
+    [[maybe_unused]] bool whole = cfg.read_record(16, rec);
+    char tok[16];
+    uint32_t n = 0;
+    cfg.read(tok, sizeof(tok), &n);
+    [[maybe_unused]] uint32_t pos = cfg.tell();
+    [[maybe_unused]] lv_fs_res_t res = cfg.result();
+
+    static uint8_t mem[512];
+    lv::fs::BufferedFile log(mem, sizeof(mem));
+    if (log.open("A:/log.txt", lv::fs::mode::write) == lv::fs::res::ok) {
+        log.write("boot\n");
+        log.write(tok, n);
+        log.flush();
+    }
+    const auto& s = log.stats();
+    [[maybe_unused]] uint32_t saved = s.saved() + s.calls + s.fs_reads + s.fs_writes + s.seeks + s.cut;
+    [[maybe_unused]] uint32_t cap = log.capacity();
+    log.reset_stats();
+    log.close();
+}
+
+// ============================================================
+// Asynchronous file I/O
+// ============================================================
+
+class AsyncGallery : public lv::Component<AsyncGallery> {
+    char m_thumb[256];
+    uint8_t* m_index = nullptr;
+
+    void on_index(lv::fs::IoResult& r) {
+        if (r.ok()) {
+            [[maybe_unused]] std::string_view json = r.text();
+            m_index = r.take();
+        }
+    }
+    void on_thumb(lv::fs::IoResult& r) { [[maybe_unused]] uint32_t n = r.bytes + r.id; }
+    void on_saved(lv::fs::IoResult& r) { [[maybe_unused]] bool ok = r.res == lv::fs::res::ok && !r.pooled; }
+
+public:
+    lv::ObjectView build(lv::ObjectView parent) {
+        return lv::Box::create(parent);
+    }
+    void on_mount() {
+        lv::fs::read_async<&AsyncGallery::on_index>("A:/photos/index.json", this);
+        const uint32_t id = lv::fs::read_async<&AsyncGallery::on_thumb>("A:/photos/1.bin", m_thumb, sizeof(m_thumb), this);
+        if (id) lv::fs::cancel(id);
+        lv::fs::write_async<&AsyncGallery::on_saved>("A:/photos/seen.txt", "1\n", 2, this, true);
+    }
+    void on_unmount() {
+        lv::fs::release_buffer(m_index);
+        m_index = nullptr;
+    }
+};
+
+[[maybe_unused]] static void test_fs_async() {
+    AsyncGallery gallery;
+    gallery.mount(lv::screen_active());
+    lv::fs::cancel_for(&gallery);
+    [[maybe_unused]] uint32_t busy = lv::fs::pending();
+    const lv::fs::IoStats s = lv::fs::io_stats();
+    [[maybe_unused]] uint64_t total = s.queued + s.completed + s.failed + s.cancelled + s.refused + s.bytes;
+    lv::fs::reset_io_stats();
+    lv::fs::shutdown_io();
+}
+
+// ============================================================
+// Worker pool with UI-thread continuations
+// ============================================================
+
+struct Forecast {
+    int32_t temps[7];
+    uint8_t days;
+};
+
+class WeatherCard : public lv::Component<WeatherCard> {
+    lv::Label m_label;
+
+    void on_forecast(Forecast& f) { m_label.text(lv::fmt<"{} days">(f.days).c_str()); }
+    void on_warmed() {}
+
+public:
+    lv::ObjectView build(lv::ObjectView parent) {
+        m_label = lv::Label::create(parent);
+        return m_label;
+    }
+    void on_mount() {
+        lv::executor().submit([] { return Forecast{{18, 19, 21, 20, 17, 16, 18}, 7}; })
+            .then_on_ui<&WeatherCard::on_forecast>(this);
+        const uint32_t id = lv::executor().submit([](const lv::CancelToken& tok) {
+            for (int i = 0; i < 1000 && !tok; ++i) {}
+        }).then_on_ui<&WeatherCard::on_warmed>(this);
+        if (id) lv::executor().cancel(id);
+    }
+};
+
+[[maybe_unused]] static void test_executor() {
+    WeatherCard card;
+    card.mount(lv::screen_active());
+    lv::executor().submit([] { return 42; }).detach();
+    lv::executor().cancel_for(&card);
+    [[maybe_unused]] uint32_t busy = lv::executor().pending();
+    const lv::ExecutorStats s = lv::executor().stats();
+    [[maybe_unused]] uint32_t total = s.submitted + s.completed + s.cancelled + s.stolen + s.refused;
+    lv::executor().reset_stats();
+    lv::executor().shutdown();
+}
+
+// ============================================================
+// ROM filesystem
+// ============================================================
+
+alignas(4) static constexpr uint8_t rom_hello[] = {'h', 'i', '\n'};
+alignas(4) static constexpr uint8_t rom_loader[] = {'{', '}'};
+
+static constexpr lv::fs::RomEntry rom_files[] = {
+    {"anim/loader.json", rom_loader, sizeof(rom_loader)},
+    {"hello.txt", rom_hello, sizeof(rom_hello)},
+};
+
+[[maybe_unused]] static void test_romfs() {
+    lv::fs::RomFs* rom = lv::fs::RomFs::mount('R', rom_files);
+    if (rom) {
+        [[maybe_unused]] const lv::fs::RomEntry* e = rom->find("/hello.txt");
+        [[maybe_unused]] uint32_t n = rom->file_count() + static_cast<uint32_t>(rom->letter());
+        for (const lv::fs::RomEntry& f : *rom) (void)f.size;
+    }
+    [[maybe_unused]] const lv::fs::RomEntry* any = lv::fs::RomFs::lookup("R:/anim/loader.json");
+
+    lv::fs::File f("R:/hello.txt");
+    char buf[4];
+    f.read(buf, sizeof(buf));
+    lv::fs::MappedFile in_place("R:/anim/loader.json");
+    [[maybe_unused]] bool zero_copy = in_place.is_mapped();
+    lv::fs::Directory dir("R:/anim");
+}
+
+// ============================================================
+// Directory listing cache and FileBrowser
+// ============================================================
+
+#if LV_USE_LIST
+class MediaPicker : public lv::Component<MediaPicker> {
+    lv::FileBrowser<24> m_browser{36};
+
+    void play(const char* path) { [[maybe_unused]] char first = path[0]; }
+
+public:
+    lv::ObjectView build(lv::ObjectView parent) {
+        auto box = lv::Box::create(parent);
+        m_browser.mount(box);
+        m_browser.on_select<&MediaPicker::play>(this);
+        m_browser.open("A:/media");
+        return box;
+    }
+    void back() {
+        if (!m_browser.up()) m_browser.reload();
+        [[maybe_unused]] bool done = m_browser.loaded() && m_browser.row_count() <= 24;
+        [[maybe_unused]] const char* at = m_browser.path();
+    }
+};
+#endif
+
+[[maybe_unused]] static void test_dir_cache() {
+    lv::fs::DirListing* dir = lv::fs::dir_cache::open("A:/media");
+    if (dir) {
+        while (!dir->complete()) dir->load(64);
+        for (uint32_t i = 0; i < dir->count(); ++i) {
+            const lv::fs::DirEntry e = dir->at(i);
+            [[maybe_unused]] bool skip = e.is_dir || e.name[0] == '.';
+        }
+        [[maybe_unused]] uint32_t v = dir->version() + dir->heap_bytes();
+        [[maybe_unused]] const char* p = dir->path();
+    }
+    lv::fs::dir_cache::release(dir);
+    lv::fs::dir_cache::invalidate("A:/media");
+    const lv::fs::dir_cache::Stats s = lv::fs::dir_cache::stats();
+    [[maybe_unused]] uint32_t total = s.hits + s.misses + s.reloads + s.evictions;
+    lv::fs::dir_cache::reset_stats();
+
+#if LV_USE_LIST
+    MediaPicker picker;
+    picker.mount(lv::screen_active());
+    picker.back();
+#endif
+}
+
+// ============================================================
+// Memory-mapped files and images
+// ============================================================
+
+[[maybe_unused]] static void test_mapped_file() {
+    lv::fs::MappedFile f("A:/data/lut.bin");
+    if (f) {
+        [[maybe_unused]] const uint8_t* bytes = f.data();
+        [[maybe_unused]] size_t n = f.size();
+        [[maybe_unused]] bool zero_copy = f.is_mapped();
+    }
+    lv::fs::MappedFile moved = std::move(f);
+    moved.close();
+
+    static lv::MappedImage wallpaper("A:/img/wallpaper.bin");
+    if (wallpaper) {
+        [[maybe_unused]] const void* src = wallpaper.src();
+        [[maybe_unused]] const lv_image_dsc_t* dsc = wallpaper.dsc();
+        [[maybe_unused]] uint32_t w = wallpaper.width() + wallpaper.height();
+        [[maybe_unused]] lv_color_format_t cf = wallpaper.color_format();
+    }
+    [[maybe_unused]] bool reopened = wallpaper.open("A:/img/night.bin");
+}
+
+[[maybe_unused]] static void test_mapped_font(lv::Label label, const uint8_t* flash_font, size_t flash_size) {
+    static lv::MappedFont inter("A:fonts/inter_14.bin");
+    if (inter) {
+        label.text_font(inter);
+        [[maybe_unused]] bool zero_copy = inter.in_place();
+        [[maybe_unused]] size_t heap = inter.heap_bytes();
+    }
+    lv::MappedFont rom;
+    [[maybe_unused]] bool ok = rom.open(flash_font, flash_size);
+    rom.fallback(inter.get());
+    lv::MappedFont moved = std::move(rom);
+
+    static lv::FontPack pack("A:fonts/inter.fpk");
+    if (const lv_font_t* f = pack.font(28)) label.text_font(f);
+    [[maybe_unused]] const lv_font_t* bold = pack.font(14, 1);
+    [[maybe_unused]] uint16_t sizes = pack.count() + pack.size_at(0);
+    [[maybe_unused]] size_t heap = pack.heap_bytes();
+}
+
+// ============================================================
+// Input-to-flush latency
+// ============================================================
+
+[[maybe_unused]] static void test_input_latency(lv::Indev& touch) {
+    [[maybe_unused]] lv_indev_read_cb_t driver = touch.read_cb();
+    lv::perf::InputLatency lat = lv::perf::input_latency(touch);
+    lat.corner_marker()
+       .on_marker([](bool level, void*) { (void)level; })
+       .on_sample([](uint32_t us, void*) { (void)us; });
+    lv::perf::InputLatencyStats s = lat.stats();
+    [[maybe_unused]] uint32_t p99 = s.p99_us + s.unanswered + s.coalesced;
+    lat.for_each_sample([](uint32_t us) { (void)us; });
+    lat.log();
+    lat.reset();
+    lat.corner_marker(false);
+    lat.stop();
+    [[maybe_unused]] bool none = lv::perf::input_latency(nullptr).active();
+}
+
+// ============================================================
+// Event-mode indev queue
+// ============================================================
+
+[[maybe_unused]] static void test_indev_queue(lv::Indev& touch) {
+    static lv::IndevQueue<32> queue;
+    queue.attach(touch.get()).coalesce(true).on_push([](void*) {});
+    [[maybe_unused]] bool event = touch.mode() == LV_INDEV_MODE_EVENT;
+    queue.push_point(10, 20, true);
+    queue.push_point(12, 24, true, lv_tick_get());
+    queue.push_key(lv::key::enter, false);
+    queue.push(lv::IndevSample{0, 0, 0, lv_tick_get(), false});
+    queue.read();
+    const auto& s = queue.stats();
+    [[maybe_unused]] uint32_t n = s.samples + s.coalesced + s.max_batch + s.max_latency_ms;
+    [[maybe_unused]] uint32_t waiting = queue.size() + queue.dropped() + queue.capacity();
+    queue.reset_stats();
+    queue.detach();
+    touch.mode(LV_INDEV_MODE_EVENT).read();
+}
+
+// ============================================================
+// Touch motion prediction
+// ============================================================
+
+[[maybe_unused]] static void test_touch_predict(lv::Indev& touch) {
+    touch.predict({.lead_ms = 24, .max_px = 40});
+    lv::PredictConfig cfg = lv::touch_predict::config(touch.get());
+    cfg.alpha = 0.6f;
+    lv::touch_predict::enable(touch.get(), cfg);
+    [[maybe_unused]] bool on = lv::touch_predict::enabled(touch.get());
+    lv::Box wheel = lv::Box::create(lv::screen_active());
+    lv::touch_predict::exclude(wheel);
+    lv::touch_predict::exclude(wheel, false);
+    lv::touch_predict::Stats s = lv::touch_predict::stats(touch.get());
+    [[maybe_unused]] uint32_t n = s.reads + s.predicted + s.excluded + s.max_lead_px;
+    lv::touch_predict::reset_stats(touch.get());
+    touch.no_predict();
+}
+
+// ============================================================
+// Gesture recognizers
+// ============================================================
+
+struct Pager {
+    void follow(const lv::gesture::Info& g) {
+        [[maybe_unused]] int32_t d = g.dx() + g.dy() + g.vx + g.vy;
+        [[maybe_unused]] bool done = g.phase == lv::gesture::Phase::end && g.dir == LV_DIR_LEFT;
+    }
+    void zoom(const lv::gesture::Info& g) { [[maybe_unused]] float f = g.scale + g.angle; }
+    void menu() {}
+};
+
+[[maybe_unused]] static void test_gestures(lv::Indev& touch) {
+    static Pager pager;
+    lv::gesture::Config cfg = lv::gesture::config();
+    cfg.fling_speed = 600;
+    lv::gesture::config(cfg);
+    lv::Box page = lv::Box::create(lv::screen_active());
+    page.on_pan<&Pager::follow>(&pager)
+        .on_fling<&Pager::follow>(&pager)
+        .on_pinch<&Pager::zoom>(&pager)
+        .on_rotate<&Pager::zoom>(&pager)
+        .on_hold<&Pager::menu>(&pager)
+        .on_double_tap<&Pager::menu>(&pager)
+        .recognize(lv::gesture::Kind::fling, [](const lv::gesture::Info&, void*) {});
+    const lv_point_t fingers[2] = {{10, 10}, {80, 90}};
+    lv::gesture::touches(touch.get(), fingers, 2);
+    lv::gesture::touches(touch.get(), nullptr, 0);
+    page.forget_gestures();
+    [[maybe_unused]] bool ok = lv::gesture::recognize(page, lv::gesture::Kind::pan, nullptr);
+}
+
+// ============================================================
+// Incremental flex
+// ============================================================
+
+[[maybe_unused]] static void test_flex_incremental() {
+    lv::Flex rows = lv::vbox(lv::screen_active()).gap(4);
+    [[maybe_unused]] bool on = lv::flex_incremental::enable(rows) && lv::flex_incremental::enabled(rows);
+    const lv::flex_incremental::Stats s = lv::flex_incremental::stats(rows);
+    [[maybe_unused]] uint32_t work = s.passes + s.fallbacks + s.visited + s.moved;
+    lv::flex_incremental::reset_stats(rows);
+    lv::flex_incremental::disable(rows);
+}
+
+// ============================================================
+// Soak runs
+// ============================================================
+
+#if LV_USE_MONKEY
+class SoakHome : public lv::Component<SoakHome> {
+public:
+    lv::ObjectView build(lv::ObjectView parent) { return lv::Box::create(parent); }
+};
+#endif
+
+[[maybe_unused]] static void test_soak() {
+#if LV_USE_MONKEY
+    static constexpr lv::soak::Screen screens[] = {
+        lv::soak::component<SoakHome>("home"),
+        {"labels", [](lv_obj_t* screen, void*) { lv::Label::create(screen).text("soak"); }},
+    };
+    lv::Monkey monkey(LV_INDEV_TYPE_POINTER, 10, 100);
+    lv::soak::Config cfg;
+    cfg.duration_ms = 8u * 3600u * 1000u;
+    cfg.report = "/tmp/soak.json";
+    const lv::soak::Result r = lv::soak::run(monkey, screens, cfg);
+    [[maybe_unused]] bool ok = r.passed() && !r.leaked() && !r.frame_regression && r.conclusive;
+    [[maybe_unused]] int64_t grew = r.heap.growth() + r.rss.growth() + r.objects.growth() + r.timers.growth();
+    [[maybe_unused]] uint32_t figures = r.samples + r.sample_ms + r.switches + r.frame_first_us + r.frame_last_us;
+    [[maybe_unused]] lv::soak::Result quick = lv::soak::run(monkey, 60u * 1000u);
+#endif
+}
+
+// ============================================================
+// Record and replay
+// ============================================================
+
+[[maybe_unused]] static void test_replay(lv::Bench& bench) {
+    static lv::State<int32_t> speed{0};
+    lv::replay::bind(0, speed);
+    [[maybe_unused]] bool started = lv::replay::start_recording();
+    lv::replay::set(speed, int32_t{42});
+    [[maybe_unused]] float temp = lv::replay::input(1, 21.5f);
+    [[maybe_unused]] bool rec = lv::replay::recording();
+    lv::replay::stop_recording();
+    const lv::replay::Stats st = lv::replay::stats();
+    [[maybe_unused]] uint32_t n = st.records + st.dropped + st.duration_ms + st.indevs;
+    [[maybe_unused]] bool saved = lv::replay::save("/tmp/trip.lvrp") && lv::replay::load("/tmp/trip.lvrp");
+
+    lv::replay::PlayConfig cfg;
+    cfg.save_baseline = "/tmp/trip.baseline";
+    cfg.report = "/tmp/replay.json";
+    const lv::replay::Result r = lv::replay::play(bench, cfg);
+    cfg.baseline = cfg.save_baseline;
+    cfg.save_baseline = nullptr;
+    const lv::replay::Result again = lv::replay::play(bench, cfg);
+    [[maybe_unused]] bool same = again.passed() && again.hash == r.hash && again.first_mismatch == UINT32_MAX &&
+                                 !again.regression && again.compared && !lv::replay::playing();
+    [[maybe_unused]] uint32_t us = r.frame_p50_us + r.frame_p99_us + again.base_p50_us + again.base_p99_us +
+                                   r.frames + r.applied + again.mismatched;
+}
+
+// ============================================================
+// Remote mirror
+// ============================================================
+
+[[maybe_unused]] static void test_remote_mirror(lv_display_t* disp, lv_group_t* group) {
+    static lv::remote::Mirror mirror;
+    [[maybe_unused]] bool ok = mirror.start([](const void* data, uint32_t size, void* user) -> int32_t {
+        (void)data;
+        return user ? static_cast<int32_t>(size) : 0;
+    }, nullptr, disp);
+    mirror.enable_input();
+    lv_indev_set_group(mirror.keypad_indev(), group);
+    static constexpr uint8_t tap[] = {16, 0, 0, 0, 5, 0, 0, 0, 10, 0, 20, 0, 1};
+    mirror.feed(tap, sizeof(tap));
+    mirror.inject_pointer(10, 20, false);
+    mirror.inject_key(LV_KEY_ENTER, true);
+    mirror.resync();
+    const lv::remote::MirrorStats& s = mirror.stats();
+    [[maybe_unused]] uint64_t work = s.frames + s.dropped + s.rects + s.pixels + s.bytes + s.stalls + s.resyncs +
+                                     s.inputs + s.bad_inputs + mirror.pending_rects();
+    mirror.reset_stats();
+    [[maybe_unused]] bool active = mirror.is_active() && mirror.pointer_indev();
+    mirror.stop();
+}
+
+// ============================================================
+// Snapshot encoders
+// ============================================================
+
+[[maybe_unused]] static void test_snapshot_encode(lv::ObjectView screen, int sock) {
+#if LV_USE_SNAPSHOT
+    lv::fs::File f("A:/tmp/shot.qoi", LV_FS_MODE_WR);
+    [[maybe_unused]] size_t n = lv::snapshot::encode(screen, lv::snapshot::Format::qoi, f);
+    lv::fs::File raw("A:/tmp/shot.bin", LV_FS_MODE_WR);
+    n += lv::snapshot::encode(screen, lv::snapshot::Format::raw, raw);
+    n += lv::snapshot::encode(screen, lv::snapshot::Format::png, [](const void* data, uint32_t size, void* user) {
+        (void)data;
+        (void)size;
+        return *static_cast<int*>(user) >= 0;
+    }, &sock, {.alpha = true});
+#else
+    (void)screen;
+    (void)sock;
+#endif
+}
+
+// ============================================================
+// Snapshot recorder
+// ============================================================
+
+[[maybe_unused]] static void test_snapshot_recorder(lv::ObjectView screen, lv::ObjectView preview) {
+#if LV_USE_SNAPSHOT
+    static lv::snapshot::Recorder full(screen);
+    static lv::snapshot::Recorder thumb(screen, {.scale = 4, .cf = LV_COLOR_FORMAT_RGB565});
+    if (thumb.capture()) {
+        lv_image_set_src(preview.get(), thumb.src());
+        lv_obj_invalidate(preview.get());
+    }
+    [[maybe_unused]] bool changed = full.capture();
+    full.invalidate();
+    [[maybe_unused]] const lv_draw_buf_t* buf = full.buf();
+    [[maybe_unused]] lv_obj_t* obj = thumb.object();
+    const lv::snapshot::RecorderStats& s = thumb.stats();
+    [[maybe_unused]] uint64_t work = s.captures + s.full + s.clean + s.pixels + s.last_us + s.max_us;
+    thumb.reset_stats();
+#endif
+}
+
+// ============================================================
+// Lazy fonts and images
+// ============================================================
+
+[[maybe_unused]] static void test_lazy_assets(lv::ObjectView screen, lv::AssetPack& assets) {
+    static lv::LazyFont title("A:fonts/inter_bold.ttf", 28, 34);
+    static lv::MappedFont body_font;
+    static lv::LazyFont body([](void* pack) -> const lv_font_t* {
+        return static_cast<lv::AssetPack*>(pack)->font("inter_14", body_font) ? body_font.get() : nullptr;
+    }, &assets, 14, "inter_14");
+    static lv::LazyImage map("A:img/map.bin");
+    static lv::LazyImage logo([](void* pack) -> const void* {
+        return static_cast<lv::AssetPack*>(pack)->image("logo");
+    }, &assets, "logo");
+    title.fallback(lv_font_get_default());
+    lv_obj_set_style_text_font(screen.get(), title, 0);
+    lv::prefetch::glyphs(body, 0x20, 0x7E);
+    body.prefetch();
+    [[maybe_unused]] const lv_font_t* real = title.resolve();
+    [[maybe_unused]] bool ready = title.loaded() && body.loaded();
+    map.apply(lv_image_create(screen.get()));
+    lv_image_set_src(lv_image_create(screen.get()), logo.src());
+    logo.prefetch();
+    [[maybe_unused]] bool shown = map.loaded();
+    { lv::startup::Span span("load settings"); }
+}
+
+// ============================================================
+// Asset pack
+// ============================================================
+
+[[maybe_unused]] static void test_asset_pack(lv::ObjectView screen) {
+    static lv::AssetPack assets("A:/data/ebike.lap");
+    static lv::MappedFont body;
+    static lv::translation::BinaryPack texts;
+    if (!assets) return;
+    if (assets.font("inter_14", body)) lv_obj_set_style_text_font(screen.get(), body, 0);
+    if (assets.translations("ebike", texts)) texts.use();
+    if (const lv_image_dsc_t* bg = assets.image("bg")) lv_image_set_src(lv_image_create(screen.get()), bg);
+    constexpr uint32_t logo = lv::asset_hash("logo");
+    [[maybe_unused]] const lv_image_dsc_t* dsc = assets.image(logo);
+    const lv::Asset config = assets.find("config.json");
+    [[maybe_unused]] bool raw = config && config.kind == lv::AssetKind::raw;
+    for (uint32_t i = 0; i < assets.count(); ++i) {
+        [[maybe_unused]] const char* name = assets.name(i);
+        [[maybe_unused]] uint32_t size = assets.asset(i).size;
+    }
+    [[maybe_unused]] uint32_t align = assets.alignment() + assets.is_mapped();
+}
+
+// ============================================================
+// Boot splash and startup timeline
+// ============================================================
+
+[[maybe_unused]] static void test_splash_startup(const lv_image_dsc_t& logo, lv_display_t* disp) {
+    lv::startup::begin();
+#if defined(__linux__)
+    lv::Splash splash = lv::splash::show_fbdev("/dev/fb0", logo, 0x101418);
+#else
+    lv::Splash splash;
+#endif
+    static uint16_t fb[64 * 32];
+    [[maybe_unused]] bool ok = lv::splash::show_memory(fb, 64, 32, 64 * 2, 16, logo);
+    lv::startup::watch(disp);
+    lv::startup::mark(lv::startup::Phase::display);
+    lv::startup::mark("config loaded");
+    lv::splash::hand_over(splash, disp);
+    lv::splash::release(splash);
+    [[maybe_unused]] int64_t first = lv::startup::at(lv::startup::Phase::first_flush);
+    [[maybe_unused]] bool mounted = lv::startup::reached(lv::startup::Phase::mount);
+    lv::startup::Mark marks[16];
+    const uint32_t n = lv::startup::report(marks, 16);
+    for (uint32_t i = 0; i < n; ++i) {
+        [[maybe_unused]] const char* step = marks[i].name;
+    }
+    lv::startup::log();
+}
+
+// ============================================================
+// Memory budget
+// ============================================================
+
+struct ThumbnailStrip : lv::Component<ThumbnailStrip> {
+    lv::ObjectView build(lv::ObjectView parent) { return lv::ObjectView(lv_obj_create(parent.get())); }
+};
+
+[[maybe_unused]] static void test_mem_budget(lv::Navigator& nav) {
+    static lv::ComponentPool<ThumbnailStrip, 2> strips;
+    lv::memory::budget::set(160 * 1024, 200 * 1024);
+    lv::memory::budget::add_defaults();
+    lv::memory::budget::add(nav);
+    lv::memory::budget::add(strips, 50);
+    lv::memory::budget::add("thumbnails", 5, [](size_t need, void*) { (void)need; });
+    lv::memory::budget::start();
+    [[maybe_unused]] bool fits = lv::memory::budget::reserve(320 * 240 * 4);
+    [[maybe_unused]] lv::memory::budget::Level level = lv::memory::budget::check();
+    const lv::memory::budget::Report& r = lv::memory::budget::last_report();
+    for (uint32_t i = 0; i < r.count; ++i) {
+        [[maybe_unused]] size_t freed = r.entries[i].freed;
+    }
+    [[maybe_unused]] size_t total = r.freed() + lv::memory::budget::stats().freed + lv::memory::budget::freed_by("image cache");
+    lv_obj_add_event_cb(lv_screen_active(), [](lv_event_t* e) {
+        [[maybe_unused]] auto* report = static_cast<const lv::memory::budget::Report*>(lv_event_get_param(e));
+    }, lv::memory::budget::low_memory_event(), nullptr);
+    lv::memory::budget::log();
+    lv::memory::budget::reset_stats();
+    lv::memory::budget::stop();
+}
+
+// ============================================================
+// std::pmr bridge
+// ============================================================
+
+[[maybe_unused]] static void test_pmr_bridge() {
+#if __has_include(<memory_resource>)
+    std::pmr::memory_resource* lvgl = lv::memory::resource();
+    void* p = lvgl->allocate(64, 16);
+    lvgl->deallocate(p, 64, 16);
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_CUSTOM
+    [[maybe_unused]] bool routed = lv::memory::set_resource(std::pmr::new_delete_resource());
+    [[maybe_unused]] std::pmr::memory_resource* current = lv::memory::lvgl_resource();
+    const lv::memory::Stats& s = lv::memory::stats();
+    [[maybe_unused]] size_t held = s.bytes + s.peak + s.blocks + s.allocs + s.failures;
+    lv::memory::reset_stats();
+#endif
+#endif
+}
+
+// ============================================================
+// Slab allocator statistics (LV_STDLIB_CUSTOM)
+// ============================================================
+
+[[maybe_unused]] static void test_slab_alloc() {
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_CUSTOM
+    const lv::slab_alloc::Stats s = lv::slab_alloc::stats();
+    for (uint32_t i = 0; i < s.class_count; ++i) {
+        [[maybe_unused]] bool too_small = s.classes[i].spills > 0 || s.classes[i].peak == s.classes[i].blocks;
+    }
+    [[maybe_unused]] uint32_t frag = s.arena_frag_pct + s.arena_biggest_free + s.failures;
+    [[maybe_unused]] size_t fallback = s.system_peak + s.peak;
+    lv::slab_alloc::log();
+    lv::slab_alloc::reset_peaks();
+#endif
+}
+
+// ============================================================
+// Per-component memory accounting (LV_CPP_USE_MEM_ACCOUNT)
+// ============================================================
+
+[[maybe_unused]] static void test_mem_account() {
+#if LV_CPP_USE_MEM_ACCOUNT
+    static int owner;
+    {
+        LV_CPP_MEM_ACCOUNT_SCOPE(&owner, "settings");
+        lv_obj_create(lv_screen_active());
+    }
+    lv::mem_account::OwnerStat top[4];
+    uint32_t n = lv::mem_account::report(top, 4);
+    for (uint32_t i = 0; i < n; ++i) {
+        [[maybe_unused]] uint32_t held = top[i].live_bytes + top[i].live_blocks + top[i].objects;
+        [[maybe_unused]] const char* name = top[i].name;
+    }
+    const lv::mem_account::OwnerStat s = lv::mem_account::find(&owner);
+    [[maybe_unused]] uint32_t peak = s.peak_bytes + s.allocs + lv::mem_account::size();
+    lv::mem_account::log(5);
+    lv::mem_account::reset_peaks();
+#endif
+}
+
+// ============================================================
+// Component build profile (LV_CPP_USE_BUILD_PROFILE)
+// ============================================================
+
+[[maybe_unused]] static void test_build_profile() {
+#if LV_CPP_USE_BUILD_PROFILE
+    lv::build_profile::reset();
+    for (uint32_t i = 0; i < lv::build_profile::size(); ++i) {
+        const lv::build_profile::Node& n = lv::build_profile::node(i);
+        [[maybe_unused]] uint32_t us = n.build_us + n.on_mount_us + n.layout_us;
+        [[maybe_unused]] bool rendered = n.render_us != lv::build_profile::pending;
+        [[maybe_unused]] uint32_t created = n.objects + n.styles + n.events + n.depth;
+        [[maybe_unused]] bool nested = n.parent >= 0;
+        [[maybe_unused]] const char* name = n.name;
+    }
+    [[maybe_unused]] uint32_t lost = lv::build_profile::dropped();
+    lv::build_profile::log();
+#endif
+}
+
+// ============================================================
+// Component pool
+// ============================================================
+
+struct ConfirmDialog : lv::Component<ConfirmDialog> {
+    lv_obj_t* text = nullptr;
+    lv::ObjectView build(lv::ObjectView parent) {
+        lv::ObjectView box = lv::Box::create(parent);
+        text = lv_label_create(box.get());
+        return box;
+    }
+    void reset(const char* question) { lv_label_set_text(text, question); }
+    void on_release() {}
+};
+
+[[maybe_unused]] static void test_component_pool() {
+    static lv::ComponentPool<ConfirmDialog, 2> dialogs;
+    dialogs.budget(64 * 1024);
+    ConfirmDialog* d = dialogs.acquire(lv::screen_active(), "Delete file?");
+    if (d) dialogs.release(d);
+    dialogs.trim(1);
+    [[maybe_unused]] uint32_t n = dialogs.in_use() + dialogs.idle() + dialogs.capacity();
+    [[maybe_unused]] uint32_t reused = dialogs.stats().reuses;
+    dialogs.reset_stats();
+}
+
+// ============================================================
+// Declarative UI trees
+// ============================================================
+
+struct SettingsScreen {
+    lv::ObjectView save_btn;
+    lv_obj_t* volume = nullptr;
+    void save() {}
+    void changed(lv::Event) {}
+};
+
+[[maybe_unused]] static void test_ui_tree() {
+    static constexpr lv::ConstStyle card = lv::const_style().radius(8).pad_all(12);
+    static SettingsScreen screen;
+    lv::ObjectView root = lv::ui::build(lv::screen_active(),
+        lv::ui::box{lv::ui::style{card}, lv::ui::flex_col, lv::ui::gap{8}, lv::ui::size{lv::pct(100), LV_SIZE_CONTENT},
+            lv::ui::label{"Settings", lv::ui::grow{1}},
+            lv::ui::box{lv::ui::flex_row, lv::ui::flex_align{LV_FLEX_ALIGN_SPACE_BETWEEN},
+                lv::ui::make<&lv_slider_create>(lv::ui::width{200}, lv::ui::ref{&screen.volume},
+                    lv::ui::on<&SettingsScreen::changed>(LV_EVENT_VALUE_CHANGED, &screen)),
+                lv::ui::button{lv::ui::on_click<&SettingsScreen::save>(&screen), lv::ui::ref{&screen.save_btn},
+                    lv::ui::flag{LV_OBJ_FLAG_CHECKABLE}, lv::ui::label{"Save"}}}});
+    (void)root;
+}
+
+// ============================================================
+// Compile-time grid templates
+// ============================================================
+
+using DashTemplate = lv::GridTemplate<lv::GridTracks<80, lv::Grid::fr(1), 80>,
+                                      lv::GridTracks<lv::Grid::fr(1), 40>>;
+static_assert(DashTemplate::precomputed);
+static_assert(DashTemplate::columns::fixed_px == 160 && DashTemplate::columns::fr_sum == 1);
+static_assert(!lv::GridTemplate<lv::GridTracks<lv::Grid::content>, lv::GridTracks<40>>::precomputed);
+
+[[maybe_unused]] static void test_grid_template() {
+    auto dash = lv::grid(lv::screen_active()).use<DashTemplate>().gap(4);
+    lv::grid_cell(lv::Box::create(dash)).pos(1, 0);
+    const lv::GridTemplateStats s = DashTemplate::stats();
+    [[maybe_unused]] uint32_t work = s.passes + s.reused + s.fallbacks + s.moved + s.resized;
+    DashTemplate::reset_stats();
+}
+
+// ============================================================
+// Focus group bulk membership
+// ============================================================
+
+[[maybe_unused]] static void test_group_range(lv::ObjectView settings, lv::ObjectView advanced) {
+    lv::Group group;
+    group.add_range(settings)
+        .add_range(advanced, [](lv::ObjectView o) { return o.has_flag(LV_OBJ_FLAG_CLICKABLE); })
+        .set_hidden(advanced, true)
+        .set_hidden(advanced, false);
+    lv::group_list::add_range(group, settings);
+    lv::group_list::add_range(group, advanced, [](lv::ObjectView o) { return o.has_flag(LV_OBJ_FLAG_CLICKABLE); });
+    lv::group_list::set_hidden(group, advanced, true);
+    lv::group_list::set_hidden(group, advanced, false);
+    [[maybe_unused]] uint32_t members = group.count();
+}
+
+// ============================================================
+// Spatial index
+// ============================================================
+
+[[maybe_unused]] static void test_spatial_index(lv::ObjectView wall, lv_group_t* group) {
+    static lv::SpatialIndex<1024> index;
+    index.attach(wall);
+    [[maybe_unused]] lv::ObjectView tile = index.hit({120, 80});
+    [[maybe_unused]] lv::ObjectView any = index.hit({120, 80}, false);
+    [[maybe_unused]] lv::ObjectView right = index.neighbor(tile, LV_DIR_RIGHT);
+    index.focus(lv::SpatialIndex<1024>::key_dir(LV_KEY_DOWN), group, LV_ANIM_OFF);
+    index.invalidate();
+    [[maybe_unused]] uint32_t visited = index.stats().visited;
+    [[maybe_unused]] bool over = index.size() == index.capacity() && index.dirty();
+    index.reset_stats();
+    index.detach();
+}
+
+// ============================================================
+// Page stack
+// ============================================================
+
+class StackPage : public lv::Component<StackPage> {
+public:
+    lv::ObjectView build(lv::ObjectView parent) { return lv::Box::create(parent); }
+};
+
+[[maybe_unused]] static void test_page_stack() {
+    lv::Box content = lv::Box::create(lv::screen_active());
+    static StackPage settings, wifi, detail;
+    static lv::PageStack pages(content);   // registered with the budget manager below
+    pages.keep(1).budget(96 * 1024);
+    [[maybe_unused]] bool pushed = pages.push(settings) && pages.push(wifi) && pages.push(detail);
+    [[maybe_unused]] bool popped = pages.pop() && pages.pop_to(settings);
+    [[maybe_unused]] bool linked = pages.assign(settings, wifi, detail);
+    [[maybe_unused]] bool in = pages.contains(wifi) && pages.can_pop();
+    lv::memory::budget::add(pages);
+    pages.evict_covered();
+    [[maybe_unused]] uint32_t n = pages.depth() + pages.built_count() + pages.evictions() + pages.rebuilds();
+    [[maybe_unused]] lv::ObjectView top = pages.current();
+#if LV_USE_FRAGMENT
+    static const lv_fragment_class_t legacy_cls = [] {
+        lv_fragment_class_t c{};
+        c.instance_size = sizeof(lv_fragment_t);
+        c.create_obj_cb = [](lv_fragment_t*, lv_obj_t* container) { return lv_obj_create(container); };
+        return c;
+    }();
+    static lv::FragmentPage legacy(&legacy_cls, nullptr);
+    [[maybe_unused]] bool frag = pages.push(legacy) && legacy.is_mounted() && legacy.root() && legacy.get();
+#endif
+    pages.clear();
+}
+
+// ============================================================
+// Name index
+// ============================================================
+
+#if LV_USE_OBJ_NAME
+[[maybe_unused]] static void test_name_index() {
+    lv::ObjectView scr = lv::screen_active();
+    [[maybe_unused]] bool ok = lv::name_index::enable(scr);
+    lv::Box settings = lv::Box::create(scr).name("settings");
+    lv::Box row = lv::Box::create(lv::Box::create(settings)).name("wifi");
+    lv::Switch toggle = lv::Switch::create(row).name("toggle");
+    [[maybe_unused]] lv::ObjectView a = lv::find("settings.wifi.toggle");
+    [[maybe_unused]] lv::ObjectView b = lv::find(settings, "wifi.toggle");
+    toggle.set_parent(settings);
+    [[maybe_unused]] lv::ObjectView c = lv::find("settings.toggle");
+    const lv::name_index::Stats st = lv::name_index::stats();
+    [[maybe_unused]] uint32_t n = st.lookups + st.hits + st.walks + st.stale + st.indexed;
+    lv::name_index::reset_stats();
+    [[maybe_unused]] bool on = lv::name_index::enabled(scr);
+    lv::name_index::disable(scr);
+}
+#endif
+
+// ============================================================
+// System monitor metrics
+// ============================================================
+
+[[maybe_unused]] static void test_sysmon_metrics() {
+    lv::sysmon::start(nullptr, 500);
+    lv::sysmon::subscribe([](const lv::sysmon::PerfSample& s, void*) {
+        [[maybe_unused]] uint32_t fps = s.fps;
+        [[maybe_unused]] uint32_t frag = s.mem_frag_pct;
+    });
+    [[maybe_unused]] lv::sysmon::PerfSample now = lv::sysmon::snapshot();
+    [[maybe_unused]] bool running = lv::sysmon::running();
+#if LV_USE_OBSERVER
+    [[maybe_unused]] const lv::sysmon::PerfSample& latest = lv::sysmon::perf_state().get();
+#endif
+    lv::sysmon::subscribe(nullptr);
+    lv::sysmon::stop();
+}
+
+// ============================================================
+// Animation governor
+// ============================================================
+
+[[maybe_unused]] static void test_anim_governor(lv::ObjectView card, lv::ObjectView gauge) {
+    lv::anim_governor::start(nullptr, 12000);
+    lv::anim_governor::simplify(card);
+    [[maybe_unused]] bool cached = lv::anim_governor::cache(gauge);
+    lv::anim_x(card, 0, 200).duration(800).priority(lv::AnimPriority::low).start();
+    lv::anim_opa(gauge, 0, 255).duration(150).priority(lv::AnimPriority::high).start();
+    [[maybe_unused]] lv::AnimPriority prio = lv::Anim().priority();
+    [[maybe_unused]] bool thinning = lv::anim_governor::quality() >= lv::anim_governor::Quality::thin;
+    [[maybe_unused]] uint32_t moving = lv::anim_governor::animations();
+    lv::anim_governor::budget(lv::anim_governor::budget() * 2);
+    [[maybe_unused]] lv::anim_governor::Stats s = lv::anim_governor::stats();
+    lv::anim_governor::reset_stats();
+    lv::anim_governor::forget(card);
+    [[maybe_unused]] bool on = lv::anim_governor::running();
+    lv::anim_governor::stop();
+}
+
+// ============================================================
+// Profiler markers
+// ============================================================
+
+[[maybe_unused]] static void test_profiler() {
+    LV_PROFILE_SCOPE("smoke test");
+    LV_PROFILE_FUNCTION();
+#if LV_CPP_USE_PROFILER
+    lv::profiler::enable(true);
+    [[maybe_unused]] uint32_t n = lv::profiler::size() + lv::profiler::dropped();
+    lv::profiler::for_each([](const lv::profiler::TraceEvent& e) { (void)e.dur_us; });
+    lv::profiler::write_chrome_trace(stdout);
+    lv::profiler::write_chrome_trace("/tmp/trace.json");
+    lv::profiler::clear();
+#endif
+}
+
+// ============================================================
+// Event handler latency stats (LV_CPP_USE_EVENT_STATS)
+// ============================================================
+
+[[maybe_unused]] static void test_event_stats() {
+#if LV_CPP_USE_EVENT_STATS
+    lv::event_stats::enable(true);
+    lv::event_stats::HandlerStat top[4];
+    uint32_t n = lv::event_stats::slowest(top, 4);
+    for (uint32_t i = 0; i < n; ++i) {
+        [[maybe_unused]] uint32_t avg = top[i].avg_us();
+        [[maybe_unused]] const char* handler = top[i].handler;
+    }
+    const lv::event_stats::Histogram& h = lv::event_stats::histogram();
+    [[maybe_unused]] uint32_t p99 = h.percentile_us(99);
+    [[maybe_unused]] uint32_t first = lv::event_stats::Histogram::floor_us(1);
+    [[maybe_unused]] uint32_t keys = lv::event_stats::size() + lv::event_stats::evicted();
+    lv::event_stats::for_each([](const lv::event_stats::HandlerStat& s) { (void)s.max_us; });
+    lv::event_stats::log(5);
+    lv::event_stats::reset();
+#endif
+}
+
+// ============================================================
+// Timer lateness stats (LV_CPP_USE_TIMER_STATS)
+// ============================================================
+
+[[maybe_unused]] static void test_timer_stats() {
+#if LV_CPP_USE_TIMER_STATS
+    lv::timer_stats::enable(true);
+    lv::timer_stats::TimerStat top[4];
+    uint32_t n = lv::timer_stats::report(top, 4);
+    for (uint32_t i = 0; i < n; ++i) {
+        [[maybe_unused]] uint32_t avg = top[i].avg_us() + top[i].avg_late_ms();
+        [[maybe_unused]] uint32_t p99 = top[i].late.percentile_ms(99);
+        [[maybe_unused]] uint32_t missed = top[i].missed;
+    }
+    [[maybe_unused]] uint32_t first = lv::timer_stats::LateHistogram::floor_ms(1);
+    [[maybe_unused]] const lv::timer_stats::TimerStat* s = lv::timer_stats::find(nullptr);
+    [[maybe_unused]] uint32_t keys = lv::timer_stats::size() + lv::timer_stats::evicted();
+    lv::timer_stats::for_each([](const lv::timer_stats::TimerStat& e) { (void)e.max_late_ms; });
+    lv::timer_stats::log(5);
+    lv::timer_stats::reset();
+#endif
+}
+
+// ============================================================
+// Timer wheel
+// ============================================================
+
+struct StatusLed {
+    lv::WheelTimer blink;
+    lv::WheelTimer poll;
+    void toggle() {}
+    void sample() {}
+};
+
+[[maybe_unused]] static void test_timer_wheel() {
+    using namespace std::chrono_literals;
+    static StatusLed led;
+    led.blink = lv::TimerWheel::shared().create<&StatusLed::toggle>(500, &led);
+    led.poll = lv::Timer::create<&StatusLed::sample>(1000, &led, lv::slack{50ms});
+    led.poll.slack(lv::slack{100}).period(2000).pause().resume();
+    led.blink.ready();
+    [[maybe_unused]] bool paused = led.poll.is_paused() || !led.blink.valid();
+    lv::TimerWheel& wheel = lv::TimerWheel::shared();
+    [[maybe_unused]] uint32_t n = wheel.size() + wheel.capacity();
+    [[maybe_unused]] uint32_t shared = wheel.stats().coalesced + wheel.stats().wakeups;
+    wheel.reset_stats();
+    led.blink.once();
+    led.poll.del();
+}
+
+// ============================================================
+// Setter audit (LV_CPP_SETTER_AUDIT / LV_CPP_SET_IF_CHANGED)
+// ============================================================
+
+[[maybe_unused]] static void test_setter_audit(lv::Label label) {
+    for (int i = 0; i < 2; ++i) {        // the second pass changes nothing
+        label.text("42 km/h").text(std::string_view("42 km/h"));
+        label.size(80, 20).pos(4, 4).x(4).y(4).show().visible(true);
+        label.bg_color(lv::rgb(0x202020)).bg_opa(LV_OPA_COVER).text_color(lv::rgb(0xFFFFFF));
+        label.opa(LV_OPA_COVER).translate_x(0).transform_scale(256);
+    }
+    label.hide().hide();
+#if LV_CPP_SETTER_AUDIT
+    const lv::setter_audit::Stats st = lv::setter_audit::stats();
+    [[maybe_unused]] uint32_t n = st.calls + st.redundant + st.sites + st.untracked;
+    lv::setter_audit::dump(5);
+    lv::setter_audit::reset();
+#endif
+}
+
+// ============================================================
+// Capturing callbacks (LV_CPP_USE_STD_FUNCTION)
+// ============================================================
+
+#if LV_CPP_USE_STD_FUNCTION
+[[maybe_unused]] static void test_capturing_callbacks() {
+    static int clicks = 0;
+    int step = 2;
+    lv::Button btn = lv::Button::create(lv::screen_active());
+    btn.on_click([step](lv::Event) { clicks += step; });
+    btn.on(lv::kEvent::pressed, [&btn](lv_event_t*) { (void)btn; });
+
+    lv::Timer timer = lv::Timer::create(100, [step]() { clicks += step; });
+
+    static lv::State<int32_t> level{0};
+    level.observe([step](int32_t v) { clicks = v * step; });
+    level.observe_obj(btn.get(), [](int32_t) {});
+    [[maybe_unused]] size_t used = lv::callbacks_in_use();
+}
+
+/// One-shot capturing timers free their pool slot after running: more than the pool holds all fire
+[[maybe_unused]] static bool test_one_shot_timers_free_slots() {
+    static uint32_t fired = 0;
+    const size_t before = lv::callbacks_in_use();
+    constexpr uint32_t rounds = LV_CPP_MAX_CALLBACKS + 8;
+    for (uint32_t i = 0; i < rounds; ++i) {
+        lv::Timer t = lv::Timer::create(1, [step = 1u]() { fired += step; });
+        if (!t) return false;    // pool ran dry: earlier one-shots kept their slots
+        (void)t.once().release();
+        lv_tick_inc(2);
+        lv_timer_handler();
+    }
+    return fired == rounds && lv::callbacks_in_use() == before;
+}
+#endif
+
 int main() {
     return 0;
 }
@@ -4,6 +4,10 @@
  *
  * Compile with: g++ -O2 -S -o zero_cost_test.s zero_cost_test.cpp
  * Then compare the assembly for C vs C++ versions
+ *
+ * scripts/zero_cost_check.py (target zero_cost_check) does this for every
+ * test_c_X / test_cpp_X pair at -O2 and -Os on x86-64, Cortex-M4 and
+ * Cortex-A53 and fails when the C++ side grows past the baseline.
  */
 
 #include <lv/lv.hpp>
@@ -116,6 +120,39 @@ static_assert(sizeof(lv::Button) == sizeof(lv_obj_t*), "Button must be pointer-s
 static_assert(sizeof(lv::Slider) == sizeof(lv_obj_t*), "Slider must be pointer-sized");
 static_assert(sizeof(lv::Chart) == sizeof(lv_obj_t*), "Chart must be pointer-sized");
 
+// ============================================================
+// TEST 7: Declarative UI tree
+// ============================================================
+
+// C version - the same calls lv::ui::build() makes, BuildScope included
+extern "C" lv_obj_t* test_c_ui_tree(lv_obj_t* parent, Handler* h) {
+    lv_display_t* disp = parent ? lv_obj_get_display(parent) : nullptr;
+    const bool scoped = disp && lv_display_is_invalidation_enabled(disp);
+    if (scoped) lv_display_enable_invalidation(disp, false);
+    lv_obj_t* cont = lv_obj_create(parent);
+    lv_obj_set_layout(cont, LV_LAYOUT_FLEX);
+    lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_COLUMN);
+    lv_obj_set_style_pad_gap(cont, 8, 0);
+    lv_obj_t* label = lv_label_create(cont);
+    lv_label_set_text_static(label, "Title");
+    lv_obj_t* btn = lv_button_create(cont);
+    lv_obj_add_event_cb(btn, c_event_cb, LV_EVENT_CLICKED, h);
+    if (scoped) {
+        lv_display_enable_invalidation(disp, true);
+        lv_obj_update_layout(cont);
+        lv_obj_invalidate(cont);
+    }
+    return cont;
+}
+
+// C++ version
+lv_obj_t* test_cpp_ui_tree(lv_obj_t* parent, Handler* h) {
+    return lv::ui::build(lv::ObjectView(parent),
+        lv::ui::box{lv::ui::flex_col, lv::ui::gap{8},
+            lv::ui::label{"Title"},
+            lv::ui::button{lv::ui::on_click<&Handler::on_click>(h)}}).get();
+}
+
 int main() {
     return 0;
 }